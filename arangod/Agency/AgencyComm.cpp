@@ -23,6 +23,7 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "AgencyComm.h"
+#include "AgencyWriteCoalescer.h"
 #include "ApplicationFeatures/ApplicationServer.h"
 #include "RestServer/ServerFeature.h"
 
@@ -1020,6 +1021,11 @@ AgencyCommResult AgencyComm::unregisterCallback(std::string const& key,
 
 AgencyCommResult AgencyComm::sendTransactionWithFailover(
     AgencyTransaction const& transaction, double timeout) {
+  auto write = dynamic_cast<AgencyWriteTransaction const*>(&transaction);
+  if (write != nullptr) {
+    return AgencyWriteCoalescer::instance()->send(*write, timeout);
+  }
+
   std::string url = AgencyComm::AGENCY_URL_PREFIX;
 
   url += transaction.path();
@@ -1250,6 +1256,23 @@ AgencyCommResult AgencyComm::sendWithFailover(
     arangodb::rest::RequestType method, double const timeout,
     std::string const& initialUrl, std::string const& body,
     std::string const& clientId) {
+  std::vector<std::string> clientIds;
+  if (!clientId.empty()) {
+    clientIds.emplace_back(clientId);
+  }
+  return sendWithFailover(method, timeout, initialUrl, body, clientIds,
+                          nullptr);
+}
+
+AgencyCommResult AgencyComm::sendWithFailover(
+    arangodb::rest::RequestType method, double const timeout,
+    std::string const& initialUrl, std::string const& body,
+    std::vector<std::string> const& clientIds,
+    std::shared_ptr<VPackBuilder>* inquiry) {
+
+  // the result of a request carries its client id only if it is the only one
+  std::string const clientId =
+      (clientIds.size() == 1) ? clientIds[0] : std::string();
 
   std::string endpoint;
   std::unique_ptr<GeneralClientConnection> connection =
@@ -1331,18 +1354,20 @@ AgencyCommResult AgencyComm::sendWithFailover(
     }
     
     // break on a watch timeout (drop connection)
-    if (!clientId.empty() && result._sent &&
+    if (!clientIds.empty() && result._sent &&
         (result._statusCode == 0 || result._statusCode == 503)) {
       
       VPackBuilder b;
       {
         VPackArrayBuilder ab(&b);
-        b.add(VPackValue(clientId));
+        for (auto const& id : clientIds) {
+          b.add(VPackValue(id));
+        }
       }
       
       LOG_TOPIC(DEBUG, Logger::AGENCYCOMM) <<
         "Failed agency comm (" << result._statusCode << ")! " <<
-        "Inquiring about clientId " << clientId << ".";
+        "Inquiring about clientIds " << b.toJson() << ".";
       
       AgencyCommResult inq = send(
         connection.get(), method, conTimeout, "/_api/agency/inquire",
@@ -1350,6 +1375,13 @@ AgencyCommResult AgencyComm::sendWithFailover(
       
       if (inq.successful()) {
         auto bodyBuilder = VPackParser::fromJson(inq._body);
+
+        if (inquiry != nullptr) {
+          // the caller evaluates the answer per client id
+          *inquiry = bodyBuilder;
+          return result;
+        }
+
         auto const& outer = bodyBuilder->slice();
 
         if (outer.isArray() && outer.length() > 0) {
@@ -567,6 +567,8 @@ class AgencyCommManager {
 // -----------------------------------------------------------------------------
 
 class AgencyComm {
+  friend class AgencyWriteCoalescer;
+
  private:
   static std::string const AGENCY_URL_PREFIX;
   static uint64_t const INITIAL_SLEEP_TIME = 5000;
@@ -646,6 +648,15 @@ class AgencyComm {
                                     std::string const&, std::string const&,
                                     std::string const& clientId = std::string());
 
+  /// @brief send a request with several transactions, each with its own
+  /// client id. if the connection fails after sending it, the agency is asked
+  /// about all client ids. its answer is then stored in inquiry, with one
+  /// array of log entries per client id, and the failed result is returned
+  AgencyCommResult sendWithFailover(
+      arangodb::rest::RequestType, double, std::string const&,
+      std::string const&, std::vector<std::string> const& clientIds,
+      std::shared_ptr<arangodb::velocypack::Builder>* inquiry);
+
  private:
   bool lock(std::string const&, double, double,
             arangodb::velocypack::Slice const&);
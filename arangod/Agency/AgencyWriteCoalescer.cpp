@@ -0,0 +1,248 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "AgencyWriteCoalescer.h"
+
+#include "Basics/ConditionLocker.h"
+#include "Logger/Logger.h"
+
+#include <velocypack/Iterator.h>
+#include <velocypack/Parser.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+
+namespace {
+
+/// @brief the result of a single transaction of an envelope, with the given
+/// log index as its only result
+AgencyCommResult ownResult(AgencyCommResult const& envelope,
+                           std::string const& clientId, int statusCode,
+                           VPackSlice index) {
+  auto body = std::make_shared<VPackBuilder>();
+  {
+    VPackObjectBuilder guard(body.get());
+    body->add(VPackValue("results"));
+    VPackArrayBuilder guard2(body.get());
+    body->add(index);
+  }
+
+  AgencyCommResult own;
+  own._connected = envelope._connected;
+  own._sent = envelope._sent;
+  own._location = envelope._location;
+  own._clientId = clientId;
+  own._statusCode = statusCode;
+  own.setVPack(body);
+  return own;
+}
+}
+
+AgencyWriteCoalescer* AgencyWriteCoalescer::instance() {
+  static AgencyWriteCoalescer coalescer;
+  return &coalescer;
+}
+
+AgencyCommResult AgencyWriteCoalescer::send(
+    AgencyWriteTransaction const& transaction, double timeout) {
+  Entry entry{&transaction, timeout, AgencyCommResult(), false};
+
+  CONDITION_LOCKER(guard, _condition);
+  _queue.emplace_back(&entry);
+
+  while (!entry._done) {
+    if (_inFlight || _queue.front() != &entry) {
+      guard.wait(100000);
+      continue;
+    }
+
+    std::vector<Entry*> batch;
+    while (!_queue.empty() && batch.size() < MaxBatchTransactions) {
+      batch.emplace_back(_queue.front());
+      _queue.pop_front();
+    }
+
+    _inFlight = true;
+    guard.unlock();
+
+    try {
+      sendBatch(batch);
+    } catch (std::exception const& ex) {
+      for (auto& it : batch) {
+        it->_result = AgencyCommResult(500, ex.what());
+      }
+    } catch (...) {
+      for (auto& it : batch) {
+        it->_result = AgencyCommResult(500, "out of memory");
+      }
+    }
+
+    guard.lock();
+    _inFlight = false;
+    for (auto& it : batch) {
+      it->_done = true;
+    }
+    guard.broadcast();
+  }
+
+  return entry._result;
+}
+
+std::vector<AgencyCommResult> AgencyWriteCoalescer::splitResults(
+    AgencyCommResult const& envelope,
+    std::vector<std::string> const& clientIds) {
+  std::shared_ptr<VPackBuilder> parsed;
+  try {
+    parsed = VPackParser::fromJson(envelope._body);
+  } catch (std::exception const& e) {
+    LOG_TOPIC(ERR, Logger::AGENCYCOMM) << "Error transforming result. "
+                                       << e.what();
+  }
+
+  VPackSlice results = (parsed == nullptr) ? VPackSlice() : parsed->slice();
+  if (results.isObject()) {
+    results = results.get("results");
+  }
+  if (!results.isArray()) {
+    results = VPackSlice::emptyArraySlice();
+  }
+
+  if (results.length() != clientIds.size()) {
+    LOG_TOPIC(ERR, Logger::AGENCYCOMM)
+        << "unexpected agency response to " << clientIds.size()
+        << " write transactions: " << envelope._body;
+  }
+
+  std::vector<AgencyCommResult> own;
+  own.reserve(clientIds.size());
+
+  for (size_t i = 0; i < clientIds.size(); ++i) {
+    VPackSlice index =
+        (i < results.length()) ? results.at(i) : VPackSlice::noneSlice();
+
+    if (!index.isNumber()) {
+      // the agency did not report on this transaction
+      own.emplace_back(AgencyCommResult(
+          500, "invalid agency response to write transaction", clientIds[i]));
+      continue;
+    }
+
+    own.emplace_back(ownResult(
+        envelope, clientIds[i],
+        (index.getNumber<uint64_t>() > 0)
+            ? (int)arangodb::rest::ResponseCode::OK
+            : (int)arangodb::rest::ResponseCode::PRECONDITION_FAILED,
+        index));
+  }
+
+  return own;
+}
+
+std::vector<AgencyCommResult> AgencyWriteCoalescer::splitInquiry(
+    AgencyCommResult const& failed, VPackSlice inquiry,
+    std::vector<std::string> const& clientIds) {
+  std::vector<AgencyCommResult> own;
+  own.reserve(clientIds.size());
+
+  for (size_t i = 0; i < clientIds.size(); ++i) {
+    // one array of log entries per client id, in order. only applied
+    // transactions are logged
+    VPackSlice entries = (inquiry.isArray() && i < inquiry.length())
+                             ? inquiry.at(i)
+                             : VPackSlice::noneSlice();
+    VPackSlice index = VPackSlice::noneSlice();
+
+    if (entries.isArray() && entries.length() > 0) {
+      VPackSlice last = entries.at(entries.length() - 1);
+      if (last.isObject()) {
+        index = last.get("index");
+      }
+    }
+
+    if (index.isNumber() && index.getNumber<uint64_t>() > 0) {
+      LOG_TOPIC(DEBUG, Logger::AGENCYCOMM)
+          << "transaction " << clientIds[i] << " was applied at index "
+          << index.toJson();
+      own.emplace_back(ownResult(failed, clientIds[i],
+                                 (int)arangodb::rest::ResponseCode::OK, index));
+    } else {
+      LOG_TOPIC(DEBUG, Logger::AGENCYCOMM)
+          << "transaction " << clientIds[i] << " was not applied";
+      own.emplace_back(failed);
+      own.back()._clientId = clientIds[i];
+    }
+  }
+
+  return own;
+}
+
+void AgencyWriteCoalescer::sendBatch(std::vector<Entry*> const& batch) {
+  TRI_ASSERT(!batch.empty());
+
+  double timeout = 0.0;
+  std::vector<std::string> clientIds;
+  VPackBuilder builder;
+  {
+    VPackArrayBuilder guard(&builder);
+    for (auto const& it : batch) {
+      it->_transaction->toVelocyPack(builder);
+      clientIds.emplace_back(it->_transaction->getClientId());
+      double t = (it->_timeout == 0.0)
+                     ? AgencyCommManager::CONNECTION_OPTIONS._requestTimeout
+                     : it->_timeout;
+      timeout = (std::max)(timeout, t);
+    }
+  }
+
+  std::string const url =
+      AgencyComm::AGENCY_URL_PREFIX + batch[0]->_transaction->path();
+
+  LOG_TOPIC(TRACE, Logger::AGENCYCOMM)
+    << "sending " << builder.toJson() << "'" << url << "'";
+
+  // if the connection fails after sending the envelope, the agency is asked
+  // about every transaction's client id, so that an envelope that may have
+  // been applied partially is never sent again
+  std::shared_ptr<VPackBuilder> inquiry;
+  AgencyCommResult result = AgencyComm().sendWithFailover(
+      arangodb::rest::RequestType::POST, timeout, url,
+      builder.slice().toJson(), clientIds, &inquiry);
+
+  std::vector<AgencyCommResult> results;
+
+  if (inquiry != nullptr) {
+    results = splitInquiry(result, inquiry->slice(), clientIds);
+  } else if (!result.successful() &&
+             result.httpCode() !=
+                 (int)arangodb::rest::ResponseCode::PRECONDITION_FAILED) {
+    for (auto& it : batch) {
+      it->_result = result;
+    }
+    return;
+  } else {
+    results = splitResults(result, clientIds);
+  }
+
+  TRI_ASSERT(results.size() == batch.size());
+  for (size_t i = 0; i < batch.size(); ++i) {
+    batch[i]->_result = std::move(results[i]);
+  }
+}
@@ -0,0 +1,88 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_AGENCY_AGENCY_WRITE_COALESCER_H
+#define ARANGOD_AGENCY_AGENCY_WRITE_COALESCER_H 1
+
+#include "Agency/AgencyComm.h"
+#include "Basics/ConditionVariable.h"
+
+#include <deque>
+
+namespace arangodb {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief combines write transactions that are sent concurrently into one
+/// request to /_api/agency/write. there is at most one write request in
+/// flight per process. the transactions that are issued while it is in
+/// flight are queued and sent together as soon as it returns, so a lone
+/// transaction is sent right away. the agency handles every transaction of
+/// an envelope independently and reports one result index per transaction,
+/// in order. every transaction keeps its own client id, so that its outcome
+/// can be inquired about if the connection fails
+////////////////////////////////////////////////////////////////////////////////
+
+class AgencyWriteCoalescer {
+ public:
+  /// @brief maximum number of transactions combined into one request
+  static size_t const MaxBatchTransactions = 64;
+
+  static AgencyWriteCoalescer* instance();
+
+  /// @brief send a write transaction, possibly together with others, and
+  /// return its own result
+  AgencyCommResult send(AgencyWriteTransaction const& transaction,
+                        double timeout);
+
+  /// @brief split the response to an envelope into one result per
+  /// transaction, by position: 200 if the transaction was applied, 412 if
+  /// its precondition failed. transactions the response has no result for
+  /// get a 500
+  static std::vector<AgencyCommResult> splitResults(
+      AgencyCommResult const& envelope,
+      std::vector<std::string> const& clientIds);
+
+  /// @brief determine the result of every transaction of an envelope from
+  /// the agency's answer to an inquiry about their client ids, after the
+  /// connection failed. transactions found in the agency's log were
+  /// applied. the others get the failed result, so their callers retry
+  static std::vector<AgencyCommResult> splitInquiry(
+      AgencyCommResult const& failed, velocypack::Slice inquiry,
+      std::vector<std::string> const& clientIds);
+
+ private:
+  struct Entry {
+    AgencyWriteTransaction const* _transaction;
+    double _timeout;
+    AgencyCommResult _result;
+    bool _done;
+  };
+
+  void sendBatch(std::vector<Entry*> const& batch);
+
+ private:
+  basics::ConditionVariable _condition;
+  std::deque<Entry*> _queue;
+  bool _inFlight = false;
+};
+}
+
+#endif
@@ -323,9 +323,49 @@ bool Agent::recvAppendEntriesRPC(
     }
   }
 
+  {
+    // Everything up to the last entry of this message matches the leader's
+    // log, entries behind it may still be replaced
+    MUTEX_LOCKER(ioLocker, _ioLock);
+    applyCommitted(prevIndex + nqs);
+  }
+
+  { // Wake up reads waiting for the leader's commit index
+    CONDITION_LOCKER(guard, _waitForCV);
+    guard.broadcast();
+  }
+
   return true;
 }
 
+/// Follower's apply of committed entries
+void Agent::applyCommitted(index_t lastMatching) {
+
+  index_t leaderCommitIndex;
+  {
+    MUTEX_LOCKER(liLocker, _liLock);
+    leaderCommitIndex = _leaderCommitIndex;
+  }
+
+  auto range =
+    nextApplyRange(_lastAppliedIndex, leaderCommitIndex, lastMatching);
+  if (range.first > range.second) {
+    return;
+  }
+
+  auto logs = _state.slices(range.first, range.second);
+  _spearhead.apply(logs, range.second, _constituent.term());
+  _readDB.apply(logs, range.second, _constituent.term());
+  _lastAppliedIndex = range.second;
+
+}
+
+std::pair<index_t, index_t> Agent::nextApplyRange(
+  index_t lastApplied, index_t leaderCommit, index_t lastMatching) {
+  return std::make_pair(
+    lastApplied + 1, (std::min)(leaderCommit, lastMatching));
+}
+
 /// Leader's append entries
 void Agent::sendAppendEntriesRPC() {
 
@@ -804,6 +844,9 @@ read_ret_t Agent::read(query_t const& query) {
 
   auto leader = _constituent.leaderID();
   if (leader != id()) {
+    if (leader != NO_LEADER) {
+      return followerRead(query, leader);
+    }
     return read_ret_t(false, leader);
   }
 
@@ -823,6 +866,102 @@ read_ret_t Agent::read(query_t const& query) {
 }
 
 
+/// Leader's commit index for a follower's read
+bool Agent::readIndex(index_t& index) {
+
+  if (!leading()) {
+    return false;
+  }
+
+  MUTEX_LOCKER(ioLocker, _ioLock);
+
+  // A majority has acknowledged us within the last ping interval, so
+  // no other leader can have committed anything beyond our commit index
+  if (challengeLeadership()) {
+    return false;
+  }
+
+  // Until we have committed an entry of our own term, entries of earlier
+  // terms beyond our commit index may be committed already
+  if (!mayServeReadIndex(_state[_lastCommitIndex].term, _constituent.term())) {
+    return false;
+  }
+
+  index = _lastCommitIndex;
+  return true;
+  
+}
+
+bool Agent::mayServeReadIndex(term_t commitTerm, term_t currentTerm) {
+  return commitTerm == currentTerm;
+}
+
+
+/// Follower's read: ask the leader for its commit index, wait until we
+/// have applied the log up to there and read locally. Redirect to the
+/// leader on any failure
+read_ret_t Agent::followerRead(
+  query_t const& query, std::string const& leader) {
+
+  auto cc = ClusterComm::instance();
+  if (cc == nullptr) {
+    // nullptr only happens during controlled shutdown
+    return read_ret_t(false, leader);
+  }
+
+  double const timeout = _config.minPing();
+  
+  auto comres = cc->syncRequest(
+    "1", 1, _config.poolAt(leader), rest::RequestType::GET,
+    "/_api/agency_priv/readIndex", std::string(),
+    std::unordered_map<std::string, std::string>(), timeout);
+
+  index_t index = 0;
+  try {
+    if (comres->status != CL_COMM_SENT ||
+        comres->result->getHttpReturnCode() != 200) {
+      return read_ret_t(false, leader);
+    }
+    auto body = comres->result->getBodyVelocyPack();
+    index = body->slice().get("readIndex").getNumber<index_t>();
+  } catch (...) {
+    return read_ret_t(false, leader);
+  }
+
+  auto const until = steady_clock::now() + duration<double>(timeout);
+
+  CONDITION_LOCKER(guard, _waitForCV);
+
+  while (true) {
+
+    if (_constituent.leaderID() != leader || this->isStopping()) {
+      return read_ret_t(false, leader);
+    }
+    
+    {
+      // Entries are only applied by appendEntries and compaction, never here
+      MUTEX_LOCKER(ioLocker, _ioLock);
+      if (_lastAppliedIndex >= index) {
+        auto result = std::make_shared<arangodb::velocypack::Builder>();
+        std::vector<bool> success = _readDB.read(query, result);
+        return read_ret_t(true, leader, success, result);
+      }
+    }
+
+    auto const now = steady_clock::now();
+    if (now >= until) {
+      return read_ret_t(false, leader);
+    }
+
+    // Woken up by appendEntries
+    _waitForCV.wait(static_cast<uint64_t>(
+      1.0e6 * duration<double>(until - now).count()));
+    
+  }
+  
+}
+
+
 /// Send out append entries to followers regularly or on event
 void Agent::run() {
 
@@ -1178,16 +1317,19 @@ arangodb::consensus::index_t Agent::rebuildDBs() {
     << "Rebuilding key-value stores from index "
     << _lastAppliedIndex << " to " << _leaderCommitIndex;
 
-  auto logs = _state.slices(_lastAppliedIndex+1, _leaderCommitIndex+1);
+  // Slices are inclusive, nothing behind the commit index may be applied
+  if (_leaderCommitIndex > _lastAppliedIndex) {
+    auto logs = _state.slices(_lastAppliedIndex+1, _leaderCommitIndex);
   
-  _spearhead.apply(logs, _leaderCommitIndex, _constituent.term());
-  _readDB.apply(logs, _leaderCommitIndex, _constituent.term());
+    _spearhead.apply(logs, _leaderCommitIndex, _constituent.term());
+    _readDB.apply(logs, _leaderCommitIndex, _constituent.term());
+  
+    _lastAppliedIndex = _leaderCommitIndex;
+  }
   
   LOG_TOPIC(TRACE, Logger::AGENCY)
     << "ReadDB: " << _readDB;
   
-  _lastAppliedIndex = _leaderCommitIndex;
-  
   return _lastAppliedIndex;
 
 }
@@ -1196,7 +1338,18 @@ arangodb::consensus::index_t Agent::rebuildDBs() {
 /// Compact read db
 void Agent::compact() {
   rebuildDBs();
-  _state.compact(_lastAppliedIndex-_config.compactionKeepSize());
+
+  // Serialize and persist a copy, so that commits are only held up for as
+  // long as copying takes. The copy and the index must match.
+  Store snapshot(this, "snapshot");
+  arangodb::consensus::index_t cind;
+  {
+    MUTEX_LOCKER(ioLocker, _ioLock);
+    snapshot = _readDB;
+    cind = _lastAppliedIndex - _config.compactionKeepSize();
+  }
+
+  _state.compact(cind, snapshot);
   _nextCompationAfter += _config.compactionStepSize();
 }
 
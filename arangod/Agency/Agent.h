@@ -103,6 +103,22 @@ class Agent : public arangodb::Thread {
   /// @brief Read from agency
   read_ret_t read(query_t const&);
 
+  /// @brief Leader only: the commit index, up to which a follower must have
+  /// applied the log to serve a linearizable read. false, if we are not
+  /// leading or a majority has not acknowledged our leadership recently
+  bool readIndex(index_t&);
+
+  /// @brief Whether a leader may hand out its commit index as read index.
+  /// Entries of earlier terms only count as committed once an entry of the
+  /// current term is, until then the commit index may be stale
+  static bool mayServeReadIndex(term_t commitTerm, term_t currentTerm);
+
+  /// @brief The log entries a follower applies next: those after the last
+  /// applied one, up to the leader's commit index, but only as far as our
+  /// log is known to match the leader's. Empty if first > second
+  static std::pair<index_t, index_t> nextApplyRange(
+    index_t lastApplied, index_t leaderCommit, index_t lastMatching);
+
   /// @brief Inquire success of logs given clientIds
   inquire_ret_t inquire(query_t const&);
 
@@ -237,6 +253,14 @@ class Agent : public arangodb::Thread {
   /// @brief Find out, if we've had acknowledged RPCs recent enough
   bool challengeLeadership();
 
+  /// @brief Follower only: serve a read, once our read db has caught up
+  /// with the leader's read index
+  read_ret_t followerRead(query_t const&, std::string const& leader);
+
+  /// @brief Follower only: apply the committed log entries up to
+  /// lastMatching to spearhead and read db. _ioLock must be held
+  void applyCommitted(index_t lastMatching);
+
   /// @brief Notify inactive pool members of changes in configuration
   void notifyInactive() const;
 
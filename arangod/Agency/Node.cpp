@@ -145,7 +145,11 @@ Node::Node(Node&& other)
       _value(std::move(other._value)),
       _vecBuf(std::move(other._vecBuf)),
       _vecBufDirty(std::move(other._vecBufDirty)),
-      _isArray(std::move(other._isArray)) {}
+      _isArray(std::move(other._isArray)) {
+  for (auto const& p : _children) {
+    p.second->_parent = this;
+  }
+}
 
 /// Copy constructor
 Node::Node(Node const& other)
@@ -158,6 +162,7 @@ Node::Node(Node const& other)
       _isArray(other._isArray) {
   for (auto const& p : other._children) {
     auto copy = std::make_shared<Node>(*p.second);
+    copy->_parent = this;
     _children.insert(std::make_pair(p.first, copy));
   }
 }
@@ -169,6 +174,7 @@ Node& Node::operator=(VPackSlice const& slice) {
   // 3. copy from rhs buffer to my buffer
   // Must not copy _parent, _ttl, _observers
   removeTimeToLive();
+  invalidate();
   _children.clear();
   _value.clear();
   if (slice.isArray()) {
@@ -195,8 +201,12 @@ Node& Node::operator=(Node&& rhs) {
   // 3. move value over
   // Must not move ober rhs's _parent, _ttl, _observers
   removeTimeToLive();
+  invalidate();
   _node_name = std::move(rhs._node_name);
   _children = std::move(rhs._children);
+  for (auto const& p : _children) {
+    p.second->_parent = this;
+  }
   _value = std::move(rhs._value);
   _vecBuf = std::move(rhs._vecBuf);
   _vecBufDirty = std::move(rhs._vecBufDirty);
@@ -211,10 +221,12 @@ Node& Node::operator=(Node const& rhs) {
   // 3. move from rhs to buffer pointer
   // Must not move rhs's _parent, _ttl, _observers
   removeTimeToLive();
+  invalidate();
   _node_name = rhs._node_name;
   _children.clear();
   for (auto const& p : rhs._children) {
     auto copy = std::make_shared<Node>(*p.second);
+    copy->_parent = this;
     _children.insert(std::make_pair(p.first, copy));
   }
   _value = rhs._value;
@@ -250,6 +262,7 @@ bool Node::removeChild(std::string const& key) {
   }
   found->second->removeTimeToLive();
   _children.erase(found);
+  invalidate();
   return true;
 }
 
@@ -262,6 +275,7 @@ Node& Node::operator()(std::vector<std::string> const& pv) {
     std::string const& key = pv.front();
     if (_children.find(key) == _children.end()) {
       _children[key] = std::make_shared<Node>(key, this);
+      invalidate();
     }
     auto pvc(pv);
     pvc.erase(pvc.begin());
@@ -364,6 +378,7 @@ bool Node::handle<SET>(VPackSlice const& slice) {
     if (val.hasKey("op")) {  // No longer a keyword but a regular key "op"
       if (_children.find("op") == _children.end()) {
         _children["op"] = std::make_shared<Node>("op", this);
+        invalidate();
       }
       *(_children["op"]) = val.get("op");
     } else {  // Deeper down
@@ -605,6 +620,7 @@ bool Node::applieOp(VPackSlice const& slice) {
     if (_parent == nullptr) {  // root node
       _children.clear();
       _value.clear();
+      invalidate();
       return true;
     } else {
       return _parent->removeChild(_node_name);
@@ -631,6 +647,7 @@ bool Node::applieOp(VPackSlice const& slice) {
       if (_parent == nullptr) {  // root node
         _children.clear();
         _value.clear();
+        invalidate();
         return true;
       } else {
         return _parent->removeChild(_node_name);
@@ -666,6 +683,7 @@ bool Node::applies(VPackSlice const& slice) {
         auto found = _children.find(key);
         if (found == _children.end()) {
           _children[key] = std::make_shared<Node>(key, this);
+          invalidate();
         }
         _children[key]->applies(i.value);
       }
@@ -678,6 +696,38 @@ bool Node::applies(VPackSlice const& slice) {
 }
 
 void Node::toBuilder(Builder& builder, bool showHidden) const {
+  if (_serialized != nullptr && !showHidden) {
+    if (_serialized->size() > 0) {
+      builder.add(Slice(_serialized->data()));
+    }
+    return;
+  }
+
+  buildUncached(builder, showHidden);
+}
+
+Slice Node::serialized() const {
+  if (_serialized == nullptr) {
+    Builder tmp;
+    buildUncached(tmp, false);
+    _serialized = tmp.steal();
+  }
+
+  if (_serialized->size() == 0) {
+    return Slice::noneSlice();
+  }
+  return Slice(_serialized->data());
+}
+
+void Node::invalidate() {
+  Node* node = this;
+  while (node != nullptr) {
+    node->_serialized.reset();
+    node = node->_parent;
+  }
+}
+
+void Node::buildUncached(Builder& builder, bool showHidden) const {
   try {
     if (type() == NODE) {
       VPackObjectBuilder guard(&builder);
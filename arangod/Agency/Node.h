@@ -163,6 +163,14 @@ class Node {
   /// @brief Create Builder representing this store
   void toBuilder(Builder&, bool showHidden = false) const;
 
+  /// @brief Serialized representation of this node and below, as produced
+  ///        by toBuilder without hidden keys. The result is cached until
+  ///        this node or one below is modified, and is reused by toBuilder
+  ///        of any node above. Only to be used for frequently read subtrees,
+  ///        must be called under the store's lock. The slice is None for an
+  ///        empty leaf and is valid until the next modification.
+  Slice serialized() const;
+
   /// @brief Access children
   Children& children();
 
@@ -229,6 +237,12 @@ class Node {
 
   void rebuildVecBuf() const;
 
+  /// @brief Build representation without using or filling own cache
+  void buildUncached(Builder&, bool showHidden) const;
+
+  /// @brief Drop cached serialization of this node and all above
+  void invalidate();
+
   std::string _node_name;  ///< @brief my name
   Node* _parent;           ///< @brief parent
   Store* _store;           ///< @brief Store
@@ -238,6 +252,7 @@ class Node {
   mutable Buffer<uint8_t> _vecBuf;
   mutable bool _vecBufDirty;
   bool _isArray;
+  mutable std::shared_ptr<Buffer<uint8_t>> _serialized; ///< @brief see serialized()
 };
 
 inline std::ostream& operator<<(std::ostream& o, Node const& n) {
@@ -183,6 +183,16 @@ RestStatus RestAgencyPrivHandler::execute() {
           result.add("active",
                      _agent->config().activeAgentsToBuilder()->slice());
         }
+      } else if (suffixes[0] == "readIndex") {
+        if (_request->requestType() != rest::RequestType::GET) {
+          return reportMethodNotAllowed();
+        }
+        arangodb::consensus::index_t index = 0;
+        if (!_agent->readIndex(index)) {
+          generateError(rest::ResponseCode::SERVICE_UNAVAILABLE, 503);
+          return RestStatus::DONE;
+        }
+        result.add("readIndex", VPackValue(index));
       } else if (suffixes[0] == "inform") {
         query_t query = _request->toVelocyPackBuilderPtr();
         try {
@@ -84,20 +84,74 @@ inline static std::string stringify(arangodb::consensus::index_t index) {
   return i_str.str();
 }
 
+/// Write a full snapshot after this many incremental ones
+static size_t const fullCompactionInterval = 10;
+
+/// Split the tree of a read DB dump into the subtrees which are compared
+/// between snapshots: the children of the top level nodes, e.g. "arango/Plan",
+/// and top level values and empty nodes as a whole
+void State::decompose(Slice const& tree,
+                      std::map<std::string, Slice>& result) {
+  for (auto const& top : VPackObjectIterator(tree)) {
+    std::string name = top.key.copyString();
+    if (top.value.isObject() && top.value.length() > 0) {
+      for (auto const& sub : VPackObjectIterator(top.value)) {
+        result[name + "/" + sub.key.copyString()] = sub.value;
+      }
+    } else {
+      result[name] = top.value;
+    }
+  }
+}
+
+/// Rebuild the tree of a read DB dump from its subtrees
+void State::compose(std::map<std::string, Slice> const& subtrees,
+                    Builder& builder) {
+  VPackObjectBuilder guard(&builder);
+  bool open = false;
+  std::string top;
+  for (auto const& it : subtrees) {
+    size_t pos = it.first.find('/');
+    if (open &&
+        (pos == std::string::npos || it.first.compare(0, pos, top) != 0)) {
+      builder.close();
+      open = false;
+    }
+    if (pos == std::string::npos) {
+      builder.add(it.first, it.second);
+      continue;
+    }
+    if (!open) {
+      top = it.first.substr(0, pos);
+      builder.add(top, VPackValue(VPackValueType::Object));
+      open = true;
+    }
+    builder.add(it.first.substr(pos + 1), it.second);
+  }
+  if (open) {
+    builder.close();
+  }
+}
+
 /// Persist one entry
+void State::buildLogDocument(Builder& body, arangodb::consensus::index_t index,
+                             term_t term,
+                             arangodb::velocypack::Slice const& entry,
+                             std::string const& clientId) const {
+  VPackObjectBuilder b(&body);
+  body.add("_key", Value(stringify(index)));
+  body.add("term", Value(term));
+  body.add("request", entry);
+  body.add("clientId", Value(clientId));
+  body.add("timestamp", Value(timestamp()));
+}
+
 bool State::persist(arangodb::consensus::index_t index, term_t term,
                     arangodb::velocypack::Slice const& entry,
                     std::string const& clientId) const {
 
   Builder body;
-  {
-    VPackObjectBuilder b(&body);
-    body.add("_key", Value(stringify(index)));
-    body.add("term", Value(term));
-    body.add("request", entry);
-    body.add("clientId", Value(clientId));
-    body.add("timestamp", Value(timestamp()));
-  }
+  buildLogDocument(body, index, term, entry, clientId);
   
   TRI_ASSERT(_vocbase != nullptr);
   auto transactionContext =
@@ -123,6 +177,46 @@ bool State::persist(arangodb::consensus::index_t index, term_t term,
   return (res == TRI_ERROR_NO_ERROR);
 }
 
+/// Save multiple log entries in one transaction, so that a batch of appended
+/// entries costs one commit (and one sync with waitForSync) instead of one
+/// per entry
+bool State::persist(arangodb::velocypack::Slice const& documents) const {
+  TRI_ASSERT(documents.isArray());
+
+  if (documents.length() == 0) {
+    return true;
+  }
+
+  TRI_ASSERT(_vocbase != nullptr);
+  auto transactionContext =
+    std::make_shared<transaction::StandaloneContext>(_vocbase);
+  SingleCollectionTransaction trx(
+    transactionContext, "log", AccessMode::Type::WRITE);
+  
+  int res = trx.begin();
+  if (res != TRI_ERROR_NO_ERROR) {
+    THROW_ARANGO_EXCEPTION(res);
+  }
+  
+  OperationResult result;
+  try {
+    result = trx.insert("log", documents, _options);
+
+    if (result.code == TRI_ERROR_NO_ERROR && !result.countErrorCodes.empty()) {
+      // an array insert reports the errors of single documents separately.
+      // the batch must be persisted completely or not at all
+      result.code = result.countErrorCodes.begin()->first;
+    }
+  } catch (std::exception const& e) {
+    LOG_TOPIC(ERR, Logger::AGENCY)
+      << "Failed to persist log entries:" << e.what();
+  }
+  
+  res = trx.finish(result.code);
+
+  return (res == TRI_ERROR_NO_ERROR);
+}
+
 
 /// Log transaction (leader)
 std::vector<arangodb::consensus::index_t> State::log(
@@ -142,6 +236,10 @@ std::vector<arangodb::consensus::index_t> State::log(
   TRI_ASSERT(slice.length() == applicable.size());
   
   MUTEX_LOCKER(mutexLocker, _logLock); 
+
+  // all entries of the batch are persisted together after the loop
+  Builder documents;
+  documents.openArray();
   
   for (auto const& i : VPackArrayIterator(slice)) {
 
@@ -168,12 +266,15 @@ std::vector<arangodb::consensus::index_t> State::log(
       _log.push_back(log_t(idx[j], term, buf, clientId));  // log to RAM
       _clientIdLookupTable.emplace(
         std::pair<std::string, arangodb::consensus::index_t>(clientId, idx[j]));
-      persist(idx[j], term, i[0], clientId);               // log to disk
+      buildLogDocument(documents, idx[j], term, i[0], clientId);
     }
     
     ++j;
   }
 
+  documents.close();
+  persist(documents.slice());                            // log to disk
+
   return idx;
   
 }
@@ -212,6 +313,10 @@ arangodb::consensus::index_t State::log(query_t const& transactions,
   MUTEX_LOCKER(mutexLocker, _logLock);  // log entries must stay in order
   std::string clientId;
 
+  // all entries of the batch are persisted together after the loop
+  Builder documents;
+  documents.openArray();
+
   for (size_t i = ndups; i < nqs; ++i) {
     VPackSlice slice = slices[i];
 
@@ -229,14 +334,22 @@ arangodb::consensus::index_t State::log(query_t const& transactions,
       _clientIdLookupTable.emplace(
         std::pair<std::string, arangodb::consensus::index_t>(clientId, idx));
 
-      // to disk
-      persist(idx, trm, slice.get("query"), clientId);
+      // to disk, after the loop
+      buildLogDocument(documents, idx, trm, slice.get("query"), clientId);
 
     } catch (std::exception const& e) {
       LOG_TOPIC(ERR, Logger::AGENCY) << e.what() << " " << __FILE__ << __LINE__;
     }
   }
 
+  documents.close();
+
+  try {
+    persist(documents.slice());
+  } catch (std::exception const& e) {
+    LOG_TOPIC(ERR, Logger::AGENCY) << e.what() << " " << __FILE__ << __LINE__;
+  }
+
   TRI_ASSERT(!_log.empty());
   return _log.back().index;
 }
@@ -535,9 +648,9 @@ bool State::loadCompacted() {
   bindVars->openObject();
   bindVars->close();
 
-  
+  // the last full snapshot and the incremental ones after it
   std::string const aql(
-      std::string("FOR c IN compact SORT c._key DESC LIMIT 1 RETURN c"));
+      std::string("FOR c IN compact SORT c._key RETURN c"));
   arangodb::aql::Query query(false, _vocbase, aql.c_str(), aql.size(), bindVars,
                              nullptr, arangodb::aql::PART_MAIN);
 
@@ -550,23 +663,90 @@ bool State::loadCompacted() {
   VPackSlice result = queryResult.result->slice();
 
   if (result.isArray() && result.length()) {
+    Builder merged;
+    CompactionChain chain;
+    if (!mergeCompacted(result, merged, chain)) {
+      LOG_TOPIC(ERR, Logger::AGENCY)
+        << "Found no full snapshot of the read DB in the compaction collection";
+      return true;
+    }
     MUTEX_LOCKER(logLock, _logLock);
-    for (auto const& i : VPackArrayIterator(result)) {
-      auto ii = i.resolveExternals();
-      buffer_t tmp = std::make_shared<arangodb::velocypack::Buffer<uint8_t>>();
-      (*_agent) = ii;
-      try {
-        _cur = std::stoul(ii.get("_key").copyString());
-      } catch (std::exception const& e) {
-        LOG_TOPIC(ERR, Logger::AGENCY) << e.what() << " " << __FILE__
-                                       << __LINE__;
-      }
+    (*_agent) = merged.slice();
+    _chain = std::move(chain);
+    try {
+      _cur = std::stoul(merged.slice().get("_key").copyString());
+    } catch (std::exception const& e) {
+      LOG_TOPIC(ERR, Logger::AGENCY) << e.what() << " " << __FILE__
+                                     << __LINE__;
     }
   }
 
   return true;
 }
 
+/// Merge full snapshot with the incremental ones after it
+bool State::mergeCompacted(Slice docs, Builder& result,
+                           CompactionChain& chain) {
+  size_t first = 0;
+  Slice base;
+  for (size_t i = 0; i < docs.length(); ++i) {
+    Slice doc = docs.at(i).resolveExternals();
+    if (doc.hasKey("readDB")) {
+      base = doc;
+      first = i;
+    }
+  }
+  if (base.isNone()) {
+    return false;
+  }
+
+  // readDB is [tree, timeTable, observerTable, observedTable], the
+  // incremental snapshots carry the three tables in full
+  std::map<std::string, Slice> subtrees;
+  decompose(base.get("readDB").at(0), subtrees);
+  Slice tables = base.get("readDB");
+  size_t offset = 1;
+  Slice last = base;
+
+  chain = CompactionChain();
+  chain.base = base.get(StaticStrings::KeyString).copyString();
+  chain.fullBytes = base.byteSize();
+
+  for (size_t i = first + 1; i < docs.length(); ++i) {
+    Slice doc = docs.at(i).resolveExternals();
+    Slice delta = doc.get("delta");
+    if (!delta.isObject() || !doc.get("base").isEqualString(chain.base)) {
+      continue;
+    }
+    for (auto const& path : VPackArrayIterator(delta.get("removed"))) {
+      subtrees.erase(path.copyString());
+    }
+    for (auto const& it : VPackObjectIterator(delta.get("subtrees"))) {
+      subtrees[it.key.copyString()] = it.value;
+    }
+    tables = delta.get("tables");
+    offset = 0;
+    last = doc;
+    ++chain.deltas;
+    chain.deltaBytes += doc.byteSize();
+  }
+
+  for (auto const& it : subtrees) {
+    chain.hashes.emplace(it.first, it.second.hash());
+  }
+
+  VPackObjectBuilder guard(&result);
+  result.add(StaticStrings::KeyString, last.get(StaticStrings::KeyString));
+  {
+    VPackArrayBuilder readDB(&result, "readDB");
+    compose(subtrees, result);
+    for (size_t i = offset; i < offset + 3; ++i) {
+      result.add(tables.at(i));
+    }
+  }
+
+  return true;
+}
 
 /// Load persisted configuration
 bool State::loadOrPersistConfiguration() {
@@ -713,8 +893,8 @@ bool State::find(arangodb::consensus::index_t prevIndex, term_t prevTerm) {
 }
 
 /// Log compaction
-bool State::compact(arangodb::consensus::index_t cind) {
-  bool saved = persistReadDB(cind);
+bool State::compact(arangodb::consensus::index_t cind, Store const& readDB) {
+  bool saved = persistReadDB(cind, readDB);
 
   if (saved) {
     compactVolatile(cind);
@@ -777,12 +957,15 @@ bool State::removeObsolete(arangodb::consensus::index_t cind) {
     bindVars->openObject();
     bindVars->close();
 
-    std::stringstream i_str;
-    i_str << std::setw(20) << std::setfill('0')
-          << -3 * _agent->config().compactionStepSize() + cind;
+    std::string key =
+        stringify(cind - 3 * _agent->config().compactionStepSize());
+    // keep the full snapshot the latest incremental ones are based on
+    if (!_chain.base.empty() && _chain.base < key) {
+      key = _chain.base;
+    }
 
     std::string const aql(std::string("FOR c IN compact FILTER c._key < \"") +
-                          i_str.str() + "\" REMOVE c IN compact");
+                          key + "\" REMOVE c IN compact");
 
     arangodb::aql::Query query(false, _vocbase, aql.c_str(), aql.size(),
                                bindVars, nullptr, arangodb::aql::PART_MAIN);
@@ -797,17 +980,18 @@ bool State::removeObsolete(arangodb::consensus::index_t cind) {
 
 
 /// Persist the globally commited truth
-bool State::persistReadDB(arangodb::consensus::index_t cind) {
+bool State::persistReadDB(arangodb::consensus::index_t cind,
+                          Store const& readDB) {
   if (checkCollection("compact")) {
+    Builder dump;
+    dump.openArray();
+    readDB.dumpToBuilder(dump);
+    dump.close();
+
     Builder store;
-    store.openObject();
-    store.add("readDB", VPackValue(VPackValueType::Array));
-    _agent->readDB().dumpToBuilder(store);
-    store.close();
-    std::stringstream i_str;
-    i_str << std::setw(20) << std::setfill('0') << cind;
-    store.add("_key", VPackValue(i_str.str()));
-    store.close();
+    CompactionChain next;
+    bool const full =
+        buildCompacted(stringify(cind), dump.slice(), _chain, store, next);
 
     TRI_ASSERT(_vocbase != nullptr);
     auto transactionContext =
@@ -824,13 +1008,93 @@ bool State::persistReadDB(arangodb::consensus::index_t cind) {
     auto result = trx.insert("compact", store.slice(), _options);
     res = trx.finish(result.code);
 
-    return (res == TRI_ERROR_NO_ERROR);
+    if (res != TRI_ERROR_NO_ERROR) {
+      return false;
+    }
+
+    _chain = std::move(next);
+
+    LOG_TOPIC(DEBUG, Logger::AGENCY)
+      << "Persisted " << (full ? "full" : "incremental")
+      << " snapshot of the read DB at " << cind << " ("
+      << store.slice().byteSize() << " bytes)";
+
+    return true;
   }
 
   LOG_TOPIC(ERR, Logger::AGENCY) << "Failed to persist read DB for compaction!";
   return false;
 }
 
+/// Build the compaction document of a read DB dump
+bool State::buildCompacted(std::string const& key, Slice dump,
+                           CompactionChain const& chain, Builder& store,
+                           CompactionChain& next) {
+  std::map<std::string, Slice> subtrees;
+  decompose(dump.at(0), subtrees);
+  std::unordered_map<std::string, uint64_t> hashes;
+  hashes.reserve(subtrees.size());
+  for (auto const& it : subtrees) {
+    hashes.emplace(it.first, it.second.hash());
+  }
+
+  store.clear();
+
+  if (!chain.base.empty() && chain.deltas + 1 < fullCompactionInterval) {
+    // only the subtrees changed since the last snapshot
+    store.openObject();
+    store.add(StaticStrings::KeyString, VPackValue(key));
+    store.add("base", VPackValue(chain.base));
+    store.add("delta", VPackValue(VPackValueType::Object));
+    store.add("subtrees", VPackValue(VPackValueType::Object));
+    for (auto const& it : subtrees) {
+      auto old = chain.hashes.find(it.first);
+      if (old == chain.hashes.end() || old->second != hashes[it.first]) {
+        store.add(it.first, it.second);
+      }
+    }
+    store.close();
+    store.add("removed", VPackValue(VPackValueType::Array));
+    for (auto const& it : chain.hashes) {
+      if (subtrees.find(it.first) == subtrees.end()) {
+        store.add(VPackValue(it.first));
+      }
+    }
+    store.close();
+    store.add("tables", VPackValue(VPackValueType::Array));
+    for (size_t i = 1; i < 4; ++i) {
+      store.add(dump.at(i));
+    }
+    store.close();
+    store.close();
+    store.close();
+
+    if (chain.deltaBytes + store.slice().byteSize() > chain.fullBytes) {
+      // loading would read more than a full snapshot, merge instead
+      store.clear();
+    }
+  }
+
+  bool const full = store.isEmpty();
+  if (full) {
+    store.openObject();
+    store.add("readDB", dump);
+    store.add(StaticStrings::KeyString, VPackValue(key));
+    store.close();
+
+    next = CompactionChain();
+    next.base = key;
+    next.fullBytes = store.slice().byteSize();
+  } else {
+    next = chain;
+    ++next.deltas;
+    next.deltaBytes += store.slice().byteSize();
+  }
+  next.hashes = std::move(hashes);
+
+  return full;
+}
+
 bool State::persistActiveAgents(query_t const& active, query_t const& pool) {
   auto bindVars = std::make_shared<VPackBuilder>();
   bindVars->openObject();
@@ -884,7 +1148,14 @@ query_t State::allLogs() const {
   everything->openObject();
 
   try {
-    everything->add("compact", compqResult.result->slice());
+    // the last snapshot merged from the persisted ones, if any
+    Builder merged;
+    CompactionChain chain;
+    if (mergeCompacted(compqResult.result->slice(), merged, chain)) {
+      everything->add("compact", merged.slice());
+    } else {
+      everything->add("compact", VPackSlice::emptyArraySlice());
+    }
   } catch (std::exception const&) {
     LOG_TOPIC(ERR, Logger::AGENCY)
       << "Failed to assemble compaction part of everything package";
@@ -34,6 +34,7 @@
 #include <deque>
 #include <functional>
 #include <map>
+#include <unordered_map>
 
 struct TRI_vocbase_t;
 
@@ -46,6 +47,7 @@ class QueryRegistry;
 namespace consensus {
 
 class Agent;
+class Store;
 
 /**
  * @brief State replica
@@ -121,8 +123,9 @@ class State {
     return os;
   }
 
-  /// @brief compact state machine
-  bool compact(arangodb::consensus::index_t cind);
+  /// @brief compact state machine. readDB is a copy of the read database,
+  ///        which is persisted without holding any of the agent's locks
+  bool compact(arangodb::consensus::index_t cind, Store const& readDB);
 
   /// @brief Remove RAFT conflicts. i.e. All indices, where higher term version
   ///        exists are overwritten
@@ -134,11 +137,64 @@ class State {
   /// @brief Get everything from the state machine
   query_t allLogs() const;
 
+  /// @brief The persisted snapshots since the last full one. Only used by
+  ///        the compactor and when loading
+  struct CompactionChain {
+    CompactionChain() : deltas(0), deltaBytes(0), fullBytes(0) {}
+
+    /// @brief _key of the last full snapshot, empty if there is none
+    std::string base;
+    /// @brief number and size of the incremental snapshots since then
+    size_t deltas;
+    size_t deltaBytes;
+    /// @brief size of the last full snapshot
+    size_t fullBytes;
+    /// @brief hashes of the persisted subtrees by path
+    std::unordered_map<std::string, uint64_t> hashes;
+  };
+
+  /// @brief Split the tree of a read DB dump into the subtrees which are
+  ///        compared between snapshots, by path, e.g. "arango/Plan"
+  static void decompose(
+      arangodb::velocypack::Slice const& tree,
+      std::map<std::string, arangodb::velocypack::Slice>& result);
+
+  /// @brief Rebuild the tree of a read DB dump from its subtrees
+  static void compose(
+      std::map<std::string, arangodb::velocypack::Slice> const& subtrees,
+      arangodb::velocypack::Builder& builder);
+
+  /// @brief Build the compaction document of the read DB dump
+  ///        [tree, timeTable, observerTable, observedTable] with the given
+  ///        _key. It only holds the subtrees changed since the snapshots in
+  ///        chain, unless a full one is due. next is the chain after the
+  ///        document was persisted. Returns whether the document is full
+  static bool buildCompacted(std::string const& key,
+                             arangodb::velocypack::Slice dump,
+                             CompactionChain const& chain,
+                             arangodb::velocypack::Builder& store,
+                             CompactionChain& next);
+
+  /// @brief Merge the compaction documents, sorted by _key, into the last
+  ///        snapshot {_key, readDB}. Returns false if there is no full one
+  static bool mergeCompacted(arangodb::velocypack::Slice docs,
+                             arangodb::velocypack::Builder& result,
+                             CompactionChain& chain);
+
  private:
   /// @brief Save currentTerm, votedFor, log entries
   bool persist(index_t, term_t, arangodb::velocypack::Slice const&,
                std::string const&) const;
 
+  /// @brief Build the document of a log entry for the log collection
+  void buildLogDocument(arangodb::velocypack::Builder&, index_t, term_t,
+                        arangodb::velocypack::Slice const&,
+                        std::string const&) const;
+
+  /// @brief Save multiple log entries in one transaction. documents is an
+  ///        array of log documents built with buildLogDocument
+  bool persist(arangodb::velocypack::Slice const& documents) const;
+
   bool saveCompacted();
 
   /// @brief Load collection from persistent store
@@ -168,8 +224,12 @@ class State {
   /// @brief Remove obsolete logs
   bool removeObsolete(arangodb::consensus::index_t cind);
 
-  /// @brief Persist read database
-  bool persistReadDB(arangodb::consensus::index_t cind);
+  /// @brief Persist read database, as a full snapshot or as the subtrees
+  ///        changed since the last one
+  bool persistReadDB(arangodb::consensus::index_t cind, Store const& readDB);
+
+  /// @brief Snapshots persisted since the last full one
+  CompactionChain _chain;
 
   /// @brief Our agent
   Agent* _agent;
@@ -484,14 +484,39 @@ bool Store::read(VPackSlice const& query, Builder& ret) const {
   auto cut = std::remove_if(query_strs.begin(), query_strs.end(), Empty());
   query_strs.erase(cut, query_strs.end());
 
-  // Create response tree
+  // Create response tree. existing subtrees are not copied node by node,
+  // but as their serialized form, which the nodes cache between changes
   Node copy("copy");
+  std::vector<std::vector<std::string>> copied;
   MUTEX_LOCKER(storeLocker, _storeLock); // Freeze KV-Store for read
   for (auto const path : query_strs) {
     std::vector<std::string> pv = split(path, '/');
     size_t e = _node.exists(pv).size();
     if (e == pv.size()) {  // existing
-      copy(pv) = _node(pv);
+      if (pv.empty()) {
+        // the root keeps its own copy, as hidden keys may be shown on the
+        // top level
+        copy(pv) = _node(pv);
+        continue;
+      }
+      bool covered = false;
+      for (auto const& c : copied) {
+        if (c.size() <= pv.size() &&
+            std::equal(c.begin(), c.end(), pv.begin())) {
+          covered = true;
+          break;
+        }
+      }
+      if (covered) {  // already contained in an earlier path
+        continue;
+      }
+      Slice value = _node(pv).serialized();
+      if (!value.isNone()) {
+        copy(pv) = value;
+      } else {
+        copy(pv);
+      }
+      copied.emplace_back(pv);
     } else {  // non-existing
       for (size_t i = 0; i < pv.size() - e + 1; ++i) {
         pv.pop_back();
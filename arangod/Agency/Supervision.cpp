@@ -23,6 +23,7 @@
 
 #include "Supervision.h"
 
+#include <cmath>
 #include <thread>
 
 #include "Agency/AddFollower.h"
@@ -52,6 +53,11 @@ Supervision::Supervision()
       _agent(nullptr),
       _snapshot("Supervision"),
       _transient("Transient"),
+      _snapshotIndex(0),
+      _haveSnapshot(false),
+      _planCheckedIndex(0),
+      _havePlanChecked(false),
+      _haveRebalanced(false),
       _frequency(1.),
       _gracePeriod(5.),
       _jobId(0),
@@ -68,6 +74,8 @@ static std::string const targetShortID = "/Target/MapUniqueToShortID/";
 static std::string const currentServersRegisteredPrefix =
     "/Current/ServersRegistered";
 static std::string const foxxmaster = "/Current/Foxxmaster";
+static std::string const rebalanceShardsPrefix = "/Target/RebalanceShards";
+static std::string const shardStatisticsPrefix = "/Sync/ShardStatistics/";
 
 // Upgrade agency, guarded by wakeUp
 void Supervision::upgradeAgency() {
@@ -415,7 +423,14 @@ bool Supervision::updateSnapshot() {
   }
   
   try {
-    _snapshot = _agent->readDB().get(_agencyPrefix);
+    // the commit index is fetched before copying, so a commit that happens
+    // in between only leads to one more copy in the next run
+    index_t const commitIndex = _agent->lastCommitted().first;
+    if (!_haveSnapshot || commitIndex != _snapshotIndex) {
+      _snapshot = _agent->readDB().get(_agencyPrefix);
+      _snapshotIndex = commitIndex;
+      _haveSnapshot = true;
+    }
     _transient = _agent->transient().get(_agencyPrefix);
   } catch (...) {}
   
@@ -466,13 +481,17 @@ void Supervision::run() {
       {
         MUTEX_LOCKER(locker, _lock);
 
+        auto const started = std::chrono::steady_clock::now();
         updateSnapshot();
+        auto const snapshotTaken = std::chrono::steady_clock::now();
+
         // mop: always do health checks so shutdown is able to detect if a server
         // failed otherwise
         if (_agent->leading()) {
           upgradeAgency();
           doChecks();
         }
+        auto const checked = std::chrono::steady_clock::now();
 
         if (isShuttingDown()) {
           handleShutdown();
@@ -484,6 +503,26 @@ void Supervision::run() {
             break;
           }
         }
+
+        auto const finished = std::chrono::steady_clock::now();
+        double const total =
+            std::chrono::duration<double>(finished - started).count();
+
+        LOG_TOPIC(TRACE, Logger::AGENCY)
+            << "supervision run took " << total << "s (snapshot: "
+            << std::chrono::duration<double>(snapshotTaken - started).count()
+            << "s, health checks: "
+            << std::chrono::duration<double>(checked - snapshotTaken).count()
+            << "s, jobs: "
+            << std::chrono::duration<double>(finished - checked).count()
+            << "s)";
+
+        if (total > _frequency) {
+          LOG_TOPIC(DEBUG, Logger::AGENCY)
+              << "supervision run took " << total
+              << "s, which is longer than its interval of " << _frequency
+              << "s";
+        }
       }
       _cv.wait(static_cast<uint64_t>(1000000 * _frequency));
     }
@@ -568,9 +607,20 @@ void Supervision::handleShutdown() {
 // Guarded by caller 
 bool Supervision::handleJobs() {
   // Do supervision
-  
-  shrinkCluster();
-  enforceReplication();
+
+  // shrinking and replication only depend on the snapshot. if it did not
+  // change since they last looked at the whole Plan, they would come to
+  // the same conclusion again
+  if (!_havePlanChecked || _planCheckedIndex != _snapshotIndex) {
+    shrinkCluster();
+    enforceReplication();
+    _planCheckedIndex = _snapshotIndex;
+    _havePlanChecked = true;
+  } else {
+    // only when the checks above have nothing new to look at, so that a
+    // job they created is visible in the snapshot before we add another
+    rebalanceShards();
+  }
   workJobs();
 
   return true;
@@ -715,6 +765,193 @@ void Supervision::enforceReplication() {
   
 }
 
+// Rebalance shards if applicable, guarded by caller
+void Supervision::rebalanceShards() {
+
+  auto const& todo = _snapshot(toDoPrefix).children();
+  auto const& pending = _snapshot(pendingPrefix).children();
+
+  if (!todo.empty() || !pending.empty()) { // This is low priority
+    return;
+  }
+
+  // Rebalancing is opt-in:
+  // /Target/RebalanceShards = {"enabled": true, "interval": <seconds between
+  // moves>, "threshold": <tolerated imbalance relative to the mean load>}
+  if (_snapshot.exists(rebalanceShardsPrefix).size() != 2) {
+    return;
+  }
+
+  double interval = 300.0;
+  double threshold = 0.2;
+  try {
+    Slice config = _snapshot(rebalanceShardsPrefix).slice();
+    if (!config.isObject() || !config.get("enabled").isTrue()) {
+      return;
+    }
+    if (config.get("interval").isNumber()) {
+      interval = config.get("interval").getNumber<double>();
+    }
+    if (config.get("threshold").isNumber()) {
+      threshold = config.get("threshold").getNumber<double>();
+    }
+  } catch (...) {
+    return;
+  }
+
+  auto const now = std::chrono::steady_clock::now();
+  if (_haveRebalanced &&
+      now - _lastRebalance < std::chrono::duration<double>(interval)) {
+    return;
+  }
+
+  // Statistics of all healthy servers, as reported by their heartbeats:
+  // shard -> {"size": documents, "rate": operations per second}
+  std::vector<std::string> servers;
+  std::unordered_map<std::string, Slice> statistics;
+  for (auto const& server : Job::availableServers(_snapshot)) {
+    if (serverHealth(server) != HEALTH_STATUS_GOOD) {
+      continue;
+    }
+    Slice stats;
+    try {
+      stats = _transient(shardStatisticsPrefix + server).slice();
+    } catch (...) {}
+    if (!stats.isObject()) {
+      // Cannot judge the load without the statistics of every server
+      LOG_TOPIC(DEBUG, Logger::AGENCY)
+        << "No shard statistics from " << server << ", not rebalancing";
+      return;
+    }
+    servers.push_back(server);
+    statistics.emplace(server, stats);
+  }
+
+  if (servers.size() < 2) {
+    return;
+  }
+
+  double totalSize = 0.0, totalRate = 0.0;
+  for (auto const& it : statistics) {
+    for (auto const& shard : VPackObjectIterator(it.second)) {
+      if (shard.value.isObject()) {
+        if (shard.value.get("size").isNumber()) {
+          totalSize += shard.value.get("size").getNumber<double>();
+        }
+        if (shard.value.get("rate").isNumber()) {
+          totalRate += shard.value.get("rate").getNumber<double>();
+        }
+      }
+    }
+  }
+
+  // The load of a shard copy is its share of all documents plus its share
+  // of all operations in the cluster
+  auto shardLoad = [&](std::string const& server, std::string const& shard) {
+    Slice s = statistics[server].get(shard);
+    double load = 0.0;
+    if (s.isObject()) {
+      if (totalSize > 0.0 && s.get("size").isNumber()) {
+        load += s.get("size").getNumber<double>() / totalSize;
+      }
+      if (totalRate > 0.0 && s.get("rate").isNumber()) {
+        load += s.get("rate").getNumber<double>() / totalRate;
+      }
+    }
+    return load;
+  };
+
+  std::unordered_map<std::string, double> loads;
+  double mean = 0.0;
+  for (auto const& server : servers) {
+    double load = 0.0;
+    for (auto const& shard : VPackObjectIterator(statistics[server])) {
+      load += shardLoad(server, shard.key.copyString());
+    }
+    loads.emplace(server, load);
+    mean += load;
+  }
+  mean /= static_cast<double>(servers.size());
+
+  std::string hot = servers[0], cold = servers[0];
+  for (auto const& server : servers) {
+    if (loads[server] > loads[hot]) {
+      hot = server;
+    }
+    if (loads[server] < loads[cold]) {
+      cold = server;
+    }
+  }
+
+  double const difference = loads[hot] - loads[cold];
+  if (difference <= threshold * mean) {
+    return;
+  }
+
+  // Find the shard on the hot server, whose move to the cold server brings
+  // both closest to each other. Shards following a prototype are moved
+  // along with it, so they count for the prototype
+  std::string database, collection, shard;
+  double best = difference;
+  for (auto const& db_ : _snapshot(planColPrefix).children()) {
+    for (auto const& col_ : db_.second->children()) {
+      auto const& col = *(col_.second);
+
+      try {
+        if (!col("distributeShardsLike").slice().copyString().empty()) {
+          continue;
+        }
+      } catch (...) {}
+
+      try {
+        if (col("replicationFactor").slice().getUInt() == 0) {
+          continue; // satellite collections are everywhere
+        }
+      } catch (...) {}
+
+      for (auto const& shard_ : col("shards").children()) {
+        bool onHot = false, onCold = false;
+        for (auto const& i : VPackArrayIterator(shard_.second->slice())) {
+          onHot |= (i.copyString() == hot);
+          onCold |= (i.copyString() == cold);
+        }
+        if (!onHot || onCold ||
+            _snapshot.exists(blockedShardsPrefix + shard_.first).size() == 3) {
+          continue;
+        }
+
+        double load = shardLoad(hot, shard_.first);
+        for (auto const& clone :
+               Job::clones(_snapshot, db_.first, col_.first, shard_.first)) {
+          load += shardLoad(hot, clone.shard);
+        }
+
+        double const remaining = std::abs(difference - 2.0 * load);
+        if (load > 0.0 && remaining < best) {
+          best = remaining;
+          database = db_.first;
+          collection = col_.first;
+          shard = shard_.first;
+        }
+      }
+    }
+  }
+
+  if (shard.empty()) {
+    return;
+  }
+
+  LOG_TOPIC(INFO, Logger::AGENCY)
+    << "Rebalancing: moving shard " << shard << " from " << hot << " to "
+    << cold << ", loads " << loads[hot] << " and " << loads[cold];
+
+  MoveShard(_snapshot, _agent, std::to_string(_jobId++), "supervision",
+            _agencyPrefix, database, collection, shard, hot, cold);
+
+  _lastRebalance = now;
+  _haveRebalanced = true;
+}
+
 // Shrink cluster if applicable, guarded by caller
 void Supervision::shrinkCluster() {
 
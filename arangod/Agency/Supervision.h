@@ -122,6 +122,10 @@ class Supervision : public arangodb::Thread {
   /// @brief Check for inconsistencies in replication factor vs dbs entries
   void enforceReplication();
 
+  /// @brief Move a shard from the most to the least loaded DB server, if
+  /// enabled in /Target/RebalanceShards and the load is uneven
+  void rebalanceShards();
+
   /// @brief Update agency prefix from agency itself
   bool updateAgencyPrefix(size_t nTries = 10, double intervalSec = 1.0);
 
@@ -162,6 +166,23 @@ class Supervision : public arangodb::Thread {
   Node _snapshot;
   Node _transient;
 
+  /// @brief commit index of the agent at the time _snapshot was taken. the
+  /// snapshot is only copied again when the agent has committed something
+  /// since then
+  index_t _snapshotIndex;
+  bool _haveSnapshot;
+
+  /// @brief snapshot index at which shrinkCluster and enforceReplication
+  /// last evaluated the whole Plan. they only depend on the snapshot, so
+  /// they are skipped as long as it did not change
+  index_t _planCheckedIndex;
+  bool _havePlanChecked;
+
+  /// @brief time rebalanceShards last scheduled a move, moves are at least
+  /// the configured interval apart
+  std::chrono::steady_clock::time_point _lastRebalance;
+  bool _haveRebalanced;
+
   arangodb::basics::ConditionVariable _cv; /**< @brief Control if thread
                                               should run */
 
@@ -62,6 +62,16 @@ std::unique_ptr<Aggregator> Aggregator::fromTypeString(transaction::Methods* trx
   if (type == "STDDEV_SAMPLE") {
     return std::make_unique<AggregatorStddev>(trx, false);
   }
+  // internal aggregate functions, used for aggregating in the cluster
+  if (type == "SUM_STEP2") {
+    return std::make_unique<AggregatorSumStep2>(trx);
+  }
+  if (type == "AVERAGE_STEP1") {
+    return std::make_unique<AggregatorAverageStep1>(trx);
+  }
+  if (type == "AVERAGE_STEP2") {
+    return std::make_unique<AggregatorAverageStep2>(trx);
+  }
 
   // aggregator function name should have been validated before
   THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL, "invalid aggregator type");
@@ -99,6 +109,36 @@ bool Aggregator::requiresInput(std::string const& type) {
   return true;
 }
 
+/// @brief the aggregate functions to use on the DB servers and on the
+/// coordinator when splitting an aggregation into two steps. returns
+/// false if the aggregate function cannot be split
+bool Aggregator::splitIntoSteps(std::string const& type, std::string& step1,
+                                std::string& step2) {
+  if (type == "LENGTH" || type == "COUNT") {
+    // count per shard, then add up the counts
+    step1 = "LENGTH";
+    step2 = "SUM";
+    return true;
+  }
+  if (type == "MIN" || type == "MAX") {
+    step1 = type;
+    step2 = type;
+    return true;
+  }
+  if (type == "SUM") {
+    step1 = "SUM";
+    step2 = "SUM_STEP2";
+    return true;
+  }
+  if (type == "AVERAGE" || type == "AVG") {
+    step1 = "AVERAGE_STEP1";
+    step2 = "AVERAGE_STEP2";
+    return true;
+  }
+  // VARIANCE and STDDEV are not split
+  return false;
+}
+
 void AggregatorLength::reset() { count = 0; }
 
 void AggregatorLength::reduce(AqlValue const&) {
@@ -120,9 +160,11 @@ void AggregatorMin::reset() { value.erase(); }
 void AggregatorMin::reduce(AqlValue const& cmpValue) {
   if (value.isEmpty() ||
       (!cmpValue.isNull(true) &&
-       AqlValue::Compare(trx, value, cmpValue, true) > 0)) {
+       (value.isNull(true) ||
+        AqlValue::Compare(trx, value, cmpValue, true) > 0))) {
     // the value `null` itself will not be used in MIN() to compare lower than
-    // e.g. value `false`
+    // e.g. value `false`. a `null` seen first is replaced by the first
+    // non-null value, so the result does not depend on the input order
     value.destroy();
     value = cmpValue.clone();
   }
@@ -235,6 +277,115 @@ AqlValue AggregatorAverage::stealValue() {
   return temp;
 }
 
+void AggregatorSumStep2::reset() {
+  sum = 0.0;
+  invalid = false;
+}
+
+void AggregatorSumStep2::reduce(AqlValue const& cmpValue) {
+  if (!invalid && cmpValue.isNumber()) {
+    double const number = cmpValue.toDouble(trx);
+    if (!std::isnan(number) && number != HUGE_VAL && number != -HUGE_VAL) {
+      sum += number;
+      return;
+    }
+  }
+
+  // the partial sum of a DB server was null, or not a valid number
+  invalid = true;
+}
+
+AqlValue AggregatorSumStep2::stealValue() {
+  if (invalid || std::isnan(sum) || sum == HUGE_VAL || sum == -HUGE_VAL) {
+    return AqlValue(arangodb::basics::VelocyPackHelper::NullValue());
+  }
+
+  builder.clear();
+  builder.add(VPackValue(sum));
+  AqlValue temp(builder.slice());
+  reset();
+  return temp;
+}
+
+void AggregatorAverageStep1::reset() {
+  count = 0;
+  sum = 0.0;
+  invalid = false;
+}
+
+void AggregatorAverageStep1::reduce(AqlValue const& cmpValue) {
+  if (!invalid) {
+    if (cmpValue.isNull(true)) {
+      // ignore `null` values here
+      return;
+    }
+    if (cmpValue.isNumber()) {
+      double const number = cmpValue.toDouble(trx);
+      if (!std::isnan(number) && number != HUGE_VAL &&
+          number != -HUGE_VAL) {
+        sum += number;
+        ++count;
+        return;
+      }
+    }
+  }
+
+  invalid = true;
+}
+
+AqlValue AggregatorAverageStep1::stealValue() {
+  if (invalid || std::isnan(sum) || sum == HUGE_VAL || sum == -HUGE_VAL) {
+    return AqlValue(arangodb::basics::VelocyPackHelper::NullValue());
+  }
+
+  builder.clear();
+  builder.openArray();
+  builder.add(VPackValue(sum));
+  builder.add(VPackValue(count));
+  builder.close();
+  AqlValue temp(builder.slice());
+  reset();
+  return temp;
+}
+
+void AggregatorAverageStep2::reset() {
+  count = 0;
+  sum = 0.0;
+  invalid = false;
+}
+
+void AggregatorAverageStep2::reduce(AqlValue const& cmpValue) {
+  if (!invalid) {
+    AqlValueMaterializer materializer(trx);
+    VPackSlice s = materializer.slice(cmpValue, false);
+
+    if (s.isArray() && s.length() == 2 && s.at(0).isNumber() &&
+        s.at(1).isNumber()) {
+      sum += s.at(0).getNumericValue<double>();
+      count += s.at(1).getNumericValue<uint64_t>();
+      return;
+    }
+  }
+
+  // the partial result of a DB server was null, i.e. invalid
+  invalid = true;
+}
+
+AqlValue AggregatorAverageStep2::stealValue() {
+  if (invalid || count == 0 || std::isnan(sum) || sum == HUGE_VAL ||
+      sum == -HUGE_VAL) {
+    return AqlValue(arangodb::basics::VelocyPackHelper::NullValue());
+  }
+
+  TRI_ASSERT(count > 0);
+  
+  builder.clear();
+  builder.add(VPackValue(sum / count));
+  AqlValue temp(builder.slice());
+  reset();
+  return temp;
+}
+
 void AggregatorVarianceBase::reset() {
   count = 0;
   sum = 0.0;
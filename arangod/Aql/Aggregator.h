@@ -57,6 +57,12 @@ struct Aggregator {
   static bool isSupported(std::string const&);
   static bool requiresInput(std::string const&);
 
+  /// @brief the aggregate functions to use on the DB servers and on the
+  /// coordinator when splitting an aggregation into two steps. returns
+  /// false if the aggregate function cannot be split
+  static bool splitIntoSteps(std::string const& type, std::string& step1,
+                             std::string& step2);
+
   transaction::Methods* trx;
 
   arangodb::velocypack::Builder builder;
@@ -136,6 +142,55 @@ struct AggregatorAverage final : public Aggregator {
   bool invalid;
 };
 
+/// @brief second step of a distributed SUM: adds up the partial sums of the
+/// DB servers. a partial sum of null means that an invalid value was summed
+struct AggregatorSumStep2 final : public Aggregator {
+  explicit AggregatorSumStep2(transaction::Methods* trx)
+      : Aggregator(trx), sum(0.0), invalid(false) {}
+
+  char const* name() const override final { return "SUM_STEP2"; }
+
+  void reset() override final;
+  void reduce(AqlValue const&) override final;
+  AqlValue stealValue() override final;
+
+  double sum;
+  bool invalid;
+};
+
+/// @brief first step of a distributed AVERAGE: produces [sum, count]
+struct AggregatorAverageStep1 final : public Aggregator {
+  explicit AggregatorAverageStep1(transaction::Methods* trx)
+      : Aggregator(trx), count(0), sum(0.0), invalid(false) {}
+
+  char const* name() const override final { return "AVERAGE_STEP1"; }
+
+  void reset() override final;
+  void reduce(AqlValue const&) override final;
+  AqlValue stealValue() override final;
+
+  uint64_t count;
+  double sum;
+  bool invalid;
+};
+
+/// @brief second step of a distributed AVERAGE: combines the [sum, count]
+/// pairs produced by AVERAGE_STEP1
+struct AggregatorAverageStep2 final : public Aggregator {
+  explicit AggregatorAverageStep2(transaction::Methods* trx)
+      : Aggregator(trx), count(0), sum(0.0), invalid(false) {}
+
+  char const* name() const override final { return "AVERAGE_STEP2"; }
+
+  void reset() override final;
+  void reduce(AqlValue const&) override final;
+  AqlValue stealValue() override final;
+
+  uint64_t count;
+  double sum;
+  bool invalid;
+};
+
 struct AggregatorVarianceBase : public Aggregator {
   AggregatorVarianceBase(transaction::Methods* trx, bool population)
       : Aggregator(trx),
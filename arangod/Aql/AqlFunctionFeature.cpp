@@ -216,7 +216,7 @@ void AqlFunctionFeature::addTypeCheckFunctions() {
        &Functions::IsObject});
 
   add({"IS_DATESTRING", "AQL_IS_DATESTRING", ".", true, true, false, true,
-       true});
+       true, &Functions::IsDateString});
   add({"TYPENAME", "AQL_TYPENAME", ".", true, true, false, true, true,
        &Functions::Typename});
 }
@@ -242,10 +242,14 @@ void AqlFunctionFeature::addStringFunctions() {
        &Functions::Concat});
   add({"CONCAT_SEPARATOR", "AQL_CONCAT_SEPARATOR", "s,szl|+", true, true, false,
        true, true, &Functions::ConcatSeparator});
-  add({"CHAR_LENGTH", "AQL_CHAR_LENGTH", "s", true, true, false, true, true});
-  add({"LOWER", "AQL_LOWER", "s", true, true, false, true, true});
-  add({"UPPER", "AQL_UPPER", "s", true, true, false, true, true});
-  add({"SUBSTRING", "AQL_SUBSTRING", "s,n|n", true, true, false, true, true});
+  add({"CHAR_LENGTH", "AQL_CHAR_LENGTH", "s", true, true, false, true, true,
+       &Functions::CharLength});
+  add({"LOWER", "AQL_LOWER", "s", true, true, false, true, true,
+       &Functions::Lower});
+  add({"UPPER", "AQL_UPPER", "s", true, true, false, true, true,
+       &Functions::Upper});
+  add({"SUBSTRING", "AQL_SUBSTRING", "s,n|n", true, true, false, true, true,
+       &Functions::Substring});
   add({"CONTAINS", "AQL_CONTAINS", "s,s|b", true, true, false, true, true,
        &Functions::Contains});
   add({"LIKE", "AQL_LIKE", "s,r|b", true, true, false, true, true,
@@ -254,18 +258,24 @@ void AqlFunctionFeature::addStringFunctions() {
        &Functions::RegexTest});
   add({"REGEX_REPLACE", "AQL_REGEX_REPLACE", "s,r,s|b", true, true, false, true,
        true, &Functions::RegexReplace});
-  add({"LEFT", "AQL_LEFT", "s,n", true, true, false, true, true});
-  add({"RIGHT", "AQL_RIGHT", "s,n", true, true, false, true, true});
-  add({"TRIM", "AQL_TRIM", "s|ns", true, true, false, true, true});
-  add({"LTRIM", "AQL_LTRIM", "s|s", true, true, false, true, true});
-  add({"RTRIM", "AQL_RTRIM", "s|s", true, true, false, true, true});
+  add({"LEFT", "AQL_LEFT", "s,n", true, true, false, true, true,
+       &Functions::Left});
+  add({"RIGHT", "AQL_RIGHT", "s,n", true, true, false, true, true,
+       &Functions::Right});
+  add({"TRIM", "AQL_TRIM", "s|ns", true, true, false, true, true,
+       &Functions::Trim});
+  add({"LTRIM", "AQL_LTRIM", "s|s", true, true, false, true, true,
+       &Functions::LTrim});
+  add({"RTRIM", "AQL_RTRIM", "s|s", true, true, false, true, true,
+       &Functions::RTrim});
   add({"FIND_FIRST", "AQL_FIND_FIRST", "s,s|zn,zn", true, true, false, true,
-       true});
+       true, &Functions::FindFirst});
   add({"FIND_LAST", "AQL_FIND_LAST", "s,s|zn,zn", true, true, false, true,
-       true});
-  add({"SPLIT", "AQL_SPLIT", "s|sl,n", true, true, false, true, true});
+       true, &Functions::FindLast});
+  add({"SPLIT", "AQL_SPLIT", "s|sl,n", true, true, false, true, true,
+       &Functions::Split});
   add({"SUBSTITUTE", "AQL_SUBSTITUTE", "s,las|lsn,n", true, true, false, true,
-       true});
+       true, &Functions::Substitute});
   add({"MD5", "AQL_MD5", "s", true, true, false, true, true, &Functions::Md5});
   add({"SHA1", "AQL_SHA1", "s", true, true, false, true, true,
        &Functions::Sha1});
@@ -366,8 +376,9 @@ void AqlFunctionFeature::addListFunctions() {
        &Functions::SortedUnique});
   add({"SLICE", "AQL_SLICE", "l,n|n", true, true, false, true, true,
        &Functions::Slice});
+  // note: REVERSE() can be applied on strings, too
   add({"REVERSE", "AQL_REVERSE", "ls", true, true, false, true,
-       true});  // note: REVERSE() can be applied on strings, too
+       true, &Functions::Reverse});
   add({"FIRST", "AQL_FIRST", "l", true, true, false, true, true,
        &Functions::First});
   add({"LAST", "AQL_LAST", "l", true, true, false, true, true,
@@ -409,14 +420,16 @@ void AqlFunctionFeature::addDocumentFunctions() {
        true, true, &Functions::MergeRecursive});
   add({"DOCUMENT", "AQL_DOCUMENT", "h.|.", false, false, true, false, true,
        &Functions::Document, NotInCluster});
-  add({"MATCHES", "AQL_MATCHES", ".,l|b", true, true, false, true, true});
+  add({"MATCHES", "AQL_MATCHES", ".,l|b", true, true, false, true, true,
+       &Functions::Matches});
   add({"UNSET", "AQL_UNSET", "a,sl|+", true, true, false, true, true,
        &Functions::Unset});
   add({"UNSET_RECURSIVE", "AQL_UNSET_RECURSIVE", "a,sl|+", true, true, false,
        true, true, &Functions::UnsetRecursive});
   add({"KEEP", "AQL_KEEP", "a,sl|+", true, true, false, true, true,
        &Functions::Keep});
-  add({"TRANSLATE", "AQL_TRANSLATE", ".,a|.", true, true, false, true, true});
+  add({"TRANSLATE", "AQL_TRANSLATE", ".,a|.", true, true, false, true, true,
+       &Functions::Translate});
   add({"ZIP", "AQL_ZIP", "l,l", true, true, false, true, true,
        &Functions::Zip});
   add({"JSON_STRINGIFY", "AQL_JSON_STRINGIFY", ".", true, true, false, true,
@@ -437,31 +450,38 @@ void AqlFunctionFeature::addGeoFunctions() {
 
 void AqlFunctionFeature::addDateFunctions() {
   // date functions
-  add({"DATE_NOW", "AQL_DATE_NOW", "", false, false, false, true, true});
+  add({"DATE_NOW", "AQL_DATE_NOW", "", false, false, false, true, true,
+       &Functions::DateNow});
   add({"DATE_TIMESTAMP", "AQL_DATE_TIMESTAMP", "ns|ns,ns,ns,ns,ns,ns", true,
-       true, false, true, true});
+       true, false, true, true, &Functions::DateTimestamp});
   add({"DATE_ISO8601", "AQL_DATE_ISO8601", "ns|ns,ns,ns,ns,ns,ns", true, true,
-       false, true, true});
+       false, true, true, &Functions::DateIso8601});
   add({"DATE_DAYOFWEEK", "AQL_DATE_DAYOFWEEK", "ns", true, true, false, true,
-       true});
-  add({"DATE_YEAR", "AQL_DATE_YEAR", "ns", true, true, false, true, true});
-  add({"DATE_MONTH", "AQL_DATE_MONTH", "ns", true, true, false, true, true});
-  add({"DATE_DAY", "AQL_DATE_DAY", "ns", true, true, false, true, true});
-  add({"DATE_HOUR", "AQL_DATE_HOUR", "ns", true, true, false, true, true});
-  add({"DATE_MINUTE", "AQL_DATE_MINUTE", "ns", true, true, false, true, true});
-  add({"DATE_SECOND", "AQL_DATE_SECOND", "ns", true, true, false, true, true});
+       true, &Functions::DateDayOfWeek});
+  add({"DATE_YEAR", "AQL_DATE_YEAR", "ns", true, true, false, true, true,
+       &Functions::DateYear});
+  add({"DATE_MONTH", "AQL_DATE_MONTH", "ns", true, true, false, true, true,
+       &Functions::DateMonth});
+  add({"DATE_DAY", "AQL_DATE_DAY", "ns", true, true, false, true, true,
+       &Functions::DateDay});
+  add({"DATE_HOUR", "AQL_DATE_HOUR", "ns", true, true, false, true, true,
+       &Functions::DateHour});
+  add({"DATE_MINUTE", "AQL_DATE_MINUTE", "ns", true, true, false, true, true,
+       &Functions::DateMinute});
+  add({"DATE_SECOND", "AQL_DATE_SECOND", "ns", true, true, false, true, true,
+       &Functions::DateSecond});
   add({"DATE_MILLISECOND", "AQL_DATE_MILLISECOND", "ns", true, true, false,
-       true, true});
+       true, true, &Functions::DateMillisecond});
   add({"DATE_DAYOFYEAR", "AQL_DATE_DAYOFYEAR", "ns", true, true, false, true,
-       true});
+       true, &Functions::DateDayOfYear});
   add({"DATE_ISOWEEK", "AQL_DATE_ISOWEEK", "ns", true, true, false, true,
-       true});
+       true, &Functions::DateIsoWeek});
   add({"DATE_LEAPYEAR", "AQL_DATE_LEAPYEAR", "ns", true, true, false, true,
-       true});
+       true, &Functions::DateLeapYear});
   add({"DATE_QUARTER", "AQL_DATE_QUARTER", "ns", true, true, false, true,
-       true});
+       true, &Functions::DateQuarter});
   add({"DATE_DAYS_IN_MONTH", "AQL_DATE_DAYS_IN_MONTH", "ns", true, true, false,
-       true, true});
+       true, true, &Functions::DateDaysInMonth});
   add({"DATE_ADD", "AQL_DATE_ADD", "ns,ns|n", true, true, false, true, true});
   add({"DATE_SUBTRACT", "AQL_DATE_SUBTRACT", "ns,ns|n", true, true, false, true,
        true});
@@ -475,7 +495,8 @@ void AqlFunctionFeature::addDateFunctions() {
 
 void AqlFunctionFeature::addMiscFunctions() {
   // misc functions
-  add({"FAIL", "AQL_FAIL", "|s", false, false, true, true, true});
+  add({"FAIL", "AQL_FAIL", "|s", false, false, true, true, true,
+       &Functions::Fail});
   add({"PASSTHRU", "AQL_PASSTHRU", ".", false, false, false, true, true,
        &Functions::Passthru});
   add({"NOOPT", "AQL_PASSTHRU", ".", false, false, false, true, true,
@@ -483,7 +504,8 @@ void AqlFunctionFeature::addMiscFunctions() {
   add({"V8", "AQL_PASSTHRU", ".", false, true, false, true, true});
   add({"TEST_INTERNAL", "AQL_TEST_INTERNAL", "s,.", false, false, false, true,
        false});
-  add({"SLEEP", "AQL_SLEEP", "n", false, false, true, true, true});
+  add({"SLEEP", "AQL_SLEEP", "n", false, false, true, true, true,
+       &Functions::Sleep});
   add({"COLLECTIONS", "AQL_COLLECTIONS", "", false, false, true, false, true});
   add({"NOT_NULL", "AQL_NOT_NULL", ".|+", true, true, false, true, true,
        &Functions::NotNull});
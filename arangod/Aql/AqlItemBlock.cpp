@@ -89,6 +89,125 @@ AqlItemBlock::AqlItemBlock(ResourceMonitor* resourceMonitor, VPackSlice const sl
   }
 
   // Now put in the data:
+  try {
+    if (slice.get("columns").isArray()) {
+      fromColumns(slice);
+    } else {
+      // sent by an older server
+      fromRawVelocyPack(slice);
+    }
+  } catch (...) {
+    decreaseMemoryUsage(sizeof(AqlValue) * _nrItems * _nrRegs);
+    throw;
+  }
+}
+
+/// @brief read the columnar format written by toVelocyPack. every
+/// distinct value is copied once and shared by all rows referring to it,
+/// scalar columns are stored inline, so that no allocation is needed
+/// per row
+void AqlItemBlock::fromColumns(VPackSlice const slice) {
+  VPackSlice columns = slice.get("columns");
+  VPackSlice values = slice.get("values");
+  VPackSlice ranges = slice.get("ranges");
+
+  std::vector<AqlValue> dictionary;
+  if (values.isArray()) {
+    dictionary.resize(static_cast<size_t>(values.length()));
+  }
+  std::vector<AqlValue> rangeValues;
+  if (ranges.isArray()) {
+    rangeValues.resize(static_cast<size_t>(ranges.length()));
+  }
+
+  // put the value with the given reference into the block, the first use
+  // of a value creates it
+  auto set = [&](size_t row, RegisterId column, int64_t ref) {
+    AqlValue* a;
+    VPackSlice source;
+    if (ref > 0 && static_cast<size_t>(ref) <= dictionary.size()) {
+      a = &dictionary[static_cast<size_t>(ref - 1)];
+      if (a->isEmpty()) {
+        source = values.at(static_cast<size_t>(ref - 1));
+        *a = AqlValue(source);
+      }
+    } else if (ref < 0 && static_cast<size_t>(-ref) <= rangeValues.size()) {
+      a = &rangeValues[static_cast<size_t>(-ref - 1)];
+      if (a->isEmpty()) {
+        source = ranges.at(static_cast<size_t>(-ref - 1));
+        *a = AqlValue(source.at(0).getNumericValue<int64_t>(),
+                      source.at(1).getNumericValue<int64_t>());
+      }
+    } else {
+      THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL,
+                                     "found undefined data value");
+    }
+    if (source.isNone()) {
+      // already put into the block elsewhere
+      setValue(row, column, *a);
+      return;
+    }
+    try {
+      setValue(row, column, *a);
+    } catch (...) {
+      a->destroy();
+      throw;
+    }
+  };
+
+  try {
+    if (columns.length() != _nrRegs) {
+      THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL,
+                                     "columns must contain nrRegs entries");
+    }
+
+    RegisterId column = 0;
+    for (auto const& c : VPackArrayIterator(columns)) {
+      if (c.isNumber()) {
+        // the same value in all rows
+        int64_t ref = c.getNumericValue<int64_t>();
+        if (ref != 0) {
+          for (size_t i = 0; i < _nrItems; i++) {
+            set(i, column, ref);
+          }
+        }
+        column++;
+        continue;
+      }
+
+      size_t i = 0;
+      if (c.isObject()) {
+        // scalar values, one per row
+        for (auto const& it : VPackArrayIterator(c.get("scalars"))) {
+          if (i == _nrItems) {
+            break;
+          }
+          setValue(i++, column, AqlValue(it));
+        }
+      } else {
+        // references, one per row
+        for (auto const& it : VPackArrayIterator(c)) {
+          if (i == _nrItems) {
+            break;
+          }
+          int64_t ref = it.getNumericValue<int64_t>();
+          if (ref != 0) {
+            set(i, column, ref);
+          }
+          i++;
+        }
+      }
+      column++;
+    }
+  } catch (...) {
+    destroy();
+    throw;
+  }
+}
+
+/// @brief read the format with a "data" and a "raw" array, which was
+/// written by toVelocyPack before
+void AqlItemBlock::fromRawVelocyPack(VPackSlice const slice) {
   VPackSlice data = slice.get("data");
   VPackSlice raw = slice.get("raw");
 
@@ -472,6 +591,61 @@ AqlItemBlock* AqlItemBlock::steal(std::vector<size_t> const& chosen, size_t from
   return res.release();
 }
 
+/// @brief move chosen rows for a subset into a new block. a value that is
+/// referenced by a single row changes owner, a value that is shared with
+/// other rows is cloned once, and the last row to be moved takes it over
+AqlItemBlock* AqlItemBlock::move(std::vector<size_t> const& chosen, size_t from,
+                                 size_t to) {
+  TRI_ASSERT(from < to && to <= chosen.size());
+
+  std::unordered_map<AqlValue, AqlValue> cache;
+
+  auto res = std::make_unique<AqlItemBlock>(_resourceMonitor, to - from, _nrRegs);
+
+  for (size_t row = from; row < to; row++) {
+    for (RegisterId col = 0; col < _nrRegs; col++) {
+      AqlValue& a(_data[chosen[row] * _nrRegs + col]);
+
+      if (a.isEmpty()) {
+        continue;
+      }
+      if (!a.requiresDestruction()) {
+        res->setValue(row - from, col, a);
+        a.erase();
+        continue;
+      }
+
+      auto it = cache.find(a);
+      if (it != cache.end()) {
+        res->setValue(row - from, col, it->second);
+        destroyValue(chosen[row], col);
+      } else if (valueCount(a) == 1) {
+        AqlValue b = a;
+        steal(b);
+        a.erase();
+        try {
+          res->setValue(row - from, col, b);
+        } catch (...) {
+          b.destroy();
+          throw;
+        }
+      } else {
+        AqlValue b = a.clone();
+        try {
+          res->setValue(row - from, col, b);
+        } catch (...) {
+          b.destroy();
+          throw;
+        }
+        cache.emplace(a, b);
+        destroyValue(chosen[row], col);
+      }
+    }
+  }
+
+  return res.release();
+}
+
 /// @brief concatenate multiple blocks
 AqlItemBlock* AqlItemBlock::concatenate(ResourceMonitor* resourceMonitor,
     BlockCollector* collector) {
@@ -552,87 +726,110 @@ AqlItemBlock* AqlItemBlock::concatenate(ResourceMonitor* resourceMonitor,
 ///  "nrItems": the number of rows of the AqlItemBlock
 ///  "nrRegs":  the number of registers of the AqlItemBlock
 ///  "error":   always set to false
-///  "data":    this contains the actual data in the form of a list of
-///             numbers. The AqlItemBlock is stored columnwise, starting
-///             from the first column (top to bottom) and going right.
-///             Each entry found is encoded in the following way:
-///               0  means a single empty entry
-///               -1 followed by a positive integer N (encoded as number)
-///                    means a run of that many empty entries
-///               -2 followed by two numbers LOW and HIGH means a range
-///                    and LOW and HIGH are the boundaries (inclusive)
-///               1 means a JSON entry at the "next" position in "raw"
-///                    the "next" position starts with 2 and is increased
-///                    by one for every 1 found in data
-///               integer values >= 2 mean a JSON entry, in this
-///                      case the "raw" list contains an entry in the
-///                      corresponding position
-///  "raw":     List of actual values, positions 0 and 1 are always null
-///                      such that actual indices start at 2
+///  "columns": one entry per register, encoded in one of these ways:
+///               a number N means that all rows contain the value with
+///                    reference N (0 means all rows are empty)
+///               an array of numbers contains the reference of the value
+///                    in each row
+///               an object {"scalars": [...]} contains the value of each
+///                    row directly. this is used if all rows contain
+///                    numbers, booleans or null
+///             a reference 0 is an empty entry, a positive reference N is
+///             entry N - 1 of "values", a negative reference -N is entry
+///             N - 1 of "ranges"
+///  "values":  List of the distinct values referenced by the columns
+///  "ranges":  List of [LOW, HIGH] pairs for the distinct ranges referenced
+///             by the columns, boundaries are inclusive. only present if
+///             there are any
+/// The AqlItemBlock constructor also accepts the format with "data" and
+/// "raw" attributes that older servers send.
 void AqlItemBlock::toVelocyPack(transaction::Methods* trx,
                                 VPackBuilder& result) const {
   VPackOptions options(VPackOptions::Defaults);
   options.buildUnindexedArrays = true;
   options.buildUnindexedObjects = true;
 
-  VPackBuilder raw(&options);
-  raw.openArray();
-  // Two nulls in the beginning such that indices start with 2
-  raw.add(VPackValue(VPackValueType::Null));
-  raw.add(VPackValue(VPackValueType::Null));
+  VPackBuilder values(&options);
+  values.openArray();
+  VPackBuilder ranges(&options);
+  ranges.openArray();
+  int64_t numValues = 0;
+  int64_t numRanges = 0;
+
+  std::unordered_map<AqlValue, int64_t> table;  // remember duplicates
+
+  auto reference = [&](AqlValue const& a) -> int64_t {
+    if (a.isEmpty()) {
+      return 0;
+    }
+    auto it = table.find(a);
+    if (it != table.end()) {
+      return it->second;
+    }
+    int64_t ref;
+    if (a.isRange()) {
+      ranges.openArray();
+      ranges.add(VPackValue(a.range()->_low));
+      ranges.add(VPackValue(a.range()->_high));
+      ranges.close();
+      ref = -(++numRanges);
+    } else {
+      a.toVelocyPack(trx, values, false);
+      ref = ++numValues;
+    }
+    table.emplace(a, ref);
+    return ref;
+  };
+
+  std::equal_to<AqlValue> equal;
 
-  std::unordered_map<AqlValue, size_t> table;  // remember duplicates
-  
   result.add("nrItems", VPackValue(_nrItems));
   result.add("nrRegs", VPackValue(_nrRegs));
   result.add("error", VPackValue(false));
   result.add("exhausted", VPackValue(false));
-  result.add("data", VPackValue(VPackValueType::Array));
+  result.add("columns", VPackValue(VPackValueType::Array));
 
-  size_t emptyCount = 0;  // here we count runs of empty AqlValues
-
-  auto commitEmpties = [&result, &emptyCount]() {  // this commits an empty run to the result
-    if (emptyCount > 0) {
-      if (emptyCount == 1) {
-        result.add(VPackValue(0));
-      } else {
-        result.add(VPackValue(-1));
-        result.add(VPackValue(emptyCount));
-      }
-      emptyCount = 0;
-    }
-  };
-
-  size_t pos = 2;  // write position in raw
   for (RegisterId column = 0; column < _nrRegs; column++) {
-    for (size_t i = 0; i < _nrItems; i++) {
+    AqlValue const& first(_data[column]);
+    bool constant = true;
+    bool scalar = true;
+    for (size_t i = 0; i < _nrItems && (constant || scalar); i++) {
       AqlValue const& a(_data[i * _nrRegs + column]);
-      if (a.isEmpty()) {
-        emptyCount++;
-      } else {
-        commitEmpties();
-        if (a.isRange()) {
-          result.add(VPackValue(-2));
-          result.add(VPackValue(a.range()->_low));
-          result.add(VPackValue(a.range()->_high));
-        } else {
-          auto it = table.find(a);
+      if (constant && (a.isEmpty() ? !first.isEmpty()
+                                   : (first.isEmpty() || !equal(a, first)))) {
+        constant = false;
+      }
+      if (scalar && (a.isEmpty() || a.isRange() ||
+                     !(a.isNumber() || a.isBoolean() || a.isNull(false)))) {
+        scalar = false;
+      }
+    }
 
-          if (it == table.end()) {
-            a.toVelocyPack(trx, raw, false);
-            result.add(VPackValue(1));
-            table.emplace(a, pos++);
-          } else {
-            result.add(VPackValue(it->second));
-          }
-        }
+    if (constant) {
+      result.add(VPackValue(reference(first)));
+    } else if (scalar) {
+      result.openObject();
+      result.add("scalars", VPackValue(VPackValueType::Array));
+      for (size_t i = 0; i < _nrItems; i++) {
+        _data[i * _nrRegs + column].toVelocyPack(trx, result, false);
       }
+      result.close();
+      result.close();
+    } else {
+      result.openArray();
+      for (size_t i = 0; i < _nrItems; i++) {
+        result.add(VPackValue(reference(_data[i * _nrRegs + column])));
+      }
+      result.close();
     }
   }
-  commitEmpties();
-  
-  result.close(); // closes "data"
 
-  raw.close();
-  result.add("raw", raw.slice());
+  result.close(); // closes "columns"
+
+  values.close();
+  result.add("values", values.slice());
+  ranges.close();
+  if (numRanges > 0) {
+    result.add("ranges", ranges.slice());
+  }
 }
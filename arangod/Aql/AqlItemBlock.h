@@ -200,7 +200,22 @@ class AqlItemBlock {
       }
     }
   }
-  
+
+  void copyValuesFromRow(size_t currentRow, RegisterId curRegs,
+                         size_t fromRow) {
+    TRI_ASSERT(currentRow != fromRow);
+
+    for (RegisterId i = 0; i < curRegs; i++) {
+      if (_data[currentRow * _nrRegs + i].isEmpty()) {
+        // First update the reference count, if this fails, the value is empty
+        if (_data[fromRow * _nrRegs + i].requiresDestruction()) {
+          ++_valueCount[_data[fromRow * _nrRegs + i]];
+        }
+        _data[currentRow * _nrRegs + i] = _data[fromRow * _nrRegs + i];
+      }
+    }
+  }
+
   /// @brief valueCount
   /// this is used if the value is stolen and later released from elsewhere
   uint32_t valueCount(AqlValue const& v) const {
@@ -265,6 +280,11 @@ class AqlItemBlock {
   /// after this operation, because it is unclear, when the values
   /// to which our AqlValues point will vanish.
   AqlItemBlock* steal(std::vector<size_t> const& chosen, size_t from, size_t to);
+
+  /// @brief move chosen rows for a subset into a new block. values that no
+  /// other row refers to are moved without copying them, all others are
+  /// cloned. the chosen rows are empty afterwards
+  AqlItemBlock* move(std::vector<size_t> const& chosen, size_t from, size_t to);
   
   /// @brief concatenate multiple blocks from a collector
   static AqlItemBlock* concatenate(ResourceMonitor*, BlockCollector* collector);
@@ -280,6 +300,12 @@ class AqlItemBlock {
                     arangodb::velocypack::Builder&) const;
 
  private:
+  /// @brief fill the block from the columnar VelocyPack format
+  void fromColumns(arangodb::velocypack::Slice const);
+
+  /// @brief fill the block from the VelocyPack format of older servers
+  void fromRawVelocyPack(arangodb::velocypack::Slice const);
+
   /// @brief _data, the actual data as a single vector of dimensions _nrItems
   /// times _nrRegs
   std::vector<AqlValue> _data;
@@ -28,7 +28,11 @@ using namespace arangodb::aql;
 
 /// @brief create the manager
 AqlItemBlockManager::AqlItemBlockManager(ResourceMonitor* resourceMonitor) 
-    : _resourceMonitor(resourceMonitor) {}
+    : _resourceMonitor(resourceMonitor), _pooledValues(0) {
+  for (size_t i = 0; i < NumBuckets; ++i) {
+    _buckets[i].blocks.reserve(Bucket::maxBlocks(i));
+  }
+}
 
 /// @brief destroy the manager
 AqlItemBlockManager::~AqlItemBlockManager() { }
@@ -48,6 +52,8 @@ AqlItemBlock* AqlItemBlockManager::requestBlock(size_t nrItems,
     if (!_buckets[i].empty()) {
       block = _buckets[i].pop();
       TRI_ASSERT(block != nullptr);
+      TRI_ASSERT(_pooledValues >= block->capacity());
+      _pooledValues -= block->capacity();
       block->eraseAll();
       block->rescale(nrItems, nrRegs);
       // LOG_TOPIC(TRACE, arangodb::Logger::FIXME) << "returned cached AqlItemBlock with dimensions " << block->size() << " x " << block->getNrRegs();
@@ -81,10 +87,12 @@ void AqlItemBlockManager::returnBlock(AqlItemBlock*& block) {
   size_t const i = Bucket::getId(targetSize);
   TRI_ASSERT(i < NumBuckets);
 
-  if (!_buckets[i].full()) {
+  if (!_buckets[i].full(i) && 
+      _pooledValues + block->capacity() <= MaxPooledValues) {
     // recycle the block
     block->destroy();
     // store block in bucket
+    _pooledValues += block->capacity();
     _buckets[i].push(block);
   } else {
     // bucket is full. simply delete the block
@@ -93,14 +101,10 @@ void AqlItemBlockManager::returnBlock(AqlItemBlock*& block) {
   block = nullptr;
 }
 
-AqlItemBlockManager::Bucket::Bucket() {
-  for (size_t i = 0; i < NumBlocks; ++i) {
-    blocks[i] = nullptr;
-  }
-}
+AqlItemBlockManager::Bucket::Bucket() {}
 
 AqlItemBlockManager::Bucket::~Bucket() {
-  for (size_t i = 0; i < NumBlocks; ++i) {
-    delete blocks[i];
+  for (auto& it : blocks) {
+    delete it;
   }
 }
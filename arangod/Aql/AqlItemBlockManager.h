@@ -27,8 +27,6 @@
 #include "Basics/Common.h"
 #include "Aql/types.h"
 
-#include <array>
-
 namespace arangodb {
 namespace aql {
 
@@ -57,44 +55,49 @@ class AqlItemBlockManager {
     
   static constexpr size_t NumBuckets = 12;
 
-  struct Bucket {
-    static constexpr size_t NumBlocks = 4;
+  /// @brief maximum total number of AqlValue slots kept in the buckets.
+  /// blocks returned beyond this are freed immediately, all others are
+  /// reused by the query and freed en bloc when the manager goes away
+  static constexpr size_t MaxPooledValues = 256 * 1024;
 
+  struct Bucket {
     Bucket();
     ~Bucket(); 
 
-    std::array<AqlItemBlock*, NumBlocks> blocks;
+    std::vector<AqlItemBlock*> blocks;
     
     bool empty() const {
-      return (blocks[0] == nullptr);
+      return blocks.empty();
     }
 
-    bool full() const {
-      return (blocks[NumBlocks - 1] != nullptr);
+    bool full(size_t id) const {
+      return (blocks.size() >= maxBlocks(id));
     }
 
     AqlItemBlock* pop() {
       TRI_ASSERT(!empty());
-      size_t i = NumBlocks;
-      while (i--) {       
-        if (blocks[i] != nullptr) {
-          AqlItemBlock* result = blocks[i];
-          blocks[i] = nullptr;
-          return result;
-        }
-      }
-      return nullptr;
+      AqlItemBlock* result = blocks.back();
+      blocks.pop_back();
+      return result;
     }
 
     void push(AqlItemBlock* block) {
-      TRI_ASSERT(!full());
-      for (size_t i = 0; i < NumBlocks; ++i) {
-        if (blocks[i] == nullptr) {
-          blocks[i] = block;
-          return;
-        }
+      // blocks has reserved enough capacity, so this will not throw
+      TRI_ASSERT(blocks.size() < blocks.capacity());
+      blocks.emplace_back(block);
+    }
+
+    /// @brief maximum number of blocks kept for the bucket with the
+    /// specified id. small blocks are cheap to keep around but are
+    /// requested much more often than big ones
+    static size_t maxBlocks(size_t id) {
+      if (id <= 7) {
+        return 32;
+      }
+      if (id <= 9) {
+        return 8;
       }
-      TRI_ASSERT(false);
+      return 4;
     }
 
     static size_t getId(size_t targetSize) {
@@ -136,6 +139,9 @@ class AqlItemBlockManager {
   };
 
   Bucket _buckets[NumBuckets];
+
+  /// @brief number of AqlValue slots currently kept in the buckets
+  size_t _pooledValues;
 };
 
 }
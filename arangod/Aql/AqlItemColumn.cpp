@@ -0,0 +1,196 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "AqlItemColumn.h"
+#include "Aql/AqlItemBlock.h"
+#include "Basics/VelocyPackHelper.h"
+
+#include <velocypack/Slice.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+AqlItemColumn::AqlItemColumn() : _type(EMPTY), _size(0), _numNulls(0) {}
+
+/// @brief load the values of the specified register from the block.
+/// returns true if the register could be represented as a typed column,
+/// and false otherwise. in the latter case the column type is MIXED
+bool AqlItemColumn::load(AqlItemBlock const* block, RegisterId reg) {
+  TRI_ASSERT(block != nullptr);
+  TRI_ASSERT(reg < block->getNrRegs());
+
+  size_t const n = block->size();
+  reset(n);
+
+  for (size_t row = 0; row < n; ++row) {
+    if (!set(row, block->getValueReference(row, reg))) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/// @brief prepare the column for the specified number of rows. all rows
+/// are initially null
+void AqlItemColumn::reset(size_t n) {
+  clear();
+  _size = n;
+  _numNulls = n;
+  _nulls.assign(n, 1);
+}
+
+/// @brief set the value for the specified row. returns false if the value
+/// cannot be stored in the column. the column type is MIXED then
+bool AqlItemColumn::set(size_t row, AqlValue const& a) {
+  TRI_ASSERT(row < _size);
+  TRI_ASSERT(_nulls[row] != 0);
+
+  if (_type == MIXED) {
+    return false;
+  }
+
+  if (a.isEmpty()) {
+    return true;
+  }
+
+  if (a.isRange() || a.isDocvec()) {
+    _type = MIXED;
+    return false;
+  }
+
+  VPackSlice s = a.slice();
+
+  if (s.isNull() || s.isNone()) {
+    return true;
+  }
+
+  if (s.isBoolean()) {
+    if (_type == EMPTY) {
+      _type = BOOL;
+      _bools.assign(_size, 0);
+    } else if (_type != BOOL) {
+      _type = MIXED;
+      return false;
+    }
+    _bools[row] = s.getBool() ? 1 : 0;
+  } else if (s.isInt() || s.isSmallInt() ||
+             (s.isUInt() && s.getUInt() <= static_cast<uint64_t>(
+                                               (std::numeric_limits<int64_t>::max)()))) {
+    if (_type == EMPTY) {
+      _type = INT64;
+      _ints.assign(_size, 0);
+    } else if (_type == BOOL) {
+      _type = MIXED;
+      return false;
+    }
+    if (_type == INT64) {
+      _ints[row] = s.getNumber<int64_t>();
+    } else {
+      TRI_ASSERT(_type == DOUBLE);
+      _doubles[row] = s.getNumber<double>();
+    }
+  } else if (s.isNumber()) {
+    // a double or a large unsigned integer
+    if (_type == EMPTY) {
+      _type = DOUBLE;
+      _doubles.assign(_size, 0.0);
+    } else if (_type == INT64) {
+      promoteToDouble();
+    } else if (_type == BOOL) {
+      _type = MIXED;
+      return false;
+    }
+    TRI_ASSERT(_type == DOUBLE);
+    _doubles[row] = s.getNumber<double>();
+  } else {
+    // any other type
+    _type = MIXED;
+    return false;
+  }
+
+  _nulls[row] = 0;
+  --_numNulls;
+  return true;
+}
+
+/// @brief reset the column, so it can be reused for another block
+void AqlItemColumn::clear() {
+  _type = EMPTY;
+  _size = 0;
+  _numNulls = 0;
+  _ints.clear();
+  _doubles.clear();
+  _bools.clear();
+  _nulls.clear();
+}
+
+/// @brief double values, valid for DOUBLE and INT64 columns. for INT64
+/// columns the double values are created lazily
+double const* AqlItemColumn::doubleValues() {
+  TRI_ASSERT(isNumeric());
+
+  if (_type == INT64 && _doubles.size() != _size) {
+    _doubles.resize(_size);
+    for (size_t i = 0; i < _size; ++i) {
+      _doubles[i] = static_cast<double>(_ints[i]);
+    }
+  }
+  return _doubles.data();
+}
+
+/// @brief create an AqlValue for the specified row
+AqlValue AqlItemColumn::value(size_t row) const {
+  TRI_ASSERT(row < _size);
+  TRI_ASSERT(_type != MIXED);
+
+  if (_nulls[row] != 0) {
+    return AqlValue(arangodb::basics::VelocyPackHelper::NullValue());
+  }
+
+  switch (_type) {
+    case INT64:
+      return AqlValue(_ints[row]);
+    case DOUBLE:
+      return AqlValue(_doubles[row]);
+    case BOOL:
+      return AqlValue(_bools[row] != 0);
+    case EMPTY:
+    case MIXED: {
+      break;
+    }
+  }
+
+  return AqlValue(arangodb::basics::VelocyPackHelper::NullValue());
+}
+
+/// @brief convert all values collected as integers so far into doubles
+void AqlItemColumn::promoteToDouble() {
+  TRI_ASSERT(_type == INT64);
+
+  _doubles.resize(_size);
+  for (size_t i = 0; i < _size; ++i) {
+    _doubles[i] = static_cast<double>(_ints[i]);
+  }
+  _ints.clear();
+  _type = DOUBLE;
+}
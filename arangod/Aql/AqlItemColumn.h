@@ -0,0 +1,155 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_AQL_AQL_ITEM_COLUMN_H
+#define ARANGOD_AQL_AQL_ITEM_COLUMN_H 1
+
+#include "Basics/Common.h"
+#include "Aql/AqlValue.h"
+#include "Aql/types.h"
+
+namespace arangodb {
+namespace aql {
+class AqlItemBlock;
+
+// an <AqlItemColumn> is a column-major, typed copy of the values of a
+// single register of an <AqlItemBlock>. The values of an <AqlItemBlock>
+// are stored row-major (nrItems x nrRegs), so any kernel that only looks
+// at a single register would need to stride over the values of all other
+// registers and dispatch on the type of each <AqlValue>. If all values of
+// a register are scalars of the same kind (integers, doubles or booleans),
+// they can be loaded into an <AqlItemColumn>, which stores them in
+// contiguous memory, so that tight loops (see Arithmetic.h) can be run
+// over them.
+//
+// A column can hold null values in addition to the typed values. Null
+// positions are tracked in a separate byte vector and the typed value at
+// a null position is always 0.
+//
+// If the register contains any other value (e.g. strings, arrays, objects,
+// ranges or subquery results), loading fails and the column type is
+// MIXED. Callers must then fall back to the regular per-row evaluation.
+
+class AqlItemColumn {
+ public:
+  /// @brief type of the values stored in the column
+  enum ColumnType : uint8_t {
+    EMPTY,  // column has not been loaded yet, or register was empty
+    INT64,  // all non-null values are integers
+    DOUBLE, // all non-null values are numbers, at least one is a double
+    BOOL,   // all non-null values are booleans
+    MIXED   // column cannot be represented as a typed column
+  };
+
+  AqlItemColumn();
+  AqlItemColumn(AqlItemColumn const&) = delete;
+  AqlItemColumn& operator=(AqlItemColumn const&) = delete;
+
+  ~AqlItemColumn() = default;
+
+ public:
+  /// @brief load the values of the specified register from the block.
+  /// returns true if the register could be represented as a typed column,
+  /// and false otherwise. in the latter case the column type is MIXED
+  bool load(AqlItemBlock const* block, RegisterId reg);
+
+  /// @brief prepare the column for the specified number of rows. all rows
+  /// are initially null
+  void reset(size_t n);
+
+  /// @brief set the value for the specified row. returns false if the value
+  /// cannot be stored in the column. the column type is MIXED then
+  bool set(size_t row, AqlValue const& value);
+
+  /// @brief reset the column, so it can be reused for another block
+  void clear();
+
+  /// @brief the type of the column
+  inline ColumnType type() const { return _type; }
+
+  /// @brief whether or not the column holds numeric values
+  inline bool isNumeric() const { return _type == INT64 || _type == DOUBLE; }
+
+  /// @brief number of rows in the column
+  inline size_t size() const { return _size; }
+
+  /// @brief whether or not the column contains any null values
+  inline bool hasNulls() const { return _numNulls > 0; }
+
+  /// @brief whether or not the value in the specified row is null
+  inline bool isNull(size_t row) const {
+    TRI_ASSERT(row < _size);
+    return _nulls[row] != 0;
+  }
+
+  /// @brief the null flags of the column (1 = null, 0 = not null)
+  inline uint8_t const* nulls() const { return _nulls.data(); }
+
+  /// @brief integer values, only valid for INT64 columns
+  inline int64_t const* int64Values() const {
+    TRI_ASSERT(_type == INT64);
+    return _ints.data();
+  }
+
+  /// @brief double values, valid for DOUBLE and INT64 columns. for INT64
+  /// columns the double values are created lazily
+  double const* doubleValues();
+
+  /// @brief boolean values (0 or 1), only valid for BOOL columns
+  inline uint8_t const* boolValues() const {
+    TRI_ASSERT(_type == BOOL);
+    return _bools.data();
+  }
+
+  /// @brief create an AqlValue for the specified row
+  AqlValue value(size_t row) const;
+
+ private:
+  /// @brief convert all values collected as integers so far into doubles
+  void promoteToDouble();
+
+ private:
+  /// @brief type of the column
+  ColumnType _type;
+
+  /// @brief number of rows
+  size_t _size;
+
+  /// @brief number of null values
+  size_t _numNulls;
+
+  /// @brief integer values
+  std::vector<int64_t> _ints;
+
+  /// @brief double values
+  std::vector<double> _doubles;
+
+  /// @brief boolean values
+  std::vector<uint8_t> _bools;
+
+  /// @brief null flags
+  std::vector<uint8_t> _nulls;
+};
+
+}  // namespace arangodb::aql
+}  // namespace arangodb
+
+#endif
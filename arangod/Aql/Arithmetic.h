@@ -73,6 +73,29 @@ bool IsUnsafeDivision(T l, T r) {
   // note: the caller still has to check whether r is zero (division by zero)
   return (l == (std::numeric_limits<T>::min)() && r == -1);
 }
+
+// column kernels
+// the following functions compare contiguous arrays of values, as provided
+// by AqlItemColumn. they are written as plain loops without any per-value
+// type dispatch, so the compiler can auto-vectorize them. the callers only
+// use them for columns without null values
+
+/// @brief out[i] = cmp(l[i], r[i]) ? 1 : 0
+template <typename T, typename Cmp>
+void ColumnCompare(T const* l, T const* r, uint8_t* out, size_t n, Cmp cmp) {
+  for (size_t i = 0; i < n; ++i) {
+    out[i] = static_cast<uint8_t>(cmp(l[i], r[i]));
+  }
+}
+
+/// @brief out[i] = cmp(l[i], value) ? 1 : 0
+template <typename T, typename Cmp>
+void ColumnCompareScalar(T const* l, T value, uint8_t* out, size_t n,
+                         Cmp cmp) {
+  for (size_t i = 0; i < n; ++i) {
+    out[i] = static_cast<uint8_t>(cmp(l[i], value));
+  }
+}
 }
 }
 
@@ -1428,6 +1428,8 @@ void Ast::injectBindParameters(BindParameters& parameters) {
 
           // finally note that the node was created from a bind parameter
           node->setFlag(FLAG_BIND_PARAMETER);
+
+          ++_bindParameterUses[param];
         }
       }
     } else if (node->type == NODE_TYPE_BOUND_ATTRIBUTE_ACCESS) {
@@ -113,6 +113,11 @@ class Ast {
     return std::unordered_set<std::string>(_bindParameters);
   }
 
+  /// @brief the number of value nodes created from each bind parameter
+  std::unordered_map<std::string, size_t> const& bindParameterUses() const {
+    return _bindParameterUses;
+  }
+
   /// @brief get the query scopes
   inline Scopes* scopes() { return &_scopes; }
 
@@ -526,6 +531,9 @@ private:
   /// @brief the bind parameters we found in the query
   std::unordered_set<std::string> _bindParameters;
 
+  /// @brief the number of value nodes created from each bind parameter
+  std::unordered_map<std::string, size_t> _bindParameterUses;
+
   /// @brief root node of the AST
   AstNode* _root;
 
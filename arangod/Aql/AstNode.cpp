@@ -1050,6 +1050,11 @@ void AstNode::toVelocyPack(VPackBuilder& builder, bool verbose) const {
       if (verbose) {
         builder.add("vType", VPackValue(getValueTypeString()));
         builder.add("vTypeID", VPackValue(static_cast<int>(value.type)));
+
+        if (hasFlag(FLAG_BIND_PARAMETER)) {
+          // allows the plan cache to substitute the value
+          builder.add("bindParameter", VPackValue(true));
+        }
       }
     }
 
@@ -23,7 +23,10 @@
 
 #include "BasicBlocks.h"
 #include "Aql/AqlItemBlock.h"
+#include "Aql/AstNode.h"
 #include "Aql/ExecutionEngine.h"
+#include "Aql/ExecutionPlan.h"
+#include "Aql/Expression.h"
 #include "Basics/Exceptions.h"
 #include "VocBase/vocbase.h"
 
@@ -150,15 +153,45 @@ int SingletonBlock::getOrSkipSome(size_t,  // atLeast,
 FilterBlock::FilterBlock(ExecutionEngine* engine, FilterNode const* en)
     : ExecutionBlock(engine, en), 
       _inReg(ExecutionNode::MaxRegisterId),
+      _useColumn(false),
       _collector(&engine->_itemBlockManager) {
 
   auto it = en->getRegisterPlan()->varInfo.find(en->_inVariable->id);
   TRI_ASSERT(it != en->getRegisterPlan()->varInfo.end());
   _inReg = it->second.registerId;
   TRI_ASSERT(_inReg < ExecutionNode::MaxRegisterId);
+
+  // only a comparison fills the input register with booleans for sure. for
+  // any other expression, loading the column would mostly be wasted work
+  auto setter = en->plan()->getVarSetBy(en->_inVariable->id);
+  _useColumn = (setter != nullptr &&
+                setter->getType() == ExecutionNode::CALCULATION &&
+                isComparison(static_cast<CalculationNode const*>(setter)
+                                 ->expression()
+                                 ->node()));
 }
 
 FilterBlock::~FilterBlock() {}
+
+/// @brief whether or not the expression is a comparison, which always
+/// produces a boolean value
+bool FilterBlock::isComparison(AstNode const* node) {
+  if (node == nullptr) {
+    return false;
+  }
+
+  switch (node->type) {
+    case NODE_TYPE_OPERATOR_BINARY_EQ:
+    case NODE_TYPE_OPERATOR_BINARY_NE:
+    case NODE_TYPE_OPERATOR_BINARY_LT:
+    case NODE_TYPE_OPERATOR_BINARY_LE:
+    case NODE_TYPE_OPERATOR_BINARY_GT:
+    case NODE_TYPE_OPERATOR_BINARY_GE:
+      return true;
+    default:
+      return false;
+  }
+}
   
 /// @brief internal function to actually decide if the document should be used
 bool FilterBlock::takeItem(AqlItemBlock* items, size_t index) const {
@@ -182,13 +215,36 @@ bool FilterBlock::getBlock(size_t atLeast, size_t atMost) {
 
     _chosen.clear();
     _chosen.reserve(cur->size());
-    for (size_t i = 0; i < cur->size(); ++i) {
-      if (takeItem(cur, i)) {
-        TRI_IF_FAILURE("FilterBlock::getBlock") {
-          THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
+
+    if (_useColumn && _column.load(cur, _inReg) &&
+        (_column.type() == AqlItemColumn::BOOL ||
+         _column.type() == AqlItemColumn::EMPTY)) {
+      // the filter register contains only booleans and nulls, as produced
+      // by a preceding comparison. we can use the column's values as a
+      // selection vector directly
+      TRI_IF_FAILURE("FilterBlock::getBlock") {
+        THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
+      }
+
+      if (_column.type() == AqlItemColumn::BOOL) {
+        // null positions have a value of 0, so they are not selected
+        uint8_t const* selection = _column.boolValues();
+        size_t const n = cur->size();
+        for (size_t i = 0; i < n; ++i) {
+          if (selection[i] != 0) {
+            _chosen.emplace_back(i);
+          }
         }
+      }
+    } else {
+      for (size_t i = 0; i < cur->size(); ++i) {
+        if (takeItem(cur, i)) {
+          TRI_IF_FAILURE("FilterBlock::getBlock") {
+            THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
+          }
 
-        _chosen.emplace_back(i);
+          _chosen.emplace_back(i);
+        }
       }
     }
 
@@ -306,7 +362,7 @@ bool FilterBlock::hasMore() {
     // trigger an expensive fetching operation, even if later on only
     // a single document is needed due to a LIMIT...
     // However, how should we know this here?
-    if (!getBlock(DefaultBatchSize(), DefaultBatchSize())) {
+    if (!getBlock(batchSize(), batchSize())) {
       _done = true;
       return false;
     }
@@ -398,8 +454,8 @@ int LimitBlock::getOrSkipSome(size_t atLeast, size_t atMost, bool skipping,
     if (_fullCount) {
       // if fullCount is set, we must fetch all elements from the
       // dependency. we'll use the default batch size for this
-      atLeast = DefaultBatchSize();
-      atMost = DefaultBatchSize();
+      atLeast = batchSize();
+      atMost = batchSize();
 
       // suck out all data from the dependencies
       while (true) {
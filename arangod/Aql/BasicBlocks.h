@@ -24,6 +24,7 @@
 #ifndef ARANGOD_AQL_BASIC_BLOCKS_H
 #define ARANGOD_AQL_BASIC_BLOCKS_H 1
 
+#include "Aql/AqlItemColumn.h"
 #include "Aql/BlockCollector.h"
 #include "Aql/ExecutionBlock.h"
 #include "Aql/ExecutionNode.h"
@@ -81,6 +82,11 @@ class FilterBlock final : public ExecutionBlock {
 
   ~FilterBlock();
 
+  /// @brief whether or not the expression is a comparison, which always
+  /// produces a boolean value. only then the input register is loaded as
+  /// a column, which can be used as a selection vector
+  static bool isComparison(AstNode const*);
+
  private:
   /// @brief internal function to actually decide if the document should be used
   bool takeItem(AqlItemBlock* items, size_t index) const;
@@ -109,6 +115,12 @@ class FilterBlock final : public ExecutionBlock {
   /// that are chosen
   std::vector<size_t> _chosen;
 
+  /// @brief whether or not the input register is loaded as a column
+  bool _useColumn;
+
+  /// @brief typed values of the input register of the current block
+  AqlItemColumn _column;
+
   BlockCollector _collector;
 };
 
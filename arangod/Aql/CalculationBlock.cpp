@@ -67,6 +67,9 @@ CalculationBlock::CalculationBlock(ExecutionEngine* engine,
     TRI_ASSERT(_inRegs.size() == 1);
   }
 
+  _isBatchComparison = (!_isReference && en->_conditionVariable == nullptr &&
+                        _expression->isBatchComparison());
+
   auto it3 = en->getRegisterPlan()->varInfo.find(en->_outVariable->id);
   TRI_ASSERT(it3 != en->getRegisterPlan()->varInfo.end());
   _outReg = it3->second.registerId;
@@ -98,6 +101,26 @@ void CalculationBlock::fillBlockWithReference(AqlItemBlock* result) {
   }
 }
 
+/// @brief execute a simple comparison for the whole block at once.
+/// returns false if the values in the block do not allow this
+bool CalculationBlock::executeBatchComparison(AqlItemBlock* result) {
+  if (!_expression->executeBatchComparison(_trx, result, _inVars, _inRegs,
+                                           _lhsColumn, _rhsColumn,
+                                           _selection)) {
+    return false;
+  }
+
+  size_t const n = result->size();
+  TRI_ASSERT(_selection.size() == n);
+
+  for (size_t i = 0; i < n; i++) {
+    // boolean values are stored inline and need no memory management
+    result->setValue(i, _outReg, AqlValue(_selection[i] != 0));
+  }
+  throwIfKilled();  // check if we were aborted
+  return true;
+}
+
 /// @brief shared code for executing a simple or a V8 expression
 void CalculationBlock::executeExpression(AqlItemBlock* result) {
   DEBUG_BEGIN_BLOCK();
@@ -105,6 +128,10 @@ void CalculationBlock::executeExpression(AqlItemBlock* result) {
                                  ->_conditionVariable != nullptr);
   TRI_ASSERT(!hasCondition); // currently not implemented
 
+  if (_isBatchComparison && executeBatchComparison(result)) {
+    return;
+  }
+
   size_t const n = result->size();
 
   for (size_t i = 0; i < n; i++) {
@@ -165,13 +192,17 @@ void CalculationBlock::doEvaluation(AqlItemBlock* result) {
       throw;
     }
   } else {
-    bool const isRunningInCluster = transaction()->state()->isRunningInCluster();
+    // in the cluster and for streaming queries, the next call may happen
+    // in another thread, so the context must be returned after each call
+    bool const releaseContext =
+        transaction()->state()->isRunningInCluster() ||
+        _engine->getQuery()->isStreaming();
 
     // must have a V8 context here to protect Expression::execute()
     arangodb::basics::ScopeGuard guard{
         [&]() -> void { _engine->getQuery()->enterContext(); },
         [&]() -> void {
-          if (isRunningInCluster) {
+          if (releaseContext) {
             // must invalidate the expression now as we might be called from
             // different threads
             _expression->invalidate();
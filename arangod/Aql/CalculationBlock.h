@@ -24,6 +24,7 @@
 #ifndef ARANGOD_AQL_CALCULATION_BLOCK_H
 #define ARANGOD_AQL_CALCULATION_BLOCK_H 1
 
+#include "Aql/AqlItemColumn.h"
 #include "Aql/ExecutionBlock.h"
 #include "Aql/ExecutionNode.h"
 
@@ -45,6 +46,10 @@ class CalculationBlock final : public ExecutionBlock {
   /// another variable
   void fillBlockWithReference(AqlItemBlock*);
 
+  /// @brief execute a simple comparison for the whole block at once.
+  /// returns false if the values in the block do not allow this
+  bool executeBatchComparison(AqlItemBlock*);
+
   /// @brief shared code for executing a simple or a V8 expression
   void executeExpression(AqlItemBlock*);
 
@@ -73,6 +78,15 @@ class CalculationBlock final : public ExecutionBlock {
 
   /// @brief whether or not the expression is a simple variable reference
   bool _isReference;
+
+  /// @brief whether or not the expression is a comparison that can be
+  /// evaluated for a whole block at once
+  bool _isBatchComparison;
+
+  /// @brief scratch space for batch comparisons
+  AqlItemColumn _lhsColumn;
+  AqlItemColumn _rhsColumn;
+  std::vector<uint8_t> _selection;
 };
 
 }  // namespace arangodb::aql
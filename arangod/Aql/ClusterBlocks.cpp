@@ -103,6 +103,18 @@ int GatherBlock::shutdown(int errorCode) {
   DEBUG_BEGIN_BLOCK();
   // don't call default shutdown method since it does the wrong thing to
   // _gatherBlockBuffer
+
+  // send the shutdown requests to all shards at once, so that the loop
+  // below only waits for the slowest shard instead of for all shards in turn
+  if (_dependencies.size() > 1) {
+    for (auto const& it : _dependencies) {
+      auto remote = dynamic_cast<RemoteBlock*>(it);
+      if (remote != nullptr) {
+        remote->prefetchShutdown(errorCode);
+      }
+    }
+  }
+
   for (auto it = _dependencies.begin(); it != _dependencies.end(); ++it) {
     int res = (*it)->shutdown(errorCode);
 
@@ -220,7 +232,7 @@ bool GatherBlock::hasMore() {
     for (size_t i = 0; i < _gatherBlockBuffer.size(); i++) {
       if (!_gatherBlockBuffer.at(i).empty()) {
         return true;
-      } else if (getBlock(i, DefaultBatchSize(), DefaultBatchSize())) {
+      } else if (getBlock(i, batchSize(), batchSize())) {
         _gatherBlockPos.at(i) = std::make_pair(i, 0);
         return true;
       }
@@ -256,6 +268,16 @@ AqlItemBlock* GatherBlock::getSome(size_t atLeast, size_t atMost) {
     }
     if (res == nullptr) {
       _done = true;
+    } else if (_dependencies.size() > 1) {
+      // let the shards produce their next rows while the caller processes
+      // these ones, so they are computed concurrently instead of one shard
+      // after the other
+      for (size_t i = _atDep; i < _dependencies.size(); i++) {
+        auto remote = dynamic_cast<RemoteBlock*>(_dependencies.at(i));
+        if (remote != nullptr) {
+          remote->prefetchSome(atLeast, atMost);
+        }
+      }
     }
     traceGetSomeEnd(res);
     return res;
@@ -268,6 +290,8 @@ AqlItemBlock* GatherBlock::getSome(size_t atLeast, size_t atMost) {
   // pull more blocks from dependencies . . .
   TRI_ASSERT(_gatherBlockBuffer.size() == _dependencies.size());
   TRI_ASSERT(_gatherBlockBuffer.size() == _gatherBlockPos.size());
+  
+  prefetch(atLeast, atMost);
  
   for (size_t i = 0; i < _dependencies.size(); i++) {
     if (_gatherBlockBuffer.at(i).empty()) {
@@ -296,7 +320,8 @@ AqlItemBlock* GatherBlock::getSome(size_t atLeast, size_t atMost) {
 
   size_t toSend = (std::min)(available, atMost);  // nr rows in outgoing block
 
-  // the following is similar to AqlItemBlock's slice method . . .
+  // clones of values that are referenced by more than one row of an input
+  // block, so that they are cloned only once per outgoing block
   std::unordered_map<AqlValue, AqlValue> cache;
 
   // comparison function
@@ -307,16 +332,32 @@ AqlItemBlock* GatherBlock::getSome(size_t atLeast, size_t atMost) {
   // automatically deleted if things go wrong
   std::unique_ptr<AqlItemBlock> res(requestBlock(toSend, static_cast<arangodb::aql::RegisterId>(nrRegs)));
 
+  std::vector<size_t> heap;
+  buildHeap(heap, _gatherBlockBuffer,
+            HeapLess(_gatherBlockPos, ourLessThan));
+
   for (size_t i = 0; i < toSend; i++) {
     // get the next smallest row from the buffer . . .
-    std::pair<size_t, size_t> val = *(std::min_element(
-        _gatherBlockPos.begin(), _gatherBlockPos.end(), ourLessThan));
+    TRI_ASSERT(!heap.empty());
+    std::pop_heap(heap.begin(), heap.end(), HeapLess(_gatherBlockPos, ourLessThan));
+    std::pair<size_t, size_t> const val = _gatherBlockPos.at(heap.back());
+    AqlItemBlock* src = _gatherBlockBuffer.at(val.first).front();
 
-    // copy the row in to the outgoing block . . .
+    // move the row in to the outgoing block . . .
     for (RegisterId col = 0; col < nrRegs; col++) {
-      AqlValue const& x(
-          _gatherBlockBuffer.at(val.first).front()->getValue(val.second, col));
-      if (!x.isEmpty()) {
+      AqlValue const& x(src->getValueReference(val.second, col));
+      if (x.isEmpty()) {
+        continue;
+      }
+
+      if (!x.requiresDestruction()) {
+        res->setValue(i, col, x);
+      } else if (src->valueCount(x) == 1) {
+        // no other row of the input block refers to the value, so we
+        // can take over ownership instead of cloning it
+        res->setValue(i, col, x);
+        src->eraseValue(val.second, col);
+      } else {
         auto it = cache.find(x);
 
         if (it == cache.end()) {
@@ -336,23 +377,29 @@ AqlItemBlock* GatherBlock::getSome(size_t atLeast, size_t atMost) {
 
     // renew the _gatherBlockPos and clean up the buffer if necessary
     _gatherBlockPos.at(val.first).second++;
-    if (_gatherBlockPos.at(val.first).second ==
-        _gatherBlockBuffer.at(val.first).front()->size()) {
-      AqlItemBlock* cur = _gatherBlockBuffer.at(val.first).front();
-      returnBlock(cur);
+    if (_gatherBlockPos.at(val.first).second == src->size()) {
+      returnBlock(src);
       _gatherBlockBuffer.at(val.first).pop_front();
       _gatherBlockPos.at(val.first) = std::make_pair(val.first, 0);
+      // the returned block's values may be freed now, and their addresses
+      // may be reused by other values
+      cache.clear();
 
       if (_gatherBlockBuffer.at(val.first).empty()) {
         // if we pulled everything from the buffer, we need to fetch
         // more data for the shard for which we have no more local
         // values. 
         getBlock(val.first, atLeast, atMost);
-        // note that if getBlock() returns false here, this is not
-        // a problem, because the sort function used takes care of
-        // this
+        // note that if getBlock() returns false here, the dependency
+        // is simply not put back into the heap
       }
     }
+
+    if (_gatherBlockBuffer.at(val.first).empty()) {
+      heap.pop_back();
+    } else {
+      std::push_heap(heap.begin(), heap.end(), HeapLess(_gatherBlockPos, ourLessThan));
+    }
   }
 
   traceGetSomeEnd(res.get());
@@ -365,8 +412,9 @@ AqlItemBlock* GatherBlock::getSome(size_t atLeast, size_t atMost) {
 /// @brief skipSome
 size_t GatherBlock::skipSome(size_t atLeast, size_t atMost) {
   DEBUG_BEGIN_BLOCK();
+  traceSkipSomeBegin();
   if (_done) {
-    return 0;
+    return traceSkipSomeEnd(0);
   }
 
   // the simple case . . .
@@ -379,13 +427,15 @@ size_t GatherBlock::skipSome(size_t atLeast, size_t atMost) {
     if (skipped == 0) {
       _done = true;
     }
-    return skipped;
+    return traceSkipSomeEnd(skipped);
   }
 
   // the non-simple case . . .
   size_t available = 0;  // nr of available rows
   TRI_ASSERT(_dependencies.size() != 0);
 
+  prefetch(atLeast, atMost);
+
   // pull more blocks from dependencies . . .
   for (size_t i = 0; i < _dependencies.size(); i++) {
     if (_gatherBlockBuffer.at(i).empty()) {
@@ -405,7 +455,7 @@ size_t GatherBlock::skipSome(size_t atLeast, size_t atMost) {
 
   if (available == 0) {
     _done = true;
-    return 0;
+    return traceSkipSomeEnd(0);
   }
 
   size_t skipped = (std::min)(available, atMost);  // nr rows in outgoing block
@@ -413,10 +463,15 @@ size_t GatherBlock::skipSome(size_t atLeast, size_t atMost) {
   // comparison function
   OurLessThan ourLessThan(_trx, _gatherBlockBuffer, _sortRegisters);
 
+  std::vector<size_t> heap;
+  buildHeap(heap, _gatherBlockBuffer,
+            HeapLess(_gatherBlockPos, ourLessThan));
+
   for (size_t i = 0; i < skipped; i++) {
     // get the next smallest row from the buffer . . .
-    std::pair<size_t, size_t> val = *(std::min_element(
-        _gatherBlockPos.begin(), _gatherBlockPos.end(), ourLessThan));
+    TRI_ASSERT(!heap.empty());
+    std::pop_heap(heap.begin(), heap.end(), HeapLess(_gatherBlockPos, ourLessThan));
+    std::pair<size_t, size_t> const val = _gatherBlockPos.at(heap.back());
 
     // renew the _gatherBlockPos and clean up the buffer if necessary
     _gatherBlockPos.at(val.first).second++;
@@ -427,9 +482,15 @@ size_t GatherBlock::skipSome(size_t atLeast, size_t atMost) {
       _gatherBlockBuffer.at(val.first).pop_front();
       _gatherBlockPos.at(val.first) = std::make_pair(val.first, 0);
     }
+
+    if (_gatherBlockBuffer.at(val.first).empty()) {
+      heap.pop_back();
+    } else {
+      std::push_heap(heap.begin(), heap.end(), HeapLess(_gatherBlockPos, ourLessThan));
+    }
   }
 
-  return skipped;
+  return traceSkipSomeEnd(skipped);
 
   // cppcheck-suppress style
   DEBUG_END_BLOCK();
@@ -455,6 +516,33 @@ bool GatherBlock::getBlock(size_t i, size_t atLeast, size_t atMost) {
   DEBUG_END_BLOCK();
 }
 
+/// @brief prefetch: start getSome requests for all remote dependencies
+/// with an empty buffer at once
+void GatherBlock::prefetch(size_t atLeast, size_t atMost) {
+  TRI_ASSERT(!_isSimple);
+
+  size_t empty = 0;
+  for (auto const& it : _gatherBlockBuffer) {
+    if (it.empty()) {
+      ++empty;
+    }
+  }
+
+  if (empty < 2) {
+    // nothing to parallelize
+    return;
+  }
+
+  for (size_t i = 0; i < _dependencies.size(); i++) {
+    if (_gatherBlockBuffer.at(i).empty()) {
+      auto remote = dynamic_cast<RemoteBlock*>(_dependencies.at(i));
+      if (remote != nullptr) {
+        remote->prefetchSome(atLeast, atMost);
+      }
+    }
+  }
+}
+
 /// @brief OurLessThan: comparison method for elements of _gatherBlockPos
 bool GatherBlock::OurLessThan::operator()(std::pair<size_t, size_t> const& a,
                                           std::pair<size_t, size_t> const& b) {
@@ -682,7 +770,7 @@ bool ScatterBlock::hasMoreForShard(std::string const& shardId) {
   // _buffer.at(i) we are sending to <clientId>
 
   if (pos.first > _buffer.size()) {
-    if (!ExecutionBlock::getBlock(DefaultBatchSize(), DefaultBatchSize())) {
+    if (!ExecutionBlock::getBlock(batchSize(), batchSize())) {
       _doneForClient.at(clientId) = true;
       return false;
     }
@@ -799,7 +887,10 @@ DistributeBlock::DistributeBlock(ExecutionEngine* engine,
       _index(0),
       _regId(ExecutionNode::MaxRegisterId),
       _alternativeRegId(ExecutionNode::MaxRegisterId),
-      _allowSpecifiedKeys(false) {
+      _allowSpecifiedKeys(false),
+      _nextKey(0),
+      _keysEnd(0),
+      _keysWanted(1) {
   // get the variable to inspect . . .
   VariableId varId = ep->_varId;
 
@@ -877,7 +968,7 @@ bool DistributeBlock::hasMoreForShard(std::string const& shardId) {
     return true;
   }
 
-  if (!getBlockForClient(DefaultBatchSize(), DefaultBatchSize(), clientId)) {
+  if (!getBlockForClient(batchSize(), batchSize(), clientId)) {
     _doneForClient.at(clientId) = true;
     return false;
   }
@@ -941,7 +1032,8 @@ int DistributeBlock::getOrSkipSomeForShard(size_t atLeast, size_t atMost,
       }
     }
 
-    std::unique_ptr<AqlItemBlock> more(_buffer.at(n)->slice(chosen, 0, chosen.size()));
+    // every row is handed out once, so its values can be moved
+    std::unique_ptr<AqlItemBlock> more(_buffer.at(n)->move(chosen, 0, chosen.size()));
     collector.add(std::move(more));
   }
 
@@ -985,40 +1077,84 @@ bool DistributeBlock::getBlockForClient(size_t atLeast, size_t atMost,
       }
     }
 
-    AqlItemBlock* cur = _buffer.at(_index);
+    // this may modify the input item buffer in place
+    distributeBlock(_buffer.at(_index));
 
-    while (_pos < cur->size() && buf.at(clientId).size() < atMost) {
-      // this may modify the input item buffer in place
-      size_t id = sendToClient(cur);
+    _pos = 0;
+    _index++;
+  }
 
-      buf.at(id).emplace_back(std::make_pair(_index, _pos++));
-    }
+  return true;
 
-    if (_pos == cur->size()) {
-      _pos = 0;
-      _index++;
-    } else {
-      break;
+  // cppcheck-suppress style
+  DEBUG_END_BLOCK();
+}
+
+/// @brief distributeBlock: determine the clients of all remaining rows of
+/// the incoming AqlItemBlock at once. the rows are prepared first, then the
+/// shards of all of them are computed in one go, and mapped to client ids
+/// by shard position instead of by name
+void DistributeBlock::distributeBlock(AqlItemBlock* cur) {
+  DEBUG_BEGIN_BLOCK();
+
+  size_t const n = cur->size();
+  TRI_ASSERT(_pos < n);
+
+  std::vector<VPackSlice> values;
+  values.reserve(n - _pos);
+
+  for (size_t row = _pos; row < n; ++row) {
+    // keys for all remaining rows are allocated at once
+    _keysWanted = n - row;
+    values.emplace_back(prepareRow(cur, row));
+  }
+
+  std::vector<size_t> shardIndexes;
+  std::shared_ptr<std::vector<std::string>> shards;
+  auto clusterInfo = arangodb::ClusterInfo::instance();
+  auto collInfo = _collection->getCollection();
+
+  int res = clusterInfo->getResponsibleShards(collInfo.get(), values, true,
+                                              shards, shardIndexes);
+
+  if (res != TRI_ERROR_NO_ERROR) {
+    THROW_ARANGO_EXCEPTION(res);
+  }
+
+  TRI_ASSERT(shards != nullptr && !shards->empty());
+  TRI_ASSERT(shardIndexes.size() == values.size());
+
+  if (shards != _shards) {
+    _shards = shards;
+    _shardToClient.assign(shards->size(), _nrClients);
+  }
+
+  for (size_t i = 0; i < shardIndexes.size(); ++i) {
+    size_t& clientId = _shardToClient[shardIndexes[i]];
+    if (clientId == _nrClients) {
+      clientId = getClientId((*shards)[shardIndexes[i]]);
     }
+    _distBuffer[clientId].emplace_back(_index, _pos + i);
   }
 
-  return true;
+  _pos = n;
 
   // cppcheck-suppress style
   DEBUG_END_BLOCK();
 }
 
-/// @brief sendToClient: for each row of the incoming AqlItemBlock use the
-/// attributes <shardKeys> of the Aql value <val> to determine to which shard
-/// the row should be sent and return its clientId
-size_t DistributeBlock::sendToClient(AqlItemBlock* cur) {
+/// @brief prepareRow: make the value of a row ready for sending. keys are
+/// converted to documents, and missing keys are created if we are
+/// responsible for that. the value is modified in the input item buffer
+/// in place, and the returned slice points into it
+VPackSlice DistributeBlock::prepareRow(AqlItemBlock* cur, size_t row) {
   DEBUG_BEGIN_BLOCK();
 
-  // inspect cur in row _pos and check to which shard it should be sent . .
-  AqlValue val = cur->getValueReference(_pos, _regId);
+  AqlValue val = cur->getValueReference(row, _regId);
 
   VPackSlice input = val.slice();  // will throw when wrong type
 
+  RegisterId regId = _regId;
   bool usedAlternativeRegId = false;
 
   if (input.isNull() && _alternativeRegId != ExecutionNode::MaxRegisterId) {
@@ -1026,112 +1162,66 @@ size_t DistributeBlock::sendToClient(AqlItemBlock* cur) {
     // check if there is a second input register available (UPSERT makes use of
     // two input registers,
     // one for the search document, the other for the insert document)
-    val = cur->getValueReference(_pos, _alternativeRegId);
+    val = cur->getValueReference(row, _alternativeRegId);
 
     input = val.slice();  // will throw when wrong type
+    regId = _alternativeRegId;
     usedAlternativeRegId = true;
   }
 
-  VPackSlice value = input;
-
-  VPackBuilder builder;
-  VPackBuilder builder2;
-
   bool hasCreatedKeyAttribute = false;
 
   if (input.isString() &&
       static_cast<DistributeNode const*>(_exeNode)
           ->_allowKeyConversionToObject) {
+    VPackBuilder builder;
     builder.openObject();
     builder.add(StaticStrings::KeyString, input);
     builder.close();
 
     // clear the previous value
-    cur->destroyValue(_pos, _regId);
+    cur->destroyValue(row, _regId);
 
     // overwrite with new value
-    cur->setValue(_pos, _regId, AqlValue(builder));
+    cur->setValue(row, _regId, AqlValue(builder));
 
-    value = builder.slice();
+    input = cur->getValueReference(row, _regId).slice();
     hasCreatedKeyAttribute = true;
   } else if (!input.isObject()) {
     THROW_ARANGO_EXCEPTION(TRI_ERROR_ARANGO_DOCUMENT_TYPE_INVALID);
   }
 
-  TRI_ASSERT(value.isObject());
+  TRI_ASSERT(input.isObject());
 
   if (static_cast<DistributeNode const*>(_exeNode)->_createKeys) {
     // we are responsible for creating keys if none present
-
-    if (_usesDefaultSharding) {
-      // the collection is sharded by _key...
-
-      if (!hasCreatedKeyAttribute && !value.hasKey(StaticStrings::KeyString)) {
-        // there is no _key attribute present, so we are responsible for
-        // creating one
-        VPackBuilder temp;
-        temp.openObject();
-        temp.add(StaticStrings::KeyString, VPackValue(createKey(value)));
-        temp.close();
-
-        builder2 = VPackCollection::merge(input, temp.slice(), true);
-
-        // clear the previous value and overwrite with new value:
-        if (usedAlternativeRegId) {
-          cur->destroyValue(_pos, _alternativeRegId);
-          cur->setValue(_pos, _alternativeRegId, AqlValue(builder2));
-        } else {
-          cur->destroyValue(_pos, _regId);
-          cur->setValue(_pos, _regId, AqlValue(builder2));
-        }
-        value = builder2.slice();
-      }
-    } else {
-      // the collection is not sharded by _key
-
-      if (hasCreatedKeyAttribute || value.hasKey(StaticStrings::KeyString)) {
-        // a _key was given, but user is not allowed to specify _key
-        if (usedAlternativeRegId || !_allowSpecifiedKeys) {
-          THROW_ARANGO_EXCEPTION(TRI_ERROR_CLUSTER_MUST_NOT_SPECIFY_KEY);
-        }
-      } else {
-        VPackBuilder temp;
-        temp.openObject();
-        temp.add(StaticStrings::KeyString, VPackValue(createKey(value)));
-        temp.close();
-
-        builder2 = VPackCollection::merge(input, temp.slice(), true);
-
-        // clear the previous value and overwrite with new value:
-        if (usedAlternativeRegId) {
-          cur->destroyValue(_pos, _alternativeRegId);
-          cur->setValue(_pos, _alternativeRegId, AqlValue(builder2.slice()));
-        } else {
-          cur->destroyValue(_pos, _regId);
-          cur->setValue(_pos, _regId, AqlValue(builder2.slice()));
-        }
-        value = builder2.slice();
+    bool const hasKey =
+        hasCreatedKeyAttribute || input.hasKey(StaticStrings::KeyString);
+
+    if (hasKey && !_usesDefaultSharding) {
+      // the collection is not sharded by _key, and a _key was given, but
+      // the user is not allowed to specify _key
+      if (usedAlternativeRegId || !_allowSpecifiedKeys) {
+        THROW_ARANGO_EXCEPTION(TRI_ERROR_CLUSTER_MUST_NOT_SPECIFY_KEY);
       }
+    } else if (!hasKey) {
+      // there is no _key attribute present, so we are responsible for
+      // creating one
+      VPackBuilder temp;
+      temp.openObject();
+      temp.add(StaticStrings::KeyString, VPackValue(createKey(input)));
+      temp.close();
+
+      VPackBuilder merged = VPackCollection::merge(input, temp.slice(), true);
+
+      // clear the previous value and overwrite with new value:
+      cur->destroyValue(row, regId);
+      cur->setValue(row, regId, AqlValue(merged));
+      input = cur->getValueReference(row, regId).slice();
     }
   }
 
-  std::string shardId;
-  bool usesDefaultShardingAttributes;
-  auto clusterInfo = arangodb::ClusterInfo::instance();
-  auto collInfo = _collection->getCollection();
-
-  int res = clusterInfo->getResponsibleShard(collInfo.get(), value, true,
-      shardId, usesDefaultShardingAttributes);
-
-  // std::cout << "SHARDID: " << shardId << "\n";
-
-  if (res != TRI_ERROR_NO_ERROR) {
-    THROW_ARANGO_EXCEPTION(res);
-  }
-
-  TRI_ASSERT(!shardId.empty());
-
-  return getClientId(shardId);
+  return input;
 
   // cppcheck-suppress style
   DEBUG_END_BLOCK();
@@ -1140,9 +1230,14 @@ size_t DistributeBlock::sendToClient(AqlItemBlock* cur) {
 /// @brief create a new document key, argument is unused here
 #ifndef USE_ENTERPRISE
 std::string DistributeBlock::createKey(VPackSlice) const {
-  ClusterInfo* ci = ClusterInfo::instance();
-  uint64_t uid = ci->uniqid();
-  return std::to_string(uid);
+  if (_nextKey == _keysEnd) {
+    // allocate the keys for all rows still to be distributed at once
+    uint64_t const n = static_cast<uint64_t>((std::max)(_keysWanted, size_t(1)));
+    ClusterInfo* ci = ClusterInfo::instance();
+    _nextKey = ci->uniqid(n);
+    _keysEnd = _nextKey + n;
+  }
+  return std::to_string(_nextKey++);
 }
 #endif
 
@@ -1218,6 +1313,17 @@ static bool throwExceptionAfterBadSyncRequest(ClusterCommResult* res,
   DEBUG_END_BLOCK();
 }
 
+/// @brief build the body of a getSome request
+static std::string getSomeBody(size_t atLeast, size_t atMost) {
+  VPackBuilder builder;
+  builder.openObject();
+  builder.add("atLeast", VPackValue(atLeast));
+  builder.add("atMost", VPackValue(atMost));
+  builder.close();
+
+  return builder.slice().toJson();
+}
+
 /// @brief timeout
 double const RemoteBlock::defaultTimeOut = 3600.0;
 
@@ -1230,7 +1336,10 @@ RemoteBlock::RemoteBlock(ExecutionEngine* engine, RemoteNode const* en,
       _ownName(ownName),
       _queryId(queryId),
       _isResponsibleForInitializeCursor(
-          en->isResponsibleForInitializeCursor()) {
+          en->isResponsibleForInitializeCursor()),
+      _prefetchId(0),
+      _pendingPos(0),
+      _shutdownId(0) {
   TRI_ASSERT(!queryId.empty());
   TRI_ASSERT(
       (arangodb::ServerState::instance()->isCoordinator() && ownName.empty()) ||
@@ -1238,7 +1347,23 @@ RemoteBlock::RemoteBlock(ExecutionEngine* engine, RemoteNode const* en,
        !ownName.empty()));
 }
 
-RemoteBlock::~RemoteBlock() {}
+RemoteBlock::~RemoteBlock() {
+  try {
+    discardPrefetch();
+    if (_shutdownId != 0) {
+      waitForRequest(_shutdownId);
+    }
+  } catch (...) {
+  }
+}
+
+/// @brief build the URL for a request to our query
+std::string RemoteBlock::url(std::string const& urlPart) const {
+  return std::string("/_db/") +
+         arangodb::basics::StringUtils::urlEncode(
+             _engine->getQuery()->trx()->vocbase()->name()) +
+         urlPart + _queryId;
+}
 
 /// @brief local helper to send a request
 std::unique_ptr<ClusterCommResult> RemoteBlock::sendRequest(
@@ -1264,11 +1389,7 @@ std::unique_ptr<ClusterCommResult> RemoteBlock::sendRequest(
 
       auto result =
           cc->syncRequest(clientTransactionId, coordTransactionId, _server, type,
-                          std::string("/_db/") +
-                              arangodb::basics::StringUtils::urlEncode(
-                                  _engine->getQuery()->trx()->vocbase()->name()) +
-                              urlPart + _queryId,
-                          body, headers, defaultTimeOut);
+                          url(urlPart), body, headers, defaultTimeOut);
 
       return result;
     }
@@ -1279,6 +1400,128 @@ std::unique_ptr<ClusterCommResult> RemoteBlock::sendRequest(
   DEBUG_END_BLOCK();
 }
 
+/// @brief send a getSome request without waiting for the response
+void RemoteBlock::prefetchSome(size_t atLeast, size_t atMost) {
+  DEBUG_BEGIN_BLOCK();
+  if (_prefetchId != 0 || _pending != nullptr) {
+    // already in flight, or rows of the last one are still left
+    return;
+  }
+
+  auto cc = ClusterComm::instance();
+  if (cc == nullptr) {
+    // nullptr only happens on controlled shutdown
+    return;
+  }
+  
+  auto body = std::make_shared<std::string const>(getSomeBody(atLeast, atMost));
+  auto headers = std::make_unique<std::unordered_map<std::string, std::string>>();
+  if (!_ownName.empty()) {
+    headers->emplace("Shard-Id", _ownName);
+  }
+
+  ++_engine->_stats.httpRequests;
+  // a single request, so the response ends up in the result just like
+  // for syncRequest
+  _prefetchId = cc->asyncRequest("AQL", TRI_NewTickServer(), _server,
+                                 rest::RequestType::PUT,
+                                 url("/_api/aql/getSome/"), body, headers,
+                                 nullptr, defaultTimeOut, true);
+
+  // cppcheck-suppress style
+  DEBUG_END_BLOCK();
+}
+
+/// @brief send the shutdown request without waiting for the response
+void RemoteBlock::prefetchShutdown(int errorCode) {
+  DEBUG_BEGIN_BLOCK();
+  if (!_isResponsibleForInitializeCursor || _shutdownId != 0) {
+    return;
+  }
+
+  discardPrefetch();
+
+  auto cc = ClusterComm::instance();
+  if (cc == nullptr) {
+    // nullptr only happens on controlled shutdown
+    return;
+  }
+
+  auto body = std::make_shared<std::string const>(
+      "{\"code\":" + std::to_string(errorCode) + "}");
+  auto headers = std::make_unique<std::unordered_map<std::string, std::string>>();
+  if (!_ownName.empty()) {
+    headers->emplace("Shard-Id", _ownName);
+  }
+
+  ++_engine->_stats.httpRequests;
+  _shutdownId = cc->asyncRequest("AQL", TRI_NewTickServer(), _server,
+                                 rest::RequestType::PUT,
+                                 url("/_api/aql/shutdown/"), body, headers,
+                                 nullptr, defaultTimeOut, true);
+
+  // cppcheck-suppress style
+  DEBUG_END_BLOCK();
+}
+
+/// @brief wait for the response of the prefetched getSome request
+std::unique_ptr<ClusterCommResult> RemoteBlock::waitForPrefetch() {
+  return waitForRequest(_prefetchId);
+}
+
+/// @brief wait for the response of an asynchronous request, and reset its
+/// operation id
+std::unique_ptr<ClusterCommResult> RemoteBlock::waitForRequest(
+    uint64_t& operationId) {
+  TRI_ASSERT(operationId != 0);
+  OperationID const id = operationId;
+  operationId = 0;
+
+  auto cc = ClusterComm::instance();
+  if (cc == nullptr) {
+    // nullptr only happens on controlled shutdown
+    return std::make_unique<ClusterCommResult>();
+  }
+  return std::make_unique<ClusterCommResult>(cc->wait("", 0, id, ""));
+}
+
+/// @brief wait for and throw away the response of a prefetched getSome
+/// request, if any, and the rows left over from an earlier one
+void RemoteBlock::discardPrefetch() {
+  if (_prefetchId != 0) {
+    waitForPrefetch();
+  }
+  _pending.reset();
+  _pendingPos = 0;
+}
+
+/// @brief wait for the response of the prefetched getSome request and
+/// keep its rows in _pending. the response may contain more rows than the
+/// caller asks for, so getSome and skipSome hand them out from there
+void RemoteBlock::takePrefetch() {
+  TRI_ASSERT(_prefetchId != 0);
+  TRI_ASSERT(_pending == nullptr);
+
+  std::unique_ptr<ClusterCommResult> res;
+  {
+    JobGuard guard(SchedulerFeature::SCHEDULER);
+    guard.block();
+
+    res = waitForPrefetch();
+  }
+  throwExceptionAfterBadSyncRequest(res.get(), false);
+
+  std::shared_ptr<VPackBuilder> responseBodyBuilder =
+      res->result->getBodyVelocyPack();
+  VPackSlice responseBody = responseBodyBuilder->slice();
+
+  if (!VelocyPackHelper::getBooleanValue(responseBody, "exhausted", true)) {
+    _pending.reset(new AqlItemBlock(_engine->getQuery()->resourceMonitor(),
+                                    responseBody));
+    _pendingPos = 0;
+  }
+}
+
 /// @brief initialize
 int RemoteBlock::initialize() {
   DEBUG_BEGIN_BLOCK();
@@ -1314,6 +1557,9 @@ int RemoteBlock::initializeCursor(AqlItemBlock* items, size_t pos) {
   DEBUG_BEGIN_BLOCK();
   // For every call we simply forward via HTTP
 
+  // a prefetched result belongs to the previous cursor
+  discardPrefetch();
+
   if (!_isResponsibleForInitializeCursor) {
     // do nothing...
     return TRI_ERROR_NO_ERROR;
@@ -1370,17 +1616,27 @@ int RemoteBlock::initializeCursor(AqlItemBlock* items, size_t pos) {
 /// @brief shutdown, will be called exactly once for the whole query
 int RemoteBlock::shutdown(int errorCode) {
   DEBUG_BEGIN_BLOCK();
+  
+  discardPrefetch();
 
   if (!_isResponsibleForInitializeCursor) {
     // do nothing...
     return TRI_ERROR_NO_ERROR;
   }
 
-  // For every call we simply forward via HTTP
+  // For every call we simply forward via HTTP, unless the request has
+  // already been sent by prefetchShutdown
 
-  std::unique_ptr<ClusterCommResult> res =
-      sendRequest(rest::RequestType::PUT, "/_api/aql/shutdown/",
-                  std::string("{\"code\":" + std::to_string(errorCode) + "}"));
+  std::unique_ptr<ClusterCommResult> res;
+  if (_shutdownId != 0) {
+    JobGuard guard(SchedulerFeature::SCHEDULER);
+    guard.block();
+
+    res = waitForRequest(_shutdownId);
+  } else {
+    res = sendRequest(rest::RequestType::PUT, "/_api/aql/shutdown/",
+                      std::string("{\"code\":" + std::to_string(errorCode) + "}"));
+  }
   if (throwExceptionAfterBadSyncRequest(res.get(), true)) {
     // artificially ignore error in case query was not found during shutdown
     return TRI_ERROR_NO_ERROR;
@@ -1430,16 +1686,41 @@ AqlItemBlock* RemoteBlock::getSome(size_t atLeast, size_t atMost) {
   
   traceGetSomeBegin();
 
-  VPackBuilder builder;
-  builder.openObject();
-  builder.add("atLeast", VPackValue(atLeast));
-  builder.add("atMost", VPackValue(atMost));
-  builder.close();
+  if (_prefetchId != 0) {
+    // the request has already been sent by prefetchSome
+    takePrefetch();
+    if (_pending == nullptr) {
+      traceGetSomeEnd(nullptr);
+      return nullptr;
+    }
+  }
 
-  std::string bodyString(builder.slice().toJson());
+  if (_pending != nullptr) {
+    // hand out rows of a prefetched response
+    size_t const available = _pending->size() - _pendingPos;
+    std::unique_ptr<AqlItemBlock> r;
+
+    if (_pendingPos == 0 && available <= atMost) {
+      r = std::move(_pending);
+    } else {
+      size_t const to = _pendingPos + (std::min)(available, atMost);
+      r.reset(_pending->slice(_pendingPos, to));
+      _pendingPos = to;
+      if (_pendingPos == _pending->size()) {
+        _pending.reset();
+      }
+    }
+    if (_pending == nullptr) {
+      _pendingPos = 0;
+    }
+
+    traceGetSomeEnd(r.get());
+    return r.release();
+  }
 
   std::unique_ptr<ClusterCommResult> res =
-      sendRequest(rest::RequestType::PUT, "/_api/aql/getSome/", bodyString);
+      sendRequest(rest::RequestType::PUT, "/_api/aql/getSome/",
+                  getSomeBody(atLeast, atMost));
   throwExceptionAfterBadSyncRequest(res.get(), false);
 
   // If we get here, then res->result is the response which will be
@@ -1464,6 +1745,28 @@ AqlItemBlock* RemoteBlock::getSome(size_t atLeast, size_t atMost) {
 /// @brief skipSome
 size_t RemoteBlock::skipSome(size_t atLeast, size_t atMost) {
   DEBUG_BEGIN_BLOCK();
+  traceSkipSomeBegin();
+
+  if (_prefetchId != 0) {
+    // the request has already been sent by prefetchSome
+    takePrefetch();
+    if (_pending == nullptr) {
+      return traceSkipSomeEnd(0);
+    }
+  }
+
+  if (_pending != nullptr) {
+    // skip rows of a prefetched response
+    size_t const skipped =
+        (std::min)(_pending->size() - _pendingPos, atMost);
+    _pendingPos += skipped;
+    if (_pendingPos == _pending->size()) {
+      _pending.reset();
+      _pendingPos = 0;
+    }
+    return traceSkipSomeEnd(skipped);
+  }
+
   // For every call we simply forward via HTTP
 
   VPackBuilder builder;
@@ -1493,7 +1796,7 @@ size_t RemoteBlock::skipSome(size_t atLeast, size_t atMost) {
     if (slice.hasKey("skipped")) {
       skipped = slice.get("skipped").getNumericValue<size_t>();
     }
-    return skipped;
+    return traceSkipSomeEnd(skipped);
   }
 
   // cppcheck-suppress style
@@ -1503,6 +1806,13 @@ size_t RemoteBlock::skipSome(size_t atLeast, size_t atMost) {
 /// @brief hasMore
 bool RemoteBlock::hasMore() {
   DEBUG_BEGIN_BLOCK();
+  if (_prefetchId != 0) {
+    takePrefetch();
+  }
+  if (_pending != nullptr) {
+    return true;
+  }
+
   // For every call we simply forward via HTTP
   std::unique_ptr<ClusterCommResult> res =
       sendRequest(rest::RequestType::GET, "/_api/aql/hasMore/", std::string());
@@ -1560,6 +1870,12 @@ int64_t RemoteBlock::count() const {
 /// @brief remaining
 int64_t RemoteBlock::remaining() {
   DEBUG_BEGIN_BLOCK();
+  if (_prefetchId != 0) {
+    takePrefetch();
+  }
+  int64_t const pending =
+      (_pending == nullptr) ? 0 : static_cast<int64_t>(_pending->size() - _pendingPos);
+
   // For every call we simply forward via HTTP
   std::unique_ptr<ClusterCommResult> res = sendRequest(
       rest::RequestType::GET, "/_api/aql/remaining/", std::string());
@@ -1580,7 +1896,10 @@ int64_t RemoteBlock::remaining() {
   if (slice.hasKey("remaining")) {
     remaining = slice.get("remaining").getNumericValue<int64_t>();
   }
-  return remaining;
+  if (remaining == -1) {
+    return remaining;
+  }
+  return remaining + pending;
 
   // cppcheck-suppress style
   DEBUG_END_BLOCK();
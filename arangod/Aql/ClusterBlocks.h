@@ -75,11 +75,38 @@ class GatherBlock : public ExecutionBlock {
   /// @brief skipSome
   size_t skipSome(size_t, size_t) override final;
 
+  /// @brief buildHeap: put all dependencies with buffered rows into a heap
+  /// that has the dependency with the smallest current row on top. merging
+  /// then needs O(log n) instead of O(n) comparisons per row. heapLess
+  /// compares two dependency numbers and returns true if the first one's
+  /// current row sorts after the second one's
+  template <typename HeapLessType>
+  static void buildHeap(
+      std::vector<size_t>& heap,
+      std::vector<std::deque<AqlItemBlock*>> const& gatherBlockBuffer,
+      HeapLessType heapLess) {
+    heap.clear();
+    heap.reserve(gatherBlockBuffer.size());
+
+    for (size_t i = 0; i < gatherBlockBuffer.size(); i++) {
+      if (!gatherBlockBuffer[i].empty()) {
+        heap.emplace_back(i);
+      }
+    }
+
+    std::make_heap(heap.begin(), heap.end(), heapLess);
+  }
+
  protected:
   /// @brief getBlock: from dependency i into _gatherBlockBuffer.at(i),
   /// non-simple case only
   bool getBlock(size_t i, size_t atLeast, size_t atMost);
 
+  /// @brief prefetch: start getSome requests for all remote dependencies
+  /// with an empty buffer at once, so that the subsequent getBlock calls
+  /// only wait for the slowest shard instead of for all shards in turn
+  void prefetch(size_t atLeast, size_t atMost);
+
   /// @brief _gatherBlockBuffer: buffer the incoming block from each dependency
   /// separately
   std::vector<std::deque<AqlItemBlock*>> _gatherBlockBuffer;
@@ -117,6 +144,23 @@ class GatherBlock : public ExecutionBlock {
     std::vector<std::deque<AqlItemBlock*>>& _gatherBlockBuffer;
     std::vector<SortElementBlock>& _sortRegisters;
   };
+
+  /// @brief HeapLess: orders dependency indexes by their current rows so
+  /// that the std heap functions keep the smallest row on top
+  class HeapLess {
+   public:
+    HeapLess(std::vector<std::pair<size_t, size_t>> const& gatherBlockPos,
+             OurLessThan& ourLessThan)
+        : _gatherBlockPos(gatherBlockPos), _ourLessThan(ourLessThan) {}
+
+    bool operator()(size_t a, size_t b) const {
+      return _ourLessThan(_gatherBlockPos[b], _gatherBlockPos[a]);
+    }
+
+   private:
+    std::vector<std::pair<size_t, size_t>> const& _gatherBlockPos;
+    OurLessThan& _ourLessThan;
+  };
 };
 
 class BlockWithClients : public ExecutionBlock {
@@ -256,11 +300,14 @@ class DistributeBlock : public BlockWithClients {
   /// _distBuffer.at(clientId).
   bool getBlockForClient(size_t atLeast, size_t atMost, size_t clientId);
 
-  /// @brief sendToClient: for each row of the incoming AqlItemBlock use the
-  /// attributes <shardKeys> of the register <id> to determine to which shard
-  /// the
-  /// row should be sent.
-  size_t sendToClient(AqlItemBlock*);
+  /// @brief distributeBlock: determine the clients of all remaining rows of
+  /// the incoming AqlItemBlock at once, and append the rows to the buffers
+  /// of their clients
+  void distributeBlock(AqlItemBlock*);
+
+  /// @brief prepareRow: make the value of a row ready for sending, i.e.
+  /// convert keys to documents and create missing keys, and return it
+  arangodb::velocypack::Slice prepareRow(AqlItemBlock*, size_t row);
 
   /// @brief create a new document key
   std::string createKey(arangodb::velocypack::Slice) const;
@@ -287,6 +334,20 @@ class DistributeBlock : public BlockWithClients {
 
   /// @brief allow specified keys even in non-default sharding case
   bool _allowSpecifiedKeys;
+
+  /// @brief the shards of the collection, as last returned by the cluster
+  /// info, and the client id of each of them (or _nrClients if not known
+  /// yet)
+  std::shared_ptr<std::vector<std::string>> _shards;
+  std::vector<size_t> _shardToClient;
+
+  /// @brief the range of document keys allocated in advance
+  mutable uint64_t _nextKey;
+  mutable uint64_t _keysEnd;
+
+  /// @brief the number of keys to allocate when the range is used up,
+  /// i.e. the number of rows still to be distributed
+  size_t _keysWanted;
 };
 
 class RemoteBlock : public ExecutionBlock {
@@ -325,12 +386,40 @@ class RemoteBlock : public ExecutionBlock {
   /// @brief remaining
   int64_t remaining() override final;
 
+  /// @brief send a getSome request without waiting for the response. the
+  /// response is picked up by the next call to getSome, skipSome or hasMore.
+  /// rows of it that the caller does not ask for are kept for later calls
+  void prefetchSome(size_t atLeast, size_t atMost);
+
+  /// @brief send the shutdown request without waiting for the response.
+  /// the response is picked up by the next call to shutdown
+  void prefetchShutdown(int errorCode);
+
   /// @brief internal method to send a request
  private:
   std::unique_ptr<arangodb::ClusterCommResult> sendRequest(
       rest::RequestType type, std::string const& urlPart,
       std::string const& body) const;
 
+  /// @brief build the URL for a request to our query
+  std::string url(std::string const& urlPart) const;
+
+  /// @brief wait for the response of the prefetched getSome request
+  std::unique_ptr<arangodb::ClusterCommResult> waitForPrefetch();
+
+  /// @brief wait for the response of an asynchronous request, and reset its
+  /// operation id
+  std::unique_ptr<arangodb::ClusterCommResult> waitForRequest(
+      uint64_t& operationId);
+
+  /// @brief wait for and throw away the response of a prefetched getSome
+  /// request, if any, and the rows left over from an earlier one
+  void discardPrefetch();
+
+  /// @brief wait for the response of the prefetched getSome request and
+  /// keep its rows in _pending
+  void takePrefetch();
+
   /// @brief our server, can be like "shard:S1000" or like "server:Claus"
   std::string _server;
 
@@ -344,6 +433,19 @@ class RemoteBlock : public ExecutionBlock {
   /// @brief whether or not this block will forward initialize, 
   /// initializeCursor or shutDown requests
   bool const _isResponsibleForInitializeCursor;
+
+  /// @brief operation id of a prefetched getSome request, 0 if none is
+  /// in flight
+  uint64_t _prefetchId;
+
+  /// @brief rows of a prefetched response that have not been handed out
+  /// yet, starting at _pendingPos
+  std::unique_ptr<AqlItemBlock> _pending;
+  size_t _pendingPos;
+
+  /// @brief operation id of a prefetched shutdown request, 0 if none is
+  /// in flight
+  uint64_t _shutdownId;
 };
 
 }  // namespace arangodb::aql
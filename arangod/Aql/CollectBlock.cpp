@@ -26,6 +26,8 @@
 #include "Aql/AqlValue.h"
 #include "Aql/AqlItemBlock.h"
 #include "Aql/ExecutionEngine.h"
+#include "Aql/Query.h"
+#include "Aql/SpillFile.h"
 #include "Basics/Exceptions.h"
 #include "Basics/VelocyPackHelper.h"
 #include "VocBase/vocbase.h"
@@ -34,6 +36,13 @@ using namespace arangodb::aql;
 
 static AqlValue EmptyValue;
 
+/// @brief number of partitions rows are spilled into
+static size_t const SpillPartitions = 16;
+
+/// @brief maximum number of times rows are re-partitioned. partitions
+/// on this level are aggregated in memory, regardless of their size
+static size_t const MaxSpillLevel = 4;
+
 /// @brief get the value from an input register
 /// for a reduce function that does not require input, this will return a
 /// reference to a static empty AqlValue
@@ -520,7 +529,8 @@ HashedCollectBlock::HashedCollectBlock(ExecutionEngine* engine,
     : ExecutionBlock(engine, en),
       _groupRegisters(),
       _aggregateRegisters(),
-      _collectRegister(ExecutionNode::MaxRegisterId) {
+      _collectRegister(ExecutionNode::MaxRegisterId),
+      _spillThreshold(engine->getQuery()->spillThreshold()) {
   for (auto const& p : en->_groupVariables) {
     // We know that planRegisters() has been run, so
     // getPlanNode()->_registerPlan is set up
@@ -575,6 +585,25 @@ HashedCollectBlock::HashedCollectBlock(ExecutionEngine* engine,
 
 HashedCollectBlock::~HashedCollectBlock() {}
 
+HashedCollectBlock::SpilledPartition::SpilledPartition(
+    std::unique_ptr<SpillFile>&& file, size_t level)
+    : file(std::move(file)), level(level) {}
+
+HashedCollectBlock::SpilledPartition::SpilledPartition(SpilledPartition&&) =
+    default;
+
+HashedCollectBlock::SpilledPartition&
+HashedCollectBlock::SpilledPartition::operator=(SpilledPartition&&) = default;
+
+HashedCollectBlock::SpilledPartition::~SpilledPartition() {}
+
+int HashedCollectBlock::initializeCursor(AqlItemBlock* items, size_t pos) {
+  _partitions.clear();
+  _inheritRow.reset();
+
+  return ExecutionBlock::initializeCursor(items, pos);
+}
+
 int HashedCollectBlock::getOrSkipSome(size_t atLeast, size_t atMost,
                                       bool skipping, AqlItemBlock*& result,
                                       size_t& skipped) {
@@ -584,6 +613,12 @@ int HashedCollectBlock::getOrSkipSome(size_t atLeast, size_t atMost,
     return TRI_ERROR_NO_ERROR;
   }
 
+  if (!_partitions.empty()) {
+    // all input has been consumed, but there are still spilled partitions
+    aggregatePartition(skipping, result, skipped);
+    return TRI_ERROR_NO_ERROR;
+  }
+
   if (_buffer.empty()) {
     if (!ExecutionBlock::getBlock(atLeast, atMost)) {
       // done
@@ -599,14 +634,12 @@ int HashedCollectBlock::getOrSkipSome(size_t atLeast, size_t atMost,
   // If we get here, we do have _buffer.front()
   AqlItemBlock* cur = _buffer.front();
   TRI_ASSERT(cur != nullptr);
-  size_t const curNrRegs = cur->getNrRegs();
+  RegisterId const curNrRegs = cur->getNrRegs();
 
   TRI_ASSERT(_aggregateRegisters.size() == en->_aggregateVariables.size());
 
-  std::unordered_map<std::vector<AqlValue>, AggregateValuesType*, GroupKeyHash,
-                     GroupKeyEqual> allGroups(1024,
-                                              GroupKeyHash(_trx, _groupRegisters.size()),
-                                              GroupKeyEqual(_trx));
+  GroupMap allGroups(1024, GroupKeyHash(_trx, _groupRegisters.size()),
+                     GroupKeyEqual(_trx));
 
   // cleanup function for group values
   auto cleanup = [&allGroups]() -> void {
@@ -618,55 +651,6 @@ int HashedCollectBlock::getOrSkipSome(size_t atLeast, size_t atMost,
   // prevent memory leaks by always cleaning up the groups
   TRI_DEFER(cleanup());
 
-  auto buildResult = [&](AqlItemBlock const* src) {
-    RegisterId nrRegs = en->getRegisterPlan()->nrRegs[en->getDepth()];
-
-    std::unique_ptr<AqlItemBlock> result(requestBlock(allGroups.size(), nrRegs));
-
-    if (src != nullptr) {
-      inheritRegisters(src, result.get(), 0);
-    }
-
-    TRI_ASSERT(!en->_count || _collectRegister != ExecutionNode::MaxRegisterId);
-
-    size_t row = 0;
-    for (auto& it : allGroups) {
-      auto& keys = it.first;
-      TRI_ASSERT(it.second != nullptr);
-
-      TRI_ASSERT(keys.size() == _groupRegisters.size());
-      size_t i = 0;
-      for (auto& key : keys) {
-        result->setValue(row, _groupRegisters[i++].first, key);
-        const_cast<AqlValue*>(&key)->erase(); // to prevent double-freeing later
-      }
-
-      if (!en->_count) {
-        TRI_ASSERT(it.second->size() == _aggregateRegisters.size());
-        size_t j = 0;
-        for (auto const& r : *(it.second)) {
-          result->setValue(row, _aggregateRegisters[j++].first,
-                           r->stealValue());
-        }
-      } else if (en->_count) {
-        // set group count in result register
-        TRI_ASSERT(!it.second->empty());
-        result->setValue(row, _collectRegister,
-                         it.second->back()->stealValue());
-      }
-      
-      if (row > 0) {
-        // re-use already copied AQLValues for remaining registers
-        result->copyValuesFromFirstRow(row, static_cast<RegisterId>(curNrRegs));
-      }
-
-
-      ++row;
-    }
-
-    return result.release();
-  };
-
   std::vector<AqlValue> groupValues;
   size_t const n = _groupRegisters.size();
   groupValues.reserve(n);
@@ -674,6 +658,11 @@ int HashedCollectBlock::getOrSkipSome(size_t atLeast, size_t atMost,
   std::vector<AqlValue> group;
   group.reserve(n);
 
+  // estimated memory usage of the groups, and the files for spilling the
+  // rows of new groups once the groups use too much memory
+  size_t memoryUsage = 0;
+  std::vector<std::unique_ptr<SpillFile>> spilled;
+
   try {
     while (skipped < atMost) {
       TRI_IF_FAILURE("HashedCollectBlock::getOrSkipSomeOuter") {
@@ -694,7 +683,25 @@ int HashedCollectBlock::getOrSkipSome(size_t atLeast, size_t atMost,
       // now check if we already know this group
       auto it = allGroups.find(groupValues);
 
-      if (it == allGroups.end()) {
+      if (it == allGroups.end() && !spilled.empty()) {
+        // new group, but no more memory for it. write the row to the
+        // partition of the group, it will be aggregated later
+        _spillBuilder.clear();
+        _spillBuilder.openArray();
+        for (auto const& v : groupValues) {
+          v.toVelocyPack(_trx, _spillBuilder, false);
+        }
+        for (auto const& r : _aggregateRegisters) {
+          AqlValue const& v = GetValueForRegister(cur, _pos, r.second);
+          if (v.isEmpty()) {
+            _spillBuilder.add(VPackValue(VPackValueType::MinKey));
+          } else {
+            v.toVelocyPack(_trx, _spillBuilder, false);
+          }
+        }
+        _spillBuilder.close();
+        spilled[partitionFor(groupValues, 0)]->append(_spillBuilder.slice());
+      } else if (it == allGroups.end()) {
         // new group
         group.clear();
 
@@ -726,9 +733,16 @@ int HashedCollectBlock::getOrSkipSome(size_t atLeast, size_t atMost,
           }
         }
 
+        memoryUsage += groupMemoryUsage(group, aggregateValues.get());
+
         // note: aggregateValues may be a nullptr!
         allGroups.emplace(group, aggregateValues.get());
         aggregateValues.release();
+
+        if (_spillThreshold > 0 && memoryUsage > _spillThreshold) {
+          // from now on, rows of new groups are spilled to disk
+          createPartitions(spilled);
+        }
       } else {
         // existing group
         auto aggregateValues = (*it).second;
@@ -774,10 +788,18 @@ int HashedCollectBlock::getOrSkipSome(size_t atLeast, size_t atMost,
             }
 
             ++skipped;
-            result = buildResult(cur);
+            result = buildResult(allGroups, cur, 0, curNrRegs);
+
+            if (!spilled.empty()) {
+              // keep the inherited registers for the results of the
+              // spilled partitions
+              _inheritRow.reset(requestBlock(1, static_cast<RegisterId>(curNrRegs)));
+              inheritRegisters(cur, _inheritRow.get(), 0);
+              finishPartitions(spilled, 0);
+            }
 
             returnBlock(cur);
-            _done = true;
+            _done = _partitions.empty();
 
             groupValues.clear();
 
@@ -810,11 +832,263 @@ int HashedCollectBlock::getOrSkipSome(size_t atLeast, size_t atMost,
     TRI_ASSERT(skipped > 0);
   }
 
-  result = buildResult(nullptr);
+  result = buildResult(allGroups, nullptr, 0, curNrRegs);
 
   return TRI_ERROR_NO_ERROR;
 }
 
+/// @brief build a result block from the groups
+AqlItemBlock* HashedCollectBlock::buildResult(GroupMap& groups,
+                                              AqlItemBlock const* src,
+                                              size_t srcRow,
+                                              RegisterId curNrRegs) {
+  auto* en = static_cast<CollectNode const*>(_exeNode);
+  RegisterId nrRegs = en->getRegisterPlan()->nrRegs[en->getDepth()];
+
+  std::unique_ptr<AqlItemBlock> result(requestBlock(groups.size(), nrRegs));
+
+  if (src != nullptr) {
+    inheritRegisters(src, result.get(), srcRow);
+  }
+
+  TRI_ASSERT(!en->_count || _collectRegister != ExecutionNode::MaxRegisterId);
+
+  size_t row = 0;
+  for (auto& it : groups) {
+    auto& keys = it.first;
+    TRI_ASSERT(it.second != nullptr);
+
+    TRI_ASSERT(keys.size() == _groupRegisters.size());
+    size_t i = 0;
+    for (auto& key : keys) {
+      result->setValue(row, _groupRegisters[i++].first, key);
+      const_cast<AqlValue*>(&key)->erase(); // to prevent double-freeing later
+    }
+
+    if (!en->_count) {
+      TRI_ASSERT(it.second->size() == _aggregateRegisters.size());
+      size_t j = 0;
+      for (auto const& r : *(it.second)) {
+        result->setValue(row, _aggregateRegisters[j++].first,
+                         r->stealValue());
+      }
+    } else if (en->_count) {
+      // set group count in result register
+      TRI_ASSERT(!it.second->empty());
+      result->setValue(row, _collectRegister,
+                       it.second->back()->stealValue());
+    }
+    
+    if (row > 0) {
+      // re-use already copied AQLValues for remaining registers
+      result->copyValuesFromFirstRow(row, curNrRegs);
+    }
+
+    ++row;
+  }
+
+  return result.release();
+}
+
+/// @brief estimate the memory used by a new group
+size_t HashedCollectBlock::groupMemoryUsage(
+    std::vector<AqlValue> const& group,
+    AggregateValuesType const* aggregateValues) {
+  // hash table node, group vector and aggregators
+  size_t memory = 64 + group.size() * sizeof(AqlValue);
+  for (auto const& it : group) {
+    memory += it.memoryUsage();
+  }
+  if (aggregateValues != nullptr) {
+    memory += aggregateValues->size() * 64;
+  }
+  return memory;
+}
+
+/// @brief determine the partition for a spilled row
+size_t HashedCollectBlock::partitionFor(std::vector<AqlValue> const& groupValues,
+                                        size_t level) const {
+  // use a different seed per level, so rows of a partition that is
+  // re-partitioned are distributed over all new partitions
+  uint64_t hash = 0xdeadbeef + level;
+  for (auto const& it : groupValues) {
+    hash = it.hash(_trx, hash);
+  }
+  return static_cast<size_t>(hash % SpillPartitions);
+}
+
+/// @brief create the files for spilling rows
+void HashedCollectBlock::createPartitions(
+    std::vector<std::unique_ptr<SpillFile>>& spilled) {
+  TRI_ASSERT(spilled.empty());
+  spilled.reserve(SpillPartitions);
+  for (size_t i = 0; i < SpillPartitions; ++i) {
+    spilled.emplace_back(new SpillFile());
+  }
+}
+
+/// @brief finish writing the spilled rows, and queue the partitions that
+/// received any rows
+void HashedCollectBlock::finishPartitions(
+    std::vector<std::unique_ptr<SpillFile>>& spilled, size_t level) {
+  for (auto& it : spilled) {
+    if (it->count() > 0) {
+      it->finish();
+      _partitions.emplace_back(std::move(it), level + 1);
+    }
+  }
+  spilled.clear();
+}
+
+/// @brief aggregate the groups of the next spilled partition
+void HashedCollectBlock::aggregatePartition(bool skipping,
+                                            AqlItemBlock*& result,
+                                            size_t& skipped) {
+  TRI_ASSERT(!_partitions.empty());
+  TRI_ASSERT(_inheritRow != nullptr);
+
+  auto* en = static_cast<CollectNode const*>(_exeNode);
+
+  SpilledPartition partition(std::move(_partitions.front()));
+  _partitions.pop_front();
+
+  GroupMap groups(1024, GroupKeyHash(_trx, _groupRegisters.size()),
+                  GroupKeyEqual(_trx));
+
+  // cleanup function for group values
+  auto cleanup = [&groups]() -> void {
+    for (auto& it : groups) {
+      for (auto& it2 : it.first) {
+        const_cast<AqlValue*>(&it2)->destroy();
+      }
+      delete it.second;
+    }
+  };
+
+  // prevent memory leaks by always cleaning up the groups
+  TRI_DEFER(cleanup());
+
+  size_t const n = _groupRegisters.size();
+  bool const canSpill =
+      (_spillThreshold > 0 && partition.level < MaxSpillLevel);
+  size_t memoryUsage = 0;
+  std::vector<std::unique_ptr<SpillFile>> spilled;
+
+  std::vector<AqlValue> groupValues;
+  groupValues.reserve(n);
+
+  // reduce an aggregator with a value of the spilled row
+  auto reduce = [](Aggregator* aggregator, VPackSlice const& value) {
+    if (value.isMinKey()) {
+      aggregator->reduce(EmptyValue);
+    } else {
+      AqlValue a(value);
+      AqlValueGuard guard(a, true);
+      aggregator->reduce(a);
+    }
+  };
+
+  VPackSlice row;
+  while (partition.file->next(row)) {
+    throwIfKilled();  // check if we were aborted
+
+    TRI_ASSERT(row.isArray() && row.length() == n + _aggregateRegisters.size());
+
+    // for hashing, point to the values of the row without copying them
+    groupValues.clear();
+    for (size_t i = 0; i < n; ++i) {
+      groupValues.emplace_back(row.at(i).begin());
+    }
+
+    auto it = groups.find(groupValues);
+
+    if (it == groups.end() && !spilled.empty()) {
+      // still too many groups, re-partition the row
+      spilled[partitionFor(groupValues, partition.level)]->append(row);
+    } else if (it == groups.end()) {
+      // new group. copy the group values, as the row will be overwritten
+      std::vector<AqlValue> group;
+      group.reserve(n);
+      try {
+        for (size_t i = 0; i < n; ++i) {
+          group.emplace_back(row.at(i));
+        }
+      } catch (...) {
+        for (auto& it2 : group) {
+          it2.destroy();
+        }
+        throw;
+      }
+
+      auto aggregateValues = std::make_unique<AggregateValuesType>();
+
+      if (en->_aggregateVariables.empty()) {
+        if (en->_count) {
+          aggregateValues->emplace_back(std::make_unique<AggregatorLength>(_trx, 1));
+        }
+      } else {
+        aggregateValues->reserve(_aggregateRegisters.size());
+        size_t j = 0;
+        for (auto const& r : en->_aggregateVariables) {
+          aggregateValues->emplace_back(Aggregator::fromTypeString(_trx, r.second.second));
+          reduce(aggregateValues->back().get(), row.at(n + j));
+          ++j;
+        }
+      }
+
+      memoryUsage += groupMemoryUsage(group, aggregateValues.get());
+
+      try {
+        groups.emplace(group, aggregateValues.get());
+      } catch (...) {
+        for (auto& it2 : group) {
+          it2.destroy();
+        }
+        throw;
+      }
+      aggregateValues.release();
+
+      if (canSpill && memoryUsage > _spillThreshold) {
+        createPartitions(spilled);
+      }
+    } else {
+      // existing group
+      auto aggregateValues = (*it).second;
+
+      if (en->_aggregateVariables.empty()) {
+        if (en->_count) {
+          TRI_ASSERT(!aggregateValues->empty());
+          aggregateValues->back()->reduce(AqlValue());
+        }
+      } else {
+        TRI_ASSERT(aggregateValues->size() == _aggregateRegisters.size());
+        for (size_t j = 0; j < _aggregateRegisters.size(); ++j) {
+          reduce((*aggregateValues)[j].get(), row.at(n + j));
+        }
+      }
+    }
+  }
+
+  // the partition is not needed anymore
+  partition.file.reset();
+
+  if (!spilled.empty()) {
+    finishPartitions(spilled, partition.level);
+  }
+
+  if (skipping) {
+    skipped = groups.size();
+  } else {
+    result = buildResult(groups, _inheritRow.get(), 0,
+                         _inheritRow->getNrRegs());
+  }
+
+  if (_partitions.empty()) {
+    _done = true;
+    _inheritRow.reset();
+  }
+}
+
 /// @brief hasher for groups
 size_t HashedCollectBlock::GroupKeyHash::operator()(
     std::vector<AqlValue> const& value) const {
@@ -848,3 +1122,105 @@ bool HashedCollectBlock::GroupKeyEqual::operator()(
 
   return true;
 }
+
+CountCollectBlock::CountCollectBlock(ExecutionEngine* engine,
+                                     CollectNode const* en)
+    : ExecutionBlock(engine, en),
+      _collectRegister(ExecutionNode::MaxRegisterId),
+      _dependencyCanSkip(false) {
+  TRI_ASSERT(en->_groupVariables.empty());
+  TRI_ASSERT(en->_aggregateVariables.empty());
+  TRI_ASSERT(en->_count && en->_outVariable != nullptr);
+
+  auto const& registerPlan = en->getRegisterPlan()->varInfo;
+  auto it = registerPlan.find(en->_outVariable->id);
+  TRI_ASSERT(it != registerPlan.end());
+  _collectRegister = (*it).second.registerId;
+  TRI_ASSERT(_collectRegister > 0 &&
+             _collectRegister < ExecutionNode::MaxRegisterId);
+
+  TRI_ASSERT(en->hasDependency());
+  auto const type = en->getFirstDependency()->getType();
+  _dependencyCanSkip = (type == ExecutionNode::ENUMERATE_COLLECTION ||
+                        type == ExecutionNode::INDEX);
+}
+
+int CountCollectBlock::getOrSkipSome(size_t atLeast, size_t atMost,
+                                     bool skipping, AqlItemBlock*& result,
+                                     size_t& skipped) {
+  TRI_ASSERT(result == nullptr && skipped == 0);
+
+  if (_done) {
+    return TRI_ERROR_NO_ERROR;
+  }
+
+  std::unique_ptr<AqlItemBlock> res;
+
+  if (!skipping) {
+    res.reset(requestBlock(
+        1, getPlanNode()->getRegisterPlan()->nrRegs[getPlanNode()->getDepth()]));
+  }
+
+  uint64_t count = 0;
+
+  // only the first input row is fetched, for inheriting the registers of
+  // the outer frames. all other rows are just counted
+  if (ExecutionBlock::getBlock(1, 1)) {
+    AqlItemBlock* cur = _buffer.front();
+    _buffer.pop_front();
+    _pos = 0;
+    count += cur->size();
+
+    if (!skipping) {
+      TRI_ASSERT(cur->getNrRegs() <= res->getNrRegs());
+      try {
+        inheritRegisters(cur, res.get(), 0);
+      } catch (...) {
+        returnBlock(cur);
+        throw;
+      }
+    }
+    returnBlock(cur);
+
+    count += countRemaining();
+  }
+
+  _done = true;
+  skipped = 1;
+
+  if (!skipping) {
+    _builder.clear();
+    _builder.add(VPackValue(count));
+    res->setValue(0, _collectRegister, AqlValue(_builder.slice()));
+    result = res.release();
+  }
+
+  return TRI_ERROR_NO_ERROR;
+}
+
+/// @brief count the remaining input rows
+uint64_t CountCollectBlock::countRemaining() {
+  uint64_t count = 0;
+  ExecutionBlock* dependency = _dependencies[0];
+
+  while (true) {
+    throwIfKilled();  // check if we were aborted
+
+    if (_dependencyCanSkip) {
+      size_t skipped = dependency->skipSome(batchSize(), batchSize());
+      if (skipped == 0) {
+        break;
+      }
+      count += skipped;
+    } else {
+      AqlItemBlock* block = dependency->getSome(batchSize(), batchSize());
+      if (block == nullptr) {
+        break;
+      }
+      count += block->size();
+      returnBlock(block);
+    }
+  }
+
+  return count;
+}
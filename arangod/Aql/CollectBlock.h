@@ -42,6 +42,7 @@ namespace aql {
 struct Aggregator;
 class AqlItemBlock;
 class ExecutionEngine;
+class SpillFile;
   
 typedef std::vector<std::unique_ptr<Aggregator>> AggregateValuesType;
 
@@ -124,6 +125,8 @@ class HashedCollectBlock : public ExecutionBlock {
   HashedCollectBlock(ExecutionEngine*, CollectNode const*);
   ~HashedCollectBlock();
 
+  int initializeCursor(AqlItemBlock* items, size_t pos) override;
+
  private:
   int getOrSkipSome(size_t atLeast, size_t atMost, bool skipping,
                     AqlItemBlock*& result, size_t& skipped) override;
@@ -162,6 +165,89 @@ class HashedCollectBlock : public ExecutionBlock {
 
     transaction::Methods* _trx;
   };
+
+  typedef std::unordered_map<std::vector<AqlValue>, AggregateValuesType*,
+                             GroupKeyHash, GroupKeyEqual> GroupMap;
+
+  /// @brief a partition of input rows that has been spilled to disk, because
+  /// the groups did not fit into memory
+  struct SpilledPartition {
+    SpilledPartition(std::unique_ptr<SpillFile>&& file, size_t level);
+    SpilledPartition(SpilledPartition&&);
+    SpilledPartition& operator=(SpilledPartition&&);
+    ~SpilledPartition();
+
+    std::unique_ptr<SpillFile> file;
+    /// @brief number of times the rows have been partitioned
+    size_t level;
+  };
+
+  /// @brief build a result block from the groups
+  AqlItemBlock* buildResult(GroupMap& groups, AqlItemBlock const* src,
+                            size_t srcRow, RegisterId curNrRegs);
+
+  /// @brief estimate the memory used by a new group
+  static size_t groupMemoryUsage(std::vector<AqlValue> const& group,
+                                 AggregateValuesType const* aggregateValues);
+
+  /// @brief determine the partition for a spilled row
+  size_t partitionFor(std::vector<AqlValue> const& groupValues,
+                      size_t level) const;
+
+  /// @brief create the files for spilling rows
+  static void createPartitions(std::vector<std::unique_ptr<SpillFile>>&);
+
+  /// @brief finish writing the spilled rows, and queue the partitions that
+  /// received any rows
+  void finishPartitions(std::vector<std::unique_ptr<SpillFile>>&,
+                        size_t level);
+
+  /// @brief aggregate the groups of the next spilled partition
+  void aggregatePartition(bool skipping, AqlItemBlock*& result,
+                          size_t& skipped);
+
+  /// @brief amount of memory the groups may use before rows of new groups
+  /// are spilled to disk. 0 means everything is kept in memory
+  size_t _spillThreshold;
+
+  /// @brief partitions that still need to be aggregated
+  std::deque<SpilledPartition> _partitions;
+
+  /// @brief the registers inherited from previous frames, for building the
+  /// results of spilled partitions
+  std::unique_ptr<AqlItemBlock> _inheritRow;
+
+  /// @brief builder for spilled rows
+  arangodb::velocypack::Builder _spillBuilder;
+};
+
+/// @brief COLLECT WITH COUNT INTO without groups and aggregates. the input
+/// rows are only counted, and if the input comes right from a collection
+/// scan or an index, they are skipped there without reading any documents
+class CountCollectBlock final : public ExecutionBlock {
+ public:
+  CountCollectBlock(ExecutionEngine*, CollectNode const*);
+
+  ~CountCollectBlock() = default;
+
+ private:
+  int getOrSkipSome(size_t atLeast, size_t atMost, bool skipping,
+                    AqlItemBlock*& result, size_t& skipped) override;
+
+  /// @brief count the remaining input rows
+  uint64_t countRemaining();
+
+ private:
+  /// @brief the register for the count
+  RegisterId _collectRegister;
+
+  /// @brief whether or not the dependency can skip rows by itself. the
+  /// default skipSome does not reliably report the number of skipped rows,
+  /// so it can only be used for counting blocks that implement their own
+  bool _dependencyCanSkip;
+
+  /// @brief builder for the count value
+  arangodb::velocypack::Builder _builder;
 };
 
 }  // namespace arangodb::aql
@@ -194,6 +194,7 @@ struct UserVarFinder final : public WalkerWorker<ExecutionNode> {
                en->getType() == ExecutionNode::ENUMERATE_LIST ||
                en->getType() == ExecutionNode::TRAVERSAL ||
                en->getType() == ExecutionNode::SHORTEST_PATH ||
+               en->getType() == ExecutionNode::HASH_JOIN ||
                en->getType() == ExecutionNode::COLLECT) {
       depth += 1;
     }
@@ -44,6 +44,7 @@ class RedundantCalculationsReplacer;
 /// @brief class CollectNode
 class CollectNode : public ExecutionNode {
   friend class ExecutionNode;
+  friend class CountCollectBlock;
   friend class ExecutionBlock;
   friend class HashedCollectBlock;
   friend class RedundantCalculationsReplacer;
@@ -181,6 +182,12 @@ class CollectNode : public ExecutionNode {
     return _groupVariables;
   }
 
+  /// @brief set all group variables (out, in)
+  void groupVariables(
+      std::vector<std::pair<Variable const*, Variable const*>> const& vars) {
+    _groupVariables = vars;
+  }
+
   /// @brief get all aggregate variables (out, in)
   std::vector<std::pair<Variable const*,
                         std::pair<Variable const*, std::string>>> const&
@@ -188,6 +195,14 @@ class CollectNode : public ExecutionNode {
     return _aggregateVariables;
   }
 
+  /// @brief set all aggregate variables (out, in)
+  void aggregateVariables(
+      std::vector<std::pair<Variable const*,
+                            std::pair<Variable const*, std::string>>> const&
+          vars) {
+    _aggregateVariables = vars;
+  }
+
   /// @brief getVariablesUsedHere, returning a vector
   std::vector<Variable const*> getVariablesUsedHere() const override final;
 
@@ -64,6 +64,9 @@ CollectOptions::CollectMethod CollectOptions::methodFromString(
   if (method == "sorted") {
     return CollectMethod::COLLECT_METHOD_SORTED;
   }
+  if (method == "count") {
+    return CollectMethod::COLLECT_METHOD_COUNT;
+  }
 
   return CollectMethod::COLLECT_METHOD_UNDEFINED;
 }
@@ -77,6 +80,9 @@ std::string CollectOptions::methodToString(
   if (method == CollectMethod::COLLECT_METHOD_SORTED) {
     return std::string("sorted");
   }
+  if (method == CollectMethod::COLLECT_METHOD_COUNT) {
+    return std::string("count");
+  }
 
   THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL,
                                  "cannot stringify unknown aggregation method");
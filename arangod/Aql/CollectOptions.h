@@ -38,7 +38,8 @@ struct CollectOptions {
   enum CollectMethod {
     COLLECT_METHOD_UNDEFINED,
     COLLECT_METHOD_HASH,
-    COLLECT_METHOD_SORTED
+    COLLECT_METHOD_SORTED,
+    COLLECT_METHOD_COUNT
   };
 
   /// @brief constructor, using default values
@@ -0,0 +1,266 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "CompiledExpression.h"
+#include "Aql/AstNode.h"
+#include "Aql/Expression.h"
+#include "Basics/Exceptions.h"
+
+#include <velocypack/Slice.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+/// @brief compile the expression's AST, starting at node
+CompiledExpression::CompiledExpression(Expression* expression,
+                                       AstNode const* node)
+    : _expression(expression), _root(compile(node, false)) {
+  TRI_ASSERT(_expression != nullptr);
+}
+
+CompiledExpression::~CompiledExpression() {}
+
+/// @brief compile an AST node
+CompiledExpression::Step CompiledExpression::compile(AstNode const* node,
+                                                     bool mayBorrow) {
+  TRI_ASSERT(node != nullptr);
+
+  if (node->isConstant()) {
+    // constant subtrees are computed only once. the value is owned by
+    // the AST node
+    uint8_t const* value = node->computeValue().begin();
+    return [value](transaction::Methods*, bool& mustDestroy) {
+      mustDestroy = false;
+      return AqlValue(value);
+    };
+  }
+
+  Expression* expression = _expression;
+  bool const doCopy = !mayBorrow;
+
+  switch (node->type) {
+    case NODE_TYPE_REFERENCE:
+      return [expression, node, doCopy](transaction::Methods* trx,
+                                        bool& mustDestroy) {
+        return expression->executeSimpleExpressionReference(node, trx,
+                                                            mustDestroy, doCopy);
+      };
+
+    case NODE_TYPE_ATTRIBUTE_ACCESS:
+      return compileAttributeAccess(node, mayBorrow);
+
+    case NODE_TYPE_OPERATOR_UNARY_NOT: {
+      Step operand = compile(node->getMemberUnchecked(0), true);
+      return [operand](transaction::Methods* trx, bool& mustDestroy) {
+        AqlValue value = operand(trx, mustDestroy);
+        AqlValueGuard guard(value, mustDestroy);
+        mustDestroy = false;  // only a boolean
+        return AqlValue(!value.toBoolean());
+      };
+    }
+
+    case NODE_TYPE_OPERATOR_BINARY_EQ:
+    case NODE_TYPE_OPERATOR_BINARY_NE:
+    case NODE_TYPE_OPERATOR_BINARY_LT:
+    case NODE_TYPE_OPERATOR_BINARY_LE:
+    case NODE_TYPE_OPERATOR_BINARY_GT:
+    case NODE_TYPE_OPERATOR_BINARY_GE:
+    case NODE_TYPE_OPERATOR_BINARY_IN:
+    case NODE_TYPE_OPERATOR_BINARY_NIN:
+      return compileComparison(node);
+
+    case NODE_TYPE_OPERATOR_BINARY_AND:
+    case NODE_TYPE_OPERATOR_BINARY_OR:
+    case NODE_TYPE_OPERATOR_NARY_AND:
+    case NODE_TYPE_OPERATOR_NARY_OR:
+      return compileLogical(node, mayBorrow);
+
+    default: {
+      // no compiled version for this node type. use the tree walker
+      return [expression, node, doCopy](transaction::Methods* trx,
+                                        bool& mustDestroy) {
+        return expression->executeSimpleExpression(node, trx, mustDestroy,
+                                                   doCopy);
+      };
+    }
+  }
+}
+
+/// @brief compile a (possibly nested) attribute access, e.g. a.b.c.
+/// the attribute path is resolved once, and no intermediate values are
+/// created for the inner attributes
+CompiledExpression::Step CompiledExpression::compileAttributeAccess(
+    AstNode const* node, bool mayBorrow) {
+  std::vector<std::string> path;
+
+  while (node->type == NODE_TYPE_ATTRIBUTE_ACCESS) {
+    TRI_ASSERT(node->numMembers() == 1);
+    path.insert(path.begin(), node->getString());
+    node = node->getMemberUnchecked(0);
+  }
+
+  Step base = compile(node, true);
+  bool const doCopy = !mayBorrow;
+
+  return [base, path, doCopy](transaction::Methods* trx, bool& mustDestroy) {
+    bool baseMustDestroy;
+    AqlValue value = base(trx, baseMustDestroy);
+    AqlValueGuard guard(value, baseMustDestroy);
+
+    // the result must be copied if the base value is a temporary
+    return value.get(trx, path, mustDestroy, doCopy || baseMustDestroy);
+  };
+}
+
+/// @brief compile a comparison operator. the operands are only inspected,
+/// so they do not need to be copied
+CompiledExpression::Step CompiledExpression::compileComparison(
+    AstNode const* node) {
+  Step left = compile(node->getMemberUnchecked(0), true);
+  Step right = compile(node->getMemberUnchecked(1), true);
+
+  if (node->type == NODE_TYPE_OPERATOR_BINARY_IN ||
+      node->type == NODE_TYPE_OPERATOR_BINARY_NIN) {
+    Expression* expression = _expression;
+    bool const negate = (node->type == NODE_TYPE_OPERATOR_BINARY_NIN);
+
+    return [expression, node, left, right, negate](transaction::Methods* trx,
+                                                   bool& mustDestroy) {
+      AqlValue l = left(trx, mustDestroy);
+      AqlValueGuard guardLeft(l, mustDestroy);
+
+      AqlValue r = right(trx, mustDestroy);
+      AqlValueGuard guardRight(r, mustDestroy);
+
+      mustDestroy = false;  // we're returning a boolean only
+
+      if (!r.isArray()) {
+        // right operand must be an array, otherwise we return false
+        return AqlValue(false);
+      }
+
+      // revert the result in case of a NOT IN
+      return AqlValue(expression->findInArray(l, r, trx, node) != negate);
+    };
+  }
+
+  AstNodeType const type = node->type;
+  // for equality and non-equality we can use a binary comparison
+  bool const compareUtf8 = (type != NODE_TYPE_OPERATOR_BINARY_EQ &&
+                            type != NODE_TYPE_OPERATOR_BINARY_NE);
+
+  return [left, right, type, compareUtf8](transaction::Methods* trx,
+                                          bool& mustDestroy) {
+    AqlValue l = left(trx, mustDestroy);
+    AqlValueGuard guardLeft(l, mustDestroy);
+
+    AqlValue r = right(trx, mustDestroy);
+    AqlValueGuard guardRight(r, mustDestroy);
+
+    mustDestroy = false;  // we're returning a boolean only
+
+    int const compareResult = AqlValue::Compare(trx, l, r, compareUtf8);
+
+    switch (type) {
+      case NODE_TYPE_OPERATOR_BINARY_EQ:
+        return AqlValue(compareResult == 0);
+      case NODE_TYPE_OPERATOR_BINARY_NE:
+        return AqlValue(compareResult != 0);
+      case NODE_TYPE_OPERATOR_BINARY_LT:
+        return AqlValue(compareResult < 0);
+      case NODE_TYPE_OPERATOR_BINARY_LE:
+        return AqlValue(compareResult <= 0);
+      case NODE_TYPE_OPERATOR_BINARY_GT:
+        return AqlValue(compareResult > 0);
+      case NODE_TYPE_OPERATOR_BINARY_GE:
+        return AqlValue(compareResult >= 0);
+      default: {
+        THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL,
+                                       "invalid comparison operator");
+      }
+    }
+  };
+}
+
+/// @brief compile a logical operator. the result is one of the operands,
+/// so the operands may only borrow their values if the caller may
+CompiledExpression::Step CompiledExpression::compileLogical(
+    AstNode const* node, bool mayBorrow) {
+  bool const isAnd = (node->type == NODE_TYPE_OPERATOR_BINARY_AND ||
+                      node->type == NODE_TYPE_OPERATOR_NARY_AND);
+
+  std::vector<Step> operands;
+  size_t const n = node->numMembers();
+  operands.reserve(n);
+
+  for (size_t i = 0; i < n; ++i) {
+    operands.emplace_back(compile(node->getMemberUnchecked(i), mayBorrow));
+  }
+
+  if (node->type == NODE_TYPE_OPERATOR_BINARY_AND ||
+      node->type == NODE_TYPE_OPERATOR_BINARY_OR) {
+    TRI_ASSERT(n == 2);
+    Step left = operands[0];
+    Step right = operands[1];
+
+    return [left, right, isAnd](transaction::Methods* trx, bool& mustDestroy) {
+      AqlValue value = left(trx, mustDestroy);
+
+      if (value.toBoolean() != isAnd) {
+        // left is false (AND) or true (OR) => return left
+        return value;
+      }
+
+      if (mustDestroy) {
+        value.destroy();
+      }
+      return right(trx, mustDestroy);
+    };
+  }
+
+  if (n == 0) {
+    // there is nothing to evaluate. so this is always true
+    return [](transaction::Methods*, bool& mustDestroy) {
+      mustDestroy = false;
+      return AqlValue(true);
+    };
+  }
+
+  // n-ary AND or OR. returns the first operand that decides the result,
+  // or a boolean if there is none
+  return [operands, isAnd](transaction::Methods* trx, bool& mustDestroy) {
+    for (auto const& it : operands) {
+      AqlValue value = it(trx, mustDestroy);
+
+      if (value.toBoolean() != isAnd) {
+        return value;
+      }
+
+      if (mustDestroy) {
+        value.destroy();
+      }
+    }
+
+    mustDestroy = false;
+    return AqlValue(isAnd);
+  };
+}
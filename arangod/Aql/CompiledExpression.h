@@ -0,0 +1,90 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_AQL_COMPILED_EXPRESSION_H
+#define ARANGOD_AQL_COMPILED_EXPRESSION_H 1
+
+#include "Basics/Common.h"
+#include "Aql/AqlValue.h"
+
+namespace arangodb {
+namespace transaction {
+class Methods;
+}
+
+namespace aql {
+struct AstNode;
+class Expression;
+class ExpressionContext;
+
+/// @brief a SIMPLE expression, compiled once into a tree of closures.
+/// compared to walking the AST for every row, the node types are
+/// dispatched only once, attribute paths are resolved upfront, constant
+/// subtrees are computed at compile time, and operands that are only
+/// inspected (e.g. by comparisons) are not copied. node types without a
+/// compiled version are executed by the expression's tree walker
+class CompiledExpression {
+ public:
+  CompiledExpression(CompiledExpression const&) = delete;
+  CompiledExpression& operator=(CompiledExpression const&) = delete;
+
+  /// @brief compile the expression's AST, starting at node
+  CompiledExpression(Expression* expression, AstNode const* node);
+
+  ~CompiledExpression();
+
+ public:
+  /// @brief execute the compiled expression. the expression context must
+  /// have been set in the expression before
+  AqlValue execute(transaction::Methods* trx, bool& mustDestroy) const {
+    return _root(trx, mustDestroy);
+  }
+
+ private:
+  /// @brief a compiled AST node
+  typedef std::function<AqlValue(transaction::Methods*, bool&)> Step;
+
+  /// @brief compile an AST node. if mayBorrow is set, the step may return
+  /// values that point into the values of variables instead of copies,
+  /// because the caller only inspects the value and does not return it
+  Step compile(AstNode const* node, bool mayBorrow);
+
+  /// @brief compile a (possibly nested) attribute access
+  Step compileAttributeAccess(AstNode const* node, bool mayBorrow);
+
+  /// @brief compile a comparison operator
+  Step compileComparison(AstNode const* node);
+
+  /// @brief compile a logical operator (AND, OR, n-ary AND, n-ary OR)
+  Step compileLogical(AstNode const* node, bool mayBorrow);
+
+ private:
+  /// @brief the expression, used for the parts executed by its tree walker
+  Expression* _expression;
+
+  /// @brief the compiled root node
+  Step _root;
+};
+
+}  // namespace arangodb::aql
+}  // namespace arangodb
+
+#endif
@@ -48,6 +48,9 @@ bool ConditionFinder::before(ExecutionNode* en) {
     case EN::RETURN:
     case EN::TRAVERSAL:
     case EN::SHORTEST_PATH:
+    case EN::HASH_JOIN:
+    case EN::MATERIALIZE:
+    case EN::HASH_LOOKUP:
       // in these cases we simply ignore the intermediate nodes, note
       // that we have taken care of nodes that could throw exceptions
       // above.
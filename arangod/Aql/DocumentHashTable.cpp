@@ -0,0 +1,144 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "DocumentHashTable.h"
+
+#include "Aql/Collection.h"
+#include "Aql/ResourceUsage.h"
+#include "Basics/Exceptions.h"
+#include "StorageEngine/DocumentIdentifierToken.h"
+#include "Transaction/Context.h"
+#include "Transaction/Methods.h"
+#include "Utils/OperationCursor.h"
+#include "VocBase/LogicalCollection.h"
+#include "VocBase/ManagedDocumentResult.h"
+
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+using VelocyPackHelper = arangodb::basics::VelocyPackHelper;
+
+DocumentHashTable::DocumentHashTable(transaction::Methods* trx,
+                                     ResourceMonitor* resourceMonitor,
+                                     Collection const* collection,
+                                     std::vector<std::string> const& attribute)
+    : _trx(trx),
+      _resourceMonitor(resourceMonitor),
+      _memoryUsage(0),
+      _collection(collection),
+      _mmdr(new ManagedDocumentResult),
+      _attribute(attribute),
+      _built(false),
+      _table(16, VelocyPackHelper::VPackHash(),
+             VelocyPackHelper::VPackEqual(
+                 trx->transactionContextPtr()->getVPackOptions())) {
+  TRI_ASSERT(_resourceMonitor != nullptr);
+  TRI_ASSERT(_collection != nullptr);
+  TRI_ASSERT(!_attribute.empty());
+}
+
+DocumentHashTable::~DocumentHashTable() {
+  _resourceMonitor->decreaseMemoryUsage(_memoryUsage);
+}
+
+/// @brief build the hash table from all documents of the collection.
+/// checkKilled is called after each batch of documents. returns the
+/// number of documents scanned
+size_t DocumentHashTable::build(std::function<void()> const& checkKilled) {
+  TRI_ASSERT(!_built);
+
+  std::unique_ptr<OperationCursor> cursor(_trx->indexScan(
+      _collection->getName(), transaction::Methods::CursorType::ALL,
+      _mmdr.get(), 0, UINT64_MAX, 1000, false));
+
+  if (!cursor->successful()) {
+    THROW_ARANGO_EXCEPTION(cursor->code);
+  }
+
+  LogicalCollection* c = _collection->getCollection().get();
+  size_t scanned = 0;
+
+  auto cb = [&](DocumentIdentifierToken const& tkn) {
+    ++scanned;
+
+    if (!c->readDocument(_trx, tkn, *_mmdr)) {
+      return;
+    }
+
+    // the document pointer stays valid until the end of the transaction,
+    // exactly like the values produced by an EnumerateCollectionBlock
+    uint8_t const* vpack = _mmdr->vpack();
+    VPackSlice key(vpack);
+
+    for (auto const& it : _attribute) {
+      if (!key.isObject()) {
+        key = VelocyPackHelper::NullValue();
+        break;
+      }
+      key = key.get(it);
+    }
+
+    if (key.isNone()) {
+      // a non-existing attribute is equal to null in AQL
+      key = VelocyPackHelper::NullValue();
+    }
+
+    // charge the memory before it is used, so that the query fails when
+    // the table grows over its memory limit. a new value needs a hash
+    // table node and a bucket
+    auto it = _table.find(key);
+    size_t memoryUsage = sizeof(uint8_t const*);
+    if (it == _table.end()) {
+      memoryUsage += sizeof(HashTable::value_type) + 2 * sizeof(void*);
+    }
+    _resourceMonitor->increaseMemoryUsage(memoryUsage);
+    _memoryUsage += memoryUsage;
+
+    if (it == _table.end()) {
+      it = _table.emplace(key, std::vector<uint8_t const*>()).first;
+    }
+    (*it).second.emplace_back(vpack);
+  };
+
+  while (cursor->getMore(cb, 1000)) {
+    checkKilled();
+  }
+
+  _built = true;
+  return scanned;
+}
+
+/// @brief return the documents whose attribute value is equal to value,
+/// or a nullptr if there are none
+std::vector<uint8_t const*> const* DocumentHashTable::find(
+    VPackSlice const& value) const {
+  TRI_ASSERT(_built);
+  auto it = _table.find(value);
+
+  if (it == _table.end()) {
+    return nullptr;
+  }
+
+  TRI_ASSERT(!(*it).second.empty());
+  return &((*it).second);
+}
@@ -0,0 +1,101 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_AQL_DOCUMENT_HASH_TABLE_H
+#define ARANGOD_AQL_DOCUMENT_HASH_TABLE_H 1
+
+#include "Basics/Common.h"
+#include "Basics/VelocyPackHelper.h"
+
+#include <velocypack/Slice.h>
+
+namespace arangodb {
+class ManagedDocumentResult;
+
+namespace transaction {
+class Methods;
+}
+
+namespace aql {
+struct Collection;
+struct ResourceMonitor;
+
+/// @brief all documents of a collection, hashed on the value of an
+/// attribute. used by the HashJoinBlock and the HashLookupBlock. the memory
+/// of the table is charged to the query's resource monitor
+class DocumentHashTable {
+ public:
+  DocumentHashTable(transaction::Methods* trx, ResourceMonitor* resourceMonitor,
+                    Collection const* collection,
+                    std::vector<std::string> const& attribute);
+
+  ~DocumentHashTable();
+
+ public:
+  /// @brief whether or not the hash table has been built
+  bool isBuilt() const { return _built; }
+
+  /// @brief build the hash table from all documents of the collection.
+  /// checkKilled is called after each batch of documents. returns the
+  /// number of documents scanned
+  size_t build(std::function<void()> const& checkKilled);
+
+  /// @brief return the documents whose attribute value is equal to value,
+  /// or a nullptr if there are none
+  std::vector<uint8_t const*> const* find(
+      arangodb::velocypack::Slice const& value) const;
+
+ private:
+  typedef std::unordered_map<arangodb::velocypack::Slice,
+                             std::vector<uint8_t const*>,
+                             arangodb::basics::VelocyPackHelper::VPackHash,
+                             arangodb::basics::VelocyPackHelper::VPackEqual>
+      HashTable;
+
+  /// @brief the transaction
+  transaction::Methods* _trx;
+
+  /// @brief the resource monitor of the query
+  ResourceMonitor* _resourceMonitor;
+
+  /// @brief memory charged to the resource monitor
+  size_t _memoryUsage;
+
+  /// @brief collection
+  Collection const* _collection;
+
+  /// @brief document buffer used for building the hash table
+  std::unique_ptr<ManagedDocumentResult> _mmdr;
+
+  /// @brief attribute path of the hashed attribute
+  std::vector<std::string> const _attribute;
+
+  /// @brief whether or not the hash table has been built
+  bool _built;
+
+  /// @brief the hash table, mapping attribute values to documents
+  HashTable _table;
+};
+
+}  // namespace arangodb::aql
+}  // namespace arangodb
+
+#endif
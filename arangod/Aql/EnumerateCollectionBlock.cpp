@@ -28,7 +28,11 @@
 #include "Aql/ExecutionEngine.h"
 #include "Aql/Query.h"
 #include "Basics/Exceptions.h"
+#include "Basics/LocalTaskQueue.h"
 #include "Cluster/FollowerInfo.h"
+#include "Indexes/IndexIterator.h"
+#include "Scheduler/Scheduler.h"
+#include "Scheduler/SchedulerFeature.h"
 #include "StorageEngine/DocumentIdentifierToken.h"
 #include "Utils/OperationCursor.h"
 #include "VocBase/LogicalCollection.h"
@@ -37,6 +41,35 @@
 
 using namespace arangodb::aql;
 
+namespace {
+
+/// @brief task for scanning some partitions of a collection
+class EnumerateCollectionScanTask : public arangodb::basics::LocalTask {
+ public:
+  EnumerateCollectionScanTask(arangodb::basics::LocalTaskQueue* queue,
+                              std::function<void()> const& cb)
+      : LocalTask(queue), _cb(cb) {}
+
+  void run() override {
+    try {
+      _cb();
+    } catch (arangodb::basics::Exception const& ex) {
+      _queue->setStatus(ex.code());
+    } catch (std::bad_alloc const&) {
+      _queue->setStatus(TRI_ERROR_OUT_OF_MEMORY);
+    } catch (...) {
+      _queue->setStatus(TRI_ERROR_INTERNAL);
+    }
+
+    _queue->join();
+  }
+
+ private:
+  std::function<void()> _cb;
+};
+
+}  // namespace
+
 EnumerateCollectionBlock::EnumerateCollectionBlock(
     ExecutionEngine* engine, EnumerateCollectionNode const* ep)
     : ExecutionBlock(engine, ep),
@@ -47,8 +80,155 @@ EnumerateCollectionBlock::EnumerateCollectionBlock(
           (ep->_random ? transaction::Methods::CursorType::ANY
                        : transaction::Methods::CursorType::ALL),
           _mmdr.get(), 0, UINT64_MAX, 1000, false)),
-      _mustStoreResult(true) {
+      _mustStoreResult(true),
+      _parallelism(1),
+      _posInDocuments(0) {
   TRI_ASSERT(_cursor->successful());
+
+  if (!ep->_random) {
+    setupParallelScan();
+  }
+}
+
+/// @brief set up the partition iterators for a parallel scan
+void EnumerateCollectionBlock::setupParallelScan() {
+  size_t parallelism =
+      _engine->getQuery()->getNumericOption<size_t>("scanParallelism", 1);
+
+  if (parallelism <= 1 || SchedulerFeature::SCHEDULER == nullptr) {
+    return;
+  }
+
+  auto logical = _collection->getCollection();
+  size_t const n = logical->numScanPartitions();
+
+  if (n <= 1) {
+    // nothing to parallelize
+    return;
+  }
+
+  _parallelism = (std::min)(parallelism, n);
+
+  _partitions.reserve(n);
+  _partitionResults.reserve(n);
+  for (size_t i = 0; i < n; ++i) {
+    _partitionResults.emplace_back(new ManagedDocumentResult);
+    _partitions.emplace_back(
+        logical->getPartitionIterator(_trx, _partitionResults.back().get(), i));
+  }
+  _partitionHasMore.assign(n, 1);
+
+  _workerDocuments.resize(_parallelism);
+  _workerTokens.resize(_parallelism);
+}
+
+/// @brief whether or not the current scan has more documents
+bool EnumerateCollectionBlock::scanHasMore() const {
+  if (_parallelism <= 1) {
+    return _cursor->hasMore();
+  }
+
+  if (_posInDocuments < _documents.size()) {
+    return true;
+  }
+  for (auto const& it : _partitionHasMore) {
+    if (it != 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/// @brief restart the current scan
+void EnumerateCollectionBlock::resetScan() {
+  if (_parallelism <= 1) {
+    _cursor->reset();
+    return;
+  }
+
+  for (auto& it : _partitions) {
+    it->reset();
+  }
+  _partitionHasMore.assign(_partitions.size(), 1);
+  _documents.clear();
+  _posInDocuments = 0;
+}
+
+/// @brief make sure there are buffered documents from the parallel scan.
+/// returns false if the scan is exhausted
+bool EnumerateCollectionBlock::fillParallel() {
+  TRI_ASSERT(_parallelism > 1);
+
+  while (_posInDocuments >= _documents.size()) {
+    if (!scanHasMore()) {
+      return false;
+    }
+
+    _documents.clear();
+    _posInDocuments = 0;
+
+    size_t const limit = batchSize();
+
+    arangodb::basics::LocalTaskQueue queue(
+        SchedulerFeature::SCHEDULER->ioService());
+
+    for (size_t i = 0; i < _parallelism; ++i) {
+      _workerDocuments[i].clear();
+      bool hasWork = false;
+      for (size_t p = i; p < _partitions.size(); p += _parallelism) {
+        if (_partitionHasMore[p] != 0) {
+          hasWork = true;
+          break;
+        }
+      }
+      if (hasWork) {
+        queue.enqueue(std::make_shared<EnumerateCollectionScanTask>(
+            &queue, [this, i, limit]() { scanPartitions(i, limit); }));
+      }
+    }
+
+    queue.dispatchAndWait();
+
+    if (queue.status() != TRI_ERROR_NO_ERROR) {
+      THROW_ARANGO_EXCEPTION(queue.status());
+    }
+
+    // merge the results of all workers
+    for (auto& it : _workerDocuments) {
+      _documents.insert(_documents.end(), it.begin(), it.end());
+    }
+
+    throwIfKilled();  // check if we were aborted
+  }
+
+  return true;
+}
+
+/// @brief fetch up to limit documents from the partitions assigned to
+/// the worker. called from worker threads
+void EnumerateCollectionBlock::scanPartitions(size_t worker, size_t limit) {
+  auto& documents = _workerDocuments[worker];
+  auto& tokens = _workerTokens[worker];
+  LogicalCollection* c = _collection->getCollection().get();
+
+  tokens.clear();
+  for (size_t p = worker;
+       p < _partitions.size() && tokens.size() < limit;
+       p += _parallelism) {
+    if (_partitionHasMore[p] == 0) {
+      continue;
+    }
+    if (!_partitions[p]->nextTokens(tokens, limit - tokens.size())) {
+      _partitionHasMore[p] = 0;
+    }
+  }
+
+  if (_mustStoreResult) {
+    // read all documents of the round at once
+    c->readDocuments(_trx, tokens, documents);
+  } else {
+    documents.assign(tokens.size(), nullptr);
+  }
 }
 
 int EnumerateCollectionBlock::initialize() {
@@ -105,7 +285,7 @@ int EnumerateCollectionBlock::initializeCursor(AqlItemBlock* items,
   }
 
   DEBUG_BEGIN_BLOCK();  
-  _cursor->reset();
+  resetScan();
   DEBUG_END_BLOCK();  
 
   return TRI_ERROR_NO_ERROR;
@@ -140,23 +320,24 @@ AqlItemBlock* EnumerateCollectionBlock::getSome(size_t,  // atLeast,
       needMore = false;
 
       if (_buffer.empty()) {
-        size_t toFetch = (std::min)(DefaultBatchSize(), atMost);
+        size_t toFetch = (std::min)(batchSize(), atMost);
         if (!ExecutionBlock::getBlock(toFetch, toFetch)) {
           _done = true;
+          traceGetSomeEnd(nullptr);
           return nullptr;
         }
         _pos = 0;  // this is in the first block
-        _cursor->reset();
+        resetScan();
       }
 
       // If we get here, we do have _buffer.front()
       cur = _buffer.front();
 
-      if (!_cursor->hasMore()) {
+      if (!scanHasMore()) {
         needMore = true;
         // we have exhausted this cursor
         // re-initialize fetching of documents
-        _cursor->reset();
+        resetScan();
         if (++_pos >= cur->size()) {
           _buffer.pop_front();  // does not throw
           returnBlock(cur);
@@ -166,7 +347,7 @@ AqlItemBlock* EnumerateCollectionBlock::getSome(size_t,  // atLeast,
     } while (needMore);
 
     TRI_ASSERT(cur != nullptr);
-    TRI_ASSERT(_cursor->hasMore());
+    TRI_ASSERT(scanHasMore());
 
     size_t curRegs = cur->getNrRegs();
     
@@ -182,44 +363,55 @@ AqlItemBlock* EnumerateCollectionBlock::getSome(size_t,  // atLeast,
       
     auto col = _collection->getCollection();
     LogicalCollection* c = col.get();
-    std::function<void(DocumentIdentifierToken const& tkn)> cb;
-    if (_mustStoreResult) {
-      cb = [&] (DocumentIdentifierToken const& tkn) {
-        if (c->readDocument(_trx, tkn, *_mmdr)) {
-          // The result is in the first variable of this depth,
-          // we do not need to do a lookup in getPlanNode()->_registerPlan->varInfo,
-          // but can just take cur->getNrRegs() as registerId:
-          uint8_t const* vpack = _mmdr->vpack();
+
+    throwIfKilled();  // check if we were aborted
+
+    TRI_IF_FAILURE("EnumerateCollectionBlock::moreDocuments") {
+      THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
+    }
+
+    if (_parallelism > 1) {
+      // documents have already been fetched by the worker threads
+      while (send < atMost && fillParallel()) {
+        uint8_t const* vpack = _documents[_posInDocuments++];
+        if (vpack != nullptr) {
           res->setValue(send, static_cast<arangodb::aql::RegisterId>(curRegs),
                         AqlValue(vpack, AqlValueFromManagedDocument()));
-          // No harm done, if the setValue throws!
         }
-
         if (send > 0) {
           // re-use already copied AQLValues
           res->copyValuesFromFirstRow(send, static_cast<RegisterId>(curRegs));
         }
         ++send;
-      };
+      }
     } else {
-      cb = [&] (DocumentIdentifierToken const& tkn) {
+      _tokens.clear();
+      bool tmp = _cursor->getMoreTokens(_tokens, atMost);
+      if (!tmp) {
+        TRI_ASSERT(!_cursor->hasMore());
+      }
+
+      if (_mustStoreResult) {
+        // read all documents of the batch at once
+        c->readDocuments(_trx, _tokens, _tokenDocuments);
+      }
+
+      for (size_t i = 0; i < _tokens.size(); ++i) {
+        if (_mustStoreResult && _tokenDocuments[i] != nullptr) {
+          // The result is in the first variable of this depth,
+          // we do not need to do a lookup in getPlanNode()->_registerPlan->varInfo,
+          // but can just take cur->getNrRegs() as registerId:
+          res->setValue(send, static_cast<arangodb::aql::RegisterId>(curRegs),
+                        AqlValue(_tokenDocuments[i], AqlValueFromManagedDocument()));
+          // No harm done, if the setValue throws!
+        }
+
         if (send > 0) {
           // re-use already copied AQLValues
           res->copyValuesFromFirstRow(send, static_cast<RegisterId>(curRegs));
         }
         ++send;
-      };
-    }
-
-    throwIfKilled();  // check if we were aborted
-
-    TRI_IF_FAILURE("EnumerateCollectionBlock::moreDocuments") {
-      THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
-    }
-
-    bool tmp = _cursor->getMore(cb, atMost);
-    if (!tmp) {
-      TRI_ASSERT(!_cursor->hasMore());
+      }
     }
 
     // If the collection is actually empty we cannot forward an empty block
@@ -245,29 +437,37 @@ AqlItemBlock* EnumerateCollectionBlock::getSome(size_t,  // atLeast,
 
 size_t EnumerateCollectionBlock::skipSome(size_t atLeast, size_t atMost) {
   DEBUG_BEGIN_BLOCK();  
+  traceSkipSomeBegin();
   size_t skipped = 0;
   TRI_ASSERT(_cursor != nullptr);
 
   if (_done) {
-    return skipped;
+    return traceSkipSomeEnd(skipped);
   }
 
   while (skipped < atLeast) {
     if (_buffer.empty()) {
-      size_t toFetch = (std::min)(DefaultBatchSize(), atMost);
+      size_t toFetch = (std::min)(batchSize(), atMost);
       if (!getBlock(toFetch, toFetch)) {
         _done = true;
-        return skipped;
+        return traceSkipSomeEnd(skipped);
       }
       _pos = 0;  // this is in the first block
-      _cursor->reset();
+      resetScan();
     }
 
     // if we get here, then _buffer.front() exists
     AqlItemBlock* cur = _buffer.front();
     uint64_t skippedHere = 0;
 
-    if (_cursor->hasMore()) {
+    if (_parallelism > 1) {
+      while (skippedHere < atMost - skipped && fillParallel()) {
+        size_t n = (std::min)(_documents.size() - _posInDocuments,
+                              atMost - skipped - skippedHere);
+        _posInDocuments += n;
+        skippedHere += n;
+      }
+    } else if (_cursor->hasMore()) {
       int res = _cursor->skip(atMost - skipped, skippedHere);
 
       if (res != TRI_ERROR_NO_ERROR) {
@@ -278,9 +478,9 @@ size_t EnumerateCollectionBlock::skipSome(size_t atLeast, size_t atMost) {
     skipped += skippedHere;
 
     if (skipped < atLeast) {
-      TRI_ASSERT(!_cursor->hasMore());
+      TRI_ASSERT(!scanHasMore());
       // not skipped enough re-initialize fetching of documents
-      _cursor->reset();
+      resetScan();
       if (++_pos >= cur->size()) {
         _buffer.pop_front();  // does not throw
         returnBlock(cur);
@@ -291,7 +491,7 @@ size_t EnumerateCollectionBlock::skipSome(size_t atLeast, size_t atMost) {
 
   _engine->_stats.scannedFull += static_cast<int64_t>(skipped);
   // We skipped atLeast documents
-  return skipped;
+  return traceSkipSomeEnd(skipped);
 
   // cppcheck-suppress style
   DEBUG_END_BLOCK(); 
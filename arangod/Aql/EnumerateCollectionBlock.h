@@ -33,6 +33,7 @@
 namespace arangodb {
 
 struct DocumentIdentifierToken;
+class IndexIterator;
 class ManagedDocumentResult;
 struct OperationCursor;
 
@@ -62,6 +63,24 @@ class EnumerateCollectionBlock final : public ExecutionBlock {
   // things to skip overall.
   size_t skipSome(size_t atLeast, size_t atMost) override final;
 
+ private:
+  /// @brief set up the partition iterators for a parallel scan
+  void setupParallelScan();
+
+  /// @brief whether or not the current scan has more documents
+  bool scanHasMore() const;
+
+  /// @brief restart the current scan
+  void resetScan();
+
+  /// @brief make sure there are buffered documents from the parallel scan.
+  /// returns false if the scan is exhausted
+  bool fillParallel();
+
+  /// @brief fetch up to limit documents from the partitions assigned to
+  /// the worker. called from worker threads
+  void scanPartitions(size_t worker, size_t limit);
+
  private:
   /// @brief collection
   Collection* _collection;
@@ -73,6 +92,38 @@ class EnumerateCollectionBlock final : public ExecutionBlock {
   
   /// @brief whether or not the enumerated documents need to be stored
   bool _mustStoreResult;
+
+  /// @brief number of worker threads for scanning the collection. if this is
+  /// 1, the collection is scanned sequentially using _cursor
+  size_t _parallelism;
+
+  /// @brief iterators for the partitions of the collection. partition p is
+  /// always scanned by worker (p % _parallelism)
+  std::vector<std::unique_ptr<IndexIterator>> _partitions;
+
+  /// @brief document results of the partition iterators. the partitions of
+  /// different workers are scanned concurrently, so they cannot share _mmdr
+  std::vector<std::unique_ptr<ManagedDocumentResult>> _partitionResults;
+
+  /// @brief whether or not a partition has more documents (1 = yes). not a
+  /// std::vector<bool>, as it is written to from multiple threads
+  std::vector<uint8_t> _partitionHasMore;
+
+  /// @brief per-worker tokens fetched from the partitions
+  std::vector<std::vector<DocumentIdentifierToken>> _workerTokens;
+
+  /// @brief per-worker documents fetched in the current round
+  std::vector<std::vector<uint8_t const*>> _workerDocuments;
+
+  /// @brief documents fetched in the current round, from all workers
+  std::vector<uint8_t const*> _documents;
+
+  /// @brief current position in _documents
+  size_t _posInDocuments;
+
+  /// @brief tokens fetched by a sequential scan, and their documents
+  std::vector<DocumentIdentifierToken> _tokens;
+  std::vector<uint8_t const*> _tokenDocuments;
 };
 
 }  // namespace arangodb::aql
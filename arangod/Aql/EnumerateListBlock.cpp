@@ -84,7 +84,7 @@ AqlItemBlock* EnumerateListBlock::getSome(size_t, size_t atMost) {
     // try again!
 
     if (_buffer.empty()) {
-      size_t toFetch = (std::min)(DefaultBatchSize(), atMost);
+      size_t toFetch = (std::min)(batchSize(), atMost);
       if (!ExecutionBlock::getBlock(toFetch, toFetch)) {
         _done = true;
         traceGetSomeEnd(nullptr);
@@ -170,18 +170,19 @@ AqlItemBlock* EnumerateListBlock::getSome(size_t, size_t atMost) {
 
 size_t EnumerateListBlock::skipSome(size_t atLeast, size_t atMost) {
   DEBUG_BEGIN_BLOCK();  
+  traceSkipSomeBegin();
   if (_done) {
-    return 0;
+    return traceSkipSomeEnd(0);
   }
 
   size_t skipped = 0;
 
   while (skipped < atLeast) {
     if (_buffer.empty()) {
-      size_t toFetch = (std::min)(DefaultBatchSize(), atMost);
+      size_t toFetch = (std::min)(batchSize(), atMost);
       if (!ExecutionBlock::getBlock(toFetch, toFetch)) {
         _done = true;
-        return skipped;
+        return traceSkipSomeEnd(skipped);
       }
       _pos = 0;  // this is in the first block
     }
@@ -224,7 +225,7 @@ size_t EnumerateListBlock::skipSome(size_t atLeast, size_t atMost) {
       _pos = 0;
     }
   }
-  return skipped;
+  return traceSkipSomeEnd(skipped);
   DEBUG_END_BLOCK();  
 }
 
@@ -38,7 +38,11 @@ ExecutionBlock::ExecutionBlock(ExecutionEngine* engine, ExecutionNode const* ep)
       _exeNode(ep),
       _pos(0),
       _done(false),
-      _tracing(engine->getQuery()->getNumericOption<double>("tracing", 0.0)) {}
+      _tracing(engine->getQuery()->getNumericOption<double>("tracing", 0.0)),
+      _profiling(engine->getQuery()->profileLevel() >= 2),
+      _batchSize(DefaultBatchSize()) {
+  _batchSize = computeBatchSize();
+}
 
 ExecutionBlock::~ExecutionBlock() {
   for (auto& it : _buffer) {
@@ -48,6 +52,50 @@ ExecutionBlock::~ExecutionBlock() {
   _buffer.clear();
 }
 
+/// @brief determine the batch size for the block
+/// a fixed batch size can be set via the query option "executionBatchSize".
+/// otherwise the batch size is derived from the width of the rows the block
+/// produces and the memory budget for a single batch. the budget can be
+/// adjusted via the query option "batchMemoryLimit", and it is capped by
+/// the memory limit of the query (if any)
+size_t ExecutionBlock::computeBatchSize() const {
+  Query const* query = _engine->getQuery();
+
+  size_t value = query->executionBatchSize();
+  if (value > 0) {
+    // explicitly set
+    return (std::max)(static_cast<size_t>(1), value);
+  }
+
+  if (_exeNode == nullptr || _exeNode->getRegisterPlan() == nullptr) {
+    return DefaultBatchSize();
+  }
+
+  auto const& nrRegs = _exeNode->getRegisterPlan()->nrRegs;
+  int const depth = _exeNode->getDepth();
+  if (depth < 0 || static_cast<size_t>(depth) >= nrRegs.size()) {
+    return DefaultBatchSize();
+  }
+
+  size_t const rowWidth =
+      (std::max)(static_cast<RegisterId>(1), nrRegs[depth]) * sizeof(AqlValue);
+
+  size_t budget = query->batchMemoryLimit();
+  if (budget == 0) {
+    budget = DefaultBatchMemory();
+  }
+
+  size_t const memoryLimit = query->memoryLimit();
+  if (memoryLimit > 0) {
+    // a single batch should never use more than a small fraction of the
+    // memory available to the query, as there may be many batches in flight
+    budget = (std::min)(budget, memoryLimit / 64);
+  }
+
+  value = budget / rowWidth;
+  return (std::min)((std::max)(value, MinBatchSize()), MaxBatchSize());
+}
+
 /// @brief returns the register id for a variable id
 /// will return ExecutionNode::MaxRegisterId for an unknown variable
 RegisterId ExecutionBlock::getRegister(VariableId id) const {
@@ -154,7 +202,13 @@ int ExecutionBlock::shutdown(int errorCode) {
 }
 
 // Trace the start of a getSome call
-void ExecutionBlock::traceGetSomeBegin() const {
+void ExecutionBlock::traceGetSomeBegin() {
+  if (_profiling) {
+    ++_profile.getSomeCalls;
+    if (_profile.depth++ == 0) {
+      _profile.started = TRI_microtime();
+    }
+  }
   if (_tracing > 0) {
     auto node = getPlanNode();
     LOG_TOPIC(INFO, Logger::QUERIES) << "getSome type="
@@ -164,7 +218,16 @@ void ExecutionBlock::traceGetSomeBegin() const {
 }
 
 // Trace the end of a getSome call, potentially with result
-void ExecutionBlock::traceGetSomeEnd(AqlItemBlock const* result) const {
+void ExecutionBlock::traceGetSomeEnd(AqlItemBlock const* result) {
+  if (_profiling) {
+    if (result != nullptr) {
+      _profile.items += result->size();
+    }
+    TRI_ASSERT(_profile.depth > 0);
+    if (--_profile.depth == 0) {
+      _profile.runtime += TRI_microtime() - _profile.started;
+    }
+  }
   if (_tracing > 0) {
     auto node = getPlanNode();
     LOG_TOPIC(INFO, Logger::QUERIES) << "getSome done type="
@@ -188,6 +251,28 @@ void ExecutionBlock::traceGetSomeEnd(AqlItemBlock const* result) const {
   }
 }
 
+// Trace the start of a skipSome call
+void ExecutionBlock::traceSkipSomeBegin() {
+  if (_profiling) {
+    ++_profile.skipSomeCalls;
+    if (_profile.depth++ == 0) {
+      _profile.started = TRI_microtime();
+    }
+  }
+}
+
+// Trace the end of a skipSome call
+size_t ExecutionBlock::traceSkipSomeEnd(size_t skipped) {
+  if (_profiling) {
+    _profile.skipped += skipped;
+    TRI_ASSERT(_profile.depth > 0);
+    if (--_profile.depth == 0) {
+      _profile.runtime += TRI_microtime() - _profile.started;
+    }
+  }
+  return skipped;
+}
+
 /// @brief getSome, gets some more items, semantic is as follows: not
 /// more than atMost items may be delivered. The method tries to
 /// return a block of at least atLeast items, however, it may return
@@ -327,6 +412,7 @@ void ExecutionBlock::clearRegisters(AqlItemBlock* result) {
 size_t ExecutionBlock::skipSome(size_t atLeast, size_t atMost) {
   DEBUG_BEGIN_BLOCK();
   TRI_ASSERT(0 < atLeast && atLeast <= atMost);
+  traceSkipSomeBegin();
   size_t skipped = 0;
 
   AqlItemBlock* result = nullptr;
@@ -338,7 +424,7 @@ size_t ExecutionBlock::skipSome(size_t atLeast, size_t atMost) {
     THROW_ARANGO_EXCEPTION(out);
   }
 
-  return skipped;
+  return traceSkipSomeEnd(skipped);
   DEBUG_END_BLOCK();
 }
 
@@ -367,7 +453,7 @@ bool ExecutionBlock::hasMore() {
   if (!_buffer.empty()) {
     return true;
   }
-  if (getBlock(DefaultBatchSize(), DefaultBatchSize())) {
+  if (getBlock(batchSize(), batchSize())) {
     _pos = 0;
     return true;
   }
@@ -24,6 +24,7 @@
 #ifndef ARANGOD_AQL_EXECUTION_BLOCK_H
 #define ARANGOD_AQL_EXECUTION_BLOCK_H 1
 
+#include "Aql/AqlValue.h"
 #include "Aql/ExecutionNode.h"
 #include "Aql/Variable.h"
 
@@ -79,6 +80,35 @@ struct SortElementBlock {
 
 class ExecutionEngine;
 
+/// @brief runtime statistics of an execution block, collected if the query
+/// is executed with the option profile: 2
+struct ExecutionBlockProfile {
+  ExecutionBlockProfile()
+      : getSomeCalls(0),
+        skipSomeCalls(0),
+        items(0),
+        skipped(0),
+        runtime(0.0),
+        depth(0),
+        started(0.0) {}
+
+  /// @brief number of calls to getSome and skipSome
+  uint64_t getSomeCalls;
+  uint64_t skipSomeCalls;
+
+  /// @brief number of rows produced and skipped
+  uint64_t items;
+  uint64_t skipped;
+
+  /// @brief wall-clock time spent in getSome and skipSome, including the
+  /// time spent in the dependencies
+  double runtime;
+
+  /// @brief nesting depth of the current call and its start time
+  size_t depth;
+  double started;
+};
+
 class ExecutionBlock {
  public:
   ExecutionBlock(ExecutionEngine*, ExecutionNode const*);
@@ -89,6 +119,21 @@ class ExecutionBlock {
   /// @brief batch size value
   static constexpr inline size_t DefaultBatchSize() { return 1000; }
 
+  /// @brief lower and upper bounds for the adaptive batch size
+  static constexpr inline size_t MinBatchSize() { return 100; }
+  static constexpr inline size_t MaxBatchSize() { return 10000; }
+
+  /// @brief default memory budget for a single batch, in bytes. with this
+  /// budget, a block with 8 registers will use the DefaultBatchSize
+  static constexpr inline size_t DefaultBatchMemory() {
+    return DefaultBatchSize() * 8 * sizeof(AqlValue);
+  }
+
+  /// @brief the batch size used by this block. the value is determined
+  /// from the number of registers of the block and the memory budget
+  /// of the query, unless it was set explicitly via the query options
+  inline size_t batchSize() const { return _batchSize; }
+
   /// @brief returns the register id for a variable id
   /// will return ExecutionNode::MaxRegisterId for an unknown variable
   RegisterId getRegister(VariableId id) const;
@@ -155,8 +200,20 @@ class ExecutionBlock {
   /// if it returns an actual block, it must contain at least one item.
   virtual AqlItemBlock* getSome(size_t atLeast, size_t atMost);
 
-  void traceGetSomeBegin() const;
-  void traceGetSomeEnd(AqlItemBlock const*) const;
+  void traceGetSomeBegin();
+  void traceGetSomeEnd(AqlItemBlock const*);
+
+  /// @brief trace the start and the end of a skipSome call. the end
+  /// function returns the number of skipped rows
+  void traceSkipSomeBegin();
+  size_t traceSkipSomeEnd(size_t skipped);
+
+  /// @brief the runtime statistics of the block, if collected
+  ExecutionBlockProfile const& profile() const { return _profile; }
+
+ private:
+  /// @brief determine the batch size for the block
+  size_t computeBatchSize() const;
 
  protected:
   /// @brief request an AqlItemBlock from the memory manager
@@ -246,6 +303,16 @@ class ExecutionBlock {
 
   /// A copy of the tracing value in the options:
   double _tracing;
+
+  /// @brief whether or not runtime statistics are collected for the block
+  bool const _profiling;
+
+  /// @brief runtime statistics of the block
+  ExecutionBlockProfile _profile;
+
+  /// @brief number of rows this block fetches from its dependencies and
+  /// produces per call
+  size_t _batchSize;
 };
 
 }  // namespace arangodb::aql
@@ -32,7 +32,10 @@
 #include "Aql/EnumerateCollectionBlock.h"
 #include "Aql/EnumerateListBlock.h"
 #include "Aql/ExecutionNode.h"
+#include "Aql/HashJoinBlock.h"
+#include "Aql/HashLookupBlock.h"
 #include "Aql/IndexBlock.h"
+#include "Aql/MaterializeBlock.h"
 #include "Aql/ModificationBlocks.h"
 #include "Aql/Query.h"
 #include "Aql/SortBlock.h"
@@ -70,6 +73,9 @@ static ExecutionBlock* CreateBlock(
       return new EnumerateCollectionBlock(
           engine, static_cast<EnumerateCollectionNode const*>(en));
     }
+    case ExecutionNode::HASH_JOIN: {
+      return new HashJoinBlock(engine, static_cast<HashJoinNode const*>(en));
+    }
     case ExecutionNode::ENUMERATE_LIST: {
       return new EnumerateListBlock(engine,
                                     static_cast<EnumerateListNode const*>(en));
@@ -80,6 +86,14 @@ static ExecutionBlock* CreateBlock(
     case ExecutionNode::SHORTEST_PATH: {
       return new ShortestPathBlock(engine, static_cast<ShortestPathNode const*>(en));
     }
+    case ExecutionNode::MATERIALIZE: {
+      return new MaterializeBlock(engine,
+                                  static_cast<MaterializeNode const*>(en));
+    }
+    case ExecutionNode::HASH_LOOKUP: {
+      return new HashLookupBlock(engine,
+                                 static_cast<HashLookupNode const*>(en));
+    }
     case ExecutionNode::CALCULATION: {
       return new CalculationBlock(engine,
                                   static_cast<CalculationNode const*>(en));
@@ -105,6 +119,10 @@ static ExecutionBlock* CreateBlock(
                  CollectOptions::CollectMethod::COLLECT_METHOD_SORTED) {
         return new SortedCollectBlock(engine,
                                       static_cast<CollectNode const*>(en));
+      } else if (aggregationMethod ==
+                 CollectOptions::CollectMethod::COLLECT_METHOD_COUNT) {
+        return new CountCollectBlock(engine,
+                                     static_cast<CollectNode const*>(en));
       }
 
       THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL,
@@ -171,6 +189,7 @@ static ExecutionBlock* CreateBlock(
 ExecutionEngine::ExecutionEngine(Query* query)
     : _stats(),
       _itemBlockManager(query->resourceMonitor()),
+      _startedSubqueries(0),
       _blocks(),
       _root(nullptr),
       _query(query),
@@ -1311,6 +1330,12 @@ ExecutionEngine* ExecutionEngine::instantiateFromPlan(
         auto cc = arangodb::ClusterComm::instance();
         if (cc != nullptr) {
           // nullptr only happens during controlled shutdown
+          // the queries on the DBservers are removed with requests that
+          // are all sent at once
+          std::vector<ClusterCommRequest> requests;
+          std::vector<std::string> requestQueryIds;
+          auto body = std::make_shared<std::string const>("{\"code\": 0}");
+
           for (auto& q : inst.get()->queryIds) {
             std::string theId = q.first;
             std::string queryId = q.second;
@@ -1319,8 +1344,6 @@ ExecutionEngine* ExecutionEngine::instantiateFromPlan(
               // So this is a remote one on a DBserver:
               std::string shardId = theId.substr(pos + 1);
               // Remove query from DBserver:
-              arangodb::CoordTransactionID coordTransactionID =
-                  TRI_NewTickServer();
               if (queryId.back() == '*') {
                 queryId.pop_back();
               }
@@ -1328,18 +1351,10 @@ ExecutionEngine* ExecutionEngine::instantiateFromPlan(
                   "/_db/" +
                   arangodb::basics::StringUtils::urlEncode(vocbase->name()) +
                   "/_api/aql/shutdown/" + queryId);
-              std::unordered_map<std::string, std::string> headers;
-              auto res =
-                  cc->syncRequest("", coordTransactionID, "shard:" + shardId,
-                                  arangodb::rest::RequestType::PUT,
-                                  url, "{\"code\": 0}", headers, 120.0);
-              // Ignore result, we need to try to remove all.
-              // However, log the incident if we have an errorMessage.
-              if (!res->errorMessage.empty()) {
-                std::string msg("while trying to unregister query ");
-                msg += queryId + ": " + res->stringifyErrorMessage();
-                LOG_TOPIC(WARN, arangodb::Logger::FIXME) << msg;
-              }
+              requests.emplace_back("shard:" + shardId,
+                                    arangodb::rest::RequestType::PUT, url,
+                                    body);
+              requestQueryIds.emplace_back(queryId);
             } else {
               // Remove query from registry:
               try {
@@ -1351,29 +1366,37 @@ ExecutionEngine* ExecutionEngine::instantiateFromPlan(
               }
             }
           }
+
           // Also we need to destroy all traverser engines that have been pushed to DBServers
           {
-
             std::string const url(
                 "/_db/" +
                 arangodb::basics::StringUtils::urlEncode(vocbase->name()) +
                 "/_internal/traverser/");
+            auto emptyBody = std::make_shared<std::string const>();
             for (auto& te : inst.get()->traverserEngines) {
               std::string traverserId = arangodb::basics::StringUtils::itoa(te.first);
-              arangodb::CoordTransactionID coordTransactionID =
-                  TRI_NewTickServer();
-              std::unordered_map<std::string, std::string> headers;
               // NOTE: te.second is the list of shards. So we just send delete
               // to the first of those shards
-              auto res = cc->syncRequest(
-                  "", coordTransactionID, "shard:" + *(te.second.begin()),
-                  RequestType::DELETE_REQ, url + traverserId, "", headers, 30.0);
-
-              // Ignore result, we need to try to remove all.
-              // However, log the incident if we have an errorMessage.
-              if (!res->errorMessage.empty()) {
-                std::string msg("while trying to unregister traverser engine ");
-                msg += traverserId + ": " + res->stringifyErrorMessage();
+              requests.emplace_back("shard:" + *(te.second.begin()),
+                                    RequestType::DELETE_REQ, url + traverserId,
+                                    emptyBody);
+              requestQueryIds.emplace_back(traverserId);
+            }
+          }
+
+          if (!requests.empty()) {
+            size_t nrDone = 0;
+            cc->performRequests(requests, 120.0, nrDone,
+                                arangodb::Logger::FIXME);
+
+            // Ignore results, we need to try to remove all.
+            // However, log the incidents if we have an errorMessage.
+            for (size_t i = 0; i < requests.size(); ++i) {
+              auto const& res = requests[i].result;
+              if (!requests[i].done || !res.errorMessage.empty()) {
+                std::string msg("while trying to unregister query or traverser engine ");
+                msg += requestQueryIds[i] + ": " + res.stringifyErrorMessage();
                 LOG_TOPIC(WARN, arangodb::Logger::FIXME) << msg;
               }
             }
@@ -63,6 +63,9 @@ class ExecutionEngine {
   /// @brief get the query
   Query* getQuery() const { return _query; }
 
+  /// @brief get all blocks of the engine
+  std::vector<ExecutionBlock*> const& blocks() const { return _blocks; }
+
   /// @brief initializeCursor, could be called multiple times
   int initializeCursor(AqlItemBlock* items, size_t pos) {
     return _root->initializeCursor(items, pos);
@@ -132,6 +135,10 @@ class ExecutionEngine {
   /// @brief memory recycler for AqlItemBlocks
   AqlItemBlockManager _itemBlockManager;
 
+  /// @brief number of subqueries that were started ahead of their
+  /// execution and have not been executed yet
+  size_t _startedSubqueries;
+
  private:
   /// @brief all blocks registered, used for memory management
   std::vector<ExecutionBlock*> _blocks;
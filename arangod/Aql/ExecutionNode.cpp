@@ -29,7 +29,10 @@
 #include "Aql/Collection.h"
 #include "Aql/CollectNode.h"
 #include "Aql/ExecutionPlan.h"
+#include "Aql/HashJoinNode.h"
+#include "Aql/HashLookupNode.h"
 #include "Aql/IndexNode.h"
+#include "Aql/MaterializeNode.h"
 #include "Aql/ModificationNodes.h"
 #include "Aql/Query.h"
 #include "Aql/SortNode.h"
@@ -73,7 +76,10 @@ std::unordered_map<int, std::string const> const ExecutionNode::TypeNames{
     {static_cast<int>(NORESULTS), "NoResultsNode"},
     {static_cast<int>(UPSERT), "UpsertNode"},
     {static_cast<int>(TRAVERSAL), "TraversalNode"},
-    {static_cast<int>(SHORTEST_PATH), "ShortestPathNode"}};
+    {static_cast<int>(SHORTEST_PATH), "ShortestPathNode"},
+    {static_cast<int>(HASH_JOIN), "HashJoinNode"},
+    {static_cast<int>(MATERIALIZE), "MaterializeNode"},
+    {static_cast<int>(HASH_LOOKUP), "HashLookupNode"}};
 
 /// @brief returns the type name of the node
 std::string const& ExecutionNode::getTypeString() const {
@@ -258,6 +264,12 @@ ExecutionNode* ExecutionNode::fromVPackFactory(
       return new TraversalNode(plan, slice);
     case SHORTEST_PATH:
       return new ShortestPathNode(plan, slice);
+    case HASH_JOIN:
+      return new HashJoinNode(plan, slice);
+    case MATERIALIZE:
+      return new MaterializeNode(plan, slice);
+    case HASH_LOOKUP:
+      return new HashLookupNode(plan, slice);
   }
   return nullptr;
 }
@@ -550,7 +562,8 @@ ExecutionNode const* ExecutionNode::getLoop() const {
     auto type = node->getType();
 
     if (type == ENUMERATE_COLLECTION || type == INDEX || type == TRAVERSAL ||
-        type == ENUMERATE_LIST || type == SHORTEST_PATH) {
+        type == ENUMERATE_LIST || type == SHORTEST_PATH ||
+        type == HASH_JOIN) {
       return node;
     }
   }
@@ -828,6 +841,22 @@ void ExecutionNode::RegisterPlan::after(ExecutionNode* en) {
       break;
     }
 
+    case ExecutionNode::HASH_JOIN: {
+      depth++;
+      nrRegsHere.emplace_back(1);
+      // create a copy of the last value here
+      // this is requried because back returns a reference and emplace/push_back
+      // may invalidate all references
+      RegisterId registerId = 1 + nrRegs.back();
+      nrRegs.emplace_back(registerId);
+
+      auto ep = static_cast<HashJoinNode const*>(en);
+      TRI_ASSERT(ep != nullptr);
+      varInfo.emplace(ep->outVariable()->id, VarInfo(depth, totalNrRegs));
+      totalNrRegs++;
+      break;
+    }
+
     case ExecutionNode::INDEX: {
       depth++;
       nrRegsHere.emplace_back(1);
@@ -839,7 +868,10 @@ void ExecutionNode::RegisterPlan::after(ExecutionNode* en) {
 
       auto ep = static_cast<IndexNode const*>(en);
       TRI_ASSERT(ep != nullptr);
-      varInfo.emplace(ep->outVariable()->id, VarInfo(depth, totalNrRegs));
+      // a late-materializing IndexNode only produces document tokens
+      auto outVariable = ep->isLateMaterialized() ? ep->outTokenVariable()
+                                                  : ep->outVariable();
+      varInfo.emplace(outVariable->id, VarInfo(depth, totalNrRegs));
       totalNrRegs++;
       break;
     }
@@ -870,6 +902,26 @@ void ExecutionNode::RegisterPlan::after(ExecutionNode* en) {
       break;
     }
 
+    case ExecutionNode::MATERIALIZE: {
+      nrRegsHere[depth]++;
+      nrRegs[depth]++;
+      auto ep = static_cast<MaterializeNode const*>(en);
+      TRI_ASSERT(ep != nullptr);
+      varInfo.emplace(ep->outVariable()->id, VarInfo(depth, totalNrRegs));
+      totalNrRegs++;
+      break;
+    }
+
+    case ExecutionNode::HASH_LOOKUP: {
+      nrRegsHere[depth]++;
+      nrRegs[depth]++;
+      auto ep = static_cast<HashLookupNode const*>(en);
+      TRI_ASSERT(ep != nullptr);
+      varInfo.emplace(ep->outVariable()->id, VarInfo(depth, totalNrRegs));
+      totalNrRegs++;
+      break;
+    }
+
     case ExecutionNode::SUBQUERY: {
       nrRegsHere[depth]++;
       nrRegs[depth]++;
@@ -1257,7 +1309,14 @@ ExecutionNode* EnumerateListNode::clone(ExecutionPlan* plan,
 double EnumerateListNode::estimateCost(size_t& nrItems) const {
   size_t incoming = 0;
   double depCost = _dependencies.at(0)->getCost(incoming);
+  size_t const length = estimateLength();
 
+  nrItems = length * incoming;
+  return depCost + static_cast<double>(length) * incoming;
+}
+
+/// @brief the estimated number of items in the list, per incoming item
+size_t EnumerateListNode::estimateLength() const {
   // Well, what can we say? The length of the list can in general
   // only be determined at runtime... If we were to know that this
   // list is constant, then we could maybe multiply by the length
@@ -1301,8 +1360,7 @@ double EnumerateListNode::estimateCost(size_t& nrItems) const {
     }
   }
 
-  nrItems = length * incoming;
-  return depCost + static_cast<double>(length) * incoming;
+  return length;
 }
 
 LimitNode::LimitNode(ExecutionPlan* plan, arangodb::velocypack::Slice const& base)
@@ -124,7 +124,10 @@ class ExecutionNode {
     UPSERT = 21,
     TRAVERSAL = 22,
     INDEX = 23,
-    SHORTEST_PATH = 24
+    SHORTEST_PATH = 24,
+    HASH_JOIN = 25,
+    MATERIALIZE = 26,
+    HASH_LOOKUP = 27
   };
 
   ExecutionNode() = delete;
@@ -785,6 +788,9 @@ class EnumerateListNode : public ExecutionNode {
   /// @brief the cost of an enumerate list node
   double estimateCost(size_t&) const override final;
 
+  /// @brief the estimated number of items in the list, per incoming item
+  size_t estimateLength() const;
+
   /// @brief getVariablesUsedHere, returning a vector
   std::vector<Variable const*> getVariablesUsedHere() const override final {
     return std::vector<Variable const*>{_inVariable};
@@ -860,6 +866,9 @@ class LimitNode : public ExecutionNode {
   /// @brief tell the node to fully count what it will limit
   void setFullCount() { _fullCount = true; }
 
+  /// @brief whether or not the node fully counts what it limits
+  bool fullCount() const { return _fullCount; }
+
   /// @brief return the offset value
   size_t offset() const { return _offset; }
 
@@ -111,6 +111,8 @@ static std::unique_ptr<traverser::TraverserOptions> CreateTraversalOptions(
 
         if (name == "bfs") {
           options->useBreadthFirst = value->isTrue();
+        } else if (name == "cache") {
+          options->useCache = value->isTrue();
         } else if (name == "uniqueVertices" && value->isStringValue()) {
           if (value->stringEquals("path", true)) {
             options->uniqueVertices =
@@ -165,6 +167,8 @@ static ShortestPathOptions CreateShortestPathOptions(AstNode const* node) {
               std::string(value->getStringValue(), value->getStringLength());
         } else if (name == "defaultWeight" && value->isNumericValue()) {
           options.defaultWeight = value->getDoubleValue();
+        } else if (name == "parallel") {
+          options.parallel = value->isTrue();
         }
       }
     }
@@ -529,6 +533,8 @@ ModificationOptions ExecutionPlan::createModificationOptions(
           options.nullMeansRemove = value->isFalse();
         } else if (name == "mergeObjects") {
           options.mergeObjects = value->isTrue();
+        } else if (name == "readOwnWrites") {
+          options.readOwnWrites = value->isTrue();
         }
       }
     }
@@ -590,6 +596,12 @@ CollectOptions ExecutionPlan::createCollectOptions(AstNode const* node) {
           if (value->isStringValue()) {
             options.method =
                 CollectOptions::methodFromString(value->getString());
+            if (options.method ==
+                CollectOptions::CollectMethod::COLLECT_METHOD_COUNT) {
+              // the count method is chosen by the optimizer only
+              options.method =
+                  CollectOptions::CollectMethod::COLLECT_METHOD_UNDEFINED;
+            }
           }
         }
       }
@@ -1965,6 +1977,8 @@ bool ExecutionPlan::isDeadSimple() const {
         nodeType == ExecutionNode::ENUMERATE_LIST ||
         nodeType == ExecutionNode::TRAVERSAL ||
         nodeType == ExecutionNode::SHORTEST_PATH ||
+        nodeType == ExecutionNode::HASH_JOIN ||
+        nodeType == ExecutionNode::HASH_LOOKUP ||
         nodeType == ExecutionNode::INDEX) {
       // these node types are not simple
       return false;
@@ -39,6 +39,7 @@ void ExecutionStats::toVelocyPack(VPackBuilder& builder) const {
   builder.add("scannedIndex", VPackValue(scannedIndex));
   builder.add("filtered", VPackValue(filtered));
   builder.add("httpRequests", VPackValue(httpRequests));
+  builder.add("v8Executions", VPackValue(v8Executions));
 
   if (fullCount > -1) {
     // fullCount is exceptional. it has a default value of -1 and is
@@ -58,6 +59,7 @@ void ExecutionStats::toVelocyPackStatic(VPackBuilder& builder) {
   builder.add("scannedIndex", VPackValue(0));
   builder.add("filtered", VPackValue(0));
   builder.add("httpRequests", VPackValue(0));
+  builder.add("v8Executions", VPackValue(0));
   builder.add("fullCount", VPackValue(-1));
   builder.add("executionTime", VPackValue(0.0));
   builder.close();
@@ -70,6 +72,7 @@ ExecutionStats::ExecutionStats()
       scannedIndex(0),
       filtered(0),
       httpRequests(0),
+      v8Executions(0),
       fullCount(-1),
       executionTime(0.0) {}
 
@@ -89,6 +92,11 @@ ExecutionStats::ExecutionStats(VPackSlice const& slice)
   if (slice.hasKey("httpRequests")) {
     httpRequests = slice.get("httpRequests").getNumber<int64_t>();
   }
+  
+  // note: v8Executions is an optional attribute!
+  if (slice.hasKey("v8Executions")) {
+    v8Executions = slice.get("v8Executions").getNumber<int64_t>();
+  }
 
   // note: fullCount is an optional attribute!
   if (slice.hasKey("fullCount")) {
@@ -58,6 +58,7 @@ struct ExecutionStats {
     scannedIndex += summand.scannedIndex;
     filtered += summand.filtered;
     httpRequests += summand.httpRequests;
+    v8Executions += summand.v8Executions;
     if (summand.fullCount > 0) {
       // fullCount may be negative, don't add it then
       fullCount += summand.fullCount;
@@ -72,6 +73,7 @@ struct ExecutionStats {
     scannedIndex = 0;
     filtered = 0;
     httpRequests = 0;
+    v8Executions = 0;
     fullCount = -1;
     executionTime = 0.0;
   }
@@ -94,6 +96,9 @@ struct ExecutionStats {
 
   int64_t httpRequests;
 
+  /// @brief number of expression evaluations that had to fall back to V8
+  int64_t v8Executions;
+
   /// @brief total number of results, before applying last limit
   int64_t fullCount;
   
@@ -44,6 +44,9 @@ using namespace arangodb::aql;
 /// an array / object literal "big" and pulling it out of the expression
 size_t const Executor::DefaultLiteralSizeThreshold = 32;
 
+/// @brief maximum number of compiled expressions cached per V8 context
+size_t const Executor::MaxCachedExpressions = 1024;
+
 /// @brief creates an executor
 Executor::Executor(int64_t literalSizeThreshold)
     : _buffer(nullptr),
@@ -81,6 +84,29 @@ V8Expression* Executor::generateExpression(AstNode const* node) {
 
   TRI_ASSERT(_buffer != nullptr);
 
+  // a "simple" expression here is any expression that will only return
+  // non-cyclic
+  // data and will not return any special JavaScript types such as Date, RegExp
+  // or
+  // Function
+  // as we know that all built-in AQL functions are simple but do not know
+  // anything
+  // about user-defined functions, so we expect them to be non-simple
+  bool const isSimple = (!node->callsUserDefinedFunction());
+
+  // the generated code only depends on the expression. user-defined
+  // functions are looked up by name when an expression is first executed,
+  // so a cached function always calls their current versions
+  TRI_GET_GLOBALS();
+  std::string code(_buffer->c_str(), _buffer->length());
+  auto it = v8g->AqlExpressions.find(code);
+
+  if (it != v8g->AqlExpressions.end()) {
+    return new V8Expression(isolate,
+                            v8::Local<v8::Function>::New(isolate, (*it).second),
+                            constantValues, isSimple);
+  }
+
   v8::Handle<v8::Script> compiled = v8::Script::Compile(
       TRI_V8_STD_STRING((*_buffer)), TRI_V8_ASCII_STRING("--script--"));
 
@@ -90,15 +116,15 @@ V8Expression* Executor::generateExpression(AstNode const* node) {
     // exit early if an error occurred
     HandleV8Error(tryCatch, func,  _buffer, false);
 
-    // a "simple" expression here is any expression that will only return
-    // non-cyclic
-    // data and will not return any special JavaScript types such as Date, RegExp
-    // or
-    // Function
-    // as we know that all built-in AQL functions are simple but do not know
-    // anything
-    // about user-defined functions, so we expect them to be non-simple
-    bool const isSimple = (!node->callsUserDefinedFunction());
+    if (v8g->AqlExpressions.size() >= MaxCachedExpressions) {
+      // simply start over
+      for (auto& entry : v8g->AqlExpressions) {
+        entry.second.Reset();
+      }
+      v8g->AqlExpressions.clear();
+    }
+    v8g->AqlExpressions[code].Reset(isolate,
+                                    v8::Handle<v8::Function>::Cast(func));
 
     return new V8Expression(isolate, v8::Handle<v8::Function>::Cast(func),
                             constantValues, isSimple);
@@ -171,6 +171,9 @@ class Executor {
   /// an array / object literal "big" and pulling it out of the expression
   static size_t const DefaultLiteralSizeThreshold;
 
+  /// @brief maximum number of compiled expressions cached per V8 context
+  static size_t const MaxCachedExpressions;
+
 };
 }
 }
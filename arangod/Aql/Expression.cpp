@@ -23,14 +23,19 @@
 
 #include "Expression.h"
 #include "Aql/AqlItemBlock.h"
+#include "Aql/AqlItemColumn.h"
 #include "Aql/AqlValue.h"
+#include "Aql/Arithmetic.h"
 #include "Aql/Ast.h"
 #include "Aql/AttributeAccessor.h"
+#include "Aql/ExecutionEngine.h"
 #include "Aql/Executor.h"
 #include "Aql/ExpressionContext.h"
 #include "Aql/BaseExpressionContext.h"
+#include "Aql/CompiledExpression.h"
 #include "Aql/Function.h"
 #include "Aql/Functions.h"
+#include "Aql/InListSet.h"
 #include "Aql/Quantifier.h"
 #include "Aql/Query.h"
 #include "Aql/V8Expression.h"
@@ -70,8 +75,143 @@ static void RegisterWarning(arangodb::aql::Ast const* ast,
   ast->query()->registerWarning(code, msg.c_str());
 }
 
+/// @brief whether or not a node can be used as an operand in a batch
+/// comparison
+static bool IsBatchOperand(AstNode const* node) {
+  if (node->type == NODE_TYPE_VALUE) {
+    return node->isNumericValue();
+  }
+
+  while (node->type == NODE_TYPE_ATTRIBUTE_ACCESS) {
+    node = node->getMemberUnchecked(0);
+  }
+  return node->type == NODE_TYPE_REFERENCE;
+}
+
+/// @brief mirror a comparison operator, so that the operands can be swapped
+static AstNodeType MirrorComparison(AstNodeType type) {
+  switch (type) {
+    case NODE_TYPE_OPERATOR_BINARY_LT:
+      return NODE_TYPE_OPERATOR_BINARY_GT;
+    case NODE_TYPE_OPERATOR_BINARY_LE:
+      return NODE_TYPE_OPERATOR_BINARY_GE;
+    case NODE_TYPE_OPERATOR_BINARY_GT:
+      return NODE_TYPE_OPERATOR_BINARY_LT;
+    case NODE_TYPE_OPERATOR_BINARY_GE:
+      return NODE_TYPE_OPERATOR_BINARY_LE;
+    default:
+      return type;
+  }
+}
+
+/// @brief compare two columns or a column and a constant value
+template <typename T>
+static void CompareColumns(AstNodeType type, T const* l, T const* r, T value,
+                           uint8_t* out, size_t n) {
+  switch (type) {
+    case NODE_TYPE_OPERATOR_BINARY_EQ:
+      if (r == nullptr) {
+        ColumnCompareScalar(l, value, out, n, std::equal_to<T>());
+      } else {
+        ColumnCompare(l, r, out, n, std::equal_to<T>());
+      }
+      break;
+    case NODE_TYPE_OPERATOR_BINARY_NE:
+      if (r == nullptr) {
+        ColumnCompareScalar(l, value, out, n, std::not_equal_to<T>());
+      } else {
+        ColumnCompare(l, r, out, n, std::not_equal_to<T>());
+      }
+      break;
+    case NODE_TYPE_OPERATOR_BINARY_LT:
+      if (r == nullptr) {
+        ColumnCompareScalar(l, value, out, n, std::less<T>());
+      } else {
+        ColumnCompare(l, r, out, n, std::less<T>());
+      }
+      break;
+    case NODE_TYPE_OPERATOR_BINARY_LE:
+      if (r == nullptr) {
+        ColumnCompareScalar(l, value, out, n, std::less_equal<T>());
+      } else {
+        ColumnCompare(l, r, out, n, std::less_equal<T>());
+      }
+      break;
+    case NODE_TYPE_OPERATOR_BINARY_GT:
+      if (r == nullptr) {
+        ColumnCompareScalar(l, value, out, n, std::greater<T>());
+      } else {
+        ColumnCompare(l, r, out, n, std::greater<T>());
+      }
+      break;
+    case NODE_TYPE_OPERATOR_BINARY_GE:
+      if (r == nullptr) {
+        ColumnCompareScalar(l, value, out, n, std::greater_equal<T>());
+      } else {
+        ColumnCompare(l, r, out, n, std::greater_equal<T>());
+      }
+      break;
+    default:
+      THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL,
+                                     "invalid batch comparison operator");
+  }
+}
+
+/// @brief maximum number of memoized results per function call
+static size_t const MaxMemoizedResults = 1024;
+
+/// @brief whether or not the results of a function are worth memoizing.
+/// this is the case for deterministic functions that are expensive compared
+/// to a hash lookup of their arguments, and that are often called with
+/// repeating arguments (e.g. dates of the same day)
+static bool IsMemoizable(Function const* func) {
+  if (!func->isDeterministic) {
+    return false;
+  }
+
+  std::string const& name = func->externalName;
+  return (name.compare(0, 5, "DATE_") == 0 || name == "REGEX_TEST" ||
+          name == "REGEX_REPLACE" || name == "LIKE");
 }
 
+/// @brief build the memoization key for the arguments of a function call.
+/// returns false if an argument is not a scalar value, which keeps the key
+/// cheap to build and compare
+static bool BuildMemoizationKey(VPackFunctionParameters const& parameters,
+                                std::string& key) {
+  for (auto const& it : parameters) {
+    if (!it.isNull(false) && !it.isBoolean() && !it.isNumber() &&
+        !it.isString()) {
+      return false;
+    }
+    VPackSlice s = it.slice();
+    key.append(s.startAs<char>(), static_cast<size_t>(s.byteSize()));
+  }
+  return true;
+}
+
+}
+
+/// @brief memoized results of a deterministic function call, keyed by the
+/// velocypack of the call arguments
+struct Expression::FunctionCallCache {
+  FunctionCallCache() : hits(0), misses(0), enabled(true) {}
+
+  ~FunctionCallCache() { clear(); }
+
+  void clear() {
+    for (auto& it : results) {
+      it.second.destroy();
+    }
+    results.clear();
+  }
+
+  std::unordered_map<std::string, AqlValue> results;
+  uint64_t hits;
+  uint64_t misses;
+  bool enabled;
+};
+
 /// @brief create the expression
 Expression::Expression(Ast* ast, AstNode* node)
     : _ast(ast),
@@ -123,6 +263,73 @@ Expression::~Expression() {
   }
 }
 
+/// @brief return the memoization cache for a function call node, or a
+/// nullptr if the function's results are not memoized
+Expression::FunctionCallCache* Expression::functionCallCache(
+    AstNode const* node, Function const* func) {
+  auto it = _functionCallCaches.find(node);
+
+  if (it == _functionCallCaches.end()) {
+    std::unique_ptr<FunctionCallCache> cache;
+    if (IsMemoizable(func)) {
+      cache.reset(new FunctionCallCache());
+    }
+    it = _functionCallCaches.emplace(node, std::move(cache)).first;
+  }
+
+  FunctionCallCache* cache = (*it).second.get();
+
+  if (cache == nullptr || !cache->enabled) {
+    return nullptr;
+  }
+  return cache;
+}
+
+/// @brief return the hash set of a constant IN list, building it on first
+/// use
+InListSet* Expression::inListSet(AstNode const* node, AqlValue const& right,
+                                 transaction::Methods* trx) const {
+  auto it = _inListSets.find(node);
+
+  if (it == _inListSets.end()) {
+    std::unique_ptr<InListSet> set;
+    AstNode const* list = node->getMember(1);
+    if (list->type == NODE_TYPE_ARRAY && list->isConstant()) {
+      VPackBuilder builder;
+      right.toVelocyPack(trx, builder, false);
+      set.reset(new InListSet(builder.slice()));
+    }
+    it = _inListSets.emplace(node, std::move(set)).first;
+  }
+
+  return (*it).second.get();
+}
+
+/// @brief memoize the result of a function call. when the cache is full,
+/// it is kept only if it is effective enough
+void Expression::memoizeFunctionCall(FunctionCallCache* cache,
+                                     std::string const& key,
+                                     AqlValue const& result) {
+  ++cache->misses;
+
+  if (cache->results.size() >= MaxMemoizedResults) {
+    if (cache->hits < cache->misses) {
+      // the arguments hardly repeat. stop memoizing
+      cache->clear();
+      cache->enabled = false;
+    }
+    return;
+  }
+
+  AqlValue copy = result.clone();
+  try {
+    cache->results.emplace(key, copy);
+  } catch (...) {
+    copy.destroy();
+    throw;
+  }
+}
+
 /// @brief return all variables used in the expression
 void Expression::variables(std::unordered_set<Variable const*>& result) const {
   Ast::getReferencedVariables(_node, result);
@@ -148,7 +355,8 @@ AqlValue Expression::execute(transaction::Methods* trx, ExpressionContext* ctx,
     }
 
     case SIMPLE: {
-      return executeSimpleExpression(_node, trx, mustDestroy, true);
+      TRI_ASSERT(_compiled != nullptr);
+      return _compiled->execute(trx, mustDestroy);
     }
 
     case ATTRIBUTE_SYSTEM: {
@@ -163,6 +371,11 @@ AqlValue Expression::execute(transaction::Methods* trx, ExpressionContext* ctx,
 
     case V8: {
       TRI_ASSERT(_func != nullptr);
+      // count the fallbacks to V8 in the query's statistics
+      ExecutionEngine* engine = _ast->query()->engine();
+      if (engine != nullptr) {
+        ++engine->_stats.v8Executions;
+      }
       ISOLATE;
       return _func->execute(isolate, _ast->query(), trx, ctx, mustDestroy);
     }
@@ -188,6 +401,153 @@ AqlValue Expression::execute(transaction::Methods* trx,
   return execute(trx, &ctx, mustDestroy);
 }
 
+/// @brief whether or not the expression is a comparison (==, !=, <, <=,
+/// >, >=) of two operands that are numeric constants, variable references
+/// or attribute accesses on variables
+bool Expression::isBatchComparison() {
+  if (_type == UNPROCESSED) {
+    analyzeExpression();
+  }
+
+  if (_type != SIMPLE) {
+    return false;
+  }
+
+  switch (_node->type) {
+    case NODE_TYPE_OPERATOR_BINARY_EQ:
+    case NODE_TYPE_OPERATOR_BINARY_NE:
+    case NODE_TYPE_OPERATOR_BINARY_LT:
+    case NODE_TYPE_OPERATOR_BINARY_LE:
+    case NODE_TYPE_OPERATOR_BINARY_GT:
+    case NODE_TYPE_OPERATOR_BINARY_GE:
+      break;
+    default:
+      return false;
+  }
+
+  auto lhs = _node->getMemberUnchecked(0);
+  auto rhs = _node->getMemberUnchecked(1);
+
+  if (lhs->type == NODE_TYPE_VALUE && rhs->type == NODE_TYPE_VALUE) {
+    // no point in comparing two constants for each row
+    return false;
+  }
+
+  return IsBatchOperand(lhs) && IsBatchOperand(rhs);
+}
+
+/// @brief evaluate a batch comparison for all rows of the block at once
+bool Expression::executeBatchComparison(
+    transaction::Methods* trx, AqlItemBlock const* argv,
+    std::vector<Variable const*> const& vars,
+    std::vector<RegisterId> const& regs, AqlItemColumn& lhs,
+    AqlItemColumn& rhs, std::vector<uint8_t>& result) {
+  TRI_ASSERT(isBatchComparison());
+
+  if (!_variables.empty()) {
+    // temporary variables have been injected into the expression
+    return false;
+  }
+
+  AstNode const* left = _node->getMemberUnchecked(0);
+  AstNode const* right = _node->getMemberUnchecked(1);
+  AstNodeType type = _node->type;
+
+  if (left->type == NODE_TYPE_VALUE) {
+    // make the constant value the right-hand operand
+    std::swap(left, right);
+    type = MirrorComparison(type);
+  }
+
+  if (!loadBatchOperand(left, trx, argv, vars, regs, lhs) ||
+      !lhs.isNumeric() || lhs.hasNulls()) {
+    return false;
+  }
+
+  size_t const n = argv->size();
+  result.resize(n);
+
+  if (right->type == NODE_TYPE_VALUE) {
+    if (lhs.type() == AqlItemColumn::INT64 && right->isIntValue()) {
+      CompareColumns<int64_t>(type, lhs.int64Values(), nullptr,
+                              right->getIntValue(), result.data(), n);
+    } else {
+      CompareColumns<double>(type, lhs.doubleValues(), nullptr,
+                             right->getDoubleValue(), result.data(), n);
+    }
+    return true;
+  }
+
+  if (!loadBatchOperand(right, trx, argv, vars, regs, rhs) ||
+      !rhs.isNumeric() || rhs.hasNulls()) {
+    return false;
+  }
+
+  if (lhs.type() == AqlItemColumn::INT64 &&
+      rhs.type() == AqlItemColumn::INT64) {
+    CompareColumns<int64_t>(type, lhs.int64Values(), rhs.int64Values(), 0,
+                            result.data(), n);
+  } else {
+    CompareColumns<double>(type, lhs.doubleValues(), rhs.doubleValues(), 0.0,
+                           result.data(), n);
+  }
+  return true;
+}
+
+/// @brief load the values of an operand of a batch comparison for all
+/// rows of the block into the column
+bool Expression::loadBatchOperand(AstNode const* node,
+                                  transaction::Methods* trx,
+                                  AqlItemBlock const* argv,
+                                  std::vector<Variable const*> const& vars,
+                                  std::vector<RegisterId> const& regs,
+                                  AqlItemColumn& column) {
+  // collect the attribute path (if any)
+  std::vector<std::string> path;
+  while (node->type == NODE_TYPE_ATTRIBUTE_ACCESS) {
+    path.emplace(path.begin(), node->getString());
+    node = node->getMemberUnchecked(0);
+  }
+
+  TRI_ASSERT(node->type == NODE_TYPE_REFERENCE);
+  auto v = static_cast<Variable const*>(node->getData());
+
+  size_t const n = vars.size();
+  for (size_t i = 0; i < n; ++i) {
+    if (vars[i]->id != v->id) {
+      continue;
+    }
+
+    RegisterId const reg = regs[i];
+    if (path.empty()) {
+      return column.load(argv, reg);
+    }
+
+    size_t const rows = argv->size();
+    column.reset(rows);
+
+    for (size_t row = 0; row < rows; ++row) {
+      AqlValue const& value = argv->getValueReference(row, reg);
+      bool mustDestroy;
+      AqlValue a;
+      if (path.size() == 1) {
+        a = value.get(trx, path[0], mustDestroy, false);
+      } else {
+        a = value.get(trx, path, mustDestroy, false);
+      }
+      AqlValueGuard guard(a, mustDestroy);
+
+      if (!column.set(row, a)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // variable not found in the block
+  return false;
+}
+
 /// @brief replace variables in the expression with other variables
 void Expression::replaceVariables(
     std::unordered_map<VariableId, Variable const*> const& replacements) {
@@ -201,6 +561,7 @@ void Expression::replaceVariables(
   }
 
   invalidate();
+  invalidateCompiled();
 }
 
 /// @brief replace a variable reference in the expression with another
@@ -253,9 +614,19 @@ void Expression::invalidate() {
   // expression data will be freed in the destructor
 }
 
+/// @brief drop the compiled version of a SIMPLE expression, so that it
+/// is compiled again from the current AST nodes
+void Expression::invalidateCompiled() {
+  if (_type == SIMPLE && _built) {
+    _compiled.reset();
+    _built = false;
+  }
+}
+
 /// @brief find a value in an AQL list node
-/// this performs either a binary search (if the node is sorted) or a
-/// linear search (if the node is not sorted)
+/// this performs either a hash lookup (if the list is constant), a binary
+/// search (if the node is sorted) or a linear search (if the node is not
+/// sorted)
 bool Expression::findInArray(AqlValue const& left, AqlValue const& right,
                              transaction::Methods* trx,
                              AstNode const* node) const {
@@ -263,6 +634,19 @@ bool Expression::findInArray(AqlValue const& left, AqlValue const& right,
 
   size_t const n = right.length();
 
+  if (n >= AstNode::SortNumberThreshold &&
+      (node->type == NODE_TYPE_OPERATOR_BINARY_IN ||
+       node->type == NODE_TYPE_OPERATOR_BINARY_NIN)) {
+    InListSet* set = inListSet(node, right, trx);
+    if (set != nullptr) {
+      AqlValueMaterializer materializer(trx);
+      VPackSlice value = materializer.slice(left, false);
+      if (InListSet::canFind(value)) {
+        return set->contains(value);
+      }
+    }
+  }
+
   if (n >= AstNode::SortNumberThreshold && 
       (node->getMember(1)->isSorted() ||
       ((node->type == NODE_TYPE_OPERATOR_BINARY_IN || 
@@ -425,6 +809,9 @@ void Expression::buildExpression(transaction::Methods* trx) {
 
     _data = new uint8_t[static_cast<size_t>(builder->size())];
     memcpy(_data, builder->data(), static_cast<size_t>(builder->size()));
+  } else if (_type == SIMPLE) {
+    // compile the expression once, so the AST is not walked for each row
+    _compiled.reset(new CompiledExpression(this, _node));
   } else if (_type == V8) {
     // generate a V8 expression
     _func = _executor->generateExpression(_node);
@@ -894,9 +1281,38 @@ AqlValue Expression::executeSimpleExpressionFCall(
     TRI_ASSERT(parameters.size() == destroyParameters.size());
     TRI_ASSERT(parameters.size() == n);
 
+    // look up the result of an earlier call with the same arguments
+    FunctionCallCache* cache = functionCallCache(node, func);
+    std::string key;
+    bool const memoize =
+        (cache != nullptr && BuildMemoizationKey(parameters, key));
+
+    if (memoize) {
+      auto it = cache->results.find(key);
+
+      if (it != cache->results.end()) {
+        ++cache->hits;
+        AqlValue a = it->second.clone();
+        mustDestroy = true;
+
+        for (size_t i = 0; i < n; ++i) {
+          if (destroyParameters[i]) {
+            parameters[i].destroy();
+          }
+        }
+        return a;
+      }
+    }
+
     AqlValue a = func->implementation(_ast->query(), trx, parameters);
     mustDestroy = true; // function result is always dynamic
 
+    if (memoize) {
+      AqlValueGuard guard(a, true);
+      memoizeFunctionCall(cache, key, a);
+      guard.steal();
+    }
+
     for (size_t i = 0; i < n; ++i) {
       if (destroyParameters[i]) {
         parameters[i].destroy();
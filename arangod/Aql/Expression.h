@@ -46,15 +46,21 @@ class StringBuffer;
 namespace aql {
 
 class AqlItemBlock;
+class AqlItemColumn;
 struct AqlValue;
 class Ast;
 class AttributeAccessor;
+class CompiledExpression;
 class Executor;
 class ExpressionContext;
+struct Function;
+class InListSet;
 struct V8Expression;
 
 /// @brief AqlExpression, used in execution plans and execution blocks
 class Expression {
+  friend class CompiledExpression;
+
  public:
   enum ExpressionType : uint32_t { UNPROCESSED, JSON, V8, SIMPLE, ATTRIBUTE_SYSTEM, ATTRIBUTE_DYNAMIC };
 
@@ -74,6 +80,7 @@ class Expression {
   inline void replaceNode (AstNode* node) {
     _node = node;
     invalidate();
+    invalidateCompiled();
   }
 
   /// @brief get the underlying AST node
@@ -131,6 +138,24 @@ class Expression {
                    std::vector<Variable const*> const&,
                    std::vector<RegisterId> const&, bool& mustDestroy);
 
+  /// @brief whether or not the expression is a comparison (==, !=, <, <=,
+  /// >, >=) of two operands that are numeric constants, variable references
+  /// or attribute accesses on variables. such expressions can be evaluated
+  /// for a whole block at once using executeBatchComparison
+  bool isBatchComparison();
+
+  /// @brief evaluate a batch comparison for all rows of the block at once.
+  /// the comparison result for each row is written into result (1 = true,
+  /// 0 = false). lhs and rhs are used as scratch space for the operand
+  /// values. returns false if the actual values do not permit batch
+  /// evaluation (e.g. non-numeric values or nulls). the caller must then
+  /// fall back to executing the expression for each row
+  bool executeBatchComparison(transaction::Methods*, AqlItemBlock const*,
+                              std::vector<Variable const*> const&,
+                              std::vector<RegisterId> const&,
+                              AqlItemColumn& lhs, AqlItemColumn& rhs,
+                              std::vector<uint8_t>& result);
+
   /// @brief check whether this is a JSON expression
   inline bool isJson() {
     if (_type == UNPROCESSED) {
@@ -222,10 +247,21 @@ class Expression {
   /// @brief analyze the expression (determine its type etc.)
   void analyzeExpression();
 
+  /// @brief drop the compiled version of a SIMPLE expression, so that it
+  /// is compiled again from the current AST nodes
+  void invalidateCompiled();
+
   /// @brief build the expression (if appropriate, compile it into
   /// executable code)
   void buildExpression(transaction::Methods*);
 
+  /// @brief load the values of an operand of a batch comparison for all
+  /// rows of the block into the column
+  bool loadBatchOperand(AstNode const*, transaction::Methods*,
+                        AqlItemBlock const*,
+                        std::vector<Variable const*> const&,
+                        std::vector<RegisterId> const&, AqlItemColumn&);
+
   /// @brief execute an expression of type SIMPLE
   AqlValue executeSimpleExpression(AstNode const*,
                                    transaction::Methods*,
@@ -328,6 +364,22 @@ class Expression {
       AstNode const*, transaction::Methods*, 
       bool& mustDestroy);
 
+  struct FunctionCallCache;
+
+  /// @brief return the memoization cache for a function call node, or a
+  /// nullptr if the function's results are not memoized
+  FunctionCallCache* functionCallCache(AstNode const*, Function const*);
+
+  /// @brief memoize the result of a function call
+  void memoizeFunctionCall(FunctionCallCache*, std::string const&,
+                           AqlValue const&);
+
+  /// @brief return the hash set of the values of a constant array on the
+  /// right-hand side of an IN or NOT IN node, or a nullptr if it is not
+  /// constant
+  InListSet* inListSet(AstNode const*, AqlValue const&,
+                       transaction::Methods*) const;
+
  private:
   /// @brief the AST
   Ast* _ast;
@@ -348,6 +400,9 @@ class Expression {
     AttributeAccessor* _accessor;
   };
 
+  /// @brief the compiled version of a SIMPLE expression
+  std::unique_ptr<CompiledExpression> _compiled;
+
   /// @brief type of expression
   ExpressionType _type;
 
@@ -376,6 +431,16 @@ class Expression {
   std::unordered_map<Variable const*, arangodb::velocypack::Slice> _variables;
 
   ExpressionContext* _expressionContext;
+
+  /// @brief memoized function call results, by function call node. contains
+  /// a nullptr for function calls that are not memoized
+  std::unordered_map<AstNode const*, std::unique_ptr<FunctionCallCache>>
+      _functionCallCaches;
+
+  /// @brief hash sets of constant IN lists, by IN/NOT IN node. contains a
+  /// nullptr for nodes whose list is not constant
+  mutable std::unordered_map<AstNode const*, std::unique_ptr<InListSet>>
+      _inListSets;
 };
 
 }  // namespace arangodb::aql
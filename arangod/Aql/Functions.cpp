@@ -28,6 +28,8 @@
 #include <velocypack/Iterator.h>
 #include <velocypack/velocypack-aliases.h>
 
+#include <unicode/unistr.h>
+
 #include "Aql/Function.h"
 #include "Aql/Query.h"
 #include "Basics/Exceptions.h"
@@ -37,6 +39,7 @@
 #include "Basics/VPackStringBufferAdapter.h"
 #include "Basics/VelocyPackHelper.h"
 #include "Basics/fpconv.h"
+#include "Basics/system-functions.h"
 #include "Basics/tri-strings.h"
 #include "Indexes/Index.h"
 #include "Random/UniformCharacter.h"
@@ -410,6 +413,18 @@ void Functions::Stringify(transaction::Methods* trx,
     buffer.append(p, length);
     return;
   }
+
+  if (slice.isDouble()) {
+    double const v = slice.getDouble();
+
+    if (std::isfinite(v)) {
+      // format numbers the same way as the JSON output of the server does
+      char temp[24];
+      int length = fpconv_dtoa(v, &temp[0]);
+      buffer.append(&temp[0], static_cast<uint64_t>(length));
+      return;
+    }
+  }
    
   VPackOptions* options = trx->transactionContextPtr()->getVPackOptionsForDump();
   VPackOptions adjustedOptions = *options;
@@ -3688,6 +3703,1300 @@ AqlValue Functions::IsSameCollection(
   return AqlValue(arangodb::basics::VelocyPackHelper::NullValue());
 }
 
+/// @brief convert a VelocyPack value into a UTF-16 string, using the same
+/// conversion as TO_STRING. the string functions below operate on UTF-16
+/// code units, so that character offsets and lengths are the same as in
+/// their former JavaScript implementations
+static icu::UnicodeString SliceToUnicodeString(transaction::Methods* trx,
+                                               VPackSlice const& slice) {
+  transaction::StringBufferLeaser buffer(trx);
+  arangodb::basics::VPackStringBufferAdapter adapter(buffer->stringBuffer());
+
+  Functions::Stringify(trx, adapter, slice);
+  return icu::UnicodeString::fromUTF8(icu::StringPiece(
+      buffer->c_str(), static_cast<int32_t>(buffer->length())));
+}
+
+/// @brief convert an AqlValue into a UTF-16 string, using the same
+/// conversion as TO_STRING
+static icu::UnicodeString ValueToUnicodeString(transaction::Methods* trx,
+                                               AqlValue const& value) {
+  AqlValueMaterializer materializer(trx);
+  return SliceToUnicodeString(trx, materializer.slice(value, false));
+}
+
+/// @brief convert a UTF-16 string into a string AqlValue
+static AqlValue UnicodeStringValue(icu::UnicodeString const& value) {
+  std::string result;
+  value.toUTF8String(result);
+  return AqlValue(result);
+}
+
+/// @brief return length characters of value, starting at offset.
+/// a negative offset is counted from the end of the string, a negative
+/// length results in an empty string
+static AqlValue SubstringValue(icu::UnicodeString const& value,
+                               int64_t offset, int64_t length) {
+  int64_t const size = static_cast<int64_t>(value.length());
+
+  if (offset < 0) {
+    offset = (std::max)(size + offset, static_cast<int64_t>(0));
+  } else if (offset > size) {
+    offset = size;
+  }
+
+  length = (std::min)((std::max)(length, static_cast<int64_t>(0)),
+                      size - offset);
+
+  return UnicodeStringValue(value.tempSubString(static_cast<int32_t>(offset),
+                                                static_cast<int32_t>(length)));
+}
+
+/// @brief whether or not the character is whitespace that is removed
+/// by the trim functions by default
+static bool IsTrimWhitespace(UChar c) {
+  switch (c) {
+    case 0x0009:
+    case 0x000a:
+    case 0x000b:
+    case 0x000c:
+    case 0x000d:
+    case 0x0020:
+    case 0x00a0:
+    case 0x1680:
+    case 0x2028:
+    case 0x2029:
+    case 0x202f:
+    case 0x205f:
+    case 0x3000:
+    case 0xfeff:
+      return true;
+    default:
+      return (c >= 0x2000 && c <= 0x200a);
+  }
+}
+
+/// @brief remove the characters contained in chars from the start and/or
+/// the end of value. if chars is a nullptr, whitespace is removed
+static AqlValue TrimValue(icu::UnicodeString const& value,
+                          icu::UnicodeString const* chars, bool left,
+                          bool right) {
+  auto isTrimmed = [chars](UChar c) -> bool {
+    if (chars == nullptr) {
+      return IsTrimWhitespace(c);
+    }
+    return (chars->indexOf(c) >= 0);
+  };
+
+  int32_t start = 0;
+  int32_t end = value.length();
+
+  if (left) {
+    while (start < end && isTrimmed(value.charAt(start))) {
+      ++start;
+    }
+  }
+  if (right) {
+    while (end > start && isTrimmed(value.charAt(end - 1))) {
+      --end;
+    }
+  }
+
+  return UnicodeStringValue(value.tempSubString(start, end - start));
+}
+
+/// @brief shared implementation of LTRIM and RTRIM
+AqlValue Functions::TrimFunction(transaction::Methods* trx,
+                                 VPackFunctionParameters const& parameters,
+                                 char const* functionName, bool left,
+                                 bool right) {
+  ValidateParameters(parameters, functionName, 1, 2);
+
+  AqlValue value = ExtractFunctionParameterValue(trx, parameters, 0);
+  icu::UnicodeString const s = ValueToUnicodeString(trx, value);
+
+  if (parameters.size() > 1) {
+    AqlValue c = ExtractFunctionParameterValue(trx, parameters, 1);
+
+    if (!c.isNull(false)) {
+      icu::UnicodeString const chars = ValueToUnicodeString(trx, c);
+      return TrimValue(s, &chars, left, right);
+    }
+  }
+
+  return TrimValue(s, nullptr, left, right);
+}
+
+/// @brief extract the optional start and end offsets of FIND_FIRST and
+/// FIND_LAST. end is inclusive. returns false if nothing can be found
+/// in the specified range
+bool Functions::FindRange(transaction::Methods* trx,
+                          VPackFunctionParameters const& parameters,
+                          int32_t size, int32_t& start, int32_t& end) {
+  start = 0;
+  end = size;
+
+  if (parameters.size() > 2) {
+    AqlValue s = ExtractFunctionParameterValue(trx, parameters, 2);
+
+    if (!s.isNull(false)) {
+      int64_t value = s.toInt64(trx);
+      if (value < 0 || value > size) {
+        return false;
+      }
+      start = static_cast<int32_t>(value);
+    }
+  }
+
+  if (parameters.size() > 3) {
+    AqlValue e = ExtractFunctionParameterValue(trx, parameters, 3);
+
+    if (!e.isNull(false)) {
+      int64_t value = e.toInt64(trx);
+      if (value < start) {
+        return false;
+      }
+      end = static_cast<int32_t>(
+          (std::min)(value + 1, static_cast<int64_t>(size)));
+    }
+  }
+
+  return true;
+}
+
+/// @brief milliseconds per day
+static int64_t const MillisecondsPerDay = 86400000;
+
+/// @brief maximum absolute timestamp value (in milliseconds) that can
+/// be represented as a date
+static double const MaxTimestamp = 8.64e15;
+
+/// @brief the components of a timestamp
+struct DateParts {
+  int64_t days;  // days since the epoch
+  int64_t year;
+  int64_t month;  // 1 - 12
+  int64_t day;    // 1 - 31
+  int64_t hour;
+  int64_t minute;
+  int64_t second;
+  int64_t millisecond;
+  int64_t weekday;  // 0 (sunday) - 6 (saturday)
+};
+
+/// @brief whether or not the year is a leap year (proleptic Gregorian
+/// calendar)
+static bool IsLeapYear(int64_t year) {
+  return (year % 4 == 0 && (year % 100 != 0 || year % 400 == 0));
+}
+
+/// @brief number of days in a month (1 - 12)
+static int64_t DaysInMonth(int64_t year, int64_t month) {
+  static int64_t const days[] = {31, 28, 31, 30, 31, 30,
+                                 31, 31, 30, 31, 30, 31};
+  TRI_ASSERT(month >= 1 && month <= 12);
+
+  if (month == 2 && IsLeapYear(year)) {
+    return 29;
+  }
+  return days[month - 1];
+}
+
+/// @brief days since the epoch for a date (month 1 - 12)
+static int64_t DaysFromCivil(int64_t year, int64_t month, int64_t day) {
+  year -= (month <= 2) ? 1 : 0;
+  int64_t const era = (year >= 0 ? year : year - 399) / 400;
+  int64_t const yoe = year - era * 400;
+  int64_t const doy = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+  int64_t const doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+  return era * 146097 + doe - 719468;
+}
+
+/// @brief date (month 1 - 12) for a number of days since the epoch
+static void CivilFromDays(int64_t days, int64_t& year, int64_t& month,
+                          int64_t& day) {
+  days += 719468;
+  int64_t const era = (days >= 0 ? days : days - 146096) / 146097;
+  int64_t const doe = days - era * 146097;
+  int64_t const yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+  int64_t const doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+  int64_t const mp = (5 * doy + 2) / 153;
+  day = doy - (153 * mp + 2) / 5 + 1;
+  month = mp + (mp < 10 ? 3 : -9);
+  year = yoe + era * 400 + (month <= 2 ? 1 : 0);
+}
+
+/// @brief split a timestamp (milliseconds since the epoch) into its
+/// components
+static DateParts SplitTimestamp(int64_t timestamp) {
+  DateParts parts;
+
+  parts.days = timestamp / MillisecondsPerDay;
+  int64_t rest = timestamp % MillisecondsPerDay;
+  if (rest < 0) {
+    rest += MillisecondsPerDay;
+    --parts.days;
+  }
+
+  CivilFromDays(parts.days, parts.year, parts.month, parts.day);
+
+  parts.hour = rest / 3600000;
+  parts.minute = (rest / 60000) % 60;
+  parts.second = (rest / 1000) % 60;
+  parts.millisecond = rest % 1000;
+  parts.weekday = (parts.days + 4) % 7;  // 1970-01-01 was a thursday
+  if (parts.weekday < 0) {
+    parts.weekday += 7;
+  }
+
+  return parts;
+}
+
+/// @brief build a timestamp from date components, normalizing
+/// out-of-range values the same way as JavaScript's Date.UTC. the
+/// month is 0-based
+static bool MakeTimestamp(double year, double month, double day, double hour,
+                          double minute, double second, double millisecond,
+                          int64_t& result) {
+  double components[] = {year, month, day, hour, minute, second, millisecond};
+  for (auto& it : components) {
+    if (!std::isfinite(it)) {
+      return false;
+    }
+    it = std::trunc(it);
+  }
+
+  double const y = components[0] + std::floor(components[1] / 12.0);
+  double const m = components[1] - std::floor(components[1] / 12.0) * 12.0;
+
+  if (std::abs(y) > 400000.0) {
+    return false;
+  }
+
+  double const days =
+      static_cast<double>(DaysFromCivil(static_cast<int64_t>(y),
+                                        static_cast<int64_t>(m) + 1, 1)) +
+      components[2] - 1.0;
+  double const value = days * MillisecondsPerDay + components[3] * 3600000.0 +
+                       components[4] * 60000.0 + components[5] * 1000.0 +
+                       components[6];
+
+  if (std::abs(value) > MaxTimestamp) {
+    return false;
+  }
+
+  result = static_cast<int64_t>(value);
+  return true;
+}
+
+/// @brief parse a date string in ISO 8601 format:
+/// [+-]YYYY[-MM[-DD]][(T| )HH:MM[:SS[.fff]][Z|(+|-)HH[:]MM]].
+/// dates without a time zone are interpreted as UTC. if strict is set,
+/// days that do not exist in the month are rejected, otherwise they
+/// overflow into the next month
+static bool ParseDateString(char const* p, size_t length, bool strict,
+                            int64_t& result) {
+  char const* e = p + length;
+
+  // skip leading and trailing whitespace
+  while (p < e && (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n')) {
+    ++p;
+  }
+  while (e > p &&
+         (e[-1] == ' ' || e[-1] == '\t' || e[-1] == '\r' || e[-1] == '\n')) {
+    --e;
+  }
+
+  auto parseNumber = [&p, &e](size_t minDigits, size_t maxDigits,
+                              int64_t& value) -> bool {
+    size_t digits = 0;
+    value = 0;
+    while (p < e && *p >= '0' && *p <= '9' && digits < maxDigits) {
+      value = value * 10 + (*p - '0');
+      ++p;
+      ++digits;
+    }
+    return (digits >= minDigits);
+  };
+
+  int64_t sign = 1;
+  if (p < e && (*p == '+' || *p == '-')) {
+    sign = (*p == '-') ? -1 : 1;
+    ++p;
+  }
+
+  int64_t year, month = 1, day = 1;
+  int64_t hour = 0, minute = 0, second = 0, millisecond = 0;
+  int64_t offset = 0;  // time zone offset in minutes
+
+  if (!parseNumber(1, 6, year)) {
+    return false;
+  }
+  year *= sign;
+
+  if (p < e && *p == '-') {
+    ++p;
+    if (!parseNumber(1, 2, month)) {
+      return false;
+    }
+    if (p < e && *p == '-') {
+      ++p;
+      if (!parseNumber(1, 2, day)) {
+        return false;
+      }
+    }
+  }
+
+  if (p < e && (*p == 'T' || *p == 't' || *p == ' ')) {
+    ++p;
+    if (!parseNumber(1, 2, hour) || p >= e || *p != ':') {
+      return false;
+    }
+    ++p;
+    if (!parseNumber(1, 2, minute)) {
+      return false;
+    }
+    if (p < e && *p == ':') {
+      ++p;
+      if (!parseNumber(1, 2, second)) {
+        return false;
+      }
+      if (p < e && *p == '.') {
+        // only milliseconds are significant, further digits are ignored
+        ++p;
+        size_t digits = 0;
+        while (p < e && *p >= '0' && *p <= '9') {
+          if (digits < 3) {
+            millisecond = millisecond * 10 + (*p - '0');
+          }
+          ++p;
+          ++digits;
+        }
+        if (digits == 0) {
+          return false;
+        }
+        for (; digits < 3; ++digits) {
+          millisecond *= 10;
+        }
+      }
+    }
+
+    if (p < e && (*p == '+' || *p == '-')) {
+      int64_t const offsetSign = (*p == '-') ? -1 : 1;
+      int64_t offsetHour, offsetMinute = 0;
+      ++p;
+      if (!parseNumber(2, 2, offsetHour)) {
+        return false;
+      }
+      if (p < e && *p == ':') {
+        ++p;
+      }
+      if (p < e && !parseNumber(2, 2, offsetMinute)) {
+        return false;
+      }
+      if (offsetHour > 23 || offsetMinute > 59) {
+        return false;
+      }
+      offset = offsetSign * (offsetHour * 60 + offsetMinute);
+    }
+  }
+
+  if (p < e && (*p == 'Z' || *p == 'z') && offset == 0) {
+    ++p;
+  }
+
+  if (p != e) {
+    // trailing garbage
+    return false;
+  }
+
+  if (month < 1 || month > 12 || day < 1 || day > 31 || hour > 24 ||
+      minute > 59 || second > 59 ||
+      (hour == 24 && (minute > 0 || second > 0 || millisecond > 0))) {
+    return false;
+  }
+
+  if (strict && day > DaysInMonth(year, month)) {
+    return false;
+  }
+
+  double const value =
+      static_cast<double>(DaysFromCivil(year, month, 1) + day - 1) *
+          MillisecondsPerDay +
+      static_cast<double>(hour * 3600000 + minute * 60000 + second * 1000 +
+                          millisecond - offset * 60000);
+
+  if (std::abs(value) > MaxTimestamp) {
+    return false;
+  }
+
+  result = static_cast<int64_t>(value);
+  return true;
+}
+
+/// @brief convert a date value (a timestamp in milliseconds or a date
+/// string) into a timestamp
+static bool ValueToTimestamp(transaction::Methods* trx, AqlValue const& value,
+                             int64_t& result) {
+  if (value.isNumber()) {
+    double const v = value.toDouble(trx);
+    if (!std::isfinite(v) || std::abs(v) > MaxTimestamp) {
+      return false;
+    }
+    result = static_cast<int64_t>(v);
+    return true;
+  }
+
+  if (value.isString()) {
+    AqlValueMaterializer materializer(trx);
+    VPackSlice slice = materializer.slice(value, false);
+    VPackValueLength length;
+    char const* p = slice.getString(length);
+    return ParseDateString(p, static_cast<size_t>(length), false, result);
+  }
+
+  return false;
+}
+
+/// @brief extract a timestamp from the parameters of a date function.
+/// the parameters are either a single date value, or the date components
+/// year, month (1 - 12), day, hour, minute, second and millisecond.
+/// registers a warning and returns false for invalid dates
+bool Functions::ExtractTimestamp(arangodb::aql::Query* query,
+                                 transaction::Methods* trx,
+                                 VPackFunctionParameters const& parameters,
+                                 char const* functionName, int64_t& result) {
+  if (parameters.size() == 1) {
+    AqlValue value = ExtractFunctionParameterValue(trx, parameters, 0);
+    if (ValueToTimestamp(trx, value, result)) {
+      return true;
+    }
+  } else {
+    // missing components default to the first day of the month, 00:00:00
+    double components[] = {0.0, 1.0, 1.0, 0.0, 0.0, 0.0, 0.0};
+    bool valid = true;
+
+    for (size_t i = 0; i < parameters.size() && i < 7; ++i) {
+      AqlValue value = ExtractFunctionParameterValue(trx, parameters, i);
+      bool failed = false;
+
+      if (value.isNumber() || value.isString()) {
+        components[i] = value.toDouble(trx, failed);
+      }
+      if ((!value.isNumber() && !value.isString()) || failed) {
+        valid = false;
+        break;
+      }
+    }
+
+    if (valid &&
+        MakeTimestamp(components[0], components[1] - 1.0, components[2],
+                      components[3], components[4], components[5],
+                      components[6], result)) {
+      return true;
+    }
+  }
+
+  RegisterWarning(query, functionName, TRI_ERROR_QUERY_INVALID_DATE_VALUE);
+  return false;
+}
+
+/// @brief shared implementation of the functions returning a component
+/// of a date
+template <typename F>
+AqlValue Functions::DateComponent(arangodb::aql::Query* query,
+                                  transaction::Methods* trx,
+                                  VPackFunctionParameters const& parameters,
+                                  char const* functionName, F const& extract) {
+  ValidateParameters(parameters, functionName, 1, 1);
+
+  int64_t timestamp;
+  if (!ExtractTimestamp(query, trx, parameters, functionName, timestamp)) {
+    return AqlValue(arangodb::basics::VelocyPackHelper::NullValue());
+  }
+
+  return NumberValue(trx, static_cast<int>(extract(SplitTimestamp(timestamp))));
+}
+
+/// @brief function IS_DATESTRING
+AqlValue Functions::IsDateString(arangodb::aql::Query* query,
+                                 transaction::Methods* trx,
+                                 VPackFunctionParameters const& parameters) {
+  ValidateParameters(parameters, "IS_DATESTRING", 1, 1);
+
+  AqlValue value = ExtractFunctionParameterValue(trx, parameters, 0);
+
+  if (!value.isString()) {
+    return AqlValue(false);
+  }
+
+  AqlValueMaterializer materializer(trx);
+  VPackSlice slice = materializer.slice(value, false);
+  VPackValueLength length;
+  char const* p = slice.getString(length);
+
+  int64_t unused;
+  return AqlValue(
+      ParseDateString(p, static_cast<size_t>(length), true, unused));
+}
+
+/// @brief function CHAR_LENGTH
+AqlValue Functions::CharLength(arangodb::aql::Query* query,
+                               transaction::Methods* trx,
+                               VPackFunctionParameters const& parameters) {
+  ValidateParameters(parameters, "CHAR_LENGTH", 1, 1);
+
+  AqlValue value = ExtractFunctionParameterValue(trx, parameters, 0);
+  return NumberValue(trx, ValueToUnicodeString(trx, value).length());
+}
+
+/// @brief function LOWER
+AqlValue Functions::Lower(arangodb::aql::Query* query,
+                          transaction::Methods* trx,
+                          VPackFunctionParameters const& parameters) {
+  ValidateParameters(parameters, "LOWER", 1, 1);
+
+  AqlValue value = ExtractFunctionParameterValue(trx, parameters, 0);
+  icu::UnicodeString s = ValueToUnicodeString(trx, value);
+  return UnicodeStringValue(s.toLower(icu::Locale::getRoot()));
+}
+
+/// @brief function UPPER
+AqlValue Functions::Upper(arangodb::aql::Query* query,
+                          transaction::Methods* trx,
+                          VPackFunctionParameters const& parameters) {
+  ValidateParameters(parameters, "UPPER", 1, 1);
+
+  AqlValue value = ExtractFunctionParameterValue(trx, parameters, 0);
+  icu::UnicodeString s = ValueToUnicodeString(trx, value);
+  return UnicodeStringValue(s.toUpper(icu::Locale::getRoot()));
+}
+
+/// @brief function SUBSTRING
+AqlValue Functions::Substring(arangodb::aql::Query* query,
+                              transaction::Methods* trx,
+                              VPackFunctionParameters const& parameters) {
+  ValidateParameters(parameters, "SUBSTRING", 2, 3);
+
+  AqlValue value = ExtractFunctionParameterValue(trx, parameters, 0);
+  icu::UnicodeString const s = ValueToUnicodeString(trx, value);
+
+  int64_t const offset =
+      ExtractFunctionParameterValue(trx, parameters, 1).toInt64(trx);
+  int64_t length = static_cast<int64_t>(s.length());
+
+  if (parameters.size() > 2) {
+    length = ExtractFunctionParameterValue(trx, parameters, 2).toInt64(trx);
+  }
+
+  return SubstringValue(s, offset, length);
+}
+
+/// @brief function LEFT
+AqlValue Functions::Left(arangodb::aql::Query* query,
+                         transaction::Methods* trx,
+                         VPackFunctionParameters const& parameters) {
+  ValidateParameters(parameters, "LEFT", 2, 2);
+
+  AqlValue value = ExtractFunctionParameterValue(trx, parameters, 0);
+  int64_t const length =
+      ExtractFunctionParameterValue(trx, parameters, 1).toInt64(trx);
+
+  return SubstringValue(ValueToUnicodeString(trx, value), 0, length);
+}
+
+/// @brief function RIGHT
+AqlValue Functions::Right(arangodb::aql::Query* query,
+                          transaction::Methods* trx,
+                          VPackFunctionParameters const& parameters) {
+  ValidateParameters(parameters, "RIGHT", 2, 2);
+
+  AqlValue value = ExtractFunctionParameterValue(trx, parameters, 0);
+  icu::UnicodeString const s = ValueToUnicodeString(trx, value);
+  int64_t const length =
+      ExtractFunctionParameterValue(trx, parameters, 1).toInt64(trx);
+  int64_t const offset = (std::max)(
+      static_cast<int64_t>(s.length()) - length, static_cast<int64_t>(0));
+
+  return SubstringValue(s, offset, length);
+}
+
+/// @brief function TRIM
+AqlValue Functions::Trim(arangodb::aql::Query* query,
+                         transaction::Methods* trx,
+                         VPackFunctionParameters const& parameters) {
+  ValidateParameters(parameters, "TRIM", 1, 2);
+
+  AqlValue value = ExtractFunctionParameterValue(trx, parameters, 0);
+  icu::UnicodeString const s = ValueToUnicodeString(trx, value);
+
+  if (parameters.size() > 1) {
+    AqlValue p = ExtractFunctionParameterValue(trx, parameters, 1);
+
+    if (p.isString()) {
+      // characters to remove from both ends
+      icu::UnicodeString const chars = ValueToUnicodeString(trx, p);
+      return TrimValue(s, &chars, true, true);
+    }
+
+    // trim type: 0 = both ends, 1 = start only, 2 = end only
+    int64_t const type = p.toInt64(trx);
+    if (type == 1) {
+      return TrimValue(s, nullptr, true, false);
+    }
+    if (type == 2) {
+      return TrimValue(s, nullptr, false, true);
+    }
+  }
+
+  return TrimValue(s, nullptr, true, true);
+}
+
+/// @brief function LTRIM
+AqlValue Functions::LTrim(arangodb::aql::Query* query,
+                          transaction::Methods* trx,
+                          VPackFunctionParameters const& parameters) {
+  return TrimFunction(trx, parameters, "LTRIM", true, false);
+}
+
+/// @brief function RTRIM
+AqlValue Functions::RTrim(arangodb::aql::Query* query,
+                          transaction::Methods* trx,
+                          VPackFunctionParameters const& parameters) {
+  return TrimFunction(trx, parameters, "RTRIM", false, true);
+}
+
+/// @brief function FIND_FIRST
+AqlValue Functions::FindFirst(arangodb::aql::Query* query,
+                              transaction::Methods* trx,
+                              VPackFunctionParameters const& parameters) {
+  ValidateParameters(parameters, "FIND_FIRST", 2, 4);
+
+  icu::UnicodeString const value = ValueToUnicodeString(
+      trx, ExtractFunctionParameterValue(trx, parameters, 0));
+  icu::UnicodeString const search = ValueToUnicodeString(
+      trx, ExtractFunctionParameterValue(trx, parameters, 1));
+
+  int32_t start, end;
+  if (!FindRange(trx, parameters, value.length(), start, end)) {
+    return NumberValue(trx, -1);
+  }
+
+  if (search.isEmpty()) {
+    return NumberValue(trx, start);
+  }
+
+  return NumberValue(trx, value.indexOf(search, start, end - start));
+}
+
+/// @brief function FIND_LAST
+AqlValue Functions::FindLast(arangodb::aql::Query* query,
+                             transaction::Methods* trx,
+                             VPackFunctionParameters const& parameters) {
+  ValidateParameters(parameters, "FIND_LAST", 2, 4);
+
+  icu::UnicodeString const value = ValueToUnicodeString(
+      trx, ExtractFunctionParameterValue(trx, parameters, 0));
+  icu::UnicodeString const search = ValueToUnicodeString(
+      trx, ExtractFunctionParameterValue(trx, parameters, 1));
+
+  int32_t start, end;
+  if (!FindRange(trx, parameters, value.length(), start, end)) {
+    return NumberValue(trx, -1);
+  }
+
+  if (search.isEmpty()) {
+    return NumberValue(trx, end);
+  }
+
+  return NumberValue(trx, value.lastIndexOf(search, start, end - start));
+}
+
+/// @brief function SPLIT
+AqlValue Functions::Split(arangodb::aql::Query* query,
+                          transaction::Methods* trx,
+                          VPackFunctionParameters const& parameters) {
+  ValidateParameters(parameters, "SPLIT", 1, 3);
+
+  AqlValue value = ExtractFunctionParameterValue(trx, parameters, 0);
+  icu::UnicodeString const s = ValueToUnicodeString(trx, value);
+
+  // a negative limit means no limit
+  int64_t limit = -1;
+  if (parameters.size() > 2) {
+    AqlValue l = ExtractFunctionParameterValue(trx, parameters, 2);
+    if (!l.isNull(false)) {
+      limit = (std::max)(l.toInt64(trx), static_cast<int64_t>(-1));
+    }
+  }
+
+  // separators are tried in order at each position
+  std::vector<icu::UnicodeString> separators;
+  if (parameters.size() > 1) {
+    AqlValue separator = ExtractFunctionParameterValue(trx, parameters, 1);
+
+    if (separator.isArray()) {
+      AqlValueMaterializer materializer(trx);
+      VPackSlice slice = materializer.slice(separator, false);
+      for (auto const& it : VPackArrayIterator(slice)) {
+        separators.emplace_back(SliceToUnicodeString(trx, it));
+      }
+    } else if (!separator.isNull(false)) {
+      separators.emplace_back(ValueToUnicodeString(trx, separator));
+    }
+  }
+
+  transaction::BuilderLeaser builder(trx);
+  builder->openArray();
+
+  int64_t count = 0;
+  auto add = [&](int32_t from, int32_t to) -> bool {
+    if (limit >= 0 && count >= limit) {
+      return false;
+    }
+    std::string part;
+    s.tempSubString(from, to - from).toUTF8String(part);
+    builder->add(VPackValue(part));
+    ++count;
+    return true;
+  };
+
+  int32_t const n = s.length();
+
+  if (separators.empty()) {
+    add(0, n);
+  } else if (n == 0) {
+    // splitting an empty string returns an empty string, unless it is
+    // split into characters
+    bool hasEmpty = false;
+    for (auto const& it : separators) {
+      hasEmpty |= it.isEmpty();
+    }
+    if (!hasEmpty) {
+      add(0, 0);
+    }
+  } else {
+    // start of the current part, and current search position
+    int32_t p = 0;
+    int32_t q = 0;
+
+    while (q < n) {
+      int32_t matchLength = -1;
+      for (auto const& it : separators) {
+        if (it.length() <= n - q && s.compare(q, it.length(), it) == 0) {
+          matchLength = it.length();
+          break;
+        }
+      }
+
+      if (matchLength < 0 || q + matchLength == p) {
+        // no match, or an empty match at the start of the part
+        ++q;
+        continue;
+      }
+
+      if (!add(p, q)) {
+        break;
+      }
+      p = q + matchLength;
+      q = p;
+    }
+
+    add(p, n);
+  }
+
+  builder->close();
+  return AqlValue(builder.get());
+}
+
+/// @brief function SUBSTITUTE
+AqlValue Functions::Substitute(arangodb::aql::Query* query,
+                               transaction::Methods* trx,
+                               VPackFunctionParameters const& parameters) {
+  ValidateParameters(parameters, "SUBSTITUTE", 2, 4);
+
+  AqlValue value = ExtractFunctionParameterValue(trx, parameters, 0);
+  icu::UnicodeString const s = ValueToUnicodeString(trx, value);
+
+  // search strings with their replacements, tried in order at each
+  // position. empty search strings are ignored
+  std::vector<std::pair<icu::UnicodeString, icu::UnicodeString>> patterns;
+  auto addPattern = [&patterns](icu::UnicodeString const& search,
+                                icu::UnicodeString const& replace) {
+    if (search.isEmpty()) {
+      return;
+    }
+    for (auto& it : patterns) {
+      if (it.first == search) {
+        // the last replacement for a search string wins
+        it.second = replace;
+        return;
+      }
+    }
+    patterns.emplace_back(search, replace);
+  };
+
+  AqlValue search = ExtractFunctionParameterValue(trx, parameters, 1);
+  size_t limitPosition = 3;
+
+  if (search.isObject()) {
+    // search strings map to their replacements
+    AqlValueMaterializer materializer(trx);
+    VPackSlice slice = materializer.slice(search, false);
+    for (auto const& it : VPackObjectIterator(slice, true)) {
+      addPattern(SliceToUnicodeString(trx, it.key),
+                 SliceToUnicodeString(trx, it.value));
+    }
+    limitPosition = 2;
+  } else {
+    AqlValue replace;
+    if (parameters.size() > 2) {
+      replace = ExtractFunctionParameterValue(trx, parameters, 2);
+    }
+
+    AqlValueMaterializer replaceMaterializer(trx);
+    VPackSlice replaceSlice = replaceMaterializer.slice(replace, false);
+    icu::UnicodeString replaceString;
+    if (!replaceSlice.isArray() && !replaceSlice.isNone()) {
+      replaceString = SliceToUnicodeString(trx, replaceSlice);
+    }
+
+    auto replacement = [&](size_t i) -> icu::UnicodeString {
+      if (replaceSlice.isArray()) {
+        if (i < replaceSlice.length()) {
+          return SliceToUnicodeString(trx, replaceSlice.at(i));
+        }
+        return icu::UnicodeString();
+      }
+      return replaceString;
+    };
+
+    if (search.isArray()) {
+      AqlValueMaterializer materializer(trx);
+      VPackSlice slice = materializer.slice(search, false);
+      size_t i = 0;
+      for (auto const& it : VPackArrayIterator(slice)) {
+        addPattern(SliceToUnicodeString(trx, it), replacement(i++));
+      }
+    } else {
+      addPattern(ValueToUnicodeString(trx, search), replacement(0));
+    }
+  }
+
+  // a negative limit means no limit
+  int64_t limit = -1;
+  if (parameters.size() > limitPosition) {
+    AqlValue l = ExtractFunctionParameterValue(trx, parameters, limitPosition);
+    if (!l.isNull(false)) {
+      limit = l.toInt64(trx);
+    }
+  }
+
+  if (patterns.empty() || limit == 0) {
+    return UnicodeStringValue(s);
+  }
+
+  icu::UnicodeString result;
+  int32_t const n = s.length();
+  int32_t pos = 0;
+  int64_t count = 0;
+
+  while (pos < n) {
+    if (limit >= 0 && count >= limit) {
+      // copy the remainder as is
+      result.append(s, pos, n - pos);
+      break;
+    }
+
+    bool matched = false;
+    for (auto const& it : patterns) {
+      int32_t const length = it.first.length();
+      if (length <= n - pos && s.compare(pos, length, it.first) == 0) {
+        result.append(it.second);
+        pos += length;
+        ++count;
+        matched = true;
+        break;
+      }
+    }
+
+    if (!matched) {
+      result.append(s.charAt(pos));
+      ++pos;
+    }
+  }
+
+  return UnicodeStringValue(result);
+}
+
+/// @brief function REVERSE
+AqlValue Functions::Reverse(arangodb::aql::Query* query,
+                            transaction::Methods* trx,
+                            VPackFunctionParameters const& parameters) {
+  ValidateParameters(parameters, "REVERSE", 1, 1);
+
+  AqlValue value = ExtractFunctionParameterValue(trx, parameters, 0);
+
+  if (value.isArray()) {
+    AqlValueMaterializer materializer(trx);
+    VPackSlice slice = materializer.slice(value, false);
+
+    std::vector<VPackSlice> members;
+    members.reserve(static_cast<size_t>(slice.length()));
+    for (auto const& it : VPackArrayIterator(slice)) {
+      members.emplace_back(it);
+    }
+
+    transaction::BuilderLeaser builder(trx);
+    builder->openArray();
+    for (auto it = members.rbegin(); it != members.rend(); ++it) {
+      builder->add(*it);
+    }
+    builder->close();
+    return AqlValue(builder.get());
+  }
+
+  // surrogate pairs are kept intact
+  icu::UnicodeString s = ValueToUnicodeString(trx, value);
+  return UnicodeStringValue(s.reverse());
+}
+
+/// @brief function MATCHES
+AqlValue Functions::Matches(arangodb::aql::Query* query,
+                            transaction::Methods* trx,
+                            VPackFunctionParameters const& parameters) {
+  ValidateParameters(parameters, "MATCHES", 2, 3);
+
+  AqlValue document = ExtractFunctionParameterValue(trx, parameters, 0);
+  AqlValue examples = ExtractFunctionParameterValue(trx, parameters, 1);
+
+  bool returnIndex = false;
+  if (parameters.size() > 2) {
+    returnIndex =
+        ExtractFunctionParameterValue(trx, parameters, 2).toBoolean();
+  }
+
+  AqlValueMaterializer docMaterializer(trx);
+  VPackSlice docSlice = docMaterializer.slice(document, false);
+
+  AqlValueMaterializer materializer(trx);
+  VPackSlice examplesSlice = materializer.slice(examples, false);
+
+  // a single example is treated as a list containing only this example
+  VPackBuilder wrapped;
+  if (!examplesSlice.isArray()) {
+    wrapped.openArray();
+    wrapped.add(examplesSlice);
+    wrapped.close();
+    examplesSlice = wrapped.slice();
+  }
+
+  if (examplesSlice.length() == 0) {
+    RegisterInvalidArgumentWarning(query, "MATCHES");
+    return AqlValue(false);
+  }
+
+  auto options = trx->transactionContextPtr()->getVPackOptions();
+  int index = 0;
+
+  for (auto const& example : VPackArrayIterator(examplesSlice)) {
+    if (!example.isObject()) {
+      RegisterInvalidArgumentWarning(query, "MATCHES");
+      return AqlValue(false);
+    }
+
+    bool matches = true;
+    for (auto const& it : VPackObjectIterator(example, true)) {
+      VPackSlice v;
+      if (docSlice.isObject()) {
+        v = docSlice.get(it.key.copyString());
+      }
+      if (v.isNone()) {
+        // a non-existing attribute is equal to null
+        v = arangodb::basics::VelocyPackHelper::NullValue();
+      }
+      if (arangodb::basics::VelocyPackHelper::compare(v, it.value, false,
+                                                      options) != 0) {
+        matches = false;
+        break;
+      }
+    }
+
+    if (matches) {
+      if (returnIndex) {
+        return NumberValue(trx, index);
+      }
+      return AqlValue(true);
+    }
+    ++index;
+  }
+
+  if (returnIndex) {
+    return NumberValue(trx, -1);
+  }
+  return AqlValue(false);
+}
+
+/// @brief function TRANSLATE
+AqlValue Functions::Translate(arangodb::aql::Query* query,
+                              transaction::Methods* trx,
+                              VPackFunctionParameters const& parameters) {
+  ValidateParameters(parameters, "TRANSLATE", 2, 3);
+
+  AqlValue key = ExtractFunctionParameterValue(trx, parameters, 0);
+  AqlValue lookup = ExtractFunctionParameterValue(trx, parameters, 1);
+
+  if (!lookup.isObject()) {
+    RegisterInvalidArgumentWarning(query, "TRANSLATE");
+    return AqlValue(arangodb::basics::VelocyPackHelper::NullValue());
+  }
+
+  transaction::StringBufferLeaser buffer(trx);
+  arangodb::basics::VPackStringBufferAdapter adapter(buffer->stringBuffer());
+  AppendAsString(trx, adapter, key);
+
+  AqlValueMaterializer materializer(trx);
+  VPackSlice slice = materializer.slice(lookup, false);
+  VPackSlice result =
+      slice.get(std::string(buffer->c_str(), buffer->length()));
+
+  if (!result.isNone()) {
+    return AqlValue(result);
+  }
+
+  if (parameters.size() > 2) {
+    return ExtractFunctionParameterValue(trx, parameters, 2).clone();
+  }
+  return key.clone();
+}
+
+/// @brief function FAIL
+AqlValue Functions::Fail(arangodb::aql::Query* query,
+                         transaction::Methods* trx,
+                         VPackFunctionParameters const& parameters) {
+  ValidateParameters(parameters, "FAIL", 0, 1);
+
+  std::string message;
+  if (parameters.size() > 0) {
+    transaction::StringBufferLeaser buffer(trx);
+    arangodb::basics::VPackStringBufferAdapter adapter(buffer->stringBuffer());
+    AppendAsString(trx, adapter,
+                   ExtractFunctionParameterValue(trx, parameters, 0));
+    message.assign(buffer->c_str(), buffer->length());
+  }
+
+  THROW_ARANGO_EXCEPTION_PARAMS(TRI_ERROR_QUERY_FAIL_CALLED, message.c_str());
+}
+
+/// @brief function SLEEP
+AqlValue Functions::Sleep(arangodb::aql::Query* query,
+                          transaction::Methods* trx,
+                          VPackFunctionParameters const& parameters) {
+  ValidateParameters(parameters, "SLEEP", 1, 1);
+
+  AqlValue value = ExtractFunctionParameterValue(trx, parameters, 0);
+
+  if (!value.isNumber() || value.toDouble(trx) < 0.0) {
+    RegisterInvalidArgumentWarning(query, "SLEEP");
+    return AqlValue(arangodb::basics::VelocyPackHelper::NullValue());
+  }
+
+  // sleep in small steps so we can react to the query being killed
+  double const until = TRI_microtime() + value.toDouble(trx);
+
+  while (true) {
+    if (query->killed()) {
+      THROW_ARANGO_EXCEPTION(TRI_ERROR_QUERY_KILLED);
+    }
+
+    double const now = TRI_microtime();
+    if (now >= until) {
+      break;
+    }
+
+    std::this_thread::sleep_for(std::chrono::microseconds(
+        static_cast<int64_t>((std::min)(until - now, 0.01) * 1000000.0)));
+  }
+
+  return AqlValue(arangodb::basics::VelocyPackHelper::NullValue());
+}
+
+/// @brief function DATE_NOW
+AqlValue Functions::DateNow(arangodb::aql::Query* query,
+                            transaction::Methods* trx,
+                            VPackFunctionParameters const& parameters) {
+  ValidateParameters(parameters, "DATE_NOW", 0, 0);
+
+  return AqlValue(static_cast<int64_t>(TRI_microtime() * 1000.0));
+}
+
+/// @brief function DATE_TIMESTAMP
+AqlValue Functions::DateTimestamp(arangodb::aql::Query* query,
+                                  transaction::Methods* trx,
+                                  VPackFunctionParameters const& parameters) {
+  ValidateParameters(parameters, "DATE_TIMESTAMP", 1, 7);
+
+  int64_t timestamp;
+  if (!ExtractTimestamp(query, trx, parameters, "DATE_TIMESTAMP", timestamp)) {
+    return AqlValue(arangodb::basics::VelocyPackHelper::NullValue());
+  }
+
+  return AqlValue(timestamp);
+}
+
+/// @brief function DATE_ISO8601
+AqlValue Functions::DateIso8601(arangodb::aql::Query* query,
+                                transaction::Methods* trx,
+                                VPackFunctionParameters const& parameters) {
+  ValidateParameters(parameters, "DATE_ISO8601", 1, 7);
+
+  int64_t timestamp;
+  if (!ExtractTimestamp(query, trx, parameters, "DATE_ISO8601", timestamp)) {
+    return AqlValue(arangodb::basics::VelocyPackHelper::NullValue());
+  }
+
+  DateParts const parts = SplitTimestamp(timestamp);
+
+  // years outside of 0 - 9999 use the extended six-digit format
+  char const* format = (parts.year >= 0 && parts.year <= 9999)
+                           ? "%04d-%02d-%02dT%02d:%02d:%02d.%03dZ"
+                           : "%+07d-%02d-%02dT%02d:%02d:%02d.%03dZ";
+
+  char buffer[40];
+  int length =
+      snprintf(buffer, sizeof(buffer), format, static_cast<int>(parts.year),
+               static_cast<int>(parts.month), static_cast<int>(parts.day),
+               static_cast<int>(parts.hour), static_cast<int>(parts.minute),
+               static_cast<int>(parts.second),
+               static_cast<int>(parts.millisecond));
+
+  return AqlValue(&buffer[0], static_cast<size_t>(length));
+}
+
+/// @brief function DATE_DAYOFWEEK
+AqlValue Functions::DateDayOfWeek(arangodb::aql::Query* query,
+                                  transaction::Methods* trx,
+                                  VPackFunctionParameters const& parameters) {
+  return DateComponent(query, trx, parameters, "DATE_DAYOFWEEK",
+                       [](DateParts const& parts) { return parts.weekday; });
+}
+
+/// @brief function DATE_YEAR
+AqlValue Functions::DateYear(arangodb::aql::Query* query,
+                             transaction::Methods* trx,
+                             VPackFunctionParameters const& parameters) {
+  return DateComponent(query, trx, parameters, "DATE_YEAR",
+                       [](DateParts const& parts) { return parts.year; });
+}
+
+/// @brief function DATE_MONTH
+AqlValue Functions::DateMonth(arangodb::aql::Query* query,
+                              transaction::Methods* trx,
+                              VPackFunctionParameters const& parameters) {
+  return DateComponent(query, trx, parameters, "DATE_MONTH",
+                       [](DateParts const& parts) { return parts.month; });
+}
+
+/// @brief function DATE_DAY
+AqlValue Functions::DateDay(arangodb::aql::Query* query,
+                            transaction::Methods* trx,
+                            VPackFunctionParameters const& parameters) {
+  return DateComponent(query, trx, parameters, "DATE_DAY",
+                       [](DateParts const& parts) { return parts.day; });
+}
+
+/// @brief function DATE_HOUR
+AqlValue Functions::DateHour(arangodb::aql::Query* query,
+                             transaction::Methods* trx,
+                             VPackFunctionParameters const& parameters) {
+  return DateComponent(query, trx, parameters, "DATE_HOUR",
+                       [](DateParts const& parts) { return parts.hour; });
+}
+
+/// @brief function DATE_MINUTE
+AqlValue Functions::DateMinute(arangodb::aql::Query* query,
+                               transaction::Methods* trx,
+                               VPackFunctionParameters const& parameters) {
+  return DateComponent(query, trx, parameters, "DATE_MINUTE",
+                       [](DateParts const& parts) { return parts.minute; });
+}
+
+/// @brief function DATE_SECOND
+AqlValue Functions::DateSecond(arangodb::aql::Query* query,
+                               transaction::Methods* trx,
+                               VPackFunctionParameters const& parameters) {
+  return DateComponent(query, trx, parameters, "DATE_SECOND",
+                       [](DateParts const& parts) { return parts.second; });
+}
+
+/// @brief function DATE_MILLISECOND
+AqlValue Functions::DateMillisecond(arangodb::aql::Query* query,
+                                    transaction::Methods* trx,
+                                    VPackFunctionParameters const& parameters) {
+  return DateComponent(
+      query, trx, parameters, "DATE_MILLISECOND",
+      [](DateParts const& parts) { return parts.millisecond; });
+}
+
+/// @brief function DATE_DAYOFYEAR
+AqlValue Functions::DateDayOfYear(arangodb::aql::Query* query,
+                                  transaction::Methods* trx,
+                                  VPackFunctionParameters const& parameters) {
+  return DateComponent(query, trx, parameters, "DATE_DAYOFYEAR",
+                       [](DateParts const& parts) {
+                         return parts.days - DaysFromCivil(parts.year, 1, 1) +
+                                1;
+                       });
+}
+
+/// @brief function DATE_ISOWEEK
+AqlValue Functions::DateIsoWeek(arangodb::aql::Query* query,
+                                transaction::Methods* trx,
+                                VPackFunctionParameters const& parameters) {
+  return DateComponent(
+      query, trx, parameters, "DATE_ISOWEEK", [](DateParts const& parts) {
+        // the ISO week is the week of the thursday of the same week
+        int64_t const weekday = (parts.weekday == 0) ? 7 : parts.weekday;
+        int64_t const thursday = parts.days + 4 - weekday;
+        int64_t year, month, day;
+        CivilFromDays(thursday, year, month, day);
+        return (thursday - DaysFromCivil(year, 1, 1)) / 7 + 1;
+      });
+}
+
+/// @brief function DATE_LEAPYEAR
+AqlValue Functions::DateLeapYear(arangodb::aql::Query* query,
+                                 transaction::Methods* trx,
+                                 VPackFunctionParameters const& parameters) {
+  ValidateParameters(parameters, "DATE_LEAPYEAR", 1, 1);
+
+  int64_t timestamp;
+  if (!ExtractTimestamp(query, trx, parameters, "DATE_LEAPYEAR", timestamp)) {
+    return AqlValue(arangodb::basics::VelocyPackHelper::NullValue());
+  }
+
+  return AqlValue(IsLeapYear(SplitTimestamp(timestamp).year));
+}
+
+/// @brief function DATE_QUARTER
+AqlValue Functions::DateQuarter(arangodb::aql::Query* query,
+                                transaction::Methods* trx,
+                                VPackFunctionParameters const& parameters) {
+  return DateComponent(
+      query, trx, parameters, "DATE_QUARTER",
+      [](DateParts const& parts) { return (parts.month - 1) / 3 + 1; });
+}
+
+/// @brief function DATE_DAYS_IN_MONTH
+AqlValue Functions::DateDaysInMonth(arangodb::aql::Query* query,
+                                    transaction::Methods* trx,
+                                    VPackFunctionParameters const& parameters) {
+  return DateComponent(query, trx, parameters, "DATE_DAYS_IN_MONTH",
+                       [](DateParts const& parts) {
+                         return DaysInMonth(parts.year, parts.month);
+                       });
+}
+
 #include "Pregel/PregelFeature.h"
 #include "Pregel/Worker.h"
 
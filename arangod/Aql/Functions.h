@@ -302,6 +302,103 @@ struct Functions {
    static AqlValue IsSameCollection(arangodb::aql::Query*,
                                     transaction::Methods*,
                                     VPackFunctionParameters const&);
+   static AqlValue IsDateString(arangodb::aql::Query*, transaction::Methods*,
+                                VPackFunctionParameters const&);
+   static AqlValue CharLength(arangodb::aql::Query*, transaction::Methods*,
+                              VPackFunctionParameters const&);
+   static AqlValue Lower(arangodb::aql::Query*, transaction::Methods*,
+                         VPackFunctionParameters const&);
+   static AqlValue Upper(arangodb::aql::Query*, transaction::Methods*,
+                         VPackFunctionParameters const&);
+   static AqlValue Substring(arangodb::aql::Query*, transaction::Methods*,
+                             VPackFunctionParameters const&);
+   static AqlValue Left(arangodb::aql::Query*, transaction::Methods*,
+                        VPackFunctionParameters const&);
+   static AqlValue Right(arangodb::aql::Query*, transaction::Methods*,
+                         VPackFunctionParameters const&);
+   static AqlValue Trim(arangodb::aql::Query*, transaction::Methods*,
+                        VPackFunctionParameters const&);
+   static AqlValue LTrim(arangodb::aql::Query*, transaction::Methods*,
+                         VPackFunctionParameters const&);
+   static AqlValue RTrim(arangodb::aql::Query*, transaction::Methods*,
+                         VPackFunctionParameters const&);
+   static AqlValue FindFirst(arangodb::aql::Query*, transaction::Methods*,
+                             VPackFunctionParameters const&);
+   static AqlValue FindLast(arangodb::aql::Query*, transaction::Methods*,
+                            VPackFunctionParameters const&);
+   static AqlValue Split(arangodb::aql::Query*, transaction::Methods*,
+                         VPackFunctionParameters const&);
+   static AqlValue Substitute(arangodb::aql::Query*, transaction::Methods*,
+                              VPackFunctionParameters const&);
+   static AqlValue Reverse(arangodb::aql::Query*, transaction::Methods*,
+                           VPackFunctionParameters const&);
+   static AqlValue Matches(arangodb::aql::Query*, transaction::Methods*,
+                           VPackFunctionParameters const&);
+   static AqlValue Translate(arangodb::aql::Query*, transaction::Methods*,
+                             VPackFunctionParameters const&);
+   static AqlValue Fail(arangodb::aql::Query*, transaction::Methods*,
+                        VPackFunctionParameters const&);
+   static AqlValue Sleep(arangodb::aql::Query*, transaction::Methods*,
+                         VPackFunctionParameters const&);
+   static AqlValue DateNow(arangodb::aql::Query*, transaction::Methods*,
+                           VPackFunctionParameters const&);
+   static AqlValue DateTimestamp(arangodb::aql::Query*, transaction::Methods*,
+                                 VPackFunctionParameters const&);
+   static AqlValue DateIso8601(arangodb::aql::Query*, transaction::Methods*,
+                               VPackFunctionParameters const&);
+   static AqlValue DateDayOfWeek(arangodb::aql::Query*, transaction::Methods*,
+                                 VPackFunctionParameters const&);
+   static AqlValue DateYear(arangodb::aql::Query*, transaction::Methods*,
+                            VPackFunctionParameters const&);
+   static AqlValue DateMonth(arangodb::aql::Query*, transaction::Methods*,
+                             VPackFunctionParameters const&);
+   static AqlValue DateDay(arangodb::aql::Query*, transaction::Methods*,
+                           VPackFunctionParameters const&);
+   static AqlValue DateHour(arangodb::aql::Query*, transaction::Methods*,
+                            VPackFunctionParameters const&);
+   static AqlValue DateMinute(arangodb::aql::Query*, transaction::Methods*,
+                              VPackFunctionParameters const&);
+   static AqlValue DateSecond(arangodb::aql::Query*, transaction::Methods*,
+                              VPackFunctionParameters const&);
+   static AqlValue DateMillisecond(arangodb::aql::Query*, transaction::Methods*,
+                                   VPackFunctionParameters const&);
+   static AqlValue DateDayOfYear(arangodb::aql::Query*, transaction::Methods*,
+                                 VPackFunctionParameters const&);
+   static AqlValue DateIsoWeek(arangodb::aql::Query*, transaction::Methods*,
+                               VPackFunctionParameters const&);
+   static AqlValue DateLeapYear(arangodb::aql::Query*, transaction::Methods*,
+                                VPackFunctionParameters const&);
+   static AqlValue DateQuarter(arangodb::aql::Query*, transaction::Methods*,
+                               VPackFunctionParameters const&);
+   static AqlValue DateDaysInMonth(arangodb::aql::Query*, transaction::Methods*,
+                                   VPackFunctionParameters const&);
+
+  private:
+   /// @brief shared implementation of LTRIM and RTRIM
+   static AqlValue TrimFunction(transaction::Methods* trx,
+                                VPackFunctionParameters const& parameters,
+                                char const* functionName, bool left,
+                                bool right);
+
+   /// @brief extract the optional start and end offsets of FIND_FIRST and
+   /// FIND_LAST
+   static bool FindRange(transaction::Methods* trx,
+                         VPackFunctionParameters const& parameters,
+                         int32_t size, int32_t& start, int32_t& end);
+
+   /// @brief extract a timestamp from the parameters of a date function
+   static bool ExtractTimestamp(arangodb::aql::Query* query,
+                                transaction::Methods* trx,
+                                VPackFunctionParameters const& parameters,
+                                char const* functionName, int64_t& result);
+
+   /// @brief shared implementation of the functions returning a component
+   /// of a date. extract is called with the parts of the date
+   template <typename F>
+   static AqlValue DateComponent(arangodb::aql::Query* query,
+                                 transaction::Methods* trx,
+                                 VPackFunctionParameters const& parameters,
+                                 char const* functionName, F const& extract);
 };
 }
 }
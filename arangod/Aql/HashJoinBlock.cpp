@@ -0,0 +1,258 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "HashJoinBlock.h"
+
+#include "Aql/AqlItemBlock.h"
+#include "Aql/AqlValue.h"
+#include "Aql/ExecutionEngine.h"
+#include "Aql/Query.h"
+#include "Basics/Exceptions.h"
+
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+HashJoinBlock::HashJoinBlock(ExecutionEngine* engine, HashJoinNode const* ep)
+    : ExecutionBlock(engine, ep),
+      _probeRegister(ExecutionNode::MaxRegisterId),
+      _table(_trx, engine->getQuery()->resourceMonitor(), ep->_collection,
+             ep->_attribute),
+      _matches(nullptr),
+      _posInMatches(0) {
+  auto it = ep->getRegisterPlan()->varInfo.find(ep->_probeVariable->id);
+
+  if (it == ep->getRegisterPlan()->varInfo.end()) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL, "variable not found");
+  }
+
+  _probeRegister = (*it).second.registerId;
+  TRI_ASSERT(_probeRegister < ExecutionNode::MaxRegisterId);
+}
+
+HashJoinBlock::~HashJoinBlock() {}
+
+int HashJoinBlock::initializeCursor(AqlItemBlock* items, size_t pos) {
+  DEBUG_BEGIN_BLOCK();
+  int res = ExecutionBlock::initializeCursor(items, pos);
+
+  if (res != TRI_ERROR_NO_ERROR) {
+    return res;
+  }
+
+  // the hash table only depends on the collection, so it is kept
+  _matches = nullptr;
+  _posInMatches = 0;
+
+  return TRI_ERROR_NO_ERROR;
+
+  // cppcheck-suppress style
+  DEBUG_END_BLOCK();
+}
+
+/// @brief build the hash table from all documents of the collection
+void HashJoinBlock::buildTable() {
+  if (_table.isBuilt()) {
+    return;
+  }
+
+  size_t scanned = _table.build([this]() { throwIfKilled(); });
+  _engine->_stats.scannedFull += static_cast<int64_t>(scanned);
+}
+
+/// @brief advance to the next input row
+void HashJoinBlock::nextRow() {
+  TRI_ASSERT(!_buffer.empty());
+
+  _matches = nullptr;
+  _posInMatches = 0;
+
+  AqlItemBlock* cur = _buffer.front();
+
+  if (++_pos >= cur->size()) {
+    _buffer.pop_front();  // does not throw
+    returnBlock(cur);
+    _pos = 0;
+  }
+}
+
+/// @brief look up the documents matching the current input row.
+/// returns false if the input is exhausted
+bool HashJoinBlock::nextMatches(size_t atMost) {
+  DEBUG_BEGIN_BLOCK();
+  TRI_ASSERT(_matches == nullptr);
+
+  while (true) {
+    if (_buffer.empty()) {
+      size_t toFetch = (std::min)(batchSize(), atMost);
+      if (!ExecutionBlock::getBlock(toFetch, toFetch)) {
+        _done = true;
+        return false;
+      }
+      _pos = 0;  // this is in the first block
+    }
+
+    AqlItemBlock* cur = _buffer.front();
+    AqlValue const& probe = cur->getValueReference(_pos, _probeRegister);
+
+    AqlValueMaterializer materializer(_trx);
+    VPackSlice value = materializer.slice(probe, false);
+
+    _matches = _table.find(value);
+
+    if (_matches != nullptr) {
+      _posInMatches = 0;
+      return true;
+    }
+
+    // no matching documents for this row
+    nextRow();
+  }
+
+  // cppcheck-suppress style
+  DEBUG_END_BLOCK();
+}
+
+/// @brief getSome
+AqlItemBlock* HashJoinBlock::getSome(size_t,  // atLeast,
+                                     size_t atMost) {
+  DEBUG_BEGIN_BLOCK();
+  traceGetSomeBegin();
+
+  if (_done) {
+    traceGetSomeEnd(nullptr);
+    return nullptr;
+  }
+
+  buildTable();
+
+  std::unique_ptr<AqlItemBlock> res;
+  RegisterId curRegs = 0;
+  size_t send = 0;
+  // the row of res that holds the registers inherited from the current
+  // input row, if any
+  size_t inheritedRow = 0;
+  bool inherited = false;
+
+  while (send < atMost) {
+    if (_matches == nullptr) {
+      if (!nextMatches(atMost)) {
+        break;
+      }
+      inherited = false;
+    }
+
+    TRI_ASSERT(_matches != nullptr);
+    TRI_ASSERT(!_buffer.empty());
+
+    AqlItemBlock* cur = _buffer.front();
+
+    if (res == nullptr) {
+      curRegs = cur->getNrRegs();
+      RegisterId nrRegs =
+          getPlanNode()->getRegisterPlan()->nrRegs[getPlanNode()->getDepth()];
+      res.reset(requestBlock(atMost, nrRegs));
+      // automatically freed if we throw
+      TRI_ASSERT(curRegs <= res->getNrRegs());
+    }
+
+    throwIfKilled();  // check if we were aborted
+
+    size_t const n =
+        (std::min)(atMost - send, _matches->size() - _posInMatches);
+
+    for (size_t i = 0; i < n; ++i) {
+      // The result is in the first variable of this depth
+      res->setValue(send, curRegs,
+                    AqlValue((*_matches)[_posInMatches++],
+                             AqlValueFromManagedDocument()));
+
+      if (!inherited) {
+        inheritRegisters(cur, res.get(), _pos, send);
+        inheritedRow = send;
+        inherited = true;
+      } else {
+        // re-use already copied AqlValues
+        res->copyValuesFromRow(send, curRegs, inheritedRow);
+      }
+      ++send;
+    }
+
+    if (_posInMatches >= _matches->size()) {
+      nextRow();
+    }
+  }
+
+  if (send == 0) {
+    TRI_ASSERT(_done);
+    traceGetSomeEnd(nullptr);
+    return nullptr;
+  }
+
+  if (send < atMost) {
+    res->shrink(send, false);
+  }
+
+  // Clear out registers no longer needed later:
+  clearRegisters(res.get());
+
+  traceGetSomeEnd(res.get());
+
+  return res.release();
+
+  // cppcheck-suppress style
+  DEBUG_END_BLOCK();
+}
+
+/// @brief skipSome
+size_t HashJoinBlock::skipSome(size_t atLeast, size_t atMost) {
+  DEBUG_BEGIN_BLOCK();
+  traceSkipSomeBegin();
+  if (_done) {
+    return traceSkipSomeEnd(0);
+  }
+
+  buildTable();
+
+  size_t skipped = 0;
+
+  while (skipped < atLeast) {
+    if (_matches == nullptr && !nextMatches(atMost)) {
+      break;
+    }
+
+    size_t const n =
+        (std::min)(atMost - skipped, _matches->size() - _posInMatches);
+
+    _posInMatches += n;
+    skipped += n;
+
+    if (_posInMatches >= _matches->size()) {
+      nextRow();
+    }
+  }
+
+  return traceSkipSomeEnd(skipped);
+
+  // cppcheck-suppress style
+  DEBUG_END_BLOCK();
+}
@@ -0,0 +1,80 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_AQL_HASH_JOIN_BLOCK_H
+#define ARANGOD_AQL_HASH_JOIN_BLOCK_H 1
+
+#include "Aql/DocumentHashTable.h"
+#include "Aql/ExecutionBlock.h"
+#include "Aql/HashJoinNode.h"
+
+namespace arangodb {
+namespace aql {
+class AqlItemBlock;
+struct Collection;
+class ExecutionEngine;
+
+class HashJoinBlock final : public ExecutionBlock {
+ public:
+  HashJoinBlock(ExecutionEngine* engine, HashJoinNode const* ep);
+
+  ~HashJoinBlock();
+
+  /// @brief initializeCursor
+  int initializeCursor(AqlItemBlock* items, size_t pos) override;
+
+  /// @brief getSome
+  AqlItemBlock* getSome(size_t atLeast, size_t atMost) override final;
+
+  // skip between atLeast and atMost, returns the number actually skipped . . .
+  // will only return less than atLeast if there aren't atLeast many
+  // things to skip overall.
+  size_t skipSome(size_t atLeast, size_t atMost) override final;
+
+ private:
+  /// @brief build the hash table from all documents of the collection
+  void buildTable();
+
+  /// @brief look up the documents matching the current input row.
+  /// returns false if the input is exhausted
+  bool nextMatches(size_t atMost);
+
+  /// @brief advance to the next input row
+  void nextRow();
+
+ private:
+  /// @brief register of the probe variable
+  RegisterId _probeRegister;
+
+  /// @brief the hash table, mapping join attribute values to documents
+  DocumentHashTable _table;
+
+  /// @brief documents matching the current input row
+  std::vector<uint8_t const*> const* _matches;
+
+  /// @brief current position in _matches
+  size_t _posInMatches;
+};
+
+}  // namespace arangodb::aql
+}  // namespace arangodb
+
+#endif
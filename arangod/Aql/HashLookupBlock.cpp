@@ -0,0 +1,119 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "HashLookupBlock.h"
+
+#include "Aql/AqlItemBlock.h"
+#include "Aql/AqlValue.h"
+#include "Aql/ExecutionEngine.h"
+#include "Aql/Query.h"
+#include "Basics/Exceptions.h"
+
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+HashLookupBlock::HashLookupBlock(ExecutionEngine* engine,
+                                 HashLookupNode const* ep)
+    : ExecutionBlock(engine, ep),
+      _probeRegister(ExecutionNode::MaxRegisterId),
+      _outReg(ExecutionNode::MaxRegisterId),
+      _table(_trx, engine->getQuery()->resourceMonitor(), ep->_collection,
+             ep->_attribute) {
+  auto it = ep->getRegisterPlan()->varInfo.find(ep->_probeVariable->id);
+
+  if (it == ep->getRegisterPlan()->varInfo.end()) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL, "variable not found");
+  }
+
+  _probeRegister = (*it).second.registerId;
+  TRI_ASSERT(_probeRegister < ExecutionNode::MaxRegisterId);
+
+  it = ep->getRegisterPlan()->varInfo.find(ep->_outVariable->id);
+  TRI_ASSERT(it != ep->getRegisterPlan()->varInfo.end());
+  _outReg = (*it).second.registerId;
+  TRI_ASSERT(_outReg < ExecutionNode::MaxRegisterId);
+}
+
+HashLookupBlock::~HashLookupBlock() {}
+
+/// @brief build the hash table from all documents of the collection
+void HashLookupBlock::buildTable() {
+  if (_table.isBuilt()) {
+    return;
+  }
+
+  size_t scanned = _table.build([this]() { throwIfKilled(); });
+  _engine->_stats.scannedFull += static_cast<int64_t>(scanned);
+}
+
+/// @brief getSome
+AqlItemBlock* HashLookupBlock::getSome(size_t atLeast, size_t atMost) {
+  DEBUG_BEGIN_BLOCK();
+  traceGetSomeBegin();
+  std::unique_ptr<AqlItemBlock> res(
+      ExecutionBlock::getSomeWithoutRegisterClearout(atLeast, atMost));
+
+  if (res.get() == nullptr) {
+    traceGetSomeEnd(nullptr);
+    return nullptr;
+  }
+
+  buildTable();
+
+  size_t const n = res->size();
+
+  for (size_t i = 0; i < n; ++i) {
+    AqlValue const& probe = res->getValueReference(i, _probeRegister);
+
+    AqlValueMaterializer materializer(_trx);
+    VPackSlice value = materializer.slice(probe, false);
+
+    auto matches = _table.find(value);
+
+    // the documents are copied, so the result array does not depend on
+    // the lifetime of the hash table
+    _builder.clear();
+    _builder.openArray();
+    if (matches != nullptr) {
+      for (auto const& it : *matches) {
+        _builder.add(VPackSlice(it));
+      }
+    }
+    _builder.close();
+
+    AqlValue a(_builder);
+    AqlValueGuard guard(a, true);
+    res->setValue(i, _outReg, a);
+    guard.steal();
+
+    throwIfKilled();  // check if we were aborted
+  }
+
+  // Clear out registers no longer needed later:
+  clearRegisters(res.get());
+  traceGetSomeEnd(res.get());
+  return res.release();
+
+  // cppcheck-suppress style
+  DEBUG_END_BLOCK();
+}
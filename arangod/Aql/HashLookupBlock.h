@@ -0,0 +1,66 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_AQL_HASH_LOOKUP_BLOCK_H
+#define ARANGOD_AQL_HASH_LOOKUP_BLOCK_H 1
+
+#include "Aql/DocumentHashTable.h"
+#include "Aql/ExecutionBlock.h"
+#include "Aql/HashLookupNode.h"
+
+#include <velocypack/Builder.h>
+
+namespace arangodb {
+namespace aql {
+class AqlItemBlock;
+class ExecutionEngine;
+
+class HashLookupBlock final : public ExecutionBlock {
+ public:
+  HashLookupBlock(ExecutionEngine* engine, HashLookupNode const* ep);
+
+  ~HashLookupBlock();
+
+  /// @brief getSome
+  AqlItemBlock* getSome(size_t atLeast, size_t atMost) override final;
+
+ private:
+  /// @brief build the hash table from all documents of the collection
+  void buildTable();
+
+ private:
+  /// @brief register of the probe variable
+  RegisterId _probeRegister;
+
+  /// @brief output register
+  RegisterId _outReg;
+
+  /// @brief the hash table, mapping attribute values to documents
+  DocumentHashTable _table;
+
+  /// @brief builder for the arrays of matching documents
+  arangodb::velocypack::Builder _builder;
+};
+
+}  // namespace arangodb::aql
+}  // namespace arangodb
+
+#endif
@@ -0,0 +1,136 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "HashLookupNode.h"
+#include "Aql/Ast.h"
+#include "Aql/Collection.h"
+#include "Aql/ExecutionPlan.h"
+#include "Aql/Query.h"
+#include "Basics/Exceptions.h"
+
+#include <velocypack/Iterator.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+/// @brief constructor
+HashLookupNode::HashLookupNode(ExecutionPlan* plan, size_t id,
+                             TRI_vocbase_t* vocbase, Collection* collection,
+                             Variable const* outVariable,
+                             Variable const* probeVariable,
+                             std::vector<std::string> const& attribute)
+    : ExecutionNode(plan, id),
+      _vocbase(vocbase),
+      _collection(collection),
+      _outVariable(outVariable),
+      _probeVariable(probeVariable),
+      _attribute(attribute) {
+  TRI_ASSERT(_vocbase != nullptr);
+  TRI_ASSERT(_collection != nullptr);
+  TRI_ASSERT(_outVariable != nullptr);
+  TRI_ASSERT(_probeVariable != nullptr);
+  TRI_ASSERT(!_attribute.empty());
+}
+
+/// @brief constructor for HashLookupNode
+HashLookupNode::HashLookupNode(ExecutionPlan* plan,
+                             arangodb::velocypack::Slice const& base)
+    : ExecutionNode(plan, base),
+      _vocbase(plan->getAst()->query()->vocbase()),
+      _collection(plan->getAst()->query()->collections()->get(
+          base.get("collection").copyString())),
+      _outVariable(varFromVPack(plan->getAst(), base, "outVariable")),
+      _probeVariable(varFromVPack(plan->getAst(), base, "probeVariable")) {
+  VPackSlice attribute = base.get("attribute");
+
+  if (!attribute.isArray() || attribute.length() == 0) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(
+        TRI_ERROR_INTERNAL, "\"attribute\" attribute should be a non-empty array");
+  }
+
+  for (auto const& it : VPackArrayIterator(attribute)) {
+    _attribute.emplace_back(it.copyString());
+  }
+
+  TRI_ASSERT(_vocbase != nullptr);
+  TRI_ASSERT(_collection != nullptr);
+  TRI_ASSERT(_outVariable != nullptr);
+  TRI_ASSERT(_probeVariable != nullptr);
+}
+
+/// @brief toVelocyPack, for HashLookupNode
+void HashLookupNode::toVelocyPackHelper(VPackBuilder& nodes,
+                                        bool verbose) const {
+  ExecutionNode::toVelocyPackHelperGeneric(nodes,
+                                           verbose);  // call base class method
+
+  nodes.add("database", VPackValue(_vocbase->name()));
+  nodes.add("collection", VPackValue(_collection->getName()));
+  nodes.add("satellite", VPackValue(_collection->isSatellite()));
+  nodes.add(VPackValue("outVariable"));
+  _outVariable->toVelocyPack(nodes);
+  nodes.add(VPackValue("probeVariable"));
+  _probeVariable->toVelocyPack(nodes);
+
+  nodes.add(VPackValue("attribute"));
+  {
+    VPackArrayBuilder guard(&nodes);
+    for (auto const& it : _attribute) {
+      nodes.add(VPackValue(it));
+    }
+  }
+
+  // And close it:
+  nodes.close();
+}
+
+/// @brief clone ExecutionNode recursively
+ExecutionNode* HashLookupNode::clone(ExecutionPlan* plan, bool withDependencies,
+                                     bool withProperties) const {
+  auto outVariable = _outVariable;
+  auto probeVariable = _probeVariable;
+
+  if (withProperties) {
+    outVariable = plan->getAst()->variables()->createVariable(outVariable);
+    probeVariable = plan->getAst()->variables()->createVariable(probeVariable);
+    TRI_ASSERT(outVariable != nullptr);
+    TRI_ASSERT(probeVariable != nullptr);
+  }
+
+  auto c = new HashLookupNode(plan, _id, _vocbase, _collection, outVariable,
+                              probeVariable, _attribute);
+
+  cloneHelper(c, plan, withDependencies, withProperties);
+
+  return static_cast<ExecutionNode*>(c);
+}
+
+/// @brief the cost of a hash lookup node is the cost of building the
+/// hash table once plus the cost of probing it for each incoming item
+double HashLookupNode::estimateCost(size_t& nrItems) const {
+  size_t incoming;
+  double depCost = _dependencies.at(0)->getCost(incoming);
+  size_t count = _collection->count();
+  // every incoming item produces exactly one array of documents
+  nrItems = incoming;
+  return depCost + 1.5 * count + incoming + 1.0;
+}
@@ -0,0 +1,125 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_AQL_HASH_LOOKUP_NODE_H
+#define ARANGOD_AQL_HASH_LOOKUP_NODE_H 1
+
+#include "Basics/Common.h"
+#include "Aql/ExecutionNode.h"
+#include "Aql/types.h"
+#include "Aql/Variable.h"
+#include "VocBase/vocbase.h"
+
+#include <velocypack/Slice.h>
+
+namespace arangodb {
+namespace aql {
+struct Collection;
+class ExecutionBlock;
+class ExecutionPlan;
+class RedundantCalculationsReplacer;
+
+/// @brief class HashLookupNode
+/// a HashLookupNode replaces a correlated subquery of the form
+/// (FOR doc IN collection FILTER doc.attribute == probe RETURN doc). It
+/// builds a hash table over all documents of its collection, keyed on the
+/// attribute, and produces an array of the documents whose attribute value
+/// is equal to the value of the probe variable for each incoming row
+class HashLookupNode : public ExecutionNode {
+  friend class ExecutionBlock;
+  friend class HashLookupBlock;
+  friend class RedundantCalculationsReplacer;
+
+ public:
+  HashLookupNode(ExecutionPlan* plan, size_t id, TRI_vocbase_t* vocbase,
+                 Collection* collection, Variable const* outVariable,
+                 Variable const* probeVariable,
+                 std::vector<std::string> const& attribute);
+
+  HashLookupNode(ExecutionPlan*, arangodb::velocypack::Slice const& base);
+
+  /// @brief return the type of the node
+  NodeType getType() const override final { return HASH_LOOKUP; }
+
+  /// @brief export to VelocyPack
+  void toVelocyPackHelper(arangodb::velocypack::Builder&,
+                          bool) const override final;
+
+  /// @brief clone ExecutionNode recursively
+  ExecutionNode* clone(ExecutionPlan* plan, bool withDependencies,
+                       bool withProperties) const override final;
+
+  /// @brief the cost of a hash lookup node is the cost of building the
+  /// hash table once plus the cost of probing it for each incoming item
+  double estimateCost(size_t&) const override final;
+
+  /// @brief getVariablesUsedHere, returning a vector
+  std::vector<Variable const*> getVariablesUsedHere() const override final {
+    return std::vector<Variable const*>{_probeVariable};
+  }
+
+  /// @brief getVariablesUsedHere, modifying the set in-place
+  void getVariablesUsedHere(
+      std::unordered_set<Variable const*>& vars) const override final {
+    vars.emplace(_probeVariable);
+  }
+
+  /// @brief getVariablesSetHere
+  std::vector<Variable const*> getVariablesSetHere() const override final {
+    return std::vector<Variable const*>{_outVariable};
+  }
+
+  /// @brief return the database
+  TRI_vocbase_t* vocbase() const { return _vocbase; }
+
+  /// @brief return the collection
+  Collection const* collection() const { return _collection; }
+
+  /// @brief return the out variable
+  Variable const* outVariable() const { return _outVariable; }
+
+  /// @brief return the probe variable
+  Variable const* probeVariable() const { return _probeVariable; }
+
+  /// @brief return the attribute path the hash table is built on
+  std::vector<std::string> const& attribute() const { return _attribute; }
+
+ private:
+  /// @brief the database
+  TRI_vocbase_t* _vocbase;
+
+  /// @brief collection
+  Collection* _collection;
+
+  /// @brief output variable
+  Variable const* _outVariable;
+
+  /// @brief variable with the value to look up in the hash table
+  Variable const* _probeVariable;
+
+  /// @brief attribute path of the looked up attribute in the documents
+  std::vector<std::string> _attribute;
+};
+
+}  // namespace arangodb::aql
+}  // namespace arangodb
+
+#endif
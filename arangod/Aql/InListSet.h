@@ -0,0 +1,79 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_AQL_IN_LIST_SET_H
+#define ARANGOD_AQL_IN_LIST_SET_H 1
+
+#include "Basics/Common.h"
+#include "Basics/VelocyPackHelper.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Iterator.h>
+#include <velocypack/Slice.h>
+
+namespace arangodb {
+namespace aql {
+
+/// @brief the values of a constant IN list. built once per query, so that
+/// each row needs a single hash lookup instead of a binary search
+class InListSet {
+ public:
+  /// @brief build the set from an array of values
+  explicit InListSet(arangodb::velocypack::Slice values)
+      : _values(16, arangodb::basics::VelocyPackHelper::VPackHash(),
+                arangodb::basics::VelocyPackHelper::VPackEqual()) {
+    _builder.add(values);
+    values = _builder.slice();
+    _values.reserve(static_cast<size_t>(values.length()));
+    for (auto const& value : arangodb::velocypack::ArrayIterator(values)) {
+      _values.emplace(value);
+    }
+  }
+
+  InListSet(InListSet const&) = delete;
+  InListSet& operator=(InListSet const&) = delete;
+
+  /// @brief whether the set can tell if it contains the value. arrays and
+  /// objects may contain values that only compare equal when resolved,
+  /// e.g. _id
+  static bool canFind(arangodb::velocypack::Slice value) {
+    return value.isNull() || value.isBoolean() || value.isNumber() ||
+           value.isString();
+  }
+
+  /// @brief whether the set contains the value, which must be one that
+  /// canFind() accepts
+  bool contains(arangodb::velocypack::Slice value) const {
+    return _values.find(value) != _values.end();
+  }
+
+ private:
+  arangodb::velocypack::Builder _builder;
+  std::unordered_set<arangodb::velocypack::Slice,
+                     arangodb::basics::VelocyPackHelper::VPackHash,
+                     arangodb::basics::VelocyPackHelper::VPackEqual>
+      _values;
+};
+
+}  // namespace arangodb::aql
+}  // namespace arangodb
+
+#endif
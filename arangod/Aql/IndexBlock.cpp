@@ -32,6 +32,7 @@
 #include "Basics/ScopeGuard.h"
 #include "Basics/Exceptions.h"
 #include "Basics/StaticStrings.h"
+#include "Basics/VelocyPackHelper.h"
 #include "Utils/OperationCursor.h"
 #include "V8/v8-globals.h"
 #include "VocBase/LogicalCollection.h"
@@ -52,6 +53,8 @@ IndexBlock::IndexBlock(ExecutionEngine* engine, IndexNode const* en)
       _cursor(nullptr),
       _cursors(_indexes.size()),
       _condition(en->_condition->root()),
+      _lateMaterialized(en->isLateMaterialized()),
+      _projections(en->projections()),
       _hasV8Expression(false),
       _collector(&_engine->_itemBlockManager) {
   _mmdr.reset(new ManagedDocumentResult);
@@ -270,15 +273,18 @@ bool IndexBlock::initIndexes() {
     TRI_ASSERT(_condition != nullptr);
 
     if (_hasV8Expression) {
-      bool const isRunningInCluster =
-          arangodb::ServerState::instance()->isRunningInCluster();
+      // in the cluster and for streaming queries, the next call may happen
+      // in another thread, so the context must be returned after each call
+      bool const releaseContext =
+          arangodb::ServerState::instance()->isRunningInCluster() ||
+          _engine->getQuery()->isStreaming();
 
       // must have a V8 context here to protect Expression::execute()
       auto engine = _engine;
       arangodb::basics::ScopeGuard guard{
           [&engine]() -> void { engine->getQuery()->enterContext(); },
           [&]() -> void {
-            if (isRunningInCluster) {
+            if (releaseContext) {
               // must invalidate the expression now as we might be called from
               // different threads
               for (auto const& e : _nonConstExpressions) {
@@ -387,13 +393,18 @@ bool IndexBlock::readIndex(size_t atMost) {
   // Then initIndexes is read again and so on. This is to avoid reading the
   // entire index when we only want a small number of documents.
 
-  if (_documents.empty()) {
+  if (numBuffered() == 0) {
     TRI_IF_FAILURE("IndexBlock::readIndex") {
       THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
     }
-    _documents.reserve(atMost);
+    if (_lateMaterialized) {
+      _tokens.reserve(atMost);
+    } else {
+      _documents.reserve(atMost);
+    }
   } else {
     _documents.clear();
+    _tokens.clear();
   }
 
   if (_cursor == nullptr) {
@@ -413,15 +424,42 @@ bool IndexBlock::readIndex(size_t atMost) {
       continue;
     }
 
+    if (!_projections.empty() && _cursor->hasExtra()) {
+      // the index covers the query, so the projected attributes can be
+      // built from the index values without looking up the documents
+      TRI_ASSERT(!hasMultipleIndexes);
+      size_t length = 0;
+      _projectionsBuilder.clear();
+      _projectionsBuilder.openArray();
+      auto cb = [&] (DocumentIdentifierToken const&, VPackSlice extra) {
+        TRI_ASSERT(extra.isArray() && extra.length() == _projections.size());
+        _projectionsBuilder.openObject();
+        size_t i = 0;
+        for (auto const& it : VPackArrayIterator(extra)) {
+          _projectionsBuilder.add(_projections[i++], it);
+        }
+        _projectionsBuilder.close();
+        ++length;
+      };
+      _cursor->getMoreExtra(cb, atMost);
+      _projectionsBuilder.close();
+
+      if (length == 0) {
+        startNextCursor();
+        continue;
+      }
+
+      _engine->_stats.scannedIndex += length;
+
+      for (auto const& it : VPackArrayIterator(_projectionsBuilder.slice())) {
+        _documents.emplace_back(it);
+      }
+      break;
+    }
+
     LogicalCollection* collection = _cursor->collection();
     _result.clear();
-    auto cb = [&] (DocumentIdentifierToken const& token) {
-      _result.emplace_back(token);
-    };
-    // TODO We can optimize this place by allowing the
-    // index to directly write into AQLItemBlock
-    // instead of the local _result cache.
-    _cursor->getMore(cb, atMost);
+    _cursor->getMoreTokens(_result, atMost);
 
     size_t length = _result.size();
 
@@ -437,10 +475,29 @@ bool IndexBlock::readIndex(size_t atMost) {
     }
      
 
-    if (hasMultipleIndexes) {
+    if (!_projections.empty()) {
+      // the index cannot produce its values, so take them from the documents
+      TRI_ASSERT(!hasMultipleIndexes);
+      buildProjections(collection);
+    } else if (_lateMaterialized) {
+      // documents are only read by a MaterializeBlock later
       for (auto const& element : _result) {
-        if (collection->readDocument(_trx, element, *_mmdr)) {
-          uint8_t const* vpack = _mmdr->vpack(); //back();
+        if (!hasMultipleIndexes) {
+          _tokens.emplace_back(element);
+        } else if (!isLastIndex) {
+          if (_alreadyReturned.emplace(element).second) {
+            _tokens.emplace_back(element);
+          }
+        } else if (_alreadyReturned.find(element) == _alreadyReturned.end()) {
+          _tokens.emplace_back(element);
+        }
+      }
+    } else if (hasMultipleIndexes) {
+      collection->readDocuments(_trx, _result, _resultDocuments);
+      for (size_t i = 0; i < length; ++i) {
+        uint8_t const* vpack = _resultDocuments[i];
+        if (vpack != nullptr) {
+          auto const& element = _result[i];
           // uniqueness checks
           if (!isLastIndex) {
             // insert & check for duplicates in one go
@@ -456,25 +513,52 @@ bool IndexBlock::readIndex(size_t atMost) {
         }
       }
     } else {
-      for (auto const& element : _result) {
-        if (collection->readDocument(_trx, element, *_mmdr)) {
-          uint8_t const* vpack = _mmdr->vpack(); //back();
+      collection->readDocuments(_trx, _result, _resultDocuments);
+      for (auto const& vpack : _resultDocuments) {
+        if (vpack != nullptr) {
           _documents.emplace_back(vpack);
         }
-      } 
+      }
     }
     // Leave the loop here, we can only exhaust one cursor at a time, otherwise slices are lost
-    if (!_documents.empty()) {
+    if (numBuffered() > 0) {
       break;
     }
   }
   _posInDocs = 0;
-  return (!_documents.empty());
+  return (numBuffered() > 0);
 
   // cppcheck-suppress style
   DEBUG_END_BLOCK();
 }
 
+/// @brief build the objects containing the projected attributes for
+/// the documents currently in _result
+void IndexBlock::buildProjections(LogicalCollection* collection) {
+  _projectionsBuilder.clear();
+  _projectionsBuilder.openArray();
+  collection->readDocuments(_trx, _result, _resultDocuments);
+  for (auto const& vpack : _resultDocuments) {
+    if (vpack != nullptr) {
+      VPackSlice doc(vpack);
+      _projectionsBuilder.openObject();
+      for (auto const& it : _projections) {
+        VPackSlice value = doc.get(it);
+        if (value.isNone()) {
+          value = arangodb::basics::VelocyPackHelper::NullValue();
+        }
+        _projectionsBuilder.add(it, value);
+      }
+      _projectionsBuilder.close();
+    }
+  }
+  _projectionsBuilder.close();
+
+  for (auto const& it : VPackArrayIterator(_projectionsBuilder.slice())) {
+    _documents.emplace_back(it);
+  }
+}
+
 int IndexBlock::initializeCursor(AqlItemBlock* items, size_t pos) {
   DEBUG_BEGIN_BLOCK();
   _collector.clear();
@@ -512,7 +596,7 @@ AqlItemBlock* IndexBlock::getSome(size_t atLeast, size_t atMost) {
     // try again!
 
     if (_buffer.empty()) {
-      size_t toFetch = (std::min)(DefaultBatchSize(), atMost);
+      size_t toFetch = (std::min)(batchSize(), atMost);
       if (!ExecutionBlock::getBlock(toFetch, toFetch) || (!initIndexes())) {
         _done = true;
         traceGetSomeEnd(nullptr);
@@ -523,7 +607,7 @@ AqlItemBlock* IndexBlock::getSome(size_t atLeast, size_t atMost) {
       // This is a new item, so let's read the index (it is already
       // initialized).
       readIndex(atMost);
-    } else if (_posInDocs >= _documents.size()) {
+    } else if (_posInDocs >= numBuffered()) {
       // we have exhausted our local documents buffer,
 
       if (!readIndex(atMost)) {  // no more output from this version of the
@@ -535,7 +619,7 @@ AqlItemBlock* IndexBlock::getSome(size_t atLeast, size_t atMost) {
           _pos = 0;
         }
         if (_buffer.empty()) {
-          if (!ExecutionBlock::getBlock(DefaultBatchSize(), DefaultBatchSize())) {
+          if (!ExecutionBlock::getBlock(batchSize(), batchSize())) {
             _done = true;
             traceGetSomeEnd(nullptr);
             return _collector.steal();
@@ -556,7 +640,7 @@ AqlItemBlock* IndexBlock::getSome(size_t atLeast, size_t atMost) {
     AqlItemBlock* cur = _buffer.front();
     size_t const curRegs = cur->getNrRegs();
 
-    size_t available = _documents.size() - _posInDocs;
+    size_t available = numBuffered() - _posInDocs;
     size_t toSend = (std::min)(atMost, available);
 
     if (toSend > 0) {
@@ -573,11 +657,21 @@ AqlItemBlock* IndexBlock::getSome(size_t atLeast, size_t atMost) {
         // we do not need to do a lookup in
         // getPlanNode()->_registerPlan->varInfo,
         // but can just take cur->getNrRegs() as registerId:
-        auto doc = _documents[_posInDocs++];
-        TRI_ASSERT(!doc.isExternal());
-        // doc points directly into the data files
-        res->setValue(j, static_cast<arangodb::aql::RegisterId>(curRegs), 
-                      AqlValue(doc.begin(), AqlValueFromManagedDocument()));
+        if (!_projections.empty()) {
+          // only the projected attributes, built from the index values
+          res->setValue(j, static_cast<arangodb::aql::RegisterId>(curRegs),
+                        AqlValue(_documents[_posInDocs++]));
+        } else if (_lateMaterialized) {
+          // only pass on the document's token, to be materialized later
+          res->setValue(j, static_cast<arangodb::aql::RegisterId>(curRegs),
+                        AqlValue(_tokens[_posInDocs++]._data));
+        } else {
+          auto doc = _documents[_posInDocs++];
+          TRI_ASSERT(!doc.isExternal());
+          // doc points directly into the data files
+          res->setValue(j, static_cast<arangodb::aql::RegisterId>(curRegs),
+                        AqlValue(doc.begin(), AqlValueFromManagedDocument()));
+        }
         // No harm done, if the setValue throws!
         
         if (j > 0) {
@@ -609,35 +703,75 @@ AqlItemBlock* IndexBlock::getSome(size_t atLeast, size_t atMost) {
 /// @brief skipSome
 size_t IndexBlock::skipSome(size_t atLeast, size_t atMost) {
   DEBUG_BEGIN_BLOCK();
+  traceSkipSomeBegin();
   if (_done) {
-    return 0;
+    return traceSkipSomeEnd(0);
   }
 
+  // with a single index, there are no duplicates to filter out, so the
+  // index entries can be skipped in the cursor, without reading the
+  // documents
+  bool const skipInIndex = (_indexes.size() == 1);
   size_t skipped = 0;
 
   while (skipped < atLeast) {
     if (_buffer.empty()) {
-      size_t toFetch = (std::min)(DefaultBatchSize(), atMost);
+      size_t toFetch = (std::min)(batchSize(), atMost);
       if (!ExecutionBlock::getBlock(toFetch, toFetch) || (!initIndexes())) {
         _done = true;
-        return skipped;
+        return traceSkipSomeEnd(skipped);
       }
       _pos = 0;  // this is in the first block
 
       // This is a new item, so let's read the index if bounds are variable:
-      readIndex(atMost);
+      if (skipInIndex) {
+        // nothing buffered for this item
+        _documents.clear();
+        _tokens.clear();
+        _posInDocs = 0;
+      } else {
+        readIndex(atMost);
+      }
     }
 
-    size_t available = _documents.size() - _posInDocs;
+    size_t available = numBuffered() - _posInDocs;
     size_t toSkip = (std::min)(atMost - skipped, available);
 
     _posInDocs += toSkip;
     skipped += toSkip;
 
     // Advance read position:
-    if (_posInDocs >= _documents.size()) {
+    if (_posInDocs >= numBuffered()) {
       // we have exhausted our local documents buffer,
-      if (!readIndex(atMost)) {
+      bool hasMore;
+
+      if (skipInIndex) {
+        _documents.clear();
+        _tokens.clear();
+        _posInDocs = 0;
+
+        while (_cursor != nullptr && skipped < atMost) {
+          if (!_cursor->hasMore()) {
+            startNextCursor();
+            continue;
+          }
+
+          uint64_t skippedHere = 0;
+          int res = _cursor->skip(atMost - skipped, skippedHere);
+
+          if (res != TRI_ERROR_NO_ERROR) {
+            THROW_ARANGO_EXCEPTION(res);
+          }
+
+          _engine->_stats.scannedIndex += skippedHere;
+          skipped += skippedHere;
+        }
+        hasMore = (_cursor != nullptr);
+      } else {
+        hasMore = readIndex(atMost);
+      }
+
+      if (!hasMore) {
         // If we get here, we do have _buffer.front() and _pos points into it
         AqlItemBlock* cur = _buffer.front();
 
@@ -651,9 +785,11 @@ size_t IndexBlock::skipSome(size_t atLeast, size_t atMost) {
         if (!_buffer.empty()) {
           if (!initIndexes()) {
             _done = true;
-            return skipped;
+            return traceSkipSomeEnd(skipped);
+          }
+          if (!skipInIndex) {
+            readIndex(atMost);
           }
-          readIndex(atMost);
         }
       }
 
@@ -662,7 +798,7 @@ size_t IndexBlock::skipSome(size_t atLeast, size_t atMost) {
     }
   }
 
-  return skipped;
+  return traceSkipSomeEnd(skipped);
 
   // cppcheck-suppress style
   DEBUG_END_BLOCK();
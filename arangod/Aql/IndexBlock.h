@@ -32,7 +32,10 @@
 
 #include "StorageEngine/DocumentIdentifierToken.h"
 
+#include <velocypack/Builder.h>
+
 namespace arangodb {
+class LogicalCollection;
 class ManagedDocumentResult;
 struct OperationCursor;
 
@@ -101,6 +104,15 @@ class IndexBlock final : public ExecutionBlock {
   /// @brief continue fetching of documents
   bool readIndex(size_t atMost);
 
+  /// @brief build the objects containing the projected attributes for
+  /// the documents currently in _result
+  void buildProjections(LogicalCollection* collection);
+
+  /// @brief number of documents or tokens fetched by the last readIndex
+  size_t numBuffered() const {
+    return _lateMaterialized ? _tokens.size() : _documents.size();
+  }
+
   /// @brief frees the memory for all non-constant expressions
   void cleanupNonConstExpressions();
 
@@ -113,10 +125,17 @@ class IndexBlock final : public ExecutionBlock {
 
   /// @brief document result
   std::vector<DocumentIdentifierToken> _result;
+
+  /// @brief the documents of the tokens in _result, read at once
+  std::vector<uint8_t const*> _resultDocuments;
   
   /// @brief document buffer
   std::vector<arangodb::velocypack::Slice> _documents;
 
+  /// @brief token buffer, used instead of the document buffer if the
+  /// documents are materialized later
+  std::vector<DocumentIdentifierToken> _tokens;
+
   /// @brief current position in _allDocs
   size_t _posInDocs;
 
@@ -153,6 +172,17 @@ class IndexBlock final : public ExecutionBlock {
   /// @brief set of already returned documents. Used to make the result distinct
   std::unordered_set<DocumentIdentifierToken> _alreadyReturned;
 
+  /// @brief whether or not only document tokens are produced
+  bool const _lateMaterialized;
+
+  /// @brief the attributes produced from the index values, if the index
+  /// covers the query
+  std::vector<std::string> const _projections;
+
+  /// @brief storage for the objects built from the index values. the
+  /// document buffer points into this if the index covers the query
+  arangodb::velocypack::Builder _projectionsBuilder;
+
   /// @brief whether or not at least one expression uses v8
   bool _hasV8Expression;
   
@@ -44,6 +44,7 @@ IndexNode::IndexNode(ExecutionPlan* plan, size_t id, TRI_vocbase_t* vocbase,
         _vocbase(vocbase),
         _collection(collection),
         _outVariable(outVariable),
+        _outTokenVariable(nullptr),
         _indexes(indexes),
         _condition(condition),
         _reverse(reverse) {
@@ -69,6 +70,10 @@ void IndexNode::toVelocyPackHelper(VPackBuilder& nodes, bool verbose) const {
   nodes.add("satellite", VPackValue(_collection->isSatellite()));
   nodes.add(VPackValue("outVariable"));
   _outVariable->toVelocyPack(nodes);
+  if (_outTokenVariable != nullptr) {
+    nodes.add(VPackValue("outTokenVariable"));
+    _outTokenVariable->toVelocyPack(nodes);
+  }
 
   nodes.add(VPackValue("indexes"));
   {
@@ -83,6 +88,14 @@ void IndexNode::toVelocyPackHelper(VPackBuilder& nodes, bool verbose) const {
   _condition->toVelocyPack(nodes, verbose);
   nodes.add("reverse", VPackValue(_reverse));
 
+  if (!_projections.empty()) {
+    nodes.add(VPackValue("projections"));
+    VPackArrayBuilder guard(&nodes);
+    for (auto const& it : _projections) {
+      nodes.add(VPackValue(it));
+    }
+  }
+
   // And close it:
   nodes.close();
 }
@@ -90,13 +103,20 @@ void IndexNode::toVelocyPackHelper(VPackBuilder& nodes, bool verbose) const {
 ExecutionNode* IndexNode::clone(ExecutionPlan* plan, bool withDependencies,
                                 bool withProperties) const {
   auto outVariable = _outVariable;
+  auto outTokenVariable = _outTokenVariable;
 
   if (withProperties) {
     outVariable = plan->getAst()->variables()->createVariable(outVariable);
+    if (outTokenVariable != nullptr) {
+      outTokenVariable =
+          plan->getAst()->variables()->createVariable(outTokenVariable);
+    }
   }
 
   auto c = new IndexNode(plan, _id, _vocbase, _collection, outVariable,
                          _indexes, _condition->clone(), _reverse);
+  c->setLateMaterialized(outTokenVariable);
+  c->setProjections(_projections);
 
   cloneHelper(c, plan, withDependencies, withProperties);
 
@@ -110,6 +130,8 @@ IndexNode::IndexNode(ExecutionPlan* plan, arangodb::velocypack::Slice const& bas
       _collection(plan->getAst()->query()->collections()->get(
           base.get("collection").copyString())),
       _outVariable(varFromVPack(plan->getAst(), base, "outVariable")),
+      _outTokenVariable(
+          varFromVPack(plan->getAst(), base, "outTokenVariable", true)),
       _indexes(),
       _condition(nullptr),
       _reverse(base.get("reverse").getBoolean()) {
@@ -134,6 +156,13 @@ IndexNode::IndexNode(ExecutionPlan* plan, arangodb::velocypack::Slice const& bas
 
   _condition = Condition::fromVPack(plan, condition);
 
+  VPackSlice projections = base.get("projections");
+  if (projections.isArray()) {
+    for (auto const& it : VPackArrayIterator(projections)) {
+      _projections.emplace_back(it.copyString());
+    }
+  }
+
   TRI_ASSERT(_condition != nullptr);
 }
 
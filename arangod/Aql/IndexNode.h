@@ -93,9 +93,38 @@ class IndexNode : public ExecutionNode {
 
   /// @brief getVariablesSetHere
   std::vector<Variable const*> getVariablesSetHere() const override final {
+    if (_outTokenVariable != nullptr) {
+      return std::vector<Variable const*>{_outTokenVariable};
+    }
     return std::vector<Variable const*>{_outVariable};
   }
 
+  /// @brief whether or not the node only produces document tokens, which
+  /// are turned into documents by a MaterializeNode later
+  bool isLateMaterialized() const { return _outTokenVariable != nullptr; }
+
+  /// @brief return the variable for the document tokens
+  Variable const* outTokenVariable() const { return _outTokenVariable; }
+
+  /// @brief produce document tokens in the specified variable instead of
+  /// documents in the out variable
+  void setLateMaterialized(Variable const* tokenVariable) {
+    _outTokenVariable = tokenVariable;
+  }
+
+  /// @brief whether or not the node produces the indexed attribute values
+  /// only, without looking up the documents
+  bool isCovering() const { return !_projections.empty(); }
+
+  /// @brief the attributes produced by a covering index node, in the order
+  /// of the index fields
+  std::vector<std::string> const& projections() const { return _projections; }
+
+  /// @brief only produce the specified attributes, as read from the index
+  void setProjections(std::vector<std::string> const& projections) {
+    _projections = projections;
+  }
+
   /// @brief getVariablesUsedHere, returning a vector
   std::vector<Variable const*> getVariablesUsedHere() const override final;
 
@@ -119,6 +148,10 @@ class IndexNode : public ExecutionNode {
   /// @brief output variable
   Variable const* _outVariable;
 
+  /// @brief output variable for document tokens, if the documents are
+  /// materialized later
+  Variable const* _outTokenVariable;
+
   /// @brief the index
   std::vector<transaction::Methods::IndexHandle> _indexes;
 
@@ -127,6 +160,10 @@ class IndexNode : public ExecutionNode {
 
   /// @brief the index sort order - this is the same order for all indexes
   bool _reverse;
+
+  /// @brief the attributes produced from the index values, if the index
+  /// covers all attributes that are used from the documents
+  std::vector<std::string> _projections;
 };
 
 }  // namespace arangodb::aql
@@ -0,0 +1,121 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "MaterializeBlock.h"
+#include "Aql/AqlItemBlock.h"
+#include "Aql/AqlValue.h"
+#include "Aql/Collection.h"
+#include "Basics/Exceptions.h"
+#include "Basics/VelocyPackHelper.h"
+#include "StorageEngine/DocumentIdentifierToken.h"
+#include "VocBase/LogicalCollection.h"
+#include "VocBase/ManagedDocumentResult.h"
+
+#include <velocypack/Slice.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+namespace {
+
+/// @brief a document token restored from the value produced by a
+/// late-materializing IndexBlock
+struct MaterializedToken final : public DocumentIdentifierToken {
+  explicit MaterializedToken(uint64_t data) : DocumentIdentifierToken(data) {}
+};
+
+}  // namespace
+
+MaterializeBlock::MaterializeBlock(ExecutionEngine* engine,
+                                   MaterializeNode const* en)
+    : ExecutionBlock(engine, en),
+      _collection(en->collection()->getCollection().get()),
+      _mmdr(new ManagedDocumentResult),
+      _inReg(ExecutionNode::MaxRegisterId),
+      _outReg(ExecutionNode::MaxRegisterId) {
+  auto it = en->getRegisterPlan()->varInfo.find(en->_inVariable->id);
+
+  if (it == en->getRegisterPlan()->varInfo.end()) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL, "variable not found");
+  }
+
+  _inReg = (*it).second.registerId;
+  TRI_ASSERT(_inReg < ExecutionNode::MaxRegisterId);
+
+  it = en->getRegisterPlan()->varInfo.find(en->_outVariable->id);
+  TRI_ASSERT(it != en->getRegisterPlan()->varInfo.end());
+  _outReg = (*it).second.registerId;
+  TRI_ASSERT(_outReg < ExecutionNode::MaxRegisterId);
+}
+
+MaterializeBlock::~MaterializeBlock() {}
+
+/// @brief read the documents for all tokens in the block
+void MaterializeBlock::materialize(AqlItemBlock* result) {
+  DEBUG_BEGIN_BLOCK();
+  size_t const n = result->size();
+
+  for (size_t i = 0; i < n; ++i) {
+    AqlValue const& token = result->getValueReference(i, _inReg);
+    TRI_ASSERT(token.isNumber());
+
+    MaterializedToken tkn(token.slice().getNumber<uint64_t>());
+
+    if (_collection->readDocument(_trx, tkn, *_mmdr)) {
+      // the document points directly into the data files
+      result->setValue(i, _outReg,
+                       AqlValue(_mmdr->vpack(), AqlValueFromManagedDocument()));
+    } else {
+      // the document has vanished since it was found in the index
+      result->setValue(
+          i, _outReg,
+          AqlValue(arangodb::basics::VelocyPackHelper::NullValue()));
+    }
+  }
+
+  // cppcheck-suppress style
+  DEBUG_END_BLOCK();
+}
+
+/// @brief getSome
+AqlItemBlock* MaterializeBlock::getSome(size_t atLeast, size_t atMost) {
+  DEBUG_BEGIN_BLOCK();
+  traceGetSomeBegin();
+  std::unique_ptr<AqlItemBlock> res(
+      ExecutionBlock::getSomeWithoutRegisterClearout(atLeast, atMost));
+
+  if (res.get() == nullptr) {
+    traceGetSomeEnd(nullptr);
+    return nullptr;
+  }
+
+  throwIfKilled();  // check if we were aborted
+
+  materialize(res.get());
+  // Clear out registers no longer needed later:
+  clearRegisters(res.get());
+  traceGetSomeEnd(res.get());
+  return res.release();
+
+  // cppcheck-suppress style
+  DEBUG_END_BLOCK();
+}
@@ -0,0 +1,66 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_AQL_MATERIALIZE_BLOCK_H
+#define ARANGOD_AQL_MATERIALIZE_BLOCK_H 1
+
+#include "Aql/ExecutionBlock.h"
+#include "Aql/MaterializeNode.h"
+
+namespace arangodb {
+class LogicalCollection;
+class ManagedDocumentResult;
+
+namespace aql {
+class AqlItemBlock;
+class ExecutionEngine;
+
+class MaterializeBlock final : public ExecutionBlock {
+ public:
+  MaterializeBlock(ExecutionEngine*, MaterializeNode const*);
+
+  ~MaterializeBlock();
+
+  /// @brief getSome
+  AqlItemBlock* getSome(size_t atLeast, size_t atMost) override final;
+
+ private:
+  /// @brief read the documents for all tokens in the block
+  void materialize(AqlItemBlock*);
+
+ private:
+  /// @brief collection the documents are read from
+  LogicalCollection* _collection;
+
+  /// @brief document buffer
+  std::unique_ptr<ManagedDocumentResult> _mmdr;
+
+  /// @brief input register, containing document tokens
+  RegisterId _inReg;
+
+  /// @brief output register
+  RegisterId _outReg;
+};
+
+}  // namespace arangodb::aql
+}  // namespace arangodb
+
+#endif
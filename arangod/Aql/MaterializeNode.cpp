@@ -0,0 +1,133 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "MaterializeNode.h"
+#include "Aql/Ast.h"
+#include "Aql/Collection.h"
+#include "Aql/ExecutionPlan.h"
+#include "Aql/Query.h"
+
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+/// @brief constructor
+MaterializeNode::MaterializeNode(ExecutionPlan* plan, size_t id,
+                                 Collection const* collection,
+                                 Variable const* inVariable,
+                                 Variable const* outVariable)
+    : ExecutionNode(plan, id),
+      _collection(collection),
+      _inVariable(inVariable),
+      _outVariable(outVariable) {
+  TRI_ASSERT(_collection != nullptr);
+  TRI_ASSERT(_inVariable != nullptr);
+  TRI_ASSERT(_outVariable != nullptr);
+}
+
+/// @brief constructor for MaterializeNode
+MaterializeNode::MaterializeNode(ExecutionPlan* plan,
+                                 arangodb::velocypack::Slice const& base)
+    : ExecutionNode(plan, base),
+      _collection(plan->getAst()->query()->collections()->get(
+          base.get("collection").copyString())),
+      _inVariable(varFromVPack(plan->getAst(), base, "inVariable")),
+      _outVariable(varFromVPack(plan->getAst(), base, "outVariable")) {
+  TRI_ASSERT(_collection != nullptr);
+}
+
+/// @brief the node the documents must be read before, after a LIMIT
+ExecutionNode* MaterializeNode::findMaterializationPoint(
+    ExecutionNode* start, Variable const* variable) {
+  bool passedLimit = false;
+  ExecutionNode* current = start->getFirstParent();
+
+  while (current != nullptr) {
+    std::unordered_set<Variable const*> vars;
+    current->getVariablesUsedHere(vars);
+
+    if (vars.find(variable) != vars.end()) {
+      break;
+    }
+
+    auto const type = current->getType();
+
+    if (type == LIMIT) {
+      passedLimit = true;
+    } else if (type != FILTER && type != CALCULATION && type != SORT) {
+      break;
+    }
+
+    current = current->getFirstParent();
+  }
+
+  if (!passedLimit || current == nullptr) {
+    // no rows are dropped before the documents are needed, or they are
+    // not needed at all
+    return nullptr;
+  }
+  return current;
+}
+
+/// @brief toVelocyPack, for MaterializeNode
+void MaterializeNode::toVelocyPackHelper(VPackBuilder& nodes,
+                                         bool verbose) const {
+  ExecutionNode::toVelocyPackHelperGeneric(nodes,
+                                           verbose);  // call base class method
+
+  nodes.add("collection", VPackValue(_collection->getName()));
+  nodes.add(VPackValue("inVariable"));
+  _inVariable->toVelocyPack(nodes);
+  nodes.add(VPackValue("outVariable"));
+  _outVariable->toVelocyPack(nodes);
+
+  // And close it:
+  nodes.close();
+}
+
+/// @brief clone ExecutionNode recursively
+ExecutionNode* MaterializeNode::clone(ExecutionPlan* plan,
+                                      bool withDependencies,
+                                      bool withProperties) const {
+  auto inVariable = _inVariable;
+  auto outVariable = _outVariable;
+
+  if (withProperties) {
+    inVariable = plan->getAst()->variables()->createVariable(inVariable);
+    outVariable = plan->getAst()->variables()->createVariable(outVariable);
+  }
+
+  auto c = new MaterializeNode(plan, _id, _collection, inVariable, outVariable);
+
+  cloneHelper(c, plan, withDependencies, withProperties);
+
+  return static_cast<ExecutionNode*>(c);
+}
+
+/// @brief the cost of a materialize node is the cost of its dependency
+/// plus one document lookup per incoming item
+double MaterializeNode::estimateCost(size_t& nrItems) const {
+  size_t incoming = 0;
+  double depCost = _dependencies.at(0)->getCost(incoming);
+  nrItems = incoming;
+  return depCost + incoming;
+}
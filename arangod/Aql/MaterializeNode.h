@@ -0,0 +1,112 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_AQL_MATERIALIZE_NODE_H
+#define ARANGOD_AQL_MATERIALIZE_NODE_H 1
+
+#include "Basics/Common.h"
+#include "Aql/ExecutionNode.h"
+#include "Aql/types.h"
+#include "Aql/Variable.h"
+
+#include <velocypack/Slice.h>
+
+namespace arangodb {
+namespace aql {
+struct Collection;
+class ExecutionBlock;
+class ExecutionPlan;
+
+/// @brief class MaterializeNode
+/// a MaterializeNode reads the documents for the document tokens produced
+/// by a late-materializing IndexNode
+class MaterializeNode : public ExecutionNode {
+  friend class ExecutionBlock;
+  friend class MaterializeBlock;
+
+ public:
+  MaterializeNode(ExecutionPlan* plan, size_t id, Collection const* collection,
+                  Variable const* inVariable, Variable const* outVariable);
+
+  MaterializeNode(ExecutionPlan*, arangodb::velocypack::Slice const& base);
+
+  /// @brief the node above start that the documents in variable must be
+  /// read before: the first node that uses them or that may change the
+  /// number of rows per document. returns nullptr if no LIMIT drops rows
+  /// before that node, so materializing later does not save anything
+  static ExecutionNode* findMaterializationPoint(ExecutionNode* start,
+                                                 Variable const* variable);
+
+  /// @brief return the type of the node
+  NodeType getType() const override final { return MATERIALIZE; }
+
+  /// @brief export to VelocyPack
+  void toVelocyPackHelper(arangodb::velocypack::Builder&,
+                          bool) const override final;
+
+  /// @brief clone ExecutionNode recursively
+  ExecutionNode* clone(ExecutionPlan* plan, bool withDependencies,
+                       bool withProperties) const override final;
+
+  /// @brief the cost of a materialize node is the cost of its dependency
+  /// plus one document lookup per incoming item
+  double estimateCost(size_t&) const override final;
+
+  /// @brief getVariablesUsedHere, returning a vector
+  std::vector<Variable const*> getVariablesUsedHere() const override final {
+    return std::vector<Variable const*>{_inVariable};
+  }
+
+  /// @brief getVariablesUsedHere, modifying the set in-place
+  void getVariablesUsedHere(
+      std::unordered_set<Variable const*>& vars) const override final {
+    vars.emplace(_inVariable);
+  }
+
+  /// @brief getVariablesSetHere
+  std::vector<Variable const*> getVariablesSetHere() const override final {
+    return std::vector<Variable const*>{_outVariable};
+  }
+
+  /// @brief return the collection
+  Collection const* collection() const { return _collection; }
+
+  /// @brief return the in variable
+  Variable const* inVariable() const { return _inVariable; }
+
+  /// @brief return the out variable
+  Variable const* outVariable() const { return _outVariable; }
+
+ private:
+  /// @brief collection
+  Collection const* _collection;
+
+  /// @brief input variable, containing document tokens
+  Variable const* _inVariable;
+
+  /// @brief output variable, containing documents
+  Variable const* _outVariable;
+};
+
+}  // namespace arangodb::aql
+}  // namespace arangodb
+
+#endif
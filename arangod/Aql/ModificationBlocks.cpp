@@ -79,9 +79,11 @@ AqlItemBlock* ModificationBlock::getSome(size_t atLeast, size_t atMost) {
   // we cannot use any batching here because if the search document is not
   // found, the UPSERTs INSERT operation may create it. after that, the
   // search document is present and we cannot use an already queried result
-  // from the initial search batch
+  // from the initial search batch. the query can opt out of this with the
+  // readOwnWrites option, then the UPSERT uses array operations as well
   traceGetSomeBegin();
-  if (getPlanNode()->getType() == ExecutionNode::NodeType::UPSERT) {
+  if (getPlanNode()->getType() == ExecutionNode::NodeType::UPSERT &&
+      static_cast<ModificationNode const*>(_exeNode)->_options.readOwnWrites) {
     atLeast = 1;
     atMost = 1;
   }
@@ -45,7 +45,8 @@ struct ModificationOptions {
         ignoreDocumentNotFound(false),
         readCompleteInput(true),
         useIsRestore(false),
-        consultAqlWriteFilter(false) {}
+        consultAqlWriteFilter(false),
+        readOwnWrites(true) {}
 
   void toVelocyPack(arangodb::velocypack::Builder&) const;
 
@@ -57,6 +58,10 @@ struct ModificationOptions {
   bool readCompleteInput;
   bool useIsRestore;
   bool consultAqlWriteFilter;
+  /// @brief whether an UPSERT's lookup must see the writes of all previous
+  /// rows. if false, the input is processed in batches, and the lookups of
+  /// a batch are done before any of its writes
+  bool readOwnWrites;
 };
 
 }  // namespace arangodb::aql
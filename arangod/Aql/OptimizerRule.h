@@ -151,6 +151,12 @@ struct OptimizerRule {
     // sort values used in IN comparisons of remaining filters
     sortInValuesRule_pass6,
 
+    // replace nested loops for equi-joins with hash joins
+    hashJoinRule_pass6,
+
+    // replace correlated subqueries with hash lookups
+    decorrelateSubqueriesRule_pass6,
+
     // remove calculations that are never necessary
     removeUnnecessaryCalculationsRule_pass6,
 
@@ -164,6 +170,21 @@ struct OptimizerRule {
     /// Pass 9: patch update statements
     patchUpdateStatementsRule_pass9,
 
+    /// Pass 9: make sorts that are followed by a limit only keep the
+    /// rows that pass the limit
+    sortLimitRule_pass9,
+
+    /// Pass 9: produce the attributes used from documents found in indexes
+    /// from the index values
+    useCoveringIndexRule_pass9,
+
+    /// Pass 9: read documents found in indexes only after LIMITs
+    lateDocumentMaterializationRule_pass9,
+
+    /// Pass 9: take the result of COLLECT WITH COUNT INTO from the
+    /// collection's document count
+    useCollectionCountRule_pass9,
+
     /// "Pass 10": final transformations for the cluster
     // make operations on sharded collections use distribute
     distributeInClusterRule_pass10,
@@ -180,6 +201,13 @@ struct OptimizerRule {
     // adjust gathernode to also contain the sort criteria.
     distributeSortToClusterRule_pass10,
 
+    // split COLLECTs after a GatherNode into a partial COLLECT on the
+    // DB servers and a final COLLECT on the coordinator
+    collectInClusterRule_pass10,
+
+    // copy a LIMIT right after a GatherNode into the DB server snippets
+    distributeLimitToClusterRule_pass10,
+
     // try to get rid of a RemoteNode->ScatterNode combination which has
     // only a SingletonNode and possibly some CalculationNodes as dependencies
     removeUnnecessaryRemoteScatterRule_pass10,
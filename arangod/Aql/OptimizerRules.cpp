@@ -31,7 +31,10 @@
 #include "Aql/ExecutionNode.h"
 #include "Aql/ExecutionPlan.h"
 #include "Aql/Function.h"
+#include "Aql/HashJoinNode.h"
+#include "Aql/HashLookupNode.h"
 #include "Aql/IndexNode.h"
+#include "Aql/MaterializeNode.h"
 #include "Aql/ModificationNodes.h"
 #include "Aql/Optimizer.h"
 #include "Aql/Query.h"
@@ -336,7 +339,8 @@ void arangodb::aql::removeRedundantSortsRule(Optimizer* opt,
         } else if (current->getType() == EN::ENUMERATE_LIST ||
                    current->getType() == EN::ENUMERATE_COLLECTION ||
                    current->getType() == EN::TRAVERSAL ||
-                   current->getType() == EN::SHORTEST_PATH) {
+                   current->getType() == EN::SHORTEST_PATH ||
+                   current->getType() == EN::HASH_JOIN) {
           // ok, but we cannot remove two different sorts if one of these node
           // types is between them
           // example: in the following query, the one sort will be optimized
@@ -468,6 +472,12 @@ void arangodb::aql::removeCollectVariablesRule(Optimizer* opt,
         varsUsedLater.find(outVariable) == varsUsedLater.end()) {
       // outVariable not used later
       collectNode->clearOutVariable();
+      if (collectNode->aggregationMethod() ==
+          CollectOptions::CollectMethod::COLLECT_METHOD_COUNT) {
+        // there is nothing to count anymore
+        collectNode->aggregationMethod(
+            CollectOptions::CollectMethod::COLLECT_METHOD_SORTED);
+      }
       modified = true;
     }
 
@@ -774,9 +784,11 @@ void arangodb::aql::removeSortRandRule(Optimizer* opt, std::unique_ptr<Execution
         case EN::COLLECT:
         case EN::FILTER:
         case EN::SUBQUERY:
+        case EN::HASH_LOOKUP:
         case EN::ENUMERATE_LIST:
         case EN::TRAVERSAL:
         case EN::SHORTEST_PATH:
+        case EN::HASH_JOIN:
         case EN::INDEX: {
           // if we found another SortNode, a CollectNode, FilterNode, a
           // SubqueryNode, an EnumerateListNode, a TraversalNode or an IndexNode
@@ -963,6 +975,7 @@ void arangodb::aql::moveCalculationsDownRule(Optimizer* opt,
                  currentType == EN::ENUMERATE_LIST ||
                  currentType == EN::TRAVERSAL ||
                  currentType == EN::SHORTEST_PATH ||
+                 currentType == EN::HASH_JOIN ||
                  currentType == EN::COLLECT ||
                  currentType == EN::NORESULTS) {
         // we will not push further down than such nodes
@@ -1011,6 +1024,17 @@ void arangodb::aql::specializeCollectRule(Optimizer* opt, std::unique_ptr<Execut
 
     auto const& groupVariables = collectNode->groupVariables();
 
+    if (groupVariables.empty() && collectNode->aggregateVariables().empty() &&
+        collectNode->count() && !collectNode->hasExpressionVariable()) {
+      // COLLECT WITH COUNT INTO only needs to count its input rows, which
+      // neither needs a hash table nor sorted input
+      collectNode->aggregationMethod(
+          CollectOptions::CollectMethod::COLLECT_METHOD_COUNT);
+      collectNode->specialized();
+      modified = true;
+      continue;
+    }
+
     // test if we can use an alternative version of COLLECT with a hash table
     bool const canUseHashAggregation =
         (!groupVariables.empty() &&
@@ -1322,6 +1346,20 @@ class arangodb::aql::RedundantCalculationsReplacer final
         break;
       }
 
+      case EN::HASH_JOIN: {
+        auto node = static_cast<HashJoinNode*>(en);
+        node->_probeVariable =
+            Variable::replace(node->_probeVariable, _replacements);
+        break;
+      }
+
+      case EN::HASH_LOOKUP: {
+        auto node = static_cast<HashLookupNode*>(en);
+        node->_probeVariable =
+            Variable::replace(node->_probeVariable, _replacements);
+        break;
+      }
+
       case EN::COLLECT: {
         auto node = static_cast<CollectNode*>(en);
         for (auto& variable : node->_groupVariables) {
@@ -1748,6 +1786,7 @@ struct SortToIndexNode final : public WalkerWorker<ExecutionNode> {
   std::vector<std::pair<VariableId, bool>> _sorts;
   std::unordered_map<VariableId, AstNode const*> _variableDefinitions;
   bool _modified;
+  bool _sortRemoved;
 
  public:
   explicit SortToIndexNode(ExecutionPlan* plan)
@@ -1755,7 +1794,8 @@ struct SortToIndexNode final : public WalkerWorker<ExecutionNode> {
         _sortNode(nullptr),
         _sorts(),
         _variableDefinitions(),
-        _modified(false) {}
+        _modified(false),
+        _sortRemoved(false) {}
 
   bool handleEnumerateCollectionNode(
       EnumerateCollectionNode* enumerateCollectionNode) {
@@ -1807,6 +1847,7 @@ struct SortToIndexNode final : public WalkerWorker<ExecutionNode> {
           // if the index covers the complete sort condition, we can also remove
           // the sort node
           _plan->unlinkNode(_plan->getNodeById(_sortNode->id()));
+          _sortRemoved = true;
         }
       }
     }
@@ -1893,6 +1934,7 @@ struct SortToIndexNode final : public WalkerWorker<ExecutionNode> {
         // sort condition is fully covered by index... now we can remove the
         // sort node from the plan
         _plan->unlinkNode(_plan->getNodeById(_sortNode->id()));
+        _sortRemoved = true;
         _modified = true;
         handled = true;
       }
@@ -1920,6 +1962,7 @@ struct SortToIndexNode final : public WalkerWorker<ExecutionNode> {
               (isSorted || fields.size() >= sortCondition.numAttributes())) {
             // no need to sort
             _plan->unlinkNode(_plan->getNodeById(_sortNode->id()));
+            _sortRemoved = true;
             indexNode->reverse(sortCondition.isDescending());
             _modified = true;
           } else if (numCovered > 0 && sortCondition.isUnidirectional()) {
@@ -1971,6 +2014,9 @@ struct SortToIndexNode final : public WalkerWorker<ExecutionNode> {
       case EN::DISTRIBUTE:
       case EN::GATHER:
       case EN::REMOTE:
+      case EN::HASH_JOIN:
+      case EN::MATERIALIZE:
+      case EN::HASH_LOOKUP:
       case EN::LIMIT:  // LIMIT is criterion to stop
         return true;   // abort.
 
@@ -1995,6 +2041,174 @@ struct SortToIndexNode final : public WalkerWorker<ExecutionNode> {
   }
 };
 
+/// @brief if the SORT in front of a sorted COLLECT cannot be replaced by an
+/// index, look for a sorted index on the group attributes in a different
+/// order. grouping only needs equal groups to be adjacent, so the COLLECT
+/// can group in the order of the index, and a SORT of the groups restores
+/// the order of the result. returns whether the plan was modified
+static bool useIndexForCollectGroups(ExecutionPlan* plan, SortNode* sortNode) {
+  if (!sortNode->hasParent() ||
+      sortNode->getFirstParent()->getType() != EN::COLLECT) {
+    return false;
+  }
+
+  auto collectNode = static_cast<CollectNode*>(sortNode->getFirstParent());
+
+  if (collectNode->aggregationMethod() !=
+      CollectOptions::CollectMethod::COLLECT_METHOD_SORTED) {
+    return false;
+  }
+
+  // copies, as both are modified below
+  auto const groups = collectNode->groupVariables();
+  SortElementVector const elements = sortNode->getElements();
+  size_t const n = groups.size();
+
+  if (n < 2 || elements.size() != n) {
+    // a single attribute has no other order
+    return false;
+  }
+
+  for (size_t i = 0; i < n; ++i) {
+    if (elements[i].var != groups[i].second || !elements[i].ascending ||
+        !elements[i].attributePath.empty()) {
+      // not the SORT inserted for the COLLECT
+      return false;
+    }
+  }
+
+  // find the node that produces the documents
+  ExecutionNode* source = sortNode->getFirstDependency();
+  while (source != nullptr && (source->getType() == EN::CALCULATION ||
+                               source->getType() == EN::FILTER)) {
+    source = source->getFirstDependency();
+  }
+
+  if (source == nullptr || source->isInInnerLoop()) {
+    return false;
+  }
+
+  Variable const* outVariable = nullptr;
+  std::vector<std::shared_ptr<arangodb::Index>> indexes;
+
+  if (source->getType() == EN::ENUMERATE_COLLECTION) {
+    auto enumerateNode = static_cast<EnumerateCollectionNode const*>(source);
+    outVariable = enumerateNode->outVariable();
+    auto trx = plan->getAst()->query()->trx();
+    for (auto const& index : trx->indexesForCollection(
+             enumerateNode->collection()->getName())) {
+      if (!index->sparse()) {
+        // a sparse index does not contain all documents
+        indexes.emplace_back(index);
+      }
+    }
+  } else if (source->getType() == EN::INDEX) {
+    auto indexNode = static_cast<IndexNode const*>(source);
+    if (indexNode->getIndexes().size() != 1 || indexNode->reverse()) {
+      return false;
+    }
+    outVariable = indexNode->outVariable();
+    indexes.emplace_back(indexNode->getIndexes()[0].getIndex());
+  } else {
+    return false;
+  }
+
+  // the document attributes the groups are built from
+  std::vector<std::vector<arangodb::basics::AttributeName>> attributes;
+  for (auto const& it : groups) {
+    auto setter = plan->getVarSetBy(it.second->id);
+    if (setter == nullptr || setter->getType() != EN::CALCULATION) {
+      return false;
+    }
+
+    std::pair<Variable const*, std::vector<arangodb::basics::AttributeName>>
+        access;
+    if (!static_cast<CalculationNode const*>(setter)
+             ->expression()
+             ->node()
+             ->isAttributeAccessForVariable(access) ||
+        access.first != outVariable) {
+      return false;
+    }
+    attributes.emplace_back(std::move(access.second));
+  }
+
+  for (auto const& index : indexes) {
+    auto const& fields = index->fields();
+
+    if (!index->isSorted() || fields.size() < n) {
+      continue;
+    }
+
+    // the positions of the groups in the order of the index attributes
+    std::vector<size_t> order;
+    for (size_t i = 0; i < n; ++i) {
+      for (size_t j = 0; j < n; ++j) {
+        if (std::find(order.begin(), order.end(), j) == order.end() &&
+            arangodb::basics::AttributeName::isIdentical(fields[i],
+                                                         attributes[j], false)) {
+          order.emplace_back(j);
+          break;
+        }
+      }
+      if (order.size() != i + 1) {
+        break;
+      }
+    }
+
+    if (order.size() != n || std::is_sorted(order.begin(), order.end())) {
+      // the index does not cover the groups, or the SORT already had the
+      // order of the index
+      continue;
+    }
+
+    SortElementVector permuted;
+    for (auto const& j : order) {
+      permuted.emplace_back(elements[j]);
+    }
+    sortNode->setElements(permuted);
+
+    SortToIndexNode finder(plan);
+    sortNode->walk(&finder);
+
+    if (!finder._sortRemoved) {
+      // some other index was preferred, or the index does not produce
+      // sorted output for the condition. keep the original order
+      sortNode->setElements(elements);
+      return finder._modified;
+    }
+
+    std::vector<std::pair<Variable const*, Variable const*>> permutedGroups;
+    for (auto const& j : order) {
+      permutedGroups.emplace_back(groups[j]);
+    }
+    collectNode->groupVariables(permutedGroups);
+
+    if (!collectNode->isDistinctCommand()) {
+      // add the post-SORT of the groups
+      SortElementVector sortElements;
+      for (auto const& it : groups) {
+        sortElements.emplace_back(it.first, true);
+      }
+
+      auto postSort =
+          new SortNode(plan, plan->nextId(), sortElements, false);
+      plan->registerNode(postSort);
+
+      TRI_ASSERT(collectNode->hasParent());
+      auto parent = collectNode->getFirstParent();
+      TRI_ASSERT(parent != nullptr);
+
+      postSort->addDependency(collectNode);
+      parent->replaceDependency(collectNode, postSort);
+    }
+
+    return true;
+  }
+
+  return false;
+}
+
 void arangodb::aql::useIndexForSortRule(Optimizer* opt, std::unique_ptr<ExecutionPlan> plan,
                                         OptimizerRule const* rule) {
   SmallVector<ExecutionNode*>::allocator_type::arena_type a;
@@ -2012,6 +2226,10 @@ void arangodb::aql::useIndexForSortRule(Optimizer* opt, std::unique_ptr<Executio
     if (finder._modified) {
       modified = true;
     }
+
+    if (!finder._sortRemoved && useIndexForCollectGroups(plan.get(), sortNode)) {
+      modified = true;
+    }
   }
 
   opt->addPlan(std::move(plan), rule, modified);
@@ -2154,7 +2372,29 @@ static bool NextPermutationTuple(std::vector<size_t>& data,
   return false;
 }
 
-/// @brief interchange adjacent EnumerateCollectionNodes in all possible ways
+/// @brief number of permutation tuples for the runs starting at starts,
+/// capped at a value larger than any plan budget
+static size_t NumberOfPermutations(std::vector<size_t> const& starts,
+                                   size_t size) {
+  static size_t const Cap = 1000000;
+  size_t result = 1;
+
+  for (size_t i = 0; i < starts.size(); i++) {
+    size_t length =
+        ((i < starts.size() - 1) ? starts[i + 1] : size) - starts[i];
+    for (size_t j = 2; j <= length; j++) {
+      result *= j;
+      if (result > Cap) {
+        return Cap;
+      }
+    }
+  }
+
+  return result;
+}
+
+/// @brief interchange adjacent EnumerateCollectionNodes in all possible ways,
+/// or in a few promising ways if there are too many
 void arangodb::aql::interchangeAdjacentEnumerationsRule(
     Optimizer* opt, std::unique_ptr<ExecutionPlan> plan, OptimizerRule const* rule) {
   SmallVector<ExecutionNode*>::allocator_type::arena_type a;
@@ -2217,11 +2457,52 @@ void arangodb::aql::interchangeAdjacentEnumerationsRule(
     }
   }
 
-  // Now we have collected all the runs of EnumerateCollectionNodes in the
-  // plan, we need to compute all possible permutations of all of them,
-  // independently. This is why we need to compute all permutation tuples.
+  // create a plan in which the nodes of every run are reordered according
+  // to the permutation tuple
+  auto addPermutedPlan = [&](std::vector<size_t> const& tuple) {
+    // Clone the plan:
+    std::unique_ptr<ExecutionPlan> newPlan(plan->clone());
+
+    // Find the nodes in the new plan corresponding to the ones in the
+    // old plan that we want to permute:
+    std::vector<ExecutionNode*> newNodes;
+    for (size_t j = 0; j < nodesToPermute.size(); j++) {
+      newNodes.emplace_back(newPlan->getNodeById(nodesToPermute[j]->id()));
+    }
+
+    // Now get going with the permutations:
+    for (size_t i = 0; i < starts.size(); i++) {
+      size_t lowBound = starts[i];
+      size_t highBound =
+          (i < starts.size() - 1) ? starts[i + 1] : tuple.size();
+      // We need to remove the nodes
+      // newNodes[lowBound..highBound-1] in newPlan and replace
+      // them by the same ones in a different order, given by
+      // tuple[lowBound..highBound-1].
+      auto parent = newNodes[lowBound]->getFirstParent();
+
+      TRI_ASSERT(parent != nullptr);
+
+      // Unlink all those nodes:
+      for (size_t j = lowBound; j < highBound; j++) {
+        newPlan->unlinkNode(newNodes[j]);
+      }
+
+      // And insert them in the new order:
+      for (size_t j = highBound; j-- != lowBound;) {
+        newPlan->insertDependency(parent, newNodes[tuple[j]]);
+      }
+    }
 
-  if (!starts.empty()) {
+    // OK, the new plan is ready, let's report it:
+    opt->addPlan(std::move(newPlan), rule, true);
+  };
+
+  // Now we have collected all the runs of EnumerateCollectionNodes in the
+  // plan. If the optimizer can take all possible permutations of all of
+  // them, we compute all permutation tuples.
+  if (!starts.empty() &&
+      !opt->hasEnoughPlans(NumberOfPermutations(starts, permTuple.size()))) {
     NextPermutationTuple(permTuple, starts);  // will never return false
 
     do {
@@ -2232,43 +2513,89 @@ void arangodb::aql::interchangeAdjacentEnumerationsRule(
         break;
       }
 
-      // Clone the plan:
-      std::unique_ptr<ExecutionPlan> newPlan(plan->clone());
-
-      // Find the nodes in the new plan corresponding to the ones in the
-      // old plan that we want to permute:
-      std::vector<ExecutionNode*> newNodes;
-      for (size_t j = 0; j < nodesToPermute.size(); j++) {
-        newNodes.emplace_back(newPlan->getNodeById(nodesToPermute[j]->id()));
+      addPermutedPlan(permTuple);
+    } while (NextPermutationTuple(permTuple, starts));
+  } else if (!starts.empty()) {
+    // too many permutations. enumerating them in lexicographic order would
+    // only vary the innermost loops before the plan budget is used up.
+    // instead, build a few promising orders per run: nested loops are
+    // cheapest with the smallest input outermost, so the loops are sorted
+    // by their estimated number of items, once for every possible
+    // outermost loop (a greedy join order search with every start)
+    auto estimateItems = [](ExecutionNode const* node) -> size_t {
+      if (node->getType() == EN::ENUMERATE_COLLECTION) {
+        return static_cast<EnumerateCollectionNode const*>(node)
+            ->collection()
+            ->count();
       }
+      return static_cast<EnumerateListNode const*>(node)->estimateLength();
+    };
 
-      // Now get going with the permutations:
-      for (size_t i = 0; i < starts.size(); i++) {
-        size_t lowBound = starts[i];
-        size_t highBound =
-            (i < starts.size() - 1) ? starts[i + 1] : permTuple.size();
-        // We need to remove the nodes
-        // newNodes[lowBound..highBound-1] in newPlan and replace
-        // them by the same ones in a different order, given by
-        // permTuple[lowBound..highBound-1].
-        auto parent = newNodes[lowBound]->getFirstParent();
+    std::vector<size_t> items;
+    items.reserve(nodesToPermute.size());
+    for (auto const& it : nodesToPermute) {
+      items.emplace_back(estimateItems(it));
+    }
 
-        TRI_ASSERT(parent != nullptr);
+    // the candidate orders for every run, as permutation tuple segments
+    std::vector<std::vector<std::vector<size_t>>> candidates;
+    size_t maxCandidates = 0;
 
-        // Unlink all those nodes:
-        for (size_t j = lowBound; j < highBound; j++) {
-          newPlan->unlinkNode(newNodes[j]);
-        }
+    for (size_t i = 0; i < starts.size(); i++) {
+      size_t lowBound = starts[i];
+      size_t highBound =
+          (i < starts.size() - 1) ? starts[i + 1] : permTuple.size();
 
-        // And insert them in the new order:
-        for (size_t j = highBound; j-- != lowBound;) {
-          newPlan->insertDependency(parent, newNodes[permTuple[j]]);
+      // all nodes of the run, smallest first
+      std::vector<size_t> sorted;
+      for (size_t j = lowBound; j < highBound; j++) {
+        sorted.emplace_back(j);
+      }
+      std::stable_sort(sorted.begin(), sorted.end(),
+                       [&items](size_t lhs, size_t rhs) {
+                         return items[lhs] < items[rhs];
+                       });
+
+      std::vector<std::vector<size_t>> runCandidates;
+
+      for (auto const& first : sorted) {
+        // outermost to innermost
+        std::vector<size_t> order{first};
+        for (auto const& it : sorted) {
+          if (it != first) {
+            order.emplace_back(it);
+          }
         }
+        // in the tuple, the innermost node comes first
+        std::reverse(order.begin(), order.end());
+        runCandidates.emplace_back(std::move(order));
       }
 
-      // OK, the new plan is ready, let's report it:
-      opt->addPlan(std::move(newPlan), rule, true);
-    } while (NextPermutationTuple(permTuple, starts));
+      maxCandidates = (std::max)(maxCandidates, runCandidates.size());
+      candidates.emplace_back(std::move(runCandidates));
+    }
+
+    std::set<std::vector<size_t>> seen;
+    // the original order is added at the end of this function anyway
+    seen.emplace(permTuple);
+
+    for (size_t c = 0; c < maxCandidates; c++) {
+      if (opt->hasEnoughPlans(1)) {
+        break;
+      }
+
+      std::vector<size_t> tuple;
+      tuple.reserve(permTuple.size());
+      for (auto const& runCandidates : candidates) {
+        auto const& order =
+            runCandidates[(std::min)(c, runCandidates.size() - 1)];
+        tuple.insert(tuple.end(), order.begin(), order.end());
+      }
+
+      if (seen.emplace(tuple).second) {
+        addPermutedPlan(tuple);
+      }
+    }
   }
   
   opt->addPlan(std::move(plan), rule, false);
@@ -2695,6 +3022,9 @@ void arangodb::aql::distributeFilternCalcToClusterRule(
         case EN::ENUMERATE_COLLECTION:
         case EN::TRAVERSAL:
         case EN::SHORTEST_PATH:
+        case EN::HASH_JOIN:
+        case EN::MATERIALIZE:
+        case EN::HASH_LOOKUP:
           // do break
           stopSearching = true;
           break;
@@ -2794,6 +3124,9 @@ void arangodb::aql::distributeSortToClusterRule(Optimizer* opt,
         case EN::INDEX:
         case EN::TRAVERSAL:
         case EN::SHORTEST_PATH:
+        case EN::HASH_JOIN:
+        case EN::MATERIALIZE:
+        case EN::HASH_LOOKUP:
         case EN::ENUMERATE_COLLECTION:
           // For all these, we do not want to pull a SortNode further down
           // out to the DBservers, note that potential FilterNodes and
@@ -2829,6 +3162,231 @@ void arangodb::aql::distributeSortToClusterRule(Optimizer* opt,
   opt->addPlan(std::move(plan), rule, modified);
 }
 
+/// @brief split a COLLECT right after a GatherNode into a partial COLLECT
+/// on the DB servers and a COLLECT that merges the partial results on the
+/// coordinator. this only ships one row per group and shard to the
+/// coordinator instead of all input rows
+/// this rule modifies the plan in place
+void arangodb::aql::collectInClusterRule(Optimizer* opt,
+                                         std::unique_ptr<ExecutionPlan> plan,
+                                         OptimizerRule const* rule) {
+  SmallVector<ExecutionNode*>::allocator_type::arena_type a;
+  SmallVector<ExecutionNode*> nodes{a};
+  plan->findNodesOfType(nodes, EN::GATHER, true);
+
+  bool modified = false;
+
+  for (auto& n : nodes) {
+    auto gatherNode = static_cast<GatherNode*>(n);
+
+    if (!gatherNode->hasParent() ||
+        gatherNode->getDependencies().size() != 1 ||
+        gatherNode->getFirstDependency()->getType() != EN::REMOTE) {
+      continue;
+    }
+
+    auto parent = gatherNode->getFirstParent();
+
+    if (parent->getType() != EN::COLLECT) {
+      continue;
+    }
+
+    auto collectNode = static_cast<CollectNode*>(parent);
+
+    if ((collectNode->hasOutVariable() && !collectNode->count()) ||
+        collectNode->hasExpressionVariable()) {
+      // INTO needs all input rows on the coordinator
+      continue;
+    }
+
+    // determine the aggregate functions for both steps
+    std::vector<std::pair<Variable const*,
+                          std::pair<Variable const*, std::string>>>
+        dbServerAggregates;
+    std::vector<std::pair<Variable const*,
+                          std::pair<Variable const*, std::string>>>
+        coordinatorAggregates;
+    bool canSplit = true;
+
+    for (auto const& it : collectNode->aggregateVariables()) {
+      std::string step1;
+      std::string step2;
+      if (!Aggregator::splitIntoSteps(it.second.second, step1, step2)) {
+        canSplit = false;
+        break;
+      }
+      auto out = plan->getAst()->variables()->createTemporaryVariable();
+      dbServerAggregates.emplace_back(
+          std::make_pair(out, std::make_pair(it.second.first, step1)));
+      coordinatorAggregates.emplace_back(
+          std::make_pair(it.first, std::make_pair(out, step2)));
+    }
+
+    if (!canSplit) {
+      continue;
+    }
+
+    std::vector<std::pair<Variable const*, Variable const*>> dbServerGroups;
+    std::vector<std::pair<Variable const*, Variable const*>> coordinatorGroups;
+    std::unordered_map<Variable const*, Variable const*> replacements;
+
+    for (auto const& it : collectNode->groupVariables()) {
+      auto out = plan->getAst()->variables()->createTemporaryVariable();
+      dbServerGroups.emplace_back(std::make_pair(out, it.second));
+      coordinatorGroups.emplace_back(std::make_pair(it.first, out));
+      replacements.emplace(it.second, out);
+    }
+
+    // the GatherNode now sees the output of the partial COLLECT only
+    SortElementVector elements;
+    if (collectNode->aggregationMethod() ==
+        CollectOptions::CollectMethod::COLLECT_METHOD_SORTED) {
+      // the partial results must be merged in group order
+      for (auto const& it : gatherNode->getElements()) {
+        auto it2 = replacements.find(it.var);
+        if (it2 == replacements.end() || !it.attributePath.empty()) {
+          canSplit = false;
+          break;
+        }
+        elements.emplace_back((*it2).second, it.ascending);
+      }
+    }
+
+    if (!canSplit) {
+      continue;
+    }
+
+    gatherNode->setElements(elements);
+
+    // WITH COUNT INTO is counted on the DB servers, and the coordinator
+    // sums up the counts of all shards
+    Variable const* dbServerCount = nullptr;
+    if (collectNode->count()) {
+      dbServerCount = plan->getAst()->variables()->createTemporaryVariable();
+      coordinatorAggregates.emplace_back(std::make_pair(
+          collectNode->outVariable(),
+          std::make_pair(dbServerCount, std::string("SUM"))));
+    }
+
+    auto dbServerCollect = new CollectNode(
+        plan.get(), plan->nextId(), collectNode->getOptions(), dbServerGroups,
+        dbServerAggregates, nullptr, dbServerCount,
+        std::vector<Variable const*>(), collectNode->variableMap(),
+        dbServerCount != nullptr, collectNode->isDistinctCommand());
+    plan->registerNode(dbServerCollect);
+    dbServerCollect->specialized();
+
+    plan->insertDependency(gatherNode->getFirstDependency(), dbServerCollect);
+
+    if (collectNode->count()) {
+      collectNode->clearOutVariable();
+      if (collectNode->aggregationMethod() ==
+          CollectOptions::CollectMethod::COLLECT_METHOD_COUNT) {
+        // the coordinator now aggregates the counts
+        collectNode->aggregationMethod(
+            CollectOptions::CollectMethod::COLLECT_METHOD_SORTED);
+      }
+    }
+
+    collectNode->groupVariables(coordinatorGroups);
+    collectNode->aggregateVariables(coordinatorAggregates);
+
+    modified = true;
+  }
+
+  opt->addPlan(std::move(plan), rule, modified);
+}
+
+/// @brief copy a LIMIT that follows a GatherNode into the DB server snippet,
+/// below the RemoteNode and thus after a shard-local SORT. each shard then
+/// ships at most offset + limit rows to the coordinator, which still applies
+/// the original LIMIT to the merged rows
+/// this rule modifies the plan in place
+void arangodb::aql::distributeLimitToClusterRule(
+    Optimizer* opt, std::unique_ptr<ExecutionPlan> plan,
+    OptimizerRule const* rule) {
+  SmallVector<ExecutionNode*>::allocator_type::arena_type a;
+  SmallVector<ExecutionNode*> nodes{a};
+  plan->findNodesOfType(nodes, EN::GATHER, true);
+
+  bool modified = false;
+
+  for (auto& n : nodes) {
+    auto gatherNode = static_cast<GatherNode*>(n);
+
+    if (!gatherNode->hasParent() ||
+        gatherNode->getDependencies().size() != 1 ||
+        gatherNode->getFirstDependency()->getType() != EN::REMOTE) {
+      continue;
+    }
+
+    auto parent = gatherNode->getFirstParent();
+    while (parent != nullptr && parent->getType() == EN::CALCULATION) {
+      // calculations do not change the number of rows
+      parent = parent->getFirstParent();
+    }
+
+    if (parent == nullptr || parent->getType() != EN::LIMIT) {
+      continue;
+    }
+
+    auto limitNode = static_cast<LimitNode const*>(parent);
+
+    if (limitNode->fullCount()) {
+      // the limit needs to count all rows of all shards
+      continue;
+    }
+
+    size_t const offset = limitNode->offset();
+    size_t const limit = limitNode->limit();
+
+    if (limit == 0 || offset > SIZE_MAX - limit) {
+      continue;
+    }
+
+    // the snippet must not contain data-modification nodes, as these must
+    // process all their input rows
+    auto remoteNode = gatherNode->getFirstDependency();
+    auto dep = remoteNode->getFirstDependency();
+    bool suitable = true;
+
+    if (dep != nullptr && dep->getType() == EN::LIMIT) {
+      // already copied
+      continue;
+    }
+
+    while (dep != nullptr) {
+      auto const type = dep->getType();
+
+      if (dep->isModificationNode()) {
+        suitable = false;
+        break;
+      }
+
+      if (type == EN::SCATTER || type == EN::DISTRIBUTE ||
+          type == EN::REMOTE) {
+        // end of the snippet
+        break;
+      }
+
+      dep = dep->getFirstDependency();
+    }
+
+    if (!suitable) {
+      continue;
+    }
+
+    auto dbServerLimit =
+        new LimitNode(plan.get(), plan->nextId(), 0, offset + limit);
+    plan->registerNode(dbServerLimit);
+    plan->insertDependency(remoteNode, dbServerLimit);
+
+    modified = true;
+  }
+
+  opt->addPlan(std::move(plan), rule, modified);
+}
+
 /// @brief try to get rid of a RemoteNode->ScatterNode combination which has
 /// only a SingletonNode and possibly some CalculationNodes as dependencies
 void arangodb::aql::removeUnnecessaryRemoteScatterRule(
@@ -3062,6 +3620,9 @@ class RemoveToEnumCollFinder final : public WalkerWorker<ExecutionNode> {
       case EN::SORT:
       case EN::TRAVERSAL:
       case EN::SHORTEST_PATH:
+      case EN::HASH_JOIN:
+      case EN::MATERIALIZE:
+      case EN::HASH_LOOKUP:
       case EN::INDEX: {
         // if we meet any of the above, then we abort . . .
       }
@@ -3679,8 +4240,9 @@ void arangodb::aql::patchUpdateStatementsRule(Optimizer* opt,
         }
       }
 
-      if (type == EN::TRAVERSAL || type == EN::SHORTEST_PATH) {
-        // unclear what will be read by the traversal
+      if (type == EN::TRAVERSAL || type == EN::SHORTEST_PATH ||
+          type == EN::HASH_JOIN) {
+        // unclear what will be read by the traversal or join
         modified = false;
         break;
       }
@@ -3698,36 +4260,627 @@ void arangodb::aql::patchUpdateStatementsRule(Optimizer* opt,
   opt->addPlan(std::move(plan), rule, modified);
 }
 
-/// @brief optimizes away unused traversal output variables and
-/// merges filter nodes into graph traversal nodes
-void arangodb::aql::optimizeTraversalsRule(Optimizer* opt,
-                                           std::unique_ptr<ExecutionPlan> plan,
-                                           OptimizerRule const* rule) {
-  SmallVector<ExecutionNode*>::allocator_type::arena_type a;
-  SmallVector<ExecutionNode*> tNodes{a};
-  plan->findNodesOfType(tNodes, EN::TRAVERSAL, true);
+/// @brief make SORT nodes that are followed by a LIMIT only keep the first
+/// offset + limit rows
+void arangodb::aql::sortLimitRule(Optimizer* opt,
+                                  std::unique_ptr<ExecutionPlan> plan,
+                                  OptimizerRule const* rule) {
+  // larger limits are not worth it, as the sort will buffer this many rows
+  // anyway
+  static size_t const MaxSortLimit = 1000000;
 
-  if (tNodes.empty()) {
-    // no traversals present
-    opt->addPlan(std::move(plan), rule, false);
-    return;
-  }
+  SmallVector<ExecutionNode*>::allocator_type::arena_type a;
+  SmallVector<ExecutionNode*> nodes{a};
+  plan->findNodesOfType(nodes, EN::SORT, true);
 
   bool modified = false;
 
-  // first make a pass over all traversal nodes and remove unused
-  // variables from them
-  for (auto const& n : tNodes) {
-    TraversalNode* traversal = static_cast<TraversalNode*>(n);
+  for (auto const& n : nodes) {
+    auto sortNode = static_cast<SortNode*>(n);
 
-    auto varsUsedLater = n->getVarsUsedLater();
+    auto parent = n->getFirstParent();
+    while (parent != nullptr && parent->getType() == EN::CALCULATION) {
+      // calculations do not change the number of rows
+      parent = parent->getFirstParent();
+    }
 
-    // note that we can NOT optimize away the vertex output variable
-    // yet, as many traversal internals depend on the number of vertices
-    // found/built
-    auto outVariable = traversal->edgeOutVariable();
-    if (outVariable != nullptr &&
-        varsUsedLater.find(outVariable) == varsUsedLater.end()) {
+    if (parent == nullptr || parent->getType() != EN::LIMIT) {
+      continue;
+    }
+
+    auto limitNode = static_cast<LimitNode const*>(parent);
+
+    if (limitNode->fullCount()) {
+      // the limit needs to count all rows produced by the sort
+      continue;
+    }
+
+    size_t const offset = limitNode->offset();
+    size_t const limit = limitNode->limit();
+
+    if (limit == 0 || offset >= MaxSortLimit || limit >= MaxSortLimit - offset) {
+      continue;
+    }
+
+    sortNode->setLimit(offset + limit);
+    modified = true;
+  }
+
+  opt->addPlan(std::move(plan), rule, modified);
+}
+
+/// @brief check if cond is an equality comparison of an attribute of
+/// outVariable with an expression that only depends on the variables in
+/// varsValid. returns the expression and sets attribute to the attribute
+/// path if so, and returns a nullptr otherwise
+static AstNode const* findEquiJoinProbe(
+    AstNode const* cond, Variable const* outVariable,
+    std::unordered_set<Variable const*> const& varsValid,
+    std::vector<std::string>& attribute) {
+  if (cond->type != NODE_TYPE_OPERATOR_BINARY_EQ) {
+    return nullptr;
+  }
+
+  for (size_t i = 0; i < 2; ++i) {
+    AstNode const* lhs = cond->getMember(i);
+    AstNode const* rhs = cond->getMember(1 - i);
+
+    std::pair<Variable const*, std::vector<arangodb::basics::AttributeName>>
+        result;
+
+    if (lhs->type != NODE_TYPE_ATTRIBUTE_ACCESS ||
+        !lhs->isAttributeAccessForVariable(result) ||
+        result.first != outVariable ||
+        result.second[0].name == StaticStrings::IdString) {
+      continue;
+    }
+
+    bool expands = false;
+    for (auto const& it : result.second) {
+      expands |= it.shouldExpand;
+    }
+
+    // the probe value is calculated before the loop, so it must
+    // only depend on variables from outside the loop
+    if (expands || rhs->canThrow() || !rhs->isDeterministic()) {
+      continue;
+    }
+
+    std::unordered_set<Variable const*> vars;
+    Ast::getReferencedVariables(rhs, vars);
+
+    bool valid = true;
+    for (auto const& v : vars) {
+      if (varsValid.find(v) == varsValid.end()) {
+        valid = false;
+        break;
+      }
+    }
+
+    if (valid) {
+      TRI_ASSERT(attribute.empty());
+      for (auto const& it : result.second) {
+        attribute.emplace_back(it.name);
+      }
+      return rhs;
+    }
+  }
+
+  return nullptr;
+}
+
+/// @brief whether or not the collection is modified by one of the
+/// data-modification nodes
+static bool isModifiedByQuery(
+    Collection const* collection,
+    SmallVector<ExecutionNode*> const& modificationNodes) {
+  for (auto const& m : modificationNodes) {
+    if (static_cast<ModificationNode const*>(m)->collection() == collection) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/// @brief replace the inner EnumerateCollectionNode of an equi-join with a
+/// HashJoinNode, so the inner collection is scanned once instead of once per
+/// outer row
+void arangodb::aql::hashJoinRule(Optimizer* opt,
+                                 std::unique_ptr<ExecutionPlan> plan,
+                                 OptimizerRule const* rule) {
+  // the hash table is kept in memory, so don't build it for huge collections
+  static size_t const MaxBuildSize = 1000000;
+
+  if (arangodb::ServerState::instance()->isCoordinator()) {
+    // collections are scanned on the DB servers
+    opt->addPlan(std::move(plan), rule, false);
+    return;
+  }
+
+  SmallVector<ExecutionNode*>::allocator_type::arena_type a;
+  SmallVector<ExecutionNode*> nodes{a};
+  plan->findNodesOfType(nodes, EN::ENUMERATE_COLLECTION, true);
+
+  SmallVector<ExecutionNode*>::allocator_type::arena_type b;
+  SmallVector<ExecutionNode*> modificationNodes{b};
+  std::vector<ExecutionNode::NodeType> const modificationTypes{
+      EN::INSERT, EN::UPDATE, EN::REPLACE, EN::REMOVE, EN::UPSERT};
+  plan->findNodesOfType(modificationNodes, modificationTypes, true);
+
+  bool modified = false;
+
+  for (auto const& n : nodes) {
+    auto en = static_cast<EnumerateCollectionNode*>(n);
+
+    if (!en->isDeterministic() || en->getLoop() == nullptr) {
+      // random iteration, or nothing to join with
+      continue;
+    }
+
+    auto collection = en->collection();
+
+    if (collection->count() > MaxBuildSize) {
+      continue;
+    }
+
+    if (isModifiedByQuery(collection, modificationNodes)) {
+      // the hash table would not reflect modifications made by the query
+      continue;
+    }
+
+    // compare the costs of scanning the collection for each incoming row
+    // and of building the hash table once
+    size_t incoming = 0;
+    en->getFirstDependency()->getCost(incoming);
+    double const count = static_cast<double>(collection->count());
+
+    if (static_cast<double>(incoming) * count <= 1.5 * count + incoming) {
+      continue;
+    }
+
+    auto outVariable = en->outVariable();
+    auto const& varsValid = en->getFirstDependency()->getVarsValid();
+
+    AstNode const* probe = nullptr;
+    std::vector<std::string> attribute;
+
+    auto current = en->getFirstParent();
+
+    while (current != nullptr && probe == nullptr &&
+           (current->getType() == EN::CALCULATION ||
+            current->getType() == EN::FILTER)) {
+      if (current->getType() == EN::FILTER) {
+        auto inVars = current->getVariablesUsedHere();
+        TRI_ASSERT(inVars.size() == 1);
+        auto setter = plan->getVarSetBy(inVars[0]->id);
+
+        if (setter != nullptr && setter->getType() == EN::CALCULATION) {
+          AstNode const* cond =
+              static_cast<CalculationNode*>(setter)->expression()->node();
+
+          probe = findEquiJoinProbe(cond, outVariable, varsValid, attribute);
+        }
+      }
+
+      current = current->getFirstParent();
+    }
+
+    if (probe == nullptr) {
+      continue;
+    }
+
+    // calculate the probe value before the join. the FILTER still owns
+    // the condition, so the new calculation gets its own copy
+    auto probeVariable = plan->getAst()->variables()->createTemporaryVariable();
+    auto expression =
+        new Expression(plan->getAst(), probe->clone(plan->getAst()));
+    ExecutionNode* calculationNode = nullptr;
+    try {
+      calculationNode = new CalculationNode(plan.get(), plan->nextId(),
+                                            expression, probeVariable);
+    } catch (...) {
+      delete expression;
+      throw;
+    }
+    plan->registerNode(calculationNode);
+    plan->insertDependency(en, calculationNode);
+
+    // the FILTER is kept, so the join condition is still checked for
+    // the documents produced by the hash join
+    auto hashJoinNode =
+        new HashJoinNode(plan.get(), plan->nextId(), en->vocbase(),
+                         const_cast<Collection*>(collection), outVariable,
+                         probeVariable, attribute);
+    plan->registerNode(hashJoinNode);
+    plan->replaceNode(en, hashJoinNode);
+
+    // variable usage must be recalculated for the new nodes
+    plan->findVarUsage();
+    modified = true;
+  }
+
+  opt->addPlan(std::move(plan), rule, modified);
+}
+
+/// @brief replace correlated subqueries of the form
+/// (FOR doc IN collection FILTER doc.attribute == expression RETURN doc)
+/// with a HashLookupNode, so the collection is scanned once instead of
+/// executing the subquery once per outer row
+void arangodb::aql::decorrelateSubqueriesRule(
+    Optimizer* opt, std::unique_ptr<ExecutionPlan> plan,
+    OptimizerRule const* rule) {
+  // the hash table is kept in memory, so don't build it for huge collections
+  static size_t const MaxBuildSize = 1000000;
+
+  if (arangodb::ServerState::instance()->isCoordinator()) {
+    // collections are scanned on the DB servers
+    opt->addPlan(std::move(plan), rule, false);
+    return;
+  }
+
+  SmallVector<ExecutionNode*>::allocator_type::arena_type a;
+  SmallVector<ExecutionNode*> nodes{a};
+  plan->findNodesOfType(nodes, EN::SUBQUERY, true);
+
+  SmallVector<ExecutionNode*>::allocator_type::arena_type b;
+  SmallVector<ExecutionNode*> modificationNodes{b};
+  std::vector<ExecutionNode::NodeType> const modificationTypes{
+      EN::INSERT, EN::UPDATE, EN::REPLACE, EN::REMOVE, EN::UPSERT};
+  plan->findNodesOfType(modificationNodes, modificationTypes, true);
+
+  bool modified = false;
+
+  for (auto const& n : nodes) {
+    auto sn = static_cast<SubqueryNode*>(n);
+
+    // the subquery must consist of exactly
+    // SINGLETON -> ENUMERATE_COLLECTION -> CALCULATION -> FILTER -> RETURN
+    ExecutionNode* returnNode = sn->getSubquery();
+
+    if (returnNode->getType() != EN::RETURN) {
+      continue;
+    }
+
+    ExecutionNode* filterNode = returnNode->getFirstDependency();
+
+    if (filterNode == nullptr || filterNode->getType() != EN::FILTER) {
+      continue;
+    }
+
+    ExecutionNode* setter = filterNode->getFirstDependency();
+
+    if (setter == nullptr || setter->getType() != EN::CALCULATION) {
+      continue;
+    }
+
+    ExecutionNode* current = setter->getFirstDependency();
+
+    if (current == nullptr || current->getType() != EN::ENUMERATE_COLLECTION ||
+        current->getFirstDependency() == nullptr ||
+        current->getFirstDependency()->getType() != EN::SINGLETON) {
+      continue;
+    }
+
+    auto en = static_cast<EnumerateCollectionNode*>(current);
+    auto calculationNode = static_cast<CalculationNode*>(setter);
+    auto outVariable = en->outVariable();
+
+    if (!en->isDeterministic() ||
+        returnNode->getVariablesUsedHere()[0] != outVariable ||
+        filterNode->getVariablesUsedHere()[0] !=
+            calculationNode->outVariable()) {
+      // random iteration, or the subquery does not return the documents
+      continue;
+    }
+
+    auto collection = en->collection();
+
+    if (collection->count() > MaxBuildSize ||
+        isModifiedByQuery(collection, modificationNodes)) {
+      continue;
+    }
+
+    // compare the costs of executing the subquery for each incoming row
+    // and of building the hash table once
+    size_t incoming = 0;
+    sn->getFirstDependency()->getCost(incoming);
+    double const count = static_cast<double>(collection->count());
+
+    if (static_cast<double>(incoming) * count <= 1.5 * count + incoming) {
+      continue;
+    }
+
+    // the probe value is calculated before the subquery from the variables
+    // of the outer query
+    std::vector<std::string> attribute;
+    AstNode const* probe = findEquiJoinProbe(
+        calculationNode->expression()->node(), outVariable,
+        sn->getFirstDependency()->getVarsValid(), attribute);
+
+    if (probe == nullptr) {
+      continue;
+    }
+
+    auto probeVariable = plan->getAst()->variables()->createTemporaryVariable();
+    auto expression =
+        new Expression(plan->getAst(), probe->clone(plan->getAst()));
+    ExecutionNode* probeNode = nullptr;
+    try {
+      probeNode = new CalculationNode(plan.get(), plan->nextId(), expression,
+                                      probeVariable);
+    } catch (...) {
+      delete expression;
+      throw;
+    }
+    plan->registerNode(probeNode);
+
+    // the HashLookupNode produces the subquery result
+    auto hashLookupNode =
+        new HashLookupNode(plan.get(), plan->nextId(), en->vocbase(),
+                           const_cast<Collection*>(collection),
+                           sn->outVariable(), probeVariable, attribute);
+    plan->registerNode(hashLookupNode);
+    plan->replaceNode(sn, hashLookupNode);
+    plan->insertDependency(hashLookupNode, probeNode);
+
+    // variable usage must be recalculated for the new nodes
+    plan->findVarUsage();
+    modified = true;
+  }
+
+  opt->addPlan(std::move(plan), rule, modified);
+}
+
+/// @brief let IndexNodes only produce document tokens if the documents are
+/// not used before a LIMIT, and read the documents after the LIMIT
+void arangodb::aql::lateDocumentMaterializationRule(
+    Optimizer* opt, std::unique_ptr<ExecutionPlan> plan,
+    OptimizerRule const* rule) {
+  if (arangodb::ServerState::instance()->isCoordinator()) {
+    // document tokens cannot be passed between servers
+    opt->addPlan(std::move(plan), rule, false);
+    return;
+  }
+
+  SmallVector<ExecutionNode*>::allocator_type::arena_type a;
+  SmallVector<ExecutionNode*> nodes{a};
+  plan->findNodesOfType(nodes, EN::INDEX, true);
+
+  bool modified = false;
+
+  for (auto const& n : nodes) {
+    auto indexNode = static_cast<IndexNode*>(n);
+
+    if (indexNode->isLateMaterialized() || indexNode->isCovering()) {
+      continue;
+    }
+
+    // find the first node that uses the documents
+    auto current = MaterializeNode::findMaterializationPoint(
+        indexNode, indexNode->outVariable());
+
+    if (current == nullptr) {
+      continue;
+    }
+
+    auto tokenVariable = plan->getAst()->variables()->createTemporaryVariable();
+    indexNode->setLateMaterialized(tokenVariable);
+
+    auto materializeNode =
+        new MaterializeNode(plan.get(), plan->nextId(), indexNode->collection(),
+                            tokenVariable, indexNode->outVariable());
+    plan->registerNode(materializeNode);
+    plan->insertDependency(current, materializeNode);
+
+    modified = true;
+  }
+
+  if (modified) {
+    plan->findVarUsage();
+  }
+
+  opt->addPlan(std::move(plan), rule, modified);
+}
+
+/// @brief let IndexNodes build the used document attributes from the index
+/// values if the index contains all of them
+void arangodb::aql::useCoveringIndexRule(Optimizer* opt,
+                                         std::unique_ptr<ExecutionPlan> plan,
+                                         OptimizerRule const* rule) {
+  SmallVector<ExecutionNode*>::allocator_type::arena_type a;
+  SmallVector<ExecutionNode*> nodes{a};
+  plan->findNodesOfType(nodes, EN::INDEX, true);
+
+  bool modified = false;
+
+  for (auto const& n : nodes) {
+    auto indexNode = static_cast<IndexNode*>(n);
+
+    if (indexNode->isLateMaterialized() || indexNode->isCovering()) {
+      continue;
+    }
+
+    auto const& indexes = indexNode->getIndexes();
+
+    if (indexes.size() != 1) {
+      // the values of different indexes cannot be combined
+      continue;
+    }
+
+    auto index = indexes[0].getIndex();
+    auto const type = index->type();
+
+    if (type != arangodb::Index::TRI_IDX_TYPE_HASH_INDEX &&
+        type != arangodb::Index::TRI_IDX_TYPE_SKIPLIST_INDEX) {
+      // only these indexes store the values of the indexed attributes
+      continue;
+    }
+
+    // only top-level attributes can be turned into projections
+    std::vector<std::string> projections;
+    for (auto const& field : index->fields()) {
+      if (field.size() != 1 || field[0].shouldExpand ||
+          field[0].name == StaticStrings::IdString) {
+        projections.clear();
+        break;
+      }
+      projections.emplace_back(field[0].name);
+    }
+
+    if (projections.empty()) {
+      continue;
+    }
+
+    // all nodes using the documents must be calculations that only access
+    // indexed attributes of them
+    auto outVariable = indexNode->outVariable();
+    bool covered = true;
+    ExecutionNode* current = n->getFirstParent();
+
+    while (current != nullptr && covered) {
+      std::unordered_set<Variable const*> vars;
+      current->getVariablesUsedHere(vars);
+
+      if (vars.find(outVariable) != vars.end()) {
+        if (current->getType() != EN::CALCULATION) {
+          covered = false;
+          break;
+        }
+
+        bool isSafe = false;
+        auto attributes = Ast::getReferencedAttributes(
+            static_cast<CalculationNode*>(current)->expression()->node(),
+            isSafe);
+
+        auto it = attributes.find(outVariable);
+
+        if (!isSafe || it == attributes.end()) {
+          covered = false;
+          break;
+        }
+
+        for (auto const& name : (*it).second) {
+          if (std::find(projections.begin(), projections.end(), name) ==
+              projections.end()) {
+            covered = false;
+            break;
+          }
+        }
+      }
+
+      current = current->getFirstParent();
+    }
+
+    if (!covered) {
+      continue;
+    }
+
+    indexNode->setProjections(projections);
+    modified = true;
+  }
+
+  opt->addPlan(std::move(plan), rule, modified);
+}
+
+/// @brief replace a full collection scan that is followed by a COLLECT WITH
+/// COUNT INTO without groups with a calculation of COLLECTION_COUNT, which
+/// takes the number of documents from the collection's metadata
+/// this rule modifies the plan in place
+void arangodb::aql::useCollectionCountRule(Optimizer* opt,
+                                           std::unique_ptr<ExecutionPlan> plan,
+                                           OptimizerRule const* rule) {
+  if (arangodb::ServerState::instance()->isCoordinator()) {
+    // the document counts are only available on the DB servers. in the
+    // cluster, the COLLECT is split, and each shard counts its documents
+    // by skipping them in the primary index
+    opt->addPlan(std::move(plan), rule, false);
+    return;
+  }
+
+  SmallVector<ExecutionNode*>::allocator_type::arena_type a;
+  SmallVector<ExecutionNode*> nodes{a};
+  plan->findNodesOfType(nodes, EN::COLLECT, true);
+
+  bool modified = false;
+
+  for (auto const& n : nodes) {
+    auto collectNode = static_cast<CollectNode*>(n);
+
+    if (!collectNode->count() || !collectNode->groupVariables().empty() ||
+        !collectNode->aggregateVariables().empty() ||
+        collectNode->hasExpressionVariable()) {
+      continue;
+    }
+
+    auto dep = collectNode->getFirstDependency();
+
+    if (dep == nullptr || dep->getType() != EN::ENUMERATE_COLLECTION) {
+      continue;
+    }
+
+    // the COLLECT produces one row per input row of the scan, in which the
+    // scan's variable is not visible anymore. this is exactly what the
+    // calculation produces
+    auto enumerateNode = static_cast<EnumerateCollectionNode const*>(dep);
+    auto ast = plan->getAst();
+
+    auto args = ast->createNodeArray();
+    std::string const& name = enumerateNode->collection()->name;
+    args->addMember(ast->createNodeValueString(
+        ast->query()->registerString(name), name.size()));
+    auto count = ast->createNodeFunctionCall("COLLECTION_COUNT", args);
+
+    ExecutionNode* calculationNode = nullptr;
+    auto expression = new Expression(ast, count);
+    try {
+      calculationNode =
+          new CalculationNode(plan.get(), plan->nextId(), expression,
+                              collectNode->outVariable());
+    } catch (...) {
+      delete expression;
+      throw;
+    }
+    plan->registerNode(calculationNode);
+
+    plan->unlinkNode(dep);
+    plan->replaceNode(collectNode, calculationNode);
+
+    modified = true;
+  }
+
+  opt->addPlan(std::move(plan), rule, modified);
+}
+
+/// @brief optimizes away unused traversal output variables and parts of
+/// paths, and merges filter nodes into graph traversal nodes
+void arangodb::aql::optimizeTraversalsRule(Optimizer* opt,
+                                           std::unique_ptr<ExecutionPlan> plan,
+                                           OptimizerRule const* rule) {
+  SmallVector<ExecutionNode*>::allocator_type::arena_type a;
+  SmallVector<ExecutionNode*> tNodes{a};
+  plan->findNodesOfType(tNodes, EN::TRAVERSAL, true);
+
+  if (tNodes.empty()) {
+    // no traversals present
+    opt->addPlan(std::move(plan), rule, false);
+    return;
+  }
+
+  bool modified = false;
+
+  // first make a pass over all traversal nodes and remove unused
+  // variables from them
+  for (auto const& n : tNodes) {
+    TraversalNode* traversal = static_cast<TraversalNode*>(n);
+
+    auto varsUsedLater = n->getVarsUsedLater();
+
+    // note that we can NOT optimize away the vertex output variable
+    // yet, as many traversal internals depend on the number of vertices
+    // found/built
+    auto outVariable = traversal->edgeOutVariable();
+    if (outVariable != nullptr &&
+        varsUsedLater.find(outVariable) == varsUsedLater.end()) {
       // traversal edge outVariable not used later
       traversal->setEdgeOutput(nullptr);
       modified = true;
@@ -3754,6 +4907,72 @@ void arangodb::aql::optimizeTraversalsRule(Optimizer* opt,
     }
   }
 
+  // finally only produce the parts of the paths that are accessed later.
+  // building the vertices of a path requires looking up their documents
+  for (auto const& n : tNodes) {
+    TraversalNode* traversal = static_cast<TraversalNode*>(n);
+    auto pathVariable = traversal->pathOutVariable();
+
+    if (pathVariable == nullptr) {
+      continue;
+    }
+
+    auto options = traversal->options();
+
+    if (!options->producePathVertices || !options->producePathEdges) {
+      // already reduced
+      continue;
+    }
+
+    // all nodes using the path must be calculations that only access
+    // attributes of it
+    bool usesVertices = false;
+    bool usesEdges = false;
+    bool isSafe = true;
+    ExecutionNode* current = n->getFirstParent();
+
+    while (current != nullptr) {
+      std::unordered_set<Variable const*> vars;
+      current->getVariablesUsedHere(vars);
+
+      if (vars.find(pathVariable) != vars.end()) {
+        if (current->getType() != EN::CALCULATION) {
+          isSafe = false;
+          break;
+        }
+
+        auto attributes = Ast::getReferencedAttributes(
+            static_cast<CalculationNode*>(current)->expression()->node(),
+            isSafe);
+
+        auto it = attributes.find(pathVariable);
+
+        if (!isSafe || it == attributes.end()) {
+          isSafe = false;
+          break;
+        }
+
+        for (auto const& name : (*it).second) {
+          if (name == "vertices") {
+            usesVertices = true;
+          } else if (name == "edges") {
+            usesEdges = true;
+          }
+        }
+      }
+
+      current = current->getFirstParent();
+    }
+
+    if (!isSafe || (usesVertices && usesEdges)) {
+      continue;
+    }
+
+    options->producePathVertices = usesVertices;
+    options->producePathEdges = usesEdges;
+    modified = true;
+  }
+
   opt->addPlan(std::move(plan), rule, modified);
 }
 
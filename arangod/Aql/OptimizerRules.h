@@ -137,6 +137,17 @@ void distributeFilternCalcToClusterRule(Optimizer*, std::unique_ptr<ExecutionPla
 void distributeSortToClusterRule(Optimizer*, std::unique_ptr<ExecutionPlan>,
                                  OptimizerRule const*);
 
+/// @brief split a COLLECT right after a GatherNode into a partial COLLECT
+/// on the DB servers and a COLLECT that merges the partial results on the
+/// coordinator
+void collectInClusterRule(Optimizer*, std::unique_ptr<ExecutionPlan>,
+                          OptimizerRule const*);
+
+/// @brief copy a LIMIT after a GatherNode into the DB server snippets, so
+/// that each shard produces at most offset + limit rows
+void distributeLimitToClusterRule(Optimizer*, std::unique_ptr<ExecutionPlan>,
+                                  OptimizerRule const*);
+
 /// @brief try to get rid of a RemoteNode->ScatterNode combination which has
 /// only a SingletonNode and possibly some CalculationNodes as dependencies
 void removeUnnecessaryRemoteScatterRule(Optimizer*, std::unique_ptr<ExecutionPlan>,
@@ -190,8 +201,38 @@ void removeDataModificationOutVariablesRule(Optimizer*, std::unique_ptr<Executio
 void patchUpdateStatementsRule(Optimizer*, std::unique_ptr<ExecutionPlan>,
                                OptimizerRule const*);
 
-/// @brief optimizes away unused traversal output variables and
-/// merges filter nodes into graph traversal nodes
+/// @brief make SORT nodes that are followed by a LIMIT only keep the first
+/// offset + limit rows
+void sortLimitRule(Optimizer*, std::unique_ptr<ExecutionPlan>,
+                   OptimizerRule const*);
+
+/// @brief replace the inner EnumerateCollectionNode of an equi-join with a
+/// HashJoinNode
+void hashJoinRule(Optimizer*, std::unique_ptr<ExecutionPlan>,
+                  OptimizerRule const*);
+
+/// @brief replace correlated subqueries that look up documents by an
+/// attribute value with a HashLookupNode
+void decorrelateSubqueriesRule(Optimizer*, std::unique_ptr<ExecutionPlan>,
+                               OptimizerRule const*);
+
+/// @brief let IndexNodes build the used document attributes from the index
+/// values if the index contains all of them
+void useCoveringIndexRule(Optimizer*, std::unique_ptr<ExecutionPlan>,
+                          OptimizerRule const*);
+
+/// @brief let IndexNodes only produce document tokens if the documents are
+/// not used before a LIMIT, and read the documents after the LIMIT
+void lateDocumentMaterializationRule(Optimizer*, std::unique_ptr<ExecutionPlan>,
+                                     OptimizerRule const*);
+
+/// @brief take the result of a COLLECT WITH COUNT INTO that directly follows
+/// a collection scan from the collection's document count
+void useCollectionCountRule(Optimizer*, std::unique_ptr<ExecutionPlan>,
+                            OptimizerRule const*);
+
+/// @brief optimizes away unused traversal output variables and parts of
+/// paths, and merges filter nodes into graph traversal nodes
 void optimizeTraversalsRule(Optimizer* opt, std::unique_ptr<ExecutionPlan> plan,
                             OptimizerRule const* rule);
 
@@ -213,6 +213,18 @@ void OptimizerRulesFeature::addRules() {
   registerRule("sort-in-values", sortInValuesRule, OptimizerRule::sortInValuesRule_pass6,
                DoesNotCreateAdditionalPlans, CanBeDisabled);
 
+  // replace nested loops for equi-joins with hash joins (note: must come
+  // after the use-indexes rule, so index lookups are preferred)
+  registerRule("hash-join", hashJoinRule, OptimizerRule::hashJoinRule_pass6,
+               DoesNotCreateAdditionalPlans, CanBeDisabled);
+
+  // replace correlated subqueries that look up documents by an attribute
+  // value with hash lookups (note: must come after the use-indexes rule,
+  // so index lookups are preferred)
+  registerRule("decorrelate-subqueries", decorrelateSubqueriesRule,
+               OptimizerRule::decorrelateSubqueriesRule_pass6,
+               DoesNotCreateAdditionalPlans, CanBeDisabled);
+
   // remove calculations that are never necessary
   registerRule("remove-unnecessary-calculations-2",
                removeUnnecessaryCalculationsRule,
@@ -226,6 +238,25 @@ void OptimizerRulesFeature::addRules() {
   registerRule("patch-update-statements", patchUpdateStatementsRule,
                OptimizerRule::patchUpdateStatementsRule_pass9, DoesNotCreateAdditionalPlans, CanBeDisabled);
 
+  // let sorts that are followed by a limit only keep the rows they return
+  registerRule("sort-limit", sortLimitRule,
+               OptimizerRule::sortLimitRule_pass9, DoesNotCreateAdditionalPlans, CanBeDisabled);
+
+  // take document attributes from the index values if possible
+  registerRule("use-covering-index", useCoveringIndexRule,
+               OptimizerRule::useCoveringIndexRule_pass9,
+               DoesNotCreateAdditionalPlans, CanBeDisabled);
+
+  // read documents found in indexes only for rows that pass a limit
+  registerRule("late-document-materialization", lateDocumentMaterializationRule,
+               OptimizerRule::lateDocumentMaterializationRule_pass9,
+               DoesNotCreateAdditionalPlans, CanBeDisabled);
+
+  // count the documents of a collection from its metadata
+  registerRule("use-collection-count", useCollectionCountRule,
+               OptimizerRule::useCollectionCountRule_pass9,
+               DoesNotCreateAdditionalPlans, CanBeDisabled);
+
   if (arangodb::ServerState::instance()->isCoordinator()) {
     // distribute operations in cluster
     registerRule("scatter-in-cluster", scatterInClusterRule,
@@ -242,6 +273,12 @@ void OptimizerRulesFeature::addRules() {
     registerRule("distribute-sort-to-cluster", distributeSortToClusterRule,
                  OptimizerRule::distributeSortToClusterRule_pass10, DoesNotCreateAdditionalPlans, CanBeDisabled);
 
+    registerRule("collect-in-cluster", collectInClusterRule,
+                 OptimizerRule::collectInClusterRule_pass10, DoesNotCreateAdditionalPlans, CanBeDisabled);
+
+    registerRule("distribute-limit-to-cluster", distributeLimitToClusterRule,
+                 OptimizerRule::distributeLimitToClusterRule_pass10, DoesNotCreateAdditionalPlans, CanBeDisabled);
+
     registerRule("remove-unnecessary-remote-scatter",
                  removeUnnecessaryRemoteScatterRule,
                  OptimizerRule::removeUnnecessaryRemoteScatterRule_pass10, DoesNotCreateAdditionalPlans, CanBeDisabled);
@@ -23,21 +23,152 @@
 
 #include "PlanCache.h"
 #include "Aql/Ast.h"
+#include "Aql/AstNode.h"
 #include "Aql/ExecutionPlan.h"
 #include "Aql/Query.h"
+#include "Basics/Exceptions.h"
 #include "Basics/ReadLocker.h"
+#include "Basics/VelocyPackHelper.h"
 #include "Basics/WriteLocker.h"
+#include "Basics/fasthash.h"
+#include "VocBase/ticks.h"
 #include "VocBase/vocbase.h"
 
 #include <velocypack/Builder.h>
+#include <velocypack/Iterator.h>
+#include <velocypack/velocypack-aliases.h>
 
+using namespace arangodb;
 using namespace arangodb::aql;
 
 /// @brief singleton instance of the plan cache
 static arangodb::aql::PlanCache Instance;
 
+/// @brief maximum number of cached plans per database
+size_t const PlanCache::MaxPlansPerDatabase = 1024;
+
+namespace {
+
+/// @brief whether or not the value of a bind parameter can be substituted
+/// into a cached plan. collection parameters and array or object values
+/// are always part of the cache key
+bool isSubstitutable(std::string const& name, VPackSlice value) {
+  return (!name.empty() && name[0] != '@' &&
+          (value.isNumber() || value.isString()));
+}
+
+/// @brief find the substitutable bind parameter with the given value.
+/// returns an empty string if there is none or if the value is ambiguous
+std::string findParameter(VPackSlice value, VPackSlice bindParameters) {
+  std::string result;
+
+  for (auto const& it : VPackObjectIterator(bindParameters)) {
+    std::string name = it.key.copyString();
+
+    if (!isSubstitutable(name, it.value) ||
+        it.value.isNumber() != value.isNumber() ||
+        it.value.isString() != value.isString() ||
+        basics::VelocyPackHelper::compare(value, it.value, false) != 0) {
+      continue;
+    }
+
+    if (!result.empty()) {
+      // two parameters with the same value
+      return std::string();
+    }
+    result = std::move(name);
+  }
+
+  return result;
+}
+
+/// @brief recursively replace bind parameter values with placeholders.
+/// values inside arrays are left alone, because the optimizer may have
+/// sorted the array based on the values
+void parameterize(VPackSlice slice, VPackSlice bindParameters,
+                  VPackBuilder& builder, bool inArray) {
+  if (slice.isArray()) {
+    builder.openArray();
+    for (auto const& it : VPackArrayIterator(slice)) {
+      parameterize(it, bindParameters, builder, inArray);
+    }
+    builder.close();
+    return;
+  }
+
+  if (!slice.isObject()) {
+    builder.add(slice);
+    return;
+  }
+
+  VPackSlice type = slice.get("type");
+
+  if (!inArray && type.isString() && type.isEqualString("value") &&
+      slice.get("bindParameter").isTrue()) {
+    std::string name = findParameter(slice.get("value"), bindParameters);
+
+    if (!name.empty()) {
+      builder.openObject();
+      for (auto const& it : VPackObjectIterator(slice)) {
+        if (it.key.isEqualString("value") || it.key.isEqualString("vType") ||
+            it.key.isEqualString("vTypeID") ||
+            it.key.isEqualString("bindParameter")) {
+          continue;
+        }
+        builder.add(it.key.copyString(), it.value);
+      }
+      builder.add("bindParameter", VPackValue(name));
+      builder.close();
+      return;
+    }
+  }
+
+  bool isArray = (type.isString() && type.isEqualString("array"));
+
+  builder.openObject();
+  for (auto const& it : VPackObjectIterator(slice)) {
+    builder.add(VPackValue(it.key.copyString()));
+    parameterize(it.value, bindParameters, builder, inArray || isArray);
+  }
+  builder.close();
+}
+
+/// @brief count the placeholders per bind parameter in a parameterized plan
+void countPlaceholders(VPackSlice slice,
+                       std::unordered_map<std::string, size_t>& counts) {
+  if (slice.isArray()) {
+    for (auto const& it : VPackArrayIterator(slice)) {
+      countPlaceholders(it, counts);
+    }
+    return;
+  }
+
+  if (!slice.isObject()) {
+    return;
+  }
+
+  VPackSlice parameter = slice.get("bindParameter");
+  if (parameter.isString()) {
+    ++counts[parameter.copyString()];
+    return;
+  }
+
+  for (auto const& it : VPackObjectIterator(slice)) {
+    countPlaceholders(it.value, counts);
+  }
+}
+
+/// @brief whether or not an attribute is ignored when comparing plans.
+/// these are derived from the plan structure, and their order is not stable
+bool isIgnored(VPackSlice key) {
+  return (key.isEqualString("varsUsedLater") ||
+          key.isEqualString("varsValid") || key.isEqualString("regsToClear"));
+}
+
+}
+
 /// @brief create the plan cache
-PlanCache::PlanCache() : _lock(), _plans() {}
+PlanCache::PlanCache() : _lock(), _plans(), _prepared() {}
 
 /// @brief destroy the plan cache
 PlanCache::~PlanCache() {}
@@ -62,16 +193,34 @@ std::shared_ptr<PlanCacheEntry> PlanCache::lookup(TRI_vocbase_t* vocbase, uint64
     return std::shared_ptr<PlanCacheEntry>();
   }
 
+  // make sure the hash value did not collide
+  std::shared_ptr<PlanCacheEntry> const& entry = (*it2).second;
+
+  if (entry->queryString.size() != queryStringLength ||
+      memcmp(entry->queryString.data(), queryString, queryStringLength) != 0) {
+    return std::shared_ptr<PlanCacheEntry>();
+  }
+
   // plan found in cache
-  return (*it2).second;
+  return entry;
 }
 
 /// @brief store a plan in the cache
 void PlanCache::store(
     TRI_vocbase_t* vocbase, uint64_t hash, char const* queryString,
     size_t queryStringLength, ExecutionPlan const* plan) {
- 
-  auto entry = std::make_unique<PlanCacheEntry>(std::string(queryString, queryStringLength), plan->toVelocyPack(plan->getAst(), true)); 
+  store(vocbase, hash, queryString, queryStringLength,
+        plan->toVelocyPack(plan->getAst(), true), false);
+}
+
+/// @brief store a serialized plan in the cache
+void PlanCache::store(TRI_vocbase_t* vocbase, uint64_t hash,
+                      char const* queryString, size_t queryStringLength,
+                      std::shared_ptr<VPackBuilder> builder,
+                      bool isModificationQuery) {
+  auto entry = std::make_unique<PlanCacheEntry>(
+      std::string(queryString, queryStringLength), builder,
+      isModificationQuery);
 
   WRITE_LOCKER(writeLocker, _lock);
 
@@ -80,6 +229,9 @@ void PlanCache::store(
   if (it == _plans.end()) {
     // create entry for the current database
     it = _plans.emplace(vocbase, std::unordered_map<uint64_t, std::shared_ptr<PlanCacheEntry>>()).first;
+  } else if ((*it).second.size() >= MaxPlansPerDatabase) {
+    // start over if the cache for the database is full
+    (*it).second.clear();
   }
 
   // store cache entry
@@ -93,6 +245,277 @@ void PlanCache::invalidate(TRI_vocbase_t* vocbase) {
   _plans.erase(vocbase);
 }
 
+/// @brief remove all plans and prepared queries of a dropped database
+void PlanCache::drop(TRI_vocbase_t* vocbase) {
+  WRITE_LOCKER(writeLocker, _lock);
+
+  _plans.erase(vocbase);
+  _prepared.erase(vocbase);
+}
+
+/// @brief register a prepared query string and return its id
+uint64_t PlanCache::prepare(TRI_vocbase_t* vocbase,
+                            std::string const& queryString) {
+  uint64_t id = TRI_NewTickServer();
+
+  WRITE_LOCKER(writeLocker, _lock);
+
+  _prepared[vocbase].emplace(id, queryString);
+  return id;
+}
+
+/// @brief look up the query string of a prepared query
+bool PlanCache::preparedQuery(TRI_vocbase_t* vocbase, uint64_t id,
+                              std::string& queryString) {
+  READ_LOCKER(readLocker, _lock);
+
+  auto it = _prepared.find(vocbase);
+
+  if (it == _prepared.end()) {
+    return false;
+  }
+
+  auto it2 = (*it).second.find(id);
+
+  if (it2 == (*it).second.end()) {
+    return false;
+  }
+
+  queryString = (*it2).second;
+  return true;
+}
+
+/// @brief remove a prepared query. returns false if it does not exist
+bool PlanCache::unprepare(TRI_vocbase_t* vocbase, uint64_t id) {
+  WRITE_LOCKER(writeLocker, _lock);
+
+  auto it = _prepared.find(vocbase);
+
+  if (it == _prepared.end()) {
+    return false;
+  }
+
+  return ((*it).second.erase(id) > 0);
+}
+
+/// @brief calculate the hash value for a cache key
+uint64_t PlanCache::hashKey(std::string const& key) {
+  return fasthash64(key.data(), key.size(), 0x3123456789abcdef);
+}
+
+/// @brief whether or not the query has bind parameters whose values can be
+/// substituted into a cached plan
+bool PlanCache::hasSubstitutableParameters(VPackSlice bindParameters) {
+  if (!bindParameters.isObject()) {
+    return false;
+  }
+
+  for (auto const& it : VPackObjectIterator(bindParameters)) {
+    if (isSubstitutable(it.key.copyString(), it.value)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/// @brief append the bind parameters to a cache key. substitutable
+/// parameters contribute only their type unless byValue is set
+void PlanCache::buildSignature(VPackBuilder& builder,
+                               VPackSlice bindParameters, bool byValue) {
+  builder.openArray();
+  builder.add(VPackValue(byValue));
+
+  if (bindParameters.isObject()) {
+    // the order of the bind parameters must not matter
+    std::vector<std::string> names;
+    for (auto const& it : VPackObjectIterator(bindParameters)) {
+      names.emplace_back(it.key.copyString());
+    }
+    std::sort(names.begin(), names.end());
+
+    for (auto const& name : names) {
+      VPackSlice value = bindParameters.get(name);
+
+      builder.openArray();
+      builder.add(VPackValue(name));
+      if (!byValue && isSubstitutable(name, value)) {
+        builder.add(VPackValue(value.isNumber() ? 1 : 2));
+      } else {
+        builder.add(VPackValue(0));
+        builder.add(value);
+      }
+      builder.close();
+    }
+  }
+
+  builder.close();
+}
+
+/// @brief build bind parameters with different values for all substitutable
+/// parameters, used to probe whether a plan depends on the values
+void PlanCache::perturb(VPackSlice bindParameters, VPackBuilder& builder) {
+  TRI_ASSERT(bindParameters.isObject());
+
+  size_t i = 0;
+  builder.openObject();
+  for (auto const& it : VPackObjectIterator(bindParameters)) {
+    std::string name = it.key.copyString();
+
+    if (!isSubstitutable(name, it.value)) {
+      builder.add(name, it.value);
+      continue;
+    }
+
+    ++i;
+    if (it.value.isNumber()) {
+      double value = it.value.getNumber<double>();
+      double other = value + 7919.0 * i;
+      if (other == value) {
+        // value too big to be changed by the addition
+        other = -value;
+      }
+      builder.add(name, VPackValue(other));
+    } else {
+      builder.add(name, VPackValue(it.value.copyString() + "\x1f" +
+                                   std::to_string(i)));
+    }
+  }
+  builder.close();
+}
+
+/// @brief copy a serialized plan, replacing the values that stem from
+/// substitutable bind parameters with placeholders
+void PlanCache::parameterize(VPackSlice plan, VPackSlice bindParameters,
+                             VPackBuilder& builder) {
+  if (!bindParameters.isObject()) {
+    builder.add(plan);
+    return;
+  }
+  ::parameterize(plan, bindParameters, builder, false);
+}
+
+/// @brief whether or not every value node created from a substitutable
+/// bind parameter is still a placeholder in a parameterized plan. if the
+/// optimizer folded a value away, the plan is only valid for that value
+bool PlanCache::coversParameters(
+    VPackSlice plan, VPackSlice bindParameters,
+    std::unordered_map<std::string, size_t> const& uses) {
+  if (!bindParameters.isObject()) {
+    return true;
+  }
+
+  std::unordered_map<std::string, size_t> counts;
+  countPlaceholders(plan, counts);
+
+  for (auto const& it : uses) {
+    if (!isSubstitutable(it.first, bindParameters.get(it.first))) {
+      continue;
+    }
+    auto found = counts.find(it.first);
+    if (found == counts.end() || (*found).second < it.second) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/// @brief whether or not two parameterized plans are equivalent
+bool PlanCache::equivalent(VPackSlice lhs, VPackSlice rhs) {
+  if (lhs.isObject() && rhs.isObject()) {
+    size_t n = 0;
+    for (auto const& it : VPackObjectIterator(lhs)) {
+      if (isIgnored(it.key)) {
+        continue;
+      }
+      VPackSlice other = rhs.get(it.key.copyString());
+      if (other.isNone() || !equivalent(it.value, other)) {
+        return false;
+      }
+      ++n;
+    }
+    for (auto const& it : VPackObjectIterator(rhs)) {
+      if (!isIgnored(it.key)) {
+        if (n == 0) {
+          return false;
+        }
+        --n;
+      }
+    }
+    return (n == 0);
+  }
+
+  if (lhs.isArray() && rhs.isArray()) {
+    if (lhs.length() != rhs.length()) {
+      return false;
+    }
+    VPackArrayIterator it(rhs);
+    for (auto const& value : VPackArrayIterator(lhs)) {
+      if (!equivalent(value, it.value())) {
+        return false;
+      }
+      it.next();
+    }
+    return true;
+  }
+
+  return (lhs.type() == rhs.type() &&
+          basics::VelocyPackHelper::compare(lhs, rhs, false) == 0);
+}
+
+/// @brief copy a parameterized plan, filling in the bind parameter values
+void PlanCache::bind(VPackSlice plan, VPackSlice bindParameters,
+                     VPackBuilder& builder) {
+  if (plan.isArray()) {
+    builder.openArray();
+    for (auto const& it : VPackArrayIterator(plan)) {
+      bind(it, bindParameters, builder);
+    }
+    builder.close();
+    return;
+  }
+
+  if (!plan.isObject()) {
+    builder.add(plan);
+    return;
+  }
+
+  VPackSlice parameter = plan.get("bindParameter");
+
+  if (parameter.isString()) {
+    std::string name = parameter.copyString();
+    VPackSlice value = bindParameters.isObject() ? bindParameters.get(name)
+                                                 : VPackSlice();
+
+    if (!value.isNumber() && !value.isString()) {
+      THROW_ARANGO_EXCEPTION_PARAMS(TRI_ERROR_QUERY_BIND_PARAMETER_MISSING,
+                                    name.c_str());
+    }
+
+    // bind parameter values are always turned into double or string values
+    AstNodeValueType type = value.isNumber() ? VALUE_TYPE_DOUBLE
+                                             : VALUE_TYPE_STRING;
+
+    builder.openObject();
+    for (auto const& it : VPackObjectIterator(plan)) {
+      if (!it.key.isEqualString("bindParameter")) {
+        builder.add(it.key.copyString(), it.value);
+      }
+    }
+    builder.add("value", value);
+    builder.add("vType", VPackValue(AstNode::ValueTypeNames.at(static_cast<int>(type))));
+    builder.add("vTypeID", VPackValue(static_cast<int>(type)));
+    builder.close();
+    return;
+  }
+
+  builder.openObject();
+  for (auto const& it : VPackObjectIterator(plan)) {
+    builder.add(VPackValue(it.key.copyString()));
+    bind(it.value, bindParameters, builder);
+  }
+  builder.close();
+}
+
 /// @brief get the plan cache instance
 PlanCache* PlanCache::instance() { return &Instance; }
 
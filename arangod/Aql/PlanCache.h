@@ -32,6 +32,7 @@ struct TRI_vocbase_t;
 namespace arangodb {
 namespace velocypack {
 class Builder;
+class Slice;
 }
 
 namespace aql {
@@ -40,11 +41,17 @@ class VariableGenerator;
 
 struct PlanCacheEntry {
   PlanCacheEntry(std::string&& queryString, 
-                 std::shared_ptr<arangodb::velocypack::Builder> builder)
-      : queryString(std::move(queryString)), builder(builder) {}
+                 std::shared_ptr<arangodb::velocypack::Builder> builder,
+                 bool isModificationQuery = false)
+      : queryString(std::move(queryString)),
+        builder(builder),
+        isModificationQuery(isModificationQuery) {}
 
   std::string queryString;
+  /// @brief the serialized plan. a nullptr means that the plan depends on
+  /// the actual bind parameter values, so it must be looked up by value
   std::shared_ptr<arangodb::velocypack::Builder> builder;
+  bool isModificationQuery;
 };
 
 class PlanCache {
@@ -65,9 +72,63 @@ class PlanCache {
   /// @brief store a plan in the cache
   void store(TRI_vocbase_t*, uint64_t, char const*, size_t, ExecutionPlan const*);
 
+  /// @brief store a serialized plan in the cache
+  void store(TRI_vocbase_t*, uint64_t, char const*, size_t,
+             std::shared_ptr<arangodb::velocypack::Builder>, bool);
+
   /// @brief invalidate all plans for a particular database
   void invalidate(TRI_vocbase_t*);
 
+  /// @brief remove all plans and prepared queries of a dropped database
+  void drop(TRI_vocbase_t*);
+
+  /// @brief register a prepared query string and return its id
+  uint64_t prepare(TRI_vocbase_t*, std::string const&);
+
+  /// @brief look up the query string of a prepared query
+  bool preparedQuery(TRI_vocbase_t*, uint64_t, std::string&);
+
+  /// @brief remove a prepared query. returns false if it does not exist
+  bool unprepare(TRI_vocbase_t*, uint64_t);
+
+  /// @brief calculate the hash value for a cache key
+  static uint64_t hashKey(std::string const&);
+
+  /// @brief whether or not the query has bind parameters whose values can be
+  /// substituted into a cached plan
+  static bool hasSubstitutableParameters(arangodb::velocypack::Slice);
+
+  /// @brief append the bind parameters to a cache key. substitutable
+  /// parameters contribute only their type unless byValue is set
+  static void buildSignature(arangodb::velocypack::Builder&,
+                             arangodb::velocypack::Slice, bool byValue);
+
+  /// @brief build bind parameters with different values for all substitutable
+  /// parameters, used to probe whether a plan depends on the values
+  static void perturb(arangodb::velocypack::Slice,
+                      arangodb::velocypack::Builder&);
+
+  /// @brief copy a serialized plan, replacing the values that stem from
+  /// substitutable bind parameters with placeholders
+  static void parameterize(arangodb::velocypack::Slice,
+                           arangodb::velocypack::Slice,
+                           arangodb::velocypack::Builder&);
+
+  /// @brief whether or not every value node created from a substitutable
+  /// bind parameter is still a placeholder in a parameterized plan. if the
+  /// optimizer folded a value away, the plan is only valid for that value
+  static bool coversParameters(
+      arangodb::velocypack::Slice, arangodb::velocypack::Slice,
+      std::unordered_map<std::string, size_t> const& uses);
+
+  /// @brief whether or not two parameterized plans are equivalent
+  static bool equivalent(arangodb::velocypack::Slice,
+                         arangodb::velocypack::Slice);
+
+  /// @brief copy a parameterized plan, filling in the bind parameter values
+  static void bind(arangodb::velocypack::Slice, arangodb::velocypack::Slice,
+                   arangodb::velocypack::Builder&);
+
   /// @brief get the pointer to the global plan cache
   static PlanCache* instance();
 
@@ -77,6 +138,12 @@ class PlanCache {
 
   /// @brief cached query plans, organized per database
   std::unordered_map<TRI_vocbase_t*, std::unordered_map<uint64_t, std::shared_ptr<PlanCacheEntry>>> _plans;
+
+  /// @brief prepared query strings, organized per database
+  std::unordered_map<TRI_vocbase_t*, std::unordered_map<uint64_t, std::string>> _prepared;
+
+  /// @brief maximum number of cached plans per database
+  static size_t const MaxPlansPerDatabase;
 };
 }
 }
@@ -25,21 +25,29 @@
 
 #include "Aql/AqlItemBlock.h"
 #include "Aql/AqlTransaction.h"
+#include "Aql/Collection.h"
+#include "Aql/Condition.h"
 #include "Aql/ExecutionBlock.h"
 #include "Aql/ExecutionEngine.h"
 #include "Aql/ExecutionPlan.h"
 #include "Aql/Executor.h"
+#include "Aql/Function.h"
+#include "Aql/IndexNode.h"
 #include "Aql/Optimizer.h"
 #include "Aql/Parser.h"
 #include "Aql/PlanCache.h"
 #include "Aql/QueryCache.h"
 #include "Aql/QueryList.h"
 #include "Aql/QueryProfile.h"
+#include "Aql/WalkerWorker.h"
 #include "Basics/Exceptions.h"
+#include "Basics/StaticStrings.h"
 #include "Basics/VelocyPackHelper.h"
 #include "Basics/WorkMonitor.h"
 #include "Basics/fasthash.h"
+#include "Cluster/ClusterMethods.h"
 #include "Cluster/ServerState.h"
+#include "Indexes/Index.h"
 #include "Logger/Logger.h"
 #include "RestServer/AqlFeature.h"
 #include "StorageEngine/TransactionState.h"
@@ -67,6 +75,204 @@ namespace {
 static std::atomic<TRI_voc_tick_t> NextQueryId(1);
 
 constexpr uint64_t DontCache = 0;
+
+/// @brief whether or not an expression may read documents on its own
+bool mayReadDocuments(AstNode const* node) {
+  bool result = false;
+
+  Ast::traverseReadOnly(node, [&result](AstNode const* node, void*) {
+    if (node->type == NODE_TYPE_FCALL_USER) {
+      result = true;
+    } else if (node->type == NODE_TYPE_FCALL) {
+      // functions that access collections cannot run on DB servers
+      auto func = static_cast<Function*>(node->getData());
+      if (!func->canRunOnDBServer) {
+        result = true;
+      }
+    }
+  }, nullptr);
+
+  return result;
+}
+
+/// @brief add the document keys compared in an index condition part
+void addKeys(AstNode const* value, bool isId,
+             std::unordered_set<std::string>& keys) {
+  if (value->isArray()) {
+    for (size_t i = 0; i < value->numMembers(); ++i) {
+      addKeys(value->getMemberUnchecked(i), isId, keys);
+    }
+    return;
+  }
+
+  if (!value->isStringValue()) {
+    // cannot match any document
+    return;
+  }
+
+  std::string key = value->getString();
+
+  if (isId) {
+    size_t pos = key.find('/');
+    if (pos == std::string::npos) {
+      return;
+    }
+    key = key.substr(pos + 1);
+  }
+  keys.emplace(std::move(key));
+}
+
+/// @brief extract the document keys an index node looks up via the primary
+/// index. returns false if they are not known before the execution
+bool primaryIndexKeys(IndexNode const* node,
+                      std::unordered_set<std::string>& keys) {
+  for (auto const& it : node->getIndexes()) {
+    if (it.getIndex()->type() != arangodb::Index::TRI_IDX_TYPE_PRIMARY_INDEX) {
+      return false;
+    }
+  }
+
+  AstNode const* root = node->condition()->root();
+
+  if (root == nullptr || root->type != NODE_TYPE_OPERATOR_NARY_OR ||
+      root->numMembers() == 0 || mayReadDocuments(root)) {
+    return false;
+  }
+
+  for (size_t i = 0; i < root->numMembers(); ++i) {
+    AstNode const* andNode = root->getMemberUnchecked(i);
+    bool found = false;
+
+    for (size_t j = 0; j < andNode->numMembers() && !found; ++j) {
+      AstNode const* op = andNode->getMemberUnchecked(j);
+
+      if (op->type != NODE_TYPE_OPERATOR_BINARY_EQ &&
+          op->type != NODE_TYPE_OPERATOR_BINARY_IN) {
+        continue;
+      }
+
+      AstNode const* access = op->getMember(0);
+      AstNode const* value = op->getMember(1);
+
+      if (op->type == NODE_TYPE_OPERATOR_BINARY_EQ &&
+          access->type != NODE_TYPE_ATTRIBUTE_ACCESS) {
+        std::swap(access, value);
+      }
+
+      if (access->type != NODE_TYPE_ATTRIBUTE_ACCESS ||
+          access->getMember(0)->type != NODE_TYPE_REFERENCE ||
+          static_cast<Variable const*>(access->getMember(0)->getData()) !=
+              node->outVariable() ||
+          !value->isConstant()) {
+        continue;
+      }
+
+      bool const isId = (access->getString() == StaticStrings::IdString);
+
+      if (isId || access->getString() == StaticStrings::KeyString) {
+        addKeys(value, isId, keys);
+        found = true;
+      }
+    }
+
+    if (!found) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/// @brief determines the document keys that a plan reads per collection,
+/// for the key-based invalidation of the query cache
+class ReadKeysFinder final : public WalkerWorker<ExecutionNode> {
+ public:
+  ReadKeysFinder() : _unknown(false) {}
+
+  bool before(ExecutionNode* en) override final {
+    switch (en->getType()) {
+      case ExecutionNode::SINGLETON:
+      case ExecutionNode::ENUMERATE_LIST:
+      case ExecutionNode::FILTER:
+      case ExecutionNode::LIMIT:
+      case ExecutionNode::SUBQUERY:
+      case ExecutionNode::SORT:
+      case ExecutionNode::COLLECT:
+      case ExecutionNode::RETURN:
+      case ExecutionNode::NORESULTS:
+      case ExecutionNode::MATERIALIZE:
+        // these only read the documents produced by other nodes
+        return false;
+
+      case ExecutionNode::CALCULATION: {
+        auto node = static_cast<CalculationNode const*>(en);
+        if (mayReadDocuments(node->expression()->node())) {
+          _unknown = true;
+          return true;
+        }
+        return false;
+      }
+
+      case ExecutionNode::ENUMERATE_COLLECTION: {
+        auto node = static_cast<EnumerateCollectionNode const*>(en);
+        _fullCollections.emplace(node->collection()->getName());
+        return false;
+      }
+
+      case ExecutionNode::INDEX: {
+        auto node = static_cast<IndexNode const*>(en);
+        std::string const& name = node->collection()->getName();
+        std::unordered_set<std::string> keys;
+
+        if (primaryIndexKeys(node, keys)) {
+          _keys[name].insert(keys.begin(), keys.end());
+        } else {
+          _fullCollections.emplace(name);
+        }
+        return false;
+      }
+
+      default:
+        // everything else is not tracked
+        _unknown = true;
+        return true;
+    }
+  }
+
+  /// @brief return the keys read per collection
+  QueryCacheReadKeys keys() {
+    if (_unknown) {
+      return QueryCacheReadKeys();
+    }
+
+    for (auto const& it : _fullCollections) {
+      _keys.erase(it);
+    }
+    return std::move(_keys);
+  }
+
+ private:
+  /// @brief keys read per collection
+  QueryCacheReadKeys _keys;
+
+  /// @brief collections that are read without known keys
+  std::unordered_set<std::string> _fullCollections;
+
+  /// @brief whether or not the plan reads documents in other ways
+  bool _unknown;
+};
+
+/// @brief determine the document keys that a plan reads, if the query cache
+/// is configured for key-based invalidation
+QueryCacheReadKeys readKeys(ExecutionPlan* plan) {
+  if (QueryCache::instance()->invalidationMode() != INVALIDATE_KEYS) {
+    return QueryCacheReadKeys();
+  }
+
+  ReadKeysFinder finder;
+  plan->root()->walk(&finder);
+  return finder.keys();
+}
 }
 
 /// @brief global memory limit for AQL queries
@@ -102,7 +308,8 @@ Query::Query(bool contextOwnedByExterior, TRI_vocbase_t* vocbase,
       _part(part),
       _contextOwnedByExterior(contextOwnedByExterior),
       _killed(false),
-      _isModificationQuery(false) {
+      _isModificationQuery(false),
+      _isStreaming(false) {
 
   AqlFeature* aql = AqlFeature::lease();
   if (aql == nullptr) {
@@ -169,7 +376,8 @@ Query::Query(bool contextOwnedByExterior, TRI_vocbase_t* vocbase,
       _part(part),
       _contextOwnedByExterior(contextOwnedByExterior),
       _killed(false),
-      _isModificationQuery(false) {
+      _isModificationQuery(false),
+      _isStreaming(false) {
 
   AqlFeature* aql = AqlFeature::lease();
   if (aql == nullptr) {
@@ -394,8 +602,15 @@ void Query::prepare(QueryRegistry* registry, uint64_t queryStringHash) {
 
   std::unique_ptr<ExecutionPlan> plan;
 
+  if (_queryString != nullptr && _part == PART_MAIN && reusePlan()) {
+    plan.reset(prepareReusablePlan());
+
+    TRI_ASSERT(plan != nullptr);
+  }
+
 #if USE_PLAN_CACHE
-  if (_queryString != nullptr && 
+  if (plan == nullptr &&
+      _queryString != nullptr && 
       queryStringHash != DontCache &&
       _part == PART_MAIN) {
     // LOG_TOPIC(INFO, Logger::FIXME) << "trying to find query in execution plan cache: '" << std::string(_queryString, _queryStringLength) << "', hash: " << queryStringHash;
@@ -405,35 +620,7 @@ void Query::prepare(QueryRegistry* registry, uint64_t queryStringHash) {
     if (planCacheEntry != nullptr) {
       // LOG_TOPIC(INFO, Logger::FIXME) << "query found in execution plan cache: '" << std::string(_queryString, _queryStringLength) << "'";
 
-      TRI_ASSERT(_trx == nullptr); 
-      TRI_ASSERT(_collections.empty());
-  
-      // create the transaction object, but do not start it yet
-      AqlTransaction* trx = new AqlTransaction(
-        createTransactionContext(), _collections.collections(),
-        _part == PART_MAIN);
-      _trx = trx;
-
-      VPackBuilder* builder = planCacheEntry->builder.get();
-      VPackSlice slice = builder->slice();
-      ExecutionPlan::getCollectionsFromVelocyPack(_ast.get(), slice);
-      _ast->variables()->fromVelocyPack(slice);
-    
-      enterState(QueryExecutionState::ValueType::LOADING_COLLECTIONS);
-    
-      int res = trx->addCollections(*_collections.collections());
-      
-      if (res == TRI_ERROR_NO_ERROR) {
-        res = _trx->begin();
-      }
-    
-      if (res != TRI_ERROR_NO_ERROR) {
-        THROW_ARANGO_EXCEPTION_MESSAGE(res, buildErrorMessage(res));
-      }
-    
-      enterState(QueryExecutionState::ValueType::PLAN_INSTANTIATION);
-    
-      plan.reset(ExecutionPlan::instantiateFromVelocyPack(_ast.get(), slice));
+      plan.reset(instantiateCachedPlan(planCacheEntry->builder->slice()));
 
       TRI_ASSERT(plan != nullptr);
     }
@@ -577,6 +764,189 @@ ExecutionPlan* Query::prepare() {
   return plan.release();
 }
 
+/// @brief prepare the execution plan of a query whose plan is kept in the
+/// plan cache and reused for executions with other bind parameter values.
+/// bind parameters with number or string values are replaced by placeholders
+/// in the cached plan, unless the optimizer made decisions based on their
+/// values. this is detected by optimizing the query a second time with
+/// other values. plans that depend on the values are cached by value
+ExecutionPlan* Query::prepareReusablePlan() {
+  TRI_ASSERT(_queryString != nullptr);
+
+  VPackSlice bindParameters = basics::VelocyPackHelper::EmptyObjectValue();
+  auto bindParametersBuilder = _bindParameters.builder();
+
+  if (bindParametersBuilder != nullptr &&
+      bindParametersBuilder->slice().isObject()) {
+    bindParameters = bindParametersBuilder->slice();
+  }
+
+  PlanCache* cache = PlanCache::instance();
+  bool substitutable = PlanCache::hasSubstitutableParameters(bindParameters);
+
+  std::string key = planCacheKey(bindParameters, false);
+  std::shared_ptr<PlanCacheEntry> entry = cache->lookup(
+      _vocbase, PlanCache::hashKey(key), key.data(), key.size());
+
+  if (entry != nullptr && entry->builder == nullptr) {
+    // the plan depends on the bind parameter values
+    TRI_ASSERT(substitutable);
+    substitutable = false;
+    key = planCacheKey(bindParameters, true);
+    entry = cache->lookup(_vocbase, PlanCache::hashKey(key), key.data(),
+                          key.size());
+  }
+
+  if (entry != nullptr) {
+    TRI_ASSERT(entry->builder != nullptr);
+    _isModificationQuery = entry->isModificationQuery;
+
+    VPackBuilder builder;
+    PlanCache::bind(entry->builder->slice(), bindParameters, builder);
+    return instantiateCachedPlan(builder.slice());
+  }
+
+  // the probe must be optimized before our own transaction is started
+  std::shared_ptr<VPackBuilder> probe;
+  if (substitutable) {
+    probe = probePlan(bindParameters);
+  }
+
+  std::unique_ptr<ExecutionPlan> plan(prepare());
+
+  if (!_warnings.empty() || !_ast->root()->isCacheable()) {
+    return plan.release();
+  }
+
+  std::shared_ptr<VPackBuilder> serialized =
+      plan->toVelocyPack(_ast.get(), true);
+
+  if (substitutable) {
+    auto parameterized = std::make_shared<VPackBuilder>();
+    PlanCache::parameterize(serialized->slice(), bindParameters,
+                            *parameterized);
+
+    // the probe alone cannot tell whether a value was folded away, as the
+    // other value may be folded the same way (e.g. FILTER @x > 10 with 20
+    // and 20 + 7919), so every use of a parameter must be a placeholder
+    if (probe != nullptr &&
+        PlanCache::coversParameters(parameterized->slice(), bindParameters,
+                                    _ast->bindParameterUses()) &&
+        PlanCache::equivalent(parameterized->slice(), probe->slice())) {
+      cache->store(_vocbase, PlanCache::hashKey(key), key.data(), key.size(),
+                   parameterized, _isModificationQuery);
+      return plan.release();
+    }
+
+    // remember that the plan must be looked up by value
+    cache->store(_vocbase, PlanCache::hashKey(key), key.data(), key.size(),
+                 nullptr, false);
+    key = planCacheKey(bindParameters, true);
+  }
+
+  cache->store(_vocbase, PlanCache::hashKey(key), key.data(), key.size(),
+               serialized, _isModificationQuery);
+
+  return plan.release();
+}
+
+/// @brief create the transaction and instantiate a plan from the plan cache
+ExecutionPlan* Query::instantiateCachedPlan(VPackSlice slice) {
+  TRI_ASSERT(_trx == nullptr);
+  TRI_ASSERT(_collections.empty());
+
+  // create the transaction object, but do not start it yet
+  AqlTransaction* trx = new AqlTransaction(
+      createTransactionContext(), _collections.collections(),
+      _part == PART_MAIN);
+  _trx = trx;
+
+  ExecutionPlan::getCollectionsFromVelocyPack(_ast.get(), slice);
+  _ast->variables()->fromVelocyPack(slice);
+
+  enterState(QueryExecutionState::ValueType::LOADING_COLLECTIONS);
+
+  int res = trx->addCollections(*_collections.collections());
+
+  if (res == TRI_ERROR_NO_ERROR) {
+    res = _trx->begin();
+  }
+
+  if (res != TRI_ERROR_NO_ERROR) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(res, buildErrorMessage(res));
+  }
+
+  enterState(QueryExecutionState::ValueType::PLAN_INSTANTIATION);
+
+  ExecutionPlan* plan =
+      ExecutionPlan::instantiateFromVelocyPack(_ast.get(), slice);
+
+  if (plan == nullptr) {
+    // oops
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL,
+                                   "could not create plan from vpack");
+  }
+
+  return plan;
+}
+
+/// @brief optimize the query with other values for the substitutable bind
+/// parameters, and return the parameterized plan. returns a nullptr if
+/// this fails
+std::shared_ptr<VPackBuilder> Query::probePlan(VPackSlice bindParameters) {
+  auto values = std::make_shared<VPackBuilder>();
+  PlanCache::perturb(bindParameters, *values);
+
+  try {
+    Query probe(false, _vocbase, _queryString, _queryStringLength, values,
+                _options, PART_MAIN);
+    probe.init();
+
+    std::unique_ptr<ExecutionPlan> plan(probe.prepare());
+
+    if (!probe._warnings.empty()) {
+      return nullptr;
+    }
+
+    std::shared_ptr<VPackBuilder> serialized =
+        plan->toVelocyPack(plan->getAst(), true);
+
+    auto result = std::make_shared<VPackBuilder>();
+    PlanCache::parameterize(serialized->slice(), values->slice(), *result);
+    return result;
+  } catch (...) {
+    // the other values make the query fail, so the plan cannot be reused
+    return nullptr;
+  }
+}
+
+/// @brief build the plan cache key for the query. this consists of the
+/// query string, the options that influence the optimizer and the bind
+/// parameter signature
+std::string Query::planCacheKey(VPackSlice bindParameters,
+                                bool byValue) const {
+  VPackSlice optimizer = basics::VelocyPackHelper::EmptyObjectValue();
+
+  if (_options != nullptr && _options->slice().isObject() &&
+      _options->slice().hasKey("optimizer")) {
+    optimizer = _options->slice().get("optimizer");
+  }
+
+  VPackBuilder builder;
+  builder.openArray();
+  builder.add(optimizer);
+  builder.add(VPackValue(getBooleanOption("fullCount", false)));
+  builder.add(VPackValue(maxNumberOfPlans()));
+  PlanCache::buildSignature(builder, bindParameters, byValue);
+  builder.close();
+
+  std::string key(_queryString, _queryStringLength);
+  key.push_back('\0');
+  key.append(builder.slice().toJson());
+
+  return key;
+}
+
 /// @brief execute an AQL query
 QueryResult Query::execute(QueryRegistry* registry) {
   LOG_TOPIC(DEBUG, Logger::QUERIES) << TRI_microtime() - _startTime << " "
@@ -649,7 +1019,7 @@ QueryResult Query::execute(QueryRegistry* registry) {
       if (useQueryCache) {
         // iterate over result, return it and store it in query cache
         while (nullptr != (value = _engine->getSome(
-                               1, ExecutionBlock::DefaultBatchSize()))) {
+                               1, _engine->root()->batchSize()))) {
           size_t const n = value->size();
 
           for (size_t i = 0; i < n; ++i) {
@@ -672,7 +1042,8 @@ QueryResult Query::execute(QueryRegistry* registry) {
           // finally store the generated result in the query cache
           auto result = QueryCache::instance()->store(
               _vocbase, queryStringHash, _queryString, _queryStringLength,
-              resultBuilder, _trx->state()->collectionNames());
+              resultBuilder, _trx->state()->collectionNames(),
+              readKeys(_plan.get()));
 
           if (result == nullptr) {
             THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
@@ -681,7 +1052,7 @@ QueryResult Query::execute(QueryRegistry* registry) {
       } else {
         // iterate over result and return it
         while (nullptr != (value = _engine->getSome(
-                               1, ExecutionBlock::DefaultBatchSize()))) {
+                               1, _engine->root()->batchSize()))) {
           size_t const n = value->size();
           for (size_t i = 0; i < n; ++i) {
             AqlValue const& val = value->getValueReference(i, resultRegister);
@@ -702,37 +1073,8 @@ QueryResult Query::execute(QueryRegistry* registry) {
       throw;
     }
     
-    LOG_TOPIC(DEBUG, Logger::QUERIES) << TRI_microtime() - _startTime << " "
-                                      << "Query::execute: before _trx->commit"
-                                      << " this: " << (uintptr_t) this;
-
-    _trx->commit();
-    
-    LOG_TOPIC(DEBUG, Logger::QUERIES)
-        << TRI_microtime() - _startTime << " "
-        << "Query::execute: before cleanupPlanAndEngine"
-        << " this: " << (uintptr_t) this;
-   
-    QueryResult result; 
-    result.context = _trx->transactionContext();
-
-    _engine->_stats.setExecutionTime(TRI_microtime() - _startTime);
-    auto stats = std::make_shared<VPackBuilder>();
-    cleanupPlanAndEngine(TRI_ERROR_NO_ERROR, stats.get());
-
-    enterState(QueryExecutionState::ValueType::FINALIZATION);
- 
-    result.warnings = warningsToVelocyPack();
+    QueryResult result = finalize();
     result.result = resultBuilder;
-    result.stats = stats;
-
-    if (_profile != nullptr && profiling()) {
-      result.profile = _profile->toVelocyPack();
-    }
-
-    // patch stats in place
-    // we do this because "executionTime" should include the whole span of the execution and we have to set it at the very end
-    basics::VelocyPackHelper::patchDouble(result.stats->slice().get("executionTime"), runTime());
 
     LOG_TOPIC(DEBUG, Logger::QUERIES) << TRI_microtime() - _startTime << " "
                                       << "Query::execute:returning"
@@ -761,6 +1103,63 @@ QueryResult Query::execute(QueryRegistry* registry) {
   }
 }
 
+/// @brief prepare an AQL query whose results are fetched batch-wise from
+/// its engine afterwards
+void Query::prepareStreaming(QueryRegistry* registry) {
+  LOG_TOPIC(DEBUG, Logger::QUERIES) << TRI_microtime() - _startTime << " "
+                                    << "Query::prepareStreaming"
+                                    << " this: " << (uintptr_t) this;
+  TRI_ASSERT(registry != nullptr);
+  _isStreaming = true;
+
+  // will throw if it fails
+  prepare(registry, DontCache);
+  log();
+
+  TRI_ASSERT(_engine != nullptr);
+}
+
+/// @brief commit the query's transaction and return the statistics,
+/// warnings and profile of the query
+QueryResult Query::finalize() {
+  TRI_ASSERT(_engine != nullptr);
+  TRI_ASSERT(_trx != nullptr);
+
+  LOG_TOPIC(DEBUG, Logger::QUERIES) << TRI_microtime() - _startTime << " "
+                                    << "Query::finalize: before _trx->commit"
+                                    << " this: " << (uintptr_t) this;
+
+  _trx->commit();
+
+  LOG_TOPIC(DEBUG, Logger::QUERIES)
+      << TRI_microtime() - _startTime << " "
+      << "Query::finalize: before cleanupPlanAndEngine"
+      << " this: " << (uintptr_t) this;
+
+  QueryResult result;
+  result.context = _trx->transactionContext();
+
+  _engine->_stats.setExecutionTime(TRI_microtime() - _startTime);
+  profileBlocks();
+  auto stats = std::make_shared<VPackBuilder>();
+  cleanupPlanAndEngine(TRI_ERROR_NO_ERROR, stats.get());
+
+  enterState(QueryExecutionState::ValueType::FINALIZATION);
+
+  result.warnings = warningsToVelocyPack();
+  result.stats = stats;
+
+  if (_profile != nullptr && profiling()) {
+    result.profile = profileToVelocyPack();
+  }
+
+  // patch stats in place
+  // we do this because "executionTime" should include the whole span of the execution and we have to set it at the very end
+  basics::VelocyPackHelper::patchDouble(result.stats->slice().get("executionTime"), runTime());
+
+  return result;
+}
+
 // execute an AQL query: may only be called with an active V8 handle scope
 QueryResultV8 Query::executeV8(v8::Isolate* isolate, QueryRegistry* registry) {
   LOG_TOPIC(DEBUG, Logger::QUERIES) << TRI_microtime() - _startTime << " "
@@ -836,7 +1235,7 @@ QueryResultV8 Query::executeV8(v8::Isolate* isolate, QueryRegistry* registry) {
 
         uint32_t j = 0;
         while (nullptr != (value = _engine->getSome(
-                               1, ExecutionBlock::DefaultBatchSize()))) {
+                               1, _engine->root()->batchSize()))) {
           size_t const n = value->size();
 
           for (size_t i = 0; i < n; ++i) {
@@ -857,7 +1256,8 @@ QueryResultV8 Query::executeV8(v8::Isolate* isolate, QueryRegistry* registry) {
           // finally store the generated result in the query cache
           QueryCache::instance()->store(_vocbase, queryStringHash, _queryString,
                                         _queryStringLength, builder,
-                                        _trx->state()->collectionNames());
+                                        _trx->state()->collectionNames(),
+                                        readKeys(_plan.get()));
         }
       } else {
         // iterate over result and return it
@@ -865,7 +1265,7 @@ QueryResultV8 Query::executeV8(v8::Isolate* isolate, QueryRegistry* registry) {
 
         uint32_t j = 0;
         while (nullptr != (value = _engine->getSome(
-                               1, ExecutionBlock::DefaultBatchSize()))) {
+                               1, _engine->root()->batchSize()))) {
           if (!suppressResult) {
             size_t const n = value->size();
 
@@ -904,6 +1304,7 @@ QueryResultV8 Query::executeV8(v8::Isolate* isolate, QueryRegistry* registry) {
     result.context = _trx->transactionContext();
 
     _engine->_stats.setExecutionTime(TRI_microtime() - _startTime);
+    profileBlocks();
     auto stats = std::make_shared<VPackBuilder>();
     cleanupPlanAndEngine(TRI_ERROR_NO_ERROR, stats.get());
 
@@ -913,7 +1314,7 @@ QueryResultV8 Query::executeV8(v8::Isolate* isolate, QueryRegistry* registry) {
     result.stats = stats;
 
     if (_profile != nullptr && profiling()) {
-      result.profile = _profile->toVelocyPack();
+      result.profile = profileToVelocyPack();
     }
     
     // patch executionTime stats value in place
@@ -1303,6 +1704,12 @@ bool Query::canUseQueryCache() const {
     return false;
   }
 
+  if (reusePlan()) {
+    // the AST is not built for plans from the plan cache, so the
+    // cacheability of the query result is unknown
+    return false;
+  }
+
   auto queryCacheMode = QueryCache::instance()->mode();
 
   if (queryCacheMode == CACHE_ALWAYS_ON && getBooleanOption("cache", true)) {
@@ -1407,6 +1814,67 @@ void Query::enterState(QueryExecutionState::ValueType state) {
   _state = state;
 }
 
+/// @brief collect the statistics of all execution blocks of the engine.
+/// must be called before the engine is shut down
+void Query::profileBlocks() {
+  if (_engine == nullptr || profileLevel() < 2) {
+    return;
+  }
+
+  auto builder = std::make_shared<VPackBuilder>();
+  {
+    VPackArrayBuilder guard(builder.get());
+
+    for (auto const& block : _engine->blocks()) {
+      ExecutionNode const* node = block->getPlanNode();
+      ExecutionBlockProfile const& profile = block->profile();
+
+      // the input of a block is the output of its dependencies, and its
+      // own runtime is what remains after subtracting theirs
+      uint64_t rowsIn = 0;
+      double selfRuntime = profile.runtime;
+      for (auto const& dep : block->getDependencies()) {
+        rowsIn += dep->profile().items + dep->profile().skipped;
+        selfRuntime -= dep->profile().runtime;
+      }
+
+      VPackObjectBuilder b(builder.get());
+      builder->add("id", VPackValue(node->id()));
+      builder->add("type", VPackValue(node->getTypeString()));
+      builder->add("calls", VPackValue(profile.getSomeCalls));
+      builder->add("skipCalls", VPackValue(profile.skipSomeCalls));
+      builder->add("rowsIn", VPackValue(rowsIn));
+      builder->add("items", VPackValue(profile.items));
+      builder->add("skipped", VPackValue(profile.skipped));
+      builder->add("runtime", VPackValue(profile.runtime));
+      builder->add("selfRuntime", VPackValue((std::max)(0.0, selfRuntime)));
+    }
+  }
+
+  _blocksProfile = builder;
+}
+
+/// @brief build the profile returned to the client, consisting of the
+/// phase timings and the per-block statistics, if recorded
+std::shared_ptr<VPackBuilder> Query::profileToVelocyPack() {
+  TRI_ASSERT(_profile != nullptr);
+  auto timings = _profile->toVelocyPack();
+
+  if (_blocksProfile == nullptr) {
+    return timings;
+  }
+
+  auto result = std::make_shared<VPackBuilder>();
+  {
+    VPackObjectBuilder guard(result.get());
+    for (auto const& it : VPackObjectIterator(timings->slice())) {
+      result->add(it.key.copyString(), it.value);
+    }
+    result->add("nodes", _blocksProfile->slice());
+  }
+  return result;
+}
+
 /// @brief cleanup plan and engine for current query
 void Query::cleanupPlanAndEngine(int errorCode, VPackBuilder* statsBuilder) {
   if (_engine != nullptr) {
@@ -1420,6 +1888,18 @@ void Query::cleanupPlanAndEngine(int errorCode, VPackBuilder* statsBuilder) {
       // (we're also called from the destructor)
     }
     _engine.reset();
+
+    if (_isModificationQuery && ServerState::instance()->isCoordinator()) {
+      // the cached counts of the modified collections are outdated now
+      for (auto const& it : *_collections.collections()) {
+        if (it.second->accessType != AccessMode::Type::READ) {
+          try {
+            invalidateCountOnCoordinator(_vocbase->name(), it.first);
+          } catch (...) {
+          }
+        }
+      }
+    }
   }
 
   if (_trx != nullptr) {
@@ -148,8 +148,21 @@ class Query {
   /// @brief should we return all plans?
   bool allPlans() const { return getBooleanOption("allPlans", false); }
 
+  /// @brief should the execution plan be reused for later executions with
+  /// different bind parameter values?
+  bool reusePlan() const { return getBooleanOption("reusePlan", false); }
+
   /// @brief should the execution be profiled?
-  bool profiling() const { return getBooleanOption("profile", false); }
+  bool profiling() const { return profileLevel() > 0; }
+
+  /// @brief the profiling level. 1 (profile: true) records the time of each
+  /// execution phase, 2 additionally records statistics per execution block
+  int profileLevel() const {
+    if (getBooleanOption("profile", false)) {
+      return 1;
+    }
+    return getNumericOption<int>("profile", 0);
+  }
   
   /// @brief should we suppress the query result (useful for performance testing only)?
   bool silent() const { return getBooleanOption("silent", false); }
@@ -189,6 +202,32 @@ class Query {
     return 0;
   }
 
+  /// @brief fixed number of rows per batch in the execution blocks. a
+  /// value of 0 means the batch size is determined adaptively per block
+  size_t executionBatchSize() const {
+    return getNumericOption<size_t>("executionBatchSize", 0);
+  }
+
+  /// @brief memory budget for a single batch in the execution blocks, used
+  /// to determine the adaptive batch size. 0 means the default budget
+  size_t batchMemoryLimit() const {
+    return getNumericOption<size_t>("batchMemoryLimit", 0);
+  }
+
+  /// @brief maximum number of independent subqueries of a coordinator query
+  /// whose DB server parts are started ahead of their execution, so that
+  /// they run concurrently. 0 turns this off
+  size_t maxParallelSubqueries() const {
+    return getNumericOption<size_t>("maxParallelSubqueries", 4);
+  }
+
+  /// @brief amount of memory (in bytes) an execution block may use for
+  /// intermediate results before it spills them to temporary files.
+  /// 0 means intermediate results are never spilled
+  size_t spillThreshold() const {
+    return getNumericOption<size_t>("spillThreshold", 0);
+  }
+
   /// @brief maximum number of plans to produce
   int64_t literalSizeThreshold() const {
     int64_t value = getNumericOption<int64_t>("literalSizeThreshold", 0);
@@ -217,6 +256,15 @@ class Query {
   /// @brief execute an AQL query
   QueryResult execute(QueryRegistry*);
 
+  /// @brief prepare an AQL query whose results are fetched batch-wise from
+  /// its engine afterwards. the query cache is not used for such queries,
+  /// and they must be completed with finalize()
+  void prepareStreaming(QueryRegistry*);
+
+  /// @brief commit the query's transaction and return the statistics,
+  /// warnings and profile of the query. the query result is not set
+  QueryResult finalize();
+
   /// @brief execute an AQL query
   /// may only be called with an active V8 handle scope
   QueryResultV8 executeV8(v8::Isolate* isolate, QueryRegistry*);
@@ -253,6 +301,11 @@ class Query {
   /// @brief exits a V8 context
   void exitContext();
 
+  /// @brief whether or not the query's results are fetched batch-wise by
+  /// separate requests. such queries must not hold on to a V8 context
+  /// between their uses
+  bool isStreaming() const { return _isStreaming; }
+
   /// @brief returns statistics for current query.
   void getStats(arangodb::velocypack::Builder&);
 
@@ -305,6 +358,11 @@ class Query {
     return _bindParameters.builder(); 
   }
 
+  /// @brief return the per-block execution statistics, if recorded
+  std::shared_ptr<arangodb::velocypack::Builder> blocksProfile() const {
+    return _blocksProfile;
+  }
+
  private:
   /// @brief initializes the query
   void init();
@@ -315,6 +373,22 @@ class Query {
   /// QueryRegistry.
   ExecutionPlan* prepare();
 
+  /// @brief prepare the execution plan of a query whose plan is kept in the
+  /// plan cache and reused for executions with other bind parameter values
+  ExecutionPlan* prepareReusablePlan();
+
+  /// @brief create the transaction and instantiate a plan from the plan cache
+  ExecutionPlan* instantiateCachedPlan(arangodb::velocypack::Slice);
+
+  /// @brief optimize the query with other values for the substitutable bind
+  /// parameters, and return the parameterized plan. returns a nullptr if
+  /// this fails
+  std::shared_ptr<arangodb::velocypack::Builder> probePlan(
+      arangodb::velocypack::Slice);
+
+  /// @brief build the plan cache key for the query
+  std::string planCacheKey(arangodb::velocypack::Slice, bool byValue) const;
+
   void setExecutionTime();
 
   /// @brief log a query
@@ -361,6 +435,14 @@ class Query {
   /// @brief enter a new state
   void enterState(QueryExecutionState::ValueType);
 
+  /// @brief collect the statistics of all execution blocks of the engine.
+  /// must be called before the engine is shut down
+  void profileBlocks();
+
+  /// @brief build the profile returned to the client, consisting of the
+  /// phase timings and the per-block statistics, if recorded
+  std::shared_ptr<arangodb::velocypack::Builder> profileToVelocyPack();
+
   /// @brief cleanup plan and engine for current query
   void cleanupPlanAndEngine(int, VPackBuilder* statsBuilder = nullptr);
 
@@ -417,6 +499,10 @@ class Query {
   /// @brief query execution profile
   std::unique_ptr<QueryProfile> _profile;
 
+  /// @brief per-block execution statistics, only recorded with profile
+  /// level 2
+  std::shared_ptr<arangodb::velocypack::Builder> _blocksProfile;
+
   /// @brief current state the query is in (used for profiling and error
   /// messages)
   QueryExecutionState::ValueType _state;
@@ -452,6 +538,9 @@ class Query {
 
   /// @brief whether or not the query is a data modification query
   bool _isModificationQuery;
+
+  /// @brief whether or not the query was prepared by prepareStreaming
+  bool _isStreaming;
   
   /// @brief global memory limit for AQL queries
   static uint64_t MemoryLimitValue;
@@ -44,14 +44,20 @@ static size_t MaxResults = 128;  // default value. can be changed later
 /// @brief whether or not the cache is enabled
 static std::atomic<arangodb::aql::QueryCacheMode> Mode(CACHE_ON_DEMAND);
 
+/// @brief how cached results are invalidated
+static std::atomic<arangodb::aql::QueryCacheInvalidation> Invalidation(
+    INVALIDATE_COLLECTIONS);
+
 /// @brief create a cache entry
 QueryCacheResultEntry::QueryCacheResultEntry(
     uint64_t hash, char const* queryString, size_t queryStringLength,
-    std::shared_ptr<VPackBuilder> queryResult, std::vector<std::string> const& collections)
+    std::shared_ptr<VPackBuilder> queryResult, std::vector<std::string> const& collections,
+    QueryCacheReadKeys&& keys)
     : _hash(hash),
       _queryString(queryString, queryStringLength),
       _queryResult(queryResult),
       _collections(collections),
+      _keys(std::move(keys)),
       _prev(nullptr),
       _next(nullptr),
       _refCount(0),
@@ -230,6 +236,63 @@ void QueryCacheDatabaseEntry::invalidate(std::string const& collection) {
   _entriesByCollection.erase(it);
 }
 
+/// @brief invalidate the entries for a collection in the database-specific
+/// cache that may have read one of the given document keys
+void QueryCacheDatabaseEntry::invalidate(
+    std::string const& collection, std::unordered_set<std::string> const& keys) {
+  auto it = _entriesByCollection.find(collection);
+
+  if (it == _entriesByCollection.end()) {
+    return;
+  }
+
+  auto& hashes = (*it).second;
+
+  for (auto it2 = hashes.begin(); it2 != hashes.end(); /* no hoisting */) {
+    auto it3 = _entriesByHash.find(*it2);
+
+    if (it3 == _entriesByHash.end()) {
+      // entry was already removed
+      it2 = hashes.erase(it2);
+      continue;
+    }
+
+    auto entry = (*it3).second;
+    auto it4 = entry->_keys.find(collection);
+
+    if (it4 != entry->_keys.end()) {
+      // the entry has only read some keys of the collection
+      bool found = false;
+      for (auto const& key : keys) {
+        if ((*it4).second.find(key) != (*it4).second.end()) {
+          found = true;
+          break;
+        }
+      }
+
+      if (!found) {
+        ++it2;
+        continue;
+      }
+    }
+
+    // remove entry from the linked list
+    unlink(entry);
+
+    // erase it from hash table
+    _entriesByHash.erase(it3);
+
+    // delete the object itself
+    tryDelete(entry);
+
+    it2 = hashes.erase(it2);
+  }
+
+  if (hashes.empty()) {
+    _entriesByCollection.erase(it);
+  }
+}
+
 /// @brief enforce maximum number of results
 void QueryCacheDatabaseEntry::enforceMaxResults(size_t value) {
   while (_numElements > value) {
@@ -313,6 +376,8 @@ VPackBuilder QueryCache::properties() {
   builder.openObject();
   builder.add("mode", VPackValue(modeString(mode())));
   builder.add("maxResults", VPackValue(MaxResults));
+  builder.add("invalidation",
+              VPackValue(invalidationModeString(invalidationMode())));
   builder.close();
 
   return builder;
@@ -360,6 +425,25 @@ std::string QueryCache::modeString(QueryCacheMode mode) {
   return "off";
 }
 
+/// @brief return the cache invalidation mode
+QueryCacheInvalidation QueryCache::invalidationMode() const {
+  return Invalidation.load(std::memory_order_relaxed);
+}
+
+/// @brief return a string version of the invalidation mode
+std::string QueryCache::invalidationModeString(
+    QueryCacheInvalidation invalidation) {
+  switch (invalidation) {
+    case INVALIDATE_COLLECTIONS:
+      return "collection";
+    case INVALIDATE_KEYS:
+      return "keys";
+  }
+
+  TRI_ASSERT(false);
+  return "collection";
+}
+
 /// @brief lookup a query result in the cache
 QueryCacheResultEntry* QueryCache::lookup(TRI_vocbase_t* vocbase, uint64_t hash,
                                           char const* queryString,
@@ -383,7 +467,7 @@ QueryCacheResultEntry* QueryCache::lookup(TRI_vocbase_t* vocbase, uint64_t hash,
 QueryCacheResultEntry* QueryCache::store(
     TRI_vocbase_t* vocbase, uint64_t hash, char const* queryString,
     size_t queryStringLength, std::shared_ptr<VPackBuilder> result,
-    std::vector<std::string> const& collections) {
+    std::vector<std::string> const& collections, QueryCacheReadKeys&& keys) {
 
 
   if (!result->slice().isArray()) {
@@ -395,7 +479,8 @@ QueryCacheResultEntry* QueryCache::store(
 
   // create the cache entry outside the lock
   auto entry = std::make_unique<QueryCacheResultEntry>(
-      hash, queryString, queryStringLength, result, collections);
+      hash, queryString, queryStringLength, result, collections,
+      std::move(keys));
 
   WRITE_LOCKER(writeLocker, _entriesLock[part]);
 
@@ -444,6 +529,24 @@ void QueryCache::invalidate(TRI_vocbase_t* vocbase, std::string const& collectio
   (*it).second->invalidate(collection);
 }
 
+/// @brief invalidate the queries for a particular collection that may
+/// have read one of the given document keys
+void QueryCache::invalidate(TRI_vocbase_t* vocbase,
+                            std::string const& collection,
+                            std::unordered_set<std::string> const& keys) {
+  auto const part = getPart(vocbase);
+  WRITE_LOCKER(writeLocker, _entriesLock[part]);
+
+  auto it = _entries[part].find(vocbase);
+
+  if (it == _entries[part].end()) {
+    return;
+  }
+
+  // invalidate while holding the lock
+  (*it).second->invalidate(collection, keys);
+}
+
 /// @brief invalidate all queries for a particular database
 void QueryCache::invalidate(TRI_vocbase_t* vocbase) {
   QueryCacheDatabaseEntry* databaseQueryCache = nullptr;
@@ -556,3 +659,12 @@ void QueryCache::setMode(std::string const& value) {
     setMode(CACHE_ALWAYS_OFF);
   }
 }
+
+/// @brief set the cache invalidation mode
+void QueryCache::setInvalidationMode(std::string const& value) {
+  if (value == "keys") {
+    Invalidation.store(INVALIDATE_KEYS, std::memory_order_release);
+  } else {
+    Invalidation.store(INVALIDATE_COLLECTIONS, std::memory_order_release);
+  }
+}
@@ -39,11 +39,20 @@ namespace aql {
 /// @brief cache mode
 enum QueryCacheMode { CACHE_ALWAYS_OFF, CACHE_ALWAYS_ON, CACHE_ON_DEMAND };
 
+/// @brief cache invalidation mode. with INVALIDATE_KEYS, results of queries
+/// that only read known document keys of a collection are kept when other
+/// documents of the collection are modified
+enum QueryCacheInvalidation { INVALIDATE_COLLECTIONS, INVALIDATE_KEYS };
+
+/// @brief the document keys read by a query, per collection
+typedef std::unordered_map<std::string, std::unordered_set<std::string>>
+    QueryCacheReadKeys;
+
 struct QueryCacheResultEntry {
   QueryCacheResultEntry() = delete;
 
   QueryCacheResultEntry(uint64_t, char const*, size_t, std::shared_ptr<arangodb::velocypack::Builder>,
-                        std::vector<std::string> const&);
+                        std::vector<std::string> const&, QueryCacheReadKeys&&);
 
   ~QueryCacheResultEntry() = default;
 
@@ -60,6 +69,9 @@ struct QueryCacheResultEntry {
   std::string const _queryString;
   std::shared_ptr<arangodb::velocypack::Builder> _queryResult;
   std::vector<std::string> const _collections;
+  /// @brief the document keys read from collections. collections missing
+  /// here were read without known keys
+  QueryCacheReadKeys const _keys;
   QueryCacheResultEntry* _prev;
   QueryCacheResultEntry* _next;
   std::atomic<uint32_t> _refCount;
@@ -112,6 +124,10 @@ struct QueryCacheDatabaseEntry {
   /// cache
   void invalidate(std::string const&);
 
+  /// @brief invalidate the entries for a collection in the database-specific
+  /// cache that may have read one of the given document keys
+  void invalidate(std::string const&, std::unordered_set<std::string> const&);
+
   /// @brief enforce maximum number of results
   void enforceMaxResults(size_t);
 
@@ -175,6 +191,12 @@ class QueryCache {
   /// @brief return a string version of the mode
   static std::string modeString(QueryCacheMode);
 
+  /// @brief return the cache invalidation mode
+  QueryCacheInvalidation invalidationMode() const;
+
+  /// @brief return a string version of the invalidation mode
+  static std::string invalidationModeString(QueryCacheInvalidation);
+
   /// @brief lookup a query result in the cache
   QueryCacheResultEntry* lookup(TRI_vocbase_t*, uint64_t, char const*, size_t);
 
@@ -183,7 +205,8 @@ class QueryCache {
   /// query result!
   QueryCacheResultEntry* store(TRI_vocbase_t*, uint64_t, char const*, size_t,
                                std::shared_ptr<arangodb::velocypack::Builder>,
-                               std::vector<std::string> const&);
+                               std::vector<std::string> const&,
+                               QueryCacheReadKeys&& = QueryCacheReadKeys());
 
   /// @brief invalidate all queries for the given collections
   void invalidate(TRI_vocbase_t*, std::vector<std::string> const&);
@@ -191,6 +214,11 @@ class QueryCache {
   /// @brief invalidate all queries for a particular collection
   void invalidate(TRI_vocbase_t*, std::string const&);
 
+  /// @brief invalidate the queries for a particular collection that may
+  /// have read one of the given document keys
+  void invalidate(TRI_vocbase_t*, std::string const&,
+                  std::unordered_set<std::string> const&);
+
   /// @brief invalidate all queries for a particular database
   void invalidate(TRI_vocbase_t*);
 
@@ -222,6 +250,9 @@ class QueryCache {
   /// @brief enable or disable the query cache
   void setMode(std::string const&);
 
+  /// @brief set the cache invalidation mode
+  void setInvalidationMode(std::string const&);
+
  private:
   /// @brief number of R/W locks for the query cache
   static uint64_t const NumberOfParts = 8;
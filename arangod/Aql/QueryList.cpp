@@ -23,6 +23,7 @@
 
 #include "Aql/QueryList.h"
 #include "Aql/Query.h"
+#include "Basics/MutexLocker.h"
 #include "Basics/ReadLocker.h"
 #include "Basics/StringRef.h"
 #include "Basics/WriteLocker.h"
@@ -36,9 +37,10 @@ QueryEntryCopy::QueryEntryCopy(TRI_voc_tick_t id,
                                std::string&& queryString, 
                                std::shared_ptr<arangodb::velocypack::Builder> bindParameters,
                                double started,
-                               double runTime, QueryExecutionState::ValueType state)
+                               double runTime, QueryExecutionState::ValueType state,
+                               std::shared_ptr<arangodb::velocypack::Builder> profile)
     : id(id), queryString(std::move(queryString)), bindParameters(bindParameters), 
-      started(started), runTime(runTime), state(state) {}
+      started(started), runTime(runTime), state(state), profile(profile) {}
 
 double const QueryList::DefaultSlowQueryThreshold = 10.0;
 size_t const QueryList::DefaultMaxSlowQueries = 64;
@@ -46,8 +48,8 @@ size_t const QueryList::DefaultMaxQueryStringLength = 4096;
 
 /// @brief create a query list
 QueryList::QueryList(TRI_vocbase_t*)
-    : _lock(),
-      _current(),
+    : _shards(),
+      _slowLock(),
       _slow(),
       _slowCount(0),
       _enabled(!Query::DisableQueryTracking()),
@@ -55,7 +57,9 @@ QueryList::QueryList(TRI_vocbase_t*)
       _slowQueryThreshold(Query::SlowQueryThreshold()),
       _maxSlowQueries(QueryList::DefaultMaxSlowQueries),
       _maxQueryStringLength(QueryList::DefaultMaxQueryStringLength) {
-  _current.reserve(64);
+  for (auto& it : _shards) {
+    it._current.reserve(8);
+  }
 }
 
 /// @brief insert a query
@@ -66,13 +70,14 @@ bool QueryList::insert(Query const* query) {
   }
 
   try {
-    WRITE_LOCKER(writeLocker, _lock);
+    Shard& shard = this->shard(query->id());
+    WRITE_LOCKER(writeLocker, shard._lock);
 
     TRI_IF_FAILURE("QueryList::insert") {
       THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
     }
 
-    auto it = _current.emplace(query->id(), query);
+    auto it = shard._current.emplace(query->id(), query);
     if (it.second) {
       return true;
     }
@@ -96,58 +101,59 @@ void QueryList::remove(Query const* query) {
     return;
   }
 
-  size_t const maxLength = _maxQueryStringLength;
-
-  WRITE_LOCKER(writeLocker, _lock);
-  auto it = _current.find(query->id());
+  {
+    Shard& shard = this->shard(query->id());
+    WRITE_LOCKER(writeLocker, shard._lock);
+    if (shard._current.erase(query->id()) == 0) {
+      return;
+    }
+  }
 
-  if (it != _current.end()) {
-    Query const* query = (*it).second;
-    _current.erase(it);
+  // the query is still alive, as it is removing itself. so it can be
+  // copied without holding the shard lock
+  double const started = query->startTime();
+  double const now = TRI_microtime();
 
-    TRI_ASSERT(query != nullptr);
-    double const started = query->startTime();
-    double const now = TRI_microtime();
+  try {
+    // check if we need to push the query into the list of slow queries
+    if (_trackSlowQueries && _slowQueryThreshold >= 0.0 &&
+        now - started >= _slowQueryThreshold) {
+      // yes.
 
-    try {
-      // check if we need to push the query into the list of slow queries
-      if (_trackSlowQueries && _slowQueryThreshold >= 0.0 &&
-          now - started >= _slowQueryThreshold) {
-        // yes.
+      TRI_IF_FAILURE("QueryList::remove") {
+        THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
+      }
 
-        TRI_IF_FAILURE("QueryList::remove") {
-          THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
-        }
+      std::string q = extractQueryString(query, _maxQueryStringLength);
 
-        std::string q = extractQueryString(query, maxLength);
+      LOG_TOPIC(WARN, Logger::QUERIES) << "slow query: '" << q << "', took: " << Logger::FIXED(now - started);
 
-        LOG_TOPIC(WARN, Logger::QUERIES) << "slow query: '" << q << "', took: " << Logger::FIXED(now - started);
+      QueryEntryCopy entry(query->id(), std::move(q),
+                           query->bindParameters(), started, now - started,
+                           QueryExecutionState::ValueType::FINISHED,
+                           query->blocksProfile());
 
-        _slow.emplace_back(QueryEntryCopy(
-            query->id(),
-            std::move(q),
-            query->bindParameters(),
-            started, now - started,
-            QueryExecutionState::ValueType::FINISHED));
+      MUTEX_LOCKER(mutexLocker, _slowLock);
+      _slow.emplace_back(std::move(entry));
 
-        if (++_slowCount > _maxSlowQueries) {
-          // free first element
-          _slow.pop_front();
-          --_slowCount;
-        }
+      if (++_slowCount > _maxSlowQueries) {
+        // free first element
+        _slow.pop_front();
+        --_slowCount;
       }
-    } catch (...) {
     }
+  } catch (...) {
   }
 }
 
 /// @brief kills a query
 int QueryList::kill(TRI_voc_tick_t id) {
-  WRITE_LOCKER(writeLocker, _lock);
+  Shard& shard = this->shard(id);
+  WRITE_LOCKER(writeLocker, shard._lock);
 
-  auto it = _current.find(id);
+  auto it = shard._current.find(id);
 
-  if (it == _current.end()) {
+  if (it == shard._current.end()) {
     return TRI_ERROR_QUERY_NOT_FOUND;
   }
 
@@ -164,21 +170,23 @@ int QueryList::kill(TRI_voc_tick_t id) {
 uint64_t QueryList::killAll(bool silent) {
   uint64_t killed = 0;
 
-  WRITE_LOCKER(writeLocker, _lock);
+  for (auto& shard : _shards) {
+    WRITE_LOCKER(writeLocker, shard._lock);
 
-  for (auto& it : _current) {
-    Query const* query = it.second;
-   
-    StringRef queryString(query->queryString(), query->queryLength());
-  
-    if (silent) {
-      LOG_TOPIC(TRACE, arangodb::Logger::FIXME) << "killing AQL query " << query->id() << " '" << queryString << "'";
-    } else {
-      LOG_TOPIC(WARN, arangodb::Logger::FIXME) << "killing AQL query " << query->id() << " '" << queryString << "'";
+    for (auto& it : shard._current) {
+      Query const* query = it.second;
+
+      StringRef queryString(query->queryString(), query->queryLength());
+
+      if (silent) {
+        LOG_TOPIC(TRACE, arangodb::Logger::FIXME) << "killing AQL query " << query->id() << " '" << queryString << "'";
+      } else {
+        LOG_TOPIC(WARN, arangodb::Logger::FIXME) << "killing AQL query " << query->id() << " '" << queryString << "'";
+      }
+
+      const_cast<arangodb::aql::Query*>(query)->killed(true);
+      ++killed;
     }
-    
-    const_cast<arangodb::aql::Query*>(query)->killed(true);
-    ++killed;
   }
 
   return killed;
@@ -191,11 +199,11 @@ std::vector<QueryEntryCopy> QueryList::listCurrent() {
 
   std::vector<QueryEntryCopy> result;
 
-  {
-    READ_LOCKER(readLocker, _lock);
-    result.reserve(_current.size());
+  for (auto& shard : _shards) {
+    READ_LOCKER(readLocker, shard._lock);
+    result.reserve(result.size() + shard._current.size());
 
-    for (auto const& it : _current) {
+    for (auto const& it : shard._current) {
       Query const* query = it.second;
 
       if (query == nullptr || query->queryString() == nullptr) {
@@ -203,13 +211,13 @@ std::vector<QueryEntryCopy> QueryList::listCurrent() {
       }
 
       double const started = query->startTime();
-       
+
       result.emplace_back(
           QueryEntryCopy(query->id(),
                          extractQueryString(query, maxLength),
                          query->bindParameters(),
                          started, now - started,
-                         query->state()));
+                         query->state(), nullptr));
     }
   }
 
@@ -221,7 +229,7 @@ std::vector<QueryEntryCopy> QueryList::listSlow() {
   std::vector<QueryEntryCopy> result;
 
   {
-    READ_LOCKER(readLocker, _lock);
+    MUTEX_LOCKER(mutexLocker, _slowLock);
     result.reserve(_slow.size());
     for (auto const& it : _slow) {
       result.emplace_back(it);
@@ -233,7 +241,7 @@ std::vector<QueryEntryCopy> QueryList::listSlow() {
 
 /// @brief clear the list of slow queries
 void QueryList::clearSlow() {
-  WRITE_LOCKER(writeLocker, _lock);
+  MUTEX_LOCKER(mutexLocker, _slowLock);
   _slow.clear();
   _slowCount = 0;
 }
@@ -26,6 +26,7 @@
 
 #include "Basics/Common.h"
 #include "Aql/QueryExecutionState.h"
+#include "Basics/Mutex.h"
 #include "Basics/ReadWriteLock.h"
 #include "VocBase/voc-types.h"
 
@@ -48,7 +49,8 @@ struct QueryEntryCopy {
                   std::shared_ptr<arangodb::velocypack::Builder> bindParameters,
                   double started,
                   double runTime,
-                  QueryExecutionState::ValueType state);
+                  QueryExecutionState::ValueType state,
+                  std::shared_ptr<arangodb::velocypack::Builder> profile);
 
   TRI_voc_tick_t const id;
   std::string const queryString;
@@ -56,6 +58,7 @@ struct QueryEntryCopy {
   double const started;
   double const runTime;
   QueryExecutionState::ValueType const state;
+  std::shared_ptr<arangodb::velocypack::Builder> const profile;
 };
 
 class QueryList {
@@ -163,11 +166,32 @@ class QueryList {
   std::string extractQueryString(Query const* query, size_t maxLength) const;
 
  private:
-  /// @brief r/w lock for the list
-  arangodb::basics::ReadWriteLock _lock;
+  /// @brief number of shards of the list of current queries. every query
+  /// registers and unregisters itself, so a single lock would serialize
+  /// all queries of a database
+  static constexpr size_t NumShards = 16;
+
+  /// @brief a part of the list of current queries, on its own cache line
+#ifdef _WIN32
+  struct Shard {
+#else
+  struct alignas(64) Shard {
+#endif
+    /// @brief r/w lock for the shard
+    arangodb::basics::ReadWriteLock _lock;
+
+    /// @brief current queries of the shard
+    std::unordered_map<TRI_voc_tick_t, Query const*> _current;
+  };
+
+  /// @brief return the shard responsible for a query id
+  inline Shard& shard(TRI_voc_tick_t id) { return _shards[id % NumShards]; }
+
+  /// @brief the list of current queries, sharded by query id
+  Shard _shards[NumShards];
 
-  /// @brief list of current queries
-  std::unordered_map<TRI_voc_tick_t, Query const*> _current;
+  /// @brief mutex for the list of slow queries
+  arangodb::Mutex _slowLock;
 
   /// @brief list of slow queries
   std::list<QueryEntryCopy> _slow;
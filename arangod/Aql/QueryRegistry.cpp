@@ -24,11 +24,11 @@
 #include "QueryRegistry.h"
 #include "Aql/ExecutionEngine.h"
 #include "Aql/Query.h"
-#include "Basics/ReadLocker.h"
-#include "Basics/WriteLocker.h"
+#include "Basics/ConditionLocker.h"
 #include "Cluster/CollectionLockState.h"
 #include "Logger/Logger.h"
 #include "Transaction/Methods.h"
+#include "VocBase/vocbase.h"
 
 using namespace arangodb;
 using namespace arangodb::aql;
@@ -36,27 +36,15 @@ using namespace arangodb::aql;
 QueryRegistry::~QueryRegistry() {
   std::vector<std::pair<std::string, QueryId>> toDelete;
 
-  {
-    WRITE_LOCKER(writeLocker, _lock);
-
-    try {
-      for (auto& x : _queries) {
-        // x.first is a TRI_vocbase_t* and
-        // x.second is a std::unordered_map<QueryId, QueryInfo*>
-        for (auto& y : x.second) {
-          // y.first is a QueryId and
-          // y.second is a QueryInfo*
-          toDelete.emplace_back(x.first, y.first);
-        }
-      }
-    } catch (...) {
-      // the emplace_back() above might fail
-      // prevent throwing exceptions in the destructor
-    }
+  try {
+    toDelete = collect([](QueryInfo const*) { return true; });
+  } catch (...) {
+    // the emplace_back() in collect() might fail
+    // prevent throwing exceptions in the destructor
   }
 
-  // note: destroy() will acquire _lock itself, so it must be called without
-  // holding the lock
+  // note: destroy() will acquire the shard lock itself, so it must be called
+  // without holding the lock
   for (auto& p : toDelete) {
     try {  // just in case
       destroy(p.first, p.second, TRI_ERROR_TRANSACTION_ABORTED);
@@ -71,17 +59,11 @@ void QueryRegistry::insert(QueryId id, Query* query, double ttl) {
   TRI_ASSERT(query->trx() != nullptr);
   auto vocbase = query->vocbase();
 
-  WRITE_LOCKER(writeLocker, _lock);
+  Shard& s = shard(id);
+  CONDITION_LOCKER(guard, s._condition);
 
-  auto m = _queries.find(vocbase->name());
-  if (m == _queries.end()) {
-    m = _queries.emplace(vocbase->name(),
-                         std::unordered_map<QueryId, QueryInfo*>()).first;
-
-    TRI_ASSERT(_queries.find(vocbase->name()) != _queries.end());
-  }
-  auto q = m->second.find(id);
-  if (q == m->second.end()) {
+  auto q = s._queries.find(id);
+  if (q == s._queries.end()) {
     auto p = std::make_unique<QueryInfo>();
     p->_vocbase = vocbase;
     p->_id = id;
@@ -89,11 +71,10 @@ void QueryRegistry::insert(QueryId id, Query* query, double ttl) {
     p->_isOpen = false;
     p->_timeToLive = ttl;
     p->_expires = TRI_microtime() + ttl;
-    m->second.emplace(id, p.get());
+    s._queries.emplace(id, p.get());
     p.release();
 
-    TRI_ASSERT(_queries.find(vocbase->name())->second.find(id) !=
-                         _queries.find(vocbase->name())->second.end());
+    TRI_ASSERT(s._queries.find(id) != s._queries.end());
 
     // If we have set _noLockHeaders, we need to unset it:
     if (CollectionLockState::_noLockHeaders != nullptr) {
@@ -113,23 +94,39 @@ void QueryRegistry::insert(QueryId id, Query* query, double ttl) {
 
 /// @brief open
 Query* QueryRegistry::open(TRI_vocbase_t* vocbase, QueryId id) {
+  return open(vocbase, id, 0.0);
+}
+
+/// @brief open, waiting for the query to be closed by another thread
+Query* QueryRegistry::open(TRI_vocbase_t* vocbase, QueryId id,
+                           double maxWait) {
   // std::cout << "Taking out query with ID " << id << std::endl;
-  WRITE_LOCKER(writeLocker, _lock);
+  Shard& s = shard(id);
 
-  auto m = _queries.find(vocbase->name());
-  if (m == _queries.end()) {
-    m = _queries.emplace(vocbase->name(),
-                         std::unordered_map<QueryId, QueryInfo*>()).first;
-  }
-  auto q = m->second.find(id);
-  if (q == m->second.end()) {
-    return nullptr;
-  }
-  QueryInfo* qi = q->second;
-  if (qi->_isOpen) {
+  CONDITION_LOCKER(guard, s._condition);
+
+  QueryInfo* qi = nullptr;
+
+  // close() and destroy() broadcast on the condition. the entry may be
+  // gone when we wake up, so it must be looked up again
+  bool closed = waitWhile(guard, maxWait, [&]() {
+    auto q = s._queries.find(id);
+    if (q == s._queries.end() || q->second->_vocbase != vocbase) {
+      qi = nullptr;
+      return false;
+    }
+    qi = q->second;
+    return qi->_isOpen;
+  });
+
+  if (!closed) {
     THROW_ARANGO_EXCEPTION_MESSAGE(
         TRI_ERROR_INTERNAL, "query with given vocbase and id is already open");
   }
+  if (qi == nullptr) {
+    return nullptr;
+  }
+
   qi->_isOpen = true;
 
   // If we had set _noLockHeaders, we need to reset it:
@@ -148,15 +145,11 @@ Query* QueryRegistry::open(TRI_vocbase_t* vocbase, QueryId id) {
 /// @brief close
 void QueryRegistry::close(TRI_vocbase_t* vocbase, QueryId id, double ttl) {
   // std::cout << "Returning query with ID " << id << std::endl;
-  WRITE_LOCKER(writeLocker, _lock);
+  Shard& s = shard(id);
+  CONDITION_LOCKER(guard, s._condition);
 
-  auto m = _queries.find(vocbase->name());
-  if (m == _queries.end()) {
-    m = _queries.emplace(vocbase->name(),
-                         std::unordered_map<QueryId, QueryInfo*>()).first;
-  }
-  auto q = m->second.find(id);
-  if (q == m->second.end()) {
+  auto q = s._queries.find(id);
+  if (q == s._queries.end() || q->second->_vocbase != vocbase) {
     THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL,
                                    "query with given vocbase and id not found");
   }
@@ -172,36 +165,28 @@ void QueryRegistry::close(TRI_vocbase_t* vocbase, QueryId id, double ttl) {
         qi->_query->engine()->lockedShards()) {
       // std::cout << "Resetting _noLockHeaders to nullptr\n";
       CollectionLockState::_noLockHeaders = nullptr;
-    } else {
-      if (CollectionLockState::_noLockHeaders != nullptr) {
-        if (CollectionLockState::_noLockHeaders ==
-            qi->_query->engine()->lockedShards()) {
-          CollectionLockState::_noLockHeaders = nullptr;
-        }
-        // else {
-        // We have not set it, just leave it alone. This happens in particular
-        // on the DBServers, who do not set lockedShards() themselves.
-        // }
-      }
     }
+    // else {
+    // We have not set it, just leave it alone. This happens in particular
+    // on the DBServers, who do not set lockedShards() themselves.
+    // }
   }
 
   qi->_isOpen = false;
-  qi->_expires = TRI_microtime() + qi->_timeToLive;
+  qi->_expires = TRI_microtime() + (ttl < 0.0 ? qi->_timeToLive : ttl);
+
+  // wake up threads waiting to open this (or another) query of the shard
+  guard.broadcast();
 }
 
 /// @brief destroy
 void QueryRegistry::destroy(std::string const& vocbase, QueryId id,
                             int errorCode) {
-  WRITE_LOCKER(writeLocker, _lock);
+  Shard& s = shard(id);
+  CONDITION_LOCKER(guard, s._condition);
 
-  auto m = _queries.find(vocbase);
-  if (m == _queries.end()) {
-    m = _queries.emplace(vocbase, std::unordered_map<QueryId, QueryInfo*>())
-            .first;
-  }
-  auto q = m->second.find(id);
-  if (q == m->second.end()) {
+  auto q = s._queries.find(id);
+  if (q == s._queries.end() || q->second->_vocbase->name() != vocbase) {
     THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL,
                                    "query with given vocbase and id not found");
   }
@@ -231,7 +216,10 @@ void QueryRegistry::destroy(std::string const& vocbase, QueryId id,
   delete qi;
 
   q->second = nullptr;
-  m->second.erase(q);
+  s._queries.erase(q);
+
+  // threads waiting to open the query will now find it gone
+  guard.broadcast();
 }
 
 /// @brief destroy
@@ -239,27 +227,52 @@ void QueryRegistry::destroy(TRI_vocbase_t* vocbase, QueryId id, int errorCode) {
   destroy(vocbase->name(), id, errorCode);
 }
 
-/// @brief expireQueries
-void QueryRegistry::expireQueries() {
-  double now = TRI_microtime();
-  std::vector<std::pair<std::string, QueryId>> toDelete;
+/// @brief wait on the locked condition while busy returns true
+bool QueryRegistry::waitWhile(basics::ConditionLocker& guard, double maxWait,
+                              std::function<bool()> const& busy) {
+  double end = 0.0;
+
+  while (busy()) {
+    double const now = TRI_microtime();
+    if (end == 0.0) {
+      end = now + maxWait;
+    }
+    if (now >= end) {
+      return false;
+    }
+    guard.wait(static_cast<uint64_t>((end - now) * 1000000.0));
+  }
+
+  return true;
+}
+
+/// @brief collect the ids of all queries, for which the predicate holds
+std::vector<std::pair<std::string, QueryId>> QueryRegistry::collect(
+    std::function<bool(QueryInfo const*)> const& predicate) {
+  std::vector<std::pair<std::string, QueryId>> result;
 
-  {
-    WRITE_LOCKER(writeLocker, _lock);
-    for (auto& x : _queries) {
-      // x.first is a TRI_vocbase_t* and
-      // x.second is a std::unordered_map<QueryId, QueryInfo*>
-      for (auto& y : x.second) {
-        // y.first is a QueryId and
-        // y.second is a QueryInfo*
-        QueryInfo*& qi = y.second;
-        if (!qi->_isOpen && now > qi->_expires) {
-          toDelete.emplace_back(x.first, y.first);
-        }
+  for (auto& s : _shards) {
+    CONDITION_LOCKER(guard, s._condition);
+
+    for (auto const& it : s._queries) {
+      // it.first is a QueryId and
+      // it.second is a QueryInfo*
+      if (predicate(it.second)) {
+        result.emplace_back(it.second->_vocbase->name(), it.first);
       }
     }
   }
 
+  return result;
+}
+
+/// @brief expireQueries
+void QueryRegistry::expireQueries() {
+  double now = TRI_microtime();
+  auto toDelete = collect([now](QueryInfo const* qi) {
+    return !qi->_isOpen && now > qi->_expires;
+  });
+
   for (auto& p : toDelete) {
     try {  // just in case
       destroy(p.first, p.second, TRI_ERROR_TRANSACTION_ABORTED);
@@ -270,25 +283,18 @@ void QueryRegistry::expireQueries() {
 
 /// @brief return number of registered queries
 size_t QueryRegistry::numberRegisteredQueries() {
-  READ_LOCKER(readLocker, _lock);
   size_t sum = 0;
-  for (auto const&m : _queries) {
-    sum += m.second.size();
+  for (auto& s : _shards) {
+    CONDITION_LOCKER(guard, s._condition);
+    sum += s._queries.size();
   }
   return sum;
 }
 
 /// @brief for shutdown, we need to shut down all queries:
 void QueryRegistry::destroyAll() {
-  std::vector<std::pair<std::string, QueryId>> allQueries;
-  {
-    READ_LOCKER(readlock, _lock);
-    for (auto& p : _queries) {
-      for (auto& q : p.second) {
-        allQueries.emplace_back(p.first, q.first);
-      }
-    }
-  }
+  auto allQueries = collect([](QueryInfo const*) { return true; });
+
   for (auto& p : allQueries) {
     destroy(p.first, p.second, TRI_ERROR_SHUTTING_DOWN);
   }
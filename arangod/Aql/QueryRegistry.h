@@ -25,12 +25,16 @@
 #define ARANGOD_AQL_QUERY_REGISTRY_H 1
 
 #include "Basics/Common.h"
-#include "Basics/ReadWriteLock.h"
+#include "Basics/ConditionVariable.h"
 #include "Aql/types.h"
 
 struct TRI_vocbase_t;
 
 namespace arangodb {
+namespace basics {
+class ConditionLocker;
+}
+
 namespace aql {
 class Query;
 
@@ -58,6 +62,11 @@ class QueryRegistry {
   /// is thrown.
   Query* open(TRI_vocbase_t* vocbase, QueryId id);
 
+  /// @brief open, like above, but if the query is currently open, wait for
+  /// at most maxWait seconds until it is closed instead of throwing. throws
+  /// if the query is still open after that time
+  Query* open(TRI_vocbase_t* vocbase, QueryId id, double maxWait);
+
   /// @brief close, return a query to the registry, if the query is not found,
   /// an exception is thrown. If the ttl is negative (the default is), the
   /// original ttl is taken again.
@@ -80,6 +89,13 @@ class QueryRegistry {
   /// @brief for shutdown, we need to shut down all queries:
   void destroyAll();
 
+  /// @brief wait on the condition locked by guard for as long as busy
+  /// returns true, but for at most maxWait seconds. busy is called with the
+  /// lock held, after every wake up. returns false if it is still busy
+  /// after that time
+  static bool waitWhile(basics::ConditionLocker& guard, double maxWait,
+                        std::function<bool()> const& busy);
+
  private:
   /// @brief a struct for all information regarding one query in the registry
   struct QueryInfo {
@@ -92,12 +108,25 @@ class QueryRegistry {
     double _expires;          // UNIX UTC timestamp of expiration
   };
 
-  /// @brief _queries, the actual map of maps for the registry
-  std::unordered_map<std::string, std::unordered_map<QueryId, QueryInfo*>>
-      _queries;
+  /// @brief one part of the registry. query ids are unique per server, so
+  /// the registry is split by query id only, and every part has its own
+  /// lock. closing a query wakes up threads waiting to open it
+  struct Shard {
+    basics::ConditionVariable _condition;
+    std::unordered_map<QueryId, QueryInfo*> _queries;
+  };
+
+  /// @brief number of shards, must be a power of two
+  static size_t const NumShards = 32;
+
+  Shard& shard(QueryId id) { return _shards[id & (NumShards - 1)]; }
+
+  /// @brief collect the ids of all queries, for which the predicate holds
+  std::vector<std::pair<std::string, QueryId>> collect(
+      std::function<bool(QueryInfo const*)> const& predicate);
 
-  /// @brief _lock, the read/write lock for access
-  basics::ReadWriteLock _lock;
+  /// @brief the shards of the registry
+  Shard _shards[NumShards];
 };
 
 }  // namespace arangodb::aql
@@ -378,7 +378,7 @@ void RestAqlHandler::createQueryFromString() {
 //             excessive copying. The result is the JSON representation of an
 //             AqlItemBlock.
 //             If "atLeast" is not given it defaults to 1, if "atMost" is not
-//             given it defaults to ExecutionBlock::DefaultBatchSize.
+//             given it defaults to the batch size of the root block.
 // For the "skipSome" operation one has to give:
 //   "atLeast":
 //   "atMost": both must be positive integers, the cursor skips never
@@ -391,7 +391,7 @@ void RestAqlHandler::createQueryFromString() {
 //             single attribute "skipped" containing the number of
 //             skipped items.
 //             If "atLeast" is not given it defaults to 1, if "atMost" is not
-//             given it defaults to ExecutionBlock::DefaultBatchSize.
+//             given it defaults to the batch size of the root block.
 // For the "skip" operation one should give:
 //   "number": must be a positive integer, the cursor skips as many items,
 //             possibly exhausting the cursor.
@@ -646,25 +646,17 @@ bool RestAqlHandler::findQuery(std::string const& idString, Query*& query) {
   _qId = arangodb::basics::StringUtils::uint64(idString);
   query = nullptr;
 
-  // sleep for 10ms each time, wait for at most 30 seconds...
-  static int64_t const SingleWaitPeriod = 10 * 1000;
-  static int64_t const MaxIterations =
-      static_cast<int64_t>(30.0 * 1000000.0 / (double)SingleWaitPeriod);
+  // if the query is currently used by someone else (e.g. a request for
+  // another shard of the same query), the registry waits until it is
+  // returned, for at most 30 seconds
+  static double const MaxWait = 30.0;
 
-  int64_t iterations = 0;
-
-  // probably need to cycle here until we can get hold of the query
-  while (++iterations < MaxIterations) {
-    try {
-      query = _queryRegistry->open(_vocbase, _qId);
-      // we got the query (or it was not found - at least no one else
-      // can now have access to the same query)
-      break;
-    } catch (...) {
-      // we can only get here if the query is currently used by someone
-      // else. in this case we sleep for a while and re-try
-      usleep(SingleWaitPeriod);
-    }
+  try {
+    query = _queryRegistry->open(_vocbase, _qId, MaxWait);
+    // we got the query (or it was not found - at least no one else
+    // can now have access to the same query)
+  } catch (...) {
+    // the query was in use for the whole time
   }
 
   if (query == nullptr) {
@@ -719,7 +711,7 @@ void RestAqlHandler::handleUseQuery(std::string const& operation, Query* query,
         auto atLeast =
             VelocyPackHelper::getNumericValue<size_t>(querySlice, "atLeast", 1);
         auto atMost = VelocyPackHelper::getNumericValue<size_t>(
-            querySlice, "atMost", ExecutionBlock::DefaultBatchSize());
+            querySlice, "atMost", query->engine()->root()->batchSize());
         std::unique_ptr<AqlItemBlock> items;
         if (shardId.empty()) {
           items.reset(query->engine()->getSome(atLeast, atMost));
@@ -748,7 +740,7 @@ void RestAqlHandler::handleUseQuery(std::string const& operation, Query* query,
         auto atLeast =
             VelocyPackHelper::getNumericValue<size_t>(querySlice, "atLeast", 1);
         auto atMost = VelocyPackHelper::getNumericValue<size_t>(
-            querySlice, "atMost", ExecutionBlock::DefaultBatchSize());
+            querySlice, "atMost", query->engine()->root()->batchSize());
         size_t skipped;
         try {
           if (shardId.empty()) {
@@ -30,18 +30,22 @@ using namespace arangodb::aql;
 /// @brief maximum length of a "short" string
 size_t const ShortStringStorage::MaxStringLength = 127;
 
+/// @brief maximum size of a block in the short string storage
+size_t const ShortStringStorage::MaxBlockSize = 64 * 1024;
+
 /// @brief create a short string storage instance
 ShortStringStorage::ShortStringStorage(ResourceMonitor* resourceMonitor, size_t blockSize)
-    : _resourceMonitor(resourceMonitor), _blocks(), _blockSize(blockSize), _current(nullptr), _end(nullptr) {
+    : _resourceMonitor(resourceMonitor), _blocks(), _blockSize(blockSize), _allocated(0), _current(nullptr), _end(nullptr) {
   TRI_ASSERT(blockSize >= 64);
+  TRI_ASSERT(blockSize <= MaxBlockSize);
 }
 
 /// @brief destroy a short string storage instance
 ShortStringStorage::~ShortStringStorage() {
   for (auto& it : _blocks) {
-    _resourceMonitor->decreaseMemoryUsage(_blockSize);
     delete[] it;
   }
+  _resourceMonitor->decreaseMemoryUsage(_allocated);
 }
 
 /// @brief register a short string
@@ -79,8 +83,11 @@ void ShortStringStorage::allocateBlock() {
       _resourceMonitor->decreaseMemoryUsage(_blockSize);
       throw;
     }
+    _allocated += _blockSize;
     _current = buffer;
     _end = _current + _blockSize;
+    // queries that register many strings get fewer, bigger blocks
+    _blockSize = (std::min)(_blockSize * 2, MaxBlockSize);
   } catch (...) {
     delete[] buffer;
     throw;
@@ -50,14 +50,21 @@ class ShortStringStorage {
   /// @brief maximum length of strings in short string storage
   static size_t const MaxStringLength;
 
+  /// @brief maximum size of a single block. blocks start at the size
+  /// passed into the constructor and double in size until they reach it
+  static size_t const MaxBlockSize;
+
  private:
   ResourceMonitor* _resourceMonitor;
 
   /// @brief already allocated string blocks
   std::vector<char*> _blocks;
 
-  /// @brief size of each block
-  size_t const _blockSize;
+  /// @brief size of the next block to allocate
+  size_t _blockSize;
+
+  /// @brief cumulated size of all blocks in _blocks
+  size_t _allocated;
 
   /// @brief offset into current block
   char* _current;
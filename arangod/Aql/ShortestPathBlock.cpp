@@ -72,9 +72,9 @@ struct ConstDistanceExpanderLocal {
                   std::vector<VPackSlice>& neighbors) {
     TRI_ASSERT(v.isString());
     std::string id = v.copyString();
-    ManagedDocumentResult* mmdr = _block->_mmdr.get();
+    ManagedDocumentResult* mmdr = _block->mmdr(_isReverse);
     std::unique_ptr<arangodb::OperationCursor> edgeCursor;
-    for (auto const& edgeCollection : _block->_collectionInfos) {
+    for (auto const& edgeCollection : _block->collectionInfos(_isReverse)) {
       TRI_ASSERT(edgeCollection != nullptr);
       if (_isReverse) {
         edgeCursor = edgeCollection->getReverseEdges(id, mmdr);
@@ -201,10 +201,10 @@ struct EdgeWeightExpanderLocal {
                   std::vector<ArangoDBPathFinder::Step*>& result) {
     TRI_ASSERT(source.isString());
     std::string id = source.copyString();
-    ManagedDocumentResult* mmdr = _block->_mmdr.get();
+    ManagedDocumentResult* mmdr = _block->mmdr(_reverse);
     std::unique_ptr<arangodb::OperationCursor> edgeCursor;
     std::unordered_map<VPackSlice, size_t> candidates;
-    for (auto const& edgeCollection : _block->_collectionInfos) {
+    for (auto const& edgeCollection : _block->collectionInfos(_reverse)) {
       TRI_ASSERT(edgeCollection != nullptr);
       if (_reverse) {
         edgeCursor = edgeCollection->getReverseEdges(id, mmdr);
@@ -342,6 +342,24 @@ ShortestPathBlock::ShortestPathBlock(ExecutionEngine* engine,
     info.release();
   }
 
+  bool const isCoordinator = arangodb::ServerState::instance()->isCoordinator();
+  bool const parallel = _opts.multiThreaded && !isCoordinator;
+
+  if (parallel) {
+    // the backward expander runs concurrently with the forward one, so it
+    // gets its own document buffer and edge collection infos
+    _reverseMmdr.reset(new ManagedDocumentResult);
+    _reverseCollectionInfos.reserve(count);
+
+    for (size_t j = 0; j < count; ++j) {
+      auto info = std::make_unique<arangodb::traverser::EdgeCollectionInfo>(
+          _trx, ep->_edgeColls[j], ep->_directions[j], _opts.weightAttribute,
+          _opts.defaultWeight);
+      _reverseCollectionInfos.emplace_back(info.get());
+      info.release();
+    }
+  }
+
   if (!ep->usesStartInVariable()) {
     _startVertexId = ep->getStartVertex();
   } else {
@@ -369,7 +387,7 @@ ShortestPathBlock::ShortestPathBlock(ExecutionEngine* engine,
   }
   _path = std::make_unique<arangodb::traverser::ShortestPath>();
 
-  if (arangodb::ServerState::instance()->isCoordinator()) {
+  if (isCoordinator) {
     if (_opts.useWeight) {
       _finder.reset(new arangodb::basics::DynamicDistanceFinder<
                     arangodb::velocypack::Slice, arangodb::velocypack::Slice,
@@ -391,7 +409,8 @@ ShortestPathBlock::ShortestPathBlock(ExecutionEngine* engine,
                     arangodb::velocypack::Slice, arangodb::velocypack::Slice,
                     double, arangodb::traverser::ShortestPath>(
           EdgeWeightExpanderLocal(this, false),
-          EdgeWeightExpanderLocal(this, true), _opts.bidirectional));
+          EdgeWeightExpanderLocal(this, true), _opts.bidirectional,
+          parallel));
     } else {
       _finder.reset(new arangodb::basics::ConstDistanceFinder<
                     arangodb::velocypack::Slice, arangodb::velocypack::Slice,
@@ -399,7 +418,7 @@ ShortestPathBlock::ShortestPathBlock(ExecutionEngine* engine,
                     arangodb::basics::VelocyPackHelper::VPackStringEqual,
                     arangodb::traverser::ShortestPath>(
           ConstDistanceExpanderLocal(this, false),
-          ConstDistanceExpanderLocal(this, true)));
+          ConstDistanceExpanderLocal(this, true), parallel));
     }
   }
 }
@@ -408,6 +427,9 @@ ShortestPathBlock::~ShortestPathBlock() {
   for (auto& it : _collectionInfos) {
     delete it;
   }
+  for (auto& it : _reverseCollectionInfos) {
+    delete it;
+  }
 }
 
 int ShortestPathBlock::initialize() {
@@ -430,6 +452,15 @@ int ShortestPathBlock::initialize() {
     _edgeReg = it->second.registerId;
   }
 
+  if (res == TRI_ERROR_NO_ERROR && !_reverseCollectionInfos.empty()) {
+    // in parallel mode both expanders look up edges at the same time.
+    // pinning a collection modifies the transaction context, so all edge
+    // collections are pinned here, before any expander thread is started
+    for (auto const& it : _collectionInfos) {
+      _trx->pinData(_trx->addCollectionAtRuntime(it->getName()));
+    }
+  }
+
   return res;
 
   // cppcheck-suppress style
@@ -549,7 +580,7 @@ AqlItemBlock* ShortestPathBlock::getSome(size_t, size_t atMost) {
   }
 
   if (_buffer.empty()) {
-    size_t toFetch = (std::min)(DefaultBatchSize(), atMost);
+    size_t toFetch = (std::min)(batchSize(), atMost);
     if (!ExecutionBlock::getBlock(toFetch, toFetch)) {
       _done = true;
       traceGetSomeEnd(nullptr);
@@ -629,6 +660,7 @@ AqlItemBlock* ShortestPathBlock::getSome(size_t, size_t atMost) {
 }
 
 size_t ShortestPathBlock::skipSome(size_t, size_t atMost) {
-  return 0;
+  traceSkipSomeBegin();
+  return traceSkipSomeEnd(0);
 }
 
@@ -77,6 +77,20 @@ class ShortestPathBlock : public ExecutionBlock {
   /// @brief Checks if we output the edge
   bool usesEdgeOutput() { return _edgeVar != nullptr; }
 
+  /// @brief document buffer for the expander of the given direction
+  ManagedDocumentResult* mmdr(bool reverse) const {
+    return (reverse && _reverseMmdr != nullptr) ? _reverseMmdr.get()
+                                                : _mmdr.get();
+  }
+
+  /// @brief edge collection infos for the expander of the given direction
+  std::vector<arangodb::traverser::EdgeCollectionInfo*> const&
+  collectionInfos(bool reverse) const {
+    return (reverse && !_reverseCollectionInfos.empty())
+               ? _reverseCollectionInfos
+               : _collectionInfos;
+  }
+
   /// SECTION private Variables
 
   /// @brief Variable for the vertex output
@@ -99,6 +113,12 @@ class ShortestPathBlock : public ExecutionBlock {
   /// @brief list of edge collection infos used to compute the path
   std::vector<arangodb::traverser::EdgeCollectionInfo*> _collectionInfos;
 
+  /// @brief document buffer and edge collection infos of the backward
+  /// expander. only set in parallel mode, in which both expanders run
+  /// concurrently and must not share the search builders of the infos
+  std::unique_ptr<ManagedDocumentResult> _reverseMmdr;
+  std::vector<arangodb::traverser::EdgeCollectionInfo*> _reverseCollectionInfos;
+
   /// @brief position in the current path
   size_t _posInPath;
 
@@ -267,6 +267,7 @@ void ShortestPathNode::fillOptions(arangodb::traverser::ShortestPathOptions& opt
   } else {
     opts.useWeight = false;
   }
+  opts.multiThreaded = _options.parallel;
 }
 
 ShortestPathNode::ShortestPathNode(ExecutionPlan* plan,
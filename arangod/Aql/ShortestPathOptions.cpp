@@ -27,7 +27,7 @@
 using namespace arangodb::aql;
 
 ShortestPathOptions::ShortestPathOptions(VPackSlice const& slice) 
-    : weightAttribute(), defaultWeight(1) {
+    : weightAttribute(), defaultWeight(1), parallel(false) {
   VPackSlice obj = slice.get("shortestPathFlags");
 
   if (obj.isObject()) {
@@ -44,6 +44,13 @@ ShortestPathOptions::ShortestPathOptions(VPackSlice const& slice)
         defaultWeight = v.getNumericValue<double>();
       }
     }
+
+    if (obj.hasKey("parallel")) {
+      VPackSlice v = obj.get("parallel");
+      if (v.isBoolean()) {
+        parallel = v.getBool();
+      }
+    }
   }
 }
 
@@ -51,4 +58,5 @@ void ShortestPathOptions::toVelocyPack(VPackBuilder& builder) const {
   VPackObjectBuilder guard(&builder);
   builder.add("weightAttribute", VPackValue(weightAttribute));
   builder.add("defaultWeight", VPackValue(defaultWeight));
+  builder.add("parallel", VPackValue(parallel));
 }
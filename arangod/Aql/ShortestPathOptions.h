@@ -40,12 +40,17 @@ struct ShortestPathOptions {
   /// @brief constructor, using default values
   ShortestPathOptions()
       : weightAttribute(),
-        defaultWeight(1) {}
+        defaultWeight(1),
+        parallel(false) {}
 
   void toVelocyPack(arangodb::velocypack::Builder&) const;
 
   std::string weightAttribute;
   double defaultWeight;
+
+  /// @brief whether or not both search directions are expanded
+  /// concurrently. only used on a single server
+  bool parallel;
 };
 
 }  // namespace arangodb::aql
@@ -24,13 +24,50 @@
 #include "SortBlock.h"
 #include "Aql/AqlItemBlock.h"
 #include "Aql/ExecutionEngine.h"
+#include "Aql/Query.h"
+#include "Aql/SpillFile.h"
 #include "Basics/Exceptions.h"
+#include "Basics/Utf8Helper.h"
+#include "Basics/VelocyPackHelper.h"
+#include "Transaction/Context.h"
+#include "Transaction/Methods.h"
 #include "VocBase/vocbase.h"
 
+#include <velocypack/Options.h>
+#include <velocypack/velocypack-aliases.h>
+
 using namespace arangodb::aql;
 
+namespace {
+
+/// @brief minimum number of rows for which sort keys are computed. for
+/// fewer rows, the strings are not compared often enough
+constexpr size_t MinRowsForSortKeys = 32;
+
+/// @brief estimate the amount of memory used by the values of a block
+size_t EstimateMemoryUsage(AqlItemBlock const* block) {
+  size_t const n = block->size();
+  RegisterId const nrRegs = block->getNrRegs();
+
+  size_t memory = n * nrRegs * sizeof(AqlValue);
+  for (size_t i = 0; i < n; ++i) {
+    for (RegisterId j = 0; j < nrRegs; ++j) {
+      memory += block->getValueReference(i, j).memoryUsage();
+    }
+  }
+  return memory;
+}
+
+}  // namespace
+
 SortBlock::SortBlock(ExecutionEngine* engine, SortNode const* en)
-    : ExecutionBlock(engine, en), _sortRegisters(), _stable(en->_stable), _mustFetchAll(true) {
+    : ExecutionBlock(engine, en),
+      _sortRegisters(),
+      _stable(en->_stable),
+      _mustFetchAll(true),
+      _limit(en->limit()),
+      _spillThreshold(engine->getQuery()->spillThreshold()),
+      _spillRegs(0) {
   for (auto const& p : en->_elements) {
     auto it = en->getRegisterPlan()->varInfo.find(p.var->id);
     TRI_ASSERT(it != en->getRegisterPlan()->varInfo.end());
@@ -51,6 +88,8 @@ int SortBlock::initializeCursor(AqlItemBlock* items, size_t pos) {
 
   _mustFetchAll = !_done;
   _pos = 0;
+  _merge.reset();
+  _runs.clear();
 
   return TRI_ERROR_NO_ERROR;
 
@@ -66,15 +105,44 @@ int SortBlock::getOrSkipSome(size_t atLeast, size_t atMost, bool skipping,
   
   if (_mustFetchAll) {
     // suck all blocks into _buffer
-    while (getBlock(DefaultBatchSize(), DefaultBatchSize())) {
+    size_t memoryUsage = 0;
+    size_t rows = 0;
+    while (getBlock(batchSize(), batchSize())) {
+      if (_limit > 0) {
+        // only the first _limit rows are needed, so there is no need to spill
+        // anything. instead we periodically throw away the rows that cannot
+        // make it into the result anymore
+        rows += _buffer.back()->size();
+        if (rows >= _limit + batchSize()) {
+          doSorting();
+          rows = (std::min)(rows, _limit);
+        }
+      } else if (_spillThreshold > 0) {
+        memoryUsage += EstimateMemoryUsage(_buffer.back());
+        if (memoryUsage > _spillThreshold) {
+          // write a sorted run of what we have so far
+          spillRun();
+          memoryUsage = 0;
+        }
+      }
     }
 
     _mustFetchAll = false;
-    if (!_buffer.empty()) {
+    if (!_runs.empty()) {
+      if (!_buffer.empty()) {
+        spillRun();
+      }
+      startMerge();
+    } else if (!_buffer.empty()) {
       doSorting();
     }
   }
 
+  if (!_runs.empty()) {
+    getOrSkipSomeMerged(atMost, skipping, result, skipped);
+    return TRI_ERROR_NO_ERROR;
+  }
+
   return ExecutionBlock::getOrSkipSome(atLeast, atMost, skipping, result, skipped);
   
   // cppcheck-suppress style
@@ -107,11 +175,25 @@ void SortBlock::doSorting() {
     count++;
   }
 
+  // a full sort compares every string O(log n) times, so collating each
+  // of them once up front is cheaper. a partial sort for a LIMIT mostly
+  // compares each row once, against the current limit
+  std::vector<SortKeys> sortKeys;
+  std::vector<size_t> blockStarts;
+  bool const useSortKeys = (_limit == 0 || _limit >= sum) &&
+                           sum >= MinRowsForSortKeys &&
+                           buildSortKeys(sortKeys, blockStarts);
+
   // comparison function
-  OurLessThan ourLessThan(_trx, _buffer, _sortRegisters);
+  OurLessThan ourLessThan(_trx, _buffer, _sortRegisters,
+                          useSortKeys ? &sortKeys : nullptr, &blockStarts);
 
   // sort coords
-  if (_stable) {
+  if (_limit > 0 && _limit < sum) {
+    // we only need the first _limit rows
+    sortFirst(coords, _limit, ourLessThan);
+    sum = _limit;
+  } else if (_stable) {
     std::stable_sort(coords.begin(), coords.end(), ourLessThan);
   } else {
     std::sort(coords.begin(), coords.end(), ourLessThan);
@@ -131,7 +213,7 @@ void SortBlock::doSorting() {
     // install the rearranged values from _buffer into newbuffer
 
     while (count < sum) {
-      size_t sizeNext = (std::min)(sum - count, DefaultBatchSize());
+      size_t sizeNext = (std::min)(sum - count, batchSize());
       AqlItemBlock* next = requestBlock(sizeNext, nrRegs);
 
       try {
@@ -241,12 +323,174 @@ void SortBlock::doSorting() {
   DEBUG_END_BLOCK();  
 }
 
+bool SortBlock::hasMore() {
+  if (_merge != nullptr && _merge->hasMore()) {
+    return true;
+  }
+  return ExecutionBlock::hasMore();
+}
+
+/// @brief sort the buffered blocks and write them to a new run file
+void SortBlock::spillRun() {
+  DEBUG_BEGIN_BLOCK();
+  TRI_ASSERT(!_buffer.empty());
+
+  doSorting();
+
+  auto run = std::make_unique<SpillFile>();
+  _spillRegs = _buffer.front()->getNrRegs();
+
+  for (auto const& block : _buffer) {
+    TRI_ASSERT(block->getNrRegs() == _spillRegs);
+    for (size_t i = 0; i < block->size(); ++i) {
+      run->appendRow(_trx, block, i);
+    }
+    throwIfKilled();  // check if we were aborted
+  }
+  run->finish();
+  _runs.emplace_back(std::move(run));
+
+  for (auto& block : _buffer) {
+    returnBlock(block);
+  }
+  _buffer.clear();
+  DEBUG_END_BLOCK();
+}
+
+/// @brief prepare the k-way merge of all run files
+void SortBlock::startMerge() {
+  VPackOptions* options = _trx->transactionContextPtr()->getVPackOptions();
+  auto const& sortRegisters = _sortRegisters;
+
+  auto less = [options, &sortRegisters](VPackSlice const& lhs,
+                                        VPackSlice const& rhs) {
+    for (auto const& reg : sortRegisters) {
+      int cmp = arangodb::basics::VelocyPackHelper::compare(
+          lhs.at(reg.first), rhs.at(reg.first), true, options);
+
+      if (cmp < 0) {
+        return reg.second;
+      } else if (cmp > 0) {
+        return !reg.second;
+      }
+    }
+    return false;
+  };
+
+  _merge.reset(new SpillFileMerge(_runs, less));
+}
+
+/// @brief produce or skip the next rows from the merged run files
+void SortBlock::getOrSkipSomeMerged(size_t atMost, bool skipping,
+                                    AqlItemBlock*& result, size_t& skipped) {
+  DEBUG_BEGIN_BLOCK();
+  if (!_merge->hasMore()) {
+    _done = true;
+    return;
+  }
+
+  std::unique_ptr<AqlItemBlock> res;
+  if (!skipping) {
+    res.reset(requestBlock(atMost, _spillRegs));
+  }
+
+  size_t count = 0;
+  VPackSlice row;
+  while (count < atMost && _merge->next(row)) {
+    if (!skipping) {
+      SpillFile::readRow(row, res.get(), count);
+    }
+    ++count;
+  }
+
+  if (!_merge->hasMore()) {
+    _done = true;
+  }
+
+  if (skipping) {
+    skipped = count;
+  } else {
+    if (count < atMost) {
+      res->shrink(count, false);
+    }
+    result = res.release();
+  }
+  DEBUG_END_BLOCK();
+}
+
+bool SortBlock::buildSortKeys(std::vector<SortKeys>& sortKeys,
+                              std::vector<size_t>& blockStarts) const {
+  blockStarts.reserve(_buffer.size());
+  size_t rows = 0;
+  for (auto const& block : _buffer) {
+    blockStarts.emplace_back(rows);
+    rows += block->size();
+  }
+
+  auto const& helper = arangodb::basics::Utf8Helper::DefaultUtf8Helper;
+
+  sortKeys.resize(_sortRegisters.size());
+  for (size_t i = 0; i < _sortRegisters.size(); ++i) {
+    RegisterId const reg = _sortRegisters[i].first;
+    SortKeys& keys = sortKeys[i];
+    keys.entries.reserve(rows);
+
+    for (auto const& block : _buffer) {
+      size_t const n = block->size();
+      for (size_t j = 0; j < n; ++j) {
+        AqlValue const& value = block->getValueReference(j, reg);
+        SortKeys::Entry entry{keys.data.size(), 0, 0};
+
+        if (value.isString()) {
+          VPackValueLength length;
+          char const* p = value.slice().getString(length);
+          if (!helper.appendSortKey(p, static_cast<size_t>(length),
+                                    keys.data)) {
+            // no collator
+            return false;
+          }
+          entry.keyLength = keys.data.size() - entry.offset;
+          entry.valueLength = static_cast<size_t>(length);
+        }
+        keys.entries.emplace_back(entry);
+      }
+    }
+  }
+
+  return true;
+}
+
 bool SortBlock::OurLessThan::operator()(std::pair<size_t, size_t> const& a,
                                         std::pair<size_t, size_t> const& b) const {
-  for (auto const& reg : _sortRegisters) {
-    int cmp = AqlValue::Compare(
-        _trx, _buffer[a.first]->getValueReference(a.second, reg.first),
-        _buffer[b.first]->getValueReference(b.second, reg.first), true);
+  for (size_t i = 0; i < _sortRegisters.size(); ++i) {
+    auto const& reg = _sortRegisters[i];
+    int cmp = 0;
+
+    SortKeys::Entry const* left = nullptr;
+    SortKeys::Entry const* right = nullptr;
+    if (_sortKeys != nullptr) {
+      auto const& entries = (*_sortKeys)[i].entries;
+      left = &entries[(*_blockStarts)[a.first] + a.second];
+      right = &entries[(*_blockStarts)[b.first] + b.second];
+    }
+
+    if (left != nullptr && left->keyLength > 0 && right->keyLength > 0) {
+      // two strings. this is the same order as the collation of them
+      char const* data = (*_sortKeys)[i].data.data();
+      cmp = memcmp(data + left->offset, data + right->offset,
+                   (std::min)(left->keyLength, right->keyLength));
+      if (cmp == 0) {
+        if (left->keyLength != right->keyLength) {
+          cmp = left->keyLength < right->keyLength ? -1 : 1;
+        } else if (left->valueLength != right->valueLength) {
+          cmp = left->valueLength < right->valueLength ? -1 : 1;
+        }
+      }
+    } else {
+      cmp = AqlValue::Compare(
+          _trx, _buffer[a.first]->getValueReference(a.second, reg.first),
+          _buffer[b.first]->getValueReference(b.second, reg.first), true);
+    }
 
     if (cmp < 0) {
       return reg.second;
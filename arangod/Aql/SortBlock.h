@@ -28,6 +28,8 @@
 #include "Aql/ExecutionBlock.h"
 #include "Aql/SortNode.h"
 
+#include <velocypack/Slice.h>
+
 namespace arangodb {
 namespace transaction {
 class Methods;
@@ -40,6 +42,9 @@ class AqlItemBlock;
 
 class ExecutionEngine;
 
+class SpillFile;
+class SpillFileMerge;
+
 class SortBlock final : public ExecutionBlock {
  public:
   SortBlock(ExecutionEngine*, SortNode const*);
@@ -50,19 +55,84 @@ class SortBlock final : public ExecutionBlock {
 
   int getOrSkipSome(size_t atLeast, size_t atMost, bool skipping, AqlItemBlock*&, size_t& skipped) override final;
 
-  /// @brief dosorting
+  bool hasMore() override final;
+
+  /// @brief sort the first limit coords, and drop the others. ties are
+  /// broken by the position of the rows, so the result is the same as the
+  /// first limit rows of a stable sort
+  template <typename LessThan>
+  static void sortFirst(std::vector<std::pair<size_t, size_t>>& coords,
+                        size_t limit, LessThan const& lessThan) {
+    TRI_ASSERT(limit < coords.size());
+    std::partial_sort(coords.begin(), coords.begin() + limit, coords.end(),
+                      [&lessThan](std::pair<size_t, size_t> const& a,
+                                  std::pair<size_t, size_t> const& b) {
+                        if (lessThan(a, b)) {
+                          return true;
+                        }
+                        if (lessThan(b, a)) {
+                          return false;
+                        }
+                        return a < b;
+                      });
+    coords.resize(limit);
+  }
+
+  /// @brief dosorting. if _limit is set, only the first _limit rows are
+  /// kept in _buffer
  private:
   void doSorting();
 
+  /// @brief sort the buffered blocks and write them to a new run file
+  void spillRun();
+
+  /// @brief prepare the k-way merge of all run files
+  void startMerge();
+
+  /// @brief produce or skip the next rows from the merged run files
+  void getOrSkipSomeMerged(size_t atMost, bool skipping, AqlItemBlock*& result,
+                           size_t& skipped);
+
+  /// @brief the ICU sort keys of the string values of one sort register,
+  /// so that sorting compares them with memcmp instead of collating the
+  /// strings in every comparison
+  struct SortKeys {
+    struct Entry {
+      /// @brief position of the sort key in data
+      size_t offset;
+      /// @brief length of the sort key, 0 if the value is not a string
+      size_t keyLength;
+      /// @brief length of the string, which orders strings that collate
+      /// equal
+      size_t valueLength;
+    };
+
+    /// @brief the concatenated sort keys
+    std::string data;
+
+    /// @brief the entries of all buffered rows, in buffer order
+    std::vector<Entry> entries;
+  };
+
+  /// @brief compute the sort keys of all buffered rows, and the index of
+  /// the first row of each block in the entries. returns false if no sort
+  /// keys can be computed
+  bool buildSortKeys(std::vector<SortKeys>& sortKeys,
+                     std::vector<size_t>& blockStarts) const;
+
   /// @brief OurLessThan
   class OurLessThan {
    public:
     OurLessThan(transaction::Methods* trx,
                 std::deque<AqlItemBlock*>& buffer,
-                std::vector<std::pair<RegisterId, bool>>& sortRegisters)
+                std::vector<std::pair<RegisterId, bool>>& sortRegisters,
+                std::vector<SortKeys> const* sortKeys = nullptr,
+                std::vector<size_t> const* blockStarts = nullptr)
         : _trx(trx),
           _buffer(buffer),
-          _sortRegisters(sortRegisters) {}
+          _sortRegisters(sortRegisters),
+          _sortKeys(sortKeys),
+          _blockStarts(blockStarts) {}
 
     bool operator()(std::pair<size_t, size_t> const& a,
                     std::pair<size_t, size_t> const& b) const;
@@ -71,6 +141,10 @@ class SortBlock final : public ExecutionBlock {
     transaction::Methods* _trx;
     std::deque<AqlItemBlock*>& _buffer;
     std::vector<std::pair<RegisterId, bool>>& _sortRegisters;
+    /// @brief the sort keys per sort register, or nullptr if the values
+    /// are compared directly
+    std::vector<SortKeys> const* _sortKeys;
+    std::vector<size_t> const* _blockStarts;
   };
 
   /// @brief pairs, consisting of variable and sort direction
@@ -81,6 +155,24 @@ class SortBlock final : public ExecutionBlock {
   bool _stable;
 
   bool _mustFetchAll;
+
+  /// @brief maximum number of rows to produce (if the sort is followed by a
+  /// LIMIT). 0 means all rows are produced
+  size_t _limit;
+
+  /// @brief amount of memory for buffered blocks after which a sorted run
+  /// is written to a temporary file. 0 means sorting in memory only
+  size_t _spillThreshold;
+
+  /// @brief sorted runs that have been spilled to temporary files, in
+  /// input order
+  std::vector<std::unique_ptr<SpillFile>> _runs;
+
+  /// @brief merge of the runs
+  std::unique_ptr<SpillFileMerge> _merge;
+
+  /// @brief number of registers of the spilled rows
+  RegisterId _spillRegs;
 };
 
 }  // namespace arangodb::aql
@@ -53,7 +53,7 @@ class SortNode : public ExecutionNode {
  public:
   SortNode(ExecutionPlan* plan, size_t id, SortElementVector const& elements,
            bool stable)
-      : ExecutionNode(plan, id), _reinsertInCluster(true), _elements(elements), _stable(stable) {}
+      : ExecutionNode(plan, id), _reinsertInCluster(true), _elements(elements), _stable(stable), _limit(0) {}
 
   SortNode(ExecutionPlan* plan, arangodb::velocypack::Slice const& base,
            SortElementVector const& elements, bool stable);
@@ -64,6 +64,13 @@ class SortNode : public ExecutionNode {
   /// @brief whether or not the sort is stable
   inline bool isStable() const { return _stable; }
 
+  /// @brief maximum number of rows the sort needs to produce. this is set
+  /// if the sort is followed by a LIMIT. 0 means all rows are produced
+  inline size_t limit() const { return _limit; }
+
+  /// @brief set the maximum number of rows the sort needs to produce
+  void setLimit(size_t limit) { _limit = limit; }
+
   /// @brief export to VelocyPack
   void toVelocyPackHelper(arangodb::velocypack::Builder&,
                           bool) const override final;
@@ -72,6 +79,7 @@ class SortNode : public ExecutionNode {
   ExecutionNode* clone(ExecutionPlan* plan, bool withDependencies,
                        bool withProperties) const override final {
     auto c = new SortNode(plan, _id, _elements, _stable);
+    c->setLimit(_limit);
 
     cloneHelper(c, plan, withDependencies, withProperties);
 
@@ -103,6 +111,9 @@ class SortNode : public ExecutionNode {
   /// @brief get Variables Used Here including ASC/DESC
   SortElementVector const& getElements() const { return _elements; }
 
+  /// @brief replace the sort elements
+  void setElements(SortElementVector const& elements) { _elements = elements; }
+
   /// @brief returns all sort information
   SortInformation getSortInformation(ExecutionPlan*,
                                      arangodb::basics::StringBuffer*) const;
@@ -130,6 +141,9 @@ class SortNode : public ExecutionNode {
 
   /// whether or not the sort is stable
   bool _stable;
+
+  /// @brief maximum number of rows to produce, 0 = all
+  size_t _limit;
 };
 
 }  // namespace arangodb::aql
@@ -0,0 +1,257 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "SpillFile.h"
+#include "Aql/AqlItemBlock.h"
+#include "Aql/AqlValue.h"
+#include "Basics/Exceptions.h"
+#include "Basics/files.h"
+#include "Logger/Logger.h"
+
+#include <velocypack/Iterator.h>
+#include <velocypack/velocypack-aliases.h>
+
+#include <algorithm>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+SpillFile::SpillFile()
+    : _writing(true), _count(0), _byteSize(0), _read(0) {
+  char* filename = nullptr;
+  std::string errorMessage;
+  long systemError;
+
+  if (TRI_GetTempName("aql", &filename, true, systemError, errorMessage) !=
+      TRI_ERROR_NO_ERROR) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(
+        TRI_ERROR_CANNOT_CREATE_TEMP_FILE,
+        "could not create temporary file for AQL query: " + errorMessage);
+  }
+
+  if (filename == nullptr) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+  }
+
+  _filename.append(filename);
+  TRI_Free(TRI_CORE_MEM_ZONE, filename);
+
+  _file.open(_filename, std::ios::in | std::ios::out | std::ios::binary |
+                            std::ios::trunc);
+
+  if (!_file.is_open()) {
+    TRI_UnlinkFile(_filename.c_str());
+    THROW_ARANGO_EXCEPTION_MESSAGE(
+        TRI_ERROR_CANNOT_CREATE_TEMP_FILE,
+        "could not open temporary file '" + _filename + "' for AQL query");
+  }
+}
+
+SpillFile::~SpillFile() {
+  _file.close();
+
+  int res = TRI_UnlinkFile(_filename.c_str());
+
+  if (res != TRI_ERROR_NO_ERROR) {
+    LOG_TOPIC(WARN, Logger::QUERIES) << "unable to remove temporary file '"
+                                     << _filename << "'";
+  }
+}
+
+/// @brief append a value to the file
+void SpillFile::append(VPackSlice const& slice) {
+  TRI_ASSERT(_writing);
+
+  uint64_t const length = static_cast<uint64_t>(slice.byteSize());
+
+  _file.write(reinterpret_cast<char const*>(&length), sizeof(length));
+  _file.write(reinterpret_cast<char const*>(slice.begin()),
+              static_cast<std::streamsize>(length));
+
+  if (!_file.good()) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(
+        TRI_ERROR_CANNOT_WRITE_FILE,
+        "could not write to temporary file '" + _filename + "'");
+  }
+
+  ++_count;
+  _byteSize += sizeof(length) + length;
+}
+
+/// @brief append a row of a block to the file
+void SpillFile::appendRow(transaction::Methods* trx, AqlItemBlock const* block,
+                          size_t row) {
+  RegisterId const nrRegs = block->getNrRegs();
+
+  _builder.clear();
+  _builder.openArray();
+  for (RegisterId reg = 0; reg < nrRegs; ++reg) {
+    AqlValue const& value = block->getValueReference(row, reg);
+    if (value.isEmpty()) {
+      _builder.add(VPackValue(VPackValueType::MinKey));
+    } else {
+      value.toVelocyPack(trx, _builder, false);
+    }
+  }
+  _builder.close();
+
+  append(_builder.slice());
+}
+
+/// @brief finish writing, and prepare the file for reading
+void SpillFile::finish() {
+  TRI_ASSERT(_writing);
+
+  _file.flush();
+  _writing = false;
+  _builder.clear();
+  rewind();
+}
+
+/// @brief restart reading at the beginning of the file
+void SpillFile::rewind() {
+  TRI_ASSERT(!_writing);
+
+  _file.clear();
+  _file.seekg(0, std::ios::beg);
+  _read = 0;
+}
+
+/// @brief read the next value from the file. returns false if the end of
+/// the file has been reached. the slice is valid until the next call
+bool SpillFile::next(VPackSlice& slice) {
+  TRI_ASSERT(!_writing);
+
+  if (_read >= _count) {
+    return false;
+  }
+
+  uint64_t length;
+  _file.read(reinterpret_cast<char*>(&length), sizeof(length));
+
+  if (_file.good()) {
+    _buffer.reset();
+    _buffer.prealloc(length);
+    _file.read(reinterpret_cast<char*>(_buffer.data()),
+               static_cast<std::streamsize>(length));
+  }
+
+  if (!_file.good()) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(
+        TRI_ERROR_INTERNAL,
+        "could not read from temporary file '" + _filename + "'");
+  }
+
+  ++_read;
+  slice = VPackSlice(_buffer.data());
+  return true;
+}
+
+/// @brief copy a row value that has been read from the file into a block
+void SpillFile::readRow(VPackSlice const& slice, AqlItemBlock* block,
+                        size_t row) {
+  TRI_ASSERT(slice.isArray());
+  TRI_ASSERT(slice.length() == block->getNrRegs());
+
+  RegisterId reg = 0;
+  for (auto const& it : VPackArrayIterator(slice)) {
+    if (!it.isMinKey()) {
+      AqlValue a(it);
+      AqlValueGuard guard(a, true);
+      block->setValue(row, reg, a);
+      guard.steal();  // itemblock has taken over now
+    }
+    ++reg;
+  }
+}
+
+SpillFileMerge::SpillFileMerge(
+    std::vector<std::unique_ptr<SpillFile>> const& files, LessFunc const& less)
+    : _files(files), _less(less), _pending(SIZE_MAX) {
+  size_t const n = _files.size();
+
+  _heads.resize(n);
+  _heap.reserve(n);
+
+  for (size_t i = 0; i < n; ++i) {
+    _files[i]->rewind();
+    if (_files[i]->next(_heads[i])) {
+      _heap.emplace_back(i);
+    }
+  }
+
+  std::make_heap(_heap.begin(), _heap.end(),
+                 [this](size_t a, size_t b) { return greater(a, b); });
+}
+
+/// @brief read the next value in sorted order. returns false if all
+/// values have been read
+bool SpillFileMerge::next(VPackSlice& slice) {
+  advance();
+
+  if (_heap.empty()) {
+    return false;
+  }
+
+  // the file with the smallest current value is now at the back
+  std::pop_heap(_heap.begin(), _heap.end(),
+                [this](size_t a, size_t b) { return greater(a, b); });
+  _pending = _heap.back();
+  _heap.pop_back();
+
+  slice = _heads[_pending];
+  return true;
+}
+
+/// @brief whether or not there are more values
+bool SpillFileMerge::hasMore() {
+  advance();
+  return !_heap.empty();
+}
+
+/// @brief read the next value of the file whose value was returned last
+void SpillFileMerge::advance() {
+  if (_pending == SIZE_MAX) {
+    return;
+  }
+
+  size_t const file = _pending;
+  _pending = SIZE_MAX;
+
+  if (_files[file]->next(_heads[file])) {
+    _heap.emplace_back(file);
+    std::push_heap(_heap.begin(), _heap.end(),
+                   [this](size_t a, size_t b) { return greater(a, b); });
+  }
+}
+
+/// @brief whether or not the current value of file a must be returned
+/// after the current value of file b
+bool SpillFileMerge::greater(size_t a, size_t b) const {
+  if (_less(_heads[b], _heads[a])) {
+    return true;
+  }
+  if (_less(_heads[a], _heads[b])) {
+    return false;
+  }
+  // equal values are returned in the order of the files
+  return a > b;
+}
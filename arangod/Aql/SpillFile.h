@@ -0,0 +1,174 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_AQL_SPILL_FILE_H
+#define ARANGOD_AQL_SPILL_FILE_H 1
+
+#include "Basics/Common.h"
+#include "Aql/types.h"
+
+#include <velocypack/Buffer.h>
+#include <velocypack/Builder.h>
+#include <velocypack/Slice.h>
+
+#include <fstream>
+#include <functional>
+
+namespace arangodb {
+namespace transaction {
+class Methods;
+}
+
+namespace aql {
+class AqlItemBlock;
+
+// a <SpillFile> is a temporary file that execution blocks can use to move
+// intermediate results out of memory. The file is written sequentially
+// once (via append or appendRow), then switched to reading (via finish) and
+// read sequentially (via next or readRow), possibly multiple times (via
+// rewind). The file is removed when the <SpillFile> is destroyed.
+//
+// Each entry is a VelocyPack value, prefixed with its length. Rows of an
+// <AqlItemBlock> are stored as arrays with one value per register. Empty
+// registers are stored as MinKey, which cannot occur in AQL values.
+
+class SpillFile {
+ public:
+  SpillFile();
+  SpillFile(SpillFile const&) = delete;
+  SpillFile& operator=(SpillFile const&) = delete;
+
+  ~SpillFile();
+
+ public:
+  /// @brief append a value to the file
+  void append(arangodb::velocypack::Slice const& slice);
+
+  /// @brief append a row of a block to the file
+  void appendRow(transaction::Methods* trx, AqlItemBlock const* block,
+                 size_t row);
+
+  /// @brief finish writing, and prepare the file for reading
+  void finish();
+
+  /// @brief restart reading at the beginning of the file
+  void rewind();
+
+  /// @brief read the next value from the file. returns false if the end of
+  /// the file has been reached. the slice is valid until the next call
+  bool next(arangodb::velocypack::Slice& slice);
+
+  /// @brief copy a row value that has been read from the file into a block
+  static void readRow(arangodb::velocypack::Slice const& slice,
+                      AqlItemBlock* block, size_t row);
+
+  /// @brief number of values in the file
+  inline size_t count() const { return _count; }
+
+  /// @brief number of bytes written to the file
+  inline size_t byteSize() const { return _byteSize; }
+
+  /// @brief name of the file
+  inline std::string const& filename() const { return _filename; }
+
+ private:
+  /// @brief name of the file
+  std::string _filename;
+
+  /// @brief file stream
+  std::fstream _file;
+
+  /// @brief whether or not the file is still being written
+  bool _writing;
+
+  /// @brief number of values in the file
+  size_t _count;
+
+  /// @brief number of bytes written
+  size_t _byteSize;
+
+  /// @brief number of values read since the last rewind
+  size_t _read;
+
+  /// @brief buffer for the current value when reading
+  arangodb::velocypack::Buffer<uint8_t> _buffer;
+
+  /// @brief builder for rows when writing
+  arangodb::velocypack::Builder _builder;
+};
+
+// a <SpillFileMerge> reads several finished <SpillFile>s whose values are
+// sorted, and returns all values in sorted order. Values that compare equal
+// are returned in the order of the files, and within a file in the order
+// they were written, so merging runs that were sorted stably and written in
+// input order is stable as well.
+
+class SpillFileMerge {
+ public:
+  /// @brief returns whether the first value must be returned before the
+  /// second one
+  typedef std::function<bool(arangodb::velocypack::Slice const&,
+                             arangodb::velocypack::Slice const&)>
+      LessFunc;
+
+  SpillFileMerge(std::vector<std::unique_ptr<SpillFile>> const& files,
+                 LessFunc const& less);
+  SpillFileMerge(SpillFileMerge const&) = delete;
+  SpillFileMerge& operator=(SpillFileMerge const&) = delete;
+
+ public:
+  /// @brief read the next value in sorted order. returns false if all
+  /// values have been read. the slice is valid until the next call of
+  /// next() or hasMore()
+  bool next(arangodb::velocypack::Slice& slice);
+
+  /// @brief whether or not there are more values
+  bool hasMore();
+
+ private:
+  /// @brief read the next value of the file whose value was returned last
+  void advance();
+
+  /// @brief whether or not the current value of file a must be returned
+  /// after the current value of file b
+  bool greater(size_t a, size_t b) const;
+
+ private:
+  std::vector<std::unique_ptr<SpillFile>> const& _files;
+
+  LessFunc const _less;
+
+  /// @brief current value of each file
+  std::vector<arangodb::velocypack::Slice> _heads;
+
+  /// @brief heap of the files that still have values, ordered by their
+  /// current values
+  std::vector<size_t> _heap;
+
+  /// @brief the file whose value was returned last, and which has not been
+  /// advanced yet
+  size_t _pending;
+};
+
+}  // namespace arangodb::aql
+}  // namespace arangodb
+
+#endif
@@ -23,8 +23,11 @@
 
 #include "SubqueryBlock.h"
 #include "Aql/AqlItemBlock.h"
+#include "Aql/ClusterBlocks.h"
 #include "Aql/ExecutionEngine.h"
+#include "Aql/Query.h"
 #include "Basics/Exceptions.h"
+#include "Cluster/ServerState.h"
 #include "VocBase/vocbase.h"
 
 using namespace arangodb::aql;
@@ -34,13 +37,19 @@ SubqueryBlock::SubqueryBlock(ExecutionEngine* engine, SubqueryNode const* en,
     : ExecutionBlock(engine, en),
       _outReg(ExecutionNode::MaxRegisterId),
       _subquery(subquery),
-      _subqueryIsConst(const_cast<SubqueryNode*>(en)->isConst()) {
+      _subqueryIsConst(const_cast<SubqueryNode*>(en)->isConst()),
+      _constResult(),
+      _subqueryIsIndependent(_subqueryIsConst &&
+                             en->getVariablesUsedHere().empty()),
+      _subqueryStarted(false) {
   auto it = en->getRegisterPlan()->varInfo.find(en->_outVariable->id);
   TRI_ASSERT(it != en->getRegisterPlan()->varInfo.end());
   _outReg = it->second.registerId;
   TRI_ASSERT(_outReg < ExecutionNode::MaxRegisterId);
 }
 
+SubqueryBlock::~SubqueryBlock() { _constResult.destroy(); }
+
 /// @brief initialize, tell dependency and the subquery
 int SubqueryBlock::initialize() {
   int res = ExecutionBlock::initialize();
@@ -52,6 +61,31 @@ int SubqueryBlock::initialize() {
   return getSubquery()->initialize();
 }
 
+/// @brief initializeCursor, could be called multiple times
+int SubqueryBlock::initializeCursor(AqlItemBlock* items, size_t pos) {
+  DEBUG_BEGIN_BLOCK();
+  int res = ExecutionBlock::initializeCursor(items, pos);
+
+  if (res != TRI_ERROR_NO_ERROR) {
+    return res;
+  }
+
+  // an independent subquery on a coordinator does not need to wait for
+  // its input rows. start its DB server parts now, so that they run
+  // concurrently with the ones of the other subqueries of the query
+  if (_subqueryIsIndependent && !_subqueryStarted && _constResult.isEmpty() &&
+      arangodb::ServerState::instance()->isCoordinator() &&
+      _engine->_startedSubqueries <
+          _engine->getQuery()->maxParallelSubqueries()) {
+    startSubquery();
+  }
+
+  return TRI_ERROR_NO_ERROR;
+
+  // cppcheck-suppress style
+  DEBUG_END_BLOCK();
+}
+
 /// @brief getSome
 AqlItemBlock* SubqueryBlock::getSome(size_t atLeast, size_t atMost) {
   DEBUG_BEGIN_BLOCK();
@@ -70,18 +104,34 @@ AqlItemBlock* SubqueryBlock::getSome(size_t atLeast, size_t atMost) {
   std::vector<AqlItemBlock*>* subqueryResults = nullptr;
 
   for (size_t i = 0; i < res->size(); i++) {
-    int ret = _subquery->initializeCursor(res.get(), i);
-
-    if (ret != TRI_ERROR_NO_ERROR) {
-      THROW_ARANGO_EXCEPTION(ret);
-    }
-
     if (i > 0 && _subqueryIsConst) {
       // re-use already calculated subquery result
-      TRI_ASSERT(subqueryResults != nullptr);
-      res->setValue(i, _outReg, AqlValue(subqueryResults));
+      res->setValue(i, _outReg, res->getValueReference(0, _outReg));
+    } else if (_subqueryIsConst && !_constResult.isEmpty()) {
+      // the subquery was executed for an earlier block already. its result
+      // is shared by the rows of a block, but each block needs its own copy
+      AqlValue a = _constResult.clone();
+      try {
+        res->setValue(i, _outReg, a);
+      } catch (...) {
+        a.destroy();
+        throw;
+      }
     } else {
       // initial subquery execution or subquery is not constant
+      if (_subqueryStarted) {
+        // the subquery was initialized already and does not depend on
+        // the input row
+        _subqueryStarted = false;
+        TRI_ASSERT(_engine->_startedSubqueries > 0);
+        --_engine->_startedSubqueries;
+      } else {
+        int ret = _subquery->initializeCursor(res.get(), i);
+
+        if (ret != TRI_ERROR_NO_ERROR) {
+          THROW_ARANGO_EXCEPTION(ret);
+        }
+      }
 
       // execute the subquery
       subqueryResults = executeSubquery();
@@ -96,17 +146,22 @@ AqlItemBlock* SubqueryBlock::getSome(size_t atLeast, size_t atMost) {
         }
         subqueryResults->clear();
         res->setValue(i, _outReg, AqlValue(subqueryResults));
-        continue;
+      } else {
+        try {
+          TRI_IF_FAILURE("SubqueryBlock::getSome") {
+            THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
+          }
+          res->setValue(i, _outReg, AqlValue(subqueryResults));
+        } catch (...) {
+          destroySubqueryResults(subqueryResults);
+          throw;
+        }
       }
 
-      try {
-        TRI_IF_FAILURE("SubqueryBlock::getSome") {
-          THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
-        }
-        res->setValue(i, _outReg, AqlValue(subqueryResults));
-      } catch (...) {
-        destroySubqueryResults(subqueryResults);
-        throw;
+      if (_subqueryIsConst) {
+        // keep a copy of the result for the following blocks, so that
+        // the subquery is executed only once per query
+        _constResult = res->getValueReference(i, _outReg).clone();
       }
     }
 
@@ -124,6 +179,12 @@ AqlItemBlock* SubqueryBlock::getSome(size_t atLeast, size_t atMost) {
 
 /// @brief shutdown, tell dependency and the subquery
 int SubqueryBlock::shutdown(int errorCode) {
+  if (_subqueryStarted) {
+    _subqueryStarted = false;
+    TRI_ASSERT(_engine->_startedSubqueries > 0);
+    --_engine->_startedSubqueries;
+  }
+
   int res = ExecutionBlock::shutdown(errorCode);
 
   if (res != TRI_ERROR_NO_ERROR) {
@@ -141,7 +202,7 @@ std::vector<AqlItemBlock*>* SubqueryBlock::executeSubquery() {
   try {
     do {
       std::unique_ptr<AqlItemBlock> tmp(
-          _subquery->getSome(DefaultBatchSize(), DefaultBatchSize()));
+          _subquery->getSome(batchSize(), batchSize()));
 
       if (tmp.get() == nullptr) {
         break;
@@ -162,6 +223,36 @@ std::vector<AqlItemBlock*>* SubqueryBlock::executeSubquery() {
   DEBUG_END_BLOCK();
 }
 
+/// @brief start the subquery ahead of its execution
+void SubqueryBlock::startSubquery() {
+  TRI_ASSERT(_subqueryIsIndependent);
+  TRI_ASSERT(!_subqueryStarted);
+
+  // the subquery does not use any variables from outside, so it does
+  // not need an input row
+  int res = _subquery->initializeCursor(nullptr, 0);
+
+  if (res != TRI_ERROR_NO_ERROR) {
+    THROW_ARANGO_EXCEPTION(res);
+  }
+
+  _subqueryStarted = true;
+  ++_engine->_startedSubqueries;
+
+  prefetchRemotes(_subquery);
+}
+
+/// @brief send a getSome request to all remote blocks below block
+void SubqueryBlock::prefetchRemotes(ExecutionBlock* block) {
+  for (auto& it : block->getDependencies()) {
+    if (it->getPlanNode()->getType() == ExecutionNode::REMOTE) {
+      static_cast<RemoteBlock*>(it)->prefetchSome(batchSize(), batchSize());
+    } else {
+      prefetchRemotes(it);
+    }
+  }
+}
+
 /// @brief destroy the results of a subquery
 void SubqueryBlock::destroySubqueryResults(
     std::vector<AqlItemBlock*>* results) {
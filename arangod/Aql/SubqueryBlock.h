@@ -37,11 +37,14 @@ class ExecutionEngine;
 class SubqueryBlock : public ExecutionBlock {
  public:
   SubqueryBlock(ExecutionEngine*, SubqueryNode const*, ExecutionBlock*);
-  ~SubqueryBlock() = default;
+  ~SubqueryBlock();
 
   /// @brief initialize, tell dependency and the subquery
   int initialize() override final;
 
+  /// @brief initializeCursor, could be called multiple times
+  int initializeCursor(AqlItemBlock* items, size_t pos) override final;
+
   /// @brief getSome
   AqlItemBlock* getSome(size_t atLeast, size_t atMost) override final;
 
@@ -58,6 +61,14 @@ class SubqueryBlock : public ExecutionBlock {
   /// @brief destroy the results of a subquery
   void destroySubqueryResults(std::vector<AqlItemBlock*>*);
 
+  /// @brief start the subquery ahead of its execution: initialize it and
+  /// send the first getSome requests of all its remote parts
+  void startSubquery();
+
+  /// @brief send a getSome request to all remote blocks of the subquery
+  /// below block, without waiting for the responses
+  void prefetchRemotes(ExecutionBlock* block);
+
   /// @brief output register
   RegisterId _outReg;
 
@@ -67,6 +78,17 @@ class SubqueryBlock : public ExecutionBlock {
   /// @brief whether the subquery is const and will always return the same values
   /// when invoked multiple times
   bool _subqueryIsConst;
+
+  /// @brief the result of a const subquery, computed once and copied into
+  /// all following blocks
+  AqlValue _constResult;
+
+  /// @brief whether the subquery does not use any variables from outside,
+  /// so that it can be started without an input row
+  bool _subqueryIsIndependent;
+
+  /// @brief whether the subquery was started ahead of its execution
+  bool _subqueryStarted;
 };
 
 }  // namespace arangodb::aql
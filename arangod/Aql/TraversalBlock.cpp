@@ -85,12 +85,16 @@ TraversalBlock::TraversalBlock(ExecutionEngine* engine, TraversalNode const* ep)
           _trx));
     } else {
 #endif
-      _traverser.reset(new arangodb::traverser::ClusterTraverser(
+      auto traverser = std::make_unique<arangodb::traverser::ClusterTraverser>(
           _opts,
           _mmdr.get(),
           ep->engines(),
           _trx->vocbase()->name(),
-          _trx));
+          _trx);
+      // a path contains the vertices, too
+      traverser->fetchVerticesWithEdges(ep->usesVertexOutVariable() ||
+                                        ep->usesPathOutVariable());
+      _traverser.reset(traverser.release());
 #ifdef USE_ENTERPRISE
     }
 #endif
@@ -358,7 +362,7 @@ AqlItemBlock* TraversalBlock::getSome(size_t,  // atLeast,
   }
 
   if (_buffer.empty()) {
-    size_t toFetch = (std::min)(DefaultBatchSize(), atMost);
+    size_t toFetch = (std::min)(batchSize(), atMost);
     if (!ExecutionBlock::getBlock(toFetch, toFetch)) {
       _done = true;
       traceGetSomeEnd(nullptr);
@@ -454,17 +458,18 @@ AqlItemBlock* TraversalBlock::getSome(size_t,  // atLeast,
 /// @brief skipSome
 size_t TraversalBlock::skipSome(size_t atLeast, size_t atMost) {
   DEBUG_BEGIN_BLOCK();
+  traceSkipSomeBegin();
   size_t skipped = 0;
 
   if (_done) {
-    return skipped;
+    return traceSkipSomeEnd(skipped);
   }
 
   if (_buffer.empty()) {
-    size_t toFetch = (std::min)(DefaultBatchSize(), atMost);
+    size_t toFetch = (std::min)(batchSize(), atMost);
     if (!ExecutionBlock::getBlock(toFetch, toFetch)) {
       _done = true;
-      return skipped;
+      return traceSkipSomeEnd(skipped);
     }
     _pos = 0;  // this is in the first block
   }
@@ -480,18 +485,18 @@ size_t TraversalBlock::skipSome(size_t atLeast, size_t atMost) {
   size_t available = _vertices.size() - _posInPaths;
   // We have not yet fetched any paths. We can skip the next atMost many
   if (available == 0) {
-    return skipPaths(atMost);
+    return traceSkipSomeEnd(skipPaths(atMost));
   }
   // We have fewer paths available in our list, so we clear the list and thereby
   // skip these.
   if (available <= atMost) {
     freeCaches();
     _posInPaths = 0;
-    return available;
+    return traceSkipSomeEnd(available);
   }
   _posInPaths += atMost;
   // Skip the next atMost many paths.
-  return atMost;
+  return traceSkipSomeEnd(atMost);
 
   // cppcheck-suppress style
   DEBUG_END_BLOCK();
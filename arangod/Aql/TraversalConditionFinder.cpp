@@ -494,6 +494,9 @@ bool TraversalConditionFinder::before(ExecutionNode* en) {
     case EN::ENUMERATE_COLLECTION:
     case EN::LIMIT:
     case EN::SHORTEST_PATH:
+    case EN::HASH_JOIN:
+    case EN::MATERIALIZE:
+    case EN::HASH_LOOKUP:
       // in these cases we simply ignore the intermediate nodes, note
       // that we have taken care of nodes that could throw exceptions
       // above.
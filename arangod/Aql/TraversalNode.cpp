@@ -82,6 +82,54 @@ void TraversalNode::TraversalEdgeConditionBuilder::toVelocyPack(
   _modCondition->toVelocyPack(builder, verbose);
 }
 
+/// @brief whether or not the index selected for an edge lookup enforces the
+/// complete lookup condition, so that the edges it returns need not be
+/// checked again. this is the case for equality lookups in a non-sparse
+/// index without array expansion, e.g. the edge index for _from == x, or a
+/// vertex-centric index on [_from, type] for _from == x && type == y.
+/// numMembers is the number of parts of the condition before the index
+/// removed the parts it cannot use
+static bool IndexCoversCondition(
+    arangodb::transaction::Methods::IndexHandle const& handle,
+    AstNode const* condition, size_t numMembers) {
+  auto index = handle.getIndex();
+
+  if (index == nullptr || index->sparse()) {
+    return false;
+  }
+
+  switch (index->type()) {
+    case arangodb::Index::TRI_IDX_TYPE_EDGE_INDEX:
+    case arangodb::Index::TRI_IDX_TYPE_HASH_INDEX:
+    case arangodb::Index::TRI_IDX_TYPE_SKIPLIST_INDEX:
+      break;
+    default:
+      return false;
+  }
+
+  for (auto const& field : index->fields()) {
+    for (auto const& part : field) {
+      if (part.shouldExpand) {
+        return false;
+      }
+    }
+  }
+
+  if (condition->numMembers() != numMembers) {
+    // the index cannot use all parts of the condition
+    return false;
+  }
+
+  for (size_t i = 0; i < numMembers; ++i) {
+    if (condition->getMemberUnchecked(i)->type !=
+        NODE_TYPE_OPERATOR_BINARY_EQ) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
 static TRI_edge_direction_e parseDirection (AstNode const* node) {
   TRI_ASSERT(node->isIntValue());
   auto dirNum = node->getIntValue();
@@ -947,6 +995,15 @@ void TraversalNode::prepareOptions() {
   Ast* ast = _plan->getAst();
   auto trx = ast->query()->trx();
 
+  // the index selection estimates the number of edges per lookup from the
+  // size of the edge collection
+  std::vector<size_t> edgeCollectionCounts;
+  edgeCollectionCounts.reserve(numEdgeColls);
+  for (size_t i = 0; i < numEdgeColls; ++i) {
+    edgeCollectionCounts.emplace_back(
+        (std::max)(static_cast<size_t>(1000), _edgeColls[i]->count()));
+  }
+
   _options->_baseLookupInfos.reserve(numEdgeColls);
   // Compute Edge Indexes. First default indexes:
   for (size_t i = 0; i < numEdgeColls; ++i) {
@@ -970,15 +1027,25 @@ void TraversalNode::prepareOptions() {
         TRI_ASSERT(false);
         break;
     }
+    size_t numMembers = info.indexCondition->numMembers();
     info.expression = new Expression(ast, info.indexCondition->clone(ast));
+    // any index on _from or _to can serve the lookup. a vertex-centric index
+    // that also covers attributes of the edge conditions only returns the
+    // matching edges of a vertex
     res = trx->getBestIndexHandleForFilterCondition(
-        _edgeColls[i]->getName(), info.indexCondition, _tmpObjVariable, 1000,
-        info.idxHandles[0]);
+        _edgeColls[i]->getName(), info.indexCondition, _tmpObjVariable,
+        edgeCollectionCounts[i], info.idxHandles[0]);
     TRI_ASSERT(res);  // Right now we have an enforced edge index which will
                       // always fit.
     if (!res) {
       THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL, "expected edge index not found");
     }
+    if (IndexCoversCondition(info.idxHandles[0], info.indexCondition,
+                             numMembers)) {
+      // the edges need not be checked again
+      delete info.expression;
+      info.expression = nullptr;
+    }
 
     // We now have to check if we need _from / _to inside the index lookup and which position
     // it is used in. Such that the traverser can update the respective string value
@@ -1043,15 +1110,22 @@ void TraversalNode::prepareOptions() {
           break;
       }
 
+      size_t numMembers = info.indexCondition->numMembers();
       info.expression = new Expression(ast, info.indexCondition->clone(ast));
       res = trx->getBestIndexHandleForFilterCondition(
-          _edgeColls[i]->getName(), info.indexCondition, _tmpObjVariable, 1000,
-          info.idxHandles[0]);
+          _edgeColls[i]->getName(), info.indexCondition, _tmpObjVariable,
+          edgeCollectionCounts[i], info.idxHandles[0]);
       TRI_ASSERT(res);  // Right now we have an enforced edge index which will
                         // always fit.
       if (!res) {
         THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL, "expected edge index not found");
       }
+      if (IndexCoversCondition(info.idxHandles[0], info.indexCondition,
+                               numMembers)) {
+        // the edges need not be checked again
+        delete info.expression;
+        info.expression = nullptr;
+      }
 
       // We now have to check if we need _from / _to inside the index lookup and which position
       // it is used in. Such that the traverser can update the respective string value
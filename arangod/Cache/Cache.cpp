@@ -45,11 +45,13 @@ const uint64_t Cache::minSize = 16384;
 const uint64_t Cache::minLogSize = 14;
 
 uint64_t Cache::_findStatsCapacity = 16384;
+uint32_t Cache::_admissionSketchWidth = 8192;
 
 Cache::ConstructionGuard::ConstructionGuard() {}
 
 Cache::Cache(ConstructionGuard guard, Manager* manager, Metadata metadata,
              std::shared_ptr<Table> table, bool enableWindowedStats,
+             bool enableAdmission,
              std::function<Table::BucketClearer(Metadata*)> bucketClearer,
              size_t slotsPerBucket)
     : _state(),
@@ -57,6 +59,8 @@ Cache::Cache(ConstructionGuard guard, Manager* manager, Metadata metadata,
       _findStats(nullptr),
       _findHits(0),
       _findMisses(0),
+      _enableAdmission(enableAdmission),
+      _admissionSketch(nullptr),
       _manager(manager),
       _metadata(metadata),
       _table(table),
@@ -75,6 +79,14 @@ Cache::Cache(ConstructionGuard guard, Manager* manager, Metadata metadata,
       _enableWindowedStats = false;
     }
   }
+  if (_enableAdmission) {
+    try {
+      _admissionSketch.reset(new FrequencySketch(_admissionSketchWidth));
+    } catch (std::bad_alloc) {
+      _admissionSketch.reset(nullptr);
+      _enableAdmission = false;
+    }
+  }
 }
 
 uint64_t Cache::size() {
@@ -265,6 +277,24 @@ void Cache::recordStat(Stat stat) {
   }
 }
 
+void Cache::recordAccess(uint32_t hash) {
+  if (_enableAdmission && _admissionSketch.get() != nullptr) {
+    _admissionSketch->insertRecord(hash);
+  }
+}
+
+bool Cache::admit(uint32_t hash, CachedValue const* candidate) const {
+  if (!_enableAdmission || _admissionSketch.get() == nullptr ||
+      candidate == nullptr) {
+    return true;
+  }
+
+  // only displace the victim if the new key was accessed more often recently
+  uint32_t candidateHash = hashKey(candidate->key(), candidate->keySize);
+  return (_admissionSketch->estimate(hash) >
+          _admissionSketch->estimate(candidateHash));
+}
+
 Metadata* Cache::metadata() { return &_metadata; }
 
 std::shared_ptr<Table> Cache::table() { return _table; }
@@ -29,6 +29,7 @@
 #include "Cache/Common.h"
 #include "Cache/Finding.h"
 #include "Cache/FrequencyBuffer.h"
+#include "Cache/FrequencySketch.h"
 #include "Cache/Manager.h"
 #include "Cache/ManagerTasks.h"
 #include "Cache/Metadata.h"
@@ -72,6 +73,7 @@ class Cache : public std::enable_shared_from_this<Cache> {
  public:
   Cache(ConstructionGuard guard, Manager* manager, Metadata metadata,
         std::shared_ptr<Table> table, bool enableWindowedStats,
+        bool enableAdmission,
         std::function<Table::BucketClearer(Metadata*)> bucketClearer,
         size_t slotsPerBucket);
   virtual ~Cache() = default;
@@ -126,6 +128,10 @@ class Cache : public std::enable_shared_from_this<Cache> {
   std::atomic<uint64_t> _findHits;
   std::atomic<uint64_t> _findMisses;
 
+  static uint32_t _admissionSketchWidth;
+  bool _enableAdmission;
+  std::unique_ptr<FrequencySketch> _admissionSketch;
+
   // allow communication with manager
   Manager* _manager;
   Metadata _metadata;
@@ -165,6 +171,10 @@ class Cache : public std::enable_shared_from_this<Cache> {
   uint32_t hashKey(void const* key, uint32_t keySize) const;
   void recordStat(Stat stat);
 
+  // admission filter, only active if enabled at construction
+  void recordAccess(uint32_t hash);
+  bool admit(uint32_t hash, CachedValue const* candidate) const;
+
   // management
   Metadata* metadata();
   std::shared_ptr<Table> table();
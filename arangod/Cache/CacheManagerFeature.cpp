@@ -40,6 +40,7 @@
 //#include "RestServer/ServerFeature.h"
 #include "Scheduler/Scheduler.h"
 #include "Scheduler/SchedulerFeature.h"
+#include "Statistics/MetricsRegistry.h"
 
 using namespace arangodb;
 using namespace arangodb::application_features;
@@ -103,10 +104,32 @@ void CacheManagerFeature::start() {
   _rebalancer.reset(
       new CacheRebalancerThread(_manager.get(), _rebalancingInterval));
   _rebalancer->start();
+
+  Manager* manager = _manager.get();
+
+  MetricsRegistry::addGauge(
+      "arangodb_cache_limit_bytes", "Global memory limit of the caches",
+      [manager]() { return static_cast<double>(manager->globalLimit()); });
+  MetricsRegistry::addGauge(
+      "arangodb_cache_allocated_bytes", "Memory allocated by the caches",
+      [manager]() { return static_cast<double>(manager->globalAllocation()); });
+  MetricsRegistry::addGauge(
+      "arangodb_cache_hit_rate{window=\"lifetime\"}",
+      "Percentage of cache lookups that were hits",
+      [manager]() { return manager->globalHitRates().first; });
+  MetricsRegistry::addGauge(
+      "arangodb_cache_hit_rate{window=\"recent\"}",
+      "Percentage of cache lookups that were hits",
+      [manager]() { return manager->globalHitRates().second; });
+
   LOG_TOPIC(DEBUG, Logger::STARTUP) << "cache manager has started";
 }
 
 void CacheManagerFeature::beginShutdown() {
+  MetricsRegistry::remove("arangodb_cache_limit_bytes");
+  MetricsRegistry::remove("arangodb_cache_allocated_bytes");
+  MetricsRegistry::remove("arangodb_cache_hit_rate");
+
   if (_manager != nullptr) {
     _manager->beginShutdown();
     _rebalancer->beginShutdown();
@@ -0,0 +1,118 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2017 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Cache/FrequencySketch.h"
+#include "Basics/Common.h"
+
+#include <stdint.h>
+#include <atomic>
+
+using namespace arangodb::cache;
+
+constexpr uint32_t FrequencySketch::depth;
+constexpr uint8_t FrequencySketch::maxCount;
+
+static uint32_t roundWidth(uint32_t width) {
+  uint32_t result = 64;
+  while (result < width && result < (static_cast<uint32_t>(1) << 24)) {
+    result <<= 1;
+  }
+  return result;
+}
+
+FrequencySketch::FrequencySketch(uint32_t width)
+    : _width(roundWidth(width)),
+      _mask(_width - 1),
+      _sampleSize(10 * static_cast<uint64_t>(_width)),
+      _additions(0),
+      _aging(false),
+      _counters(new std::atomic<uint8_t>[depth * _width]) {
+  clear();
+}
+
+uint64_t FrequencySketch::allocationSize(uint32_t width) {
+  return sizeof(FrequencySketch) +
+         (depth * static_cast<uint64_t>(roundWidth(width)) *
+          sizeof(std::atomic<uint8_t>));
+}
+
+uint64_t FrequencySketch::memoryUsage() const {
+  return allocationSize(_width);
+}
+
+void FrequencySketch::insertRecord(uint32_t hash) {
+  for (uint32_t row = 0; row < depth; row++) {
+    std::atomic<uint8_t>& counter = _counters[index(row, hash)];
+    uint8_t current = counter.load(std::memory_order_relaxed);
+    while (current < maxCount &&
+           !counter.compare_exchange_weak(current, current + 1,
+                                          std::memory_order_relaxed)) {
+    }
+  }
+
+  if (_additions.fetch_add(1, std::memory_order_relaxed) + 1 >= _sampleSize) {
+    age();
+  }
+}
+
+uint8_t FrequencySketch::estimate(uint32_t hash) const {
+  uint8_t result = maxCount;
+  for (uint32_t row = 0; row < depth; row++) {
+    result = std::min(result, _counters[index(row, hash)].load(
+                                  std::memory_order_relaxed));
+  }
+  return result;
+}
+
+void FrequencySketch::clear() {
+  for (uint64_t i = 0; i < depth * static_cast<uint64_t>(_width); i++) {
+    _counters[i].store(0, std::memory_order_relaxed);
+  }
+  _additions.store(0, std::memory_order_relaxed);
+}
+
+size_t FrequencySketch::index(uint32_t row, uint32_t hash) const {
+  // the table hash already selects the bucket, so it is mixed again with a
+  // different seed per row (finalizer of MurmurHash3)
+  uint64_t h = static_cast<uint64_t>(hash) |
+               (static_cast<uint64_t>(row + 1) << 32);
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdULL;
+  h ^= h >> 33;
+  h *= 0xc4ceb9fe1a85ec53ULL;
+  h ^= h >> 33;
+  return static_cast<size_t>(row) * _width + static_cast<size_t>(h & _mask);
+}
+
+void FrequencySketch::age() {
+  if (_aging.exchange(true)) {
+    // another thread is already halving the counters
+    return;
+  }
+
+  for (uint64_t i = 0; i < depth * static_cast<uint64_t>(_width); i++) {
+    _counters[i].store(_counters[i].load(std::memory_order_relaxed) >> 1,
+                       std::memory_order_relaxed);
+  }
+  _additions.store(_sampleSize / 2, std::memory_order_relaxed);
+  _aging.store(false);
+}
@@ -0,0 +1,101 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2017 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGODB_CACHE_FREQUENCY_SKETCH_H
+#define ARANGODB_CACHE_FREQUENCY_SKETCH_H
+
+#include "Basics/Common.h"
+
+#include <stdint.h>
+#include <atomic>
+#include <memory>
+
+namespace arangodb {
+namespace cache {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Lockless structure to estimate how often a key was accessed
+/// recently, used as the admission filter of a cache (TinyLFU).
+///
+/// A count-min sketch: each access increments one counter per row, chosen
+/// by a different hash per row, and the estimate for a key is the smallest
+/// of its counters. Counters saturate at 15. Like FrequencyBuffer, only a
+/// recent window is considered: after 10 increments per counter of a row,
+/// all counters are halved, so old popularity fades out. Updates are
+/// approximate by design, as concurrent increments or halving may be lost.
+////////////////////////////////////////////////////////////////////////////////
+class FrequencySketch {
+ public:
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Initialize with the given number of counters per row.
+  //////////////////////////////////////////////////////////////////////////////
+  explicit FrequencySketch(uint32_t width);
+
+  FrequencySketch(FrequencySketch const&) = delete;
+  FrequencySketch& operator=(FrequencySketch const&) = delete;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Reports the memory usage in bytes for the given width.
+  //////////////////////////////////////////////////////////////////////////////
+  static uint64_t allocationSize(uint32_t width);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Reports the memory usage in bytes.
+  //////////////////////////////////////////////////////////////////////////////
+  uint64_t memoryUsage() const;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Record an access to the key with the given hash.
+  //////////////////////////////////////////////////////////////////////////////
+  void insertRecord(uint32_t hash);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Estimate the number of recent accesses to the key with the given
+  /// hash.
+  //////////////////////////////////////////////////////////////////////////////
+  uint8_t estimate(uint32_t hash) const;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Clear all counters.
+  //////////////////////////////////////////////////////////////////////////////
+  void clear();
+
+ private:
+  static constexpr uint32_t depth = 4;
+  static constexpr uint8_t maxCount = 15;
+
+  size_t index(uint32_t row, uint32_t hash) const;
+  void age();
+
+ private:
+  uint32_t _width;
+  uint32_t _mask;
+  uint64_t _sampleSize;
+  std::atomic<uint64_t> _additions;
+  std::atomic<bool> _aging;
+  std::unique_ptr<std::atomic<uint8_t>[]> _counters;
+};
+
+};  // end namespace cache
+};  // end namespace arangodb
+
+#endif
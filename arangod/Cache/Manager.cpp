@@ -23,6 +23,7 @@
 
 #include "Cache/Manager.h"
 #include "Basics/Common.h"
+#include "Basics/NumaTopology.h"
 #include "Basics/asio-helper.h"
 #include "Cache/Cache.h"
 #include "Cache/CachedValue.h"
@@ -48,12 +49,13 @@
 #include <iostream>  // TODO
 
 using namespace arangodb::cache;
+using arangodb::basics::NumaTopology;
 
 const uint64_t Manager::minSize = 1024 * 1024;
 const uint64_t Manager::minCacheAllocation =
     Cache::minSize + Table::allocationSize(Table::minLogSize) +
-    std::max(PlainCache::allocationSize(true),
-             TransactionalCache::allocationSize(true)) +
+    std::max(PlainCache::allocationSize(true, true),
+             TransactionalCache::allocationSize(true, true)) +
     Manager::cacheRecordOverhead;
 const std::chrono::milliseconds Manager::rebalancingGracePeriod(10);
 
@@ -80,6 +82,7 @@ Manager::Manager(boost::asio::io_service* ioService, uint64_t globalLimit,
       _findHits(0),
       _findMisses(0),
       _caches(),
+      _tables(NumaTopology::enabled() ? NumaTopology::numberOfNodes() : 1),
       _globalSoftLimit(globalLimit),
       _globalHardLimit(globalLimit),
       _globalHighwaterMark(
@@ -115,7 +118,8 @@ Manager::~Manager() { shutdown(); }
 
 std::shared_ptr<Cache> Manager::createCache(CacheType type,
                                             bool enableWindowedStats,
-                                            uint64_t maxSize) {
+                                            uint64_t maxSize,
+                                            bool enableAdmission) {
   std::shared_ptr<Cache> result(nullptr);
   _state.lock();
   bool allowed = isOperational();
@@ -126,10 +130,12 @@ std::shared_ptr<Cache> Manager::createCache(CacheType type,
     uint64_t fixedSize = 0;
     switch (type) {
       case CacheType::Plain:
-        fixedSize = PlainCache::allocationSize(enableWindowedStats);
+        fixedSize =
+            PlainCache::allocationSize(enableWindowedStats, enableAdmission);
         break;
       case CacheType::Transactional:
-        fixedSize = TransactionalCache::allocationSize(enableWindowedStats);
+        fixedSize = TransactionalCache::allocationSize(enableWindowedStats,
+                                                       enableAdmission);
         break;
       default:
         break;
@@ -140,11 +146,13 @@ std::shared_ptr<Cache> Manager::createCache(CacheType type,
   if (allowed) {
     switch (type) {
       case CacheType::Plain:
-        result = PlainCache::create(this, metadata, table, enableWindowedStats);
+        result = PlainCache::create(this, metadata, table, enableWindowedStats,
+                                    enableAdmission);
         break;
       case CacheType::Transactional:
         result = TransactionalCache::create(this, metadata, table,
-                                            enableWindowedStats);
+                                            enableWindowedStats,
+                                            enableAdmission);
         break;
       default:
         break;
@@ -574,11 +582,13 @@ void Manager::shrinkOvergrownCaches(Manager::TaskEnvironment environment) {
 
 void Manager::freeUnusedTables() {
   TRI_ASSERT(_state.isLocked());
-  for (size_t i = 0; i < 32; i++) {
-    while (!_tables[i].empty()) {
-      auto table = _tables[i].top();
-      _globalAllocation -= table->memoryUsage();
-      _tables[i].pop();
+  for (auto& tables : _tables) {
+    for (size_t i = 0; i < 32; i++) {
+      while (!tables[i].empty()) {
+        auto table = tables[i].top();
+        _globalAllocation -= table->memoryUsage();
+        tables[i].pop();
+      }
     }
   }
 }
@@ -665,20 +675,33 @@ void Manager::migrateCache(Manager::TaskEnvironment environment,
 std::shared_ptr<Table> Manager::leaseTable(uint32_t logSize) {
   TRI_ASSERT(_state.isLocked());
 
+  // tables are leased by the thread that will fill them, so a spare table
+  // of its own node is preferred. a new table is placed on its node, too
+  size_t const node = (_tables.size() > 1) ? NumaTopology::currentNode() : 0;
+  TRI_ASSERT(node < _tables.size());
+
   std::shared_ptr<Table> table(nullptr);
-  if (_tables[logSize].empty()) {
-    if (increaseAllowed(Table::allocationSize(logSize), true)) {
-      try {
-        table = std::make_shared<Table>(logSize);
-        _globalAllocation += table->memoryUsage();
-      } catch (std::bad_alloc) {
-        table.reset();
-      }
+  if (!_tables[node][logSize].empty()) {
+    table = _tables[node][logSize].top();
+    _spareTableAllocation -= table->memoryUsage();
+    _tables[node][logSize].pop();
+  } else if (increaseAllowed(Table::allocationSize(logSize), true)) {
+    try {
+      table = std::make_shared<Table>(logSize);
+      _globalAllocation += table->memoryUsage();
+    } catch (std::bad_alloc) {
+      table.reset();
     }
   } else {
-    table = _tables[logSize].top();
-    _spareTableAllocation -= table->memoryUsage();
-    _tables[logSize].pop();
+    // remote memory is still better than none
+    for (auto& tables : _tables) {
+      if (!tables[logSize].empty()) {
+        table = tables[logSize].top();
+        _spareTableAllocation -= table->memoryUsage();
+        tables[logSize].pop();
+        break;
+      }
+    }
   }
 
   return table;
@@ -691,11 +714,13 @@ void Manager::reclaimTable(std::shared_ptr<Table> table, bool internal) {
   }
 
   uint32_t logSize = table->logSize();
+  size_t const node =
+      (table->numaNode() < _tables.size()) ? table->numaNode() : 0;
   size_t maxTables = (logSize < 18) ? (1 << (18 - logSize)) : 1;
-  if ((_tables[logSize].size() < maxTables) &&
+  if ((_tables[node][logSize].size() < maxTables) &&
       ((table->memoryUsage() + _spareTableAllocation) <
        ((_globalSoftLimit - _globalHighwaterMark) / 2))) {
-    _tables[logSize].emplace(table);
+    _tables[node][logSize].emplace(table);
     _spareTableAllocation += table->memoryUsage();
   } else {
     _globalAllocation -= table->memoryUsage();
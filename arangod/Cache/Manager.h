@@ -36,12 +36,14 @@
 #include "Cache/TransactionManager.h"
 
 #include <stdint.h>
+#include <array>
 #include <atomic>
 #include <chrono>
 #include <memory>
 #include <set>
 #include <stack>
 #include <utility>
+#include <vector>
 
 namespace arangodb {
 namespace cache {
@@ -106,11 +108,15 @@ class Manager {
   /// recent window in time, rather than over the full lifetime of the cache.
   /// The third parameter controls the maximum size of the cache over its
   /// lifetime. It should likely only be set to a non-default value for
-  /// infrequently accessed or short-lived caches.
+  /// infrequently accessed or short-lived caches. If the fourth parameter is
+  /// true, a frequency-based admission filter is consulted before evicting a
+  /// value from a full bucket, so that a new value only replaces one that was
+  /// accessed less often recently. This protects the hot set from large scans.
   //////////////////////////////////////////////////////////////////////////////
   std::shared_ptr<Cache> createCache(CacheType type,
                                      bool enableWindowedStats = false,
-                                     uint64_t maxSize = UINT64_MAX);
+                                     uint64_t maxSize = UINT64_MAX,
+                                     bool enableAdmission = false);
 
   //////////////////////////////////////////////////////////////////////////////
   /// @brief Destroy the given cache.
@@ -190,8 +196,9 @@ class Manager {
   // set of pointers to keep track of registered caches
   std::set<std::shared_ptr<Cache>> _caches;
 
-  // actual tables to lease out
-  std::stack<std::shared_ptr<Table>> _tables[32];
+  // actual tables to lease out, by NUMA node and logSize. there is a single
+  // node unless NUMA awareness is on
+  std::vector<std::array<std::stack<std::shared_ptr<Table>>, 32>> _tables;
 
   // global statistics
   uint64_t _globalSoftLimit;
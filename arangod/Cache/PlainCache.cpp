@@ -52,6 +52,7 @@ Finding PlainCache::find(void const* key, uint32_t keySize) {
 
   if (ok) {
     result.reset(bucket->find(hash, key, keySize));
+    recordAccess(hash);
     recordStat(result.found() ? Stat::findHit : Stat::findMiss);
     bucket->unlock();
     endOperation();
@@ -78,7 +79,7 @@ bool PlainCache::insert(CachedValue* value) {
 
     if (candidate == nullptr && bucket->isFull()) {
       candidate = bucket->evictionCandidate();
-      if (candidate == nullptr) {
+      if (candidate == nullptr || !admit(hash, candidate)) {
         allowed = false;
       }
     }
@@ -158,25 +159,32 @@ bool PlainCache::remove(void const* key, uint32_t keySize) {
 
 bool PlainCache::blacklist(void const* key, uint32_t keySize) { return false; }
 
-uint64_t PlainCache::allocationSize(bool enableWindowedStats) {
+uint64_t PlainCache::allocationSize(bool enableWindowedStats,
+                                    bool enableAdmission) {
   return sizeof(PlainCache) +
          (enableWindowedStats ? (sizeof(StatBuffer) +
                                  StatBuffer::allocationSize(_findStatsCapacity))
-                              : 0);
+                              : 0) +
+         (enableAdmission
+              ? FrequencySketch::allocationSize(_admissionSketchWidth)
+              : 0);
 }
 
 std::shared_ptr<Cache> PlainCache::create(Manager* manager, Metadata metadata,
                                           std::shared_ptr<Table> table,
-                                          bool enableWindowedStats) {
+                                          bool enableWindowedStats,
+                                          bool enableAdmission) {
   return std::make_shared<PlainCache>(Cache::ConstructionGuard(), manager,
-                                      metadata, table, enableWindowedStats);
+                                      metadata, table, enableWindowedStats,
+                                      enableAdmission);
 }
 
 PlainCache::PlainCache(Cache::ConstructionGuard guard, Manager* manager,
                        Metadata metadata, std::shared_ptr<Table> table,
-                       bool enableWindowedStats)
+                       bool enableWindowedStats, bool enableAdmission)
     : Cache(guard, manager, metadata, table, enableWindowedStats,
-            PlainCache::bucketClearer, PlainBucket::slotsData) {}
+            enableAdmission, PlainCache::bucketClearer,
+            PlainBucket::slotsData) {}
 
 PlainCache::~PlainCache() {
   _state.lock();
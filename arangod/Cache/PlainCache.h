@@ -56,7 +56,7 @@ class PlainCache final : public Cache {
  public:
   PlainCache(Cache::ConstructionGuard guard, Manager* manager,
              Metadata metadata, std::shared_ptr<Table> table,
-             bool enableWindowedStats);
+             bool enableWindowedStats, bool enableAdmission);
   ~PlainCache();
 
   PlainCache() = delete;
@@ -104,10 +104,12 @@ class PlainCache final : public Cache {
   friend class MigrateTask;
 
  private:
-  static uint64_t allocationSize(bool enableWindowedStats);
+  static uint64_t allocationSize(bool enableWindowedStats,
+                                 bool enableAdmission);
   static std::shared_ptr<Cache> create(Manager* manager, Metadata metadata,
                                        std::shared_ptr<Table> table,
-                                       bool enableWindowedStats);
+                                       bool enableWindowedStats,
+                                       bool enableAdmission);
 
   virtual uint64_t freeMemoryFrom(uint32_t hash);
   virtual void migrateBucket(void* sourcePtr,
@@ -23,6 +23,8 @@
 
 #include "Cache/Table.h"
 #include "Basics/Common.h"
+#include "Basics/LargePages.h"
+#include "Basics/NumaTopology.h"
 #include "Cache/Common.h"
 #include "Cache/State.h"
 
@@ -31,10 +33,29 @@
 #include <stdexcept>
 
 using namespace arangodb::cache;
+using arangodb::basics::LargePages;
+using arangodb::basics::NumaTopology;
 
 const uint32_t Table::minLogSize = 8;
 const uint32_t Table::maxLogSize = 32;
 
+void Table::BucketDeleter::operator()(GenericBucket* buckets) const {
+  if (!LargePages::free(buckets)) {
+    delete[] buckets;
+  }
+}
+
+Table::GenericBucket* Table::allocateBuckets(uint64_t size) {
+  // buckets are probed randomly, so large tables save many TLB misses on
+  // huge pages
+  void* memory = LargePages::allocate(BUCKET_SIZE * size);
+
+  if (memory != nullptr) {
+    return static_cast<GenericBucket*>(memory);
+  }
+  return new GenericBucket[size];
+}
+
 bool Table::GenericBucket::lock(int64_t maxTries) {
   return _state.lock(maxTries);
 }
@@ -79,13 +100,17 @@ Table::Table(uint32_t logSize)
       _size(static_cast<uint64_t>(1) << _logSize),
       _shift(32 - _logSize),
       _mask((_size - 1) << _shift),
-      _buckets(new GenericBucket[_size]),
+      _buckets(allocateBuckets(_size)),
+      _numaNode(NumaTopology::enabled() ? NumaTopology::currentNode() : 0),
       _auxiliary(nullptr),
       _bucketClearer(defaultClearer),
       _slotsTotal(_size),
       _slotsUsed(0) {
   _state.lock();
   _state.toggleFlag(State::Flag::disabled);
+  // the buckets are touched for the first time right here, so the policy
+  // applies to all pages that were freshly mapped for the table
+  NumaTopology::preferNode(_buckets.get(), BUCKET_SIZE * _size, _numaNode);
   memset(_buckets.get(), 0, BUCKET_SIZE * _size);
   _state.unlock();
 }
@@ -100,6 +125,8 @@ uint64_t Table::size() const { return _size; }
 
 uint32_t Table::logSize() const { return _logSize; }
 
+size_t Table::numaNode() const { return _numaNode; }
+
 std::pair<void*, std::shared_ptr<Table>> Table::fetchAndLockBucket(
     uint32_t hash, int64_t maxTries) {
   GenericBucket* bucket = nullptr;
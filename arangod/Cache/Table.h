@@ -57,6 +57,11 @@ class Table : public std::enable_shared_from_this<Table> {
   static_assert(sizeof(GenericBucket) == BUCKET_SIZE,
                 "Expected sizeof(GenericBucket) == BUCKET_SIZE.");
 
+  // large tables are on huge pages (see LargePages), others on the heap
+  struct BucketDeleter {
+    void operator()(GenericBucket* buckets) const;
+  };
+
  public:
   //////////////////////////////////////////////////////////////////////////////
   /// @brief Helper class for migration.
@@ -104,6 +109,11 @@ class Table : public std::enable_shared_from_this<Table> {
   //////////////////////////////////////////////////////////////////////////////
   uint32_t logSize() const;
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Returns the NUMA node the buckets of the table were placed on.
+  //////////////////////////////////////////////////////////////////////////////
+  size_t numaNode() const;
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief Fetches a pointer to the bucket mapped by the given hash, and locks
   /// it.
@@ -187,7 +197,8 @@ class Table : public std::enable_shared_from_this<Table> {
   uint64_t _size;
   uint32_t _shift;
   uint32_t _mask;
-  std::unique_ptr<GenericBucket[]> _buckets;
+  std::unique_ptr<GenericBucket[], BucketDeleter> _buckets;
+  size_t _numaNode;
 
   std::shared_ptr<Table> _auxiliary;
 
@@ -200,6 +211,7 @@ class Table : public std::enable_shared_from_this<Table> {
   void disable();
   bool isEnabled(int64_t maxTries = triesGuarantee);
   static void defaultClearer(void* ptr);
+  static GenericBucket* allocateBuckets(uint64_t size);
 };
 
 };  // end namespace cache
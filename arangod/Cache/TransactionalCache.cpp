@@ -54,6 +54,7 @@ Finding TransactionalCache::find(void const* key, uint32_t keySize) {
 
   if (ok) {
     result.reset(bucket->find(hash, key, keySize));
+    recordAccess(hash);
     recordStat(result.found() ? Stat::findHit : Stat::findMiss);
     bucket->unlock();
     endOperation();
@@ -81,7 +82,7 @@ bool TransactionalCache::insert(CachedValue* value) {
 
       if (candidate == nullptr && bucket->isFull()) {
         candidate = bucket->evictionCandidate();
-        if (candidate == nullptr) {
+        if (candidate == nullptr || !admit(hash, candidate)) {
           allowed = false;
         }
       }
@@ -197,28 +198,35 @@ bool TransactionalCache::blacklist(void const* key, uint32_t keySize) {
   return blacklisted;
 }
 
-uint64_t TransactionalCache::allocationSize(bool enableWindowedStats) {
+uint64_t TransactionalCache::allocationSize(bool enableWindowedStats,
+                                            bool enableAdmission) {
   return sizeof(TransactionalCache) +
          (enableWindowedStats ? (sizeof(StatBuffer) +
                                  StatBuffer::allocationSize(_findStatsCapacity))
-                              : 0);
+                              : 0) +
+         (enableAdmission
+              ? FrequencySketch::allocationSize(_admissionSketchWidth)
+              : 0);
 }
 
 std::shared_ptr<Cache> TransactionalCache::create(Manager* manager,
                                                   Metadata metadata,
                                                   std::shared_ptr<Table> table,
-                                                  bool enableWindowedStats) {
-  return std::make_shared<TransactionalCache>(Cache::ConstructionGuard(),
-                                              manager, metadata, table,
-                                              enableWindowedStats);
+                                                  bool enableWindowedStats,
+                                                  bool enableAdmission) {
+  return std::make_shared<TransactionalCache>(
+      Cache::ConstructionGuard(), manager, metadata, table,
+      enableWindowedStats, enableAdmission);
 }
 
 TransactionalCache::TransactionalCache(Cache::ConstructionGuard guard,
                                        Manager* manager, Metadata metadata,
                                        std::shared_ptr<Table> table,
-                                       bool enableWindowedStats)
+                                       bool enableWindowedStats,
+                                       bool enableAdmission)
     : Cache(guard, manager, metadata, table, enableWindowedStats,
-            TransactionalCache::bucketClearer, TransactionalBucket::slotsData) {
+            enableAdmission, TransactionalCache::bucketClearer,
+            TransactionalBucket::slotsData) {
 }
 
 TransactionalCache::~TransactionalCache() {
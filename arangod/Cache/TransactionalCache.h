@@ -64,7 +64,7 @@ class TransactionalCache final : public Cache {
  public:
   TransactionalCache(Cache::ConstructionGuard guard, Manager* manager,
                      Metadata metadata, std::shared_ptr<Table> table,
-                     bool enableWindowedStats);
+                     bool enableWindowedStats, bool enableAdmission);
   ~TransactionalCache();
 
   TransactionalCache() = delete;
@@ -120,10 +120,12 @@ class TransactionalCache final : public Cache {
   friend class MigrateTask;
 
  private:
-  static uint64_t allocationSize(bool enableWindowedStats);
+  static uint64_t allocationSize(bool enableWindowedStats,
+                                 bool enableAdmission);
   static std::shared_ptr<Cache> create(Manager* manager, Metadata metadata,
                                        std::shared_ptr<Table> table,
-                                       bool enableWindowedStats);
+                                       bool enableWindowedStats,
+                                       bool enableAdmission);
 
   virtual uint64_t freeMemoryFrom(uint32_t hash);
   virtual void migrateBucket(void* sourcePtr,
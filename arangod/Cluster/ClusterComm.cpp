@@ -24,7 +24,9 @@
 #include "ClusterComm.h"
 #include "Basics/ConditionLocker.h"
 #include "Basics/HybridLogicalClock.h"
+#include "Basics/MutexLocker.h"
 #include "Basics/StringUtils.h"
+#include "Cluster/ClusterFeature.h"
 #include "Cluster/ClusterInfo.h"
 #include "Cluster/CollectionLockState.h"
 #include "Cluster/ServerState.h"
@@ -32,6 +34,7 @@
 #include "Logger/Logger.h"
 #include "Scheduler/JobGuard.h"
 #include "Scheduler/SchedulerFeature.h"
+#include "Statistics/MetricsRegistry.h"
 #include "SimpleHttpClient/ConnectionManager.h"
 #include "SimpleHttpClient/SimpleHttpClient.h"
 #include "SimpleHttpClient/SimpleHttpCommunicatorResult.h"
@@ -214,11 +217,13 @@ char const* ClusterCommResult::stringifyStatus(ClusterCommOpStatus status) {
 ////////////////////////////////////////////////////////////////////////////////
 
 ClusterComm::ClusterComm()
-    : _backgroundThread(nullptr),
+    : _wildcardWaiters(0),
+      _backgroundThread(nullptr),
       _logConnectionErrors(false),
       _authenticationEnabled(false),
       _jwt(""),
-      _jwtAuthorization("") {
+      _jwtAuthorization(""),
+      _useVelocyStream(false) {
   auto authentication = application_features::ApplicationServer::getFeature<AuthenticationFeature>("Authentication");
   TRI_ASSERT(authentication != nullptr);
   if (authentication->isEnabled()) {
@@ -232,7 +237,58 @@ ClusterComm::ClusterComm()
     _jwtAuthorization = "bearer " + _jwt;
   }
 
-  _communicator = std::make_shared<communicator::Communicator>();    
+  _communicator = std::make_shared<communicator::Communicator>();
+
+  auto cluster = application_features::ApplicationServer::getFeature<ClusterFeature>("Cluster");
+  if (cluster != nullptr && cluster->useVelocyStream()) {
+    _useVelocyStream = true;
+    _communicator->setAuthenticationToken(_jwt);
+
+    communicator::Communicator::PoolOptions poolOptions;
+    poolOptions._minConnections =
+        static_cast<size_t>(cluster->connectionPoolMin());
+    poolOptions._maxConnections =
+        static_cast<size_t>(cluster->connectionPoolMax());
+    poolOptions._idleTimeout = cluster->connectionIdleTimeout();
+    _communicator->setPoolOptions(poolOptions);
+
+    registerMetrics();
+  }
+}
+
+/// @brief expose the statistics of the connection pools via the metrics
+/// registry
+void ClusterComm::registerMetrics() {
+  auto const& stats = _communicator->poolStatistics();
+  MetricsRegistry::addCounter(
+      "arangodb_cluster_connections_opened_total",
+      "Number of VelocyStream connections opened to other servers",
+      [&stats]() { return static_cast<double>(stats._connectionsOpened.load()); });
+  MetricsRegistry::addCounter(
+      "arangodb_cluster_connections_prewarmed_total",
+      "Number of VelocyStream connections opened ahead of requests",
+      [&stats]() { return static_cast<double>(stats._connectionsPrewarmed.load()); });
+  MetricsRegistry::addCounter(
+      "arangodb_cluster_connections_closed_idle_total",
+      "Number of VelocyStream connections closed for being idle",
+      [&stats]() { return static_cast<double>(stats._connectionsClosedIdle.load()); });
+  MetricsRegistry::addCounter(
+      "arangodb_cluster_connections_broken_total",
+      "Number of VelocyStream connections that failed or were closed by "
+      "the other side",
+      [&stats]() { return static_cast<double>(stats._connectionsBroken.load()); });
+  MetricsRegistry::addGauge(
+      "arangodb_cluster_connections",
+      "Number of open VelocyStream connections to other servers",
+      [&stats]() { return static_cast<double>(stats._connections.load()); });
+  MetricsRegistry::addGauge(
+      "arangodb_cluster_connection_limit",
+      "Number of VelocyStream connections the pools may currently open",
+      [&stats]() { return static_cast<double>(stats._connectionLimit.load()); });
+  MetricsRegistry::addGauge(
+      "arangodb_cluster_connection_requests_in_flight",
+      "Number of requests in flight on VelocyStream connections",
+      [&stats]() { return static_cast<double>(stats._requestsInFlight.load()); });
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -240,6 +296,16 @@ ClusterComm::ClusterComm()
 ////////////////////////////////////////////////////////////////////////////////
 
 ClusterComm::~ClusterComm() {
+  if (_useVelocyStream) {
+    MetricsRegistry::remove("arangodb_cluster_connections_opened_total");
+    MetricsRegistry::remove("arangodb_cluster_connections_prewarmed_total");
+    MetricsRegistry::remove("arangodb_cluster_connections_closed_idle_total");
+    MetricsRegistry::remove("arangodb_cluster_connections_broken_total");
+    MetricsRegistry::remove("arangodb_cluster_connections");
+    MetricsRegistry::remove("arangodb_cluster_connection_limit");
+    MetricsRegistry::remove("arangodb_cluster_connection_requests_in_flight");
+  }
+
   if (_backgroundThread != nullptr) {
     _backgroundThread->beginShutdown();
     delete _backgroundThread;
@@ -402,13 +468,11 @@ OperationID ClusterComm::asyncRequest(
 
   Callbacks callbacks;
   bool doLogConnectionErrors = logConnectionErrors();
+  auto completed = std::make_shared<arangodb::basics::ConditionVariable>();
 
   if (callback) {
     callbacks._onError = [callback, result, doLogConnectionErrors, this](int errorCode, std::unique_ptr<GeneralResponse> response) {
-      {
-        CONDITION_LOCKER(locker, somethingReceived);
-        responses.erase(result->operationID);
-      }
+      unregisterResponse(result->operationID);
       result->fromError(errorCode, std::move(response));
       if (result->status == CL_COMM_BACKEND_UNAVAILABLE) {
         if (doLogConnectionErrors) {
@@ -425,47 +489,52 @@ OperationID ClusterComm::asyncRequest(
       TRI_ASSERT(ret == true);
     };
     callbacks._onSuccess = [callback, result, this](std::unique_ptr<GeneralResponse> response) {
-      {
-        CONDITION_LOCKER(locker, somethingReceived);
-        responses.erase(result->operationID);
-      }
+      unregisterResponse(result->operationID);
       TRI_ASSERT(response.get() != nullptr);
       result->fromResponse(std::move(response));
       bool ret = ((*callback.get())(result.get()));
       TRI_ASSERT(ret == true);
     };
   } else {
-    callbacks._onError = [callback, result, doLogConnectionErrors, this](int errorCode, std::unique_ptr<GeneralResponse> response) {
-      CONDITION_LOCKER(locker, somethingReceived);
-      result->fromError(errorCode, std::move(response));
-      if (result->status == CL_COMM_BACKEND_UNAVAILABLE) {
-        if (doLogConnectionErrors) {
-          LOG_TOPIC(ERR, Logger::CLUSTER)
-            << "cannot create connection to server '" << result->serverID
-            << "' at endpoint '" << result->endpoint << "'";
-        } else {
-          LOG_TOPIC(INFO, Logger::CLUSTER)
-            << "cannot create connection to server '" << result->serverID
-            << "' at endpoint '" << result->endpoint << "'";
+    callbacks._onError = [completed, result, doLogConnectionErrors, this](int errorCode, std::unique_ptr<GeneralResponse> response) {
+      {
+        CONDITION_LOCKER(locker, *completed);
+        result->fromError(errorCode, std::move(response));
+        if (result->status == CL_COMM_BACKEND_UNAVAILABLE) {
+          if (doLogConnectionErrors) {
+            LOG_TOPIC(ERR, Logger::CLUSTER)
+              << "cannot create connection to server '" << result->serverID
+              << "' at endpoint '" << result->endpoint << "'";
+          } else {
+            LOG_TOPIC(INFO, Logger::CLUSTER)
+              << "cannot create connection to server '" << result->serverID
+              << "' at endpoint '" << result->endpoint << "'";
+          }
         }
+        locker.broadcast();
       }
-      somethingReceived.broadcast();
+      notifyWildcardWaiters();
     };
-    callbacks._onSuccess = [result, this](std::unique_ptr<GeneralResponse> response) {
+    callbacks._onSuccess = [completed, result, this](std::unique_ptr<GeneralResponse> response) {
       TRI_ASSERT(response.get() != nullptr);
-      CONDITION_LOCKER(locker, somethingReceived);
-      result->fromResponse(std::move(response));
-      somethingReceived.broadcast();
+      {
+        CONDITION_LOCKER(locker, *completed);
+        result->fromResponse(std::move(response));
+        locker.broadcast();
+      }
+      notifyWildcardWaiters();
     };
   }
 
   TRI_ASSERT(request != nullptr);
-  CONDITION_LOCKER(locker, somethingReceived);
-  auto ticketId = _communicator->addRequest(createCommunicatorDestination(result->endpoint, path),
-               std::move(request), callbacks, opt);
-
+  // the operation is registered before the request is handed to the
+  // communicator, so that its callbacks always find it
+  auto ticketId = communicator::Communicator::createTicket();
   result->operationID = ticketId;
-  responses.emplace(ticketId, AsyncResponse{TRI_microtime(), result});
+  registerResponse(ticketId, AsyncResponse{TRI_microtime(), result, completed});
+
+  _communicator->addRequest(ticketId, createCommunicatorDestination(result->endpoint, path),
+               std::move(request), callbacks, opt);
   return ticketId;
 }
 
@@ -578,17 +647,11 @@ bool ClusterComm::match(ClientTransactionID const& clientTransactionID,
 ////////////////////////////////////////////////////////////////////////////////
 
 ClusterCommResult const ClusterComm::enquire(Ticket const ticketId) {
-  ResponseIterator i;
   AsyncResponse response;
 
-  {
-    CONDITION_LOCKER(locker, somethingReceived);
-
-    i = responses.find(ticketId);
-    if (i != responses.end()) {
-      response = i->second;
-      return *response.result.get();
-    }
+  if (lookupResponse(ticketId, response)) {
+    CONDITION_LOCKER(locker, *response.completed);
+    return *response.result.get();
   }
 
   ClusterCommResult res;
@@ -617,42 +680,128 @@ ClusterCommResult const ClusterComm::wait(
     CoordTransactionID const coordTransactionID, Ticket const ticketId,
     ShardID const& shardID, ClusterCommTimeout timeout) {
 
-  ResponseIterator i;
   AsyncResponse response;
 
   // tell scheduler that we are waiting:
   JobGuard guard{SchedulerFeature::SCHEDULER};
   guard.block();
 
+  if (ticketId != 0) {
+    if (!lookupResponse(ticketId, response)) {
+      // Nothing known about this operation, return with failure:
+      ClusterCommResult res;
+      res.operationID = ticketId;
+      // does res.coordTransactionID need to be set here too? 
+      res.status = CL_COMM_DROPPED;
+      return res;
+    }
+
+    // only the waiters of this operation are woken up by its completion
+    {
+      CONDITION_LOCKER(locker, *response.completed);
+      while (response.result->status == CL_COMM_SUBMITTED) {
+        locker.wait(100000);
+      }
+    }
+    unregisterResponse(ticketId);
+    return *response.result.get();
+  }
+
+  // wait for any of the matching operations to complete. the counter
+  // is increased before looking at the operations, so that a completion
+  // either is seen here or wakes us up
+  ++_wildcardWaiters;
+  TRI_DEFER(--_wildcardWaiters);
+
   CONDITION_LOCKER(locker, somethingReceived);
-  if (ticketId == 0) {
-    for (i = responses.begin(); i != responses.end(); i++) {
-      if (match(clientTransactionID, coordTransactionID, shardID, i->second.result.get())) {
-        break;
+
+  while (true) {
+    bool found = false;
+
+    for (auto& shard : _responseShards) {
+      std::vector<AsyncResponse> candidates;
+      {
+        MUTEX_LOCKER(shardLocker, shard.lock);
+        for (auto const& it : shard.responses) {
+          if (match(clientTransactionID, coordTransactionID, shardID,
+                    it.second.result.get())) {
+            candidates.emplace_back(it.second);
+          }
+        }
+      }
+
+      for (auto const& candidate : candidates) {
+        found = true;
+        CONDITION_LOCKER(resultLocker, *candidate.completed);
+        if (candidate.result->status != CL_COMM_SUBMITTED) {
+          response = candidate;
+          break;
+        }
+      }
+
+      if (response.result != nullptr) {
+        unregisterResponse(response.result->operationID);
+        return *response.result.get();
       }
     }
-  } else {
-    i = responses.find(ticketId);
+
+    if (!found) {
+      // Nothing known about this operation, return with failure:
+      ClusterCommResult res;
+      res.operationID = ticketId;
+      res.status = CL_COMM_DROPPED;
+      return res;
+    }
+
+    locker.wait(100000);
   }
-  if (i == responses.end()) {
-    // Nothing known about this operation, return with failure:
-    ClusterCommResult res;
-    res.operationID = ticketId;
-    // does res.coordTransactionID need to be set here too? 
-    res.status = CL_COMM_DROPPED;
-    // tell Dispatcher that we are back in business
-    return res;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief register an operation in flight
+////////////////////////////////////////////////////////////////////////////////
+
+void ClusterComm::registerResponse(Ticket ticketId,
+                                   AsyncResponse const& response) {
+  ResponseShard& shard = responseShard(ticketId);
+  MUTEX_LOCKER(locker, shard.lock);
+  shard.responses.emplace(ticketId, response);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief look up an operation in flight, returns false if it is unknown
+////////////////////////////////////////////////////////////////////////////////
+
+bool ClusterComm::lookupResponse(Ticket ticketId, AsyncResponse& response) {
+  ResponseShard& shard = responseShard(ticketId);
+  MUTEX_LOCKER(locker, shard.lock);
+  auto it = shard.responses.find(ticketId);
+  if (it == shard.responses.end()) {
+    return false;
   }
-  response = i->second;
+  response = it->second;
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief remove an operation from the registry
+////////////////////////////////////////////////////////////////////////////////
+
+void ClusterComm::unregisterResponse(Ticket ticketId) {
+  ResponseShard& shard = responseShard(ticketId);
+  MUTEX_LOCKER(locker, shard.lock);
+  shard.responses.erase(ticketId);
+}
 
-  ClusterCommOpStatus status = response.result->status;
+////////////////////////////////////////////////////////////////////////////////
+/// @brief wake up the threads waiting for any matching operation
+////////////////////////////////////////////////////////////////////////////////
 
-  while (status == CL_COMM_SUBMITTED) {
-    somethingReceived.wait(100000);
-    status = response.result->status;
+void ClusterComm::notifyWildcardWaiters() {
+  if (_wildcardWaiters.load() > 0) {
+    CONDITION_LOCKER(locker, somethingReceived);
+    locker.broadcast();
   }
-  responses.erase(i);
-  return *response.result.get();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -791,7 +940,8 @@ void ClusterComm::cleanupAllQueues() {
   }
 }
 
-ClusterCommThread::ClusterCommThread() : Thread("ClusterComm"), _cc(nullptr) {
+ClusterCommThread::ClusterCommThread()
+    : Thread("ClusterComm"), _cc(nullptr), _lastPrewarm(0.0) {
   _cc = ClusterComm::instance().get();
 }
 
@@ -1059,7 +1209,9 @@ size_t ClusterComm::performSingleRequest(
 communicator::Destination ClusterComm::createCommunicatorDestination(std::string const& endpoint, std::string const& path) {
   std::string httpEndpoint;
   if (endpoint.substr(0, 6) == "tcp://") {
-    httpEndpoint = "http://" + endpoint.substr(6);
+    // the communicator multiplexes vst:// destinations over a few
+    // VelocyStream connections per server
+    httpEndpoint = (_useVelocyStream ? "vst://" : "http://") + endpoint.substr(6);
   } else if (endpoint.substr(0, 6) == "ssl://") {
     httpEndpoint = "https://" + endpoint.substr(6);
   }
@@ -1107,10 +1259,17 @@ std::pair<ClusterCommResult*, HttpRequest*> ClusterComm::prepareRequest(std::str
 #endif
 #endif
 
+  // bodies are JSON, unless the caller explicitly sends VelocyPack
+  ContentType contentType = ContentType::JSON;
+  auto it = headersCopy.find(StaticStrings::ContentTypeHeader);
+  if (it != headersCopy.end() && it->second == StaticStrings::MimeTypeVPack) {
+    contentType = ContentType::VPACK;
+  }
+
   if (body == nullptr) {
-    request = HttpRequest::createHttpRequest(ContentType::JSON, "", 0, headersCopy);
+    request = HttpRequest::createHttpRequest(contentType, "", 0, headersCopy);
   } else {
-    request = HttpRequest::createHttpRequest(ContentType::JSON, body->c_str(), body->length(), headersCopy);
+    request = HttpRequest::createHttpRequest(contentType, body->c_str(), body->length(), headersCopy);
   }
   request->setRequestType(reqtype);
 
@@ -1146,12 +1305,36 @@ void ClusterCommThread::abortRequestsToFailedServers() {
   }
 }
 
+void ClusterCommThread::prewarmConnections() {
+  ClusterInfo* ci = ClusterInfo::instance();
+  std::vector<std::string> endpoints;
+
+  for (auto const& server : ci->getCurrentDBServers()) {
+    std::string endpoint = ci->getServerEndpoint(server);
+    if (!endpoint.empty()) {
+      endpoints.emplace_back(
+          _cc->createCommunicatorDestination(endpoint, "/").url());
+    }
+  }
+
+  _cc->communicator()->prewarm(endpoints);
+}
+
 void ClusterCommThread::run() {
   LOG_TOPIC(DEBUG, Logger::CLUSTER) << "starting ClusterComm thread";
 
   while (!isStopping()) {
     try {
       abortRequestsToFailedServers();
+      if (_cc->_useVelocyStream && ServerState::instance()->isCoordinator()) {
+        // open connections to new DB servers, and replace the ones that
+        // were closed by the other side, ahead of the next requests
+        double const now = TRI_microtime();
+        if (now - _lastPrewarm >= 10.0) {
+          _lastPrewarm = now;
+          prewarmConnections();
+        }
+      }
       _cc->communicator()->work_once();
       _cc->communicator()->wait();
     } catch (std::exception const& ex) {
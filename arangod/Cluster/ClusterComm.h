@@ -28,6 +28,7 @@
 
 #include "Agency/AgencyComm.h"
 #include "Basics/ConditionVariable.h"
+#include "Basics/Mutex.h"
 #include "Basics/ReadWriteLock.h"
 #include "Basics/Thread.h"
 #include "Cluster/ClusterInfo.h"
@@ -520,6 +521,9 @@ class ClusterComm {
   std::string jwt() { return _jwt; };
   
  private:
+  /// @brief expose the statistics of the connection pools
+  void registerMetrics();
+
   size_t performSingleRequest(std::vector<ClusterCommRequest>& requests,
                               ClusterCommTimeout timeout, size_t& nrDone,
                               arangodb::LogTopic const& logTopic);
@@ -568,10 +572,43 @@ class ClusterComm {
   struct AsyncResponse {
     double timestamp;
     std::shared_ptr<ClusterCommResult> result;
+    /// @brief protects the status of the result, and is signalled once
+    /// the result is complete. only the waiters for this operation sleep
+    /// on it
+    std::shared_ptr<arangodb::basics::ConditionVariable> completed;
   };
 
-  typedef std::unordered_map<communicator::Ticket, AsyncResponse>::iterator ResponseIterator;
-  std::unordered_map<communicator::Ticket, AsyncResponse> responses;
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief the registry of operations in flight, sharded by ticket id so
+  /// that registering and completing operations do not serialize on one lock
+  //////////////////////////////////////////////////////////////////////////////
+
+  static constexpr size_t NumResponseShards = 16;
+
+  struct ResponseShard {
+    arangodb::Mutex lock;
+    std::unordered_map<communicator::Ticket, AsyncResponse> responses;
+  };
+
+  ResponseShard _responseShards[NumResponseShards];
+
+  ResponseShard& responseShard(communicator::Ticket ticketId) {
+    return _responseShards[ticketId % NumResponseShards];
+  }
+
+  void registerResponse(communicator::Ticket ticketId,
+                        AsyncResponse const& response);
+  bool lookupResponse(communicator::Ticket ticketId, AsyncResponse& response);
+  void unregisterResponse(communicator::Ticket ticketId);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief number of threads in wait() for any matching operation. only if
+  /// there are some, completions need to wake up `somethingReceived`
+  //////////////////////////////////////////////////////////////////////////////
+
+  std::atomic<uint64_t> _wildcardWaiters;
+
+  void notifyWildcardWaiters();
 
   // Receiving answers:
   std::list<ClusterCommOperation*> received;
@@ -632,6 +669,9 @@ class ClusterComm {
   bool _authenticationEnabled;
   std::string _jwt;
   std::string _jwtAuthorization;
+  /// @brief whether requests to plain tcp:// endpoints are sent via
+  /// VelocyStream
+  bool _useVelocyStream;
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -654,11 +694,17 @@ class ClusterCommThread : public Thread {
  private:
   void abortRequestsToFailedServers();
 
+  /// @brief open the minimum number of connections to all DB servers
+  void prewarmConnections();
+
  protected:
   void run() override final;
 
  private:
   ClusterComm* _cc;
+
+  /// @brief the time the connections were last prewarmed
+  double _lastPrewarm;
 };
 }
 
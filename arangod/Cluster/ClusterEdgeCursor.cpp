@@ -39,7 +39,8 @@ ClusterEdgeCursor::ClusterEdgeCursor(VPackSlice v, uint64_t depth,
       fetchEdgesFromEngines(traverser->_dbname, traverser->_engines, v, depth,
                             traverser->_edges, _edgeList, traverser->_datalake,
                             *(leased.get()), traverser->_filteredPaths,
-                            traverser->_readDocuments);
+                            traverser->_readDocuments,
+                            traverser->vertexCacheForEdges(depth));
     }
 
 
@@ -46,6 +46,8 @@ using namespace arangodb::application_features;
 using namespace arangodb::basics;
 using namespace arangodb::options;
 
+double ClusterFeature::_countCacheTtl = 1.0;
+
 ClusterFeature::ClusterFeature(application_features::ApplicationServer* server)
     : ApplicationFeature(server, "Cluster"),
       _unregisterOnShutdown(false),
@@ -127,6 +129,47 @@ void ClusterFeature::collectOptions(std::shared_ptr<ProgramOptions> options) {
   options->addOption("--cluster.system-replication-factor",
                      "replication factor for system collections",
                      new UInt32Parameter(&_systemReplicationFactor));
+
+  options->addOption("--cluster.use-velocystream",
+                     "send cluster-internal requests via multiplexed "
+                     "VelocyStream connections instead of HTTP",
+                     new BooleanParameter(&_useVelocyStream));
+
+  options->addOption("--cluster.connection-pool-min",
+                     "number of VelocyStream connections a coordinator "
+                     "opens to each DB server ahead of the first request, "
+                     "and keeps open when idle",
+                     new UInt64Parameter(&_connectionPoolMin));
+
+  options->addOption("--cluster.connection-pool-max",
+                     "number of VelocyStream connections to a DB server a "
+                     "pool may grow to when the latency of its requests "
+                     "rises",
+                     new UInt64Parameter(&_connectionPoolMax));
+
+  options->addOption("--cluster.connection-idle-timeout",
+                     "time (in seconds) after which idle VelocyStream "
+                     "connections above the minimum are closed",
+                     new DoubleParameter(&_connectionIdleTimeout));
+
+  options->addHiddenOption("--cluster.native-plan-sync",
+                           "synchronize the shards of a DB server with the "
+                           "Plan in C++, using JavaScript only to create or "
+                           "drop databases and to synchronize followers "
+                           "(experimental)",
+                           new BooleanParameter(&_nativePlanSync));
+
+  options->addOption("--cluster.insert-batch-window",
+                     "time (in microseconds) a coordinator waits for more "
+                     "single-document inserts into the same shard to send "
+                     "them to the DB server as one request (0 = disabled)",
+                     new UInt64Parameter(&_insertBatchWindow));
+
+  options->addOption("--cluster.count-cache-ttl",
+                     "time (in seconds) a coordinator answers collection "
+                     "counts and figures from its cache instead of asking "
+                     "all shards (0 = disabled)",
+                     new DoubleParameter(&_countCacheTtl));
 }
 
 void ClusterFeature::validateOptions(std::shared_ptr<ProgramOptions> options) {
@@ -159,6 +202,13 @@ void ClusterFeature::validateOptions(std::shared_ptr<ProgramOptions> options) {
     FATAL_ERROR_EXIT();
   }
 
+  if (_connectionPoolMax == 0 || _connectionPoolMin > _connectionPoolMax) {
+    LOG_TOPIC(FATAL, arangodb::Logger::FIXME)
+        << "--cluster.connection-pool-max must be greater 0 and at least "
+        << "--cluster.connection-pool-min";
+    FATAL_ERROR_EXIT();
+  }
+
   // validate system-replication-factor
   if (_systemReplicationFactor == 0) {
     LOG_TOPIC(FATAL, arangodb::Logger::FIXME) << "system replication factor must be greater 0";
@@ -58,6 +58,13 @@ class ClusterFeature : public application_features::ApplicationFeature {
   std::string _dbserverConfig;
   std::string _coordinatorConfig;
   uint32_t _systemReplicationFactor = 2;
+  bool _useVelocyStream = false;
+  bool _nativePlanSync = false;
+  uint64_t _connectionPoolMin = 2;
+  uint64_t _connectionPoolMax = 8;
+  double _connectionIdleTimeout = 60.0;
+  uint64_t _insertBatchWindow = 0;
+  static double _countCacheTtl;
 
  private:
   void reportRole(ServerState::RoleEnum);
@@ -73,6 +80,30 @@ class ClusterFeature : public application_features::ApplicationFeature {
 
   void setUnregisterOnShutdown(bool);
 
+  /// @brief whether ClusterComm sends requests via VelocyStream
+  bool useVelocyStream() const { return _useVelocyStream; }
+
+  /// @brief the number of VelocyStream connections a coordinator keeps
+  /// open to each DB server, and the number a pool may grow to
+  uint64_t connectionPoolMin() const { return _connectionPoolMin; }
+  uint64_t connectionPoolMax() const { return _connectionPoolMax; }
+
+  /// @brief the time in seconds after which idle connections above the
+  /// minimum are closed
+  double connectionIdleTimeout() const { return _connectionIdleTimeout; }
+
+  /// @brief whether DB servers synchronize their shards with the Plan in
+  /// C++, or always run the JavaScript implementation
+  bool nativePlanSync() const { return _nativePlanSync; }
+
+  /// @brief the time in microseconds that single-document inserts on a
+  /// coordinator are collected for batching, 0 if batching is disabled
+  uint64_t insertBatchWindow() const { return _insertBatchWindow; }
+
+  /// @brief the time in seconds a coordinator answers count and figures
+  /// requests from its cache, 0 if the cache is disabled
+  static double countCacheTtl() { return _countCacheTtl; }
+
  private:
   bool _unregisterOnShutdown;
   bool _enableCluster;
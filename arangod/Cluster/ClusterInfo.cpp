@@ -203,6 +203,13 @@ ClusterInfo::ClusterInfo(AgencyCallbackRegistry* agencyCallbackRegistry)
   _uniqid._currentValue = 1ULL;
   _uniqid._upperValue = 0ULL;
 
+  auto table = std::make_shared<RoutingTable>();
+  table->planVersion = 0;
+  table->currentVersion = 0;
+  table->collections = std::make_shared<RoutingTable::CollectionMap const>();
+  table->shardServers = std::make_shared<RoutingTable::ShardServerMap const>();
+  _routingTable = table;
+
   // Actual loading into caches is postponed until necessary
 }
 
@@ -382,6 +389,38 @@ std::vector<DatabaseID> ClusterInfo::databases(bool reload) {
 //
 static std::string const prefixPlan = "Plan";
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether two agency values are byte-wise identical. used to skip
+/// re-parsing parts of Plan and Current that did not change since the last
+/// load. agency values of the same content are serialized identically
+////////////////////////////////////////////////////////////////////////////////
+
+static bool isUnchanged(VPackSlice oldValue, VPackSlice newValue) {
+  if (oldValue.isNone() || oldValue.byteSize() != newValue.byteSize()) {
+    return false;
+  }
+  return memcmp(oldValue.start(), newValue.start(), newValue.byteSize()) == 0;
+}
+
+/// @brief the value of "<section>/<database>" in a cached Plan or Current,
+/// or a none slice if it does not exist
+static VPackSlice previousValue(std::shared_ptr<VPackBuilder> const& cached,
+                                char const* section,
+                                VPackSlice const& database) {
+  if (cached == nullptr || !cached->slice().isObject()) {
+    return VPackSlice::noneSlice();
+  }
+  VPackSlice value = cached->slice().get(section);
+  if (!value.isObject()) {
+    return VPackSlice::noneSlice();
+  }
+  value = value.get(database.copyString());
+  if (!value.isObject()) {
+    return VPackSlice::noneSlice();
+  }
+  return value;
+}
+
 void ClusterInfo::loadPlan() {
   DatabaseFeature* databaseFeature =
       application_features::ApplicationServer::getFeature<DatabaseFeature>(
@@ -417,6 +456,14 @@ void ClusterInfo::loadPlan() {
       bool swapDatabases = false;
       bool swapCollections = false;
 
+      // the previous plan and the maps built from it. they are only
+      // modified by loadPlan, which we are the only one to execute right
+      // now, so we can read them without holding the lock. collections
+      // whose plan entry did not change are taken over from them instead
+      // of being parsed again
+      std::shared_ptr<VPackBuilder> oldPlan = _plan;
+      size_t reused = 0;
+
       VPackSlice databasesSlice;
       databasesSlice = planSlice.get("Databases");
       if (databasesSlice.isObject()) {
@@ -453,6 +500,10 @@ void ClusterInfo::loadPlan() {
             continue;
           }
 
+          VPackSlice oldCollectionsSlice =
+              previousValue(oldPlan, "Collections", databasePairSlice.key);
+          auto oldDatabase = _plannedCollections.find(databaseName);
+
           for (auto const& collectionPairSlice :
                VPackObjectIterator(collectionsSlice)) {
             VPackSlice const& collectionSlice = collectionPairSlice.value;
@@ -462,6 +513,31 @@ void ClusterInfo::loadPlan() {
 
             std::string const collectionId =
                 collectionPairSlice.key.copyString();
+
+            if (oldDatabase != _plannedCollections.end() &&
+                !oldCollectionsSlice.isNone() &&
+                isUnchanged(oldCollectionsSlice.get(collectionId),
+                            collectionSlice)) {
+              auto oldCollection = oldDatabase->second.find(collectionId);
+              auto oldShards = _shards.find(collectionId);
+              auto oldShardKeys = _shardKeys.find(collectionId);
+
+              if (oldCollection != oldDatabase->second.end() &&
+                  oldCollection->second->vocbase() == vocbase &&
+                  oldShards != _shards.end() &&
+                  oldShardKeys != _shardKeys.end()) {
+                auto const& collection = oldCollection->second;
+                databaseCollections.emplace(
+                    std::make_pair(collection->name(), collection));
+                databaseCollections.emplace(
+                    std::make_pair(collectionId, collection));
+                newShardKeys.emplace(*oldShardKeys);
+                newShards.emplace(*oldShards);
+                ++reused;
+                continue;
+              }
+            }
+
             try {
               std::shared_ptr<LogicalCollection> newCollection;
 #ifndef USE_ENTERPRISE
@@ -544,6 +620,10 @@ void ClusterInfo::loadPlan() {
         }
       }
 
+      LOG_TOPIC(TRACE, Logger::CLUSTER)
+          << "loaded plan, took over " << reused
+          << " unchanged collections from the previous plan";
+
       WRITE_LOCKER(writeLocker, _planProt.lock);
       _plan = planBuilder;
       if (swapDatabases) {
@@ -553,6 +633,7 @@ void ClusterInfo::loadPlan() {
         _plannedCollections.swap(newCollections);
         _shards.swap(newShards);
         _shardKeys.swap(newShardKeys);
+        publishPlanRouting(storedVersion);
       }
       _planProt.doneVersion = storedVersion;
       _planProt.isValid = true;  // will never be reset to false
@@ -570,6 +651,79 @@ void ClusterInfo::loadPlan() {
       << " body: " << result.body();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief a copy of the routing table with the sharding information from
+/// Plan. the shard to server part is shared with the table
+////////////////////////////////////////////////////////////////////////////////
+
+std::shared_ptr<ClusterInfo::RoutingTable const>
+ClusterInfo::RoutingTable::withPlan(
+    uint64_t planVersion,
+    std::unordered_map<CollectionID,
+                       std::shared_ptr<std::vector<std::string>>> const& shards,
+    std::unordered_map<CollectionID,
+                       std::shared_ptr<std::vector<std::string>>> const&
+        shardKeys) const {
+  auto collections = std::make_shared<CollectionMap>();
+  collections->reserve(shards.size());
+
+  for (auto const& it : shards) {
+    auto it2 = shardKeys.find(it.first);
+    if (it2 == shardKeys.end()) {
+      continue;
+    }
+    auto const& keys = it2->second;
+    collections->emplace(
+        it.first,
+        CollectionRouting{it.second, keys,
+                          keys->size() == 1 &&
+                              keys->at(0) == StaticStrings::KeyString});
+  }
+
+  auto table = std::make_shared<RoutingTable>(*this);
+  table->planVersion = planVersion;
+  table->collections = collections;
+  return table;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief a copy of the routing table with the shard leaders and followers
+/// from Current. the collection part is shared with the table
+////////////////////////////////////////////////////////////////////////////////
+
+std::shared_ptr<ClusterInfo::RoutingTable const>
+ClusterInfo::RoutingTable::withCurrent(
+    uint64_t currentVersion, ShardServerMap const& shardServers) const {
+  auto table = std::make_shared<RoutingTable>(*this);
+  table->currentVersion = currentVersion;
+  table->shardServers = std::make_shared<ShardServerMap const>(shardServers);
+  return table;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief publish a new routing table snapshot with the sharding
+/// information from Plan
+////////////////////////////////////////////////////////////////////////////////
+
+void ClusterInfo::publishPlanRouting(uint64_t planVersion) {
+  MUTEX_LOCKER(mutexLocker, _routingTableLock);
+  auto old = std::atomic_load(&_routingTable);
+  std::atomic_store(&_routingTable,
+                    old->withPlan(planVersion, _shards, _shardKeys));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief publish a new routing table snapshot with the shard leaders and
+/// followers from Current
+////////////////////////////////////////////////////////////////////////////////
+
+void ClusterInfo::publishCurrentRouting(uint64_t currentVersion) {
+  MUTEX_LOCKER(mutexLocker, _routingTableLock);
+  auto old = std::atomic_load(&_routingTable);
+  std::atomic_store(&_routingTable,
+                    old->withCurrent(currentVersion, _shardIds));
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief (re-)load the information about current databases
 /// Usually one does not have to call this directly.
@@ -608,6 +762,10 @@ void ClusterInfo::loadCurrent() {
       bool swapDatabases = false;
       bool swapCollections = false;
 
+      // like in loadPlan, collections whose entries did not change are
+      // taken over from the previous maps, which only we modify
+      std::shared_ptr<VPackBuilder> oldCurrent = _current;
+
       VPackSlice databasesSlice = currentSlice.get("Databases");
       if (databasesSlice.isObject()) {
         for (auto const& databaseSlicePair :
@@ -635,11 +793,38 @@ void ClusterInfo::loadCurrent() {
         for (auto const& databaseSlice : VPackObjectIterator(databasesSlice)) {
           std::string const databaseName = databaseSlice.key.copyString();
 
+          VPackSlice oldCollectionsSlice =
+              previousValue(oldCurrent, "Collections", databaseSlice.key);
+          auto oldDatabase = _currentCollections.find(databaseName);
+
           DatabaseCollectionsCurrent databaseCollections;
           for (auto const& collectionSlice :
                VPackObjectIterator(databaseSlice.value)) {
             std::string const collectionName = collectionSlice.key.copyString();
 
+            if (oldDatabase != _currentCollections.end() &&
+                !oldCollectionsSlice.isNone() &&
+                isUnchanged(oldCollectionsSlice.get(collectionName),
+                            collectionSlice.value)) {
+              auto oldCollection = oldDatabase->second.find(collectionName);
+              if (oldCollection != oldDatabase->second.end()) {
+                bool complete = true;
+                for (auto const& shardSlice :
+                     VPackObjectIterator(collectionSlice.value)) {
+                  auto it = _shardIds.find(shardSlice.key.copyString());
+                  if (it == _shardIds.end()) {
+                    complete = false;
+                    break;
+                  }
+                  newShardIds.emplace(*it);
+                }
+                if (complete) {
+                  databaseCollections.emplace(*oldCollection);
+                  continue;
+                }
+              }
+            }
+
             auto collectionDataCurrent =
                 std::make_shared<CollectionInfoCurrent>();
             for (auto const& shardSlice :
@@ -679,6 +864,7 @@ void ClusterInfo::loadCurrent() {
             << "Have loaded new collections current cache!";
         _currentCollections.swap(newCollections);
         _shardIds.swap(newShardIds);
+        publishCurrentRouting(storedVersion);
       }
       _currentProt.doneVersion = storedVersion;
       _currentProt.isValid = true;  // will never be reset to false
@@ -2402,12 +2588,11 @@ std::shared_ptr<std::vector<ServerID>> ClusterInfo::getResponsibleServer(
   while (true) {
     {
       {
-        READ_LOCKER(readLocker, _currentProt.lock);
-        // _shardIds is a map-type <ShardId,
-        // std::shared_ptr<std::vector<ServerId>>>
-        auto it = _shardIds.find(shardID);
+        // the routing table snapshot can be read without locking
+        auto table = routingTable();
+        auto it = table->shardServers->find(shardID);
 
-        if (it != _shardIds.end()) {
+        if (it != table->shardServers->end()) {
           auto serverList = (*it).second;
           if (serverList != nullptr && serverList->size() > 0 &&
               (*serverList)[0].size() > 0 && (*serverList)[0][0] == '_') {
@@ -2504,23 +2689,18 @@ int ClusterInfo::getResponsibleShard(LogicalCollection* collInfo,
 
   while (true) {
     {
-      // Get the sharding keys and the number of shards:
-      READ_LOCKER(readLocker, _planProt.lock);
-      // _shards is a map-type <CollectionId, shared_ptr<vector<string>>>
-      auto it = _shards.find(collectionId);
-
-      if (it != _shards.end()) {
-        shards = it->second;
-        // _shardKeys is a map-type <CollectionID, shared_ptr<vector<string>>>
-        auto it2 = _shardKeys.find(collectionId);
-        if (it2 != _shardKeys.end()) {
-          shardKeysPtr = it2->second;
-          usesDefaultShardingAttributes =
-              shardKeysPtr->size() == 1 &&
-              shardKeysPtr->at(0) == StaticStrings::KeyString;
-          found = true;
-          break;  // all OK
-        }
+      // Get the sharding keys and the number of shards from the routing
+      // table snapshot, which can be read without locking:
+      auto table = routingTable();
+      auto it = table->collections->find(collectionId);
+
+      if (it != table->collections->end()) {
+        shards = it->second.shards;
+        shardKeysPtr = it->second.shardKeys;
+        usesDefaultShardingAttributes =
+            it->second.usesDefaultShardingAttributes;
+        found = true;
+        break;  // all OK
       }
     }
     if (++tries >= 2) {
@@ -2545,6 +2725,72 @@ int ClusterInfo::getResponsibleShard(LogicalCollection* collInfo,
   shardID = shards->at(hash % shards->size());
   return error;
 }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief find the shards that are responsible for a batch of documents.
+/// the documents are handled as by getResponsibleShard, but the sharding
+/// of the collection is looked up only once, and the shards are returned
+/// as positions in the shard list instead of by name
+////////////////////////////////////////////////////////////////////////////////
+
+int ClusterInfo::getResponsibleShards(LogicalCollection* collInfo,
+                                      std::vector<VPackSlice> const& slices,
+                                      bool docComplete,
+                                      std::shared_ptr<std::vector<ShardID>>& shards,
+                                      std::vector<size_t>& shardIndexes) {
+  if (!_planProt.isValid) {
+    loadPlan();
+  }
+
+  int tries = 0;
+  std::shared_ptr<std::vector<std::string>> shardKeysPtr;
+  bool found = false;
+  CollectionID collectionId = std::to_string(collInfo->planId());
+
+  while (true) {
+    {
+      auto table = routingTable();
+      auto it = table->collections->find(collectionId);
+
+      if (it != table->collections->end()) {
+        shards = it->second.shards;
+        shardKeysPtr = it->second.shardKeys;
+        found = true;
+        break;  // all OK
+      }
+    }
+    if (++tries >= 2) {
+      break;
+    }
+    loadPlan();
+  }
+
+  if (!found) {
+    return TRI_ERROR_ARANGO_COLLECTION_NOT_FOUND;
+  }
+
+  static char const* magicPhrase =
+      "Foxx you have stolen the goose, give she back again!";
+  static size_t const len = 52;
+
+  int result = TRI_ERROR_NO_ERROR;
+  size_t const n = shards->size();
+  shardIndexes.clear();
+  shardIndexes.reserve(slices.size());
+
+  for (auto const& slice : slices) {
+    int error = TRI_ERROR_NO_ERROR;
+    uint64_t hash = arangodb::basics::VelocyPackHelper::hashByAttributes(
+        slice, *shardKeysPtr, docComplete, error);
+    hash = TRI_FnvHashBlock(hash, magicPhrase, len);
+    if (error != TRI_ERROR_NO_ERROR && result == TRI_ERROR_NO_ERROR) {
+      result = error;
+    }
+    shardIndexes.emplace_back(static_cast<size_t>(hash % n));
+  }
+
+  return result;
+}
 #endif
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -34,6 +34,7 @@
 #include "Cluster/AgencyCallbackRegistry.h"
 #include "Agency/AgencyComm.h"
 #include "Basics/Mutex.h"
+#include "Basics/ReadMostlyLock.h"
 #include "Basics/ReadWriteLock.h"
 #include "Basics/StaticStrings.h"
 #include "Basics/VelocyPackHelper.h"
@@ -464,6 +465,18 @@ class ClusterInfo {
                           bool& usesDefaultShardingAttributes,
                           std::string const& key = "");
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief find the shards that are responsible for a batch of documents,
+  /// looking up the sharding of the collection only once. shardIndexes[i]
+  /// is set to the position of the shard of slices[i] in shards
+  //////////////////////////////////////////////////////////////////////////////
+
+  int getResponsibleShards(
+      LogicalCollection*,
+      std::vector<arangodb::velocypack::Slice> const& slices,
+      bool docComplete, std::shared_ptr<std::vector<ShardID>>& shards,
+      std::vector<size_t>& shardIndexes);
+
 
   //////////////////////////////////////////////////////////////////////////////
   /// @brief return the list of coordinator server names
@@ -500,6 +513,50 @@ class ClusterInfo {
 
   std::unordered_map<ServerID, std::string> getServerAliases();
   
+  // The routing table is an immutable snapshot of the information needed
+  // to route documents to shards and shards to servers. A new snapshot is
+  // published whenever Plan or Current are reloaded (which happens on
+  // agency callbacks and heartbeats), so that request threads can read it
+  // without acquiring the read locks of _planProt and _currentProt.
+  struct CollectionRouting {
+    std::shared_ptr<std::vector<ShardID>> shards;
+    std::shared_ptr<std::vector<std::string>> shardKeys;
+    bool usesDefaultShardingAttributes;
+  };
+
+  struct RoutingTable {
+    typedef std::unordered_map<CollectionID, CollectionRouting> CollectionMap;
+    typedef std::unordered_map<ShardID, std::shared_ptr<std::vector<ServerID>>>
+        ShardServerMap;
+
+    uint64_t planVersion;
+    uint64_t currentVersion;
+    std::shared_ptr<CollectionMap const> collections;
+    std::shared_ptr<ShardServerMap const> shardServers;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief a copy of the table with the sharding information from Plan.
+    /// the shard to server part is shared with the table
+    ////////////////////////////////////////////////////////////////////////////
+
+    std::shared_ptr<RoutingTable const> withPlan(
+        uint64_t planVersion,
+        std::unordered_map<CollectionID,
+                           std::shared_ptr<std::vector<std::string>>> const&
+            shards,
+        std::unordered_map<CollectionID,
+                           std::shared_ptr<std::vector<std::string>>> const&
+            shardKeys) const;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief a copy of the table with the shard leaders and followers from
+    /// Current. the collection part is shared with the table
+    ////////////////////////////////////////////////////////////////////////////
+
+    std::shared_ptr<RoutingTable const> withCurrent(
+        uint64_t currentVersion, ShardServerMap const& shardServers) const;
+  };
+
  private:
 
   //////////////////////////////////////////////////////////////////////////////
@@ -554,7 +611,9 @@ class ClusterInfo {
     Mutex mutex;
     std::atomic<uint64_t> wantedVersion;
     std::atomic<uint64_t> doneVersion;
-    arangodb::basics::ReadWriteLock lock;
+    // read by every request that needs cluster information, written only
+    // when a new version is loaded from the agency
+    arangodb::basics::ReadMostlyLock lock;
 
     ProtectionData() : isValid(false), wantedVersion(0), doneVersion(0) {}
   };
@@ -610,6 +669,33 @@ class ClusterInfo {
   std::unordered_map<ShardID, std::shared_ptr<std::vector<ServerID>>>
       _shardIds;  // from Current/Collections/
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief return the current routing table snapshot, never a nullptr
+  //////////////////////////////////////////////////////////////////////////////
+
+  std::shared_ptr<RoutingTable const> routingTable() const {
+    return std::atomic_load(&_routingTable);
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief publish a new routing table built from _shards and _shardKeys.
+  /// must be called with the write lock of _planProt held
+  //////////////////////////////////////////////////////////////////////////////
+
+  void publishPlanRouting(uint64_t planVersion);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief publish a new routing table built from _shardIds. must be
+  /// called with the write lock of _currentProt held
+  //////////////////////////////////////////////////////////////////////////////
+
+  void publishCurrentRouting(uint64_t currentVersion);
+
+  std::shared_ptr<RoutingTable const> _routingTable;
+
+  // serializes publishers of the routing table, readers do not lock
+  Mutex _routingTableLock;
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief uniqid sequence
   //////////////////////////////////////////////////////////////////////////////
@@ -22,6 +22,9 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "ClusterMethods.h"
+#include "Basics/ConditionLocker.h"
+#include "Basics/ConditionVariable.h"
+#include "Basics/MutexLocker.h"
 #include "Basics/conversions.h"
 #include "Basics/StaticStrings.h"
 #include "Basics/StringRef.h"
@@ -29,11 +32,17 @@
 #include "Basics/tri-strings.h"
 #include "Basics/VelocyPackHelper.h"
 #include "Cluster/ClusterComm.h"
+#include "Cluster/ClusterFeature.h"
 #include "Cluster/ClusterInfo.h"
 #include "Indexes/Index.h"
+#include "Random/RandomGenerator.h"
+#include "Scheduler/JobGuard.h"
+#include "Scheduler/SchedulerFeature.h"
 #include "Utils/CollectionNameResolver.h"
 #include "Utils/OperationOptions.h"
+#include "VocBase/KeyGenerator.h"
 #include "VocBase/LogicalCollection.h"
+#include "VocBase/PhysicalCollection.h"
 #include "VocBase/Traverser.h"
 #include "VocBase/ticks.h"
 
@@ -45,6 +54,7 @@
 #include <velocypack/velocypack-aliases.h>
 
 #include <algorithm>
+#include <chrono>
 #include <vector>
 
 using namespace arangodb::basics;
@@ -378,9 +388,11 @@ static int distributeBabyOnShards(
 
     VPackSlice keySlice = node.get(StaticStrings::KeyString);
     if (keySlice.isNone()) {
-      // The user did not specify a key, let's create one:
+      // The user did not specify a key, let's create one. the id comes
+      // from the block this coordinator has leased from the agency, the
+      // collection's key generator determines the format of the key
       uint64_t uid = ci->uniqid();
-      _key = arangodb::basics::StringUtils::itoa(uid);
+      _key = collinfo->getPhysical()->keyGenerator()->generate(uid);
     } else {
       userSpecifiedKey = true;
     }
@@ -634,6 +646,50 @@ int revisionOnCoordinator(std::string const& dbname,
                               // the DBserver could have reported an error.
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the counts and figures of sharded collections most recently
+/// fetched by this coordinator. writes through this coordinator invalidate
+/// them, writes through other coordinators become visible after the ttl
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+struct CachedCounts {
+  CachedCounts() : generation(0), countsStamp(0.0), figuresStamp(0.0) {}
+
+  /// @brief increased by every invalidation, so that fetches that were
+  /// started before one do not store outdated values
+  uint64_t generation;
+
+  double countsStamp;
+  std::vector<std::pair<std::string, uint64_t>> counts;
+
+  double figuresStamp;
+  std::shared_ptr<VPackBuilder> figures;
+};
+
+arangodb::Mutex cachedCountsLock;
+/// @brief the cached values, by database name and collection id
+std::unordered_map<std::string, CachedCounts> cachedCounts;
+
+std::string cachedCountsKey(std::string const& dbname,
+                            std::shared_ptr<LogicalCollection> const& collinfo) {
+  return dbname + "/" + collinfo->cid_as_string();
+}
+
+/// @brief invalidate the cached values of a collection
+void invalidateCachedCounts(std::string const& key) {
+  MUTEX_LOCKER(locker, cachedCountsLock);
+  auto it = cachedCounts.find(key);
+  if (it != cachedCounts.end()) {
+    (*it).second.generation++;
+    (*it).second.countsStamp = 0.0;
+    (*it).second.counts.clear();
+    (*it).second.figuresStamp = 0.0;
+    (*it).second.figures.reset();
+  }
+}
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief returns figures for a sharded collection
 ////////////////////////////////////////////////////////////////////////////////
@@ -657,6 +713,24 @@ int figuresOnCoordinator(std::string const& dbname, std::string const& collname,
   }
   TRI_ASSERT(collinfo != nullptr);
 
+  std::string const cacheKey = cachedCountsKey(dbname, collinfo);
+  double const ttl = ClusterFeature::countCacheTtl();
+  uint64_t generation;
+  {
+    MUTEX_LOCKER(locker, cachedCountsLock);
+    auto& cached = cachedCounts[cacheKey];
+    if (cached.figures != nullptr &&
+        cached.figuresStamp + ttl > TRI_microtime()) {
+      recursiveAdd(cached.figures->slice(), result);
+      return TRI_ERROR_NO_ERROR;
+    }
+    generation = cached.generation;
+  }
+
+  auto total = std::make_shared<VPackBuilder>();
+  total->openObject();
+  total->close();
+
   // If we get here, the sharding attributes are not only _key, therefore
   // we have to contact everybody:
   auto shards = collinfo->shardIds();
@@ -687,7 +761,7 @@ int figuresOnCoordinator(std::string const& dbname, std::string const& collname,
           VPackSlice figures = answer.get("figures");
           if (figures.isObject()) {
             // add to the total
-            recursiveAdd(figures, result);
+            recursiveAdd(figures, total);
           }
           nrok++;
         }
@@ -699,16 +773,30 @@ int figuresOnCoordinator(std::string const& dbname, std::string const& collname,
     return TRI_ERROR_INTERNAL;
   }
 
+  recursiveAdd(total->slice(), result);
+
+  if (ttl > 0.0) {
+    MUTEX_LOCKER(locker, cachedCountsLock);
+    auto& cached = cachedCounts[cacheKey];
+    if (cached.generation == generation) {
+      cached.figuresStamp = TRI_microtime();
+      cached.figures = total;
+    }
+  }
+
   return TRI_ERROR_NO_ERROR;  // the cluster operation was OK, however,
                               // the DBserver could have reported an error.
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief counts number of documents in a coordinator, by shard
+/// @brief counts number of documents in a coordinator, by shard. unless
+/// an exact count is requested, counts fetched less than the count cache
+/// ttl ago are returned
 ////////////////////////////////////////////////////////////////////////////////
 
 int countOnCoordinator(std::string const& dbname, std::string const& collname,
-                       std::vector<std::pair<std::string, uint64_t>>& result) {
+                       std::vector<std::pair<std::string, uint64_t>>& result,
+                       bool exact) {
   // Set a few variables needed for our work:
   ClusterInfo* ci = ClusterInfo::instance();
   auto cc = ClusterComm::instance();
@@ -728,6 +816,20 @@ int countOnCoordinator(std::string const& dbname, std::string const& collname,
   }
   TRI_ASSERT(collinfo != nullptr);
 
+  std::string const cacheKey = cachedCountsKey(dbname, collinfo);
+  double const ttl = ClusterFeature::countCacheTtl();
+  uint64_t generation;
+  {
+    MUTEX_LOCKER(locker, cachedCountsLock);
+    auto& cached = cachedCounts[cacheKey];
+    if (!exact && !cached.counts.empty() &&
+        cached.countsStamp + ttl > TRI_microtime()) {
+      result = cached.counts;
+      return TRI_ERROR_NO_ERROR;
+    }
+    generation = cached.generation;
+  }
+
   auto shards = collinfo->shardIds();
   std::vector<ClusterCommRequest> requests;
   auto body = std::make_shared<std::string>();
@@ -762,6 +864,275 @@ int countOnCoordinator(std::string const& dbname, std::string const& collname,
     }
   }
 
+  if (ttl > 0.0 && !result.empty()) {
+    MUTEX_LOCKER(locker, cachedCountsLock);
+    auto& cached = cachedCounts[cacheKey];
+    if (cached.generation == generation) {
+      cached.countsStamp = TRI_microtime();
+      cached.counts = result;
+    }
+  }
+
+  return TRI_ERROR_NO_ERROR;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief invalidates the cached counts and figures of a collection
+////////////////////////////////////////////////////////////////////////////////
+
+void invalidateCountOnCoordinator(std::string const& dbname,
+                                  std::string const& collname) {
+  std::shared_ptr<LogicalCollection> collinfo;
+  try {
+    collinfo = ClusterInfo::instance()->getCollection(dbname, collname);
+  } catch (...) {
+    // the collection is gone, and so are its counts
+    return;
+  }
+  invalidateCachedCounts(cachedCountsKey(dbname, collinfo));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief a batch of single-document inserts into the same shard, sent to
+/// the DB server as one array insert
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+struct InsertBatch {
+  InsertBatch(ShardID const& shard, std::string const& url)
+      : shard(shard),
+        url(url),
+        numberOfDocuments(0),
+        sent(false),
+        done(false),
+        commError(TRI_ERROR_NO_ERROR),
+        responseCode(rest::ResponseCode::SERVER_ERROR) {
+    body.push_back('[');
+  }
+
+  ShardID const shard;
+  std::string const url;
+
+  /// @brief the request body, a JSON array of all documents
+  std::string body;
+  size_t numberOfDocuments;
+
+  /// @brief sends the batch once the window has passed. the timer and
+  /// sent are protected by openInsertBatchesLock
+  std::unique_ptr<boost::asio::steady_timer> timer;
+  bool sent;
+
+  /// @brief signalled once the results are available
+  arangodb::basics::ConditionVariable condition;
+  bool done;
+
+  int commError;
+  rest::ResponseCode responseCode;
+  std::shared_ptr<VPackBuilder> result;
+};
+
+/// @brief maximum number of documents in one batch
+size_t const MaxInsertBatchSize = 1000;
+
+/// @brief the batches still accepting documents, by request url
+arangodb::Mutex openInsertBatchesLock;
+std::unordered_map<std::string, std::shared_ptr<InsertBatch>>
+    openInsertBatches;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief closes a batch of inserts, sends it to the DB server and wakes up
+/// all inserters waiting for the result. does nothing if the batch has been
+/// sent already
+////////////////////////////////////////////////////////////////////////////////
+
+static void sendInsertBatch(std::shared_ptr<InsertBatch> const& batch) {
+  {
+    // no more documents can be added to the batch after this
+    MUTEX_LOCKER(locker, openInsertBatchesLock);
+    if (batch->sent) {
+      return;
+    }
+    batch->sent = true;
+
+    auto it = openInsertBatches.find(batch->url);
+    if (it != openInsertBatches.end() && (*it).second == batch) {
+      openInsertBatches.erase(it);
+    }
+  }
+
+  int commError = TRI_ERROR_NO_ERROR;
+  rest::ResponseCode code = rest::ResponseCode::SERVER_ERROR;
+  std::shared_ptr<VPackBuilder> result;
+
+  try {
+    auto cc = ClusterComm::instance();
+    if (cc == nullptr) {
+      // nullptr happens only during controlled shutdown
+      THROW_ARANGO_EXCEPTION(TRI_ERROR_SHUTTING_DOWN);
+    }
+
+    batch->body.push_back(']');
+
+    std::vector<ClusterCommRequest> requests;
+    requests.emplace_back("shard:" + batch->shard,
+                          arangodb::rest::RequestType::POST, batch->url,
+                          std::make_shared<std::string>(batch->body));
+
+    size_t nrDone = 0;
+    cc->performRequests(requests, CL_DEFAULT_TIMEOUT, nrDone,
+                        Logger::COMMUNICATION);
+
+    auto& res = requests[0].result;
+    commError = handleGeneralCommErrors(&res);
+    if (commError == TRI_ERROR_NO_ERROR) {
+      TRI_ASSERT(res.answer != nullptr);
+      code = res.answer_code;
+      result = res.answer->toVelocyPackBuilderPtr();
+    }
+  } catch (arangodb::basics::Exception const& ex) {
+    commError = ex.code();
+  } catch (...) {
+    commError = TRI_ERROR_INTERNAL;
+  }
+
+  CONDITION_LOCKER(guard, batch->condition);
+  batch->commError = commError;
+  batch->responseCode = code;
+  batch->result = result;
+  batch->done = true;
+  guard.broadcast();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief inserts a single document into a shard. inserts into the same
+/// shard with the same options that arrive within the configured batch
+/// window are sent to the DB server as one array insert. the first
+/// inserter of a batch starts a timer on the scheduler, which sends the
+/// batch when the window has passed, or as soon as the batch is full. all
+/// inserters wait for the result
+////////////////////////////////////////////////////////////////////////////////
+
+static int insertDocumentBatched(ShardID const& shard, std::string const& url,
+                                 std::string const& document,
+                                 uint64_t window,
+                                 arangodb::rest::ResponseCode& responseCode,
+                                 std::shared_ptr<VPackBuilder>& resultBody) {
+  auto scheduler = SchedulerFeature::SCHEDULER;
+  std::shared_ptr<InsertBatch> batch;
+  size_t position;
+  bool sendNow = false;
+
+  {
+    MUTEX_LOCKER(locker, openInsertBatchesLock);
+    auto it = openInsertBatches.find(url);
+
+    if (it == openInsertBatches.end()) {
+      batch = std::make_shared<InsertBatch>(shard, url);
+      openInsertBatches.emplace(url, batch);
+
+      if (scheduler != nullptr) {
+        batch->timer.reset(new boost::asio::steady_timer(
+            *scheduler->ioService(), std::chrono::microseconds(window)));
+        // also called when the timer is cancelled because the batch is full
+        batch->timer->async_wait(
+            [batch](boost::system::error_code const&) {
+              sendInsertBatch(batch);
+            });
+      } else {
+        // without a scheduler, e.g. during shutdown, there is no window
+        sendNow = true;
+      }
+    } else {
+      batch = (*it).second;
+    }
+
+    position = batch->numberOfDocuments++;
+    if (position > 0) {
+      batch->body.push_back(',');
+    }
+    batch->body.append(document);
+
+    if (batch->numberOfDocuments >= MaxInsertBatchSize) {
+      // the batch is full. send it right away, and start a new one with
+      // the next insert
+      openInsertBatches.erase(url);
+      if (batch->timer != nullptr) {
+        boost::system::error_code ec;
+        batch->timer->cancel(ec);
+      }
+    }
+  }
+
+  if (sendNow) {
+    sendInsertBatch(batch);
+  }
+
+  {
+    std::unique_ptr<JobGuard> jobGuard;
+    if (scheduler != nullptr) {
+      // we are going to wait for another scheduler thread
+      jobGuard.reset(new JobGuard(scheduler));
+      jobGuard->block();
+    }
+
+    CONDITION_LOCKER(guard, batch->condition);
+    while (!batch->done) {
+      if (!guard.wait(1000000) && scheduler != nullptr &&
+          scheduler->ioService()->stopped()) {
+        // the timer will not fire anymore, as the server is shutting down
+        guard.unlock();
+        sendInsertBatch(batch);
+        guard.lock();
+      }
+    }
+  }
+
+  if (batch->commError != TRI_ERROR_NO_ERROR) {
+    return batch->commError;
+  }
+
+  VPackSlice result = batch->result->slice();
+
+  if ((batch->responseCode != rest::ResponseCode::CREATED &&
+       batch->responseCode != rest::ResponseCode::ACCEPTED) ||
+      !result.isArray() || result.length() != batch->numberOfDocuments) {
+    // the whole batch failed, e.g. because the shard does not exist
+    responseCode = batch->responseCode;
+    resultBody = batch->result;
+    return TRI_ERROR_NO_ERROR;
+  }
+
+  // turn the result for our document into the answer of a single insert
+  VPackSlice item = result.at(position);
+  auto builder = std::make_shared<VPackBuilder>();
+
+  if (item.isObject() && item.get("error").isTrue()) {
+    int errorNum = arangodb::basics::VelocyPackHelper::getNumericValue<int>(
+        item, "errorNum", TRI_ERROR_INTERNAL);
+
+    if (errorNum == TRI_ERROR_ARANGO_UNIQUE_CONSTRAINT_VIOLATED) {
+      responseCode = rest::ResponseCode::CONFLICT;
+    } else if (errorNum == TRI_ERROR_ARANGO_CONFLICT) {
+      responseCode = rest::ResponseCode::PRECONDITION_FAILED;
+    } else {
+      responseCode = rest::ResponseCode::BAD;
+    }
+
+    builder->openObject();
+    builder->add("error", VPackValue(true));
+    builder->add("errorNum", VPackValue(errorNum));
+    builder->add("errorMessage",
+                 VPackValue(arangodb::basics::VelocyPackHelper::getStringValue(
+                     item, "errorMessage", TRI_errno_string(errorNum))));
+    builder->add("code", VPackValue(static_cast<int>(responseCode)));
+    builder->close();
+  } else {
+    responseCode = batch->responseCode;
+    builder->add(item);
+  }
+
+  resultBody = builder;
   return TRI_ERROR_NO_ERROR;
 }
 
@@ -799,6 +1170,8 @@ int createDocumentOnCoordinator(
     return TRI_ERROR_ARANGO_COLLECTION_NOT_FOUND;
   }
   TRI_ASSERT(collinfo != nullptr);
+  // the counts and figures are outdated once the write is done
+  TRI_DEFER(invalidateCachedCounts(cachedCountsKey(dbname, collinfo)));
 
   std::string const collid = collinfo->cid_as_string();
   std::unordered_map<
@@ -838,6 +1211,10 @@ int createDocumentOnCoordinator(
   // Now prepare the requests:
   std::vector<ClusterCommRequest> requests;
   auto body = std::make_shared<std::string>();
+  static ClusterFeature const* cluster =
+      application_features::ApplicationServer::getFeature<ClusterFeature>(
+          "Cluster");
+  uint64_t const batchWindow = cluster->insertBatchWindow();
 
   for (auto const& it : shardMap) {
     if (!useMultiple) {
@@ -853,6 +1230,12 @@ int createDocumentOnCoordinator(
         reqBuilder.close();
         body = std::make_shared<std::string>(reqBuilder.slice().toJson());
       }
+
+      if (batchWindow > 0) {
+        return insertDocumentBatched(
+            it.first, baseUrl + StringUtils::urlEncode(it.first) + optsUrlPart,
+            *body, batchWindow, responseCode, resultBody);
+      }
     } else {
       reqBuilder.clear();
       reqBuilder.openArray();
@@ -938,6 +1321,8 @@ int deleteDocumentOnCoordinator(
     return TRI_ERROR_ARANGO_COLLECTION_NOT_FOUND;
   }
   TRI_ASSERT(collinfo != nullptr);
+  // the counts and figures are outdated once the write is done
+  TRI_DEFER(invalidateCachedCounts(cachedCountsKey(dbname, collinfo)));
   bool useDefaultSharding = collinfo->usesDefaultShardKeys();
   std::string collid = collinfo->cid_as_string();
   bool useMultiple = slice.isArray();
@@ -1171,6 +1556,8 @@ int truncateCollectionOnCoordinator(std::string const& dbname,
     return TRI_ERROR_ARANGO_COLLECTION_NOT_FOUND;
   }
   TRI_ASSERT(collinfo != nullptr);
+  // the counts and figures are outdated once the write is done
+  TRI_DEFER(invalidateCachedCounts(cachedCountsKey(dbname, collinfo)));
 
   // Some stuff to prepare cluster-intern requests:
   // We have to contact everybody:
@@ -1204,6 +1591,116 @@ int truncateCollectionOnCoordinator(std::string const& dbname,
   return TRI_ERROR_NO_ERROR;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief choose where to send a read for a shard. with allowDirtyReads,
+/// the leader and its in-sync followers are picked at random, so that the
+/// read load is spread over all replicas. a follower gets the dirty read
+/// headers, so that it can refuse the read if it is too stale
+////////////////////////////////////////////////////////////////////////////////
+
+static void setReadDestination(ClusterInfo* ci, ClusterCommRequest& req,
+                               ShardID const& shard,
+                               OperationOptions const& options) {
+  if (!options.allowDirtyReads) {
+    return;
+  }
+
+  auto servers = ci->getResponsibleServer(shard);
+
+  if (servers->size() <= 1) {
+    return;
+  }
+
+  uint32_t pos = RandomGenerator::interval(
+      static_cast<uint32_t>(servers->size() - 1));
+
+  if (pos == 0) {
+    // the leader
+    return;
+  }
+
+  req.destination = "server:" + (*servers)[pos];
+
+  if (req.headerFields == nullptr) {
+    req.headerFields =
+        std::make_unique<std::unordered_map<std::string, std::string>>();
+  }
+  (*req.headerFields)[StaticStrings::AllowDirtyReads] = "true";
+  if (options.maxStaleness > 0.0) {
+    (*req.headerFields)[StaticStrings::MaxStaleness] =
+        std::to_string(options.maxStaleness);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether a follower refused a dirty read
+////////////////////////////////////////////////////////////////////////////////
+
+static bool isRefusedDirtyRead(ClusterCommResult const& res) {
+  if (res.status != CL_COMM_RECEIVED || res.answer == nullptr ||
+      res.answer_code != rest::ResponseCode::SERVER_ERROR) {
+    return false;
+  }
+
+  try {
+    auto body = res.answer->toVelocyPackBuilderPtr();
+    VPackSlice s = body->slice();
+    return s.isObject() &&
+           VelocyPackHelper::getNumericValue<int>(s, "errorNum", 0) ==
+               TRI_ERROR_CLUSTER_AQL_COLLECTION_OUT_OF_SYNC;
+  } catch (...) {
+  }
+  return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief send the reads that followers refused to the leaders instead.
+/// shards holds the shard of each request, headers the headers to send
+/// along without the dirty read headers
+////////////////////////////////////////////////////////////////////////////////
+
+static void resendRefusedDirtyReads(
+    ClusterComm* cc, std::vector<ClusterCommRequest>& requests,
+    std::vector<ShardID> const& shards,
+    std::unordered_map<std::string, std::string> const& headers) {
+  TRI_ASSERT(requests.size() == shards.size());
+
+  std::vector<size_t> refused;
+  for (size_t i = 0; i < requests.size(); ++i) {
+    if (requests[i].destination.compare(0, 7, "server:") == 0 &&
+        isRefusedDirtyRead(requests[i].result)) {
+      refused.emplace_back(i);
+    }
+  }
+
+  if (refused.empty()) {
+    return;
+  }
+
+  std::vector<ClusterCommRequest> retries;
+  retries.reserve(refused.size());
+
+  for (auto const& i : refused) {
+    retries.emplace_back("shard:" + shards[i], requests[i].requestType,
+                         requests[i].path, requests[i].body);
+    auto headersCopy =
+        std::make_unique<std::unordered_map<std::string, std::string>>(
+            headers);
+    retries.back().setHeaders(headersCopy);
+  }
+
+  size_t nrDone = 0;
+  cc->performRequests(retries, CL_DEFAULT_TIMEOUT, nrDone,
+                      Logger::COMMUNICATION);
+
+  for (size_t k = 0; k < refused.size(); ++k) {
+    auto& req = requests[refused[k]];
+    req.destination = retries[k].destination;
+    req.result = retries[k].result;
+    req.done = retries[k].done;
+  }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief get a document in a coordinator
 ////////////////////////////////////////////////////////////////////////////////
@@ -1298,6 +1795,8 @@ int getDocumentOnCoordinator(
 
     // Now prepare the requests:
     std::vector<ClusterCommRequest> requests;
+    std::vector<ShardID> requestShards;
+    std::unordered_map<std::string, std::string> baseHeaders;
     auto body = std::make_shared<std::string>();
     for (auto const& it : shardMap) {
       if (!useMultiple) {
@@ -1306,6 +1805,7 @@ int getDocumentOnCoordinator(
           headers->emplace("if-match",
                            slice.get(StaticStrings::RevString).copyString());
         }
+        baseHeaders = *headers;
 
         VPackSlice keySlice = slice;
         if (slice.isObject()) {
@@ -1320,6 +1820,7 @@ int getDocumentOnCoordinator(
                 optsUrlPart,
             body);
         requests[0].setHeaders(headers);
+        setReadDestination(ci, requests[0], it.first, options);
       } else {
         reqBuilder.clear();
         reqBuilder.openArray();
@@ -1332,13 +1833,19 @@ int getDocumentOnCoordinator(
         requests.emplace_back(
             "shard:" + it.first, reqType,
             baseUrl + StringUtils::urlEncode(it.first) + optsUrlPart, body);
+        setReadDestination(ci, requests.back(), it.first, options);
       }
+      requestShards.emplace_back(it.first);
     }
 
     // Perform the requests
     size_t nrDone = 0;
     cc->performRequests(requests, CL_DEFAULT_TIMEOUT, nrDone, Logger::COMMUNICATION);
 
+    if (options.allowDirtyReads) {
+      resendRefusedDirtyReads(cc.get(), requests, requestShards, baseHeaders);
+    }
+
     // Now listen to the results:
     if (!useMultiple) {
       TRI_ASSERT(requests.size() == 1);
@@ -1394,6 +1901,7 @@ int getDocumentOnCoordinator(
           std::make_unique<std::unordered_map<std::string, std::string>>(
               *headers);
       req.setHeaders(headersCopy);
+      setReadDestination(ci, req, shard, options);
       requests.emplace_back(std::move(req));
     }
   } else {
@@ -1402,6 +1910,7 @@ int getDocumentOnCoordinator(
       requests.emplace_back(
           "shard:" + shard, reqType,
           baseUrl + StringUtils::urlEncode(shard) + optsUrlPart, body);
+      setReadDestination(ci, requests.back(), shard, options);
     }
   }
 
@@ -1409,6 +1918,10 @@ int getDocumentOnCoordinator(
   size_t nrDone = 0;
   cc->performRequests(requests, CL_DEFAULT_TIMEOUT, nrDone, Logger::COMMUNICATION);
 
+  if (options.allowDirtyReads) {
+    resendRefusedDirtyReads(cc.get(), requests, *shardList, *headers);
+  }
+
   // Now listen to the results:
   if (!useMultiple) {
     // Only one can answer, we react a bit differently
@@ -1491,7 +2004,9 @@ int fetchEdgesFromEngines(
     std::vector<std::shared_ptr<VPackBuilder>>& datalake,
     VPackBuilder& builder,
     size_t& filtered,
-    size_t& read) {
+    size_t& read,
+    std::unordered_map<VPackSlice, std::shared_ptr<VPackBuffer<uint8_t>>>*
+        vertices) {
   auto cc = ClusterComm::instance();
   if (cc == nullptr) {
     // nullptr happens only during controlled shutdown
@@ -1507,6 +2022,9 @@ int fetchEdgesFromEngines(
   builder.openObject();
   builder.add("depth", VPackValue(depth));
   builder.add("keys", vertexId);
+  if (vertices != nullptr) {
+    builder.add("vertices", VPackValue(true));
+  }
   builder.close();
 
   std::string const url =
@@ -1560,10 +2078,34 @@ int fetchEdgesFromEngines(
     if (!allCached) {
       datalake.emplace_back(resBody);
     }
+    if (vertices != nullptr) {
+      addVerticesFromEngine(resSlice.get("vertices"), *vertices);
+    }
   }
   return TRI_ERROR_NO_ERROR;
 }
 
+/// @brief add the vertex documents returned by a TraverserEngine
+///        together with edges to the vertex cache
+
+void addVerticesFromEngine(
+    VPackSlice docs,
+    std::unordered_map<VPackSlice, std::shared_ptr<VPackBuffer<uint8_t>>>&
+        vertices) {
+  if (!docs.isObject()) {
+    return;
+  }
+  for (auto const& pair : VPackObjectIterator(docs)) {
+    if (vertices.find(pair.key) != vertices.end()) {
+      continue;
+    }
+    auto val = VPackBuilder::clone(pair.value);
+    VPackSlice id = val.slice().get(StaticStrings::IdString);
+    TRI_ASSERT(id.isString());
+    vertices.emplace(id, val.steal());
+  }
+}
+
 /// @brief fetch vertices from TraverserEngines
 ///        Contacts all TraverserEngines placed
 ///        on the DBServers for the given list
@@ -1806,6 +2348,8 @@ int modifyDocumentOnCoordinator(
   // First determine the collection ID from the name:
   std::shared_ptr<LogicalCollection> collinfo =
       ci->getCollection(dbname, collname);
+  // the counts and figures are outdated once the write is done
+  TRI_DEFER(invalidateCachedCounts(cachedCountsKey(dbname, collinfo)));
   std::string collid = collinfo->cid_as_string();
 
   // We have a fast path and a slow path. The fast path only asks one shard
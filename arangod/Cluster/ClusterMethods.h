@@ -76,11 +76,21 @@ int figuresOnCoordinator(std::string const& dbname, std::string const& collname,
                          std::shared_ptr<arangodb::velocypack::Builder>&);
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief counts number of documents in a coordinator, by shard
+/// @brief counts number of documents in a coordinator, by shard. unless
+/// an exact count is requested, counts fetched less than the count cache
+/// ttl ago are returned
 ////////////////////////////////////////////////////////////////////////////////
 
 int countOnCoordinator(std::string const& dbname, std::string const& collname,
-                       std::vector<std::pair<std::string, uint64_t>>& result);
+                       std::vector<std::pair<std::string, uint64_t>>& result,
+                       bool exact = false);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief invalidates the cached counts and figures of a collection
+////////////////////////////////////////////////////////////////////////////////
+
+void invalidateCountOnCoordinator(std::string const& dbname,
+                                  std::string const& collname);
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief creates a document in a coordinator
@@ -126,6 +136,11 @@ int getDocumentOnCoordinator(
 ///        point to content inside of this lake
 ///        only and do not run out of scope unless
 ///        the lake is cleared.
+///        If a vertex cache is given, the DBServers
+///        also return the vertices on the other side
+///        of the edges that are stored on them. These
+///        are inserted into the cache, unless they
+///        are already cached.
 
 int fetchEdgesFromEngines(
     std::string const&,
@@ -135,7 +150,20 @@ int fetchEdgesFromEngines(
                        arangodb::velocypack::Slice>&,
     std::vector<arangodb::velocypack::Slice>&,
     std::vector<std::shared_ptr<arangodb::velocypack::Builder>>&,
-    arangodb::velocypack::Builder&, size_t&, size_t&);
+    arangodb::velocypack::Builder&, size_t&, size_t&,
+    std::unordered_map<arangodb::velocypack::Slice,
+                       std::shared_ptr<arangodb::velocypack::Buffer<uint8_t>>>*
+        vertices = nullptr);
+
+/// @brief add the vertex documents returned by a TraverserEngine
+///        together with edges to the vertex cache. The cache keys
+///        point into the copied documents. Vertices that are already
+///        cached are left alone.
+
+void addVerticesFromEngine(
+    arangodb::velocypack::Slice,
+    std::unordered_map<arangodb::velocypack::Slice,
+                       std::shared_ptr<arangodb::velocypack::Buffer<uint8_t>>>&);
 
 /// @brief fetch vertices from TraverserEngines
 ///        Contacts all TraverserEngines placed
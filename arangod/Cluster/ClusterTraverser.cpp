@@ -39,7 +39,10 @@ ClusterTraverser::ClusterTraverser(
     ManagedDocumentResult* mmdr,
     std::unordered_map<ServerID, traverser::TraverserEngineID> const* engines,
     std::string const& dbname, transaction::Methods* trx)
-    : Traverser(opts, trx, mmdr), _dbname(dbname), _engines(engines) {
+    : Traverser(opts, trx, mmdr),
+      _dbname(dbname),
+      _engines(engines),
+      _fetchVerticesWithEdges(false) {
   _opts->linkTraverser(this);
 }
 
@@ -69,8 +72,14 @@ void ClusterTraverser::setStartVertex(std::string const& id) {
 
   _vertexGetter->reset(idSlice);
   if (_opts->useBreadthFirst) {
-    _enumerator.reset(
-        new arangodb::traverser::BreadthFirstEnumerator(this, idSlice, _opts));
+    if (_canUseOptimizedNeighbors) {
+      // fetches the edges of a whole depth with one request per DBServer
+      _enumerator.reset(
+          new arangodb::traverser::NeighborsEnumerator(this, idSlice, _opts));
+    } else {
+      _enumerator.reset(new arangodb::traverser::BreadthFirstEnumerator(
+          this, idSlice, _opts));
+    }
   } else {
     _enumerator.reset(
         new arangodb::traverser::DepthFirstEnumerator(this, idSlice, _opts));
@@ -111,6 +120,50 @@ void ClusterTraverser::fetchVertices() {
   _verticesToFetch.clear();
 }
 
+std::unordered_map<VPackSlice, std::shared_ptr<VPackBuffer<uint8_t>>>*
+ClusterTraverser::vertexCacheForEdges(uint64_t depth) {
+  // the vertices on the other side of the edges are checked against the
+  // filter conditions of the next depth
+  if (_fetchVerticesWithEdges || _opts->vertexHasFilter(depth + 1)) {
+    return &_vertices;
+  }
+  return nullptr;
+}
+
+void ClusterTraverser::fetchEdgesBatch(
+    std::vector<VPackSlice> const& vertices, uint64_t depth,
+    std::function<void(VPackSlice, VPackSlice)> const& callback) {
+  transaction::BuilderLeaser keys(_trx);
+  keys->openArray();
+  for (auto const& v : vertices) {
+    TRI_ASSERT(v.isString());
+    keys->add(v);
+  }
+  keys->close();
+
+  std::vector<VPackSlice> edges;
+  transaction::BuilderLeaser leased(_trx);
+  int res = fetchEdgesFromEngines(_dbname, _engines, keys->slice(), depth,
+                                  _edges, edges, _datalake, *(leased.get()),
+                                  _filteredPaths, _readDocuments,
+                                  vertexCacheForEdges(depth));
+  if (res != TRI_ERROR_NO_ERROR) {
+    THROW_ARANGO_EXCEPTION(res);
+  }
+
+  // the engines do not tell which vertex an edge was found for, but it is
+  // the side that was requested
+  std::unordered_set<VPackSlice> requested(vertices.begin(), vertices.end());
+  for (auto const& e : edges) {
+    VPackSlice from = transaction::helpers::extractFromFromDocument(e);
+    if (requested.find(from) != requested.end()) {
+      callback(e, from);
+    } else {
+      callback(e, transaction::helpers::extractToFromDocument(e));
+    }
+  }
+}
+
 aql::AqlValue ClusterTraverser::fetchVertexData(VPackSlice idString) {
   TRI_ASSERT(idString.isString());
   auto cached = _vertices.find(idString);
@@ -56,6 +56,18 @@ class ClusterTraverser final : public Traverser {
 
   void setStartVertex(std::string const& id) override;
 
+  /// @brief Request the vertex documents together with the edges from the
+  ///        DBServers. Only worth it if the vertex data is used.
+  void fetchVerticesWithEdges(bool value) { _fetchVerticesWithEdges = value; }
+
+  /// @brief Fetch the edges of all given vertices with one request per
+  ///        DBServer and call the callback with each edge and the vertex
+  ///        it was found for.
+  void fetchEdgesBatch(
+      std::vector<arangodb::velocypack::Slice> const&, uint64_t,
+      std::function<void(arangodb::velocypack::Slice,
+                         arangodb::velocypack::Slice)> const&);
+
  protected:
   /// @brief Function to load the other sides vertex of an edge
   ///        Returns true if the vertex passes filtering conditions
@@ -100,6 +112,12 @@ class ClusterTraverser final : public Traverser {
 
   void fetchVertices();
 
+  /// @brief the vertex cache to fill with the edges of the given depth,
+  ///        or a nullptr if the vertices are not requested with the edges
+  std::unordered_map<arangodb::velocypack::Slice,
+                     std::shared_ptr<arangodb::velocypack::Buffer<uint8_t>>>*
+  vertexCacheForEdges(uint64_t depth);
+
   std::unordered_map<arangodb::velocypack::Slice, arangodb::velocypack::Slice>
       _edges;
 
@@ -115,6 +133,8 @@ class ClusterTraverser final : public Traverser {
 
   std::vector<std::shared_ptr<arangodb::velocypack::Builder>> _datalake;
 
+  bool _fetchVerticesWithEdges;
+
 };
 
 }  // traverser
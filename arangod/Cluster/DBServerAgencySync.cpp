@@ -23,22 +23,92 @@
 
 #include "DBServerAgencySync.h"
 
+#include "Agency/AgencyComm.h"
 #include "Basics/MutexLocker.h"
+#include "Basics/ReadLocker.h"
+#include "Basics/Result.h"
+#include "Basics/StringUtils.h"
+#include "Basics/VelocyPackHelper.h"
+#include "Basics/fasthash.h"
+#include "Cluster/ClusterFeature.h"
 #include "Cluster/ClusterInfo.h"
+#include "Cluster/FollowerInfo.h"
 #include "Cluster/HeartbeatThread.h"
+#include "Cluster/ServerState.h"
+#include "Indexes/Index.h"
 #include "Logger/Logger.h"
 #include "RestServer/DatabaseFeature.h"
+#include "Statistics/MetricsRegistry.h"
+#include "Statistics/figures.h"
+#include "Transaction/StandaloneContext.h"
+#include "Utils/SingleCollectionTransaction.h"
 #include "V8/v8-conv.h"
 #include "V8/v8-utils.h"
 #include "V8/v8-vpack.h"
 #include "V8Server/V8Context.h"
 #include "V8Server/V8DealerFeature.h"
+#include "VocBase/LogicalCollection.h"
 #include "VocBase/vocbase.h"
 
 using namespace arangodb;
 using namespace arangodb::application_features;
+using namespace arangodb::basics;
 using namespace arangodb::rest;
 
+namespace {
+/// @brief interval in seconds after which all collections are compared
+/// again, even if their Plan and Current entries did not change, so that
+/// local changes are repaired eventually
+static double const FullSyncInterval = 60.0;
+
+/// @brief state of the plan synchronization, kept between runs. runs are
+/// serialized by the heartbeat thread, the lock protects the figures
+/// against concurrent readers of the metrics
+struct SyncState {
+  Mutex lock;
+
+  /// @brief fingerprints of the Plan and Current entries of the collections
+  /// that were synchronized without errors, by "<database>/<planId>"
+  std::unordered_map<std::string, uint64_t> fingerprints;
+  double lastFullSync = 0.0;
+
+  uint64_t numRuns = 0;
+  uint64_t numJavaScriptRuns = 0;
+  uint64_t numCollectionsSynced = 0;
+  uint64_t numCollectionsSkipped = 0;
+  double lastDuration = 0.0;
+  StatisticsDistribution duration{StatisticsVector() << 0.01 << 0.1 << 0.5
+                                                     << 1.0 << 5.0 << 30.0};
+};
+
+static SyncState State;
+
+static uint64_t fingerprint(VPackSlice slice, uint64_t seed) {
+  if (slice.isNone()) {
+    return seed;
+  }
+  return fasthash64(slice.start(), slice.byteSize(), seed);
+}
+
+static bool containsServer(VPackSlice servers, std::string const& id) {
+  if (!servers.isArray()) {
+    return false;
+  }
+  for (auto const& it : VPackArrayIterator(servers)) {
+    if (it.isString() && it.copyString() == id) {
+      return true;
+    }
+  }
+  return false;
+}
+
+static std::string currentPath(std::string const& database,
+                               std::string const& planId,
+                               std::string const& shard) {
+  return "Current/Collections/" + database + "/" + planId + "/" + shard;
+}
+}
+
 DBServerAgencySync::DBServerAgencySync(HeartbeatThread* heartbeat)
     : _heartbeat(heartbeat) {}
 
@@ -51,12 +121,575 @@ void DBServerAgencySync::work() {
   _heartbeat->dispatchedJobResult(result);
 }
 
-DBServerAgencySyncResult DBServerAgencySync::execute() {
-  // default to system database
+void DBServerAgencySync::registerMetrics() {
+  MetricsRegistry::addCounter(
+      "arangodb_cluster_plan_sync_runs_total",
+      "Number of runs of the plan synchronization", []() {
+        MUTEX_LOCKER(mutexLocker, State.lock);
+        return static_cast<double>(State.numRuns);
+      });
+  MetricsRegistry::addCounter(
+      "arangodb_cluster_plan_sync_javascript_runs_total",
+      "Number of runs of the plan synchronization that used JavaScript",
+      []() {
+        MUTEX_LOCKER(mutexLocker, State.lock);
+        return static_cast<double>(State.numJavaScriptRuns);
+      });
+  MetricsRegistry::addCounter(
+      "arangodb_cluster_plan_sync_collections_total",
+      "Number of collections compared with the plan", []() {
+        MUTEX_LOCKER(mutexLocker, State.lock);
+        return static_cast<double>(State.numCollectionsSynced);
+      });
+  MetricsRegistry::addCounter(
+      "arangodb_cluster_plan_sync_collections_skipped_total",
+      "Number of unchanged collections skipped by the plan synchronization",
+      []() {
+        MUTEX_LOCKER(mutexLocker, State.lock);
+        return static_cast<double>(State.numCollectionsSkipped);
+      });
+  MetricsRegistry::addGauge(
+      "arangodb_cluster_plan_sync_last_seconds",
+      "Duration of the last run of the plan synchronization", []() {
+        MUTEX_LOCKER(mutexLocker, State.lock);
+        return State.lastDuration;
+      });
+  MetricsRegistry::addHistogram(
+      "arangodb_cluster_plan_sync_seconds",
+      "Duration of the runs of the plan synchronization", []() {
+        MUTEX_LOCKER(mutexLocker, State.lock);
+        return State.duration;
+      });
+}
 
+void DBServerAgencySync::unregisterMetrics() {
+  MetricsRegistry::remove("arangodb_cluster_plan_sync_runs_total");
+  MetricsRegistry::remove("arangodb_cluster_plan_sync_javascript_runs_total");
+  MetricsRegistry::remove("arangodb_cluster_plan_sync_collections_total");
+  MetricsRegistry::remove(
+      "arangodb_cluster_plan_sync_collections_skipped_total");
+  MetricsRegistry::remove("arangodb_cluster_plan_sync_last_seconds");
+  MetricsRegistry::remove("arangodb_cluster_plan_sync_seconds");
+}
+
+DBServerAgencySyncResult DBServerAgencySync::execute() {
   double startTime = TRI_microtime();
 
   LOG_TOPIC(DEBUG, Logger::HEARTBEAT) << "DBServerAgencySync::execute starting";
+
+  ClusterFeature* cluster =
+      ApplicationServer::getFeature<ClusterFeature>("Cluster");
+
+  DBServerAgencySyncResult result;
+  bool needsJavaScript = true;
+
+  if (cluster->nativePlanSync()) {
+    result = executeNative(needsJavaScript);
+    if (!result.success) {
+      // do not run the JavaScript implementation on top of a failed run
+      needsJavaScript = false;
+    }
+  }
+
+  if (needsJavaScript) {
+    result = executeJavaScript();
+  }
+
+  double duration = TRI_microtime() - startTime;
+  {
+    MUTEX_LOCKER(mutexLocker, State.lock);
+    ++State.numRuns;
+    if (needsJavaScript) {
+      ++State.numJavaScriptRuns;
+    }
+    State.lastDuration = duration;
+    State.duration.addFigure(duration);
+  }
+
+  if (duration > 30.0) {
+    LOG_TOPIC(WARN, Logger::HEARTBEAT) << "DBServerAgencySync::execute "
+      "took longer than 30s to execute handlePlanChange()";
+  }
+  return result;
+}
+
+/// @brief whether databases must be created or dropped locally
+bool DBServerAgencySync::databasesNeedJavaScript(
+    VPackSlice plan, VPackSlice current,
+    std::vector<std::string> const& localDatabases,
+    std::string const& server) {
+  VPackSlice planDatabases = plan.get("Databases");
+  if (!planDatabases.isObject()) {
+    return false;
+  }
+  std::unordered_set<std::string> local;
+  for (auto const& name : localDatabases) {
+    local.emplace(name);
+    if (name != TRI_VOC_SYSTEM_DATABASE && !planDatabases.hasKey(name)) {
+      return true;
+    }
+  }
+  for (auto const& it : VPackObjectIterator(planDatabases)) {
+    std::string const name = it.key.copyString();
+    if (local.find(name) == local.end() ||
+        current.get(std::vector<std::string>({"Databases", name, server}))
+            .isNone()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/// @brief the shards of a planned collection on the server
+void DBServerAgencySync::plannedShards(
+    VPackSlice info, std::string const& server,
+    std::vector<std::pair<std::string, bool>>& shards) {
+  VPackSlice planShards = info.get("shards");
+  if (!planShards.isObject()) {
+    return;
+  }
+  for (auto const& shard : VPackObjectIterator(planShards)) {
+    VPackSlice servers = shard.value;
+    if (!containsServer(servers, server)) {
+      continue;
+    }
+    bool const isLeader =
+        servers[0].isString() && servers[0].copyString() == server;
+    shards.emplace_back(shard.key.copyString(), isLeader);
+  }
+}
+
+/// @brief whether the server is reported as in sync for a shard
+bool DBServerAgencySync::isInSync(VPackSlice currentShard,
+                                  std::string const& server) {
+  return currentShard.isObject() &&
+         containsServer(currentShard.get("servers"), server);
+}
+
+/// @brief fingerprint of the Plan and Current entries of a collection
+uint64_t DBServerAgencySync::collectionFingerprint(VPackSlice info,
+                                                   VPackSlice current) {
+  return fingerprint(current, fingerprint(info, 0xdeadbeef));
+}
+
+DBServerAgencySyncResult DBServerAgencySync::executeNative(
+    bool& needsJavaScript) {
+  DBServerAgencySyncResult result;
+  needsJavaScript = false;
+
+  DatabaseFeature* databaseFeature =
+      ApplicationServer::getFeature<DatabaseFeature>("Database");
+
+  auto clusterInfo = ClusterInfo::instance();
+  // keep the builders while we work with their slices
+  std::shared_ptr<VPackBuilder> planBuilder = clusterInfo->getPlan();
+  std::shared_ptr<VPackBuilder> currentBuilder = clusterInfo->getCurrent();
+  VPackSlice plan = planBuilder->slice();
+  VPackSlice current = currentBuilder->slice();
+
+  if (!plan.isObject() || !current.isObject()) {
+    return result;
+  }
+
+  result.planVersion = VelocyPackHelper::getNumericValue<uint64_t>(
+      plan, "Version", 0);
+  result.currentVersion = VelocyPackHelper::getNumericValue<uint64_t>(
+      current, "Version", 0);
+
+  std::string const ourselves = ServerState::instance()->getId();
+
+  // databases are created and dropped by JavaScript, as a new database must
+  // be initialized by its bootstrap scripts. this is rare
+  VPackSlice planDatabases = plan.get("Databases");
+  if (!planDatabases.isObject()) {
+    return result;
+  }
+  if (databasesNeedJavaScript(plan, current,
+                              databaseFeature->getDatabaseNames(),
+                              ourselves)) {
+    needsJavaScript = true;
+  }
+
+  double const now = TRI_microtime();
+  bool fullSync = false;
+  std::unordered_map<std::string, uint64_t> fingerprints;
+  {
+    MUTEX_LOCKER(mutexLocker, State.lock);
+    if (now - State.lastFullSync > FullSyncInterval) {
+      fullSync = true;
+      State.lastFullSync = now;
+    } else {
+      fingerprints = State.fingerprints;
+    }
+  }
+
+  std::unordered_map<std::string, uint64_t> newFingerprints;
+  uint64_t numSynced = 0;
+  uint64_t numSkipped = 0;
+  bool success = true;
+  AgencyWriteTransaction trx;
+
+  // the shards that are planned on this server, by database
+  std::unordered_map<std::string, std::unordered_set<std::string>> planned;
+
+  VPackSlice planCollections = plan.get("Collections");
+  if (planCollections.isObject()) {
+    for (auto const& database : VPackObjectIterator(planCollections)) {
+      std::string const dbName = database.key.copyString();
+      if (!database.value.isObject()) {
+        continue;
+      }
+      auto& shards = planned[dbName];
+
+      TRI_vocbase_t* vocbase = databaseFeature->useDatabase(dbName);
+      if (vocbase == nullptr) {
+        // not yet created
+        needsJavaScript = true;
+        continue;
+      }
+      TRI_DEFER(vocbase->release());
+
+      VPackSlice currentCollections =
+          current.get(std::vector<std::string>({"Collections", dbName}));
+
+      for (auto const& collection : VPackObjectIterator(database.value)) {
+        std::string const planId = collection.key.copyString();
+        VPackSlice info = collection.value;
+        VPackSlice shardsSlice = info.get("shards");
+        if (!info.isObject() || !shardsSlice.isObject()) {
+          continue;
+        }
+
+        std::vector<std::pair<std::string, bool>> localShards;
+        plannedShards(info, ourselves, localShards);
+        if (localShards.empty()) {
+          continue;
+        }
+        for (auto const& shard : localShards) {
+          shards.emplace(shard.first);
+        }
+
+        VPackSlice currentCollection;
+        if (currentCollections.isObject()) {
+          currentCollection = currentCollections.get(planId);
+        }
+        std::string key = dbName + "/" + planId;
+        uint64_t value = collectionFingerprint(info, currentCollection);
+
+        auto it = fingerprints.find(key);
+        if (it != fingerprints.end() && (*it).second == value) {
+          ++numSkipped;
+          newFingerprints.emplace(std::move(key), value);
+          continue;
+        }
+
+        ++numSynced;
+        bool collectionNeedsJavaScript = false;
+        if (syncCollection(vocbase, planId, info, currentCollection, trx,
+                           collectionNeedsJavaScript)) {
+          if (!collectionNeedsJavaScript) {
+            newFingerprints.emplace(std::move(key), value);
+          }
+        } else {
+          success = false;
+        }
+        if (collectionNeedsJavaScript) {
+          needsJavaScript = true;
+        }
+      }
+    }
+  }
+
+  // drop the local shards that are no longer planned on this server. only
+  // collections with a plan id different from their own id are shards
+  for (auto const& it : planned) {
+    TRI_vocbase_t* vocbase = databaseFeature->useDatabase(it.first);
+    if (vocbase == nullptr) {
+      continue;
+    }
+    TRI_DEFER(vocbase->release());
+
+    for (auto* collection : vocbase->collections(false)) {
+      if (collection->planId() == collection->cid() ||
+          it.second.find(collection->name()) != it.second.end()) {
+        continue;
+      }
+
+      std::string const shard = collection->name();
+      std::string const planId = collection->planId_as_string();
+      bool const wasLeader = collection->followers()->isLeader();
+
+      LOG_TOPIC(DEBUG, Logger::CLUSTER)
+          << "dropping local shard '" << it.first << "/" << shard << "'";
+      int res = vocbase->dropCollection(collection, true);
+      if (res != TRI_ERROR_NO_ERROR) {
+        LOG_TOPIC(ERR, Logger::CLUSTER)
+            << "could not drop local shard '" << it.first << "/" << shard
+            << "': " << TRI_errno_string(res);
+        success = false;
+        continue;
+      }
+
+      if (wasLeader) {
+        trx.operations.push_back(
+            AgencyOperation(currentPath(it.first, planId, shard),
+                            AgencySimpleOperationType::DELETE_OP));
+      }
+    }
+  }
+
+  if (!trx.operations.empty()) {
+    trx.operations.push_back(AgencyOperation(
+        "Current/Version", AgencySimpleOperationType::INCREMENT_OP));
+    AgencyComm agency;
+    AgencyCommResult res = agency.sendTransactionWithFailover(trx);
+    if (!res.successful()) {
+      LOG_TOPIC(WARN, Logger::CLUSTER)
+          << "could not report local shards in Current: "
+          << res.errorMessage();
+      success = false;
+      // all collections must report again
+      newFingerprints.clear();
+    }
+  }
+
+  {
+    MUTEX_LOCKER(mutexLocker, State.lock);
+    State.fingerprints.swap(newFingerprints);
+    State.numCollectionsSynced += numSynced;
+    State.numCollectionsSkipped += numSkipped;
+  }
+
+  LOG_TOPIC(DEBUG, Logger::HEARTBEAT)
+      << "DBServerAgencySync::executeNative synchronized " << numSynced
+      << " collections, skipped " << numSkipped << " unchanged ones";
+
+  // invalidate our local cache, even if an error occurred
+  clusterInfo->flush();
+
+  result.success = success;
+  return result;
+}
+
+bool DBServerAgencySync::syncCollection(TRI_vocbase_t* vocbase,
+                                        std::string const& planId,
+                                        VPackSlice info, VPackSlice current,
+                                        AgencyWriteTransaction& trx,
+                                        bool& needsJavaScript) {
+  std::string const ourselves = ServerState::instance()->getId();
+  bool success = true;
+
+  std::vector<std::pair<std::string, bool>> shards;
+  plannedShards(info, ourselves, shards);
+
+  for (auto const& shard : shards) {
+    std::string const& shardName = shard.first;
+    bool const isLeader = shard.second;
+
+    int errorNum = TRI_ERROR_NO_ERROR;
+    std::string errorMessage;
+
+    LogicalCollection* collection = vocbase->lookupCollection(shardName);
+    if (collection == nullptr) {
+      // the shard gets the plan properties, and the plan id of its
+      // collection. the indexes are created below
+      VPackBuilder properties;
+      properties.openObject();
+      for (auto const& it : VPackObjectIterator(info)) {
+        if (it.key.isEqualString("id") || it.key.isEqualString("name") ||
+            it.key.isEqualString("indexes")) {
+          continue;
+        }
+        properties.add(it.key);
+        properties.add(it.value);
+      }
+      properties.add("planId", VPackValue(planId));
+      properties.add("name", VPackValue(shardName));
+      properties.close();
+
+      LOG_TOPIC(DEBUG, Logger::CLUSTER)
+          << "creating local shard '" << vocbase->name() << "/" << shardName
+          << "' for plan id " << planId;
+      try {
+        collection = vocbase->createCollection(properties.slice(), 0);
+      } catch (basics::Exception const& ex) {
+        errorNum = ex.code();
+        errorMessage = ex.what();
+      } catch (std::exception const& ex) {
+        errorNum = TRI_ERROR_INTERNAL;
+        errorMessage = ex.what();
+      }
+    } else {
+      // update the properties that may change after creation
+      VPackBuilder local =
+          collection->toVelocyPackIgnore({"indexes", "path"}, false);
+      VPackBuilder changed;
+      changed.openObject();
+      for (auto const& name :
+           {"waitForSync", "doCompact", "journalSize", "indexBuckets"}) {
+        VPackSlice planned = info.get(name);
+        if (!planned.isNone() &&
+            VelocyPackHelper::compare(planned, local.slice().get(name),
+                                      false) != 0) {
+          changed.add(name, planned);
+        }
+      }
+      changed.close();
+
+      if (changed.slice().length() > 0) {
+        arangodb::Result res = collection->updateProperties(changed.slice(),
+                                                            true);
+        if (!res.ok()) {
+          errorNum = res.errorNumber();
+          errorMessage = res.errorMessage();
+        }
+      }
+    }
+
+    if (collection != nullptr) {
+      auto& followers = collection->followers();
+      if (isLeader && !followers->isLeader()) {
+        followers->clear();
+        followers->setLeader(true);
+      } else if (!isLeader && followers->isLeader()) {
+        // keep the followers, we were the only source of truth so far
+        followers->setLeader(false);
+      }
+
+      if (errorNum == TRI_ERROR_NO_ERROR) {
+        errorNum = syncIndexes(collection, info.get("indexes"), errorMessage);
+      }
+    }
+
+    if (errorNum != TRI_ERROR_NO_ERROR) {
+      LOG_TOPIC(ERR, Logger::CLUSTER)
+          << "could not synchronize local shard '" << vocbase->name() << "/"
+          << shardName << "': " << errorMessage;
+      success = false;
+    }
+
+    VPackSlice currentShard;
+    if (current.isObject()) {
+      currentShard = current.get(shardName);
+    }
+
+    if (!isLeader) {
+      if (!isInSync(currentShard, ourselves)) {
+        // the shard must get in sync with its leader first
+        needsJavaScript = true;
+      }
+      continue;
+    }
+
+    // report the shard in Current
+    VPackBuilder entry;
+    entry.openObject();
+    entry.add("error", VPackValue(errorNum != TRI_ERROR_NO_ERROR));
+    entry.add("errorMessage", VPackValue(errorMessage));
+    entry.add("errorNum", VPackValue(errorNum));
+    entry.add(VPackValue("indexes"));
+    if (collection != nullptr) {
+      collection->getIndexesVPack(entry, false);
+    } else {
+      entry.openArray();
+      entry.close();
+    }
+    entry.add(VPackValue("servers"));
+    entry.openArray();
+    entry.add(VPackValue(ourselves));
+    if (collection != nullptr) {
+      for (auto const& follower : *collection->followers()->get()) {
+        entry.add(VPackValue(follower));
+      }
+    }
+    entry.close();
+    entry.close();
+
+    if (!currentShard.isObject() ||
+        VelocyPackHelper::compare(currentShard, entry.slice(), false) != 0) {
+      trx.operations.push_back(AgencyOperation(
+          currentPath(vocbase->name(), planId, shardName),
+          AgencyValueOperationType::SET, entry.slice()));
+    }
+  }
+
+  return success;
+}
+
+int DBServerAgencySync::syncIndexes(LogicalCollection* collection,
+                                    VPackSlice indexes,
+                                    std::string& errorMessage) {
+  std::unordered_set<TRI_idx_iid_t> planned;
+
+  if (indexes.isArray()) {
+    for (auto const& index : VPackArrayIterator(indexes)) {
+      std::string const type =
+          VelocyPackHelper::getStringValue(index, "type", "");
+      if (type == "primary" || type == "edge") {
+        continue;
+      }
+      TRI_idx_iid_t iid = StringUtils::uint64(
+          VelocyPackHelper::getStringValue(index, "id", "0"));
+      planned.emplace(iid);
+
+      if (collection->lookupIndex(iid) != nullptr) {
+        continue;
+      }
+
+      LOG_TOPIC(DEBUG, Logger::CLUSTER)
+          << "creating index " << iid << " on local shard '"
+          << collection->name() << "'";
+
+      READ_LOCKER(readLocker, collection->vocbase()->_inventoryLock);
+      SingleCollectionTransaction trx(
+          transaction::StandaloneContext::Create(collection->vocbase()),
+          collection->cid(), AccessMode::Type::WRITE);
+
+      int res = trx.begin();
+      if (res == TRI_ERROR_NO_ERROR) {
+        bool created = false;
+        if (collection->createIndex(&trx, index, created) == nullptr) {
+          res = TRI_errno();
+        } else {
+          res = trx.commit();
+        }
+      }
+      if (res != TRI_ERROR_NO_ERROR) {
+        errorMessage = "cannot create index " + std::to_string(iid) + ": " +
+                       TRI_errno_string(res);
+        return res;
+      }
+    }
+  }
+
+  std::vector<TRI_idx_iid_t> obsolete;
+  for (auto const& index : collection->getIndexes()) {
+    auto type = index->type();
+    if (type == Index::TRI_IDX_TYPE_PRIMARY_INDEX ||
+        type == Index::TRI_IDX_TYPE_EDGE_INDEX) {
+      continue;
+    }
+    if (planned.find(index->id()) == planned.end()) {
+      obsolete.emplace_back(index->id());
+    }
+  }
+
+  for (auto const& iid : obsolete) {
+    LOG_TOPIC(DEBUG, Logger::CLUSTER)
+        << "dropping index " << iid << " of local shard '"
+        << collection->name() << "'";
+    if (!collection->dropIndex(iid)) {
+      errorMessage = "cannot drop index " + std::to_string(iid);
+      return TRI_ERROR_ARANGO_INDEX_NOT_FOUND;
+    }
+  }
+
+  return TRI_ERROR_NO_ERROR;
+}
+
+DBServerAgencySyncResult DBServerAgencySync::executeJavaScript() {
+  double startTime = TRI_microtime();
+
   DatabaseFeature* database = 
     ApplicationServer::getFeature<DatabaseFeature>("Database");
 
@@ -169,10 +802,5 @@ DBServerAgencySyncResult DBServerAgencySync::execute() {
   } catch (...) {
   }
 
-  now = TRI_microtime();
-  if (now - startTime > 30) {
-    LOG_TOPIC(WARN, Logger::HEARTBEAT) << "DBServerAgencySync::execute "
-      "took longer than 30s to execute handlePlanChange()";
-  }
   return result;
 }
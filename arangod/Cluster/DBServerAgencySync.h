@@ -26,8 +26,15 @@
 
 #include "Basics/Common.h"
 
+struct TRI_vocbase_t;
+
 namespace arangodb {
+class AgencyWriteTransaction;
 class HeartbeatThread;
+class LogicalCollection;
+namespace velocypack {
+class Slice;
+}
 
 struct DBServerAgencySyncResult {
   bool success;
@@ -53,9 +60,58 @@ class DBServerAgencySync {
  public:
   void work();
 
+  /// @brief register and remove the metrics of the plan synchronization
+  static void registerMetrics();
+  static void unregisterMetrics();
+
+  /// @brief whether databases must be created or dropped on the server,
+  /// because the local ones differ from the Plan, or the server is not
+  /// reported in Current for a planned one
+  static bool databasesNeedJavaScript(
+      velocypack::Slice plan, velocypack::Slice current,
+      std::vector<std::string> const& localDatabases,
+      std::string const& server);
+
+  /// @brief the shards of a planned collection on the server, and whether
+  /// the server leads them
+  static void plannedShards(velocypack::Slice info, std::string const& server,
+                            std::vector<std::pair<std::string, bool>>& shards);
+
+  /// @brief whether the Current entry of a shard lists the server as in
+  /// sync
+  static bool isInSync(velocypack::Slice currentShard,
+                       std::string const& server);
+
+  /// @brief fingerprint of the Plan and Current entries of a collection.
+  /// a collection is only compared again if its fingerprint changed
+  static uint64_t collectionFingerprint(velocypack::Slice info,
+                                        velocypack::Slice current);
+
  private:
   DBServerAgencySyncResult execute();
 
+  /// @brief run the JavaScript implementation of handlePlanChange
+  DBServerAgencySyncResult executeJavaScript();
+
+  /// @brief create, drop and update the local shards and their indexes
+  /// according to the Plan, and report the shards we lead in Current.
+  /// only collections whose Plan or Current entries changed since the
+  /// last run are compared. sets needsJavaScript if databases must be
+  /// created or dropped, or a follower shard must get in sync, which is
+  /// still done by the JavaScript implementation
+  DBServerAgencySyncResult executeNative(bool& needsJavaScript);
+
+  /// @brief bring the local shards of one collection in line with the
+  /// Plan. returns false if any shard could not be synchronized
+  bool syncCollection(TRI_vocbase_t* vocbase, std::string const& planId,
+                      velocypack::Slice info, velocypack::Slice current,
+                      AgencyWriteTransaction& trx, bool& needsJavaScript);
+
+  /// @brief create the planned indexes of a shard that are missing, and
+  /// drop the ones that are no longer planned
+  int syncIndexes(LogicalCollection* collection, velocypack::Slice indexes,
+                  std::string& errorMessage);
+
  private:
   HeartbeatThread* _heartbeat;
 };
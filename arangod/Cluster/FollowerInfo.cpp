@@ -38,6 +38,40 @@ std::shared_ptr<std::vector<ServerID> const> FollowerInfo::get() {
   return _followers;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether we may answer a read that allows dirty reads. a follower
+/// that was dropped by the leader only learns about it from Current, so
+/// the lag of our view of Current adds to maxStaleness
+////////////////////////////////////////////////////////////////////////////////
+
+bool FollowerInfo::canServeDirtyRead(double maxStaleness) {
+  if (_isLeader) {
+    return true;
+  }
+
+  auto servers =
+      ClusterInfo::instance()->getResponsibleServer(_docColl->name());
+  std::string const id = ServerState::instance()->getId();
+
+  if (!servers->empty() && (*servers)[0] == id) {
+    // we have just taken over leadership
+    return true;
+  }
+
+  if (maxStaleness > 0.0 &&
+      TRI_microtime() - _appliedTime.load() > maxStaleness) {
+    return false;
+  }
+
+  for (size_t i = 1; i < servers->size(); ++i) {
+    if ((*servers)[i] == id) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief change JSON under
 /// Current/Collection/<DB-name>/<Collection-ID>/<shard-ID>
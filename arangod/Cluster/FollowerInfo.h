@@ -26,6 +26,7 @@
 #define ARANGOD_CLUSTER_FOLLOWER_INFO_H 1
 
 #include "ClusterInfo.h"
+#include "VocBase/voc-types.h"
 
 namespace arangodb {
 
@@ -38,11 +39,14 @@ class FollowerInfo {
   Mutex                                        _mutex;
   arangodb::LogicalCollection*                 _docColl;
   bool                                         _isLeader;
+  std::atomic<TRI_voc_tick_t>                  _appliedTick;
+  std::atomic<double>                          _appliedTime;
 
  public:
 
   explicit FollowerInfo(arangodb::LogicalCollection* d)
-    : _followers(new std::vector<ServerID>()), _docColl(d), _isLeader(false) { }
+    : _followers(new std::vector<ServerID>()), _docColl(d), _isLeader(false),
+      _appliedTick(0), _appliedTime(0.0) { }
 
   //////////////////////////////////////////////////////////////////////////////
   /// @brief get information about current followers of a shard.
@@ -91,6 +95,33 @@ class FollowerInfo {
     _isLeader = b;
   }
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief note that we, as a follower, have applied a replicated operation
+  /// of the leader. tick is our local tick after applying it
+  //////////////////////////////////////////////////////////////////////////////
+
+  void setApplied(TRI_voc_tick_t tick) {
+    _appliedTick = tick;
+    _appliedTime = TRI_microtime();
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief local tick of the last replicated operation we applied
+  //////////////////////////////////////////////////////////////////////////////
+
+  TRI_voc_tick_t appliedTick() const {
+    return _appliedTick;
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief whether we may answer a read that allows dirty reads. the leader
+  /// always may. a follower must still be in sync according to Current, and
+  /// when maxStaleness is positive, it must have applied an operation of the
+  /// leader within the last maxStaleness seconds
+  //////////////////////////////////////////////////////////////////////////////
+
+  bool canServeDirtyRead(double maxStaleness);
+
 };
 }  // end namespace arangodb
 
@@ -40,6 +40,7 @@
 #include "GeneralServer/RestHandlerFactory.h"
 #include "Logger/Logger.h"
 #include "RestServer/DatabaseFeature.h"
+#include "Utils/DatabaseGuard.h"
 #include "Scheduler/JobGuard.h"
 #include "Scheduler/Scheduler.h"
 #include "Scheduler/SchedulerFeature.h"
@@ -52,6 +53,10 @@
 using namespace arangodb;
 using namespace arangodb::application_features;
 
+/// @brief interval in seconds in which a DB server reports the statistics
+/// of its shards to the agency
+static double const ShardStatisticsInterval = 10.0;
+
 std::atomic<bool> HeartbeatThread::HasRunOnce(false);
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -73,6 +78,7 @@ HeartbeatThread::HeartbeatThread(AgencyCallbackRegistry* agencyCallbackRegistry,
       _numFails(0),
       _lastSuccessfulVersion(0),
       _currentPlanVersion(0),
+      _lastShardStatistics(0.0),
       _ready(false),
       _currentVersions(0, 0),
       _desiredVersions(std::make_shared<AgencyVersions>(0, 0)),
@@ -203,6 +209,9 @@ void HeartbeatThread::runDBServer() {
     usleep(100000);
   }
 
+  DBServerAgencySync::registerMetrics();
+  TRI_DEFER(DBServerAgencySync::unregisterMetrics());
+
   // convert timeout to seconds
   double const interval = (double)_interval / 1000.0 / 1000.0;
 
@@ -265,6 +274,7 @@ void HeartbeatThread::runDBServer() {
       // send our state to the agency.
       // we don't care if this fails
       sendState();
+      sendShardStatistics();
 
       if (isStopping()) {
         break;
@@ -854,6 +864,70 @@ bool HeartbeatThread::handleStateChange(AgencyCommResult& result) {
   return false;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief sends the size and request rate of the local shards to the agency.
+/// they are stored under Sync/ShardStatistics/<id> as an object with an
+/// entry {"size": <documents>, "rate": <operations per second>} per shard,
+/// which expires unless it is sent again
+////////////////////////////////////////////////////////////////////////////////
+
+void HeartbeatThread::sendShardStatistics() {
+  double const now = TRI_microtime();
+  double const elapsed = now - _lastShardStatistics;
+
+  if (elapsed < ShardStatisticsInterval) {
+    return;
+  }
+
+  bool const first = (_lastShardStatistics == 0.0);
+  _lastShardStatistics = now;
+
+  std::unordered_map<std::string, uint64_t> operations;
+  VPackBuilder builder;
+
+  try {
+    builder.openObject();
+
+    for (auto const& name : DatabaseFeature::DATABASE->getDatabaseNames()) {
+      try {
+        DatabaseGuard guard(name);
+
+        for (auto const& collection : guard.database()->collections(false)) {
+          if (collection->status() != TRI_VOC_COL_STATUS_LOADED) {
+            continue;
+          }
+
+          uint64_t const numOperations = collection->numOperations();
+          double rate = 0.0;
+
+          auto it = _shardOperations.find(collection->name());
+          if (!first && it != _shardOperations.end() &&
+              numOperations >= (*it).second) {
+            rate = static_cast<double>(numOperations - (*it).second) / elapsed;
+          }
+          operations.emplace(collection->name(), numOperations);
+
+          builder.add(collection->name(), VPackValue(VPackValueType::Object));
+          builder.add("size", VPackValue(collection->numberDocuments()));
+          builder.add("rate", VPackValue(rate));
+          builder.close();
+        }
+      } catch (...) {
+        // database was dropped in the meantime
+      }
+    }
+
+    builder.close();
+  } catch (...) {
+    return;
+  }
+
+  _shardOperations.swap(operations);
+
+  _agency.setTransient("Sync/ShardStatistics/" + _myId, builder.slice(),
+                       3.0 * ShardStatisticsInterval);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief sends the current server's state to the agency
 ////////////////////////////////////////////////////////////////////////////////
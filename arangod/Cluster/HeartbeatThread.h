@@ -129,6 +129,13 @@ class HeartbeatThread : public Thread,
 
   bool sendState();
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief sends the size and request rate of the local shards to the
+  /// agency, at most every ShardStatisticsInterval seconds
+  //////////////////////////////////////////////////////////////////////////////
+
+  void sendShardStatistics();
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief bring the db server in sync with the desired state
   //////////////////////////////////////////////////////////////////////////////
@@ -196,6 +203,14 @@ class HeartbeatThread : public Thread,
 
   uint64_t _currentPlanVersion;
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief time the shard statistics were last sent, and the number of
+  /// operations of each shard at that time
+  //////////////////////////////////////////////////////////////////////////////
+
+  double _lastShardStatistics;
+  std::unordered_map<std::string, uint64_t> _shardOperations;
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief whether or not the thread is ready
   //////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,246 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "ReplicationBatcher.h"
+
+#include "Basics/ConditionLocker.h"
+#include "Basics/MutexLocker.h"
+#include "Basics/StaticStrings.h"
+#include "Basics/StringUtils.h"
+#include "Cluster/ClusterComm.h"
+#include "Cluster/FollowerInfo.h"
+#include "Logger/Logger.h"
+#include "VocBase/LogicalCollection.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Iterator.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+
+/// @brief maximum number of documents combined into one request. more
+/// operations may be queued, they are then sent in the next request
+static size_t const MaxBatchDocuments = 1000;
+
+/// @brief the number of documents of an operation
+static size_t countDocuments(VPackSlice documents) {
+  return documents.isArray() ? static_cast<size_t>(documents.length()) : 1;
+}
+
+/// @brief choose the timeout for a replication request. we usually assume
+/// that a server can process at least 5000 documents per second (this is a
+/// low estimate), and use a low limit of 0.5s and a high timeout of 120s
+static double chooseTimeout(size_t count) {
+  double timeout = static_cast<double>(count / 5000);
+  if (timeout < 0.5) {
+    return 0.5;
+  } else if (timeout > 120) {
+    return 120.0;
+  }
+  return timeout;
+}
+
+ReplicationBatcher* ReplicationBatcher::instance() {
+  static ReplicationBatcher batcher;
+  return &batcher;
+}
+
+void ReplicationBatcher::replicate(
+    LogicalCollection* collection, std::string const& database,
+    rest::RequestType type,
+    std::shared_ptr<std::vector<ServerID> const> const& followers,
+    VPackSlice documents, char const* context) {
+  TRI_ASSERT(!followers->empty());
+
+  Operation operation{type, followers, documents, false};
+  std::string const key = database + "/" + collection->name();
+
+  Queue* queue;
+  {
+    // references to the elements of the map stay valid when others are
+    // inserted, and the queue is not removed while we are a user
+    MUTEX_LOCKER(locker, _queuesLock);
+    queue = &_queues[key];
+    ++queue->_users;
+  }
+
+  enqueueAndWait(collection, database, *queue, operation, context);
+
+  MUTEX_LOCKER(locker, _queuesLock);
+  if (--queue->_users == 0) {
+    TRI_ASSERT(queue->_operations.empty());
+    TRI_ASSERT(!queue->_inFlight);
+    _queues.erase(key);
+  }
+}
+
+void ReplicationBatcher::enqueueAndWait(LogicalCollection* collection,
+                                        std::string const& database,
+                                        Queue& queue, Operation& operation,
+                                        char const* context) {
+  rest::RequestType const type = operation._type;
+  auto const& followers = operation._followers;
+
+  CONDITION_LOCKER(guard, queue._condition);
+
+  queue._operations.emplace_back(&operation);
+
+  while (!operation._done) {
+    if (queue._inFlight || queue._operations.front() != &operation) {
+      // either a request for this shard is in flight, or another operation
+      // ahead of us will send the next batch, which may include ours
+      guard.wait();
+      continue;
+    }
+
+    // we are at the head of the queue. collect the following operations of
+    // the same type and for the same followers into one batch
+    std::vector<Operation*> batch;
+    size_t documentCount = 0;
+
+    while (!queue._operations.empty()) {
+      Operation* next = queue._operations.front();
+
+      if (!batch.empty() &&
+          (next->_type != type || *(next->_followers) != *followers ||
+           documentCount + countDocuments(next->_documents) >
+               MaxBatchDocuments)) {
+        break;
+      }
+
+      documentCount += countDocuments(next->_documents);
+      batch.emplace_back(next);
+      queue._operations.pop_front();
+    }
+
+    queue._inFlight = true;
+
+    guard.unlock();
+
+    try {
+      send(collection, database, batch, context);
+    } catch (...) {
+      // a failure to send is handled like a failed request, which drops
+      // the followers. waiters must be released in any case
+      LOG_TOPIC(ERR, Logger::REPLICATION)
+          << context << ": caught exception during synchronous replication "
+          << "for shard " << collection->name();
+    }
+
+    guard.lock();
+
+    queue._inFlight = false;
+
+    for (auto& it : batch) {
+      it->_done = true;
+    }
+
+    // wake up the owners of the batch and the next head of the queue
+    guard.broadcast();
+  }
+}
+
+void ReplicationBatcher::send(LogicalCollection* collection,
+                              std::string const& database,
+                              std::vector<Operation*> const& batch,
+                              char const* context) {
+  TRI_ASSERT(!batch.empty());
+
+  auto cc = arangodb::ClusterComm::instance();
+
+  if (cc == nullptr) {
+    // nullptr only happens on controlled shutdown
+    return;
+  }
+
+  rest::RequestType const type = batch[0]->_type;
+  auto const& followers = batch[0]->_followers;
+
+  std::string const path =
+      "/_db/" + arangodb::basics::StringUtils::urlEncode(database) +
+      "/_api/document/" +
+      arangodb::basics::StringUtils::urlEncode(collection->name()) +
+      "?isRestore=true";
+
+  std::shared_ptr<std::string> body;
+  size_t count = 0;
+
+  if (batch.size() == 1) {
+    // nothing to combine, send the operation as it is
+    body = std::make_shared<std::string>(batch[0]->_documents.toJson());
+    count = countDocuments(batch[0]->_documents);
+  } else {
+    VPackBuilder payload;
+    payload.openArray();
+
+    for (auto const& it : batch) {
+      if (it->_documents.isArray()) {
+        for (auto const& doc : VPackArrayIterator(it->_documents)) {
+          payload.add(doc);
+          ++count;
+        }
+      } else {
+        payload.add(it->_documents);
+        ++count;
+      }
+    }
+
+    payload.close();
+    body = std::make_shared<std::string>(payload.slice().toJson());
+  }
+
+  // send to all followers in parallel
+  std::vector<ClusterCommRequest> requests;
+  for (auto const& f : *followers) {
+    requests.emplace_back("server:" + f, type, path, body);
+  }
+
+  size_t nrDone = 0;
+  size_t nrGood = cc->performRequests(requests, chooseTimeout(count), nrDone,
+                                      Logger::REPLICATION);
+
+  if (nrGood < followers->size()) {
+    rest::ResponseCode const expected = (type == rest::RequestType::POST)
+                                            ? rest::ResponseCode::CREATED
+                                            : rest::ResponseCode::OK;
+
+    // we drop all followers that were not successful:
+    for (size_t i = 0; i < followers->size(); ++i) {
+      bool replicationWorked =
+          requests[i].done &&
+          requests[i].result.status == CL_COMM_RECEIVED &&
+          (requests[i].result.answer_code == rest::ResponseCode::ACCEPTED ||
+           requests[i].result.answer_code == expected);
+      if (replicationWorked) {
+        bool found;
+        requests[i].result.answer->header(StaticStrings::ErrorCodes, found);
+        replicationWorked = !found;
+      }
+      if (!replicationWorked) {
+        auto const& followerInfo = collection->followers();
+        followerInfo->remove((*followers)[i]);
+        LOG_TOPIC(ERR, Logger::REPLICATION)
+            << context << ": dropping follower " << (*followers)[i]
+            << " for shard " << collection->name();
+      }
+    }
+  }
+}
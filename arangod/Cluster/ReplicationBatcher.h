@@ -0,0 +1,108 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_CLUSTER_REPLICATION_BATCHER_H
+#define ARANGOD_CLUSTER_REPLICATION_BATCHER_H 1
+
+#include "Basics/Common.h"
+
+#include "Basics/ConditionVariable.h"
+#include "Basics/Mutex.h"
+#include "Cluster/ClusterInfo.h"
+#include "Rest/CommonDefines.h"
+
+#include <velocypack/Slice.h>
+
+namespace arangodb {
+class LogicalCollection;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief combines the synchronous replication of document operations on
+/// the same shard into one request per follower.
+/// there is at most one replication request in flight per shard. operations
+/// that complete locally while it is in flight are queued, and are sent
+/// together as soon as it returns. under low load, an operation is sent
+/// right away, so batching does not add latency. the queue is processed in
+/// order, and a batch only contains consecutive operations of the same
+/// type, so followers apply operations in the order the leader performed
+/// them
+////////////////////////////////////////////////////////////////////////////////
+
+class ReplicationBatcher {
+ public:
+  ReplicationBatcher() = default;
+  ReplicationBatcher(ReplicationBatcher const&) = delete;
+  ReplicationBatcher& operator=(ReplicationBatcher const&) = delete;
+
+  static ReplicationBatcher* instance();
+
+ public:
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief replicate documents to all followers and wait until the followers
+  /// have answered. documents is an object or an array of objects in the
+  /// format of the document API with isRestore=true. followers that do not
+  /// apply the operations successfully are dropped. context is used for
+  /// logging only
+  //////////////////////////////////////////////////////////////////////////////
+
+  void replicate(LogicalCollection* collection, std::string const& database,
+                 rest::RequestType type,
+                 std::shared_ptr<std::vector<ServerID> const> const& followers,
+                 arangodb::velocypack::Slice documents, char const* context);
+
+ private:
+  struct Operation {
+    rest::RequestType _type;
+    std::shared_ptr<std::vector<ServerID> const> _followers;
+    arangodb::velocypack::Slice _documents;
+    bool _done;
+  };
+
+  /// @brief the operations of one shard. _operations and _inFlight are
+  /// protected by _condition, which only wakes up the threads replicating
+  /// to this shard
+  struct Queue {
+    basics::ConditionVariable _condition;
+    std::deque<Operation*> _operations;
+    bool _inFlight = false;
+    /// @brief number of threads using the queue, protected by _queuesLock
+    size_t _users = 0;
+  };
+
+  /// @brief queue the operation and wait until it has been replicated.
+  /// sends the next batch whenever the operation is at the head of the queue
+  void enqueueAndWait(LogicalCollection* collection,
+                      std::string const& database, Queue& queue,
+                      Operation& operation, char const* context);
+
+  void send(LogicalCollection* collection, std::string const& database,
+            std::vector<Operation*> const& batch, char const* context);
+
+ private:
+  /// @brief protects _queues
+  Mutex _queuesLock;
+
+  /// @brief queues by database and shard name
+  std::unordered_map<std::string, Queue> _queues;
+};
+}
+
+#endif
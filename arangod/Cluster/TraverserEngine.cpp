@@ -26,8 +26,11 @@
 #include "Aql/AqlTransaction.h"
 #include "Aql/Ast.h"
 #include "Aql/Query.h"
+#include "Basics/StringRef.h"
+#include "Basics/VelocyPackHelper.h"
 #include "Utils/CollectionNameResolver.h"
 #include "Transaction/Context.h"
+#include "Transaction/Helpers.h"
 #include "VocBase/ManagedDocumentResult.h"
 #include "VocBase/TraverserOptions.h"
 
@@ -130,7 +133,8 @@ BaseTraverserEngine::~BaseTraverserEngine() {
   delete _query;
 }
 
-void BaseTraverserEngine::getEdges(VPackSlice vertex, size_t depth, VPackBuilder& builder) {
+void BaseTraverserEngine::getEdges(VPackSlice vertex, size_t depth,
+                                   VPackBuilder& builder, bool withVertices) {
   // We just hope someone has locked the shards properly. We have no clue... Thanks locking
 
   TRI_ASSERT(vertex.isString() || vertex.isArray());
@@ -139,6 +143,17 @@ void BaseTraverserEngine::getEdges(VPackSlice vertex, size_t depth, VPackBuilder
   size_t filtered = 0;
   ManagedDocumentResult mmdr;
   std::vector<VPackSlice> result;
+  // the vertices on the other side of the edges, only used withVertices
+  std::unordered_set<VPackSlice> others;
+  auto addOther = [&](VPackSlice edge, VPackSlice source) {
+    if (withVertices) {
+      VPackSlice other = transaction::helpers::extractFromFromDocument(edge);
+      if (other == source) {
+        other = transaction::helpers::extractToFromDocument(edge);
+      }
+      others.emplace(other);
+    }
+  };
   builder.openObject();
   builder.add(VPackValue("edges"));
   builder.openArray();
@@ -155,6 +170,7 @@ void BaseTraverserEngine::getEdges(VPackSlice vertex, size_t depth, VPackBuilder
       }
       for (auto const& it : result) {
         builder.add(it);
+        addOther(it, v);
       }
       // Result now contains all valid edges, probably multiples.
     }
@@ -169,6 +185,7 @@ void BaseTraverserEngine::getEdges(VPackSlice vertex, size_t depth, VPackBuilder
     }
     for (auto const& it : result) {
       builder.add(it);
+      addOther(it, vertex);
     }
     // Result now contains all valid edges, probably multiples.
   } else {
@@ -177,9 +194,46 @@ void BaseTraverserEngine::getEdges(VPackSlice vertex, size_t depth, VPackBuilder
   builder.close();
   builder.add("readIndex", VPackValue(read));
   builder.add("filtered", VPackValue(filtered));
+  if (withVertices) {
+    // Saves the coordinator a separate round-trip for the vertices stored
+    // in our shards. Vertices of other servers are simply left out and
+    // fetched by the coordinator as before.
+    builder.add(VPackValue("vertices"));
+    builder.openObject();
+    for (auto const& v : others) {
+      addLocalVertex(v, builder);
+    }
+    builder.close();
+  }
   builder.close();
 }
 
+void BaseTraverserEngine::addLocalVertex(VPackSlice id, VPackBuilder& builder) {
+  TRI_ASSERT(id.isString());
+  StringRef ref(id);
+  std::string name = ref.substr(0, ref.find('/')).toString();
+  auto shards = _vertexShards.find(name);
+  if (shards == _vertexShards.end()) {
+    // not known here, the coordinator will complain when fetching it
+    return;
+  }
+  builder.add(id);
+  for (std::string const& shard : shards->second) {
+    int res = _trx->documentFastPath(shard, nullptr, id, builder, false);
+    if (res == TRI_ERROR_NO_ERROR) {
+      return;
+    }
+    if (res != TRI_ERROR_ARANGO_DOCUMENT_NOT_FOUND) {
+      // We are in a very bad condition here...
+      THROW_ARANGO_EXCEPTION(res);
+    }
+  }
+  // not stored in our shards. the key alone cannot be removed from the
+  // object, so remove it together with a dummy value
+  builder.add(arangodb::basics::VelocyPackHelper::NullValue());
+  builder.removeLast();
+}
+
 void BaseTraverserEngine::getVertexData(VPackSlice vertex, VPackBuilder& builder) {
   // We just hope someone has locked the shards properly. We have no clue...
   // Thanks locking
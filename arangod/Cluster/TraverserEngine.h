@@ -68,8 +68,12 @@ class BaseTraverserEngine {
    // The engine is NOT copyable.
    BaseTraverserEngine(BaseTraverserEngine const&) = delete;
 
+   /// @brief get the edges of one or many vertices. If withVertices is
+   ///        set, the documents of the vertices on the other side of the
+   ///        edges are added as well, as far as they are stored in shards
+   ///        of this engine.
    void getEdges(arangodb::velocypack::Slice, size_t,
-                 arangodb::velocypack::Builder&);
+                 arangodb::velocypack::Builder&, bool withVertices = false);
 
    void getVertexData(arangodb::velocypack::Slice,
                       arangodb::velocypack::Builder&);
@@ -87,6 +91,12 @@ class BaseTraverserEngine {
 
    std::shared_ptr<transaction::Context> context() const;
 
+  private:
+   /// @brief add the document of a vertex as attribute of the open object
+   ///        in builder, if it is stored in one of the shards of the engine
+   void addLocalVertex(arangodb::velocypack::Slice,
+                       arangodb::velocypack::Builder&);
+
   protected:
     std::unique_ptr<TraverserOptions> _opts;
     arangodb::aql::Query* _query;
@@ -29,6 +29,8 @@
 #include "Logger/Logger.h"
 #include "Rest/GeneralResponse.h"
 
+#include <algorithm>
+
 using namespace arangodb;
 using namespace arangodb::basics;
 using namespace arangodb::rest;
@@ -55,6 +57,7 @@ class arangodb::rest::AsyncCallbackContext {
 AsyncJobResult::AsyncJobResult()
     : _jobId(0),
       _response(nullptr),
+      _memoryUsage(0),
       _stamp(0.0),
       _status(JOB_UNDEFINED),
       _ctx(nullptr),
@@ -65,6 +68,7 @@ AsyncJobResult::AsyncJobResult(IdType jobId, Status status,
                                RestHandler* handler)
     : _jobId(jobId),
       _response(nullptr),
+      _memoryUsage(0),
       _stamp(TRI_microtime()),
       _status(status),
       _ctx(ctx),
@@ -72,8 +76,12 @@ AsyncJobResult::AsyncJobResult(IdType jobId, Status status,
 
 AsyncJobResult::~AsyncJobResult() {}
 
-AsyncJobManager::AsyncJobManager()
-    : _lock(), _jobs() {}
+AsyncJobManager::AsyncJobManager(uint64_t maxMemory, double ttl)
+    : _maxMemory(maxMemory),
+      _ttl(ttl),
+      _memoryUsage(0),
+      _lastExpiry(0.0),
+      _enforcing(false) {}
 
 AsyncJobManager::~AsyncJobManager() {
   // remove all results that haven't been fetched
@@ -87,11 +95,12 @@ AsyncJobManager::~AsyncJobManager() {
 GeneralResponse* AsyncJobManager::getJobResult(AsyncJobResult::IdType jobId,
                                                AsyncJobResult::Status& status,
                                                bool removeFromList) {
-  WRITE_LOCKER(writeLocker, _lock);
+  Shard& s = shard(jobId);
+  WRITE_LOCKER(writeLocker, s._lock);
 
-  auto it = _jobs.find(jobId);
+  auto it = s._jobs.find(jobId);
 
-  if (it == _jobs.end()) {
+  if (it == s._jobs.end()) {
     status = AsyncJobResult::JOB_UNDEFINED;
     return nullptr;
   }
@@ -107,8 +116,9 @@ GeneralResponse* AsyncJobManager::getJobResult(AsyncJobResult::IdType jobId,
     return nullptr;
   }
 
-  // remove the job from the list
-  _jobs.erase(it);
+  // remove the job from the list. the caller now owns the response
+  (*it).second._response = nullptr;
+  removeJob(s._jobs, it);
   return response;
 }
 
@@ -117,22 +127,17 @@ GeneralResponse* AsyncJobManager::getJobResult(AsyncJobResult::IdType jobId,
 ////////////////////////////////////////////////////////////////////////////////
 
 bool AsyncJobManager::deleteJobResult(AsyncJobResult::IdType jobId) {
-  WRITE_LOCKER(writeLocker, _lock);
+  Shard& s = shard(jobId);
+  WRITE_LOCKER(writeLocker, s._lock);
 
-  auto it = _jobs.find(jobId);
+  auto it = s._jobs.find(jobId);
 
-  if (it == _jobs.end()) {
+  if (it == s._jobs.end()) {
     return false;
   }
 
-  GeneralResponse* response = (*it).second._response;
-
-  if (response != nullptr) {
-    delete response;
-  }
-
   // remove the job from the list
-  _jobs.erase(it);
+  removeJob(s._jobs, it);
   return true;
 }
 
@@ -141,51 +146,40 @@ bool AsyncJobManager::deleteJobResult(AsyncJobResult::IdType jobId) {
 ////////////////////////////////////////////////////////////////////////////////
 
 void AsyncJobManager::deleteJobResults() {
-  WRITE_LOCKER(writeLocker, _lock);
+  for (auto& s : _shards) {
+    WRITE_LOCKER(writeLocker, s._lock);
 
-  auto it = _jobs.begin();
+    auto it = s._jobs.begin();
 
-  while (it != _jobs.end()) {
-    GeneralResponse* response = (*it).second._response;
-
-    if (response != nullptr) {
-      delete response;
+    while (it != s._jobs.end()) {
+      removeJob(s._jobs, it++);
     }
-
-    ++it;
   }
-
-  _jobs.clear();
 }
 
 void AsyncJobManager::deleteExpiredJobResults(double stamp) {
-  WRITE_LOCKER(writeLocker, _lock);
-
-  auto it = _jobs.begin();
+  for (auto& s : _shards) {
+    WRITE_LOCKER(writeLocker, s._lock);
 
-  while (it != _jobs.end()) {
-    AsyncJobResult ajr = (*it).second;
+    auto it = s._jobs.begin();
 
-    if (ajr._stamp < stamp) {
-      GeneralResponse* response = ajr._response;
-
-      if (response != nullptr) {
-        delete response;
+    while (it != s._jobs.end()) {
+      if ((*it).second._stamp < stamp) {
+        removeJob(s._jobs, it++);
+      } else {
+        ++it;
       }
-
-      _jobs.erase(it++);
-    } else {
-      ++it;
     }
   }
 }
 
 bool AsyncJobManager::cancelJob(AsyncJobResult::IdType jobId) {
-  WRITE_LOCKER(writeLocker, _lock);
+  Shard& s = shard(jobId);
+  WRITE_LOCKER(writeLocker, s._lock);
 
-  auto it = _jobs.find(jobId);
+  auto it = s._jobs.find(jobId);
 
-  if (it == _jobs.end()) {
+  if (it == s._jobs.end()) {
     return false;
   }
 
@@ -218,14 +212,17 @@ std::vector<AsyncJobResult::IdType> AsyncJobManager::done(size_t maxCount) {
 std::vector<AsyncJobResult::IdType> AsyncJobManager::byStatus(
     AsyncJobResult::Status status, size_t maxCount) {
   std::vector<AsyncJobResult::IdType> jobs;
+  size_t n = 0;
 
-  {
-    size_t n = 0;
-    READ_LOCKER(readLocker, _lock);
-    auto it = _jobs.begin();
+  for (auto& s : _shards) {
+    if (n >= maxCount) {
+      break;
+    }
 
-    // iterate the list. the list is sorted by id
-    while (it != _jobs.end()) {
+    READ_LOCKER(readLocker, s._lock);
+    auto it = s._jobs.begin();
+
+    while (it != s._jobs.end()) {
       AsyncJobResult::IdType jobId = (*it).first;
 
       if ((*it).second._status == status) {
@@ -258,9 +255,10 @@ void AsyncJobManager::initAsyncJob(RestHandler* handler, char const* hdr) {
 
   AsyncJobResult ajr(jobId, AsyncJobResult::JOB_PENDING, ctx, handler);
 
-  WRITE_LOCKER(writeLocker, _lock);
+  Shard& s = shard(jobId);
+  WRITE_LOCKER(writeLocker, s._lock);
 
-  _jobs.emplace(jobId, ajr);
+  s._jobs.emplace(jobId, ajr);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -271,25 +269,138 @@ void AsyncJobManager::finishAsyncJob(RestHandler* handler) {
   AsyncJobResult::IdType jobId = handler->handlerId();
   std::unique_ptr<GeneralResponse> response = handler->stealResponse();
   AsyncCallbackContext* ctx = nullptr;
+  size_t const memoryUsage =
+      (response == nullptr) ? 0 : response->memoryUsage();
+  double const now = TRI_microtime();
 
   {
-    WRITE_LOCKER(writeLocker, _lock);
-    auto it = _jobs.find(jobId);
+    Shard& s = shard(jobId);
+    WRITE_LOCKER(writeLocker, s._lock);
+    auto it = s._jobs.find(jobId);
 
-    if (it == _jobs.end()) {
+    if (it == s._jobs.end()) {
       return;
     }
 
     ctx = (*it).second._ctx;
 
     if (nullptr != ctx) {
-      _jobs.erase(it);
+      s._jobs.erase(it);
     } else {
       (*it).second._response = response.release();
+      (*it).second._memoryUsage = memoryUsage;
       (*it).second._status = AsyncJobResult::JOB_DONE;
-      (*it).second._stamp = TRI_microtime();
+      (*it).second._stamp = now;
+      _memoryUsage += memoryUsage;
     }
   }
 
   delete ctx;
+
+  if ((_maxMemory > 0 && _memoryUsage.load() > _maxMemory) ||
+      (_ttl > 0.0 && now - _lastExpiry.load() >= 1.0)) {
+    enforceLimits();
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief remove a job from its shard, the shard must be locked
+////////////////////////////////////////////////////////////////////////////////
+
+void AsyncJobManager::removeJob(JobList& jobs, JobList::iterator it) {
+  GeneralResponse* response = (*it).second._response;
+
+  if (response != nullptr) {
+    delete response;
+  }
+
+  _memoryUsage -= (*it).second._memoryUsage;
+  jobs.erase(it);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief drop expired results, and the oldest results until the memory
+/// limit is met again. only finished jobs are affected
+////////////////////////////////////////////////////////////////////////////////
+
+void AsyncJobManager::enforceLimits() {
+  if (_enforcing.exchange(true)) {
+    // another thread is already at it
+    return;
+  }
+
+  try {
+    double const now = TRI_microtime();
+    size_t expired = 0;
+    size_t evicted = 0;
+
+    // check for expired results at most once per second
+    if (_ttl > 0.0 && now - _lastExpiry.load() >= 1.0) {
+      _lastExpiry = now;
+      double const stamp = now - _ttl;
+
+      for (auto& s : _shards) {
+        WRITE_LOCKER(writeLocker, s._lock);
+
+        auto it = s._jobs.begin();
+
+        while (it != s._jobs.end()) {
+          if ((*it).second._status == AsyncJobResult::JOB_DONE &&
+              (*it).second._stamp < stamp) {
+            removeJob(s._jobs, it++);
+            ++expired;
+          } else {
+            ++it;
+          }
+        }
+      }
+    }
+
+    if (_maxMemory > 0 && _memoryUsage.load() > _maxMemory) {
+      // free some more than necessary, so that not every following job
+      // has to do this again
+      uint64_t const target = _maxMemory - _maxMemory / 10;
+      std::vector<std::pair<double, AsyncJobResult::IdType>> candidates;
+
+      for (auto& s : _shards) {
+        READ_LOCKER(readLocker, s._lock);
+
+        for (auto const& it : s._jobs) {
+          if (it.second._status == AsyncJobResult::JOB_DONE) {
+            candidates.emplace_back(it.second._stamp, it.first);
+          }
+        }
+      }
+
+      // oldest results first
+      std::sort(candidates.begin(), candidates.end());
+
+      for (auto const& candidate : candidates) {
+        if (_memoryUsage.load() <= target) {
+          break;
+        }
+
+        Shard& s = shard(candidate.second);
+        WRITE_LOCKER(writeLocker, s._lock);
+
+        auto it = s._jobs.find(candidate.second);
+
+        if (it != s._jobs.end() &&
+            (*it).second._status == AsyncJobResult::JOB_DONE) {
+          removeJob(s._jobs, it);
+          ++evicted;
+        }
+      }
+    }
+
+    if (expired > 0 || evicted > 0) {
+      LOG_TOPIC(DEBUG, arangodb::Logger::FIXME)
+          << "dropped " << expired << " expired and " << evicted
+          << " unfetched async job results to stay within limits";
+    }
+  } catch (...) {
+    // the limits will be enforced by the next finished job
+  }
+
+  _enforcing = false;
 }
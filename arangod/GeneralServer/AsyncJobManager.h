@@ -55,6 +55,7 @@ struct AsyncJobResult {
  public:
   IdType _jobId;
   GeneralResponse* _response;
+  size_t _memoryUsage;
   double _stamp;
   Status _status;
   AsyncCallbackContext* _ctx;
@@ -65,6 +66,14 @@ struct AsyncJobResult {
 // --SECTION--                                                   AsyncJobManager
 // -----------------------------------------------------------------------------
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief keeps track of async jobs and stores their results until they are
+/// fetched. the results of finished jobs are limited in total size: if they
+/// use more than maxMemory bytes, the oldest results are dropped. results
+/// that have not been fetched within ttl seconds are dropped as well. jobs
+/// are distributed over independently locked shards by job id
+////////////////////////////////////////////////////////////////////////////////
+
 class AsyncJobManager {
   AsyncJobManager(AsyncJobManager const&) = delete;
   AsyncJobManager& operator=(AsyncJobManager const&) = delete;
@@ -73,7 +82,8 @@ class AsyncJobManager {
   typedef std::unordered_map<AsyncJobResult::IdType, AsyncJobResult> JobList;
 
  public:
-  AsyncJobManager();
+  /// @brief a maxMemory or ttl of 0 means no limit
+  AsyncJobManager(uint64_t maxMemory = 0, double ttl = 0.0);
   ~AsyncJobManager();
 
  public:
@@ -91,9 +101,42 @@ class AsyncJobManager {
   void initAsyncJob(RestHandler*, char const*);
   void finishAsyncJob(RestHandler*);
 
+  /// @brief number of bytes used by the stored results
+  uint64_t memoryUsage() const { return _memoryUsage.load(); }
+
+ private:
+  struct Shard {
+    basics::ReadWriteLock _lock;
+    JobList _jobs;
+  };
+
+  /// @brief number of shards, must be a power of two
+  static size_t const NumShards = 16;
+
+  Shard& shard(AsyncJobResult::IdType jobId) {
+    return _shards[jobId & (NumShards - 1)];
+  }
+
+  /// @brief remove a job from its shard, the shard must be locked
+  void removeJob(JobList& jobs, JobList::iterator it);
+
+  /// @brief drop the oldest results until the memory limit is met again,
+  /// and results that have expired
+  void enforceLimits();
+
  private:
-  basics::ReadWriteLock _lock;
-  JobList _jobs;
+  Shard _shards[NumShards];
+
+  uint64_t const _maxMemory;
+  double const _ttl;
+
+  std::atomic<uint64_t> _memoryUsage;
+
+  /// @brief time of the last check for expired results
+  std::atomic<double> _lastExpiry;
+
+  /// @brief set while a thread enforces the limits
+  std::atomic<bool> _enforcing;
 };
 }
 }
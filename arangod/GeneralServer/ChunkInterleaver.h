@@ -0,0 +1,101 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_GENERAL_SERVER_CHUNK_INTERLEAVER_H
+#define ARANGOD_GENERAL_SERVER_CHUNK_INTERLEAVER_H 1
+
+#include "Basics/Common.h"
+
+#include <deque>
+
+namespace arangodb {
+namespace rest {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief hands out the chunks of several messages in turn: each turn takes
+/// one chunk of the first message and moves the message to the back, so
+/// that small messages are not delayed by large ones. every message carries
+/// an extra pointer, which is handed out with its last chunk. not
+/// thread-safe, the caller must synchronize access
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename Chunk, typename Extra>
+class ChunkInterleaver {
+ public:
+  bool empty() const { return _messages.empty(); }
+
+  /// @brief add a message. messages without chunks are ignored
+  void add(std::deque<Chunk>&& chunks, Extra* extra) {
+    if (!chunks.empty()) {
+      _messages.emplace_back(Message{std::move(chunks), extra});
+    }
+  }
+
+  /// @brief take the next chunk. extra is set to the extra pointer of the
+  /// message if this was its last chunk, and to nullptr otherwise. returns
+  /// false if there is no chunk left
+  bool next(Chunk& chunk, Extra*& extra) {
+    if (_messages.empty()) {
+      return false;
+    }
+
+    Message& message = _messages.front();
+    TRI_ASSERT(!message._chunks.empty());
+
+    chunk = std::move(message._chunks.front());
+    message._chunks.pop_front();
+
+    if (message._chunks.empty()) {
+      extra = message._extra;
+      _messages.pop_front();
+    } else {
+      extra = nullptr;
+
+      if (_messages.size() > 1) {
+        _messages.emplace_back(std::move(message));
+        _messages.pop_front();
+      }
+    }
+
+    return true;
+  }
+
+  /// @brief calls f with the extra pointers of all messages that still
+  /// have chunks left
+  template <typename F>
+  void forEachExtra(F const& f) const {
+    for (auto const& message : _messages) {
+      f(message._extra);
+    }
+  }
+
+ private:
+  struct Message {
+    std::deque<Chunk> _chunks;
+    Extra* _extra;
+  };
+
+  std::deque<Message> _messages;
+};
+}
+}
+
+#endif
@@ -28,6 +28,7 @@
 #include "Basics/HybridLogicalClock.h"
 #include "Basics/MutexLocker.h"
 #include "Basics/StaticStrings.h"
+#include "Cluster/ServerState.h"
 #include "GeneralServer/AsyncJobManager.h"
 #include "GeneralServer/GeneralServer.h"
 #include "GeneralServer/GeneralServerFeature.h"
@@ -235,14 +236,14 @@ bool GeneralCommTask::handleRequest(std::shared_ptr<RestHandler> handler) {
   }
 
   if (_loop._scheduler->isIdle()) {
-    handleRequestDirectly(std::move(handler));
+    handleRequestNow(std::move(handler));
     return true;
   }
 
   bool startThread = handler->needsOwnThread();
 
   if (startThread) {
-    handleRequestDirectly(std::move(handler));
+    handleRequestNow(std::move(handler));
     return true;
   }
 
@@ -251,16 +252,32 @@ bool GeneralCommTask::handleRequest(std::shared_ptr<RestHandler> handler) {
                                     << _loop._scheduler->infoStatus();
   size_t queue = handler->queue();
   uint64_t messageId = handler->messageId();
+  JobQueue* jobQueue = SchedulerFeature::SCHEDULER->jobQueue();
+
+  // shed low-priority load while the queue is overloaded. requests of
+  // other cluster members are never rejected, as a DB server cannot tell
+  // them apart from anything else it receives
+  if (jobQueue->shouldShed(queue) && !ServerState::instance()->isDBServer()) {
+    LOG_TOPIC(DEBUG, Logger::THREADS)
+        << "queue #" << queue << " is overloaded, rejecting request";
+    handleSimpleError(rest::ResponseCode::SERVICE_UNAVAILABLE,
+                      TRI_ERROR_QUEUE_FULL,
+                      TRI_errno_string(TRI_ERROR_QUEUE_FULL), messageId);
+    // the request has been answered
+    return true;
+  }
+
+  RequestStatistics::SET_QUEUE_START(handler->statistics());
 
   auto self = shared_from_this();
   std::unique_ptr<Job> job(
       new Job(_server, std::move(handler),
               [self, this](std::shared_ptr<RestHandler> h) {
+                RequestStatistics::SET_QUEUE_END(h->statistics());
                 handleRequestDirectly(h);
               }));
 
-  bool ok =
-      SchedulerFeature::SCHEDULER->jobQueue()->queue(queue, std::move(job));
+  bool ok = jobQueue->queue(queue, std::move(job));
 
   if (!ok) {
     handleSimpleError(rest::ResponseCode::SERVER_ERROR, TRI_ERROR_QUEUE_FULL,
@@ -270,6 +287,19 @@ bool GeneralCommTask::handleRequest(std::shared_ptr<RestHandler> handler) {
   return ok;
 }
 
+void GeneralCommTask::handleRequestNow(std::shared_ptr<RestHandler> handler) {
+  if (!_loop._scheduler->isIoLoop(_loop)) {
+    handleRequestDirectly(std::move(handler));
+    return;
+  }
+
+  // hand the request over to a scheduler thread, so that the thread of the
+  // I/O loop goes on serving the other connections of the loop
+  auto self = shared_from_this();
+  _loop._scheduler->post(
+      [self, this, handler]() { handleRequestDirectly(handler); });
+}
+
 void GeneralCommTask::handleRequestDirectly(
     std::shared_ptr<RestHandler> handler) {
   auto self = shared_from_this();
@@ -67,8 +67,8 @@ class GeneralServer;
 //     an error has occurred.
 //
 //     It is the responsibility of the sub-class to govern what is supported.
-//     For example, HTTP will only support one active request executing at a
-//     time until the final response has been send out.
+//     For example, HTTP executes pipelined requests with safe methods at the
+//     same time, but sends the responses in the order of the requests.
 //
 //     VelocyPack on the other hand, allows multiple active requests. Partial
 //     responses are identified by a request id.
@@ -127,6 +127,7 @@ class GeneralCommTask : public SocketTask {
 
  private:
   bool handleRequest(std::shared_ptr<RestHandler>);
+  void handleRequestNow(std::shared_ptr<RestHandler>);
   void handleRequestDirectly(std::shared_ptr<RestHandler>);
   bool handleRequestAsync(std::shared_ptr<RestHandler>,
                           uint64_t* jobId = nullptr);
@@ -39,31 +39,34 @@ using namespace arangodb::rest;
 
 GeneralListenTask::GeneralListenTask(EventLoop loop, GeneralServer* server,
                                      Endpoint* endpoint,
-                                     ProtocolType connectionType)
+                                     ProtocolType connectionType,
+                                     bool reusePort)
     : Task(loop, "GeneralListenTask"),
-      ListenTask(loop, endpoint),
+      ListenTask(loop, endpoint, reusePort),
       _server(server),
       _connectionType(connectionType) {
   _keepAliveTimeout = GeneralServerFeature::keepAliveTimeout();
 }
 
-void GeneralListenTask::handleConnected(std::unique_ptr<Socket> socket,
-                                        ConnectionInfo&& info) {
+namespace {
+void startCommTask(EventLoop loop, GeneralServer* server,
+                   ProtocolType connectionType, double keepAliveTimeout,
+                   std::unique_ptr<Socket> socket, ConnectionInfo&& info) {
   std::shared_ptr<GeneralCommTask> commTask;
 
-  switch (_connectionType) {
+  switch (connectionType) {
     case ProtocolType::VPPS:
     case ProtocolType::VPP:
       commTask =
-          std::make_shared<VppCommTask>(_loop, _server, std::move(socket),
-                                        std::move(info), _keepAliveTimeout);
+          std::make_shared<VppCommTask>(loop, server, std::move(socket),
+                                        std::move(info), keepAliveTimeout);
       break;
 
     case ProtocolType::HTTPS:
     case ProtocolType::HTTP:
       commTask =
-          std::make_shared<HttpCommTask>(_loop, _server, std::move(socket),
-                                         std::move(info), _keepAliveTimeout);
+          std::make_shared<HttpCommTask>(loop, server, std::move(socket),
+                                         std::move(info), keepAliveTimeout);
       break;
 
     default:
@@ -73,3 +76,46 @@ void GeneralListenTask::handleConnected(std::unique_ptr<Socket> socket,
 
   commTask->start();
 }
+}
+
+void GeneralListenTask::handleConnected(std::unique_ptr<Socket> socket,
+                                        ConnectionInfo&& info) {
+  if (socket->_encrypted) {
+    // the handshake needs several round trips and expensive cryptography.
+    // it runs on the handshake threads, and the comm task is created
+    // afterwards. the job must not refer to the listen task, which may be
+    // gone when it runs
+    auto peer = std::make_shared<std::unique_ptr<Socket>>(std::move(socket));
+    auto connectionInfo = std::make_shared<ConnectionInfo>(std::move(info));
+
+    EventLoop loop = _loop;
+    GeneralServer* server = _server;
+    ProtocolType connectionType = _connectionType;
+    double keepAliveTimeout = _keepAliveTimeout;
+
+    bool posted = _loop._scheduler->postHandshake(
+        [loop, server, connectionType, keepAliveTimeout, peer,
+         connectionInfo]() {
+          (*peer)->setNonBlocking(true);
+
+          if (!(*peer)->handshake()) {
+            (*peer)->close();
+            return;
+          }
+
+          startCommTask(loop, server, connectionType, keepAliveTimeout,
+                        std::move(*peer), std::move(*connectionInfo));
+        });
+
+    if (posted) {
+      return;
+    }
+
+    // no handshake threads. the comm task performs the handshake itself
+    socket = std::move(*peer);
+    info = std::move(*connectionInfo);
+  }
+
+  startCommTask(_loop, _server, _connectionType, _keepAliveTimeout,
+                std::move(socket), std::move(info));
+}
@@ -43,7 +43,7 @@ class GeneralListenTask : public ListenTask {
 
  public:
   GeneralListenTask(EventLoop, GeneralServer*, Endpoint*,
-                    ProtocolType connectionType);
+                    ProtocolType connectionType, bool reusePort = false);
 
  protected:
   void handleConnected(std::unique_ptr<Socket>,
@@ -106,14 +106,41 @@ bool GeneralServer::openEndpoint(Endpoint* endpoint) {
     }
   }
 
-  std::unique_ptr<ListenTask> task(new GeneralListenTask(
-      SchedulerFeature::SCHEDULER->eventLoop(), this, endpoint, protocolType));
-  task->start();
+  Scheduler* scheduler = SchedulerFeature::SCHEDULER;
 
-  if (!task->isBound()) {
-    return false;
+  if (scheduler->numIoLoops() == 0) {
+    std::unique_ptr<ListenTask> task(new GeneralListenTask(
+        scheduler->eventLoop(), this, endpoint, protocolType));
+    task->start();
+
+    if (!task->isBound()) {
+      return false;
+    }
+
+    _listenTasks.emplace_back(task.release());
+    return true;
+  }
+
+  // every dedicated I/O loop accepts on its own socket, so that the kernel
+  // balances the connections among the loops. a connection then stays on
+  // the loop that accepted it. unix domain sockets cannot share their path,
+  // they are accepted on the first loop only
+  size_t const n = (endpoint->domainType() == Endpoint::DomainType::UNIX)
+                       ? 1
+                       : scheduler->numIoLoops();
+
+  for (size_t i = 0; i < n; ++i) {
+    std::unique_ptr<ListenTask> task(
+        new GeneralListenTask(scheduler->ioEventLoop(i), this, endpoint,
+                              protocolType, n > 1));
+    task->start();
+
+    if (!task->isBound()) {
+      return false;
+    }
+
+    _listenTasks.emplace_back(task.release());
   }
 
-  _listenTasks.emplace_back(task.release());
   return true;
 }
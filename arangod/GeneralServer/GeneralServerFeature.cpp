@@ -55,6 +55,8 @@
 #include "RestHandler/RestHandlerCreator.h"
 #include "RestHandler/RestImportHandler.h"
 #include "RestHandler/RestJobHandler.h"
+#include "RestHandler/RestMemoryHandler.h"
+#include "RestHandler/RestMetricsHandler.h"
 #include "RestHandler/RestPleaseUpgradeHandler.h"
 #include "RestHandler/RestQueryCacheHandler.h"
 #include "RestHandler/RestQueryHandler.h"
@@ -129,6 +131,33 @@ void GeneralServerFeature::collectOptions(
                      "keep-alive timeout in seconds",
                      new DoubleParameter(&_keepAliveTimeout));
 
+  options->addOption("--http.slow-request-threshold",
+                     "log requests that take longer than this many seconds, "
+                     "with the time spent in each phase (0 = off)",
+                     new DoubleParameter(&_slowRequestThreshold));
+
+  options->addOption("--http.async-results-max-memory",
+                     "maximum number of bytes used by the stored results of "
+                     "async jobs. the oldest results are dropped when the "
+                     "limit is exceeded (0 = unlimited)",
+                     new UInt64Parameter(&_asyncResultsMaxMemory));
+
+  options->addOption("--http.async-results-ttl",
+                     "drop the stored results of async jobs that have not "
+                     "been fetched within this many seconds (0 = never)",
+                     new DoubleParameter(&_asyncResultsTtl));
+
+  options->addOption("--http.compress-response-threshold",
+                     "compress response bodies of at least this many bytes "
+                     "if the client accepts gzip, deflate or snappy via "
+                     "Accept-Encoding (0 = never compress)",
+                     new UInt64Parameter(&_compressResponseThreshold));
+
+  options->addOption("--http.compression-level",
+                     "zlib compression level for gzip and deflate encoded "
+                     "responses, from 1 (fastest) to 9 (smallest)",
+                     new UInt32Parameter(&_compressionLevel));
+
   options->addOption(
       "--http.hide-product-header",
       "do not expose \"Server: ArangoDB\" header in HTTP responses",
@@ -152,6 +181,27 @@ void GeneralServerFeature::collectOptions(
 }
 
 void GeneralServerFeature::validateOptions(std::shared_ptr<ProgramOptions>) {
+  if (_slowRequestThreshold < 0.0) {
+    LOG_TOPIC(FATAL, arangodb::Logger::FIXME)
+        << "invalid value for --http.slow-request-threshold, expecting a "
+           "value of at least 0";
+    FATAL_ERROR_EXIT();
+  }
+
+  if (_compressionLevel < 1 || _compressionLevel > 9) {
+    LOG_TOPIC(FATAL, arangodb::Logger::FIXME)
+        << "invalid value for --http.compression-level, expecting a "
+           "value between 1 and 9";
+    FATAL_ERROR_EXIT();
+  }
+
+  if (_asyncResultsTtl < 0.0) {
+    LOG_TOPIC(FATAL, arangodb::Logger::FIXME)
+        << "invalid value for --http.async-results-ttl, expecting a "
+           "value of at least 0";
+    FATAL_ERROR_EXIT();
+  }
+
   if (!_accessControlAllowOrigins.empty()) {
     // trim trailing slash from all members
     for (auto& it : _accessControlAllowOrigins) {
@@ -235,7 +285,8 @@ void GeneralServerFeature::prepare() {
 }
 
 void GeneralServerFeature::start() {
-  _jobManager.reset(new AsyncJobManager);
+  _jobManager.reset(
+      new AsyncJobManager(_asyncResultsMaxMemory, _asyncResultsTtl));
 
   JOB_MANAGER = _jobManager.get();
 
@@ -477,11 +528,16 @@ void GeneralServerFeature::defineHandlers() {
   _handlerFactory->addHandler(
       "/_admin/json-echo", RestHandlerCreator<RestEchoHandler>::createNoData);
 
-#ifdef ARANGODB_ENABLE_FAILURE_TESTS
-  // This handler is to activate SYS_DEBUG_FAILAT on DB servers
+  _handlerFactory->addHandler(
+      "/_admin/metrics", RestHandlerCreator<RestMetricsHandler>::createNoData);
+
+  _handlerFactory->addPrefixHandler(
+      "/_admin/memory", RestHandlerCreator<RestMemoryHandler>::createNoData);
+
+  // This handler is to activate SYS_DEBUG_FAILAT on DB servers, and to
+  // take CPU profiles. failure points are only available with failure tests
   _handlerFactory->addPrefixHandler(
       "/_admin/debug", RestHandlerCreator<RestDebugHandler>::createNoData);
-#endif
 
   _handlerFactory->addPrefixHandler(
       "/_admin/shutdown",
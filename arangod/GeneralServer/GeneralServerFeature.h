@@ -69,6 +69,23 @@ class GeneralServerFeature final
     return GENERAL_SERVER->_allowMethodOverride;
   }
 
+  static double slowRequestThreshold() {
+    return GENERAL_SERVER != nullptr ? GENERAL_SERVER->_slowRequestThreshold
+                                     : 0.0;
+  }
+
+  static uint64_t compressResponseThreshold() {
+    return GENERAL_SERVER != nullptr
+               ? GENERAL_SERVER->_compressResponseThreshold
+               : 0;
+  }
+
+  static int compressionLevel() {
+    return GENERAL_SERVER != nullptr
+               ? static_cast<int>(GENERAL_SERVER->_compressionLevel)
+               : 1;
+  }
+
   static std::vector<std::string> const& accessControlAllowOrigins() {
     static std::vector<std::string> empty;
 
@@ -95,7 +112,12 @@ class GeneralServerFeature final
 
  private:
   double _keepAliveTimeout = 300.0;
+  double _slowRequestThreshold = 0.0;
+  uint64_t _asyncResultsMaxMemory = 256 * 1024 * 1024;
+  double _asyncResultsTtl = 0.0;
   bool _allowMethodOverride;
+  uint64_t _compressResponseThreshold = 64 * 1024;
+  uint32_t _compressionLevel = 1;
 
   bool _proxyCheck;
   std::vector<std::string> _trustedProxies;
@@ -27,6 +27,7 @@
 #include "Basics/HybridLogicalClock.h"
 #include "GeneralServer/GeneralServer.h"
 #include "GeneralServer/GeneralServerFeature.h"
+#include "GeneralServer/ResponseCompression.h"
 #include "GeneralServer/RestHandler.h"
 #include "GeneralServer/RestHandlerFactory.h"
 #include "GeneralServer/VppCommTask.h"
@@ -43,6 +44,8 @@ size_t const HttpCommTask::MaximalHeaderSize = 2 * 1024 * 1024;       //    2 MB
 size_t const HttpCommTask::MaximalBodySize = 1024 * 1024 * 1024;      // 1024 MB
 size_t const HttpCommTask::MaximalPipelineSize = 1024 * 1024 * 1024;  // 1024 MB
 size_t const HttpCommTask::RunCompactEvery = 500;
+size_t const HttpCommTask::MaximalPipelinedRequests = 64;
+size_t const HttpCommTask::MinimalSeparateBodySize = 32 * 1024;
 
 HttpCommTask::HttpCommTask(EventLoop loop, GeneralServer* server,
                            std::unique_ptr<Socket> socket,
@@ -61,6 +64,7 @@ HttpCommTask::HttpCommTask(EventLoop loop, GeneralServer* server,
       _requestType(rest::RequestType::ILLEGAL),
       _fullUrl(),
       _origin(),
+      _acceptEncoding(rest::ContentEncoding::IDENTITY),
       _sinceCompactification(0),
       _originalBodyLength(0) {
   _protocol = "http";
@@ -69,15 +73,17 @@ HttpCommTask::HttpCommTask(EventLoop loop, GeneralServer* server,
 }
 
 void HttpCommTask::handleSimpleError(rest::ResponseCode code,
-                                     uint64_t /* messageId */) {
-  std::unique_ptr<GeneralResponse> response(new HttpResponse(code));
-  addResponse(response.get(), stealStatistics(1UL));
+                                     uint64_t messageId) {
+  std::unique_ptr<HttpResponse> response(new HttpResponse(code));
+  response->setMessageId(messageId);
+  addResponse(response.get(), stealStatistics(messageId));
 }
 
 void HttpCommTask::handleSimpleError(rest::ResponseCode code, int errorNum,
                                      std::string const& errorMessage,
-                                     uint64_t /* messageId */) {
-  std::unique_ptr<GeneralResponse> response(new HttpResponse(code));
+                                     uint64_t messageId) {
+  std::unique_ptr<HttpResponse> response(new HttpResponse(code));
+  response->setMessageId(messageId);
 
   VPackBuilder builder;
   builder.openObject();
@@ -89,7 +95,7 @@ void HttpCommTask::handleSimpleError(rest::ResponseCode code, int errorNum,
 
   try {
     response->setPayload(builder.slice(), true, VPackOptions::Defaults);
-    addResponse(response.get(), stealStatistics(1UL));
+    addResponse(response.get(), stealStatistics(messageId));
   } catch (std::exception const& ex) {
     LOG_TOPIC(WARN, Logger::COMMUNICATION)
         << "handleSimpleError received an exception, closing connection:"
@@ -105,22 +111,56 @@ void HttpCommTask::handleSimpleError(rest::ResponseCode code, int errorNum,
 void HttpCommTask::addResponse(HttpResponse* response, RequestStatistics* stat) {
   resetKeepAlive();
 
-  // response has been queued, allow further requests
-  _requestPending = false;
+  uint64_t const messageId = response->messageId();
+
+  if (stat == nullptr) {
+    stat = stealStatistics(messageId);
+  }
+
+  RequestInfo info;
+
+  {
+    MUTEX_LOCKER(locker, _responseLock);
+
+    auto it = _requestsInFlight.find(messageId);
+
+    if (it != _requestsInFlight.end()) {
+      info = std::move(it->second);
+      _requestsInFlight.erase(it);
+
+      if (info._exclusive) {
+        _exclusiveInFlight = false;
+      }
+    } else if (_responses.hasResponse(messageId)) {
+      // there must be only one response per request
+      LOG_TOPIC(DEBUG, Logger::COMMUNICATION)
+          << "ignoring additional response for request #" << messageId;
+
+      if (stat != nullptr) {
+        stat->release();
+      }
+      return;
+    } else {
+      // the request that is currently being read is answered before it
+      // was handled, e.g. because it is malformed. this happens in the
+      // thread that reads the request only
+      info = currentRequestInfo(false);
+    }
+  }
 
   // CORS response handling
-  if (!_origin.empty()) {
+  if (!info._origin.empty()) {
     // the request contained an Origin header. We have to send back the
     // access-control-allow-origin header now
     LOG_TOPIC(TRACE, arangodb::Logger::FIXME) << "handling CORS response";
 
     // send back original value of "Origin" header
     response->setHeaderNCIfNotSet(StaticStrings::AccessControlAllowOrigin,
-                                  _origin);
+                                  info._origin);
 
     // send back "Access-Control-Allow-Credentials" header
     response->setHeaderNCIfNotSet(StaticStrings::AccessControlAllowCredentials,
-                                  (_denyCredentials ? "false" : "true"));
+                                  (info._denyCredentials ? "false" : "true"));
 
     // use "IfNotSet" here because we should not override HTTP headers set
     // by Foxx applications
@@ -133,24 +173,51 @@ void HttpCommTask::addResponse(HttpResponse* response, RequestStatistics* stat)
                                   ? rest::ConnectionType::C_CLOSE
                                   : rest::ConnectionType::C_KEEP_ALIVE);
 
+  // compress the body if the client accepts it. bodies that already have
+  // an encoding, e.g. set by Foxx, are sent as they are
+  if (info._acceptEncoding != rest::ContentEncoding::IDENTITY &&
+      info._requestType != rest::RequestType::HEAD &&
+      !response->hasHeaderNC(StaticStrings::ContentEncoding) &&
+      !response->hasHeaderNC(StaticStrings::TransferEncoding)) {
+    StringBuffer compressed(TRI_UNKNOWN_MEM_ZONE, false);
+
+    if (ResponseCompression::compress(info._acceptEncoding,
+                                      response->body().c_str(),
+                                      response->body().length(), compressed)) {
+      response->body().swap(&compressed);
+      response->setHeaderNC(StaticStrings::ContentEncoding,
+                            ResponseCompression::name(info._acceptEncoding));
+      response->setHeaderNC(StaticStrings::Vary, StaticStrings::AcceptEncoding);
+    }
+  }
+
   size_t const responseBodyLength = response->bodySize();
 
-  if (_requestType == rest::RequestType::HEAD) {
+  if (info._requestType == rest::RequestType::HEAD) {
     // clear body if this is an HTTP HEAD request
     // HEAD must not return a body
     response->headResponse(responseBodyLength);
   }
 
+  // large bodies are sent directly from the response, all others are
+  // copied behind the header
+  bool const separateBody = (info._requestType != rest::RequestType::HEAD &&
+                             responseBodyLength >= MinimalSeparateBodySize);
+
   // reserve a buffer with some spare capacity
   WriteBuffer buffer(
-      new StringBuffer(TRI_UNKNOWN_MEM_ZONE, responseBodyLength + 128, false),
+      new StringBuffer(TRI_UNKNOWN_MEM_ZONE,
+                       (separateBody ? 0 : responseBodyLength) + 128, false),
       stat);
 
   // write header
   response->writeHeader(buffer._buffer);
 
   // write body
-  if (_requestType != rest::RequestType::HEAD) {
+  if (separateBody) {
+    buffer._body = new StringBuffer(TRI_UNKNOWN_MEM_ZONE, false);
+    buffer._body->swap(&response->body());
+  } else if (info._requestType != rest::RequestType::HEAD) {
     buffer._buffer->appendText(response->body());
   }
 
@@ -158,7 +225,8 @@ void HttpCommTask::addResponse(HttpResponse* response, RequestStatistics* stat)
 
   if (!buffer._buffer->empty()) {
     LOG_TOPIC(TRACE, Logger::REQUESTS)
-        << "\"http-request-response\",\"" << (void*)this << "\",\"" << _fullUrl
+        << "\"http-request-response\",\"" << (void*)this << "\",\""
+        << info._fullUrl
         << "\",\"" << StringUtils::escapeUnicode(std::string(
                           buffer._buffer->c_str(), buffer._buffer->length()))
         << "\"";
@@ -166,17 +234,25 @@ void HttpCommTask::addResponse(HttpResponse* response, RequestStatistics* stat)
 
   // append write buffer and statistics
   double const totalTime = RequestStatistics::ELAPSED_SINCE_READ_START(stat);
-  addWriteBuffer(buffer);
+
+  {
+    MUTEX_LOCKER(locker, _responseLock);
+
+    // responses to pipelined requests must be sent in the order of the
+    // requests
+    _responses.add(messageId, std::move(buffer),
+                   [this](WriteBuffer& ready) { addWriteBuffer(ready); });
+  }
 
   // and give some request information
   LOG_TOPIC(INFO, Logger::REQUESTS)
       << "\"http-request-end\",\"" << (void*)this << "\",\""
       << _connectionInfo.clientAddress << "\",\""
-      << HttpRequest::translateMethod(_requestType) << "\",\""
+      << HttpRequest::translateMethod(info._requestType) << "\",\""
       << HttpRequest::translateVersion(_protocolVersion) << "\","
       << static_cast<int>(response->responseCode()) << ","
-      << _originalBodyLength << "," << responseBodyLength << ",\"" << _fullUrl
-      << "\"," << Logger::FIXED(totalTime, 6);
+      << info._originalBodyLength << "," << responseBodyLength << ",\""
+      << info._fullUrl << "\"," << Logger::FIXED(totalTime, 6);
 
   // clear body
   response->body().clear();
@@ -188,8 +264,9 @@ bool HttpCommTask::processRead(double startTime) {
 
   TRI_ASSERT(_readBuffer.c_str() != nullptr);
 
-  if (_requestPending) {
-    return false;
+  if (_requestWaiting) {
+    // a complete request is waiting for earlier requests to finish
+    return dispatchRequest();
   }
 
   RequestStatistics* stat = nullptr;
@@ -206,8 +283,15 @@ bool HttpCommTask::processRead(double startTime) {
 
     // starting a new request
     if (_newRequest) {
+      if (!canStartRequest()) {
+        // too many pipelined requests, read on when some have been answered
+        return false;
+      }
+
+      ++_messageId;
+
       // acquire a new statistics entry for the request
-      stat = acquireStatistics(1UL);
+      stat = acquireStatistics(_messageId);
       RequestStatistics::SET_READ_START(stat, startTime);
 
       _newRequest = false;
@@ -216,6 +300,7 @@ bool HttpCommTask::processRead(double startTime) {
       _requestType = rest::RequestType::ILLEGAL;
       _fullUrl = "";
       _denyCredentials = true;
+      _acceptEncoding = rest::ContentEncoding::IDENTITY;
 
       _sinceCompactification++;
     }
@@ -244,7 +329,7 @@ bool HttpCommTask::processRead(double startTime) {
 
       // header is too large
       handleSimpleError(rest::ResponseCode::REQUEST_HEADER_FIELDS_TOO_LARGE,
-                        1);  // ID does not matter for http (http default is 1)
+                        _messageId);
 
       return false;
     }
@@ -289,6 +374,7 @@ bool HttpCommTask::processRead(double startTime) {
       GeneralServerFeature::HANDLER_FACTORY->setRequestContext(
           _incompleteRequest.get());
       _incompleteRequest->setClientTaskId(_taskId);
+      _incompleteRequest->setMessageId(_messageId);
 
       // check HTTP protocol version
       _protocolVersion = _incompleteRequest->protocolVersion();
@@ -296,7 +382,7 @@ bool HttpCommTask::processRead(double startTime) {
       if (_protocolVersion != rest::ProtocolVersion::HTTP_1_0 &&
           _protocolVersion != rest::ProtocolVersion::HTTP_1_1) {
         handleSimpleError(rest::ResponseCode::HTTP_VERSION_NOT_SUPPORTED,
-                          1);  // FIXME
+                          _messageId);
 
         return false;
       }
@@ -306,7 +392,7 @@ bool HttpCommTask::processRead(double startTime) {
 
       if (_fullUrl.size() > 16384) {
         handleSimpleError(rest::ResponseCode::REQUEST_URI_TOO_LONG,
-                          1);  // FIXME
+                          _messageId);
         return false;
       }
 
@@ -357,11 +443,16 @@ bool HttpCommTask::processRead(double startTime) {
         }
       }
 
+      // choose the encoding of the response body now, the request object is
+      // gone when the response is written
+      _acceptEncoding = ResponseCompression::negotiate(
+          _incompleteRequest->header(StaticStrings::AcceptEncoding));
+
       // store the original request's type. we need it later when responding
       // (original request object gets deleted before responding)
       _requestType = _incompleteRequest->requestType();
 
-      stat = statistics(1UL);
+      stat = statistics(_messageId);
       RequestStatistics::SET_REQUEST_TYPE(stat, _requestType);
 
       // handle different HTTP methods
@@ -405,7 +496,8 @@ bool HttpCommTask::processRead(double startTime) {
                     << "'";
 
           // bad request, method not allowed
-          handleSimpleError(rest::ResponseCode::METHOD_NOT_ALLOWED, 1);
+          handleSimpleError(rest::ResponseCode::METHOD_NOT_ALLOWED,
+                            _messageId);
           return false;
         }
       }
@@ -419,13 +511,20 @@ bool HttpCommTask::processRead(double startTime) {
         if (found && StringUtils::trim(expect) == "100-continue") {
           LOG_TOPIC(TRACE, arangodb::Logger::FIXME) << "received a 100-continue request";
 
-          WriteBuffer buffer(new StringBuffer(TRI_UNKNOWN_MEM_ZONE), nullptr);
+          MUTEX_LOCKER(locker, _responseLock);
 
-          buffer._buffer->appendText(
-              TRI_CHAR_LENGTH_PAIR("HTTP/1.1 100 (Continue)\r\n\r\n"));
-          buffer._buffer->ensureNullTerminated();
+          // the interim response must not overtake the responses to earlier
+          // pipelined requests. the client will send the body anyway
+          if (_responses.next() == _messageId) {
+            WriteBuffer buffer(new StringBuffer(TRI_UNKNOWN_MEM_ZONE),
+                               nullptr);
 
-          addWriteBuffer(buffer);
+            buffer._buffer->appendText(
+                TRI_CHAR_LENGTH_PAIR("HTTP/1.1 100 (Continue)\r\n\r\n"));
+            buffer._buffer->ensureNullTerminated();
+
+            addWriteBuffer(buffer);
+          }
         }
       }
     } else {
@@ -453,20 +552,20 @@ bool HttpCommTask::processRead(double startTime) {
         if (!StringUtils::gzipUncompress(_readBuffer.c_str() + _bodyPosition,
                                          _bodyLength, uncompressed)) {
           handleSimpleError(rest::ResponseCode::BAD, TRI_ERROR_BAD_PARAMETER,
-                            "gzip decoding error", 1);
+                            "gzip decoding error", _messageId);
           return false;
         }
-        _incompleteRequest->setBody(uncompressed.c_str(), uncompressed.size());
+        _incompleteRequest->setBody(std::move(uncompressed));
         handled = true;
       } else if (encoding == "deflate") {
         std::string uncompressed;
         if (!StringUtils::gzipDeflate(_readBuffer.c_str() + _bodyPosition,
                                       _bodyLength, uncompressed)) {
           handleSimpleError(rest::ResponseCode::BAD, TRI_ERROR_BAD_PARAMETER,
-                            "gzip deflate error", 1);
+                            "gzip deflate error", _messageId);
           return false;
         }
-        _incompleteRequest->setBody(uncompressed.c_str(), uncompressed.size());
+        _incompleteRequest->setBody(std::move(uncompressed));
         handled = true;
       }
     }
@@ -490,13 +589,23 @@ bool HttpCommTask::processRead(double startTime) {
 
   auto bytes = _bodyPosition - _startPosition + _bodyLength;
 
-  stat = statistics(1UL);
+  stat = statistics(_messageId);
   RequestStatistics::SET_READ_END(stat);
   RequestStatistics::ADD_RECEIVED_BYTES(stat, bytes);
 
-  bool const isOptionsRequest = (_requestType == rest::RequestType::OPTIONS);
   resetState();
 
+  return dispatchRequest();
+}
+
+// handles the complete request, unless it has to wait for earlier pipelined
+// requests. requests with safe methods run concurrently, all other requests
+// run on their own, so that they are executed in the order they were sent
+bool HttpCommTask::dispatchRequest() {
+  TRI_ASSERT(_incompleteRequest != nullptr);
+
+  bool const isOptionsRequest = (_requestType == rest::RequestType::OPTIONS);
+
   // .............................................................................
   // keep-alive handling
   // .............................................................................
@@ -505,27 +614,53 @@ bool HttpCommTask::processRead(double startTime) {
   std::string connectionType = StringUtils::tolower(
       _incompleteRequest->header(StaticStrings::Connection));
 
+  bool closeRequested = false;
+
   if (connectionType == "close") {
     // client has sent an explicit "Connection: Close" header. we should close
     // the connection
     LOG_TOPIC(DEBUG, arangodb::Logger::FIXME) << "connection close requested by client";
-    _closeRequested = true;
+    closeRequested = true;
   } else if (_incompleteRequest->isHttp10() && connectionType != "keep-alive") {
     // HTTP 1.0 request, and no "Connection: Keep-Alive" header sent
     // we should close the connection
     LOG_TOPIC(DEBUG, arangodb::Logger::FIXME) << "no keep-alive, connection close requested by client";
-    _closeRequested = true;
+    closeRequested = true;
 
   } else if (!_useKeepAliveTimer) {
     // if keepAliveTimeout was set to 0.0, we'll close even keep-alive
     // connections immediately
     LOG_TOPIC(DEBUG, arangodb::Logger::FIXME) << "keep-alive disabled by admin";
-    _closeRequested = true;
+    closeRequested = true;
   }
 
   // we keep the connection open in all other cases (HTTP 1.1 or Keep-Alive
   // header sent)
 
+  bool const exclusive = closeRequested ||
+                         (_requestType != rest::RequestType::GET &&
+                          _requestType != rest::RequestType::HEAD &&
+                          _requestType != rest::RequestType::OPTIONS);
+
+  {
+    MUTEX_LOCKER(locker, _responseLock);
+
+    if (_exclusiveInFlight || (exclusive && !_requestsInFlight.empty())) {
+      // read on when the earlier requests have been answered
+      _requestWaiting = true;
+      return false;
+    }
+
+    _requestsInFlight.emplace(_messageId, currentRequestInfo(exclusive));
+    _exclusiveInFlight = exclusive;
+  }
+
+  _requestWaiting = false;
+
+  if (closeRequested) {
+    _closeRequested = true;
+  }
+
   // .............................................................................
   // authenticate
   // .............................................................................
@@ -545,14 +680,16 @@ bool HttpCommTask::processRead(double startTime) {
   // not found
   else if (authResult == rest::ResponseCode::NOT_FOUND) {
     handleSimpleError(authResult, TRI_ERROR_ARANGO_DATABASE_NOT_FOUND,
-                      TRI_errno_string(TRI_ERROR_ARANGO_DATABASE_NOT_FOUND), 1);
+                      TRI_errno_string(TRI_ERROR_ARANGO_DATABASE_NOT_FOUND),
+                      _messageId);
   }
   // forbidden
   else if (authResult == rest::ResponseCode::FORBIDDEN) {
     handleSimpleError(authResult, TRI_ERROR_USER_CHANGE_PASSWORD,
-                      "change password", 1);
+                      "change password", _messageId);
   } else {  // not authenticated
     HttpResponse response(rest::ResponseCode::UNAUTHORIZED);
+    response.setMessageId(_messageId);
     std::string realm = "Bearer token_type=\"JWT\", realm=\"ArangoDB\"";
 
     response.setHeaderNC(StaticStrings::WwwAuthenticate, std::move(realm));
@@ -564,6 +701,19 @@ bool HttpCommTask::processRead(double startTime) {
   return true;
 }
 
+// whether another request may be read, which limits the number of requests
+// waiting for their responses
+bool HttpCommTask::canStartRequest() {
+  MUTEX_LOCKER(locker, _responseLock);
+  return _messageId + 1 - _responses.next() < MaximalPipelinedRequests;
+}
+
+HttpCommTask::RequestInfo HttpCommTask::currentRequestInfo(
+    bool exclusive) const {
+  return RequestInfo{_requestType, _denyCredentials, _origin, _fullUrl,
+                     _originalBodyLength, exclusive, _acceptEncoding};
+}
+
 void HttpCommTask::processRequest(std::unique_ptr<HttpRequest> request) {
   {
     LOG_TOPIC(DEBUG, Logger::REQUESTS)
@@ -596,9 +746,10 @@ void HttpCommTask::processRequest(std::unique_ptr<HttpRequest> request) {
   }
 
   // create a handler and execute
-  std::unique_ptr<GeneralResponse> response(
+  std::unique_ptr<HttpResponse> response(
       new HttpResponse(rest::ResponseCode::SERVER_ERROR));
 
+  response->setMessageId(request->messageId());
   response->setContentType(request->contentTypeResponse());
   response->setContentTypeRequested(request->contentTypeResponse());
 
@@ -615,7 +766,7 @@ bool HttpCommTask::checkContentLength(HttpRequest* request,
 
   if (bodyLength < 0) {
     // bad request, body length is < 0. this is a client error
-    handleSimpleError(rest::ResponseCode::LENGTH_REQUIRED);
+    handleSimpleError(rest::ResponseCode::LENGTH_REQUIRED, _messageId);
     return false;
   }
 
@@ -633,7 +784,7 @@ bool HttpCommTask::checkContentLength(HttpRequest* request,
 
     // request entity too large
     handleSimpleError(rest::ResponseCode::REQUEST_ENTITY_TOO_LARGE,
-                      0);  // FIXME
+                      _messageId);
     return false;
   }
 
@@ -652,6 +803,7 @@ bool HttpCommTask::checkContentLength(HttpRequest* request,
 
 void HttpCommTask::processCorsOptions(std::unique_ptr<HttpRequest> request) {
   HttpResponse response(rest::ResponseCode::OK);
+  response.setMessageId(request->messageId());
 
   response.setHeaderNCIfNotSet(StaticStrings::Allow,
                                StaticStrings::CorsMethods);
@@ -688,13 +840,13 @@ void HttpCommTask::processCorsOptions(std::unique_ptr<HttpRequest> request) {
 }
 
 std::unique_ptr<GeneralResponse> HttpCommTask::createResponse(
-    rest::ResponseCode responseCode, uint64_t /* messageId */) {
-  return std::unique_ptr<GeneralResponse>(new HttpResponse(responseCode));
+    rest::ResponseCode responseCode, uint64_t messageId) {
+  std::unique_ptr<HttpResponse> response(new HttpResponse(responseCode));
+  response->setMessageId(messageId);
+  return std::unique_ptr<GeneralResponse>(response.release());
 }
 
 void HttpCommTask::resetState() {
-  _requestPending = true;
-
   bool compact = false;
 
   if (_sinceCompactification > RunCompactEvery) {
@@ -2,6 +2,7 @@
 #define ARANGOD_GENERAL_SERVER_HTTP_COMM_TASK_H 1
 
 #include "GeneralServer/GeneralCommTask.h"
+#include "GeneralServer/ResponseSequencer.h"
 
 #include "Rest/HttpResponse.h"
 
@@ -15,6 +16,8 @@ class HttpCommTask final : public GeneralCommTask {
   static size_t const MaximalBodySize;
   static size_t const MaximalPipelineSize;
   static size_t const RunCompactEvery;
+  static size_t const MaximalPipelinedRequests;
+  static size_t const MinimalSeparateBodySize;
 
  public:
   HttpCommTask(EventLoop, GeneralServer*, std::unique_ptr<Socket> socket,
@@ -42,13 +45,30 @@ class HttpCommTask final : public GeneralCommTask {
       rest::ResponseCode, uint64_t messageId) override final;
 
   void handleSimpleError(rest::ResponseCode code,
-                         uint64_t messageId = 1) override final;
+                         uint64_t messageId) override final;
 
   void handleSimpleError(rest::ResponseCode, int code,
                          std::string const& errorMessage,
-                         uint64_t messageId = 1) override final;
+                         uint64_t messageId) override final;
 
  private:
+  // the state of a request needed to respond to it
+  struct RequestInfo {
+    rest::RequestType _requestType;
+    bool _denyCredentials;
+    std::string _origin;
+    std::string _fullUrl;
+    size_t _originalBodyLength;
+    // request must not run at the same time as any other request
+    bool _exclusive;
+    // encoding of the response body, negotiated via Accept-Encoding
+    rest::ContentEncoding _acceptEncoding;
+  };
+
+  bool dispatchRequest();
+  bool canStartRequest();
+  RequestInfo currentRequestInfo(bool exclusive) const;
+
   void processRequest(std::unique_ptr<HttpRequest>);
   void processCorsOptions(std::unique_ptr<HttpRequest>);
 
@@ -76,16 +96,37 @@ class HttpCommTask final : public GeneralCommTask {
   std::string _fullUrl;            // value of requested URL
   std::string _origin;  // value of the HTTP origin header the client sent (if
                         // any, CORS only)
+  rest::ContentEncoding _acceptEncoding;  // response encoding the client
+                                          // accepts
   size_t
       _sinceCompactification;  // number of requests since last compactification
   size_t _originalBodyLength;
 
   std::string const _authenticationRealm;
 
-  // true if request is complete but not handled
-  bool _requestPending = false;
+  // true if request is complete but has to wait for earlier pipelined
+  // requests to finish before it can be handled
+  bool _requestWaiting = false;
+
+  // message id of the request being read, requests are numbered in the
+  // order they arrive on the connection
+  uint64_t _messageId = 0;
 
   std::unique_ptr<HttpRequest> _incompleteRequest;
+
+  // protects the following members, which are also accessed by the threads
+  // adding responses
+  Mutex _responseLock;
+
+  // requests that are being handled, by message id
+  std::unordered_map<uint64_t, RequestInfo> _requestsInFlight;
+
+  // whether one of the requests being handled is exclusive
+  bool _exclusiveInFlight = false;
+
+  // responses in the order of the requests. completed responses wait
+  // here for the responses to earlier requests before they are sent
+  ResponseSequencer<WriteBuffer> _responses;
 };
 }
 }
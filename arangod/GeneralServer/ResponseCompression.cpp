@@ -0,0 +1,208 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "ResponseCompression.h"
+
+#include "Basics/StringBuffer.h"
+#include "Basics/StringUtils.h"
+#include "GeneralServer/GeneralServerFeature.h"
+
+#include <snappy.h>
+#include <zlib.h>
+
+using namespace arangodb;
+using namespace arangodb::basics;
+using namespace arangodb::rest;
+
+namespace {
+std::string const Identity("identity");
+std::string const Deflate("deflate");
+std::string const Gzip("gzip");
+std::string const Snappy("snappy");
+
+/// @brief the quality value of one element of an Accept-Encoding header,
+/// e.g. "gzip;q=0.5". a missing or unparsable value counts as 1
+double qualityValue(std::string const& parameters) {
+  size_t const pos = parameters.find("q=");
+
+  if (pos == std::string::npos) {
+    return 1.0;
+  }
+
+  char* end = nullptr;
+  double q = strtod(parameters.c_str() + pos + 2, &end);
+
+  if (end == parameters.c_str() + pos + 2 || q > 1.0) {
+    return 1.0;
+  }
+  return q;
+}
+
+/// @brief compress with zlib. the zlib wrapper is used for deflate, as the
+/// HTTP "deflate" encoding demands it, and the gzip wrapper for gzip
+bool compressZlib(bool gzip, int level, char const* data, size_t length,
+                  StringBuffer& out) {
+  if (length > static_cast<size_t>(UINT32_MAX)) {
+    return false;
+  }
+
+  z_stream strm;
+  memset(&strm, 0, sizeof(strm));
+
+  if (deflateInit2(&strm, level, Z_DEFLATED,
+                   gzip ? (16 + MAX_WBITS) : MAX_WBITS, 8,
+                   Z_DEFAULT_STRATEGY) != Z_OK) {
+    return false;
+  }
+
+  // deflateBound accounts for the wrapper, so the whole output fits into
+  // the buffer and one call suffices
+  uLong const bound = deflateBound(&strm, static_cast<uLong>(length));
+
+  if (out.reserve(bound) != TRI_ERROR_NO_ERROR) {
+    (void)deflateEnd(&strm);
+    return false;
+  }
+
+  strm.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data));
+  strm.avail_in = static_cast<uInt>(length);
+  strm.next_out = reinterpret_cast<Bytef*>(out.end());
+  strm.avail_out = static_cast<uInt>(bound);
+
+  int res = deflate(&strm, Z_FINISH);
+  (void)deflateEnd(&strm);
+
+  if (res != Z_STREAM_END) {
+    return false;
+  }
+
+  out.increaseLength(strm.total_out);
+  return true;
+}
+
+bool compressSnappy(char const* data, size_t length, StringBuffer& out) {
+  if (out.reserve(snappy::MaxCompressedLength(length)) != TRI_ERROR_NO_ERROR) {
+    return false;
+  }
+
+  size_t compressedLength = 0;
+  snappy::RawCompress(data, length, out.end(), &compressedLength);
+  out.increaseLength(compressedLength);
+  return true;
+}
+}
+
+ContentEncoding ResponseCompression::negotiate(
+    std::string const& acceptEncoding) {
+  return negotiate(acceptEncoding,
+                   GeneralServerFeature::compressResponseThreshold() != 0);
+}
+
+ContentEncoding ResponseCompression::negotiate(
+    std::string const& acceptEncoding, bool enabled) {
+  if (acceptEncoding.empty() || !enabled) {
+    return ContentEncoding::IDENTITY;
+  }
+
+  ContentEncoding result = ContentEncoding::IDENTITY;
+  double best = 0.0;
+
+  for (auto const& part : StringUtils::split(acceptEncoding, ',')) {
+    size_t const pos = part.find(';');
+    std::string const coding =
+        StringUtils::tolower(StringUtils::trim(part.substr(0, pos)));
+    double const q = (pos == std::string::npos)
+                         ? 1.0
+                         : qualityValue(part.substr(pos + 1));
+
+    ContentEncoding encoding;
+
+    if (coding == Snappy) {
+      encoding = ContentEncoding::SNAPPY;
+    } else if (coding == Gzip || coding == "x-gzip") {
+      encoding = ContentEncoding::GZIP;
+    } else if (coding == Deflate) {
+      encoding = ContentEncoding::DEFLATE;
+    } else {
+      // identity, "*" and unknown codings do not change anything
+      continue;
+    }
+
+    // the enum values are ordered by preference, so on equal quality the
+    // cheaper coding wins
+    if (q > best || (q == best && q > 0.0 && encoding > result)) {
+      best = q;
+      result = encoding;
+    }
+  }
+
+  return result;
+}
+
+std::string const& ResponseCompression::name(ContentEncoding encoding) {
+  switch (encoding) {
+    case ContentEncoding::DEFLATE:
+      return Deflate;
+    case ContentEncoding::GZIP:
+      return Gzip;
+    case ContentEncoding::SNAPPY:
+      return Snappy;
+    case ContentEncoding::IDENTITY:
+      break;
+  }
+  return Identity;
+}
+
+bool ResponseCompression::compress(ContentEncoding encoding, char const* data,
+                                   size_t length, StringBuffer& out) {
+  return compress(encoding, data, length,
+                  GeneralServerFeature::compressResponseThreshold(),
+                  GeneralServerFeature::compressionLevel(), out);
+}
+
+bool ResponseCompression::compress(ContentEncoding encoding, char const* data,
+                                   size_t length, uint64_t threshold,
+                                   int level, StringBuffer& out) {
+  out.clear();
+
+  if (encoding == ContentEncoding::IDENTITY || threshold == 0 ||
+      length < threshold) {
+    return false;
+  }
+
+  bool ok;
+
+  if (encoding == ContentEncoding::SNAPPY) {
+    ok = compressSnappy(data, length, out);
+  } else {
+    ok = compressZlib(encoding == ContentEncoding::GZIP, level, data, length,
+                      out);
+  }
+
+  if (!ok || out.length() >= length) {
+    // already compressed data, e.g. images served by Foxx, must be sent
+    // as they are
+    out.clear();
+    return false;
+  }
+
+  return true;
+}
@@ -0,0 +1,81 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_GENERAL_SERVER_RESPONSE_COMPRESSION_H
+#define ARANGOD_GENERAL_SERVER_RESPONSE_COMPRESSION_H 1
+
+#include "Basics/Common.h"
+
+#include "Rest/CommonDefines.h"
+
+namespace arangodb {
+namespace basics {
+class StringBuffer;
+}
+
+namespace rest {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief compression of response bodies for HTTP and VelocyStream
+////////////////////////////////////////////////////////////////////////////////
+
+class ResponseCompression {
+ public:
+  ResponseCompression() = delete;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief choose the encoding of a response from the value of the
+  /// Accept-Encoding header of the request. returns IDENTITY if compression
+  /// is turned off or the client does not accept any supported encoding.
+  /// among the accepted encodings with the highest quality value, the one
+  /// that is cheapest to produce is chosen (snappy, then gzip, then deflate)
+  //////////////////////////////////////////////////////////////////////////////
+
+  static ContentEncoding negotiate(std::string const& acceptEncoding);
+
+  /// @brief choose the encoding as above, with compression turned on or off
+  /// explicitly instead of via --http.compress-response-threshold
+  static ContentEncoding negotiate(std::string const& acceptEncoding,
+                                   bool enabled);
+
+  /// @brief the name of an encoding as used in Content-Encoding
+  static std::string const& name(ContentEncoding);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief compress a body of length bytes into out, if it is at least
+  /// --http.compress-response-threshold bytes long. returns false and leaves
+  /// out empty if the body is too small or does not get smaller, in which
+  /// case it must be sent as it is
+  //////////////////////////////////////////////////////////////////////////////
+
+  static bool compress(ContentEncoding, char const* data, size_t length,
+                       basics::StringBuffer& out);
+
+  /// @brief compress as above, with the threshold and the zlib compression
+  /// level given explicitly instead of via the server options
+  static bool compress(ContentEncoding, char const* data, size_t length,
+                       uint64_t threshold, int level,
+                       basics::StringBuffer& out);
+};
+}
+}
+
+#endif
@@ -0,0 +1,76 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_GENERAL_SERVER_RESPONSE_SEQUENCER_H
+#define ARANGOD_GENERAL_SERVER_RESPONSE_SEQUENCER_H 1
+
+#include "Basics/Common.h"
+
+namespace arangodb {
+namespace rest {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief puts the responses to pipelined requests back into the order of
+/// the requests. requests are numbered from 1 in the order they arrive on
+/// the connection. not thread-safe, the caller must synchronize access
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename T>
+class ResponseSequencer {
+ public:
+  /// @brief message id of the response to be sent next
+  uint64_t next() const { return _next; }
+
+  /// @brief whether the response for the message id was already added
+  bool hasResponse(uint64_t messageId) const {
+    return messageId < _next || _waiting.find(messageId) != _waiting.end();
+  }
+
+  /// @brief add the response for the message id. calls send for every
+  /// response that can be sent now, in the order of the requests. a
+  /// response to a later request is kept until the earlier ones are added
+  template <typename F>
+  void add(uint64_t messageId, T&& response, F const& send) {
+    if (messageId != _next) {
+      _waiting.emplace(messageId, std::move(response));
+      return;
+    }
+
+    send(response);
+    ++_next;
+
+    while (!_waiting.empty() && _waiting.begin()->first == _next) {
+      send(_waiting.begin()->second);
+      _waiting.erase(_waiting.begin());
+      ++_next;
+    }
+  }
+
+ private:
+  uint64_t _next = 1;
+
+  // responses that have to wait for the responses to earlier requests
+  std::map<uint64_t, T> _waiting;
+};
+}
+}
+
+#endif
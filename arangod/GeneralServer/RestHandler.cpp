@@ -27,6 +27,7 @@
 
 #include "Basics/StringUtils.h"
 #include "GeneralServer/GeneralCommTask.h"
+#include "GeneralServer/GeneralServerFeature.h"
 #include "Logger/Logger.h"
 #include "Rest/GeneralRequest.h"
 #include "Statistics/RequestStatistics.h"
@@ -79,6 +80,10 @@ RestHandler::~RestHandler() {
 int RestHandler::prepareEngine() {
   RequestStatistics::SET_REQUEST_START(_statistics);
 
+  if (GeneralServerFeature::slowRequestThreshold() > 0.0) {
+    _startTime = TRI_microtime();
+  }
+
   // set end immediately so we do not get netative statistics
   RequestStatistics::SET_REQUEST_END(_statistics);
 
@@ -143,6 +148,8 @@ int RestHandler::finalizeEngine() {
 
   RequestStatistics::SET_REQUEST_END(_statistics);
 
+  logSlowRequest();
+
   if (res == TRI_ERROR_NO_ERROR) {
     _engine.setState(RestEngine::State::DONE);
   } else {
@@ -153,6 +160,72 @@ int RestHandler::finalizeEngine() {
   return res;
 }
 
+RestHandler::RequestTimes RestHandler::requestTimes(double startTime,
+                                                   double now,
+                                                   double readStart,
+                                                   double readEnd,
+                                                   double queueStart,
+                                                   double queueEnd) {
+  RequestTimes times;
+  times._execution = now - startTime;
+
+  if (readStart <= 0.0) {
+    times._total = times._execution;
+    return times;
+  }
+
+  // measure from the first byte of the request if the statistics know it
+  times._total = now - readStart;
+  times._read = readEnd - readStart;
+
+  if (queueStart > 0.0 && queueEnd > 0.0) {
+    times._queue = queueEnd - queueStart;
+  }
+
+  times._phases = true;
+  return times;
+}
+
+void RestHandler::logSlowRequest() {
+  double const threshold = GeneralServerFeature::slowRequestThreshold();
+
+  if (threshold <= 0.0 || _startTime == 0.0 || _request == nullptr) {
+    return;
+  }
+
+  double const now = TRI_microtime();
+  RequestStatistics* stat = _statistics.load();
+
+  RequestTimes const times =
+      (stat == nullptr)
+          ? requestTimes(_startTime, now, 0.0, 0.0, 0.0, 0.0)
+          : requestTimes(_startTime, now, stat->readStart(), stat->readEnd(),
+                         stat->queueStart(), stat->queueEnd());
+
+  if (times._total < threshold) {
+    return;
+  }
+
+  std::string const method =
+      GeneralRequest::translateMethod(_request->requestType());
+
+  if (!times._phases) {
+    LOG_TOPIC(WARN, Logger::REQUESTS)
+        << "slow request: " << method << " '" << _request->fullUrl()
+        << "', database: '" << _request->databaseName()
+        << "', took: " << Logger::FIXED(times._total);
+    return;
+  }
+
+  LOG_TOPIC(WARN, Logger::REQUESTS)
+      << "slow request: " << method << " '" << _request->fullUrl()
+      << "', database: '" << _request->databaseName()
+      << "', took: " << Logger::FIXED(times._total)
+      << ", read: " << Logger::FIXED(times._read)
+      << ", queue: " << Logger::FIXED(times._queue)
+      << ", execution: " << Logger::FIXED(times._execution);
+}
+
 int RestHandler::executeEngine() {
   try {
     RestStatus result = execute();
@@ -99,6 +99,24 @@ class RestHandler : public std::enable_shared_from_this<RestHandler> {
 
   virtual void handleError(basics::Exception const&) = 0;
 
+ public:
+  /// @brief the time a request took, and the time spent in its phases
+  struct RequestTimes {
+    double _total = 0.0;
+    double _read = 0.0;
+    double _queue = 0.0;
+    double _execution = 0.0;
+    /// @brief whether the phases before the execution are known
+    bool _phases = false;
+  };
+
+  /// @brief the times of a request whose execution started at startTime.
+  /// the other timestamps are taken from the request statistics, and are
+  /// 0.0 if they are not known
+  static RequestTimes requestTimes(double startTime, double now,
+                                   double readStart, double readEnd,
+                                   double queueStart, double queueEnd);
+
  protected:
   void resetResponse(rest::ResponseCode);
 
@@ -114,9 +132,18 @@ class RestHandler : public std::enable_shared_from_this<RestHandler> {
 
   std::atomic<RequestStatistics*> _statistics;
 
+ private:
+  /// @brief log the request if it took longer than the configured
+  /// slow request threshold
+  void logSlowRequest();
+
  private:
   bool _needsOwnThread = false;
 
+  /// @brief time at which the execution of the request started. only set
+  /// if slow requests are logged
+  double _startTime = 0.0;
+
  public:
   void initEngine(EventLoop loop,
                   std::function<void(RestHandler*)> storeResult) {
@@ -38,6 +38,7 @@ using namespace arangodb::rest;
 
 static std::string const ROOT_PATH = "/";
 std::atomic<bool> RestHandlerFactory::_maintenanceMode(false);
+std::atomic<bool> RestHandlerFactory::_nativeHandlersReady(false);
 
 namespace {
 class MaintenanceHandler : public RestHandler {
@@ -76,6 +77,10 @@ void RestHandlerFactory::setMaintenance(bool value) {
 
 bool RestHandlerFactory::isMaintenance() { return _maintenanceMode.load(); }
 
+void RestHandlerFactory::setNativeHandlersReady(bool value) {
+  _nativeHandlersReady.store(value);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief set request context, wrapper method
 ////////////////////////////////////////////////////////////////////////////////
@@ -95,13 +100,20 @@ RestHandler* RestHandlerFactory::createHandler(
   
   // In the bootstrap phase, we would like that coordinators answer the
   // following to endpoints, but not yet others:
+  bool refuseActions = false;
   if (_maintenanceMode.load()) {
     if ((!ServerState::instance()->isCoordinator() &&
          path.find("/_api/agency/agency-callbacks") == std::string::npos) ||
         (path.find("/_api/agency/agency-callbacks") == std::string::npos &&
          path.find("/_api/aql") == std::string::npos)) {
-      LOG_TOPIC(DEBUG, arangodb::Logger::FIXME) << "Maintenance mode: refused path: " << path;
-      return new MaintenanceHandler(request.release(), response.release());
+      if (!_nativeHandlersReady.load() ||
+          ServerState::instance()->isCoordinator()) {
+        LOG_TOPIC(DEBUG, arangodb::Logger::FIXME) << "Maintenance mode: refused path: " << path;
+        return new MaintenanceHandler(request.release(), response.release());
+      }
+      // the JavaScript actions are not loaded yet, but everything else
+      // can be served already
+      refuseActions = true;
     }
   }
 
@@ -178,6 +190,11 @@ RestHandler* RestHandlerFactory::createHandler(
     }
   }
 
+  if (refuseActions && (i == ii.end() || *modifiedPath == ROOT_PATH)) {
+    LOG_TOPIC(DEBUG, arangodb::Logger::FIXME) << "Maintenance mode: refused action path: " << path;
+    return new MaintenanceHandler(request.release(), response.release());
+  }
+
   // no match
   if (i == ii.end()) {
     if (_notFound != nullptr) {
@@ -57,6 +57,10 @@ class RestHandlerFactory {
   // checks maintenance mode
   static bool isMaintenance();
 
+  // sets whether requests handled without V8 are served in maintenance
+  // mode, while the JavaScript bootstrap is still running
+  static void setNativeHandlersReady(bool);
+
  public:
   // set request context, wrapper method
   bool setRequestContext(GeneralRequest*);
@@ -93,6 +97,7 @@ class RestHandlerFactory {
 
  private:
   static std::atomic<bool> _maintenanceMode;
+  static std::atomic<bool> _nativeHandlersReady;
 };
 }
 }
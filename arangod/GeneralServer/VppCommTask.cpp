@@ -35,6 +35,7 @@
 #include "GeneralServer/AuthenticationFeature.h"
 #include "GeneralServer/GeneralServer.h"
 #include "GeneralServer/GeneralServerFeature.h"
+#include "GeneralServer/ResponseCompression.h"
 #include "GeneralServer/RestHandler.h"
 #include "GeneralServer/RestHandlerFactory.h"
 #include "GeneralServer/VppNetwork.h"
@@ -86,6 +87,7 @@ VppCommTask::VppCommTask(EventLoop loop, GeneralServer* server,
       GeneralCommTask(loop, server, std::move(socket), std::move(info), timeout,
                       skipInit),
       _authenticatedUser(),
+      _authenticatedInternal(false),
       _authentication(nullptr) {
   _authentication = application_features::ApplicationServer::getFeature<
       AuthenticationFeature>("Authentication");
@@ -97,14 +99,48 @@ VppCommTask::VppCommTask(EventLoop loop, GeneralServer* server,
   _readBuffer.reserve(_bufferLength);
 }
 
+VppCommTask::~VppCommTask() {
+  _outgoingMessages.forEachExtra([](RequestStatistics* stat) {
+    if (stat != nullptr) {
+      stat->release();
+    }
+  });
+}
+
 void VppCommTask::addResponse(VppResponse* response, RequestStatistics* stat) {
+  // compress the payload if the client accepts it. the content-encoding
+  // must be in the meta object, so this happens before the header is built
+  std::unique_ptr<StringBuffer> compressed;
+
+  if (response->_acceptEncoding != ContentEncoding::IDENTITY &&
+      response->generateBody() && !response->_vpackPayloads.empty()) {
+    StringBuffer payload(TRI_UNKNOWN_MEM_ZONE, false);
+
+    for (auto const& buffer : response->_vpackPayloads) {
+      VPackSlice slice(buffer.data());
+      payload.appendText(slice.startAs<char>(), slice.byteSize());
+    }
+
+    compressed.reset(new StringBuffer(TRI_UNKNOWN_MEM_ZONE, false));
+
+    ContentEncoding const encoding = response->_acceptEncoding;
+
+    if (ResponseCompression::compress(encoding, payload.c_str(),
+                                      payload.length(), *compressed)) {
+      response->setHeaderNC(StaticStrings::ContentEncoding,
+                            ResponseCompression::name(encoding));
+    } else {
+      compressed.reset();
+    }
+  }
+
   VPackMessageNoOwnBuffer response_message = response->prepareForNetwork();
   uint64_t const id = response_message._id;
 
   std::vector<VPackSlice> slices;
   slices.push_back(response_message._header);
 
-  if (response->generateBody()) {
+  if (response->generateBody() && compressed == nullptr) {
     for (auto& payload : response_message._payloads) {
       slices.push_back(payload);
     }
@@ -131,8 +167,14 @@ void VppCommTask::addResponse(VppResponse* response, RequestStatistics* stat) {
           ServerFeature>("Server")
           ->vppMaxSize();
 
-  // set some sensible maxchunk size and compression
-  auto buffers = createChunkForNetwork(slices, id, chunkSize, false);
+  // set some sensible maxchunk size and compression. a compressed payload
+  // is not a sequence of VelocyPack values anymore, so it is sent as
+  // opaque bytes behind the header
+  auto buffers =
+      (compressed == nullptr)
+          ? createChunkForNetwork(slices, id, chunkSize, false)
+          : createChunkForNetwork(response_message._header, *compressed, id,
+                                  chunkSize);
   double const totalTime = RequestStatistics::ELAPSED_SINCE_READ_START(stat);
 
   if (buffers.empty()) {
@@ -140,20 +182,18 @@ void VppCommTask::addResponse(VppResponse* response, RequestStatistics* stat) {
       stat->release();
     }
   } else {
-    size_t n = buffers.size() - 1;
-    size_t c = 0;
+    std::deque<std::unique_ptr<basics::StringBuffer>> chunks;
 
     for (auto&& buffer : buffers) {
-      if (c == n) {
-        WriteBuffer b(buffer.release(), stat);
-        addWriteBuffer(b);
-      } else {
-        WriteBuffer b(buffer.release(), nullptr);
-        addWriteBuffer(b);
-      }
+      chunks.emplace_back(std::move(buffer));
+    }
 
-      ++c;
+    {
+      MUTEX_LOCKER(locker, _outgoingLock);
+      _outgoingMessages.add(std::move(chunks), stat);
     }
+
+    startWriting();
   }
 
   // and give some request information
@@ -165,6 +205,22 @@ void VppCommTask::addResponse(VppResponse* response, RequestStatistics* stat) {
       << "\"," << Logger::FIXED(totalTime, 6);
 }
 
+// caller must hold the _writeLock
+bool VppCommTask::nextWriteBuffer(WriteBuffer& buffer) {
+  MUTEX_LOCKER(locker, _outgoingLock);
+
+  std::unique_ptr<basics::StringBuffer> chunk;
+  RequestStatistics* stat = nullptr;
+
+  if (!_outgoingMessages.next(chunk, stat)) {
+    return false;
+  }
+
+  // the statistics go with the last chunk
+  buffer = WriteBuffer(chunk.release(), stat);
+  return true;
+}
+
 VppCommTask::ChunkHeader VppCommTask::readChunkHeader() {
   VppCommTask::ChunkHeader header;
 
@@ -224,14 +280,27 @@ bool VppCommTask::isChunkComplete(char* start) {
 
 void VppCommTask::handleAuthentication(VPackSlice const& header,
                                        uint64_t messageId) {
-  // std::string encryption = header.at(2).copyString();
-  std::string user = header.at(3).copyString();
-  std::string pass = header.at(4).copyString();
+  std::string encryption = header.at(2).copyString();
 
   bool authOk = false;
+  _authenticatedInternal = false;
+
   if (!_authentication->isEnabled()) {
     authOk = true;
+  } else if (encryption == "jwt") {
+    // used by ClusterComm for its VelocyStream connections
+    AuthResult result = _authentication->authInfo()->checkAuthentication(
+        AuthInfo::AuthType::JWT, header.at(3).copyString());
+
+    authOk = result._authorized;
+    if (authOk) {
+      _authenticatedUser = std::move(result._username);
+      _authenticatedInternal = _authenticatedUser.empty();
+    }
   } else {
+    std::string user = header.at(3).copyString();
+    std::string pass = header.at(4).copyString();
+
     auto auth = basics::StringUtils::encodeBase64(user + ":" + pass);
     AuthResult result = _authentication->authInfo()->checkAuthentication(
         AuthInfo::AuthType::BASIC, auth);
@@ -249,6 +318,7 @@ void VppCommTask::handleAuthentication(VPackSlice const& header,
                       "authentication successful", messageId);
   } else {
     _authenticatedUser.clear();
+    _authenticatedInternal = false;
     handleSimpleError(rest::ResponseCode::UNAUTHORIZED,
                       TRI_ERROR_HTTP_UNAUTHORIZED, "authentication failed",
                       messageId);
@@ -338,8 +408,9 @@ bool VppCommTask::processRead(double startTime) {
 
       // check authentication
       AuthLevel level = AuthLevel::RW;
-      if (_authentication->isEnabled()) {  // only check authorization if
-                                           // authentication is enabled
+      if (_authentication->isEnabled() &&
+          !_authenticatedInternal) {  // only check authorization if
+                                      // authentication is enabled
         std::string const& dbname = request->databaseName();
         if (!(_authenticatedUser.empty() && dbname.empty())) {
           level = _authentication->canUseDatabase(_authenticatedUser, dbname);
@@ -367,6 +438,8 @@ bool VppCommTask::processRead(double startTime) {
           std::unique_ptr<VppResponse> response(new VppResponse(
               rest::ResponseCode::SERVER_ERROR, chunkHeader._messageID));
           response->setContentTypeRequested(request->contentTypeResponse());
+          response->_acceptEncoding = ResponseCompression::negotiate(
+              request->header(StaticStrings::AcceptEncoding));
           executeRequest(std::move(request), std::move(response));
         }
       }
@@ -24,9 +24,11 @@
 #ifndef ARANGOD_GENERAL_SERVER_VPP_COMM_TASK_H
 #define ARANGOD_GENERAL_SERVER_VPP_COMM_TASK_H 1
 
+#include "GeneralServer/ChunkInterleaver.h"
 #include "GeneralServer/GeneralCommTask.h"
 
 #include <boost/optional.hpp>
+#include <deque>
 #include <stdexcept>
 
 #include "lib/Rest/VppMessage.h"
@@ -43,6 +45,7 @@ class VppCommTask : public GeneralCommTask {
  public:
   VppCommTask(EventLoop, GeneralServer*, std::unique_ptr<Socket> socket,
               ConnectionInfo&&, double timeout, bool skipSocketInit = false);
+  ~VppCommTask();
 
   // convert from GeneralResponse to vppResponse ad dispatch request to class
   // internal addResponse
@@ -79,6 +82,9 @@ class VppCommTask : public GeneralCommTask {
                          std::string const& errorMessage,
                          uint64_t messageId) override;
 
+  // hands out the chunks of all responses in turn
+  bool nextWriteBuffer(WriteBuffer&) override;
+
  private:
   // reets the internal state this method can be called to clean up when the
   // request handling aborts prematurely
@@ -139,7 +145,16 @@ class VppCommTask : public GeneralCommTask {
       ChunkHeader const& chunkHeader, VppInputMessage& message, bool& doExecute,
       char const* vpackBegin, char const* chunkEnd);
 
+  // the chunks of the responses being sent, written in turn so that small
+  // responses are not delayed by large ones
+  Mutex _outgoingLock;
+  ChunkInterleaver<std::unique_ptr<basics::StringBuffer>, RequestStatistics>
+      _outgoingMessages;
+
   std::string _authenticatedUser;
+  /// @brief whether the connection was authenticated with a cluster-internal
+  /// JWT, which carries no user name but may access all databases
+  bool _authenticatedInternal;
   AuthenticationFeature* _authentication;
 };
 }
@@ -319,6 +319,29 @@ inline std::vector<std::unique_ptr<basics::StringBuffer>> createChunkForNetwork(
   return rv;
 }
 
+// create the chunks of a message that consists of a header and a payload
+// that is not VelocyPack, e.g. because it is compressed
+inline std::vector<std::unique_ptr<basics::StringBuffer>> createChunkForNetwork(
+    VPackSlice header, basics::StringBuffer const& payload, uint64_t id,
+    std::size_t maxChunkBytes) {
+  std::vector<std::unique_ptr<basics::StringBuffer>> rv;
+
+  auto message = std::make_unique<basics::StringBuffer>(
+      TRI_UNKNOWN_MEM_ZONE, header.byteSize() + payload.length(), false);
+  message->appendText(header.startAs<char>(), header.byteSize());
+  message->appendText(payload.c_str(), payload.length());
+
+  std::size_t const messageLength = message->length();
+
+  if (messageLength < maxChunkBytes - chunkHeaderLength(false)) {
+    rv.push_back(createChunkForNetworkDetail(message->c_str(), 0,
+                                             messageLength, true, 1, id, 0));
+  } else {
+    send_many(rv, id, maxChunkBytes, std::move(message), messageLength);
+  }
+  return rv;
+}
+
 }
 
 #endif
@@ -66,6 +66,14 @@ bool IndexIterator::nextExtra(ExtraCallback const&, size_t) {
                                  "relevant collections to arangodb.com");
 }
 
+/// @brief default implementation for nextTokens
+bool IndexIterator::nextTokens(std::vector<DocumentIdentifierToken>& tokens,
+                               size_t limit) {
+  return next([&tokens](DocumentIdentifierToken const& token) {
+    tokens.emplace_back(token);
+  }, limit);
+}
+
 /// @brief default implementation for reset
 void IndexIterator::reset() {}
 
@@ -98,6 +106,70 @@ bool MultiIndexIterator::next(TokenCallback const& callback, size_t limit) {
         _current = nullptr;
         return false;
       }
+      _current = _iterators.at(_currentIdx);
+    }
+  }
+  return true;
+}
+
+/// @brief Get the next tokens
+///        If one iterator is exhausted, the next one is used.
+///        If less than limit many tokens are appended
+///        all iterators are exhausted
+bool MultiIndexIterator::nextTokens(std::vector<DocumentIdentifierToken>& tokens,
+                                    size_t limit) {
+  while (limit > 0) {
+    if (_current == nullptr) {
+      return false;
+    }
+    size_t const before = tokens.size();
+    bool more = _current->nextTokens(tokens, limit);
+    limit -= tokens.size() - before;
+    if (!more) {
+      _currentIdx++;
+      if (_currentIdx >= _iterators.size()) {
+        _current = nullptr;
+        return false;
+      }
+      _current = _iterators.at(_currentIdx);
+    }
+  }
+  return true;
+}
+
+/// @brief whether or not all internal iterators can produce extra values
+bool MultiIndexIterator::hasExtra() const {
+  if (_iterators.empty()) {
+    return false;
+  }
+  for (auto const& it : _iterators) {
+    if (!it->hasExtra()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/// @brief Get the next elements together with their extra values
+///        If one iterator is exhausted, the next one is used.
+///        If callback is called less than limit many times
+///        all iterators are exhausted
+bool MultiIndexIterator::nextExtra(ExtraCallback const& callback, size_t limit) {
+  auto cb = [&limit, &callback] (DocumentIdentifierToken const& token, arangodb::velocypack::Slice extra) {
+    --limit;
+    callback(token, extra);
+  };
+  while (limit > 0) {
+    if (_current == nullptr) {
+      return false;
+    }
+    if (!_current->nextExtra(cb, limit)) {
+      _currentIdx++;
+      if (_currentIdx >= _iterators.size()) {
+        _current = nullptr;
+        return false;
+      }
+      _current = _iterators.at(_currentIdx);
     }
   }
   return true;
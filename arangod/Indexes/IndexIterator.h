@@ -37,6 +37,9 @@
 //
 // skip(trySkip, skipped) tries to skip the next trySkip elements
 //
+// nextTokens(tokens, limit) appends at most limit many tokens to a vector,
+// iterators override it to do so without a callback per token
+//
 // When finished you need to implement the fuction:
 //    virtual IndexIterator* iteratorForCondition(...)
 // So a there is a way to create an iterator for the index
@@ -88,6 +91,11 @@ class IndexIterator {
   virtual bool next(TokenCallback const& callback, size_t limit) = 0;
   virtual bool nextExtra(ExtraCallback const& callback, size_t limit);
 
+  /// @brief append at most limit many tokens to the vector. returns false
+  /// if the iterator is exhausted, like next
+  virtual bool nextTokens(std::vector<DocumentIdentifierToken>& tokens,
+                          size_t limit);
+
   virtual void reset();
 
   virtual void skip(uint64_t count, uint64_t& skipped);
@@ -154,6 +162,18 @@ class MultiIndexIterator final : public IndexIterator {
     ///        all iterators are exhausted
     bool next(TokenCallback const& callback, size_t limit) override;
 
+    /// @brief Get the next tokens
+    ///        If one iterator is exhausted, the next one is used.
+    bool nextTokens(std::vector<DocumentIdentifierToken>& tokens,
+                    size_t limit) override;
+
+    /// @brief whether or not all internal iterators can produce extra values
+    bool hasExtra() const override;
+
+    /// @brief Get the next elements together with their extra values
+    ///        Works like next, but calls nextExtra on the internal iterators
+    bool nextExtra(ExtraCallback const& callback, size_t limit) override;
+
     /// @brief Reset the cursor
     ///        This will reset ALL internal iterators and start all over again
     void reset() override;
@@ -0,0 +1,82 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "IndexValueSample.h"
+
+#include "Basics/MutexLocker.h"
+#include "Random/RandomGenerator.h"
+
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+
+IndexValueSample::IndexValueSample() : _seen(0) {}
+
+void IndexValueSample::insert(VPackSlice value) {
+  MUTEX_LOCKER(locker, _lock);
+
+  ++_seen;
+
+  size_t slot;
+  if (_values.size() < MaxValues) {
+    slot = _values.size();
+    _values.emplace_back();
+  } else {
+    // keep the new value with a probability of MaxValues / _seen, replacing
+    // a random one
+    uint64_t r = RandomGenerator::interval(_seen - 1);
+    if (r >= MaxValues) {
+      return;
+    }
+    slot = static_cast<size_t>(r);
+  }
+
+  _values[slot].assign(value.startAs<char>(),
+                       static_cast<size_t>(value.byteSize()));
+}
+
+void IndexValueSample::clear() {
+  MUTEX_LOCKER(locker, _lock);
+  _values.clear();
+  _seen = 0;
+}
+
+bool IndexValueSample::estimate(std::function<bool(VPackSlice)> const& predicate,
+                                double& fraction) const {
+  MUTEX_LOCKER(locker, _lock);
+
+  if (_values.size() < MinValues) {
+    return false;
+  }
+
+  size_t matches = 0;
+  for (auto const& it : _values) {
+    if (predicate(VPackSlice(it.data()))) {
+      ++matches;
+    }
+  }
+
+  // a value that is not in the sample is still expected to exist, but to be
+  // rarer than one sampled value
+  fraction = (std::max)(static_cast<double>(matches), 0.5) /
+             static_cast<double>(_values.size());
+  return true;
+}
@@ -0,0 +1,74 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_INDEXES_INDEX_VALUE_SAMPLE_H
+#define ARANGOD_INDEXES_INDEX_VALUE_SAMPLE_H 1
+
+#include "Basics/Common.h"
+#include "Basics/Mutex.h"
+
+#include <velocypack/Slice.h>
+
+namespace arangodb {
+
+/// @brief a uniform random sample of the values inserted into an index
+/// (reservoir sampling). it serves as an equi-depth histogram for the
+/// optimizer: the fraction of sampled values that satisfy a condition
+/// estimates the fraction of index entries that do. removals are not
+/// tracked, so the sample describes the inserted values, which is close
+/// enough as long as removals do not depend on the indexed value
+class IndexValueSample {
+ public:
+  /// @brief maximum number of sampled values
+  static size_t const MaxValues = 256;
+
+  /// @brief minimum number of sampled values for an estimate
+  static size_t const MinValues = 32;
+
+ public:
+  IndexValueSample();
+  IndexValueSample(IndexValueSample const&) = delete;
+  IndexValueSample& operator=(IndexValueSample const&) = delete;
+
+  /// @brief offer an inserted value to the sample
+  void insert(arangodb::velocypack::Slice value);
+
+  /// @brief forget all values, e.g. when the index is unloaded
+  void clear();
+
+  /// @brief estimate the fraction of index entries for which the predicate
+  /// holds. returns false if there are not enough values in the sample
+  bool estimate(
+      std::function<bool(arangodb::velocypack::Slice)> const& predicate,
+      double& fraction) const;
+
+ private:
+  mutable Mutex _lock;
+
+  /// @brief the sampled values, as velocypack
+  std::vector<std::string> _values;
+
+  /// @brief number of values offered so far
+  uint64_t _seen;
+};
+}
+
+#endif
@@ -198,7 +198,10 @@ void InternalRestTraverserHandler::queryEngine() {
       return;
     }
 
-    engine->getEdges(keysSlice, depthSlice.getNumericValue<size_t>(), result);
+    bool withVertices = arangodb::basics::VelocyPackHelper::getBooleanValue(
+        body, "vertices", false);
+    engine->getEdges(keysSlice, depthSlice.getNumericValue<size_t>(), result,
+                     withVertices);
   } else if (option == "vertex") {
     VPackSlice depthSlice = body.get("depth");
 
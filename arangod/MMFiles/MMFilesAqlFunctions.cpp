@@ -170,45 +170,50 @@ static arangodb::MMFilesGeoIndex* getGeoIndex(
   return index;
 }
 
-/// @brief function FULLTEXT
-AqlValue MMFilesAqlFunctions::Fulltext(
-    arangodb::aql::Query* query, transaction::Methods* trx,
-    VPackFunctionParameters const& parameters) {
-  ValidateParameters(parameters, "FULLTEXT", 3, 4);
+/// @brief execute a fulltext query with the parameters of the FULLTEXT
+/// and FULLTEXT_SCORED functions. the caller must free the result
+TRI_fulltext_result_s* MMFilesAqlFunctions::RunFulltextQuery(
+    transaction::Methods* trx, VPackFunctionParameters const& parameters,
+    char const* functionName, bool scored, LogicalCollection*& collection) {
+  ValidateParameters(parameters, functionName, 3, 4);
 
-  AqlValue collectionValue = ExtractFunctionParameterValue(trx, parameters, 0);
+  AqlValue collectionValue =
+      ExtractFunctionParameterValue(trx, parameters, 0);
 
   if (!collectionValue.isString()) {
     THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, "FULLTEXT");
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, functionName);
   }
 
   std::string const collectionName(collectionValue.slice().copyString());
 
-  AqlValue attribute = ExtractFunctionParameterValue(trx, parameters, 1);
+  AqlValue attribute =
+      ExtractFunctionParameterValue(trx, parameters, 1);
 
   if (!attribute.isString()) {
     THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, "FULLTEXT");
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, functionName);
   }
 
   std::string attributeName(attribute.slice().copyString());
 
-  AqlValue queryValue = ExtractFunctionParameterValue(trx, parameters, 2);
+  AqlValue queryValue =
+      ExtractFunctionParameterValue(trx, parameters, 2);
 
   if (!queryValue.isString()) {
     THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, "FULLTEXT");
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, functionName);
   }
 
   std::string queryString = queryValue.slice().copyString();
 
   size_t maxResults = 0;  // 0 means "all results"
   if (parameters.size() >= 4) {
-    AqlValue limit = ExtractFunctionParameterValue(trx, parameters, 3);
+    AqlValue limit =
+        ExtractFunctionParameterValue(trx, parameters, 3);
     if (!limit.isNull(true) && !limit.isNumber()) {
       THROW_ARANGO_EXCEPTION_PARAMS(
-          TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, "FULLTEXT");
+          TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, functionName);
     } 
     if (limit.isNumber()) {
       int64_t value = limit.toInt64(trx);
@@ -222,7 +227,7 @@ AqlValue MMFilesAqlFunctions::Fulltext(
   TRI_voc_cid_t cid = resolver->getCollectionIdLocal(collectionName);
   trx->addCollectionAtRuntime(cid, collectionName);
 
-  LogicalCollection* collection = trx->documentCollection(cid);
+  collection = trx->documentCollection(cid);
 
   if (collection == nullptr) {
     THROW_ARANGO_EXCEPTION_FORMAT(TRI_ERROR_ARANGO_COLLECTION_NOT_FOUND,
@@ -278,9 +283,14 @@ AqlValue MMFilesAqlFunctions::Fulltext(
     THROW_ARANGO_EXCEPTION(res);
   }
 
-  // note: the following call will free "ft"!
-  TRI_fulltext_result_t* queryResult =
-      TRI_QueryMMFilesFulltextIndex(fulltextIndex->internals(), ft);
+  // note: the following calls will free "ft"!
+  TRI_fulltext_result_t* queryResult;
+  if (scored) {
+    queryResult =
+        TRI_QueryScoredMMFilesFulltextIndex(fulltextIndex->internals(), ft);
+  } else {
+    queryResult = TRI_QueryMMFilesFulltextIndex(fulltextIndex->internals(), ft);
+  }
 
   if (queryResult == nullptr) {
     THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
@@ -288,6 +298,17 @@ AqlValue MMFilesAqlFunctions::Fulltext(
   
   TRI_ASSERT(trx->isPinned(cid));
 
+  return queryResult;
+}
+
+/// @brief function FULLTEXT
+AqlValue MMFilesAqlFunctions::Fulltext(
+    arangodb::aql::Query* query, transaction::Methods* trx,
+    VPackFunctionParameters const& parameters) {
+  LogicalCollection* collection = nullptr;
+  TRI_fulltext_result_t* queryResult =
+      RunFulltextQuery(trx, parameters, "FULLTEXT", false, collection);
+
   transaction::BuilderLeaser builder(trx);
   try {
     builder->openArray();
@@ -308,6 +329,39 @@ AqlValue MMFilesAqlFunctions::Fulltext(
   }
 }
 
+/// @brief function FULLTEXT_SCORED
+/// returns objects with attributes "doc" and "score", ordered by descending
+/// score
+AqlValue MMFilesAqlFunctions::FulltextScored(
+    arangodb::aql::Query* query, transaction::Methods* trx,
+    VPackFunctionParameters const& parameters) {
+  LogicalCollection* collection = nullptr;
+  TRI_fulltext_result_t* queryResult =
+      RunFulltextQuery(trx, parameters, "FULLTEXT_SCORED", true, collection);
+
+  transaction::BuilderLeaser builder(trx);
+  try {
+    builder->openArray();
+
+    ManagedDocumentResult mmdr;
+    size_t const numResults = queryResult->_numDocuments;
+    for (size_t i = 0; i < numResults; ++i) {
+      if (collection->readDocument(trx, queryResult->_documents[i], mmdr)) {
+        builder->openObject();
+        builder->add(VPackValue("doc"));
+        builder->addExternal(mmdr.vpack());
+        builder->add("score", VPackValue(queryResult->_scores[i]));
+        builder->close();
+      }
+    }
+    builder->close();
+    TRI_FreeResultMMFilesFulltextIndex(queryResult);
+    return AqlValue(builder.get());
+  } catch (...) {
+    TRI_FreeResultMMFilesFulltextIndex(queryResult);
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+  }
+}
 
 /// @brief function NEAR
 AqlValue MMFilesAqlFunctions::Near(arangodb::aql::Query* query,
@@ -431,6 +485,9 @@ void MMFilesAqlFunctions::registerResources() {
   functions->add({"FULLTEXT", "AQL_FULLTEXT", "hs,s,s|n", true, false, true,
                  false, true, &MMFilesAqlFunctions::Fulltext,
                  NotInCoordinator});
+  functions->add({"FULLTEXT_SCORED", "AQL_FULLTEXT_SCORED", "hs,s,s|n", true,
+                  false, true, false, true, &MMFilesAqlFunctions::FulltextScored,
+                  NotInCoordinator});
   functions->add({"NEAR", "AQL_NEAR", "hs,n,n|nz,s", true, false, true, false,
                   true, &MMFilesAqlFunctions::Near, NotInCoordinator});
   functions->add({"WITHIN", "AQL_WITHIN", "hs,n,n,n|s", true, false, true,
@@ -27,15 +27,22 @@
 #include "Basics/Common.h"
 #include "Aql/Functions.h"
 
+struct TRI_fulltext_result_s;
+
 namespace arangodb {
 namespace aql {
 struct Function;
 }
+class LogicalCollection;
 
 struct MMFilesAqlFunctions : public aql::Functions {
   static aql::AqlValue Fulltext(arangodb::aql::Query*, transaction::Methods*,
                                 aql::VPackFunctionParameters const&);
 
+  static aql::AqlValue FulltextScored(arangodb::aql::Query*,
+                                      transaction::Methods*,
+                                      aql::VPackFunctionParameters const&);
+
   static aql::AqlValue Near(arangodb::aql::Query*, transaction::Methods*,
                             aql::VPackFunctionParameters const&);
 
@@ -43,6 +50,13 @@ struct MMFilesAqlFunctions : public aql::Functions {
                               aql::VPackFunctionParameters const&);
 
   static void registerResources();
+
+ private:
+  /// @brief execute a fulltext query with the parameters of the FULLTEXT
+  /// and FULLTEXT_SCORED functions. the caller must free the result
+  static TRI_fulltext_result_s* RunFulltextQuery(
+      transaction::Methods*, aql::VPackFunctionParameters const&,
+      char const* functionName, bool scored, LogicalCollection*& collection);
 };
 
 } // namespace arangodb
@@ -106,6 +106,15 @@ void MMFilesCleanupThread::run() {
             physical->cleanupIndexes();
           }
 
+          if (status != TRI_VOC_COL_STATUS_DELETED) {
+            // drop previous revisions that no snapshot can see anymore
+            auto physical = static_cast<MMFilesCollection*>(collection->getPhysical());
+            TRI_ASSERT(physical != nullptr);
+            physical->pruneRevisionHistory();
+            // free the decompressed documents once no reader can use them
+            physical->releaseDecompressedDocuments();
+          }
+
           cleanupCollection(collection);
         }
       }, false);
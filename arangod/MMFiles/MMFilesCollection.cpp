@@ -40,13 +40,16 @@
 #include "Logger/Logger.h"
 #include "MMFiles/MMFilesCollectionReadLocker.h"
 #include "MMFiles/MMFilesCollectionWriteLocker.h"
+#include "MMFiles/MMFilesCompactorThread.h"
 #include "MMFiles/MMFilesDatafile.h"
 #include "MMFiles/MMFilesDatafileHelper.h"
 #include "MMFiles/MMFilesDocumentOperation.h"
 #include "MMFiles/MMFilesDocumentPosition.h"
+#include "MMFiles/MMFilesEngine.h"
 #include "MMFiles/MMFilesIndexElement.h"
 #include "MMFiles/MMFilesLogfileManager.h"
 #include "MMFiles/MMFilesPrimaryIndex.h"
+#include "MMFiles/MMFilesPrimaryIndexSnapshot.h"
 #include "MMFiles/MMFilesToken.h"
 #include "MMFiles/MMFilesTransactionState.h"
 #include "RestServer/DatabaseFeature.h"
@@ -66,6 +69,10 @@
 #include "VocBase/ticks.h"
 #include "Indexes/IndexIterator.h"
 
+#include <velocypack/Iterator.h>
+#include <velocypack/Validator.h>
+#include <velocypack/velocypack-aliases.h>
+
 using namespace arangodb;
 using Helper = arangodb::basics::VelocyPackHelper;
 
@@ -141,6 +148,13 @@ arangodb::Result MMFilesCollection::updateProperties(VPackSlice const& slice,
         TRI_ERROR_BAD_PARAMETER,
         "isVolatile option cannot be changed at runtime");
   }
+
+  if (_compressDocuments != arangodb::basics::VelocyPackHelper::getBooleanValue(
+                                slice, "compressDocuments", _compressDocuments)) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(
+        TRI_ERROR_BAD_PARAMETER,
+        "compressDocuments option cannot be changed at runtime");
+  }
   auto journalSlice = slice.get("journalSize");
 
   if (journalSlice.isNone()) {
@@ -216,8 +230,11 @@ int MMFilesCollection::OpenIteratorHandleDocumentMarker(TRI_df_marker_t const* m
   transaction::Methods* trx = state->_trx;
   TRI_ASSERT(trx != nullptr);
 
-  VPackSlice const slice(reinterpret_cast<char const*>(marker) + MMFilesDatafileHelper::VPackOffset(TRI_DF_MARKER_VPACK_DOCUMENT));
-  uint8_t const* vpack = slice.begin();
+  uint8_t const* vpack = reinterpret_cast<uint8_t const*>(marker) + MMFilesDatafileHelper::VPackOffset(TRI_DF_MARKER_VPACK_DOCUMENT);
+  // the revisions cache keeps the marker's VelocyPack, but the key and the
+  // primary index need the document itself
+  VPackBuffer<uint8_t> buffer;
+  VPackSlice const slice = MMFilesDocumentCompression::document(vpack, buffer);
 
   VPackSlice keySlice;
   TRI_voc_rid_t revisionId;
@@ -250,7 +267,7 @@ int MMFilesCollection::OpenIteratorHandleDocumentMarker(TRI_df_marker_t const* m
     physical->insertRevision(revisionId, vpack, fid, false, false); 
 
     // insert into primary index
-    int res = state->_primaryIndex->insertKey(trx, revisionId, VPackSlice(vpack), state->_mmdr);
+    int res = state->_primaryIndex->insertKey(trx, revisionId, slice, state->_mmdr);
 
     if (res != TRI_ERROR_NO_ERROR) {
       physical->removeRevision(revisionId, false);
@@ -268,7 +285,7 @@ int MMFilesCollection::OpenIteratorHandleDocumentMarker(TRI_df_marker_t const* m
   else {
     TRI_voc_rid_t const oldRevisionId = found->revisionId();
     // update the revision id in primary index
-    found->updateRevisionId(revisionId, static_cast<uint32_t>(keySlice.begin() - vpack));
+    found->updateRevisionId(revisionId, static_cast<uint32_t>(keySlice.begin() - slice.begin()));
 
     MMFilesDocumentPosition const old = physical->lookupRevision(oldRevisionId);
 
@@ -371,7 +388,8 @@ int MMFilesCollection::OpenIteratorHandleDeletionMarker(TRI_df_marker_t const* m
     dfi->sizeDead += encoding::alignedSize<int64_t>(size);
     state->_dfi->numberDeletions++;
 
-    state->_primaryIndex->removeKey(trx, oldRevisionId, VPackSlice(vpack), state->_mmdr);
+    VPackBuffer<uint8_t> buffer;
+    state->_primaryIndex->removeKey(trx, oldRevisionId, MMFilesDocumentCompression::document(vpack, buffer), state->_mmdr);
 
     physical->removeRevision(oldRevisionId, true);
   }
@@ -458,6 +476,8 @@ MMFilesCollection::MMFilesCollection(LogicalCollection* collection,
                                                    TRI_JOURNAL_DEFAULT_SIZE))),
       _isVolatile(arangodb::basics::VelocyPackHelper::readBooleanValue(
           info, "isVolatile", false)),
+      _compressDocuments(Helper::readBooleanValue(info, "compressDocuments",
+                                                  false)),
       _cleanupIndexes(0),
       _persistentIndexes(0),
       _indexBuckets(Helper::readNumericValue<uint32_t>(
@@ -488,7 +508,9 @@ MMFilesCollection::MMFilesCollection(LogicalCollection* logical,
                                      PhysicalCollection* physical)
     : PhysicalCollection(logical, VPackSlice::emptyObjectSlice()),
       _ditches(logical),
-      _isVolatile(static_cast<MMFilesCollection*>(physical)->isVolatile()) {
+      _isVolatile(static_cast<MMFilesCollection*>(physical)->isVolatile()),
+      _compressDocuments(
+          static_cast<MMFilesCollection*>(physical)->compressDocuments()) {
   _keyOptions = VPackBuilder::clone(physical->keyOptions()).steal();
   MMFilesCollection& mmfiles = *static_cast<MMFilesCollection*>(physical);
   _keyGenerator.reset(KeyGenerator::factory(mmfiles.keyOptions()));
@@ -570,6 +592,8 @@ int MMFilesCollection::close() {
     }
   }
 
+  writePrimaryIndexSnapshot();
+
   // We also have to unload the indexes.
   for (auto& idx : _indexes) {
     idx->unload();
@@ -858,7 +882,16 @@ int MMFilesCollection::closeCompactor(MMFilesDatafile* datafile) {
     return TRI_ERROR_INTERNAL;
   }
 
-  return sealDatafile(datafile, true);
+  int res = sealDatafile(datafile, true);
+
+  if (res == TRI_ERROR_NO_ERROR &&
+      MMFilesCompactorThread::settings().dropPageCache &&
+      datafile->isPhysical()) {
+    // sealing has synced the file, so all its pages can be evicted
+    datafile->dropPageCache();
+  }
+
+  return res;
 }
 
 /// @brief replace a datafile with a compactor
@@ -1114,6 +1147,7 @@ bool MMFilesCollection::closeDatafiles(std::vector<MMFilesDatafile*> const& file
 
 void MMFilesCollection::getPropertiesVPack(velocypack::Builder& result) const {
   TRI_ASSERT(result.isOpenObject());
+  result.add("compressDocuments", VPackValue(_compressDocuments));
   result.add("count", VPackValue(initialCount()));
   result.add("doCompact", VPackValue(_doCompact));
   result.add("indexBuckets", VPackValue(_indexBuckets));
@@ -1133,6 +1167,48 @@ void MMFilesCollection::getPropertiesVPack(velocypack::Builder& result) const {
   TRI_ASSERT(result.isOpenObject());
 }
 
+/// @brief number of bytes of the files that are resident in memory
+size_t MMFilesCollection::residentSize(
+    std::vector<MMFilesDatafile*> const& files) {
+  size_t resident = 0;
+  for (auto const& it : files) {
+    resident += it->residentSize();
+  }
+  return resident;
+}
+
+bool MMFilesCollection::releaseIdleDatafiles(double now, double timeout) {
+  if (_documentsRead.load(std::memory_order_relaxed)) {
+    _documentsRead.store(false, std::memory_order_relaxed);
+    _lastDocumentsRead = now;
+    _datafilesReleased = false;
+    return false;
+  }
+
+  if (_lastDocumentsRead == 0.0) {
+    // first check. start counting from now
+    _lastDocumentsRead = now;
+    return false;
+  }
+
+  if (_datafilesReleased || now - _lastDocumentsRead < timeout) {
+    return false;
+  }
+
+  READ_LOCKER(readLocker, _filesLock);
+
+  for (auto& it : _datafiles) {
+    if (it->isPhysical()) {
+      it->dontNeed();
+    }
+  }
+  _datafilesReleased = true;
+
+  LOG_TOPIC(DEBUG, Logger::COMPACTOR) << "released pages of " << _datafiles.size() << " idle datafile(s) of collection '" << _logicalCollection->name() << "'";
+
+  return true;
+}
+
 void MMFilesCollection::figuresSpecific(std::shared_ptr<arangodb::velocypack::Builder>& builder) {
 
   // fills in compaction status
@@ -1195,6 +1271,7 @@ void MMFilesCollection::figuresSpecific(std::shared_ptr<arangodb::velocypack::Bu
 
   builder->add("count", VPackValue(_datafiles.size()));
   builder->add("fileSize", VPackValue(sizeDatafiles));
+  builder->add("residentSize", VPackValue(residentSize(_datafiles)));
   builder->close(); // datafiles
   
   size_t sizeJournals = 0;
@@ -1204,6 +1281,7 @@ void MMFilesCollection::figuresSpecific(std::shared_ptr<arangodb::velocypack::Bu
   builder->add("journals", VPackValue(VPackValueType::Object));
   builder->add("count", VPackValue(_journals.size()));
   builder->add("fileSize", VPackValue(sizeJournals));
+  builder->add("residentSize", VPackValue(residentSize(_journals)));
   builder->close(); // journals
   
   size_t sizeCompactors = 0;
@@ -1213,6 +1291,7 @@ void MMFilesCollection::figuresSpecific(std::shared_ptr<arangodb::velocypack::Bu
   builder->add("compactors", VPackValue(VPackValueType::Object));
   builder->add("count", VPackValue(_compactors.size()));
   builder->add("fileSize", VPackValue(sizeCompactors));
+  builder->add("residentSize", VPackValue(residentSize(_compactors)));
   builder->close(); // compactors
   
   builder->add("revisions", VPackValue(VPackValueType::Object));
@@ -1623,6 +1702,214 @@ int MMFilesCollection::fillIndexes(
   return queue.status();
 }
 
+/// @brief operations captured for an index build that may be applied
+/// while holding the write lock. as long as more changes are pending, they
+/// are applied without the lock, for at most MaxIndexCatchUpRounds rounds
+static size_t const MaxIndexChangesUnderLock = 10000;
+static size_t const MaxIndexCatchUpRounds = 10;
+
+/// @brief fill, persist and add an index without blocking writes
+int MMFilesCollection::buildIndexInBackground(
+    transaction::Methods* trx, VPackSlice const& info,
+    std::shared_ptr<arangodb::Index> idx,
+    std::shared_ptr<arangodb::Index>& existing) {
+  TRI_ASSERT(!ServerState::instance()->isCoordinator());
+  TRI_ASSERT(idx->type() != Index::IndexType::TRI_IDX_TYPE_PRIMARY_INDEX);
+  TRI_ASSERT(!idx->isPersistent());
+
+  PerformanceLogScope logScope(
+      std::string("fill-index-in-background { collection: ") +
+      _logicalCollection->vocbase()->name() + "/" +
+      _logicalCollection->name() + " }");
+
+  // the ditch keeps the documents of the snapshot in place while they are
+  // read without holding the collection lock
+  MMFilesDocumentDitch* ditch = nullptr;
+  StorageEngine* engine = EngineSelectorFeature::ENGINE;
+  engine->preventCompaction(_logicalCollection->vocbase(),
+                            [this, &ditch](TRI_vocbase_t*) {
+                              ditch = _ditches.createMMFilesDocumentDitch(
+                                  false, __FILE__, __LINE__);
+                            });
+
+  if (ditch == nullptr) {
+    return TRI_ERROR_OUT_OF_MEMORY;
+  }
+
+  TRI_DEFER(_ditches.freeMMFilesDocumentDitch(ditch, false));
+
+  std::shared_ptr<MMFilesIndexBuilds::Build> build;
+  std::vector<TRI_voc_rid_t> revisions;
+
+  // take the snapshot, and capture all operations from now on
+  {
+    MMFilesCollectionWriteLocker locker(this, true, true);
+
+    existing = lookupIndex(info);
+    if (existing != nullptr) {
+      // the index was created concurrently
+      return TRI_ERROR_NO_ERROR;
+    }
+
+    auto primaryIdx = primaryIndex();
+    revisions.reserve(primaryIdx->size());
+
+    arangodb::basics::BucketPosition position;
+    uint64_t total = 0;
+
+    while (true) {
+      MMFilesSimpleIndexElement element =
+          primaryIdx->lookupSequential(trx, position, total);
+
+      if (!element) {
+        break;
+      }
+      revisions.emplace_back(element.revisionId());
+    }
+
+    build = _indexBuilds.add(trx);
+  }
+
+  int res = TRI_ERROR_NO_ERROR;
+
+  try {
+    idx->sizeHint(trx, revisions.size());
+
+    res = fillIndexFromSnapshot(trx, idx.get(), revisions);
+    revisions.clear();
+    revisions.shrink_to_fit();
+
+    // catch up with the operations since the snapshot, while they are
+    // still being performed
+    for (size_t round = 0;
+         res == TRI_ERROR_NO_ERROR && round < MaxIndexCatchUpRounds; ++round) {
+      MMFilesIndexBuilds::Changes changes;
+      if (!build->takeChanges(changes, MaxIndexChangesUnderLock)) {
+        break;
+      }
+      res = applyIndexBuildChanges(trx, idx.get(), changes);
+    }
+  } catch (arangodb::basics::Exception const& ex) {
+    res = ex.code();
+  } catch (std::bad_alloc const&) {
+    res = TRI_ERROR_OUT_OF_MEMORY;
+  } catch (...) {
+    res = TRI_ERROR_INTERNAL;
+  }
+
+  // apply the remaining operations and switch the index live
+  MMFilesCollectionWriteLocker locker(this, true, true);
+
+  try {
+    if (res == TRI_ERROR_NO_ERROR) {
+      MMFilesIndexBuilds::Changes changes;
+      build->takeChanges(changes, 0);
+      res = applyIndexBuildChanges(trx, idx.get(), changes);
+    }
+
+    if (res == TRI_ERROR_NO_ERROR) {
+      existing = lookupIndex(info);
+      if (existing == nullptr) {
+        res = persistIndex(idx);
+      }
+    }
+  } catch (arangodb::basics::Exception const& ex) {
+    res = ex.code();
+  } catch (...) {
+    res = TRI_ERROR_INTERNAL;
+  }
+
+  _indexBuilds.remove(build);
+
+  if (res == TRI_ERROR_NO_ERROR && existing == nullptr) {
+    addIndex(idx);
+  }
+
+  return res;
+}
+
+/// @brief fill an index with the documents of the given revisions
+int MMFilesCollection::fillIndexFromSnapshot(
+    transaction::Methods* trx, arangodb::Index* idx,
+    std::vector<TRI_voc_rid_t> const& revisions) {
+  TRI_ASSERT(SchedulerFeature::SCHEDULER != nullptr);
+  auto ioService = SchedulerFeature::SCHEDULER->ioService();
+  TRI_ASSERT(ioService != nullptr);
+  arangodb::basics::LocalTaskQueue queue(ioService);
+
+  // process documents a million at a time
+  size_t const blockSize = 1024 * 1024 * 1;
+
+  std::vector<std::pair<TRI_voc_rid_t, VPackSlice>> documents;
+  documents.reserve((std::min)(blockSize, revisions.size()));
+
+  for (auto const& revisionId : revisions) {
+    uint8_t const* vpack = lookupIndexBuildVPack(trx, revisionId);
+
+    if (vpack != nullptr) {
+      documents.emplace_back(std::make_pair(revisionId, VPackSlice(vpack)));
+    }
+
+    if (documents.size() == blockSize) {
+      fillIndex(&queue, trx, idx, documents, false);
+      queue.dispatchAndWait();
+
+      if (queue.status() != TRI_ERROR_NO_ERROR) {
+        return queue.status();
+      }
+      documents.clear();
+    }
+  }
+
+  if (!documents.empty()) {
+    fillIndex(&queue, trx, idx, documents, false);
+    queue.dispatchAndWait();
+  }
+
+  return queue.status();
+}
+
+/// @brief apply the operations captured for an index build to the index
+int MMFilesCollection::applyIndexBuildChanges(
+    transaction::Methods* trx, arangodb::Index* idx,
+    MMFilesIndexBuilds::Changes const& changes) {
+  for (auto const& it : changes) {
+    uint8_t const* vpack = lookupIndexBuildVPack(trx, it.first);
+
+    if (vpack == nullptr) {
+      // removed documents are kept until the build is finished
+      TRI_ASSERT(false);
+      continue;
+    }
+
+    if (it.second) {
+      int res = idx->insert(trx, it.first, VPackSlice(vpack), false);
+
+      if (res != TRI_ERROR_NO_ERROR) {
+        return res;
+      }
+    } else {
+      // the document may not be contained in the index, if it was removed
+      // before it was read from the snapshot
+      idx->remove(trx, it.first, VPackSlice(vpack), false);
+    }
+  }
+
+  return TRI_ERROR_NO_ERROR;
+}
+
+/// @brief look up a document for an index build
+uint8_t const* MMFilesCollection::lookupIndexBuildVPack(
+    transaction::Methods* trx, TRI_voc_rid_t revisionId) const {
+  uint8_t const* vpack =
+      lookupRevisionVPackConditional(revisionId, 0, false);
+
+  if (vpack == nullptr) {
+    vpack = _indexBuilds.lookupRemoved(trx, revisionId);
+  }
+  return vpack;
+}
+
 /// @brief opens an existing collection
 int MMFilesCollection::openWorker(bool ignoreErrors) {
   auto vocbase = _logicalCollection->vocbase();
@@ -1761,12 +2048,17 @@ int MMFilesCollection::iterateMarkersOnLoad(transaction::Methods* trx) {
     openState._initialCount = _initialCount;
   }
 
-  // read all documents and fill primary index
-  auto cb = [&openState](TRI_df_marker_t const* marker, MMFilesDatafile* datafile) -> bool {
-    return OpenIterator(marker, &openState, datafile); 
-  };
+  if (readPrimaryIndexSnapshot(openState)) {
+    LOG_TOPIC(DEBUG, arangodb::Logger::FIXME) << "filled primary index of collection '" << _logicalCollection->name() 
+               << "' from snapshot";
+  } else {
+    // read all documents and fill primary index
+    auto cb = [&openState](TRI_df_marker_t const* marker, MMFilesDatafile* datafile) -> bool {
+      return OpenIterator(marker, &openState, datafile); 
+    };
 
-  iterateDatafiles(cb);
+    iterateDatafiles(cb);
+  }
     
   LOG_TOPIC(TRACE, arangodb::Logger::FIXME) << "found " << openState._documents << " document markers, " 
              << openState._deletions << " deletion markers for collection '" << _logicalCollection->name() << "'";
@@ -1797,6 +2089,297 @@ int MMFilesCollection::iterateMarkersOnLoad(transaction::Methods* trx) {
   return TRI_ERROR_NO_ERROR;
 }
 
+/// @brief name of the file holding the primary index snapshot
+std::string MMFilesCollection::primaryIndexSnapshotFilename() const {
+  return arangodb::basics::FileUtils::buildFilename(path(), "snapshot-primary.vpack");
+}
+
+/// @brief write a snapshot of the primary index and the revisions cache.
+/// the snapshot contains the position of each live document in the
+/// datafiles, plus the statistics and tick ranges of the datafiles. it
+/// can only be used as long as the datafiles remain unchanged
+void MMFilesCollection::writePrimaryIndexSnapshot() {
+  auto engine = static_cast<MMFilesEngine*>(EngineSelectorFeature::ENGINE);
+
+  // key generators that track keys would need the keys of removed
+  // documents too, so these collections are always scanned
+  if (!engine->usePrimaryIndexSnapshots() || engine->inRecovery() ||
+      _isVolatile || keyGenerator()->trackKeys() ||
+      _logicalCollection->deleted() ||
+      _logicalCollection->vocbase()->isDropped()) {
+    return;
+  }
+
+  std::string const filename = primaryIndexSnapshotFilename();
+  std::string const tmp = filename + ".tmp";
+
+  try {
+    MMFilesPrimaryIndexSnapshot snapshot;
+    std::unordered_map<TRI_voc_fid_t, MMFilesDatafile const*> files;
+    std::unordered_map<TRI_voc_fid_t, std::vector<uint64_t>> offsets;
+    bool valid = true;
+
+    {
+      READ_LOCKER(readLocker, _filesLock);
+
+      if (!_compactors.empty()) {
+        return;
+      }
+
+      snapshot.lastRevision = _lastRevision;
+      snapshot.maxTick = _maxTick;
+
+      for (auto const* list : {&_datafiles, &_journals}) {
+        for (auto const& datafile : *list) {
+          DatafileStatisticsContainer const dfi =
+              _datafileStatistics.get(datafile->fid());
+
+          files.emplace(datafile->fid(), datafile);
+
+          MMFilesPrimaryIndexSnapshot::Datafile entry;
+          entry.fid = datafile->fid();
+          entry.size = datafile->currentSize();
+          entry.tickMin = datafile->_tickMin;
+          entry.tickMax = datafile->_tickMax;
+          entry.dataMin = datafile->_dataMin;
+          entry.dataMax = datafile->_dataMax;
+          entry.numberAlive = dfi.numberAlive;
+          entry.numberDead = dfi.numberDead;
+          entry.numberDeletions = dfi.numberDeletions;
+          entry.sizeAlive = dfi.sizeAlive;
+          entry.sizeDead = dfi.sizeDead;
+          snapshot.datafiles.emplace_back(entry);
+        }
+      }
+
+      primaryIndex()->invokeOnAllElements(
+          [&](DocumentIdentifierToken const& token) -> bool {
+            auto tkn = static_cast<MMFilesToken const*>(&token);
+            MMFilesDocumentPosition const old =
+                _revisionsCache.lookup(tkn->revisionId());
+            auto it = files.find(old.fid());
+
+            if (!old || old.pointsToWal() || it == files.end()) {
+              // the document is not in a datafile
+              valid = false;
+              return false;
+            }
+
+            char const* begin = (*it).second->data();
+            char const* p = static_cast<char const*>(old.dataptr());
+
+            if (p < begin || p >= begin + (*it).second->currentSize()) {
+              valid = false;
+              return false;
+            }
+
+            offsets[old.fid()].emplace_back(static_cast<uint64_t>(p - begin));
+            return true;
+          });
+    }
+
+    if (!valid) {
+      LOG_TOPIC(DEBUG, arangodb::Logger::FIXME) << "not writing primary index snapshot for collection '" 
+                 << _logicalCollection->name() << "' because it has uncollected documents";
+      return;
+    }
+
+    for (auto& it : offsets) {
+      snapshot.documents.emplace_back(
+          MMFilesPrimaryIndexSnapshot::Documents{it.first, std::move(it.second)});
+    }
+
+    VPackBuilder builder;
+    snapshot.toVelocyPack(builder);
+
+    VPackSlice const slice = builder.slice();
+    arangodb::basics::FileUtils::spit(tmp, slice.startAs<char>(), static_cast<size_t>(slice.byteSize()));
+
+    int res = TRI_RenameFile(tmp.c_str(), filename.c_str());
+
+    if (res != TRI_ERROR_NO_ERROR) {
+      THROW_ARANGO_EXCEPTION(res);
+    }
+
+    LOG_TOPIC(DEBUG, arangodb::Logger::FIXME) << "wrote primary index snapshot for collection '" 
+               << _logicalCollection->name() << "'";
+  } catch (basics::Exception const& ex) {
+    LOG_TOPIC(WARN, arangodb::Logger::FIXME) << "unable to write primary index snapshot for collection '"
+              << _logicalCollection->name() << "': " << ex.what();
+    arangodb::basics::FileUtils::remove(tmp);
+  } catch (std::exception const& ex) {
+    LOG_TOPIC(WARN, arangodb::Logger::FIXME) << "unable to write primary index snapshot for collection '"
+              << _logicalCollection->name() << "': " << ex.what();
+    arangodb::basics::FileUtils::remove(tmp);
+  }
+}
+
+/// @brief fill the primary index and the revisions cache from a snapshot.
+/// returns false if there is no usable snapshot. the snapshot file is
+/// removed in any case, because it becomes outdated with the next write
+bool MMFilesCollection::readPrimaryIndexSnapshot(OpenIteratorState& state) {
+  std::string const filename = primaryIndexSnapshotFilename();
+
+  if (!arangodb::basics::FileUtils::exists(filename)) {
+    return false;
+  }
+
+  std::string content;
+  try {
+    content = arangodb::basics::FileUtils::slurp(filename);
+  } catch (...) {
+  }
+  arangodb::basics::FileUtils::remove(filename);
+
+  auto engine = static_cast<MMFilesEngine*>(EngineSelectorFeature::ENGINE);
+
+  if (!engine->usePrimaryIndexSnapshots() || keyGenerator()->trackKeys() ||
+      content.empty()) {
+    return false;
+  }
+
+  size_t const vpackOffset = MMFilesDatafileHelper::VPackOffset(TRI_DF_MARKER_VPACK_DOCUMENT);
+  std::unordered_map<TRI_voc_fid_t, MMFilesDatafile*> files;
+  bool modified = false;
+
+  READ_LOCKER(readLocker, _filesLock);
+
+  try {
+    VPackValidator validator;
+    validator.validate(content.data(), content.size());
+
+    MMFilesPrimaryIndexSnapshot snapshot;
+
+    if (!snapshot.fromVelocyPack(VPackSlice(content.data())) ||
+        !_compactors.empty()) {
+      return false;
+    }
+
+    for (auto const* list : {&_datafiles, &_journals}) {
+      for (auto const& datafile : *list) {
+        files.emplace(datafile->fid(), datafile);
+      }
+    }
+
+    // the snapshot must have been taken for exactly the same datafiles
+    if (snapshot.datafiles.size() != files.size()) {
+      return false;
+    }
+
+    for (auto const& it : snapshot.datafiles) {
+      auto f = files.find(it.fid);
+
+      if (f == files.end() || (*f).second->currentSize() != it.size) {
+        LOG_TOPIC(DEBUG, arangodb::Logger::FIXME) << "primary index snapshot of collection '" 
+                   << _logicalCollection->name() << "' is outdated";
+        return false;
+      }
+    }
+
+    // check all document positions before modifying anything
+    for (auto const& it : snapshot.documents) {
+      auto f = files.find(it.fid);
+
+      if (f == files.end()) {
+        return false;
+      }
+
+      char const* begin = (*f).second->data();
+      uint64_t const size = (*f).second->currentSize();
+
+      for (auto const& o : it.offsets) {
+        if (o < vpackOffset || o >= size) {
+          return false;
+        }
+
+        auto marker = reinterpret_cast<TRI_df_marker_t const*>(begin + o - vpackOffset);
+
+        if (marker->getType() != TRI_DF_MARKER_VPACK_DOCUMENT ||
+            o - vpackOffset + marker->getSize() > size) {
+          return false;
+        }
+      }
+    }
+
+    modified = true;
+
+    for (auto const& it : snapshot.datafiles) {
+      MMFilesDatafile* datafile = files[it.fid];
+
+      datafile->_tickMin = it.tickMin;
+      datafile->_tickMax = it.tickMax;
+      datafile->_dataMin = it.dataMin;
+      datafile->_dataMax = it.dataMax;
+
+      DatafileStatisticsContainer* dfi = FindDatafileStats(&state, datafile->fid());
+      dfi->numberAlive = it.numberAlive;
+      dfi->numberDead = it.numberDead;
+      dfi->numberDeletions = it.numberDeletions;
+      dfi->sizeAlive = it.sizeAlive;
+      dfi->sizeDead = it.sizeDead;
+    }
+
+    setRevision(snapshot.lastRevision, false);
+    // WAL recovery skips the markers up to this tick
+    _maxTick = snapshot.maxTick;
+
+    VPackBuffer<uint8_t> buffer;
+
+    for (auto const& it : snapshot.documents) {
+      char const* begin = files[it.fid]->data();
+
+      for (auto const& o : it.offsets) {
+        uint8_t const* vpack = reinterpret_cast<uint8_t const*>(begin + o);
+        VPackSlice const doc = MMFilesDocumentCompression::document(vpack, buffer);
+        TRI_voc_rid_t const revisionId = transaction::helpers::extractRevFromDocument(doc);
+
+        insertRevision(revisionId, vpack, it.fid, false, false);
+
+        int res = state._primaryIndex->insertKey(state._trx, revisionId, doc, state._mmdr);
+
+        if (res != TRI_ERROR_NO_ERROR) {
+          THROW_ARANGO_EXCEPTION(res);
+        }
+
+        ++state._documents;
+        if (++state._operations % 1024 == 0) {
+          state._mmdr.clear();
+        }
+      }
+    }
+
+    return true;
+  } catch (...) {
+  }
+
+  LOG_TOPIC(WARN, arangodb::Logger::FIXME) << "unable to use primary index snapshot of collection '" 
+            << _logicalCollection->name() << "', scanning datafiles instead";
+
+  if (modified) {
+    // undo everything, so the datafiles can be scanned from scratch
+    state._primaryIndex->unload();
+    _revisionsCache.clear();
+
+    for (auto& it : state._stats) {
+      delete it.second;
+    }
+    state._stats.clear();
+    state._dfi = nullptr;
+    state._fid = 0;
+    state._documents = 0;
+    _maxTick = 0;
+
+    for (auto& it : files) {
+      it.second->_tickMin = 0;
+      it.second->_tickMax = 0;
+      it.second->_dataMin = 0;
+      it.second->_dataMax = 0;
+    }
+  }
+
+  return false;
+}
+
 
 int MMFilesCollection::read(transaction::Methods* trx, VPackSlice const key,
                             ManagedDocumentResult& result, bool lock) {
@@ -1809,11 +2392,28 @@ int MMFilesCollection::read(transaction::Methods* trx, VPackSlice const key,
     THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
   }
 
+  TRI_voc_tick_t const snapshotTick =
+      static_cast<MMFilesTransactionState*>(trx->state())->snapshotTick();
+  int res;
+
+  if (snapshotTick != 0 &&
+      lookupSnapshotDocument(trx, key, snapshotTick, result, res)) {
+    // the document was modified after the snapshot was taken. the revision
+    // the snapshot sees is read without the collection lock
+    return res;
+  }
+
   bool const useDeadlockDetector =
       (lock && !trx->isSingleOperationTransaction());
   MMFilesCollectionReadLocker collectionLocker(this, useDeadlockDetector, lock);
 
-  int res = lookupDocument(trx, key, result);
+  if (snapshotTick != 0 &&
+      lookupSnapshotDocument(trx, key, snapshotTick, result, res)) {
+    // modified after the first check, but before we got the lock
+    return res;
+  }
+
+  res = lookupDocument(trx, key, result);
 
   if (res != TRI_ERROR_NO_ERROR) {
     return res;
@@ -1823,11 +2423,59 @@ int MMFilesCollection::read(transaction::Methods* trx, VPackSlice const key,
   return TRI_ERROR_NO_ERROR;
 }
 
+int MMFilesCollection::readInto(transaction::Methods* trx,
+                                StringRef const& key,
+                                std::vector<std::string> const& projections,
+                                VPackBuilder& result, bool lock) {
+  auto engine = static_cast<MMFilesEngine*>(EngineSelectorFeature::ENGINE);
+  // the cache holds current revisions, which snapshots may not see
+  bool const useCache =
+      engine->useDocumentCache() && !_isVolatile &&
+      static_cast<MMFilesTransactionState*>(trx->state())->snapshotTick() == 0;
+
+  if (useCache && _documentCache.lookup(trx, key, projections, result)) {
+    return TRI_ERROR_NO_ERROR;
+  }
+
+  transaction::BuilderLeaser builder(trx);
+  builder->add(VPackValuePair(key.data(), key.size(), VPackValueType::String));
+
+  ManagedDocumentResult mmdr;
+  int res = read(trx, builder->slice(), mmdr, lock);
+
+  if (res != TRI_ERROR_NO_ERROR) {
+    return res;
+  }
+
+  VPackSlice document(mmdr.vpack());
+  if (projections.empty()) {
+    result.addExternal(mmdr.vpack());
+  } else {
+    MMFilesDocumentCache::buildProjection(result, document, projections);
+  }
+
+  if (useCache) {
+    _documentCache.store(trx, key, projections, document);
+  }
+  return TRI_ERROR_NO_ERROR;
+}
+
 bool MMFilesCollection::readDocument(transaction::Methods* trx,
                                      DocumentIdentifierToken const& token,
                                      ManagedDocumentResult& result) {
   auto tkn = static_cast<MMFilesToken const*>(&token);
   TRI_voc_rid_t revisionId = tkn->revisionId();
+
+  if (!_indexBuilds.empty()) {
+    // an index built in the background may still contain documents that
+    // were removed in the meantime
+    uint8_t const* vpack = lookupIndexBuildVPack(trx, revisionId);
+    if (vpack != nullptr) {
+      result.addExisting(vpack, revisionId);
+      return true;
+    }
+  }
+
   uint8_t const* vpack = lookupRevisionVPack(revisionId);
   if (vpack != nullptr) {
     result.addExisting(vpack, revisionId);
@@ -1837,6 +2485,48 @@ bool MMFilesCollection::readDocument(transaction::Methods* trx,
 
 }
 
+/// @brief read the documents of many tokens at once. this only takes the
+/// locks of the revisions cache and of the index build documents, so it can
+/// be called by several threads at once
+void MMFilesCollection::readDocuments(
+    transaction::Methods* trx,
+    std::vector<DocumentIdentifierToken> const& tokens,
+    std::vector<uint8_t const*>& result) {
+  result.clear();
+  if (tokens.empty()) {
+    return;
+  }
+
+  std::vector<TRI_voc_rid_t> revisionIds;
+  revisionIds.reserve(tokens.size());
+  for (auto const& token : tokens) {
+    revisionIds.emplace_back(
+        static_cast<MMFilesToken const*>(&token)->revisionId());
+  }
+
+  std::vector<MMFilesDocumentPosition> positions;
+  _revisionsCache.lookup(revisionIds, positions);
+
+  bool const hasIndexBuilds = !_indexBuilds.empty();
+  result.reserve(positions.size());
+  for (size_t i = 0; i < positions.size(); ++i) {
+    uint8_t const* vpack = nullptr;
+    if (hasIndexBuilds) {
+      // an index built in the background may still contain documents that
+      // were removed in the meantime
+      vpack = lookupIndexBuildVPack(trx, revisionIds[i]);
+    }
+    if (vpack == nullptr && positions[i]) {
+      vpack = uncompressedVPack(
+          revisionIds[i], static_cast<uint8_t const*>(positions[i].dataptr()));
+      // the caller reads the documents next
+      TRI_PREFETCH(vpack);
+    }
+    result.emplace_back(vpack);
+  }
+  markDocumentsRead();
+}
+
 bool MMFilesCollection::readDocumentConditional(
     transaction::Methods* trx, DocumentIdentifierToken const& token,
     TRI_voc_tick_t maxTick, ManagedDocumentResult& result) {
@@ -1966,17 +2656,41 @@ std::shared_ptr<Index> MMFilesCollection::createIndex(transaction::Methods* trx,
     return idx;
   }
 
-  int res = saveIndex(trx, idx);
+  // indexes with in-memory data can be filled without blocking writes.
+  // this requires that the calling transaction does not hold the write lock
+  bool const inBackground =
+      basics::VelocyPackHelper::getBooleanValue(info, "inBackground", false) &&
+      !idx->isPersistent() && !engine->inRecovery() &&
+      !trx->isLocked(_logicalCollection, AccessMode::Type::WRITE);
 
-  if (res != TRI_ERROR_NO_ERROR) {
-    THROW_ARANGO_EXCEPTION(res);
+  if (inBackground) {
+    std::shared_ptr<Index> existing;
+    int res = buildIndexInBackground(trx, info, idx, existing);
+
+    if (res != TRI_ERROR_NO_ERROR) {
+      THROW_ARANGO_EXCEPTION(res);
+    }
+
+    if (existing != nullptr) {
+      created = false;
+      return existing;
+    }
+  } else {
+    int res = saveIndex(trx, idx);
+
+    if (res != TRI_ERROR_NO_ERROR) {
+      THROW_ARANGO_EXCEPTION(res);
+    }
   }
 
   arangodb::aql::PlanCache::instance()->invalidate(_logicalCollection->vocbase());
   // Until here no harm is done if sth fails. The shared ptr will clean up. if
   // left before
 
-  addIndex(idx);
+  if (!inBackground) {
+    // a background build has added the index under the write lock already
+    addIndex(idx);
+  }
   {
     bool const doSync =
         application_features::ApplicationServer::getFeature<DatabaseFeature>(
@@ -2005,6 +2719,12 @@ int MMFilesCollection::saveIndex(transaction::Methods* trx, std::shared_ptr<aran
     return res;
   }
 
+  return persistIndex(idx);
+}
+
+/// @brief write the definition of a filled index to disk and the WAL
+int MMFilesCollection::persistIndex(std::shared_ptr<arangodb::Index> idx) {
+  int res = TRI_ERROR_NO_ERROR;
   std::shared_ptr<VPackBuilder> builder;
   try {
     builder = idx->toVelocyPack(false);
@@ -2214,6 +2934,11 @@ bool MMFilesCollection::removeIndex(TRI_idx_iid_t iid) {
 
 
 
+/// @brief remove the previous revisions no snapshot can see anymore
+void MMFilesCollection::pruneRevisionHistory() {
+  _revisionHistory.prune(MMFilesSnapshots::oldest());
+}
+
 /// @brief garbage-collect a collection's indexes
 int MMFilesCollection::cleanupIndexes() {
   int res = TRI_ERROR_NO_ERROR;
@@ -2243,6 +2968,16 @@ std::unique_ptr<IndexIterator> MMFilesCollection::getAnyIterator(transaction::Me
   return std::unique_ptr<IndexIterator>(primaryIndex()->anyIterator(trx, mdr));
 }
 
+/// @brief number of partitions a full collection scan can be split into.
+/// each bucket of the primary index is a partition
+size_t MMFilesCollection::numScanPartitions() const {
+  return primaryIndex()->numBuckets();
+}
+
+std::unique_ptr<IndexIterator> MMFilesCollection::getPartitionIterator(transaction::Methods* trx, ManagedDocumentResult* mdr, size_t partition){
+  return std::unique_ptr<IndexIterator>(primaryIndex()->bucketIterator(trx, mdr, partition));
+}
+
 void MMFilesCollection::invokeOnAllElements(std::function<bool(DocumentIdentifierToken const&)> callback){
   primaryIndex()->invokeOnAllElements(callback);
 }
@@ -2591,10 +3326,17 @@ int MMFilesCollection::insert(transaction::Methods* trx,
     newSlice = slice;
   }
 
+  transaction::BuilderLeaser compressed(trx);
+  VPackSlice markerSlice = newSlice;
+  if (_compressDocuments && options.recoveryData == nullptr) {
+    MMFilesDocumentCompression::compress(newSlice, *compressed.get());
+    markerSlice = compressed->slice();
+  }
+
   // create marker
   MMFilesCrudMarker insertMarker(
       TRI_DF_MARKER_VPACK_DOCUMENT,
-      static_cast<MMFilesTransactionState*>(trx->state())->idForMarker(), newSlice);
+      static_cast<MMFilesTransactionState*>(trx->state())->idForMarker(), markerSlice);
 
   MMFilesWalMarker const* marker;
   if (options.recoveryData == nullptr) {
@@ -2624,9 +3366,10 @@ int MMFilesCollection::insert(transaction::Methods* trx,
   }
 
   TRI_voc_rid_t revisionId = transaction::helpers::extractRevFromDocument(newSlice);
-  VPackSlice doc(marker->vpack());
+  // the marker may contain the compressed document
+  VPackSlice doc(newSlice);
   operation.setRevisions(DocumentDescriptor(),
-                         DocumentDescriptor(revisionId, doc.begin()));
+                         DocumentDescriptor(revisionId, marker->vpack()));
 
   MMFilesDocumentPosition old;
 
@@ -2656,6 +3399,16 @@ int MMFilesCollection::insert(transaction::Methods* trx,
         // insert into indexes
         res = insertDocument(trx, revisionId, doc, operation, marker,
                              options.waitForSync);
+
+        if (res == TRI_ERROR_NO_ERROR) {
+          // only now is it certain that the document did not exist before,
+          // i.e. the insert did not violate a unique constraint. a snapshot
+          // reader that does not find the entry yet takes the read lock,
+          // and so waits for it. the entry is removed again if the
+          // transaction is rolled back
+          VPackSlice key = transaction::helpers::extractKeyFromDocument(doc);
+          recordPreviousRevision(trx, key, VPackSlice());
+        }
       } catch (basics::Exception const& ex) {
         res = ex.code();
       } catch (std::bad_alloc const&) {
@@ -2717,8 +3470,10 @@ uint8_t const* MMFilesCollection::lookupRevisionVPack(TRI_voc_rid_t revisionId)
 
   MMFilesDocumentPosition const old = _revisionsCache.lookup(revisionId);
   if (old) {
-    uint8_t const* vpack = static_cast<uint8_t const*>(old.dataptr());
+    uint8_t const* vpack = uncompressedVPack(
+        revisionId, static_cast<uint8_t const*>(old.dataptr()));
     TRI_ASSERT(VPackSlice(vpack).isObject());
+    markDocumentsRead();
     return vpack;
   }
   THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL, "got invalid vpack value on lookup");
@@ -2735,6 +3490,7 @@ uint8_t const* MMFilesCollection::lookupRevisionVPackConditional(TRI_voc_rid_t r
     return nullptr;
   }
 
+  markDocumentsRead();
   uint8_t const* vpack = static_cast<uint8_t const*>(old.dataptr());
 
   if (maxTick > 0) {
@@ -2744,7 +3500,35 @@ uint8_t const* MMFilesCollection::lookupRevisionVPackConditional(TRI_voc_rid_t r
     }
   }
 
-  return vpack; 
+  return uncompressedVPack(revisionId, vpack);
+}
+
+/// @brief the VelocyPack of the document marker of a document, which the
+/// revisions cache holds. doc is the document itself
+uint8_t const* MMFilesCollection::storedVPack(TRI_voc_rid_t revisionId,
+                                              uint8_t const* doc) const {
+  if (!_compressDocuments) {
+    return doc;
+  }
+  MMFilesDocumentPosition const old = _revisionsCache.lookup(revisionId);
+  if (!old) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL, "got invalid vpack value on lookup");
+  }
+  return static_cast<uint8_t const*>(old.dataptr());
+}
+
+uint8_t const* MMFilesCollection::uncompressedVPack(TRI_voc_rid_t revisionId,
+                                                    uint8_t const* vpack) const {
+  if (!MMFilesDocumentCompression::isCompressed(vpack)) {
+    return vpack;
+  }
+  return _decompressedDocuments.lookup(revisionId, vpack);
+}
+
+void MMFilesCollection::releaseDecompressedDocuments() {
+  _decompressedDocuments.release([this]() {
+    return !_ditches.contains(MMFilesDitch::TRI_DITCH_DOCUMENT);
+  });
 }
 
 MMFilesDocumentPosition MMFilesCollection::insertRevision(TRI_voc_rid_t revisionId, uint8_t const* dataptr, TRI_voc_fid_t fid, bool isInWal, bool shouldLock) {
@@ -2817,6 +3601,14 @@ int MMFilesCollection::insertSecondaryIndexes(arangodb::transaction::Methods* tr
     return TRI_ERROR_NO_ERROR;
   }
 
+  if (!_indexBuilds.empty()) {
+    try {
+      _indexBuilds.capture(revisionId, doc, true);
+    } catch (...) {
+      return TRI_ERROR_OUT_OF_MEMORY;
+    }
+  }
+
   int result = TRI_ERROR_NO_ERROR;
 
   auto indexes = _indexes;
@@ -2863,6 +3655,14 @@ int MMFilesCollection::deleteSecondaryIndexes(arangodb::transaction::Methods* tr
 
   TRI_IF_FAILURE("DeleteSecondaryIndexes") { return TRI_ERROR_DEBUG; }
 
+  if (!_indexBuilds.empty()) {
+    try {
+      _indexBuilds.capture(revisionId, doc, false);
+    } catch (...) {
+      return TRI_ERROR_OUT_OF_MEMORY;
+    }
+  }
+
   int result = TRI_ERROR_NO_ERROR;
 
   // TODO FIXME
@@ -2983,6 +3783,9 @@ int MMFilesCollection::update(arangodb::transaction::Methods* trx,
     return res;
   }
 
+  _documentCache.invalidate(trx, StringRef(key));
+  recordPreviousRevision(trx, key, VPackSlice(previous.vpack()));
+
   uint8_t const* vpack = previous.vpack();
   VPackSlice oldDoc(vpack);
   TRI_voc_rid_t oldRevisionId =
@@ -3035,10 +3838,17 @@ int MMFilesCollection::update(arangodb::transaction::Methods* trx,
     }
   }
 
+  transaction::BuilderLeaser compressed(trx);
+  VPackSlice markerSlice = builder->slice();
+  if (_compressDocuments && options.recoveryData == nullptr) {
+    MMFilesDocumentCompression::compress(markerSlice, *compressed.get());
+    markerSlice = compressed->slice();
+  }
+
   // create marker
   MMFilesCrudMarker updateMarker(
       TRI_DF_MARKER_VPACK_DOCUMENT,
-      static_cast<MMFilesTransactionState*>(trx->state())->idForMarker(), builder->slice());
+      static_cast<MMFilesTransactionState*>(trx->state())->idForMarker(), markerSlice);
 
   MMFilesWalMarker const* marker;
   if (options.recoveryData == nullptr) {
@@ -3047,7 +3857,9 @@ int MMFilesCollection::update(arangodb::transaction::Methods* trx,
     marker = static_cast<MMFilesWalMarker*>(options.recoveryData);
   }
 
-  VPackSlice const newDoc(marker->vpack());
+  // the marker may contain the compressed document
+  VPackSlice const newDoc =
+      (options.recoveryData == nullptr) ? builder->slice() : newSlice;
 
   MMFilesDocumentOperation operation(_logicalCollection,
                                      TRI_VOC_DOCUMENT_OPERATION_UPDATE);
@@ -3055,8 +3867,10 @@ int MMFilesCollection::update(arangodb::transaction::Methods* trx,
   try {
     insertRevision(revisionId, marker->vpack(), 0, true, true);
     
-    operation.setRevisions(DocumentDescriptor(oldRevisionId, oldDoc.begin()),
-                           DocumentDescriptor(revisionId, newDoc.begin()));
+    operation.setRevisions(
+        DocumentDescriptor(oldRevisionId,
+                           storedVPack(oldRevisionId, oldDoc.begin())),
+        DocumentDescriptor(revisionId, marker->vpack()));
     
     if (oldRevisionId == revisionId) {
       // update with same revision id => can happen if isRestore = true
@@ -3117,6 +3931,9 @@ int MMFilesCollection::replace(
     return res;
   }
 
+  _documentCache.invalidate(trx, StringRef(key));
+  recordPreviousRevision(trx, key, VPackSlice(previous.vpack()));
+
   TRI_IF_FAILURE("ReplaceDocumentNoMarker") {
     // test what happens when no marker can be created
     return TRI_ERROR_DEBUG;
@@ -3160,10 +3977,17 @@ int MMFilesCollection::replace(
     }
   }
 
+  transaction::BuilderLeaser compressed(trx);
+  VPackSlice markerSlice = builder->slice();
+  if (_compressDocuments && options.recoveryData == nullptr) {
+    MMFilesDocumentCompression::compress(markerSlice, *compressed.get());
+    markerSlice = compressed->slice();
+  }
+
   // create marker
   MMFilesCrudMarker replaceMarker(
       TRI_DF_MARKER_VPACK_DOCUMENT,
-      static_cast<MMFilesTransactionState*>(trx->state())->idForMarker(), builder->slice());
+      static_cast<MMFilesTransactionState*>(trx->state())->idForMarker(), markerSlice);
 
   MMFilesWalMarker const* marker;
   if (options.recoveryData == nullptr) {
@@ -3172,15 +3996,18 @@ int MMFilesCollection::replace(
     marker = static_cast<MMFilesWalMarker*>(options.recoveryData);
   }
 
-  VPackSlice const newDoc(marker->vpack());
+  // the marker may contain the compressed document
+  VPackSlice const newDoc = builder->slice();
 
   MMFilesDocumentOperation operation(_logicalCollection, TRI_VOC_DOCUMENT_OPERATION_REPLACE);
 
   try {
     insertRevision(revisionId, marker->vpack(), 0, true, true);
     
-    operation.setRevisions(DocumentDescriptor(oldRevisionId, oldDoc.begin()),
-                           DocumentDescriptor(revisionId, newDoc.begin()));
+    operation.setRevisions(
+        DocumentDescriptor(oldRevisionId,
+                           storedVPack(oldRevisionId, oldDoc.begin())),
+        DocumentDescriptor(revisionId, marker->vpack()));
     
     if (oldRevisionId == revisionId) {
       // update with same revision id => can happen if isRestore = true
@@ -3280,6 +4107,9 @@ int MMFilesCollection::remove(arangodb::transaction::Methods* trx, VPackSlice co
     return res;
   }
 
+  _documentCache.invalidate(trx, StringRef(key));
+  recordPreviousRevision(trx, key, VPackSlice(previous.vpack()));
+
   uint8_t const* vpack = previous.vpack();
   VPackSlice oldDoc(vpack);
   TRI_voc_rid_t oldRevisionId = arangodb::transaction::helpers::extractRevFromDocument(oldDoc);
@@ -3297,8 +4127,10 @@ int MMFilesCollection::remove(arangodb::transaction::Methods* trx, VPackSlice co
 
   // we found a document to remove
   try {
-    operation.setRevisions(DocumentDescriptor(oldRevisionId, oldDoc.begin()),
-                           DocumentDescriptor());
+    operation.setRevisions(
+        DocumentDescriptor(oldRevisionId,
+                           storedVPack(oldRevisionId, oldDoc.begin())),
+        DocumentDescriptor());
 
     // delete from indexes
     res = deleteSecondaryIndexes(trx, oldRevisionId, oldDoc, false);
@@ -3451,11 +4283,16 @@ int MMFilesCollection::removeFastPath(arangodb::transaction::Methods* trx,
   VPackSlice key = arangodb::transaction::helpers::extractKeyFromDocument(oldDoc);
   TRI_ASSERT(!key.isNone());
 
+  _documentCache.invalidate(trx, StringRef(key));
+  recordPreviousRevision(trx, key, oldDoc);
+
   MMFilesDocumentOperation operation(_logicalCollection,
                                      TRI_VOC_DOCUMENT_OPERATION_REMOVE);
 
-  operation.setRevisions(DocumentDescriptor(oldRevisionId, oldDoc.begin()),
-                         DocumentDescriptor());
+  operation.setRevisions(
+      DocumentDescriptor(oldRevisionId,
+                         storedVPack(oldRevisionId, oldDoc.begin())),
+      DocumentDescriptor());
 
   // delete from indexes
   int res;
@@ -3531,6 +4368,63 @@ int MMFilesCollection::lookupDocument(transaction::Methods* trx,
   return TRI_ERROR_ARANGO_DOCUMENT_NOT_FOUND;
 }
 
+/// @brief looks up the revision of a document visible to a snapshot
+/// returns false if the document was not modified after the snapshot was
+/// taken, so that the current revision is visible
+bool MMFilesCollection::lookupSnapshotDocument(transaction::Methods* trx,
+                                               VPackSlice const key,
+                                               TRI_voc_tick_t snapshotTick,
+                                               ManagedDocumentResult& result,
+                                               int& res) {
+  if (!key.isString()) {
+    return false;
+  }
+
+  MMFilesRevisionHistory::Document document;
+  if (!_revisionHistory.lookup(StringRef(key), snapshotTick, document)) {
+    return false;
+  }
+
+  if (document.vpack == nullptr) {
+    // the document was inserted after the snapshot was taken
+    res = TRI_ERROR_ARANGO_DOCUMENT_NOT_FOUND;
+    return true;
+  }
+
+  // the history may drop the revision as soon as the snapshot is released
+  static_cast<MMFilesTransactionState*>(trx->state())
+      ->keepSnapshotDocument(document.vpack);
+  result.addExisting(document.vpack->data(), document.revisionId);
+  res = TRI_ERROR_NO_ERROR;
+  return true;
+}
+
+/// @brief records the revision of a document before it is modified
+/// returns true if the transaction had not recorded it before
+/// the caller must make sure the write lock on the collection is held
+bool MMFilesCollection::recordPreviousRevision(transaction::Methods* trx,
+                                               VPackSlice const key,
+                                               VPackSlice const oldDoc) {
+  auto engine = static_cast<MMFilesEngine*>(EngineSelectorFeature::ENGINE);
+  if (!engine->useSnapshotReads() || !key.isString() ||
+      trx->state()->hasHint(transaction::Hints::Hint::RECOVERY)) {
+    return false;
+  }
+
+  TRI_voc_rid_t oldRevisionId = 0;
+  if (!oldDoc.isNone()) {
+    oldRevisionId = transaction::helpers::extractRevFromDocument(oldDoc);
+  }
+
+  auto state = static_cast<MMFilesTransactionState*>(trx->state());
+  StringRef keyRef(key);
+  if (!_revisionHistory.record(state->id(), keyRef, oldDoc, oldRevisionId)) {
+    return false;
+  }
+  state->addHistoryKey(&_revisionHistory, keyRef.toString());
+  return true;
+}
+
 /// @brief updates an existing document, low level worker
 /// the caller must make sure the write lock on the collection is held
 int MMFilesCollection::updateDocument(
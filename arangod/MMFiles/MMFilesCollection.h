@@ -29,7 +29,11 @@
 #include "Indexes/IndexLookupContext.h"
 #include "MMFiles/MMFilesDatafileStatistics.h"
 #include "MMFiles/MMFilesDitch.h"
+#include "MMFiles/MMFilesDocumentCache.h"
+#include "MMFiles/MMFilesDocumentCompression.h"
 #include "MMFiles/MMFilesDocumentPosition.h"
+#include "MMFiles/MMFilesIndexBuilds.h"
+#include "MMFiles/MMFilesRevisionHistory.h"
 #include "MMFiles/MMFilesRevisionsCache.h"
 #include "VocBase/KeyGenerator.h"
 #include "VocBase/ManagedDocumentResult.h"
@@ -146,6 +150,9 @@ class MMFilesCollection final : public PhysicalCollection {
   void updateCount(int64_t) override;
   size_t journalSize() const override;
   bool isVolatile() const;
+
+  /// @brief whether documents are stored compressed in the datafiles
+  bool compressDocuments() const { return _compressDocuments; }
  
   TRI_voc_tick_t maxTick() const { return _maxTick; }
   void maxTick(TRI_voc_tick_t value) { _maxTick = value; }
@@ -221,6 +228,12 @@ class MMFilesCollection final : public PhysicalCollection {
   double lastCompactionStamp() const { return _lastCompactionStamp; }
   void lastCompactionStamp(double value) { _lastCompactionStamp = value; }
 
+  /// @brief advise the kernel that the datafiles' pages are not needed
+  /// if no document was read from the collection for at least timeout
+  /// seconds. must be called periodically by the compactor thread only.
+  /// returns whether the datafiles were released
+  bool releaseIdleDatafiles(double now, double timeout);
+
   MMFilesDitches* ditches() const { return &_ditches; }
   
   void open(bool ignoreErrors) override;
@@ -272,6 +285,8 @@ class MMFilesCollection final : public PhysicalCollection {
 
  std::unique_ptr<IndexIterator> getAllIterator(transaction::Methods* trx, ManagedDocumentResult* mdr, bool reverse) override;
   std::unique_ptr<IndexIterator> getAnyIterator(transaction::Methods* trx, ManagedDocumentResult* mdr)  override;
+  size_t numScanPartitions() const override;
+  std::unique_ptr<IndexIterator> getPartitionIterator(transaction::Methods* trx, ManagedDocumentResult* mdr, size_t partition) override;
   void invokeOnAllElements(std::function<bool(DocumentIdentifierToken const&)> callback) override;
 
   std::shared_ptr<Index> createIndex(transaction::Methods* trx,
@@ -287,6 +302,19 @@ class MMFilesCollection final : public PhysicalCollection {
 
   int cleanupIndexes();
 
+  /// @brief remove the previous revisions of documents that no snapshot
+  /// can see anymore
+  void pruneRevisionHistory();
+
+  /// @brief release the decompressed copies of compressed documents if no
+  /// transaction holds a document ditch on the collection anymore
+  void releaseDecompressedDocuments();
+
+  /// @brief the document at vpack, which is the VelocyPack of a document
+  /// marker for the given revision. a compressed document is decompressed
+  uint8_t const* uncompressedVPack(TRI_voc_rid_t revisionId,
+                                   uint8_t const* vpack) const;
+
   ////////////////////////////////////
   // -- SECTION Locking --
   ///////////////////////////////////
@@ -308,6 +336,10 @@ class MMFilesCollection final : public PhysicalCollection {
   int read(transaction::Methods*, arangodb::velocypack::Slice const key,
            ManagedDocumentResult& result, bool) override;
 
+  int readInto(transaction::Methods*, StringRef const& key,
+               std::vector<std::string> const& projections,
+               arangodb::velocypack::Builder& result, bool) override;
+
   bool readDocument(transaction::Methods* trx,
                     DocumentIdentifierToken const& token,
                     ManagedDocumentResult& result) override;
@@ -317,6 +349,10 @@ class MMFilesCollection final : public PhysicalCollection {
                                TRI_voc_tick_t maxTick,
                                ManagedDocumentResult& result) override;
 
+  void readDocuments(transaction::Methods* trx,
+                     std::vector<DocumentIdentifierToken> const& tokens,
+                     std::vector<uint8_t const*>& result) override;
+
   int insert(arangodb::transaction::Methods* trx,
              arangodb::velocypack::Slice const newSlice,
              arangodb::ManagedDocumentResult& result,
@@ -418,6 +454,16 @@ class MMFilesCollection final : public PhysicalCollection {
     _datafileStatistics.create(fid, values);
     }
 
+    /// @brief name of the file holding the primary index snapshot
+    std::string primaryIndexSnapshotFilename() const;
+
+    /// @brief write a snapshot of the primary index and the revisions cache
+    void writePrimaryIndexSnapshot();
+
+    /// @brief fill the primary index and the revisions cache from a
+    /// snapshot. returns false if there is no usable snapshot
+    bool readPrimaryIndexSnapshot(OpenIteratorState& state);
+
     /// @brief iterates over a collection
     bool iterateDatafiles(
         std::function<bool(TRI_df_marker_t const*, MMFilesDatafile*)> const&
@@ -442,11 +488,28 @@ class MMFilesCollection final : public PhysicalCollection {
 
     MMFilesDocumentPosition lookupRevision(TRI_voc_rid_t revisionId) const;
 
+    /// @brief returns a pointer to the document's VelocyPack inside the WAL
+    /// logfile or the datafile that contains it, or to its decompressed copy
+    /// if it is stored compressed. the pointer stays valid as long as the
+    /// caller holds a document ditch
     uint8_t const* lookupRevisionVPack(TRI_voc_rid_t revisionId) const override;
     uint8_t const* lookupRevisionVPackConditional(
         TRI_voc_rid_t revisionId, TRI_voc_tick_t maxTick, bool excludeWal)
         const override;
 
+    /// @brief note that documents were read, for the detection of idle
+    /// datafiles. the flag is only written when it changes, so that readers
+    /// do not keep invalidating each other's cache lines
+    inline void markDocumentsRead() const {
+      if (!_documentsRead.load(std::memory_order_relaxed)) {
+        _documentsRead.store(true, std::memory_order_relaxed);
+      }
+    }
+
+    /// @brief number of bytes of the files that are resident in memory.
+    /// the caller must hold the files lock
+    static size_t residentSize(std::vector<MMFilesDatafile*> const& files);
+
     int insertDocument(arangodb::transaction::Methods * trx,
                        TRI_voc_rid_t revisionId,
                        arangodb::velocypack::Slice const& doc,
@@ -470,6 +533,38 @@ class MMFilesCollection final : public PhysicalCollection {
     int saveIndex(transaction::Methods* trx,
                   std::shared_ptr<arangodb::Index> idx);
 
+    /// @brief write the definition of a filled index to disk and the WAL
+    int persistIndex(std::shared_ptr<arangodb::Index> idx);
+
+    /// @brief fill, persist and add an index without holding the
+    /// collection's write lock while it is filled. the index is filled from
+    /// a snapshot of the documents, and then catches up with the operations
+    /// that happened in the meantime. if an index with the same definition
+    /// was created concurrently, it is returned in existing instead
+    int buildIndexInBackground(transaction::Methods* trx,
+                               velocypack::Slice const& info,
+                               std::shared_ptr<arangodb::Index> idx,
+                               std::shared_ptr<arangodb::Index>& existing);
+
+    /// @brief fill an index with the documents of the given revisions
+    int fillIndexFromSnapshot(transaction::Methods* trx, arangodb::Index* idx,
+                              std::vector<TRI_voc_rid_t> const& revisions);
+
+    /// @brief apply the operations captured for an index build to the index
+    int applyIndexBuildChanges(
+        transaction::Methods* trx, arangodb::Index* idx,
+        MMFilesIndexBuilds::Changes const& changes);
+
+    /// @brief the VelocyPack of the document marker of a document, which
+    /// differs from the document if it is compressed
+    uint8_t const* storedVPack(TRI_voc_rid_t revisionId,
+                               uint8_t const* doc) const;
+
+    /// @brief look up a document for an index build. this also finds
+    /// documents removed since the build started
+    uint8_t const* lookupIndexBuildVPack(transaction::Methods* trx,
+                                         TRI_voc_rid_t revisionId) const;
+
     /// @brief Detect all indexes form file
     int detectIndexes(transaction::Methods* trx);
 
@@ -491,6 +586,22 @@ class MMFilesCollection final : public PhysicalCollection {
     int lookupDocument(transaction::Methods*, velocypack::Slice const,
                        ManagedDocumentResult& result);
 
+    /// @brief look up the revision of a document visible to the snapshot
+    /// of the transaction, if it was modified after the snapshot was
+    /// taken. returns false if the current revision is visible
+    bool lookupSnapshotDocument(transaction::Methods*,
+                                velocypack::Slice const key,
+                                TRI_voc_tick_t snapshotTick,
+                                ManagedDocumentResult& result, int& res);
+
+    /// @brief record the revision of a document before it is modified, for
+    /// snapshot reads. oldDoc is a none slice for documents being inserted.
+    /// returns true if the transaction had not recorded it before. the
+    /// caller must make sure the write lock on the collection is held
+    bool recordPreviousRevision(transaction::Methods*,
+                                velocypack::Slice const key,
+                                velocypack::Slice const oldDoc);
+
     int updateDocument(transaction::Methods*, TRI_voc_rid_t oldRevisionId,
                        velocypack::Slice const& oldDoc,
                        TRI_voc_rid_t newRevisionId,
@@ -521,8 +632,27 @@ class MMFilesCollection final : public PhysicalCollection {
 
     MMFilesRevisionsCache _revisionsCache;
 
+    /// @brief copies of hot documents, only used if enabled in the engine
+    MMFilesDocumentCache _documentCache;
+
+    /// @brief decompressed copies of the documents read, only used if
+    /// documents are stored compressed
+    mutable MMFilesDecompressedDocuments _decompressedDocuments;
+
+    /// @brief previous revisions of modified documents, only used if
+    /// snapshot reads are enabled in the engine
+    MMFilesRevisionHistory _revisionHistory;
+
     std::atomic<int64_t> _uncollectedLogfileEntries;
 
+    /// @brief whether documents were read since the last check for idle
+    /// datafiles
+    mutable std::atomic<bool> _documentsRead{false};
+    /// @brief the time documents were last found to be read, and whether
+    /// the datafiles were released since then. only used by the compactor
+    double _lastDocumentsRead = 0.0;
+    bool _datafilesReleased = false;
+
     Mutex _compactionStatusLock;
     size_t _nextCompactionStartIndex;
     char const* _lastCompactionStatus;
@@ -532,6 +662,10 @@ class MMFilesCollection final : public PhysicalCollection {
 
     bool const _isVolatile;
 
+    /// @brief whether documents are stored compressed. cannot be changed
+    /// once the collection has been created
+    bool const _compressDocuments;
+
     // SECTION: Indexes
 
     size_t _cleanupIndexes;
@@ -541,6 +675,9 @@ class MMFilesCollection final : public PhysicalCollection {
     // whether or not secondary indexes should be filled
     bool _useSecondaryIndexes;
 
+    /// @brief indexes built in the background
+    MMFilesIndexBuilds _indexBuilds;
+
     bool _doCompact;
     TRI_voc_tick_t _maxTick;
 };
@@ -34,13 +34,17 @@
 #include "MMFiles/MMFilesCollection.h"
 #include "MMFiles/MMFilesCompactionLocker.h"
 #include "MMFiles/MMFilesDatafileHelper.h"
+#include "MMFiles/MMFilesDocumentCompression.h"
 #include "MMFiles/MMFilesEngine.h"
 #include "MMFiles/MMFilesIndexElement.h"
 #include "MMFiles/MMFilesLogfileManager.h"
 #include "MMFiles/MMFilesPersistentIndex.h"
 #include "MMFiles/MMFilesPrimaryIndex.h"
 #include "MMFiles/MMFilesWalLogfile.h"
+#include "Basics/LocalTaskQueue.h"
 #include "RestServer/TransactionManagerFeature.h"
+#include "Scheduler/Scheduler.h"
+#include "Scheduler/SchedulerFeature.h"
 #include "StorageEngine/EngineSelectorFeature.h"
 #include "StorageEngine/StorageEngine.h"
 #include "Transaction/Helpers.h"
@@ -53,6 +57,38 @@
 
 using namespace arangodb;
 
+namespace {
+
+/// @brief transfers the markers of some collections of a logfile
+class MMFilesCollectorTransferTask : public arangodb::basics::LocalTask {
+ public:
+  MMFilesCollectorTransferTask(arangodb::basics::LocalTaskQueue* queue,
+                               std::function<int()> const& cb)
+      : LocalTask(queue), _cb(cb) {}
+
+  void run() override {
+    try {
+      int res = _cb();
+      if (res != TRI_ERROR_NO_ERROR) {
+        _queue->setStatus(res);
+      }
+    } catch (arangodb::basics::Exception const& ex) {
+      _queue->setStatus(ex.code());
+    } catch (std::bad_alloc const&) {
+      _queue->setStatus(TRI_ERROR_OUT_OF_MEMORY);
+    } catch (...) {
+      _queue->setStatus(TRI_ERROR_INTERNAL);
+    }
+
+    _queue->join();
+  }
+
+ private:
+  std::function<int()> _cb;
+};
+
+}  // namespace
+
 /// @brief state that is built up when scanning a WAL logfile
 struct CollectorState {
   std::unordered_map<TRI_voc_cid_t, TRI_voc_tick_t> collections;
@@ -147,7 +183,8 @@ static bool ScanMarker(TRI_df_marker_t const* marker, void* data,
         break;
       }
 
-      VPackSlice slice(reinterpret_cast<char const*>(marker) + MMFilesDatafileHelper::VPackOffset(type));
+      VPackBuffer<uint8_t> buffer;
+      VPackSlice slice = MMFilesDocumentCompression::document(reinterpret_cast<uint8_t const*>(marker) + MMFilesDatafileHelper::VPackOffset(type), buffer);
       state->documentOperations[collectionId][transaction::helpers::extractKeyFromDocument(slice).copyString()] = marker;
       state->operationsCount[collectionId]++;
       break;
@@ -576,7 +613,8 @@ void MMFilesCollectorThread::processCollectionMarker(
     auto& dfi = cache->createDfi(fid);
     dfi.numberUncollected--;
 
-    VPackSlice slice(reinterpret_cast<char const*>(walMarker) + MMFilesDatafileHelper::VPackOffset(type));
+    VPackBuffer<uint8_t> buffer;
+    VPackSlice slice = MMFilesDocumentCompression::document(reinterpret_cast<uint8_t const*>(walMarker) + MMFilesDatafileHelper::VPackOffset(type), buffer);
     TRI_ASSERT(slice.isObject());
     
     VPackSlice keySlice;
@@ -768,15 +806,17 @@ int MMFilesCollectorThread::collect(MMFilesWalLogfile* logfile) {
     }
   }
     
-  MMFilesOperationsType sortedOperations;
+  // sort the surviving markers of each collection by tick
+  std::vector<std::pair<TRI_voc_cid_t, MMFilesOperationsType>> transfers;
+  transfers.reserve(collectionIds.size());
 
-  // now for each collection, write all surviving markers into collection
-  // datafiles
   for (auto it = collectionIds.begin(); it != collectionIds.end(); ++it) {
     auto cid = (*it);
 
+    transfers.emplace_back(cid, MMFilesOperationsType());
+    MMFilesOperationsType& sortedOperations = transfers.back().second;
+
     // calculate required size for sortedOperations vector
-    sortedOperations.clear();
     {
       size_t requiredSize = 0;
 
@@ -815,44 +855,70 @@ int MMFilesCollectorThread::collect(MMFilesWalLogfile* logfile) {
                 });
     }
 
-    if (!sortedOperations.empty()) {
-      int res = TRI_ERROR_INTERNAL;
-
-      try {
-        res = transferMarkers(logfile, cid, state.collections[cid],
-                              state.operationsCount[cid], sortedOperations);
-
-        TRI_IF_FAILURE("failDuringCollect") {
-          THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
-        }
-
-      } catch (arangodb::basics::Exception const& ex) {
-        res = ex.code();
-        LOG_TOPIC(TRACE, Logger::COLLECTOR) << "caught exception in collect: " << ex.what();
-      } catch (std::exception const& ex) {
-        res = TRI_ERROR_INTERNAL;
-        LOG_TOPIC(TRACE, Logger::COLLECTOR) << "caught exception in collect: " << ex.what();
-      } catch (...) {
-        res = TRI_ERROR_INTERNAL;
-        LOG_TOPIC(TRACE, Logger::COLLECTOR) << "caught unknown exception in collect";
-      }
+    if (sortedOperations.empty()) {
+      transfers.pop_back();
+    }
+  }
 
-      if (res != TRI_ERROR_NO_ERROR &&
-          res != TRI_ERROR_ARANGO_DATABASE_NOT_FOUND &&
-          res != TRI_ERROR_ARANGO_COLLECTION_NOT_FOUND) {
-        if (res != TRI_ERROR_ARANGO_FILESYSTEM_FULL) {
-          // other places already log this error, and making the logging
-          // conditional here
-          // prevents the log message from being shown over and over again in
-          // case the
-          // file system is full
-          LOG_TOPIC(WARN, Logger::COLLECTOR) << "got unexpected error in MMFilesCollectorThread::collect: "
-                    << TRI_errno_string(res);
-        }
+  // now for each collection, write all surviving markers into collection
+  // datafiles. the datafiles of different collections are independent,
+  // so multiple collections can be handled in parallel
+  size_t const parallelism =
+      (std::min)(static_cast<size_t>(_logfileManager->collectorThreads()),
+                 transfers.size());
+
+  if (parallelism <= 1 || SchedulerFeature::SCHEDULER == nullptr) {
+    for (auto const& it : transfers) {
+      TRI_voc_cid_t cid = it.first;
+      int res = transferCollectionMarkers(logfile, cid, state.collections[cid],
+                                          state.operationsCount[cid],
+                                          it.second);
+
+      if (res != TRI_ERROR_NO_ERROR) {
         // abort early
         return res;
       }
     }
+  } else {
+    // look up the per-collection values upfront, so the workers do not
+    // access the state's maps concurrently
+    std::vector<std::pair<TRI_voc_tick_t, int64_t>> transferInfo;
+    transferInfo.reserve(transfers.size());
+    for (auto const& it : transfers) {
+      transferInfo.emplace_back(state.collections[it.first],
+                                state.operationsCount[it.first]);
+    }
+
+    // the collector keeps running while the server shuts down, when the
+    // scheduler may be gone already. the queue then runs the transfers on
+    // this thread
+    auto scheduler = SchedulerFeature::SCHEDULER;
+    arangodb::basics::LocalTaskQueue queue(
+        scheduler == nullptr ? nullptr : scheduler->ioService());
+
+    for (size_t i = 0; i < parallelism; ++i) {
+      queue.enqueue(std::make_shared<MMFilesCollectorTransferTask>(
+          &queue, [&, i]() -> int {
+            // each worker handles every n-th collection, and stops at the
+            // first error
+            for (size_t j = i; j < transfers.size(); j += parallelism) {
+              int res = transferCollectionMarkers(
+                  logfile, transfers[j].first, transferInfo[j].first,
+                  transferInfo[j].second, transfers[j].second);
+
+              if (res != TRI_ERROR_NO_ERROR) {
+                return res;
+              }
+            }
+            return TRI_ERROR_NO_ERROR;
+          }));
+    }
+
+    queue.dispatchAndWait();
+
+    if (queue.status() != TRI_ERROR_NO_ERROR) {
+      return queue.status();
+    }
   }
 
   // Error conditions TRI_ERROR_ARANGO_DATABASE_NOT_FOUND and
@@ -868,6 +934,51 @@ int MMFilesCollectorThread::collect(MMFilesWalLogfile* logfile) {
   return TRI_ERROR_NO_ERROR;
 }
 
+/// @brief transfer markers into a collection, handling all errors.
+/// returns an error only if collecting the logfile must be aborted
+int MMFilesCollectorThread::transferCollectionMarkers(
+    MMFilesWalLogfile* logfile, TRI_voc_cid_t collectionId,
+    TRI_voc_tick_t databaseId, int64_t totalOperationsCount,
+    MMFilesOperationsType const& operations) {
+  int res = TRI_ERROR_INTERNAL;
+
+  try {
+    res = transferMarkers(logfile, collectionId, databaseId,
+                          totalOperationsCount, operations);
+
+    TRI_IF_FAILURE("failDuringCollect") {
+      THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
+    }
+
+  } catch (arangodb::basics::Exception const& ex) {
+    res = ex.code();
+    LOG_TOPIC(TRACE, Logger::COLLECTOR) << "caught exception in collect: " << ex.what();
+  } catch (std::exception const& ex) {
+    res = TRI_ERROR_INTERNAL;
+    LOG_TOPIC(TRACE, Logger::COLLECTOR) << "caught exception in collect: " << ex.what();
+  } catch (...) {
+    res = TRI_ERROR_INTERNAL;
+    LOG_TOPIC(TRACE, Logger::COLLECTOR) << "caught unknown exception in collect";
+  }
+
+  if (res != TRI_ERROR_NO_ERROR &&
+      res != TRI_ERROR_ARANGO_DATABASE_NOT_FOUND &&
+      res != TRI_ERROR_ARANGO_COLLECTION_NOT_FOUND) {
+    if (res != TRI_ERROR_ARANGO_FILESYSTEM_FULL) {
+      // other places already log this error, and making the logging
+      // conditional here
+      // prevents the log message from being shown over and over again in
+      // case the
+      // file system is full
+      LOG_TOPIC(WARN, Logger::COLLECTOR) << "got unexpected error in MMFilesCollectorThread::collect: "
+                << TRI_errno_string(res);
+    }
+    return res;
+  }
+
+  return TRI_ERROR_NO_ERROR;
+}
+
 /// @brief transfer markers into a collection
 int MMFilesCollectorThread::transferMarkers(MMFilesWalLogfile* logfile,
                                      TRI_voc_cid_t collectionId,
@@ -958,21 +1069,21 @@ int MMFilesCollectorThread::queueOperations(arangodb::MMFilesWalLogfile* logfile
     usleep(10000);
   }
 
+  uint64_t numPendingOperations = _numPendingOperations.fetch_add(numOperations);
+
   if (maxNumPendingOperations > 0 &&
-      _numPendingOperations < maxNumPendingOperations &&
-      (_numPendingOperations + numOperations) >= maxNumPendingOperations &&
+      numPendingOperations < maxNumPendingOperations &&
+      (numPendingOperations + numOperations) >= maxNumPendingOperations &&
       !isStopping()) {
     // activate write-throttling!
     _logfileManager->activateWriteThrottling();
     LOG_TOPIC(WARN, Logger::COLLECTOR)
         << "queued more than " << maxNumPendingOperations
         << " pending WAL collector operations." 
-        << " current queue size: " << (_numPendingOperations + numOperations) 
+        << " current queue size: " << (numPendingOperations + numOperations) 
         << ". now activating write-throttling";
   }
 
-  _numPendingOperations += numOperations;
-
   return TRI_ERROR_NO_ERROR;
 }
 
@@ -64,6 +64,9 @@ class MMFilesCollectorThread final : public Thread {
   /// collection
   bool hasQueuedOperations(TRI_voc_cid_t);
 
+  /// @brief return the number of queued operations
+  size_t numQueuedOperations();
+
   // execute a callback during a phase in which the collector has nothing
   // queued. This is used in the DatabaseManagerThread when dropping
   // a database to avoid existence of ditches of type DOCUMENT.
@@ -79,9 +82,6 @@ class MMFilesCollectorThread final : public Thread {
       arangodb::SingleCollectionTransaction&,
       arangodb::LogicalCollection*, MMFilesCollectorCache*, MMFilesCollectorOperation const&);
 
-  /// @brief return the number of queued operations
-  size_t numQueuedOperations();
-
   /// @brief step 1: perform collection of a logfile (if any)
   int collectLogfiles(bool&);
 
@@ -98,6 +98,12 @@ class MMFilesCollectorThread final : public Thread {
   int transferMarkers(MMFilesWalLogfile*, TRI_voc_cid_t, TRI_voc_tick_t,
                       int64_t, MMFilesOperationsType const&);
 
+  /// @brief transfer markers into a collection, handling all errors.
+  /// returns an error only if collecting the logfile must be aborted
+  int transferCollectionMarkers(MMFilesWalLogfile*, TRI_voc_cid_t,
+                                TRI_voc_tick_t, int64_t,
+                                MMFilesOperationsType const&);
+
   /// @brief insert the collect operations into a per-collection queue
   int queueOperations(MMFilesWalLogfile*, std::unique_ptr<MMFilesCollectorCache>&);
 
@@ -123,8 +129,9 @@ class MMFilesCollectorThread final : public Thread {
   /// @brief whether or not the queue is currently in use
   bool _operationsQueueInUse;
 
-  /// @brief number of pending operations in collector queue
-  uint64_t _numPendingOperations;
+  /// @brief number of pending operations in collector queue. collections
+  /// may be transferred in parallel, so this is atomic
+  std::atomic<uint64_t> _numPendingOperations;
 
   /// @brief condition variable for the collector thread result
   basics::ConditionVariable _collectorResultCondition;
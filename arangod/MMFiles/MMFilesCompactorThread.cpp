@@ -33,6 +33,7 @@
 #include "MMFiles/MMFilesCollection.h"
 #include "MMFiles/MMFilesCompactionLocker.h"
 #include "MMFiles/MMFilesDatafileHelper.h"
+#include "MMFiles/MMFilesDocumentCompression.h"
 #include "MMFiles/MMFilesDocumentPosition.h"
 #include "MMFiles/MMFilesIndexElement.h"
 #include "MMFiles/MMFilesPrimaryIndex.h"
@@ -279,7 +280,8 @@ MMFilesCompactorThread::CompactionInitialContext MMFilesCompactorThread::getComp
 
       // new or updated document
       if (type == TRI_DF_MARKER_VPACK_DOCUMENT) {
-        VPackSlice const slice(reinterpret_cast<char const*>(marker) + MMFilesDatafileHelper::VPackOffset(type));
+        VPackBuffer<uint8_t> buffer;
+        VPackSlice const slice = MMFilesDocumentCompression::document(reinterpret_cast<uint8_t const*>(marker) + MMFilesDatafileHelper::VPackOffset(type), buffer);
         TRI_ASSERT(slice.isObject());
 
         VPackSlice keySlice = transaction::helpers::extractKeyFromDocument(slice);
@@ -351,7 +353,7 @@ MMFilesCompactorThread::CompactionInitialContext MMFilesCompactorThread::getComp
 }
 
 /// @brief compact the specified datafiles
-void MMFilesCompactorThread::compactDatafiles(LogicalCollection* collection,
+uint64_t MMFilesCompactorThread::compactDatafiles(LogicalCollection* collection,
     std::vector<compaction_info_t> const& toCompact) {
   TRI_ASSERT(collection != nullptr);
   auto physical = static_cast<MMFilesCollection*>(collection->getPhysical());
@@ -374,7 +376,8 @@ void MMFilesCompactorThread::compactDatafiles(LogicalCollection* collection,
 
     // new or updated document
     if (type == TRI_DF_MARKER_VPACK_DOCUMENT) {
-      VPackSlice const slice(reinterpret_cast<char const*>(marker) + MMFilesDatafileHelper::VPackOffset(type));
+      VPackBuffer<uint8_t> buffer;
+      VPackSlice const slice = MMFilesDocumentCompression::document(reinterpret_cast<uint8_t const*>(marker) + MMFilesDatafileHelper::VPackOffset(type), buffer);
       TRI_ASSERT(slice.isObject());
 
       VPackSlice keySlice = transaction::helpers::extractKeyFromDocument(slice);
@@ -450,7 +453,7 @@ void MMFilesCompactorThread::compactDatafiles(LogicalCollection* collection,
   if (initial._failed) {
     LOG_TOPIC(ERR, Logger::COMPACTOR) << "could not create initialize compaction";
 
-    return;
+    return 0;
   }
 
   LOG_TOPIC(DEBUG, Logger::COMPACTOR) << "compactify called for collection '" << collection->cid() << "' for " << n << " datafiles of total size " << initial._targetSize;
@@ -462,10 +465,10 @@ void MMFilesCompactorThread::compactDatafiles(LogicalCollection* collection,
     compactor = physical->createCompactor(initial._fid, static_cast<TRI_voc_size_t>(initial._targetSize));
   } catch (std::exception const& ex) {
     LOG_TOPIC(ERR, Logger::COMPACTOR) << "could not create compactor file: " << ex.what();
-    return;
+    return 0;
   } catch (...) {
     LOG_TOPIC(ERR, Logger::COMPACTOR) << "could not create compactor file: unknown exception";
-    return;
+    return 0;
   }
 
   TRI_ASSERT(compactor != nullptr);
@@ -481,9 +484,12 @@ void MMFilesCompactorThread::compactDatafiles(LogicalCollection* collection,
 
   if (res != TRI_ERROR_NO_ERROR) {
     LOG_TOPIC(ERR, Logger::COMPACTOR) << "error during compaction: " << TRI_errno_string(res);
-    return;
+    return 0;
   }
 
+  // from now on, data is written into the compactor file
+  uint64_t const written = static_cast<uint64_t>(initial._targetSize);
+
   // now compact all datafiles
   for (size_t i = 0; i < n; ++i) {
     auto compaction = toCompact[i];
@@ -496,6 +502,12 @@ void MMFilesCompactorThread::compactDatafiles(LogicalCollection* collection,
     // deletion markers
     context->_keepDeletions = compaction._keepDeletions;
 
+    // the datafile is read from start to end once. it is accessed
+    // randomly again afterwards if compaction fails
+    df->sequentialAccess();
+    df->willNeed();
+    TRI_DEFER(df->randomAccess());
+
     // run the actual compaction of a single datafile
     bool ok = TRI_IterateDatafile(df, compactifier);
 
@@ -504,7 +516,7 @@ void MMFilesCompactorThread::compactDatafiles(LogicalCollection* collection,
       // compactor file does not need to be removed now. will be removed on next
       // startup
       // TODO: Remove file
-      return;
+      return written;
     }
 
   }  // next file
@@ -522,7 +534,7 @@ void MMFilesCompactorThread::compactDatafiles(LogicalCollection* collection,
   if (physical->closeCompactor(compactor) != TRI_ERROR_NO_ERROR) {
     LOG_TOPIC(ERR, Logger::COMPACTOR) << "could not close compactor file";
     // TODO: how do we recover from this state?
-    return;
+    return written;
   }
 
   if (context->_dfi.numberAlive == 0 && context->_dfi.numberDead == 0 &&
@@ -616,16 +628,20 @@ void MMFilesCompactorThread::compactDatafiles(LogicalCollection* collection,
       }
     }
   }
+
+  return written;
 }
 
 /// @brief checks all datafiles of a collection
-bool MMFilesCompactorThread::compactCollection(LogicalCollection* collection, bool& wasBlocked) {
+bool MMFilesCompactorThread::compactCollection(LogicalCollection* collection, bool& wasBlocked,
+                                               uint64_t& bytesWritten) {
   // we can hopefully get away without the lock here...
   //  if (! document->isFullyCollected()) {
   //    return false;
   //  }
 
   wasBlocked = false;
+  bytesWritten = 0;
 
   // if we cannot acquire the read lock instantly, we will exit directly.
   // otherwise we'll risk a multi-thread deadlock between synchronizer,
@@ -669,6 +685,18 @@ bool MMFilesCompactorThread::compactCollection(LogicalCollection* collection, bo
 
   size_t start = physical->getNextCompactionStartIndex();
 
+  // start at the datafile with the highest share of dead data, so that
+  // compaction work is spent where it reclaims the most space. if no
+  // datafile has enough dead data, go on round-robin
+  {
+    std::vector<DatafileStatisticsContainer> statistics;
+    statistics.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+      statistics.emplace_back(physical->_datafileStatistics.get(datafiles[i]->fid()));
+    }
+    start = compactionStartIndex(statistics, start, deadSizeThreshold());
+  }
+
   // get number of documents from collection
   uint64_t const numDocuments = getNumberOfDocuments(collection);
 
@@ -839,11 +867,93 @@ bool MMFilesCompactorThread::compactCollection(LogicalCollection* collection, bo
   TRI_ASSERT(reason != nullptr);
   physical->setCompactionStatus(reason);
   physical->setNextCompactionStartIndex(start);
-  compactDatafiles(collection, toCompact);
+  bytesWritten = compactDatafiles(collection, toCompact);
 
   return true;
 }
 
+/// @brief the settings used by all compactor threads
+MMFilesCompactorThread::Settings& MMFilesCompactorThread::settings() {
+  static Settings settings;
+  return settings;
+}
+
+/// @brief sort the collections so that the ones with the most dead data
+/// come first. this way the collections that benefit most from compaction
+/// are compacted first, regardless of their order in the database
+void MMFilesCompactorThread::sortByBenefit(std::vector<arangodb::LogicalCollection*>& collections) {
+  std::vector<std::pair<int64_t, arangodb::LogicalCollection*>> ordered;
+  ordered.reserve(collections.size());
+
+  for (auto& collection : collections) {
+    auto physical = static_cast<MMFilesCollection*>(collection->getPhysical());
+    TRI_ASSERT(physical != nullptr);
+    ordered.emplace_back(physical->_datafileStatistics.all().sizeDead, collection);
+  }
+
+  std::stable_sort(ordered.begin(), ordered.end(),
+                   [](std::pair<int64_t, arangodb::LogicalCollection*> const& lhs,
+                      std::pair<int64_t, arangodb::LogicalCollection*> const& rhs) {
+                     return lhs.first > rhs.first;
+                   });
+
+  for (size_t i = 0; i < ordered.size(); ++i) {
+    collections[i] = ordered[i].second;
+  }
+}
+
+/// @brief the index of the datafile to start compacting at
+size_t MMFilesCompactorThread::compactionStartIndex(
+    std::vector<DatafileStatisticsContainer> const& statistics, size_t start,
+    int64_t deadSizeThreshold) {
+  double bestShare = 0.0;
+
+  for (size_t i = 0; i < statistics.size(); ++i) {
+    DatafileStatisticsContainer const& dfi = statistics[i];
+
+    if (dfi.numberUncollected > 0 || dfi.sizeDead < deadSizeThreshold) {
+      continue;
+    }
+
+    double share = static_cast<double>(dfi.sizeDead) /
+                   (static_cast<double>(dfi.sizeDead) + static_cast<double>(dfi.sizeAlive));
+    if (share > bestShare) {
+      bestShare = share;
+      start = i;
+    }
+  }
+
+  return start;
+}
+
+/// @brief the time to wait so that maxWriteRate is not exceeded on average
+double MMFilesCompactorThread::throttleWait(uint64_t bytesWritten, double duration,
+                                            uint64_t maxWriteRate) {
+  if (maxWriteRate == 0 || bytesWritten == 0) {
+    return 0.0;
+  }
+
+  double const wait = static_cast<double>(bytesWritten) / static_cast<double>(maxWriteRate) - duration;
+  return wait > 0.0 ? wait : 0.0;
+}
+
+/// @brief wait until the average compaction write rate is below the
+/// configured maximum again. waiting happens between compactions, when
+/// no locks are held, so that readers and writers of the collection are
+/// not blocked for longer
+void MMFilesCompactorThread::throttle(uint64_t bytesWritten, double duration) {
+  double const wait = throttleWait(bytesWritten, duration, settings().maxWriteRate);
+
+  if (wait <= 0.0 || isStopping()) {
+    return;
+  }
+
+  LOG_TOPIC(TRACE, Logger::COMPACTOR) << "throttling compaction for " << wait << " s after writing " << bytesWritten << " bytes";
+
+  CONDITION_LOCKER(locker, _condition);
+  locker.wait(static_cast<uint64_t>(wait * 1000.0 * 1000.0));
+}
+
 MMFilesCompactorThread::MMFilesCompactorThread(TRI_vocbase_t* vocbase) 
     : Thread("Compactor"), _vocbase(vocbase) {}
 
@@ -858,6 +968,7 @@ void MMFilesCompactorThread::run() {
   StorageEngine* engine = EngineSelectorFeature::ENGINE;
   std::vector<arangodb::LogicalCollection*> collections;
   int numCompacted = 0;
+  uint64_t bytesWritten = 0;
 
   while (true) {
     // keep initial _state value as vocbase->_state might change during
@@ -865,12 +976,16 @@ void MMFilesCompactorThread::run() {
     TRI_vocbase_t::State state = _vocbase->state();
 
     try {
-      engine->tryPreventCompaction(_vocbase, [this, &numCompacted, &collections](TRI_vocbase_t* vocbase) {
+      double const started = TRI_microtime();
+
+      engine->tryPreventCompaction(_vocbase, [this, &numCompacted, &bytesWritten, &collections](TRI_vocbase_t* vocbase) {
         // compaction is currently allowed
         numCompacted = 0;
+        bytesWritten = 0;
         try {
           // copy all collections
           collections = _vocbase->collections(false);
+          sortByBenefit(collections);
         } catch (...) {
           collections.clear();
         }
@@ -878,13 +993,21 @@ void MMFilesCompactorThread::run() {
         for (auto& collection : collections) {
           bool worked = false;
 
-          auto callback = [this, &collection, &worked]() -> void {
+          auto callback = [this, &collection, &worked, &bytesWritten]() -> void {
             if (collection->status() != TRI_VOC_COL_STATUS_LOADED &&
                 collection->status() != TRI_VOC_COL_STATUS_UNLOADING) {
               return;
             }
 
             bool doCompact = collection->getPhysical()->doCompact();
+            
+            double const idleTimeout = settings().idleDatafilesTimeout;
+
+            if (idleTimeout > 0.0 && collection->status() == TRI_VOC_COL_STATUS_LOADED) {
+              auto physical = static_cast<MMFilesCollection*>(collection->getPhysical());
+              TRI_ASSERT(physical != nullptr);
+              physical->releaseIdleDatafiles(TRI_microtime(), idleTimeout);
+            }
 
             // for document collection, compactify datafiles
             if (collection->status() == TRI_VOC_COL_STATUS_LOADED && doCompact) {
@@ -915,7 +1038,9 @@ void MMFilesCompactorThread::run() {
                   } else {
                     try {
                       bool wasBlocked = false;
-                      worked = compactCollection(collection, wasBlocked);
+                      uint64_t written = 0;
+                      worked = compactCollection(collection, wasBlocked, written);
+                      bytesWritten += written;
 
                       if (!worked && !wasBlocked) {
                         // set compaction stamp
@@ -951,6 +1076,12 @@ void MMFilesCompactorThread::run() {
             // up
             CONDITION_LOCKER(locker, _condition);
             locker.signal();
+
+            if (settings().maxWriteRate > 0) {
+              // compact incrementally: leave the loop so that the IO budget
+              // can be checked before the next compaction
+              break;
+            }
           }
         }
       }, true);
@@ -959,6 +1090,7 @@ void MMFilesCompactorThread::run() {
         // no need to sleep long or go into wait state if we worked.
         // maybe there's still work left
         usleep(1000);
+        throttle(bytesWritten, TRI_microtime() - started);
       } else if (state != TRI_vocbase_t::State::SHUTDOWN_COMPACTOR && _vocbase->state() == TRI_vocbase_t::State::NORMAL) {
         // only sleep while server is still running
         CONDITION_LOCKER(locker, _condition);
@@ -35,6 +35,7 @@ struct TRI_vocbase_t;
 
 namespace arangodb {
 struct CompactionContext;
+struct DatafileStatisticsContainer;
 class LogicalCollection;
 namespace transaction {
 class Methods;
@@ -62,6 +63,55 @@ class MMFilesCompactorThread final : public Thread {
         : _trx(trx), _collection(collection), _targetSize(0), _fid(0), _keepDeletions(false), _failed(false) {}
   };
 
+ public:
+  /// @brief compaction settings, configurable via the --compaction.* options
+  struct Settings {
+    /// @brief wait time (in seconds) between compaction runs when idle
+    double sleepTime = 1.0;
+    /// @brief minimum time (in seconds) between two compactions of the
+    /// same collection
+    double collectionInterval = 10.0;
+    /// @brief maximum number of files to compact and concat
+    uint64_t maxFiles = 3;
+    /// @brief maximum filesize of resulting compacted file
+    uint64_t maxResultFilesize = 128 * 1024 * 1024;
+    /// @brief minimum number of dead documents in a datafile from which on
+    /// we will compact it if nothing else qualifies the file for compaction
+    uint64_t deadNumberThreshold = 16384;
+    /// @brief minimum size of dead data (in bytes) in a datafile that will
+    /// make the datafile eligible for compaction
+    uint64_t deadSizeThreshold = 128 * 1024;
+    /// @brief share of dead data in a datafile that will trigger compaction
+    double deadShare = 0.1;
+    /// @brief maximum average number of bytes per second written into
+    /// compactor files. 0 means unlimited
+    uint64_t maxWriteRate = 0;
+    /// @brief time (in seconds) without document reads after which the
+    /// memory of a collection's datafiles is released. 0 means never
+    double idleDatafilesTimeout = 0.0;
+    /// @brief whether the pages of sealed compactor files are evicted from
+    /// the page cache, so that compaction does not displace the data that
+    /// is actually read
+    bool dropPageCache = false;
+  };
+
+  /// @brief the settings used by all compactor threads
+  static Settings& settings();
+
+  /// @brief the index of the datafile to start compacting at: the one
+  /// with the highest share of dead data, among the datafiles with at
+  /// least deadSizeThreshold bytes of dead data and nothing uncollected.
+  /// returns start if no datafile qualifies
+  static size_t compactionStartIndex(
+      std::vector<DatafileStatisticsContainer> const& statistics, size_t start,
+      int64_t deadSizeThreshold);
+
+  /// @brief the time (in seconds) to wait after writing bytesWritten bytes
+  /// in duration seconds, so that maxWriteRate is not exceeded on average.
+  /// 0 if the rate is unlimited
+  static double throttleWait(uint64_t bytesWritten, double duration,
+                             uint64_t maxWriteRate);
+
  public:
   explicit MMFilesCompactorThread(TRI_vocbase_t* vocbase);
   ~MMFilesCompactorThread();
@@ -82,11 +132,21 @@ class MMFilesCompactorThread final : public Thread {
     transaction::Methods* trx, LogicalCollection* collection,
     std::vector<compaction_info_t> const& toCompact);
 
-  /// @brief compact the specified datafiles
-  void compactDatafiles(LogicalCollection* collection, std::vector<compaction_info_t> const&);
+  /// @brief compact the specified datafiles. returns the number of bytes
+  /// reserved for the compactor file
+  uint64_t compactDatafiles(LogicalCollection* collection, std::vector<compaction_info_t> const&);
 
   /// @brief checks all datafiles of a collection
-  bool compactCollection(LogicalCollection* collection, bool& wasBlocked);
+  bool compactCollection(LogicalCollection* collection, bool& wasBlocked,
+                         uint64_t& bytesWritten);
+
+  /// @brief sort the collections so that the ones with the most dead
+  /// data come first
+  static void sortByBenefit(std::vector<arangodb::LogicalCollection*>&);
+
+  /// @brief wait until the average compaction write rate is below the
+  /// configured maximum again
+  void throttle(uint64_t bytesWritten, double duration);
 
   int removeCompactor(LogicalCollection* collection, MMFilesDatafile* datafile);
 
@@ -101,13 +161,17 @@ class MMFilesCompactorThread final : public Thread {
                  TRI_df_marker_t** result);
 
   /// @brief wait time between compaction runs when idle
-  static constexpr unsigned compactionSleepTime() { return 1000 * 1000; }
+  static unsigned compactionSleepTime() {
+    return static_cast<unsigned>(settings().sleepTime * 1000.0 * 1000.0);
+  }
 
   /// @brief compaction interval in seconds
-  static constexpr double compactionCollectionInterval() { return 10.0; }
+  static double compactionCollectionInterval() {
+    return settings().collectionInterval;
+  }
   
   /// @brief maximum number of files to compact and concat
-  static constexpr unsigned maxFiles() { return 3; }
+  static size_t maxFiles() { return static_cast<size_t>(settings().maxFiles); }
 
   /// @brief maximum multiple of journal filesize of a compacted file
   /// a value of 3 means that the maximum filesize of the compacted file is
@@ -117,24 +181,28 @@ class MMFilesCompactorThread final : public Thread {
   static constexpr unsigned smallDatafileSize() { return 128 * 1024; }
   
   /// @brief maximum filesize of resulting compacted file
-  static constexpr uint64_t maxResultFilesize() { return 128 * 1024 * 1024; }
+  static uint64_t maxResultFilesize() { return settings().maxResultFilesize; }
 
   /// @brief minimum number of deletion marker in file from which on we will
   /// compact it if nothing else qualifies file for compaction
-  static constexpr int64_t deadNumberThreshold() { return 16384; }
+  static int64_t deadNumberThreshold() {
+    return static_cast<int64_t>(settings().deadNumberThreshold);
+  }
 
   /// @brief minimum size of dead data (in bytes) in a datafile that will make
   /// the datafile eligible for compaction at all.
   /// Any datafile with less dead data than the threshold will not become a
   /// candidate for compaction.
-  static constexpr int64_t deadSizeThreshold() { return 128 * 1024; }
+  static int64_t deadSizeThreshold() {
+    return static_cast<int64_t>(settings().deadSizeThreshold);
+  }
 
   /// @brief percentage of dead documents in a datafile that will trigger the
   /// compaction
   /// for example, if the collection contains 800 bytes of alive and 400 bytes of
   /// dead documents, the share of the dead documents is 400 / (400 + 800) = 33 %.
   /// if this value if higher than the threshold, the datafile will be compacted
-  static constexpr double deadShare() { return 0.1; }
+  static double deadShare() { return settings().deadShare; }
 
  private:
   TRI_vocbase_t* _vocbase;
@@ -33,6 +33,7 @@
 #include "Basics/tri-strings.h"
 #include "Logger/Logger.h"
 #include "MMFiles/MMFilesDatafileHelper.h"
+#include "MMFiles/MMFilesDocumentCompression.h"
 #include "VocBase/ticks.h"
 
 #include <sstream>
@@ -224,15 +225,25 @@ static MMFilesDatafile* CreateAnonymousDatafile(TRI_voc_fid_t fid,
 #endif
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief creates a new physical datafile
+/// @brief creates a new physical datafile. if recycleFrom is not empty,
+/// the file with this name is reused if possible
 ////////////////////////////////////////////////////////////////////////////////
 
 static MMFilesDatafile* CreatePhysicalDatafile(std::string const& filename,
                                               TRI_voc_fid_t fid,
-                                              TRI_voc_size_t maximalSize) {
+                                              TRI_voc_size_t maximalSize,
+                                              std::string const& recycleFrom) {
   TRI_ASSERT(!filename.empty());
 
-  int fd = TRI_CreateDatafile(filename, maximalSize);
+  int fd = -1;
+
+  if (!recycleFrom.empty()) {
+    fd = TRI_RecycleDatafile(recycleFrom, filename, maximalSize);
+  }
+
+  if (fd < 0) {
+    fd = TRI_CreateDatafile(filename, maximalSize);
+  }
 
   if (fd < 0) {
     // an error occurred
@@ -317,7 +328,8 @@ int MMFilesDatafile::judge(std::string const& filename) {
 /// @brief creates either an anonymous or a physical datafile
 MMFilesDatafile* MMFilesDatafile::create(std::string const& filename, TRI_voc_fid_t fid,
                                    TRI_voc_size_t maximalSize,
-                                   bool withInitialMarkers) {
+                                   bool withInitialMarkers,
+                                   std::string const& recycleFrom) {
   size_t pageSize = PageSizeFeature::getPageSize();
 
   TRI_ASSERT(pageSize >= 256);
@@ -342,7 +354,7 @@ MMFilesDatafile* MMFilesDatafile::create(std::string const& filename, TRI_voc_fi
     datafile.reset(CreateAnonymousDatafile(fid, maximalSize));
 #endif
   } else {
-    datafile.reset(CreatePhysicalDatafile(filename, fid, maximalSize));
+    datafile.reset(CreatePhysicalDatafile(filename, fid, maximalSize, recycleFrom));
   }
 
   if (datafile == nullptr) {
@@ -527,6 +539,26 @@ void MMFilesDatafile::dontNeed() {
   TRI_MMFileAdvise(_data, _initSize, TRI_MADVISE_DONTNEED);
 }
 
+void MMFilesDatafile::dropPageCache() {
+  dontNeed();
+
+#if defined(__linux__) && defined(POSIX_FADV_DONTNEED)
+  if (isPhysical()) {
+    int res = posix_fadvise(_fd, 0, static_cast<off_t>(_initSize), POSIX_FADV_DONTNEED);
+
+    if (res != 0) {
+      LOG_TOPIC(DEBUG, arangodb::Logger::FIXME) << "posix_fadvise for datafile '" << getName() << "' failed: " << res;
+    }
+  }
+#endif
+}
+
+size_t MMFilesDatafile::residentSize() const {
+  size_t resident = 0;
+  TRI_MMFileResidentSize(_data, _initSize, &resident);
+  return resident;
+}
+
 bool MMFilesDatafile::readOnly() {
   return (TRI_ProtectMMFile(_data, _initSize, PROT_READ, _fd) == TRI_ERROR_NO_ERROR);
 }
@@ -1589,9 +1621,14 @@ DatafileScan MMFilesDatafile::scanHelper() {
 
     if (type == TRI_DF_MARKER_VPACK_DOCUMENT ||
         type == TRI_DF_MARKER_VPACK_REMOVE) {
-      VPackSlice const slice(reinterpret_cast<char const*>(marker) + MMFilesDatafileHelper::VPackOffset(type));
-      TRI_ASSERT(slice.isObject());
-      entry.key = slice.get(StaticStrings::KeyString).copyString();
+      VPackBuffer<uint8_t> buffer;
+      try {
+        VPackSlice const slice = MMFilesDocumentCompression::document(reinterpret_cast<uint8_t const*>(marker) + MMFilesDatafileHelper::VPackOffset(type), buffer);
+        TRI_ASSERT(slice.isObject());
+        entry.key = slice.get(StaticStrings::KeyString).copyString();
+      } catch (...) {
+        // a corrupted compressed document has no key to report
+      }
     }
 
     scan.entries.emplace_back(entry);
@@ -25,6 +25,7 @@
 #define ARANGOD_STORAGE_ENGINE_MMFILES_DATAFILE_H 1
 
 #include "Basics/Common.h"
+#include "Basics/StaticStrings.h"
 #include "VocBase/vocbase.h"
 
 struct TRI_df_marker_t;
@@ -203,7 +204,8 @@ struct MMFilesDatafile {
   /// @brief creates either an anonymous or a physical datafile
   static MMFilesDatafile* create(std::string const& filename, TRI_voc_fid_t fid,
                                 TRI_voc_size_t maximalSize,
-                                bool withInitialMarkers);
+                                bool withInitialMarkers,
+                                std::string const& recycleFrom = arangodb::StaticStrings::Empty);
 
   /// @brief close a datafile
   int close();
@@ -238,6 +240,13 @@ struct MMFilesDatafile {
   void randomAccess();
   void willNeed();
   void dontNeed();
+  /// @brief release the memory of the datafile and evict its pages from
+  /// the page cache. only clean pages can be evicted, so the datafile
+  /// should be synced before. the data is read from disk again when it
+  /// is accessed later
+  void dropPageCache();
+  /// @brief number of bytes of the datafile currently resident in memory
+  size_t residentSize() const;
   bool readOnly();
   bool readWrite();
   
@@ -132,15 +132,17 @@ void MMFilesDitches::destroy() {
         type == MMFilesDitch::TRI_DITCH_REPLICATION ||
         type == MMFilesDitch::TRI_DITCH_COMPACTION) {
       delete ptr;
-    } else if (type == MMFilesDitch::TRI_DITCH_DOCUMENT) {
-      LOG_TOPIC(ERR, arangodb::Logger::FIXME) << "logic error. shouldn't have document ditches on unload";
-      TRI_ASSERT(false);
     } else {
       LOG_TOPIC(ERR, arangodb::Logger::FIXME) << "unknown ditch type";
     }
 
     ptr = next;
   }
+
+  if (_numMMFilesDocumentMMFilesDitches > 0) {
+    LOG_TOPIC(ERR, arangodb::Logger::FIXME) << "logic error. shouldn't have document ditches on unload";
+    TRI_ASSERT(false);
+  }
 }
 
 /// @brief return the associated collection
@@ -160,6 +162,12 @@ MMFilesDitch* MMFilesDitches::process(bool& popped,
                         std::function<bool(MMFilesDitch const*)> callback) {
   popped = false;
 
+  if (_numMMFilesDocumentMMFilesDitches > 0) {
+    // there is still a reference held to document data in a datafile. We
+    // must then not unload or remove a file
+    return nullptr;
+  }
+
   MUTEX_LOCKER(mutexLocker, _lock);
 
   auto ditch = _begin;
@@ -173,11 +181,8 @@ MMFilesDitch* MMFilesDitches::process(bool& popped,
 
   auto const type = ditch->type();
 
-  // if it is a MMFilesDocumentDitch, it means that there is still a reference held
-  // to document data in a datafile. We must then not unload or remove a file
-  if (type == MMFilesDitch::TRI_DITCH_DOCUMENT ||
-      type == MMFilesDitch::TRI_DITCH_REPLICATION ||
-      type == MMFilesDitch::TRI_DITCH_COMPACTION || _numMMFilesDocumentMMFilesDitches > 0) {
+  if (type == MMFilesDitch::TRI_DITCH_REPLICATION ||
+      type == MMFilesDitch::TRI_DITCH_COMPACTION) {
     // did not find anything at the head of the barrier list or found an element
     // marker
     // this means we must exit and cannot throw away datafiles and can unload
@@ -224,27 +229,23 @@ char const* MMFilesDitches::head() {
   auto ditch = _begin;
 
   if (ditch == nullptr) {
+    if (_numMMFilesDocumentMMFilesDitches > 0) {
+      return "document-reference";
+    }
     return nullptr;
   }
   return ditch->typeName();
 }
 
-/// @brief return the number of document ditches active
-uint64_t MMFilesDitches::numMMFilesDocumentMMFilesDitches() {
-  MUTEX_LOCKER(mutexLocker, _lock);
-
-  return _numMMFilesDocumentMMFilesDitches;
-}
-
 /// @brief check whether the ditches contain a ditch of a certain type
 bool MMFilesDitches::contains(MMFilesDitch::DitchType type) {
-  MUTEX_LOCKER(mutexLocker, _lock);
-
   if (type == MMFilesDitch::TRI_DITCH_DOCUMENT) {
     // shortcut
     return (_numMMFilesDocumentMMFilesDitches > 0);
   }
 
+  MUTEX_LOCKER(mutexLocker, _lock);
+
   auto const* ptr = _begin;
 
   while (ptr != nullptr) {
@@ -262,17 +263,13 @@ bool MMFilesDitches::contains(MMFilesDitch::DitchType type) {
 void MMFilesDitches::freeDitch(MMFilesDitch* ditch) {
   TRI_ASSERT(ditch != nullptr);
 
-  bool const isMMFilesDocumentDitch = (ditch->type() == MMFilesDitch::TRI_DITCH_DOCUMENT);
-
-  {
+  if (ditch->type() == MMFilesDitch::TRI_DITCH_DOCUMENT) {
+    // decrease counter
+    releaseDocuments();
+  } else {
     MUTEX_LOCKER(mutexLocker, _lock);
 
     unlink(ditch);
-
-    if (isMMFilesDocumentDitch) {
-      // decrease counter
-      --_numMMFilesDocumentMMFilesDitches;
-    }
   }
 
   delete ditch;
@@ -289,14 +286,8 @@ void MMFilesDitches::freeMMFilesDocumentDitch(MMFilesDocumentDitch* ditch, bool
     TRI_ASSERT(ditch->usedByTransaction() == true);
   }
 
-  {
-    MUTEX_LOCKER(mutexLocker, _lock); 
-
-    unlink(ditch);
-
-    // decrease counter
-    --_numMMFilesDocumentMMFilesDitches;
-  }
+  // decrease counter
+  releaseDocuments();
 
   delete ditch;
 }
@@ -411,7 +402,11 @@ void MMFilesDitches::link(MMFilesDitch* ditch) {
   ditch->_next = nullptr;
   ditch->_prev = nullptr;
   
-  bool const isMMFilesDocumentDitch = (ditch->type() == MMFilesDitch::TRI_DITCH_DOCUMENT);
+  if (ditch->type() == MMFilesDitch::TRI_DITCH_DOCUMENT) {
+    // increase counter
+    pinDocuments();
+    return;
+  }
 
   MUTEX_LOCKER(mutexLocker, _lock);  // FIX_MUTEX
 
@@ -427,11 +422,6 @@ void MMFilesDitches::link(MMFilesDitch* ditch) {
   }
     
   _end = ditch;
-
-  if (isMMFilesDocumentDitch) {
-    // increase counter
-    ++_numMMFilesDocumentMMFilesDitches;
-  }
 }
 
 /// @brief unlinks the ditch from the linked list of ditches
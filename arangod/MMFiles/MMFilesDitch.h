@@ -256,7 +256,19 @@ class MMFilesDitches {
   char const* head();
 
   /// @brief return the number of document ditches active
-  uint64_t numMMFilesDocumentMMFilesDitches();
+  uint64_t numMMFilesDocumentMMFilesDitches() const {
+    return _numMMFilesDocumentMMFilesDitches.load();
+  }
+
+  /// @brief protect the documents of the collection without creating a
+  /// ditch. every call must be matched by a call to releaseDocuments
+  void pinDocuments() { ++_numMMFilesDocumentMMFilesDitches; }
+
+  /// @brief release the protection acquired by pinDocuments
+  void releaseDocuments() {
+    TRI_ASSERT(_numMMFilesDocumentMMFilesDitches > 0);
+    --_numMMFilesDocumentMMFilesDitches;
+  }
 
   /// @brief check whether the ditches contain a ditch of a certain type
   bool contains(MMFilesDitch::DitchType);
@@ -316,7 +328,9 @@ class MMFilesDitches {
   arangodb::Mutex _lock;
   MMFilesDitch* _begin;
   MMFilesDitch* _end;
-  uint64_t _numMMFilesDocumentMMFilesDitches;
+  /// @brief document ditches are not linked into the list, as any of
+  /// them blocks processing the list. counting them avoids the lock
+  std::atomic<uint64_t> _numMMFilesDocumentMMFilesDitches;
 };
 }
 
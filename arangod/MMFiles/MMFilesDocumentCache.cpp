@@ -0,0 +1,259 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2017 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "MMFilesDocumentCache.h"
+#include "Basics/MutexLocker.h"
+#include "Basics/VelocyPackHelper.h"
+#include "Cache/Cache.h"
+#include "Cache/CacheManagerFeature.h"
+#include "Cache/CachedValue.h"
+#include "Cache/Finding.h"
+#include "Cache/Manager.h"
+#include "MMFiles/MMFilesTransactionState.h"
+#include "Transaction/Methods.h"
+
+using namespace arangodb;
+
+namespace {
+/// @brief maximum number of attempts to blacklist a value in the cache
+static constexpr size_t MaxBlacklistTries = 10;
+
+/// @brief join the attribute names of a projection
+static std::string projectionSignature(
+    std::vector<std::string> const& projections) {
+  std::string result;
+  for (auto const& it : projections) {
+    result.append(it);
+    result.push_back('\0');
+  }
+  return result;
+}
+}
+
+MMFilesDocumentCache::MMFilesDocumentCache()
+    : _hasCache(false), _numProjections(0) {}
+
+MMFilesDocumentCache::~MMFilesDocumentCache() {
+  if (_cache != nullptr && CacheManagerFeature::MANAGER != nullptr) {
+    CacheManagerFeature::MANAGER->destroyCache(_cache);
+  }
+}
+
+bool MMFilesDocumentCache::lookup(transaction::Methods* trx,
+                                  StringRef const& key,
+                                  std::vector<std::string> const& projections,
+                                  VPackBuilder& result) {
+  if (this->cache(true) == nullptr) {
+    return false;
+  }
+  static_cast<MMFilesTransactionState*>(trx->state())->useCacheTransaction();
+
+  return lookup(key, projections, result);
+}
+
+bool MMFilesDocumentCache::lookup(StringRef const& key,
+                                  std::vector<std::string> const& projections,
+                                  VPackBuilder& result) {
+  int id = projectionId(projections, false);
+  if (id < 0) {
+    return false;
+  }
+
+  cache::Cache* cache = this->cache(true);
+  if (cache == nullptr) {
+    return false;
+  }
+
+  std::string cacheKey;
+  buildCacheKey(cacheKey, key, static_cast<uint8_t>(id));
+  cache::Finding finding =
+      cache->find(cacheKey.data(), static_cast<uint32_t>(cacheKey.size()));
+  if (!finding.found()) {
+    return false;
+  }
+
+  result.add(VPackSlice(finding.value()->value()));
+  return true;
+}
+
+void MMFilesDocumentCache::store(transaction::Methods* trx,
+                                 StringRef const& key,
+                                 std::vector<std::string> const& projections,
+                                 VPackSlice document) {
+  if (!trx->state()->isReadOnlyTransaction()) {
+    // the transaction may have modified the document itself
+    return;
+  }
+
+  store(key, projections, document);
+}
+
+void MMFilesDocumentCache::store(StringRef const& key,
+                                 std::vector<std::string> const& projections,
+                                 VPackSlice document) {
+  cache::Cache* cache = this->cache(false);
+  if (cache == nullptr) {
+    return;
+  }
+
+  int id = projectionId(projections, true);
+  if (id < 0) {
+    return;
+  }
+
+  std::string cacheKey;
+  buildCacheKey(cacheKey, key, static_cast<uint8_t>(id));
+
+  cache::CachedValue* value = nullptr;
+  if (id == 0) {
+    value = cache::CachedValue::construct(
+        cacheKey.data(), static_cast<uint32_t>(cacheKey.size()),
+        document.start(), document.byteSize());
+  } else {
+    VPackBuilder builder;
+    buildProjection(builder, document, projections);
+    VPackSlice projection = builder.slice();
+    value = cache::CachedValue::construct(
+        cacheKey.data(), static_cast<uint32_t>(cacheKey.size()),
+        projection.start(), projection.byteSize());
+  }
+
+  if (value != nullptr && !cache->insert(value)) {
+    // not stored, e.g. because the document is blacklisted
+    delete value;
+  }
+}
+
+void MMFilesDocumentCache::invalidate(transaction::Methods* trx,
+                                      StringRef const& key) {
+  if (this->cache(false) == nullptr) {
+    // nothing can have been cached yet
+    return;
+  }
+  static_cast<MMFilesTransactionState*>(trx->state())->useCacheTransaction();
+
+  invalidate(key);
+}
+
+void MMFilesDocumentCache::invalidate(StringRef const& key) {
+  cache::Cache* cache = this->cache(false);
+  if (cache == nullptr) {
+    return;
+  }
+
+  size_t const n = _numProjections.load(std::memory_order_acquire);
+  std::string cacheKey;
+  for (size_t id = 0; id <= n; ++id) {
+    buildCacheKey(cacheKey, key, static_cast<uint8_t>(id));
+    for (size_t tries = 0; tries < MaxBlacklistTries; ++tries) {
+      if (cache->blacklist(cacheKey.data(),
+                           static_cast<uint32_t>(cacheKey.size()))) {
+        break;
+      }
+    }
+  }
+}
+
+void MMFilesDocumentCache::buildProjection(
+    VPackBuilder& result, VPackSlice document,
+    std::vector<std::string> const& projections) {
+  result.openObject();
+  for (auto const& it : projections) {
+    VPackSlice value = document.get(it);
+    if (value.isNone()) {
+      value = arangodb::basics::VelocyPackHelper::NullValue();
+    }
+    result.add(it, value);
+  }
+  result.close();
+}
+
+cache::Cache* MMFilesDocumentCache::cache(bool create) {
+  if (_hasCache.load(std::memory_order_acquire)) {
+    return _cache.get();
+  }
+  if (!create) {
+    return nullptr;
+  }
+
+  MUTEX_LOCKER(mutexLocker, _lock);
+  if (!_hasCache.load(std::memory_order_relaxed)) {
+    cache::Manager* manager = CacheManagerFeature::MANAGER;
+    if (manager == nullptr) {
+      return nullptr;
+    }
+    // few hot documents are read over and over, so do not let scans over
+    // many documents evict them
+    _cache = manager->createCache(cache::CacheType::Transactional, false,
+                                  UINT64_MAX, true);
+    if (_cache == nullptr) {
+      // creation may fail under memory pressure. try again next time
+      return nullptr;
+    }
+    _hasCache.store(true, std::memory_order_release);
+  }
+  return _cache.get();
+}
+
+int MMFilesDocumentCache::projectionId(
+    std::vector<std::string> const& projections, bool registerNew) {
+  if (projections.empty()) {
+    return 0;
+  }
+
+  std::string signature = projectionSignature(projections);
+  size_t n = _numProjections.load(std::memory_order_acquire);
+  for (size_t i = 0; i < n; ++i) {
+    if (_projections[i] == signature) {
+      return static_cast<int>(i + 1);
+    }
+  }
+  if (!registerNew) {
+    return -1;
+  }
+
+  MUTEX_LOCKER(mutexLocker, _lock);
+  n = _numProjections.load(std::memory_order_relaxed);
+  for (size_t i = 0; i < n; ++i) {
+    if (_projections[i] == signature) {
+      return static_cast<int>(i + 1);
+    }
+  }
+  if (n == MaxProjections) {
+    return -1;
+  }
+  _projections[n] = std::move(signature);
+  _numProjections.store(n + 1, std::memory_order_release);
+  return static_cast<int>(n + 1);
+}
+
+void MMFilesDocumentCache::buildCacheKey(std::string& result,
+                                         StringRef const& key,
+                                         uint8_t projectionId) {
+  // document keys cannot contain '\0', so the projection id cannot
+  // make one key look like another
+  result.clear();
+  result.reserve(key.size() + 2);
+  result.append(key.data(), key.size());
+  result.push_back('\0');
+  result.push_back(static_cast<char>(projectionId));
+}
@@ -0,0 +1,126 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2017 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_MMFILES_MMFILES_DOCUMENT_CACHE_H
+#define ARANGOD_MMFILES_MMFILES_DOCUMENT_CACHE_H 1
+
+#include "Basics/Common.h"
+#include "Basics/Mutex.h"
+#include "Basics/StringRef.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Slice.h>
+
+#include <atomic>
+
+namespace arangodb {
+namespace cache {
+class Cache;
+}
+namespace transaction {
+class Methods;
+}
+
+/// @brief cache of hot documents of a collection, looked up by key. the
+/// values are copies of the documents, or of projections of them to a few
+/// top-level attributes, so that reading them does not touch the datafiles.
+/// the cache is a transactional cache of the global cache manager, so it is
+/// bounded by the global cache size, and writers blacklist the keys they
+/// modify so that no stale values can be read
+class MMFilesDocumentCache {
+ public:
+  /// @brief maximum number of distinct projections cached per collection
+  static constexpr size_t MaxProjections = 8;
+
+  MMFilesDocumentCache();
+  ~MMFilesDocumentCache();
+
+  MMFilesDocumentCache(MMFilesDocumentCache const&) = delete;
+  MMFilesDocumentCache& operator=(MMFilesDocumentCache const&) = delete;
+
+ public:
+  /// @brief look up a document, or the projection of it to the given
+  /// attributes if any. on a hit, the value is added to the builder
+  bool lookup(transaction::Methods* trx, StringRef const& key,
+              std::vector<std::string> const& projections,
+              arangodb::velocypack::Builder& result);
+
+  /// @brief store a document, or the projection of it to the given
+  /// attributes if any. values are only stored by read-only transactions,
+  /// so that uncommitted documents are never cached
+  void store(transaction::Methods* trx, StringRef const& key,
+             std::vector<std::string> const& projections,
+             arangodb::velocypack::Slice document);
+
+  /// @brief blacklist the document and all its projections. must be called
+  /// before the document is modified or removed
+  void invalidate(transaction::Methods* trx, StringRef const& key);
+
+  /// @brief look up, store and blacklist values as above, within a cache
+  /// transaction that the caller has begun
+  bool lookup(StringRef const& key,
+              std::vector<std::string> const& projections,
+              arangodb::velocypack::Builder& result);
+  void store(StringRef const& key, std::vector<std::string> const& projections,
+             arangodb::velocypack::Slice document);
+  void invalidate(StringRef const& key);
+
+  /// @brief add the projection of a document to the given attributes, as
+  /// an object. missing attributes are returned as null
+  static void buildProjection(arangodb::velocypack::Builder& result,
+                              arangodb::velocypack::Slice document,
+                              std::vector<std::string> const& projections);
+
+ private:
+  /// @brief return the cache, creating it on first use if requested.
+  /// returns a nullptr if there is no cache (manager)
+  cache::Cache* cache(bool create);
+
+  /// @brief the id of a projection, 0 for the full document. returns -1
+  /// for projections that are not cached
+  int projectionId(std::vector<std::string> const& projections,
+                   bool registerNew);
+
+  /// @brief build the cache key for a document key and projection id
+  static void buildCacheKey(std::string& result, StringRef const& key,
+                            uint8_t projectionId);
+
+ private:
+  /// @brief lock protecting the creation of the cache and the registration
+  /// of projections
+  Mutex _lock;
+
+  /// @brief whether or not the cache has been created
+  std::atomic<bool> _hasCache;
+
+  /// @brief the cache, released together with the collection
+  std::shared_ptr<cache::Cache> _cache;
+
+  /// @brief the registered projections, as their attribute names joined by
+  /// '\0'. entries are only appended, and published by _numProjections
+  std::string _projections[MaxProjections];
+  std::atomic<size_t> _numProjections;
+};
+
+}
+
+#endif
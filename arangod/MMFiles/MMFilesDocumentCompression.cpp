@@ -0,0 +1,151 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2017 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "MMFilesDocumentCompression.h"
+#include "Basics/Exceptions.h"
+#include "Basics/MutexLocker.h"
+
+#include <snappy.h>
+
+using namespace arangodb;
+
+/// @brief add the compressed form of the document to the builder
+void MMFilesDocumentCompression::compress(velocypack::Slice document,
+                                          velocypack::Builder& builder) {
+  TRI_ASSERT(document.isObject());
+
+  size_t const length = static_cast<size_t>(document.byteSize());
+  std::string compressed;
+  compressed.resize(snappy::MaxCompressedLength(length));
+
+  size_t compressedLength = 0;
+  snappy::RawCompress(reinterpret_cast<char const*>(document.start()), length,
+                      &compressed[0], &compressedLength);
+
+  builder.add(velocypack::ValuePair(compressed.data(), compressedLength,
+                                    velocypack::ValueType::Binary));
+}
+
+/// @brief decompress the VelocyPack of a document marker into the buffer
+void MMFilesDocumentCompression::decompress(
+    uint8_t const* vpack, velocypack::Buffer<uint8_t>& buffer) {
+  TRI_ASSERT(isCompressed(vpack));
+
+  velocypack::ValueLength compressedLength;
+  char const* compressed = reinterpret_cast<char const*>(
+      velocypack::Slice(vpack).getBinary(compressedLength));
+
+  size_t length = 0;
+  if (!snappy::GetUncompressedLength(
+          compressed, static_cast<size_t>(compressedLength), &length) ||
+      length == 0) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_ARANGO_CORRUPTED_DATAFILE,
+                                   "invalid compressed document");
+  }
+
+  buffer.clear();
+  buffer.reserve(length);
+
+  if (!snappy::RawUncompress(compressed,
+                             static_cast<size_t>(compressedLength),
+                             reinterpret_cast<char*>(buffer.data()))) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_ARANGO_CORRUPTED_DATAFILE,
+                                   "invalid compressed document");
+  }
+  buffer.resetTo(length);
+
+  velocypack::Slice document(buffer.data());
+  if (!document.isObject() || document.byteSize() != length) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_ARANGO_CORRUPTED_DATAFILE,
+                                   "invalid compressed document");
+  }
+}
+
+/// @brief the document stored in a document marker
+velocypack::Slice MMFilesDocumentCompression::document(
+    uint8_t const* vpack, velocypack::Buffer<uint8_t>& buffer) {
+  if (!isCompressed(vpack)) {
+    return velocypack::Slice(vpack);
+  }
+  decompress(vpack, buffer);
+  return velocypack::Slice(buffer.data());
+}
+
+/// @brief the decompressed copy of the given revision
+uint8_t const* MMFilesDecompressedDocuments::lookup(TRI_voc_rid_t revisionId,
+                                                    uint8_t const* vpack) {
+  {
+    MUTEX_LOCKER(mutexLocker, _lock);
+    auto it = _documents.find(vpack);
+    if (it != _documents.end() && (*it).second.revisionId == revisionId) {
+      return (*it).second.document->data();
+    }
+  }
+
+  // decompress without holding the lock. if another reader does the same
+  // in the meantime, the copy that was stored first is used
+  auto document = std::make_unique<velocypack::Buffer<uint8_t>>();
+  MMFilesDocumentCompression::decompress(vpack, *document);
+
+  MUTEX_LOCKER(mutexLocker, _lock);
+  auto it = _documents.find(vpack);
+  if (it != _documents.end()) {
+    if ((*it).second.revisionId == revisionId) {
+      return (*it).second.document->data();
+    }
+    // the position belonged to another document before. a reader may
+    // still use its copy, so it is only freed by the next release
+    _retired.emplace_back(std::move((*it).second.document));
+    _documents.erase(it);
+  }
+
+  uint8_t const* result = document->data();
+  size_t const size = static_cast<size_t>(document->size());
+  _documents.emplace(vpack, Entry{revisionId, std::move(document)});
+  _memoryUsage += size;
+  return result;
+}
+
+/// @brief release all copies if canRelease returns true
+bool MMFilesDecompressedDocuments::release(
+    std::function<bool()> const& canRelease) {
+  MUTEX_LOCKER(mutexLocker, _lock);
+  if ((_documents.empty() && _retired.empty()) || !canRelease()) {
+    return false;
+  }
+  _documents.clear();
+  _retired.clear();
+  _memoryUsage = 0;
+  return true;
+}
+
+/// @brief number of copies
+size_t MMFilesDecompressedDocuments::size() const {
+  MUTEX_LOCKER(mutexLocker, _lock);
+  return _documents.size();
+}
+
+/// @brief memory used by the copies
+size_t MMFilesDecompressedDocuments::memoryUsage() const {
+  MUTEX_LOCKER(mutexLocker, _lock);
+  return _memoryUsage;
+}
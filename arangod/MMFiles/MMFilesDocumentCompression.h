@@ -0,0 +1,118 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2017 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_MMFILES_MMFILES_DOCUMENT_COMPRESSION_H
+#define ARANGOD_MMFILES_MMFILES_DOCUMENT_COMPRESSION_H 1
+
+#include "Basics/Common.h"
+#include "Basics/Mutex.h"
+#include "VocBase/voc-types.h"
+
+#include <velocypack/Buffer.h>
+#include <velocypack/Builder.h>
+#include <velocypack/Slice.h>
+
+namespace arangodb {
+
+/// @brief Snappy compression of the documents of collections with the
+/// compressDocuments option. the document marker of a compressed document
+/// contains a VelocyPack Binary value with the compressed document instead
+/// of the document itself. documents are always objects, so both forms can
+/// be told apart without knowing the option of the collection
+class MMFilesDocumentCompression {
+ public:
+  MMFilesDocumentCompression() = delete;
+
+  /// @brief whether the VelocyPack of a document marker is compressed
+  static inline bool isCompressed(uint8_t const* vpack) {
+    return velocypack::Slice(vpack).isBinary();
+  }
+
+  /// @brief add the compressed form of the document to the builder
+  static void compress(velocypack::Slice document,
+                       velocypack::Builder& builder);
+
+  /// @brief decompress the VelocyPack of a document marker into the buffer.
+  /// throws TRI_ERROR_ARANGO_CORRUPTED_DATAFILE if it is not a valid
+  /// compressed document
+  static void decompress(uint8_t const* vpack,
+                         velocypack::Buffer<uint8_t>& buffer);
+
+  /// @brief the document stored in a document marker. a compressed document
+  /// is decompressed into the buffer, which must outlive the result
+  static velocypack::Slice document(uint8_t const* vpack,
+                                    velocypack::Buffer<uint8_t>& buffer);
+};
+
+/// @brief decompressed copies of the compressed documents of a collection.
+/// readers use document pointers for as long as they hold a document ditch,
+/// so a copy must live as long as any ditch that was taken before it was
+/// handed out. the copies are only released all at once, when there is no
+/// document ditch at all. until then, a copy is reused by all readers of
+/// the same document
+class MMFilesDecompressedDocuments {
+ public:
+  MMFilesDecompressedDocuments() : _memoryUsage(0) {}
+  ~MMFilesDecompressedDocuments() = default;
+
+  MMFilesDecompressedDocuments(MMFilesDecompressedDocuments const&) = delete;
+  MMFilesDecompressedDocuments& operator=(MMFilesDecompressedDocuments const&) =
+      delete;
+
+ public:
+  /// @brief the decompressed copy of the given revision, whose compressed
+  /// document is at vpack. decompresses the document on first use
+  uint8_t const* lookup(TRI_voc_rid_t revisionId, uint8_t const* vpack);
+
+  /// @brief release all copies if canRelease returns true. it is called
+  /// under the lock that lookups take, so no copy can be handed out between
+  /// the check and the release. returns whether the copies were released
+  bool release(std::function<bool()> const& canRelease);
+
+  /// @brief number of copies that can be looked up
+  size_t size() const;
+
+  /// @brief memory used by the copies
+  size_t memoryUsage() const;
+
+ private:
+  struct Entry {
+    TRI_voc_rid_t revisionId;
+    std::unique_ptr<velocypack::Buffer<uint8_t>> document;
+  };
+
+  mutable Mutex _lock;
+
+  /// @brief the copies, by the position of the compressed document. the
+  /// revision id detects a position that was reused for another document
+  std::unordered_map<uint8_t const*, Entry> _documents;
+
+  /// @brief copies that were replaced by the copy of another document at
+  /// the same position
+  std::vector<std::unique_ptr<velocypack::Buffer<uint8_t>>> _retired;
+
+  size_t _memoryUsage;
+};
+
+}
+
+#endif
@@ -101,12 +101,18 @@ void MMFilesDocumentOperation::revert(transaction::Methods* trx) {
   StatusType status = _status;
   _status = StatusType::REVERTED;
 
+  auto physical = static_cast<MMFilesCollection*>(_collection->getPhysical());
+  TRI_ASSERT(physical != nullptr);
+
+  // the revisions point to the VelocyPack of the document markers, which
+  // may contain compressed documents
   TRI_voc_rid_t oldRevisionId = 0;
   VPackSlice oldDoc;
   if (_type != TRI_VOC_DOCUMENT_OPERATION_INSERT) {
     TRI_ASSERT(!_oldRevision.empty());
     oldRevisionId = _oldRevision._revisionId;
-    oldDoc = VPackSlice(_oldRevision._vpack);
+    oldDoc = VPackSlice(
+        physical->uncompressedVPack(oldRevisionId, _oldRevision._vpack));
   }
 
   TRI_voc_rid_t newRevisionId = 0;
@@ -114,12 +120,10 @@ void MMFilesDocumentOperation::revert(transaction::Methods* trx) {
   if (_type != TRI_VOC_DOCUMENT_OPERATION_REMOVE) {
     TRI_ASSERT(!_newRevision.empty());
     newRevisionId = _newRevision._revisionId;
-    newDoc = VPackSlice(_newRevision._vpack);
+    newDoc = VPackSlice(
+        physical->uncompressedVPack(newRevisionId, _newRevision._vpack));
   }
 
-  auto physical = static_cast<MMFilesCollection*>(_collection->getPhysical());
-  TRI_ASSERT(physical != nullptr);
-
   if (_type == TRI_VOC_DOCUMENT_OPERATION_INSERT) {
     TRI_ASSERT(_oldRevision.empty());
     TRI_ASSERT(!_newRevision.empty());
@@ -164,7 +168,7 @@ void MMFilesDocumentOperation::revert(transaction::Methods* trx) {
       VPackSlice keySlice(transaction::helpers::extractKeyFromDocument(oldDoc));
       element->updateRevisionId(oldRevisionId, static_cast<uint32_t>(keySlice.begin() - oldDoc.begin()));
     }
-    physical->updateRevision(oldRevisionId, oldDoc.begin(), 0, false);
+    physical->updateRevision(oldRevisionId, _oldRevision._vpack, 0, false);
     
     // remove now obsolete new revision
     if (oldRevisionId != newRevisionId) { 
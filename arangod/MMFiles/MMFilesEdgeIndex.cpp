@@ -46,6 +46,9 @@
 
 using namespace arangodb;
 
+/// @brief number of keys the edge index iterator prefetches ahead
+static size_t const PrefetchDistance = 8;
+
 /// @brief hard-coded vector of the index attributes
 /// note that the attribute names must be hard-coded here to avoid an init-order
 /// fiasco with StaticStrings::FromString etc.
@@ -72,8 +75,15 @@ static uint64_t HashElementEdge(void*, MMFilesSimpleIndexElement const& element,
 }
 
 /// @brief checks if key and element match
-static bool IsEqualKeyEdge(void* userData, VPackSlice const* left, MMFilesSimpleIndexElement const& right) {
+static bool IsEqualKeyEdge(void* userData, VPackSlice const* left, uint64_t hash, MMFilesSimpleIndexElement const& right) {
   TRI_ASSERT(left != nullptr);
+  
+  if (right.hash() != hash) {
+    // the element stores the hash of its value, so there is no need to
+    // look up the document if the hashes differ
+    return false;
+  }
+
   IndexLookupContext* context = static_cast<IndexLookupContext*>(userData);
   TRI_ASSERT(context != nullptr);
 
@@ -93,6 +103,10 @@ static bool IsEqualElementEdge(void*, MMFilesSimpleIndexElement const& left, MMF
 
 /// @brief checks for elements are equal
 static bool IsEqualElementEdgeByKey(void* userData, MMFilesSimpleIndexElement const& left, MMFilesSimpleIndexElement const& right) {
+  if (left.hash() != right.hash()) {
+    return false;
+  }
+
   IndexLookupContext* context = static_cast<IndexLookupContext*>(userData);
   try {
     VPackSlice lSlice = left.slice(context);
@@ -116,10 +130,13 @@ MMFilesEdgeIndexIterator::MMFilesEdgeIndexIterator(LogicalCollection* collection
       _index(indexImpl),
       _keys(keys.get()),
       _iterator(_keys->slice()),
+      _prefetchIterator(_keys->slice()),
+      _usePrefetch(_keys->slice().length() > 1),
       _posInBuffer(0),
       _batchSize(1000),
       _lastElement() {
   keys.release();  // now we have ownership for _keys
+  prefetchKeys(PrefetchDistance);
 }
 
 MMFilesEdgeIndexIterator::~MMFilesEdgeIndexIterator() {
@@ -145,6 +162,7 @@ bool MMFilesEdgeIndexIterator::next(TokenCallback const& cb, size_t limit) {
       if (tmp.isObject()) {
         tmp = tmp.get(StaticStrings::IndexEq);
       }
+      prefetchKeys(1);
       _index->lookupByKey(&_context, &tmp, _buffer, _batchSize);
     } else if (_posInBuffer >= _buffer.size()) {
       // We have to refill the buffer
@@ -174,7 +192,24 @@ void MMFilesEdgeIndexIterator::reset() {
   _posInBuffer = 0;
   _buffer.clear();
   _iterator.reset();
+  _prefetchIterator.reset();
   _lastElement = MMFilesSimpleIndexElement();
+  prefetchKeys(PrefetchDistance);
+}
+
+void MMFilesEdgeIndexIterator::prefetchKeys(size_t n) {
+  if (!_usePrefetch) {
+    return;
+  }
+
+  while (n-- > 0 && _prefetchIterator.valid()) {
+    VPackSlice tmp = _prefetchIterator.value();
+    if (tmp.isObject()) {
+      tmp = tmp.get(StaticStrings::IndexEq);
+    }
+    _index->prefetchByKey(&_context, &tmp);
+    _prefetchIterator.next();
+  }
 }
   
 MMFilesEdgeIndex::MMFilesEdgeIndex(TRI_idx_iid_t iid, arangodb::LogicalCollection* collection)
@@ -61,10 +61,17 @@ class MMFilesEdgeIndexIterator final : public IndexIterator {
 
   void reset() override;
 
+ private:
+  /// @brief prefetch the hash table slots of the keys ahead of the one
+  /// looked up next. only used for iterators with multiple keys
+  void prefetchKeys(size_t n);
+
  private:
   TRI_MMFilesEdgeIndexHash_t const* _index;
   std::unique_ptr<arangodb::velocypack::Builder> _keys;
   arangodb::velocypack::ArrayIterator _iterator;
+  arangodb::velocypack::ArrayIterator _prefetchIterator;
+  bool const _usePrefetch;
   std::vector<MMFilesSimpleIndexElement> _buffer;
   size_t _posInBuffer;
   size_t _batchSize;
@@ -46,6 +46,8 @@
 #include "MMFiles/MMFilesTransactionContextData.h"
 #include "MMFiles/MMFilesTransactionState.h"
 #include "MMFiles/MMFilesV8Functions.h"
+#include "ProgramOptions/ProgramOptions.h"
+#include "ProgramOptions/Section.h"
 #include "Random/RandomGenerator.h"
 #include "RestServer/DatabaseFeature.h"
 #include "RestServer/DatabasePathFeature.h"
@@ -61,6 +63,7 @@
 
 using namespace arangodb;
 using namespace arangodb::basics;
+using namespace arangodb::options;
 
 namespace {
 /// @brief collection meta info filename
@@ -132,6 +135,9 @@ std::string const MMFilesEngine::FeatureName("MMFilesEngine");
 MMFilesEngine::MMFilesEngine(application_features::ApplicationServer* server)
     : StorageEngine(server, EngineName, FeatureName, new MMFilesIndexFactory())
     , _isUpgrade(false)
+    , _primaryIndexSnapshots(false)
+    , _documentCache(false)
+    , _snapshotReads(false)
     , _maxTick(0) { 
       startsAfter("MMFilesPersistentIndex");
 }
@@ -170,11 +176,105 @@ void MMFilesEngine::dropDatabase(Database* database, int& status) {
 
 
 // add the storage engine's specifc options to the global list of options
-void MMFilesEngine::collectOptions(std::shared_ptr<options::ProgramOptions>) {
+void MMFilesEngine::collectOptions(std::shared_ptr<options::ProgramOptions> options) {
+  auto& settings = MMFilesCompactorThread::settings();
+
+  options->addSection(
+      Section("compaction", "Configure the MMFiles compactor", "compaction",
+              false, false));
+
+  options->addOption("--compaction.db-sleep-time",
+                     "sleep interval between two compaction runs (in s)",
+                     new DoubleParameter(&settings.sleepTime));
+
+  options->addOption("--compaction.min-interval",
+                     "minimum sleep time between two compactions of the same "
+                     "collection (in s)",
+                     new DoubleParameter(&settings.collectionInterval));
+
+  options->addOption("--compaction.dead-documents-threshold",
+                     "minimum number of dead documents in a datafile that "
+                     "triggers its compaction",
+                     new UInt64Parameter(&settings.deadNumberThreshold));
+
+  options->addOption("--compaction.dead-size-threshold",
+                     "minimum size of dead data (in bytes) in a datafile "
+                     "that triggers its compaction",
+                     new UInt64Parameter(&settings.deadSizeThreshold));
+
+  options->addOption("--compaction.dead-size-percent-threshold",
+                     "minimum share of dead data in a datafile that "
+                     "triggers its compaction (0.1 = 10 %)",
+                     new DoubleParameter(&settings.deadShare));
+
+  options->addOption("--compaction.max-files",
+                     "maximum number of datafiles to merge into one "
+                     "compactor file",
+                     new UInt64Parameter(&settings.maxFiles));
+
+  options->addOption("--compaction.max-result-file-size",
+                     "maximum size of a compactor file (in bytes)",
+                     new UInt64Parameter(&settings.maxResultFilesize));
+
+  options->addOption("--compaction.max-write-rate",
+                     "maximum average number of bytes per second written "
+                     "by the compactor (0 = unlimited)",
+                     new UInt64Parameter(&settings.maxWriteRate));
+
+  options->addOption("--compaction.idle-datafiles-timeout",
+                     "time without document reads (in s) after which the "
+                     "memory of a collection's datafiles is released to the "
+                     "operating system (0 = never)",
+                     new DoubleParameter(&settings.idleDatafilesTimeout));
+
+  options->addOption("--compaction.drop-page-cache",
+                     "evict the pages of compactor files from the page "
+                     "cache once they are written",
+                     new BooleanParameter(&settings.dropPageCache));
+
+  options->addSection(
+      Section("mmfiles", "Configure the MMFiles storage engine", "mmfiles",
+              false, false));
+
+  options->addOption("--mmfiles.primary-index-snapshots",
+                     "write a snapshot of the primary index when a collection "
+                     "is closed, and use it instead of scanning the "
+                     "datafiles when the collection is opened again",
+                     new BooleanParameter(&_primaryIndexSnapshots));
+
+  options->addOption("--mmfiles.document-cache",
+                     "keep copies of documents looked up by key with "
+                     "DOCUMENT() in the in-memory cache (--cache.size), so "
+                     "that hot documents are read without touching the "
+                     "datafiles",
+                     new BooleanParameter(&_documentCache));
+
+  options->addOption("--mmfiles.snapshot-reads",
+                     "let read-only document lookups read from a snapshot "
+                     "taken when their transaction starts. writers keep the "
+                     "previous revisions of the documents they modify until "
+                     "no snapshot can see them anymore",
+                     new BooleanParameter(&_snapshotReads));
 }
   
 // validate the storage engine's specific options
 void MMFilesEngine::validateOptions(std::shared_ptr<options::ProgramOptions>) {
+  auto& settings = MMFilesCompactorThread::settings();
+
+  if (settings.maxFiles == 0) {
+    LOG_TOPIC(FATAL, arangodb::Logger::FIXME) << "invalid value for --compaction.max-files. Please use a value of at least 1";
+    FATAL_ERROR_EXIT();
+  }
+
+  if (settings.sleepTime <= 0.0) {
+    LOG_TOPIC(FATAL, arangodb::Logger::FIXME) << "invalid value for --compaction.db-sleep-time. Please use a positive value";
+    FATAL_ERROR_EXIT();
+  }
+
+  if (settings.idleDatafilesTimeout < 0.0) {
+    LOG_TOPIC(FATAL, arangodb::Logger::FIXME) << "invalid value for --compaction.idle-datafiles-timeout. Please use a value of at least 0";
+    FATAL_ERROR_EXIT();
+  }
 }
 
 // preparation phase for storage engine. can be used for internal setup.
@@ -2118,6 +2218,11 @@ int MMFilesEngine::openCollection(TRI_vocbase_t* vocbase, LogicalCollection* col
       continue;
     }
 
+    // file is a primary index snapshot. it is handled by the collection
+    if (filetype == "snapshot") {
+      continue;
+    }
+
     // file is a journal or datafile, open the datafile
     if (extension == "db") {
       // found a compaction file. now rename it back
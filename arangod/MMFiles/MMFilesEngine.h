@@ -138,6 +138,18 @@ class MMFilesEngine final : public StorageEngine {
   // wal in recovery
   bool inRecovery() override;
 
+  /// @brief whether or not primary index snapshots are written when
+  /// collections are closed, and used when they are opened again
+  bool usePrimaryIndexSnapshots() const { return _primaryIndexSnapshots; }
+
+  /// @brief whether or not documents looked up by key are kept in the
+  /// in-memory cache
+  bool useDocumentCache() const { return _documentCache; }
+
+  /// @brief whether or not read-only transactions can read documents from
+  /// a snapshot, so that they do not wait for the collection locks
+  bool useSnapshotReads() const { return _snapshotReads; }
+
   // start compactor thread and delete files form collections marked as deleted
   void recoveryDone(TRI_vocbase_t* vocbase) override;
 
@@ -383,6 +395,9 @@ public:
   std::string _basePath;
   std::string _databasePath;
   bool _isUpgrade;
+  bool _primaryIndexSnapshots;
+  bool _documentCache;
+  bool _snapshotReads;
   TRI_voc_tick_t _maxTick;
   std::vector<std::pair<std::string, std::string>> _deleted;
 
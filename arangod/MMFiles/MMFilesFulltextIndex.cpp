@@ -22,6 +22,7 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "MMFilesFulltextIndex.h"
+#include "Basics/LocalTaskQueue.h"
 #include "Basics/StringRef.h"
 #include "Basics/Utf8Helper.h"
 #include "Basics/VelocyPackHelper.h"
@@ -231,6 +232,34 @@ int MMFilesFulltextIndex::insert(transaction::Methods*, TRI_voc_rid_t revisionId
   return res;
 }
 
+/// @brief inserts many documents at once. the words of all documents are
+/// extracted before the index is locked, and are then merged into the
+/// index together
+void MMFilesFulltextIndex::batchInsert(
+    transaction::Methods* trx,
+    std::vector<std::pair<TRI_voc_rid_t, VPackSlice>> const& documents,
+    arangodb::basics::LocalTaskQueue* queue) {
+  std::vector<std::pair<TRI_voc_rid_t, std::vector<std::string>>> wordlists;
+
+  try {
+    wordlists.reserve(documents.size());
+    for (auto const& it : documents) {
+      std::vector<std::string> words = wordlist(it.second);
+      if (!words.empty()) {
+        wordlists.emplace_back(it.first, std::move(words));
+      }
+    }
+  } catch (...) {
+    queue->setStatus(TRI_ERROR_OUT_OF_MEMORY);
+    return;
+  }
+
+  if (!TRI_InsertWordsBatchMMFilesFulltextIndex(_fulltextIndex, wordlists)) {
+    LOG_TOPIC(ERR, arangodb::Logger::FIXME) << "adding documents to fulltext index failed";
+    queue->setStatus(TRI_ERROR_INTERNAL);
+  }
+}
+
 int MMFilesFulltextIndex::remove(transaction::Methods*, TRI_voc_rid_t revisionId,
                           VPackSlice const& doc, bool isRollback) {
   TRI_DeleteDocumentMMFilesFulltextIndex(_fulltextIndex, revisionId);
@@ -69,6 +69,13 @@ class MMFilesFulltextIndex final : public Index {
 
   int remove(transaction::Methods*, TRI_voc_rid_t, arangodb::velocypack::Slice const&, bool isRollback) override;
 
+  void batchInsert(
+      transaction::Methods*,
+      std::vector<std::pair<TRI_voc_rid_t, arangodb::velocypack::Slice>> const&,
+      arangodb::basics::LocalTaskQueue* queue = nullptr) override;
+
+  bool hasBatchInsert() const override { return true; }
+
   int unload() override;
 
   int cleanup() override;
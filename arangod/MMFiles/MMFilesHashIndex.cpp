@@ -43,6 +43,9 @@
 
 using namespace arangodb;
 
+/// @brief number of IN values the hash index iterator looks up in one batch
+static size_t const LookupBatchSize = 32;
+
 MMFilesHashIndexLookupBuilder::MMFilesHashIndexLookupBuilder(
     transaction::Methods* trx, arangodb::aql::AstNode const* node,
     arangodb::aql::Variable const* reference,
@@ -256,13 +259,20 @@ static uint64_t HashKey(void*, VPackSlice const* key) {
 /// @brief determines if a key corresponds to an element
 static bool IsEqualKeyElementMulti(void* userData,
                                    VPackSlice const* left,
+                                   uint64_t hash,
                                    MMFilesHashIndexElement const* right) {
   TRI_ASSERT(left->isArray());
   TRI_ASSERT(right->revisionId() != 0);
+
+  if (right->hash() != hash) {
+    // the element stores the hash of its values, so there is no need to
+    // look up the document if the hashes differ
+    return false;
+  }
+
   IndexLookupContext* context = static_cast<IndexLookupContext*>(userData);
   TRI_ASSERT(context != nullptr);
 
-  // TODO: is it a performance improvement to compare the hash values first?
   size_t const n = left->length();
 
   for (size_t i = 0; i < n; ++i) {
@@ -282,8 +292,8 @@ static bool IsEqualKeyElementMulti(void* userData,
 
 /// @brief determines if a key corresponds to an element
 static bool IsEqualKeyElementUnique(void* userData, VPackSlice const* left,
-                                    uint64_t, MMFilesHashIndexElement const* right) {
-  return IsEqualKeyElementMulti(userData, left, right);
+                                    uint64_t hash, MMFilesHashIndexElement const* right) {
+  return IsEqualKeyElementMulti(userData, left, hash, right);
 }
 
 MMFilesHashIndexIterator::MMFilesHashIndexIterator(LogicalCollection* collection,
@@ -295,29 +305,75 @@ MMFilesHashIndexIterator::MMFilesHashIndexIterator(LogicalCollection* collection
     : IndexIterator(collection, trx, mmdr, index),
       _index(index),
       _lookups(trx, node, reference, index->fields()),
+      _lookupsDone(false),
+      _posInBatch(0),
       _buffer(),
       _posInBuffer(0) {
-  _index->lookup(_trx, _lookups.lookup(), _buffer);
+  nextBatch(true);
 }
 
 bool MMFilesHashIndexIterator::next(TokenCallback const& cb, size_t limit) {
   while (limit > 0) {
     if (_posInBuffer >= _buffer.size()) {
-      if (!_lookups.hasAndGetNext()) {
+      if (!lookupNext()) {
         // we're at the end of the lookup values
         return false;
       }
+    }
 
-      // We have to refill the buffer
-      _buffer.clear();
-      _posInBuffer = 0;
+    if (!_buffer.empty()) {
+      // found something
+      cb(MMFilesToken{_buffer[_posInBuffer++]->revisionId()});
+      --limit;
+    }
+  }
+  return true;
+}
 
-      _index->lookup(_trx, _lookups.lookup(), _buffer);
+bool MMFilesHashIndexIterator::nextTokens(
+    std::vector<DocumentIdentifierToken>& tokens, size_t limit) {
+  while (limit > 0) {
+    if (_posInBuffer >= _buffer.size()) {
+      if (!lookupNext()) {
+        // we're at the end of the lookup values
+        return false;
+      }
+    }
+
+    // copy as much of the buffer as fits at once
+    size_t const n = (std::min)(limit, _buffer.size() - _posInBuffer);
+    for (size_t i = 0; i < n; ++i) {
+      tokens.emplace_back(MMFilesToken{_buffer[_posInBuffer + i]->revisionId()});
+    }
+    _posInBuffer += n;
+    limit -= n;
+  }
+  return true;
+}
+
+bool MMFilesHashIndexIterator::nextExtra(ExtraCallback const& cb, size_t limit) {
+  size_t const n = _context.numFields();
+
+  while (limit > 0) {
+    if (_posInBuffer >= _buffer.size()) {
+      if (!lookupNext()) {
+        // we're at the end of the lookup values
+        return false;
+      }
     }
 
     if (!_buffer.empty()) {
       // found something
-      cb(MMFilesToken{_buffer[_posInBuffer++]->revisionId()});
+      MMFilesHashIndexElement* element = _buffer[_posInBuffer++];
+
+      _extra.clear();
+      _extra.openArray();
+      for (size_t i = 0; i < n; ++i) {
+        _extra.add(element->slice(&_context, i));
+      }
+      _extra.close();
+
+      cb(MMFilesToken{element->revisionId()}, _extra.slice());
       --limit;
     }
   }
@@ -328,7 +384,56 @@ void MMFilesHashIndexIterator::reset() {
   _buffer.clear();
   _posInBuffer = 0;
   _lookups.reset();
-  _index->lookup(_trx, _lookups.lookup(), _buffer);
+  _lookupsDone = false;
+  nextBatch(true);
+}
+
+bool MMFilesHashIndexIterator::nextBatch(bool first) {
+  _batch.clear();
+  _batchValues.clear();
+  _posInBatch = 0;
+
+  if (_lookupsDone) {
+    return false;
+  }
+
+  // with many IN values, looking them up one after the other waits for
+  // a cache miss each time. the batch is prefetched before the first one
+  // is looked up
+  _batch.openArray();
+  size_t n = 0;
+  bool more = first || _lookups.hasAndGetNext();
+  while (more) {
+    VPackSlice value = _lookups.lookup();
+    if (!value.isNone()) {
+      _batch.add(value);
+    }
+    if (++n == LookupBatchSize) {
+      break;
+    }
+    more = _lookups.hasAndGetNext();
+  }
+  _batch.close();
+  _lookupsDone = !more;
+
+  for (auto const& value : VPackArrayIterator(_batch.slice())) {
+    _batchValues.emplace_back(value);
+    _index->prefetch(&_context, value);
+  }
+  return !_batchValues.empty();
+}
+
+bool MMFilesHashIndexIterator::lookupNext() {
+  if (_posInBatch >= _batchValues.size() && !nextBatch(false)) {
+    return false;
+  }
+
+  // We have to refill the buffer
+  _buffer.clear();
+  _posInBuffer = 0;
+
+  _index->lookup(_trx, _batchValues[_posInBatch++], _buffer);
+  return true;
 }
   
 MMFilesHashIndexIteratorVPack::MMFilesHashIndexIteratorVPack(LogicalCollection* collection,
@@ -705,6 +810,16 @@ int MMFilesHashIndex::lookup(transaction::Methods* trx,
   return TRI_ERROR_NO_ERROR;
 }
 
+/// @brief prefetches the slot a lookup of the velocypack slice starts at
+void MMFilesHashIndex::prefetch(IndexLookupContext* context,
+                                VPackSlice key) const {
+  if (_unique) {
+    _uniqueArray->_hashArray->prefetchByKey(context, &key);
+  } else {
+    _multiArray->_hashArray->prefetchByKey(context, &key);
+  }
+}
+
 int MMFilesHashIndex::insertUnique(transaction::Methods* trx, TRI_voc_rid_t revisionId, 
                             VPackSlice const& doc, bool isRollback) {
   std::vector<MMFilesHashIndexElement*> elements;
@@ -96,13 +96,39 @@ class MMFilesHashIndexIterator final : public IndexIterator {
 
   bool next(TokenCallback const& cb, size_t limit) override;
 
+  bool nextTokens(std::vector<DocumentIdentifierToken>& tokens,
+                  size_t limit) override;
+
+  /// @brief the hash index can produce the indexed values of each element
+  bool hasExtra() const override { return true; }
+
+  /// @brief like next, but also passes an array with the indexed values
+  /// of each element to the callback
+  bool nextExtra(ExtraCallback const& cb, size_t limit) override;
+
   void reset() override;
 
+ private:
+  /// @brief build the next batch of lookup values and prefetch the index
+  /// slots they will probe. returns false if there are no more values
+  bool nextBatch(bool first);
+
+  /// @brief look up the next value of the batch into _buffer. returns
+  /// false if there are no more values
+  bool lookupNext();
+
  private:
   MMFilesHashIndex const* _index;
   MMFilesHashIndexLookupBuilder _lookups;
+  /// @brief whether or not all values of _lookups are in batches
+  bool _lookupsDone;
+  /// @brief the lookup values of the current batch, and the next one
+  arangodb::velocypack::Builder _batch;
+  std::vector<arangodb::velocypack::Slice> _batchValues;
+  size_t _posInBatch;
   std::vector<MMFilesHashIndexElement*> _buffer;
   size_t _posInBuffer;
+  arangodb::velocypack::Builder _extra;
 };
 
 class MMFilesHashIndexIteratorVPack final : public IndexIterator {
@@ -199,6 +225,9 @@ class MMFilesHashIndex final : public MMFilesPathBasedIndex {
   int lookup(transaction::Methods*, arangodb::velocypack::Slice,
              std::vector<MMFilesHashIndexElement*>&) const;
 
+  /// @brief prefetches the slot a lookup of the velocypack slice starts at
+  void prefetch(IndexLookupContext*, arangodb::velocypack::Slice) const;
+
   int insertUnique(transaction::Methods*, TRI_voc_rid_t,
                    arangodb::velocypack::Slice const&, bool isRollback);
 
@@ -261,6 +290,10 @@ class MMFilesHashIndex final : public MMFilesPathBasedIndex {
         return true;
       }
 
+      if (left->hash() != right->hash()) {
+        return false;
+      }
+
       IndexLookupContext* context = static_cast<IndexLookupContext*>(userData);
 
       for (size_t i = 0; i < _numFields; ++i) {
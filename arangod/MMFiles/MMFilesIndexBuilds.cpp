@@ -0,0 +1,107 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2017 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "MMFilesIndexBuilds.h"
+#include "Basics/MutexLocker.h"
+
+using namespace arangodb;
+
+/// @brief take the captured operations if there are more than threshold
+bool MMFilesIndexBuilds::Build::takeChanges(Changes& changes,
+                                            size_t threshold) {
+  MUTEX_LOCKER(mutexLocker, _lock);
+  if (_changes.size() <= threshold) {
+    return false;
+  }
+  changes.clear();
+  changes.swap(_changes);
+  return true;
+}
+
+/// @brief start capturing operations for an index build
+std::shared_ptr<MMFilesIndexBuilds::Build> MMFilesIndexBuilds::add(
+    transaction::Methods const* trx) {
+  auto build = std::make_shared<Build>(trx);
+  {
+    MUTEX_LOCKER(mutexLocker, _documentsLock);
+    _transactions.emplace(trx);
+  }
+  _builds.emplace_back(build);
+  _hasBuilds = true;
+  return build;
+}
+
+/// @brief stop capturing operations for a build
+void MMFilesIndexBuilds::remove(std::shared_ptr<Build> const& build) {
+  for (auto it = _builds.begin(); it != _builds.end(); ++it) {
+    if ((*it) == build) {
+      _builds.erase(it);
+      break;
+    }
+  }
+
+  MUTEX_LOCKER(mutexLocker, _documentsLock);
+  _transactions.erase(build->_trx);
+
+  if (_builds.empty()) {
+    // no index refers to removed documents anymore
+    _hasBuilds = false;
+    _documents.clear();
+  }
+}
+
+/// @brief record a document operation for all builds
+void MMFilesIndexBuilds::capture(TRI_voc_rid_t revisionId,
+                                 velocypack::Slice const& doc,
+                                 bool isInsert) {
+  if (!isInsert) {
+    // the indexes need the document to remove it, but it may be gone
+    // before the operation is applied to them
+    auto copy = std::make_unique<velocypack::Buffer<uint8_t>>();
+    copy->append(doc.startAs<uint8_t>(), doc.byteSize());
+
+    MUTEX_LOCKER(mutexLocker, _documentsLock);
+    _documents.emplace(revisionId, std::move(copy));
+  }
+
+  for (auto& build : _builds) {
+    MUTEX_LOCKER(mutexLocker, build->_lock);
+    build->_changes.emplace_back(revisionId, isInsert);
+  }
+}
+
+/// @brief the copy of a document removed during the builds
+uint8_t const* MMFilesIndexBuilds::lookupRemoved(
+    transaction::Methods const* trx, TRI_voc_rid_t revisionId) const {
+  MUTEX_LOCKER(mutexLocker, _documentsLock);
+
+  if (_transactions.find(trx) == _transactions.end()) {
+    return nullptr;
+  }
+
+  auto it = _documents.find(revisionId);
+
+  if (it == _documents.end()) {
+    return nullptr;
+  }
+  return (*it).second->data();
+}
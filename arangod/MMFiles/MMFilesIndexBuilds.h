@@ -0,0 +1,119 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2017 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_MMFILES_MMFILES_INDEX_BUILDS_H
+#define ARANGOD_MMFILES_MMFILES_INDEX_BUILDS_H 1
+
+#include "Basics/Common.h"
+#include "Basics/Mutex.h"
+#include "VocBase/voc-types.h"
+
+#include <velocypack/Buffer.h>
+#include <velocypack/Slice.h>
+
+namespace arangodb {
+namespace transaction {
+class Methods;
+}
+
+/// @brief the indexes of a collection that are built in the background, and
+/// the document operations they have to catch up with. operations are
+/// captured and builds are added and removed under the collection's write
+/// lock. the builds take their captured operations without that lock
+class MMFilesIndexBuilds {
+ public:
+  /// @brief revision ids of the operations, and whether they were inserts
+  typedef std::vector<std::pair<TRI_voc_rid_t, bool>> Changes;
+
+  /// @brief an index that is built in the background, with the document
+  /// operations that happened since its snapshot was taken
+  class Build {
+    friend class MMFilesIndexBuilds;
+
+   public:
+    explicit Build(transaction::Methods const* trx) : _trx(trx) {}
+
+    /// @brief take the captured operations if there are more than
+    /// threshold. returns whether they were taken
+    bool takeChanges(Changes& changes, size_t threshold);
+
+   private:
+    /// @brief the transaction that fills the index
+    transaction::Methods const* _trx;
+
+    /// @brief protects _changes
+    Mutex _lock;
+
+    Changes _changes;
+  };
+
+ public:
+  MMFilesIndexBuilds() : _hasBuilds(false) {}
+
+  MMFilesIndexBuilds(MMFilesIndexBuilds const&) = delete;
+  MMFilesIndexBuilds& operator=(MMFilesIndexBuilds const&) = delete;
+
+  /// @brief whether indexes are built in the background. does not need the
+  /// collection's write lock
+  bool empty() const { return !_hasBuilds.load(); }
+
+  /// @brief start capturing operations for an index that the transaction
+  /// builds. must be called under the collection's write lock
+  std::shared_ptr<Build> add(transaction::Methods const* trx);
+
+  /// @brief stop capturing operations for a build. the copies of removed
+  /// documents are freed with the last build. must be called under the
+  /// collection's write lock
+  void remove(std::shared_ptr<Build> const& build);
+
+  /// @brief record a document operation for all builds. removed documents
+  /// are copied, because the indexes need them to remove them again. must
+  /// be called under the collection's write lock
+  void capture(TRI_voc_rid_t revisionId, velocypack::Slice const& doc,
+               bool isInsert);
+
+  /// @brief the copy of a document removed during the builds. returns a
+  /// nullptr for transactions that do not build an index
+  uint8_t const* lookupRemoved(transaction::Methods const* trx,
+                               TRI_voc_rid_t revisionId) const;
+
+ private:
+  std::vector<std::shared_ptr<Build>> _builds;
+
+  /// @brief whether _builds is non-empty, for lock-free checks
+  std::atomic<bool> _hasBuilds;
+
+  /// @brief protects _transactions and _documents
+  mutable Mutex _documentsLock;
+
+  /// @brief the transactions of the builds
+  std::unordered_set<transaction::Methods const*> _transactions;
+
+  /// @brief copies of the documents removed during the builds
+  std::unordered_map<TRI_voc_rid_t,
+                     std::unique_ptr<velocypack::Buffer<uint8_t>>>
+      _documents;
+};
+
+}
+
+#endif
@@ -328,6 +328,13 @@ int MMFilesIndexFactory::enhanceIndexDefinition(VPackSlice const definition,
         break;
     }
 
+    if (create && basics::VelocyPackHelper::getBooleanValue(
+                      definition, "inBackground", false)) {
+      // fill the index without blocking writes to the collection. this is
+      // not part of the index definition
+      enhanced.add("inBackground", VPackValue(true));
+    }
+
   } catch (...) {
     // TODO Check for different type of Errors
     return TRI_ERROR_OUT_OF_MEMORY;
@@ -40,6 +40,7 @@
 #include "RestServer/DatabaseFeature.h"
 #include "RestServer/DatabasePathFeature.h"
 #include "RestServer/TransactionManagerFeature.h"
+#include "Statistics/MetricsRegistry.h"
 #include "StorageEngine/EngineSelectorFeature.h"
 #include "MMFiles/MMFilesAllocatorThread.h"
 #include "MMFiles/MMFilesCollectorThread.h"
@@ -155,6 +156,11 @@ void MMFilesLogfileManager::collectOptions(std::shared_ptr<ProgramOptions> optio
       "mlock WAL logfiles in memory (may require elevated privileges or limits)",
       new BooleanParameter(&_useMLock));
 
+  options->addOption(
+      "--wal.drop-page-cache",
+      "evict the pages of logfiles from the page cache once they are collected",
+      new BooleanParameter(&_dropPageCache));
+
   options->addOption("--wal.directory", "logfile directory",
                      new StringParameter(&_directory));
 
@@ -188,6 +194,10 @@ void MMFilesLogfileManager::collectOptions(std::shared_ptr<ProgramOptions> optio
                      "maximum number of reserve logfiles to maintain",
                      new UInt32Parameter(&_reserveLogfiles));
 
+  options->addOption("--wal.recycled-logfiles",
+                     "maximum number of removed logfiles to keep for reuse",
+                     new UInt32Parameter(&_recycledLogfiles));
+
   options->addHiddenOption("--wal.slots", "number of logfile slots to use",
                            new UInt32Parameter(&_numberOfSlots));
 
@@ -196,6 +206,25 @@ void MMFilesLogfileManager::collectOptions(std::shared_ptr<ProgramOptions> optio
       "interval for automatic, non-requested disk syncs (in milliseconds)",
       new UInt64Parameter(&_syncInterval));
 
+  options->addOption(
+      "--wal.collector-threads",
+      "number of collections whose WAL markers are transferred into their "
+      "datafiles in parallel by the collector",
+      new UInt32Parameter(&_collectorThreads));
+
+  options->addOption(
+      "--wal.recovery-threads",
+      "number of threads used for opening collections and filling their "
+      "indexes during WAL recovery",
+      new UInt32Parameter(&_recoveryThreads));
+
+  options->addOption(
+      "--wal.group-commit-window",
+      "maximum time (in microseconds) to wait for more waitForSync "
+      "operations to be synced together. the actual wait time adapts to "
+      "the observed sync latency (0 = turn off group commits)",
+      new UInt64Parameter(&_groupCommitWindow));
+
   options->addHiddenOption(
       "--wal.throttle-when-pending",
       "throttle writes when at least this many operations are waiting for "
@@ -232,6 +261,18 @@ void MMFilesLogfileManager::validateOptions(std::shared_ptr<options::ProgramOpti
     FATAL_ERROR_EXIT();
   }
 
+  if (_collectorThreads == 0) {
+    LOG_TOPIC(FATAL, arangodb::Logger::FIXME) << "invalid value for --wal.collector-threads. Please use a value "
+                  "of at least 1";
+    FATAL_ERROR_EXIT();
+  }
+
+  if (_recoveryThreads == 0) {
+    LOG_TOPIC(FATAL, arangodb::Logger::FIXME) << "invalid value for --wal.recovery-threads. Please use a value "
+                  "of at least 1";
+    FATAL_ERROR_EXIT();
+  }
+
   if (_syncInterval < MinSyncInterval()) {
     LOG_TOPIC(FATAL, arangodb::Logger::FIXME) << "invalid value for --wal.sync-interval. Please use a value "
                   "of at least "
@@ -396,7 +437,7 @@ bool MMFilesLogfileManager::open() {
   _recoverState->removeEmptyLogfiles();
 
   // now fill secondary indexes of all collections used in the recovery
-  _recoverState->fillIndexes();
+  _recoverState->fillIndexes(_recoveryThreads);
 
   // remove usage locks for databases and collections
   _recoverState->releaseResources();
@@ -439,8 +480,62 @@ bool MMFilesLogfileManager::open() {
     return false;
   }
 
+  registerMetrics();
+
   return true;
 }
+
+/// @brief expose the WAL figures via the metrics registry
+void MMFilesLogfileManager::registerMetrics() {
+  MetricsRegistry::addGauge(
+      "arangodb_mmfiles_wal_last_assigned_tick",
+      "Last tick assigned to a WAL marker",
+      [this]() { return static_cast<double>(state().lastAssignedTick); });
+  MetricsRegistry::addGauge(
+      "arangodb_mmfiles_wal_last_committed_tick",
+      "Last tick of a WAL marker that was committed",
+      [this]() { return static_cast<double>(state().lastCommittedTick); });
+  MetricsRegistry::addCounter(
+      "arangodb_mmfiles_wal_events_total", "Number of WAL markers written",
+      [this]() { return static_cast<double>(state().numEvents); });
+  MetricsRegistry::addCounter(
+      "arangodb_mmfiles_wal_sync_events_total",
+      "Number of WAL markers written with waitForSync",
+      [this]() { return static_cast<double>(state().numEventsSync); });
+  MetricsRegistry::addCounter(
+      "arangodb_mmfiles_wal_group_commits_total",
+      "Number of WAL syncs that served waiting writers",
+      [this]() { return static_cast<double>(state().numGroupCommits); });
+  MetricsRegistry::addGauge("arangodb_mmfiles_wal_sync_latency_seconds",
+                            "Recent duration of a WAL sync",
+                            [this]() { return state().syncLatency; });
+  MetricsRegistry::addGauge(
+      "arangodb_mmfiles_wal_running_transactions",
+      "Number of running transactions",
+      [this]() { return static_cast<double>(std::get<0>(runningTransactions())); });
+  MetricsRegistry::addGauge(
+      "arangodb_mmfiles_collector_queue_length",
+      "Number of operations queued for the WAL collector", [this]() {
+        MMFilesCollectorThread* collector = _collectorThread;
+        if (collector == nullptr) {
+          return 0.0;
+        }
+        return static_cast<double>(collector->numQueuedOperations());
+      });
+  MetricsRegistry::addHistogram(
+      "arangodb_mmfiles_wal_logfile_allocation_seconds",
+      "Time taken to allocate a reserve WAL logfile", [this]() {
+        MUTEX_LOCKER(mutexLocker, _recycledFilesLock);
+        return _allocationTime;
+      });
+  MetricsRegistry::addCounter(
+      "arangodb_mmfiles_wal_logfiles_recycled_total",
+      "Number of reserve WAL logfiles that reused the file of a removed one",
+      [this]() {
+        MUTEX_LOCKER(mutexLocker, _recycledFilesLock);
+        return static_cast<double>(_numRecycledAllocations);
+      });
+}
     
 void MMFilesLogfileManager::stop() { 
   // deactivate write-throttling (again) on shutdown in case it was set again
@@ -453,6 +548,17 @@ void MMFilesLogfileManager::beginShutdown() {
 }
 
 void MMFilesLogfileManager::unprepare() {
+  MetricsRegistry::remove("arangodb_mmfiles_wal_last_assigned_tick");
+  MetricsRegistry::remove("arangodb_mmfiles_wal_last_committed_tick");
+  MetricsRegistry::remove("arangodb_mmfiles_wal_events_total");
+  MetricsRegistry::remove("arangodb_mmfiles_wal_sync_events_total");
+  MetricsRegistry::remove("arangodb_mmfiles_wal_group_commits_total");
+  MetricsRegistry::remove("arangodb_mmfiles_wal_sync_latency_seconds");
+  MetricsRegistry::remove("arangodb_mmfiles_wal_running_transactions");
+  MetricsRegistry::remove("arangodb_mmfiles_collector_queue_length");
+  MetricsRegistry::remove("arangodb_mmfiles_wal_logfile_allocation_seconds");
+  MetricsRegistry::remove("arangodb_mmfiles_wal_logfiles_recycled_total");
+
   // deactivate write-throttling (again) on shutdown in case it was set again
   // after beginShutdown
   throttleWhenPending(0); 
@@ -886,6 +992,15 @@ bool MMFilesLogfileManager::waitForSync(double maxWait) {
   }
 }
 
+// wait until the last committed tick is greater than the given tick,
+// or until maxWait seconds have passed. returns the last committed tick
+TRI_voc_tick_t MMFilesLogfileManager::waitForCommittedTick(TRI_voc_tick_t tick,
+                                                           double maxWait) {
+  TRI_ASSERT(!_inRecovery);
+
+  return _slots->waitForCommittedTick(tick, maxWait);
+}
+
 // re-inserts a logfile back into the inventory only
 void MMFilesLogfileManager::relinkLogfile(MMFilesWalLogfile* logfile) {
   MMFilesWalLogfile::IdType const id = logfile->id();
@@ -1496,6 +1611,12 @@ void MMFilesLogfileManager::setCollectionDone(MMFilesWalLogfile* logfile) {
     }
   }
 
+  if (_dropPageCache) {
+    // the logfile was synced before it was collected. its data is now in
+    // the datafiles and only read again by replication clients
+    logfile->df()->dropPageCache();
+  }
+
   {
     MUTEX_LOCKER(mutexLocker, _idLock);
     _lastCollectedId = id;
@@ -1525,6 +1646,17 @@ MMFilesLogfileManagerState MMFilesLogfileManager::state() {
   // now fill the state
   _slots->statistics(state.lastAssignedTick, state.lastCommittedTick,
                      state.lastCommittedDataTick, state.numEvents, state.numEventsSync);
+
+  if (_synchronizerThread != nullptr) {
+    _synchronizerThread->groupCommitStatistics(
+        state.numGroupCommits, state.numGroupCommitWaiters,
+        state.maxGroupCommitSize, state.syncLatency);
+  } else {
+    state.numGroupCommits = 0;
+    state.numGroupCommitWaiters = 0;
+    state.maxGroupCommitSize = 0;
+    state.syncLatency = 0.0;
+  }
   state.timeString = utilities::timeString();
 
   return state;
@@ -1592,9 +1724,15 @@ void MMFilesLogfileManager::removeLogfile(MMFilesWalLogfile* logfile) {
 
   LOG_TOPIC(TRACE, arangodb::Logger::FIXME) << "removing logfile '" << filename << "'";
 
+  TRI_voc_size_t const size = logfile->df()->initSize();
+
   // now close the logfile
   delete logfile;
 
+  if (recycleLogfile(filename, size)) {
+    return;
+  }
+
   int res = TRI_ERROR_NO_ERROR;
   // now physically remove the file
 
@@ -1704,6 +1842,9 @@ int MMFilesLogfileManager::runRecovery() {
   // this is because all other threads competing for the lock are
   // not active yet
   {
+    // open all collections up front, so their datafiles are read in parallel
+    _recoverState->loadCollections(_recoveryThreads);
+
     int res = _recoverState->replayLogfiles();
 
     if (res != TRI_ERROR_NO_ERROR) {
@@ -1855,7 +1996,8 @@ int MMFilesLogfileManager::writeShutdownInfo(bool writeShutdownTime) {
 
 // start the synchronizer thread
 int MMFilesLogfileManager::startMMFilesSynchronizerThread() {
-  _synchronizerThread = new MMFilesSynchronizerThread(this, _syncInterval);
+  _synchronizerThread =
+      new MMFilesSynchronizerThread(this, _syncInterval, _groupCommitWindow);
 
   if (!_synchronizerThread->start()) {
     delete _synchronizerThread;
@@ -2001,6 +2143,17 @@ int MMFilesLogfileManager::inventory() {
         WRITE_LOCKER(writeLocker, _logfilesLock);
         _logfiles.emplace(id, nullptr);
       }
+    } else if (StringUtils::isPrefix(file, "recycled-") &&
+               StringUtils::isSuffix(file, ".db")) {
+      // the file of a removed logfile. its contents are irrelevant, so it
+      // can be reused as long as it has the current default size
+      std::string const filename = _directory + file;
+
+      if (!recycleLogfile(filename, static_cast<TRI_voc_size_t>(
+                                        TRI_SizeFile(filename.c_str())))) {
+        LOG_TOPIC(TRACE, arangodb::Logger::FIXME) << "removing recycled logfile '" << filename << "'";
+        TRI_UnlinkFile(filename.c_str());
+      }
     }
   }
 
@@ -2135,7 +2288,30 @@ int MMFilesLogfileManager::createReserveLogfile(uint32_t size) {
     realsize = filesize();
   }
 
-  std::unique_ptr<MMFilesWalLogfile> logfile(MMFilesWalLogfile::createNew(filename, id, realsize));
+  double const start = TRI_microtime();
+
+  // files of removed logfiles all have the default size
+  std::string const recycleFrom =
+      (realsize == filesize()) ? popRecycledLogfile() : std::string();
+
+  std::unique_ptr<MMFilesWalLogfile> logfile(MMFilesWalLogfile::createNew(filename, id, realsize, recycleFrom));
+
+  bool recycled = false;
+  if (!recycleFrom.empty()) {
+    // the recycled file is only left over if it could not be reused
+    recycled = !basics::FileUtils::exists(recycleFrom);
+    if (!recycled) {
+      TRI_UnlinkFile(recycleFrom.c_str());
+    }
+  }
+
+  {
+    MUTEX_LOCKER(mutexLocker, _recycledFilesLock);
+    _allocationTime.addFigure(TRI_microtime() - start);
+    if (logfile != nullptr && recycled) {
+      ++_numRecycledAllocations;
+    }
+  }
 
   if (logfile == nullptr) {
     int res = TRI_errno();
@@ -2204,3 +2380,61 @@ std::string MMFilesLogfileManager::logfileName(MMFilesWalLogfile::IdType id) con
   return _directory + std::string("logfile-") + basics::StringUtils::itoa(id) +
          std::string(".db");
 }
+
+// return an absolute filename for a recycled logfile
+std::string MMFilesLogfileManager::recycledLogfileName(MMFilesWalLogfile::IdType id) const {
+  return _directory + std::string("recycled-") + basics::StringUtils::itoa(id) +
+         std::string(".db");
+}
+
+// put the file of a removed logfile into the pool of recycled files.
+/// the file is renamed right away, so it can never be mistaken for a logfile
+/// during recovery, even though it still contains the old markers. they are
+/// zeroed when the file is reused
+bool MMFilesLogfileManager::recycleLogfile(std::string const& filename,
+                                           TRI_voc_size_t size) {
+  size_t const pageSize = PageSizeFeature::getPageSize();
+
+  if (size != ((filesize() + pageSize - 1) / pageSize) * pageSize) {
+    // only files with the current default size can be reused
+    return false;
+  }
+
+  MUTEX_LOCKER(mutexLocker, _recycledFilesLock);
+
+  if (_recycledFiles.size() >= _recycledLogfiles) {
+    return false;
+  }
+
+  std::string recycled = filename;
+
+  if (!StringUtils::isPrefix(filename, _directory + "recycled-")) {
+    recycled = recycledLogfileName(nextId());
+
+    int res = TRI_RenameFile(filename.c_str(), recycled.c_str());
+
+    if (res != TRI_ERROR_NO_ERROR) {
+      LOG_TOPIC(WARN, arangodb::Logger::FIXME) << "unable to recycle logfile '" << filename
+                << "': " << TRI_errno_string(res);
+      return false;
+    }
+  }
+
+  LOG_TOPIC(TRACE, arangodb::Logger::FIXME) << "keeping file '" << recycled << "' for reuse";
+
+  _recycledFiles.emplace_back(std::move(recycled));
+  return true;
+}
+
+// take a file from the pool of recycled files
+std::string MMFilesLogfileManager::popRecycledLogfile() {
+  MUTEX_LOCKER(mutexLocker, _recycledFilesLock);
+
+  if (_recycledFiles.empty()) {
+    return std::string();
+  }
+
+  std::string filename = std::move(_recycledFiles.back());
+  _recycledFiles.pop_back();
+  return filename;
+}
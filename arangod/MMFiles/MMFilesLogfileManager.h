@@ -30,6 +30,7 @@
 #include "Basics/ReadWriteLock.h"
 #include "MMFiles/MMFilesWalLogfile.h"
 #include "MMFiles/MMFilesWalSlots.h"
+#include "Statistics/figures.h"
 #include "VocBase/TransactionManager.h"
 #include "VocBase/voc-types.h"
 
@@ -78,6 +79,10 @@ struct MMFilesLogfileManagerState {
   TRI_voc_tick_t lastCommittedDataTick;
   uint64_t numEvents;
   uint64_t numEventsSync;
+  uint64_t numGroupCommits;
+  uint64_t numGroupCommitWaiters;
+  uint64_t maxGroupCommitSize;
+  double syncLatency;
   std::string timeString;
 };
 
@@ -150,6 +155,12 @@ class MMFilesLogfileManager final : public application_features::ApplicationFeat
   // set the sync interval
   inline void syncInterval(uint64_t value) { _syncInterval = value * 1000; }
 
+  // get the maximum group commit window (in microseconds)
+  inline uint64_t groupCommitWindow() const { return _groupCommitWindow; }
+
+  // get the number of collections the collector transfers in parallel
+  inline uint32_t collectorThreads() const { return _collectorThreads; }
+
   // get the number of reserve logfiles
   inline uint32_t reserveLogfiles() const { return _reserveLogfiles; }
 
@@ -266,6 +277,10 @@ class MMFilesLogfileManager final : public application_features::ApplicationFeat
   /// wait until all changes to the current logfile are synced
   bool waitForSync(double);
 
+  /// wait until the last committed tick is greater than the given tick,
+  /// or until maxWait seconds have passed. returns the last committed tick
+  TRI_voc_tick_t waitForCommittedTick(TRI_voc_tick_t, double maxWait);
+
   // re-inserts a logfile back into the inventory only
   void relinkLogfile(MMFilesWalLogfile*);
 
@@ -409,6 +424,9 @@ class MMFilesLogfileManager final : public application_features::ApplicationFeat
   // stop the synchronizer thread
   void stopMMFilesSynchronizerThread();
 
+  // expose the WAL figures via the metrics registry
+  void registerMetrics();
+
   // start the allocator thread
   int startMMFilesAllocatorThread();
 
@@ -450,6 +468,17 @@ class MMFilesLogfileManager final : public application_features::ApplicationFeat
   // return an absolute filename for a logfile id
   std::string logfileName(MMFilesWalLogfile::IdType) const;
 
+  // return an absolute filename for a recycled logfile
+  std::string recycledLogfileName(MMFilesWalLogfile::IdType) const;
+
+  // put the file of a removed logfile into the pool of recycled files.
+  /// returns false if the pool is full or the file has a non-default size
+  bool recycleLogfile(std::string const&, TRI_voc_size_t);
+
+  // take a file from the pool of recycled files. returns an empty string
+  /// if the pool is empty
+  std::string popRecycledLogfile();
+
  private:
   // the arangod config variable containing the database path
   std::string _databasePath;
@@ -459,6 +488,7 @@ class MMFilesLogfileManager final : public application_features::ApplicationFeat
 
   bool _allowOversizeEntries = true;
   bool _useMLock = false;
+  bool _dropPageCache = false;
   std::string _directory;
   uint32_t _historicLogfiles = 10; 
   bool _ignoreLogfileErrors = false;
@@ -467,8 +497,12 @@ class MMFilesLogfileManager final : public application_features::ApplicationFeat
   uint32_t _filesize = 32 * 1024 * 1024;
   uint32_t _maxOpenLogfiles = 0;
   uint32_t _reserveLogfiles = 3;
+  uint32_t _recycledLogfiles = 3;
   uint32_t _numberOfSlots = 1048576;
   uint64_t _syncInterval = 100;
+  uint64_t _groupCommitWindow = 0;
+  uint32_t _collectorThreads = 1;
+  uint32_t _recoveryThreads = 1;
   uint64_t _throttleWhenPending = 0;
   uint64_t _maxThrottleWait = 15000;
 
@@ -543,6 +577,20 @@ class MMFilesLogfileManager final : public application_features::ApplicationFeat
 
   // barriers that prevent WAL logfiles from being collected
   std::unordered_map<TRI_voc_tick_t, LogfileBarrier*> _barriers;
+
+  // a lock protecting _recycledFiles, _allocationTime and
+  /// _numRecycledAllocations
+  Mutex _recycledFilesLock;
+
+  // files of removed logfiles, kept for reuse by the allocator
+  std::vector<std::string> _recycledFiles;
+
+  // time taken to allocate reserve logfiles
+  basics::StatisticsDistribution _allocationTime{
+      basics::StatisticsVector() << 0.001 << 0.01 << 0.1 << 0.5 << 1.0 << 5.0};
+
+  // number of reserve logfiles that reused a recycled file
+  uint64_t _numRecycledAllocations = 0;
 };
 
 }
@@ -26,12 +26,15 @@
 #include "Aql/Condition.h"
 #include "Aql/ExecutionNode.h"
 #include "Aql/ExecutionPlan.h"
+#include "Aql/Expression.h"
 #include "Aql/Function.h"
 #include "Aql/IndexNode.h"
 #include "Aql/Optimizer.h"
 #include "Aql/OptimizerRule.h"
 #include "Aql/OptimizerRulesFeature.h"
+#include "Aql/Query.h"
 #include "Aql/SortNode.h"
+#include "Basics/VelocyPackHelper.h"
 #include "Cluster/ServerState.h"
 #include "Indexes/Index.h"
 #include "VocBase/LogicalCollection.h"
@@ -366,23 +369,24 @@ MMFilesGeoIndexInfo identifyGeoOptimizationCandidate(ExecutionNode::NodeType typ
 //modify plan
 
 // builds a condition that can be used with the index interface and
-// contains all parameters required by the MMFilesGeoIndex 
-std::unique_ptr<Condition> buildGeoCondition(ExecutionPlan* plan, MMFilesGeoIndexInfo& info) {
-  AstNode* lat = info.constantPair.first;
-  AstNode* lon = info.constantPair.second;
+// contains all parameters required by the MMFilesGeoIndex. range is
+// nullptr for a NEAR lookup
+std::unique_ptr<Condition> createGeoCondition(ExecutionPlan* plan, Variable const* variable,
+                                              AstNode const* lat, AstNode const* lon,
+                                              AstNode const* range, bool inclusive) {
   auto ast = plan->getAst();
-  auto varAstNode = ast->createNodeReference(info.collectionNode->outVariable());
+  auto varAstNode = ast->createNodeReference(variable);
 
-  auto args = ast->createNodeArray(info.within ? 4 : 3);
+  auto args = ast->createNodeArray(range != nullptr ? 5 : 3);
   args->addMember(varAstNode); // collection
   args->addMember(lat); // latitude
   args->addMember(lon); // longitude
   
   AstNode* cond = nullptr;
-  if (info.within) {
+  if (range != nullptr) {
     // WITHIN
-    args->addMember(info.range);
-    auto lessValue =  ast->createNodeValueBool(info.lessgreaterequal);
+    args->addMember(range);
+    auto lessValue =  ast->createNodeValueBool(inclusive);
     args->addMember(lessValue);
     cond = ast->createNodeFunctionCall("WITHIN", args);
   } else {
@@ -398,6 +402,13 @@ std::unique_ptr<Condition> buildGeoCondition(ExecutionPlan* plan, MMFilesGeoInde
   return condition;
 }
 
+std::unique_ptr<Condition> buildGeoCondition(ExecutionPlan* plan, MMFilesGeoIndexInfo& info) {
+  return createGeoCondition(plan, info.collectionNode->outVariable(),
+                            info.constantPair.first, info.constantPair.second,
+                            info.within ? info.range : nullptr,
+                            info.lessgreaterequal);
+}
+
 void replaceGeoCondition(ExecutionPlan* plan, MMFilesGeoIndexInfo& info){
   if (info.expressionParent && info.executionNodeType == EN::FILTER) {
     auto ast = plan->getAst();
@@ -518,6 +529,235 @@ bool applyGeoOptimization(bool near, ExecutionPlan* plan, MMFilesGeoIndexInfo& f
   return true;
 }
 
+// builds an access to the attribute path of an index field, starting
+// at the document in variable
+AstNode* createFieldAccess(ExecutionPlan* plan, Variable const* variable,
+                           std::vector<arangodb::basics::AttributeName> const& field) {
+  auto ast = plan->getAst();
+  AstNode* node = ast->createNodeReference(variable);
+
+  for (auto const& part : field) {
+    char* name = ast->query()->registerString(part.name);
+    node = ast->createNodeAttributeAccess(node, name, part.name.size());
+  }
+  return node;
+}
+
+// builds DISTANCE(doc.latitude, doc.longitude, lat, lon) for the
+// attributes the geo index is built on, so that documents produced by the
+// index can be ordered by their distance. returns nullptr if the
+// attributes cannot be accessed from AQL
+AstNode* createDistanceFunction(ExecutionPlan* plan, Variable const* variable,
+                                arangodb::Index const* index,
+                                AstNode const* lat, AstNode const* lon) {
+  auto ast = plan->getAst();
+  auto const& fields = index->fields();
+  AstNode* docLat = nullptr;
+  AstNode* docLon = nullptr;
+
+  for (auto const& field : fields) {
+    for (auto const& part : field) {
+      if (part.shouldExpand) {
+        return nullptr;
+      }
+    }
+  }
+
+  if (fields.size() == 2) {
+    // individual latitude and longitude attributes
+    docLat = createFieldAccess(plan, variable, fields[0]);
+    docLon = createFieldAccess(plan, variable, fields[1]);
+  } else if (fields.size() == 1) {
+    // [latitude, longitude] or, for GeoJSON, [longitude, latitude]
+    VPackBuilder definition;
+    definition.openObject();
+    index->toVelocyPack(definition, false);
+    definition.close();
+    bool const geoJson = arangodb::basics::VelocyPackHelper::getBooleanValue(
+        definition.slice(), "geoJson", false);
+
+    auto location = createFieldAccess(plan, variable, fields[0]);
+    docLat = ast->createNodeIndexedAccess(location, ast->createNodeValueInt(geoJson ? 1 : 0));
+    docLon = ast->createNodeIndexedAccess(location, ast->createNodeValueInt(geoJson ? 0 : 1));
+  } else {
+    return nullptr;
+  }
+
+  auto args = ast->createNodeArray(4);
+  args->addMember(docLat);
+  args->addMember(docLon);
+  args->addMember(lat);
+  args->addMember(lon);
+  return ast->createNodeFunctionCall("DISTANCE", args);
+}
+
+// replaces FOR doc IN NEAR(coll, lat, lon, limit) and
+// FOR doc IN WITHIN(coll, lat, lon, radius) with an IndexNode on the
+// geo index, followed by a LIMIT for NEAR. the function calls build the
+// complete result array in one go, and on a coordinator they fetch the
+// nearest candidates of all shards and merge them. the IndexNode instead
+// streams the documents in distance order, so in the cluster every shard
+// only produces the documents the (pushed down) LIMIT lets through, and
+// the coordinator merges the shards' results by distance
+bool applyGeoFunctionOptimization(ExecutionPlan* plan, EnumerateListNode* listNode) {
+  if (listNode->isInInnerLoop()) {
+    // SORT and LIMIT would work on the results of all outer iterations
+    return false;
+  }
+
+  auto inVariable = listNode->inVariable();
+  auto setter = plan->getVarSetBy(inVariable->id);
+
+  if (setter == nullptr || setter->getType() != EN::CALCULATION) {
+    return false;
+  }
+
+  auto expression = static_cast<CalculationNode*>(setter)->expression();
+
+  if (expression == nullptr || expression->node() == nullptr) {
+    return false;
+  }
+
+  AstNode const* fcall = expression->node();
+
+  if (fcall->type != NODE_TYPE_FCALL) {
+    return false;
+  }
+
+  auto func = static_cast<Function const*>(fcall->getData());
+  bool const within = (func->externalName == "WITHIN");
+
+  if (!within && func->externalName != "NEAR") {
+    return false;
+  }
+
+  AstNode const* args = fcall->getMember(0);
+  size_t const n = args->numMembers();
+
+  if (n < (within ? 4 : 3)) {
+    return false;
+  }
+
+  if (n > 4 && !args->getMember(4)->isNullValue()) {
+    // distance attribute requested. the documents would need to be merged
+    // with their distance
+    return false;
+  }
+
+  AstNode const* collectionArg = args->getMember(0);
+  AstNode const* lat = args->getMember(1);
+  AstNode const* lon = args->getMember(2);
+
+  if ((collectionArg->type != NODE_TYPE_COLLECTION && !collectionArg->isStringValue()) ||
+      !lat->isNumericValue() || !lon->isNumericValue()) {
+    return false;
+  }
+
+  AstNode const* range = nullptr;
+  int64_t limit = 100; // default limit of NEAR
+
+  if (within) {
+    range = args->getMember(3);
+    if (!range->isNumericValue()) {
+      return false;
+    }
+  } else if (n > 3 && !args->getMember(3)->isNullValue()) {
+    if (!args->getMember(3)->isNumericValue()) {
+      return false;
+    }
+    limit = args->getMember(3)->getIntValue();
+    if (limit <= 0) {
+      return false;
+    }
+  }
+
+  auto ast = plan->getAst();
+  auto collection = ast->query()->collections()->get(collectionArg->getString());
+
+  if (collection == nullptr) {
+    return false;
+  }
+
+  // the function calls use the first geo index of the collection
+  std::shared_ptr<arangodb::Index> index;
+  for (auto const& idx : collection->getCollection()->getIndexes()) {
+    if (idx->type() == arangodb::Index::IndexType::TRI_IDX_TYPE_GEO1_INDEX ||
+        idx->type() == arangodb::Index::IndexType::TRI_IDX_TYPE_GEO2_INDEX) {
+      index = idx;
+      break;
+    }
+  }
+
+  if (index == nullptr) {
+    // leave it to the function to report the missing index
+    return false;
+  }
+
+  auto outVariable = listNode->outVariable();
+  bool const isCoordinator = arangodb::ServerState::instance()->isCoordinator();
+  AstNode* distance = nullptr;
+
+  if (isCoordinator) {
+    distance = createDistanceFunction(plan, outVariable, index.get(), lat, lon);
+    if (distance == nullptr) {
+      return false;
+    }
+  }
+
+  std::unique_ptr<Condition> condition(
+      createGeoCondition(plan, outVariable, lat, lon, range, true));
+
+  auto inode = new IndexNode(
+          plan, plan->nextId(), ast->query()->vocbase(), collection, outVariable,
+          std::vector<transaction::Methods::IndexHandle>{transaction::Methods::IndexHandle{index}},
+          condition.get(), false);
+  plan->registerNode(inode);
+  condition.release();
+
+  auto parent = listNode->getFirstParent();
+  TRI_ASSERT(parent != nullptr);
+  plan->replaceNode(listNode, inode);
+
+  if (isCoordinator) {
+    // every shard produces its documents in distance order. the SORT is
+    // not reinserted on the DB servers, but makes the GatherNode merge the
+    // shards' results by distance
+    auto distanceVariable = ast->variables()->createTemporaryVariable();
+    auto expr = new Expression(ast, distance);
+    CalculationNode* calculationNode = nullptr;
+    try {
+      calculationNode = new CalculationNode(plan, plan->nextId(), expr, distanceVariable);
+    } catch (...) {
+      delete expr;
+      throw;
+    }
+    plan->registerNode(calculationNode);
+    plan->insertDependency(parent, calculationNode);
+
+    SortElementVector elements;
+    elements.emplace_back(distanceVariable, true);
+    auto sortNode = new SortNode(plan, plan->nextId(), elements, false);
+    sortNode->_reinsertInCluster = false;
+    plan->registerNode(sortNode);
+    plan->insertDependency(parent, sortNode);
+  }
+
+  if (!within) {
+    auto limitNode = new LimitNode(plan, plan->nextId(), 0, static_cast<size_t>(limit));
+    plan->registerNode(limitNode);
+    plan->insertDependency(parent, limitNode);
+  }
+
+  // the function call is not needed anymore if nothing else uses its result
+  plan->clearVarUsageComputed();
+  plan->findVarUsage();
+  if (!setter->isVarUsedLater(inVariable)) {
+    plan->unlinkNode(setter);
+  }
+
+  return true;
+}
+
 void MMFilesOptimizerRules::geoIndexRule(Optimizer* opt,
                                          std::unique_ptr<ExecutionPlan> plan,
                                          OptimizerRule const* rule) {
@@ -525,6 +765,16 @@ void MMFilesOptimizerRules::geoIndexRule(Optimizer* opt,
   SmallVector<ExecutionNode*>::allocator_type::arena_type a;
   SmallVector<ExecutionNode*> nodes{a};
   bool modified = false;
+
+  // FOR ... IN NEAR(...) / WITHIN(...)
+  plan->findNodesOfType(nodes, EN::ENUMERATE_LIST, true);
+  for (auto& node : nodes) {
+    if (applyGeoFunctionOptimization(plan.get(), static_cast<EnumerateListNode*>(node))) {
+      modified = true;
+    }
+  }
+
+  nodes.clear();
   //inspect each return node and work upwards to SingletonNode
   plan->findEndNodes(nodes, true);
   
@@ -26,8 +26,14 @@
 #include "Aql/SortCondition.h"
 #include "Basics/AttributeNameParser.h"
 #include "Basics/FixedSizeAllocator.h"
+#include "Basics/MutexLocker.h"
 #include "Basics/StaticStrings.h"
 #include "Basics/VelocyPackHelper.h"
+#include "Cache/Cache.h"
+#include "Cache/CacheManagerFeature.h"
+#include "Cache/CachedValue.h"
+#include "Cache/Finding.h"
+#include "Cache/Manager.h"
 #include "Indexes/IndexLookupContext.h"
 #include "MMFiles/MMFilesCollection.h"
 #include "MMFiles/MMFilesIndexElement.h"
@@ -40,14 +46,25 @@
 #include "Transaction/Methods.h"
 #include "VocBase/LogicalCollection.h"
 
+#include <cmath>
+
 #include <rocksdb/utilities/optimistic_transaction_db.h>
-#include <rocksdb/utilities/transaction.h>
+#include <rocksdb/utilities/write_batch_with_index.h>
 
 #include <velocypack/Iterator.h>
 #include <velocypack/velocypack-aliases.h>
 
 using namespace arangodb;
 
+namespace {
+/// @brief maximum number of document keys stored in the cache for one
+/// lookup. lookups producing more documents are not cached
+static constexpr size_t MaxCachedKeys = 1000;
+
+/// @brief maximum number of attempts to blacklist a value in the cache
+static constexpr size_t MaxBlacklistTries = 10;
+}
+
 static size_t sortWeight(arangodb::aql::AstNode const* node) {
   switch (node->type) {
     case arangodb::aql::NODE_TYPE_OPERATOR_BINARY_EQ:
@@ -94,12 +111,32 @@ MMFilesPersistentIndexIterator::MMFilesPersistentIndexIterator(LogicalCollection
                                  rocksdb::OptimisticTransactionDB* db,
                                  bool reverse, 
                                  VPackSlice const& left,
-                                 VPackSlice const& right)
+                                 VPackSlice const& right,
+                                 cache::Cache* cache,
+                                 VPackSlice const& cacheKey)
     : IndexIterator(collection, trx, mmdr, index),
       _primaryIndex(primaryIndex),
       _db(db),
       _reverse(reverse),
-      _probe(false) {
+      _probe(false),
+      _cache(cache),
+      _position(0),
+      _fromCache(false),
+      _collecting(false),
+      _numCollected(0) {
+  if (_cache != nullptr) {
+    TRI_ASSERT(cacheKey.isArray());
+    _cacheKey.assign(cacheKey.startAs<char const>(), cacheKey.byteSize());
+
+    cache::Finding finding = _cache->find(
+        _cacheKey.data(), static_cast<uint32_t>(_cacheKey.size()));
+    if (finding.found()) {
+      _keys.add(VPackSlice(finding.value()->value()));
+      _fromCache = true;
+      // no need to scan the index at all
+      return;
+    }
+  }
   
   TRI_idx_iid_t const id = index->id();
   std::string const prefix = MMFilesPersistentIndex::buildPrefix(
@@ -130,6 +167,20 @@ MMFilesPersistentIndexIterator::MMFilesPersistentIndexIterator(LogicalCollection
 
 /// @brief Reset the cursor
 void MMFilesPersistentIndexIterator::reset() {
+  if (_fromCache) {
+    _position = 0;
+    return;
+  }
+
+  // only complete forward scans are stored in the cache, so that the
+  // keys are in index order
+  _collecting = (_cache != nullptr && !_reverse);
+  if (_collecting) {
+    _keys.clear();
+    _keys.openArray();
+    _numCollected = 0;
+  }
+
   if (_reverse) {
     _probe = true;
     _cursor->Seek(rocksdb::Slice(_rightEndpoint->data(), _rightEndpoint->size()));
@@ -142,10 +193,15 @@ void MMFilesPersistentIndexIterator::reset() {
 }
 
 bool MMFilesPersistentIndexIterator::next(TokenCallback const& cb, size_t limit) {
+  if (_fromCache) {
+    return nextCached(cb, limit);
+  }
+
   auto comparator = MMFilesPersistentIndexFeature::instance()->comparator();
   while (limit > 0) {
     if (!_cursor->Valid()) {
       // We are exhausted already, sorry
+      storeInCache();
       return false;
     }
   
@@ -158,6 +214,7 @@ bool MMFilesPersistentIndexIterator::next(TokenCallback const& cb, size_t limit)
     if (res < 0) {
       if (_reverse) {
         // We are done
+        storeInCache();
         return false;
       } else {
         _cursor->Next();
@@ -179,6 +236,16 @@ bool MMFilesPersistentIndexIterator::next(TokenCallback const& cb, size_t limit)
       // LOG_TOPIC(TRACE, arangodb::Logger::FIXME) << "looking up document with key: " << keySlice.toJson();
       // LOG_TOPIC(TRACE, arangodb::Logger::FIXME) << "looking up document with primary key: " << keySlice[n - 1].toJson();
 
+      if (_collecting) {
+        if (_numCollected < MaxCachedKeys) {
+          _keys.add(keySlice[n - 1]);
+          ++_numCollected;
+        } else {
+          // too many documents to be cached
+          _collecting = false;
+        }
+      }
+
       // use primary index to lookup the document
       MMFilesSimpleIndexElement element = _primaryIndex->lookupKey(_trx, keySlice[n - 1]);
       if (element) {
@@ -198,6 +265,7 @@ bool MMFilesPersistentIndexIterator::next(TokenCallback const& cb, size_t limit)
 
     if (res > 0) {
       if (!_probe) {
+        storeInCache();
         return false;
       }
       _probe = false;
@@ -206,15 +274,155 @@ bool MMFilesPersistentIndexIterator::next(TokenCallback const& cb, size_t limit)
   return true;
 }
 
+/// @brief produce the documents of the keys taken from the cache
+bool MMFilesPersistentIndexIterator::nextCached(TokenCallback const& cb,
+                                                size_t limit) {
+  VPackSlice keys = _keys.slice();
+  TRI_ASSERT(keys.isArray());
+  size_t const n = static_cast<size_t>(keys.length());
+
+  while (limit > 0) {
+    if (_position >= n) {
+      return false;
+    }
+
+    size_t const i = _reverse ? n - 1 - _position : _position;
+    ++_position;
+
+    MMFilesSimpleIndexElement element = _primaryIndex->lookupKey(_trx, keys.at(i));
+    if (element) {
+      MMFilesToken doc = MMFilesToken{element.revisionId()};
+      if (doc != 0) {
+        cb(doc);
+        --limit;
+      }
+    }
+  }
+  return (_position < n);
+}
+
+/// @brief store the keys found by a complete scan in the cache
+void MMFilesPersistentIndexIterator::storeInCache() {
+  if (!_collecting) {
+    return;
+  }
+  _collecting = false;
+
+  TRI_ASSERT(_cache != nullptr);
+  _keys.close();
+  VPackSlice keys = _keys.slice();
+
+  cache::CachedValue* value = cache::CachedValue::construct(
+      _cacheKey.data(), static_cast<uint32_t>(_cacheKey.size()),
+      keys.start(), keys.byteSize());
+
+  if (value != nullptr && !_cache->insert(value)) {
+    // not stored, e.g. because the values are blacklisted
+    delete value;
+  }
+}
+
 /// @brief create the index
 MMFilesPersistentIndex::MMFilesPersistentIndex(TRI_idx_iid_t iid,
                            arangodb::LogicalCollection* collection,
                            arangodb::velocypack::Slice const& info)
     : MMFilesPathBasedIndex(iid, collection, info, 0, true),
-      _db(MMFilesPersistentIndexFeature::instance()->db()) {}
+      _db(MMFilesPersistentIndexFeature::instance()->db()),
+      _hasCache(false) {}
 
 /// @brief destroy the index
-MMFilesPersistentIndex::~MMFilesPersistentIndex() {}
+MMFilesPersistentIndex::~MMFilesPersistentIndex() {
+  if (_cache != nullptr && CacheManagerFeature::MANAGER != nullptr) {
+    CacheManagerFeature::MANAGER->destroyCache(_cache);
+  }
+}
+
+/// @brief return the transactional cache for point lookups, creating it
+/// on first use. returns a nullptr if there is no cache manager
+cache::Cache* MMFilesPersistentIndex::cache() const {
+  if (_hasCache.load(std::memory_order_acquire)) {
+    return _cache.get();
+  }
+
+  MUTEX_LOCKER(mutexLocker, _cacheLock);
+  if (!_hasCache.load(std::memory_order_relaxed)) {
+    // the index may be opened before the cache manager is started
+    cache::Manager* manager = CacheManagerFeature::MANAGER;
+    if (manager == nullptr) {
+      return nullptr;
+    }
+    _cache = manager->createCache(cache::CacheType::Transactional);
+    if (_cache == nullptr) {
+      // creation may fail under memory pressure. try again next time
+      return nullptr;
+    }
+    _hasCache.store(true, std::memory_order_release);
+  }
+  return _cache.get();
+}
+
+/// @brief add a value to a cache key. numbers with an integral value that
+/// doubles represent exactly are stored as integers, so that equal values
+/// have equal keys. all other numbers keep their type, as the index only
+/// compares them exactly with numbers of the same type. returns false for
+/// values that are not cached, i.e. arrays and objects
+bool MMFilesPersistentIndex::addCacheKeyValue(VPackBuilder& key,
+                                              VPackSlice value) {
+  if (value.isNumber()) {
+    // 2^53, the largest integer up to which all integers are doubles
+    static double const MaxExact = 9007199254740992.0;
+
+    double const v = value.getNumber<double>();
+    if (v >= -MaxExact && v <= MaxExact && v == std::trunc(v)) {
+      // this also maps -0.0 to 0
+      key.add(VPackValue(static_cast<int64_t>(v)));
+    } else {
+      key.add(value);
+    }
+    return true;
+  }
+  if (value.isNull() || value.isBoolean() || value.isString()) {
+    key.add(value);
+    return true;
+  }
+  return false;
+}
+
+/// @brief blacklist the values of a document in the cache before the
+/// index entries for them are written
+void MMFilesPersistentIndex::blacklistInCache(
+    transaction::Methods* trx,
+    std::vector<MMFilesSkiplistIndexElement*> const& elements,
+    IndexLookupContext* context) {
+  cache::Cache* cache = this->cache();
+  if (cache == nullptr) {
+    return;
+  }
+
+  static_cast<MMFilesTransactionState*>(trx->state())->useCacheTransaction();
+
+  VPackBuilder key;
+  for (auto const& it : elements) {
+    key.clear();
+    key.openArray();
+    bool cacheable = true;
+    for (size_t i = 0; i < _fields.size() && cacheable; ++i) {
+      cacheable = addCacheKeyValue(key, it->slice(context, i));
+    }
+    if (!cacheable) {
+      // lookups for these values are not cached
+      continue;
+    }
+    key.close();
+
+    VPackSlice k = key.slice();
+    for (size_t tries = 0; tries < MaxBlacklistTries; ++tries) {
+      if (cache->blacklist(k.start(), static_cast<uint32_t>(k.byteSize()))) {
+        break;
+      }
+    }
+  }
+}
 
 size_t MMFilesPersistentIndex::memory() const {
   return 0; // TODO
@@ -266,6 +474,8 @@ int MMFilesPersistentIndex::insert(transaction::Methods* trx, TRI_voc_rid_t revi
   std::string const prefix =
       buildPrefix(trx->vocbase()->id(), _collection->cid(), _iid);
 
+  blacklistInCache(trx, elements, &context);
+
   VPackBuilder builder;
   std::vector<std::string> values;
   values.reserve(elements.size());
@@ -328,8 +538,8 @@ int MMFilesPersistentIndex::insert(transaction::Methods* trx, TRI_voc_rid_t revi
     }
   }
 
-  auto rocksTransaction = static_cast<MMFilesTransactionState*>(trx->state())->rocksTransaction();
-  TRI_ASSERT(rocksTransaction != nullptr);
+  auto rocksBatch = static_cast<MMFilesTransactionState*>(trx->state())->rocksBatch();
+  TRI_ASSERT(rocksBatch != nullptr);
 
   rocksdb::ReadOptions readOptions;
 
@@ -337,7 +547,9 @@ int MMFilesPersistentIndex::insert(transaction::Methods* trx, TRI_voc_rid_t revi
   for (size_t i = 0; i < count; ++i) {
     if (_unique) {
       bool uniqueConstraintViolated = false;
-      auto iterator = rocksTransaction->GetIterator(readOptions);
+      // sees the committed entries plus the ones of this transaction
+      auto iterator = rocksBatch->NewIteratorWithBase(
+          MMFilesPersistentIndexFeature::instance()->db()->GetBaseDB()->NewIterator(readOptions));
 
       if (iterator != nullptr) {
         auto& bound = bounds[i];
@@ -370,16 +582,12 @@ int MMFilesPersistentIndex::insert(transaction::Methods* trx, TRI_voc_rid_t revi
     }
 
     if (res == TRI_ERROR_NO_ERROR) {
-      auto status = rocksTransaction->Put(values[i], std::string());
-      
-      if (! status.ok()) {
-        res = TRI_ERROR_INTERNAL;
-      }
+      rocksBatch->Put(values[i], rocksdb::Slice());
     }
 
     if (res != TRI_ERROR_NO_ERROR) {
       for (size_t j = 0; j < i; ++j) {
-        rocksTransaction->Delete(values[i]);
+        rocksBatch->Delete(values[j]);
       }
     
       if (res == TRI_ERROR_ARANGO_UNIQUE_CONSTRAINT_VIOLATED && !_unique) {
@@ -421,6 +629,8 @@ int MMFilesPersistentIndex::remove(transaction::Methods* trx, TRI_voc_rid_t revi
   ManagedDocumentResult result; 
   IndexLookupContext context(trx, _collection, &result, numPaths()); 
   VPackSlice const key = transaction::helpers::extractKeyFromDocument(doc);
+
+  blacklistInCache(trx, elements, &context);
   
   VPackBuilder builder;
   std::vector<std::string> values;
@@ -441,20 +651,12 @@ int MMFilesPersistentIndex::remove(transaction::Methods* trx, TRI_voc_rid_t revi
     values.emplace_back(std::move(value));
   }
   
-  auto rocksTransaction = static_cast<MMFilesTransactionState*>(trx->state())->rocksTransaction();
-  TRI_ASSERT(rocksTransaction != nullptr);
+  auto rocksBatch = static_cast<MMFilesTransactionState*>(trx->state())->rocksBatch();
+  TRI_ASSERT(rocksBatch != nullptr);
 
-  size_t const count = elements.size();
-
-  for (size_t i = 0; i < count; ++i) {
-    // LOG_TOPIC(TRACE, arangodb::Logger::FIXME) << "removing key: " << VPackSlice(values[i].c_str() + keyPrefixSize()).toJson();
-    auto status = rocksTransaction->Delete(values[i]);
-
-    // we may be looping through this multiple times, and if an error
-    // occurs, we want to keep it
-    if (! status.ok()) {
-      res = TRI_ERROR_INTERNAL;
-    }
+  for (auto const& value : values) {
+    // LOG_TOPIC(TRACE, arangodb::Logger::FIXME) << "removing key: " << VPackSlice(value.c_str() + keyPrefixSize()).toJson();
+    rocksBatch->Delete(value);
   }
 
   return res;
@@ -484,16 +686,34 @@ MMFilesPersistentIndexIterator* MMFilesPersistentIndex::lookup(transaction::Meth
   VPackBuilder leftSearch;
   VPackBuilder rightSearch;
 
+  // the normalized values of a point lookup, used as cache key
+  VPackBuilder cacheKey;
+  bool cacheable = (searchValues.length() == _fields.size());
+
   VPackSlice lastNonEq;
   leftSearch.openArray();
+  cacheKey.openArray();
   for (auto const& it : VPackArrayIterator(searchValues)) {
     TRI_ASSERT(it.isObject());
     VPackSlice eq = it.get(StaticStrings::IndexEq);
     if (eq.isNone()) {
       lastNonEq = it;
+      cacheable = false;
       break;
     }
     leftSearch.add(eq);
+    if (cacheable) {
+      cacheable = addCacheKeyValue(cacheKey, eq);
+    }
+  }
+  cacheKey.close();
+
+  cache::Cache* cache = nullptr;
+  if (cacheable) {
+    cache = this->cache();
+    if (cache != nullptr) {
+      static_cast<MMFilesTransactionState*>(trx->state())->useCacheTransaction();
+    }
   }
 
   VPackSlice leftBorder;
@@ -573,7 +793,7 @@ MMFilesPersistentIndexIterator* MMFilesPersistentIndex::lookup(transaction::Meth
   // Same for the iterator
   auto physical = static_cast<MMFilesCollection*>(_collection->getPhysical());
   auto idx = physical->primaryIndex();
-  return new MMFilesPersistentIndexIterator(_collection, trx, mmdr, this, idx, _db, reverse, leftBorder, rightBorder);
+  return new MMFilesPersistentIndexIterator(_collection, trx, mmdr, this, idx, _db, reverse, leftBorder, rightBorder, cache, cacheKey.slice());
 }
 
 bool MMFilesPersistentIndex::accessFitsIndex(
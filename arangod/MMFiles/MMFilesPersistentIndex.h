@@ -26,6 +26,7 @@
 
 #include "Basics/Common.h"
 #include "Aql/AstNode.h"
+#include "Basics/Mutex.h"
 #include "Indexes/IndexIterator.h"
 #include "MMFiles/MMFilesPersistentIndexFeature.h"
 #include "MMFiles/MMFilesPathBasedIndex.h"
@@ -36,20 +37,28 @@
 #include <rocksdb/utilities/optimistic_transaction_db.h>
 
 #include <velocypack/Buffer.h>
+#include <velocypack/Builder.h>
 #include <velocypack/Slice.h>
 
+#include <atomic>
+
 namespace rocksdb {
 class OptimisticTransactionDB;
 }
 
 namespace arangodb {
+namespace cache {
+class Cache;
+}
 namespace aql {
 class SortCondition;
 struct Variable;
 }
 
+class IndexLookupContext;
 class LogicalCollection;
 class MMFilesPrimaryIndex;
+struct MMFilesSkiplistIndexElement;
 class MMFilesPersistentIndex;
 namespace transaction {
 class Methods;
@@ -68,7 +77,9 @@ class MMFilesPersistentIndexIterator final : public IndexIterator {
                   rocksdb::OptimisticTransactionDB* db,
                   bool reverse, 
                   arangodb::velocypack::Slice const& left,
-                  arangodb::velocypack::Slice const& right);
+                  arangodb::velocypack::Slice const& right,
+                  cache::Cache* cache,
+                  arangodb::velocypack::Slice const& cacheKey);
 
   ~MMFilesPersistentIndexIterator() = default;
 
@@ -82,6 +93,13 @@ class MMFilesPersistentIndexIterator final : public IndexIterator {
   /// @brief Reset the cursor
   void reset() override;
  
+ private:
+  /// @brief produce the documents of the keys taken from the cache
+  bool nextCached(TokenCallback const& cb, size_t limit);
+
+  /// @brief store the keys found by a complete scan in the cache
+  void storeInCache();
+
  private:
   arangodb::MMFilesPrimaryIndex* _primaryIndex;
   rocksdb::OptimisticTransactionDB* _db;
@@ -90,6 +108,21 @@ class MMFilesPersistentIndexIterator final : public IndexIterator {
   std::unique_ptr<arangodb::velocypack::Buffer<char>> _rightEndpoint;  // Interval right border
   bool const _reverse;
   bool _probe;
+
+  /// @brief the cache of the index, or a nullptr if the lookup is not cached
+  cache::Cache* _cache;
+  /// @brief the cache key, i.e. the normalized values looked up
+  std::string _cacheKey;
+  /// @brief the keys of the documents, taken from the cache or collected
+  /// while scanning the index
+  arangodb::velocypack::Builder _keys;
+  /// @brief position in _keys when producing the keys taken from the cache
+  size_t _position;
+  bool _fromCache;
+  /// @brief whether or not keys are collected for the cache while scanning
+  bool _collecting;
+  /// @brief number of keys collected, as _keys is still open while scanning
+  size_t _numCollected;
 };
 
 class MMFilesPersistentIndex final : public MMFilesPathBasedIndex {
@@ -187,6 +220,23 @@ class MMFilesPersistentIndex final : public MMFilesPathBasedIndex {
       arangodb::aql::AstNode*, arangodb::aql::Variable const*) const override;
 
  private:
+  /// @brief return the transactional cache for point lookups, creating it
+  /// on first use. returns a nullptr if there is no cache manager
+  cache::Cache* cache() const;
+
+  /// @brief add a value to a cache key. numbers with an integral value that
+  /// doubles represent exactly are stored as integers, so that equal values
+  /// have equal keys. returns false for values that are not cached, i.e.
+  /// arrays and objects
+  static bool addCacheKeyValue(arangodb::velocypack::Builder&,
+                               arangodb::velocypack::Slice);
+
+  /// @brief blacklist the values of a document in the cache before the
+  /// index entries for them are written
+  void blacklistInCache(transaction::Methods*,
+                        std::vector<MMFilesSkiplistIndexElement*> const&,
+                        IndexLookupContext*);
+
   bool isDuplicateOperator(arangodb::aql::AstNode const*,
                            std::unordered_set<int> const&) const;
 
@@ -209,6 +259,16 @@ class MMFilesPersistentIndex final : public MMFilesPathBasedIndex {
   /// @brief the RocksDB instance
   rocksdb::OptimisticTransactionDB* _db;
 
+  /// @brief lock protecting the creation of the cache
+  mutable Mutex _cacheLock;
+
+  /// @brief whether or not the cache has been created
+  mutable std::atomic<bool> _hasCache;
+
+  /// @brief cache for the keys of the documents found by point lookups,
+  /// i.e. lookups with equality conditions for all index attributes
+  mutable std::shared_ptr<cache::Cache> _cache;
+
 };
 }
 
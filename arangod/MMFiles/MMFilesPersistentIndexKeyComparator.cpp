@@ -30,6 +30,9 @@
 #include <rocksdb/db.h>
 #include <rocksdb/comparator.h>
 
+#include <velocypack/Iterator.h>
+#include <velocypack/velocypack-aliases.h>
+
 using namespace arangodb;
 
 int MMFilesPersistentIndexKeyComparator::Compare(rocksdb::Slice const& lhs, rocksdb::Slice const& rhs) const {
@@ -43,27 +46,42 @@ int MMFilesPersistentIndexKeyComparator::Compare(rocksdb::Slice const& lhs, rock
     return res;
   }
   
+  // byte-wise identical keys are equal. this is the case for every
+  // successful equality lookup, so we can save decoding the keys
+  if (lhs.size() == rhs.size() &&
+      memcmp(lhs.data() + MMFilesPersistentIndex::keyPrefixSize(),
+             rhs.data() + MMFilesPersistentIndex::keyPrefixSize(),
+             lhs.size() - MMFilesPersistentIndex::keyPrefixSize()) == 0) {
+    return 0;
+  }
+  
   VPackSlice const lSlice = extractKeySlice(lhs);
   TRI_ASSERT(lSlice.isArray());
   VPackSlice const rSlice = extractKeySlice(rhs);
   TRI_ASSERT(rSlice.isArray());
 
-  size_t const lLength = lSlice.length();
-  size_t const rLength = rSlice.length();
-  size_t const n = lLength < rLength ? lLength : rLength;
+  // iterate over both arrays at once. this avoids the index lookups for
+  // every member of the compact arrays the keys are built as
+  VPackArrayIterator lIt(lSlice);
+  VPackArrayIterator rIt(rSlice);
 
-  for (size_t i = 0; i < n; ++i) {
-    int res = arangodb::basics::VelocyPackHelper::compare(
-      (i < lLength ? lSlice[i] : VPackSlice::noneSlice()), 
-      (i < rLength ? rSlice[i] : VPackSlice::noneSlice()), 
-      true
-    );
+  while (lIt.valid() && rIt.valid()) {
+    VPackSlice const l = lIt.value();
+    VPackSlice const r = rIt.value();
+    
+    int res = compareValues(l, r);
 
     if (res != 0) {
       return res;
     }
+
+    lIt.next();
+    rIt.next();
   }
 
+  size_t const lLength = lIt.size();
+  size_t const rLength = rIt.size();
+
   if (lLength != rLength) {
     return lLength < rLength ? -1 : 1;
   }
@@ -71,3 +89,31 @@ int MMFilesPersistentIndexKeyComparator::Compare(rocksdb::Slice const& lhs, rock
   return 0;
 }
 
+/// @brief compare two members of index keys. values with the same encoding
+/// and integers of the same type are handled without calling the generic
+/// comparison, which would first determine the type weights of both values
+int MMFilesPersistentIndexKeyComparator::compareValues(VPackSlice const& lhs,
+                                                       VPackSlice const& rhs) {
+  VPackValueLength const lSize = lhs.byteSize();
+
+  if (lSize == rhs.byteSize() && memcmp(lhs.start(), rhs.start(), lSize) == 0) {
+    // same encoding means same value
+    return 0;
+  }
+
+  VPackValueType const type = lhs.type();
+
+  if (type == rhs.type() &&
+      (type == VPackValueType::SmallInt || type == VPackValueType::Int)) {
+    // same as the generic comparison, which compares integers of the same
+    // type exactly
+    int64_t const l = lhs.getInt();
+    int64_t const r = rhs.getInt();
+    if (l != r) {
+      return l < r ? -1 : 1;
+    }
+    return 0;
+  }
+
+  return arangodb::basics::VelocyPackHelper::compare(lhs, rhs, true);
+}
@@ -50,6 +50,10 @@ class MMFilesPersistentIndexKeyComparator final : public rocksdb::Comparator {
   void FindShortestSeparator(std::string*, 
                              rocksdb::Slice const&) const {}
   void FindShortSuccessor(std::string*) const {}
+
+ private:
+  static int compareValues(arangodb::velocypack::Slice const& lhs,
+                           arangodb::velocypack::Slice const& rhs);
 };
 
 }
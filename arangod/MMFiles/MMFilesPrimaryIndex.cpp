@@ -64,6 +64,12 @@ static inline uint64_t HashElement(void*, MMFilesSimpleIndexElement const& eleme
 static bool IsEqualKeyElement(void* userData, uint8_t const* key,
                               uint64_t hash,
                               MMFilesSimpleIndexElement const& right) {
+  if (right.hash() != hash) {
+    // the element stores the hash of its key, so there is no need to
+    // look up the document if the hashes differ
+    return false;
+  }
+
   IndexLookupContext* context = static_cast<IndexLookupContext*>(userData);
   TRI_ASSERT(context != nullptr);
   
@@ -79,6 +85,10 @@ static bool IsEqualKeyElement(void* userData, uint8_t const* key,
 /// @brief determines if two elements are equal
 static bool IsEqualElementElement(void* userData, MMFilesSimpleIndexElement const& left,
                                   MMFilesSimpleIndexElement const& right) {
+  if (left.hash() != right.hash()) {
+    return false;
+  }
+
   IndexLookupContext* context = static_cast<IndexLookupContext*>(userData);
   TRI_ASSERT(context != nullptr);
   
@@ -126,6 +136,19 @@ bool MMFilesPrimaryIndexIterator::next(TokenCallback const& cb, size_t limit) {
   return _iterator.valid();
 }
 
+bool MMFilesPrimaryIndexIterator::nextTokens(
+    std::vector<DocumentIdentifierToken>& tokens, size_t limit) {
+  while (_iterator.valid() && limit > 0) {
+    MMFilesSimpleIndexElement result = _index->lookupKey(_trx, _iterator.value());
+    _iterator.next();
+    if (result) {
+      tokens.emplace_back(MMFilesToken{result.revisionId()});
+      --limit;
+    }
+  }
+  return _iterator.valid();
+}
+
 void MMFilesPrimaryIndexIterator::reset() { _iterator.reset(); }
   
 MMFilesAllIndexIterator::MMFilesAllIndexIterator(LogicalCollection* collection,
@@ -154,8 +177,65 @@ bool MMFilesAllIndexIterator::next(TokenCallback const& cb, size_t limit) {
   return true;
 }
 
+bool MMFilesAllIndexIterator::nextTokens(
+    std::vector<DocumentIdentifierToken>& tokens, size_t limit) {
+  while (limit > 0) {
+    MMFilesSimpleIndexElement element;
+    if (_reverse) {
+      element = _index->findSequentialReverse(&_context, _position);
+    } else {
+      element = _index->findSequential(&_context, _position, _total);
+    }
+    if (!element) {
+      return false;
+    }
+    tokens.emplace_back(MMFilesToken{element.revisionId()});
+    --limit;
+  }
+  return true;
+}
+
 void MMFilesAllIndexIterator::reset() { _position.reset(); }
   
+MMFilesBucketIndexIterator::MMFilesBucketIndexIterator(
+    LogicalCollection* collection, transaction::Methods* trx,
+    ManagedDocumentResult* mmdr, MMFilesPrimaryIndex const* index,
+    MMFilesPrimaryIndexImpl const* indexImpl, size_t bucketId)
+    : IndexIterator(collection, trx, mmdr, index),
+      _index(indexImpl),
+      _bucketId(bucketId),
+      _position(0) {}
+
+bool MMFilesBucketIndexIterator::next(TokenCallback const& cb, size_t limit) {
+  while (limit > 0) {
+    MMFilesSimpleIndexElement element =
+        _index->findSequentialInBucket(&_context, _bucketId, _position);
+    if (element) {
+      cb(MMFilesToken{element.revisionId()});
+      --limit;
+    } else {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool MMFilesBucketIndexIterator::nextTokens(
+    std::vector<DocumentIdentifierToken>& tokens, size_t limit) {
+  while (limit > 0) {
+    MMFilesSimpleIndexElement element =
+        _index->findSequentialInBucket(&_context, _bucketId, _position);
+    if (!element) {
+      return false;
+    }
+    tokens.emplace_back(MMFilesToken{element.revisionId()});
+    --limit;
+  }
+  return true;
+}
+
+void MMFilesBucketIndexIterator::reset() { _position = 0; }
+
 MMFilesAnyIndexIterator::MMFilesAnyIndexIterator(LogicalCollection* collection, transaction::Methods* trx, 
                                    ManagedDocumentResult* mmdr,
                                    MMFilesPrimaryIndex const* index,
@@ -316,6 +396,21 @@ IndexIterator* MMFilesPrimaryIndex::allIterator(transaction::Methods* trx,
   return new MMFilesAllIndexIterator(_collection, trx, mmdr, this, _primaryIndex, reverse);
 }
 
+/// @brief number of buckets the index consists of
+size_t MMFilesPrimaryIndex::numBuckets() const {
+  return _primaryIndex->buckets();
+}
+
+/// @brief request an iterator over all elements of a single bucket of
+///        the index in a sequential order.
+IndexIterator* MMFilesPrimaryIndex::bucketIterator(transaction::Methods* trx,
+                                                   ManagedDocumentResult* mmdr,
+                                                   size_t bucketId) const {
+  TRI_ASSERT(bucketId < numBuckets());
+  return new MMFilesBucketIndexIterator(_collection, trx, mmdr, this,
+                                        _primaryIndex, bucketId);
+}
+
 /// @brief request an iterator over all elements in the index in
 ///        a random order. It is guaranteed that each element is found
 ///        exactly once unless the collection is modified.
@@ -60,6 +60,9 @@ class MMFilesPrimaryIndexIterator final : public IndexIterator {
 
   bool next(TokenCallback const& cb, size_t limit) override;
 
+  bool nextTokens(std::vector<DocumentIdentifierToken>& tokens,
+                  size_t limit) override;
+
   void reset() override;
 
  private:
@@ -83,6 +86,9 @@ class MMFilesAllIndexIterator final : public IndexIterator {
 
   bool next(TokenCallback const& cb, size_t limit) override;
 
+  bool nextTokens(std::vector<DocumentIdentifierToken>& tokens,
+                  size_t limit) override;
+
   void reset() override;
 
  private:
@@ -92,6 +98,33 @@ class MMFilesAllIndexIterator final : public IndexIterator {
   uint64_t _total;
 };
 
+/// @brief iterator over all elements of a single bucket of the primary index
+class MMFilesBucketIndexIterator final : public IndexIterator {
+ public:
+  MMFilesBucketIndexIterator(LogicalCollection* collection,
+                             transaction::Methods* trx,
+                             ManagedDocumentResult* mmdr,
+                             MMFilesPrimaryIndex const* index,
+                             MMFilesPrimaryIndexImpl const* indexImpl,
+                             size_t bucketId);
+
+  ~MMFilesBucketIndexIterator() {}
+
+  char const* typeName() const override { return "bucket-index-iterator"; }
+
+  bool next(TokenCallback const& cb, size_t limit) override;
+
+  bool nextTokens(std::vector<DocumentIdentifierToken>& tokens,
+                  size_t limit) override;
+
+  void reset() override;
+
+ private:
+  MMFilesPrimaryIndexImpl const* _index;
+  size_t const _bucketId;
+  uint64_t _position;
+};
+
 class MMFilesAnyIndexIterator final : public IndexIterator {
  public:
   MMFilesAnyIndexIterator(LogicalCollection* collection, transaction::Methods* trx, 
@@ -176,6 +209,15 @@ class MMFilesPrimaryIndex final : public Index {
   ///        exactly once unless the collection is modified.
   IndexIterator* anyIterator(transaction::Methods*, ManagedDocumentResult*) const;
 
+  /// @brief number of buckets the index consists of. each bucket can be
+  ///        scanned independently via bucketIterator
+  size_t numBuckets() const;
+
+  /// @brief request an iterator over all elements of a single bucket of
+  ///        the index in a sequential order.
+  IndexIterator* bucketIterator(transaction::Methods*, ManagedDocumentResult*,
+                                size_t bucketId) const;
+
   /// @brief a method to iterate over all elements in the index in
   ///        reversed sequential order.
   ///        Returns nullptr if all documents have been returned.
@@ -0,0 +1,149 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2017 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "MMFilesPrimaryIndexSnapshot.h"
+#include "Basics/VelocyPackHelper.h"
+
+#include <velocypack/Iterator.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+using Helper = arangodb::basics::VelocyPackHelper;
+
+// version 1 did not contain the collection's maximum tick
+uint64_t const MMFilesPrimaryIndexSnapshot::Version = 2;
+
+/// @brief number of documents in the snapshot
+uint64_t MMFilesPrimaryIndexSnapshot::numberOfDocuments() const {
+  uint64_t count = 0;
+  for (auto const& it : documents) {
+    count += it.offsets.size();
+  }
+  return count;
+}
+
+/// @brief serialize the snapshot
+void MMFilesPrimaryIndexSnapshot::toVelocyPack(VPackBuilder& builder) const {
+  builder.openObject();
+  builder.add("version", VPackValue(Version));
+  builder.add("lastRevision", VPackValue(lastRevision));
+  builder.add("maxTick", VPackValue(maxTick));
+
+  builder.add("datafiles", VPackValue(VPackValueType::Array));
+  for (auto const& it : datafiles) {
+    builder.openArray();
+    builder.add(VPackValue(it.fid));
+    builder.add(VPackValue(it.size));
+    builder.add(VPackValue(it.tickMin));
+    builder.add(VPackValue(it.tickMax));
+    builder.add(VPackValue(it.dataMin));
+    builder.add(VPackValue(it.dataMax));
+    builder.add(VPackValue(it.numberAlive));
+    builder.add(VPackValue(it.numberDead));
+    builder.add(VPackValue(it.numberDeletions));
+    builder.add(VPackValue(it.sizeAlive));
+    builder.add(VPackValue(it.sizeDead));
+    builder.close();
+  }
+  builder.close();  // datafiles
+
+  builder.add("documents", VPackValue(VPackValueType::Array));
+  for (auto const& it : documents) {
+    builder.openArray();
+    builder.add(VPackValue(it.fid));
+    builder.openArray();
+    for (auto const& offset : it.offsets) {
+      builder.add(VPackValue(offset));
+    }
+    builder.close();
+    builder.close();
+  }
+  builder.close();  // documents
+
+  builder.close();
+}
+
+/// @brief read a snapshot. returns false if the slice is not a valid
+/// snapshot of the current version
+bool MMFilesPrimaryIndexSnapshot::fromVelocyPack(VPackSlice const& slice) {
+  datafiles.clear();
+  documents.clear();
+
+  if (!slice.isObject() ||
+      Helper::getNumericValue<uint64_t>(slice, "version", 0) != Version) {
+    return false;
+  }
+
+  VPackSlice const files = slice.get("datafiles");
+  VPackSlice const docs = slice.get("documents");
+
+  if (!files.isArray() || !docs.isArray()) {
+    return false;
+  }
+
+  lastRevision = Helper::getNumericValue<TRI_voc_rid_t>(slice, "lastRevision", 0);
+  maxTick = Helper::getNumericValue<TRI_voc_tick_t>(slice, "maxTick", 0);
+
+  for (auto const& it : VPackArrayIterator(files)) {
+    if (!it.isArray() || it.length() != 11) {
+      return false;
+    }
+    for (auto const& value : VPackArrayIterator(it)) {
+      if (!value.isNumber()) {
+        return false;
+      }
+    }
+
+    Datafile datafile;
+    datafile.fid = it.at(0).getNumber<TRI_voc_fid_t>();
+    datafile.size = it.at(1).getNumber<TRI_voc_size_t>();
+    datafile.tickMin = it.at(2).getNumber<TRI_voc_tick_t>();
+    datafile.tickMax = it.at(3).getNumber<TRI_voc_tick_t>();
+    datafile.dataMin = it.at(4).getNumber<TRI_voc_tick_t>();
+    datafile.dataMax = it.at(5).getNumber<TRI_voc_tick_t>();
+    datafile.numberAlive = it.at(6).getNumber<int64_t>();
+    datafile.numberDead = it.at(7).getNumber<int64_t>();
+    datafile.numberDeletions = it.at(8).getNumber<int64_t>();
+    datafile.sizeAlive = it.at(9).getNumber<int64_t>();
+    datafile.sizeDead = it.at(10).getNumber<int64_t>();
+    datafiles.emplace_back(datafile);
+  }
+
+  for (auto const& it : VPackArrayIterator(docs)) {
+    if (!it.isArray() || it.length() != 2 || !it.at(0).isNumber() ||
+        !it.at(1).isArray()) {
+      return false;
+    }
+
+    Documents entry;
+    entry.fid = it.at(0).getNumber<TRI_voc_fid_t>();
+    for (auto const& offset : VPackArrayIterator(it.at(1))) {
+      if (!offset.isNumber()) {
+        return false;
+      }
+      entry.offsets.emplace_back(offset.getNumber<uint64_t>());
+    }
+    documents.emplace_back(std::move(entry));
+  }
+
+  return true;
+}
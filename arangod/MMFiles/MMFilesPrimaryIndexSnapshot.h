@@ -0,0 +1,85 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2017 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_MMFILES_MMFILES_PRIMARY_INDEX_SNAPSHOT_H
+#define ARANGOD_MMFILES_MMFILES_PRIMARY_INDEX_SNAPSHOT_H 1
+
+#include "Basics/Common.h"
+#include "VocBase/voc-types.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Slice.h>
+
+namespace arangodb {
+
+/// @brief the contents of a primary index snapshot of an MMFiles
+/// collection: the position of each live document in the datafiles, plus
+/// the statistics and tick ranges of the datafiles and the collection's
+/// last revision and tick. it can only be used as long as the datafiles
+/// remain unchanged
+struct MMFilesPrimaryIndexSnapshot {
+  /// @brief the state of a datafile when the snapshot was taken
+  struct Datafile {
+    TRI_voc_fid_t fid;
+    TRI_voc_size_t size;
+    TRI_voc_tick_t tickMin;
+    TRI_voc_tick_t tickMax;
+    TRI_voc_tick_t dataMin;
+    TRI_voc_tick_t dataMax;
+    int64_t numberAlive;
+    int64_t numberDead;
+    int64_t numberDeletions;
+    int64_t sizeAlive;
+    int64_t sizeDead;
+  };
+
+  /// @brief the offsets of the live documents' VPack in a datafile
+  struct Documents {
+    TRI_voc_fid_t fid;
+    std::vector<uint64_t> offsets;
+  };
+
+  /// @brief current version of the snapshot format. snapshots of other
+  /// versions are not used
+  static uint64_t const Version;
+
+  MMFilesPrimaryIndexSnapshot() : lastRevision(0), maxTick(0) {}
+
+  /// @brief number of documents in the snapshot
+  uint64_t numberOfDocuments() const;
+
+  /// @brief serialize the snapshot
+  void toVelocyPack(arangodb::velocypack::Builder&) const;
+
+  /// @brief read a snapshot. returns false if the slice is not a valid
+  /// snapshot of the current version
+  bool fromVelocyPack(arangodb::velocypack::Slice const&);
+
+  TRI_voc_rid_t lastRevision;
+  /// @brief the tick of the last marker of the collection in its datafiles
+  TRI_voc_tick_t maxTick;
+  std::vector<Datafile> datafiles;
+  std::vector<Documents> documents;
+};
+}
+
+#endif
@@ -132,6 +132,16 @@ void MMFilesRestWalHandler::properties() {
   builder.add("syncInterval", VPackValue(l->syncInterval()));
   builder.add("throttleWait", VPackValue(l->maxThrottleWait()));
   builder.add("throttleWhenPending", VPackValue(l->throttleWhenPending()));
+  builder.add("groupCommitWindow", VPackValue(l->groupCommitWindow()));
+
+  // group commit statistics (read-only)
+  auto const state = l->state();
+  builder.add("groupCommit", VPackValue(VPackValueType::Object));
+  builder.add("count", VPackValue(state.numGroupCommits));
+  builder.add("waiters", VPackValue(state.numGroupCommitWaiters));
+  builder.add("maxSize", VPackValue(state.maxGroupCommitSize));
+  builder.add("syncLatency", VPackValue(state.syncLatency));
+  builder.close();
 
   builder.close();
   generateResult(rest::ResponseCode::OK, builder.slice());
@@ -0,0 +1,196 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2017 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "MMFilesRevisionHistory.h"
+#include "Basics/MutexLocker.h"
+#include "VocBase/ticks.h"
+
+#include <set>
+
+using namespace arangodb;
+
+namespace {
+/// @brief protects the snapshots and the handing out of commit ticks
+static Mutex SnapshotsLock;
+
+/// @brief the ticks of all active snapshots
+static std::multiset<TRI_voc_tick_t> Snapshots;
+
+/// @brief number of active snapshots, for checks without the lock
+static std::atomic<size_t> NumSnapshots(0);
+}
+
+MMFilesRevisionHistory::MMFilesRevisionHistory() {}
+
+MMFilesRevisionHistory::~MMFilesRevisionHistory() {}
+
+bool MMFilesRevisionHistory::record(TRI_voc_tid_t tid, StringRef const& key,
+                                    velocypack::Slice oldDoc,
+                                    TRI_voc_rid_t oldRevisionId) {
+  Version version;
+  version.tid = tid;
+  version.commitTick = 0;
+  version.document.revisionId = 0;
+
+  if (!oldDoc.isNone()) {
+    // copy the document, as its datafile may be compacted away before the
+    // last snapshot that can see it is released
+    version.document.vpack =
+        std::make_shared<velocypack::Buffer<uint8_t>>(oldDoc.byteSize());
+    version.document.vpack->append(oldDoc.start(), oldDoc.byteSize());
+    version.document.revisionId = oldRevisionId;
+  }
+
+  MUTEX_LOCKER(mutexLocker, _lock);
+  auto& versions = _versions[key.toString()];
+  for (auto const& it : versions) {
+    if (it.tid == tid && it.commitTick == 0) {
+      // the transaction has modified the document before, and snapshots
+      // must see the version from before its first modification
+      return false;
+    }
+  }
+  versions.emplace_back(std::move(version));
+  return true;
+}
+
+void MMFilesRevisionHistory::commit(TRI_voc_tid_t tid, std::string const& key,
+                                    TRI_voc_tick_t commitTick) {
+  MUTEX_LOCKER(mutexLocker, _lock);
+  auto it = _versions.find(key);
+  if (it == _versions.end()) {
+    return;
+  }
+  for (auto& version : (*it).second) {
+    if (version.tid == tid && version.commitTick == 0) {
+      version.commitTick = commitTick;
+      return;
+    }
+  }
+}
+
+void MMFilesRevisionHistory::abort(TRI_voc_tid_t tid, std::string const& key) {
+  MUTEX_LOCKER(mutexLocker, _lock);
+  auto it = _versions.find(key);
+  if (it == _versions.end()) {
+    return;
+  }
+  auto& versions = (*it).second;
+  for (auto it2 = versions.begin(); it2 != versions.end(); ++it2) {
+    if ((*it2).tid == tid && (*it2).commitTick == 0) {
+      versions.erase(it2);
+      break;
+    }
+  }
+  if (versions.empty()) {
+    _versions.erase(it);
+  }
+}
+
+bool MMFilesRevisionHistory::lookup(StringRef const& key,
+                                    TRI_voc_tick_t snapshotTick,
+                                    Document& result) const {
+  MUTEX_LOCKER(mutexLocker, _lock);
+  if (_versions.empty()) {
+    return false;
+  }
+  auto it = _versions.find(key.toString());
+  if (it == _versions.end()) {
+    return false;
+  }
+  for (auto const& version : (*it).second) {
+    if (version.commitTick == 0 || version.commitTick > snapshotTick) {
+      // the first write the snapshot must not see
+      result = version.document;
+      return true;
+    }
+  }
+  return false;
+}
+
+void MMFilesRevisionHistory::prune(TRI_voc_tick_t oldestSnapshot) {
+  MUTEX_LOCKER(mutexLocker, _lock);
+  for (auto it = _versions.begin(); it != _versions.end(); /* no hoisting */) {
+    auto& versions = (*it).second;
+    versions.erase(
+        std::remove_if(versions.begin(), versions.end(),
+                       [oldestSnapshot](Version const& version) {
+                         return version.commitTick != 0 &&
+                                (oldestSnapshot == 0 ||
+                                 version.commitTick <= oldestSnapshot);
+                       }),
+        versions.end());
+    if (versions.empty()) {
+      it = _versions.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+size_t MMFilesRevisionHistory::size() const {
+  MUTEX_LOCKER(mutexLocker, _lock);
+  return _versions.size();
+}
+
+TRI_voc_tick_t MMFilesSnapshots::acquire() {
+  MUTEX_LOCKER(mutexLocker, SnapshotsLock);
+  TRI_voc_tick_t tick = TRI_NewTickServer();
+  Snapshots.emplace(tick);
+  NumSnapshots.fetch_add(1, std::memory_order_release);
+  return tick;
+}
+
+void MMFilesSnapshots::release(TRI_voc_tick_t tick) {
+  MUTEX_LOCKER(mutexLocker, SnapshotsLock);
+  auto it = Snapshots.find(tick);
+  if (it != Snapshots.end()) {
+    Snapshots.erase(it);
+    NumSnapshots.fetch_sub(1, std::memory_order_release);
+  }
+}
+
+TRI_voc_tick_t MMFilesSnapshots::oldest() {
+  MUTEX_LOCKER(mutexLocker, SnapshotsLock);
+  if (Snapshots.empty()) {
+    return 0;
+  }
+  return *Snapshots.begin();
+}
+
+bool MMFilesSnapshots::active() {
+  return NumSnapshots.load(std::memory_order_acquire) > 0;
+}
+
+void MMFilesSnapshots::commit(
+    TRI_voc_tid_t tid,
+    std::vector<std::pair<MMFilesRevisionHistory*, std::string>> const& keys) {
+  if (keys.empty()) {
+    return;
+  }
+  // a snapshot must either see all or none of the modifications
+  MUTEX_LOCKER(mutexLocker, SnapshotsLock);
+  TRI_voc_tick_t commitTick = TRI_NewTickServer();
+  for (auto const& it : keys) {
+    it.first->commit(tid, it.second, commitTick);
+  }
+}
@@ -0,0 +1,132 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2017 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_MMFILES_MMFILES_REVISION_HISTORY_H
+#define ARANGOD_MMFILES_MMFILES_REVISION_HISTORY_H 1
+
+#include "Basics/Common.h"
+#include "Basics/Mutex.h"
+#include "Basics/StringRef.h"
+#include "VocBase/voc-types.h"
+
+#include <velocypack/Buffer.h>
+#include <velocypack/Slice.h>
+
+namespace arangodb {
+
+/// @brief the previous revisions of the documents of a collection that are
+/// still visible to some snapshot. before a writer modifies a document, it
+/// records the version it replaces (or that the document did not exist).
+/// the entry is pending until the writer commits, and is then stamped with
+/// the commit tick. a snapshot with tick S must see the version recorded
+/// by the first write to a key that is pending or committed after S; if
+/// there is no such write, the current version is visible to it
+class MMFilesRevisionHistory {
+ public:
+  /// @brief a version of a document as seen by a snapshot
+  struct Document {
+    /// @brief the document, nullptr if it did not exist
+    std::shared_ptr<velocypack::Buffer<uint8_t>> vpack;
+    /// @brief the revision id of the document, 0 if it did not exist
+    TRI_voc_rid_t revisionId;
+  };
+
+  MMFilesRevisionHistory();
+  ~MMFilesRevisionHistory();
+
+  MMFilesRevisionHistory(MMFilesRevisionHistory const&) = delete;
+  MMFilesRevisionHistory& operator=(MMFilesRevisionHistory const&) = delete;
+
+ public:
+  /// @brief record the version of a document before transaction tid
+  /// modifies it. oldDoc is a none slice if the document does not exist.
+  /// only the first modification of a key by a transaction is recorded.
+  /// returns true if a new entry was added. the caller must hold the
+  /// write lock on the collection
+  bool record(TRI_voc_tid_t tid, StringRef const& key,
+              velocypack::Slice oldDoc, TRI_voc_rid_t oldRevisionId);
+
+  /// @brief stamp the entry of transaction tid with its commit tick
+  void commit(TRI_voc_tid_t tid, std::string const& key,
+              TRI_voc_tick_t commitTick);
+
+  /// @brief remove the entry of transaction tid after it was rolled back.
+  /// must be called after the modification was undone
+  void abort(TRI_voc_tid_t tid, std::string const& key);
+
+  /// @brief look up the version of a document visible to the snapshot with
+  /// the given tick. returns false if the current version is visible
+  bool lookup(StringRef const& key, TRI_voc_tick_t snapshotTick,
+              Document& result) const;
+
+  /// @brief remove all committed entries that are visible to every
+  /// snapshot, i.e. that were committed before the oldest active one.
+  /// oldestSnapshot is 0 if there are no active snapshots
+  void prune(TRI_voc_tick_t oldestSnapshot);
+
+  /// @brief number of keys with recorded versions
+  size_t size() const;
+
+ private:
+  struct Version {
+    Document document;
+    /// @brief the transaction that replaced the version
+    TRI_voc_tid_t tid;
+    /// @brief the commit tick of that transaction, 0 while it is pending
+    TRI_voc_tick_t commitTick;
+  };
+
+  mutable Mutex _lock;
+
+  /// @brief the recorded versions per key, in the order of the writes.
+  /// writes to a key are serialized by the collection lock
+  std::unordered_map<std::string, std::vector<Version>> _versions;
+};
+
+/// @brief the snapshots of all read-only transactions. snapshot ticks and
+/// commit ticks are handed out under the same lock, so that a transaction
+/// committed before a snapshot was acquired always has a smaller tick
+class MMFilesSnapshots {
+ public:
+  /// @brief acquire a snapshot of the committed state
+  static TRI_voc_tick_t acquire();
+
+  /// @brief release a snapshot acquired before
+  static void release(TRI_voc_tick_t tick);
+
+  /// @brief the tick of the oldest active snapshot, 0 if there is none
+  static TRI_voc_tick_t oldest();
+
+  /// @brief whether or not there are active snapshots
+  static bool active();
+
+  /// @brief make the modifications of transaction tid visible to new
+  /// snapshots, by stamping their history entries with a commit tick
+  static void commit(
+      TRI_voc_tid_t tid,
+      std::vector<std::pair<MMFilesRevisionHistory*, std::string>> const&
+          keys);
+};
+
+}
+
+#endif
@@ -54,55 +54,123 @@ static bool IsEqualElementElement(void*, MMFilesDocumentPosition const& left,
 
 } // namespace
 
-MMFilesRevisionsCache::MMFilesRevisionsCache() 
-    : _positions(HashKey, HashElement, IsEqualKeyElement, IsEqualElementElement, IsEqualElementElement, 8, []() -> std::string { return "mmfiles revisions"; }) {}
+MMFilesRevisionsCache::Partition::Partition()
+    : _positions(HashKey, HashElement, IsEqualKeyElement, IsEqualElementElement, IsEqualElementElement, 1, []() -> std::string { return "mmfiles revisions"; }) {}
+
+MMFilesRevisionsCache::MMFilesRevisionsCache() {
+  static_assert((1ULL << (64 - 61)) == NumPartitions, "invalid number of partitions");
+
+  _partitions.reserve(NumPartitions);
+  for (size_t i = 0; i < NumPartitions; ++i) {
+    _partitions.emplace_back(new Partition());
+  }
+}
 
 MMFilesRevisionsCache::~MMFilesRevisionsCache() {}
 
 MMFilesDocumentPosition MMFilesRevisionsCache::lookup(TRI_voc_rid_t revisionId) const {
   TRI_ASSERT(revisionId != 0);
-  READ_LOCKER(locker, _lock);
+  Partition& p = partition(revisionId);
+  READ_LOCKER(locker, p._lock);
+
+  return p._positions.findByKey(nullptr, &revisionId);
+}
+
+/// @brief look up the positions of many revisions. every partition is
+/// locked once, and the slots of all its lookups are prefetched before the
+/// first one is done, so that their cache misses overlap. revisions that
+/// are not found have an empty position in the result
+void MMFilesRevisionsCache::lookup(std::vector<TRI_voc_rid_t> const& revisionIds,
+                                   std::vector<MMFilesDocumentPosition>& result) const {
+  size_t const n = revisionIds.size();
+  result.clear();
+  result.resize(n);
+
+  std::vector<uint8_t> partitionIds;
+  partitionIds.reserve(n);
+  uint32_t used = 0;
+  for (auto const& revisionId : revisionIds) {
+    TRI_ASSERT(revisionId != 0);
+    size_t id = partitionId(revisionId);
+    partitionIds.emplace_back(static_cast<uint8_t>(id));
+    used |= (1U << id);
+  }
 
-  return _positions.findByKey(nullptr, &revisionId);
+  for (size_t id = 0; id < NumPartitions; ++id) {
+    if ((used & (1U << id)) == 0) {
+      continue;
+    }
+    Partition& p = *_partitions[id];
+    READ_LOCKER(locker, p._lock);
+
+    for (size_t i = 0; i < n; ++i) {
+      if (partitionIds[i] == id) {
+        p._positions.prefetchByKey(nullptr, &revisionIds[i]);
+      }
+    }
+    for (size_t i = 0; i < n; ++i) {
+      if (partitionIds[i] == id) {
+        result[i] = p._positions.findByKey(nullptr, &revisionIds[i]);
+      }
+    }
+  }
 }
 
 void MMFilesRevisionsCache::sizeHint(int64_t hint) {
-  WRITE_LOCKER(locker, _lock);
-  if (hint > 256) {
-    _positions.resize(nullptr, static_cast<size_t>(hint));
+  if (hint <= 256) {
+    return;
+  }
+  for (auto& p : _partitions) {
+    WRITE_LOCKER(locker, p->_lock);
+    p->_positions.resize(nullptr, static_cast<size_t>(hint) / NumPartitions + 1);
   }
 }
 
 size_t MMFilesRevisionsCache::size() {
-  READ_LOCKER(locker, _lock);
-  return _positions.size();
+  size_t result = 0;
+  for (auto& p : _partitions) {
+    READ_LOCKER(locker, p->_lock);
+    result += p->_positions.size();
+  }
+  return result;
 }
 
 size_t MMFilesRevisionsCache::capacity() {
-  READ_LOCKER(locker, _lock);
-  return _positions.capacity();
+  size_t result = 0;
+  for (auto& p : _partitions) {
+    READ_LOCKER(locker, p->_lock);
+    result += p->_positions.capacity();
+  }
+  return result;
 }
 
 size_t MMFilesRevisionsCache::memoryUsage() {
-  READ_LOCKER(locker, _lock);
-  return _positions.memoryUsage();
+  size_t result = 0;
+  for (auto& p : _partitions) {
+    READ_LOCKER(locker, p->_lock);
+    result += p->_positions.memoryUsage();
+  }
+  return result;
 }
 
 void MMFilesRevisionsCache::clear() {
-  WRITE_LOCKER(locker, _lock);
-  _positions.truncate([](MMFilesDocumentPosition&) { return true; });
+  for (auto& p : _partitions) {
+    WRITE_LOCKER(locker, p->_lock);
+    p->_positions.truncate([](MMFilesDocumentPosition&) { return true; });
+  }
 }
 
 MMFilesDocumentPosition MMFilesRevisionsCache::insert(TRI_voc_rid_t revisionId, uint8_t const* dataptr, TRI_voc_fid_t fid, bool isInWal, bool shouldLock) {
   TRI_ASSERT(revisionId != 0);
   TRI_ASSERT(dataptr != nullptr);
 
-  CONDITIONAL_WRITE_LOCKER(locker, _lock, shouldLock);
-  int res = _positions.insert(nullptr, MMFilesDocumentPosition(revisionId, dataptr, fid, isInWal));
+  Partition& p = partition(revisionId);
+  CONDITIONAL_WRITE_LOCKER(locker, p._lock, shouldLock);
+  int res = p._positions.insert(nullptr, MMFilesDocumentPosition(revisionId, dataptr, fid, isInWal));
 
   if (res != TRI_ERROR_NO_ERROR) {
-    MMFilesDocumentPosition old = _positions.removeByKey(nullptr, &revisionId);
-    _positions.insert(nullptr, MMFilesDocumentPosition(revisionId, dataptr, fid, isInWal));
+    MMFilesDocumentPosition old = p._positions.removeByKey(nullptr, &revisionId);
+    p._positions.insert(nullptr, MMFilesDocumentPosition(revisionId, dataptr, fid, isInWal));
     return old;
   }
 
@@ -110,17 +178,19 @@ MMFilesDocumentPosition MMFilesRevisionsCache::insert(TRI_voc_rid_t revisionId,
 }
 
 void MMFilesRevisionsCache::insert(MMFilesDocumentPosition const& position, bool shouldLock) {
-  CONDITIONAL_WRITE_LOCKER(locker, _lock, shouldLock);
-  _positions.insert(nullptr, position);
+  Partition& p = partition(position.revisionId());
+  CONDITIONAL_WRITE_LOCKER(locker, p._lock, shouldLock);
+  p._positions.insert(nullptr, position);
 }
 
 void MMFilesRevisionsCache::update(TRI_voc_rid_t revisionId, uint8_t const* dataptr, TRI_voc_fid_t fid, bool isInWal) {
   TRI_ASSERT(revisionId != 0);
   TRI_ASSERT(dataptr != nullptr);
 
-  WRITE_LOCKER(locker, _lock);
+  Partition& p = partition(revisionId);
+  WRITE_LOCKER(locker, p._lock);
   
-  MMFilesDocumentPosition* old = _positions.findByKeyRef(nullptr, &revisionId);
+  MMFilesDocumentPosition* old = p._positions.findByKeyRef(nullptr, &revisionId);
   if (old == nullptr) {
     return;
   }
@@ -131,9 +201,10 @@ void MMFilesRevisionsCache::update(TRI_voc_rid_t revisionId, uint8_t const* data
 }
   
 bool MMFilesRevisionsCache::updateConditional(TRI_voc_rid_t revisionId, TRI_df_marker_t const* oldPosition, TRI_df_marker_t const* newPosition, TRI_voc_fid_t newFid, bool isInWal) {
-  WRITE_LOCKER(locker, _lock);
+  Partition& p = partition(revisionId);
+  WRITE_LOCKER(locker, p._lock);
 
-  MMFilesDocumentPosition old = _positions.findByKey(nullptr, &revisionId);
+  MMFilesDocumentPosition old = p._positions.findByKey(nullptr, &revisionId);
   if (!old) {
     return false;
   }
@@ -148,12 +219,12 @@ bool MMFilesRevisionsCache::updateConditional(TRI_voc_rid_t revisionId, TRI_df_m
     return false;
   }
   
-  _positions.removeByKey(nullptr, &revisionId);
+  p._positions.removeByKey(nullptr, &revisionId);
 
   old.dataptr(reinterpret_cast<char const*>(newPosition) + MMFilesDatafileHelper::VPackOffset(TRI_DF_MARKER_VPACK_DOCUMENT));
   old.fid(newFid, isInWal); 
 
-  _positions.insert(nullptr, old);
+  p._positions.insert(nullptr, old);
   
   return true;
 }
@@ -161,14 +232,15 @@ bool MMFilesRevisionsCache::updateConditional(TRI_voc_rid_t revisionId, TRI_df_m
 void MMFilesRevisionsCache::remove(TRI_voc_rid_t revisionId) {
   TRI_ASSERT(revisionId != 0);
 
-  WRITE_LOCKER(locker, _lock);
-  _positions.removeByKey(nullptr, &revisionId);
+  Partition& p = partition(revisionId);
+  WRITE_LOCKER(locker, p._lock);
+  p._positions.removeByKey(nullptr, &revisionId);
 }
 
 MMFilesDocumentPosition MMFilesRevisionsCache::fetchAndRemove(TRI_voc_rid_t revisionId) {
   TRI_ASSERT(revisionId != 0);
 
-  WRITE_LOCKER(locker, _lock);
-  return _positions.removeByKey(nullptr, &revisionId);
+  Partition& p = partition(revisionId);
+  WRITE_LOCKER(locker, p._lock);
+  return p._positions.removeByKey(nullptr, &revisionId);
 }
-
@@ -34,11 +34,17 @@ struct TRI_df_marker_t;
 
 namespace arangodb {
 
+/// @brief maps revision ids to document positions. the map is split into
+/// independently locked partitions, so that concurrent readers and writers
+/// of different documents do not contend on the same lock
 class MMFilesRevisionsCache {
  public:
   MMFilesRevisionsCache();
   ~MMFilesRevisionsCache();
   
+  MMFilesRevisionsCache(MMFilesRevisionsCache const&) = delete;
+  MMFilesRevisionsCache& operator=(MMFilesRevisionsCache const&) = delete;
+  
  public:
   void sizeHint(int64_t hint);
   size_t size();
@@ -46,6 +52,8 @@ class MMFilesRevisionsCache {
   size_t memoryUsage();
   void clear();
   MMFilesDocumentPosition lookup(TRI_voc_rid_t revisionId) const;
+  void lookup(std::vector<TRI_voc_rid_t> const& revisionIds,
+              std::vector<MMFilesDocumentPosition>& result) const;
   MMFilesDocumentPosition insert(TRI_voc_rid_t revisionId, uint8_t const* dataptr, TRI_voc_fid_t fid, bool isInWal, bool shouldLock);
   void insert(MMFilesDocumentPosition const& position, bool shouldLock);
   void update(TRI_voc_rid_t revisionId, uint8_t const* dataptr, TRI_voc_fid_t fid, bool isInWal);
@@ -54,9 +62,30 @@ class MMFilesRevisionsCache {
   MMFilesDocumentPosition fetchAndRemove(TRI_voc_rid_t revisionId);
 
  private:
-  mutable arangodb::basics::ReadWriteLock _lock; 
+  /// @brief number of partitions, must be a power of two
+  static constexpr size_t NumPartitions = 8;
+
+  struct Partition {
+    Partition();
+
+    mutable arangodb::basics::ReadWriteLock _lock; 
   
-  arangodb::basics::AssocUnique<TRI_voc_rid_t, MMFilesDocumentPosition> _positions;
+    arangodb::basics::AssocUnique<TRI_voc_rid_t, MMFilesDocumentPosition> _positions;
+  };
+
+  /// @brief the number of the partition responsible for a revision id
+  static size_t partitionId(TRI_voc_rid_t revisionId) {
+    // use the high bits of a multiplicative hash, as the low bits of the
+    // revision id are used for the positions inside the partition
+    return static_cast<size_t>((revisionId * 0x9E3779B97F4A7C15ULL) >> 61);
+  }
+
+  /// @brief the partition responsible for a revision id
+  Partition& partition(TRI_voc_rid_t revisionId) const {
+    return *_partitions[partitionId(revisionId)];
+  }
+
+  std::vector<std::unique_ptr<Partition>> _partitions;
 };
 
 } // namespace arangodb
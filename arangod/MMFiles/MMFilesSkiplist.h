@@ -35,16 +35,25 @@
 
 namespace arangodb {
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief two possibilities for comparison, see below
+////////////////////////////////////////////////////////////////////////////////
+
+enum MMFilesSkiplistCmpType { SKIPLIST_CMP_PREORDER, SKIPLIST_CMP_TOTORDER };
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief type of a skiplist node
 ////////////////////////////////////////////////////////////////////////////////
 
-template <class Key, class Element>
+template <class Key, class Element,
+          class CmpElmElm = std::function<int(void*, Element const*, Element const*, MMFilesSkiplistCmpType)>,
+          class CmpKeyElm = std::function<int(void*, Key const*, Element const*)>>
 class MMFilesSkiplist;
 
 template <class Key, class Element>
 class MMFilesSkiplistNode {
-  friend class MMFilesSkiplist<Key, Element>;
+  template <class K, class E, class C1, class C2>
+  friend class MMFilesSkiplist;
   MMFilesSkiplistNode<Key, Element>** _next;
   MMFilesSkiplistNode<Key, Element>* _prev;
   Element* _doc;
@@ -78,12 +87,6 @@ class MMFilesSkiplistNode {
   MMFilesSkiplistNode<Key, Element>* prevNode() const { return _prev; }
 };
 
-////////////////////////////////////////////////////////////////////////////////
-/// @brief two possibilities for comparison, see below
-////////////////////////////////////////////////////////////////////////////////
-
-enum MMFilesSkiplistCmpType { SKIPLIST_CMP_PREORDER, SKIPLIST_CMP_TOTORDER };
-
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief type of a skiplist
 /// _end always points to the last node in the skiplist, this can be the
@@ -91,7 +94,7 @@ enum MMFilesSkiplistCmpType { SKIPLIST_CMP_PREORDER, SKIPLIST_CMP_TOTORDER };
 /// level, then the corresponding _next pointer is a nullptr.
 ////////////////////////////////////////////////////////////////////////////////
 
-template <class Key, class Element>
+template <class Key, class Element, class CmpElmElm, class CmpKeyElm>
 class MMFilesSkiplist {
   typedef MMFilesSkiplistNode<Key, Element> Node;
 
@@ -111,11 +114,13 @@ class MMFilesSkiplist {
   /// The cmp_key_elm variant compares a key with an element using the preorder.
   /// The first argument is a data pointer as above, the second is a pointer
   /// to the key and the third is a pointer to an element.
+  /// Both comparators are template parameters, so that callers can pass
+  /// function objects which are inlined into the search loops instead of
+  /// being invoked through a std::function.
   //////////////////////////////////////////////////////////////////////////////
 
-  typedef std::function<int(void*, Element const*, Element const*, MMFilesSkiplistCmpType)>
-      CmpElmElmFuncType;
-  typedef std::function<int(void*, Key const*, Element const*)> CmpKeyElmFuncType;
+  typedef CmpElmElm CmpElmElmFuncType;
+  typedef CmpKeyElm CmpKeyElmFuncType;
 
   //////////////////////////////////////////////////////////////////////////////
   /// @brief Type of a pointer to a function that is called whenever a
@@ -317,6 +322,150 @@ class MMFilesSkiplist {
     return TRI_ERROR_NO_ERROR;
   }
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief inserts many documents into a skiplist at once
+  ///
+  /// The documents are sorted in the proper total order and merged into the
+  /// skiplist in a single pass over its lowest level, so this needs
+  /// O(m log m + n) comparisons instead of the O(m log(n + m)) comparisons
+  /// of m individual inserts. Tower heights are assigned deterministically,
+  /// so that every second new node reaches level 1, every fourth level 2 etc.
+  /// The function checks all documents before it modifies the skiplist.
+  /// If any document cannot be inserted for one of the reasons given for
+  /// insert(), or if allocation fails, nothing is inserted and the error
+  /// is returned. The caller keeps the ownership of the documents then.
+  /// Note that docs is sorted in any case.
+  //////////////////////////////////////////////////////////////////////////////
+
+  int bulkInsert(void* userData, std::vector<Element*>& docs) {
+    size_t const m = docs.size();
+
+    if (m == 0) {
+      return TRI_ERROR_NO_ERROR;
+    }
+
+    std::sort(docs.begin(), docs.end(),
+              [this, userData](Element const* lhs, Element const* rhs) {
+                return _cmp_elm_elm(userData, lhs, rhs,
+                                    SKIPLIST_CMP_TOTORDER) < 0;
+              });
+
+    // find the existing predecessor of each new document, and check for
+    // duplicates amongst the new documents and against the existing ones
+    std::vector<Node*> preds;
+    preds.reserve(m);
+
+    Node* cur = _start;
+    for (size_t i = 0; i < m; ++i) {
+      Element* doc = docs[i];
+      Node* next = cur->_next[0];
+      int cmp = 1;
+
+      while (nullptr != next) {
+        cmp = _cmp_elm_elm(userData, next->_doc, doc, SKIPLIST_CMP_TOTORDER);
+        if (cmp >= 0) {
+          break;
+        }
+        cur = next;
+        next = cur->_next[0];
+      }
+
+      if (nullptr != next && 0 == cmp) {
+        return TRI_ERROR_ARANGO_UNIQUE_CONSTRAINT_VIOLATED;
+      }
+
+      // the document directly before doc once everything is merged
+      Element* prev = nullptr;
+      if (i > 0 && preds[i - 1] == cur) {
+        prev = docs[i - 1];
+      } else if (cur != _start) {
+        prev = cur->_doc;
+      }
+
+      if (i > 0 && 0 == _cmp_elm_elm(userData, docs[i - 1], doc,
+                                     SKIPLIST_CMP_TOTORDER)) {
+        return TRI_ERROR_ARANGO_UNIQUE_CONSTRAINT_VIOLATED;
+      }
+
+      if (_unique &&
+          ((nullptr != prev &&
+            0 == _cmp_elm_elm(userData, doc, prev, SKIPLIST_CMP_PREORDER)) ||
+           (nullptr != next && 0 == _cmp_elm_elm(userData, doc, next->_doc,
+                                                 SKIPLIST_CMP_PREORDER)))) {
+        return TRI_ERROR_ARANGO_UNIQUE_CONSTRAINT_VIOLATED;
+      }
+
+      preds.emplace_back(cur);
+    }
+
+    // allocate all nodes up front, so that linking them cannot fail
+    std::vector<Node*> nodes;
+
+    try {
+      nodes.reserve(m);
+      for (size_t i = 0; i < m; ++i) {
+        int height = 1;
+        for (size_t j = i + 1; (j & 1) == 0 && height < TRI_SKIPLIST_MAX_HEIGHT;
+             j >>= 1) {
+          ++height;
+        }
+        nodes.emplace_back(allocNode(height));
+        nodes.back()->_doc = docs[i];
+      }
+    } catch (...) {
+      for (auto& node : nodes) {
+        freeNode(node);
+      }
+      return TRI_ERROR_OUT_OF_MEMORY;
+    }
+
+    // last[lev] is the last node of height > lev before the current
+    // insert position. walk through the merged list and link the new nodes
+    Node* last[TRI_SKIPLIST_MAX_HEIGHT];
+    for (int lev = 0; lev < TRI_SKIPLIST_MAX_HEIGHT; lev++) {
+      last[lev] = _start;
+    }
+
+    Node* walk = _start;
+    for (size_t i = 0; i < m; ++i) {
+      Node* newNode = nodes[i];
+      Node* insertAfter =
+          (i > 0 && preds[i] == preds[i - 1]) ? nodes[i - 1] : preds[i];
+
+      while (walk != insertAfter) {
+        walk = walk->_next[0];
+        for (int lev = 0; lev < walk->_height; lev++) {
+          last[lev] = walk;
+        }
+      }
+
+      if (newNode->_height > _start->_height) {
+        // note that _start is already initialized with nullptr to the top
+        _start->_height = newNode->_height;
+      }
+
+      for (int lev = 0; lev < newNode->_height; lev++) {
+        newNode->_next[lev] = last[lev]->_next[lev];
+        last[lev]->_next[lev] = newNode;
+        last[lev] = newNode;
+      }
+
+      newNode->_prev = insertAfter;
+      if (newNode->_next[0] == nullptr) {
+        // a new last node
+        _end = newNode;
+      } else {
+        newNode->_next[0]->_prev = newNode;
+      }
+
+      walk = newNode;
+    }
+
+    _nrUsed += m;
+
+    return TRI_ERROR_NO_ERROR;
+  }
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief removes a document from a skiplist
   ///
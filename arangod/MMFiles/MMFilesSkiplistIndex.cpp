@@ -22,6 +22,7 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "MMFilesSkiplistIndex.h"
+#include "Aql/Ast.h"
 #include "Aql/AstNode.h"
 #include "Aql/SortCondition.h"
 #include "Basics/AttributeNameParser.h"
@@ -77,6 +78,24 @@ static size_t sortWeight(arangodb::aql::AstNode const* node) {
 // lists: lexicographically and within each slot according to these rules.
 // ...........................................................................
 
+/// @brief compares two indexed values. integers and doubles are by far
+/// the most common indexed values, so they are compared directly if both
+/// sides have the same type. everything else uses the generic comparison
+static inline int CompareValues(VPackSlice const& left, VPackSlice const& right) {
+  if ((left.isSmallInt() || left.isInt()) &&
+      (right.isSmallInt() || right.isInt())) {
+    int64_t l = left.getInt();
+    int64_t r = right.getInt();
+    return (l == r ? 0 : (l < r ? -1 : 1));
+  }
+  if (left.isDouble() && right.isDouble()) {
+    double l = left.getDouble();
+    double r = right.getDouble();
+    return (l == r ? 0 : (l < r ? -1 : 1));
+  }
+  return arangodb::basics::VelocyPackHelper::compare(left, right, true);
+}
+
 /// @brief compares a key with an element, version with proper types
 static int CompareKeyElement(void* userData, 
                              VPackSlice const* left,
@@ -85,8 +104,7 @@ static int CompareKeyElement(void* userData,
   IndexLookupContext* context = static_cast<IndexLookupContext*>(userData);
   TRI_ASSERT(nullptr != left);
   TRI_ASSERT(nullptr != right);
-  return arangodb::basics::VelocyPackHelper::compare(
-      *left, right->slice(context, rightPosition), true);
+  return CompareValues(*left, right->slice(context, rightPosition));
 }
 
 /// @brief compares elements, version with proper types
@@ -101,7 +119,7 @@ static int CompareElementElement(void* userData,
 
   VPackSlice l = left->slice(context, leftPosition);
   VPackSlice r = right->slice(context, rightPosition);
-  return arangodb::basics::VelocyPackHelper::compare(l, r, true);
+  return CompareValues(l, r);
 }
 
 bool MMFilesBaseSkiplistLookupBuilder::isEquality() const { return _isEquality; }
@@ -505,8 +523,7 @@ MMFilesSkiplistIterator::MMFilesSkiplistIterator(LogicalCollection* collection,
     ManagedDocumentResult* mmdr,
     arangodb::MMFilesSkiplistIndex const* index,
     TRI_Skiplist const* skiplist, size_t numPaths,
-    std::function<int(void*, MMFilesSkiplistIndexElement const*, MMFilesSkiplistIndexElement const*,
-                      MMFilesSkiplistCmpType)> const& CmpElmElm,
+    MMFilesSkiplistElementElementComparator const& CmpElmElm,
     bool reverse, MMFilesBaseSkiplistLookupBuilder* builder)
     : IndexIterator(collection, trx, mmdr, index),
       _skiplistIndex(skiplist),
@@ -588,6 +605,45 @@ bool MMFilesSkiplistIterator::next(TokenCallback const& cb, size_t limit) {
   return true;
 }
 
+bool MMFilesSkiplistIterator::nextExtra(ExtraCallback const& cb, size_t limit) {
+  while (limit > 0) {
+    if (_cursor == nullptr) {
+      // We are exhausted already, sorry
+      return false;
+    }
+    TRI_ASSERT(_currentInterval < _intervals.size());
+    auto const& interval = _intervals[_currentInterval];
+    Node* tmp = _cursor;
+    if (_reverse) {
+      if (_cursor == interval.first) {
+        forwardCursor();
+      } else {
+        _cursor = _cursor->prevNode();
+      }
+    } else {
+      if (_cursor == interval.second) {
+        forwardCursor();
+      } else {
+        _cursor = _cursor->nextNode();
+      }
+    }
+    TRI_ASSERT(tmp != nullptr);
+    MMFilesSkiplistIndexElement* element = tmp->document();
+    TRI_ASSERT(element != nullptr);
+
+    _extra.clear();
+    _extra.openArray();
+    for (size_t i = 0; i < _numPaths; ++i) {
+      _extra.add(element->slice(&_context, i));
+    }
+    _extra.close();
+
+    cb(MMFilesToken{element->revisionId()}, _extra.slice());
+    limit--;
+  }
+  return true;
+}
+
 void MMFilesSkiplistIterator::forwardCursor() {
   _currentInterval++;
   if (_currentInterval < _intervals.size()) {
@@ -733,11 +789,14 @@ int MMFilesSkiplistIndex::insert(transaction::Methods* trx, TRI_voc_rid_t revisi
   // insert into the index. the memory for the element will be owned or freed
   // by the index
   size_t const count = elements.size();
+  bool inserted = true;
 
   for (size_t i = 0; i < count; ++i) {
     res = _skiplistIndex->insert(&context, elements[i]);
 
     if (res != TRI_ERROR_NO_ERROR) {
+      inserted = false;
+
       // Note: this element is freed already
       for (size_t j = i; j < count; ++j) {
         _allocator->deallocate(elements[j]);
@@ -755,9 +814,70 @@ int MMFilesSkiplistIndex::insert(transaction::Methods* trx, TRI_voc_rid_t revisi
     }
   }
 
+  if (inserted && count > 0 && !_useExpansion) {
+    try {
+      _valueSample.insert(elements[0]->slice(&context, 0));
+    } catch (...) {
+      // the sample is only used for estimates
+    }
+  }
+
   return res;
 }
 
+/// @brief inserts many documents into a skiplist index at once, by merging
+/// them into the skiplist in sorted order. if this fails for any document,
+/// e.g. because of a unique constraint violation, the documents are inserted
+/// one by one instead, so that errors are reported exactly as by insert()
+void MMFilesSkiplistIndex::batchInsert(
+    transaction::Methods* trx,
+    std::vector<std::pair<TRI_voc_rid_t, VPackSlice>> const& documents,
+    arangodb::basics::LocalTaskQueue* queue) {
+  std::vector<MMFilesSkiplistIndexElement*> elements;
+
+  int res = TRI_ERROR_NO_ERROR;
+  try {
+    elements.reserve(documents.size());
+
+    for (auto const& it : documents) {
+      res = fillElement<MMFilesSkiplistIndexElement>(elements, it.first,
+                                                     it.second);
+      if (res != TRI_ERROR_NO_ERROR) {
+        break;
+      }
+    }
+  } catch (...) {
+    res = TRI_ERROR_OUT_OF_MEMORY;
+  }
+
+  ManagedDocumentResult result;
+  IndexLookupContext context(trx, _collection, &result, numPaths());
+
+  if (res == TRI_ERROR_NO_ERROR) {
+    res = _skiplistIndex->bulkInsert(&context, elements);
+  }
+
+  if (res != TRI_ERROR_NO_ERROR) {
+    for (auto& element : elements) {
+      // the skiplist has not taken over any of the elements
+      _allocator->deallocate(element);
+    }
+    Index::batchInsert(trx, documents, queue);
+    return;
+  }
+
+  if (!_useExpansion) {
+    // without expansion, there is one element per document at most
+    try {
+      for (auto const& element : elements) {
+        _valueSample.insert(element->slice(&context, 0));
+      }
+    } catch (...) {
+      // the sample is only used for estimates
+    }
+  }
+}
+
 /// @brief removes a document from a skiplist index
 int MMFilesSkiplistIndex::remove(transaction::Methods* trx, TRI_voc_rid_t revisionId,
                           VPackSlice const& doc, bool isRollback) {
@@ -802,6 +922,7 @@ int MMFilesSkiplistIndex::remove(transaction::Methods* trx, TRI_voc_rid_t revisi
 
 int MMFilesSkiplistIndex::unload() {
   _skiplistIndex->truncate(true);
+  _valueSample.clear();
   return TRI_ERROR_NO_ERROR;
 }
 
@@ -826,7 +947,7 @@ bool MMFilesSkiplistIndex::intervalValid(void* userData, Node* left, Node* right
 }
 
 /// @brief compares a key with an element in a skip list, generic callback
-int MMFilesSkiplistIndex::KeyElementComparator::operator()(void* userData,
+int MMFilesSkiplistKeyElementComparator::operator()(void* userData,
     VPackSlice const* leftKey, MMFilesSkiplistIndexElement const* rightElement) const {
   TRI_ASSERT(nullptr != leftKey);
   TRI_ASSERT(nullptr != rightElement);
@@ -848,7 +969,7 @@ int MMFilesSkiplistIndex::KeyElementComparator::operator()(void* userData,
 }
 
 /// @brief compares two elements in a skip list, this is the generic callback
-int MMFilesSkiplistIndex::ElementElementComparator::operator()(
+int MMFilesSkiplistElementElementComparator::operator()(
     void* userData,
     MMFilesSkiplistIndexElement const* leftElement,
     MMFilesSkiplistIndexElement const* rightElement,
@@ -1288,9 +1409,20 @@ bool MMFilesSkiplistIndex::supportsFilterCondition(
     }
 
     ++attributesCovered;
+
+    double fraction;
+    bool const estimated = (i == 0 && estimateFraction(nodes, reference, fraction));
+
+    if (estimated) {
+      // the value sample knows the distribution of the first attribute
+      estimatedCost *= fraction;
+    }
+
     if (containsEquality) {
       ++attributesCoveredByEquality;
-      estimatedCost /= equalityReductionFactor;
+      if (!estimated) {
+        estimatedCost /= equalityReductionFactor;
+      }
 
       // decrease the effect of the equality reduction factor
       equalityReductionFactor *= 0.25;
@@ -1298,7 +1430,7 @@ bool MMFilesSkiplistIndex::supportsFilterCondition(
         // equalityReductionFactor shouldn't get too low
         equalityReductionFactor = 2.0;
       }
-    } else {
+    } else if (!estimated) {
       // quick estimate for the potential reductions caused by the conditions
       if (nodes.size() >= 2) {
         // at least two (non-equality) conditions. probably a range with lower
@@ -1348,6 +1480,113 @@ bool MMFilesSkiplistIndex::supportsFilterCondition(
   return false;
 }
 
+bool MMFilesSkiplistIndex::estimateFraction(
+    std::vector<arangodb::aql::AstNode const*> const& nodes,
+    arangodb::aql::Variable const* reference, double& fraction) const {
+  if (_useExpansion) {
+    return false;
+  }
+
+  // the conditions, normalized to "attribute <op> value"
+  std::vector<std::pair<arangodb::aql::AstNodeType, VPackBuilder>> conditions;
+  size_t values = 1;
+
+  for (auto const& op : nodes) {
+    TRI_ASSERT(op->numMembers() == 2);
+    std::pair<arangodb::aql::Variable const*,
+              std::vector<arangodb::basics::AttributeName>> attributeData;
+
+    arangodb::aql::AstNodeType type = op->type;
+    arangodb::aql::AstNode const* value = op->getMember(1);
+
+    if (!op->getMember(0)->isAttributeAccessForVariable(attributeData) ||
+        attributeData.first != reference) {
+      if (type == arangodb::aql::NODE_TYPE_OPERATOR_BINARY_IN) {
+        // 'value' IN doc.value
+        return false;
+      }
+      // value <op> attribute
+      type = arangodb::aql::Ast::ReverseOperator(type);
+      value = op->getMember(0);
+    }
+
+    if (!value->isConstant()) {
+      // e.g. a bind parameter that refers to another variable
+      return false;
+    }
+
+    if (type == arangodb::aql::NODE_TYPE_OPERATOR_BINARY_IN) {
+      if (!value->isArray()) {
+        return false;
+      }
+      values *= (std::max)(value->numMembers(), static_cast<size_t>(1));
+    }
+
+    conditions.emplace_back(type, VPackBuilder());
+    value->toVelocyPackValue(conditions.back().second);
+  }
+
+  auto predicate = [&conditions](VPackSlice sample) -> bool {
+    for (auto const& it : conditions) {
+      VPackSlice value = it.second.slice();
+
+      if (it.first == arangodb::aql::NODE_TYPE_OPERATOR_BINARY_IN) {
+        bool found = false;
+        for (auto const& member : VPackArrayIterator(value)) {
+          if (basics::VelocyPackHelper::compare(sample, member, true) == 0) {
+            found = true;
+            break;
+          }
+        }
+        if (!found) {
+          return false;
+        }
+        continue;
+      }
+
+      int cmp = basics::VelocyPackHelper::compare(sample, value, true);
+      switch (it.first) {
+        case arangodb::aql::NODE_TYPE_OPERATOR_BINARY_EQ:
+          if (cmp != 0) {
+            return false;
+          }
+          break;
+        case arangodb::aql::NODE_TYPE_OPERATOR_BINARY_LT:
+          if (cmp >= 0) {
+            return false;
+          }
+          break;
+        case arangodb::aql::NODE_TYPE_OPERATOR_BINARY_LE:
+          if (cmp > 0) {
+            return false;
+          }
+          break;
+        case arangodb::aql::NODE_TYPE_OPERATOR_BINARY_GT:
+          if (cmp <= 0) {
+            return false;
+          }
+          break;
+        case arangodb::aql::NODE_TYPE_OPERATOR_BINARY_GE:
+          if (cmp < 0) {
+            return false;
+          }
+          break;
+        default:
+          break;
+      }
+    }
+    return true;
+  };
+
+  if (!_valueSample.estimate(predicate, fraction)) {
+    return false;
+  }
+
+  // the caller multiplies the costs by the number of IN values
+  fraction /= static_cast<double>(values);
+  return true;
+}
+
 bool MMFilesSkiplistIndex::supportsSortCondition(
     arangodb::aql::SortCondition const* sortCondition,
     arangodb::aql::Variable const* reference, size_t itemsInIndex,
@@ -27,6 +27,7 @@
 #include "Basics/Common.h"
 #include "Aql/AstNode.h"
 #include "Indexes/IndexIterator.h"
+#include "Indexes/IndexValueSample.h"
 #include "MMFiles/MMFilesIndexElement.h"
 #include "MMFiles/MMFilesPathBasedIndex.h"
 #include "MMFiles/MMFilesSkiplist.h"
@@ -159,6 +160,30 @@ class MMFilesSkiplistInLookupBuilder final : public MMFilesBaseSkiplistLookupBui
     void buildSearchValues();
 };
 
+/// @brief compares a lookup key with an element of a skiplist index
+struct MMFilesSkiplistKeyElementComparator {
+  int operator()(void* userData, VPackSlice const* leftKey,
+                 MMFilesSkiplistIndexElement const* rightElement) const;
+
+  explicit MMFilesSkiplistKeyElementComparator(MMFilesSkiplistIndex* idx) : _idx(idx) {}
+
+ private:
+  MMFilesSkiplistIndex* _idx;
+};
+
+/// @brief compares two elements of a skiplist index
+struct MMFilesSkiplistElementElementComparator {
+  int operator()(void* userData, 
+                 MMFilesSkiplistIndexElement const* leftElement,
+                 MMFilesSkiplistIndexElement const* rightElement,
+                 MMFilesSkiplistCmpType cmptype) const;
+
+  explicit MMFilesSkiplistElementElementComparator(MMFilesSkiplistIndex* idx) : _idx(idx) {}
+
+ private:
+  MMFilesSkiplistIndex* _idx;
+};
+
 /// @brief Iterator structure for skip list. We require a start and stop node
 ///
 /// Intervals are open in the sense that both end points are not members
@@ -171,7 +196,9 @@ class MMFilesSkiplistIterator final : public IndexIterator {
   // Shorthand for the skiplist node
   typedef MMFilesSkiplistNode<VPackSlice, MMFilesSkiplistIndexElement> Node;
 
-  typedef MMFilesSkiplist<VPackSlice, MMFilesSkiplistIndexElement> TRI_Skiplist;
+  typedef MMFilesSkiplist<VPackSlice, MMFilesSkiplistIndexElement,
+                          MMFilesSkiplistElementElementComparator,
+                          MMFilesSkiplistKeyElementComparator> TRI_Skiplist;
 
  private:
 
@@ -188,16 +215,17 @@ class MMFilesSkiplistIterator final : public IndexIterator {
 
   MMFilesBaseSkiplistLookupBuilder* _builder;
 
-  std::function<int(void*, MMFilesSkiplistIndexElement const*, MMFilesSkiplistIndexElement const*,
-                    MMFilesSkiplistCmpType)> _CmpElmElm;
+  // buffer for the indexed values produced by nextExtra
+  arangodb::velocypack::Builder _extra;
+
+  MMFilesSkiplistElementElementComparator const _CmpElmElm;
 
  public:
   MMFilesSkiplistIterator(LogicalCollection* collection, transaction::Methods* trx,
       ManagedDocumentResult* mmdr,
       arangodb::MMFilesSkiplistIndex const* index,
       TRI_Skiplist const* skiplist, size_t numPaths,
-      std::function<int(void*, MMFilesSkiplistIndexElement const*, MMFilesSkiplistIndexElement const*,
-                        MMFilesSkiplistCmpType)> const& CmpElmElm,
+      MMFilesSkiplistElementElementComparator const& CmpElmElm,
       bool reverse, MMFilesBaseSkiplistLookupBuilder* builder);
 
   ~MMFilesSkiplistIterator() {
@@ -216,6 +244,13 @@ class MMFilesSkiplistIterator final : public IndexIterator {
   /// @brief Get the next elements in the skiplist
   bool next(TokenCallback const& cb, size_t limit) override;
 
+  /// @brief the skiplist index can produce the indexed values of each element
+  bool hasExtra() const override { return true; }
+
+  /// @brief Get the next elements in the skiplist, together with an array
+  /// of their indexed values
+  bool nextExtra(ExtraCallback const& cb, size_t limit) override;
+
   /// @brief Reset the cursor
   void reset() override;
   
@@ -238,32 +273,12 @@ class MMFilesSkiplistIterator final : public IndexIterator {
 };
 
 class MMFilesSkiplistIndex final : public MMFilesPathBasedIndex {
-  struct KeyElementComparator {
-    int operator()(void* userData, VPackSlice const* leftKey,
-                   MMFilesSkiplistIndexElement const* rightElement) const;
-
-    explicit KeyElementComparator(MMFilesSkiplistIndex* idx) { _idx = idx; }
-
-   private:
-    MMFilesSkiplistIndex* _idx;
-  };
-
-  struct ElementElementComparator {
-    int operator()(void* userData, 
-                   MMFilesSkiplistIndexElement const* leftElement,
-                   MMFilesSkiplistIndexElement const* rightElement,
-                   MMFilesSkiplistCmpType cmptype) const;
-
-    explicit ElementElementComparator(MMFilesSkiplistIndex* idx) { _idx = idx; }
-
-   private:
-    MMFilesSkiplistIndex* _idx;
-  };
+  friend struct MMFilesSkiplistKeyElementComparator;
+  friend struct MMFilesSkiplistElementElementComparator;
 
-  friend struct KeyElementComparator;
-  friend struct ElementElementComparator;
-
-  typedef MMFilesSkiplist<VPackSlice, MMFilesSkiplistIndexElement> TRI_Skiplist;
+  typedef MMFilesSkiplist<VPackSlice, MMFilesSkiplistIndexElement,
+                          MMFilesSkiplistElementElementComparator,
+                          MMFilesSkiplistKeyElementComparator> TRI_Skiplist;
 
  public:
   MMFilesSkiplistIndex() = delete;
@@ -294,6 +309,13 @@ class MMFilesSkiplistIndex final : public MMFilesPathBasedIndex {
   int insert(transaction::Methods*, TRI_voc_rid_t, arangodb::velocypack::Slice const&, bool isRollback) override;
 
   int remove(transaction::Methods*, TRI_voc_rid_t, arangodb::velocypack::Slice const&, bool isRollback) override;
+
+  void batchInsert(
+      transaction::Methods*,
+      std::vector<std::pair<TRI_voc_rid_t, arangodb::velocypack::Slice>> const&,
+      arangodb::basics::LocalTaskQueue* queue = nullptr) override;
+
+  bool hasBatchInsert() const override { return true; }
   
   int unload() override;
 
@@ -342,6 +364,12 @@ class MMFilesSkiplistIndex final : public MMFilesPathBasedIndex {
       arangodb::aql::AstNode const*, arangodb::aql::Variable const*,
       std::vector<std::vector<arangodb::aql::AstNode const*>>&, bool&) const;
 
+  /// @brief estimate the fraction of index entries that satisfy all given
+  /// conditions on the first index attribute, using the value sample.
+  /// returns false if no estimate is possible
+  bool estimateFraction(std::vector<arangodb::aql::AstNode const*> const&,
+                        arangodb::aql::Variable const*, double&) const;
+
   /// @brief Checks if the interval is valid. It is declared invalid if
   ///        one border is nullptr or the right is lower than left.
   // Shorthand for the skiplist node
@@ -351,12 +379,16 @@ class MMFilesSkiplistIndex final : public MMFilesPathBasedIndex {
 
  private:
 
-  ElementElementComparator CmpElmElm;
+  MMFilesSkiplistElementElementComparator CmpElmElm;
 
-  KeyElementComparator CmpKeyElm;
+  MMFilesSkiplistKeyElementComparator CmpKeyElm;
 
   /// @brief the actual skiplist index
   TRI_Skiplist* _skiplistIndex;
+
+  /// @brief sample of the values of the first index attribute, used for
+  /// cost estimates. not maintained for array indexes
+  IndexValueSample _valueSample;
 };
 }
 
@@ -46,11 +46,19 @@ static constexpr inline uint64_t syncWaitersMask() {
 static constexpr inline int asyncWaitersBits() { return 32; }
 
 MMFilesSynchronizerThread::MMFilesSynchronizerThread(MMFilesLogfileManager* logfileManager,
-                                       uint64_t syncInterval)
+                                       uint64_t syncInterval,
+                                       uint64_t groupCommitWindow)
     : Thread("WalSynchronizer"),
       _logfileManager(logfileManager),
       _condition(),
       _syncInterval(syncInterval),
+      _groupCommitWindow(groupCommitWindow),
+      _syncLatency(0.0),
+      _lastGroupSize(0),
+      _numGroups(0),
+      _numGroupWaiters(0),
+      _maxGroupSize(0),
+      _syncLatencyReported(0),
       _logfileCache({0, -1}),
       _waiting(0) {}
 
@@ -77,6 +85,73 @@ void MMFilesSynchronizerThread::signalSync(bool waitForSync) {
   }
 }
 
+/// @brief return group commit statistics
+void MMFilesSynchronizerThread::groupCommitStatistics(
+    uint64_t& numGroups, uint64_t& numWaiters, uint64_t& maxGroupSize,
+    double& syncLatency) const {
+  numGroups = _numGroups.load();
+  numWaiters = _numGroupWaiters.load();
+  maxGroupSize = _maxGroupSize.load();
+  syncLatency = static_cast<double>(_syncLatencyReported.load()) / 1000000.0;
+}
+
+/// @brief wait for more synchronous writers to join the next sync.
+/// the window adapts to the observed sync latency: writers arriving while
+/// we wait for as long as a sync takes would otherwise have to wait for
+/// a full sync of their own after the current one. if the previous sync
+/// only served a single writer, there is no concurrency to exploit and
+/// the sync is done right away
+void MMFilesSynchronizerThread::waitForGroup() {
+  uint64_t const window =
+      groupCommitWait(_groupCommitWindow, _lastGroupSize, _syncLatency);
+
+  if (window == 0 || isStopping()) {
+    return;
+  }
+
+  // no one will signal us during the window, because signalSync only
+  // signals if there were no synchronous waiters before. only shutdown
+  // does, which is fine
+  CONDITION_LOCKER(guard, _condition);
+  guard.wait(window);
+}
+
+/// @brief how long to wait for more synchronous writers before the next sync
+uint64_t MMFilesSynchronizerThread::groupCommitWait(uint64_t groupCommitWindow,
+                                                    uint64_t lastGroupSize,
+                                                    double syncLatency) {
+  if (groupCommitWindow == 0 || lastGroupSize <= 1) {
+    return 0;
+  }
+  return (std::min)(groupCommitWindow, static_cast<uint64_t>(syncLatency));
+}
+
+/// @brief the moving average of the sync latency after a sync
+double MMFilesSynchronizerThread::averageSyncLatency(double syncLatency,
+                                                     double elapsed) {
+  if (syncLatency == 0.0) {
+    return elapsed;
+  }
+  return 0.8 * syncLatency + 0.2 * elapsed;
+}
+
+/// @brief record the size of a group of synced waiters
+void MMFilesSynchronizerThread::trackGroup(uint64_t numWaiters) {
+  _lastGroupSize = numWaiters;
+
+  if (numWaiters == 0) {
+    return;
+  }
+
+  ++_numGroups;
+  _numGroupWaiters += numWaiters;
+
+  uint64_t maxGroupSize = _maxGroupSize.load();
+  while (numWaiters > maxGroupSize &&
+         !_maxGroupSize.compare_exchange_weak(maxGroupSize, numWaiters)) {
+  }
+}
+
 /// @brief main loop
 void MMFilesSynchronizerThread::run() {
   // fetch initial value for waiting
@@ -89,6 +164,16 @@ void MMFilesSynchronizerThread::run() {
     if (waitingWithoutSync > 0 || waitingWithSync > 0 || ++iterations == 10) {
       iterations = 0;
 
+      if (waitingWithSync > 0 && _groupCommitWindow > 0) {
+        waitForGroup();
+
+        // all waiters that have signaled us by now have returned their
+        // slots already, so they will be served by the following sync
+        waitingValue = _waiting;
+        waitingWithoutSync = waitingValue >> asyncWaitersBits();
+        waitingWithSync = (waitingValue & syncWaitersMask());
+      }
+
       try {
         // sync as much as we can in this loop
         bool checkMore = false;
@@ -107,6 +192,8 @@ void MMFilesSynchronizerThread::run() {
       } catch (...) {
         LOG_TOPIC(ERR, arangodb::Logger::FIXME) << "got unspecific error in synchronizerThread";
       }
+
+      trackGroup(waitingWithSync);
     }
 
     // update value of waiting
@@ -163,7 +250,13 @@ int MMFilesSynchronizerThread::doSync(bool& checkMore) {
 
   double startTime = TRI_microtime();
   bool result = TRI_MSync(fd, region.mem, region.mem + region.size);
-  if (TRI_microtime() - startTime > 1.0) {
+  double const elapsed = TRI_microtime() - startTime;
+
+  // keep track of the sync latency for sizing the group commit window
+  _syncLatency = averageSyncLatency(_syncLatency, elapsed * 1000000.0);
+  _syncLatencyReported = static_cast<uint64_t>(_syncLatency);
+
+  if (elapsed > 1.0) {
     LOG_TOPIC(DEBUG, arangodb::Logger::FIXME) << "Long sync logfile " << id << ", region "
       << (void*) region.mem << ", size " << region.size;
   }
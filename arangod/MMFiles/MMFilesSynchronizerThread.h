@@ -39,7 +39,7 @@ class MMFilesSynchronizerThread final : public Thread {
   MMFilesSynchronizerThread& operator=(MMFilesSynchronizerThread const&) = delete;
 
  public:
-  MMFilesSynchronizerThread(MMFilesLogfileManager*, uint64_t);
+  MMFilesSynchronizerThread(MMFilesLogfileManager*, uint64_t, uint64_t);
   ~MMFilesSynchronizerThread() { shutdown(); }
 
  public:
@@ -49,6 +49,20 @@ class MMFilesSynchronizerThread final : public Thread {
   /// @brief signal that a sync is needed
   void signalSync(bool waitForSync);
 
+  /// @brief return group commit statistics
+  void groupCommitStatistics(uint64_t& numGroups, uint64_t& numWaiters,
+                             uint64_t& maxGroupSize, double& syncLatency) const;
+
+  /// @brief how long (in microseconds) to wait for more synchronous writers
+  /// before the next sync, given the configured window, the number of
+  /// waiters of the previous sync and the average sync latency
+  static uint64_t groupCommitWait(uint64_t groupCommitWindow,
+                                  uint64_t lastGroupSize, double syncLatency);
+
+  /// @brief the moving average of the sync latency (in microseconds) after
+  /// a sync that took elapsed microseconds
+  static double averageSyncLatency(double syncLatency, double elapsed);
+
  protected:
   void run() override;
 
@@ -59,6 +73,12 @@ class MMFilesSynchronizerThread final : public Thread {
   /// @brief get a logfile descriptor (it caches the descriptor for performance)
   int getLogfileDescriptor(MMFilesWalLogfile::IdType);
 
+  /// @brief wait for more synchronous writers to join the next sync
+  void waitForGroup();
+
+  /// @brief record the size of a group of synced waiters
+  void trackGroup(uint64_t numWaiters);
+
  private:
   /// @brief the logfile manager
   MMFilesLogfileManager* _logfileManager;
@@ -69,6 +89,23 @@ class MMFilesSynchronizerThread final : public Thread {
   /// @brief wait interval for the synchronizer thread when idle
   uint64_t const _syncInterval;
 
+  /// @brief maximum time (in microseconds) to wait for more synchronous
+  /// writers before syncing. 0 turns off group commits
+  uint64_t const _groupCommitWindow;
+
+  /// @brief moving average of the time (in microseconds) a sync takes.
+  /// only accessed by the synchronizer thread itself
+  double _syncLatency;
+
+  /// @brief number of waiters synced by the previous sync
+  uint64_t _lastGroupSize;
+
+  /// @brief group commit statistics
+  std::atomic<uint64_t> _numGroups;
+  std::atomic<uint64_t> _numGroupWaiters;
+  std::atomic<uint64_t> _maxGroupSize;
+  std::atomic<uint64_t> _syncLatencyReported;
+
   /// @brief logfile descriptor cache
   struct {
     MMFilesWalLogfile::IdType id;
@@ -33,10 +33,8 @@ MMFilesTransactionContextData::MMFilesTransactionContextData()
 
 MMFilesTransactionContextData::~MMFilesTransactionContextData() {
   for (auto& it : _ditches) {
-    // we're done with this ditch
-    auto& ditch = it.second;
-    ditch->ditches()->freeMMFilesDocumentDitch(ditch, true /* fromTransaction */);
-    // If some external entity is still using the ditch, it is kept!
+    // we're done with the documents of this collection
+    it.second->releaseDocuments();
   }
 }
 
@@ -52,27 +50,14 @@ void MMFilesTransactionContextData::pinData(LogicalCollection* collection) {
   auto it = _ditches.find(cid);
 
   if (it != _ditches.end()) {
-    // tell everyone else this ditch is still in use,
-    // at least until the transaction is over
-    TRI_ASSERT((*it).second->usedByTransaction());
-    // ditch already exists
+    // already pinned, at least until the transaction is over
     return;
   }
 
-  // this method will not throw, but may return a nullptr
-  auto ditch = arangodb::MMFilesCollection::toMMFilesCollection(collection)->ditches()->createMMFilesDocumentDitch(true, __FILE__, __LINE__);
-
-  if (ditch == nullptr) {
-    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
-  }
-
-  try {
-    _ditches.emplace(cid, ditch);
-  }
-  catch (...) {
-    ditch->ditches()->freeMMFilesDocumentDitch(ditch, true);
-    throw;
-  }
+  // pinning only counts the reference, there is no ditch to allocate
+  auto ditches = arangodb::MMFilesCollection::toMMFilesCollection(collection)->ditches();
+  _ditches.emplace(cid, ditches);
+  ditches->pinDocuments();
 
   _lastPinnedCid = cid;
 }
@@ -30,7 +30,7 @@
                                 
 namespace arangodb {
 class LogicalCollection;
-class MMFilesDocumentDitch;
+class MMFilesDitches;
 
 /// @brief transaction type
 class MMFilesTransactionContextData final : public transaction::ContextData {
@@ -45,7 +45,8 @@ class MMFilesTransactionContextData final : public transaction::ContextData {
   bool isPinned(TRI_voc_cid_t) const override;
   
  private:
-  std::unordered_map<TRI_voc_cid_t, MMFilesDocumentDitch*> _ditches;
+  /// @brief ditches of the collections whose documents are pinned
+  std::unordered_map<TRI_voc_cid_t, MMFilesDitches*> _ditches;
 
   TRI_voc_cid_t _lastPinnedCid;
 };
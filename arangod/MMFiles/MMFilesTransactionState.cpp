@@ -25,13 +25,21 @@
 #include "Aql/QueryCache.h"
 #include "Logger/Logger.h"
 #include "Basics/Exceptions.h"
+#include "Cache/CacheManagerFeature.h"
+#include "Cache/Manager.h"
 #include "MMFiles/MMFilesCollection.h"
 #include "MMFiles/MMFilesDatafileHelper.h"
+#include "MMFiles/MMFilesDocumentCompression.h"
 #include "MMFiles/MMFilesDocumentOperation.h"
+#include "MMFiles/MMFilesEngine.h"
 #include "MMFiles/MMFilesLogfileManager.h"
 #include "MMFiles/MMFilesPersistentIndexFeature.h"
+#include "MMFiles/MMFilesPersistentIndexKeyComparator.h"
+#include "MMFiles/MMFilesRevisionHistory.h"
 #include "MMFiles/MMFilesTransactionCollection.h"
+#include "StorageEngine/EngineSelectorFeature.h"
 #include "StorageEngine/TransactionCollection.h"
+#include "Transaction/Helpers.h"
 #include "Transaction/Methods.h"
 #include "VocBase/LogicalCollection.h"
 #include "VocBase/modes.h"
@@ -40,7 +48,7 @@
 #include <rocksdb/db.h>
 #include <rocksdb/options.h>
 #include <rocksdb/utilities/optimistic_transaction_db.h>
-#include <rocksdb/utilities/transaction.h>
+#include <rocksdb/utilities/write_batch_with_index.h>
 
 using namespace arangodb;
 
@@ -49,25 +57,98 @@ static inline MMFilesLogfileManager* GetMMFilesLogfileManager() {
   return MMFilesLogfileManager::instance();
 }
 
+/// @brief invalidate the query cache for a modified document. an empty key
+/// invalidates all results for the collection
+static void InvalidateQueryCache(TRI_vocbase_t* vocbase,
+                                 std::string const& collection,
+                                 std::string const& key) {
+  if (key.empty()) {
+    arangodb::aql::QueryCache::instance()->invalidate(vocbase, collection);
+  } else {
+    arangodb::aql::QueryCache::instance()->invalidate(
+        vocbase, collection, std::unordered_set<std::string>{key});
+  }
+}
+
 /// @brief transaction type
 MMFilesTransactionState::MMFilesTransactionState(TRI_vocbase_t* vocbase)
     : TransactionState(vocbase),
-      _rocksTransaction(nullptr),
+      _rocksBatch(nullptr),
+      _cacheManager(nullptr),
+      _cacheTransaction(nullptr),
       _beginWritten(false),
-      _hasOperations(false) {}
+      _hasOperations(false),
+      _snapshotTick(0) {}
 
 /// @brief free a transaction container
 MMFilesTransactionState::~MMFilesTransactionState() {
-  delete _rocksTransaction;
+  for (auto const& it : _historyKeys) {
+    // entries of a transaction that was neither committed nor aborted
+    it.first->abort(_id, it.second);
+  }
+  endCacheTransaction();
+  releaseSnapshot();
+  delete _rocksBatch;
+}
+
+/// @brief get (or create) the rocksdb write batch of the transaction
+rocksdb::WriteBatchWithIndex* MMFilesTransactionState::rocksBatch() {
+  if (_rocksBatch == nullptr) {
+    // the batch must order keys like the database does, so that iterators
+    // over the batch and the database can be merged. overwrite_key is
+    // required for such iterators
+    _rocksBatch = new rocksdb::WriteBatchWithIndex(
+        MMFilesPersistentIndexFeature::instance()->comparator(), 0, true);
+  }
+  return _rocksBatch;
+}
+
+/// @brief write the collected persistent index changes to rocksdb
+int MMFilesTransactionState::writeRocksBatch() {
+  if (_rocksBatch == nullptr || _rocksBatch->GetWriteBatch()->Count() == 0) {
+    return TRI_ERROR_NO_ERROR;
+  }
+
+  auto status = MMFilesPersistentIndexFeature::instance()->db()->GetBaseDB()->Write(
+      rocksdb::WriteOptions(), _rocksBatch->GetWriteBatch());
+  _rocksBatch->Clear();
+
+  if (!status.ok()) {
+    LOG_TOPIC(ERR, arangodb::Logger::FIXME)
+        << "writing persistent index changes failed: " << status.ToString();
+    return TRI_ERROR_INTERNAL;
+  }
+  return TRI_ERROR_NO_ERROR;
+}
+
+/// @brief make sure a cache transaction is open. must be called before
+/// reading from or writing to an index with a transactional cache, so
+/// that no stale values can be stored in the cache
+void MMFilesTransactionState::useCacheTransaction() {
+  if (_cacheTransaction == nullptr && CacheManagerFeature::MANAGER != nullptr) {
+    _cacheManager = CacheManagerFeature::MANAGER;
+    _cacheTransaction = _cacheManager->beginTransaction(
+        !AccessMode::isWriteOrExclusive(_type));
+  }
 }
 
-/// @brief get (or create) a rocksdb WriteTransaction
-rocksdb::Transaction* MMFilesTransactionState::rocksTransaction() {
-  if (_rocksTransaction == nullptr) {
-    _rocksTransaction = MMFilesPersistentIndexFeature::instance()->db()->BeginTransaction(
-      rocksdb::WriteOptions(), rocksdb::OptimisticTransactionOptions());
+/// @brief end the cache transaction, if any
+void MMFilesTransactionState::endCacheTransaction() {
+  if (_cacheTransaction != nullptr) {
+    TRI_ASSERT(_cacheManager != nullptr);
+    _cacheManager->endTransaction(_cacheTransaction);
+    _cacheTransaction = nullptr;
   }
-  return _rocksTransaction;
+}
+
+/// @brief release the snapshot, if any
+void MMFilesTransactionState::releaseSnapshot() {
+  if (_snapshotTick != 0) {
+    MMFilesSnapshots::release(_snapshotTick);
+    _snapshotTick = 0;
+  }
+  // the documents read from the snapshot are kept until the transaction
+  // is destroyed, as results may still point to them after the commit
 }
   
 /// @brief start a transaction
@@ -103,6 +184,14 @@ int MMFilesTransactionState::beginTransaction(transaction::Hints hints) {
     // get a new id
     _id = TRI_NewTickServer();
 
+    if (isReadOnlyTransaction() &&
+        hasHint(transaction::Hints::Hint::SNAPSHOT) &&
+        static_cast<MMFilesEngine*>(EngineSelectorFeature::ENGINE)
+            ->useSnapshotReads()) {
+      // read all documents as of now, regardless of later writers
+      _snapshotTick = MMFilesSnapshots::acquire();
+    }
+
     // register a protector
     int res = logfileManager->registerTransaction(_id, isReadOnlyTransaction());
  
@@ -143,19 +232,17 @@ int MMFilesTransactionState::commitTransaction(transaction::Methods* activeTrx)
   TRI_ASSERT(_status == transaction::Status::RUNNING);
 
   int res = TRI_ERROR_NO_ERROR;
+  TRI_voc_tick_t syncTick = 0;
 
   if (_nestingLevel == 0) {
-    if (_rocksTransaction != nullptr) {
-      auto status = _rocksTransaction->Commit();
+    res = writeRocksBatch();
 
-      if (!status.ok()) {
-        res = TRI_ERROR_INTERNAL;
-        abortTransaction(activeTrx);
-        return res;
-      }
+    if (res != TRI_ERROR_NO_ERROR) {
+      abortTransaction(activeTrx);
+      return res;
     }
 
-    res = writeCommitMarker();
+    res = writeCommitMarker(syncTick);
 
     if (res != TRI_ERROR_NO_ERROR) {
       // TODO: revert rocks transaction somehow
@@ -167,6 +254,15 @@ int MMFilesTransactionState::commitTransaction(transaction::Methods* activeTrx)
 
     updateStatus(transaction::Status::COMMITTED);
 
+    // make the previous revisions recorded by the transaction invisible to
+    // new snapshots
+    MMFilesSnapshots::commit(_id, _historyKeys);
+    _historyKeys.clear();
+
+    if (AccessMode::isWriteOrExclusive(_type)) {
+      increaseModificationEpochs();
+    }
+
     // if a write query, clear the query cache for the participating collections
     if (AccessMode::isWriteOrExclusive(_type) &&
         !_collections.empty() &&
@@ -175,10 +271,22 @@ int MMFilesTransactionState::commitTransaction(transaction::Methods* activeTrx)
     }
 
     freeOperations(activeTrx);
+    endCacheTransaction();
+    releaseSnapshot();
   }
 
+  // release the collection locks before waiting for the disk sync, so that
+  // other writers to the same collections do not queue up behind the fsync.
+  // the WAL is written in order, so any transaction that sees our changes
+  // has its own commit marker written behind ours
   unuseCollections(_nestingLevel);
 
+  if (syncTick > 0) {
+    // the transaction is committed even if this fails, but the caller must
+    // not assume that it is durable
+    res = waitForCommitSync(syncTick);
+  }
+
   return res;
 }
 
@@ -202,6 +310,20 @@ int MMFilesTransactionState::abortTransaction(transaction::Methods* activeTrx) {
     }
 
     freeOperations(activeTrx);
+
+    // the modifications are undone now, so snapshots can read the current
+    // revisions again
+    for (auto const& it : _historyKeys) {
+      it.first->abort(_id, it.second);
+    }
+    _historyKeys.clear();
+
+    if (_hasOperations) {
+      // the rolled back operations may have been seen by traversals
+      increaseModificationEpochs();
+    }
+    endCacheTransaction();
+    releaseSnapshot();
   }
 
   unuseCollections(_nestingLevel);
@@ -217,6 +339,20 @@ int MMFilesTransactionState::addOperation(TRI_voc_rid_t revisionId,
   LogicalCollection* collection = operation.collection();
   bool const isSingleOperationTransaction = isSingleOperation();
 
+  // the key of the modified document, for the key-based invalidation of
+  // the query cache
+  std::string key;
+  if (!hasHint(transaction::Hints::Hint::RECOVERY) &&
+      arangodb::aql::QueryCache::instance()->invalidationMode() ==
+          arangodb::aql::INVALIDATE_KEYS) {
+    VPackBuffer<uint8_t> buffer;
+    VPackSlice keySlice = transaction::helpers::extractKeyFromDocument(
+        MMFilesDocumentCompression::document(marker->vpack(), buffer));
+    if (keySlice.isString()) {
+      key = keySlice.copyString();
+    }
+  }
+
   if (hasHint(transaction::Hints::Hint::RECOVERY)) {
     // turn off all waitForSync operations during recovery
     waitForSync = false;
@@ -308,17 +444,16 @@ int MMFilesTransactionState::addOperation(TRI_voc_rid_t revisionId,
 
   if (isSingleOperationTransaction) {
     // operation is directly executed
-    if (_rocksTransaction != nullptr) {
-      auto status = _rocksTransaction->Commit();
+    int res = writeRocksBatch();
 
-      if (!status.ok()) { 
-        // TODO: what to do here?
-      }
+    if (res != TRI_ERROR_NO_ERROR) {
+      // the operation is not handled, so the caller reverts it
+      return res;
     }
+
     operation.handled();
 
-    arangodb::aql::QueryCache::instance()->invalidate(
-        _vocbase, collection->name());
+    InvalidateQueryCache(_vocbase, collection->name(), key);
 
     physical->increaseUncollectedLogfileEntries(1);
   } else {
@@ -343,8 +478,8 @@ int MMFilesTransactionState::addOperation(TRI_voc_rid_t revisionId,
     operation.swapped();
     _hasOperations = true;
     
-    arangodb::aql::QueryCache::instance()->invalidate(
-        _vocbase, collection->name());
+    trackModifiedKey(collection->name(), key);
+    InvalidateQueryCache(_vocbase, collection->name(), key);
   }
 
   physical->setRevision(revisionId, false);
@@ -450,7 +585,7 @@ int MMFilesTransactionState::writeAbortMarker() {
 }
 
 /// @brief write WAL commit marker
-int MMFilesTransactionState::writeCommitMarker() {
+int MMFilesTransactionState::writeCommitMarker(TRI_voc_tick_t& syncTick) {
   if (!needWriteMarker(false)) {
     return TRI_ERROR_NO_ERROR;
   }
@@ -463,17 +598,17 @@ int MMFilesTransactionState::writeCommitMarker() {
 
   try {
     MMFilesTransactionMarker marker(TRI_DF_MARKER_VPACK_COMMIT_TRANSACTION, _vocbase->id(), _id);
-    res = GetMMFilesLogfileManager()->allocateAndWrite(marker, _waitForSync).errorCode;
+    // request the sync, but do not wait for it here. the caller waits
+    // after giving up the collection locks
+    auto slotInfo = GetMMFilesLogfileManager()->allocateAndWrite(&marker, true, _waitForSync, false);
+    res = slotInfo.errorCode;
     
     TRI_IF_FAILURE("TransactionWriteCommitMarkerSegfault") { 
       TRI_SegfaultDebugging("crashing on commit");
     }
 
-    TRI_IF_FAILURE("TransactionWriteCommitMarkerNoRocksSync") { return TRI_ERROR_NO_ERROR; }
-
-    if (_waitForSync) {
-      // also sync RocksDB WAL
-      MMFilesPersistentIndexFeature::syncWal();
+    if (res == TRI_ERROR_NO_ERROR && _waitForSync) {
+      syncTick = static_cast<TRI_voc_tick_t>(slotInfo.tick);
     }
     
     TRI_IF_FAILURE("TransactionWriteCommitMarkerThrow") { 
@@ -494,6 +629,35 @@ int MMFilesTransactionState::writeCommitMarker() {
     LOG_TOPIC(WARN, arangodb::Logger::FIXME) << "could not save transaction commit marker in log: unknown exception";
   }
 
+  if (res != TRI_ERROR_NO_ERROR) {
+    syncTick = 0;
+  }
+
   return res;
 }
 
+/// @brief wait until the commit marker with the given tick is on disk
+int MMFilesTransactionState::waitForCommitSync(TRI_voc_tick_t syncTick) {
+  return waitForCommitSync(GetMMFilesLogfileManager()->slots(), syncTick, 30.0);
+}
+
+/// @brief wait until the commit marker with the given tick is on disk,
+/// waiting at most maxWait seconds
+int MMFilesTransactionState::waitForCommitSync(MMFilesWalSlots* slots,
+                                               TRI_voc_tick_t syncTick,
+                                               double maxWait) {
+  if (!slots->waitForTick(syncTick, maxWait)) {
+    LOG_TOPIC(WARN, arangodb::Logger::FIXME)
+        << "timed out waiting for transaction commit marker to be synced";
+    return TRI_ERROR_ARANGO_SYNC_TIMEOUT;
+  }
+
+  TRI_IF_FAILURE("TransactionWriteCommitMarkerNoRocksSync") {
+    return TRI_ERROR_NO_ERROR;
+  }
+
+  // also sync RocksDB WAL
+  MMFilesPersistentIndexFeature::syncWal();
+  return TRI_ERROR_NO_ERROR;
+}
+
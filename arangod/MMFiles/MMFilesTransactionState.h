@@ -31,17 +31,28 @@
 #include "Transaction/Hints.h"
 #include "VocBase/AccessMode.h"
 #include "VocBase/voc-types.h"
+
+#include <velocypack/Buffer.h>
                                 
 struct TRI_vocbase_t;
 
 namespace rocksdb {
-class Transaction;
+class WriteBatchWithIndex;
+}
+
+namespace arangodb {
+namespace cache {
+class Manager;
+struct Transaction;
+}
 }
 
 namespace arangodb {
 class LogicalCollection;
 struct MMFilesDocumentOperation;
+class MMFilesRevisionHistory;
 class MMFilesWalMarker;
+class MMFilesWalSlots;
 namespace transaction {
 class Methods;
 }
@@ -77,8 +88,41 @@ class MMFilesTransactionState final : public TransactionState {
     return _id;
   }
   
-  /// @brief get (or create) a rocksdb WriteTransaction
-  rocksdb::Transaction* rocksTransaction();
+  /// @brief get (or create) the rocksdb write batch that collects the
+  /// persistent index changes of the transaction. the batch is written
+  /// atomically when the transaction commits, and discarded otherwise.
+  /// writes to a collection are serialized by the collection lock, so no
+  /// conflict detection is needed for them
+  rocksdb::WriteBatchWithIndex* rocksBatch();
+
+  /// @brief make sure a cache transaction is open. must be called before
+  /// reading from or writing to an index with a transactional cache, so
+  /// that no stale values can be stored in the cache
+  void useCacheTransaction();
+
+  /// @brief the tick of the snapshot the transaction reads from, 0 if it
+  /// reads the current state
+  TRI_voc_tick_t snapshotTick() const { return _snapshotTick; }
+
+  /// @brief keep a previous revision of a document read from the snapshot
+  /// alive as long as the transaction
+  void keepSnapshotDocument(
+      std::shared_ptr<velocypack::Buffer<uint8_t>> const& document) {
+    _snapshotDocuments.emplace_back(document);
+  }
+
+  /// @brief register a key for which the transaction has recorded the
+  /// previous revision, so that the entry can be committed or aborted
+  /// together with the transaction
+  void addHistoryKey(MMFilesRevisionHistory* history, std::string&& key) {
+    _historyKeys.emplace_back(history, std::move(key));
+  }
+
+  /// @brief wait until the commit marker with the given tick is on disk,
+  /// waiting at most maxWait seconds. returns TRI_ERROR_ARANGO_SYNC_TIMEOUT
+  /// if it was not synced in time
+  static int waitForCommitSync(MMFilesWalSlots* slots, TRI_voc_tick_t syncTick,
+                               double maxWait);
 
  private:
   /// @brief whether or not a marker needs to be written
@@ -97,16 +141,36 @@ class MMFilesTransactionState final : public TransactionState {
   /// @brief write WAL abort marker
   int writeAbortMarker();
 
-  /// @brief write WAL commit marker
-  int writeCommitMarker();
+  /// @brief write WAL commit marker. if the transaction must be synced,
+  /// syncTick is set to the tick the caller has to wait for
+  int writeCommitMarker(TRI_voc_tick_t& syncTick);
+
+  /// @brief wait until the commit marker with the given tick is on disk.
+  /// returns TRI_ERROR_ARANGO_SYNC_TIMEOUT if it was not synced in time
+  int waitForCommitSync(TRI_voc_tick_t syncTick);
 
   /// @brief free all operations for a transaction
   void freeOperations(transaction::Methods* activeTrx);
+
+  /// @brief end the cache transaction, if any
+  void endCacheTransaction();
+
+  /// @brief release the snapshot, if any
+  void releaseSnapshot();
+
+  /// @brief write the persistent index changes collected so far to rocksdb
+  /// and clear the write batch
+  int writeRocksBatch();
   
  private:
-  rocksdb::Transaction* _rocksTransaction;
+  rocksdb::WriteBatchWithIndex* _rocksBatch;
+  cache::Manager* _cacheManager;
+  cache::Transaction* _cacheTransaction;
   bool _beginWritten;
   bool _hasOperations;
+  TRI_voc_tick_t _snapshotTick;
+  std::vector<std::shared_ptr<velocypack::Buffer<uint8_t>>> _snapshotDocuments;
+  std::vector<std::pair<MMFilesRevisionHistory*, std::string>> _historyKeys;
 };
 
 }
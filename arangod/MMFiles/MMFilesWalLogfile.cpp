@@ -40,8 +40,8 @@ MMFilesWalLogfile::~MMFilesWalLogfile() {
 
 /// @brief create a new logfile
 MMFilesWalLogfile* MMFilesWalLogfile::createNew(std::string const& filename, MMFilesWalLogfile::IdType id,
-                            uint32_t size) {
-  std::unique_ptr<MMFilesDatafile> df(MMFilesDatafile::create(filename, id, static_cast<TRI_voc_size_t>(size), false));
+                            uint32_t size, std::string const& recycleFrom) {
+  std::unique_ptr<MMFilesDatafile> df(MMFilesDatafile::create(filename, id, static_cast<TRI_voc_size_t>(size), false, recycleFrom));
 
   if (df == nullptr) {
     int res = TRI_errno();
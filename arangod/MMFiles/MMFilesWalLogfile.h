@@ -60,8 +60,9 @@ class MMFilesWalLogfile {
   /// @brief destroy a logfile
   ~MMFilesWalLogfile();
 
-  /// @brief create a new logfile
-  static MMFilesWalLogfile* createNew(std::string const&, MMFilesWalLogfile::IdType, uint32_t);
+  /// @brief create a new logfile, optionally reusing an existing file
+  static MMFilesWalLogfile* createNew(std::string const&, MMFilesWalLogfile::IdType, uint32_t,
+                                      std::string const& recycleFrom = arangodb::StaticStrings::Empty);
 
   /// @brief open an existing logfile
   static MMFilesWalLogfile* openExisting(std::string const&, MMFilesWalLogfile::IdType, bool, bool);
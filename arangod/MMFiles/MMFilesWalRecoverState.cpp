@@ -34,6 +34,7 @@
 #include "RestServer/DatabaseFeature.h"
 #include "MMFiles/MMFilesCollection.h"
 #include "MMFiles/MMFilesDatafileHelper.h"
+#include "MMFiles/MMFilesDocumentCompression.h"
 #include "MMFiles/MMFilesLogfileManager.h"
 #include "MMFiles/MMFilesPersistentIndexFeature.h"
 #include "MMFiles/MMFilesWalSlots.h"
@@ -48,6 +49,8 @@
 #include <velocypack/Parser.h>
 #include <velocypack/velocypack-aliases.h>
 
+#include <thread>
+
 using namespace arangodb;
 
 namespace {
@@ -357,8 +360,11 @@ bool MMFilesWalRecoverState::InitialScanMarker(TRI_df_marker_t const* marker,
 
   switch (type) {
     case TRI_DF_MARKER_VPACK_DOCUMENT: {
-      VPackSlice const payloadSlice(reinterpret_cast<char const*>(marker) +
-                                    MMFilesDatafileHelper::VPackOffset(type));
+      VPackBuffer<uint8_t> buffer;
+      VPackSlice const payloadSlice = MMFilesDocumentCompression::document(
+          reinterpret_cast<uint8_t const*>(marker) +
+              MMFilesDatafileHelper::VPackOffset(type),
+          buffer);
       if (payloadSlice.isObject()) {
         TRI_voc_rid_t revisionId =
             transaction::helpers::extractRevFromDocument(payloadSlice);
@@ -398,6 +404,16 @@ bool MMFilesWalRecoverState::InitialScanMarker(TRI_df_marker_t const* marker,
       break;
     }
 
+    case TRI_DF_MARKER_PROLOGUE: {
+      // note the collection so it can be opened before the replay
+      TRI_voc_tick_t const databaseId =
+          MMFilesDatafileHelper::DatabaseId(marker);
+      TRI_voc_cid_t const collectionId =
+          MMFilesDatafileHelper::CollectionId(marker);
+      state->collectionsToLoad.emplace(collectionId, databaseId);
+      break;
+    }
+
     case TRI_DF_MARKER_VPACK_DROP_DATABASE: {
       // note that the database was dropped and doesn't need to be recovered
       TRI_voc_tick_t const databaseId =
@@ -492,8 +508,13 @@ bool MMFilesWalRecoverState::ReplayMarker(TRI_df_marker_t const* marker,
 
               std::string const collectionName =
                   trx->documentCollection()->name();
-              uint8_t const* ptr = reinterpret_cast<uint8_t const*>(marker) +
-                                   MMFilesDatafileHelper::VPackOffset(type);
+              // the marker may contain the compressed document. the
+              // collection keeps pointing to the marker itself
+              VPackBuffer<uint8_t> buffer;
+              VPackSlice const document = MMFilesDocumentCompression::document(
+                  reinterpret_cast<uint8_t const*>(marker) +
+                      MMFilesDatafileHelper::VPackOffset(type),
+                  buffer);
 
               OperationOptions options;
               options.silent = true;
@@ -503,14 +524,14 @@ bool MMFilesWalRecoverState::ReplayMarker(TRI_df_marker_t const* marker,
               options.ignoreRevs = true;
 
               // try an insert first
-              TRI_ASSERT(VPackSlice(ptr).isObject());
+              TRI_ASSERT(document.isObject());
               OperationResult opRes =
-                  trx->insert(collectionName, VPackSlice(ptr), options);
+                  trx->insert(collectionName, document, options);
               int res = opRes.code;
 
               if (res == TRI_ERROR_ARANGO_UNIQUE_CONSTRAINT_VIOLATED) {
                 // document/edge already exists, now make it a replace
-                opRes = trx->replace(collectionName, VPackSlice(ptr), options);
+                opRes = trx->replace(collectionName, document, options);
                 res = opRes.code;
               }
 
@@ -1258,28 +1279,193 @@ int MMFilesWalRecoverState::removeEmptyLogfiles() {
   return TRI_ERROR_NO_ERROR;
 }
 
-/// @brief fill the secondary indexes of all collections used in recovery
-int MMFilesWalRecoverState::fillIndexes() {
-  // release all collections
-  for (auto it = openedCollections.begin(); it != openedCollections.end();
-       ++it) {
-    arangodb::LogicalCollection* collection = (*it).second;
+/// @brief open all collections referenced in the logfiles before the
+/// replay, using up to the given number of threads. opening a collection
+/// reads all its datafiles and builds its primary index, which dominates
+/// the startup time for servers with many collections. collections that
+/// cannot be opened here are ignored, the replay will report them
+void MMFilesWalRecoverState::loadCollections(size_t numThreads) {
+  struct Item {
+    TRI_vocbase_t* vocbase;
+    TRI_voc_cid_t cid;
+    arangodb::LogicalCollection* collection;
+  };
+
+  std::vector<Item> items;
+  items.reserve(collectionsToLoad.size());
+
+  for (auto const& it : collectionsToLoad) {
+    if (willBeDropped(it.second, it.first) ||
+        openedCollections.find(it.first) != openedCollections.end()) {
+      continue;
+    }
+
+    // databases are opened by this thread only
+    TRI_vocbase_t* vocbase = useDatabase(it.second);
+
+    if (vocbase == nullptr) {
+      continue;
+    }
+    items.emplace_back(Item{vocbase, it.first, nullptr});
+  }
+
+  if (items.empty()) {
+    return;
+  }
+
+  numThreads = (std::max)(static_cast<size_t>(1),
+                          (std::min)(numThreads, items.size()));
+
+  LOG_TOPIC(INFO, arangodb::Logger::FIXME)
+      << "opening " << items.size() << " collection(s) used in WAL recovery"
+      << " using " << numThreads << " thread(s)";
+
+  double const start = TRI_microtime();
+  std::atomic<size_t> next(0);
+  std::atomic<size_t> done(0);
+  std::atomic<double> lastReport(start);
+
+  auto work = [&]() {
+    while (true) {
+      size_t const i = next.fetch_add(1);
+
+      if (i >= items.size()) {
+        return;
+      }
+
+      Item& item = items[i];
+      TRI_vocbase_col_status_e status;  // ignored here
+
+      try {
+        item.collection = item.vocbase->useCollection(item.cid, status);
+      } catch (...) {
+        item.collection = nullptr;
+      }
+
+      size_t const n = done.fetch_add(1) + 1;
+      LOG_TOPIC(DEBUG, arangodb::Logger::FIXME)
+          << "opened collection " << item.cid << " of database "
+          << item.vocbase->id() << " (" << n << "/" << items.size() << ")";
+
+      double now = TRI_microtime();
+      double last = lastReport.load();
+
+      if (now - last >= 5.0 &&
+          lastReport.compare_exchange_strong(last, now)) {
+        LOG_TOPIC(INFO, arangodb::Logger::FIXME)
+            << "opened " << n << " of " << items.size()
+            << " collection(s) used in WAL recovery";
+      }
+    }
+  };
+
+  if (numThreads == 1) {
+    work();
+  } else {
+    // the loading itself may use the scheduler, so use plain threads here
+    std::vector<std::thread> threads;
+    threads.reserve(numThreads);
+
+    for (size_t i = 0; i < numThreads; ++i) {
+      threads.emplace_back(work);
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  }
+
+  for (auto& item : items) {
+    if (item.collection == nullptr) {
+      continue;
+    }
+
+    auto physical =
+        static_cast<MMFilesCollection*>(item.collection->getPhysical());
+    TRI_ASSERT(physical != nullptr);
+    // disable secondary indexes for the moment
+    physical->useSecondaryIndexes(false);
+
+    openedCollections.emplace(item.cid, item.collection);
+  }
+
+  LOG_TOPIC(INFO, arangodb::Logger::FIXME)
+      << "opened " << items.size() << " collection(s) used in WAL recovery in "
+      << Logger::FIXED(TRI_microtime() - start, 3) << " s";
+}
+
+/// @brief fill the secondary indexes of all collections used in recovery,
+/// using up to the given number of threads
+int MMFilesWalRecoverState::fillIndexes(size_t numThreads) {
+  std::vector<arangodb::LogicalCollection*> collections;
+  collections.reserve(openedCollections.size());
+
+  for (auto const& it : openedCollections) {
+    arangodb::LogicalCollection* collection = it.second;
 
     auto physical = static_cast<MMFilesCollection*>(collection->getPhysical());
     TRI_ASSERT(physical != nullptr);
     // activate secondary indexes
     physical->useSecondaryIndexes(true);
 
-    arangodb::SingleCollectionTransaction trx(
-        arangodb::transaction::StandaloneContext::Create(collection->vocbase()),
-        collection->cid(), AccessMode::Type::WRITE);
+    collections.emplace_back(collection);
+  }
 
-    int res = physical->fillAllIndexes(&trx);
+  if (collections.empty()) {
+    return TRI_ERROR_NO_ERROR;
+  }
 
-    if (res != TRI_ERROR_NO_ERROR) {
-      return res;
+  numThreads = (std::max)(static_cast<size_t>(1),
+                          (std::min)(numThreads, collections.size()));
+
+  std::atomic<size_t> next(0);
+  std::atomic<int> result(TRI_ERROR_NO_ERROR);
+
+  auto work = [&]() {
+    while (result.load() == TRI_ERROR_NO_ERROR) {
+      size_t const i = next.fetch_add(1);
+
+      if (i >= collections.size()) {
+        return;
+      }
+
+      arangodb::LogicalCollection* collection = collections[i];
+      auto physical =
+          static_cast<MMFilesCollection*>(collection->getPhysical());
+
+      int res;
+      try {
+        arangodb::SingleCollectionTransaction trx(
+            arangodb::transaction::StandaloneContext::Create(
+                collection->vocbase()),
+            collection->cid(), AccessMode::Type::WRITE);
+
+        res = physical->fillAllIndexes(&trx);
+      } catch (arangodb::basics::Exception const& ex) {
+        res = ex.code();
+      } catch (...) {
+        res = TRI_ERROR_INTERNAL;
+      }
+
+      if (res != TRI_ERROR_NO_ERROR) {
+        int expected = TRI_ERROR_NO_ERROR;
+        result.compare_exchange_strong(expected, res);
+      }
+    }
+  };
+
+  if (numThreads == 1) {
+    work();
+  } else {
+    std::vector<std::thread> threads;
+    threads.reserve(numThreads);
+
+    for (size_t i = 0; i < numThreads; ++i) {
+      threads.emplace_back(work);
+    }
+    for (auto& thread : threads) {
+      thread.join();
     }
   }
 
-  return TRI_ERROR_NO_ERROR;
+  return result.load();
 }
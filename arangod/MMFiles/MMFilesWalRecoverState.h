@@ -148,8 +148,13 @@ struct MMFilesWalRecoverState {
   /// @brief remove all empty logfiles found during logfile inspection
   int removeEmptyLogfiles();
 
-  /// @brief fill the secondary indexes of all collections used in recovery
-  int fillIndexes();
+  /// @brief open all collections referenced in the logfiles before the
+  /// replay, using up to the given number of threads
+  void loadCollections(size_t numThreads);
+
+  /// @brief fill the secondary indexes of all collections used in recovery,
+  /// using up to the given number of threads
+  int fillIndexes(size_t numThreads);
 
   DatabaseFeature* databaseFeature;
   std::unordered_map<TRI_voc_tid_t, std::pair<TRI_voc_tick_t, bool>>
@@ -158,6 +163,8 @@ struct MMFilesWalRecoverState {
   std::unordered_set<TRI_voc_tick_t> droppedDatabases;
   std::unordered_set<TRI_voc_cid_t> totalDroppedCollections;
   std::unordered_set<TRI_voc_tick_t> totalDroppedDatabases;
+  /// @brief collections referenced in the logfiles, with their database ids
+  std::unordered_map<TRI_voc_cid_t, TRI_voc_tick_t> collectionsToLoad;
 
   TRI_voc_tick_t lastTick;
   std::vector<MMFilesWalLogfile*> logfilesToProcess;
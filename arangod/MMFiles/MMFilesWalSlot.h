@@ -47,10 +47,8 @@ class MMFilesWalSlot {
   };
 
   /// @brief create a slot
- private:
   MMFilesWalSlot();
 
- public:
   /// @brief return the tick assigned to the slot
   inline MMFilesWalSlot::TickType tick() const { return _tick; }
 
@@ -74,31 +72,39 @@ class MMFilesWalSlot {
   /// the source region) and copy the calculated marker data into the slot
   void fill(void*, size_t);
 
- private:
   /// @brief whether or not the slot is unused
-  inline bool isUnused() const { return _status == StatusType::UNUSED; }
+  inline bool isUnused() const { return status() == StatusType::UNUSED; }
 
   /// @brief whether or not the slot is used
-  inline bool isUsed() const { return _status == StatusType::USED; }
+  inline bool isUsed() const { return status() == StatusType::USED; }
 
   /// @brief whether or not the slot is returned
   inline bool isReturned() const {
-    return (_status == StatusType::RETURNED ||
-            _status == StatusType::RETURNED_WFS);
+    StatusType const s = status();
+    return (s == StatusType::RETURNED || s == StatusType::RETURNED_WFS);
   }
 
   /// @brief whether or not a sync was requested for the slot
   inline bool waitForSync() const {
-    return (_status == StatusType::RETURNED_WFS);
+    return (status() == StatusType::RETURNED_WFS);
+  }
+
+  /// @brief return the slot status. the acquire pairs with the release
+  /// in setReturned, so that the marker data written into a returned slot
+  /// is visible to the thread that syncs it
+  inline StatusType status() const {
+    return _status.load(std::memory_order_acquire);
   }
 
-  /// @brief mark as slot as unused
+  /// @brief mark as slot as unused. like setUsed, this must only be called
+  /// under the slots lock
   void setUnused();
 
   /// @brief mark as slot as used
   void setUsed(void*, uint32_t, MMFilesWalLogfile::IdType, MMFilesWalSlot::TickType);
 
-  /// @brief mark as slot as returned
+  /// @brief mark as slot as returned. the writer the slot was handed out to
+  /// calls this without holding the slots lock
   void setReturned(bool waitForSync);
 
  private:
@@ -118,8 +124,9 @@ class MMFilesWalSlot {
   /// @brief slot raw memory size
   uint32_t _size;
 
-  /// @brief slot status
-  StatusType _status; 
+  /// @brief slot status. all other members are only modified under the
+  /// slots lock, but a slot is returned without holding it
+  std::atomic<StatusType> _status;
 };
 
 static_assert(sizeof(MMFilesWalSlot) == 32, "invalid slot size");
@@ -45,6 +45,8 @@ MMFilesWalSlots::MMFilesWalSlots(MMFilesLogfileManager* logfileManager, size_t n
       _numberOfSlots(numberOfSlots),
       _freeSlots(numberOfSlots),
       _waiting(0),
+      _tickCondition(),
+      _tickWaiters(0),
       _handoutIndex(0),
       _recycleIndex(0),
       _logfile(nullptr),
@@ -64,8 +66,13 @@ MMFilesWalSlots::~MMFilesWalSlots() { delete[] _slots; }
 
 /// @brief sets a shutdown flag, disabling the request for new logfiles
 void MMFilesWalSlots::shutdown() {
-  MUTEX_LOCKER(mutexLocker, _lock);
-  _shutdown = true;
+  {
+    MUTEX_LOCKER(mutexLocker, _lock);
+    _shutdown = true;
+  }
+
+  CONDITION_LOCKER(guard, _tickCondition);
+  guard.broadcast();
 }
 
 /// @brief get the statistics of the slots
@@ -78,8 +85,8 @@ void MMFilesWalSlots::statistics(MMFilesWalSlot::TickType& lastAssignedTick,
   lastAssignedTick = _lastAssignedTick;
   lastCommittedTick = _lastCommittedTick;
   lastCommittedDataTick = _lastCommittedDataTick;
-  numEvents = _numEvents;
-  numEventsSync = _numEventsSync;
+  numEvents = _numEvents.load(std::memory_order_relaxed);
+  numEventsSync = _numEventsSync.load(std::memory_order_relaxed);
 }
 
 /// @brief execute a flush operation
@@ -285,11 +292,7 @@ MMFilesWalSlotInfo MMFilesWalSlots::nextUnused(TRI_voc_tick_t databaseId, TRI_vo
       hasWaited = true;
     }
 
-    bool mustWait;
-    {
-      MUTEX_LOCKER(mutexLocker, _lock);
-      mustWait = (_freeSlots < 2);
-    }
+    bool mustWait = (_freeSlots.load() < 2);
 
     if (mustWait) {
       guard.wait(10 * 1000);
@@ -310,15 +313,16 @@ void MMFilesWalSlots::returnUsed(MMFilesWalSlotInfo& slotInfo, bool wakeUpSynchr
 
   TRI_ASSERT(tick > 0);
 
-  {
-    MUTEX_LOCKER(mutexLocker, _lock);
-    slotInfo.slot->setReturned(waitForSyncRequested);
-    if (waitForSyncRequested) {
-      ++_numEventsSync;
-    } else {
-      ++_numEvents;
-    }
+  // returning a slot does not require the slots lock: the slot was
+  // handed out to us exclusively, and it will only be picked up by
+  // getSyncRegion once it has been marked as returned. this saves
+  // writers the second acquisition of the lock per WAL entry
+  if (waitForSyncRequested) {
+    _numEventsSync.fetch_add(1, std::memory_order_relaxed);
+  } else {
+    _numEvents.fetch_add(1, std::memory_order_relaxed);
   }
+  slotInfo.slot->setReturned(waitForSyncRequested);
 
   wakeUpSynchronizer |= waitForSyncRequested;
   wakeUpSynchronizer |= waitUntilSyncDone;
@@ -455,6 +459,13 @@ void MMFilesWalSlots::returnSyncRegion(MMFilesWalSyncRegion const& region) {
     }
   }
 
+  if (_tickWaiters.load() > 0) {
+    // wake up the waiters for the new committed tick. the waiters register
+    // before they check the tick, so no wake-up can be missed
+    CONDITION_LOCKER(guard, _tickCondition);
+    guard.broadcast();
+  }
+
   // signal that we have done something
   CONDITION_LOCKER(guard, _condition);
 
@@ -586,11 +597,7 @@ int MMFilesWalSlots::closeLogfile(MMFilesWalSlot::TickType& lastCommittedTick, b
       hasWaited = true;
     }
 
-    bool mustWait;
-    {
-      MUTEX_LOCKER(mutexLocker, _lock);
-      mustWait = (_freeSlots < 2);
-    }
+    bool mustWait = (_freeSlots.load() < 2);
 
     if (mustWait) {
       guard.wait(10 * 1000);
@@ -690,10 +697,13 @@ size_t MMFilesWalSlots::nextHandoutIndex() const {
   return handoutIndex;
 }
 
-/// @brief wait until all data has been synced up to a certain marker
-bool MMFilesWalSlots::waitForTick(MMFilesWalSlot::TickType tick) {
+/// @brief wait until all data has been synced up to a certain marker,
+/// or until maxWait seconds have passed
+bool MMFilesWalSlots::waitForTick(MMFilesWalSlot::TickType tick,
+                                  double maxWait) {
   static uint64_t const SleepTime = 10000;
-  static int const MaxIterations = 30 * 1000 * 1000 / SleepTime;
+  int const maxIterations =
+      (std::max)(1, static_cast<int>(maxWait * 1000.0 * 1000.0 / SleepTime));
   int iterations = 0;
 
   // wait until data has been committed to disk
@@ -704,11 +714,44 @@ bool MMFilesWalSlots::waitForTick(MMFilesWalSlot::TickType tick) {
 
     CONDITION_LOCKER(guard, _condition);
     guard.wait(SleepTime);
-  } while (++iterations < MaxIterations);
+  } while (++iterations < maxIterations);
 
   return false;
 }
 
+/// @brief wait until the last committed tick is greater than the given
+/// tick, or until maxWait seconds have passed. returns the last committed
+/// tick
+MMFilesWalSlot::TickType MMFilesWalSlots::waitForCommittedTick(
+    MMFilesWalSlot::TickType tick, double maxWait) {
+  double const end = TRI_microtime() + maxWait;
+
+  CONDITION_LOCKER(guard, _tickCondition);
+  ++_tickWaiters;
+
+  MMFilesWalSlot::TickType committed;
+
+  while (true) {
+    committed = lastCommittedTick();
+
+    if (committed > tick || _shutdown) {
+      break;
+    }
+
+    double const now = TRI_microtime();
+
+    if (now >= end) {
+      break;
+    }
+
+    guard.wait(static_cast<uint64_t>((end - now) * 1000.0 * 1000.0));
+  }
+
+  --_tickWaiters;
+
+  return committed;
+}
+
 /// @brief request a new logfile which can satisfy a marker of the
 /// specified size
 int MMFilesWalSlots::newLogfile(uint32_t size, MMFilesWalLogfile::StatusType& status) {
@@ -139,8 +139,15 @@ class MMFilesWalSlots {
   /// actually handing it out
   size_t nextHandoutIndex() const;
 
-  /// @brief wait until all data has been synced up to a certain marker
-  bool waitForTick(MMFilesWalSlot::TickType);
+  /// @brief wait until all data has been synced up to a certain marker,
+  /// or until maxWait seconds have passed
+  bool waitForTick(MMFilesWalSlot::TickType, double maxWait = 30.0);
+
+  /// @brief wait until the last committed tick is greater than the given
+  /// tick, or until maxWait seconds have passed. returns the last committed
+  /// tick
+  MMFilesWalSlot::TickType waitForCommittedTick(MMFilesWalSlot::TickType,
+                                                double maxWait);
 
   /// @brief request a new logfile which can satisfy a marker of the
   /// specified size
@@ -162,12 +169,20 @@ class MMFilesWalSlots {
   /// @brief the total number of slots
   size_t const _numberOfSlots;
 
-  /// @brief the number of currently free slots
-  size_t _freeSlots;
+  /// @brief the number of currently free slots. only modified under the
+  /// slots lock, but can be read without it
+  std::atomic<size_t> _freeSlots;
 
   /// @brief whether or not someone is waiting for a slot
   uint32_t _waiting;
 
+  /// @brief condition variable signaled when the last committed tick
+  /// advances while someone is waiting for it
+  basics::ConditionVariable _tickCondition;
+
+  /// @brief number of threads waiting for the last committed tick
+  std::atomic<uint32_t> _tickWaiters;
+
   /// @brief the index of the slot to hand out next
   size_t _handoutIndex;
 
@@ -187,10 +202,10 @@ class MMFilesWalSlots {
   MMFilesWalSlot::TickType _lastCommittedDataTick;
 
   /// @brief number of log events handled
-  uint64_t _numEvents;
+  std::atomic<uint64_t> _numEvents;
 
   /// @brief number of sync log events handled
-  uint64_t _numEventsSync;
+  std::atomic<uint64_t> _numEventsSync;
   
   /// @brief last written database id (in prologue marker)
   TRI_voc_tick_t _lastDatabaseId;
@@ -1355,6 +1355,127 @@ bool TRI_InsertWordsMMFilesFulltextIndex(TRI_fts_index_t* const ftx,
   return true;
 }
 
+/// @brief insert the lists of words of many documents to the index
+/// the words of all documents are sorted together, so that each distinct
+/// word is looked up in the tree only once, and the handles of all
+/// documents containing it are appended to its list in one go
+bool TRI_InsertWordsBatchMMFilesFulltextIndex(
+    TRI_fts_index_t* const ftx,
+    std::vector<std::pair<TRI_voc_rid_t, std::vector<std::string>>> const&
+        wordlists) {
+  index__t* idx;
+  node_t* paths[MAX_WORD_BYTES + 4];
+  size_t lastLength;
+
+  if (wordlists.empty()) {
+    return true;
+  }
+
+  size_t numWords = 0;
+  for (auto const& it : wordlists) {
+    numWords += it.second.size();
+  }
+
+  std::vector<std::pair<std::string const*, TRI_fulltext_handle_t>> entries;
+  entries.reserve(numWords);
+
+  // initialize to satisfy scan-build
+  paths[0] = nullptr;
+  paths[MAX_WORD_BYTES] = nullptr;
+
+  idx = (index__t*)ftx;
+
+  TRI_WriteLockReadWriteLock(&idx->_lock);
+
+  // get new handles for the documents. the handles are increasing, so the
+  // handle lists stay sorted when the handles are appended in order
+  size_t numDocuments = 0;
+  for (auto const& it : wordlists) {
+    TRI_fulltext_handle_t handle =
+        TRI_InsertHandleMMFilesFulltextIndex(idx->_handles, it.first);
+    if (handle == 0) {
+      for (size_t i = 0; i < numDocuments; ++i) {
+        TRI_DeleteDocumentHandleMMFilesFulltextIndex(idx->_handles,
+                                                     wordlists[i].first);
+      }
+      TRI_WriteUnlockReadWriteLock(&idx->_lock);
+      return false;
+    }
+    ++numDocuments;
+
+    for (auto const& word : it.second) {
+      entries.emplace_back(&word, handle);
+    }
+  }
+
+  std::sort(entries.begin(), entries.end(),
+            [](std::pair<std::string const*, TRI_fulltext_handle_t> const& lhs,
+               std::pair<std::string const*, TRI_fulltext_handle_t> const& rhs) {
+              int res = lhs.first->compare(*rhs.first);
+              if (res != 0) {
+                return res < 0;
+              }
+              return lhs.second < rhs.second;
+            });
+
+  paths[0] = idx->_root;
+  lastLength = 0;
+
+  for (size_t w = 0; w < entries.size(); ++w) {
+    std::string const& word = *entries[w].first;
+    node_t* node;
+    size_t start;
+    size_t i;
+
+    if (w > 0) {
+      // words with a common prefix are adjacent, so the tree only needs to
+      // be traversed from the end of the common prefix
+      start = CommonPrefixLength(*entries[w - 1].first, word);
+      if (start > MAX_WORD_BYTES) {
+        start = MAX_WORD_BYTES;
+      }
+
+      if (start > 0 && start == lastLength && start == word.size() &&
+          entries[w - 1].second == entries[w].second) {
+        // duplicate word of the same document
+        continue;
+      }
+    } else {
+      start = 0;
+    }
+
+    node = paths[start];
+    char const* p = word.c_str() + start;
+
+    for (i = start; *p && i <= MAX_WORD_BYTES; ++i) {
+      node_char_t c = (node_char_t) * (p++);
+
+      node = EnsureSubNode(idx, node, c);
+      if (node == nullptr) {
+        break;
+      }
+
+      paths[i + 1] = node;
+    }
+
+    if (node == nullptr || !InsertHandle(idx, node, entries[w].second)) {
+      // the documents were added at least partially, mark them as deleted
+      for (auto const& it : wordlists) {
+        TRI_DeleteDocumentHandleMMFilesFulltextIndex(idx->_handles, it.first);
+      }
+      TRI_WriteUnlockReadWriteLock(&idx->_lock);
+      return false;
+    }
+
+    // store length of word just inserted
+    lastLength = i;
+  }
+
+  TRI_WriteUnlockReadWriteLock(&idx->_lock);
+
+  return true;
+}
+
 /// @brief find all documents that contain a word (exact match)
 #if 0
 TRI_fulltext_result_t* TRI_FindExactMMFilesFulltextIndex (TRI_fts_index_t* const ftx,
@@ -1373,30 +1494,17 @@ TRI_fulltext_result_t* TRI_FindPrefixMMFilesFulltextIndex (TRI_fts_index_t* cons
 }
 #endif
 
-/// @brief execute a query on the fulltext index
-/// note: this will free the query
-TRI_fulltext_result_t* TRI_QueryMMFilesFulltextIndex(TRI_fts_index_t* const ftx,
-                                              TRI_fulltext_query_t* query) {
-  index__t* idx;
+/// @brief evaluate the words of a query and combine their handle lists
+/// if terms is not a nullptr, a copy of the handle list of each word that
+/// is not an exclusion is added to it. the caller must free these
+/// returns a nullptr if the query did not produce a result
+/// the caller must hold the index read lock
+static TRI_fulltext_list_t* EvaluateQuery(
+    index__t* idx, TRI_fulltext_query_t* query,
+    std::vector<TRI_fulltext_list_t*>* terms) {
   TRI_fulltext_list_t* result;
   size_t i;
 
-  if (query == nullptr) {
-    return nullptr;
-  }
-
-  if (query->_numWords == 0) {
-    // query is empty
-    TRI_FreeQueryMMFilesFulltextIndex(query);
-    return TRI_CreateResultMMFilesFulltextIndex(0);
-  }
-
-  auto maxResults = query->_maxResults;
-
-  idx = (index__t*)ftx;
-
-  TRI_ReadLockReadWriteLock(&idx->_lock);
-
   // initial result is empty
   result = nullptr;
 
@@ -1442,6 +1550,30 @@ TRI_fulltext_result_t* TRI_QueryMMFilesFulltextIndex(TRI_fts_index_t* const ftx,
       list = TRI_CreateListMMFilesFulltextIndex(0);
     }
 
+    if (list != nullptr && terms != nullptr &&
+        operation != TRI_FULLTEXT_EXCLUDE) {
+      // keep a copy of the word's list for scoring
+      TRI_fulltext_list_t* copy = TRI_CloneListMMFilesFulltextIndex(list);
+
+      if (copy != nullptr) {
+        try {
+          terms->emplace_back(copy);
+        } catch (...) {
+          TRI_FreeListMMFilesFulltextIndex(copy);
+          copy = nullptr;
+        }
+      }
+
+      if (copy == nullptr) {
+        // out of memory
+        TRI_FreeListMMFilesFulltextIndex(list);
+        if (result != nullptr) {
+          TRI_FreeListMMFilesFulltextIndex(result);
+        }
+        return nullptr;
+      }
+    }
+
     if (operation == TRI_FULLTEXT_AND) {
       // perform a logical AND of current and previous result (if any)
       result = TRI_IntersectListMMFilesFulltextIndex(result, list);
@@ -1459,6 +1591,34 @@ TRI_fulltext_result_t* TRI_QueryMMFilesFulltextIndex(TRI_fts_index_t* const ftx,
     }
   }
 
+  return result;
+}
+
+/// @brief execute a query on the fulltext index
+/// note: this will free the query
+TRI_fulltext_result_t* TRI_QueryMMFilesFulltextIndex(TRI_fts_index_t* const ftx,
+                                              TRI_fulltext_query_t* query) {
+  index__t* idx;
+  TRI_fulltext_list_t* result;
+
+  if (query == nullptr) {
+    return nullptr;
+  }
+
+  if (query->_numWords == 0) {
+    // query is empty
+    TRI_FreeQueryMMFilesFulltextIndex(query);
+    return TRI_CreateResultMMFilesFulltextIndex(0);
+  }
+
+  auto maxResults = query->_maxResults;
+
+  idx = (index__t*)ftx;
+
+  TRI_ReadLockReadWriteLock(&idx->_lock);
+
+  result = EvaluateQuery(idx, query, nullptr);
+
   TRI_FreeQueryMMFilesFulltextIndex(query);
 
   if (result == nullptr) {
@@ -1475,6 +1635,161 @@ TRI_fulltext_result_t* TRI_QueryMMFilesFulltextIndex(TRI_fts_index_t* const ftx,
   return r;
 }
 
+/// @brief compute the relevance scores for the handles in a result list
+/// the index stores each word only once per document and does not keep
+/// document lengths, so the BM25 score of a document degenerates to the
+/// sum of the inverse document frequencies of the words it contains
+static void ScoreList(index__t* idx, TRI_fulltext_list_t* result,
+                      std::vector<TRI_fulltext_list_t*> const& terms,
+                      std::vector<double>& scores) {
+  uint32_t const numResults = TRI_NumEntriesListMMFilesFulltextIndex(result);
+  TRI_fulltext_list_entry_t const* resultEntries =
+      TRI_StartListMMFilesFulltextIndex(result);
+
+  double const numDocuments = static_cast<double>(
+      TRI_NumHandlesHandleMMFilesFulltextIndex(idx->_handles) -
+      TRI_NumDeletedHandleMMFilesFulltextIndex(idx->_handles));
+
+  scores.assign(numResults, 0.0);
+
+  for (auto& term : terms) {
+    uint32_t const numEntries = TRI_NumEntriesListMMFilesFulltextIndex(term);
+
+    if (numEntries == 0) {
+      continue;
+    }
+
+    double const df = static_cast<double>(numEntries);
+    double const idf =
+        std::log(1.0 + (std::max)(0.0, numDocuments - df + 0.5) / (df + 0.5));
+
+    // both lists are sorted, so a single merge pass finds the documents
+    // that contain the word
+    TRI_SortListMMFilesFulltextIndex(term);
+    TRI_fulltext_list_entry_t const* entries =
+        TRI_StartListMMFilesFulltextIndex(term);
+    uint32_t j = 0;
+
+    for (uint32_t i = 0; i < numResults && j < numEntries; ++i) {
+      while (j < numEntries && entries[j] < resultEntries[i]) {
+        ++j;
+      }
+      if (j < numEntries && entries[j] == resultEntries[i]) {
+        scores[i] += idf;
+      }
+    }
+  }
+}
+
+/// @brief execute a query on the fulltext index, and return the matching
+/// documents ordered by descending relevance, together with their scores
+/// note: this will free the query
+TRI_fulltext_result_t* TRI_QueryScoredMMFilesFulltextIndex(
+    TRI_fts_index_t* const ftx, TRI_fulltext_query_t* query) {
+  if (query == nullptr) {
+    return nullptr;
+  }
+
+  if (query->_numWords == 0) {
+    // query is empty
+    TRI_FreeQueryMMFilesFulltextIndex(query);
+    return TRI_CreateResultMMFilesFulltextIndex(0);
+  }
+
+  auto maxResults = query->_maxResults;
+  index__t* idx = (index__t*)ftx;
+  std::vector<TRI_fulltext_list_t*> terms;
+
+  auto freeTerms = [&terms]() {
+    for (auto& term : terms) {
+      TRI_FreeListMMFilesFulltextIndex(term);
+    }
+    terms.clear();
+  };
+
+  TRI_ReadLockReadWriteLock(&idx->_lock);
+
+  TRI_fulltext_list_t* list = EvaluateQuery(idx, query, &terms);
+
+  TRI_FreeQueryMMFilesFulltextIndex(query);
+
+  if (list == nullptr) {
+    freeTerms();
+    TRI_ReadUnlockReadWriteLock(&idx->_lock);
+    return TRI_CreateResultMMFilesFulltextIndex(0);
+  }
+
+  TRI_fulltext_result_t* result = nullptr;
+
+  try {
+    TRI_SortListMMFilesFulltextIndex(list);
+
+    std::vector<double> scores;
+    ScoreList(idx, list, terms, scores);
+    freeTerms();
+
+    // collect the positions of all documents that are still present
+    uint32_t const numEntries = TRI_NumEntriesListMMFilesFulltextIndex(list);
+    TRI_fulltext_list_entry_t const* entries =
+        TRI_StartListMMFilesFulltextIndex(list);
+
+    std::vector<uint32_t> positions;
+    positions.reserve(numEntries);
+    for (uint32_t i = 0; i < numEntries; ++i) {
+      if (TRI_GetDocumentMMFilesFulltextIndex(idx->_handles, entries[i]) != 0) {
+        positions.emplace_back(i);
+      }
+    }
+
+    size_t numResults = positions.size();
+    if (maxResults > 0 && numResults > maxResults) {
+      numResults = maxResults;
+    }
+
+    // only the top results need to be ordered. ties are broken by handle,
+    // so that results are deterministic
+    auto cmp = [&scores](uint32_t lhs, uint32_t rhs) {
+      if (scores[lhs] != scores[rhs]) {
+        return scores[lhs] > scores[rhs];
+      }
+      return lhs < rhs;
+    };
+    std::partial_sort(positions.begin(), positions.begin() + numResults,
+                      positions.end(), cmp);
+
+    result =
+        TRI_CreateResultMMFilesFulltextIndex(static_cast<uint32_t>(numResults));
+
+    if (result != nullptr &&
+        !TRI_AllocateScoresMMFilesFulltextIndex(
+            result, static_cast<uint32_t>(numResults))) {
+      TRI_FreeResultMMFilesFulltextIndex(result);
+      result = nullptr;
+    }
+
+    if (result != nullptr) {
+      for (size_t i = 0; i < numResults; ++i) {
+        uint32_t pos = positions[i];
+        result->_documents[i] =
+            TRI_GetDocumentMMFilesFulltextIndex(idx->_handles, entries[pos]);
+        result->_scores[i] = scores[pos];
+      }
+      result->_numDocuments = static_cast<uint32_t>(numResults);
+    }
+  } catch (...) {
+    if (result != nullptr) {
+      TRI_FreeResultMMFilesFulltextIndex(result);
+      result = nullptr;
+    }
+  }
+
+  freeTerms();
+  TRI_FreeListMMFilesFulltextIndex(list);
+  TRI_ReadUnlockReadWriteLock(&idx->_lock);
+
+  return result;
+}
+
 /// @brief dump index tree
 #if TRI_FULLTEXT_DEBUG
 void TRI_DumpTreeFtsIndex(const TRI_fts_index_t* const ftx) {
@@ -74,6 +74,11 @@ bool TRI_InsertWordsMMFilesFulltextIndex(TRI_fts_index_t* const,
                                          const TRI_voc_rid_t,
                                          std::vector<std::string>&);
 
+/// @brief insert the lists of words of many documents to the index
+bool TRI_InsertWordsBatchMMFilesFulltextIndex(
+    TRI_fts_index_t* const,
+    std::vector<std::pair<TRI_voc_rid_t, std::vector<std::string>>> const&);
+
 /// @brief find all documents that contain a word (exact match)
 #if 0
 struct TRI_fulltext_result_s* TRI_FindExactMMFilesFulltextIndex (TRI_fts_index_t* const,
@@ -93,6 +98,12 @@ struct TRI_fulltext_result_s* TRI_FindPrefixMMFilesFulltextIndex (TRI_fts_index_
 struct TRI_fulltext_result_s* TRI_QueryMMFilesFulltextIndex(
     TRI_fts_index_t* const, struct TRI_fulltext_query_s*);
 
+/// @brief execute a query on the fulltext index, and return the matching
+/// documents ordered by descending relevance, together with their scores
+/// note: this will free the query
+struct TRI_fulltext_result_s* TRI_QueryScoredMMFilesFulltextIndex(
+    TRI_fts_index_t* const, struct TRI_fulltext_query_s*);
+
 /// @brief dump index tree
 #if TRI_FULLTEXT_DEBUG
 void TRI_DumpTreeFtsIndex(const TRI_fts_index_t* const);
@@ -34,6 +34,11 @@
 /// @brief growth factor for lists
 #define GROWTH_FACTOR 1.2
 
+/// @brief minimum size ratio between two lists from which on intersections
+/// search the bigger list for each entry of the smaller one instead of
+/// merging both lists
+#define GALLOP_RATIO 16
+
 /// @brief compare two entries in a list
 static int CompareEntries(const void* lhs, const void* rhs) {
   TRI_fulltext_list_entry_t l = (*(TRI_fulltext_list_entry_t*)lhs);
@@ -129,6 +134,46 @@ static void SortList(TRI_fulltext_list_t* list) {
   SetIsSorted(list, true);
 }
 
+/// @brief find the position of the first entry not less than value in a
+/// sorted list, starting at position pos
+/// the search probes positions pos + 1, pos + 3, pos + 7 etc. before falling
+/// back to a binary search, so that it is cheap when the result is close
+/// to the start position
+static uint32_t GallopList(TRI_fulltext_list_entry_t const* entries,
+                           uint32_t pos, uint32_t numEntries,
+                           TRI_fulltext_list_entry_t value) {
+  if (pos >= numEntries || entries[pos] >= value) {
+    return pos;
+  }
+
+  // entries[low] < value
+  uint32_t low = pos;
+  uint32_t step = 1;
+
+  while (true) {
+    uint32_t high = low + step;
+    if (high >= numEntries || high < low) {
+      high = numEntries;
+    } else if (entries[high] < value) {
+      low = high;
+      step *= 2;
+      continue;
+    }
+
+    // entries[low] < value <= entries[high], or high is the end
+    ++low;
+    while (low < high) {
+      uint32_t mid = low + (high - low) / 2;
+      if (entries[mid] < value) {
+        low = mid + 1;
+      } else {
+        high = mid;
+      }
+    }
+    return low;
+  }
+}
+
 /// @brief get the memory usage for a list of the specified size
 static inline size_t MemoryList(uint32_t size) {
   return sizeof(uint32_t) +                         // numAllocated
@@ -345,6 +390,50 @@ TRI_fulltext_list_t* TRI_IntersectListMMFilesFulltextIndex(TRI_fulltext_list_t*
   listEntries = GetStart(list);
   last = 0;
 
+  if (numLhs / GALLOP_RATIO >= numRhs || numRhs / GALLOP_RATIO >= numLhs) {
+    // one list is much smaller than the other. instead of walking over all
+    // entries of the big list, look up each entry of the small list in it
+    TRI_fulltext_list_entry_t* smallEntries = lhsEntries;
+    TRI_fulltext_list_entry_t* bigEntries = rhsEntries;
+    uint32_t numSmall = numLhs;
+    uint32_t numBig = numRhs;
+
+    if (numLhs > numRhs) {
+      smallEntries = rhsEntries;
+      bigEntries = lhsEntries;
+      numSmall = numRhs;
+      numBig = numLhs;
+    }
+
+    uint32_t b = 0;
+    for (uint32_t s = 0; s < numSmall; ++s) {
+      TRI_fulltext_list_entry_t entry = smallEntries[s];
+
+      if (entry <= last) {
+        // duplicate
+        continue;
+      }
+
+      b = GallopList(bigEntries, b, numBig, entry);
+      if (b >= numBig) {
+        break;
+      }
+
+      if (bigEntries[b] == entry) {
+        // match
+        listEntries[listPos++] = last = entry;
+      }
+    }
+
+    SetNumEntries(list, listPos);
+    SetIsSorted(list, true);
+
+    TRI_FreeListMMFilesFulltextIndex(lhs);
+    TRI_FreeListMMFilesFulltextIndex(rhs);
+
+    return list;
+  }
+
   while (true) {
     while (l < numLhs && lhsEntries[l] <= last) {
       ++l;
@@ -413,6 +502,7 @@ TRI_fulltext_list_t* TRI_ExcludeListMMFilesFulltextIndex(
   }
 
   SortList(list);
+  SortList(exclude);
 
   listEntries = GetStart(list);
   excludeEntries = GetStart(exclude);
@@ -423,9 +513,7 @@ TRI_fulltext_list_t* TRI_ExcludeListMMFilesFulltextIndex(
     TRI_fulltext_list_entry_t entry;
 
     entry = listEntries[i];
-    while (j < numExclude && excludeEntries[j] < entry) {
-      ++j;
-    }
+    j = GallopList(excludeEntries, j, numExclude, entry);
 
     if (j < numExclude && excludeEntries[j] == entry) {
       // entry is contained in exclusion list
@@ -512,6 +600,11 @@ TRI_fulltext_list_t* TRI_InsertListMMFilesFulltextIndex(
   return list;
 }
 
+/// @brief sort a list in place, if it is not yet sorted
+void TRI_SortListMMFilesFulltextIndex(TRI_fulltext_list_t* list) {
+  SortList(list);
+}
+
 /// @brief rewrites the list of entries using a map of handles
 /// returns the number of entries remaining in the list after rewrite
 /// the map is provided by the routines that handle the compaction
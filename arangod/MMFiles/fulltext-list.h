@@ -64,6 +64,9 @@ TRI_fulltext_list_t* TRI_ExcludeListMMFilesFulltextIndex(TRI_fulltext_list_t*,
 TRI_fulltext_list_t* TRI_InsertListMMFilesFulltextIndex(
     TRI_fulltext_list_t*, const TRI_fulltext_list_entry_t);
 
+/// @brief sort a list in place, if it is not yet sorted
+void TRI_SortListMMFilesFulltextIndex(TRI_fulltext_list_t*);
+
 /// @brief rewrites the list of entries using a map of values
 /// returns the number of entries remaining in the list after rewrite
 uint32_t TRI_RewriteListMMFilesFulltextIndex(TRI_fulltext_list_t*, void const*);
@@ -35,6 +35,7 @@ TRI_fulltext_result_t* TRI_CreateResultMMFilesFulltextIndex(const uint32_t size)
   }
 
   result->_documents = nullptr;
+  result->_scores = nullptr;
   result->_numDocuments = 0;
 
   if (size > 0) {
@@ -50,11 +51,29 @@ TRI_fulltext_result_t* TRI_CreateResultMMFilesFulltextIndex(const uint32_t size)
   return result;
 }
 
+/// @brief allocate the scores for a result with the given capacity
+bool TRI_AllocateScoresMMFilesFulltextIndex(TRI_fulltext_result_t* result,
+                                            const uint32_t size) {
+  TRI_ASSERT(result->_scores == nullptr);
+
+  if (size == 0) {
+    return true;
+  }
+
+  result->_scores = static_cast<double*>(
+      TRI_Allocate(TRI_UNKNOWN_MEM_ZONE, sizeof(double) * size, false));
+
+  return (result->_scores != nullptr);
+}
+
 /// @brief destroy a result
 void TRI_DestroyResultMMFilesFulltextIndex(TRI_fulltext_result_t* result) {
   if (result->_documents != nullptr) {
     TRI_Free(TRI_UNKNOWN_MEM_ZONE, result->_documents);
   }
+  if (result->_scores != nullptr) {
+    TRI_Free(TRI_UNKNOWN_MEM_ZONE, result->_scores);
+  }
 }
 
 /// @brief free a result
@@ -35,11 +35,18 @@ namespace arangodb {
 typedef struct TRI_fulltext_result_s {
   uint32_t _numDocuments;
   arangodb::DocumentIdentifierToken* _documents;
+  /// @brief relevance scores of the documents, in the same order.
+  /// only populated by scored queries, nullptr otherwise
+  double* _scores;
 } TRI_fulltext_result_t;
 
 /// @brief create a result
 TRI_fulltext_result_t* TRI_CreateResultMMFilesFulltextIndex(const uint32_t);
 
+/// @brief allocate the scores for a result with the given capacity
+bool TRI_AllocateScoresMMFilesFulltextIndex(TRI_fulltext_result_t*,
+                                            const uint32_t);
+
 /// @brief destroy a result
 void TRI_DestroyResultMMFilesFulltextIndex(TRI_fulltext_result_t*);
 
@@ -33,6 +33,8 @@
 
 #define GEOSLOTSTART 50
 #define GEOPOTSTART 100
+/* larger than any distance of a point to a fixed point */
+#define GEOFIXMAX ((GeoFix)~((GeoFix)0))
 
 #if GeoIndexFIXEDSET == 2
 #define GeoIndexFIXEDPOINTS 2
@@ -86,6 +88,9 @@ typedef struct {
 /* used for a leaf pot.                                */
 /* maxdist is the maximum, over all points descendent  */
 /* from this pot, of the distances to the fixed points */
+/* mindist is the corresponding minimum, so that with  */
+/* both bounds a pot covers a ring around each fixed   */
+/* point, and can be rejected from either side         */
 /* level is the AVL-level.  It is 1 for a leaf pot,    */
 /* and always at least 1 more and at most 2 more than  */
 /* each of its children, and exactly 1 more than at    */
@@ -98,6 +103,7 @@ typedef struct {
   int RorPoints;
   GeoString middle;
   GeoFix maxdist[GeoIndexFIXEDPOINTS];
+  GeoFix mindist[GeoIndexFIXEDPOINTS];
   GeoString start;
   GeoString end;
   int level;
@@ -167,6 +173,9 @@ typedef struct {
 /* is used to reject pots (leaf or non-leaf).          */
 /* The routine GeoPotJunk is used to test this,        */
 /* by comparing the distances in the pot the this array*/
+/* fixrad is the radius itself in GeoFix units, used to*/
+/* reject pots all of whose points are too far from the*/
+/* fixed points (as opposed to too near)               */
 /* =================================================== */
 typedef struct {
   GeoIx* gix;
@@ -178,6 +187,7 @@ typedef struct {
   GeoFix fixdist[GeoIndexFIXEDPOINTS];
   double snmd;
   GeoFix distrej[GeoIndexFIXEDPOINTS];
+  GeoFix fixrad;
 } GeoDetailedPoint;
 /* =================================================== */
 /*                   GeoResults   structure            */
@@ -534,7 +544,10 @@ GeoIdx* GeoIndex_new(void) {
   gix->pots[j].start = 0ll;
   gix->pots[j].end = 0x1FFFFFFFFFFFFFll;
   gix->pots[j].level = 1;
-  for (i = 0; i < GeoIndexFIXEDPOINTS; i++) gix->pots[j].maxdist[i] = 0;
+  for (i = 0; i < GeoIndexFIXEDPOINTS; i++) {
+    gix->pots[j].maxdist[i] = 0;
+    gix->pots[j].mindist[i] = GEOFIXMAX;
+  }
   return (GeoIdx*)gix;
 }
 /* =================================================== */
@@ -720,6 +733,7 @@ void GeoSetDistance(GeoDetailedPoint* gd, double snmd) {
   gd->snmd = snmd;
   gf = (GeoFix)(asin(sqrt(snmd) / 2.0) * ARCSINFIX);
   gf++;
+  gd->fixrad = gf;
   for (i = 0; i < GeoIndexFIXEDPOINTS; i++) {
     if ((gd->fixdist)[i] <= gf)
       (gd->distrej)[i] = 0;
@@ -993,14 +1007,23 @@ GeoCoordinates* GeoAnswers(GeoIx* gix, GeoResults* gr, bool returnDistances) {
 /* descendents of a pot, 1 is returned to indicate that*/
 /* the pot is "junk" = it may be ignored in its        */
 /* entirety because it contains no points close enough */
-/* to the target.  Otherwise 0 is returned.            */
+/* to the target.  Likewise, if all the descendents of */
+/* a pot are too far from one of the fixed points, the */
+/* pot is junk as well.  This second test matters for  */
+/* large radii, where hardly any pot is close enough to*/
+/* the fixed points to be rejected by the first one.   */
+/* Otherwise 0 is returned.                            */
 /* =================================================== */
 int GeoPotJunk(GeoDetailedPoint* gd, int pot) {
   int i;
   GeoPot* gp;
   gp = (gd->gix)->pots + pot;
-  for (i = 0; i < GeoIndexFIXEDPOINTS; i++)
+  for (i = 0; i < GeoIndexFIXEDPOINTS; i++) {
     if (gp->maxdist[i] < gd->distrej[i]) return 1;
+    if (gp->mindist[i] > gd->fixdist[i] &&
+        gp->mindist[i] - gd->fixdist[i] > gd->fixrad)
+      return 1;
+  }
   return 0;
 }
 /* =================================================== */
@@ -1316,18 +1339,23 @@ int GeoFind(GeoPath* gt, GeoDetailedPoint* gd) {
 /* During maintencance, when the points in a leaf pot  */
 /* have been changed, this routine merely looks at all */
 /* the points in the pot, details them, and rebuilds   */
-/* the list of maximum distances.                      */
+/* the lists of maximum and minimum distances.         */
 /* =================================================== */
 void GeoPopulateMaxdist(GeoIx* gix, GeoPot* gp, GeoString* gsa) {
   int i, j;
   GeoDetailedPoint gd;
   gsa[0] = 0x1FFFFFFFFFFFFFll;
   gsa[1] = 0ll;
-  for (j = 0; j < GeoIndexFIXEDPOINTS; j++) gp->maxdist[j] = 0;
+  for (j = 0; j < GeoIndexFIXEDPOINTS; j++) {
+    gp->maxdist[j] = 0;
+    gp->mindist[j] = GEOFIXMAX;
+  }
   for (i = 0; i < gp->RorPoints; i++) {
     GeoMkDetail(gix, &gd, gix->gc + gp->points[i]);
-    for (j = 0; j < GeoIndexFIXEDPOINTS; j++)
+    for (j = 0; j < GeoIndexFIXEDPOINTS; j++) {
       if (gd.fixdist[j] > gp->maxdist[j]) gp->maxdist[j] = gd.fixdist[j];
+      if (gd.fixdist[j] < gp->mindist[j]) gp->mindist[j] = gd.fixdist[j];
+    }
     if (gd.gs < gsa[0]) gsa[0] = gd.gs;
     if (gd.gs > gsa[1]) gsa[1] = gd.gs;
   }
@@ -1348,7 +1376,8 @@ int GeoGetPot(GeoPath* gt, int height) {
 /* specified (which may not be a leaf pot) by taking   */
 /* the data from the child pots.  It populates the     */
 /* start, middle and end GeoStrings, the level, and    */
-/* the maximum distances to the fixed points.          */
+/* the maximum and minimum distances to the fixed      */
+/* points.                                             */
 /* =================================================== */
 void GeoAdjust(GeoIx* gix, int potx) /* the kids are alright */
 {
@@ -1371,6 +1400,8 @@ void GeoAdjust(GeoIx* gix, int potx) /* the kids are alright */
   for (i = 0; i < GeoIndexFIXEDPOINTS; i++) {
     gpx->maxdist[i] = gpy->maxdist[i];
     if (gpx->maxdist[i] < gpz->maxdist[i]) gpx->maxdist[i] = gpz->maxdist[i];
+    gpx->mindist[i] = gpy->mindist[i];
+    if (gpx->mindist[i] > gpz->mindist[i]) gpx->mindist[i] = gpz->mindist[i];
   }
 }
 /* =================================================== */
@@ -1578,6 +1609,14 @@ int GeoIndex_insert(GeoIdx* gi, GeoCoordinate* c) {
         break;
       j--;
     }
+    j = gt.pathlength - 1;
+    while (j >= 0) {
+      if (gd.fixdist[i] < gix->pots[gt.path[j]].mindist[i])
+        gix->pots[gt.path[j]].mindist[i] = gd.fixdist[i];
+      else
+        break;
+      j--;
+    }
   }
   /* just need to balance the tree  */
   if (rebalance == 0) return 0;
@@ -2025,6 +2064,8 @@ GeoFix makedist(GeoPot* pot, GeoDetailedPoint* gd) {
   for (i = 0; i < GeoIndexFIXEDPOINTS; i++) {
     if (gd->fixdist[i] > pot->maxdist[i])
       d1 = gd->fixdist[i] - pot->maxdist[i];
+    else if (pot->mindist[i] > gd->fixdist[i])
+      d1 = pot->mindist[i] - gd->fixdist[i];
     else
       d1 = 0;
     if (d1 > dist) dist = d1;
@@ -2188,6 +2229,9 @@ void RecursivePotDump(GeoIx* gix, FILE* f, int pot) {
   fprintf(f, "maxdists ");
   for (i = 0; i < GeoIndexFIXEDPOINTS; i++) fprintf(f, " %x", gp->maxdist[i]);
   fprintf(f, "\n");
+  fprintf(f, "mindists ");
+  for (i = 0; i < GeoIndexFIXEDPOINTS; i++) fprintf(f, " %x", gp->mindist[i]);
+  fprintf(f, "\n");
   if (gp->LorLeaf == 0) {
     fprintf(f, "Leaf pot containing %d points . . .\n", gp->RorPoints);
     for (i = 0; i < gp->RorPoints; i++) {
@@ -2220,22 +2264,30 @@ int RecursivePotValidate(GeoIx* gix, int pot, int* usage) {
   GeoPot* gp;
   GeoDetailedPoint gd;
   GeoFix maxdist[GeoIndexFIXEDPOINTS];
+  GeoFix mindist[GeoIndexFIXEDPOINTS];
   GeoPot *gpa, *gpb;
   gp = gix->pots + pot;
   usage[0]++;
   if (gp->LorLeaf == 0) {
     if ((pot != 1) && (2 * gp->RorPoints < GeoIndexPOTSIZE)) return 1;
-    for (j = 0; j < GeoIndexFIXEDPOINTS; j++) maxdist[j] = 0;
+    for (j = 0; j < GeoIndexFIXEDPOINTS; j++) {
+      maxdist[j] = 0;
+      mindist[j] = GEOFIXMAX;
+    }
     if (gp->level != 1) return 10;
     for (i = 0; i < gp->RorPoints; i++) {
       GeoMkDetail(gix, &gd, gix->gc + gp->points[i]);
-      for (j = 0; j < GeoIndexFIXEDPOINTS; j++)
+      for (j = 0; j < GeoIndexFIXEDPOINTS; j++) {
         if (maxdist[j] < gd.fixdist[j]) maxdist[j] = gd.fixdist[j];
+        if (mindist[j] > gd.fixdist[j]) mindist[j] = gd.fixdist[j];
+      }
       if (gd.gs < gp->start) return 8;
       if (gd.gs > gp->end) return 9;
     }
     for (j = 0; j < GeoIndexFIXEDPOINTS; j++)
       if (maxdist[j] != gp->maxdist[j]) return 7;
+    for (j = 0; j < GeoIndexFIXEDPOINTS; j++)
+      if (mindist[j] != gp->mindist[j]) return 14;
     usage[1] += gp->RorPoints;
     return 0;
   } else {
@@ -2259,6 +2311,11 @@ int RecursivePotValidate(GeoIx* gix, int pot, int* usage) {
       if (maxdist[j] < gpb->maxdist[j]) maxdist[j] = gpb->maxdist[j];
     for (j = 0; j < GeoIndexFIXEDPOINTS; j++)
       if (maxdist[j] != gp->maxdist[j]) return 13;
+    for (j = 0; j < GeoIndexFIXEDPOINTS; j++) mindist[j] = gpa->mindist[j];
+    for (j = 0; j < GeoIndexFIXEDPOINTS; j++)
+      if (mindist[j] > gpb->mindist[j]) mindist[j] = gpb->mindist[j];
+    for (j = 0; j < GeoIndexFIXEDPOINTS; j++)
+      if (mindist[j] != gp->mindist[j]) return 15;
     i = RecursivePotValidate(gix, gp->LorLeaf, usage);
     if (i != 0) return i;
     i = RecursivePotValidate(gix, gp->RorPoints, usage);
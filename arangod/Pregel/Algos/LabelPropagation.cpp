@@ -38,11 +38,13 @@ using namespace arangodb::pregel::algos;
 static const uint64_t STABILISATION_ROUNDS = 20;
 
 struct LPComputation : public VertexComputation<LPValue, int8_t, uint64_t> {
-  LPComputation() {}
+  bool const _async;
+  explicit LPComputation(bool async) : _async(async) {}
 
   void compute(MessageIterator<uint64_t> const& messages) override {
     LPValue* value = mutableVertexData();
-    if (globalSuperstep() == 0) {
+    // equal to the global superstep unless running asynchronously
+    if (localSuperstep() == 0) {
       sendMessageToAllEdges(value->currentCommunity);
     } else {
       uint64_t newCommunity = value->currentCommunity;
@@ -86,11 +88,16 @@ struct LPComputation : public VertexComputation<LPValue, int8_t, uint64_t> {
       }
 
       bool isUnstable = value->stabilizationRounds <= STABILISATION_ROUNDS;
+      if (_async) {
+        // there is no maximum superstep within a global superstep
+        isUnstable = isUnstable && value->migrations < STABILISATION_ROUNDS;
+      }
       bool mayChange = value->currentCommunity != newCommunity;
       if (mayChange && isUnstable) {
         value->lastCommunity = value->currentCommunity;
         value->currentCommunity = newCommunity;
         value->stabilizationRounds = 0;  // reset stabilization counter
+        value->migrations++;
         sendMessageToAllEdges(value->currentCommunity);
       }
     }
@@ -100,7 +107,7 @@ struct LPComputation : public VertexComputation<LPValue, int8_t, uint64_t> {
 
 VertexComputation<LPValue, int8_t, uint64_t>*
 LabelPropagation::createComputation(WorkerConfig const* config) const {
-  return new LPComputation();
+  return new LPComputation(config->asynchronousMode());
 }
 
 struct LPGraphFormat : public GraphFormat<LPValue, int8_t> {
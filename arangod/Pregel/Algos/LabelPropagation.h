@@ -38,12 +38,17 @@ namespace algos {
 /// most frequently. Tries to avoid osscilation, usually won't converge so
 /// specify a
 /// maximum superstep number.
+/// In the asynchronous mode vertices only see the communities of neighbours
+/// which changed since their last computation, and each vertex migrates at
+/// most a fixed number of times, so that the execution always ends.
 struct LabelPropagation : public SimpleAlgorithm<LPValue, int8_t, uint64_t> {
  public:
   LabelPropagation(VPackSlice userParams)
       : SimpleAlgorithm<LPValue, int8_t, uint64_t>("LabelPropagation",
                                                    userParams) {}
 
+  bool supportsAsyncMode() const override { return true; }
+
   GraphFormat<LPValue, int8_t>* inputFormat() const override;
   MessageFormat<uint64_t>* messageFormat() const override {
     return new NumberMessageFormat<uint64_t>();
@@ -52,6 +52,8 @@ PageRank::PageRank(VPackSlice const& params)
     : SimpleAlgorithm("PageRank", params) {
   _maxGSS =
       basics::VelocyPackHelper::getNumericValue(params, "maxIterations", 250);
+  VPackSlice t = params.get("threshold");
+  _threshold = t.isNumber() ? t.getNumber<float>() : EPS;
 }
 
 struct PRComputation : public VertexComputation<float, float, float> {
@@ -81,8 +83,46 @@ struct PRComputation : public VertexComputation<float, float, float> {
   }
 };
 
+/// Delta based PageRank for the asynchronous mode. Every vertex starts with
+/// the teleport probability as its rank and sends the damped share of each
+/// change of its rank to its neighbours. Messages are summed up, so a vertex
+/// receives the changes of its in-neighbours' ranks since its last
+/// computation. Changes smaller than the threshold relative to the rank are
+/// not propagated, after which the vertices stop sending messages and the
+/// execution ends.
+struct AsyncPRComputation : public VertexComputation<float, float, float> {
+  float const _threshold;
+  explicit AsyncPRComputation(float threshold) : _threshold(threshold) {}
+  void compute(MessageIterator<float> const& messages) override {
+    float* ptr = mutableVertexData();
+    float delta = 0.0;
+
+    if (localSuperstep() == 0) {
+      delta = 0.15 / context()->vertexCount();
+      *ptr = delta;
+    } else {
+      for (const float* msg : messages) {
+        delta += *msg;
+      }
+      *ptr += delta;
+    }
+
+    RangeIterator<Edge<float>> edges = getEdges();
+    if (edges.size() > 0 && delta > _threshold * *ptr) {
+      float val = 0.85 * delta / edges.size();
+      for (Edge<float>* edge : edges) {
+        sendMessage(edge, val);
+      }
+    }
+    voteHalt();
+  }
+};
+
 VertexComputation<float, float, float>* PageRank::createComputation(
     WorkerConfig const* config) const {
+  if (config->asynchronousMode()) {
+    return new AsyncPRComputation(_threshold);
+  }
   return new PRComputation();
 }
 
@@ -33,9 +33,13 @@ namespace algos {
 /// PageRank
 struct PageRank : public SimpleAlgorithm<float, float, float> {
   uint64_t _maxGSS = 250;
+  float _threshold;
 
   PageRank(arangodb::velocypack::Slice const& params);
 
+  /// the asynchronous mode propagates rank deltas instead of ranks
+  bool supportsAsyncMode() const override { return true; }
+
   GraphFormat<float, float>* inputFormat() const override {
     return new VertexGraphFormat<float, float>(_resultField, 0);
   }
@@ -42,6 +42,8 @@ struct LPValue {
   uint64_t lastCommunity = UINT64_MAX;
   /// Iterations since last migration.
   uint64_t stabilizationRounds = 0;
+  /// Number of migrations, bounds the asynchronous execution
+  uint64_t migrations = 0;
 };
 
 /// Value for Hyperlink-Induced Topic Search (HITS; also known as
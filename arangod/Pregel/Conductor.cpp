@@ -94,6 +94,17 @@ Conductor::Conductor(uint64_t executionNumber, TRI_vocbase_t* vocbase,
   if (!_storeResults) {
     LOG_TOPIC(INFO, Logger::PREGEL) << "Will keep results in-memory";
   }
+  VPackSlice result = _userParams.slice().get("resultCollection");
+  if (result.isString()) {
+    if (_vertexCollections.size() != 1) {
+      THROW_ARANGO_EXCEPTION_MESSAGE(
+          TRI_ERROR_BAD_PARAMETER,
+          "a result collection requires exactly one vertex collection");
+    }
+    _resultCollection = result.copyString();
+    LOG_TOPIC(INFO, Logger::PREGEL) << "Will insert results into "
+                                    << _resultCollection;
+  }
 }
 
 Conductor::~Conductor() {
@@ -132,10 +143,15 @@ bool Conductor::_startGlobalStep() {
   _statistics.resetActiveCount();
   _totalVerticesCount = 0;  // might change during execution
   _totalEdgesCount = 0;
+  uint64_t checkpointGSS = UINT64_MAX;
   // we are explicitly expecting an response containing the aggregated
   // values as well as the count of active vertices
   int res = _sendToAllDBServers(
       Utils::prepareGSSPath, b, [&](VPackSlice const& payload) {
+        // a checkpoint is only usable if every worker has written it
+        VPackSlice checkpoint = payload.get(Utils::checkpointKey);
+        checkpointGSS = std::min(
+            checkpointGSS, checkpoint.isInteger() ? checkpoint.getUInt() : 0);
         _aggregators->aggregateValues(payload);
         _statistics.accumulateActiveCounts(payload);
         _totalVerticesCount += payload.get(Utils::vertexCountKey).getUInt();
@@ -148,6 +164,9 @@ bool Conductor::_startGlobalStep() {
     // the recovery mechanisms should take care of this
     return false;
   }
+  if (checkpointGSS != UINT64_MAX) {
+    _checkpointGSS = checkpointGSS;
+  }
 
   // workers are done if all messages were processed and no active vertices
   // are left to process
@@ -220,12 +239,22 @@ void Conductor::finishedWorkerStartup(VPackSlice const& data) {
 
   _totalVerticesCount += data.get(Utils::vertexCountKey).getUInt();
   _totalEdgesCount += data.get(Utils::edgeCountKey).getUInt();
+  VPackSlice bytes = data.get(Utils::residentBytesKey);
+  if (bytes.isInteger()) {
+    _residentBytes += bytes.getUInt();
+  }
+  bytes = data.get(Utils::mappedBytesKey);
+  if (bytes.isInteger()) {
+    _mappedBytes += bytes.getUInt();
+  }
   if (_respondedServers.size() != _dbServers.size()) {
     return;
   }
 
   LOG_TOPIC(INFO, Logger::PREGEL) << _totalVerticesCount << " vertices, "
-                                  << _totalEdgesCount << " edges";
+                                  << _totalEdgesCount << " edges, "
+                                  << _residentBytes << " bytes on the heap, "
+                                  << _mappedBytes << " bytes memory mapped";
   if (_masterContext) {
     _masterContext->_globalSuperstep = 0;
     _masterContext->_vertexCount = _totalVerticesCount;
@@ -322,13 +351,17 @@ void Conductor::finishedRecoveryStep(VPackSlice const& data) {
     return;
   }
 
+  if (_rollback) {
+    _finishedRollbackStep(data);
+    return;
+  }
+
   // the recovery mechanism might be gathering state information
   _aggregators->aggregateValues(data);
   if (_respondedServers.size() != _dbServers.size()) {
     return;
   }
 
-  // only compensations supported
   bool proceed = false;
   if (_masterContext) {
     proceed = proceed || _masterContext->postCompensation();
@@ -371,6 +404,46 @@ void Conductor::finishedRecoveryStep(VPackSlice const& data) {
   }
 }
 
+// only called by finishedRecoveryStep, protected by the _callbackMutex
+void Conductor::_finishedRollbackStep(VPackSlice const& data) {
+  _rollbackFailed = _rollbackFailed || !data.get(Utils::restoredKey).isTrue();
+  // restored messages are accounted like messages sent in the last superstep
+  _statistics.accumulateMessageStats(data);
+  if (_respondedServers.size() != _dbServers.size()) {
+    return;
+  }
+
+  _rollback = false;
+  if (_rollbackFailed) {
+    // at least one worker could not restore its checkpoint, all workers
+    // reload their data on the next attempt
+    LOG_TOPIC(WARN, Logger::PREGEL)
+        << "Restoring the checkpoint of gss " << _checkpointGSS << " failed";
+    _checkpointGSS = 0;
+    _state = ExecutionState::IN_ERROR;
+    ThreadPool* pool = PregelFeature::instance()->threadPool();
+    pool->enqueue([this] { startRecovery(); });
+    return;
+  }
+
+  LOG_TOPIC(INFO, Logger::PREGEL) << "Restored the checkpoint of gss "
+                                  << _checkpointGSS << ". Proceeding normally";
+  _globalSuperstep = _checkpointGSS;
+  VPackBuilder b;
+  b.openObject();
+  b.add(Utils::executionNumberKey, VPackValue(_executionNumber));
+  b.add(Utils::globalSuperstepKey, VPackValue(_globalSuperstep));
+  b.close();
+  int res = _sendToAllDBServers(Utils::finalizeRecoveryPath, b);
+  if (res == TRI_ERROR_NO_ERROR) {
+    _state = ExecutionState::RUNNING;
+    _startGlobalStep();
+  } else {
+    cancel();
+    LOG_TOPIC(INFO, Logger::PREGEL) << "Recovery failed";
+  }
+}
+
 void Conductor::cancel() {
   if (_state == ExecutionState::RUNNING ||
       _state == ExecutionState::RECOVERING ||
@@ -384,7 +457,8 @@ void Conductor::startRecovery() {
   MUTEX_LOCKER(guard, _callbackMutex);
   if (_state != ExecutionState::RUNNING && _state != ExecutionState::IN_ERROR) {
     return;  // maybe we are already in recovery mode
-  } else if (_algorithm->supportsCompensation() == false) {
+  } else if (_checkpointGSS == 0 &&
+             _algorithm->supportsCompensation() == false) {
     LOG_TOPIC(ERR, Logger::PREGEL) << "Algorithm does not support recovery";
     cancel();
     return;
@@ -394,6 +468,8 @@ void Conductor::startRecovery() {
   // so they load the data for the lost machine
   _state = ExecutionState::RECOVERING;
   _statistics.reset();
+  _rollback = _checkpointGSS > 0;
+  _rollbackFailed = false;
 
   ThreadPool* pool = PregelFeature::instance()->threadPool();
   pool->enqueue([this] {
@@ -426,17 +502,23 @@ void Conductor::startRecovery() {
       return;  // seems like we are canceled
     }
 
-    // Let's try recovery
-    if (_masterContext) {
-      bool proceed = _masterContext->preCompensation();
-      if (!proceed) {
-        cancel();
-      }
-    }
-
     VPackBuilder additionalKeys;
     additionalKeys.openObject();
-    additionalKeys.add(Utils::recoveryMethodKey, VPackValue(Utils::compensate));
+    if (_rollback) {
+      // all workers restart from the latest complete checkpoint
+      additionalKeys.add(Utils::recoveryMethodKey, VPackValue(Utils::rollback));
+      additionalKeys.add(Utils::checkpointKey, VPackValue(_checkpointGSS));
+    } else {
+      // Let's try recovery
+      if (_masterContext) {
+        bool proceed = _masterContext->preCompensation();
+        if (!proceed) {
+          cancel();
+        }
+      }
+      additionalKeys.add(Utils::recoveryMethodKey,
+                         VPackValue(Utils::compensate));
+    }
     _aggregators->serializeValues(b);
     additionalKeys.close();
     _aggregators->resetValues();
@@ -496,6 +578,60 @@ static void resolveInfo(
   }
 }
 
+// maps each vertex shard to the shard of the result collection with the
+// same index. results are inserted into the result shard on the server of the
+// vertex shard with the key of the vertex, so both collections need the same
+// shards on the same servers and must be sharded by _key
+static std::map<ShardID, ShardID> resolveResultShards(
+    TRI_vocbase_t* vocbase, CollectionID const& vertexCollection,
+    CollectionID const& resultCollection) {
+  std::map<ShardID, ShardID> resultShards;
+
+  ServerState* ss = ServerState::instance();
+  if (!ss->isRunningInCluster()) {  // single server mode
+    LogicalCollection* lc = vocbase->lookupCollection(resultCollection);
+    if (lc == nullptr || lc->deleted()) {
+      THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_ARANGO_COLLECTION_NOT_FOUND,
+                                     resultCollection);
+    }
+    resultShards.emplace(vertexCollection, resultCollection);
+    return resultShards;
+  }
+
+  ClusterInfo* ci = ClusterInfo::instance();
+  std::shared_ptr<LogicalCollection> vertices =
+      ci->getCollection(vocbase->name(), vertexCollection);
+  std::shared_ptr<LogicalCollection> results =
+      ci->getCollection(vocbase->name(), resultCollection);
+  if (!results || results->deleted()) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_ARANGO_COLLECTION_NOT_FOUND,
+                                   resultCollection);
+  }
+
+  std::shared_ptr<std::vector<ShardID>> vertexShards =
+      ci->getShardList(vertices->cid_as_string());
+  std::shared_ptr<std::vector<ShardID>> resultShardList =
+      ci->getShardList(results->cid_as_string());
+  std::vector<std::string> const keyOnly{StaticStrings::KeyString};
+  bool compatible = vertexShards->size() == resultShardList->size() &&
+                    vertices->shardKeys() == keyOnly &&
+                    results->shardKeys() == keyOnly;
+  for (size_t i = 0; compatible && i < vertexShards->size(); i++) {
+    std::shared_ptr<std::vector<ServerID>> a =
+        ci->getResponsibleServer((*vertexShards)[i]);
+    std::shared_ptr<std::vector<ServerID>> b =
+        ci->getResponsibleServer((*resultShardList)[i]);
+    compatible = !a->empty() && !b->empty() && (*a)[0] == (*b)[0];
+    resultShards.emplace((*vertexShards)[i], (*resultShardList)[i]);
+  }
+  if (!compatible) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(
+        TRI_ERROR_BAD_PARAMETER,
+        "the result collection must be sharded like the vertex collection");
+  }
+  return resultShards;
+}
+
 /// should cause workers to start a new execution or begin with recovery
 /// proceedings
 int Conductor::_initializeWorkers(std::string const& suffix,
@@ -528,6 +664,12 @@ int Conductor::_initializeWorkers(std::string const& suffix,
     _allShards = shardList;
   }
 
+  std::map<ShardID, ShardID> resultShards;
+  if (!_resultCollection.empty()) {
+    resultShards = resolveResultShards(
+        _vocbaseGuard.vocbase(), _vertexCollections[0], _resultCollection);
+  }
+
   std::string coordinatorId = ServerState::instance()->getId();
   LOG_TOPIC(INFO, Logger::PREGEL) << "My id: " << coordinatorId;
   std::vector<ClusterCommRequest> requests;
@@ -582,6 +724,18 @@ int Conductor::_initializeWorkers(std::string const& suffix,
       b.add(VPackValue(shard));
     }
     b.close();
+    if (!resultShards.empty()) {
+      b.add(Utils::resultShardsKey, VPackValue(VPackValueType::Object));
+      for (auto const& pair : vertexShardMap) {
+        for (ShardID const& shard : pair.second) {
+          auto const& rs = resultShards.find(shard);
+          if (rs != resultShards.end()) {
+            b.add(shard, VPackValue(rs->second));
+          }
+        }
+      }
+      b.close();
+    }
     b.close();
 
     // only on single server
@@ -73,18 +73,29 @@ class Conductor {
   /// unique response, not necessarily during the async mode
   std::set<ServerID> _respondedServers;
   uint64_t _globalSuperstep = 0;
+  /// latest global superstep for which all workers wrote a checkpoint
+  uint64_t _checkpointGSS = 0;
+  /// the current recovery restores the checkpoint
+  bool _rollback = false;
+  bool _rollbackFailed = false;
   /// adjustable maximum gss for some algorithms
   uint64_t _maxSuperstep = 500;
   /// determines whether we support async execution
   bool _asyncMode = false;
   bool _lazyLoading = false;
   bool _storeResults = false;
+  /// collection the results are inserted into instead of updating the
+  /// vertex documents, empty for the latter
+  std::string _resultCollection;
 
   /// persistent tracking of active vertices, send messages, runtimes
   StatsManager _statistics;
   /// Current number of vertices
   uint64_t _totalVerticesCount = 0;
   uint64_t _totalEdgesCount = 0;
+  /// graph data of all workers on the heap and in memory mapped buffers
+  uint64_t _residentBytes = 0;
+  uint64_t _mappedBytes = 0;
   /// some tracking info
   double _startTimeSecs = 0, _computationStartTimeSecs, _endTimeSecs = 0;
 
@@ -95,6 +106,7 @@ class Conductor {
   int _sendToAllDBServers(std::string const& path, VPackBuilder const& message,
                           std::function<void(VPackSlice)> handle);
   void _ensureUniqueResponse(VPackSlice body);
+  void _finishedRollbackStep(VPackSlice const& data);
 
   // === REST callbacks ===
   void finishedWorkerStartup(VPackSlice const& data);
@@ -118,6 +130,8 @@ class Conductor {
   ExecutionState getState() const { return _state; }
   StatsManager workerStats() const { return _statistics; }
   uint64_t globalSuperstep() const { return _globalSuperstep; }
+  uint64_t residentBytes() const { return _residentBytes; }
+  uint64_t mappedBytes() const { return _mappedBytes; }
 
   VPackBuilder collectAQLResults();
   double totalRuntimeSecs() {
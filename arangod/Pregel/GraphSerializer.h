@@ -24,36 +24,175 @@
 #define ARANGODB_PREGEL_GRAPH_SERIALIZER_H 1
 
 #include <velocypack/Builder.h>
+#include <velocypack/Iterator.h>
 #include <velocypack/Slice.h>
 #include <velocypack/velocypack-aliases.h>
 #include <cstddef>
 
 #include "Basics/Common.h"
+#include "Pregel/Algos/EffectiveCloseness/HLLCounterFormat.h"
 #include "Pregel/CommonFormats.h"
 #include "Pregel/Graph.h"
 
 namespace arangodb {
 namespace pregel {
 
+/// writes the complete state of a vertex value as VelocyPack, e.g. for
+/// checkpoints. needed for every vertex type that is not trivially copyable
 template <typename V>
 struct VertexSerializer {
   virtual ~VertexSerializer() {}
 
-  virtual void serialize(VPackBuilder const& builder,
-                         V const* targetPtr) const = 0;
+  virtual void serialize(VPackBuilder& builder, V const* targetPtr) const = 0;
 
   virtual bool deserialize(VPackSlice const& data, V* targetPtr) const = 0;
 };
 
 template <>
 struct VertexSerializer<int64_t> {
-  virtual void serialize(VPackBuilder const& builder,
-                         int64_t const* targetPtr) const {
+  void serialize(VPackBuilder& builder, int64_t const* targetPtr) const {
     builder.add(VPackValue(*targetPtr));
-  };
-  virtual bool deserialize(VPackSlice const& data, int64_t* targetPtr) const {
+  }
+  bool deserialize(VPackSlice const& data, int64_t* targetPtr) const {
+    if (!data.isInteger()) {
+      return false;
+    }
     *targetPtr = data.getInt();
-  };
+    return true;
+  }
+};
+
+/// a vertex id is stored as [shard, key]
+struct PregelIDSerializer {
+  static void serialize(VPackBuilder& builder, PregelID const& id) {
+    builder.openArray();
+    builder.add(VPackValue(id.shard));
+    builder.add(VPackValue(id.key));
+    builder.close();
+  }
+  static bool deserialize(VPackSlice const& data, PregelID& id) {
+    if (!data.isArray() || data.length() < 2 || !data.at(0).isInteger() ||
+        !data.at(1).isString()) {
+      return false;
+    }
+    id.shard = data.at(0).getNumber<PregelShard>();
+    id.key = data.at(1).copyString();
+    return true;
+  }
+};
+
+/// [vertexID, color, [parent, ...]]
+template <>
+struct VertexSerializer<SCCValue> {
+  void serialize(VPackBuilder& builder, SCCValue const* targetPtr) const {
+    builder.openArray();
+    builder.add(VPackValue(targetPtr->vertexID));
+    builder.add(VPackValue(targetPtr->color));
+    builder.openArray();
+    for (PregelID const& parent : targetPtr->parents) {
+      PregelIDSerializer::serialize(builder, parent);
+    }
+    builder.close();
+    builder.close();
+  }
+  bool deserialize(VPackSlice const& data, SCCValue* targetPtr) const {
+    if (!data.isArray() || data.length() != 3 || !data.at(0).isInteger() ||
+        !data.at(1).isInteger() || !data.at(2).isArray()) {
+      return false;
+    }
+    targetPtr->vertexID = data.at(0).getNumber<uint64_t>();
+    targetPtr->color = data.at(1).getNumber<uint64_t>();
+    targetPtr->parents.clear();
+    for (VPackSlice parent : VPackArrayIterator(data.at(2))) {
+      PregelID id;
+      if (!PregelIDSerializer::deserialize(parent, id)) {
+        return false;
+      }
+      targetPtr->parents.emplace_back(std::move(id));
+    }
+    return true;
+  }
+};
+
+/// [counter, [shortestPath, ...]]
+template <>
+struct VertexSerializer<ECValue> {
+  void serialize(VPackBuilder& builder, ECValue const* targetPtr) const {
+    builder.openArray();
+    HLLCounterFormat().addValue(builder, targetPtr->counter);
+    builder.openArray();
+    for (int32_t length : targetPtr->shortestPaths) {
+      builder.add(VPackValue(length));
+    }
+    builder.close();
+    builder.close();
+  }
+  bool deserialize(VPackSlice const& data, ECValue* targetPtr) const {
+    if (!data.isArray() || data.length() != 2 || !data.at(0).isArray() ||
+        data.at(0).length() != HLLCounter::NUM_BUCKETS ||
+        !data.at(1).isArray()) {
+      return false;
+    }
+    HLLCounterFormat().unwrapValue(data.at(0), targetPtr->counter);
+    targetPtr->shortestPaths.clear();
+    for (VPackSlice length : VPackArrayIterator(data.at(1))) {
+      if (!length.isInteger()) {
+        return false;
+      }
+      targetPtr->shortestPaths.push_back(length.getNumber<int32_t>());
+    }
+    return true;
+  }
+};
+
+/// [weightedInDegree, [[id, degree], ...], [[id, value], ...]]
+template <>
+struct VertexSerializer<DMIDValue> {
+  void serialize(VPackBuilder& builder, DMIDValue const* targetPtr) const {
+    builder.openArray();
+    builder.add(VPackValue(targetPtr->weightedInDegree));
+    serializeMap(builder, targetPtr->membershipDegree);
+    serializeMap(builder, targetPtr->disCol);
+    builder.close();
+  }
+  bool deserialize(VPackSlice const& data, DMIDValue* targetPtr) const {
+    if (!data.isArray() || data.length() != 3 || !data.at(0).isNumber()) {
+      return false;
+    }
+    targetPtr->weightedInDegree = data.at(0).getNumber<float>();
+    return deserializeMap(data.at(1), targetPtr->membershipDegree) &&
+           deserializeMap(data.at(2), targetPtr->disCol);
+  }
+
+ private:
+  static void serializeMap(VPackBuilder& builder,
+                           std::map<PregelID, float> const& map) {
+    builder.openArray();
+    for (auto const& it : map) {
+      builder.openArray();
+      PregelIDSerializer::serialize(builder, it.first);
+      builder.add(VPackValue(it.second));
+      builder.close();
+    }
+    builder.close();
+  }
+  static bool deserializeMap(VPackSlice const& data,
+                             std::map<PregelID, float>& map) {
+    if (!data.isArray()) {
+      return false;
+    }
+    map.clear();
+    for (VPackSlice entry : VPackArrayIterator(data)) {
+      PregelID id;
+      if (!entry.isArray() || entry.length() != 2 ||
+          !PregelIDSerializer::deserialize(entry.at(0), id) ||
+          !entry.at(1).isNumber()) {
+        return false;
+      }
+      map.emplace(std::move(id), entry.at(1).getNumber<float>());
+    }
+    return true;
+  }
 };
 }
 }
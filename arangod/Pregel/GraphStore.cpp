@@ -25,7 +25,9 @@
 #include <algorithm>
 #include "Basics/Common.h"
 #include "Basics/MutexLocker.h"
+#include "Basics/StringRef.h"
 #include "Pregel/CommonFormats.h"
+#include "Pregel/GraphSerializer.h"
 #include "Pregel/PregelFeature.h"
 #include "Pregel/ThreadPool.h"
 #include "Pregel/Utils.h"
@@ -64,6 +66,9 @@ static uint64_t TRI_totalSystemMemory() {
 #endif
 }
 
+/// @brief number of vertices written with one document operation
+static size_t const StoreBatchSize = 10000;
+
 template <typename V, typename E>
 GraphStore<V, E>::GraphStore(TRI_vocbase_t* vb, GraphFormat<V, E>* graphFormat)
     : _vocbaseGuard(vb),
@@ -104,14 +109,7 @@ std::map<ShardID, uint64_t> GraphStore<V, E>::_allocateMemory() {
     count += opResult.slice().getUInt();
   }
   _index.resize(count);
-  if (_graphFormat->estimatedVertexSize() > 0) {
-    size_t requiredMem = count * _graphFormat->estimatedVertexSize();
-    if (!_config->lazyLoading() && requiredMem > totalMemory / 2) {
-        _vertexData = new MappedFileBuffer<V>(count);
-    } else {
-      _vertexData = new VectorTypedBuffer<V>(count);
-    }
-  }
+  uint64_t const vertexCount = count;
   
   count = 0;
   for (auto const& shard : _config->localEdgeShardIDs()) {
@@ -123,12 +121,27 @@ std::map<ShardID, uint64_t> GraphStore<V, E>::_allocateMemory() {
     count += opResult.slice().getUInt();
   }
   
-  size_t requiredMem = count * _graphFormat->estimatedEdgeSize();
-  if (!_config->lazyLoading() && requiredMem > totalMemory / 2) {
-    _edges = new MappedFileBuffer<Edge<E>>(count);
-  } else {
-    _edges = new VectorTypedBuffer<Edge<E>>(count);
+  uint64_t const edgeCount = count;
+
+  uint64_t budget = _config->memoryBudget();
+  if (budget == 0) {
+    budget = totalMemory / 2;
   }
+  uint64_t const vertexMem =
+      vertexCount * _graphFormat->estimatedVertexSize();
+  uint64_t const edgeMem = edgeCount * sizeof(Edge<E>);
+
+  allocateBuffers(vertexCount, edgeCount,
+                  _graphFormat->estimatedVertexSize() > 0, vertexMem, budget,
+                  _config->useMemoryMaps(), _config->lazyLoading(),
+                  _vertexData, _edges);
+  LOG_TOPIC(INFO, Logger::PREGEL)
+      << "Placing " << vertexMem << " bytes of vertex data "
+      << (_vertexData != nullptr && _vertexData->isMapped() ? "in a memory map"
+                                                           : "on the heap")
+      << " and " << edgeMem << " bytes of edges "
+      << (_edges->isMapped() ? "in a memory map" : "on the heap")
+      << ", memory budget is " << budget << " bytes";
 
   if (countTrx->commit() != TRI_ERROR_NO_ERROR) {
     LOG_TOPIC(WARN, Logger::PREGEL)
@@ -153,9 +166,13 @@ void GraphStore<V, E>::loadShards(WorkerConfig* config,
   std::map<CollectionID, std::vector<ShardID>> const& edgeCollMap =
       _config->edgeCollectionShards();
 
-  _runningThreads = config->localVertexShardIDs().size();
-  LOG_TOPIC(INFO, Logger::PREGEL) << "Using " << _runningThreads
-                                  << " threads to load data";
+  struct LoadTask {
+    ShardID vertexShard;
+    std::vector<ShardID> edgeShards;
+    uint64_t vertexOffset;
+    uint64_t edgeOffset;
+  };
+  std::vector<LoadTask> tasks;
   for (auto const& pair : vertexCollMap) {
     std::vector<ShardID> const& vertexShards = pair.second;
     for (size_t i = 0; i < vertexShards.size(); i++) {
@@ -181,26 +198,54 @@ void GraphStore<V, E>::loadShards(WorkerConfig* config,
       }
 
       _loadedShards.insert(vertexShard);
-      pool->enqueue([this, &vertexShard, edgeLookups, vertexOffset, edgeOffset,
-                     callback] {
-
-        _loadVertices(vertexShard, edgeLookups, vertexOffset, edgeOffset);
-        {
-          MUTEX_LOCKER(guard, _threadMutex);
-          _runningThreads--;
-          if (_runningThreads == 0) {
-            if (_localEdgeCount < _edges->size()) {
-              _edges->resize(_localEdgeCount);
-            }
-            callback();
-          }
-        }
-      });
+      tasks.emplace_back(
+          LoadTask{vertexShard, edgeLookups, vertexOffset, edgeOffset});
       // update to next offset
       vertexOffset += shardSizes[vertexShard];
       edgeOffset = nextEdgeOffset;
     }
   }
+
+  auto finished = [this, callback] {
+    if (_localEdgeCount < _edges->size()) {
+      _edges->resize(_localEdgeCount);
+    }
+    // every superstep walks vertices and their edges in order
+    if (_vertexData != nullptr) {
+      _vertexData->sequentialAccess();
+    }
+    _edges->sequentialAccess();
+    callback();
+  };
+  if (tasks.empty()) {
+    finished();
+    return;
+  }
+
+  // all shards are loaded at the same time, each one by its own thread.
+  // the offsets into the buffers were computed from the shard sizes above
+  _runningThreads = static_cast<uint32_t>(tasks.size());
+  LOG_TOPIC(INFO, Logger::PREGEL) << "Using " << _runningThreads
+                                  << " threads to load data";
+  for (LoadTask& task : tasks) {
+    pool->enqueue([this, task, finished] {
+      try {
+        _loadVertices(task.vertexShard, task.edgeShards, task.vertexOffset,
+                      task.edgeOffset);
+      } catch (basics::Exception const& ex) {
+        LOG_TOPIC(ERR, Logger::PREGEL) << "Failed to load shard '"
+                                       << task.vertexShard << "': " << ex.what();
+      } catch (...) {
+        LOG_TOPIC(ERR, Logger::PREGEL) << "Failed to load shard '"
+                                       << task.vertexShard << "'";
+      }
+      MUTEX_LOCKER(guard, _threadMutex);
+      _runningThreads--;
+      if (_runningThreads == 0) {
+        finished();
+      }
+    });
+  }
 }
 
 template <typename V, typename E>
@@ -277,9 +322,12 @@ void GraphStore<V, E>::loadDocument(WorkerConfig* config,
     auto it = std::find(vertexShards.begin(), vertexShards.end(), vertexShard);
     if (it != vertexShards.end()) {
       size_t pos = (size_t)(it - vertexShards.begin());
+      // lazy loading is single threaded, so all documents share a pool
+      KeyPool* keys =
+          _keyPools.empty() ? _createKeyPool() : _keyPools[0].get();
       for (auto const& pair2 : edgeMap) {
         std::vector<ShardID> const& edgeShards = pair2.second;
-        _loadEdges(trx.get(), edgeShards[pos], entry, documentId);
+        _loadEdges(trx.get(), edgeShards[pos], entry, documentId, keys);
       }
       break;
     }
@@ -290,6 +338,220 @@ void GraphStore<V, E>::loadDocument(WorkerConfig* config,
   }
 }
 
+/// graph data exceeding the memory budget is placed in memory mapped
+/// buffers, edges first since they are larger and accessed in order. lazy
+/// loading grows the buffers one element at a time, which needs vectors
+template <typename V, typename E>
+void GraphStore<V, E>::allocateBuffers(
+    uint64_t vertexCount, uint64_t edgeCount, bool hasVertexData,
+    uint64_t vertexBytes, uint64_t budget, bool useMemoryMaps,
+    bool lazyLoading, TypedBuffer<V>*& vertexData,
+    TypedBuffer<Edge<E>>*& edges) {
+  uint64_t const edgeBytes = edgeCount * sizeof(Edge<E>);
+
+  if (hasVertexData) {
+    if (!lazyLoading && (useMemoryMaps || vertexBytes > budget)) {
+      vertexData = new MappedFileBuffer<V>(vertexCount);
+    } else {
+      vertexData = new VectorTypedBuffer<V>(vertexCount);
+    }
+  }
+  if (!lazyLoading && (useMemoryMaps || vertexBytes + edgeBytes > budget)) {
+    edges = new MappedFileBuffer<Edge<E>>(edgeCount);
+  } else {
+    edges = new VectorTypedBuffer<Edge<E>>(edgeCount);
+  }
+}
+
+template <typename V, typename E>
+uint64_t GraphStore<V, E>::residentBytes() const {
+  uint64_t bytes = _index.capacity() * sizeof(VertexEntry);
+  if (_vertexData != nullptr && !_vertexData->isMapped()) {
+    bytes += _vertexData->size() * sizeof(V);
+  }
+  if (_edges != nullptr && !_edges->isMapped()) {
+    bytes += _edges->size() * sizeof(Edge<E>);
+  }
+  return bytes;
+}
+
+template <typename V, typename E>
+uint64_t GraphStore<V, E>::mappedBytes() const {
+  uint64_t bytes = 0;
+  if (_vertexData != nullptr && _vertexData->isMapped()) {
+    bytes += _vertexData->size() * sizeof(V);
+  }
+  if (_edges != nullptr && _edges->isMapped()) {
+    bytes += _edges->size() * sizeof(Edge<E>);
+  }
+  return bytes;
+}
+
+/// marks snapshots whose vertex values are stored as VelocyPack
+static uint32_t const SerializedValueSize = UINT32_MAX;
+
+/// trivially copyable vertex values are stored as raw bytes
+template <typename V>
+using IsRawValue =
+    std::integral_constant<bool, std::is_trivially_copyable<V>::value>;
+
+template <typename V>
+static uint32_t snapshotValueSize(std::true_type) {
+  return sizeof(V);
+}
+
+template <typename V>
+static uint32_t snapshotValueSize(std::false_type) {
+  return SerializedValueSize;
+}
+
+template <typename V>
+static void appendValue(std::string& out, V const* value, std::true_type) {
+  out.append(reinterpret_cast<char const*>(value), sizeof(V));
+}
+
+/// values that are not trivially copyable are stored as length (uint32_t)
+/// and VelocyPack
+template <typename V>
+static void appendValue(std::string& out, V const* value, std::false_type) {
+  VPackBuilder builder;
+  VertexSerializer<V>().serialize(builder, value);
+  uint32_t const size = static_cast<uint32_t>(builder.size());
+  out.append(reinterpret_cast<char const*>(&size), sizeof(size));
+  out.append(reinterpret_cast<char const*>(builder.data()), size);
+}
+
+/// returns the number of bytes read, or 0 if the snapshot is invalid
+template <typename V>
+static size_t readValue(char const* in, char const* end, V* value,
+                        std::true_type) {
+  if (end - in < static_cast<ptrdiff_t>(sizeof(V))) {
+    return 0;
+  }
+  memcpy(static_cast<void*>(value), in, sizeof(V));
+  return sizeof(V);
+}
+
+template <typename V>
+static size_t readValue(char const* in, char const* end, V* value,
+                        std::false_type) {
+  uint32_t size = 0;
+  if (end - in < static_cast<ptrdiff_t>(sizeof(size))) {
+    return 0;
+  }
+  memcpy(&size, in, sizeof(size));
+  in += sizeof(size);
+  if (end - in < static_cast<ptrdiff_t>(size)) {
+    return 0;
+  }
+  VPackSlice slice(reinterpret_cast<uint8_t const*>(in));
+  if (size == 0 || slice.byteSize() != size ||
+      !VertexSerializer<V>().deserialize(slice, value)) {
+    return 0;
+  }
+  return sizeof(size) + size;
+}
+
+/// a snapshot starts with the size of the vertex data (or
+/// SerializedValueSize), followed by one record per vertex: key length
+/// (uint32_t), key, active flag (uint8_t) and the vertex data
+template <typename V, typename E>
+void GraphStore<V, E>::snapshotVertices(
+    std::map<PregelShard, std::string>& snapshots) const {
+  std::vector<PregelShard> shards;
+  for (ShardID const& shard : _config->localVertexShardIDs()) {
+    shards.push_back(_config->shardId(shard));
+  }
+  snapshotVertices(_index, _vertexData, shards, snapshots);
+}
+
+template <typename V, typename E>
+void GraphStore<V, E>::snapshotVertices(
+    std::vector<VertexEntry> const& index, TypedBuffer<V> const* vertexData,
+    std::vector<PregelShard> const& shards,
+    std::map<PregelShard, std::string>& snapshots) {
+  uint32_t const valueSize =
+      vertexData != nullptr ? snapshotValueSize<V>(IsRawValue<V>()) : 0;
+  for (PregelShard shard : shards) {
+    std::string& out = snapshots[shard];
+    out.append(reinterpret_cast<char const*>(&valueSize), sizeof(valueSize));
+  }
+  for (VertexEntry const& entry : index) {
+    std::string& out = snapshots[entry.shard()];
+    uint32_t const keySize = static_cast<uint32_t>(entry.key().size());
+    out.append(reinterpret_cast<char const*>(&keySize), sizeof(keySize));
+    out.append(entry.key());
+    out.push_back(entry.active() ? 1 : 0);
+    if (valueSize > 0) {
+      appendValue(out, vertexData->data() + entry._vertexDataOffset,
+                  IsRawValue<V>());
+    }
+  }
+}
+
+template <typename V, typename E>
+bool GraphStore<V, E>::restoreVertices(PregelShard shard,
+                                       std::string const& snapshot) {
+  return restoreVertices(_index, _vertexData, shard, snapshot);
+}
+
+template <typename V, typename E>
+bool GraphStore<V, E>::restoreVertices(std::vector<VertexEntry>& index,
+                                       TypedBuffer<V>* vertexData,
+                                       PregelShard shard,
+                                       std::string const& snapshot) {
+  uint32_t const valueSize =
+      vertexData != nullptr ? snapshotValueSize<V>(IsRawValue<V>()) : 0;
+  uint32_t size = 0;
+  if (snapshot.size() < sizeof(size)) {
+    return false;
+  }
+  memcpy(&size, snapshot.data(), sizeof(size));
+  if (size != valueSize) {
+    return false;
+  }
+
+  std::unordered_map<StringRef, VertexEntry*> entries;
+  for (VertexEntry& entry : index) {
+    if (entry.shard() == shard) {
+      entries.emplace(StringRef(entry._key), &entry);
+    }
+  }
+
+  char const* p = snapshot.data() + sizeof(size);
+  char const* end = snapshot.data() + snapshot.size();
+  size_t restored = 0;
+  while (p < end) {
+    uint32_t keySize = 0;
+    if (end - p < static_cast<ptrdiff_t>(sizeof(keySize))) {
+      return false;
+    }
+    memcpy(&keySize, p, sizeof(keySize));
+    p += sizeof(keySize);
+    if (end - p < static_cast<ptrdiff_t>(keySize + 1)) {
+      return false;
+    }
+    auto it = entries.find(StringRef(p, keySize));
+    if (it == entries.end()) {
+      return false;
+    }
+    p += keySize;
+    VertexEntry* entry = it->second;
+    entry->setActive(*p++ != 0);
+    if (valueSize > 0) {
+      size_t const read = readValue(
+          p, end, vertexData->data() + entry->_vertexDataOffset,
+          IsRawValue<V>());
+      if (read == 0) {
+        return false;
+      }
+      p += read;
+    }
+    restored++;
+  }
+  return restored == entries.size();
+}
+
 template <typename V, typename E>
 RangeIterator<VertexEntry> GraphStore<V, E>::vertexIterator() {
   return vertexIterator(0, _index.size());
@@ -335,6 +597,13 @@ std::unique_ptr<transaction::Methods> GraphStore<V, E>::_createTransaction() {
   return trx;
 }
 
+template <typename V, typename E>
+typename GraphStore<V, E>::KeyPool* GraphStore<V, E>::_createKeyPool() {
+  MUTEX_LOCKER(guard, _threadMutex);
+  _keyPools.emplace_back(new KeyPool());
+  return _keyPools.back().get();
+}
+
 template <typename V, typename E>
 void GraphStore<V, E>::_loadVertices(ShardID const& vertexShard,
                                      std::vector<ShardID> const& edgeShards,
@@ -346,6 +615,7 @@ void GraphStore<V, E>::_loadVertices(ShardID const& vertexShard,
   TRI_voc_cid_t cid = trx->addCollectionAtRuntime(vertexShard);
   trx->pinData(cid);  // will throw when it fails
   PregelShard sourceShard = (PregelShard)_config->shardId(vertexShard);
+  KeyPool* keys = _createKeyPool();
 
   ManagedDocumentResult mmdr;
   std::unique_ptr<OperationCursor> cursor =
@@ -361,6 +631,10 @@ void GraphStore<V, E>::_loadVertices(ShardID const& vertexShard,
   uint64_t number = collection->numberDocuments();
   _graphFormat->willLoadVertices(number);
 
+  // document ids of the loaded vertices, in the order of _index
+  std::vector<std::string> documentIds;
+  documentIds.reserve(number);
+
   auto cb = [&](DocumentIdentifierToken const& token) {
     if (collection->readDocument(trx.get(), token, mmdr)) {
       VPackSlice document(mmdr.vpack());
@@ -371,21 +645,16 @@ void GraphStore<V, E>::_loadVertices(ShardID const& vertexShard,
       VertexEntry& ventry = _index[vertexOffset];
       ventry._shard = sourceShard;
       ventry._key = document.get(StaticStrings::KeyString).copyString();
-      ventry._edgeDataOffset = edgeOffset;
 
       // load vertex data
-      std::string documentId = trx->extractIdString(document);
+      documentIds.emplace_back(trx->extractIdString(document));
       if (_graphFormat->estimatedVertexSize() > 0) {
         ventry._vertexDataOffset = vertexOffset;
         V* ptr = _vertexData->data() + vertexOffset;
-        _graphFormat->copyVertexData(documentId, document, ptr, sizeof(V));
-      }
-      // load edges
-      for (ShardID const& edgeShard : edgeShards) {
-        _loadEdges(trx.get(), edgeShard, ventry, documentId);
+        _graphFormat->copyVertexData(documentIds.back(), document, ptr,
+                                     sizeof(V));
       }
       vertexOffset++;
-      edgeOffset += ventry._edgeCount;
     }
   };
   while (cursor->getMore(cb, 1000)) {
@@ -398,17 +667,152 @@ void GraphStore<V, E>::_loadVertices(ShardID const& vertexShard,
   // Add all new vertices
   _localVerticeCount += (vertexOffset - originalVertexOffset);
 
+  if (!_destroyed && !documentIds.empty()) {
+    _loadEdges(trx.get(), edgeShards, documentIds, originalVertexOffset,
+               edgeOffset, keys);
+  }
+
   if (trx->commit() != TRI_ERROR_NO_ERROR) {
     LOG_TOPIC(WARN, Logger::PREGEL)
         << "Pregel worker: Failed to commit on a read transaction";
   }
 }
 
+template <typename V, typename E>
+void GraphStore<V, E>::_scanEdges(
+    transaction::Methods* trx, ShardID const& edgeShard,
+    std::function<void(VPackSlice)> const& callback) {
+  ManagedDocumentResult mmdr;
+  std::unique_ptr<OperationCursor> cursor =
+      trx->indexScan(edgeShard, transaction::Methods::CursorType::ALL, &mmdr,
+                     0, UINT64_MAX, 1000, false);
+  if (cursor->failed()) {
+    THROW_ARANGO_EXCEPTION_FORMAT(cursor->code, "while looking up shard '%s'",
+                                  edgeShard.c_str());
+  }
+
+  LogicalCollection* collection = cursor->collection();
+  auto cb = [&](DocumentIdentifierToken const& token) {
+    if (collection->readDocument(trx, token, mmdr)) {
+      VPackSlice document(mmdr.vpack());
+      if (document.isExternal()) {
+        document = document.resolveExternal();
+      }
+      callback(document);
+    }
+  };
+  while (cursor->getMore(cb, 1000)) {
+    if (_destroyed) {
+      LOG_TOPIC(WARN, Logger::PREGEL) << "Aborted loading graph";
+      break;
+    }
+  }
+}
+
+/// Loads the edges of the vertices in _index[vertexOffset] and onwards.
+/// Every edge shard is scanned twice instead of looking up the edges of each
+/// vertex in the edge index: the first scan counts the edges per vertex, so
+/// that the second one can put all edges of a vertex next to each other
+template <typename V, typename E>
+void GraphStore<V, E>::_loadEdges(transaction::Methods* trx,
+                                  std::vector<ShardID> const& edgeShards,
+                                  std::vector<std::string> const& documentIds,
+                                  uint64_t vertexOffset, uint64_t edgeOffset,
+                                  KeyPool* keys) {
+  // edge shards may contain edges of vertices in other collections
+  std::unordered_map<StringRef, uint64_t> positions;
+  positions.reserve(documentIds.size());
+  for (size_t i = 0; i < documentIds.size(); i++) {
+    positions.emplace(StringRef(documentIds[i]), i);
+  }
+  auto position = [&](VPackSlice document) -> int64_t {
+    VPackSlice from = document.get(StaticStrings::FromString);
+    if (from.isString()) {
+      auto it = positions.find(StringRef(from));
+      if (it != positions.end()) {
+        return static_cast<int64_t>(it->second);
+      }
+    }
+    return -1;
+  };
+
+  std::vector<uint64_t> counts(documentIds.size(), 0);
+  for (ShardID const& edgeShard : edgeShards) {
+    _scanEdges(trx, edgeShard, [&](VPackSlice document) {
+      int64_t pos = position(document);
+      if (pos >= 0) {
+        counts[pos]++;
+      }
+    });
+  }
+
+  uint64_t offset = edgeOffset;
+  for (size_t i = 0; i < counts.size(); i++) {
+    _index[vertexOffset + i]._edgeDataOffset = offset;
+    offset += counts[i];
+  }
+  if (offset > _edges->size()) {
+    // the edge shards grew since they were counted
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL,
+                                   "edge shards changed while loading");
+  }
+
+  size_t added = 0;
+  for (ShardID const& edgeShard : edgeShards) {
+    _scanEdges(trx, edgeShard, [&](VPackSlice document) {
+      int64_t pos = position(document);
+      if (pos < 0) {
+        return;
+      }
+      VertexEntry& ventry = _index[vertexOffset + pos];
+      if (ventry._edgeCount >= counts[pos]) {
+        return;
+      }
+      Edge<E>* edge =
+          _edges->data() + ventry._edgeDataOffset + ventry._edgeCount;
+      if (_fillEdge(edge, document, keys)) {
+        ventry._edgeCount++;
+        added++;
+      }
+    });
+  }
+  _localEdgeCount += added;
+}
+
+template <typename V, typename E>
+bool GraphStore<V, E>::_fillEdge(Edge<E>* edge, VPackSlice document,
+                                 KeyPool* keys) {
+  std::string toValue = document.get(StaticStrings::ToString).copyString();
+  std::size_t pos = toValue.find('/');
+  std::string collectionName = toValue.substr(0, pos);
+
+  edge->_toKey =
+      &*(keys->emplace(toValue.substr(pos + 1, toValue.length() - pos - 1))
+             .first);
+
+  // resolve the shard of the target vertex.
+  ShardID responsibleShard;
+  int res = Utils::resolveShard(_config, collectionName,
+                                StaticStrings::KeyString, *(edge->_toKey),
+                                responsibleShard);
+
+  if (res == TRI_ERROR_NO_ERROR) {
+    edge->_targetShard = (PregelShard)_config->shardId(responsibleShard);
+    _graphFormat->copyEdgeData(document, edge->data(), sizeof(E));
+    if (edge->_targetShard != (PregelShard)-1) {
+      return true;
+    }
+  }
+  LOG_TOPIC(ERR, Logger::PREGEL) << "Could not resolve target shard of edge";
+  return false;
+}
+
 template <typename V, typename E>
 void GraphStore<V, E>::_loadEdges(transaction::Methods* trx,
                                   ShardID const& edgeShard,
                                   VertexEntry& vertexEntry,
-                                  std::string const& documentID) {
+                                  std::string const& documentID,
+                                  KeyPool* keys) {
   size_t added = 0;
   size_t offset = vertexEntry._edgeDataOffset + vertexEntry._edgeCount;
   // moving pointer to edge
@@ -431,12 +835,6 @@ void GraphStore<V, E>::_loadEdges(transaction::Methods* trx,
         document = document.resolveExternal();
       }
 
-      // LOG_TOPIC(INFO, Logger::PREGEL) << "Loaded Edge: " <<
-      // document.toJson();
-      std::string toValue = document.get(StaticStrings::ToString).copyString();
-      std::size_t pos = toValue.find('/');
-      std::string collectionName = toValue.substr(0, pos);
-
       // If this is called from loadDocument we didn't preallocate the vector
       if (_edges->size() <= offset) {
         if (!_config->lazyLoading()) {
@@ -448,25 +846,9 @@ void GraphStore<V, E>::_loadEdges(transaction::Methods* trx,
       }
       
       Edge<E> *edge = _edges->data() + offset;
-      edge->_toKey = toValue.substr(pos + 1, toValue.length() - pos - 1);
-
-      // resolve the shard of the target vertex.
-      ShardID responsibleShard;
-      int res = Utils::resolveShard(_config, collectionName,
-                                    StaticStrings::KeyString, edge->_toKey, responsibleShard);
-      
-      if (res == TRI_ERROR_NO_ERROR) {
-        //PregelShard sourceShard = (PregelShard)_config->shardId(edgeShard);
-        edge->_targetShard = (PregelShard)_config->shardId(responsibleShard);
-        _graphFormat->copyEdgeData(document, edge->data(), sizeof(E));
-        if (edge->_targetShard != (PregelShard)-1) {
-          added++;
-          offset++;
-        } else {
-          LOG_TOPIC(ERR, Logger::PREGEL) << "Could not resolve target shard of edge";
-        }
-      } else {
-        LOG_TOPIC(ERR, Logger::PREGEL) << "Could not resolve target shard of edge";
+      if (_fillEdge(edge, document, keys)) {
+        added++;
+        offset++;
       }
     }
   };
@@ -486,9 +868,17 @@ void GraphStore<V, E>::_storeVertices(std::vector<ShardID> const& globalShards,
   // transaction on one shard
   std::unique_ptr<UserTransaction> trx;
   PregelShard currentShard = (PregelShard)-1;
+  // either the vertex shard or the shard of the result collection
+  ShardID targetShard;
+  bool insert = false;
   int res = TRI_ERROR_NO_ERROR;
   
   V* vData = _vertexData->data();
+  std::map<ShardID, ShardID> const& resultShards = _config->resultShards();
+
+  // the results of the single operations are not needed
+  OperationOptions options;
+  options.silent = true;
 
   // loop over vertices
   while (it != it.end()) {
@@ -500,11 +890,16 @@ void GraphStore<V, E>::_storeVertices(std::vector<ShardID> const& globalShards,
         }
       }
       currentShard = it->shard();
-      ShardID const& shard = globalShards[currentShard];
+      targetShard = globalShards[currentShard];
+      auto const& rs = resultShards.find(targetShard);
+      insert = rs != resultShards.end();
+      if (insert) {
+        targetShard = rs->second;
+      }
       double timeout = transaction::Methods::DefaultLockTimeout;
       trx.reset(new UserTransaction(
           transaction::StandaloneContext::Create(_vocbaseGuard.vocbase()), {},
-          {shard}, {}, timeout, false, false));
+          {targetShard}, {}, timeout, false, false));
       res = trx->begin();
       if (res != TRI_ERROR_NO_ERROR) {
         THROW_ARANGO_EXCEPTION(res);
@@ -514,7 +909,8 @@ void GraphStore<V, E>::_storeVertices(std::vector<ShardID> const& globalShards,
     transaction::BuilderLeaser b(trx.get());
     b->openArray();
     size_t buffer = 0;
-    while (it != it.end() && it->shard() == currentShard && buffer < 1000) {
+    while (it != it.end() && it->shard() == currentShard &&
+           buffer < StoreBatchSize) {
       // This loop will fill a buffer of vertices until we run into a new collection
       // or there are no more vertices for to store (or the buffer is full)
       V* data = vData + it->_vertexDataOffset;
@@ -537,9 +933,9 @@ void GraphStore<V, E>::_storeVertices(std::vector<ShardID> const& globalShards,
       break;
     }
 
-    ShardID const& shard = globalShards[currentShard];
-    OperationOptions options;
-    OperationResult result = trx->update(shard, b->slice(), options);
+    OperationResult result = insert
+                                 ? trx->insert(targetShard, b->slice(), options)
+                                 : trx->update(targetShard, b->slice(), options);
     if (result.code != TRI_ERROR_NO_ERROR) {
       THROW_ARANGO_EXCEPTION(result.code);
     }
@@ -559,31 +955,33 @@ void GraphStore<V, E>::storeResults(WorkerConfig const& state) {
 
   std::atomic<size_t> tCount(0);
   size_t total = _index.size();
-  size_t delta = _index.size() / state.localVertexShardIDs().size();
-  if (delta < 1000) {
-    delta = _index.size();
-  }
-  size_t start = 0, end = delta;
+  size_t start = 0;
 
-  do {
+  // the vertices of a shard are stored next to each other. every shard is
+  // written by its own thread, so the threads do not wait for each other's
+  // locks
+  ThreadPool* pool = PregelFeature::instance()->threadPool();
+  while (start != total) {
+    size_t end = start + 1;
+    while (end != total && _index[end].shard() == _index[start].shard()) {
+      end++;
+    }
     tCount++;
-    ThreadPool* pool = PregelFeature::instance()->threadPool();
     pool->enqueue([this, start, end, &state, &tCount] {
       try {
         RangeIterator<VertexEntry> it = vertexIterator(start, end);
         _storeVertices(state.globalShardIDs(), it);
         // TODO can't just write edges with smart graphs
+      } catch (basics::Exception const& ex) {
+        LOG_TOPIC(ERR, Logger::PREGEL) << "Storing vertex data failed: "
+                                       << ex.what();
       } catch (...) {
         LOG_TOPIC(ERR, Logger::PREGEL) << "Storing vertex data failed";
       }
       tCount--;
     });
     start = end;
-    end = end + delta;
-    if (total < end + delta) {  // swallow the rest
-      end = total;
-    }
-  } while (start != end);
+  }
 
   while (tCount > 0 && !_destroyed) {
     usleep(25 * 1000);  // 25ms
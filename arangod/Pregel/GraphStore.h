@@ -27,6 +27,7 @@
 #include <cstdint>
 #include <cstdio>
 #include <set>
+#include <unordered_set>
 #include "Basics/Mutex.h"
 #include "Cluster/ClusterInfo.h"
 #include "Pregel/Graph.h"
@@ -67,6 +68,10 @@ class GraphStore {
   std::vector<VertexEntry> _index;
   TypedBuffer<V> *_vertexData = nullptr;
   TypedBuffer<Edge<E>> *_edges = nullptr;
+  /// target keys of the edges, one pool per loading thread so that loading
+  /// does not need to synchronize. edges point to the pooled keys
+  typedef std::unordered_set<PregelKey> KeyPool;
+  std::vector<std::unique_ptr<KeyPool>> _keyPools;
   
   // cacge the amount of vertices
   std::set<ShardID> _loadedShards;
@@ -80,8 +85,18 @@ class GraphStore {
   void _loadVertices(ShardID const& vertexShard,
                      std::vector<ShardID> const& edgeShards,
                      uint64_t vertexOffset, uint64_t edgeOffset);
+  KeyPool* _createKeyPool();
+  void _scanEdges(transaction::Methods* trx, ShardID const& edgeShard,
+                  std::function<void(arangodb::velocypack::Slice)> const& cb);
+  void _loadEdges(transaction::Methods* trx,
+                  std::vector<ShardID> const& edgeShards,
+                  std::vector<std::string> const& documentIds,
+                  uint64_t vertexOffset, uint64_t edgeOffset, KeyPool* keys);
+  bool _fillEdge(Edge<E>* edge, arangodb::velocypack::Slice document,
+                 KeyPool* keys);
   void _loadEdges(transaction::Methods* trx, ShardID const& shard,
-                  VertexEntry& vertexEntry, std::string const& documentID);
+                  VertexEntry& vertexEntry, std::string const& documentID,
+                  KeyPool* keys);
   void _storeVertices(std::vector<ShardID> const& globalShards,
                       RangeIterator<VertexEntry>& it);
   std::unique_ptr<transaction::Methods> _createTransaction();
@@ -93,8 +108,40 @@ class GraphStore {
 
   uint64_t localVertexCount() const { return _localVerticeCount; }
   uint64_t localEdgeCount() const { return _localEdgeCount; }
+  /// bytes of graph data on the heap and in memory mapped buffers
+  uint64_t residentBytes() const;
+  uint64_t mappedBytes() const;
   GraphFormat<V, E> const* graphFormat() { return _graphFormat.get(); }
 
+  /// serialize key, active flag and data of all vertices, by vertex shard.
+  /// vertex data that is not trivially copyable is written with its
+  /// VertexSerializer
+  void snapshotVertices(std::map<PregelShard, std::string>& snapshots) const;
+  /// restore the vertices of a shard from a snapshot. returns false if the
+  /// snapshot does not match the loaded vertices of the shard
+  bool restoreVertices(PregelShard shard, std::string const& snapshot);
+
+  /// snapshot and restore the given vertices and their data, which may be
+  /// null. shards are the vertex shards that get a snapshot even if they
+  /// have no vertices
+  static void snapshotVertices(std::vector<VertexEntry> const& index,
+                               TypedBuffer<V> const* vertexData,
+                               std::vector<PregelShard> const& shards,
+                               std::map<PregelShard, std::string>& snapshots);
+  static bool restoreVertices(std::vector<VertexEntry>& index,
+                              TypedBuffer<V>* vertexData, PregelShard shard,
+                              std::string const& snapshot);
+
+  /// create the buffers for vertex data (unless the format has none) and
+  /// edges. a buffer is memory mapped instead of on the heap if memory maps
+  /// are enforced, or if the graph data exceeds the memory budget of
+  /// vertexBytes plus the size of the edges. never with lazy loading
+  static void allocateBuffers(uint64_t vertexCount, uint64_t edgeCount,
+                              bool hasVertexData, uint64_t vertexBytes,
+                              uint64_t budget, bool useMemoryMaps,
+                              bool lazyLoading, TypedBuffer<V>*& vertexData,
+                              TypedBuffer<Edge<E>>*& edges);
+
   // ====================== NOT THREAD SAFE ===========================
   void loadShards(WorkerConfig* state, std::function<void()> callback);
   void loadDocument(WorkerConfig* config, std::string const& documentID);
@@ -38,6 +38,24 @@
 using namespace arangodb;
 using namespace arangodb::pregel;
 
+/// @brief add a request sending a message package to a shard. the package
+/// is sent as VelocyPack, which is much more compact than JSON and needs no
+/// conversion of numeric message values to and from text
+static void addMessageRequest(std::vector<ClusterCommRequest>& requests,
+                              ShardID const& shardId, std::string const& url,
+                              VPackSlice package) {
+  auto body = std::make_shared<std::string>(package.startAs<char>(),
+                                            package.byteSize());
+  requests.emplace_back("shard:" + shardId, rest::RequestType::POST, url,
+                        body);
+
+  auto headers =
+      std::make_unique<std::unordered_map<std::string, std::string>>();
+  headers->emplace(StaticStrings::ContentTypeHeader,
+                   StaticStrings::MimeTypeVPack);
+  requests.back().setHeaders(headers);
+}
+
 template <typename M>
 OutCache<M>::OutCache(WorkerConfig* state, MessageFormat<M> const* format)
     : _config(state), _format(format) {
@@ -61,8 +79,8 @@ template <typename M>
 void ArrayOutCache<M>::appendMessage(PregelShard shard, PregelKey const& key,
                                      M const& data) {
   if (this->_config->isLocalVertexShard(shard)) {
-    if (this->_sendToNextGSS) {  // I use the global cache, we need locking
-      this->_localCacheNextGSS->storeMessage(shard, key, data);
+    if (this->_sendToNextGSS) {  // also thread local, merged by the worker
+      this->_localCacheNextGSS->storeMessageNoLock(shard, key, data);
       this->_sendCountNextGSS++;
     } else {  // the local cache is always thread local
       this->_localCache->storeMessageNoLock(shard, key, data);
@@ -126,9 +144,8 @@ void ArrayOutCache<M>::flushMessages() {
     data.close();
     // add a request
     ShardID const& shardId = this->_config->globalShardIDs()[shard];
-    auto body = std::make_shared<std::string>(data.toJson());
-    requests.emplace_back("shard:" + shardId, rest::RequestType::POST,
-                          this->_baseUrl + Utils::messagesPath, body);
+    addMessageRequest(requests, shardId, this->_baseUrl + Utils::messagesPath,
+                      data.slice());
 
     // LOG_TOPIC(INFO, Logger::PREGEL) << "Worker: Sending data to other Shard:
     // " << shardId;
@@ -165,8 +182,8 @@ void CombiningOutCache<M>::appendMessage(PregelShard shard,
                                          PregelKey const& key,
                                          M const& data) {
   if (this->_config->isLocalVertexShard(shard)) {
-    if (this->_sendToNextGSS) {
-      this->_localCacheNextGSS->storeMessage(shard, key, data);
+    if (this->_sendToNextGSS) {  // also thread local, merged by the worker
+      this->_localCacheNextGSS->storeMessageNoLock(shard, key, data);
       this->_sendCountNextGSS++;
     } else {
       this->_localCache->storeMessageNoLock(shard, key, data);
@@ -234,9 +251,8 @@ void CombiningOutCache<M>::flushMessages() {
     data.close();
     // add a request
     ShardID const& shardId = this->_config->globalShardIDs()[shard];
-    auto body = std::make_shared<std::string>(data.toJson());
-    requests.emplace_back("shard:" + shardId, rest::RequestType::POST,
-                          this->_baseUrl + Utils::messagesPath, body);
+    addMessageRequest(requests, shardId, this->_baseUrl + Utils::messagesPath,
+                      data.slice());
 
     // LOG_TOPIC(INFO, Logger::PREGEL) << "Worker: Sending data to other Shard:
     // " << shardId;
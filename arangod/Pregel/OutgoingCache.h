@@ -48,8 +48,8 @@ class ArrayInCache;
 
 /// None of the current implementations use locking
 /// Therefore only ever use this thread locally
-/// We expect the local cache to be thread local too,
-/// next GSS cache may be a global cache
+/// We expect the local cache and the next GSS cache to be thread local too,
+/// messages are stored in them without locking
 template <typename M>
 class OutCache {
  protected:
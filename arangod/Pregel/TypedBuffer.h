@@ -66,6 +66,13 @@ struct TypedBuffer {
   /// of the page size
   virtual void resize(size_t newSize) = 0;
 
+  /// whether the buffer is backed by a memory mapping instead of the heap
+  virtual bool isMapped() const { return false; }
+
+  /// tell the OS that the buffer will be accessed in order, so it can read
+  /// ahead and evict pages behind. only has an effect on mapped buffers
+  virtual void sequentialAccess() {}
+
   
 private:
   
@@ -208,8 +215,10 @@ public:
   /// @brief return whether the datafile is a physical file (true) or an
   /// anonymous mapped region (false)
   inline bool isPhysical() const { return !_filename.empty(); }
+
+  bool isMapped() const override { return true; }
   
-  void sequentialAccess() {
+  void sequentialAccess() override {
     TRI_MMFileAdvise(this->_ptr, _mappedSize, TRI_MADVISE_SEQUENTIAL);
   }
   
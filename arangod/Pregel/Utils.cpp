@@ -63,6 +63,11 @@ std::string const Utils::userParametersKey = "userparams";
 std::string const Utils::asyncModeKey = "asyncMode";
 std::string const Utils::lazyLoadingKey = "lazyloading";
 std::string const Utils::parallelismKey = "parallelism";
+std::string const Utils::memoryBudgetKey = "memoryBudget";
+std::string const Utils::checkpointIntervalKey = "checkpointInterval";
+std::string const Utils::useMemoryMapsKey = "useMemoryMaps";
+std::string const Utils::residentBytesKey = "residentBytes";
+std::string const Utils::mappedBytesKey = "mappedBytes";
 
 std::string const Utils::globalSuperstepKey = "gss";
 std::string const Utils::vertexCountKey = "vertexCount";
@@ -72,6 +77,9 @@ std::string const Utils::messagesKey = "msgs";
 std::string const Utils::senderKey = "sender";
 std::string const Utils::recoveryMethodKey = "rmethod";
 std::string const Utils::storeResultsKey = "storeResults";
+std::string const Utils::resultShardsKey = "resultShards";
+std::string const Utils::checkpointKey = "checkpoint";
+std::string const Utils::restoredKey = "restored";
 std::string const Utils::aggregatorValuesKey = "aggregators";
 std::string const Utils::activeCountKey = "activeCount";
 std::string const Utils::receivedCountKey = "receivedCount";
@@ -70,6 +70,11 @@ class Utils {
   static std::string const asyncModeKey;
   static std::string const lazyLoadingKey;
   static std::string const parallelismKey;
+  static std::string const memoryBudgetKey;
+  static std::string const checkpointIntervalKey;
+  static std::string const useMemoryMapsKey;
+  static std::string const residentBytesKey;
+  static std::string const mappedBytesKey;
 
   /// Current global superstep
   static std::string const globalSuperstepKey;
@@ -96,6 +101,16 @@ class Utils {
   /// otherwise dicard results
   static std::string const storeResultsKey;
 
+  /// vertex shards and the shards of the result collection their results
+  /// are inserted into
+  static std::string const resultShardsKey;
+
+  /// global superstep of the latest checkpoint
+  static std::string const checkpointKey;
+
+  /// whether a worker restored its part of a checkpoint
+  static std::string const restoredKey;
+
   /// Holds aggregated values
   static std::string const aggregatorValuesKey;
 
@@ -32,11 +32,15 @@
 #include "Pregel/VertexComputation.h"
 #include "Pregel/WorkerConfig.h"
 
+#include "ApplicationFeatures/ApplicationServer.h"
+#include "Basics/FileUtils.h"
 #include "Basics/MutexLocker.h"
 #include "Basics/ReadLocker.h"
 #include "Basics/WriteLocker.h"
+#include "Basics/files.h"
 #include "Cluster/ClusterComm.h"
 #include "Cluster/ServerState.h"
+#include "RestServer/DatabasePathFeature.h"
 #include "VocBase/ticks.h"
 #include "VocBase/vocbase.h"
 
@@ -47,6 +51,9 @@ using namespace arangodb;
 using namespace arangodb::basics;
 using namespace arangodb::pregel;
 
+/// @brief number of vertices a thread takes from the shared range at once
+static size_t const VertexChunkSize = 256;
+
 #define MY_READ_LOCKER(obj, lock)                                              \
   ReadLocker<ReadWriteLock> obj(&lock, arangodb::basics::LockerType::BLOCKING, \
                                 true, __FILE__, __LINE__)
@@ -70,6 +77,8 @@ Worker<V, E, M>::Worker(TRI_vocbase_t* vocbase, Algorithm<V, E, M>* algo,
   _workerAggregators.reset(new AggregatorHandler(algo));
   _graphStore.reset(new GraphStore<V, E>(vocbase, _algorithm->inputFormat()));
   _nextGSSSendMessageCount = 0;
+  _nextVertex = 0;
+  _writingCheckpoint = std::make_shared<std::atomic<bool>>(false);
   if (_config.asynchronousMode()) {
     _messageBatchSize = _algorithm->messageBatchSize(_config, _messageStats);
   } else {
@@ -86,10 +95,18 @@ Worker<V, E, M>::Worker(TRI_vocbase_t* vocbase, Algorithm<V, E, M>* algo,
     package.add(Utils::vertexCountKey,
                 VPackValue(_graphStore->localVertexCount()));
     package.add(Utils::edgeCountKey, VPackValue(_graphStore->localEdgeCount()));
+    package.add(Utils::residentBytesKey,
+                VPackValue(_graphStore->residentBytes()));
+    package.add(Utils::mappedBytesKey, VPackValue(_graphStore->mappedBytes()));
     package.close();
     _callConductor(Utils::finishedStartupPath, package);
   };
 
+  if (initConfig.get(Utils::recoveryMethodKey).isString()) {
+    // created to replace a lost worker, startRecovery loads the shards
+    return;
+  }
+
   if (_config.lazyLoading()) {
     // TODO maybe lazy loading needs to be performed on another thread too
     std::set<std::string> activeSet = _algorithm->initialActiveSet();
@@ -124,6 +141,9 @@ Worker<V, E, M>::~Worker() {
   for (InCache<M>* cache : _inCaches) {
     delete cache;
   }
+  for (InCache<M>* cache : _inCachesNextGSS) {
+    delete cache;
+  }
   for (OutCache<M>* cache : _outCaches) {
     delete cache;
   }
@@ -149,6 +169,10 @@ void Worker<V, E, M>::_initializeMessageCaches() {
       _outCaches.push_back(new CombiningOutCache<M>(
           &_config, _messageFormat.get(), _messageCombiner.get()));
       incoming.release();
+      if (_config.asynchronousMode()) {
+        _inCachesNextGSS.push_back(new CombiningInCache<M>(
+            nullptr, _messageFormat.get(), _messageCombiner.get()));
+      }
     }
   } else {
     _readCache = new ArrayInCache<M>(&_config, _messageFormat.get());
@@ -163,6 +187,10 @@ void Worker<V, E, M>::_initializeMessageCaches() {
       _outCaches.push_back(
           new ArrayOutCache<M>(&_config, _messageFormat.get()));
       incoming.release();
+      if (_config.asynchronousMode()) {
+        _inCachesNextGSS.push_back(
+            new ArrayInCache<M>(nullptr, _messageFormat.get()));
+      }
     }
   }
 }
@@ -220,6 +248,16 @@ VPackBuilder Worker<V, E, M>::prepareGlobalStep(VPackSlice const& data) {
     _config._localSuperstep = gss;
   }
 
+  // vertices, messages and aggregators are consistent between supersteps
+  if (_pendingCheckpointGSS > 0 && !_writingCheckpoint->load()) {
+    _finishCheckpoint();
+  }
+  uint64_t const interval = _config.checkpointInterval();
+  if (interval > 0 && gss > 0 && gss % interval == 0 && gss != _checkpointGSS &&
+      !_config.asynchronousMode()) {
+    _writeCheckpoint(gss);
+  }
+
   // only place where is makes sense to call this, since startGlobalSuperstep
   // might not be called again
   if (_workerContext && gss > 0) {
@@ -235,6 +273,7 @@ VPackBuilder Worker<V, E, M>::prepareGlobalStep(VPackSlice const& data) {
   response.add(Utils::vertexCountKey,
                VPackValue(_graphStore->localVertexCount()));
   response.add(Utils::edgeCountKey, VPackValue(_graphStore->localEdgeCount()));
+  response.add(Utils::checkpointKey, VPackValue(_checkpointGSS));
   _workerAggregators->serializeValues(response);
   response.close();
 
@@ -315,36 +354,27 @@ void Worker<V, E, M>::_startProcessing() {
 
   ThreadPool* pool = PregelFeature::instance()->threadPool();
   size_t total = _graphStore->localVertexCount();
-  size_t delta = total / _config.parallelism();
-  size_t start = 0, end = delta;
-  if (delta < 100 || total < 100) {
-    _runningThreads = 1;
-    end = total;
-  } else {
-    _runningThreads = total / delta;  // rounds-up unsigned integers
+  size_t threads = _config.parallelism();
+  if (total / threads < 100 || total < 100) {
+    threads = 1;
   }
-  size_t i = 0;
-  do {
-    pool->enqueue([this, start, end, i] {
+  // all threads process chunks of the same vertex range
+  _nextVertex = 0;
+  _endVertex = total;
+  _runningThreads = threads;
+  for (size_t i = 0; i < threads; i++) {
+    pool->enqueue([this, i] {
       if (_state != WorkerState::COMPUTING) {
         LOG_TOPIC(INFO, Logger::PREGEL) << "Execution aborted prematurely.";
         return;
       }
-      auto vertices = _graphStore->vertexIterator(start, end);
       // should work like a join operation
-      if (_processVertices(i, vertices) && _state == WorkerState::COMPUTING) {
+      if (_processVertices(i) && _state == WorkerState::COMPUTING) {
         _finishedProcessing();  // last thread turns the lights out
       }
     });
-    start = end;
-    end = end + delta;
-    if (total < end + delta) {  // swallow the rest
-      end = total;
-    }
-    i++;
-  } while (start != total);
-  // TRI_ASSERT(_runningThreads == i);
-  LOG_TOPIC(INFO, Logger::PREGEL) << "Using " << i << " Threads";
+  }
+  LOG_TOPIC(INFO, Logger::PREGEL) << "Using " << threads << " Threads";
 }
 
 template <typename V, typename E, typename M>
@@ -358,18 +388,19 @@ void Worker<V, E, M>::_initializeVertexContext(VertexContext<V, E, M>* ctx) {
 
 // internally called in a WORKER THREAD!!
 template <typename V, typename E, typename M>
-bool Worker<V, E, M>::_processVertices(
-    size_t threadId, RangeIterator<VertexEntry>& vertexIterator) {
+bool Worker<V, E, M>::_processVertices(size_t threadId) {
   double start = TRI_microtime();
 
   // thread local caches
   InCache<M>* inCache = _inCaches[threadId];
+  InCache<M>* inCacheNextGSS = nullptr;
   OutCache<M>* outCache = _outCaches[threadId];
   outCache->setBatchSize(_messageBatchSize);
   outCache->setLocalCache(inCache);
   if (_config.asynchronousMode()) {
+    inCacheNextGSS = _inCachesNextGSS[threadId];
     outCache->sendToNextGSS(_requestedNextGSS);
-    outCache->setLocalCacheNextGSS(_writeCacheNextGSS);
+    outCache->setLocalCacheNextGSS(inCacheNextGSS);
     TRI_ASSERT(outCache->sendCountNextGSS() == 0);
   }
   TRI_ASSERT(outCache->sendCount() == 0);
@@ -387,21 +418,32 @@ bool Worker<V, E, M>::_processVertices(
   }
 
   size_t activeCount = 0;
-  for (VertexEntry* vertexEntry : vertexIterator) {
-    MessageIterator<M> messages =
-        _readCache->getMessages(vertexEntry->shard(), vertexEntry->key());
-
-    if (messages.size() > 0 || vertexEntry->active()) {
-      vertexComputation->_vertexEntry = vertexEntry;
-      vertexComputation->compute(messages);
-      if (vertexEntry->active()) {
-        activeCount++;
-      }
-    }
-    if (_state != WorkerState::COMPUTING) {
-      LOG_TOPIC(INFO, Logger::PREGEL) << "Execution aborted prematurely.";
+  bool aborted = false;
+  while (!aborted) {
+    size_t begin = _nextVertex.fetch_add(VertexChunkSize);
+    if (begin >= _endVertex) {
       break;
     }
+    size_t end = std::min(begin + VertexChunkSize, _endVertex);
+    RangeIterator<VertexEntry> vertexIterator =
+        _graphStore->vertexIterator(begin, end);
+    for (VertexEntry* vertexEntry : vertexIterator) {
+      MessageIterator<M> messages =
+          _readCache->getMessages(vertexEntry->shard(), vertexEntry->key());
+
+      if (messages.size() > 0 || vertexEntry->active()) {
+        vertexComputation->_vertexEntry = vertexEntry;
+        vertexComputation->compute(messages);
+        if (vertexEntry->active()) {
+          activeCount++;
+        }
+      }
+      if (_state != WorkerState::COMPUTING) {
+        LOG_TOPIC(INFO, Logger::PREGEL) << "Execution aborted prematurely.";
+        aborted = true;
+        break;
+      }
+    }
   }
   // ==================== send messages to other shards ====================
   outCache->flushMessages();
@@ -416,6 +458,10 @@ bool Worker<V, E, M>::_processVertices(
   double t = TRI_microtime();
   // merge thread local messages, _writeCache does locking
   _writeCache->mergeCache(_config, inCache);
+  if (inCacheNextGSS != nullptr) {
+    _writeCacheNextGSS->mergeCache(_config, inCacheNextGSS);
+    inCacheNextGSS->clear();
+  }
   // TODO ask how to implement message sending without waiting for a response
   t = TRI_microtime() - t;
 
@@ -493,9 +539,9 @@ void Worker<V, E, M>::_finishedProcessing() {
         } else {
           // TODO call _startProcessing ???
           _runningThreads = 1;
-          auto addedVertices =
-              _graphStore->vertexIterator(currentAVCount, total);
-          _processVertices(0, addedVertices);
+          _nextVertex = currentAVCount;
+          _endVertex = total;
+          _processVertices(0);
         }
       }
     }
@@ -607,6 +653,228 @@ void Worker<V, E, M>::finalizeExecution(VPackSlice const& body) {
     LOG_TOPIC(WARN, Logger::PREGEL) << "Discarding results";
   }
   _graphStore.reset();
+
+  if (_config.checkpointInterval() > 0) {
+    std::string const path = _checkpointPath(0);
+    if (basics::FileUtils::isDirectory(path)) {
+      TRI_RemoveDirectory(path.c_str());
+    }
+  }
+}
+
+/// checkpoints of an execution are kept in the database directory, so they
+/// survive a restart of the server. gss 0 returns the directory of all
+/// checkpoints of the execution
+template <typename V, typename E, typename M>
+std::string Worker<V, E, M>::_checkpointPath(uint64_t gss) const {
+  auto database =
+      application_features::ApplicationServer::getFeature<DatabasePathFeature>(
+          "DatabasePath");
+  std::string path = basics::FileUtils::buildFilename(
+      database->subdirectoryName("pregel"),
+      std::to_string(_config.executionNumber()));
+  if (gss > 0) {
+    path = basics::FileUtils::buildFilename(path, std::to_string(gss));
+  }
+  return path;
+}
+
+/// WARNING only call this while holding the _commandMutex
+/// Serializes the state of the worker between two supersteps: vertex data,
+/// the messages for the next superstep and the aggregated values. Only the
+/// serialization is done here, the files are written in the background while
+/// the next supersteps run
+template <typename V, typename E, typename M>
+void Worker<V, E, M>::_writeCheckpoint(uint64_t gss) {
+  if (_writingCheckpoint->load()) {
+    LOG_TOPIC(WARN, Logger::PREGEL)
+        << "Skipping checkpoint of gss " << gss
+        << ", the previous checkpoint is still being written";
+    return;
+  }
+
+  std::string const dir = _checkpointPath(gss);
+  long systemError;
+  std::string systemErrorStr;
+  int res = TRI_CreateRecursiveDirectory(dir.c_str(), systemError,
+                                         systemErrorStr);
+  if (res != TRI_ERROR_NO_ERROR) {
+    LOG_TOPIC(WARN, Logger::PREGEL) << "Could not create checkpoint directory '"
+                                    << dir << "': " << systemErrorStr;
+    return;
+  }
+
+  double start = TRI_microtime();
+  auto files =
+      std::make_shared<std::vector<std::pair<std::string, std::string>>>();
+  std::vector<ShardID> const& shards = _config.globalShardIDs();
+
+  std::map<PregelShard, std::string> vertices;
+  _graphStore->snapshotVertices(vertices);
+  for (auto& pair : vertices) {
+    files->emplace_back(
+        basics::FileUtils::buildFilename(dir, shards[pair.first] + ".vertices"),
+        std::move(pair.second));
+  }
+
+  // messages in the format they are sent in, so they can be parsed again
+  std::map<PregelShard, std::unique_ptr<VPackBuilder>> messages;
+  _readCache->forEach(
+      [&](PregelShard shard, PregelKey const& key, M const& value) {
+        std::unique_ptr<VPackBuilder>& b = messages[shard];
+        if (!b) {
+          b.reset(new VPackBuilder());
+          b->openObject();
+          b->add(Utils::shardIdKey, VPackValue(shard));
+          b->add(Utils::messagesKey, VPackValue(VPackValueType::Array));
+        }
+        b->add(VPackValue(key));
+        b->openArray();
+        _messageFormat->addValue(*b, value);
+        b->close();
+      });
+  for (auto& pair : messages) {
+    pair.second->close();
+    pair.second->close();
+    VPackSlice slice = pair.second->slice();
+    files->emplace_back(
+        basics::FileUtils::buildFilename(dir, shards[pair.first] + ".messages"),
+        std::string(slice.startAs<char>(), slice.byteSize()));
+  }
+
+  VPackBuilder aggregators;
+  aggregators.openObject();
+  _workerAggregators->serializeValues(aggregators);
+  aggregators.close();
+  files->emplace_back(basics::FileUtils::buildFilename(dir, "aggregators"),
+                      std::string(aggregators.slice().startAs<char>(),
+                                  aggregators.slice().byteSize()));
+  LOG_TOPIC(DEBUG, Logger::PREGEL) << "Serializing checkpoint of gss " << gss
+                                   << " took " << (TRI_microtime() - start)
+                                   << "s";
+
+  // the marker is written last, a checkpoint without it is incomplete
+  std::string const marker = basics::FileUtils::buildFilename(dir, "done");
+  _pendingCheckpointGSS = gss;
+  _writingCheckpoint->store(true);
+  std::shared_ptr<std::atomic<bool>> writing = _writingCheckpoint;
+  ThreadPool* pool = PregelFeature::instance()->threadPool();
+  pool->enqueue([files, marker, writing] {
+    try {
+      for (auto const& file : *files) {
+        basics::FileUtils::spit(file.first, file.second);
+      }
+      basics::FileUtils::spit(marker, std::string());
+    } catch (...) {
+      LOG_TOPIC(WARN, Logger::PREGEL) << "Writing a checkpoint failed";
+    }
+    writing->store(false);
+  });
+}
+
+/// WARNING only call this while holding the _commandMutex
+/// after the pending checkpoint was written, older checkpoints are removed
+template <typename V, typename E, typename M>
+void Worker<V, E, M>::_finishCheckpoint() {
+  uint64_t const gss = _pendingCheckpointGSS;
+  _pendingCheckpointGSS = 0;
+  std::string const marker =
+      basics::FileUtils::buildFilename(_checkpointPath(gss), "done");
+  if (!basics::FileUtils::exists(marker)) {
+    TRI_RemoveDirectory(_checkpointPath(gss).c_str());
+    return;
+  }
+  if (_checkpointGSS > 0) {
+    TRI_RemoveDirectory(_checkpointPath(_checkpointGSS).c_str());
+  }
+  _checkpointGSS = gss;
+  LOG_TOPIC(INFO, Logger::PREGEL) << "Wrote checkpoint of gss " << gss;
+}
+
+/// WARNING only call this while holding the _commandMutex
+/// restores all local vertex shards, their messages and the aggregated
+/// values. New messages go into the write cache, which becomes readable in
+/// the next superstep
+template <typename V, typename E, typename M>
+bool Worker<V, E, M>::_restoreCheckpoint(uint64_t gss,
+                                         uint64_t& messageCount) {
+  std::string const dir = _checkpointPath(gss);
+  if (!basics::FileUtils::exists(
+          basics::FileUtils::buildFilename(dir, "done"))) {
+    return false;
+  }
+
+  {
+    // messages of the canceled superstep are obsolete
+    MY_WRITE_LOCKER(wguard, _cacheRWLock);
+    _readCache->clear();
+    _writeCache->clear();
+  }
+  for (ShardID const& shard : _config.localVertexShardIDs()) {
+    std::string file = basics::FileUtils::buildFilename(dir, shard + ".vertices");
+    if (!basics::FileUtils::exists(file) ||
+        !_graphStore->restoreVertices(_config.shardId(shard),
+                                      basics::FileUtils::slurp(file))) {
+      LOG_TOPIC(WARN, Logger::PREGEL) << "No usable checkpoint of shard '"
+                                      << shard << "' for gss " << gss;
+      return false;
+    }
+    file = basics::FileUtils::buildFilename(dir, shard + ".messages");
+    if (basics::FileUtils::exists(file)) {
+      std::string const data = basics::FileUtils::slurp(file);
+      MY_READ_LOCKER(guard, _cacheRWLock);
+      _writeCache->parseMessages(VPackSlice(data.data()));
+    }
+  }
+
+  std::string const file = basics::FileUtils::buildFilename(dir, "aggregators");
+  _workerAggregators->resetValues();
+  if (basics::FileUtils::exists(file)) {
+    std::string const data = basics::FileUtils::slurp(file);
+    _workerAggregators->aggregateValues(VPackSlice(data.data()));
+  }
+
+  messageCount = _writeCache->containedMessageCount();
+  _checkpointGSS = gss;
+  return true;
+}
+
+template <typename V, typename E, typename M>
+void Worker<V, E, M>::_rollback(VPackSlice const& data) {
+  MUTEX_LOCKER(guard, _commandMutex);
+  if (_state != WorkerState::RECOVERING) {
+    LOG_TOPIC(INFO, Logger::PREGEL) << "Rollback aborted prematurely.";
+    return;
+  }
+
+  uint64_t const gss = data.get(Utils::checkpointKey).getUInt();
+  uint64_t messageCount = 0;
+  bool restored = false;
+  try {
+    restored = _restoreCheckpoint(gss, messageCount);
+  } catch (basics::Exception const& ex) {
+    LOG_TOPIC(WARN, Logger::PREGEL) << "Restoring checkpoint of gss " << gss
+                                    << " failed: " << ex.what();
+  } catch (...) {
+    LOG_TOPIC(WARN, Logger::PREGEL) << "Restoring checkpoint of gss " << gss
+                                    << " failed";
+  }
+  if (!restored) {
+    MY_WRITE_LOCKER(wguard, _cacheRWLock);
+    _writeCache->clear();
+    messageCount = 0;
+  }
+
+  VPackBuilder package;
+  package.openObject();
+  package.add(Utils::senderKey, VPackValue(ServerState::instance()->getId()));
+  package.add(Utils::executionNumberKey, VPackValue(_config.executionNumber()));
+  package.add(Utils::globalSuperstepKey, VPackValue(gss));
+  package.add(Utils::restoredKey, VPackValue(restored));
+  // restored messages count as sent, so the conductor waits for them
+  package.add(Utils::sendCountKey, VPackValue(messageCount));
+  package.close();
+  _callConductor(Utils::finishedRecoveryPath, package);
 }
 
 template <typename V, typename E, typename M>
@@ -631,11 +899,11 @@ void Worker<V, E, M>::startRecovery(VPackSlice const& data) {
   // other methods might lock _commandMutex
   MUTEX_LOCKER(guard, _commandMutex);
   VPackSlice method = data.get(Utils::recoveryMethodKey);
-  if (method.compareString(Utils::compensate) != 0) {
+  bool const rollback = method.compareString(Utils::rollback) == 0;
+  if (!rollback && method.compareString(Utils::compensate) != 0) {
     LOG_TOPIC(INFO, Logger::PREGEL) << "Unsupported operation";
     return;
   }
-  // else if (method.compareString(Utils::rollback) == 0)
 
   _state = WorkerState::RECOVERING;
   {
@@ -652,9 +920,13 @@ void Worker<V, E, M>::startRecovery(VPackSlice const& data) {
   _preRecoveryTotal = _graphStore->localVertexCount();
   WorkerConfig nextState(_config);
   nextState.updateConfig(data);
-  _graphStore->loadShards(&nextState, [this, nextState, copy] {
+  _graphStore->loadShards(&nextState, [this, nextState, copy, rollback] {
     _config = nextState;
-    compensateStep(copy.slice());
+    if (rollback) {
+      _rollback(copy.slice());
+    } else {
+      compensateStep(copy.slice());
+    }
   });
 }
 
@@ -114,6 +114,10 @@ class Worker : public IWorker {
   InCache<M>* _writeCacheNextGSS = nullptr;
   // preallocated incoming caches
   std::vector<InCache<M>*> _inCaches;
+  // preallocated incoming caches for the next superstep phase, only used in
+  // async mode. they are merged into _writeCacheNextGSS at the end of a
+  // thread's processing, so storing a message does not need to lock
+  std::vector<InCache<M>*> _inCachesNextGSS;
   // preallocated ootgoing caches
   std::vector<OutCache<M>*> _outCaches;
 
@@ -123,17 +127,32 @@ class Worker : public IWorker {
   uint64_t _activeCount = 0;
   /// current number of running threads
   size_t _runningThreads = 0;
+  /// next vertex to process and the end of the processed range. threads
+  /// take small chunks of vertices from here until the range is exhausted,
+  /// so a few expensive vertices do not hold up the whole superstep
+  std::atomic<size_t> _nextVertex;
+  size_t _endVertex = 0;
   /// During async mode this should keep track of the send messages
   std::atomic<uint64_t> _nextGSSSendMessageCount;
   /// if the worker has started sendng messages to the next GSS
   std::atomic<bool> _requestedNextGSS;
+  /// last global superstep with a complete checkpoint, 0 for none
+  uint64_t _checkpointGSS = 0;
+  /// global superstep of the checkpoint which is being written
+  uint64_t _pendingCheckpointGSS = 0;
+  /// set while a checkpoint is written in the background
+  std::shared_ptr<std::atomic<bool>> _writingCheckpoint;
 
   void _initializeMessageCaches();
   void _initializeVertexContext(VertexContext<V, E, M>* ctx);
   void _startProcessing();
-  bool _processVertices(size_t threadId,
-                        RangeIterator<VertexEntry>& vertexIterator);
+  bool _processVertices(size_t threadId);
   void _finishedProcessing();
+  std::string _checkpointPath(uint64_t gss) const;
+  void _writeCheckpoint(uint64_t gss);
+  void _finishCheckpoint();
+  bool _restoreCheckpoint(uint64_t gss, uint64_t& messageCount);
+  void _rollback(VPackSlice const& data);
   void _continueAsync();
   void _callConductor(std::string const& path, VPackBuilder const& message);
   void _callConductorWithResponse(std::string const& path,
@@ -60,6 +60,16 @@ void WorkerConfig::updateConfig(VPackSlice params) {
   if (parallel.isInteger()) {
     _parallelism = std::min(std::max((uint64_t)1, parallel.getUInt()), _parallelism);
   }
+  VPackSlice budget = userParams.get(Utils::memoryBudgetKey);
+  if (budget.isNumber()) {
+    _memoryBudget = budget.getNumber<uint64_t>();
+  }
+  VPackSlice useMaps = userParams.get(Utils::useMemoryMapsKey);
+  _useMemoryMaps = useMaps.isBoolean() && useMaps.getBoolean();
+  VPackSlice interval = userParams.get(Utils::checkpointIntervalKey);
+  if (interval.isInteger()) {
+    _checkpointInterval = interval.getUInt();
+  }
   
   // list of all shards, equal on all workers. Used to avoid storing strings of
   // shard names
@@ -101,6 +111,13 @@ void WorkerConfig::updateConfig(VPackSlice params) {
     }
     _edgeCollectionShards.emplace(pair.key.copyString(), shards);
   }
+
+  VPackSlice resultShardMap = params.get(Utils::resultShardsKey);
+  if (resultShardMap.isObject()) {
+    for (auto const& pair : VPackObjectIterator(resultShardMap)) {
+      _resultShards[pair.key.copyString()] = pair.value.copyString();
+    }
+  }
 }
 
 PregelID WorkerConfig::documentIdToPregel(std::string const& documentID) const {
@@ -60,6 +60,16 @@ class WorkerConfig {
 
   inline uint64_t parallelism() const { return _parallelism; }
 
+  /// memory in bytes the graph data may use before it is placed in memory
+  /// mapped buffers. 0 means half of the system memory
+  inline uint64_t memoryBudget() const { return _memoryBudget; }
+
+  /// always place the graph data in memory mapped buffers
+  inline bool useMemoryMaps() const { return _useMemoryMaps; }
+
+  /// number of global supersteps between checkpoints, 0 for none
+  inline uint64_t checkpointInterval() const { return _checkpointInterval; }
+
   inline std::string const& coordinatorId() const { return _coordinatorId; }
 
   inline TRI_vocbase_t* const& vocbase() const { return _vocbase; }
@@ -115,6 +125,12 @@ class WorkerConfig {
     return _localPregelShardIDs.find(shardIndex) != _localPregelShardIDs.end();
   }
 
+  /// shards of the result collection by vertex shard, empty when results
+  /// are written into the vertex documents
+  inline std::map<ShardID, ShardID> const& resultShards() const {
+    return _resultShards;
+  }
+
   // convert an arangodb document id to a pregel id
   PregelID documentIdToPregel(std::string const& documentID) const;
 
@@ -129,6 +145,9 @@ class WorkerConfig {
   bool _lazyLoading = false;
 
   uint64_t _parallelism = 1;
+  uint64_t _memoryBudget = 0;
+  bool _useMemoryMaps = false;
+  uint64_t _checkpointInterval = 0;
 
   std::string _coordinatorId;
   TRI_vocbase_t *_vocbase;
@@ -140,6 +159,7 @@ class WorkerConfig {
   // Map from edge collection to their shards, only iterated over keep sorted
   std::map<CollectionID, std::vector<ShardID>> _vertexCollectionShards,
       _edgeCollectionShards;
+  std::map<ShardID, ShardID> _resultShards;
   
   /// cache these ids as much as possible, since we access them often
   std::unordered_map<std::string, PregelShard> _pregelShardIDs;
@@ -23,12 +23,15 @@
 
 #include "ContinuousSyncer.h"
 #include "ApplicationFeatures/ApplicationServer.h"
+#include "Basics/ConditionLocker.h"
+#include "Basics/ConditionVariable.h"
 #include "Basics/Exceptions.h"
 #include "Basics/Result.h"
 #include "Basics/StaticStrings.h"
 #include "Basics/StringBuffer.h"
 #include "Basics/VelocyPackHelper.h"
 #include "Basics/WriteLocker.h"
+#include "Basics/fasthash.h"
 #include "Logger/Logger.h"
 #include "Replication/InitialSyncer.h"
 #include "Rest/HttpRequest.h"
@@ -45,15 +48,185 @@
 
 #include <velocypack/Builder.h>
 #include <velocypack/Iterator.h>
-#include <velocypack/Parser.h>
 #include <velocypack/Slice.h>
 #include <velocypack/velocypack-aliases.h>
 
+#include <thread>
+
 using namespace arangodb;
 using namespace arangodb::basics;
 using namespace arangodb::httpclient;
 using namespace arangodb::rest;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief applies standalone document operations with a fixed number of
+/// worker threads. each collection is assigned to one lane, so the
+/// operations of a collection are still applied in log order, while
+/// operations of different collections are applied concurrently
+////////////////////////////////////////////////////////////////////////////////
+
+class ContinuousSyncer::ApplyLanes {
+ private:
+  struct Entry {
+    // the builder holding the marker, if it was parsed from JSON. otherwise
+    // the marker lives in the response body, which is kept alive by the
+    // caller until wait()
+    std::shared_ptr<VPackBuilder> _builder;
+    VPackSlice _marker;
+    TRI_replication_operation_e _type;
+  };
+
+  struct Lane {
+    std::deque<Entry> _queue;
+    bool _busy;
+  };
+
+ public:
+  ApplyLanes(ContinuousSyncer* syncer, size_t numLanes)
+      : _syncer(syncer),
+        _lanes(numLanes),
+        _stop(false),
+        _result(TRI_ERROR_NO_ERROR) {
+    TRI_ASSERT(numLanes > 1);
+
+    for (size_t i = 0; i < numLanes; ++i) {
+      _lanes[i]._busy = false;
+      _threads.emplace_back(&ApplyLanes::run, this, i);
+    }
+  }
+
+  ~ApplyLanes() {
+    {
+      CONDITION_LOCKER(guard, _condition);
+      _stop = true;
+      guard.broadcast();
+    }
+
+    for (auto& thread : _threads) {
+      thread.join();
+    }
+  }
+
+  /// @brief queue a standalone document operation
+  void dispatch(TRI_voc_cid_t cid, TRI_replication_operation_e type,
+                std::shared_ptr<VPackBuilder> const& builder,
+                VPackSlice marker) {
+    size_t const lane =
+        static_cast<size_t>(fasthash64_uint64(cid, 0xdeadbeef) %
+                            _lanes.size());
+
+    CONDITION_LOCKER(guard, _condition);
+    _lanes[lane]._queue.emplace_back(Entry{builder, marker, type});
+    guard.broadcast();
+  }
+
+  /// @brief wait until all queued operations are applied. returns the first
+  /// error that occurred, if any. errorMsg then contains the offending marker
+  int wait(std::string& errorMsg) {
+    CONDITION_LOCKER(guard, _condition);
+
+    while (!isIdle()) {
+      guard.wait(100000);
+    }
+
+    int res = _result;
+
+    if (res != TRI_ERROR_NO_ERROR) {
+      errorMsg = _errorMsg;
+      _result = TRI_ERROR_NO_ERROR;
+      _errorMsg.clear();
+    }
+
+    return res;
+  }
+
+ private:
+  /// @brief whether all lanes are drained, must be called under the lock
+  bool isIdle() const {
+    for (auto const& lane : _lanes) {
+      if (lane._busy || !lane._queue.empty()) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  void run(size_t laneId) {
+    Lane& lane = _lanes[laneId];
+
+    while (true) {
+      Entry entry;
+      bool failed;
+
+      {
+        CONDITION_LOCKER(guard, _condition);
+
+        while (!_stop && lane._queue.empty()) {
+          guard.wait(100000);
+        }
+
+        if (_stop) {
+          return;
+        }
+
+        entry = std::move(lane._queue.front());
+        lane._queue.pop_front();
+        lane._busy = true;
+        failed = (_result != TRI_ERROR_NO_ERROR);
+      }
+
+      int res = TRI_ERROR_NO_ERROR;
+      std::string errorMsg;
+
+      // once an operation has failed, the remaining ones are discarded. the
+      // syncer stops at the failed marker anyway
+      if (!failed) {
+        try {
+          res = _syncer->processDocument(entry._type, entry._marker,
+                                         errorMsg);
+        } catch (arangodb::basics::Exception const& ex) {
+          res = ex.code();
+        } catch (...) {
+          res = TRI_ERROR_INTERNAL;
+        }
+      }
+
+      CONDITION_LOCKER(guard, _condition);
+
+      lane._busy = false;
+
+      if (res != TRI_ERROR_NO_ERROR && _result == TRI_ERROR_NO_ERROR) {
+        _result = res;
+
+        if (errorMsg.empty()) {
+          errorMsg = TRI_errno_string(res);
+        }
+
+        std::string const text = entry._marker.toJson();
+
+        if (text.size() > 256) {
+          errorMsg += ", offending marker: " + text.substr(0, 256) + "...";
+        } else {
+          errorMsg += ", offending marker: " + text;
+        }
+
+        _errorMsg = std::move(errorMsg);
+      }
+
+      guard.broadcast();
+    }
+  }
+
+ private:
+  ContinuousSyncer* _syncer;
+  std::vector<Lane> _lanes;
+  std::vector<std::thread> _threads;
+  arangodb::basics::ConditionVariable _condition;
+  bool _stop;
+  int _result;
+  std::string _errorMsg;
+};
+
 ContinuousSyncer::ContinuousSyncer(
     TRI_vocbase_t* vocbase,
     TRI_replication_applier_configuration_t const* configuration,
@@ -89,6 +262,11 @@ ContinuousSyncer::ContinuousSyncer(
     _barrierId = barrierId;
     _barrierUpdateTime = TRI_microtime();
   }
+
+  if (configuration->_applyThreads > 1) {
+    _applyLanes.reset(new ApplyLanes(
+        this, static_cast<size_t>(configuration->_applyThreads)));
+  }
 }
 
 ContinuousSyncer::~ContinuousSyncer() { 
@@ -802,20 +980,7 @@ int ContinuousSyncer::applyLogMarker(VPackSlice const& slice,
   // fetch marker "type"
   int typeValue = VelocyPackHelper::getNumericValue<int>(slice, "type", 0);
 
-  // fetch "tick"
-  std::string const tick = VelocyPackHelper::getStringValue(slice, "tick", "");
-
-  if (!tick.empty()) {
-    TRI_voc_tick_t newTick = static_cast<TRI_voc_tick_t>(
-        StringUtils::uint64(tick.c_str(), tick.size()));
-
-    WRITE_LOCKER_EVENTUAL(writeLocker, _applier->_statusLock);
-
-    if (newTick >= firstRegularTick &&
-        newTick > _applier->_state._lastProcessedContinuousTick) {
-      _applier->_state._lastProcessedContinuousTick = newTick;
-    }
-  }
+  updateProcessedTick(slice, firstRegularTick);
 
   // handle marker type
   TRI_replication_operation_e type = (TRI_replication_operation_e)typeValue;
@@ -866,6 +1031,28 @@ int ContinuousSyncer::applyLogMarker(VPackSlice const& slice,
   return TRI_ERROR_REPLICATION_UNEXPECTED_MARKER;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief advance the last processed tick to the tick of a marker
+////////////////////////////////////////////////////////////////////////////////
+
+void ContinuousSyncer::updateProcessedTick(VPackSlice const& slice,
+                                           TRI_voc_tick_t firstRegularTick) {
+  // fetch "tick"
+  std::string const tick = VelocyPackHelper::getStringValue(slice, "tick", "");
+
+  if (!tick.empty()) {
+    TRI_voc_tick_t newTick = static_cast<TRI_voc_tick_t>(
+        StringUtils::uint64(tick.c_str(), tick.size()));
+
+    WRITE_LOCKER_EVENTUAL(writeLocker, _applier->_statusLock);
+
+    if (newTick >= firstRegularTick &&
+        newTick > _applier->_state._lastProcessedContinuousTick) {
+      _applier->_state._lastProcessedContinuousTick = newTick;
+    }
+  }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief apply the data from the continuous log
 ////////////////////////////////////////////////////////////////////////////////
@@ -882,39 +1069,71 @@ int ContinuousSyncer::applyLog(SimpleHttpResult* response,
   // buffer must end with a NUL byte
   TRI_ASSERT(*end == '\0');
 
-  while (p < end) {
-    char const* q = strchr(p, '\n');
+  // markers sent as VelocyPack are used in place, JSON markers are parsed
+  bool const isVelocyPack = hasVelocyPackBody(response);
+  VPackBuilder scratch;
 
-    if (q == nullptr) {
-      q = end;
-    }
+  // whether operations were handed to the apply lanes that have not been
+  // waited for yet. the lanes refer to the response body, so they must be
+  // drained before returning
+  bool lanesPending = false;
 
-    char const* lineStart = p;
-    size_t const lineLength = q - p;
+  TRI_DEFER(if (lanesPending) {
+    std::string ignored;
+    _applyLanes->wait(ignored);
+  });
 
-    if (lineLength < 2) {
-      // we are done
+  // wait for the apply lanes and advance the applied tick to the ticks of
+  // the operations they have applied
+  auto waitForLanes = [&]() -> int {
+    if (!lanesPending) {
       return TRI_ERROR_NO_ERROR;
     }
 
-    TRI_ASSERT(q <= end);
+    lanesPending = false;
+    int res = _applyLanes->wait(errorMsg);
 
-    processedMarkers++;
+    if (res == TRI_ERROR_NO_ERROR) {
+      WRITE_LOCKER_EVENTUAL(writeLocker, _applier->_statusLock);
 
-    auto builder = std::make_shared<VPackBuilder>();
+      if (_applier->_state._lastProcessedContinuousTick >
+          _applier->_state._lastAppliedContinuousTick) {
+        _applier->_state._lastAppliedContinuousTick =
+            _applier->_state._lastProcessedContinuousTick;
+      }
 
-    try {
-      VPackParser parser(builder);
-      parser.parse(p, static_cast<size_t>(q - p));
+      if (_ongoingTransactions.empty()) {
+        _applier->_state._safeResumeTick =
+            _applier->_state._lastProcessedContinuousTick;
+      }
     }
-    catch (...) {
-      // TODO: improve error reporting
-      return TRI_ERROR_OUT_OF_MEMORY;
+
+    return res;
+  };
+
+  while (p < end) {
+    // the apply lanes keep the builders of JSON markers until they are done
+    std::shared_ptr<VPackBuilder> builder;
+    if (!isVelocyPack) {
+      builder = std::make_shared<VPackBuilder>();
     }
 
-    p = q + 1;
+    VPackSlice slice;
+    int res = nextMarker(p, end, isVelocyPack,
+                         isVelocyPack ? scratch : *builder, slice);
+
+    if (res != TRI_ERROR_NO_ERROR) {
+      errorMsg = "received invalid data";
 
-    VPackSlice const slice = builder->slice();
+      return res;
+    }
+
+    if (slice.isNone()) {
+      // we are done
+      break;
+    }
+
+    processedMarkers++;
 
     if (!slice.isObject()) {
       errorMsg = "received invalid JSON data";
@@ -922,13 +1141,45 @@ int ContinuousSyncer::applyLog(SimpleHttpResult* response,
       return TRI_ERROR_REPLICATION_INVALID_RESPONSE;
     }
 
-    int res;
     bool skipped;
     if (skipMarker(firstRegularTick, slice)) {
       // entry is skipped
       res = TRI_ERROR_NO_ERROR;
       skipped = true;
+
+      if (lanesPending) {
+        // the applied tick must not advance past operations that are
+        // still being applied. it is updated when the lanes are drained
+        WRITE_LOCKER_EVENTUAL(writeLocker, _applier->_statusLock);
+        ++_applier->_state._skippedOperations;
+        continue;
+      }
     } else {
+      TRI_replication_operation_e type = static_cast<TRI_replication_operation_e>(
+          VelocyPackHelper::getNumericValue<int>(slice, "type", 0));
+
+      if (_applyLanes != nullptr && ignoreCount == 0 &&
+          (type == REPLICATION_MARKER_DOCUMENT ||
+           type == REPLICATION_MARKER_REMOVE) &&
+          getCid(slice) != 0 &&
+          StringUtils::uint64(
+              VelocyPackHelper::getStringValue(slice, "tid", "")) == 0) {
+        // standalone operation. operations of different collections are
+        // independent of each other and can be applied concurrently
+        updateProcessedTick(slice, firstRegularTick);
+        _applyLanes->dispatch(getCid(slice), type, builder, slice);
+        lanesPending = true;
+        continue;
+      }
+
+      // everything else acts as a barrier: transactions may touch any
+      // collection, and DDL operations change the collections themselves
+      res = waitForLanes();
+
+      if (res != TRI_ERROR_NO_ERROR) {
+        return res;
+      }
+
       res = applyLogMarker(slice, firstRegularTick, errorMsg);
       skipped = false;
     }
@@ -942,12 +1193,12 @@ int ContinuousSyncer::applyLog(SimpleHttpResult* response,
       }
 
       if (ignoreCount == 0) {
-        if (lineLength > 256) {
-          errorMsg +=
-              ", offending marker: " + std::string(lineStart, 256) + "...";
+        std::string const text = slice.toJson();
+
+        if (text.size() > 256) {
+          errorMsg += ", offending marker: " + text.substr(0, 256) + "...";
         } else {
-          errorMsg +=
-              ", offending marker: " + std::string(lineStart, lineLength);
+          errorMsg += ", offending marker: " + text;
         }
 
         // LOG_TOPIC(ERR, Logger::REPLICATION) << "replication applier error: " << errorMsg;
@@ -978,7 +1229,7 @@ int ContinuousSyncer::applyLog(SimpleHttpResult* response,
   }
 
   // reached the end
-  return TRI_ERROR_NO_ERROR;
+  return waitForLanes();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1055,12 +1306,13 @@ int ContinuousSyncer::runContinuousSync(std::string& errorMsg) {
   while (true) {
     bool worked;
     bool masterActive = false;
+    bool longPolled = false;
     errorMsg = "";
 
     // fetchTick is passed by reference!
-    int res =
-        followMasterLog(errorMsg, fetchTick, fromTick,
-                        _configuration._ignoreErrors, worked, masterActive);
+    int res = followMasterLog(errorMsg, fetchTick, fromTick,
+                              _configuration._ignoreErrors, worked,
+                              masterActive, longPolled);
 
     uint64_t sleepTime;
 
@@ -1111,6 +1363,10 @@ int ContinuousSyncer::runContinuousSync(std::string& errorMsg) {
         // we have done something, so we won't sleep (but check for cancelation)
         inactiveCycles = 0;
         sleepTime = 0;
+      } else if (longPolled) {
+        // the master has already held the request until its wait time was
+        // over, so we can ask again right away
+        sleepTime = 0;
       } else {
         sleepTime = _configuration._idleMinWaitTime;
         if (sleepTime < MinWaitTime) {
@@ -1288,17 +1544,27 @@ int ContinuousSyncer::followMasterLog(std::string& errorMsg,
                                       TRI_voc_tick_t& fetchTick,
                                       TRI_voc_tick_t firstRegularTick,
                                       uint64_t& ignoreCount, bool& worked,
-                                      bool& masterActive) {
+                                      bool& masterActive,
+                                      bool& longPolled) {
   std::string const baseUrl =
       BaseUrl + "/logger-follow?chunkSize=" + _chunkSize + "&barrier=" + StringUtils::itoa(_barrierId);
 
   worked = false;
+  longPolled = false;
 
-  std::string const url = baseUrl + "&from=" + StringUtils::itoa(fetchTick) +
-                          "&firstRegular=" +
-                          StringUtils::itoa(firstRegularTick) + "&serverId=" +
-                          _localServerIdString + "&includeSystem=" +
-                          (_includeSystem ? "true" : "false");
+  std::string url = baseUrl + "&from=" + StringUtils::itoa(fetchTick) +
+                    "&firstRegular=" + StringUtils::itoa(firstRegularTick) +
+                    "&serverId=" + _localServerIdString + "&includeSystem=" +
+                    (_includeSystem ? "true" : "false");
+
+  if (_configuration._idleMaxWaitTime > 0) {
+    // let the master hold the request until new data arrives, for at most
+    // the time we would otherwise sleep between two idle requests. masters
+    // that do not support this ignore the parameter
+    url += "&waitTime=" +
+           StringUtils::ftoa(static_cast<double>(_configuration._idleMaxWaitTime) /
+                             (1000.0 * 1000.0));
+  }
 
   // send request
   std::string const progress =
@@ -1331,10 +1597,15 @@ int ContinuousSyncer::followMasterLog(std::string& errorMsg,
     }
   }
 
+  // ask for the markers in VelocyPack format. masters that do not support
+  // it send JSON
+  std::unordered_map<std::string, std::string> headers;
+  headers[StaticStrings::Accept] = StaticStrings::MimeTypeVPack;
+
   std::unique_ptr<SimpleHttpResult> response(
       _client->request(_masterIs27OrHigher ? rest::RequestType::PUT
                                            : rest::RequestType::GET,
-                       url, body.c_str(), body.size()));
+                       url, body.c_str(), body.size(), headers));
 
   if (response == nullptr || !response->isComplete()) {
     errorMsg = "got invalid response from master at " +
@@ -1381,6 +1652,11 @@ int ContinuousSyncer::followMasterLog(std::string& errorMsg,
       active = StringUtils::boolean(header);
     }
 
+    header = response->getHeaderField(TRI_REPLICATION_HEADER_LONGPOLL, found);
+    if (found) {
+      longPolled = StringUtils::boolean(header);
+    }
+
     header =
         response->getHeaderField(TRI_REPLICATION_HEADER_LASTINCLUDED, found);
     if (found) {
@@ -69,6 +69,13 @@ class ContinuousSyncer : public Syncer {
 
   TRI_replication_applier_t* applier() const { return _applier; }
 
+ private:
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief worker threads applying standalone document operations
+  //////////////////////////////////////////////////////////////////////////////
+
+  class ApplyLanes;
+
  private:
   //////////////////////////////////////////////////////////////////////////////
   /// @brief abort all ongoing transactions
@@ -152,6 +159,12 @@ class ContinuousSyncer : public Syncer {
 
   int applyLogMarker(arangodb::velocypack::Slice const&, TRI_voc_tick_t, std::string&);
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief advance the last processed tick to the tick of a marker
+  //////////////////////////////////////////////////////////////////////////////
+
+  void updateProcessedTick(arangodb::velocypack::Slice const&, TRI_voc_tick_t);
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief apply the data from the continuous log
   //////////////////////////////////////////////////////////////////////////////
@@ -177,7 +190,7 @@ class ContinuousSyncer : public Syncer {
   //////////////////////////////////////////////////////////////////////////////
 
   int followMasterLog(std::string&, TRI_voc_tick_t&, TRI_voc_tick_t, uint64_t&,
-                      bool&, bool&);
+                      bool&, bool&, bool&);
 
  private:
   //////////////////////////////////////////////////////////////////////////////
@@ -258,6 +271,13 @@ class ContinuousSyncer : public Syncer {
 
   std::unordered_map<TRI_voc_tid_t, ReplicationTransaction*>
       _ongoingTransactions;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief lanes for applying standalone operations in parallel. only set
+  /// if the applier is configured with more than one apply thread
+  //////////////////////////////////////////////////////////////////////////////
+
+  std::unique_ptr<ApplyLanes> _applyLanes;
 };
 }
 
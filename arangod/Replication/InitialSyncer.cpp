@@ -23,6 +23,8 @@
 
 #include "InitialSyncer.h"
 #include "ApplicationFeatures/ApplicationServer.h"
+#include "Basics/ConditionLocker.h"
+#include "Basics/ConditionVariable.h"
 #include "Basics/Exceptions.h"
 #include "Basics/ReadLocker.h"
 #include "Basics/Result.h"
@@ -54,11 +56,169 @@
 #include <velocypack/Slice.h>
 #include <velocypack/velocypack-aliases.h>
 
+#include <thread>
+
 using namespace arangodb;
 using namespace arangodb::basics;
 using namespace arangodb::httpclient;
 using namespace arangodb::rest;
 
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief executes requests to the master on connections of its own, so
+/// that several requests can be in flight while the results of earlier
+/// ones are processed. requests are executed in submission order, and
+/// their results are handed out by ticket. without any connections,
+/// requests are executed synchronously on the fallback client
+////////////////////////////////////////////////////////////////////////////////
+
+class RequestPipeline {
+ public:
+  RequestPipeline(std::vector<std::unique_ptr<SimpleHttpClient>> clients,
+                  SimpleHttpClient* fallback)
+      : _clients(std::move(clients)),
+        _fallback(fallback),
+        _nextTicket(0),
+        _stop(false) {
+    for (auto& client : _clients) {
+      _threads.emplace_back(&RequestPipeline::run, this, client.get());
+    }
+  }
+
+  ~RequestPipeline() {
+    {
+      CONDITION_LOCKER(guard, _condition);
+      _stop = true;
+      guard.broadcast();
+    }
+
+    for (auto& thread : _threads) {
+      thread.join();
+    }
+  }
+
+  /// @brief queue a request, returns the ticket for its result
+  size_t submit(RequestType type, std::string const& url,
+                std::string const& body) {
+    CONDITION_LOCKER(guard, _condition);
+
+    size_t const ticket = _nextTicket++;
+    Request& request = _requests[ticket];
+    request._type = type;
+    request._url = url;
+    request._body = body;
+    request._done = false;
+
+    if (_threads.empty()) {
+      request._result.reset(_fallback->retryRequest(
+          type, url, body.empty() ? nullptr : body.c_str(), body.size()));
+      request._error = _fallback->getErrorMessage();
+      request._done = true;
+    } else {
+      _queue.emplace_back(ticket);
+      guard.signal();
+    }
+
+    return ticket;
+  }
+
+  /// @brief whether the result for a ticket is available
+  bool isDone(size_t ticket) {
+    CONDITION_LOCKER(guard, _condition);
+
+    auto it = _requests.find(ticket);
+    TRI_ASSERT(it != _requests.end());
+
+    return (*it).second._done;
+  }
+
+  /// @brief wait for the result of a request. the result is nullptr if
+  /// the request failed, errorMessage then contains the reason
+  std::unique_ptr<SimpleHttpResult> wait(size_t ticket,
+                                         std::string& errorMessage) {
+    CONDITION_LOCKER(guard, _condition);
+
+    while (true) {
+      auto it = _requests.find(ticket);
+      TRI_ASSERT(it != _requests.end());
+
+      if ((*it).second._done) {
+        std::unique_ptr<SimpleHttpResult> result =
+            std::move((*it).second._result);
+        errorMessage = (*it).second._error;
+        _requests.erase(it);
+        return result;
+      }
+
+      guard.wait(100000);
+    }
+  }
+
+ private:
+  void run(SimpleHttpClient* client) {
+    while (true) {
+      size_t ticket;
+      RequestType type;
+      std::string url;
+      std::string body;
+
+      {
+        CONDITION_LOCKER(guard, _condition);
+
+        while (!_stop && _queue.empty()) {
+          guard.wait(100000);
+        }
+
+        if (_stop) {
+          return;
+        }
+
+        ticket = _queue.front();
+        _queue.pop_front();
+
+        Request const& request = _requests[ticket];
+        type = request._type;
+        url = request._url;
+        body = request._body;
+      }
+
+      std::unique_ptr<SimpleHttpResult> result(client->retryRequest(
+          type, url, body.empty() ? nullptr : body.c_str(), body.size()));
+
+      CONDITION_LOCKER(guard, _condition);
+
+      Request& request = _requests[ticket];
+      request._result = std::move(result);
+      request._error = client->getErrorMessage();
+      request._done = true;
+      guard.broadcast();
+    }
+  }
+
+ private:
+  struct Request {
+    RequestType _type;
+    std::string _url;
+    std::string _body;
+    bool _done;
+    std::unique_ptr<SimpleHttpResult> _result;
+    std::string _error;
+  };
+
+  std::vector<std::unique_ptr<SimpleHttpClient>> _clients;
+  SimpleHttpClient* _fallback;
+  std::vector<std::thread> _threads;
+
+  /// @brief protects all members below
+  ConditionVariable _condition;
+  size_t _nextTicket;
+  bool _stop;
+  std::deque<size_t> _queue;
+  std::unordered_map<size_t, Request> _requests;
+};
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief performs a binary search for the given key in the markers vector
 ////////////////////////////////////////////////////////////////////////////////
@@ -121,6 +281,8 @@ static bool FindRange(std::vector<uint8_t const*> const& markers,
 
 size_t const InitialSyncer::MaxChunkSize = 10 * 1024 * 1024;
 
+size_t const InitialSyncer::MaxRequestsInFlight = 4;
+
 InitialSyncer::InitialSyncer(
     TRI_vocbase_t* vocbase,
     TRI_replication_applier_configuration_t const* configuration,
@@ -481,7 +643,7 @@ int InitialSyncer::applyCollectionDump(
     transaction::Methods& trx, std::string const& collectionName,
     SimpleHttpResult* response, uint64_t& markersProcessed,
     std::string& errorMsg) {
-  std::string const invalidMsg = "received invalid JSON data for collection " +
+  std::string const invalidMsg = "received invalid data for collection " +
                                  collectionName;
 
   StringBuffer& data = response->getBody();
@@ -490,37 +652,26 @@ int InitialSyncer::applyCollectionDump(
 
   // buffer must end with a NUL byte
   TRI_ASSERT(*end == '\0');
-    
-  auto builder = std::make_shared<VPackBuilder>();
+
+  // markers sent as VelocyPack are used in place, JSON markers are parsed
+  bool const isVelocyPack = hasVelocyPackBody(response);
+  VPackBuilder builder;
 
   while (p < end) {
-    char const* q = strchr(p, '\n');
+    VPackSlice slice;
+    int res = nextMarker(p, end, isVelocyPack, builder, slice);
 
-    if (q == nullptr) {
-      q = end;
+    if (res != TRI_ERROR_NO_ERROR) {
+      errorMsg = invalidMsg;
+
+      return res;
     }
 
-    if (q - p < 2) {
+    if (slice.isNone()) {
       // we are done
       return TRI_ERROR_NO_ERROR;
     }
 
-    TRI_ASSERT(q <= end);
-
-    try {
-      builder->clear();
-      VPackParser parser(builder);
-      parser.parse(p, static_cast<size_t>(q - p));
-    }
-    catch (...) {
-      // TODO: improve error reporting
-      return TRI_ERROR_OUT_OF_MEMORY;
-    }
-
-    p = q + 1;
-
-    VPackSlice const slice = builder->slice();
-
     if (!slice.isObject()) {
       errorMsg = invalidMsg;
 
@@ -580,7 +731,7 @@ int InitialSyncer::applyCollectionDump(
 
     VPackSlice const old = oldBuilder.slice();
 
-    int res = applyCollectionDumpMarker(trx, collectionName, type, old, doc, errorMsg);
+    res = applyCollectionDumpMarker(trx, collectionName, type, old, doc, errorMsg);
 
     if (res != TRI_ERROR_NO_ERROR) {
       return res;
@@ -651,8 +802,12 @@ int InitialSyncer::handleCollectionDump(
 
     setProgress(progress);
 
-    // use async mode for first batch
+    // ask for the markers in VelocyPack format. masters that do not support
+    // it send JSON
     std::unordered_map<std::string, std::string> headers;
+    headers[StaticStrings::Accept] = StaticStrings::MimeTypeVPack;
+
+    // use async mode for first batch
     if (batch == 1) {
       headers["X-Arango-Async"] = "store";
     }
@@ -1272,44 +1427,13 @@ int InitialSyncer::handleSyncKeys(arangodb::LogicalCollection* col,
     trx.commit();
   }
     
-  size_t nextStart = 0;
+  // compare all chunks with the local keys first. this needs no requests
+  // to the master, and tells which chunks have to be fetched
+  std::vector<bool> matches(n, false);
+  std::vector<size_t> localEnds(n, 0);
 
-  // now process each chunk
   for (size_t i = 0; i < n; ++i) {
-    if (checkAborted()) {
-      return TRI_ERROR_REPLICATION_APPLIER_STOPPED;
-    }
-    
-    SingleCollectionTransaction trx(transaction::StandaloneContext::Create(_vocbase), col->cid(), AccessMode::Type::WRITE);
-  
-    int res = trx.begin();
-  
-    if (res != TRI_ERROR_NO_ERROR) {
-      errorMsg = std::string("unable to start transaction: ") + TRI_errno_string(res);
-      return res;
-    }
-    
-    trx.pinData(col->cid()); // will throw when it fails
-    
-    // We do not take responsibility for the index.
-    // The LogicalCollection is protected by trx.
-    // Neither it nor it's indexes can be invalidated
-
-    // TODO Move to MMFiles
-    auto physical = static_cast<MMFilesCollection*>(
-        trx.documentCollection()->getPhysical());
-    auto idx = physical->primaryIndex();
-
-    size_t const currentChunkId = i;
-    progress = "processing keys chunk " + std::to_string(currentChunkId) +
-               " for collection '" + collectionName + "'";
-    setProgress(progress);
-
-    sendExtendBatch();
-    sendExtendBarrier();
-
-    // read remote chunk
-    VPackSlice chunk = slice.at(i);
+    VPackSlice const chunk = slice.at(i);
 
     if (!chunk.isObject()) {
       errorMsg = "got invalid response from master at " +
@@ -1331,21 +1455,18 @@ int InitialSyncer::handleSyncKeys(arangodb::LogicalCollection* col,
       return TRI_ERROR_REPLICATION_INVALID_RESPONSE;
     }
 
-    std::string const lowString = lowSlice.copyString();
-    std::string const highString = highSlice.copyString();
-
     size_t localFrom;
     size_t localTo;
-    bool match =
-        FindRange(markers, lowString, highString, localFrom, localTo);
+    bool match = FindRange(markers, lowSlice.copyString(),
+                           highSlice.copyString(), localFrom, localTo);
 
     if (match) {
       // now must hash the range
       uint64_t hash = 0x012345678;
 
-      for (size_t i = localFrom; i <= localTo; ++i) {
-        TRI_ASSERT(i < markers.size());
-        VPackSlice const current(markers.at(i));
+      for (size_t j = localFrom; j <= localTo; ++j) {
+        TRI_ASSERT(j < markers.size());
+        VPackSlice const current(markers.at(j));
         hash ^= current.get(StaticStrings::KeyString).hashString();
         hash ^= current.get(StaticStrings::RevString).hash();
       }
@@ -1355,282 +1476,386 @@ int InitialSyncer::handleSyncKeys(arangodb::LogicalCollection* col,
       }
     }
 
-    if (match) {
-      // match
-      nextStart = localTo + 1;
-    } else {
-      // no match
-      // must transfer keys for non-matching range
-      std::string url = baseUrl + "/" + keysId + "?type=keys&chunk=" +
-                        std::to_string(i) + "&chunkSize=" +
-                        std::to_string(chunkSize);
-      progress = "fetching keys chunk " + std::to_string(currentChunkId) +
-                 " for collection '" + collectionName + "' from " + url;
-      setProgress(progress);
+    matches[i] = match;
+    localEnds[i] = localTo;
+  }
 
-      std::unique_ptr<SimpleHttpResult> response(_client->retryRequest(
-          rest::RequestType::PUT, url, nullptr, 0));
+  // fetch the keys and documents of several chunks concurrently, using
+  // connections of their own. masters before 3.2 cannot serve concurrent
+  // requests for the same keys
+  std::vector<std::unique_ptr<SimpleHttpClient>> clients;
 
-      if (response == nullptr || !response->isComplete()) {
-        errorMsg = "could not connect to master at " +
-                   _masterInfo._endpoint + ": " +
-                   _client->getErrorMessage();
+  if (_masterInfo._majorVersion > 3 ||
+      (_masterInfo._majorVersion == 3 && _masterInfo._minorVersion >= 2)) {
+    for (size_t i = 0; i < MaxRequestsInFlight; ++i) {
+      std::unique_ptr<SimpleHttpClient> client = createHttpClient();
 
-        return TRI_ERROR_REPLICATION_NO_RESPONSE;
+      if (client == nullptr) {
+        break;
       }
+      clients.emplace_back(std::move(client));
+    }
+  }
 
-      TRI_ASSERT(response != nullptr);
+  RequestPipeline pipeline(std::move(clients), _client);
 
-      if (response->wasHttpError()) {
-        errorMsg = "got invalid response from master at " +
-                   _masterInfo._endpoint + ": HTTP " +
-                   StringUtils::itoa(response->getHttpReturnCode()) + ": " +
-                   response->getHttpReturnMessage();
+  // validates a response and parses it into an array
+  auto parseArrayResponse = [this, &errorMsg](
+      SimpleHttpResult* response, std::string const& clientError,
+      std::shared_ptr<VPackBuilder>& builder) -> int {
+    if (response == nullptr || !response->isComplete()) {
+      errorMsg = "could not connect to master at " + _masterInfo._endpoint +
+                 ": " + clientError;
+
+      return TRI_ERROR_REPLICATION_NO_RESPONSE;
+    }
+
+    if (response->wasHttpError()) {
+      errorMsg = "got invalid response from master at " +
+                 _masterInfo._endpoint + ": HTTP " +
+                 StringUtils::itoa(response->getHttpReturnCode()) + ": " +
+                 response->getHttpReturnMessage();
 
-        return TRI_ERROR_REPLICATION_MASTER_ERROR;
+      return TRI_ERROR_REPLICATION_MASTER_ERROR;
+    }
+
+    builder = std::make_shared<VPackBuilder>();
+    int res = parseResponse(builder, response);
+
+    if (res != TRI_ERROR_NO_ERROR || !builder->slice().isArray()) {
+      errorMsg = "got invalid response from master at " +
+                 _masterInfo._endpoint + ": response is no array";
+
+      return TRI_ERROR_REPLICATION_INVALID_RESPONSE;
+    }
+
+    return TRI_ERROR_NO_ERROR;
+  };
+
+  // the keys of non-matching chunks are requested ahead of processing
+  std::vector<size_t> keysTickets(n, 0);
+  size_t keysRequested = 0;
+
+  auto requestKeys = [&](size_t upTo) {
+    for (; keysRequested < n && keysRequested < upTo; ++keysRequested) {
+      if (!matches[keysRequested]) {
+        std::string const url = baseUrl + "/" + keysId + "?type=keys&chunk=" +
+                                std::to_string(keysRequested) +
+                                "&chunkSize=" + std::to_string(chunkSize);
+        keysTickets[keysRequested] =
+            pipeline.submit(rest::RequestType::PUT, url, "");
       }
+    }
+  };
 
-      auto builder = std::make_shared<VPackBuilder>();
-      int res = parseResponse(builder, response.get());
+  // document requests in flight, as pairs of chunk id and ticket. the
+  // chunks cover disjoint key ranges, so the documents of a chunk can be
+  // applied while later chunks are being compared
+  std::deque<std::pair<size_t, size_t>> pendingDocuments;
 
-      if (res != TRI_ERROR_NO_ERROR) {
+  auto applyDocuments = [&](size_t chunkId, size_t ticket) -> int {
+    std::string clientError;
+    std::unique_ptr<SimpleHttpResult> response =
+        pipeline.wait(ticket, clientError);
+
+    std::shared_ptr<VPackBuilder> builder;
+    int res = parseArrayResponse(response.get(), clientError, builder);
+
+    if (res != TRI_ERROR_NO_ERROR) {
+      return res;
+    }
+
+    setProgress("applying documents chunk " + std::to_string(chunkId) +
+                " for collection '" + collectionName + "'");
+
+    SingleCollectionTransaction trx(
+        transaction::StandaloneContext::Create(_vocbase), col->cid(),
+        AccessMode::Type::WRITE);
+
+    res = trx.begin();
+
+    if (res != TRI_ERROR_NO_ERROR) {
+      errorMsg = std::string("unable to start transaction: ") +
+                 TRI_errno_string(res);
+      return res;
+    }
+
+    trx.pinData(col->cid());  // will throw when it fails
+
+    // TODO Move to MMFiles
+    auto physical = static_cast<MMFilesCollection*>(
+        trx.documentCollection()->getPhysical());
+    auto idx = physical->primaryIndex();
+
+    for (auto const& it : VPackArrayIterator(builder->slice())) {
+      if (!it.isObject()) {
         errorMsg = "got invalid response from master at " +
-                   _masterInfo._endpoint +
-                   ": response is no array";
+                   _masterInfo._endpoint + ": document is no object";
 
         return TRI_ERROR_REPLICATION_INVALID_RESPONSE;
       }
 
-      VPackSlice const slice = builder->slice();
-      if (!slice.isArray()) {
+      VPackSlice const keySlice = it.get(StaticStrings::KeyString);
+
+      if (!keySlice.isString()) {
         errorMsg = "got invalid response from master at " +
-                   _masterInfo._endpoint +
-                   ": response is no array";
+                   _masterInfo._endpoint + ": document key is invalid";
 
         return TRI_ERROR_REPLICATION_INVALID_RESPONSE;
       }
 
+      VPackSlice const revSlice = it.get(StaticStrings::RevString);
 
-      // delete all keys at start of the range
-      while (nextStart < markers.size()) {
-        VPackSlice const keySlice(markers[nextStart]);
-        std::string const localKey(keySlice.get(StaticStrings::KeyString).copyString());
+      if (!revSlice.isString()) {
+        errorMsg = "got invalid response from master at " +
+                   _masterInfo._endpoint + ": document revision is invalid";
 
-        if (localKey.compare(lowString) < 0) {
-          // we have a local key that is not present remotely
-          keyBuilder.clear();
-          keyBuilder.openObject();
-          keyBuilder.add(StaticStrings::KeyString, VPackValue(localKey));
-          keyBuilder.close();
+        return TRI_ERROR_REPLICATION_INVALID_RESPONSE;
+      }
 
-          trx.remove(collectionName, keyBuilder.slice(), options);
-          ++nextStart;
-        } else {
-          break;
-        }
+      MMFilesSimpleIndexElement element = idx->lookupKey(&trx, keySlice);
+
+      if (!element) {
+        // INSERT
+        OperationResult opRes = trx.insert(collectionName, it, options);
+        res = opRes.code;
+      } else {
+        // UPDATE
+        OperationResult opRes = trx.update(collectionName, it, options);
+        res = opRes.code;
       }
 
-      toFetch.clear();
+      if (res != TRI_ERROR_NO_ERROR) {
+        return res;
+      }
+    }
 
-      size_t const n = static_cast<size_t>(slice.length());
-      TRI_ASSERT(n > 0);
-  
-      for (size_t i = 0; i < n; ++i) {
-        VPackSlice const pair = slice.at(i);
+    return trx.commit();
+  };
 
-        if (!pair.isArray() || pair.length() != 2) {
-          errorMsg = "got invalid response from master at " +
-                     _masterInfo._endpoint +
-                     ": response key pair is no valid array";
+  size_t nextStart = 0;
 
-          return TRI_ERROR_REPLICATION_INVALID_RESPONSE;
-        }
+  // now process each chunk
+  for (size_t i = 0; i < n; ++i) {
+    if (checkAborted()) {
+      return TRI_ERROR_REPLICATION_APPLIER_STOPPED;
+    }
 
-        // key
-        VPackSlice const keySlice = pair.at(0);
-        
-        if (!keySlice.isString()) {
-          errorMsg = "got invalid response from master at " +
-                     _masterInfo._endpoint +
-                     ": response key is no string";
+    requestKeys(i + MaxRequestsInFlight);
 
-          return TRI_ERROR_REPLICATION_INVALID_RESPONSE;
-        }
+    // apply the documents that have arrived, and wait for the oldest
+    // request if too many are in flight
+    while (!pendingDocuments.empty() &&
+           (pendingDocuments.size() >= MaxRequestsInFlight ||
+            pipeline.isDone(pendingDocuments.front().second))) {
+      res = applyDocuments(pendingDocuments.front().first,
+                           pendingDocuments.front().second);
+      pendingDocuments.pop_front();
 
-        // rid
-        if (markers.empty()) {
-          // no local markers
-          toFetch.emplace_back(i);
-          continue;
-        }
-          
-        std::string const keyString = keySlice.copyString();
+      if (res != TRI_ERROR_NO_ERROR) {
+        return res;
+      }
+    }
 
-        while (nextStart < markers.size()) {
-          VPackSlice const localKeySlice(markers[nextStart]);
-          std::string const localKey(localKeySlice.get(StaticStrings::KeyString).copyString());
+    sendExtendBatch();
+    sendExtendBarrier();
 
-          int res = localKey.compare(keyString);
+    if (matches[i]) {
+      // match
+      nextStart = localEnds[i] + 1;
+      continue;
+    }
 
-          if (res != 0) {
-            // we have a local key that is not present remotely
-            keyBuilder.clear();
-            keyBuilder.openObject();
-            keyBuilder.add(StaticStrings::KeyString, VPackValue(localKey));
-            keyBuilder.close();
+    size_t const currentChunkId = i;
+    progress = "processing keys chunk " + std::to_string(currentChunkId) +
+               " for collection '" + collectionName + "'";
+    setProgress(progress);
 
-            trx.remove(collectionName, keyBuilder.slice(), options);
-            ++nextStart;
-          } else {
-            // key match
-            break;
-          }
-        }
+    VPackSlice const chunk = slice.at(i);
+    std::string const lowString = chunk.get("low").copyString();
+    std::string const highString = chunk.get("high").copyString();
 
-        MMFilesSimpleIndexElement element = idx->lookupKey(&trx, keySlice);
+    // no match
+    // must transfer keys for non-matching range
+    std::string clientError;
+    std::unique_ptr<SimpleHttpResult> response =
+        pipeline.wait(keysTickets[i], clientError);
 
-        if (!element) {
-          // key not found locally
-          toFetch.emplace_back(i);
-        } else if (TRI_RidToString(element.revisionId()) != pair.at(1).copyString()) {
-          // key found, but revision id differs
-          toFetch.emplace_back(i);
-          ++nextStart;
-        } else {
-          // a match - nothing to do!
-          ++nextStart;
-        }
-      }
+    std::shared_ptr<VPackBuilder> keysBuilder;
+    res = parseArrayResponse(response.get(), clientError, keysBuilder);
 
-      // calculate next starting point
-      if (!markers.empty()) {
-        BinarySearch(markers, highString, nextStart);
+    if (res != TRI_ERROR_NO_ERROR) {
+      return res;
+    }
 
-        while (nextStart < markers.size()) {
-          VPackSlice const localKeySlice(markers[nextStart]);
-          std::string const localKey(localKeySlice.get(StaticStrings::KeyString).copyString());
-          
-          int res = localKey.compare(highString);
+    VPackSlice const keys = keysBuilder->slice();
 
-          if (res <= 0) {
-            ++nextStart;
-          } else {
-            break;
-          }
-        }
+    SingleCollectionTransaction trx(transaction::StandaloneContext::Create(_vocbase), col->cid(), AccessMode::Type::WRITE);
+  
+    res = trx.begin();
+  
+    if (res != TRI_ERROR_NO_ERROR) {
+      errorMsg = std::string("unable to start transaction: ") + TRI_errno_string(res);
+      return res;
+    }
+    
+    trx.pinData(col->cid()); // will throw when it fails
+    
+    // We do not take responsibility for the index.
+    // The LogicalCollection is protected by trx.
+    // Neither it nor it's indexes can be invalidated
+
+    // TODO Move to MMFiles
+    auto physical = static_cast<MMFilesCollection*>(
+        trx.documentCollection()->getPhysical());
+    auto idx = physical->primaryIndex();
+
+    // delete all keys at start of the range
+    while (nextStart < markers.size()) {
+      VPackSlice const keySlice(markers[nextStart]);
+      std::string const localKey(keySlice.get(StaticStrings::KeyString).copyString());
+
+      if (localKey.compare(lowString) < 0) {
+        // we have a local key that is not present remotely
+        keyBuilder.clear();
+        keyBuilder.openObject();
+        keyBuilder.add(StaticStrings::KeyString, VPackValue(localKey));
+        keyBuilder.close();
+
+        trx.remove(collectionName, keyBuilder.slice(), options);
+        ++nextStart;
+      } else {
+        break;
       }
+    }
 
-      if (!toFetch.empty()) {
-        VPackBuilder keysBuilder;
-        keysBuilder.openArray();
-        for (auto& it : toFetch) {
-          keysBuilder.add(VPackValue(it));
-        }
-        keysBuilder.close();
-  
-        std::string url = baseUrl + "/" + keysId + "?type=docs&chunk=" +
-                          std::to_string(currentChunkId) + "&chunkSize=" +
-                          std::to_string(chunkSize);
-        progress = "fetching documents chunk " +
-                   std::to_string(currentChunkId) + " for collection '" +
-                   collectionName + "' from " + url;
-        setProgress(progress);
+    toFetch.clear();
 
-        std::string const keyJsonString(keysBuilder.slice().toJson()); 
+    size_t const numKeys = static_cast<size_t>(keys.length());
+    TRI_ASSERT(numKeys > 0);
 
-        std::unique_ptr<SimpleHttpResult> response(
-            _client->retryRequest(rest::RequestType::PUT, url,
-                                  keyJsonString.c_str(), keyJsonString.size()));
+    for (size_t j = 0; j < numKeys; ++j) {
+      VPackSlice const pair = keys.at(j);
 
-        if (response == nullptr || !response->isComplete()) {
-          errorMsg = "could not connect to master at " +
-                     _masterInfo._endpoint + ": " +
-                     _client->getErrorMessage();
+      if (!pair.isArray() || pair.length() != 2) {
+        errorMsg = "got invalid response from master at " +
+                   _masterInfo._endpoint +
+                   ": response key pair is no valid array";
 
-          return TRI_ERROR_REPLICATION_NO_RESPONSE;
-        }
+        return TRI_ERROR_REPLICATION_INVALID_RESPONSE;
+      }
 
-        TRI_ASSERT(response != nullptr);
+      // key
+      VPackSlice const keySlice = pair.at(0);
+      
+      if (!keySlice.isString()) {
+        errorMsg = "got invalid response from master at " +
+                   _masterInfo._endpoint +
+                   ": response key is no string";
 
-        if (response->wasHttpError()) {
-          errorMsg = "got invalid response from master at " +
-                     _masterInfo._endpoint + ": HTTP " +
-                     StringUtils::itoa(response->getHttpReturnCode()) + ": " +
-                     response->getHttpReturnMessage();
+        return TRI_ERROR_REPLICATION_INVALID_RESPONSE;
+      }
 
-          return TRI_ERROR_REPLICATION_MASTER_ERROR;
-        }
+      // rid
+      if (markers.empty()) {
+        // no local markers
+        toFetch.emplace_back(j);
+        continue;
+      }
+        
+      std::string const keyString = keySlice.copyString();
 
-        auto builder = std::make_shared<VPackBuilder>();
-        int res = parseResponse(builder, response.get());
+      while (nextStart < markers.size()) {
+        VPackSlice const localKeySlice(markers[nextStart]);
+        std::string const localKey(localKeySlice.get(StaticStrings::KeyString).copyString());
 
-        if (res != TRI_ERROR_NO_ERROR) {
-          errorMsg = "got invalid response from master at " +
-                     std::string(_masterInfo._endpoint) +
-                     ": response is no array";
+        int res = localKey.compare(keyString);
 
-          return TRI_ERROR_REPLICATION_INVALID_RESPONSE;
-        }
- 
-        VPackSlice const slice = builder->slice();
-        if (!slice.isArray()) {
-          errorMsg = "got invalid response from master at " +
-                     _masterInfo._endpoint +
-                     ": response is no array";
+        if (res != 0) {
+          // we have a local key that is not present remotely
+          keyBuilder.clear();
+          keyBuilder.openObject();
+          keyBuilder.add(StaticStrings::KeyString, VPackValue(localKey));
+          keyBuilder.close();
 
-          return TRI_ERROR_REPLICATION_INVALID_RESPONSE;
+          trx.remove(collectionName, keyBuilder.slice(), options);
+          ++nextStart;
+        } else {
+          // key match
+          break;
         }
+      }
 
-        for (auto const& it : VPackArrayIterator(slice)) {
-          if (!it.isObject()) {
-            errorMsg = "got invalid response from master at " +
-                       _masterInfo._endpoint +
-                       ": document is no object";
-
-            return TRI_ERROR_REPLICATION_INVALID_RESPONSE;
-          }
+      MMFilesSimpleIndexElement element = idx->lookupKey(&trx, keySlice);
+
+      if (!element) {
+        // key not found locally
+        toFetch.emplace_back(j);
+      } else if (TRI_RidToString(element.revisionId()) != pair.at(1).copyString()) {
+        // key found, but revision id differs
+        toFetch.emplace_back(j);
+        ++nextStart;
+      } else {
+        // a match - nothing to do!
+        ++nextStart;
+      }
+    }
 
-          VPackSlice const keySlice = it.get(StaticStrings::KeyString);
+    // calculate next starting point
+    if (!markers.empty()) {
+      BinarySearch(markers, highString, nextStart);
 
-          if (!keySlice.isString()) {
-            errorMsg = "got invalid response from master at " +
-                       _masterInfo._endpoint +
-                       ": document key is invalid";
+      while (nextStart < markers.size()) {
+        VPackSlice const localKeySlice(markers[nextStart]);
+        std::string const localKey(localKeySlice.get(StaticStrings::KeyString).copyString());
+        
+        int res = localKey.compare(highString);
 
-            return TRI_ERROR_REPLICATION_INVALID_RESPONSE;
-          }
+        if (res <= 0) {
+          ++nextStart;
+        } else {
+          break;
+        }
+      }
+    }
 
-          VPackSlice const revSlice = it.get(StaticStrings::RevString);
+    res = trx.commit();
 
-          if (!revSlice.isString()) {
-            errorMsg = "got invalid response from master at " +
-                       _masterInfo._endpoint +
-                       ": document revision is invalid";
+    if (res != TRI_ERROR_NO_ERROR) {
+      return res;
+    }
 
-            return TRI_ERROR_REPLICATION_INVALID_RESPONSE;
-          }
+    if (!toFetch.empty()) {
+      VPackBuilder fetchBuilder;
+      fetchBuilder.openArray();
+      for (auto& it : toFetch) {
+        fetchBuilder.add(VPackValue(it));
+      }
+      fetchBuilder.close();
 
-          MMFilesSimpleIndexElement element = idx->lookupKey(&trx, keySlice);
+      std::string url = baseUrl + "/" + keysId + "?type=docs&chunk=" +
+                        std::to_string(currentChunkId) + "&chunkSize=" +
+                        std::to_string(chunkSize);
+      progress = "fetching documents chunk " +
+                 std::to_string(currentChunkId) + " for collection '" +
+                 collectionName + "' from " + url;
+      setProgress(progress);
 
-          if (!element) {
-            // INSERT
-            OperationResult opRes = trx.insert(collectionName, it, options);
-            res = opRes.code;
-          } else {
-            // UPDATE
-            OperationResult opRes = trx.update(collectionName, it, options);
-            res = opRes.code;
-          }
+      pendingDocuments.emplace_back(
+          currentChunkId, pipeline.submit(rest::RequestType::PUT, url,
+                                          fetchBuilder.slice().toJson()));
+    }
+  }
 
-          if (res != TRI_ERROR_NO_ERROR) {
-            return res;
-          }
-        }
-      }
+  while (!pendingDocuments.empty()) {
+    if (checkAborted()) {
+      return TRI_ERROR_REPLICATION_APPLIER_STOPPED;
     }
 
-    res = trx.commit();
-    
+    res = applyDocuments(pendingDocuments.front().first,
+                         pendingDocuments.front().second);
+    pendingDocuments.pop_front();
+
     if (res != TRI_ERROR_NO_ERROR) {
       return res;
     }
@@ -298,6 +298,13 @@ class InitialSyncer : public Syncer {
   //////////////////////////////////////////////////////////////////////////////
 
   static size_t const MaxChunkSize;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief maximum number of concurrent requests for keys and documents
+  /// during incremental synchronization of a collection
+  //////////////////////////////////////////////////////////////////////////////
+
+  static size_t const MaxRequestsInFlight;
 };
 }
 
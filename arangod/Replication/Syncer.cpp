@@ -23,6 +23,8 @@
 
 #include "Syncer.h"
 #include "Basics/Exceptions.h"
+#include "Basics/StaticStrings.h"
+#include "Basics/StringUtils.h"
 #include "Basics/VelocyPackHelper.h"
 #include "Rest/HttpRequest.h"
 #include "RestServer/ServerIdFeature.h"
@@ -43,7 +45,9 @@
 
 #include <velocypack/Builder.h>
 #include <velocypack/Collection.h>
+#include <velocypack/Parser.h>
 #include <velocypack/Slice.h>
+#include <velocypack/Validator.h>
 #include <velocypack/velocypack-aliases.h>
 
 using namespace arangodb;
@@ -97,24 +101,7 @@ Syncer::Syncer(TRI_vocbase_t* vocbase,
     if (_connection != nullptr) {
       _client = new SimpleHttpClient(_connection,
                                      _configuration._requestTimeout, false);
-
-      std::string username = _configuration._username;
-      std::string password = _configuration._password;
-      
-      if (!username.empty()) {
-        _client->setUserNamePassword("/", username, password);
-      } else {
-        _client->setJwt(_configuration._jwt);
-      }
-      _client->setLocationRewriter(this, &rewriteLocation);
-
-      _client->_maxRetries = 2;
-      _client->_retryWaitTime = 2 * 1000 * 1000;
-      _client->_retryMessage =
-          std::string("retrying failed HTTP request for endpoint '") +
-          _configuration._endpoint +
-          std::string("' for replication applier in database '" +
-                      _vocbase->name() + "'");
+      configureHttpClient(_client);
     }
   }
 }
@@ -131,6 +118,58 @@ Syncer::~Syncer() {
   delete _endpoint;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create an additional http client for the master
+////////////////////////////////////////////////////////////////////////////////
+
+std::unique_ptr<SimpleHttpClient> Syncer::createHttpClient() {
+  if (_endpoint == nullptr) {
+    return nullptr;
+  }
+
+  std::unique_ptr<GeneralClientConnection> connection(
+      GeneralClientConnection::factory(
+          _endpoint, _configuration._requestTimeout,
+          _configuration._connectTimeout,
+          (size_t)_configuration._maxConnectRetries,
+          (uint32_t)_configuration._sslProtocol));
+
+  if (connection == nullptr) {
+    return nullptr;
+  }
+
+  // the client takes over the connection
+  std::unique_ptr<SimpleHttpClient> client(new SimpleHttpClient(
+      connection, _configuration._requestTimeout, false));
+  configureHttpClient(client.get());
+
+  return client;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief apply credentials and retry settings to an http client
+////////////////////////////////////////////////////////////////////////////////
+
+void Syncer::configureHttpClient(SimpleHttpClient* client) {
+  std::string username = _configuration._username;
+  std::string password = _configuration._password;
+
+  if (!username.empty()) {
+    client->setUserNamePassword("/", username, password);
+  } else {
+    client->setJwt(_configuration._jwt);
+  }
+  client->setLocationRewriter(this, &rewriteLocation);
+
+  client->_maxRetries = 2;
+  client->_retryWaitTime = 2 * 1000 * 1000;
+  client->_retryMessage =
+      std::string("retrying failed HTTP request for endpoint '") +
+      _configuration._endpoint +
+      std::string("' for replication applier in database '" +
+                  _vocbase->name() + "'");
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief parse a velocypack response
 ////////////////////////////////////////////////////////////////////////////////
@@ -318,6 +357,71 @@ TRI_voc_cid_t Syncer::getCid(VPackSlice const& slice) const {
   return VelocyPackHelper::extractIdValue(slice);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether the master sent the markers of a dump or logger-follow
+/// response as VelocyPack values instead of JSON lines
+////////////////////////////////////////////////////////////////////////////////
+
+bool Syncer::hasVelocyPackBody(SimpleHttpResult* response) const {
+  bool found = false;
+  std::string const contentType =
+      response->getHeaderField(StaticStrings::ContentTypeHeader, found);
+
+  return found && StringUtils::isPrefix(contentType, StaticStrings::MimeTypeVPack);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief read the next marker from the body of a dump or logger-follow
+/// response
+////////////////////////////////////////////////////////////////////////////////
+
+int Syncer::nextMarker(char const*& p, char const* end, bool isVelocyPack,
+                       VPackBuilder& builder, VPackSlice& marker) const {
+  marker = VPackSlice::noneSlice();
+
+  if (p >= end) {
+    return TRI_ERROR_NO_ERROR;
+  }
+
+  if (isVelocyPack) {
+    // the markers follow each other without separators
+    try {
+      VPackValidator validator;
+      validator.validate(p, static_cast<size_t>(end - p), true);
+    } catch (...) {
+      return TRI_ERROR_REPLICATION_INVALID_RESPONSE;
+    }
+
+    marker = VPackSlice(p);
+    p += marker.byteSize();
+    return TRI_ERROR_NO_ERROR;
+  }
+
+  char const* q = strchr(p, '\n');
+
+  if (q == nullptr) {
+    q = end;
+  }
+
+  if (q - p < 2) {
+    // we are done
+    p = end;
+    return TRI_ERROR_NO_ERROR;
+  }
+
+  try {
+    builder.clear();
+    VPackParser parser(builder);
+    parser.parse(p, static_cast<size_t>(q - p));
+  } catch (...) {
+    return TRI_ERROR_REPLICATION_INVALID_RESPONSE;
+  }
+
+  p = (q < end) ? q + 1 : end;
+  marker = builder.slice();
+  return TRI_ERROR_NO_ERROR;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 /// @brief extract the collection name from VelocyPack
 ////////////////////////////////////////////////////////////////////////////////
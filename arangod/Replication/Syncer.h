@@ -36,6 +36,7 @@ class Endpoint;
 class LogicalCollection;
 
 namespace velocypack {
+class Builder;
 class Slice;
 }
 
@@ -92,6 +93,20 @@ class Syncer {
 
  protected:
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief create an additional http client for the master, with a
+  /// connection of its own and configured like _client. returns nullptr
+  /// if no connection can be created
+  //////////////////////////////////////////////////////////////////////////////
+
+  std::unique_ptr<httpclient::SimpleHttpClient> createHttpClient();
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief apply credentials and retry settings to an http client
+  //////////////////////////////////////////////////////////////////////////////
+
+  void configureHttpClient(httpclient::SimpleHttpClient*);
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief send a "create barrier" command
   //////////////////////////////////////////////////////////////////////////////
@@ -110,6 +125,24 @@ class Syncer {
 
   int sendRemoveBarrier();
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief whether the master sent the markers of a dump or logger-follow
+  /// response as VelocyPack values instead of JSON lines
+  //////////////////////////////////////////////////////////////////////////////
+
+  bool hasVelocyPackBody(httpclient::SimpleHttpResult*) const;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief read the next marker from the body of a dump or logger-follow
+  /// response and advance the read position behind it. VelocyPack markers
+  /// are validated and used in place, JSON markers are parsed into the
+  /// builder. the marker is set to a none slice at the end of the body
+  //////////////////////////////////////////////////////////////////////////////
+
+  int nextMarker(char const*&, char const*, bool,
+                 arangodb::velocypack::Builder&,
+                 arangodb::velocypack::Slice&) const;
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief extract the collection id from VelocyPack
   //////////////////////////////////////////////////////////////////////////////
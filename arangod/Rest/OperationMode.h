@@ -31,6 +31,7 @@ enum class OperationMode {
   MODE_CONSOLE,
   MODE_UNITTESTS,
   MODE_SCRIPT,
+  MODE_BENCHMARK,
   MODE_SERVER
 };
 }
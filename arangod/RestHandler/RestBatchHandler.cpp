@@ -23,6 +23,7 @@
 
 #include "RestBatchHandler.h"
 
+#include "Basics/LocalTaskQueue.h"
 #include "Basics/StaticStrings.h"
 #include "Basics/StringUtils.h"
 #include "GeneralServer/GeneralServer.h"
@@ -30,11 +31,42 @@
 #include "GeneralServer/RestHandlerFactory.h"
 #include "Logger/Logger.h"
 #include "Rest/HttpRequest.h"
+#include "Scheduler/JobGuard.h"
+#include "Scheduler/Scheduler.h"
+#include "Scheduler/SchedulerFeature.h"
 
 using namespace arangodb;
 using namespace arangodb::basics;
 using namespace arangodb::rest;
 
+namespace {
+
+/// @brief task executing batch parts on a scheduler thread
+class BatchPartTask : public arangodb::basics::LocalTask {
+ public:
+  BatchPartTask(arangodb::basics::LocalTaskQueue* queue,
+                std::function<void()> const& cb)
+      : LocalTask(queue), _cb(cb) {}
+
+  void run() override {
+    try {
+      _cb();
+    } catch (...) {
+      _queue->setStatus(TRI_ERROR_INTERNAL);
+    }
+
+    _queue->join();
+  }
+
+ private:
+  std::function<void()> _cb;
+};
+
+}  // namespace
+
+/// @brief upper bound for the parallelism requested by a client
+size_t const RestBatchHandler::MaxParallelism = 16;
+
 RestBatchHandler::RestBatchHandler(GeneralRequest* request,
                                    GeneralResponse* response)
     : RestVocbaseBaseHandler(request, response) {}
@@ -119,6 +151,16 @@ RestStatus RestBatchHandler::executeHttp() {
   helper.message = &message;
   helper.searchStart = message.messageStart;
 
+  // number of parts that may be executed concurrently. with more than one,
+  // the parts must be independent of each other, because they may run in
+  // any order
+  size_t parallelism = static_cast<size_t>((std::max)(
+      int64_t(1), StringUtils::int64(_request->value("parallelism"))));
+  parallelism = (std::min)(parallelism, MaxParallelism);
+
+  // handlers and content ids of all parts, in order
+  std::vector<std::pair<std::shared_ptr<RestHandler>, std::string>> parts;
+
   // iterate over all parts of the multipart message
   while (true) {
     // get the next part from the multipart message
@@ -208,69 +250,61 @@ RestStatus RestBatchHandler::executeHttp() {
       handler.reset(h);
     }
 
-    // start to work for this handler
-    {
-      // ignore any errors here, will be handled later by inspecting the response
-      try {
-        handler->syncRunEngine();
-      } catch (...) {
-      }
+    std::string contentId;
+    if (helper.contentId != 0) {
+      contentId.assign(helper.contentId, helper.contentIdLength);
+    }
 
-#if 0
-      int result = TRI_ERROR_NO_ERROR; 
-      if (result != TRI_ERROR_NO_ERROR) {
-        generateError(rest::ResponseCode::BAD, TRI_ERROR_INTERNAL,
-                      "executing a handler for batch part failed");
+    parts.emplace_back(std::move(handler), std::move(contentId));
 
-        return RestStatus::FAIL;
-      }
-#endif
-      HttpResponse* partResponse =
-          dynamic_cast<HttpResponse*>(handler->response());
+    // we've read the last part
+    if (!helper.containsMore) {
+      break;
+    }
+  }
 
-      if (partResponse == nullptr) {
-        generateError(rest::ResponseCode::BAD, TRI_ERROR_INTERNAL,
-                      "could not create a response for batch part request");
+  // start to work for the handlers
+  executeParts(parts, parallelism);
 
-        return RestStatus::FAIL;
-      }
+  for (auto const& part : parts) {
+    HttpResponse* partResponse =
+        dynamic_cast<HttpResponse*>(part.first->response());
 
-      rest::ResponseCode const code = partResponse->responseCode();
+    if (partResponse == nullptr) {
+      generateError(rest::ResponseCode::BAD, TRI_ERROR_INTERNAL,
+                    "could not create a response for batch part request");
 
-      // count everything above 400 as error
-      if (int(code) >= 400) {
-        ++errors;
-      }
+      return RestStatus::FAIL;
+    }
 
-      // append the boundary for this subpart
-      httpResponse->body().appendText(boundary + "\r\nContent-Type: ");
-      httpResponse->body().appendText(StaticStrings::BatchContentType);
+    rest::ResponseCode const code = partResponse->responseCode();
 
-      // append content-id if it is present
-      if (helper.contentId != 0) {
-        httpResponse->body().appendText(
-            "\r\nContent-Id: " +
-            std::string(helper.contentId, helper.contentIdLength));
-      }
+    // count everything above 400 as error
+    if (int(code) >= 400) {
+      ++errors;
+    }
 
-      httpResponse->body().appendText(TRI_CHAR_LENGTH_PAIR("\r\n\r\n"));
+    // append the boundary for this subpart
+    httpResponse->body().appendText(boundary + "\r\nContent-Type: ");
+    httpResponse->body().appendText(StaticStrings::BatchContentType);
 
-      // remove some headers we don't need
-      partResponse->setConnectionType(rest::ConnectionType::C_NONE);
-      partResponse->setHeaderNC(StaticStrings::Server, "");
+    // append content-id if it is present
+    if (!part.second.empty()) {
+      httpResponse->body().appendText("\r\nContent-Id: " + part.second);
+    }
 
-      // append the part response header
-      partResponse->writeHeader(&httpResponse->body());
+    httpResponse->body().appendText(TRI_CHAR_LENGTH_PAIR("\r\n\r\n"));
 
-      // append the part response body
-      httpResponse->body().appendText(partResponse->body());
-      httpResponse->body().appendText(TRI_CHAR_LENGTH_PAIR("\r\n"));
-    }
+    // remove some headers we don't need
+    partResponse->setConnectionType(rest::ConnectionType::C_NONE);
+    partResponse->setHeaderNC(StaticStrings::Server, "");
 
-    // we've read the last part
-    if (!helper.containsMore) {
-      break;
-    }
+    // append the part response header
+    partResponse->writeHeader(&httpResponse->body());
+
+    // append the part response body
+    httpResponse->body().appendText(partResponse->body());
+    httpResponse->body().appendText(TRI_CHAR_LENGTH_PAIR("\r\n"));
   }
 
   // append final boundary + "--"
@@ -284,6 +318,77 @@ RestStatus RestBatchHandler::executeHttp() {
   return RestStatus::DONE;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief run the handlers of all parts. with a parallelism of more than 1,
+/// up to that many parts are executed concurrently on the scheduler, and
+/// the calling thread waits until all of them are finished
+////////////////////////////////////////////////////////////////////////////////
+
+void RestBatchHandler::executeParts(
+    std::vector<std::pair<std::shared_ptr<RestHandler>, std::string>>& parts,
+    size_t parallelism) {
+  auto runPart = [&parts](size_t i) {
+    // ignore any errors here, will be handled later by inspecting the
+    // response
+    try {
+      parts[i].first->syncRunEngine();
+    } catch (...) {
+    }
+  };
+
+  if ((std::min)(parallelism, parts.size()) <= 1 ||
+      SchedulerFeature::SCHEDULER == nullptr) {
+    runParts(nullptr, parts.size(), 1, runPart);
+    return;
+  }
+
+  // we are going to wait for other scheduler threads
+  JobGuard guard(SchedulerFeature::SCHEDULER);
+  guard.block();
+
+  runParts(SchedulerFeature::SCHEDULER->ioService(), parts.size(), parallelism,
+           runPart);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief call run for all part indexes, up to parallelism of them
+/// concurrently on the io_service
+////////////////////////////////////////////////////////////////////////////////
+
+void RestBatchHandler::runParts(boost::asio::io_service* ioService,
+                                size_t count, size_t parallelism,
+                                std::function<void(size_t)> const& run) {
+  parallelism = (std::min)(parallelism, count);
+
+  if (parallelism <= 1 || ioService == nullptr) {
+    for (size_t i = 0; i < count; ++i) {
+      run(i);
+    }
+    return;
+  }
+
+  // every worker picks the next part that nobody has started yet
+  std::atomic<size_t> next(0);
+
+  auto worker = [count, &next, &run]() {
+    while (true) {
+      size_t const i = next.fetch_add(1);
+      if (i >= count) {
+        break;
+      }
+      run(i);
+    }
+  };
+
+  basics::LocalTaskQueue queue(ioService);
+
+  for (size_t i = 0; i < parallelism; ++i) {
+    queue.enqueue(std::make_shared<BatchPartTask>(&queue, worker));
+  }
+
+  queue.dispatchAndWait();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief extract the boundary from the body of a multipart message
 ////////////////////////////////////////////////////////////////////////////////
@@ -25,6 +25,7 @@
 #define ARANGOD_REST_HANDLER_REST_BATCH_HANDLER_H 1
 
 #include "Basics/Common.h"
+#include "Basics/asio-helper.h"
 #include "RestHandler/RestVocbaseBaseHandler.h"
 
 namespace arangodb {
@@ -56,6 +57,9 @@ struct SearchHelper {
 };
 
 class RestBatchHandler : public RestVocbaseBaseHandler {
+ public:
+  static size_t const MaxParallelism;
+
  public:
   RestBatchHandler(GeneralRequest*, GeneralResponse*);
   ~RestBatchHandler();
@@ -64,9 +68,22 @@ class RestBatchHandler : public RestVocbaseBaseHandler {
   RestStatus execute() override;
   char const* name() const override final { return "RestBatchHandler"; }
 
+  // call run for the indexes 0 to count - 1. with an io_service and a
+  // parallelism of more than 1, up to that many calls run concurrently on
+  // the io_service, in any order. returns when all calls are finished
+  static void runParts(boost::asio::io_service*, size_t count,
+                       size_t parallelism,
+                       std::function<void(size_t)> const& run);
+
  private:
   RestStatus executeHttp();
   RestStatus executeVpp();
+
+  // run the handlers of all parts, up to parallelism of them concurrently
+  void executeParts(
+      std::vector<std::pair<std::shared_ptr<RestHandler>, std::string>>&,
+      size_t parallelism);
+
   // extract the boundary from the body of a multipart message
   bool getBoundaryBody(std::string*);
 
@@ -22,11 +22,13 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "RestCursorHandler.h"
+#include "Aql/PlanCache.h"
 #include "Aql/Query.h"
 #include "Aql/QueryRegistry.h"
 #include "Basics/Exceptions.h"
 #include "Basics/MutexLocker.h"
 #include "Basics/StaticStrings.h"
+#include "Basics/StringUtils.h"
 #include "Basics/VelocyPackDumper.h"
 #include "Basics/VelocyPackHelper.h"
 #include "Utils/Cursor.h"
@@ -90,7 +92,22 @@ void RestCursorHandler::processQuery(VPackSlice const& slice) {
     return;
   }
   VPackSlice const querySlice = slice.get("query");
-  if (!querySlice.isString()) {
+  VPackSlice const preparedSlice = slice.get("preparedQuery");
+
+  // the query string of a prepared query
+  std::string preparedQueryString;
+
+  if (preparedSlice.isString()) {
+    std::string const id = preparedSlice.copyString();
+
+    if (!arangodb::aql::PlanCache::instance()->preparedQuery(
+            _vocbase, arangodb::basics::StringUtils::uint64(id),
+            preparedQueryString)) {
+      generateError(rest::ResponseCode::NOT_FOUND, TRI_ERROR_QUERY_NOT_FOUND,
+                    "cannot find prepared query '" + id + "'");
+      return;
+    }
+  } else if (!querySlice.isString()) {
     generateError(rest::ResponseCode::BAD, TRI_ERROR_QUERY_EMPTY);
     return;
   }
@@ -111,8 +128,24 @@ void RestCursorHandler::processQuery(VPackSlice const& slice) {
   }
 
   auto options = std::make_shared<VPackBuilder>(buildOptions(slice));
+
+  if (arangodb::basics::VelocyPackHelper::getBooleanValue(
+          options->slice(), "stream", false)) {
+    processStreamingQuery(preparedSlice.isString() ? preparedQueryString
+                                                   : querySlice.copyString(),
+                          bindVarsBuilder, options);
+    return;
+  }
+
   VPackValueLength l;
-  char const* queryString = querySlice.getString(l);
+  char const* queryString;
+
+  if (preparedSlice.isString()) {
+    queryString = preparedQueryString.c_str();
+    l = preparedQueryString.size();
+  } else {
+    queryString = querySlice.getString(l);
+  }
 
   arangodb::aql::Query query(false, _vocbase, queryString,
                              static_cast<size_t>(l), bindVarsBuilder, options,
@@ -234,6 +267,51 @@ void RestCursorHandler::processQuery(VPackSlice const& slice) {
   }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief creates a streaming cursor for the query and returns its first
+/// results
+////////////////////////////////////////////////////////////////////////////////
+
+void RestCursorHandler::processStreamingQuery(
+    std::string const& queryString, std::shared_ptr<VPackBuilder> bindVars,
+    std::shared_ptr<VPackBuilder> options) {
+  VPackSlice opts = options->slice();
+
+  size_t batchSize =
+      arangodb::basics::VelocyPackHelper::getNumericValue<size_t>(
+          opts, "batchSize", 1000);
+  double ttl = arangodb::basics::VelocyPackHelper::getNumericValue<double>(
+      opts, "ttl", 30);
+
+  auto cursors = _vocbase->cursorRepository();
+  TRI_ASSERT(cursors != nullptr);
+
+  // the cursor owns the query. the query is only prepared here, and
+  // executed batch-wise when the results are dumped
+  arangodb::QueryStreamCursor* cursor = cursors->createQueryStream(
+      queryString, bindVars, options, batchSize, ttl, _queryRegistry);
+
+  try {
+    resetResponse(rest::ResponseCode::CREATED);
+
+    VPackBuilder result;
+    result.openObject();
+    result.add("error", VPackValue(false));
+    result.add("code", VPackValue((int)_response->responseCode()));
+    cursor->dump(result);
+    result.close();
+
+    _response->setContentType(rest::ContentType::JSON);
+    generateResult(_response->responseCode(), result.slice(),
+                   cursor->context());
+
+    cursors->release(cursor);
+  } catch (...) {
+    cursors->release(cursor);
+    throw;
+  }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief register the currently running query
 ////////////////////////////////////////////////////////////////////////////////
@@ -320,6 +398,12 @@ VPackBuilder RestCursorHandler::buildOptions(VPackSlice const& slice) const {
     options.add("memoryLimit", memoryLimit);
   }
 
+  // plans of prepared queries are reused
+  bool const isPrepared = slice.get("preparedQuery").isString();
+  if (isPrepared) {
+    options.add("reusePlan", VPackValue(true));
+  }
+
   bool hasCache = false;
   VPackSlice cache = slice.get("cache");
   if (cache.isBool()) {
@@ -336,7 +420,8 @@ VPackBuilder RestCursorHandler::buildOptions(VPackSlice const& slice) const {
       std::string keyName = it.key.copyString();
 
       if (keyName != "count" && keyName != "batchSize") {
-        if (keyName == "cache" && hasCache) {
+        if ((keyName == "cache" && hasCache) ||
+            (keyName == "reusePlan" && isPrepared)) {
           continue;
         }
         options.add(keyName, it.value);
@@ -470,7 +555,7 @@ void RestCursorHandler::modifyCursor() {
 
     _response->setContentType(rest::ContentType::JSON);
     generateResult(rest::ResponseCode::OK, builder.slice(),
-                     static_cast<VelocyPackCursor*>(cursor)->result()->context);
+                   cursor->context());
 
     cursors->release(cursor);
   } catch (...) {
@@ -73,6 +73,15 @@ class RestCursorHandler : public RestVocbaseBaseHandler {
   void processQuery(arangodb::velocypack::Slice const&);
 
  private:
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief creates a streaming cursor for the query and returns its first
+  /// results. the query produces further results only when they are requested
+  //////////////////////////////////////////////////////////////////////////////
+
+  void processStreamingQuery(
+      std::string const&, std::shared_ptr<arangodb::velocypack::Builder>,
+      std::shared_ptr<arangodb::velocypack::Builder>);
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief register the currently running query
   //////////////////////////////////////////////////////////////////////////////
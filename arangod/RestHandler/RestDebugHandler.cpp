@@ -23,7 +23,12 @@
 
 #include "RestDebugHandler.h"
 
+#include "Basics/CpuProfiler.h"
+#include "Basics/StringUtils.h"
 #include "Rest/HttpRequest.h"
+#include "Rest/HttpResponse.h"
+
+#include <thread>
 
 using namespace arangodb;
 using namespace arangodb::basics;
@@ -41,6 +46,16 @@ RestStatus RestDebugHandler::execute() {
   std::vector<std::string> const& suffixes = _request->decodedSuffixes();
   size_t const len = suffixes.size();
 
+  if (len == 1 && suffixes[0] == "profile") {
+    if (type != rest::RequestType::GET) {
+      generateError(rest::ResponseCode::METHOD_NOT_ALLOWED,
+                    TRI_ERROR_HTTP_METHOD_NOT_ALLOWED);
+      return RestStatus::DONE;
+    }
+    return profile();
+  }
+
+#ifdef ARANGODB_ENABLE_FAILURE_TESTS
   if (len == 0 || len > 2 || suffixes[0] != "failat") {
     generateNotImplemented("ILLEGAL /_admin/debug/failat");
     return RestStatus::DONE;
@@ -73,5 +88,79 @@ RestStatus RestDebugHandler::execute() {
   } catch (...) {
     // Ignore this error
   }
+#else
+  generateNotImplemented("ILLEGAL /_admin/debug/failat");
+#endif
   return RestStatus::DONE;
 }
+
+/// @brief GET /_admin/debug/profile?seconds=...&frequency=...
+RestStatus RestDebugHandler::profile() {
+  // folded stacks are plain text, which can only be sent via HTTP
+  auto response = dynamic_cast<HttpResponse*>(_response.get());
+
+  if (response == nullptr) {
+    generateError(rest::ResponseCode::NOT_IMPLEMENTED,
+                  TRI_ERROR_NOT_IMPLEMENTED,
+                  "profiles are only available via HTTP");
+    return RestStatus::DONE;
+  }
+
+  double seconds = 10.0;
+  uint64_t frequency = 99;
+  bool found;
+
+  std::string const& s = _request->value("seconds", found);
+  if (found) {
+    seconds = StringUtils::doubleDecimal(s);
+  }
+  std::string const& f = _request->value("frequency", found);
+  if (found) {
+    frequency = StringUtils::uint64(f);
+  }
+
+  // a profile blocks for its whole duration, which must not occupy a
+  // scheduler thread
+  std::shared_ptr<RestHandler> self = shared_from_this();
+
+  return RestStatus::WAIT_FOR([self, this, seconds, frequency](
+                                  std::function<void()> next) {
+           std::thread([self, this, seconds, frequency, next]() {
+             try {
+               generateProfile(seconds, frequency);
+             } catch (std::exception const& ex) {
+               generateError(rest::ResponseCode::SERVER_ERROR,
+                             TRI_ERROR_INTERNAL, ex.what());
+             } catch (...) {
+               generateError(rest::ResponseCode::SERVER_ERROR,
+                             TRI_ERROR_INTERNAL);
+             }
+             next();
+           }).detach();
+         }).done();
+}
+
+void RestDebugHandler::generateProfile(double seconds, uint64_t frequency) {
+  std::string result;
+  int res = CpuProfiler::profile(seconds, frequency, result);
+
+  if (res == TRI_ERROR_LOCKED) {
+    // only one profile can be taken at a time
+    generateError(rest::ResponseCode::CONFLICT, res);
+    return;
+  }
+  if (res == TRI_ERROR_NOT_IMPLEMENTED) {
+    generateError(rest::ResponseCode::NOT_IMPLEMENTED, res);
+    return;
+  }
+  if (res != TRI_ERROR_NO_ERROR) {
+    generateError(GeneralResponse::responseCode(res), res);
+    return;
+  }
+
+  resetResponse(rest::ResponseCode::OK);
+  auto response = dynamic_cast<HttpResponse*>(_response.get());
+  TRI_ASSERT(response != nullptr);
+  response->setContentType("text/plain");
+  response->body().appendText(result);
+}
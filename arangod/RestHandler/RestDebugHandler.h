@@ -35,6 +35,14 @@ class RestDebugHandler : public arangodb::RestVocbaseBaseHandler {
   char const* name() const override final { return "RestDebugHandler"; }
   bool isDirect() const override;
   RestStatus execute() override;
+
+ private:
+  /// @brief take a CPU profile on a thread of its own, and return it as
+  /// folded stacks
+  RestStatus profile();
+
+  /// @brief take the profile and generate the response
+  void generateProfile(double seconds, uint64_t frequency);
 };
 }
 
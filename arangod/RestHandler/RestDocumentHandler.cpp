@@ -120,7 +120,7 @@ bool RestDocumentHandler::createDocument() {
   opOptions.silent = extractBooleanParameter(StaticStrings::SilentString, false);
 
   // find and load collection given by name or identifier
-  auto transactionContext(transaction::StandaloneContext::Create(_vocbase));
+  auto transactionContext(transaction::StandaloneContext::CreateRecycled(_vocbase));
   SingleCollectionTransaction trx(transactionContext, collectionName,
                                   AccessMode::Type::WRITE);
   bool const isMultiple = body.isArray();
@@ -208,6 +208,7 @@ bool RestDocumentHandler::readSingleDocument(bool generateBody) {
 
   OperationOptions options;
   options.ignoreRevs = true;
+  extractDirtyReadOptions(options);
 
   TRI_voc_rid_t ifRid =
       extractRevision("if-match", isValidRevision);
@@ -227,10 +228,12 @@ bool RestDocumentHandler::readSingleDocument(bool generateBody) {
   VPackSlice search = builder.slice();
 
   // find and load collection given by name or identifier
-  auto transactionContext(transaction::StandaloneContext::Create(_vocbase));
+  auto transactionContext(transaction::StandaloneContext::CreateRecycled(_vocbase));
   SingleCollectionTransaction trx(transactionContext, collection,
                                   AccessMode::Type::READ);
   trx.addHint(transaction::Hints::Hint::SINGLE_OPERATION);
+  // read from a snapshot if the storage engine supports it
+  trx.addHint(transaction::Hints::Hint::SNAPSHOT);
 
   // ...........................................................................
   // inside read transaction
@@ -414,7 +417,7 @@ bool RestDocumentHandler::modifyDocument(bool isPatch) {
   }
 
   // find and load collection given by name or identifier
-  auto transactionContext(transaction::StandaloneContext::Create(_vocbase));
+  auto transactionContext(transaction::StandaloneContext::CreateRecycled(_vocbase));
   SingleCollectionTransaction trx(transactionContext, collectionName,
                                   AccessMode::Type::WRITE);
   if (!isArrayCase) {
@@ -503,7 +506,7 @@ bool RestDocumentHandler::deleteDocument() {
   opOptions.waitForSync = extractBooleanParameter(StaticStrings::WaitForSyncString, false);
   opOptions.silent = extractBooleanParameter(StaticStrings::SilentString, false);
 
-  auto transactionContext(transaction::StandaloneContext::Create(_vocbase));
+  auto transactionContext(transaction::StandaloneContext::CreateRecycled(_vocbase));
 
   VPackBuilder builder;
   VPackSlice search;
@@ -573,6 +576,32 @@ bool RestDocumentHandler::deleteDocument() {
   return true;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief reads the dirty read headers. with x-arango-allow-dirty-read, a
+/// coordinator may read from in-sync followers. x-arango-max-staleness
+/// additionally bounds the time since a follower applied an operation of
+/// its leader
+////////////////////////////////////////////////////////////////////////////////
+
+void RestDocumentHandler::extractDirtyReadOptions(OperationOptions& options) {
+  bool found;
+  std::string const& dirty =
+      _request->header(StaticStrings::AllowDirtyReads, found);
+
+  if (!found || !StringUtils::boolean(dirty)) {
+    return;
+  }
+
+  options.allowDirtyReads = true;
+
+  std::string const& staleness =
+      _request->header(StaticStrings::MaxStaleness, found);
+
+  if (found) {
+    options.maxStaleness = StringUtils::doubleDecimal(staleness);
+  }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief was docuBlock REST_DOCUMENT_READ_MANY
 ////////////////////////////////////////////////////////////////////////////////
@@ -592,10 +621,14 @@ bool RestDocumentHandler::readManyDocuments() {
 
   OperationOptions opOptions;
   opOptions.ignoreRevs = extractBooleanParameter(StaticStrings::IgnoreRevsString, true);
+  extractDirtyReadOptions(opOptions);
 
-  auto transactionContext(transaction::StandaloneContext::Create(_vocbase));
+  auto transactionContext(transaction::StandaloneContext::CreateRecycled(_vocbase));
   SingleCollectionTransaction trx(transactionContext, collectionName,
                                   AccessMode::Type::READ);
+  // read all documents from the same snapshot if the storage engine
+  // supports it
+  trx.addHint(transaction::Hints::Hint::SNAPSHOT);
 
   // ...........................................................................
   // inside read transaction
@@ -28,6 +28,8 @@
 #include "RestHandler/RestVocbaseBaseHandler.h"
 
 namespace arangodb {
+struct OperationOptions;
+
 class RestDocumentHandler : public RestVocbaseBaseHandler {
  public:
   RestDocumentHandler(GeneralRequest*, GeneralResponse*);
@@ -60,6 +62,9 @@ class RestDocumentHandler : public RestVocbaseBaseHandler {
   // reads a single document head
   bool checkDocument();
 
+  // reads the dirty read headers into the options for a read
+  void extractDirtyReadOptions(OperationOptions& options);
+
   // replaces a document
   bool replaceDocument();
 
@@ -26,16 +26,19 @@
 #include "Aql/Graphs.h"
 #include "Aql/Variable.h"
 #include "Basics/ScopeGuard.h"
+#include "Basics/StringUtils.h"
 #include "Cluster/ClusterMethods.h"
 #include "Utils/CollectionNameResolver.h"
 #include "Utils/OperationCursor.h"
 #include "Utils/SingleCollectionTransaction.h"
+#include "Transaction/Helpers.h"
 #include "Transaction/StandaloneContext.h"
 
 #include <velocypack/Iterator.h>
 #include <velocypack/velocypack-aliases.h>
 
 using namespace arangodb;
+using namespace arangodb::basics;
 using namespace arangodb::rest;
 
 RestEdgesHandler::RestEdgesHandler(GeneralRequest* request,
@@ -66,7 +69,8 @@ RestStatus RestEdgesHandler::execute() {
 void RestEdgesHandler::readCursor(
     aql::AstNode* condition, aql::Variable const* var,
     std::string const& collectionName, SingleCollectionTransaction& trx,
-    std::function<void(DocumentIdentifierToken const&)> cb) {
+    std::function<void(DocumentIdentifierToken const&)> cb,
+    std::function<bool()> const& done) {
   transaction::Methods::IndexHandle indexId;
   bool foundIdx = trx.getBestIndexHandleForFilterCondition(
       collectionName, condition, var, 1000, indexId);
@@ -87,7 +91,7 @@ void RestEdgesHandler::readCursor(
     THROW_ARANGO_EXCEPTION(cursor->code);
   }
 
-  while (cursor->getMore(cb, 1000)) {
+  while ((!done || !done()) && cursor->getMore(cb, 1000)) {
   }
 }
 
@@ -199,7 +203,30 @@ bool RestEdgesHandler::readEdges() {
     return false;
   }
 
+  // optional pagination: skip the first <offset> edges and return at most
+  // <limit> edges (0 = all). the order of edges is stable as long as the
+  // edges of the vertex are not modified
+  uint64_t const offset = StringUtils::uint64(_request->value("offset"));
+  uint64_t const limit = StringUtils::uint64(_request->value("limit"));
+
+  // optional projection: only return the given attributes of the edges
+  std::unordered_set<std::string> attributes;
+  for (auto const& it :
+       StringUtils::split(_request->value("attributes"), ',')) {
+    std::string const attribute = StringUtils::trim(it);
+    if (!attribute.empty()) {
+      attributes.emplace(attribute);
+    }
+  }
+
   if (ServerState::instance()->isCoordinator()) {
+    if (offset > 0 || limit > 0 || !attributes.empty()) {
+      generateError(rest::ResponseCode::BAD, TRI_ERROR_HTTP_BAD_PARAMETER,
+                    "<offset>, <limit> and <attributes> are not supported "
+                    "on a coordinator");
+      return false;
+    }
+
     std::string vertexString(startVertex);
     rest::ResponseCode responseCode;
     VPackBuilder resultDocument;
@@ -248,27 +275,78 @@ bool RestEdgesHandler::readEdges() {
 
   auto collection = trx.documentCollection();
   ManagedDocumentResult mmdr;
-  std::unordered_set<DocumentIdentifierToken> foundTokens;
+
+  // number of matching edges seen so far, including skipped ones
+  uint64_t position = 0;
+  bool hasMore = false;
+  // with direction "any", edges from the vertex to itself are found by
+  // both the inbound and the outbound lookup. they are only returned by
+  // the inbound one
+  bool skipSelfLoops = false;
+
   auto cb = [&] (DocumentIdentifierToken const& token) {
-    if (foundTokens.find(token) == foundTokens.end()) {
-      if (collection->readDocument(&trx, token, mmdr)) {
-        resultBuilder.add(VPackSlice(mmdr.vpack()));
+    if (hasMore || !collection->readDocument(&trx, token, mmdr)) {
+      return;
+    }
+
+    VPackSlice edge(mmdr.vpack());
+
+    if (skipSelfLoops &&
+        transaction::helpers::extractToFromDocument(edge).isEqualString(
+            startVertex)) {
+      return;
+    }
+
+    scannedIndex++;
+
+    if (limit > 0 && position >= offset + limit) {
+      // there is at least one more edge than requested
+      hasMore = true;
+      return;
+    }
+
+    if (position++ < offset) {
+      return;
+    }
+
+    if (attributes.empty()) {
+      resultBuilder.add(edge);
+      return;
+    }
+
+    resultBuilder.openObject();
+    for (auto const& it : VPackObjectIterator(edge, true)) {
+      // attribute names of stored documents may be translated
+      std::string key = it.key.makeKey().copyString();
+      if (attributes.find(key) != attributes.end()) {
+        resultBuilder.add(key, it.value);
       }
-      scannedIndex++;
-      // Mark edges we find
-      foundTokens.emplace(token);
     }
+    resultBuilder.close();
   };
 
+  auto done = [&hasMore]() { return hasMore; };
+
   // NOTE: collectionName is the shard-name in DBServer case
-  bool ok = getEdgesForVertex(startVertex, collectionName, direction, trx, cb);
+  trx.pinData(trx.cid());  // will throw when it fails
+
+  // Create a conditionBuilder that manages the AstNodes for querying
+  aql::EdgeConditionBuilderContainer condBuilder;
+  condBuilder.setVertexId(startVertex);
+  aql::Variable const* var = condBuilder.getVariable();
+
+  if (direction != TRI_EDGE_OUT) {
+    readCursor(condBuilder.getInboundCondition(), var, collectionName, trx,
+               cb, done);
+  }
+  if (direction != TRI_EDGE_IN) {
+    skipSelfLoops = (direction == TRI_EDGE_ANY);
+    readCursor(condBuilder.getOutboundCondition(), var, collectionName, trx,
+               cb, done);
+  }
   resultBuilder.close();
 
   res = trx.finish(res);
-  if (!ok) {
-    // Error has been built internally
-    return false;
-  }
 
   if (res != TRI_ERROR_NO_ERROR) {
     if (ServerState::instance()->isDBServer()) {
@@ -280,6 +358,9 @@ bool RestEdgesHandler::readEdges() {
     return false;
   }
 
+  if (limit > 0) {
+    resultBuilder.add("hasMore", VPackValue(hasMore));
+  }
   resultBuilder.add("error", VPackValue(false));
   resultBuilder.add("code", VPackValue(200));
   resultBuilder.add("stats", VPackValue(VPackValueType::Object));
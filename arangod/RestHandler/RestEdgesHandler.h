@@ -60,13 +60,15 @@ class RestEdgesHandler : public RestVocbaseBaseHandler {
   bool readEdgesForMultipleVertices();
 
   //////////////////////////////////////////////////////////////////////////////
-  /// @brief find the index and read it completely with the given callback
+  /// @brief find the index and read it with the given callback, until it is
+  /// exhausted or done returns true
   //////////////////////////////////////////////////////////////////////////////
 
   void readCursor(aql::AstNode* condition, aql::Variable const* var,
                   std::string const& collectionName,
                   SingleCollectionTransaction& trx,
-                  std::function<void(DocumentIdentifierToken const&)> cb);
+                  std::function<void(DocumentIdentifierToken const&)> cb,
+                  std::function<bool()> const& done = nullptr);
 
   //////////////////////////////////////////////////////////////////////////////
   /// @brief get all edges for a given vertex. Independent from the request
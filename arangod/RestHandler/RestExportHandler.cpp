@@ -122,6 +122,13 @@ VPackBuilder RestExportHandler::buildOptions(VPackSlice const& slice) {
     options.add("ttl", VPackValue(30));
   }
 
+  VPackSlice stream = slice.get("stream");
+  if (stream.isBool()) {
+    options.add("stream", stream);
+  } else {
+    options.add("stream", VPackValue(false));
+  }
+
   VPackSlice flushWait = slice.get("flushWait");
   if (flushWait.isNumber()) {
     options.add("flushWait", flushWait);
@@ -247,10 +254,19 @@ void RestExportHandler::createCursor() {
   size_t limit = arangodb::basics::VelocyPackHelper::getNumericValue<size_t>(
       options, "limit", 0);
 
+  bool stream = arangodb::basics::VelocyPackHelper::getBooleanValue(
+      options, "stream", false);
+
   // this may throw!
   auto collectionExport =
       std::make_unique<CollectionExport>(_vocbase, name, _restrictions);
-  collectionExport->run(waitTime, limit);
+  if (stream) {
+    // read the documents batch by batch instead of collecting all of
+    // them before the first batch is returned
+    collectionExport->runStreaming(waitTime, limit);
+  } else {
+    collectionExport->run(waitTime, limit);
+  }
 
   size_t batchSize =
       arangodb::basics::VelocyPackHelper::getNumericValue<size_t>(
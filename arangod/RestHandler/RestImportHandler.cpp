@@ -45,6 +45,9 @@ using namespace arangodb;
 using namespace arangodb::basics;
 using namespace arangodb::rest;
 
+/// @brief number of documents inserted with a single operation
+static size_t const BatchSize = 1000;
+
 RestImportHandler::RestImportHandler(GeneralRequest* request,
                                      GeneralResponse* response)
     : RestVocbaseBaseHandler(request, response),
@@ -381,8 +384,7 @@ bool RestImportHandler::createFromJson(std::string const& type) {
     // Ignore the result ...
   }
 
-  VPackBuilder babies;
-  babies.openArray();
+  RestImportBatch babies(BatchSize);
 
   if (linewise) {
     // http required here
@@ -456,8 +458,8 @@ bool RestImportHandler::createFromJson(std::string const& type) {
         continue;
       }
 
-      res = handleSingleDocument(trx, result, babies, builder->slice(),
-                                 isEdgeCollection, i);
+      res = handleSingleDocument(trx, result, babies.builder(),
+                                 builder->slice(), isEdgeCollection, i);
 
       if (res != TRI_ERROR_NO_ERROR) {
         if (complete) {
@@ -466,6 +468,12 @@ bool RestImportHandler::createFromJson(std::string const& type) {
         }
 
         res = TRI_ERROR_NO_ERROR;
+      } else if (babies.added()) {
+        res = performBatch(trx, result, collectionName, babies, complete,
+                           opOptions);
+        if (res != TRI_ERROR_NO_ERROR) {
+          break;
+        }
       }
     }
   }
@@ -496,8 +504,8 @@ bool RestImportHandler::createFromJson(std::string const& type) {
     for (VPackValueLength i = 0; i < n; ++i) {
       VPackSlice const slice = documents.at(i);
 
-      res = handleSingleDocument(trx, result, babies, slice, isEdgeCollection,
-                                 static_cast<size_t>(i + 1));
+      res = handleSingleDocument(trx, result, babies.builder(), slice,
+                                 isEdgeCollection, static_cast<size_t>(i + 1));
 
       if (res != TRI_ERROR_NO_ERROR) {
         if (complete) {
@@ -506,6 +514,12 @@ bool RestImportHandler::createFromJson(std::string const& type) {
         }
 
         res = TRI_ERROR_NO_ERROR;
+      } else if (babies.added()) {
+        res = performBatch(trx, result, collectionName, babies, complete,
+                           opOptions);
+        if (res != TRI_ERROR_NO_ERROR) {
+          break;
+        }
       }
     }
   }
@@ -514,8 +528,8 @@ bool RestImportHandler::createFromJson(std::string const& type) {
 
   if (res == TRI_ERROR_NO_ERROR) {
     // no error so far. go on and perform the actual insert
-    res =
-        performImport(trx, result, collectionName, babies, complete, opOptions);
+    res = performImport(trx, result, collectionName, babies.builder(),
+                        babies.offset(), complete, opOptions);
   }
 
   res = trx.finish(res);
@@ -585,8 +599,7 @@ bool RestImportHandler::createFromVPack(std::string const& type) {
     // Ignore the result ...
   }
 
-  VPackBuilder babies;
-  babies.openArray();
+  RestImportBatch babies(BatchSize);
 
   VPackSlice const documents = _request->payload();
 
@@ -601,8 +614,8 @@ bool RestImportHandler::createFromVPack(std::string const& type) {
   for (VPackValueLength i = 0; i < n; ++i) {
     VPackSlice const slice = documents.at(i);
 
-    res = handleSingleDocument(trx, result, babies, slice, isEdgeCollection,
-                               static_cast<size_t>(i + 1));
+    res = handleSingleDocument(trx, result, babies.builder(), slice,
+                               isEdgeCollection, static_cast<size_t>(i + 1));
 
     if (res != TRI_ERROR_NO_ERROR) {
       if (complete) {
@@ -611,6 +624,12 @@ bool RestImportHandler::createFromVPack(std::string const& type) {
       }
 
       res = TRI_ERROR_NO_ERROR;
+    } else if (babies.added()) {
+      res = performBatch(trx, result, collectionName, babies, complete,
+                         opOptions);
+      if (res != TRI_ERROR_NO_ERROR) {
+        break;
+      }
     }
   }
 
@@ -618,8 +637,8 @@ bool RestImportHandler::createFromVPack(std::string const& type) {
 
   if (res == TRI_ERROR_NO_ERROR) {
     // no error so far. go on and perform the actual insert
-    res =
-        performImport(trx, result, collectionName, babies, complete, opOptions);
+    res = performImport(trx, result, collectionName, babies.builder(),
+                        babies.offset(), complete, opOptions);
   }
 
   res = trx.finish(res);
@@ -761,8 +780,7 @@ bool RestImportHandler::createFromKeyValueList() {
     // Ignore the result ...
   }
 
-  VPackBuilder babies;
-  babies.openArray();
+  RestImportBatch babies(BatchSize);
 
   size_t i = static_cast<size_t>(lineNumber);
 
@@ -818,8 +836,8 @@ bool RestImportHandler::createFromKeyValueList() {
       try {
         std::shared_ptr<VPackBuilder> objectBuilder =
             createVelocyPackObject(keys, values, errorMsg, i);
-        res = handleSingleDocument(trx, result, babies, objectBuilder->slice(),
-                                   isEdgeCollection, i);
+        res = handleSingleDocument(trx, result, babies.builder(),
+                                   objectBuilder->slice(), isEdgeCollection, i);
       } catch (...) {
         // raise any error
         res = TRI_ERROR_INTERNAL;
@@ -834,6 +852,12 @@ bool RestImportHandler::createFromKeyValueList() {
       }
 
       res = TRI_ERROR_NO_ERROR;
+    } else if (babies.added()) {
+      res = performBatch(trx, result, collectionName, babies, complete,
+                         opOptions);
+      if (res != TRI_ERROR_NO_ERROR) {
+        break;
+      }
     }
   }
 
@@ -841,8 +865,8 @@ bool RestImportHandler::createFromKeyValueList() {
 
   if (res == TRI_ERROR_NO_ERROR) {
     // no error so far. go on and perform the actual insert
-    res =
-        performImport(trx, result, collectionName, babies, complete, opOptions);
+    res = performImport(trx, result, collectionName, babies.builder(),
+                        babies.offset(), complete, opOptions);
   }
 
   res = trx.finish(res);
@@ -862,10 +886,12 @@ bool RestImportHandler::createFromKeyValueList() {
 int RestImportHandler::performImport(SingleCollectionTransaction& trx,
                                      RestImportResult& result,
                                      std::string const& collectionName,
-                                     VPackBuilder const& babies, bool complete,
+                                     VPackBuilder const& babies, size_t offset,
+                                     bool complete,
                                      OperationOptions const& opOptions) {
   auto makeError = [&](size_t i, int res, VPackSlice const& slice,
                        RestImportResult& result) {
+    i += offset;
     VPackOptions options(VPackOptions::Defaults);
     options.escapeUnicode = false;
     std::string part = VPackDumper::toString(slice, &options);
@@ -987,6 +1013,22 @@ int RestImportHandler::performImport(SingleCollectionTransaction& trx,
   return res;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief import the documents collected so far and start a new batch
+////////////////////////////////////////////////////////////////////////////////
+
+int RestImportHandler::performBatch(SingleCollectionTransaction& trx,
+                                    RestImportResult& result,
+                                    std::string const& collectionName,
+                                    RestImportBatch& babies, bool complete,
+                                    OperationOptions const& opOptions) {
+  int res = performImport(trx, result, collectionName, babies.close(),
+                          babies.offset(), complete, opOptions);
+  babies.next();
+
+  return res;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief create response for number of documents created / failed
 ////////////////////////////////////////////////////////////////////////////////
@@ -56,6 +56,50 @@ struct RestImportResult {
   std::vector<std::string> _errors;
 };
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief documents of an import request that are inserted together. the
+/// documents of a request are inserted in batches so that the copies of the
+/// documents need not be held for the whole request
+////////////////////////////////////////////////////////////////////////////////
+
+class RestImportBatch {
+ public:
+  explicit RestImportBatch(size_t maxLength)
+      : _maxLength(maxLength), _length(0), _offset(0) {
+    _builder.openArray();
+  }
+
+  /// @brief the builder that documents are added to
+  VPackBuilder& builder() { return _builder; }
+
+  /// @brief counts a document that was added to the builder, and returns
+  /// whether the batch is full
+  bool added() { return ++_length >= _maxLength; }
+
+  /// @brief closes the batch, so that its documents can be inserted
+  VPackBuilder const& close() {
+    _builder.close();
+    return _builder;
+  }
+
+  /// @brief number of documents inserted in earlier batches
+  size_t offset() const { return _offset; }
+
+  /// @brief starts a new batch after the documents were inserted
+  void next() {
+    _offset += _length;
+    _length = 0;
+    _builder.clear();
+    _builder.openArray();
+  }
+
+ private:
+  VPackBuilder _builder;
+  size_t const _maxLength;
+  size_t _length;
+  size_t _offset;
+};
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief import request handler
 ////////////////////////////////////////////////////////////////////////////////
@@ -128,9 +172,17 @@ class RestImportHandler : public RestVocbaseBaseHandler {
 
   int performImport(SingleCollectionTransaction& trx, RestImportResult& result,
                     std::string const& collectionName,
-                    VPackBuilder const& babies, bool complete,
+                    VPackBuilder const& babies, size_t offset, bool complete,
                     OperationOptions const& opOptions);
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief import the documents collected so far and start a new batch
+  //////////////////////////////////////////////////////////////////////////////
+
+  int performBatch(SingleCollectionTransaction& trx, RestImportResult& result,
+                   std::string const& collectionName, RestImportBatch& babies,
+                   bool complete, OperationOptions const& opOptions);
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief creates the result
   //////////////////////////////////////////////////////////////////////////////
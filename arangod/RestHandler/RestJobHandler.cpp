@@ -94,7 +94,14 @@ void RestJobHandler::putJob() {
   TRI_ASSERT(status == AsyncJobResult::JOB_DONE);
   TRI_ASSERT(response != nullptr);
 
-  // return the original response
+  // return the original response, but keep the message id of this request,
+  // as it determines the order of responses on the connection
+  HttpResponse* httpResponse = dynamic_cast<HttpResponse*>(response);
+
+  if (httpResponse != nullptr) {
+    httpResponse->setMessageId(_response->messageId());
+  }
+
   _response.reset(response);
 
   // plus a new header
@@ -0,0 +1,133 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "RestMemoryHandler.h"
+
+#include "Basics/FileUtils.h"
+#include "Basics/MemoryArenas.h"
+#include "Basics/files.h"
+#include "Rest/HttpResponse.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+using namespace arangodb::basics;
+using namespace arangodb::rest;
+
+RestMemoryHandler::RestMemoryHandler(GeneralRequest* request,
+                                     GeneralResponse* response)
+    : RestBaseHandler(request, response) {}
+
+bool RestMemoryHandler::isDirect() const {
+  // a profile dump writes and reads a file
+  return _request->suffixes().empty();
+}
+
+RestStatus RestMemoryHandler::execute() {
+  std::vector<std::string> const& suffixes = _request->suffixes();
+  auto const type = _request->requestType();
+
+  if (suffixes.empty() && type == rest::RequestType::GET) {
+    reportStatistics();
+  } else if (suffixes.size() == 1 && suffixes[0] == "profile" &&
+             type == rest::RequestType::PUT) {
+    dumpProfile();
+  } else if (suffixes.size() > 1 ||
+             (suffixes.size() == 1 && suffixes[0] != "profile")) {
+    generateError(rest::ResponseCode::NOT_FOUND, TRI_ERROR_HTTP_NOT_FOUND);
+  } else {
+    generateError(rest::ResponseCode::METHOD_NOT_ALLOWED,
+                  TRI_ERROR_HTTP_METHOD_NOT_ALLOWED);
+  }
+
+  return RestStatus::DONE;
+}
+
+void RestMemoryHandler::reportStatistics() {
+  VPackBuilder builder;
+  MemoryArenas::toVelocyPack(builder);
+  generateResult(rest::ResponseCode::OK, builder.slice());
+}
+
+void RestMemoryHandler::dumpProfile() {
+  // the profile is a text file for jeprof, which can only be sent via HTTP
+  auto response = dynamic_cast<HttpResponse*>(_response.get());
+
+  if (response == nullptr) {
+    generateError(rest::ResponseCode::NOT_IMPLEMENTED,
+                  TRI_ERROR_NOT_IMPLEMENTED,
+                  "heap profiles are only available via HTTP");
+    return;
+  }
+
+  std::string filename;
+  {
+    char* name = nullptr;
+    std::string errorMessage;
+    long systemError;
+
+    if (TRI_GetTempName("memory", &name, false, systemError, errorMessage) !=
+        TRI_ERROR_NO_ERROR) {
+      generateError(rest::ResponseCode::SERVER_ERROR,
+                    TRI_ERROR_CANNOT_CREATE_TEMP_FILE,
+                    "could not generate temp file: " + errorMessage);
+      return;
+    }
+
+    if (name == nullptr) {
+      THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+    }
+
+    filename.append(name);
+    TRI_Free(TRI_CORE_MEM_ZONE, name);
+  }
+
+  int res = MemoryArenas::dumpProfile(filename);
+
+  if (res == TRI_ERROR_NOT_IMPLEMENTED) {
+    generateError(rest::ResponseCode::NOT_IMPLEMENTED, res,
+                  "heap profiling needs jemalloc with profiling support and "
+                  "MALLOC_CONF=prof:true");
+    return;
+  }
+
+  if (res != TRI_ERROR_NO_ERROR) {
+    generateError(rest::ResponseCode::SERVER_ERROR, res,
+                  "could not write heap profile");
+    return;
+  }
+
+  std::string profile;
+
+  try {
+    profile = FileUtils::slurp(filename);
+  } catch (...) {
+    TRI_UnlinkFile(filename.c_str());
+    throw;
+  }
+
+  TRI_UnlinkFile(filename.c_str());
+
+  resetResponse(rest::ResponseCode::OK);
+  response->setContentType("text/plain");
+  response->body().appendText(profile);
+}
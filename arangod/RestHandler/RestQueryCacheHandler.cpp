@@ -135,5 +135,11 @@ bool RestQueryCacheHandler::replaceProperties() {
 
   queryCache->setProperties(cacheProperties);
 
+  attribute = body.get("invalidation");
+
+  if (attribute.isString()) {
+    queryCache->setInvalidationMode(attribute.copyString());
+  }
+
   return readProperties();
 }
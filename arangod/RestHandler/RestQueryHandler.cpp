@@ -23,6 +23,7 @@
 
 #include "RestQueryHandler.h"
 
+#include "Aql/PlanCache.h"
 #include "Aql/Query.h"
 #include "Aql/QueryList.h"
 #include "Basics/conversions.h"
@@ -66,7 +67,12 @@ RestStatus RestQueryHandler::execute() {
       replaceProperties();
       break;
     case rest::RequestType::POST:
-      parseQuery();
+      if (_request->suffixes().size() == 1 &&
+          _request->suffixes()[0] == "prepare") {
+        prepareQuery();
+      } else {
+        parseQuery();
+      }
       break;
     default:
       generateNotImplemented("ILLEGAL " + DOCUMENT_PATH);
@@ -119,6 +125,9 @@ bool RestQueryHandler::readQuery(bool slow) {
     result.add("started", VPackValue(timeString));
     result.add("runTime", VPackValue(q.runTime));
     result.add("state", VPackValue(QueryExecutionState::toString(q.state)));
+    if (q.profile != nullptr) {
+      result.add("profile", q.profile->slice());
+    }
     result.close();
   }
   result.close();
@@ -204,6 +213,10 @@ bool RestQueryHandler::deleteQuery(std::string const& name) {
 bool RestQueryHandler::deleteQuery() {
   auto const& suffixes = _request->suffixes();
 
+  if (suffixes.size() == 2 && suffixes[0] == "prepare") {
+    return deletePreparedQuery(suffixes[1]);
+  }
+
   if (suffixes.size() != 1) {
     generateError(rest::ResponseCode::BAD,
                   TRI_ERROR_HTTP_BAD_PARAMETER,
@@ -355,3 +368,83 @@ bool RestQueryHandler::parseQuery() {
   generateResult(rest::ResponseCode::OK, result.slice());
   return true;
 }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief prepares a query. the query is parsed to validate it, and its
+/// execution plan is cached when the query is first executed via the
+/// returned id. later executions with other bind parameter values reuse
+/// the plan
+////////////////////////////////////////////////////////////////////////////////
+
+bool RestQueryHandler::prepareQuery() {
+  bool parseSuccess = true;
+  std::shared_ptr<VPackBuilder> parsedBody =
+      parseVelocyPackBody(parseSuccess);
+  if (!parseSuccess) {
+    // error message generated in parseVelocyPackBody
+    return true;
+  }
+
+  VPackSlice body = parsedBody.get()->slice();
+
+  if (!body.isObject()) {
+    generateError(rest::ResponseCode::BAD,
+                  TRI_ERROR_HTTP_BAD_PARAMETER,
+                  "expecting a JSON object as body");
+    return true;
+  }
+
+  std::string const&& queryString =
+      VelocyPackHelper::checkAndGetStringValue(body, "query");
+
+  Query query(true, _vocbase, queryString.c_str(), queryString.size(),
+              nullptr, nullptr, PART_MAIN);
+
+  auto parseResult = query.parse();
+
+  if (parseResult.code != TRI_ERROR_NO_ERROR) {
+    generateError(rest::ResponseCode::BAD, parseResult.code,
+                  parseResult.details);
+    return true;
+  }
+
+  uint64_t id = PlanCache::instance()->prepare(_vocbase, queryString);
+
+  VPackBuilder result;
+  {
+    VPackObjectBuilder b(&result);
+    result.add("error", VPackValue(false));
+    result.add("code", VPackValue((int)rest::ResponseCode::CREATED));
+    result.add("id", VPackValue(StringUtils::itoa(id)));
+
+    result.add("bindVars", VPackValue(VPackValueType::Array));
+    for (const auto& it : parseResult.bindParameters) {
+      result.add(VPackValue(it));
+    }
+    result.close();  // bindVars
+  }
+
+  generateResult(rest::ResponseCode::CREATED, result.slice());
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief removes a prepared query
+////////////////////////////////////////////////////////////////////////////////
+
+bool RestQueryHandler::deletePreparedQuery(std::string const& id) {
+  if (!PlanCache::instance()->unprepare(_vocbase, StringUtils::uint64(id))) {
+    generateError(rest::ResponseCode::NOT_FOUND, TRI_ERROR_QUERY_NOT_FOUND,
+                  "cannot find prepared query '" + id + "'");
+    return true;
+  }
+
+  VPackBuilder result;
+  result.add(VPackValue(VPackValueType::Object));
+  result.add("error", VPackValue(false));
+  result.add("code", VPackValue((int)rest::ResponseCode::OK));
+  result.close();
+
+  generateResult(rest::ResponseCode::OK, result.slice());
+  return true;
+}
@@ -90,6 +90,18 @@ class RestQueryHandler : public RestVocbaseBaseHandler {
   //////////////////////////////////////////////////////////////////////////////
 
   bool parseQuery();
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief prepares a query, so its plan can be reused across executions
+  //////////////////////////////////////////////////////////////////////////////
+
+  bool prepareQuery();
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief removes a prepared query
+  //////////////////////////////////////////////////////////////////////////////
+
+  bool deletePreparedQuery(std::string const& id);
 };
 }
 
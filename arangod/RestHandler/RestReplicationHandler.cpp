@@ -67,6 +67,9 @@ using namespace arangodb;
 using namespace arangodb::basics;
 using namespace arangodb::rest;
 
+/// @brief maximum time a logger-follow request is held open (in seconds)
+static double const MaxLongPollTime = 60.0;
+
 uint64_t const RestReplicationHandler::defaultChunkSize = 128 * 1024;
 uint64_t const RestReplicationHandler::maxChunkSize = 128 * 1024 * 1024;
 
@@ -860,8 +863,12 @@ void RestReplicationHandler::handleCommandLoggerFollow() {
     useVpp = true;
   }
 
+  // clients that accept VelocyPack get the markers as VelocyPack values
+  bool const writeVelocyPack =
+      (!useVpp && _request->contentTypeResponse() == rest::ContentType::VPACK);
+
   // determine start and end tick
-  MMFilesLogfileManagerState const state =
+  MMFilesLogfileManagerState state =
       MMFilesLogfileManager::instance()->state();
   TRI_voc_tick_t tickStart = 0;
   TRI_voc_tick_t tickEnd = UINT64_MAX;
@@ -902,6 +909,21 @@ void RestReplicationHandler::handleCommandLoggerFollow() {
     includeSystem = StringUtils::boolean(value4);
   }
 
+  // long-polling: if there is no new data, hold the request for up to this
+  // many seconds until new data is committed
+  double waitTime = 0.0;
+  std::string const& value7 = _request->value("waitTime", found);
+
+  if (found) {
+    waitTime = StringUtils::doubleDecimal(value7);
+
+    if (waitTime < 0.0) {
+      waitTime = 0.0;
+    } else if (waitTime > MaxLongPollTime) {
+      waitTime = MaxLongPollTime;
+    }
+  }
+
   // grab list of transactions from the body value
   std::unordered_set<TRI_voc_tid_t> transactionIds;
 
@@ -964,15 +986,42 @@ void RestReplicationHandler::handleCommandLoggerFollow() {
 
   auto transactionContext =
       std::make_shared<transaction::StandaloneContext>(_vocbase);
+  size_t const chunkSize = static_cast<size_t>(determineChunkSize());
+  double const waitEnd = TRI_microtime() + waitTime;
 
-  // initialize the dump container
-  TRI_replication_dump_t dump(transactionContext,
-                              static_cast<size_t>(determineChunkSize()),
-                              includeSystem, cid, useVpp);
+  std::unique_ptr<TRI_replication_dump_t> dumpPtr;
+  int res;
 
-  // and dump
-  int res = TRI_DumpLogReplication(&dump, transactionIds, firstRegularTick,
-                                   tickStart, tickEnd, false);
+  while (true) {
+    // initialize the dump container
+    dumpPtr.reset(new TRI_replication_dump_t(transactionContext, chunkSize,
+                                             includeSystem, cid, useVpp));
+    dumpPtr->_writeVelocyPack = writeVelocyPack;
+
+    // and dump
+    res = TRI_DumpLogReplication(dumpPtr.get(), transactionIds,
+                                 firstRegularTick, tickStart, tickEnd, false);
+
+    if (res != TRI_ERROR_NO_ERROR || dumpPtr->_lastFoundTick > 0) {
+      break;
+    }
+
+    double const now = TRI_microtime();
+
+    if (now >= waitEnd || application_features::ApplicationServer::isStopping()) {
+      break;
+    }
+
+    // nothing to return yet. wait until the WAL has new committed data and
+    // dump again. the new data may belong to other databases or to
+    // collections the client is not interested in, so waiting may continue
+    // after that
+    MMFilesLogfileManager::instance()->waitForCommittedTick(
+        state.lastCommittedTick, (std::min)(waitEnd - now, 1.0));
+    state = MMFilesLogfileManager::instance()->state();
+  }
+
+  TRI_replication_dump_t& dump = *dumpPtr;
 
   if (res == TRI_ERROR_NO_ERROR) {
     bool const checkMore = (dump._lastFoundTick > 0 &&
@@ -993,7 +1042,8 @@ void RestReplicationHandler::handleCommandLoggerFollow() {
     }
 
     // transfer ownership of the buffer contents
-    _response->setContentType(rest::ContentType::DUMP);
+    _response->setContentType(writeVelocyPack ? rest::ContentType::VPACK
+                                              : rest::ContentType::DUMP);
 
     // set headers
     _response->setHeaderNC(TRI_REPLICATION_HEADER_CHECKMORE,
@@ -1006,6 +1056,12 @@ void RestReplicationHandler::handleCommandLoggerFollow() {
     _response->setHeaderNC(TRI_REPLICATION_HEADER_FROMPRESENT,
                            dump._fromTickIncluded ? "true" : "false");
 
+    if (waitTime > 0.0) {
+      // the request was held until data arrived or the wait time was over,
+      // so the client does not need to sleep before its next request
+      _response->setHeaderNC(TRI_REPLICATION_HEADER_LONGPOLL, "true");
+    }
+
     if (length > 0) {
       if (useVpp) {
         for (auto message : dump._slices) {
@@ -2708,6 +2764,9 @@ void RestReplicationHandler::handleCommandDump() {
 
   if (compat28) {
     dump._compat28 = true;
+  } else if (_request->contentTypeResponse() == rest::ContentType::VPACK) {
+    // clients that accept VelocyPack get the markers as VelocyPack values
+    dump._writeVelocyPack = true;
   }
 
   int res =
@@ -2733,7 +2792,8 @@ void RestReplicationHandler::handleCommandDump() {
     THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL, "invalid response type");
   }
 
-  response->setContentType(rest::ContentType::DUMP);
+  response->setContentType(dump._writeVelocyPack ? rest::ContentType::VPACK
+                                                 : rest::ContentType::DUMP);
 
   // set headers
   _response->setHeaderNC(TRI_REPLICATION_HEADER_CHECKMORE,
@@ -2846,6 +2906,8 @@ void RestReplicationHandler::handleCommandMakeSlave() {
           static_cast<double>(defaults._idleMaxWaitTime) / (1000.0 * 1000.0)));
   config._autoResyncRetries = VelocyPackHelper::getNumericValue<uint64_t>(
       body, "autoResyncRetries", defaults._autoResyncRetries);
+  config._applyThreads = VelocyPackHelper::getNumericValue<uint64_t>(
+      body, "applyThreads", defaults._applyThreads);
 
   VPackSlice const restriction = body.get("restrictCollections");
 
@@ -3171,6 +3233,8 @@ void RestReplicationHandler::handleCommandApplierSetConfig() {
           static_cast<double>(config._idleMaxWaitTime) / (1000.0 * 1000.0)));
   config._autoResyncRetries = VelocyPackHelper::getNumericValue<uint64_t>(
       body, "autoResyncRetries", config._autoResyncRetries);
+  config._applyThreads = VelocyPackHelper::getNumericValue<uint64_t>(
+      body, "applyThreads", config._applyThreads);
 
   VPackSlice const restriction = body.get("restrictCollections");
   if (restriction.isArray()) {
@@ -22,6 +22,7 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "RestSimpleHandler.h"
+#include "Aql/BindParameters.h"
 #include "Aql/Query.h"
 #include "Aql/QueryRegistry.h"
 #include "Basics/Exceptions.h"
@@ -31,6 +32,7 @@
 #include "Basics/VPackStringBufferAdapter.h"
 #include "Basics/VelocyPackHelper.h"
 #include "Utils/CollectionNameResolver.h"
+#include "Utils/OperationOptions.h"
 #include "Utils/SingleCollectionTransaction.h"
 #include "Transaction/StandaloneContext.h"
 #include "Transaction/Context.h"
@@ -290,110 +292,120 @@ void RestSimpleHandler::lookupByKeys(VPackSlice const& slice) {
     THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL, "invalid response");
   }
 
-  try {
-    std::string collectionName;
-    {
-      VPackSlice const value = slice.get("collection");
-      if (!value.isString()) {
-        generateError(rest::ResponseCode::BAD, TRI_ERROR_TYPE_ERROR,
-                      "expecting string for <collection>");
-        return;
-      }
-      collectionName = value.copyString();
+  std::string collectionName;
+  {
+    VPackSlice const value = slice.get("collection");
+    if (!value.isString()) {
+      generateError(rest::ResponseCode::BAD, TRI_ERROR_TYPE_ERROR,
+                    "expecting string for <collection>");
+      return;
+    }
+    collectionName = value.copyString();
 
-      if (!collectionName.empty()) {
-        auto const* col = _vocbase->lookupCollection(collectionName);
+    if (!collectionName.empty()) {
+      auto const* col = _vocbase->lookupCollection(collectionName);
 
-        if (col != nullptr && collectionName != col->name()) {
-          // user has probably passed in a numeric collection id.
-          // translate it into a "real" collection name
-          collectionName = col->name();
-        }
+      if (col != nullptr && collectionName != col->name()) {
+        // user has probably passed in a numeric collection id.
+        // translate it into a "real" collection name
+        collectionName = col->name();
       }
     }
+  }
 
-    VPackSlice const keys = slice.get("keys");
+  VPackSlice const keys = slice.get("keys");
 
-    if (!keys.isArray()) {
-      generateError(rest::ResponseCode::BAD, TRI_ERROR_TYPE_ERROR,
-                    "expecting array for <keys>");
-      return;
+  if (!keys.isArray()) {
+    generateError(rest::ResponseCode::BAD, TRI_ERROR_TYPE_ERROR,
+                  "expecting array for <keys>");
+    return;
+  }
+
+  // only string keys can match a document. keys may also be passed as
+  // document ids, from which the collection name is stripped
+  VPackBuilder strippedBuilder =
+      arangodb::aql::BindParameters::StripCollectionNames(
+          keys, collectionName.c_str());
+
+  VPackBuilder search;
+  search.openArray();
+  for (auto const& key : VPackArrayIterator(strippedBuilder.slice())) {
+    if (key.isString()) {
+      search.add(key);
     }
+  }
+  search.close();
 
-    auto bindVars = std::make_shared<VPackBuilder>();
-    bindVars->openObject();
-    bindVars->add("@collection", VPackValue(collectionName));
-    VPackBuilder strippedBuilder =
-        arangodb::aql::BindParameters::StripCollectionNames(
-            keys, collectionName.c_str());
+  // the documents are fetched with a multi-document read. on a coordinator
+  // this groups the keys by shard and contacts all responsible shards in
+  // parallel, and the results are returned in the order of the keys
+  auto transactionContext(transaction::StandaloneContext::Create(_vocbase));
+  SingleCollectionTransaction trx(transactionContext, collectionName,
+                                  AccessMode::Type::READ);
 
-    bindVars->add("keys", strippedBuilder.slice());
-    bindVars->close();
+  int res = trx.begin();
 
-    std::string const aql(
-        "FOR doc IN @@collection FILTER doc._key IN @keys RETURN doc");
+  if (res != TRI_ERROR_NO_ERROR) {
+    generateTransactionError(collectionName, res, "");
+    return;
+  }
 
-    arangodb::aql::Query query(false, _vocbase, aql.c_str(), aql.size(),
-                               bindVars, nullptr, arangodb::aql::PART_MAIN);
+  OperationOptions options;
+  OperationResult opRes = trx.document(collectionName, search.slice(), options);
 
-    registerQuery(&query);
-    auto queryResult = query.execute(_queryRegistry);
-    unregisterQuery();
+  res = trx.finish(opRes.code);
 
-    if (queryResult.code != TRI_ERROR_NO_ERROR) {
-      if (queryResult.code == TRI_ERROR_REQUEST_CANCELED ||
-          (queryResult.code == TRI_ERROR_QUERY_KILLED && wasCanceled())) {
-        generateError(GeneralResponse::responseCode(TRI_ERROR_REQUEST_CANCELED), TRI_ERROR_REQUEST_CANCELED);
-        return;
-      }
+  if (!opRes.successful()) {
+    generateTransactionError(opRes);
+    return;
+  }
 
-      generateError(GeneralResponse::responseCode(queryResult.code), queryResult.code, queryResult.details);
-      return;
-    }
+  if (res != TRI_ERROR_NO_ERROR) {
+    generateTransactionError(collectionName, res, "");
+    return;
+  }
 
-    size_t resultSize = 10;
-    VPackSlice qResult = queryResult.result->slice();
-    if (qResult.isArray()) {
-      resultSize = static_cast<size_t>(qResult.length());
+  VPackSlice const documents = opRes.slice();
+  TRI_ASSERT(documents.isArray());
+
+  VPackBuffer<uint8_t> resultBuffer;
+  VPackBuilder result(resultBuffer);
+  {
+    VPackObjectBuilder guard(&result);
+    resetResponse(rest::ResponseCode::OK);
+
+    response->setContentType(rest::ContentType::JSON);
+
+    // This is for internal use of AQL Traverser only.
+    // Should not be documented
+    VPackSlice const postFilter = slice.get("filter");
+    TRI_ASSERT(postFilter.isNone());
+
+    // keys that were not found are left out, as before
+    result.add(VPackValue("documents"));
+    result.openArray();
+    for (auto const& doc : VPackArrayIterator(documents)) {
+      if (doc.isObject() &&
+          !arangodb::basics::VelocyPackHelper::getBooleanValue(doc, "error",
+                                                              false)) {
+        result.add(doc);
+      }
     }
+    result.close();
 
-    VPackBuffer<uint8_t> resultBuffer;
-    VPackBuilder result(resultBuffer);
-    {
-      VPackObjectBuilder guard(&result);
-      resetResponse(rest::ResponseCode::OK);
-
-      response->setContentType(rest::ContentType::JSON);
-
-      if (qResult.isArray()) {
-        // This is for internal use of AQL Traverser only.
-        // Should not be documented
-        VPackSlice const postFilter = slice.get("filter");
-        TRI_ASSERT(postFilter.isNone());
-        result.add(VPackValue("documents"));
-        result.add(qResult);
-        queryResult.result = nullptr;
-      } else {
-        result.add(VPackValue("documents"));
-        result.add(qResult);
-        queryResult.result = nullptr;
-      }
-      result.add("error", VPackValue(false));
-      result.add("code",
-                 VPackValue(static_cast<int>(_response->responseCode())));
+    result.add("error", VPackValue(false));
+    result.add("code",
+               VPackValue(static_cast<int>(_response->responseCode())));
 
-      // reserve a few bytes per result document by default
-      int res = response->reservePayload(32 * resultSize);
+    // reserve a few bytes per result document by default
+    res = response->reservePayload(32 *
+                                   static_cast<size_t>(documents.length()));
 
-      if (res != TRI_ERROR_NO_ERROR) {
-        THROW_ARANGO_EXCEPTION(res);
-      }
+    if (res != TRI_ERROR_NO_ERROR) {
+      THROW_ARANGO_EXCEPTION(res);
     }
-
-    generateResult(rest::ResponseCode::OK, std::move(resultBuffer),
-                   queryResult.context);
-  } catch (...) {
-    unregisterQuery();
-    throw;
   }
+
+  generateResult(rest::ResponseCode::OK, std::move(resultBuffer),
+                 transactionContext);
 }
@@ -0,0 +1,107 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "AllocatorFeature.h"
+
+#include "Basics/LargePages.h"
+#include "Basics/MemoryArenas.h"
+#include "Logger/Logger.h"
+#include "ProgramOptions/ProgramOptions.h"
+#include "ProgramOptions/Section.h"
+
+using namespace arangodb;
+using namespace arangodb::application_features;
+using namespace arangodb::basics;
+using namespace arangodb::options;
+
+AllocatorFeature::AllocatorFeature(
+    application_features::ApplicationServer* server)
+    : ApplicationFeature(server, "Allocator"),
+      _indexArena(true),
+      _decayTime(10000),
+      _backgroundThreads(true),
+      _largePages("transparent") {
+  setOptional(true);
+  requiresElevatedPrivileges(false);
+  startsAfter("Logger");
+}
+
+void AllocatorFeature::collectOptions(
+    std::shared_ptr<ProgramOptions> options) {
+  options->addSection("memory", "Configure the memory allocator (jemalloc)");
+
+  options->addOption("--memory.index-arena",
+                     "allocate the tables of in-memory indexes from an arena "
+                     "of their own",
+                     new BooleanParameter(&_indexArena));
+
+  options->addOption("--memory.decay-time",
+                     "time (in milliseconds) after which unused memory is "
+                     "returned to the operating system (-1 = never)",
+                     new Int64Parameter(&_decayTime));
+
+  options->addOption("--memory.background-threads",
+                     "return unused memory to the operating system in "
+                     "background threads (needs jemalloc 5)",
+                     new BooleanParameter(&_backgroundThreads));
+
+  options->addOption(
+      "--memory.large-pages",
+      "put the tables of indexes and caches of at least 2 MB on huge pages "
+      "(transparent = ask for transparent huge pages, explicit = use pages "
+      "reserved with vm.nr_hugepages and fall back to transparent ones)",
+      new DiscreteValuesParameter<StringParameter>(
+          &_largePages, std::unordered_set<std::string>{
+                            "off", "transparent", "explicit"}));
+}
+
+void AllocatorFeature::prepare() {
+  // independent of jemalloc, and must be set before any table is allocated
+  if (_largePages == "off") {
+    LargePages::setMode(LargePages::Mode::OFF);
+  } else if (_largePages == "explicit") {
+    LargePages::setMode(LargePages::Mode::EXPLICIT);
+  } else {
+    LargePages::setMode(LargePages::Mode::TRANSPARENT);
+  }
+
+  if (!MemoryArenas::enabled()) {
+    LOG_TOPIC(DEBUG, arangodb::Logger::MEMORY)
+        << "not linked with jemalloc, ignoring the --memory options";
+    return;
+  }
+
+  // the decay time applies to all arenas, so the index arena is created
+  // first
+  MemoryArenas::initialize(_indexArena);
+
+  if (MemoryArenas::setDecayTime(_decayTime) != TRI_ERROR_NO_ERROR) {
+    LOG_TOPIC(WARN, arangodb::Logger::MEMORY)
+        << "cannot set the decay time of jemalloc. jemalloc 4 needs "
+           "MALLOC_CONF=purge:decay for this";
+  }
+
+  if (MemoryArenas::setBackgroundThreads(_backgroundThreads) !=
+      TRI_ERROR_NO_ERROR) {
+    LOG_TOPIC(INFO, arangodb::Logger::MEMORY)
+        << "jemalloc does not support background threads";
+  }
+}
@@ -140,6 +140,10 @@ void BootstrapFeature::start() {
   auto ss = ServerState::instance();
 
   if (!ss->isRunningInCluster()) {
+    // the databases are up, so requests that do not need V8 can be served
+    // while the JavaScript bootstrap runs
+    rest::RestHandlerFactory::setNativeHandlersReady(true);
+
     LOG_TOPIC(DEBUG, Logger::STARTUP) << "Running server/server.js";
     V8DealerFeature::DEALER->loadJavaScriptFileInAllContexts(vocbase, "server/server.js");
   } else if (ss->isCoordinator()) {
@@ -743,7 +743,7 @@ int DatabaseFeature::dropDatabase(std::string const& name, bool waitForDeletion,
     vocbase->setIsOwnAppsDirectory(removeAppsDirectory);
 
     // invalidate all entries for the database
-    arangodb::aql::PlanCache::instance()->invalidate(vocbase);
+    arangodb::aql::PlanCache::instance()->drop(vocbase);
     arangodb::aql::QueryCache::instance()->invalidate(vocbase);
 
     engine->prepareDropDatabase(vocbase, !engine->inRecovery(), res);
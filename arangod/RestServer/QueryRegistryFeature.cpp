@@ -41,7 +41,8 @@ QueryRegistryFeature::QueryRegistryFeature(ApplicationServer* server)
       _queryMemoryLimit(0),
       _slowThreshold(10.0),
       _queryCacheMode("off"),
-      _queryCacheEntries(128) {
+      _queryCacheEntries(128),
+      _queryCacheInvalidation("collection") {
   setOptional(false);
   requiresElevatedPrivileges(false);
   startsAfter("DatabasePath");
@@ -74,6 +75,13 @@ void QueryRegistryFeature::collectOptions(
   options->addOption("--query.cache-entries",
                      "maximum number of results in query result cache per database",
                      new UInt64Parameter(&_queryCacheEntries));
+
+  options->addOption("--query.cache-invalidation",
+                     "invalidation of the AQL query result cache on writes "
+                     "(collection, keys)",
+                     new DiscreteValuesParameter<StringParameter>(
+                         &_queryCacheInvalidation,
+                         std::unordered_set<std::string>{"collection", "keys"}));
 }
 
 void QueryRegistryFeature::validateOptions(
@@ -94,6 +102,8 @@ void QueryRegistryFeature::prepare() {
   std::pair<std::string, size_t> cacheProperties{_queryCacheMode,
                                                  _queryCacheEntries};
   arangodb::aql::QueryCache::instance()->setProperties(cacheProperties);
+  arangodb::aql::QueryCache::instance()->setInvalidationMode(
+      _queryCacheInvalidation);
   
   // create the query registery
   _queryRegistry.reset(new aql::QueryRegistry());
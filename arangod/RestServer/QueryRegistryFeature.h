@@ -50,6 +50,7 @@ class QueryRegistryFeature final : public application_features::ApplicationFeatu
   double _slowThreshold;
   std::string _queryCacheMode;
   uint64_t _queryCacheEntries;
+  std::string _queryCacheInvalidation;
 
  public:
   aql::QueryRegistry* queryRegistry() const { return _queryRegistry.get(); }
@@ -83,6 +83,12 @@ void ServerFeature::collectOptions(std::shared_ptr<ProgramOptions> options) {
   options->addOption("--javascript.script", "run scripts and exit",
                      new VectorParameter<StringParameter>(&_scripts));
 
+  options->addSection("benchmark", "Configure the storage benchmark");
+
+  options->addHiddenOption("--benchmark.storage",
+                           "run storage benchmark operations and exit",
+                           new VectorParameter<StringParameter>(&_benchmarks));
+
   options->addSection("vst", "Configure the VelocyStream protocol");
 
   options->addOption("--vst.maxsize",
@@ -108,15 +114,21 @@ void ServerFeature::validateOptions(std::shared_ptr<ProgramOptions>) {
     ++count;
   }
 
+  if (!_benchmarks.empty()) {
+    _operationMode = OperationMode::MODE_BENCHMARK;
+    ++count;
+  }
+
   if (1 < count) {
-    LOG_TOPIC(FATAL, arangodb::Logger::FIXME) << "cannot combine '--console', '--javascript.unit-tests' and "
-               << "'--javascript.script'";
+    LOG_TOPIC(FATAL, arangodb::Logger::FIXME) << "cannot combine '--console', '--javascript.unit-tests', "
+               << "'--javascript.script' and '--benchmark.storage'";
     FATAL_ERROR_EXIT();
   }
 
   if (_operationMode == OperationMode::MODE_SERVER && !_restServer) {
-    LOG_TOPIC(FATAL, arangodb::Logger::FIXME) << "need at least '--console', '--javascript.unit-tests' or"
-               << "'--javascript.script if rest-server is disabled";
+    LOG_TOPIC(FATAL, arangodb::Logger::FIXME) << "need at least '--console', '--javascript.unit-tests', "
+               << "'--javascript.script' or '--benchmark.storage' if "
+               << "rest-server is disabled";
     FATAL_ERROR_EXIT();
   }
 
@@ -174,6 +186,7 @@ void ServerFeature::start() {
   switch (_operationMode) {
     case OperationMode::MODE_UNITTESTS:
     case OperationMode::MODE_SCRIPT:
+    case OperationMode::MODE_BENCHMARK:
     case OperationMode::MODE_CONSOLE:
       break;
 
@@ -212,6 +225,8 @@ std::string ServerFeature::operationModeString(OperationMode mode) {
       return "unittests";
     case OperationMode::MODE_SCRIPT:
       return "script";
+    case OperationMode::MODE_BENCHMARK:
+      return "benchmark";
     case OperationMode::MODE_SERVER:
       return "server";
     default:
@@ -58,6 +58,7 @@ class ServerFeature final : public application_features::ApplicationFeature {
 
   std::vector<std::string> const& scripts() const { return _scripts; }
   std::vector<std::string> const& unitTests() const { return _unitTests; }
+  std::vector<std::string> const& benchmarks() const { return _benchmarks; }
   uint32_t const& vppMaxSize() const { return _vppMaxSize; }
  
  private:
@@ -68,6 +69,7 @@ class ServerFeature final : public application_features::ApplicationFeature {
   bool _restServer = true;
   std::vector<std::string> _unitTests;
   std::vector<std::string> _scripts;
+  std::vector<std::string> _benchmarks;
   uint32_t _vppMaxSize;
   int* _result;
   OperationMode _operationMode;
@@ -0,0 +1,415 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "StorageBenchmarkFeature.h"
+
+#include "Basics/Exceptions.h"
+#include "Basics/FileUtils.h"
+#include "Basics/StaticStrings.h"
+#include "Basics/StringUtils.h"
+#include "Basics/system-functions.h"
+#include "Indexes/Index.h"
+#include "Indexes/IndexFactory.h"
+#include "Logger/Logger.h"
+#include "ProgramOptions/ProgramOptions.h"
+#include "ProgramOptions/Section.h"
+#include "Random/RandomGenerator.h"
+#include "RestServer/DatabaseFeature.h"
+#include "RestServer/ServerFeature.h"
+#include "StorageEngine/EngineSelectorFeature.h"
+#include "StorageEngine/StorageEngine.h"
+#include "Transaction/StandaloneContext.h"
+#include "Utils/OperationCursor.h"
+#include "Utils/OperationOptions.h"
+#include "Utils/SingleCollectionTransaction.h"
+#include "VocBase/LogicalCollection.h"
+#include "VocBase/ManagedDocumentResult.h"
+#include "VocBase/ticks.h"
+#include "VocBase/vocbase.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/velocypack-aliases.h>
+
+#include <iostream>
+#include <thread>
+
+using namespace arangodb;
+using namespace arangodb::application_features;
+using namespace arangodb::basics;
+using namespace arangodb::options;
+
+namespace {
+/// @brief the operations that can be benchmarked
+static std::vector<std::string> const Operations = {
+    "insert", "insert-sync", "lookup", "scan", "index-build", "update",
+    "remove"};
+
+static std::string keyOf(uint64_t value) {
+  return "k" + StringUtils::itoa(value);
+}
+}
+
+StorageBenchmarkFeature::StorageBenchmarkFeature(
+    application_features::ApplicationServer* server, int* result)
+    : ApplicationFeature(server, "StorageBenchmark"),
+      _result(result),
+      _threads(4),
+      _documents(100000),
+      _batchSize(100),
+      _payloadSize(64),
+      _nextKey(0),
+      _nextRemove(0) {
+  startsAfter("Nonce");
+  startsAfter("Server");
+  startsAfter("Bootstrap");
+}
+
+void StorageBenchmarkFeature::collectOptions(
+    std::shared_ptr<ProgramOptions> options) {
+  options->addSection("benchmark", "Configure the storage benchmark");
+
+  options->addHiddenOption("--benchmark.threads",
+                           "number of threads running each operation",
+                           new UInt64Parameter(&_threads));
+
+  options->addHiddenOption("--benchmark.documents",
+                           "number of documents processed by each operation",
+                           new UInt64Parameter(&_documents));
+
+  options->addHiddenOption("--benchmark.batch-size",
+                           "number of documents per transaction",
+                           new UInt64Parameter(&_batchSize));
+
+  options->addHiddenOption("--benchmark.payload-size",
+                           "size of the payload of each document (in bytes)",
+                           new UInt64Parameter(&_payloadSize));
+
+  options->addHiddenOption("--benchmark.output",
+                           "file to write the results to, stdout if empty",
+                           new StringParameter(&_output));
+}
+
+void StorageBenchmarkFeature::validateOptions(
+    std::shared_ptr<ProgramOptions>) {
+  if (_threads == 0 || _batchSize == 0) {
+    LOG_TOPIC(FATAL, arangodb::Logger::FIXME)
+        << "'--benchmark.threads' and '--benchmark.batch-size' must be "
+           "positive";
+    FATAL_ERROR_EXIT();
+  }
+
+  auto server = ApplicationServer::getFeature<ServerFeature>("Server");
+
+  for (auto const& it : server->benchmarks()) {
+    if (std::find(Operations.begin(), Operations.end(), it) ==
+        Operations.end()) {
+      LOG_TOPIC(FATAL, arangodb::Logger::FIXME)
+          << "unknown benchmark operation '" << it << "', expecting one of "
+          << StringUtils::join(Operations, ", ");
+      FATAL_ERROR_EXIT();
+    }
+  }
+}
+
+void StorageBenchmarkFeature::start() {
+  auto server = ApplicationServer::getFeature<ServerFeature>("Server");
+  auto operationMode = server->operationMode();
+
+  if (operationMode != OperationMode::MODE_BENCHMARK) {
+    return;
+  }
+
+  LOG_TOPIC(TRACE, Logger::STARTUP) << "server about to run benchmarks";
+  *_result = runBenchmarks(server->benchmarks());
+}
+
+int StorageBenchmarkFeature::runBenchmarks(
+    std::vector<std::string> const& operations) {
+  DatabaseFeature* database =
+      ApplicationServer::getFeature<DatabaseFeature>("Database");
+  TRI_vocbase_t* vocbase = database->systemDatabase();
+
+  std::string const name =
+      "benchmark" + StringUtils::itoa(TRI_NewTickServer());
+
+  VPackBuilder info;
+  info.openObject();
+  info.add("name", VPackValue(name));
+  info.close();
+
+  LogicalCollection* collection = nullptr;
+  try {
+    collection = vocbase->createCollection(info.slice(), 0);
+  } catch (arangodb::basics::Exception const& ex) {
+    LOG_TOPIC(ERR, arangodb::Logger::FIXME)
+        << "cannot create benchmark collection: " << ex.what();
+    return EXIT_FAILURE;
+  }
+
+  if (collection == nullptr) {
+    LOG_TOPIC(ERR, arangodb::Logger::FIXME)
+        << "cannot create benchmark collection: "
+        << TRI_errno_string(TRI_errno());
+    return EXIT_FAILURE;
+  }
+
+  TRI_DEFER(vocbase->dropCollection(collection, false));
+
+  VPackBuilder result;
+  result.openArray();
+
+  int res = TRI_ERROR_NO_ERROR;
+  for (auto const& operation : operations) {
+    res = runOperation(vocbase, name, operation, result);
+
+    if (res != TRI_ERROR_NO_ERROR) {
+      LOG_TOPIC(ERR, arangodb::Logger::FIXME)
+          << "benchmark operation '" << operation
+          << "' failed: " << TRI_errno_string(res);
+      break;
+    }
+  }
+
+  result.close();
+
+  std::string const json = result.slice().toJson();
+
+  if (_output.empty()) {
+    std::cout << json << std::endl;
+  } else {
+    try {
+      FileUtils::spit(_output, json);
+    } catch (...) {
+      LOG_TOPIC(ERR, arangodb::Logger::FIXME)
+          << "cannot write benchmark results to '" << _output << "'";
+      return EXIT_FAILURE;
+    }
+  }
+
+  return res == TRI_ERROR_NO_ERROR ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+int StorageBenchmarkFeature::runOperation(TRI_vocbase_t* vocbase,
+                                          std::string const& collection,
+                                          std::string const& operation,
+                                          VPackBuilder& result) {
+  std::atomic<uint64_t> processed(0);
+  std::atomic<int> error(TRI_ERROR_NO_ERROR);
+  uint64_t threads = _threads;
+
+  double const start = TRI_microtime();
+
+  if (operation == "index-build") {
+    // building an index is single-threaded. it processes all documents
+    // of the collection
+    threads = 1;
+    try {
+      processed = runBatch(vocbase, collection, operation, 0);
+    } catch (arangodb::basics::Exception const& ex) {
+      error = ex.code();
+    } catch (...) {
+      error = TRI_ERROR_INTERNAL;
+    }
+  } else {
+    // the documents still to be processed, handed out in batches
+    std::atomic<uint64_t> remaining(_documents);
+    std::vector<std::thread> workers;
+    workers.reserve(threads);
+
+    for (uint64_t i = 0; i < threads; ++i) {
+      workers.emplace_back([&]() {
+        try {
+          if (operation == "scan") {
+            // every thread reads the complete collection once
+            processed += runBatch(vocbase, collection, operation, 0);
+            return;
+          }
+          while (error.load() == TRI_ERROR_NO_ERROR) {
+            uint64_t available = remaining.load();
+            uint64_t batchSize;
+            do {
+              if (available == 0) {
+                return;
+              }
+              batchSize = (std::min)(available, _batchSize);
+            } while (!remaining.compare_exchange_weak(available,
+                                                      available - batchSize));
+
+            processed += runBatch(vocbase, collection, operation, batchSize);
+          }
+        } catch (arangodb::basics::Exception const& ex) {
+          error = ex.code();
+        } catch (...) {
+          error = TRI_ERROR_INTERNAL;
+        }
+      });
+    }
+
+    for (auto& it : workers) {
+      it.join();
+    }
+  }
+
+  double const seconds = TRI_microtime() - start;
+
+  if (error.load() != TRI_ERROR_NO_ERROR) {
+    return error.load();
+  }
+
+  result.openObject();
+  result.add("operation", VPackValue(operation));
+  result.add("engine", VPackValue(EngineSelectorFeature::ENGINE->typeName()));
+  result.add("threads", VPackValue(threads));
+  result.add("batchSize", VPackValue(_batchSize));
+  result.add("documents", VPackValue(processed.load()));
+  result.add("seconds", VPackValue(seconds));
+  result.add("documentsPerSecond",
+             VPackValue(seconds > 0.0 ? processed.load() / seconds : 0.0));
+  result.close();
+
+  return TRI_ERROR_NO_ERROR;
+}
+
+uint64_t StorageBenchmarkFeature::runBatch(TRI_vocbase_t* vocbase,
+                                           std::string const& collection,
+                                           std::string const& operation,
+                                           uint64_t batchSize) {
+  bool const isRead = (operation == "lookup" || operation == "scan");
+
+  SingleCollectionTransaction trx(
+      transaction::StandaloneContext::Create(vocbase), collection,
+      isRead ? AccessMode::Type::READ : AccessMode::Type::WRITE);
+
+  int res = trx.begin();
+
+  if (res != TRI_ERROR_NO_ERROR) {
+    THROW_ARANGO_EXCEPTION(res);
+  }
+
+  OperationOptions options;
+  options.silent = true;
+  options.waitForSync = (operation == "insert-sync");
+
+  uint64_t processed = 0;
+  VPackBuilder builder;
+
+  if (operation == "insert" || operation == "insert-sync") {
+    buildDocuments(builder, batchSize);
+    res = trx.insert(collection, builder.slice(), options).code;
+    processed = batchSize;
+  } else if (operation == "lookup" || operation == "update") {
+    uint64_t const present = _nextKey.load();
+    builder.openArray();
+    for (uint64_t i = 0; i < batchSize; ++i) {
+      uint64_t const key =
+          present == 0 ? 0 : RandomGenerator::interval(present - 1);
+      if (operation == "lookup") {
+        builder.add(VPackValue(keyOf(key)));
+      } else {
+        // each update leaves a dead revision behind, so that the
+        // compactor has to run concurrently with the writers
+        builder.openObject();
+        builder.add(StaticStrings::KeyString, VPackValue(keyOf(key)));
+        builder.add("value", VPackValue(RandomGenerator::interval(UINT64_MAX)));
+        builder.close();
+      }
+    }
+    builder.close();
+    if (operation == "lookup") {
+      res = trx.document(collection, builder.slice(), options).code;
+    } else {
+      res = trx.update(collection, builder.slice(), options).code;
+    }
+    processed = batchSize;
+  } else if (operation == "remove") {
+    uint64_t const first = _nextRemove.fetch_add(batchSize);
+    builder.openArray();
+    for (uint64_t i = 0; i < batchSize; ++i) {
+      builder.add(VPackValue(keyOf(first + i)));
+    }
+    builder.close();
+    res = trx.remove(collection, builder.slice(), options).code;
+    processed = batchSize;
+  } else if (operation == "scan") {
+    ManagedDocumentResult mmdr;
+    std::unique_ptr<OperationCursor> cursor =
+        trx.indexScan(collection, transaction::Methods::CursorType::ALL, &mmdr,
+                      0, UINT64_MAX, 1000, false);
+    std::vector<DocumentIdentifierToken> tokens;
+    LogicalCollection* logical = trx.documentCollection();
+    while (cursor->hasMore()) {
+      tokens.clear();
+      cursor->getMoreTokens(tokens, 1000);
+      for (auto const& token : tokens) {
+        if (logical->readDocument(&trx, token, mmdr)) {
+          ++processed;
+        }
+      }
+    }
+  } else if (operation == "index-build") {
+    VPackBuilder definition;
+    definition.openObject();
+    definition.add("type", VPackValue("skiplist"));
+    definition.add("fields", VPackValue(VPackValueType::Array));
+    definition.add(VPackValue("value"));
+    definition.close();
+    definition.close();
+
+    res = EngineSelectorFeature::ENGINE->indexFactory()->enhanceIndexDefinition(
+        definition.slice(), builder, true);
+
+    if (res == TRI_ERROR_NO_ERROR) {
+      bool created = false;
+      auto idx = trx.documentCollection()->createIndex(&trx, builder.slice(),
+                                                      created);
+      if (idx == nullptr) {
+        res = TRI_errno();
+      } else {
+        processed = trx.documentCollection()->numberDocuments();
+        trx.documentCollection()->dropIndex(idx->id());
+      }
+    }
+  }
+
+  res = trx.finish(res);
+
+  if (res != TRI_ERROR_NO_ERROR) {
+    THROW_ARANGO_EXCEPTION(res);
+  }
+
+  return processed;
+}
+
+void StorageBenchmarkFeature::buildDocuments(VPackBuilder& builder,
+                                             uint64_t batchSize) {
+  uint64_t const first = _nextKey.fetch_add(batchSize);
+  std::string const payload(_payloadSize, 'x');
+
+  builder.openArray();
+  for (uint64_t i = 0; i < batchSize; ++i) {
+    builder.openObject();
+    builder.add(StaticStrings::KeyString, VPackValue(keyOf(first + i)));
+    builder.add("value", VPackValue(first + i));
+    builder.add("payload", VPackValue(payload));
+    builder.close();
+  }
+  builder.close();
+}
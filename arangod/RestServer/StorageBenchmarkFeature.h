@@ -0,0 +1,85 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef APPLICATION_FEATURES_STORAGE_BENCHMARK_FEATURE_H
+#define APPLICATION_FEATURES_STORAGE_BENCHMARK_FEATURE_H 1
+
+#include "ApplicationFeatures/ApplicationFeature.h"
+
+#include "Rest/OperationMode.h"
+
+struct TRI_vocbase_t;
+
+namespace arangodb {
+namespace velocypack {
+class Builder;
+}
+
+/// @brief runs benchmarks against the transaction layer and the storage
+/// engine, without going through the network layer. the operations run in
+/// a temporary collection of the system database, and the results are
+/// written as a JSON array, one object per operation
+class StorageBenchmarkFeature final
+    : public application_features::ApplicationFeature {
+ public:
+  explicit StorageBenchmarkFeature(application_features::ApplicationServer*,
+                                   int* result);
+
+ public:
+  void collectOptions(std::shared_ptr<options::ProgramOptions>) override final;
+  void validateOptions(std::shared_ptr<options::ProgramOptions>) override final;
+  void start() override final;
+
+ private:
+  int runBenchmarks(std::vector<std::string> const& operations);
+
+  /// @brief run a single operation with the configured number of threads,
+  /// and add its result to the builder
+  int runOperation(TRI_vocbase_t* vocbase, std::string const& collection,
+                   std::string const& operation,
+                   arangodb::velocypack::Builder& result);
+
+  /// @brief execute a batch of an operation in its own transaction.
+  /// returns the number of documents processed
+  uint64_t runBatch(TRI_vocbase_t* vocbase, std::string const& collection,
+                    std::string const& operation, uint64_t batchSize);
+
+  /// @brief build the documents for inserting a batch
+  void buildDocuments(arangodb::velocypack::Builder& builder,
+                      uint64_t batchSize);
+
+ private:
+  int* _result;
+  uint64_t _threads;
+  uint64_t _documents;
+  uint64_t _batchSize;
+  uint64_t _payloadSize;
+  std::string _output;
+
+  /// @brief the next key to insert. keys below are present unless removed
+  std::atomic<uint64_t> _nextKey;
+
+  /// @brief the next key to remove
+  std::atomic<uint64_t> _nextRemove;
+};
+}
+
+#endif
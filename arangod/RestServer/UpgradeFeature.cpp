@@ -22,11 +22,17 @@
 
 #include "UpgradeFeature.h"
 
+#include "Basics/FileUtils.h"
+#include "Basics/VelocyPackHelper.h"
+#include "Basics/fasthash.h"
+#include "Basics/files.h"
 #include "Cluster/ClusterFeature.h"
 #include "Logger/Logger.h"
 #include "ProgramOptions/ProgramOptions.h"
 #include "ProgramOptions/Section.h"
+#include "Rest/Version.h"
 #include "RestServer/DatabaseFeature.h"
+#include "RestServer/DatabasePathFeature.h"
 #include "RestServer/InitDatabaseFeature.h"
 #include "V8/v8-globals.h"
 #include "V8Server/V8Context.h"
@@ -45,6 +51,7 @@ UpgradeFeature::UpgradeFeature(
     : ApplicationFeature(server, "Upgrade"),
       _upgrade(false),
       _upgradeCheck(true),
+      _skipUnchanged(true),
       _result(result),
       _nonServerFeatures(nonServerFeatures) {
   setOptional(false);
@@ -69,6 +76,12 @@ void UpgradeFeature::collectOptions(std::shared_ptr<ProgramOptions> options) {
   options->addHiddenOption("--database.upgrade-check",
                            "skip a database upgrade",
                            new BooleanParameter(&_upgradeCheck));
+
+  options->addHiddenOption(
+      "--database.skip-unchanged-upgrade-check",
+      "skip the upgrade check if neither the server version nor the list of "
+      "databases have changed since the last successful check",
+      new BooleanParameter(&_skipUnchanged));
 }
 
 void UpgradeFeature::validateOptions(std::shared_ptr<ProgramOptions> options) {
@@ -186,6 +199,19 @@ void UpgradeFeature::upgradeDatabase(std::string const& defaultPassword) {
   DatabaseFeature* databaseFeature = application_features::ApplicationServer::getFeature<DatabaseFeature>("Database");
   auto* systemVocbase = DatabaseFeature::DATABASE->systemDatabase();
 
+  auto init =
+      ApplicationServer::getFeature<InitDatabaseFeature>("InitDatabase");
+  std::string const state = bootstrapState(databaseFeature);
+
+  if (_skipUnchanged && !_upgrade && !init->isInitDatabase() &&
+      !init->restoreAdmin() && state == readBootstrapState()) {
+    // all databases passed the check with this version before, and none
+    // were added or removed since. the check would not find anything
+    LOG_TOPIC(DEBUG, arangodb::Logger::FIXME)
+        << "skipping database init/upgrade, databases are unchanged";
+    return;
+  }
+
   // enter context and isolate
   {
     V8Context* context =
@@ -264,6 +290,8 @@ void UpgradeFeature::upgradeDatabase(std::string const& defaultPassword) {
     }
   }
 
+  writeBootstrapState(state);
+
   if (_upgrade) {
     *_result = EXIT_SUCCESS;
     LOG_TOPIC(INFO, arangodb::Logger::FIXME) << "database upgrade passed";
@@ -272,3 +300,59 @@ void UpgradeFeature::upgradeDatabase(std::string const& defaultPassword) {
   // and return from the context
   LOG_TOPIC(TRACE, arangodb::Logger::FIXME) << "finished database init/upgrade";
 }
+
+std::string UpgradeFeature::bootstrapStateFile() const {
+  auto databasePath =
+      ApplicationServer::getFeature<DatabasePathFeature>("DatabasePath");
+  return FileUtils::buildFilename(databasePath->directory(), "BOOTSTRAP");
+}
+
+std::string UpgradeFeature::bootstrapState(DatabaseFeature* databaseFeature) {
+  std::vector<std::string> databases;
+  for (auto& name : databaseFeature->getDatabaseNames()) {
+    TRI_vocbase_t* vocbase = databaseFeature->lookupDatabase(name);
+    TRI_ASSERT(vocbase != nullptr);
+    databases.emplace_back(std::to_string(vocbase->id()) + "/" + name);
+  }
+  std::sort(databases.begin(), databases.end());
+
+  uint64_t hash = 0x012345678;
+  for (auto const& it : databases) {
+    hash = fasthash64(it.data(), it.size(), hash);
+  }
+
+  return std::string(ARANGODB_VERSION) + "-" + std::to_string(hash);
+}
+
+std::string UpgradeFeature::readBootstrapState() const {
+  std::string const filename = bootstrapStateFile();
+
+  if (!TRI_ExistsFile(filename.c_str())) {
+    return "";
+  }
+
+  try {
+    auto builder = VelocyPackHelper::velocyPackFromFile(filename);
+    VPackSlice state = builder->slice();
+    if (state.isObject() && state.get("state").isString()) {
+      return state.get("state").copyString();
+    }
+  } catch (...) {
+    // a damaged file only means that the check must run again
+  }
+  return "";
+}
+
+void UpgradeFeature::writeBootstrapState(std::string const& state) const {
+  VPackBuilder builder;
+  builder.openObject();
+  builder.add("state", VPackValue(state));
+  builder.close();
+
+  if (!VelocyPackHelper::velocyPackToFile(bootstrapStateFile(),
+                                          builder.slice(), true)) {
+    LOG_TOPIC(WARN, arangodb::Logger::FIXME)
+        << "cannot write file '" << bootstrapStateFile()
+        << "', the upgrade check will run on the next start again";
+  }
+}
@@ -26,6 +26,8 @@
 #include "ApplicationFeatures/ApplicationFeature.h"
 
 namespace arangodb {
+class DatabaseFeature;
+
 class UpgradeFeature final : public application_features::ApplicationFeature {
  public:
   UpgradeFeature(application_features::ApplicationServer* server, int* result,
@@ -39,11 +41,21 @@ class UpgradeFeature final : public application_features::ApplicationFeature {
  private:
   bool _upgrade;
   bool _upgradeCheck;
+  bool _skipUnchanged;
 
  private:
   void changeAdminPassword(std::string const& defaultPassword);
   void upgradeDatabase(std::string const& defaultPassword);
 
+  // the file recording the state after the last successful upgrade check
+  std::string bootstrapStateFile() const;
+
+  // the server version and a hash of the ids and names of all databases
+  static std::string bootstrapState(DatabaseFeature*);
+
+  std::string readBootstrapState() const;
+  void writeBootstrapState(std::string const&) const;
+
  private:
   int* _result;
   std::vector<std::string> _nonServerFeatures;
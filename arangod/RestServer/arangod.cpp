@@ -52,6 +52,7 @@
 #include "Logger/LoggerFeature.h"
 #include "ProgramOptions/ProgramOptions.h"
 #include "Random/RandomFeature.h"
+#include "RestServer/AllocatorFeature.h"
 #include "RestServer/AqlFeature.h"
 #include "RestServer/BootstrapFeature.h"
 #include "RestServer/CheckVersionFeature.h"
@@ -68,6 +69,7 @@
 #include "RestServer/ScriptFeature.h"
 #include "RestServer/ServerFeature.h"
 #include "RestServer/ServerIdFeature.h"
+#include "RestServer/StorageBenchmarkFeature.h"
 #include "RestServer/TransactionManagerFeature.h"
 #include "RestServer/TraverserEngineRegistryFeature.h"
 #include "RestServer/UnitTestsFeature.h"
@@ -125,6 +127,7 @@ static int runServer(int argc, char** argv) {
 
     server.addFeature(new ActionFeature(&server));
     server.addFeature(new AgencyFeature(&server));
+    server.addFeature(new AllocatorFeature(&server));
     server.addFeature(new aql::AqlFunctionFeature(&server));
     server.addFeature(new aql::OptimizerRulesFeature(&server));
     server.addFeature(new AuthenticationFeature(&server));
@@ -161,9 +164,10 @@ static int runServer(int argc, char** argv) {
     server.addFeature(new ScriptFeature(&server, &ret));
     server.addFeature(new ServerFeature(&server, &ret));
     server.addFeature(new ServerIdFeature(&server));
-    server.addFeature(new ShutdownFeature(&server, {"UnitTests", "Script"}));
+    server.addFeature(new ShutdownFeature(&server, {"UnitTests", "Script", "StorageBenchmark"}));
     server.addFeature(new SslFeature(&server));
     server.addFeature(new StatisticsFeature(&server));
+    server.addFeature(new StorageBenchmarkFeature(&server, &ret));
     server.addFeature(new TempFeature(&server, name));
     server.addFeature(new TransactionManagerFeature(&server));
     server.addFeature(new TraverserEngineRegistryFeature(&server));
@@ -37,11 +37,11 @@ Acceptor::Acceptor(boost::asio::io_service& ioService, Endpoint* endpoint)
 }
 
 std::unique_ptr<Acceptor> Acceptor::factory(
-    boost::asio::io_service& ioService, Endpoint* endpoint) {
+    boost::asio::io_service& ioService, Endpoint* endpoint, bool reusePort) {
 #ifdef ARANGODB_HAVE_DOMAIN_SOCKETS
   if (endpoint->domainType() == Endpoint::DomainType::UNIX) {
     return std::make_unique<AcceptorUnixDomain>(ioService, endpoint);
   }
 #endif
-  return std::make_unique<AcceptorTcp>(ioService, endpoint);
+  return std::make_unique<AcceptorTcp>(ioService, endpoint, reusePort);
 }
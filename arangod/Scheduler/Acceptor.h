@@ -42,8 +42,11 @@ class Acceptor {
     std::unique_ptr<Socket> movePeer() { return std::move(_peer); };
   
   public:
+    // with reusePort, several acceptors can listen on the same TCP
+    // endpoint, and the kernel distributes the connections among them
     static std::unique_ptr<Acceptor> factory(
-        boost::asio::io_service& _ioService, Endpoint* endpoint);
+        boost::asio::io_service& _ioService, Endpoint* endpoint,
+        bool reusePort = false);
   
   protected:
     virtual void createPeer() = 0;
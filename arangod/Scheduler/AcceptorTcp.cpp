@@ -52,6 +52,14 @@ void AcceptorTcp::open() {
       boost::asio::ip::tcp::acceptor::reuse_address(
         ((EndpointIp*)_endpoint)->reuseAddress()));
 
+#ifdef SO_REUSEPORT
+  if (_reusePort) {
+    _acceptor.set_option(
+        boost::asio::detail::socket_option::boolean<SOL_SOCKET, SO_REUSEPORT>(
+            true));
+  }
+#endif
+
   _acceptor.bind(asioEndpoint);
   _acceptor.listen();
 }
@@ -64,11 +72,10 @@ void AcceptorTcp::asyncAccept(AcceptHandler const& handler) {
 
 void AcceptorTcp::createPeer() {
   if (_endpoint->encryption() == Endpoint::EncryptionType::SSL) {
-    _peer.reset(new SocketTcp(_ioService, SslServerFeature::SSL->createSslContext(), true));
+    // all connections share one context, so that they share the session
+    // cache and the keys of session tickets
+    _peer.reset(new SocketTcp(_ioService, SslServerFeature::SSL->sslContext(), true));
   } else {
-    _peer.reset(new SocketTcp(
-        _ioService,
-        boost::asio::ssl::context(boost::asio::ssl::context::method::sslv23),
-        false));
+    _peer.reset(new SocketTcp(_ioService, _plainContext, false));
   }
 }
@@ -28,9 +28,12 @@
 namespace arangodb {
 class AcceptorTcp final : public Acceptor {
   public:
-    AcceptorTcp(boost::asio::io_service& ioService, Endpoint* endpoint)
+    AcceptorTcp(boost::asio::io_service& ioService, Endpoint* endpoint,
+                bool reusePort)
     : Acceptor(ioService, endpoint),
-      _acceptor(ioService) {
+      _acceptor(ioService),
+      _plainContext(boost::asio::ssl::context::method::sslv23),
+      _reusePort(reusePort) {
     }
 
     void open() override;
@@ -40,6 +43,9 @@ class AcceptorTcp final : public Acceptor {
 
   private:
     boost::asio::ip::tcp::acceptor _acceptor;
+    // unencrypted connections need a context, but never use it
+    boost::asio::ssl::context _plainContext;
+    bool _reusePort;
 };
 }
 
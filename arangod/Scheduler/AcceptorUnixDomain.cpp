@@ -57,9 +57,7 @@ void AcceptorUnixDomain::asyncAccept(AcceptHandler const& handler) {
 }
 
 void AcceptorUnixDomain::createPeer() {
-  _peer.reset(new SocketUnixDomain(
-        _ioService,
-        boost::asio::ssl::context(boost::asio::ssl::context::method::sslv23)));
+  _peer.reset(new SocketUnixDomain(_ioService));
 }
 
 void AcceptorUnixDomain::close() {
@@ -28,11 +28,17 @@ using namespace arangodb;
 using namespace arangodb::rest;
 
 Job::Job(std::function<void(std::shared_ptr<RestHandler>)> callback)
-    : _server(nullptr), _handler(nullptr), _callback(callback) {}
+    : _server(nullptr),
+      _handler(nullptr),
+      _callback(callback),
+      _queueStart(TRI_microtime()) {}
 
 Job::Job(rest::GeneralServer* server, std::shared_ptr<RestHandler> handler,
          std::function<void(std::shared_ptr<RestHandler>)> callback)
-    : _server(server), _handler(std::move(handler)), _callback(callback) {}
+    : _server(server),
+      _handler(std::move(handler)),
+      _callback(callback),
+      _queueStart(TRI_microtime()) {}
 
 // trival, but needs definition of RestHandler
 Job::~Job() {}
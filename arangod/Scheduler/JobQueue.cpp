@@ -31,6 +31,38 @@
 using namespace arangodb;
 
 namespace {
+// maximum number of queued jobs a worker thread runs in a row before it
+// returns to the io_service, so that it does not delay other events
+static size_t const MAX_JOBS_IN_A_ROW = 16;
+
+// runs the job and then further queued jobs, in order of priority.
+// jobs queued while the server is busy are picked up by the threads that
+// just finished a job, and do not need to go through the queue thread
+void runJobs(JobQueue* jobQueue, Job* job) {
+  JobGuard guard(SchedulerFeature::SCHEDULER);
+  guard.work();
+
+  size_t n = 0;
+
+  while (job != nullptr) {
+    std::unique_ptr<Job> releaseGuard(job);
+
+    try {
+      job->_callback(std::move(job->_handler));
+    } catch (...) {
+    }
+
+    job = nullptr;
+
+    if (++n < MAX_JOBS_IN_A_ROW) {
+      jobQueue->popAny(job);
+    }
+  }
+
+  jobQueue->releaseActive();
+  jobQueue->wakeup();
+}
+
 class JobQueueThread final : public Thread {
  public:
   JobQueueThread(JobQueue* server, boost::asio::io_service* ioService)
@@ -70,19 +102,7 @@ class JobQueueThread final : public Thread {
 
           idleTries = 0;
 
-          _ioService->post([jobQueue, job]() {
-            JobGuard guard(SchedulerFeature::SCHEDULER);
-            guard.work();
-
-            std::unique_ptr<Job> releaseGuard(job);
-
-            try {
-              job->_callback(std::move(job->_handler));
-            } catch (...) {
-            }
-            jobQueue->releaseActive();
-            jobQueue->wakeup();
-          });
+          _ioService->post([jobQueue, job]() { runJobs(jobQueue, job); });
         }
       }
 
@@ -116,17 +136,22 @@ class JobQueueThread final : public Thread {
 // --SECTION--                                      constructors and destructors
 // -----------------------------------------------------------------------------
 
-JobQueue::JobQueue(size_t queueSize, boost::asio::io_service* ioService)
+JobQueue::JobQueue(size_t queueSize, boost::asio::io_service* ioService,
+                   double targetTime, double targetInterval)
     : _queueAql(queueSize),
       _queueRequeue(queueSize),
       _queueStandard(queueSize),
       _queueUser(queueSize),
       _queues{&_queueRequeue, &_queueAql, &_queueStandard, &_queueUser},
       _active(0),
+      _targetTime(targetTime),
+      _targetInterval(targetInterval),
+      _waiting(false),
       _ioService(ioService),
       _queueThread(new JobQueueThread(this, _ioService)) {
   for (size_t i = 0; i < SYSTEM_QUEUE_SIZE; ++i) {
     _queuesSize[i].store(0);
+    _aboveTargetSince[i].store(0.0);
   }
 }
 
@@ -143,8 +168,6 @@ void JobQueue::beginShutdown() {
 }
 
 bool JobQueue::tryActive() {
-  static size_t const MAX_ACTIVE = 10;
-  
   if (_active > MAX_ACTIVE) {
     return false;
   }
@@ -157,7 +180,32 @@ void JobQueue::releaseActive() {
   --_active;
 }
 
+bool JobQueue::shouldShed(size_t i) const {
+  // jobs of the internal queues are never rejected
+  if (_targetTime <= 0.0 || i < STANDARD_QUEUE || i >= SYSTEM_QUEUE_SIZE) {
+    return false;
+  }
+
+  double now = TRI_microtime();
+
+  for (size_t j = STANDARD_QUEUE; j <= i; ++j) {
+    if (overloaded(j, now)) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
 void JobQueue::wakeup() {
+  // queueing and finishing jobs happens very often. only take the lock
+  // if the queue thread is actually waiting. this cannot miss a wakeup:
+  // the queue thread sets _waiting before it checks for work for the last
+  // time, and we check _waiting only after the work has been added
+  if (!_waiting.load()) {
+    return;
+  }
+
   CONDITION_LOCKER(guard, _queueCondition);
   guard.signal();
 }
@@ -166,5 +214,47 @@ void JobQueue::waitForWork() {
   static uint64_t WAIT_TIME = 1000 * 1000;
 
   CONDITION_LOCKER(guard, _queueCondition);
-  guard.wait(WAIT_TIME);
+  _waiting.store(true);
+
+  bool hasWork = false;
+  if (_active.load() <= MAX_ACTIVE) {
+    for (size_t i = 0; i < SYSTEM_QUEUE_SIZE; ++i) {
+      if (_queuesSize[i].load() > 0) {
+        hasWork = true;
+        break;
+      }
+    }
+  }
+
+  if (!hasWork) {
+    guard.wait(WAIT_TIME);
+  }
+
+  _waiting.store(false);
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                   private methods
+// -----------------------------------------------------------------------------
+
+// the queue counts as overloaded when the time the jobs spent waiting in it
+// stays above the target time for a whole interval, similar to CoDel. short
+// bursts that are worked off quickly do not cause any rejections
+void JobQueue::trackQueueTime(size_t i, Job const* job) {
+  if (_targetTime <= 0.0) {
+    return;
+  }
+
+  double now = TRI_microtime();
+
+  if (now - job->_queueStart < _targetTime) {
+    _aboveTargetSince[i].store(0.0);
+  } else if (_aboveTargetSince[i].load() == 0.0) {
+    _aboveTargetSince[i].store(now);
+  }
+}
+
+bool JobQueue::overloaded(size_t i, double now) const {
+  double since = _aboveTargetSince[i].load();
+  return since != 0.0 && now - since >= _targetInterval;
 }
@@ -42,8 +42,12 @@ class JobQueue {
   static size_t const USER_QUEUE = 3;
   static size_t const SYSTEM_QUEUE_SIZE = 4;
 
+  // maximum number of jobs running at the same time
+  static size_t const MAX_ACTIVE = 10;
+
  public:
-  JobQueue(size_t queueSize, boost::asio::io_service* ioService);
+  JobQueue(size_t queueSize, boost::asio::io_service* ioService,
+           double targetTime, double targetInterval);
 
  public:
   void start();
@@ -81,11 +85,26 @@ class JobQueue {
 
     if (ok) {
       --_queuesSize[i];
+      trackQueueTime(i, job);
+    } else if (_targetTime > 0.0) {
+      // an empty queue is never overloaded
+      _aboveTargetSince[i].store(0.0);
     }
 
     return ok;
   }
 
+  // pops the job with the highest priority from any queue
+  bool popAny(Job*& job) {
+    for (size_t i = 0; i < SYSTEM_QUEUE_SIZE; ++i) {
+      if (pop(i, job)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // wakes up the queue thread, but only if it is waiting
   void wakeup();
   void waitForWork();
 
@@ -93,6 +112,16 @@ class JobQueue {
   bool tryActive();
   void releaseActive();
 
+  // whether new low-priority jobs for queue i should be rejected, because
+  // the jobs of this queue (or of a queue of higher priority but still
+  // subject to shedding) have been waiting longer than the target time
+  // for at least the target interval
+  bool shouldShed(size_t i) const;
+
+ private:
+  void trackQueueTime(size_t i, Job const* job);
+  bool overloaded(size_t i, double now) const;
+
  private:
   boost::lockfree::queue<Job*> _queueAql;
   boost::lockfree::queue<Job*> _queueRequeue;
@@ -102,6 +131,18 @@ class JobQueue {
   std::atomic<int64_t> _queuesSize[SYSTEM_QUEUE_SIZE];
   std::atomic<size_t> _active;
 
+  // time a job may wait in the queue before the queue counts as overloaded,
+  // 0 disables load shedding
+  double const _targetTime;
+  // time the queue waiting time must stay above the target before jobs are
+  // rejected
+  double const _targetInterval;
+  // start of the current period in which the jobs taken from a queue waited
+  // longer than the target time, 0 if not in such a period
+  std::atomic<double> _aboveTargetSince[SYSTEM_QUEUE_SIZE];
+
+  // set while the queue thread is waiting (or about to wait) for work
+  std::atomic<bool> _waiting;
   basics::ConditionVariable _queueCondition;
 
   boost::asio::io_service* _ioService;
@@ -36,12 +36,12 @@ using namespace arangodb::rest;
 // --SECTION--                                      constructors and destructors
 // -----------------------------------------------------------------------------
 
-ListenTask::ListenTask(EventLoop loop, Endpoint* endpoint)
+ListenTask::ListenTask(EventLoop loop, Endpoint* endpoint, bool reusePort)
     : Task(loop, "ListenTask"),
       _endpoint(endpoint),
       _bound(false),
       _ioService(loop._ioService),
-      _acceptor(Acceptor::factory(*loop._ioService, endpoint)) {}
+      _acceptor(Acceptor::factory(*loop._ioService, endpoint, reusePort)) {}
 
 // -----------------------------------------------------------------------------
 // --SECTION--                                                    public methods
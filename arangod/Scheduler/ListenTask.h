@@ -38,7 +38,7 @@ class ListenTask : virtual public rest::Task {
   static size_t const MAX_ACCEPT_ERRORS = 128;
 
  public:
-  ListenTask(EventLoop, Endpoint*);
+  ListenTask(EventLoop, Endpoint*, bool reusePort = false);
 
  public:
   virtual void handleConnected(std::unique_ptr<Socket>, ConnectionInfo&&) = 0;
@@ -31,7 +31,9 @@
 #include <velocypack/Builder.h>
 #include <velocypack/velocypack-aliases.h>
 
+#include "Basics/CpuProfiler.h"
 #include "Basics/MutexLocker.h"
+#include "Basics/NumaTopology.h"
 #include "Basics/StringUtils.h"
 #include "Basics/Thread.h"
 #include "Logger/Logger.h"
@@ -77,6 +79,41 @@ class SchedulerManagerThread : public Thread {
 };
 }
 
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 SchedulerIoThread
+// -----------------------------------------------------------------------------
+
+namespace {
+class SchedulerIoThread : public Thread {
+ public:
+  SchedulerIoThread(Scheduler* scheduler, boost::asio::io_service* service,
+                    std::string const& name)
+      : Thread(name), _scheduler(scheduler), _service(service) {}
+
+  ~SchedulerIoThread() { shutdown(); }
+
+ public:
+  void run() {
+    // the thread runs its io_service for the whole lifetime of the
+    // scheduler, it is not subject to rebalancing
+    while (!_scheduler->isStopping() && !_service->stopped()) {
+      try {
+        _service->run();
+      } catch (...) {
+        LOG_TOPIC(ERR, Logger::THREADS)
+            << "I/O loop caught an error, restarting";
+      }
+    }
+
+    _scheduler->threadDone(this);
+  }
+
+ private:
+  Scheduler* _scheduler;
+  boost::asio::io_service* _service;
+};
+}
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                   SchedulerThread
 // -----------------------------------------------------------------------------
@@ -95,6 +132,10 @@ class SchedulerThread : public Thread {
     LOG_TOPIC(DEBUG, Logger::THREADS) << "running (" << _scheduler->infoStatus()
                                       << ")";
 
+    // the scheduler threads run the request handlers, so they are the ones
+    // CPU profiles are interested in
+    CpuProfiler::registerThread();
+
     auto start = std::chrono::steady_clock::now();
 
     try {
@@ -136,6 +177,7 @@ class SchedulerThread : public Thread {
       _scheduler->startNewThread();
     }
 
+    CpuProfiler::unregisterThread();
     _scheduler->threadDone(this);
   }
 
@@ -155,7 +197,12 @@ class SchedulerThread : public Thread {
 
 Scheduler::Scheduler(size_t nrThreads, size_t maxQueueSize)
     : _nrThreads(nrThreads),
+      _nrIoThreads(0),
+      _nrHandshakeThreads(0),
       _maxQueueSize(maxQueueSize),
+      _nextNumaNode(0),
+      _queueTargetTime(0.0),
+      _queueTargetInterval(0.0),
       _stopping(false),
       _nrWorking(0),
       _nrBlocked(0),
@@ -199,6 +246,26 @@ void Scheduler::post(std::function<void()> callback) {
   });
 }
 
+void Scheduler::post(EventLoop const& loop, std::function<void()> callback) {
+  if (!isIoLoop(loop)) {
+    post(std::move(callback));
+    return;
+  }
+
+  // the I/O threads are not part of the thread accounting, so there is no
+  // JobGuard here
+  loop._ioService->post(std::move(callback));
+}
+
+bool Scheduler::postHandshake(std::function<void()> callback) {
+  if (_handshakeService == nullptr) {
+    return false;
+  }
+
+  _handshakeService->post(std::move(callback));
+  return true;
+}
+
 bool Scheduler::start(ConditionVariable* cv) {
   // start the I/O
   startIoService();
@@ -220,11 +287,13 @@ bool Scheduler::start(ConditionVariable* cv) {
     startNewThread();
   }
 
+  startIoThreads();
   startManagerThread();
   startRebalancer();
 
   // initialize the queue handling
-  _jobQueue.reset(new JobQueue(_maxQueueSize, _ioService.get()));
+  _jobQueue.reset(new JobQueue(_maxQueueSize, _ioService.get(),
+                               _queueTargetTime, _queueTargetInterval));
   _jobQueue->start();
 
   // done
@@ -236,10 +305,50 @@ void Scheduler::startIoService() {
   _ioService.reset(new boost::asio::io_service());
   _serviceGuard.reset(new boost::asio::io_service::work(*_ioService));
 
+  // one io_service per I/O thread avoids the locking of a shared
+  // io_service and lets every loop have its own epoll instance
+  for (size_t i = 0; i < _nrIoThreads; ++i) {
+    _ioLoops.emplace_back(new boost::asio::io_service(1));
+    _ioLoopGuards.emplace_back(
+        new boost::asio::io_service::work(*_ioLoops.back()));
+  }
+
+  if (_nrHandshakeThreads > 0) {
+    _handshakeService.reset(new boost::asio::io_service());
+    _handshakeGuard.reset(
+        new boost::asio::io_service::work(*_handshakeService));
+  }
+
   _managerService.reset(new boost::asio::io_service());
   _managerGuard.reset(new boost::asio::io_service::work(*_managerService));
 }
 
+void Scheduler::startIoThreads() {
+  MUTEX_LOCKER(guard, _threadsLock);
+
+  for (size_t i = 0; i < _ioLoops.size(); ++i) {
+    auto thread =
+        new SchedulerIoThread(this, _ioLoops[i].get(), "SchedulerIo");
+
+    // a connection stays on the loop that accepted it, so its buffers are
+    // allocated on the node of that loop
+    if (NumaTopology::enabled()) {
+      thread->setNumaNode(i % NumaTopology::numberOfNodes());
+    }
+
+    _threads.emplace(thread);
+    thread->start();
+  }
+
+  for (size_t i = 0; i < _nrHandshakeThreads; ++i) {
+    auto thread =
+        new SchedulerIoThread(this, _handshakeService.get(), "SslHandshake");
+
+    _threads.emplace(thread);
+    thread->start();
+  }
+}
+
 void Scheduler::startRebalancer() {
   std::chrono::milliseconds interval(500);
   _threadManager.reset(new boost::asio::steady_timer(*_managerService));
@@ -275,6 +384,13 @@ void Scheduler::startNewThread() {
 
   auto thread = new SchedulerThread(this, _ioService.get());
 
+  // spread the threads evenly across the nodes, so each node works on
+  // its share of the requests with local memory
+  if (NumaTopology::enabled()) {
+    thread->setNumaNode(_nextNumaNode);
+    _nextNumaNode = (_nextNumaNode + 1) % NumaTopology::numberOfNodes();
+  }
+
   _threads.emplace(thread);
   thread->start();
 }
@@ -386,6 +502,17 @@ void Scheduler::beginShutdown() {
   _serviceGuard.reset();
   _ioService->stop();
 
+  _ioLoopGuards.clear();
+
+  for (auto& ioLoop : _ioLoops) {
+    ioLoop->stop();
+  }
+
+  if (_handshakeService != nullptr) {
+    _handshakeGuard.reset();
+    _handshakeService->stop();
+  }
+
   // set the flag AFTER stopping the threads
   _stopping = true;
 }
@@ -401,6 +528,8 @@ void Scheduler::shutdown() {
   deleteOldThreads();
 
   _managerService.reset();
+  _ioLoops.clear();
+  _handshakeService.reset();
   _ioService.reset();
 }
 
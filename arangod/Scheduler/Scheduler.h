@@ -71,8 +71,35 @@ class Scheduler {
     return EventLoop{_ioService.get(), this};
   }
 
+  // number of dedicated I/O event loops, 0 if all I/O runs on the shared
+  // io_service
+  size_t numIoLoops() const { return _ioLoops.size(); }
+
+  // a dedicated I/O event loop. it is run by exactly one thread, so all
+  // connections accepted on it are handled by that thread
+  EventLoop ioEventLoop(size_t index) {
+    TRI_ASSERT(index < _ioLoops.size());
+    return EventLoop{_ioLoops[index].get(), this};
+  }
+
+  // whether an event loop is a dedicated I/O loop. the thread of such a
+  // loop must not run request handlers, as it would stall all connections
+  // of the loop meanwhile
+  bool isIoLoop(EventLoop const& loop) const {
+    return loop._ioService != _ioService.get();
+  }
+
   void post(std::function<void()> callback);
 
+  // post a callback to the event loop a connection belongs to. callbacks
+  // for connections on a dedicated I/O loop stay on the thread of the loop
+  void post(EventLoop const& loop, std::function<void()> callback);
+
+  // run the TLS handshake of a new connection on the handshake threads, so
+  // it does not delay the other connections of the accepting event loop.
+  // returns false if there are no handshake threads
+  bool postHandshake(std::function<void()> callback);
+
   bool start(basics::ConditionVariable*);
   bool isRunning() { return _nrRunning.load() > 0; }
 
@@ -94,13 +121,23 @@ class Scheduler {
     return false;
   }
 
+  void setIoThreads(size_t ioThreads) { _nrIoThreads = ioThreads; }
+  void setHandshakeThreads(size_t threads) { _nrHandshakeThreads = threads; }
   void setMinimal(int64_t minimal) { _nrMinimal = minimal; }
   void setMaximal(int64_t maximal) { _nrMaximal = maximal; }
   void setRealMaximum(int64_t maximum) { _nrRealMaximum = maximum; }
+  void setQueueTarget(double targetTime, double targetInterval) {
+    _queueTargetTime = targetTime;
+    _queueTargetInterval = targetInterval;
+  }
 
   uint64_t incRunning() { return ++_nrRunning; }
   uint64_t decRunning() { return --_nrRunning; }
 
+  int64_t numWorking() const { return _nrWorking; }
+  int64_t numBlocked() const { return _nrBlocked; }
+  int64_t numRunning() const { return _nrRunning; }
+
   std::string infoStatus() {
     return "working: " + std::to_string(_nrWorking) + ", blocked: " +
            std::to_string(_nrBlocked) + ", running: " +
@@ -122,14 +159,23 @@ class Scheduler {
   void unblockThread() { --_nrBlocked; }
 
   void startIoService();
+  void startIoThreads();
   void startRebalancer();
   void startManagerThread();
   void rebalanceThreads();
 
  private:
   size_t _nrThreads;
+  size_t _nrIoThreads;
+  size_t _nrHandshakeThreads;
   size_t _maxQueueSize;
 
+  // NUMA node of the next scheduler thread, protected by _threadsLock
+  size_t _nextNumaNode;
+
+  double _queueTargetTime;
+  double _queueTargetInterval;
+
   std::atomic<bool> _stopping;
 
   std::atomic<int64_t> _nrWorking;
@@ -146,6 +192,12 @@ class Scheduler {
   boost::shared_ptr<boost::asio::io_service::work> _serviceGuard;
   std::unique_ptr<boost::asio::io_service> _ioService;
 
+  std::vector<boost::shared_ptr<boost::asio::io_service::work>> _ioLoopGuards;
+  std::vector<std::unique_ptr<boost::asio::io_service>> _ioLoops;
+
+  boost::shared_ptr<boost::asio::io_service::work> _handshakeGuard;
+  std::unique_ptr<boost::asio::io_service> _handshakeService;
+
   boost::shared_ptr<boost::asio::io_service::work> _managerGuard;
   std::unique_ptr<boost::asio::io_service> _managerService;
 
@@ -30,12 +30,15 @@
 
 #include "ApplicationFeatures/ApplicationServer.h"
 #include "Basics/ArangoGlobalContext.h"
+#include "Basics/NumaTopology.h"
 #include "Basics/WorkMonitor.h"
 #include "Logger/LogAppender.h"
 #include "ProgramOptions/ProgramOptions.h"
 #include "ProgramOptions/Section.h"
 #include "RestServer/ServerFeature.h"
+#include "Scheduler/JobQueue.h"
 #include "Scheduler/Scheduler.h"
+#include "Statistics/MetricsRegistry.h"
 #include "V8Server/V8DealerFeature.h"
 #include "V8Server/v8-dispatcher.h"
 
@@ -73,10 +76,40 @@ void SchedulerFeature::collectOptions(
   options->addHiddenOption("--server.maximal-threads", "maximal number of threads",
                      new Int64Parameter(&_nrMaximalThreads));
 
+  options->addOption("--server.io-threads",
+                     "number of threads with an event loop of their own for "
+                     "network I/O. each of them accepts connections on its "
+                     "own socket via SO_REUSEPORT and handles them until "
+                     "they are closed (0 = all I/O runs on the scheduler "
+                     "threads)",
+                     new UInt64Parameter(&_nrIoThreads));
+
+  options->addOption("--server.handshake-threads",
+                     "number of threads performing the TLS handshakes of "
+                     "new connections (0 = handshakes run on the thread "
+                     "accepting the connection)",
+                     new UInt64Parameter(&_nrHandshakeThreads));
+
+  options->addOption("--server.numa-aware",
+                     "bind scheduler and I/O threads to the NUMA nodes "
+                     "round-robin and place cache and index memory per node",
+                     new BooleanParameter(&_numaAware));
+
   options->addOption("--server.maximal-queue-size",
                      "maximum queue length for asynchronous operations",
                      new UInt64Parameter(&_queueSize));
 
+  options->addOption("--server.queue-target-time",
+                     "maximum time (in seconds) low-priority requests may "
+                     "wait in the queue before new ones are rejected with "
+                     "HTTP 503 (0 = never reject)",
+                     new DoubleParameter(&_queueTargetTime));
+
+  options->addOption("--server.queue-target-interval",
+                     "time (in seconds) the queue waiting time must stay above "
+                     "the target time before requests are rejected",
+                     new DoubleParameter(&_queueTargetInterval));
+
   options->addOldOption("scheduler.threads", "server.threads");
 }
 
@@ -93,6 +126,42 @@ void SchedulerFeature::validateOptions(
     FATAL_ERROR_EXIT();
   }
 
+  if (_queueTargetTime < 0.0) {
+    LOG_TOPIC(FATAL, arangodb::Logger::FIXME)
+        << "invalid value for `--server.queue-target-time', must not be "
+           "negative";
+    FATAL_ERROR_EXIT();
+  }
+
+  if (_queueTargetInterval <= 0.0) {
+    LOG_TOPIC(FATAL, arangodb::Logger::FIXME)
+        << "invalid value for `--server.queue-target-interval', must be "
+           "positive";
+    FATAL_ERROR_EXIT();
+  }
+
+#ifndef SO_REUSEPORT
+  if (_nrIoThreads > 0) {
+    LOG_TOPIC(WARN, arangodb::Logger::FIXME)
+        << "`--server.io-threads' needs SO_REUSEPORT, which this platform "
+           "does not support. ignoring it";
+    _nrIoThreads = 0;
+  }
+#endif
+
+  // this must happen before the caches and indexes allocate memory
+  if (_numaAware) {
+    if (NumaTopology::setEnabled(true)) {
+      LOG_TOPIC(INFO, arangodb::Logger::FIXME)
+          << "placing threads and memory on "
+          << NumaTopology::numberOfNodes() << " NUMA nodes";
+    } else {
+      LOG_TOPIC(INFO, arangodb::Logger::FIXME)
+          << "ignoring `--server.numa-aware', the machine has only one "
+             "NUMA node";
+    }
+  }
+
   if (_nrMinimalThreads != 0 && _nrMaximalThreads != 0 && _nrMinimalThreads > _nrMaximalThreads) {
     _nrMaximalThreads = _nrMinimalThreads;
   }
@@ -111,6 +180,8 @@ void SchedulerFeature::start() {
 
   buildHangupHandler();
 
+  registerMetrics();
+
   LOG_TOPIC(DEBUG, Logger::STARTUP) << "scheduler has started";
 
   V8DealerFeature* dealer =
@@ -126,6 +197,11 @@ void SchedulerFeature::start() {
 void SchedulerFeature::stop() {
   static size_t const MAX_TRIES = 10;
 
+  MetricsRegistry::remove("arangodb_scheduler_threads_working");
+  MetricsRegistry::remove("arangodb_scheduler_threads_blocked");
+  MetricsRegistry::remove("arangodb_scheduler_threads_running");
+  MetricsRegistry::remove("arangodb_scheduler_queue_length");
+
   // shutdown user jobs (needs the scheduler)
   TRI_ShutdownV8Dispatcher();
 
@@ -232,13 +308,50 @@ bool CtrlHandler(DWORD eventType) {
 
 #endif
 
+void SchedulerFeature::registerMetrics() {
+  rest::Scheduler* scheduler = _scheduler.get();
+
+  MetricsRegistry::addGauge(
+      "arangodb_scheduler_threads_working",
+      "Number of scheduler threads executing a job",
+      [scheduler]() { return static_cast<double>(scheduler->numWorking()); });
+  MetricsRegistry::addGauge(
+      "arangodb_scheduler_threads_blocked",
+      "Number of scheduler threads blocked in a job",
+      [scheduler]() { return static_cast<double>(scheduler->numBlocked()); });
+  MetricsRegistry::addGauge(
+      "arangodb_scheduler_threads_running",
+      "Number of scheduler threads",
+      [scheduler]() { return static_cast<double>(scheduler->numRunning()); });
+
+  std::vector<std::pair<size_t, char const*>> const queues = {
+      {JobQueue::REQUEUED_QUEUE, "requeued"},
+      {JobQueue::AQL_QUEUE, "aql"},
+      {JobQueue::STANDARD_QUEUE, "standard"},
+      {JobQueue::USER_QUEUE, "user"}};
+
+  for (auto const& queue : queues) {
+    size_t const i = queue.first;
+
+    MetricsRegistry::addGauge(
+        std::string("arangodb_scheduler_queue_length{queue=\"") +
+            queue.second + "\"}",
+        "Number of jobs waiting in a scheduler queue", [scheduler, i]() {
+          return static_cast<double>(scheduler->jobQueue()->queueSize(i));
+        });
+  }
+}
+
 void SchedulerFeature::buildScheduler() {
   _scheduler =
       std::make_unique<Scheduler>(static_cast<size_t>(_nrServerThreads),
                                   static_cast<size_t>(_queueSize));
 
+  _scheduler->setIoThreads(static_cast<size_t>(_nrIoThreads));
+  _scheduler->setHandshakeThreads(static_cast<size_t>(_nrHandshakeThreads));
   _scheduler->setMinimal(_nrMinimalThreads);
   _scheduler->setRealMaximum(_nrMaximalThreads);
+  _scheduler->setQueueTarget(_queueTargetTime, _queueTargetInterval);
  
   TRI_ASSERT(SCHEDULER == nullptr); 
   SCHEDULER = _scheduler.get();
@@ -53,9 +53,14 @@ class SchedulerFeature final : public application_features::ApplicationFeature {
 
  private:
   uint64_t _nrServerThreads = 0;
+  uint64_t _nrIoThreads = 0;
+  uint64_t _nrHandshakeThreads = 2;
+  bool _numaAware = false;
   int64_t _nrMinimalThreads = 0;
   int64_t _nrMaximalThreads = 0;
   uint64_t _queueSize = 128;
+  double _queueTargetTime = 0.0;
+  double _queueTargetInterval = 0.5;
 
  public:
   size_t concurrency() const {
@@ -66,6 +71,7 @@ class SchedulerFeature final : public application_features::ApplicationFeature {
 
  private:
   void buildScheduler();
+  void registerMetrics();
 
  private:
   std::unique_ptr<rest::Scheduler> _scheduler;
@@ -33,60 +33,69 @@
 #include "Basics/asio-helper.h"
 #include "Logger/Logger.h"
 
+#ifdef TRI_HAVE_POLL_H
+#include <poll.h>
+#endif
+
 namespace arangodb {
 
 typedef std::function<void(const boost::system::error_code& ec,
                            std::size_t transferred)>
     AsyncHandler;
 
+// the parts of an outgoing message, written with a single system call
+// without being copied into one buffer first
+typedef std::array<boost::asio::const_buffer, 2> BufferSequence;
+
 namespace socketcommon {
+/// @brief wait until a socket has data to read or the timeout (in seconds)
+/// has passed. the handshake of a non-blocking socket would otherwise spin
+static inline void waitForSocket(int fd, double timeout) {
+#ifdef TRI_HAVE_POLL_H
+  struct pollfd poller;
+  memset(&poller, 0, sizeof(struct pollfd));
+  poller.fd = fd;
+  poller.events = POLLIN;
+
+  // writes of the handshake block rarely, they are retried after a slice
+  int ms = static_cast<int>(std::min(timeout, 0.1) * 1000.0);
+  (void)poll(&poller, 1, ms < 1 ? 1 : ms);
+#else
+  usleep(10000);
+#endif
+}
+
 template <typename T>
 bool doSslHandshake(T& socket) {
   boost::system::error_code ec;
 
-  uint64_t tries = 0;
-  double start = 0.0;
+  // handshakes of connections whose peer went away meanwhile would hang
+  // forever, so they are aborted after some time
+  double const maxTime = 3.0;
+  double const start = TRI_microtime();
 
   while (true) {
     ec.assign(boost::system::errc::success,
-	boost::system::generic_category());
+        boost::system::generic_category());
     socket.handshake(
-	boost::asio::ssl::stream_base::handshake_type::server, ec);
+        boost::asio::ssl::stream_base::handshake_type::server, ec);
 
     if (ec.value() != boost::asio::error::would_block) {
       break;
     }
 
-    // got error EWOULDBLOCK and need to try again
-    ++tries;
-
-    // following is a helpless fix for connections hanging in the handshake
-    // phase forever. we've seen this happening when the underlying peer
-    // connection was closed during the handshake.
-    // with the helpless fix, handshakes will be aborted it they take longer 
-    // than x seconds. a proper fix is to make the handshake run asynchronously
-    // and somehow signal it that the connection got closed. apart from that
-    // running it asynchronously will not block the scheduler thread as it 
-    // does now. anyway, even the helpless fix allows self-healing of busy
-    // scheduler threads after a network failure
-    if (tries == 1) {
-      // capture start time of handshake
-      start = TRI_microtime();
-    } else if (tries % 50 == 0) {
-      // check if we have spent more than x seconds handshaking and then abort
-      TRI_ASSERT(start != 0.0);
-
-      if (TRI_microtime() - start >= 3) {
-	ec.assign(boost::asio::error::connection_reset,
-	    boost::system::generic_category());
-	LOG_TOPIC(DEBUG, Logger::COMMUNICATION) << "forcefully shutting down connection after wait time";
-	break;
-      } else {
-	usleep(10000);
-      }
+    // got error EWOULDBLOCK and need to wait for the peer
+    double const elapsed = TRI_microtime() - start;
+
+    if (elapsed >= maxTime) {
+      ec.assign(boost::asio::error::connection_reset,
+          boost::system::generic_category());
+      LOG_TOPIC(DEBUG, Logger::COMMUNICATION) << "forcefully shutting down connection after wait time";
+      break;
     }
 
-    // next iteration
+    waitForSocket(static_cast<int>(socket.lowest_layer().native_handle()),
+                  maxTime - elapsed);
   }
 
   if (ec) {
@@ -99,15 +108,14 @@ bool doSslHandshake(T& socket) {
 }
 
 template <typename T>
-size_t doWrite(T& socket, basics::StringBuffer* buffer,
+size_t doWrite(T& socket, BufferSequence const& buffers,
                boost::system::error_code& ec) {
-  return socket.write_some(
-      boost::asio::buffer(buffer->begin(), buffer->length()), ec);
+  return socket.write_some(buffers, ec);
 }
 template <typename T>
-void doAsyncWrite(T& socket, boost::asio::mutable_buffers_1 const& buffer,
+void doAsyncWrite(T& socket, BufferSequence const& buffers,
                   AsyncHandler const& handler) {
-  return boost::asio::async_write(socket, buffer, handler);
+  return boost::asio::async_write(socket, buffers, handler);
 }
 template <typename T>
 size_t doRead(T& socket, boost::asio::mutable_buffers_1 const& buffer,
@@ -123,11 +131,8 @@ void doAsyncRead(T& socket, boost::asio::mutable_buffers_1 const& buffer,
 
 class Socket {
  public:
-  Socket(boost::asio::io_service& ioService,
-         boost::asio::ssl::context&& context, bool encrypted)
-      : _ioService(ioService),
-        _context(std::move(context)),
-        _encrypted(encrypted) {}
+  Socket(boost::asio::io_service& ioService, bool encrypted)
+      : _ioService(ioService), _encrypted(encrypted) {}
   Socket(Socket&& that) = delete;
   virtual ~Socket() {}
 
@@ -137,9 +142,9 @@ class Socket {
   virtual std::string peerAddress() = 0;
   virtual int peerPort() = 0;
   bool handshake();
-  virtual size_t write(basics::StringBuffer* buffer,
+  virtual size_t write(BufferSequence const& buffers,
                        boost::system::error_code& ec) = 0;
-  virtual void asyncWrite(boost::asio::mutable_buffers_1 const& buffer,
+  virtual void asyncWrite(BufferSequence const& buffers,
                           AsyncHandler const& handler) = 0;
   virtual size_t read(boost::asio::mutable_buffers_1 const& buffer,
                       boost::system::error_code& ec) = 0;
@@ -155,7 +160,6 @@ class Socket {
 
  public:
   boost::asio::io_service& _ioService;
-  boost::asio::ssl::context _context;
 
   bool _encrypted;
   bool _handshakeDone = false;
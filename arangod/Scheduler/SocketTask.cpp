@@ -112,7 +112,7 @@ void SocketTask::start() {
       << _connectionInfo.clientPort;
 
   auto self = shared_from_this();
-  _loop._scheduler->post([self, this]() { asyncReadSome(); });
+  _loop._scheduler->post(_loop, [self, this]() { asyncReadSome(); });
 }
 
 // -----------------------------------------------------------------------------
@@ -129,7 +129,7 @@ void SocketTask::addWriteBuffer(WriteBuffer& buffer) {
   {
     auto self = shared_from_this();
 
-    _loop._scheduler->post([self, this]() {
+    _loop._scheduler->post(_loop, [self, this]() {
       MUTEX_LOCKER(locker, _readLock);
       processAll();
     });
@@ -149,13 +149,26 @@ void SocketTask::addWriteBuffer(WriteBuffer& buffer) {
   writeWriteBuffer();
 }
 
+// will acquire the _writeLock
+void SocketTask::startWriting() {
+  if (_closedSend) {
+    return;
+  }
+
+  MUTEX_LOCKER(locker, _writeLock);
+
+  if (_writeBuffer.empty() && nextWriteBuffer(_writeBuffer)) {
+    writeWriteBuffer();
+  }
+}
+
 // caller must hold the _writeLock
 void SocketTask::writeWriteBuffer() {
   if (_writeBuffer.empty()) {
     return;
   }
 
-  size_t total = _writeBuffer._buffer->length();
+  size_t total = _writeBuffer.length();
   size_t written = 0;
 
   boost::system::error_code err;
@@ -163,7 +176,7 @@ void SocketTask::writeWriteBuffer() {
 
   while (true) {
     RequestStatistics::SET_WRITE_START(_writeBuffer._statistics);
-    written = _peer->write(_writeBuffer._buffer, err);
+    written = _peer->write(_writeBuffer.buffers(0), err);
 
     if (err) {
       break;
@@ -182,7 +195,7 @@ void SocketTask::writeWriteBuffer() {
     }
 
     // try to send next buffer
-    total = _writeBuffer._buffer->length();
+    total = _writeBuffer.length();
     written = 0;
   }
 
@@ -197,8 +210,7 @@ void SocketTask::writeWriteBuffer() {
   // so the code could have blocked at this point or not all data
   // was written in one go, begin writing at offset (written)
   auto self = shared_from_this();
-  _peer->asyncWrite(boost::asio::buffer(_writeBuffer._buffer->begin() + written,
-                                        total - written),
+  _peer->asyncWrite(_writeBuffer.buffers(written),
                     [self, this](const boost::system::error_code& ec,
                                  std::size_t transferred) {
                       MUTEX_LOCKER(locker, _writeLock);
@@ -212,7 +224,7 @@ void SocketTask::writeWriteBuffer() {
                         closeStreamNoLock();
                       } else {
                         if (completedWriteBuffer()) {
-                          _loop._scheduler->post([self, this]() {
+                          _loop._scheduler->post(_loop, [self, this]() {
                             MUTEX_LOCKER(locker, _writeLock);
                             writeWriteBuffer();
                           });
@@ -227,6 +239,10 @@ bool SocketTask::completedWriteBuffer() {
   _writeBuffer.release();
 
   if (_writeBuffers.empty()) {
+    if (nextWriteBuffer(_writeBuffer)) {
+      return true;
+    }
+
     if (_closeRequested) {
       closeStreamNoLock();
     }
@@ -471,7 +487,11 @@ void SocketTask::asyncReadSome() {
   auto handler = [self, this](const boost::system::error_code& ec,
                               std::size_t transferred) {
     JobGuard guard(_loop);
-    guard.work();
+
+    // the thread of a dedicated I/O loop is not a scheduler thread
+    if (!_loop._scheduler->isIoLoop(_loop)) {
+      guard.work();
+    }
 
     MUTEX_LOCKER(locker, _readLock);
 
@@ -483,7 +503,7 @@ void SocketTask::asyncReadSome() {
       _readBuffer.increaseLength(transferred);
 
       if (processAll()) {
-        _loop._scheduler->post([self, this]() { asyncReadSome(); });
+        _loop._scheduler->post(_loop, [self, this]() { asyncReadSome(); });
       }
     }
   };
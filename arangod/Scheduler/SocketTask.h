@@ -70,17 +70,27 @@ class SocketTask : virtual public Task {
  protected:
   struct WriteBuffer {
     basics::StringBuffer* _buffer;
+    // optional second part, e.g. a large response body, which is written
+    // after _buffer without being copied into it
+    basics::StringBuffer* _body;
     RequestStatistics* _statistics;
 
     WriteBuffer(basics::StringBuffer* buffer, RequestStatistics* statistics)
-        : _buffer(buffer), _statistics(statistics) {}
+        : _buffer(buffer), _body(nullptr), _statistics(statistics) {}
+
+    WriteBuffer(basics::StringBuffer* buffer, basics::StringBuffer* body,
+                RequestStatistics* statistics)
+        : _buffer(buffer), _body(body), _statistics(statistics) {}
     
     WriteBuffer(WriteBuffer const&) = delete;
     WriteBuffer& operator=(WriteBuffer const&) = delete;
 
     WriteBuffer(WriteBuffer&& other) 
-        : _buffer(other._buffer), _statistics(other._statistics) {
+        : _buffer(other._buffer),
+          _body(other._body),
+          _statistics(other._statistics) {
       other._buffer = nullptr;
+      other._body = nullptr;
       other._statistics = nullptr;
     }
 
@@ -91,9 +101,11 @@ class SocketTask : virtual public Task {
 
         // take over ownership from other
         _buffer = other._buffer;
+        _body = other._body;
         _statistics = other._statistics;
         // fix other
         other._buffer = nullptr;
+        other._body = nullptr;
         other._statistics = nullptr;
       }
       return *this;
@@ -104,9 +116,34 @@ class SocketTask : virtual public Task {
     bool empty() const {
       return _buffer == nullptr;
     }
+
+    // total number of bytes to write
+    size_t length() const {
+      return _buffer->length() + (_body == nullptr ? 0 : _body->length());
+    }
+
+    // the bytes still to write after the first offset bytes
+    BufferSequence buffers(size_t offset) const {
+      size_t const length = _buffer->length();
+      size_t const bodyOffset = (offset > length) ? offset - length : 0;
+      BufferSequence result;
+
+      if (offset < length) {
+        result[0] = boost::asio::const_buffer(_buffer->begin() + offset,
+                                              length - offset);
+      }
+
+      if (_body != nullptr && bodyOffset < _body->length()) {
+        result[1] = boost::asio::const_buffer(_body->begin() + bodyOffset,
+                                              _body->length() - bodyOffset);
+      }
+
+      return result;
+    }
     
     void clear() {
       _buffer = nullptr;
+      _body = nullptr;
       _statistics = nullptr;
     }
 
@@ -116,6 +153,11 @@ class SocketTask : virtual public Task {
         _buffer = nullptr;
       }
 
+      if (_body != nullptr) {
+        delete _body;
+        _body = nullptr;
+      }
+
       if (_statistics != nullptr) {
         _statistics->release();
         _statistics = nullptr;
@@ -126,6 +168,15 @@ class SocketTask : virtual public Task {
   // will acquire the _writeLock
   void addWriteBuffer(WriteBuffer&);
 
+  // will acquire the _writeLock. starts writing the buffers provided by
+  // nextWriteBuffer() if nothing is being written at the moment
+  void startWriting();
+
+  // caller must hold the _writeLock. provides the next buffer to write
+  // once all buffers added via addWriteBuffer() have been written. this
+  // allows sub-classes to decide about the order of their output late
+  virtual bool nextWriteBuffer(WriteBuffer&) { return false; }
+
   // will acquire the _writeLock
   void closeStream();
 
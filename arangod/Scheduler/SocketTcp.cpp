@@ -24,23 +24,23 @@
 
 using namespace arangodb;
 
-size_t SocketTcp::write(basics::StringBuffer* buffer,
+size_t SocketTcp::write(BufferSequence const& buffers,
                         boost::system::error_code& ec) {
   MUTEX_LOCKER(guard, _lock);
   if (_encrypted) {
-    return socketcommon::doWrite(_sslSocket, buffer, ec);
+    return socketcommon::doWrite(_sslSocket, buffers, ec);
   } else {
-    return socketcommon::doWrite(_socket, buffer, ec);
+    return socketcommon::doWrite(_socket, buffers, ec);
   }
 }
 
-void SocketTcp::asyncWrite(boost::asio::mutable_buffers_1 const& buffer,
+void SocketTcp::asyncWrite(BufferSequence const& buffers,
                            AsyncHandler const& handler) {
   MUTEX_LOCKER(guard, _lock);
   if (_encrypted) {
-    return socketcommon::doAsyncWrite(_sslSocket, buffer, handler);
+    return socketcommon::doAsyncWrite(_sslSocket, buffers, handler);
   } else {
-    return socketcommon::doAsyncWrite(_socket, buffer, handler);
+    return socketcommon::doAsyncWrite(_socket, buffers, handler);
   }
 }
 
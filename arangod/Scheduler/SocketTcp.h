@@ -31,10 +31,12 @@
 namespace arangodb {
 class SocketTcp final : public Socket {
  public:
+  // the context is only used to create the SSL state of the connection,
+  // which keeps a reference to it. it can be shared by all connections
   SocketTcp(boost::asio::io_service& ioService,
-            boost::asio::ssl::context&& context, bool encrypted)
-      : Socket(ioService, std::move(context), encrypted),
-        _sslSocket(ioService, _context),
+            boost::asio::ssl::context& context, bool encrypted)
+      : Socket(ioService, encrypted),
+        _sslSocket(ioService, context),
         _socket(_sslSocket.next_layer()),
         _peerEndpoint() {}
 
@@ -66,10 +68,10 @@ class SocketTcp final : public Socket {
     return socketcommon::doSslHandshake(_sslSocket);
   }
 
-  size_t write(basics::StringBuffer* buffer,
+  size_t write(BufferSequence const& buffers,
                boost::system::error_code& ec) override;
 
-  void asyncWrite(boost::asio::mutable_buffers_1 const& buffer,
+  void asyncWrite(BufferSequence const& buffers,
                   AsyncHandler const& handler) override;
 
   size_t read(boost::asio::mutable_buffers_1 const& buffer,
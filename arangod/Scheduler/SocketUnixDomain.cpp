@@ -26,11 +26,11 @@
 
 using namespace arangodb;
 
-size_t SocketUnixDomain::write(basics::StringBuffer* buffer, boost::system::error_code& ec) {
-  return socketcommon::doWrite(_socket, buffer, ec);
+size_t SocketUnixDomain::write(BufferSequence const& buffers, boost::system::error_code& ec) {
+  return socketcommon::doWrite(_socket, buffers, ec);
 }
-void SocketUnixDomain::asyncWrite(boost::asio::mutable_buffers_1 const& buffer, AsyncHandler const& handler) {
-  return socketcommon::doAsyncWrite(_socket, buffer, handler);
+void SocketUnixDomain::asyncWrite(BufferSequence const& buffers, AsyncHandler const& handler) {
+  return socketcommon::doAsyncWrite(_socket, buffers, handler);
 }
 size_t SocketUnixDomain::read(boost::asio::mutable_buffers_1 const& buffer, boost::system::error_code& ec) {
   return socketcommon::doRead(_socket, buffer, ec);
@@ -34,8 +34,8 @@ class StringBuffer;
 
 class SocketUnixDomain final : public Socket {
   public:
-    SocketUnixDomain(boost::asio::io_service& ioService, boost::asio::ssl::context&& context)
-        : Socket(ioService, std::move(context), false),
+    explicit SocketUnixDomain(boost::asio::io_service& ioService)
+        : Socket(ioService, false),
           _socket(ioService),
           _peerEndpoint() {}
 
@@ -53,9 +53,9 @@ class SocketUnixDomain final : public Socket {
     
     bool sslHandshake() override { return false; }
     
-    size_t write(basics::StringBuffer* buffer, boost::system::error_code& ec) override;
+    size_t write(BufferSequence const& buffers, boost::system::error_code& ec) override;
     
-    void asyncWrite(boost::asio::mutable_buffers_1 const& buffer, AsyncHandler const& handler) override;
+    void asyncWrite(BufferSequence const& buffers, AsyncHandler const& handler) override;
     
     size_t read(boost::asio::mutable_buffers_1 const& buffer, boost::system::error_code& ec) override;
     
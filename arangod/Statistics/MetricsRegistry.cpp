@@ -0,0 +1,176 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "MetricsRegistry.h"
+
+#include "Basics/MutexLocker.h"
+#include "Basics/StringUtils.h"
+
+#include <cmath>
+
+using namespace arangodb;
+using namespace arangodb::basics;
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 private functions
+// -----------------------------------------------------------------------------
+
+/// @brief the name of a metric without its labels
+static std::string familyName(std::string const& name) {
+  return name.substr(0, name.find('{'));
+}
+
+/// @brief append a value in the exposition format
+static void appendValue(std::string& result, double value) {
+  if (std::isnan(value)) {
+    result.append("NaN");
+  } else if (std::isinf(value)) {
+    result.append(value > 0.0 ? "+Inf" : "-Inf");
+  } else {
+    result.append(StringUtils::ftoa(value));
+  }
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                    static members
+// -----------------------------------------------------------------------------
+
+Mutex MetricsRegistry::_lock;
+
+std::vector<MetricsRegistry::Metric> MetricsRegistry::_metrics;
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                             static public methods
+// -----------------------------------------------------------------------------
+
+void MetricsRegistry::addCounter(std::string const& name,
+                                 std::string const& help,
+                                 ValueFunction value) {
+  add(Metric{familyName(name), name, help, "counter", value, nullptr});
+}
+
+void MetricsRegistry::addGauge(std::string const& name,
+                               std::string const& help, ValueFunction value) {
+  add(Metric{familyName(name), name, help, "gauge", value, nullptr});
+}
+
+void MetricsRegistry::addHistogram(std::string const& name,
+                                   std::string const& help,
+                                   DistributionFunction distribution) {
+  // the bucket samples carry the "le" label, so histograms cannot have
+  // labels of their own
+  TRI_ASSERT(name.find('{') == std::string::npos);
+
+  add(Metric{name, name, help, "histogram", nullptr, distribution});
+}
+
+void MetricsRegistry::remove(std::string const& family) {
+  MUTEX_LOCKER(locker, _lock);
+
+  _metrics.erase(std::remove_if(_metrics.begin(), _metrics.end(),
+                                [&family](Metric const& metric) {
+                                  return metric._family == family;
+                                }),
+                 _metrics.end());
+}
+
+void MetricsRegistry::toPrometheus(std::string& result) {
+  MUTEX_LOCKER(locker, _lock);
+
+  std::string const* family = nullptr;
+
+  for (auto const& metric : _metrics) {
+    if (family == nullptr || *family != metric._family) {
+      family = &metric._family;
+
+      result.append("# HELP ");
+      result.append(metric._family);
+      result.push_back(' ');
+      result.append(metric._help);
+      result.append("\n# TYPE ");
+      result.append(metric._family);
+      result.push_back(' ');
+      result.append(metric._type);
+      result.push_back('\n');
+    }
+
+    if (metric._value) {
+      result.append(metric._name);
+      result.push_back(' ');
+      appendValue(result, metric._value());
+      result.push_back('\n');
+      continue;
+    }
+
+    TRI_ASSERT(metric._distribution);
+    StatisticsDistribution const distribution = metric._distribution();
+
+    // buckets are cumulative in the exposition format
+    uint64_t count = 0;
+
+    for (size_t i = 0; i < distribution._cuts.size(); ++i) {
+      count += distribution._counts[i];
+
+      result.append(metric._name);
+      result.append("_bucket{le=\"");
+      appendValue(result, distribution._cuts[i]);
+      result.append("\"} ");
+      result.append(StringUtils::itoa(count));
+      result.push_back('\n');
+    }
+
+    result.append(metric._name);
+    result.append("_bucket{le=\"+Inf\"} ");
+    result.append(StringUtils::itoa(distribution._count));
+    result.push_back('\n');
+
+    result.append(metric._name);
+    result.append("_sum ");
+    appendValue(result, distribution._total);
+    result.push_back('\n');
+
+    result.append(metric._name);
+    result.append("_count ");
+    result.append(StringUtils::itoa(distribution._count));
+    result.push_back('\n');
+  }
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                            static private methods
+// -----------------------------------------------------------------------------
+
+void MetricsRegistry::add(Metric&& metric) {
+  MUTEX_LOCKER(locker, _lock);
+
+  // keep the samples of a family together, so that the family's help and
+  // type are only emitted once
+  auto it = std::find_if(_metrics.rbegin(), _metrics.rend(),
+                         [&metric](Metric const& other) {
+                           return other._family == metric._family;
+                         });
+
+  if (it == _metrics.rend()) {
+    _metrics.emplace_back(std::move(metric));
+  } else {
+    _metrics.emplace(it.base(), std::move(metric));
+  }
+}
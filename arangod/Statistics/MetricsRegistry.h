@@ -0,0 +1,84 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_STATISTICS_METRICS_REGISTRY_H
+#define ARANGOD_STATISTICS_METRICS_REGISTRY_H 1
+
+#include "Basics/Common.h"
+
+#include "Basics/Mutex.h"
+#include "Statistics/figures.h"
+
+namespace arangodb {
+
+/// @brief registry of the metrics exposed via /_admin/metrics.
+/// subsystems register their metrics when they start and remove them
+/// before they shut down. the values are produced by callbacks that are
+/// only invoked when the metrics are read, so registered metrics do not
+/// add any overhead to the code that maintains the underlying figures.
+/// a metric name may carry labels, e.g. `queue_length{queue="aql"}`.
+/// all samples with the same name before the labels form a family and
+/// must be registered with the same type and help text
+class MetricsRegistry {
+ public:
+  typedef std::function<double()> ValueFunction;
+  typedef std::function<basics::StatisticsDistribution()>
+      DistributionFunction;
+
+  /// @brief register a monotonically increasing value
+  static void addCounter(std::string const& name, std::string const& help,
+                         ValueFunction value);
+
+  /// @brief register a value that can go up and down
+  static void addGauge(std::string const& name, std::string const& help,
+                       ValueFunction value);
+
+  /// @brief register a distribution, exposed as a histogram
+  static void addHistogram(std::string const& name, std::string const& help,
+                           DistributionFunction distribution);
+
+  /// @brief remove all samples of a metric family
+  static void remove(std::string const& family);
+
+  /// @brief append all metrics in the Prometheus text exposition format
+  static void toPrometheus(std::string& result);
+
+ private:
+  struct Metric {
+    std::string _family;
+    std::string _name;
+    std::string _help;
+    char const* _type;
+    ValueFunction _value;
+    DistributionFunction _distribution;
+  };
+
+  static void add(Metric&& metric);
+
+ private:
+  static Mutex _lock;
+
+  /// @brief the metrics, in registration order
+  static std::vector<Metric> _metrics;
+};
+}
+
+#endif
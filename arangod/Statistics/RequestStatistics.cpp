@@ -65,17 +65,40 @@ void RequestStatistics::initialize() {
 void RequestStatistics::shutdown() {}
 
 size_t RequestStatistics::processAll() {
+  RequestStatistics* batch[PROCESS_BATCH_SIZE];
   RequestStatistics* statistics = nullptr;
   size_t count = 0;
 
-  while (_finishedList.pop(statistics)) {
-    if (statistics != nullptr) {
-      TRI_ASSERT(!statistics->_released);
-      TRI_ASSERT(statistics->_inQueue);
-      statistics->_inQueue = false;
-      process(statistics);
-      ++count;
+  while (true) {
+    size_t n = 0;
+
+    while (n < PROCESS_BATCH_SIZE && _finishedList.pop(statistics)) {
+      if (statistics != nullptr) {
+        TRI_ASSERT(!statistics->_released);
+        TRI_ASSERT(statistics->_inQueue);
+        statistics->_inQueue = false;
+        batch[n++] = statistics;
+      }
+    }
+
+    if (n == 0) {
+      break;
+    }
+
+    // aggregate the whole batch under a single lock acquisition
+    {
+      MUTEX_LOCKER(mutexLocker, _dataLock);
+
+      for (size_t i = 0; i < n; ++i) {
+        process(batch[i]);
+      }
+    }
+
+    for (size_t i = 0; i < n; ++i) {
+      recycle(batch[i]);
     }
+
+    count += n;
   }
 
   return count;
@@ -109,8 +132,6 @@ void RequestStatistics::process(RequestStatistics* statistics) {
   TRI_ASSERT(statistics != nullptr);
 
   {
-    MUTEX_LOCKER(mutexLocker, _dataLock);
-
     TRI_TotalRequestsStatistics.incCounter();
 
     if (statistics->_async) {
@@ -153,6 +174,10 @@ void RequestStatistics::process(RequestStatistics* statistics) {
           statistics->_receivedBytes);
     }
   }
+}
+
+void RequestStatistics::recycle(RequestStatistics* statistics) {
+  TRI_ASSERT(statistics != nullptr);
 
   // clear statistics
   statistics->reset();
@@ -105,6 +105,18 @@ class RequestStatistics {
     }
   }
 
+  static void SET_QUEUE_START(RequestStatistics* stat) {
+    if (stat != nullptr) {
+      stat->_queueStart = StatisticsFeature::time();
+    }
+  }
+
+  static void SET_QUEUE_END(RequestStatistics* stat) {
+    if (stat != nullptr) {
+      stat->_queueEnd = StatisticsFeature::time();
+    }
+  }
+
   static void SET_REQUEST_START(RequestStatistics* stat) {
     if (stat != nullptr) {
       stat->_requestStart = StatisticsFeature::time();
@@ -125,6 +137,10 @@ class RequestStatistics {
     }
   }
 
+  double readStart() const { return _readStart; }
+  double readEnd() const { return _readEnd; }
+  double queueStart() const { return _queueStart; }
+  double queueEnd() const { return _queueEnd; }
   double requestStart() const { return _requestStart; }
 
   static void fill(basics::StatisticsDistribution& totalTime,
@@ -140,6 +156,10 @@ class RequestStatistics {
  private:
   static size_t const QUEUE_SIZE = 1000;
 
+  // number of finished statistics that are aggregated while holding the
+  // data lock once
+  static size_t const PROCESS_BATCH_SIZE = 64;
+
   static arangodb::Mutex _dataLock;
 
   static std::unique_ptr<RequestStatistics[]> _statisticsBuffer;
@@ -152,8 +172,13 @@ class RequestStatistics {
                                 boost::lockfree::capacity<QUEUE_SIZE>>
       _finishedList;
 
+  // aggregates the figures of a finished statistics object. must be called
+  // with the data lock held
   static void process(RequestStatistics*);
 
+  // resets a processed statistics object and returns it to the free list
+  static void recycle(RequestStatistics*);
+
   RequestStatistics() { reset(); }
 
   void reset() {
@@ -27,6 +27,7 @@
 #include "ProgramOptions/ProgramOptions.h"
 #include "ProgramOptions/Section.h"
 #include "Statistics/ConnectionStatistics.h"
+#include "Statistics/MetricsRegistry.h"
 #include "Statistics/RequestStatistics.h"
 #include "Statistics/ServerStatistics.h"
 
@@ -188,9 +189,92 @@ void StatisticsFeature::start() {
     LOG_TOPIC(FATAL, arangodb::Logger::FIXME) << "could not start statistics thread";
     FATAL_ERROR_EXIT();
   }
+
+  registerMetrics();
+}
+
+void StatisticsFeature::registerMetrics() {
+  // connection and request counters
+  enum class Counter { CONNECTIONS, TOTAL, ASYNC };
+
+  auto counter = [](Counter which) -> double {
+    StatisticsCounter httpConnections;
+    StatisticsCounter totalRequests;
+    std::vector<StatisticsCounter> methodRequests;
+    StatisticsCounter asyncRequests;
+    StatisticsDistribution connectionTime;
+
+    ConnectionStatistics::fill(httpConnections, totalRequests, methodRequests,
+                               asyncRequests, connectionTime);
+
+    switch (which) {
+      case Counter::CONNECTIONS:
+        return static_cast<double>(httpConnections._count);
+      case Counter::TOTAL:
+        return static_cast<double>(totalRequests._count);
+      case Counter::ASYNC:
+        return static_cast<double>(asyncRequests._count);
+    }
+    return 0.0;
+  };
+
+  MetricsRegistry::addGauge("arangodb_http_connections",
+                            "Number of open client connections",
+                            [counter]() { return counter(Counter::CONNECTIONS); });
+  MetricsRegistry::addCounter("arangodb_http_requests_total",
+                              "Number of requests handled",
+                              [counter]() { return counter(Counter::TOTAL); });
+  MetricsRegistry::addCounter("arangodb_http_requests_async_total",
+                              "Number of asynchronous requests handled",
+                              [counter]() { return counter(Counter::ASYNC); });
+
+  // request time distributions
+  enum class Distribution { TOTAL, REQUEST, QUEUE };
+
+  auto distribution = [](Distribution which) -> StatisticsDistribution {
+    StatisticsDistribution totalTime;
+    StatisticsDistribution requestTime;
+    StatisticsDistribution queueTime;
+    StatisticsDistribution ioTime;
+    StatisticsDistribution bytesSent;
+    StatisticsDistribution bytesReceived;
+
+    RequestStatistics::fill(totalTime, requestTime, queueTime, ioTime,
+                            bytesSent, bytesReceived);
+
+    switch (which) {
+      case Distribution::TOTAL:
+        return totalTime;
+      case Distribution::REQUEST:
+        return requestTime;
+      case Distribution::QUEUE:
+        return queueTime;
+    }
+    return totalTime;
+  };
+
+  MetricsRegistry::addHistogram(
+      "arangodb_http_total_time_seconds",
+      "Time between reading the first byte of a request and sending its response",
+      [distribution]() { return distribution(Distribution::TOTAL); });
+  MetricsRegistry::addHistogram(
+      "arangodb_http_request_time_seconds",
+      "Time spent executing requests",
+      [distribution]() { return distribution(Distribution::REQUEST); });
+  MetricsRegistry::addHistogram(
+      "arangodb_http_queue_time_seconds",
+      "Time requests spent waiting in the scheduler queue",
+      [distribution]() { return distribution(Distribution::QUEUE); });
 }
 
 void StatisticsFeature::unprepare() {
+  MetricsRegistry::remove("arangodb_http_connections");
+  MetricsRegistry::remove("arangodb_http_requests_total");
+  MetricsRegistry::remove("arangodb_http_requests_async_total");
+  MetricsRegistry::remove("arangodb_http_total_time_seconds");
+  MetricsRegistry::remove("arangodb_http_request_time_seconds");
+  MetricsRegistry::remove("arangodb_http_queue_time_seconds");
+
   if (_statisticsThread != nullptr) {
     _statisticsThread->beginShutdown();
 
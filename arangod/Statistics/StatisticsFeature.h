@@ -72,6 +72,9 @@ class StatisticsFeature final
  public:
   void disableStatistics() { _statistics = false; }
 
+ private:
+  void registerMetrics();
+
  private:
   bool _statistics;
 
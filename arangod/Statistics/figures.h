@@ -74,17 +74,10 @@ struct StatisticsDistribution {
     ++_count;
     _total += value;
 
-    std::vector<double>::iterator i = _cuts.begin();
-    std::vector<uint64_t>::iterator j = _counts.begin();
-
-    for (; i != _cuts.end(); ++i, ++j) {
-      if (value < *i) {
-        ++(*j);
-        return;
-      }
-    }
-
-    ++(*j);
+    // the cuts are sorted, so the bucket is the first cut greater than
+    // the value, or the last bucket if there is none
+    auto it = std::upper_bound(_cuts.begin(), _cuts.end(), value);
+    ++_counts[it - _cuts.begin()];
   }
 
   uint64_t _count;
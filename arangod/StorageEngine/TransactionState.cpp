@@ -29,10 +29,14 @@
 #include "StorageEngine/StorageEngine.h"
 #include "StorageEngine/TransactionCollection.h"
 #include "Transaction/Methods.h"
+#include "VocBase/LogicalCollection.h"
 #include "VocBase/ticks.h"
 
 using namespace arangodb;
 
+/// @brief maximum number of modified keys tracked per collection
+size_t const TransactionState::MaxModifiedKeys = 1000;
+
 /// @brief transaction type
 TransactionState::TransactionState(TRI_vocbase_t* vocbase)
     : _vocbase(vocbase), 
@@ -46,7 +50,8 @@ TransactionState::TransactionState(TRI_vocbase_t* vocbase)
       _timeout(transaction::Methods::DefaultLockTimeout),
       _nestingLevel(0), 
       _allowImplicitCollections(true),
-      _waitForSync(false) {}
+      _waitForSync(false),
+      _modifiedKeys() {}
 
 /// @brief free a transaction container
 TransactionState::~TransactionState() {
@@ -252,7 +257,16 @@ void TransactionState::clearQueryCache() {
     for (auto& trxCollection : _collections) {
       if (trxCollection->hasOperations()) {
         // we're only interested in collections that may have been modified
-        collections.emplace_back(trxCollection->collectionName());
+        std::string const name = trxCollection->collectionName();
+        auto it = _modifiedKeys.find(name);
+
+        if (it != _modifiedKeys.end() && (*it).second != nullptr) {
+          // only invalidate the results that read the modified keys
+          arangodb::aql::QueryCache::instance()->invalidate(_vocbase, name,
+                                                            *(*it).second);
+        } else {
+          collections.emplace_back(name);
+        }
       }
     }
 
@@ -266,6 +280,50 @@ void TransactionState::clearQueryCache() {
   }
 }
 
+/// @brief increase the modification epochs of all collections that were
+/// modified by the transaction, so that cached traversal results derived
+/// from their uncommitted state are not used anymore
+void TransactionState::increaseModificationEpochs() {
+  for (auto& trxCollection : _collections) {
+    if (trxCollection->hasOperations()) {
+      LogicalCollection* collection = trxCollection->collection();
+      if (collection != nullptr) {
+        collection->increaseModificationEpoch();
+      }
+    }
+  }
+}
+
+/// @brief remember the key of a document modified by the transaction, for
+/// the key-based invalidation of the query cache. an empty key means that
+/// the modified keys of the collection are unknown
+void TransactionState::trackModifiedKey(std::string const& collection,
+                                        std::string const& key) {
+  auto it = _modifiedKeys.find(collection);
+
+  if (it == _modifiedKeys.end()) {
+    it = _modifiedKeys
+             .emplace(collection,
+                      std::make_unique<std::unordered_set<std::string>>())
+             .first;
+  }
+
+  auto& keys = (*it).second;
+
+  if (keys == nullptr) {
+    // keys are already unknown
+    return;
+  }
+
+  if (key.empty() || keys->size() >= MaxModifiedKeys) {
+    // too many keys to be tracked
+    keys.reset();
+    return;
+  }
+
+  keys->emplace(key);
+}
+
 /// @brief update the status of a transaction
 void TransactionState::updateStatus(transaction::Status status) {
   TRI_ASSERT(_status == transaction::Status::CREATED ||
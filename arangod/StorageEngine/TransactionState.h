@@ -135,15 +135,15 @@ class TransactionState {
 
   virtual bool hasFailedOperations() const = 0;
 
- protected:
-  /// @brief find a collection in the transaction's list of collections
-  TransactionCollection* findCollection(TRI_voc_cid_t cid, size_t& position) const;
-
   /// @brief whether or not a transaction is read-only
   bool isReadOnlyTransaction() const {
     return (_type == AccessMode::Type::READ);
   }
 
+ protected:
+  /// @brief find a collection in the transaction's list of collections
+  TransactionCollection* findCollection(TRI_voc_cid_t cid, size_t& position) const;
+
   /// @brief free all operations for a transaction
   void freeOperations(transaction::Methods* activeTrx);
 
@@ -154,7 +154,20 @@ class TransactionState {
   /// the transaction
   void clearQueryCache();
 
+  /// @brief increase the modification epochs of all collections that were
+  /// modified by the transaction, so that cached traversal results derived
+  /// from their uncommitted state are not used anymore
+  void increaseModificationEpochs();
+
+  /// @brief remember the key of a document modified by the transaction, for
+  /// the key-based invalidation of the query cache. an empty key means that
+  /// the modified keys of the collection are unknown
+  void trackModifiedKey(std::string const& collection, std::string const& key);
+
  protected:
+  /// @brief maximum number of modified keys tracked per collection
+  static size_t const MaxModifiedKeys;
+
   TRI_vocbase_t* _vocbase;            // vocbase
   TRI_voc_tid_t _id;                  // local trx id
   AccessMode::Type _type;             // access type (read|write)
@@ -170,6 +183,12 @@ class TransactionState {
   int _nestingLevel;
   bool _allowImplicitCollections;
   bool _waitForSync;   // whether or not the transaction had a synchronous op
+
+  /// @brief keys of the documents modified per collection. a nullptr means
+  /// that the keys are unknown
+  std::unordered_map<std::string,
+                     std::unique_ptr<std::unordered_set<std::string>>>
+      _modifiedKeys;
 };
 
 }
@@ -22,6 +22,7 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "Context.h"
+#include "Basics/MutexLocker.h"
 #include "Basics/StringBuffer.h"
 #include "RestServer/TransactionManagerFeature.h"
 #include "StorageEngine/EngineSelectorFeature.h"
@@ -95,6 +96,33 @@ transaction::Context::~Context() {
   _resolver = nullptr;
 }
 
+/// @brief reset the context so it can be used for another transaction
+void transaction::Context::reset(TRI_vocbase_t* vocbase) {
+  // unregister the transaction from the logfile manager
+  if (_transaction.id > 0) {
+    TransactionManagerFeature::MANAGER->unregisterTransaction(_transaction.id, _transaction.hasFailedOperations);
+    _transaction.id = 0;
+    _transaction.hasFailedOperations = false;
+  }
+
+  // releases the pinned data
+  _contextData.reset();
+
+  // the resolver caches collections of the previous transaction's vocbase
+  _customTypeHandler.reset();
+  if (_ownsResolver) {
+    delete _resolver;
+  }
+  _resolver = nullptr;
+  _ownsResolver = false;
+
+  _options = arangodb::velocypack::Options::Defaults;
+  _dumpOptions = arangodb::velocypack::Options::Defaults;
+  _dumpOptions.escapeUnicode = true;
+
+  _vocbase = vocbase;
+}
+
 /// @brief factory to create a custom type handler, not managed
 VPackCustomTypeHandler* transaction::Context::createCustomTypeHandler(TRI_vocbase_t* vocbase, 
                                                                     CollectionNameResolver const* resolver) {
@@ -129,6 +157,8 @@ void transaction::Context::returnStringBuffer(basics::StringBuffer* stringBuffer
 
 /// @brief temporarily lease a Builder object
 VPackBuilder* transaction::Context::leaseBuilder() {
+  MUTEX_LOCKER(mutexLocker, _buildersLock);
+
   if (_builders.empty()) {
     // create a new builder and return it
     return new VPackBuilder();
@@ -144,6 +174,8 @@ VPackBuilder* transaction::Context::leaseBuilder() {
   
 /// @brief return a temporary Builder object
 void transaction::Context::returnBuilder(VPackBuilder* builder) {
+  MUTEX_LOCKER(mutexLocker, _buildersLock);
+
   try {
     // put builder back into our vector of builders
     _builders.emplace_back(builder);
@@ -25,6 +25,7 @@
 #define ARANGOD_TRANSACTION_CONTEXT_H 1
 
 #include "Basics/Common.h"
+#include "Basics/Mutex.h"
 #include "Basics/SmallVector.h"
 #include "VocBase/voc-types.h"
 
@@ -125,6 +126,11 @@ class Context {
   /// @brief create a resolver
   CollectionNameResolver const* createResolver();
 
+  /// @brief reset the context so it can be used for another transaction.
+  /// releases everything that refers to the previous transaction, but keeps
+  /// the builders and the string buffer, so that their memory is reused
+  void reset(TRI_vocbase_t*);
+
   transaction::ContextData* contextData();
  
  protected:
@@ -137,6 +143,9 @@ class Context {
   
   SmallVector<arangodb::velocypack::Builder*, 32>::allocator_type::arena_type _arena;
   SmallVector<arangodb::velocypack::Builder*, 32> _builders;
+  /// @brief protects _builders. the parallel shortest path expanders lease
+  /// builders for their edge lookups concurrently
+  arangodb::Mutex _buildersLock;
   
   std::unique_ptr<arangodb::basics::StringBuffer> _stringBuffer;
 
@@ -45,7 +45,8 @@ class Hints {
     TRY_LOCK = 64,
     NO_COMPACTION_LOCK = 128,
     NO_USAGE_LOCK = 256,
-    RECOVERY = 512
+    RECOVERY = 512,
+    SNAPSHOT = 1024
   };
 
   Hints() : _value(0) {}
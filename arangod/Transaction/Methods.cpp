@@ -36,6 +36,7 @@
 #include "Cluster/ClusterComm.h"
 #include "Cluster/ClusterMethods.h"
 #include "Cluster/FollowerInfo.h"
+#include "Cluster/ReplicationBatcher.h"
 #include "Cluster/ServerState.h"
 #include "Indexes/Index.h"
 #include "Logger/Logger.h"
@@ -982,15 +983,8 @@ int transaction::Methods::documentFastPath(std::string const& collectionName,
     return TRI_ERROR_ARANGO_DOCUMENT_HANDLE_BAD;
   }
 
-  std::unique_ptr<ManagedDocumentResult> tmp;
-  if (mmdr == nullptr) {
-    tmp.reset(new ManagedDocumentResult);
-    mmdr = tmp.get();
-  }
-  
-  TRI_ASSERT(mmdr != nullptr); 
-
-  int res = collection->read(this, key, *mmdr,
+  // the document may be served from the engine's document cache
+  int res = collection->readInto(this, key, std::vector<std::string>(), result,
       shouldLock && !isLocked(collection, AccessMode::Type::READ));
 
   if (res != TRI_ERROR_NO_ERROR) {
@@ -998,10 +992,6 @@ int transaction::Methods::documentFastPath(std::string const& collectionName,
   }
   
   TRI_ASSERT(isPinned(cid));
-
-  uint8_t const* vpack = mmdr->vpack();
-  TRI_ASSERT(vpack != nullptr);
-  result.addExternal(vpack);
   return TRI_ERROR_NO_ERROR;
 }
 
@@ -1186,10 +1176,29 @@ OperationResult transaction::Methods::documentLocal(std::string const& collectio
   TRI_voc_cid_t cid = addCollectionAtRuntime(collectionName); 
   LogicalCollection* collection = documentCollection(trxCollection(cid));
 
+  if (options.allowDirtyReads && _state->isDBServer() &&
+      !collection->followers()->canServeDirtyRead(options.maxStaleness)) {
+    // we are a follower that may be too stale. the coordinator will ask
+    // the leader instead
+    return OperationResult(TRI_ERROR_CLUSTER_AQL_COLLECTION_OUT_OF_SYNC);
+  }
+
   if (!options.silent) {
     pinData(cid); // will throw when it fails
   }
+
+  if (value.isArray()) {
+    // lock the collection once for all documents instead of locking and
+    // unlocking it for each of them
+    int res = lock(trxCollection(cid), AccessMode::Type::READ);
+
+    if (res != TRI_ERROR_NO_ERROR) {
+      return OperationResult(res);
+    }
+  }
  
+  bool const needsLock = !isLocked(collection, AccessMode::Type::READ);
+
   VPackBuilder resultBuilder;
 
   auto workForOneDocument = [&](VPackSlice const value, bool isMultiple) -> int {
@@ -1209,8 +1218,7 @@ OperationResult transaction::Methods::documentLocal(std::string const& collectio
 
     ManagedDocumentResult result;
     TIMER_START(TRANSACTION_DOCUMENT_DOCUMENT_DOCUMENT);
-    int res = collection->read(this, key, result,
-                               !isLocked(collection, AccessMode::Type::READ));
+    int res = collection->read(this, key, result, needsLock);
     TIMER_STOP(TRANSACTION_DOCUMENT_DOCUMENT_DOCUMENT);
 
     if (res != TRI_ERROR_NO_ERROR) {
@@ -1318,22 +1326,6 @@ OperationResult transaction::Methods::insertCoordinator(std::string const& colle
 }
 #endif
 
-/// @brief choose a timeout for synchronous replication, based on the 
-/// number of documents we ship over
-static double chooseTimeout(size_t count) {
-  // We usually assume that a server can process at least 5000 documents
-  // per second (this is a low estimate), and use a low limit of 0.5s
-  // and a high timeout of 120s
-  double timeout = static_cast<double>(count / 5000);
-  if (timeout < 0.5) {
-    return 0.5;
-  } else if (timeout > 120) {
-    return 120.0;
-  } else {
-    return timeout;
-  }
-}
-
 /// @brief create one or multiple documents in a collection, local
 /// the single-document variant of this operation will either succeed or,
 /// if it fails, clean up after itself
@@ -1348,6 +1340,20 @@ OperationResult transaction::Methods::insertLocal(std::string const& collectionN
     pinData(cid); // will throw when it fails 
   }
 
+  bool const multiCase = value.isArray();
+
+  if (multiCase) {
+    // lock the collection once for all documents instead of locking and
+    // unlocking it for each of them
+    int res = lock(trxCollection(cid), AccessMode::Type::WRITE);
+
+    if (res != TRI_ERROR_NO_ERROR) {
+      return OperationResult(res);
+    }
+  }
+
+  bool const needsLock = !isLocked(collection, AccessMode::Type::WRITE);
+
   VPackBuilder resultBuilder;
   TRI_voc_tick_t maxTick = 0;
 
@@ -1361,7 +1367,7 @@ OperationResult transaction::Methods::insertLocal(std::string const& collectionN
 
     TIMER_START(TRANSACTION_INSERT_DOCUMENT_INSERT);
     int res = collection->insert(this, value, result, options, resultMarkerTick,
-                                 !isLocked(collection, AccessMode::Type::WRITE));
+                                 needsLock);
     TIMER_STOP(TRANSACTION_INSERT_DOCUMENT_INSERT);
 
     if (resultMarkerTick > 0 && resultMarkerTick > maxTick) {
@@ -1393,7 +1399,6 @@ OperationResult transaction::Methods::insertLocal(std::string const& collectionN
   TIMER_START(TRANSACTION_INSERT_WORK_FOR_ONE);
 
   int res = TRI_ERROR_NO_ERROR;
-  bool const multiCase = value.isArray();
   std::unordered_map<int, size_t> countErrorCodes;
   if (multiCase) {
     VPackArrayBuilder b(&resultBuilder);
@@ -1424,6 +1429,11 @@ OperationResult transaction::Methods::insertLocal(std::string const& collectionN
     auto const& followerInfo = collection->followers();
     followers = followerInfo->get();
     doingSynchronousReplication = followers->size() > 0;
+    if (options.isRestore && !followerInfo->isLeader() &&
+        res == TRI_ERROR_NO_ERROR) {
+      // an operation replicated by our leader, remembered for dirty reads
+      followerInfo->setApplied(TRI_CurrentTickServer());
+    }
   }
 
   if (doingSynchronousReplication && res == TRI_ERROR_NO_ERROR) {
@@ -1432,13 +1442,6 @@ OperationResult transaction::Methods::insertLocal(std::string const& collectionN
     // in case of an error.
  
     // Now replicate the good operations on all followers:
-    std::string path
-        = "/_db/" +
-          arangodb::basics::StringUtils::urlEncode(databaseName()) +
-          "/_api/document/" +
-          arangodb::basics::StringUtils::urlEncode(collection->name())
-          + "?isRestore=true";
-
     VPackBuilder payload;
 
     auto doOneDoc = [&](VPackSlice const& doc, VPackSlice result) {
@@ -1470,47 +1473,9 @@ OperationResult transaction::Methods::insertLocal(std::string const& collectionN
       count++;
     }
     if (count > 0) {
-      auto body = std::make_shared<std::string>();
-      *body = payload.slice().toJson();
-
-      // Now prepare the requests:
-      std::vector<ClusterCommRequest> requests;
-      for (auto const& f : *followers) {
-        requests.emplace_back("server:" + f, 
-                              arangodb::rest::RequestType::POST,
-                              path, body);
-      }
-      auto cc = arangodb::ClusterComm::instance();
-      if (cc != nullptr) {
-        // nullptr only happens on controlled shutdown
-        size_t nrDone = 0;
-        size_t nrGood = cc->performRequests(requests, chooseTimeout(count),
-                                            nrDone, Logger::REPLICATION);
-        if (nrGood < followers->size()) {
-          // we drop all followers that were not successful:
-          for (size_t i = 0; i < followers->size(); ++i) {
-            bool replicationWorked 
-                = requests[i].done &&
-                  requests[i].result.status == CL_COMM_RECEIVED &&
-                  (requests[i].result.answer_code == 
-                       rest::ResponseCode::ACCEPTED ||
-                   requests[i].result.answer_code == 
-                       rest::ResponseCode::CREATED);
-            if (replicationWorked) {
-              bool found;
-              requests[i].result.answer->header(StaticStrings::ErrorCodes, found);
-              replicationWorked = !found;
-            }
-            if (!replicationWorked) {
-              auto const& followerInfo = collection->followers();
-              followerInfo->remove((*followers)[i]);
-              LOG_TOPIC(ERR, Logger::REPLICATION)
-                  << "insertLocal: dropping follower "
-                  << (*followers)[i] << " for shard " << collectionName;
-            }
-          }
-        }
-      }
+      ReplicationBatcher::instance()->replicate(
+          collection, databaseName(), arangodb::rest::RequestType::POST,
+          followers, payload.slice(), "insertLocal");
     }
   }
   
@@ -1650,6 +1615,8 @@ OperationResult transaction::Methods::modifyLocal(
     return OperationResult(res);
   }
 
+  bool const needsLock = !isLocked(collection, AccessMode::Type::WRITE);
+
   VPackBuilder resultBuilder;  // building the complete result
   TRI_voc_tick_t maxTick = 0;
 
@@ -1665,12 +1632,10 @@ OperationResult transaction::Methods::modifyLocal(
 
     if (operation == TRI_VOC_DOCUMENT_OPERATION_REPLACE) {
       res = collection->replace(this, newVal, result, options, resultMarkerTick, 
-          !isLocked(collection, AccessMode::Type::WRITE), actualRevision,
-          previous);
+          needsLock, actualRevision, previous);
     } else {
       res = collection->update(this, newVal, result, options, resultMarkerTick,
-          !isLocked(collection, AccessMode::Type::WRITE), actualRevision,
-          previous);
+          needsLock, actualRevision, previous);
     }
     
     if (resultMarkerTick > 0 && resultMarkerTick > maxTick) {
@@ -1733,6 +1698,11 @@ OperationResult transaction::Methods::modifyLocal(
     auto const& followerInfo = collection->followers();
     followers = followerInfo->get();
     doingSynchronousReplication = followers->size() > 0;
+    if (options.isRestore && !followerInfo->isLeader() &&
+        res == TRI_ERROR_NO_ERROR) {
+      // an operation replicated by our leader, remembered for dirty reads
+      followerInfo->setApplied(TRI_CurrentTickServer());
+    }
   }
 
   if (doingSynchronousReplication && res == TRI_ERROR_NO_ERROR) {
@@ -1744,13 +1714,6 @@ OperationResult transaction::Methods::modifyLocal(
     auto cc = arangodb::ClusterComm::instance();
     if (cc != nullptr) {
       // nullptr only happens on controlled shutdown
-      std::string path
-          = "/_db/" +
-            arangodb::basics::StringUtils::urlEncode(databaseName()) +
-            "/_api/document/" +
-            arangodb::basics::StringUtils::urlEncode(collection->name())
-            + "?isRestore=true";
-
       VPackBuilder payload;
 
       auto doOneDoc = [&](VPackSlice const& doc, VPackSlice result) {
@@ -1783,45 +1746,12 @@ OperationResult transaction::Methods::modifyLocal(
         count++;
       }
       if (count > 0) {
-        auto body = std::make_shared<std::string>();
-        *body = payload.slice().toJson();
-
-        // Now prepare the requests:
-        std::vector<ClusterCommRequest> requests;
-        for (auto const& f : *followers) {
-          requests.emplace_back("server:" + f, 
-              operation == TRI_VOC_DOCUMENT_OPERATION_REPLACE ?
-              arangodb::rest::RequestType::PUT :
-              arangodb::rest::RequestType::PATCH,
-              path, body);
-        }
-        size_t nrDone = 0;
-        size_t nrGood = cc->performRequests(requests, chooseTimeout(count),
-                                            nrDone, Logger::REPLICATION);
-        if (nrGood < followers->size()) {
-          // we drop all followers that were not successful:
-          for (size_t i = 0; i < followers->size(); ++i) {
-            bool replicationWorked 
-                = requests[i].done &&
-                  requests[i].result.status == CL_COMM_RECEIVED &&
-                  (requests[i].result.answer_code == 
-                       rest::ResponseCode::ACCEPTED ||
-                   requests[i].result.answer_code == 
-                       rest::ResponseCode::OK);
-            if (replicationWorked) {
-              bool found;
-              requests[i].result.answer->header(StaticStrings::ErrorCodes, found);
-              replicationWorked = !found;
-            }
-            if (!replicationWorked) {
-              auto const& followerInfo = collection->followers();
-              followerInfo->remove((*followers)[i]);
-              LOG_TOPIC(ERR, Logger::REPLICATION)
-                  << "modifyLocal: dropping follower "
-                  << (*followers)[i] << " for shard " << collectionName;
-            }
-          }
-        }
+        ReplicationBatcher::instance()->replicate(
+            collection, databaseName(),
+            operation == TRI_VOC_DOCUMENT_OPERATION_REPLACE
+                ? arangodb::rest::RequestType::PUT
+                : arangodb::rest::RequestType::PATCH,
+            followers, payload.slice(), "modifyLocal");
       }
     }
   }
@@ -1895,6 +1825,20 @@ OperationResult transaction::Methods::removeLocal(std::string const& collectionN
   if (options.returnOld) {
     pinData(cid); // will throw when it fails 
   }
+
+  bool const multiCase = value.isArray();
+
+  if (multiCase) {
+    // lock the collection once for all documents instead of locking and
+    // unlocking it for each of them
+    int res = lock(trxCollection(cid), AccessMode::Type::WRITE);
+
+    if (res != TRI_ERROR_NO_ERROR) {
+      return OperationResult(res);
+    }
+  }
+
+  bool const needsLock = !isLocked(collection, AccessMode::Type::WRITE);
  
   VPackBuilder resultBuilder;
   TRI_voc_tick_t maxTick = 0;
@@ -1925,8 +1869,7 @@ OperationResult transaction::Methods::removeLocal(std::string const& collectionN
     TRI_voc_tick_t resultMarkerTick = 0;
 
     int res = collection->remove(this, value, options, resultMarkerTick,
-                                 !isLocked(collection, AccessMode::Type::WRITE),
-                                 actualRevision, previous);
+                                 needsLock, actualRevision, previous);
 
     if (resultMarkerTick > 0 && resultMarkerTick > maxTick) {
       maxTick = resultMarkerTick;
@@ -1948,7 +1891,6 @@ OperationResult transaction::Methods::removeLocal(std::string const& collectionN
   };
 
   int res = TRI_ERROR_NO_ERROR;
-  bool multiCase = value.isArray();
   std::unordered_map<int, size_t> countErrorCodes;
   if (multiCase) {
     VPackArrayBuilder guard(&resultBuilder);
@@ -1977,6 +1919,11 @@ OperationResult transaction::Methods::removeLocal(std::string const& collectionN
     auto const& followerInfo = collection->followers();
     followers = followerInfo->get();
     doingSynchronousReplication = followers->size() > 0;
+    if (options.isRestore && !followerInfo->isLeader() &&
+        res == TRI_ERROR_NO_ERROR) {
+      // an operation replicated by our leader, remembered for dirty reads
+      followerInfo->setApplied(TRI_CurrentTickServer());
+    }
   }
 
   if (doingSynchronousReplication && res == TRI_ERROR_NO_ERROR) {
@@ -1989,13 +1936,6 @@ OperationResult transaction::Methods::removeLocal(std::string const& collectionN
     if (cc != nullptr) {
       // nullptr only happens on controled shutdown
 
-      std::string path
-          = "/_db/" +
-            arangodb::basics::StringUtils::urlEncode(databaseName()) +
-            "/_api/document/" +
-            arangodb::basics::StringUtils::urlEncode(collection->name())
-            + "?isRestore=true";
-
       VPackBuilder payload;
 
       auto doOneDoc = [&](VPackSlice const& doc, VPackSlice result) {
@@ -2028,43 +1968,9 @@ OperationResult transaction::Methods::removeLocal(std::string const& collectionN
         count++;
       }
       if (count > 0) {
-        auto body = std::make_shared<std::string>();
-        *body = payload.slice().toJson();
-
-        // Now prepare the requests:
-        std::vector<ClusterCommRequest> requests;
-        for (auto const& f : *followers) {
-          requests.emplace_back("server:" + f, 
-                                arangodb::rest::RequestType::DELETE_REQ,
-                                path, body);
-        }
-        size_t nrDone = 0;
-        size_t nrGood = cc->performRequests(requests, chooseTimeout(count),
-                                            nrDone, Logger::REPLICATION);
-        if (nrGood < followers->size()) {
-          // we drop all followers that were not successful:
-          for (size_t i = 0; i < followers->size(); ++i) {
-            bool replicationWorked 
-                = requests[i].done &&
-                  requests[i].result.status == CL_COMM_RECEIVED &&
-                  (requests[i].result.answer_code == 
-                       rest::ResponseCode::ACCEPTED ||
-                   requests[i].result.answer_code == 
-                       rest::ResponseCode::OK);
-            if (replicationWorked) {
-              bool found;
-              requests[i].result.answer->header(StaticStrings::ErrorCodes, found);
-              replicationWorked = !found;
-            }
-            if (!replicationWorked) {
-              auto const& followerInfo = collection->followers();
-              followerInfo->remove((*followers)[i]);
-              LOG_TOPIC(ERR, Logger::REPLICATION)
-                  << "removeLocal: dropping follower "
-                  << (*followers)[i] << " for shard " << collectionName;
-            }
-          }
-        }
+        ReplicationBatcher::instance()->replicate(
+            collection, databaseName(), arangodb::rest::RequestType::DELETE_REQ,
+            followers, payload.slice(), "removeLocal");
       }
     }
   }
@@ -2260,11 +2166,12 @@ OperationResult transaction::Methods::truncateLocal(std::string const& collectio
 }
 
 /// @brief count the number of documents in a collection
-OperationResult transaction::Methods::count(std::string const& collectionName, bool aggregate) {
+OperationResult transaction::Methods::count(std::string const& collectionName,
+                                            bool aggregate, bool exact) {
   TRI_ASSERT(_state->status() == transaction::Status::RUNNING);
 
   if (_state->isCoordinator()) {
-    return countCoordinator(collectionName, aggregate);
+    return countCoordinator(collectionName, aggregate, exact);
   }
 
   return countLocal(collectionName);
@@ -2273,9 +2180,10 @@ OperationResult transaction::Methods::count(std::string const& collectionName, b
 /// @brief count the number of documents in a collection
 #ifndef USE_ENTERPRISE
 OperationResult transaction::Methods::countCoordinator(std::string const& collectionName, 
-                                              bool aggregate) {
+                                              bool aggregate, bool exact) {
   std::vector<std::pair<std::string, uint64_t>> count;
-  int res = arangodb::countOnCoordinator(databaseName(), collectionName, count);
+  int res = arangodb::countOnCoordinator(databaseName(), collectionName, count,
+                                         exact);
 
   if (res != TRI_ERROR_NO_ERROR) {
     return OperationResult(res);
@@ -286,8 +286,11 @@ class Methods {
   OperationResult truncate(std::string const& collectionName,
                            OperationOptions const& options);
   
-  /// @brief count the number of documents in a collection
-  OperationResult count(std::string const& collectionName, bool aggregate);
+  /// @brief count the number of documents in a collection. on a
+  /// coordinator, the count may be answered from the count cache unless
+  /// an exact count is requested
+  OperationResult count(std::string const& collectionName, bool aggregate,
+                        bool exact = false);
 
   /// @brief Gets the best fitting index for an AQL condition.
   /// note: the caller must have read-locked the underlying collection when
@@ -441,7 +444,8 @@ class Methods {
   OperationResult truncateLocal(std::string const& collectionName,
                                 OperationOptions& options);
   
-  OperationResult countCoordinator(std::string const& collectionName, bool aggregate);
+  OperationResult countCoordinator(std::string const& collectionName,
+                                   bool aggregate, bool exact);
   OperationResult countLocal(std::string const& collectionName);
   
  protected:
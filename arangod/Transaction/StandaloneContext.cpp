@@ -25,8 +25,40 @@
 #include "StorageEngine/TransactionState.h"
 #include "Utils/CollectionNameResolver.h"
 
+#include <velocypack/Builder.h>
+
 using namespace arangodb;
 
+namespace {
+/// @brief maximum number of contexts recycled per thread
+size_t const MaxRecycledContexts = 4;
+
+/// @brief maximum size of a builder's buffer that is kept when a context is
+/// recycled, so a single large operation does not pin its memory
+arangodb::velocypack::ValueLength const MaxRecycledBuilderSize = 64 * 1024;
+
+/// @brief the recycled contexts of a thread
+struct RecycledContexts {
+  RecycledContexts() { contexts.reserve(MaxRecycledContexts); }
+  ~RecycledContexts();
+
+  std::vector<transaction::StandaloneContext*> contexts;
+};
+
+/// @brief set when the thread's list of recycled contexts has been
+/// destroyed. contexts released after that are destroyed directly
+thread_local bool RecyclingDisabled = false;
+
+thread_local RecycledContexts Recycled;
+
+RecycledContexts::~RecycledContexts() {
+  RecyclingDisabled = true;
+  for (auto& it : contexts) {
+    delete it;
+  }
+}
+}
+
 /// @brief create the context
 transaction::StandaloneContext::StandaloneContext(TRI_vocbase_t* vocbase)
     : Context(vocbase) {}
@@ -57,3 +89,45 @@ std::shared_ptr<transaction::StandaloneContext> transaction::StandaloneContext::
   return std::make_shared<transaction::StandaloneContext>(vocbase);
 }
 
+/// @brief create a context that is recycled when it is no longer used
+std::shared_ptr<transaction::StandaloneContext> transaction::StandaloneContext::CreateRecycled(TRI_vocbase_t* vocbase) {
+  transaction::StandaloneContext* context = nullptr;
+
+  if (!RecyclingDisabled && !Recycled.contexts.empty()) {
+    context = Recycled.contexts.back();
+    Recycled.contexts.pop_back();
+    context->reset(vocbase);
+  } else {
+    context = new transaction::StandaloneContext(vocbase);
+  }
+
+  // if the shared_ptr cannot be created, it calls the deleter itself
+  return std::shared_ptr<transaction::StandaloneContext>(context, &recycle);
+}
+
+/// @brief put a context that is no longer used into the current thread's
+/// list of recycled contexts, or destroy it
+void transaction::StandaloneContext::recycle(transaction::StandaloneContext* context) {
+  if (RecyclingDisabled || Recycled.contexts.size() >= MaxRecycledContexts) {
+    delete context;
+    return;
+  }
+
+  // release everything that refers to the transaction now, so pinned data
+  // does not stay pinned while the context is idle
+  context->reset(context->_vocbase);
+
+  // drop builders that have grown large
+  for (size_t i = 0; i < context->_builders.size(); /* no increment */) {
+    if (context->_builders[i]->buffer()->capacity() > MaxRecycledBuilderSize) {
+      delete context->_builders[i];
+      context->_builders.erase(context->_builders.begin() + i);
+    } else {
+      ++i;
+    }
+  }
+
+  // cannot throw, as the capacity was reserved
+  Recycled.contexts.emplace_back(context);
+}
+
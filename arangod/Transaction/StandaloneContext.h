@@ -68,6 +68,18 @@ class StandaloneContext final : public Context {
   /// @brief create a context, returned in a shared ptr
   static std::shared_ptr<transaction::StandaloneContext> Create(TRI_vocbase_t*);
 
+  /// @brief create a context that is recycled instead of destroyed when it
+  /// is no longer used. recycled contexts are kept per thread, so the builders
+  /// and buffers leased by one transaction are reused by the next one of the
+  /// same thread. meant for short transactions, e.g. single-document
+  /// operations
+  static std::shared_ptr<transaction::StandaloneContext> CreateRecycled(TRI_vocbase_t*);
+
+ private:
+  /// @brief put a context that is no longer used into the current thread's
+  /// list of recycled contexts, or destroy it
+  static void recycle(transaction::StandaloneContext*);
+
 };
 
 }
@@ -24,6 +24,9 @@
 #include "CollectionExport.h"
 #include "Basics/WriteLocker.h"
 #include "MMFiles/MMFilesDitch.h"
+#include "MMFiles/MMFilesIndexElement.h"
+#include "MMFiles/MMFilesPrimaryIndex.h"
+#include "MMFiles/MMFilesToken.h"
 #include "StorageEngine/EngineSelectorFeature.h"
 #include "StorageEngine/StorageEngine.h"
 #include "Utils/CollectionGuard.h"
@@ -35,8 +38,38 @@
 #include "VocBase/vocbase.h"
 #include "MMFiles/MMFilesCollection.h" //TODO -- REMOVE
 
+#include <velocypack/Builder.h>
+#include <velocypack/Iterator.h>
+#include <velocypack/velocypack-aliases.h>
+
 using namespace arangodb;
 
+static bool IncludeAttribute(
+    CollectionExport::Restrictions::Type const restrictionType,
+    std::unordered_set<std::string> const& fields, std::string const& key) {
+  if (restrictionType == CollectionExport::Restrictions::RESTRICTION_INCLUDE ||
+      restrictionType == CollectionExport::Restrictions::RESTRICTION_EXCLUDE) {
+    bool const keyContainedInRestrictions = (fields.find(key) != fields.end());
+    if ((restrictionType ==
+             CollectionExport::Restrictions::RESTRICTION_INCLUDE &&
+         !keyContainedInRestrictions) ||
+        (restrictionType ==
+             CollectionExport::Restrictions::RESTRICTION_EXCLUDE &&
+         keyContainedInRestrictions)) {
+      // exclude the field
+      return false;
+    }
+    // include the field
+    return true;
+  } else {
+    // no restrictions
+    TRI_ASSERT(restrictionType ==
+               CollectionExport::Restrictions::RESTRICTION_NONE);
+    return true;
+  }
+  return true;
+}
+
 CollectionExport::CollectionExport(TRI_vocbase_t* vocbase,
                                    std::string const& name,
                                    Restrictions const& restrictions)
@@ -44,7 +77,13 @@ CollectionExport::CollectionExport(TRI_vocbase_t* vocbase,
       _ditch(nullptr),
       _name(name),
       _resolver(vocbase),
-      _restrictions(restrictions) {
+      _restrictions(restrictions),
+      _count(0),
+      _streaming(false),
+      _exhausted(false),
+      _remaining(0),
+      _position(),
+      _total(0) {
   // prevent the collection from being unloaded while the export is ongoing
   // this may throw
   _guard.reset(new arangodb::CollectionGuard(vocbase, _name.c_str(), false));
@@ -59,7 +98,7 @@ CollectionExport::~CollectionExport() {
   }
 }
 
-void CollectionExport::run(uint64_t maxWaitTime, size_t limit) {
+void CollectionExport::createDitch(uint64_t maxWaitTime) {
   StorageEngine* engine = EngineSelectorFeature::ENGINE;
 
   // try to acquire the exclusive lock on the compaction
@@ -88,6 +127,10 @@ void CollectionExport::run(uint64_t maxWaitTime, size_t limit) {
       usleep(SleepTime);
     }
   }
+}
+
+void CollectionExport::run(uint64_t maxWaitTime, size_t limit) {
+  createDitch(maxWaitTime);
 
   {
     SingleCollectionTransaction trx(
@@ -126,6 +169,8 @@ void CollectionExport::run(uint64_t maxWaitTime, size_t limit) {
     trx.finish(res);
   }
 
+  _count = _vpack.size();
+
   // delete guard right now as we're about to return
   // if we would continue holding the guard's collection lock and return,
   // and the export object gets later freed in a different thread, then all
@@ -135,3 +180,107 @@ void CollectionExport::run(uint64_t maxWaitTime, size_t limit) {
   // datafiles etc.)
   _guard.reset();
 }
+
+void CollectionExport::runStreaming(uint64_t maxWaitTime, size_t limit) {
+  createDitch(maxWaitTime);
+
+  _streaming = true;
+  _count = _collection->numberDocuments();
+  if (limit > 0 && limit < _count) {
+    _count = limit;
+  }
+  _remaining = (limit > 0) ? limit : SIZE_MAX;
+  _exhausted = (_remaining == 0);
+
+  // the ditch prevents the unloading of the collection from now on,
+  // see the comment at the end of run()
+  _guard.reset();
+}
+
+size_t CollectionExport::fetch(VPackBuilder& builder, size_t batchSize) {
+  TRI_ASSERT(_streaming);
+
+  if (_exhausted) {
+    return 0;
+  }
+
+  // every batch uses its own short transaction, so concurrent writers are
+  // only blocked while this batch is read
+  SingleCollectionTransaction trx(
+      transaction::StandaloneContext::Create(_collection->vocbase()), _name,
+      AccessMode::Type::READ);
+
+  int res = trx.begin();
+
+  if (res != TRI_ERROR_NO_ERROR) {
+    THROW_ARANGO_EXCEPTION(res);
+  }
+
+  MMFilesPrimaryIndex* primaryIndex =
+      MMFilesCollection::toMMFilesCollection(_collection)->primaryIndex();
+  ManagedDocumentResult mmdr;
+  size_t count = 0;
+
+  while (count < batchSize && _remaining > 0) {
+    MMFilesSimpleIndexElement element =
+        primaryIndex->lookupSequential(&trx, _position, _total);
+
+    if (!element) {
+      _exhausted = true;
+      break;
+    }
+
+    if (_collection->readDocumentConditional(
+            &trx, MMFilesToken{element.revisionId()}, 0, mmdr)) {
+      // the projection is applied right away, so only the exported
+      // attributes are copied
+      appendDocument(builder, VPackSlice(mmdr.vpack()), _restrictions);
+      ++count;
+      --_remaining;
+    }
+  }
+
+  if (!_exhausted) {
+    if (_remaining == 0) {
+      _exhausted = true;
+    } else {
+      // check whether there is another document, so the caller can tell
+      // the client whether more batches follow
+      arangodb::basics::BucketPosition const position = _position;
+      if (!primaryIndex->lookupSequential(&trx, _position, _total)) {
+        _exhausted = true;
+      }
+      _position = position;
+    }
+  }
+
+  trx.finish(res);
+
+  return count;
+}
+
+void CollectionExport::appendDocument(VPackBuilder& builder,
+                                      VPackSlice const& slice,
+                                      Restrictions const& restrictions) {
+  auto const restrictionType = restrictions.type;
+
+  builder.openObject();
+  // Copy over shaped values
+  for (auto const& entry : VPackObjectIterator(slice)) {
+    std::string key(entry.key.copyString());
+
+    if (!IncludeAttribute(restrictionType, restrictions.fields, key)) {
+      // Ignore everything that should be excluded or not included
+      continue;
+    }
+    // If we get here we need this entry in the final result
+    if (entry.value.isCustom()) {
+      builder.add(key,
+                  VPackValue(builder.options->customTypeHandler->toString(
+                      entry.value, builder.options, slice)));
+    } else {
+      builder.add(key, entry.value);
+    }
+  }
+  builder.close();
+}
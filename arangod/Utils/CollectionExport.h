@@ -25,6 +25,7 @@
 #define ARANGOD_UTILS_COLLECTION_EXPORT_H 1
 
 #include "Basics/Common.h"
+#include "Basics/AssocUniqueHelpers.h"
 #include "Utils/CollectionNameResolver.h"
 #include "VocBase/ManagedDocumentResult.h"
 #include "VocBase/voc-types.h"
@@ -32,6 +33,10 @@
 struct TRI_vocbase_t;
 
 namespace arangodb {
+namespace velocypack {
+class Builder;
+class Slice;
+}
 
 class CollectionGuard;
 class MMFilesDocumentDitch;
@@ -58,8 +63,38 @@ class CollectionExport {
   ~CollectionExport();
 
  public:
+  /// @brief collect the documents to export up front
   void run(uint64_t, size_t);
 
+  /// @brief prepare a streaming export. no documents are collected up front,
+  /// instead each call to fetch() continues iterating the primary index. the
+  /// ditch keeps the documents returned by fetch() valid, but the export is
+  /// not isolated from concurrent modifications of the collection
+  void runStreaming(uint64_t, size_t);
+
+  /// @brief append up to the given number of documents of a streaming export
+  /// to the builder, which must have an open array. returns the number of
+  /// documents appended
+  size_t fetch(arangodb::velocypack::Builder&, size_t);
+
+  bool streaming() const { return _streaming; }
+
+  /// @brief whether a streaming export has returned all documents
+  bool exhausted() const { return _exhausted; }
+
+  /// @brief the number of documents to export. for streaming exports this
+  /// is the number of documents at the start of the export
+  size_t count() const { return _count; }
+
+  /// @brief append a document to the builder, leaving out the attributes
+  /// excluded by the restrictions
+  static void appendDocument(arangodb::velocypack::Builder&,
+                             arangodb::velocypack::Slice const&,
+                             Restrictions const&);
+
+ private:
+  void createDitch(uint64_t);
+
  private:
   std::unique_ptr<arangodb::CollectionGuard> _guard;
   LogicalCollection* _collection;
@@ -68,6 +103,14 @@ class CollectionExport {
   arangodb::CollectionNameResolver _resolver;
   Restrictions _restrictions;
   std::vector<uint8_t const*> _vpack;
+  size_t _count;
+  bool _streaming;
+  bool _exhausted;
+  /// @brief number of documents a streaming export may still return
+  size_t _remaining;
+  /// @brief position of a streaming export in the primary index
+  arangodb::basics::BucketPosition _position;
+  uint64_t _total;
 };
 }
 
@@ -55,7 +55,7 @@ CollectionKeys::CollectionKeys(TRI_vocbase_t* vocbase, std::string const& name,
       _ttl(ttl),
       _expires(0.0),
       _isDeleted(false),
-      _isUsed(false) {
+      _usage(0) {
   _id = TRI_NewTickServer();
   _expires = TRI_microtime() + _ttl;
   TRI_ASSERT(_blockerId > 0);
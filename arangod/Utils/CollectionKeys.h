@@ -62,23 +62,24 @@ class CollectionKeys {
 
   double expires() const { return _expires; }
 
-  bool isUsed() const { return _isUsed; }
+  bool isUsed() const { return _usage > 0; }
 
   bool isDeleted() const { return _isDeleted; }
 
   void deleted() { _isDeleted = true; }
 
+  /// @brief the keys are never modified after create(), so several
+  /// requests may use them at the same time
   void use() {
     TRI_ASSERT(!_isDeleted);
-    TRI_ASSERT(!_isUsed);
 
-    _isUsed = true;
+    ++_usage;
     _expires = TRI_microtime() + _ttl;
   }
 
   void release() {
-    TRI_ASSERT(_isUsed);
-    _isUsed = false;
+    TRI_ASSERT(_usage > 0);
+    --_usage;
   }
 
   size_t count() const {
@@ -123,7 +124,7 @@ class CollectionKeys {
   double _ttl;
   double _expires;
   bool _isDeleted;
-  bool _isUsed;
+  size_t _usage;
   std::vector<uint8_t const*> _vpack;
 };
 }
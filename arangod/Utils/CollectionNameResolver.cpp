@@ -24,7 +24,6 @@
 #include "CollectionNameResolver.h"
 
 #include "Basics/Common.h"
-#include "Basics/ReadLocker.h"
 #include "Basics/StringUtils.h"
 #include "Cluster/ClusterInfo.h"
 #include "VocBase/LogicalCollection.h"
@@ -263,21 +262,20 @@ std::string CollectionNameResolver::localNameLookup(TRI_voc_cid_t cid) const {
   std::string name;
 
   if (ServerState::isDBServer(_serverRole)) {
-    READ_LOCKER(readLocker, _vocbase->_collectionsLock);
+    // uses the vocbase-wide name snapshot, no need to lock the vocbase
+    LogicalCollection const* collection = _vocbase->lookupCollection(cid);
 
-    auto it = _vocbase->_collectionsById.find(cid);
-
-    if (it != _vocbase->_collectionsById.end()) {
-      if ((*it).second->planId() == (*it).second->cid()) {
+    if (collection != nullptr) {
+      if (collection->planId() == collection->cid()) {
         // DBserver local case
-        name = (*it).second->name();
+        name = _vocbase->collectionName(cid);
       } else {
         // DBserver case of a shard:
-        name = arangodb::basics::StringUtils::itoa((*it).second->planId());
+        name = arangodb::basics::StringUtils::itoa(collection->planId());
         std::shared_ptr<LogicalCollection> ci;
         try {
           ci = ClusterInfo::instance()->getCollection(
-              (*it).second->dbName(), name);
+              collection->dbName(), name);
         }
         catch (...) {
         }
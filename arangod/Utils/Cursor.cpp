@@ -22,6 +22,10 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "Cursor.h"
+#include "Aql/AqlItemBlock.h"
+#include "Aql/ExecutionBlock.h"
+#include "Aql/ExecutionEngine.h"
+#include "Aql/Query.h"
 #include "Basics/VPackStringBufferAdapter.h"
 #include "Basics/VelocyPackDumper.h"
 #include "Basics/VelocyPackHelper.h"
@@ -29,6 +33,7 @@
 #include "Utils/CollectionNameResolver.h"
 #include "Transaction/StandaloneContext.h"
 #include "Transaction/Context.h"
+#include "Transaction/Methods.h"
 #include "VocBase/vocbase.h"
 
 #include <velocypack/Builder.h>
@@ -169,7 +174,7 @@ ExportCursor::ExportCursor(TRI_vocbase_t* vocbase, CursorId id,
     : Cursor(id, batchSize, nullptr, ttl, hasCount),
       _vocbaseGuard(vocbase),
       _ex(ex),
-      _size(ex->_vpack.size()) {}
+      _size(ex->count()) {}
 
 ExportCursor::~ExportCursor() { delete _ex; }
 
@@ -182,6 +187,10 @@ bool ExportCursor::hasNext() {
     return false;
   }
 
+  if (_ex->streaming()) {
+    return !_ex->exhausted();
+  }
+
   return (_position < _size);
 }
 
@@ -200,32 +209,6 @@ VPackSlice ExportCursor::next() {
 
 size_t ExportCursor::count() const { return _size; }
 
-static bool IncludeAttribute(
-    CollectionExport::Restrictions::Type const restrictionType,
-    std::unordered_set<std::string> const& fields, std::string const& key) {
-  if (restrictionType == CollectionExport::Restrictions::RESTRICTION_INCLUDE ||
-      restrictionType == CollectionExport::Restrictions::RESTRICTION_EXCLUDE) {
-    bool const keyContainedInRestrictions = (fields.find(key) != fields.end());
-    if ((restrictionType ==
-             CollectionExport::Restrictions::RESTRICTION_INCLUDE &&
-         !keyContainedInRestrictions) ||
-        (restrictionType ==
-             CollectionExport::Restrictions::RESTRICTION_EXCLUDE &&
-         keyContainedInRestrictions)) {
-      // exclude the field
-      return false;
-    }
-    // include the field
-    return true;
-  } else {
-    // no restrictions
-    TRI_ASSERT(restrictionType ==
-               CollectionExport::Restrictions::RESTRICTION_NONE);
-    return true;
-  }
-  return true;
-}
-
 void ExportCursor::dump(VPackBuilder& builder) {
   auto transactionContext =
       std::make_shared<transaction::StandaloneContext>(_vocbaseGuard.vocbase());
@@ -235,39 +218,24 @@ void ExportCursor::dump(VPackBuilder& builder) {
   builder.options = transactionContext->getVPackOptions();
 
   TRI_ASSERT(_ex != nullptr);
-  auto const restrictionType = _ex->_restrictions.type;
 
   try {
     builder.add("result", VPackValue(VPackValueType::Array));
     size_t const n = batchSize();
 
-    for (size_t i = 0; i < n; ++i) {
-      if (!hasNext()) {
-        break;
-      }
-
-      VPackSlice const slice(
-          reinterpret_cast<char const*>(_ex->_vpack.at(_position++)));
-      builder.openObject();
-      // Copy over shaped values
-      for (auto const& entry : VPackObjectIterator(slice)) {
-        std::string key(entry.key.copyString());
-
-        if (!IncludeAttribute(restrictionType, _ex->_restrictions.fields,
-                              key)) {
-          // Ignore everything that should be excluded or not included
-          continue;
-        }
-        // If we get here we need this entry in the final result
-        if (entry.value.isCustom()) {
-          builder.add(key,
-                      VPackValue(builder.options->customTypeHandler->toString(
-                          entry.value, builder.options, slice)));
-        } else {
-          builder.add(key, entry.value);
+    if (_ex->streaming()) {
+      // documents are read from the collection batch by batch
+      _position += _ex->fetch(builder, n);
+    } else {
+      for (size_t i = 0; i < n; ++i) {
+        if (!hasNext()) {
+          break;
         }
+
+        VPackSlice const slice(
+            reinterpret_cast<char const*>(_ex->_vpack.at(_position++)));
+        CollectionExport::appendDocument(builder, slice, _ex->_restrictions);
       }
-      builder.close();
     }
     builder.close();  // close Array
 
@@ -302,3 +270,190 @@ void ExportCursor::dump(VPackBuilder& builder) {
   }
   builder.options = oldOptions;
 }
+
+QueryStreamCursor::QueryStreamCursor(TRI_vocbase_t* vocbase, CursorId id,
+                                     std::string const& query,
+                                     std::shared_ptr<VPackBuilder> bindVars,
+                                     std::shared_ptr<VPackBuilder> opts,
+                                     size_t batchSize, double ttl,
+                                     aql::QueryRegistry* registry)
+    : Cursor(id, batchSize, nullptr, ttl, false),
+      _vocbaseGuard(vocbase),
+      _queryString(query),
+      _posInBlock(0),
+      _finalized(false) {
+  _query.reset(new aql::Query(false, vocbase, _queryString.c_str(),
+                              _queryString.size(), bindVars, opts,
+                              aql::PART_MAIN));
+  // will throw if it fails
+  _query->prepareStreaming(registry);
+
+  TRI_ASSERT(_query->trx() != nullptr);
+  _context = _query->trx()->transactionContext();
+}
+
+QueryStreamCursor::~QueryStreamCursor() {
+  // the block must be freed before the query. if the query was not
+  // finalized, its transaction is aborted here
+  _block.reset();
+  _query.reset();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief check whether the cursor contains more data
+////////////////////////////////////////////////////////////////////////////////
+
+bool QueryStreamCursor::hasNext() {
+  if (_block == nullptr && !_finalized) {
+    fetchBlock();
+  }
+
+  return (_block != nullptr);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the next element. the slice is valid until the next call
+////////////////////////////////////////////////////////////////////////////////
+
+VPackSlice QueryStreamCursor::next() {
+  TRI_ASSERT(_block != nullptr);
+  TRI_ASSERT(_posInBlock < _block->size());
+
+  auto const resultRegister = _query->engine()->resultRegister();
+  aql::AqlValue const& val =
+      _block->getValueReference(_posInBlock++, resultRegister);
+
+  _current.clear();
+  val.toVelocyPack(_query->trx(), _current, true);
+
+  if (_posInBlock >= _block->size()) {
+    _block.reset();
+  }
+
+  return _current.slice();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the cursor size. the number of results of a streaming
+/// query is not known in advance
+////////////////////////////////////////////////////////////////////////////////
+
+size_t QueryStreamCursor::count() const { return 0; }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief fetch the next block of results from the query's engine
+////////////////////////////////////////////////////////////////////////////////
+
+void QueryStreamCursor::fetchBlock() {
+  TRI_ASSERT(_block == nullptr);
+  TRI_ASSERT(!_finalized);
+
+  auto engine = _query->engine();
+  TRI_ASSERT(engine != nullptr);
+
+  _block.reset(engine->getSome(1, engine->root()->batchSize()));
+  _posInBlock = 0;
+
+  if (_block == nullptr) {
+    // query is done
+    finalize();
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief commit the query and build the extra values from its statistics
+////////////////////////////////////////////////////////////////////////////////
+
+void QueryStreamCursor::finalize() {
+  aql::QueryResult result = _query->finalize();
+  _finalized = true;
+
+  _extra = std::make_shared<VPackBuilder>();
+  VPackObjectBuilder b(_extra.get());
+  if (result.stats != nullptr) {
+    VPackSlice stats = result.stats->slice();
+    if (!stats.isNone()) {
+      _extra->add("stats", stats);
+    }
+  }
+  if (result.profile != nullptr) {
+    _extra->add("profile", result.profile->slice());
+  }
+  if (result.warnings == nullptr) {
+    _extra->add("warnings", VPackValue(VPackValueType::Array));
+    _extra->close();
+  } else {
+    _extra->add("warnings", result.warnings->slice());
+  }
+}
+
+void QueryStreamCursor::dump(VPackBuilder& builder) {
+  try {
+    VPackOptions const* oldOptions = builder.options;
+
+    builder.options = _context->getVPackOptionsForDump();
+
+    builder.add("result", VPackValue(VPackValueType::Array));
+    size_t const n = batchSize();
+    size_t num = 0;
+
+    while (num < n && hasNext()) {
+      // this is the RegisterId our results can be found in
+      auto const resultRegister = _query->engine()->resultRegister();
+      size_t const rows = _block->size();
+
+      for (; _posInBlock < rows && num < n; ++_posInBlock) {
+        aql::AqlValue const& val =
+            _block->getValueReference(_posInBlock, resultRegister);
+
+        if (!val.isEmpty()) {
+          val.toVelocyPack(_query->trx(), builder, false);
+          ++num;
+        }
+      }
+
+      if (_posInBlock >= rows) {
+        _block.reset();
+      }
+    }
+    builder.close();
+
+    // this fetches the next block, or finalizes the query if there are
+    // no more results
+    bool const hasMore = hasNext();
+    builder.add("hasMore", VPackValue(hasMore));
+
+    if (hasMore) {
+      builder.add("id", VPackValue(std::to_string(id())));
+    }
+
+    if (extra().isObject()) {
+      builder.add("extra", extra());
+    }
+
+    builder.add("cached", VPackValue(false));
+
+    if (!hasMore) {
+      // mark the cursor as deleted
+      this->deleted();
+    }
+    builder.options = oldOptions;
+  } catch (arangodb::basics::Exception const& ex) {
+    // the query cannot be continued after an error
+    this->deleted();
+    _query->exitContext();
+    THROW_ARANGO_EXCEPTION_MESSAGE(ex.code(), ex.what());
+  } catch (std::exception const& ex) {
+    this->deleted();
+    _query->exitContext();
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL, ex.what());
+  } catch (...) {
+    this->deleted();
+    _query->exitContext();
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL, "internal error during QueryStreamCursor::dump");
+  }
+
+  // don't hold on to a V8 context until the next batch is requested. the
+  // blocks enter a context again when they need one
+  _query->exitContext();
+}
@@ -30,6 +30,7 @@
 #include "VocBase/voc-types.h"
 #include "VocBase/vocbase.h"
 
+#include <velocypack/Builder.h>
 #include <velocypack/Iterator.h>
 
 namespace arangodb {
@@ -38,6 +39,16 @@ class Builder;
 class Slice;
 }
 
+namespace aql {
+class AqlItemBlock;
+class Query;
+class QueryRegistry;
+}
+
+namespace transaction {
+class Context;
+}
+
 class CollectionExport;
 
 typedef TRI_voc_tick_t CursorId;
@@ -105,6 +116,9 @@ class Cursor {
 
   virtual void dump(VPackBuilder&) = 0;
 
+  /// @brief the transaction context to be used for dumping the results
+  virtual std::shared_ptr<transaction::Context> context() const = 0;
+
  protected:
   CursorId const _id;
   size_t const _batchSize;
@@ -138,6 +152,10 @@ class VelocyPackCursor final : public Cursor {
 
   void dump(VPackBuilder&) override final;
 
+  std::shared_ptr<transaction::Context> context() const override final {
+    return _result.context;
+  }
+
  private:
   VocbaseGuard _vocbaseGuard;
   aql::QueryResult _result;
@@ -163,11 +181,64 @@ class ExportCursor final : public Cursor {
 
   void dump(VPackBuilder&) override final;
 
+  /// @brief export cursors create their own context for dumping
+  std::shared_ptr<transaction::Context> context() const override final {
+    return nullptr;
+  }
+
  private:
   VocbaseGuard _vocbaseGuard;
   arangodb::CollectionExport* _ex;
   size_t const _size;
 };
+
+/// @brief a cursor that keeps its query running and only produces the
+/// results of the next batch when they are requested
+class QueryStreamCursor final : public Cursor {
+ public:
+  QueryStreamCursor(TRI_vocbase_t*, CursorId, std::string const&,
+                    std::shared_ptr<arangodb::velocypack::Builder>,
+                    std::shared_ptr<arangodb::velocypack::Builder>, size_t,
+                    double, aql::QueryRegistry*);
+
+  ~QueryStreamCursor();
+
+ public:
+  CursorType type() const override final { return CURSOR_VPACK; }
+
+  bool hasNext() override final;
+
+  arangodb::velocypack::Slice next() override final;
+
+  size_t count() const override final;
+
+  void dump(VPackBuilder&) override final;
+
+  std::shared_ptr<transaction::Context> context() const override final {
+    return _context;
+  }
+
+ private:
+  /// @brief fetch the next block of results from the query's engine, and
+  /// finalize the query if there are no more results
+  void fetchBlock();
+
+  /// @brief commit the query and build the extra values from its statistics
+  void finalize();
+
+ private:
+  VocbaseGuard _vocbaseGuard;
+  /// @brief the query string, which must outlive the query
+  std::string const _queryString;
+  std::unique_ptr<aql::Query> _query;
+  std::shared_ptr<transaction::Context> _context;
+  /// @brief the current block of results and the position in it
+  std::unique_ptr<aql::AqlItemBlock> _block;
+  size_t _posInBlock;
+  /// @brief buffer for the value returned by next()
+  arangodb::velocypack::Builder _current;
+  bool _finalized;
+};
 }
 
 #endif
@@ -40,8 +40,10 @@ size_t const CursorRepository::MaxCollectCount = 32;
 ////////////////////////////////////////////////////////////////////////////////
 
 CursorRepository::CursorRepository(TRI_vocbase_t* vocbase)
-    : _vocbase(vocbase), _lock(), _cursors() {
-  _cursors.reserve(64);
+    : _vocbase(vocbase), _shards() {
+  for (auto& it : _shards) {
+    it._cursors.reserve(8);
+  }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -72,14 +74,14 @@ CursorRepository::~CursorRepository() {
     ++tries;
   }
 
-  {
-    MUTEX_LOCKER(mutexLocker, _lock);
+  for (auto& shard : _shards) {
+    MUTEX_LOCKER(mutexLocker, shard._lock);
 
-    for (auto it : _cursors) {
+    for (auto it : shard._cursors) {
       delete it.second;
     }
 
-    _cursors.clear();
+    shard._cursors.clear();
   }
 }
 
@@ -101,14 +103,33 @@ VelocyPackCursor* CursorRepository::createFromQueryResult(
       _vocbase, id, std::move(result), batchSize, extra, ttl, count);
   cursor->use();
 
-  try {
-    MUTEX_LOCKER(mutexLocker, _lock);
-    _cursors.emplace(std::make_pair(id, cursor));
-    return cursor;
-  } catch (...) {
-    delete cursor;
-    throw;
-  }
+  insert(cursor);
+  return cursor;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief creates a cursor for a query whose results are produced batch-wise
+/// and stores it in the registry
+/// the cursor will be returned with the usage flag set to true. it must be
+/// returned later using release()
+////////////////////////////////////////////////////////////////////////////////
+
+QueryStreamCursor* CursorRepository::createQueryStream(
+    std::string const& query, std::shared_ptr<VPackBuilder> bindVars,
+    std::shared_ptr<VPackBuilder> opts, size_t batchSize, double ttl,
+    aql::QueryRegistry* registry) {
+  CursorId const id = TRI_NewTickServer();
+
+  // this will prepare the query, and throw if that fails
+  std::unique_ptr<arangodb::QueryStreamCursor> cursor(
+      new arangodb::QueryStreamCursor(_vocbase, id, query, bindVars, opts,
+                                      batchSize, ttl, registry));
+  cursor->use();
+
+  // the repository takes ownership, even if storing the cursor fails
+  QueryStreamCursor* result = cursor.release();
+  insert(result);
+  return result;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -126,10 +147,21 @@ ExportCursor* CursorRepository::createFromExport(arangodb::CollectionExport* ex,
 
   cursor->use();
 
+  insert(cursor);
+  return cursor;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief stores a cursor in the registry, which takes ownership of it
+////////////////////////////////////////////////////////////////////////////////
+
+void CursorRepository::insert(Cursor* cursor) {
+  TRI_ASSERT(cursor->isUsed());
+
   try {
-    MUTEX_LOCKER(mutexLocker, _lock);
-    _cursors.emplace(std::make_pair(id, cursor));
-    return cursor;
+    Shard& shard = this->shard(cursor->id());
+    MUTEX_LOCKER(mutexLocker, shard._lock);
+    shard._cursors.emplace(cursor->id(), cursor);
   } catch (...) {
     delete cursor;
     throw;
@@ -144,10 +176,11 @@ bool CursorRepository::remove(CursorId id, Cursor::CursorType type) {
   arangodb::Cursor* cursor = nullptr;
 
   {
-    MUTEX_LOCKER(mutexLocker, _lock);
+    Shard& shard = this->shard(id);
+    MUTEX_LOCKER(mutexLocker, shard._lock);
 
-    auto it = _cursors.find(id);
-    if (it == _cursors.end()) {
+    auto it = shard._cursors.find(id);
+    if (it == shard._cursors.end()) {
       // not found
       return false;
     }
@@ -171,7 +204,7 @@ bool CursorRepository::remove(CursorId id, Cursor::CursorType type) {
     }
 
     // cursor not in use by someone else
-    _cursors.erase(it);
+    shard._cursors.erase(it);
   }
 
   TRI_ASSERT(cursor != nullptr);
@@ -191,10 +224,11 @@ Cursor* CursorRepository::find(CursorId id, Cursor::CursorType type, bool& busy)
   busy = false;
 
   {
-    MUTEX_LOCKER(mutexLocker, _lock);
+    Shard& shard = this->shard(id);
+    MUTEX_LOCKER(mutexLocker, shard._lock);
 
-    auto it = _cursors.find(id);
-    if (it == _cursors.end()) {
+    auto it = shard._cursors.find(id);
+    if (it == shard._cursors.end()) {
       // not found
       return nullptr;
     }
@@ -228,7 +262,8 @@ Cursor* CursorRepository::find(CursorId id, Cursor::CursorType type, bool& busy)
 
 void CursorRepository::release(Cursor* cursor) {
   {
-    MUTEX_LOCKER(mutexLocker, _lock);
+    Shard& shard = this->shard(cursor->id());
+    MUTEX_LOCKER(mutexLocker, shard._lock);
 
     TRI_ASSERT(cursor->isUsed());
     cursor->release();
@@ -238,7 +273,7 @@ void CursorRepository::release(Cursor* cursor) {
     }
 
     // remove from the list
-    _cursors.erase(cursor->id());
+    shard._cursors.erase(cursor->id());
   }
 
   // and free the cursor
@@ -250,11 +285,13 @@ void CursorRepository::release(Cursor* cursor) {
 ////////////////////////////////////////////////////////////////////////////////
 
 bool CursorRepository::containsUsedCursor() {
-  MUTEX_LOCKER(mutexLocker, _lock);
+  for (auto& shard : _shards) {
+    MUTEX_LOCKER(mutexLocker, shard._lock);
 
-  for (auto it : _cursors) {
-    if (it.second->isUsed()) {
-      return true;
+    for (auto it : shard._cursors) {
+      if (it.second->isUsed()) {
+        return true;
+      }
     }
   }
 
@@ -272,35 +309,46 @@ bool CursorRepository::garbageCollect(bool force) {
   try {
     found.reserve(MaxCollectCount);
 
-    MUTEX_LOCKER(mutexLocker, _lock);
-
-    for (auto it = _cursors.begin(); it != _cursors.end(); /* no hoisting */) {
-      auto cursor = (*it).second;
+    bool done = false;
 
-      if (cursor->isUsed()) {
-        // must not destroy used cursors
-        ++it;
-        continue;
+    for (auto& shard : _shards) {
+      if (done) {
+        break;
       }
 
-      if (force || cursor->expires() < now) {
-        cursor->deleted();
-      }
+      MUTEX_LOCKER(mutexLocker, shard._lock);
+
+      for (auto it = shard._cursors.begin(); it != shard._cursors.end();
+           /* no hoisting */) {
+        auto cursor = (*it).second;
+
+        if (cursor->isUsed()) {
+          // must not destroy used cursors
+          ++it;
+          continue;
+        }
 
-      if (cursor->isDeleted()) {
-        try {
-          found.emplace_back(cursor);
-          it = _cursors.erase(it);
-        } catch (...) {
-          // stop iteration
-          break;
+        if (force || cursor->expires() < now) {
+          cursor->deleted();
         }
 
-        if (!force && found.size() >= MaxCollectCount) {
-          break;
+        if (cursor->isDeleted()) {
+          try {
+            found.emplace_back(cursor);
+            it = shard._cursors.erase(it);
+          } catch (...) {
+            // stop iteration
+            done = true;
+            break;
+          }
+
+          if (!force && found.size() >= MaxCollectCount) {
+            done = true;
+            break;
+          }
+        } else {
+          ++it;
         }
-      } else {
-        ++it;
       }
     }
   } catch (...) {
@@ -37,6 +37,7 @@ class Builder;
 }
 
 namespace aql {
+class QueryRegistry;
 struct QueryResult;
 }
 
@@ -68,6 +69,18 @@ class CursorRepository {
       aql::QueryResult&&, size_t, std::shared_ptr<arangodb::velocypack::Builder>,
       double, bool);
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief creates a cursor for a query whose results are produced batch-wise
+  /// and stores it in the registry
+  /// the cursor will be returned with the usage flag set to true. it must be
+  /// returned later using release()
+  //////////////////////////////////////////////////////////////////////////////
+
+  QueryStreamCursor* createQueryStream(
+      std::string const&, std::shared_ptr<arangodb::velocypack::Builder>,
+      std::shared_ptr<arangodb::velocypack::Builder>, size_t, double,
+      aql::QueryRegistry*);
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief creates a cursor and stores it in the registry
   //////////////////////////////////////////////////////////////////////////////
@@ -75,6 +88,14 @@ class CursorRepository {
   ExportCursor* createFromExport(arangodb::CollectionExport*, size_t, double,
                                  bool);
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief stores a cursor in the registry, which takes ownership of it
+  /// the cursor must have the usage flag set to true. it must be returned
+  /// later using release()
+  //////////////////////////////////////////////////////////////////////////////
+
+  void insert(Cursor*);
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief remove a cursor by id
   //////////////////////////////////////////////////////////////////////////////
@@ -115,16 +136,38 @@ class CursorRepository {
   TRI_vocbase_t* _vocbase;
 
   //////////////////////////////////////////////////////////////////////////////
-  /// @brief mutex for the cursors repository
+  /// @brief number of shards of the cursors repository. every cursor access
+  /// locks the shard of the cursor only
+  //////////////////////////////////////////////////////////////////////////////
+
+  static constexpr size_t NumShards = 16;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief a part of the cursors repository, on its own cache line. the
+  /// usage flags of the cursors are protected by the mutex of their shard
+  //////////////////////////////////////////////////////////////////////////////
+
+#ifdef _WIN32
+  struct Shard {
+#else
+  struct alignas(64) Shard {
+#endif
+    Mutex _lock;
+
+    std::unordered_map<CursorId, Cursor*> _cursors;
+  };
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief return the shard responsible for a cursor id
   //////////////////////////////////////////////////////////////////////////////
 
-  Mutex _lock;
+  inline Shard& shard(CursorId id) { return _shards[id % NumShards]; }
 
   //////////////////////////////////////////////////////////////////////////////
-  /// @brief list of current cursors
+  /// @brief list of current cursors, sharded by cursor id
   //////////////////////////////////////////////////////////////////////////////
 
-  std::unordered_map<CursorId, Cursor*> _cursors;
+  Shard _shards[NumShards];
 
   //////////////////////////////////////////////////////////////////////////////
   /// @brief maximum number of cursors to garbage-collect in one go
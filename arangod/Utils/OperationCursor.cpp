@@ -97,6 +97,98 @@ bool OperationCursor::getMore(
   return _hasMore;
 }
 
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Appends the tokens of the next batchSize many elements
+///        to the vector, without a callback per element
+//////////////////////////////////////////////////////////////////////////////
+
+bool OperationCursor::getMoreTokens(std::vector<DocumentIdentifierToken>& tokens,
+                                    uint64_t batchSize) {
+  if (!hasMore()) {
+    return false;
+  }
+
+  if (batchSize == UINT64_MAX) {
+    batchSize = _batchSize;
+  }
+
+  size_t atMost = static_cast<size_t>(batchSize > _limit ? _limit : batchSize);
+
+#ifdef ARANGODB_ENABLE_MAINTAINER_MODE
+  size_t const before = tokens.size();
+#endif
+  _hasMore = _indexIterator->nextTokens(tokens, atMost);
+
+  if (_hasMore) {
+    // If the index says it has more elements than it need
+    // to return at least one.
+    // Otherweise progress is not guaranteed.
+#ifdef ARANGODB_ENABLE_MAINTAINER_MODE
+    TRI_ASSERT(tokens.size() > before);
+#endif
+    TRI_ASSERT(_limit >= atMost);
+    _limit -= atMost;
+  }
+  return _hasMore;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not the underlying index can produce extra values
+//////////////////////////////////////////////////////////////////////////////
+
+bool OperationCursor::hasExtra() const {
+  return _indexIterator != nullptr && _indexIterator->hasExtra();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Calls cb for the next batchSize many elements, together with
+///        the extra values the index produces for them.
+///        Check hasExtra()==true before using this
+//////////////////////////////////////////////////////////////////////////////
+
+bool OperationCursor::getMoreExtra(
+    std::function<void(DocumentIdentifierToken const& token,
+                       VPackSlice extra)> const& callback,
+    uint64_t batchSize) {
+  if (!hasMore()) {
+    return false;
+  }
+
+  TRI_ASSERT(hasExtra());
+
+  if (batchSize == UINT64_MAX) {
+    batchSize = _batchSize;
+  }
+
+  size_t atMost = static_cast<size_t>(batchSize > _limit ? _limit : batchSize);
+
+#ifdef ARANGODB_ENABLE_MAINTAINER_MODE
+  // We add wrapper around Callback that validates that
+  // the callback has been called at least once.
+  bool called = false;
+  auto cb = [&](DocumentIdentifierToken const& token, VPackSlice extra) {
+    called = true;
+    callback(token, extra);
+  };
+  _hasMore = _indexIterator->nextExtra(cb, atMost);
+  if (_hasMore) {
+    // If the index says it has more elements than it need
+    // to call callback at least once.
+    // Otherweise progress is not guaranteed.
+    TRI_ASSERT(called);
+  }
+#else
+  _hasMore = _indexIterator->nextExtra(callback, atMost);
+#endif
+
+  if (_hasMore) {
+    // We got atMost many callbacks
+    TRI_ASSERT(_limit >= atMost);
+    _limit -= atMost;
+  }
+  return _hasMore;
+}
+
 //////////////////////////////////////////////////////////////////////////////
 /// @brief Skip the next toSkip many elements.
 ///        skipped will be increased by the amount of skipped elements afterwards
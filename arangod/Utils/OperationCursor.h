@@ -105,6 +105,31 @@ struct OperationCursor {
       std::function<void(DocumentIdentifierToken const& token)> const& callback,
       uint64_t batchSize);
 
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Appends the tokens of the next batchSize many elements
+///        to the vector
+//////////////////////////////////////////////////////////////////////////////
+
+  bool getMoreTokens(std::vector<DocumentIdentifierToken>& tokens,
+                     uint64_t batchSize);
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not the underlying index can produce extra values
+//////////////////////////////////////////////////////////////////////////////
+
+  bool hasExtra() const;
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Calls cb for the next batchSize many elements, together with
+///        the extra values the index produces for them.
+///        Check hasExtra()==true before using this
+//////////////////////////////////////////////////////////////////////////////
+
+  bool getMoreExtra(
+      std::function<void(DocumentIdentifierToken const& token,
+                         arangodb::velocypack::Slice extra)> const& callback,
+      uint64_t batchSize);
+
 //////////////////////////////////////////////////////////////////////////////
 /// @brief Skip the next toSkip many elements.
 ///        skipped will be increased by the amount of skipped elements afterwards
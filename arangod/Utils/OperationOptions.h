@@ -32,7 +32,8 @@ struct OperationOptions {
   OperationOptions() 
       : recoveryData(nullptr), waitForSync(false), keepNull(true),
         mergeObjects(true), silent(false), ignoreRevs(true),
-        returnOld(false), returnNew(false), isRestore(false) {}
+        returnOld(false), returnNew(false), isRestore(false),
+        allowDirtyReads(false), maxStaleness(0.0) {}
 
   // original marker, set by an engine's recovery procedure only!
   void* recoveryData;
@@ -61,6 +62,15 @@ struct OperationOptions {
   // for insert operations: use _key value even when this is normally prohibited for the end user
   // this option is there to ensure _key values once set can be restored by replicated and arangorestore
   bool isRestore;
+
+  // for read operations in a cluster: the coordinator may send the read to
+  // an in-sync follower instead of the leader of a shard
+  bool allowDirtyReads;
+
+  // for reads with allowDirtyReads: a follower only answers if it has applied
+  // an operation of its leader within this number of seconds. 0 means that
+  // being in sync according to Current is enough
+  double maxStaleness;
 };
 
 }
@@ -51,32 +51,21 @@ void WorkMonitor::run() {
   uint32_t const minSleep = 100;
   uint32_t s = minSleep;
 
-  // clean old entries and create summary if requested
+  // handle cancel and overview requests. the work descriptions themselves
+  // are owned by their threads, there is nothing to clean up
   while (!isStopping()) {
     try {
       bool found = false;
-      WorkDescription* desc;
-
-      // handle freeable work descriptions
-      while (_freeableWorkDescription.pop(desc)) {
-        found = true;
-
-        if (desc != nullptr) {
-          deleteWorkDescription(desc, false);
-        }
-      }
-
-      if (found) {
-        s = minSleep;
-      } else if (s < maxSleep) {
-        s *= 2;
-      }
 
       // handle cancel requests
       {
         MUTEX_LOCKER(guard, _cancelLock);
 
         if (!_cancelIds.empty()) {
+          found = true;
+
+          MUTEX_LOCKER(threadsGuard, _threadsLock);
+
           for (auto thread : _threads) {
             cancelWorkDescriptions(thread);
           }
@@ -89,6 +78,8 @@ void WorkMonitor::run() {
       std::pair<std::shared_ptr<rest::RestHandler>, std::function<void()>>* hac;
 
       while (_workOverview.pop(hac)) {
+        found = true;
+
         VPackBuilder builder;
 
         builder.add(VPackValue(VPackValueType::Object));
@@ -100,7 +91,15 @@ void WorkMonitor::run() {
           MUTEX_LOCKER(guard, _threadsLock);
 
           for (auto& thread : _threads) {
-            WorkDescription* desc = thread->workDescription();
+            WorkStack* stack = thread->workStack();
+
+            if (stack == nullptr || !stack->tryBeginRead()) {
+              // the thread is busy pushing and popping descriptions
+              continue;
+            }
+
+            TRI_DEFER(stack->endRead());
+            WorkDescription* desc = stack->top();
 
             if (desc != nullptr) {
               builder.add(VPackValue(VPackValueType::Object));
@@ -117,6 +116,12 @@ void WorkMonitor::run() {
         hac->second();  // callback
         delete hac;
       }
+
+      if (found) {
+        s = minSleep;
+      } else if (s < maxSleep) {
+        s *= 2;
+      }
     } catch (...) {
       // must prevent propagation of exceptions from here
     }
@@ -124,25 +129,9 @@ void WorkMonitor::run() {
     guard.wait(s);
   }
 
-  // indicate that we stopped the work monitor, freeWorkDescription
-  // should directly delete old entries
+  // indicate that we stopped the work monitor
   _stopped.store(true);
 
-  // cleanup old entries
-  WorkDescription* desc;
-
-  while (_freeableWorkDescription.pop(desc)) {
-    if (desc != nullptr) {
-      deleteWorkDescription(desc, false);
-    }
-  }
-
-  while (_emptyWorkDescription.pop(desc)) {
-    if (desc != nullptr) {
-      delete desc;
-    }
-  }
-
   clearAllHandlers();
 }
 
@@ -157,60 +146,42 @@ void WorkMonitor::clearAllHandlers() {
 }
 
 void WorkMonitor::pushHandler(std::shared_ptr<RestHandler> handler) {
-  WorkDescription* desc = createWorkDescription(WorkType::HANDLER);
-  TRI_ASSERT(desc->_type == WorkType::HANDLER);
+  WorkDescription* desc = beginPush(WorkType::HANDLER);
+
+  if (desc != nullptr) {
+    TRI_ASSERT(desc->_type == WorkType::HANDLER);
+
+    desc->_context = handler->context();
 
-  desc->_context = handler->context();
+    new (&desc->_data._handler._handler) std::shared_ptr<RestHandler>(handler);
+    new (&desc->_data._handler._canceled) std::atomic<bool>(false);
 
-  new (&desc->_data._handler._handler) std::shared_ptr<RestHandler>(handler);
-  new (&desc->_data._handler._canceled) std::atomic<bool>(false);
+    endPush(desc);
+  }
 
-  activateWorkDescription(desc);
   RestHandler::CURRENT_HANDLER = handler.get();
 }
 
 void WorkMonitor::popHandler() {
-  WorkDescription* desc = deactivateWorkDescription();
-  TRI_ASSERT(desc != nullptr);
-  TRI_ASSERT(desc->_type == WorkType::HANDLER);
-  TRI_ASSERT(desc->_data._handler._handler != nullptr);
-
-  try {
-    freeWorkDescription(desc);
-  } catch (...) {
-    // just to prevent throwing exceptions from here, as this method
-    // will be called in destructors...
-  }
+  popWorkDescription(WorkType::HANDLER);
 
   // TODO(fc) we might have a stack of handlers
   RestHandler::CURRENT_HANDLER = nullptr;
 }
 
-bool WorkMonitor::cancelAql(WorkDescription* desc) {
-  auto type = desc->_type;
-
-  if (type != WorkType::AQL_STRING && type != WorkType::AQL_ID) {
-    return true;
+void WorkMonitor::cancelAql(TRI_vocbase_t* vocbase, uint64_t id) {
+  if (vocbase == nullptr) {
+    return;
   }
 
-  TRI_vocbase_t* vocbase = desc->_data._aql._vocbase;
-
-  if (vocbase != nullptr) {
-    uint64_t id = desc->_data._aql._id;
+  LOG_TOPIC(WARN, arangodb::Logger::FIXME) << "cancel query " << id << " in " << vocbase;
 
-    LOG_TOPIC(WARN, arangodb::Logger::FIXME) << "cancel query " << id << " in " << vocbase;
+  auto queryList = vocbase->queryList();
+  auto res = queryList->kill(id);
 
-    auto queryList = vocbase->queryList();
-    auto res = queryList->kill(id);
-
-    if (res != TRI_ERROR_NO_ERROR) {
-      LOG_TOPIC(DEBUG, arangodb::Logger::FIXME) << "cannot kill query " << id;
-    }
+  if (res != TRI_ERROR_NO_ERROR) {
+    LOG_TOPIC(DEBUG, arangodb::Logger::FIXME) << "cannot kill query " << id;
   }
-
-  desc->_data._aql._canceled.store(true);
-
-  return true;
 }
 
 void WorkMonitor::deleteHandler(WorkDescription* desc) {
@@ -222,6 +193,13 @@ void WorkMonitor::deleteHandler(WorkDescription* desc) {
   desc->_data._handler._canceled.std::atomic<bool>::~atomic();
 }
 
+char const* WorkMonitor::handlerName(WorkDescription* desc) {
+  TRI_ASSERT(desc->_type == WorkType::HANDLER);
+
+  RestHandler* handler = desc->_data._handler._handler.get();
+  return handler == nullptr ? "handler" : handler->name();
+}
+
 void WorkMonitor::vpackHandler(VPackBuilder* b, WorkDescription* desc) {
   RestHandler* handler = desc->_data._handler._handler.get();
   GeneralRequest const* request = handler->request();
@@ -49,7 +49,7 @@ std::string const GlobalContextMethods::CodeWarmupExports =
   
 V8Context::V8Context(size_t id)
     : _id(id), _isolate(nullptr), _locker(nullptr), 
-      _numExecutions(0), _creationStamp(TRI_microtime()), 
+      _numExecutions(0), _numStartupFiles(0), _creationStamp(TRI_microtime()), 
       _lastGcStamp(0.0), _hasActiveExternals(0) {}
 
 double V8Context::age() const {
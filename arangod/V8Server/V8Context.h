@@ -121,6 +121,7 @@ class V8Context {
   v8::Isolate* _isolate;
   v8::Locker* _locker;
   size_t _numExecutions;
+  size_t _numStartupFiles;
   double const _creationStamp;
   double _lastGcStamp;
   bool _hasActiveExternals;
@@ -41,6 +41,7 @@
 #include "RestServer/DatabaseFeature.h"
 #include "Scheduler/JobGuard.h"
 #include "Scheduler/SchedulerFeature.h"
+#include "Statistics/MetricsRegistry.h"
 #include "Transaction/V8Context.h"
 #include "V8/v8-buffer.h"
 #include "V8/v8-conv.h"
@@ -94,10 +95,12 @@ V8DealerFeature::V8DealerFeature(
       _nrMaxContexts(0),
       _nrMinContexts(0),
       _nrInflightContexts(0),
+      _lazyContexts(true),
       _ok(false),
       _nextId(0),
       _stopping(false),
       _gcFinished(false),
+      _numStartupFiles(0),
       _nrAdditionalContexts(0),
       _minimumContexts(1),
       _forceNrContexts(0) {
@@ -147,6 +150,12 @@ void V8DealerFeature::collectOptions(std::shared_ptr<ProgramOptions> options) {
       "--javascript.v8-contexts-minimum",
       "minimum number of V8 contexts that keep available for executing JavaScript actions",
       new UInt64Parameter(&_nrMinContexts));
+
+  options->addHiddenOption(
+      "--javascript.lazy-contexts",
+      "create all but the first V8 context in the background, and run the "
+      "startup scripts in a context when it is used first",
+      new BooleanParameter(&_lazyContexts));
 }
 
 void V8DealerFeature::validateOptions(std::shared_ptr<ProgramOptions> options) {
@@ -245,7 +254,12 @@ void V8DealerFeature::start() {
     _freeContexts.reserve(static_cast<size_t>(_nrMaxContexts));
     _dirtyContexts.reserve(static_cast<size_t>(_nrMaxContexts));
   
-    for (size_t i = 0; i < _nrMinContexts; ++i) {
+    // with lazy contexts, only the default context is built now. the
+    // garbage collector thread builds the others in the background
+    size_t const initialContexts =
+        _lazyContexts ? 1 : static_cast<size_t>(_nrMinContexts);
+
+    for (size_t i = 0; i < initialContexts; ++i) {
       V8Context* context = buildContext(nextId());
       try {
         _contexts.push_back(context);
@@ -270,6 +284,22 @@ void V8DealerFeature::start() {
   loadJavaScriptFileInAllContexts(database->systemDatabase(), "server/initialize.js");
 
   startGarbageCollection();
+
+  MetricsRegistry::addGauge("arangodb_v8_contexts",
+                            "Number of V8 contexts", [this]() {
+                              size_t total, busy;
+                              contextCounts(total, busy);
+                              return static_cast<double>(total);
+                            });
+  MetricsRegistry::addGauge("arangodb_v8_contexts_busy",
+                            "Number of V8 contexts in use", [this]() {
+                              size_t total, busy;
+                              contextCounts(total, busy);
+                              return static_cast<double>(busy);
+                            });
+  MetricsRegistry::addGauge(
+      "arangodb_v8_contexts_max", "Maximum number of V8 contexts",
+      [this]() { return static_cast<double>(_nrMaxContexts); });
 }
 
 V8Context* V8DealerFeature::addContext() {
@@ -277,14 +307,15 @@ V8Context* V8DealerFeature::addContext() {
 
   applyContextUpdate(context);
 
-  DatabaseFeature* database =
-      ApplicationServer::getFeature<DatabaseFeature>("Database");
-
-  loadJavaScriptFileInContext(database->systemDatabase(), "server/initialize.js", context);
+  // the startup files are run when the context is entered first
   return context; 
 }
 
 void V8DealerFeature::unprepare() {
+  MetricsRegistry::remove("arangodb_v8_contexts");
+  MetricsRegistry::remove("arangodb_v8_contexts_busy");
+  MetricsRegistry::remove("arangodb_v8_contexts_max");
+
   // turn off memory allocation failures before going into v8 code 
   TRI_DisallowMemoryFailures();
 
@@ -316,6 +347,13 @@ bool V8DealerFeature::addGlobalContextMethod(std::string const& method) {
   return result;
 }
 
+void V8DealerFeature::contextCounts(size_t& total, size_t& busy) {
+  CONDITION_LOCKER(guard, _contextCondition);
+
+  total = _contexts.size();
+  busy = _busyContexts.size();
+}
+
 void V8DealerFeature::collectGarbage() {
   V8GcThread* gc = static_cast<V8GcThread*>(_gcThread.get());
   TRI_ASSERT(gc != nullptr);
@@ -349,13 +387,51 @@ void V8DealerFeature::collectGarbage() {
         preferFree = !preferFree;
         CONDITION_LOCKER(guard, _contextCondition);
   
-        if (_dirtyContexts.empty()) {
+        bool const belowMinimum =
+            _contexts.size() + _nrInflightContexts < _nrMinContexts;
+
+        if (_dirtyContexts.empty() && !belowMinimum) {
           uint64_t waitTime = useReducedWait ? reducedWaitTime : regularWaitTime;
 
           // we'll wait for a signal or a timeout
           gotSignal = guard.wait(waitTime);
         }
 
+        if (!_stopping &&
+            ((_freeContexts.empty() &&
+              _contexts.size() + _nrInflightContexts < _nrMaxContexts) ||
+             belowMinimum)) {
+          // all contexts are in use, or the lazily started server does not
+          // have the minimum number of contexts yet. create another one in
+          // advance, so the next caller of enterContext does not have to
+          // wait for it
+          ++_nrInflightContexts;
+          guard.unlock();
+
+          V8Context* added = nullptr;
+          try {
+            added = addContext();
+            // nobody else can use the context yet
+            loadStartupFiles(added);
+          } catch (...) {
+          }
+
+          guard.lock();
+          --_nrInflightContexts;
+
+          if (added != nullptr) {
+            // cannot fail because we reserved enough space beforehand
+            _contexts.push_back(added);
+            _freeContexts.push_back(added);
+            LOG_TOPIC(DEBUG, Logger::V8)
+                << "created additional V8 context #" << added->_id
+                << " in the background, number of contexts is now "
+                << _contexts.size();
+            guard.broadcast();
+          }
+          continue;
+        }
+
         if (preferFree && !_freeContexts.empty()) {
           context = pickFreeContextForGc();
         }
@@ -479,10 +555,64 @@ void V8DealerFeature::collectGarbage() {
 
 void V8DealerFeature::loadJavaScriptFileInAllContexts(TRI_vocbase_t* vocbase,
                                                       std::string const& file) {
+  // contexts that are created or entered later catch up on the startup
+  // files in the system database
+  TRI_ASSERT(vocbase != nullptr);
+  TRI_ASSERT(vocbase->isSystem());
+
+  if (_lazyContexts) {
+    {
+      CONDITION_LOCKER(guard, _contextCondition);
+      _startupFiles.emplace_back(file);
+      _numStartupFiles.store(_startupFiles.size(), std::memory_order_release);
+    }
+
+    // run the file in the default context right away, so that errors in it
+    // still show up during startup
+    V8Context* context = enterContext(vocbase, true, 0);
+    if (context != nullptr) {
+      exitContext(context);
+    }
+    return;
+  }
+
   CONDITION_LOCKER(guard, _contextCondition);
+  _startupFiles.emplace_back(file);
+  _numStartupFiles.store(_startupFiles.size(), std::memory_order_release);
   
   for (auto& context : _contexts) {
-    loadJavaScriptFileInContext(vocbase, file, context);
+    if (_busyContexts.find(context) == _busyContexts.end()) {
+      // busy contexts catch up when they are entered next time
+      loadStartupFiles(context, _startupFiles);
+    }
+  }
+}
+
+void V8DealerFeature::loadStartupFiles(V8Context* context) {
+  if (context->_numStartupFiles >=
+      _numStartupFiles.load(std::memory_order_acquire)) {
+    return;
+  }
+
+  std::vector<std::string> files;
+  {
+    CONDITION_LOCKER(guard, _contextCondition);
+    files = _startupFiles;
+  }
+  loadStartupFiles(context, files);
+}
+
+void V8DealerFeature::loadStartupFiles(V8Context* context,
+                                       std::vector<std::string> const& files) {
+  TRI_vocbase_t* vocbase = DatabaseFeature::DATABASE->systemDatabase();
+
+  while (context->_numStartupFiles < files.size()) {
+    if (!loadJavaScriptFileInContext(
+            vocbase, files[context->_numStartupFiles], context)) {
+      // shutting down
+      return;
+    }
+    ++context->_numStartupFiles;
   }
 }
 
@@ -719,10 +849,20 @@ V8Context* V8DealerFeature::enterContext(TRI_vocbase_t* vocbase,
 
     // should not fail because we reserved enough space beforehand
     _busyContexts.emplace(context);
+
+    if (_freeContexts.empty() &&
+        _contexts.size() + _nrInflightContexts < _nrMaxContexts) {
+      // wake up the garbage collector thread, which creates another
+      // context before the next request has to wait for one
+      guard.broadcast();
+    }
   }
 
   TRI_ASSERT(context != nullptr);
 
+  // run the startup files the context has not seen yet
+  loadStartupFiles(context);
+
   enterContextInternal(vocbase, context, allowUseDatabase);
   return context;
 }
@@ -56,12 +56,16 @@ class V8DealerFeature final : public application_features::ApplicationFeature {
   uint64_t _nrMaxContexts;  // maximum number of contexts to create
   uint64_t _nrMinContexts; // minimum number of contexts to keep
   uint64_t _nrInflightContexts; // number of contexts currently in creation 
+  bool _lazyContexts; // build and initialize contexts on demand
 
  public:
   JSLoader* startupLoader() { return &_startupLoader; };
   bool addGlobalContextMethod(std::string const&);
   void collectGarbage();
 
+  /// @brief number of contexts, and number of contexts in use
+  void contextCounts(size_t& total, size_t& busy);
+
   void loadJavaScriptFileInAllContexts(TRI_vocbase_t*, std::string const& file);
   void loadJavaScriptFileInDefaultContext(TRI_vocbase_t*, std::string const& file);
   void startGarbageCollection();
@@ -100,6 +104,12 @@ class V8DealerFeature final : public application_features::ApplicationFeature {
   void applyContextUpdate(V8Context* context);
   void shutdownContexts();
 
+  // load the startup files the context has not executed yet. the caller
+  // must have exclusive use of the context
+  void loadStartupFiles(V8Context* context);
+  void loadStartupFiles(V8Context* context,
+                        std::vector<std::string> const& files);
+
  private:
   std::atomic<bool> _ok;
   std::atomic<uint64_t> _nextId;
@@ -113,6 +123,11 @@ class V8DealerFeature final : public application_features::ApplicationFeature {
   std::vector<V8Context*> _freeContexts;
   std::vector<V8Context*> _dirtyContexts;
   std::unordered_set<V8Context*> _busyContexts;
+
+  // the files loaded into all contexts in the system database, in order.
+  // contexts execute the ones they have not seen yet when they are entered
+  std::vector<std::string> _startupFiles;
+  std::atomic<size_t> _numStartupFiles;
   size_t _nrAdditionalContexts;
   size_t _minimumContexts;
   size_t _forceNrContexts;
@@ -461,7 +461,7 @@ static void DocumentVocbaseCol(
   
   TIMER_START(JS_DOCUMENT_VPACK_TO_V8);
 
-  v8::Handle<v8::Value> result = TRI_VPackToV8(isolate, opResult.slice(),
+  v8::Handle<v8::Value> result = TRI_VPackToV8Lazy(isolate, opResult.slice(),
       transactionContext->getVPackOptions());
   
   TIMER_STOP(JS_DOCUMENT_VPACK_TO_V8);
@@ -541,7 +541,7 @@ static void DocumentVocbase(
     TRI_V8_THROW_EXCEPTION(res);
   }
 
-  v8::Handle<v8::Value> result = TRI_VPackToV8(isolate, opResult.slice(),
+  v8::Handle<v8::Value> result = TRI_VPackToV8Lazy(isolate, opResult.slice(),
       transactionContext->getVPackOptions());
 
   TRI_V8_RETURN(result);
@@ -2033,6 +2033,8 @@ static void JS_PregelStatus(v8::FunctionCallbackInfo<v8::Value> const& args) {
   result.add("state", VPackValue(pregel::ExecutionStateNames[c->getState()]));
   result.add("gss", VPackValue(c->globalSuperstep()));
   result.add("totalRuntime", VPackValue(c->totalRuntimeSecs()));
+  result.add("residentBytes", VPackValue(c->residentBytes()));
+  result.add("mappedBytes", VPackValue(c->mappedBytes()));
   c->aggregators()->serializeValues(result);
   c->workerStats().serializeValues(result);
   result.close();
@@ -2944,13 +2946,18 @@ static void JS_CountVocbaseCol(
     TRI_V8_THROW_EXCEPTION_INTERNAL("cannot extract collection");
   }
 
-  if (args.Length() > 1) {
-    TRI_V8_THROW_EXCEPTION_USAGE("count()");
+  if (args.Length() > 2) {
+    TRI_V8_THROW_EXCEPTION_USAGE("count(<details>, <exact>)");
   }
 
   bool details = false;
-  if (args.Length() == 1 && ServerState::instance()->isCoordinator()) {
+  bool exact = false;
+  if (args.Length() >= 1 && ServerState::instance()->isCoordinator()) {
     details = TRI_ObjectToBoolean(args[0]);
+    if (args.Length() == 2) {
+      // bypass the count cache of the coordinator
+      exact = TRI_ObjectToBoolean(args[1]);
+    }
   }
     
   TRI_vocbase_t* vocbase = col->vocbase();
@@ -2969,7 +2976,7 @@ static void JS_CountVocbaseCol(
     TRI_V8_THROW_EXCEPTION(res);
   }
 
-  OperationResult opResult = trx.count(collectionName, !details);
+  OperationResult opResult = trx.count(collectionName, !details, exact);
   res = trx.finish(opResult.code);
 
   if (res != TRI_ERROR_NO_ERROR) {
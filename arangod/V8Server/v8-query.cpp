@@ -272,7 +272,7 @@ static void JS_AllQuery(v8::FunctionCallbackInfo<v8::Value> const& args) {
   TRI_ASSERT(docs.isArray());
   // setup result
   v8::Handle<v8::Object> result = v8::Object::New(isolate);
-  auto documents = TRI_VPackToV8(isolate, docs, &resultOptions);
+  auto documents = TRI_VPackToV8Lazy(isolate, docs, &resultOptions);
   result->Set(TRI_V8_ASCII_STRING("documents"), documents);
   result->Set(TRI_V8_ASCII_STRING("total"),
               v8::Number::New(isolate, count.getNumericValue<double>()));
@@ -340,7 +340,7 @@ static void JS_AnyQuery(v8::FunctionCallbackInfo<v8::Value> const& args) {
   // copy default options
   VPackOptions resultOptions = VPackOptions::Defaults;
   resultOptions.customTypeHandler = transactionContext->orderCustomTypeHandler().get();
-  TRI_V8_RETURN(TRI_VPackToV8(isolate, doc.at(0), &resultOptions));
+  TRI_V8_RETURN(TRI_VPackToV8Lazy(isolate, doc.at(0), &resultOptions));
   TRI_V8_TRY_CATCH_END
 }
 
@@ -674,6 +674,14 @@ static void JS_ConfigureApplierReplication(
       }
     }
 
+    if (object->Has(TRI_V8_ASCII_STRING("applyThreads"))) {
+      if (object->Get(TRI_V8_ASCII_STRING("applyThreads"))->IsNumber()) {
+        double value = TRI_ObjectToDouble(
+            object->Get(TRI_V8_ASCII_STRING("applyThreads")));
+        config._applyThreads = static_cast<uint64_t>(value);
+      }
+    }
+
     int res =
         TRI_ConfigureReplicationApplier(vocbase->replicationApplier(), &config);
 
@@ -26,6 +26,7 @@
 #include "Basics/Exceptions.h"
 #include "Basics/StringUtils.h"
 #include "Basics/process-utils.h"
+#include "GeneralServer/AuthenticationFeature.h"
 #include "Rest/GeneralRequest.h"
 #include "Statistics/ConnectionStatistics.h"
 #include "Statistics/RequestStatistics.h"
@@ -107,6 +108,25 @@ static void JS_ServerStatistics(
   result->Set(TRI_V8_ASCII_STRING("physicalMemory"),
               v8::Number::New(isolate, (double)TRI_PhysicalMemory));
 
+  AuthenticationFeature* authentication =
+      application_features::ApplicationServer::getFeature<
+          AuthenticationFeature>("Authentication");
+  uint64_t cacheHits = 0;
+  uint64_t cacheMisses = 0;
+
+  if (authentication->isEnabled()) {
+    AuthInfo* authInfo = authentication->authInfo();
+    cacheHits = authInfo->basicCacheHits();
+    cacheMisses = authInfo->basicCacheMisses();
+  }
+
+  v8::Handle<v8::Object> authCache = v8::Object::New(isolate);
+  authCache->Set(TRI_V8_ASCII_STRING("hits"),
+                 v8::Number::New(isolate, (double)cacheHits));
+  authCache->Set(TRI_V8_ASCII_STRING("misses"),
+                 v8::Number::New(isolate, (double)cacheMisses));
+  result->Set(TRI_V8_ASCII_STRING("authenticationCache"), authCache);
+
   TRI_V8_RETURN(result);
   TRI_V8_TRY_CATCH_END
 }
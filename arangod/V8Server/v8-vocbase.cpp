@@ -1003,8 +1003,8 @@ static void JS_ExecuteAqlJson(v8::FunctionCallbackInfo<v8::Value> const& args) {
   v8::Handle<v8::Object> result = v8::Object::New(isolate);
   if (queryResult.result != nullptr) {
     result->ForceSet(TRI_V8_ASCII_STRING("json"),
-                     TRI_VPackToV8(isolate, queryResult.result->slice(),
-                                   queryResult.context->getVPackOptions()));
+                     TRI_VPackToV8Lazy(isolate, queryResult.result->slice(),
+                                       queryResult.context->getVPackOptions()));
   }
   if (queryResult.stats != nullptr) {
     VPackSlice stats = queryResult.stats->slice();
@@ -1407,6 +1407,11 @@ static void JS_QueryCachePropertiesAql(
 
     // set mode and max elements
     queryCache->setProperties(cacheProperties);
+
+    if (obj->Has(TRI_V8_ASCII_STRING("invalidation"))) {
+      queryCache->setInvalidationMode(
+          TRI_ObjectToString(obj->Get(TRI_V8_ASCII_STRING("invalidation"))));
+    }
   }
 
   auto properties = queryCache->properties();
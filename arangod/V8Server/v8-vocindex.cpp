@@ -33,6 +33,7 @@
 #include "StorageEngine/EngineSelectorFeature.h"
 #include "Transaction/Helpers.h"
 #include "Transaction/Hints.h"
+#include "Utils/CollectionGuard.h"
 #include "Utils/Events.h"
 #include "Utils/SingleCollectionTransaction.h"
 #include "Transaction/V8Context.h"
@@ -162,10 +163,25 @@ static void EnsureIndexLocal(v8::FunctionCallbackInfo<v8::Value> const& args,
   TRI_ASSERT(collection != nullptr);
   READ_LOCKER(readLocker, collection->vocbase()->_inventoryLock);
 
+  // an index filled in the background takes the collection locks itself,
+  // only for short periods of time. the guard keeps the collection loaded
+  bool const inBackground =
+      create && arangodb::basics::VelocyPackHelper::getBooleanValue(
+                     slice, "inBackground", false);
+  std::unique_ptr<CollectionGuard> guard;
+
+  if (inBackground) {
+    guard.reset(new CollectionGuard(collection->vocbase(), collection->cid()));
+  }
+
   SingleCollectionTransaction trx(
       transaction::V8Context::Create(collection->vocbase(), true),
       collection->cid(), create ? AccessMode::Type::WRITE : AccessMode::Type::READ);
 
+  if (inBackground) {
+    trx.addHint(transaction::Hints::Hint::LOCK_NEVER);
+  }
+
   int res = trx.begin();
 
   if (res != TRI_ERROR_NO_ERROR) {
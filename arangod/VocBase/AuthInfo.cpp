@@ -43,6 +43,56 @@ using namespace arangodb::basics;
 using namespace arangodb::velocypack;
 using namespace arangodb::rest;
 
+size_t const AuthBasicCache::Shards;
+size_t const AuthBasicCache::ShardSize;
+constexpr double AuthBasicCache::TTL;
+
+bool AuthBasicCache::lookup(std::string const& secret, double now,
+                            AuthResult& result) {
+  Shard& s = shard(secret);
+
+  {
+    READ_LOCKER(readLocker, s._lock);
+    auto const& it = s._entries.find(secret);
+
+    if (it != s._entries.end() && it->second._expires > now) {
+      ++_hits;
+      result = it->second._result;
+      return true;
+    }
+  }
+
+  ++_misses;
+  return false;
+}
+
+void AuthBasicCache::store(std::string const& secret, AuthResult const& result,
+                           double now, uint64_t version) {
+  Shard& s = shard(secret);
+  WRITE_LOCKER(writeLocker, s._lock);
+
+  if (result._authorized && version == _version.load()) {
+    if (s._entries.size() >= ShardSize) {
+      // the cache is not meant to hold many distinct secrets. start over
+      // instead of tracking the age of all entries
+      s._entries.clear();
+    }
+
+    s._entries[secret] = Entry{result, now + TTL};
+  } else {
+    s._entries.erase(secret);
+  }
+}
+
+void AuthBasicCache::clear() {
+  ++_version;
+
+  for (size_t i = 0; i < Shards; ++i) {
+    WRITE_LOCKER(writeLocker, _shards[i]._lock);
+    _shards[i]._entries.clear();
+  }
+}
+
 static AuthEntry CreateAuthEntry(VPackSlice const& slice) {
   if (slice.isNone() || !slice.isObject()) {
     return AuthEntry();
@@ -404,15 +454,16 @@ AuthResult AuthInfo::checkAuthentication(AuthType authType,
 
 // private
 AuthResult AuthInfo::checkAuthenticationBasic(std::string const& secret) {
-  {
-    READ_LOCKER(readLocker, _authInfoLock);
-    auto const& it = _authBasicCache.find(secret);
+  double const now = TRI_microtime();
+  AuthResult result;
 
-    if (it != _authBasicCache.end()) {
-      return it->second;
-    }
+  if (_authBasicCache.lookup(secret, now, result)) {
+    return result;
   }
 
+  // a reload of the users in the meantime keeps the result out of the cache
+  uint64_t const version = _authBasicCache.version();
+
   std::string const up = StringUtils::decodeBase64(secret);
   std::string::size_type n = up.find(':', 0);
 
@@ -425,23 +476,8 @@ AuthResult AuthInfo::checkAuthenticationBasic(std::string const& secret) {
   std::string username = up.substr(0, n);
   std::string password = up.substr(n + 1);
 
-  AuthResult result = checkPassword(username, password);
-
-  {
-    WRITE_LOCKER(readLocker, _authInfoLock);
-
-    if (result._authorized) {
-      if (!_authBasicCache.emplace(secret, result).second) {
-        // insertion did not work - probably another thread did insert the 
-        // same data right now
-        // erase it and re-insert our version
-        _authBasicCache.erase(secret);
-        _authBasicCache.emplace(secret, result);
-      }
-    } else {
-      _authBasicCache.erase(secret);
-    }
-  } 
+  result = checkPassword(username, password);
+  _authBasicCache.store(secret, result, now, version);
 
   return result;
 }
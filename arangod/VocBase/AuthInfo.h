@@ -34,6 +34,7 @@
 #include "Aql/QueryRegistry.h"
 #include "Basics/Mutex.h"
 #include "Basics/LruCache.h"
+#include "Basics/ReadMostlyLock.h"
 #include "Basics/ReadWriteLock.h"
 
 namespace arangodb {
@@ -119,6 +120,68 @@ class AuthJwtResult: public AuthResult {
   std::chrono::system_clock::time_point _expireTime;
 };
 
+// verified basic authentication secrets. the cache is split into shards,
+// each with its own lock, so that concurrent requests do not all wait for
+// the same lock
+class AuthBasicCache {
+ public:
+  // number of shards
+  static size_t const Shards = 16;
+  // maximum number of secrets in a shard
+  static size_t const ShardSize = 1024;
+  // time (in seconds) for which a verified secret is accepted without
+  // checking the password again
+  static constexpr double TTL = 60.0;
+
+ public:
+  AuthBasicCache() : _version(0), _hits(0), _misses(0) {}
+
+  AuthBasicCache(AuthBasicCache const&) = delete;
+  AuthBasicCache& operator=(AuthBasicCache const&) = delete;
+
+ public:
+  // looks up a secret that has not expired at the given time, and counts
+  // the lookup as a hit or a miss
+  bool lookup(std::string const& secret, double now, AuthResult& result);
+
+  // current version of the cache. a result must be stored with the version
+  // that was current before it was computed
+  uint64_t version() const { return _version.load(); }
+
+  // stores an authorized result, unless the cache was cleared since the
+  // given version. any other result removes the secret from the cache
+  void store(std::string const& secret, AuthResult const& result, double now,
+             uint64_t version);
+
+  // removes all secrets, and starts a new version so that results computed
+  // before are not stored anymore
+  void clear();
+
+  uint64_t hits() const { return _hits.load(); }
+  uint64_t misses() const { return _misses.load(); }
+
+ private:
+  struct Entry {
+    AuthResult _result;
+    double _expires;
+  };
+
+  struct Shard {
+    basics::ReadWriteLock _lock;
+    std::unordered_map<std::string, Entry> _entries;
+  };
+
+  Shard& shard(std::string const& secret) {
+    return _shards[std::hash<std::string>()(secret) % Shards];
+  }
+
+ private:
+  Shard _shards[Shards];
+  std::atomic<uint64_t> _version;
+  std::atomic<uint64_t> _hits;
+  std::atomic<uint64_t> _misses;
+};
+
 class AuthInfo {
  public:
   enum class AuthType {
@@ -154,6 +217,11 @@ class AuthInfo {
   std::string jwtSecret();
   std::string generateJwt(VPackBuilder const&);
   std::string generateRawJwt(VPackBuilder const&);
+
+  // number of basic authentication checks answered from the cache
+  uint64_t basicCacheHits() const { return _authBasicCache.hits(); }
+  // number of basic authentication checks that had to verify the password
+  uint64_t basicCacheMisses() const { return _authBasicCache.misses(); }
  
  private:
   void reload();
@@ -168,13 +236,14 @@ class AuthInfo {
   std::shared_ptr<VPackBuilder> parseJson(std::string const&, std::string const&);
 
  private:
-  basics::ReadWriteLock _authInfoLock;
-  basics::ReadWriteLock _authJwtLock;
+  // read for every authenticated request
+  basics::ReadMostlyLock _authInfoLock;
+  basics::ReadMostlyLock _authJwtLock;
   Mutex _queryLock;
   std::atomic<bool> _outdated;
 
   std::unordered_map<std::string, arangodb::AuthEntry> _authInfo;
-  std::unordered_map<std::string, arangodb::AuthResult> _authBasicCache;
+  AuthBasicCache _authBasicCache;
   arangodb::basics::LruCache<std::string, arangodb::AuthJwtResult> _authJwtCache;
   std::string _jwtSecret;
   aql::QueryRegistry* _queryRegistry;
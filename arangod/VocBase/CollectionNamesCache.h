@@ -0,0 +1,113 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_VOC_BASE_COLLECTION_NAMES_CACHE_H
+#define ARANGOD_VOC_BASE_COLLECTION_NAMES_CACHE_H 1
+
+#include "Basics/Common.h"
+
+#include "Basics/ReadLocker.h"
+#include "Basics/ReadWriteLock.h"
+#include "VocBase/voc-types.h"
+
+namespace arangodb {
+class LogicalCollection;
+
+/// @brief immutable copy of the collection name and id maps of a database
+struct CollectionNamesSnapshot {
+  typedef std::unordered_map<std::string, LogicalCollection*> ByName;
+  typedef std::unordered_map<TRI_voc_cid_t, LogicalCollection*> ById;
+
+  CollectionNamesSnapshot(ByName const& byName, ById const& byId)
+      : byName(byName), byId(byId) {
+    std::unordered_map<LogicalCollection const*, TRI_voc_cid_t> ids;
+    ids.reserve(byId.size());
+    for (auto const& it : byId) {
+      ids.emplace(it.second, it.first);
+    }
+
+    namesById.reserve(byName.size());
+    for (auto const& it : byName) {
+      auto id = ids.find(it.second);
+      if (id != ids.end()) {
+        namesById.emplace((*id).second, it.first);
+      }
+    }
+  }
+
+  ByName const byName;
+  ById const byId;
+  // names are copied, as a rename changes the name of the collection
+  // object while readers of an older snapshot may still use it
+  std::unordered_map<TRI_voc_cid_t, std::string> namesById;
+};
+
+/// @brief the current snapshot of the collection name and id maps of a
+/// database, so that the frequent name and id lookups of all transactions
+/// and resolvers do not need to acquire the collections lock. it is
+/// invalidated (under the write lock) whenever a collection is registered,
+/// unregistered or renamed, and rebuilt by the next lookup
+class CollectionNamesCache {
+ public:
+  CollectionNamesCache() = default;
+  CollectionNamesCache(CollectionNamesCache const&) = delete;
+  CollectionNamesCache& operator=(CollectionNamesCache const&) = delete;
+
+  /// @brief returns the current snapshot, building it from the maps
+  /// protected by lock if necessary
+  std::shared_ptr<CollectionNamesSnapshot const> get(
+      basics::ReadWriteLock& lock, CollectionNamesSnapshot::ByName const& byName,
+      CollectionNamesSnapshot::ById const& byId) {
+    auto snapshot = std::atomic_load(&_snapshot);
+
+    if (snapshot != nullptr) {
+      return snapshot;
+    }
+
+    READ_LOCKER(readLocker, lock);
+
+    // someone else may have built it in the meantime
+    snapshot = std::atomic_load(&_snapshot);
+
+    if (snapshot == nullptr) {
+      snapshot = std::make_shared<CollectionNamesSnapshot const>(byName, byId);
+      // storing the snapshot while still holding the read lock is safe:
+      // modifications of the maps and invalidations happen under the write
+      // lock, so they cannot interleave with the copy
+      std::atomic_store(&_snapshot, snapshot);
+    }
+
+    return snapshot;
+  }
+
+  /// @brief discards the snapshot. the caller must hold the lock that
+  /// protects the maps in write mode
+  void invalidate() {
+    std::atomic_store(&_snapshot,
+                      std::shared_ptr<CollectionNamesSnapshot const>());
+  }
+
+ private:
+  std::shared_ptr<CollectionNamesSnapshot const> _snapshot;
+};
+}
+
+#endif
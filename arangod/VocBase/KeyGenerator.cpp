@@ -98,6 +98,10 @@ KeyGenerator::GeneratorType KeyGenerator::generatorType(
     return KeyGenerator::TYPE_AUTOINCREMENT;
   }
 
+  if (typeName == PaddedKeyGenerator::name()) {
+    return KeyGenerator::TYPE_PADDED;
+  }
+
   // error
   return KeyGenerator::TYPE_UNKNOWN;
 }
@@ -133,6 +137,10 @@ KeyGenerator* KeyGenerator::factory(VPackSlice const& options) {
     return new TraditionalKeyGenerator(allowUserKeys);
   }
 
+  else if (type == TYPE_PADDED) {
+    return new PaddedKeyGenerator(allowUserKeys);
+  }
+
   else if (type == TYPE_AUTOINCREMENT) {
     uint64_t offset = 0;
     uint64_t increment = 1;
@@ -298,6 +306,44 @@ void TraditionalKeyGenerator::toVelocyPack(VPackBuilder& builder) const {
 /// @brief create the generator
 ////////////////////////////////////////////////////////////////////////////////
 
+PaddedKeyGenerator::PaddedKeyGenerator(bool allowUserKeys)
+    : TraditionalKeyGenerator(allowUserKeys) {}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief destroy the generator
+////////////////////////////////////////////////////////////////////////////////
+
+PaddedKeyGenerator::~PaddedKeyGenerator() {}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief generate a key, always 16 lowercase hex digits
+////////////////////////////////////////////////////////////////////////////////
+
+std::string PaddedKeyGenerator::generate(TRI_voc_tick_t tick) {
+  static char const* const digits = "0123456789abcdef";
+
+  std::string key(16, '0');
+  for (size_t i = 16; i > 0 && tick > 0; --i) {
+    key[i - 1] = digits[tick & 0x0fULL];
+    tick >>= 4;
+  }
+  return key;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create a VPack representation of the generator
+////////////////////////////////////////////////////////////////////////////////
+
+void PaddedKeyGenerator::toVelocyPack(VPackBuilder& builder) const {
+  TRI_ASSERT(!builder.isClosed());
+  builder.add("type", VPackValue(name()));
+  builder.add("allowUserKeys", VPackValue(_allowUserKeys));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create the generator
+////////////////////////////////////////////////////////////////////////////////
+
 AutoIncrementKeyGenerator::AutoIncrementKeyGenerator(bool allowUserKeys,
                                                      uint64_t offset,
                                                      uint64_t increment)
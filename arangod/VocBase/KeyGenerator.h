@@ -51,7 +51,8 @@ class KeyGenerator {
   enum GeneratorType {
     TYPE_UNKNOWN = 0,
     TYPE_TRADITIONAL = 1,
-    TYPE_AUTOINCREMENT = 2
+    TYPE_AUTOINCREMENT = 2,
+    TYPE_PADDED = 3
   };
 
  protected:
@@ -196,6 +197,49 @@ class TraditionalKeyGenerator : public KeyGenerator {
   virtual void toVelocyPack(arangodb::velocypack::Builder&) const override;
 };
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief key generator producing fixed-length hexadecimal keys. the keys
+/// are built from the same values as traditional keys (the local tick on a
+/// single server, cluster-wide unique ids leased in blocks from the agency
+/// on coordinators), but as all keys have the same length, their
+/// lexicographical order is the same as their numeric order. this makes
+/// the generator usable for sharded collections
+////////////////////////////////////////////////////////////////////////////////
+
+class PaddedKeyGenerator : public TraditionalKeyGenerator {
+ public:
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief create the generator
+  //////////////////////////////////////////////////////////////////////////////
+
+  explicit PaddedKeyGenerator(bool);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief destroy the generator
+  //////////////////////////////////////////////////////////////////////////////
+
+  ~PaddedKeyGenerator();
+
+ public:
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief generate a key
+  //////////////////////////////////////////////////////////////////////////////
+
+  std::string generate(TRI_voc_tick_t) override;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief return the generator name (must be lowercase)
+  //////////////////////////////////////////////////////////////////////////////
+
+  static std::string name() { return "padded"; }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief build a VelocyPack representation of the generator in the builder
+  //////////////////////////////////////////////////////////////////////////////
+
+  virtual void toVelocyPack(arangodb::velocypack::Builder&) const override;
+};
+
 class AutoIncrementKeyGenerator : public KeyGenerator {
  public:
   //////////////////////////////////////////////////////////////////////////////
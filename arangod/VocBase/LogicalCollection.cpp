@@ -146,6 +146,8 @@ static std::string const ReadStringValue(VPackSlice info,
 ///        Can only be given to V8, cannot be used for functionality.
 LogicalCollection::LogicalCollection(LogicalCollection const& other)
     : _internalVersion(0),
+      _modificationEpoch(0),
+      _numOperations(0),
       _cid(other.cid()),
       _planId(other.planId()),
       _type(other.type()),
@@ -178,6 +180,8 @@ LogicalCollection::LogicalCollection(LogicalCollection const& other)
 LogicalCollection::LogicalCollection(TRI_vocbase_t* vocbase,
                                      VPackSlice const& info)
     : _internalVersion(0),
+      _modificationEpoch(0),
+      _numOperations(0),
       _cid(ReadCid(info)),
       _planId(ReadPlanId(info, _cid)),
       _type(Helper::readNumericValue<TRI_col_type_e, int>(
@@ -234,11 +238,11 @@ LogicalCollection::LogicalCollection(TRI_vocbase_t* vocbase,
       keyGenSlice = keyGenSlice.get("type");
       if (keyGenSlice.isString()) {
         StringRef tmp(keyGenSlice);
-        if (!tmp.empty() && tmp != "traditional") {
+        if (!tmp.empty() && tmp != "traditional" && tmp != "padded") {
           THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_CLUSTER_UNSUPPORTED,
-                                         "non-traditional key generators are "
-                                         "not supported for sharded "
-                                         "collections");
+                                         "only the traditional and padded "
+                                         "key generators are supported for "
+                                         "sharded collections");
         }
       }
     }
@@ -364,6 +368,14 @@ std::unique_ptr<IndexIterator> LogicalCollection::getAnyIterator(transaction::Me
   return _physical->getAnyIterator(trx, mdr);
 }
 
+size_t LogicalCollection::numScanPartitions() const {
+  return _physical->numScanPartitions();
+}
+
+std::unique_ptr<IndexIterator> LogicalCollection::getPartitionIterator(transaction::Methods* trx, ManagedDocumentResult* mdr, size_t partition){
+  return _physical->getPartitionIterator(trx, mdr, partition);
+}
+
 void LogicalCollection::invokeOnAllElements(std::function<bool(DocumentIdentifierToken const&)> callback){
   _physical->invokeOnAllElements(callback);
 }
@@ -956,11 +968,20 @@ int LogicalCollection::read(transaction::Methods* trx, std::string const& key,
 
 int LogicalCollection::read(transaction::Methods* trx, StringRef const& key,
                             ManagedDocumentResult& result, bool lock) {
+  countOperation();
   transaction::BuilderLeaser builder(trx);
   builder->add(VPackValuePair(key.data(), key.size(), VPackValueType::String));
   return getPhysical()->read(trx, builder->slice(), result, lock);
 }
 
+int LogicalCollection::readInto(transaction::Methods* trx,
+                                StringRef const& key,
+                                std::vector<std::string> const& projections,
+                                VPackBuilder& result, bool lock) {
+  countOperation();
+  return getPhysical()->readInto(trx, key, projections, result, lock);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief processes a truncate operation (note: currently this only clears
 /// the read-cache
@@ -968,6 +989,7 @@ int LogicalCollection::read(transaction::Methods* trx, StringRef const& key,
 
 void LogicalCollection::truncate(transaction::Methods* trx, OperationOptions& options) {
   getPhysical()->truncate(trx, options);
+  increaseModificationEpoch();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -979,8 +1001,11 @@ int LogicalCollection::insert(transaction::Methods* trx, VPackSlice const slice,
                               OperationOptions& options,
                               TRI_voc_tick_t& resultMarkerTick, bool lock) {
   resultMarkerTick = 0;
-  return getPhysical()->insert(trx, slice, result, options, resultMarkerTick,
-                               lock);
+  int res = getPhysical()->insert(trx, slice, result, options,
+                                  resultMarkerTick, lock);
+  increaseModificationEpoch();
+  countOperation();
+  return res;
 }
 
 /// @brief updates a document or edge in a collection
@@ -1021,8 +1046,12 @@ int LogicalCollection::update(transaction::Methods* trx, VPackSlice const newSli
     return TRI_ERROR_ARANGO_DOCUMENT_HANDLE_BAD;
   }
 
-  return getPhysical()->update(trx, newSlice, result, options, resultMarkerTick,
-                               lock, prevRev, previous, revisionId, key);
+  int res = getPhysical()->update(trx, newSlice, result, options,
+                                  resultMarkerTick, lock, prevRev, previous,
+                                  revisionId, key);
+  increaseModificationEpoch();
+  countOperation();
+  return res;
 }
 
 /// @brief replaces a document or edge in a collection
@@ -1073,9 +1102,12 @@ int LogicalCollection::replace(
     revisionId = TRI_HybridLogicalClock();
   }
 
-  return getPhysical()->replace(trx, newSlice, result, options,
-                                resultMarkerTick, lock, prevRev, previous,
-                                revisionId, fromSlice, toSlice);
+  int res = getPhysical()->replace(trx, newSlice, result, options,
+                                   resultMarkerTick, lock, prevRev, previous,
+                                   revisionId, fromSlice, toSlice);
+  increaseModificationEpoch();
+  countOperation();
+  return res;
 }
 
 /// @brief removes a document or edge
@@ -1105,8 +1137,11 @@ int LogicalCollection::remove(transaction::Methods* trx,
     revisionId = TRI_HybridLogicalClock();
   }
 
-  return getPhysical()->remove(trx, slice, previous, options, resultMarkerTick,
-                               lock, revisionId, prevRev);
+  int res = getPhysical()->remove(trx, slice, previous, options,
+                                  resultMarkerTick, lock, revisionId, prevRev);
+  increaseModificationEpoch();
+  countOperation();
+  return res;
 }
 
 void LogicalCollection::sizeHint(transaction::Methods* trx, int64_t hint) {
@@ -1126,6 +1161,13 @@ bool LogicalCollection::readDocumentConditional(
   return getPhysical()->readDocumentConditional(trx, token, maxTick, result);
 }
 
+void LogicalCollection::readDocuments(
+    transaction::Methods* trx,
+    std::vector<DocumentIdentifierToken> const& tokens,
+    std::vector<uint8_t const*>& result) {
+  getPhysical()->readDocuments(trx, tokens, result);
+}
+
 /// @brief a method to skip certain documents in AQL write operations,
 /// this is only used in the enterprise edition for smart graphs
 #ifndef USE_ENTERPRISE
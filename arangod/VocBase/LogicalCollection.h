@@ -32,6 +32,8 @@
 
 #include <velocypack/Buffer.h>
 
+#include <atomic>
+
 namespace arangodb {
 
 namespace velocypack {
@@ -169,6 +171,8 @@ class LogicalCollection {
   
   std::unique_ptr<IndexIterator> getAllIterator(transaction::Methods* trx, ManagedDocumentResult* mdr, bool reverse);
   std::unique_ptr<IndexIterator> getAnyIterator(transaction::Methods* trx, ManagedDocumentResult* mdr);
+  size_t numScanPartitions() const;
+  std::unique_ptr<IndexIterator> getPartitionIterator(transaction::Methods* trx, ManagedDocumentResult* mdr, size_t partition);
 
   void invokeOnAllElements(std::function<bool(DocumentIdentifierToken const&)> callback);
 
@@ -252,6 +256,9 @@ class LogicalCollection {
            ManagedDocumentResult& result, bool);
   int read(transaction::Methods*, StringRef const&,
            ManagedDocumentResult& result, bool);
+  int readInto(transaction::Methods*, StringRef const&,
+               std::vector<std::string> const& projections,
+               arangodb::velocypack::Builder& result, bool);
 
   /// @brief processes a truncate operation
   /// NOTE: This function throws on error
@@ -281,6 +288,10 @@ class LogicalCollection {
                                TRI_voc_tick_t maxTick,
                                ManagedDocumentResult& result);
 
+  void readDocuments(transaction::Methods* trx,
+                     std::vector<DocumentIdentifierToken> const& tokens,
+                     std::vector<uint8_t const*>& result);
+
   /// @brief Persist the connected physical collection.
   ///        This should be called AFTER the collection is successfully
   ///        created and only on Sinlge/DBServer
@@ -290,6 +301,30 @@ class LogicalCollection {
     return _lock;
   }
 
+  /// @brief Return the modification epoch, which is increased whenever
+  ///        the collection may have been modified. Used to tell whether
+  ///        results derived from the documents are still valid.
+  uint64_t modificationEpoch() const {
+    return _modificationEpoch.load(std::memory_order_acquire);
+  }
+
+  /// @brief Increase the modification epoch
+  void increaseModificationEpoch() {
+    _modificationEpoch.fetch_add(1, std::memory_order_release);
+  }
+
+  /// @brief Return the number of document reads and modifications so far.
+  ///        Reported to the agency, which derives the request rate of
+  ///        shards from it for rebalancing.
+  uint64_t numOperations() const {
+    return _numOperations.load(std::memory_order_relaxed);
+  }
+
+  /// @brief Count a document read or modification
+  void countOperation() {
+    _numOperations.fetch_add(1, std::memory_order_relaxed);
+  }
+
   /// @brief Defer a callback to be executed when the collection
   ///        can be dropped. The callback is supposed to drop
   ///        the collection and it is guaranteed that no one is using
@@ -315,6 +350,12 @@ class LogicalCollection {
   // @brief Internal version used for caching
   uint32_t _internalVersion;
 
+  // @brief Number of modifications, used for invalidating the traversal cache
+  std::atomic<uint64_t> _modificationEpoch;
+
+  // @brief Number of document reads and modifications
+  std::atomic<uint64_t> _numOperations;
+
   // @brief Local collection id
   TRI_voc_cid_t const _cid;
 
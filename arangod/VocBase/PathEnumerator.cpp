@@ -23,8 +23,12 @@
 
 #include "PathEnumerator.h"
 #include "Basics/VelocyPackHelper.h"
+#include "VocBase/TraversalCache.h"
 #include "VocBase/Traverser.h"
 
+#include <velocypack/Iterator.h>
+#include <velocypack/velocypack-aliases.h>
+
 using DepthFirstEnumerator = arangodb::traverser::DepthFirstEnumerator;
 using BreadthFirstEnumerator = arangodb::traverser::BreadthFirstEnumerator;
 using NeighborsEnumerator = arangodb::traverser::NeighborsEnumerator;
@@ -179,19 +183,24 @@ arangodb::aql::AqlValue DepthFirstEnumerator::lastEdgeToAqlValue() {
 arangodb::aql::AqlValue DepthFirstEnumerator::pathToAqlValue(arangodb::velocypack::Builder& result) {
   result.clear();
   result.openObject();
-  result.add(VPackValue("edges"));
-  result.openArray();
-  for (auto const& it : _enumeratedPath.edges) {
-    _traverser->addEdgeToVelocyPack(it, result);
+  if (_opts->producePathEdges) {
+    result.add(VPackValue("edges"));
+    result.openArray();
+    for (auto const& it : _enumeratedPath.edges) {
+      _traverser->addEdgeToVelocyPack(it, result);
+    }
+    result.close();
   }
-  result.close();
-  result.add(VPackValue("vertices"));
-  result.openArray();
-  for (auto const& it : _enumeratedPath.vertices) {
-    _traverser->addVertexToVelocyPack(it, result);
+  if (_opts->producePathVertices) {
+    // building the vertices requires looking up their documents
+    result.add(VPackValue("vertices"));
+    result.openArray();
+    for (auto const& it : _enumeratedPath.vertices) {
+      _traverser->addVertexToVelocyPack(it, result);
+    }
+    result.close();
   }
   result.close();
-  result.close();
   return arangodb::aql::AqlValue(result.slice());
 }
 
@@ -345,19 +354,24 @@ arangodb::aql::AqlValue BreadthFirstEnumerator::pathToAqlValue(
     arangodb::velocypack::Builder& result) {
   result.clear();
   result.openObject();
-  result.add(VPackValue("edges"));
-  result.openArray();
-  for (auto const& it : _enumeratedPath.edges) {
-    _traverser->addEdgeToVelocyPack(it, result);
+  if (_opts->producePathEdges) {
+    result.add(VPackValue("edges"));
+    result.openArray();
+    for (auto const& it : _enumeratedPath.edges) {
+      _traverser->addEdgeToVelocyPack(it, result);
+    }
+    result.close();
   }
-  result.close();
-  result.add(VPackValue("vertices"));
-  result.openArray();
-  for (auto const& it : _enumeratedPath.vertices) {
-    _traverser->addVertexToVelocyPack(it, result);
+  if (_opts->producePathVertices) {
+    // building the vertices requires looking up their documents
+    result.add(VPackValue("vertices"));
+    result.openArray();
+    for (auto const& it : _enumeratedPath.vertices) {
+      _traverser->addVertexToVelocyPack(it, result);
+    }
+    result.close();
   }
   result.close();
-  result.close();
   return arangodb::aql::AqlValue(result.slice());
 }
 
@@ -388,10 +402,33 @@ NeighborsEnumerator::NeighborsEnumerator(Traverser* traverser,
                                          VPackSlice startVertex,
                                          TraverserOptions const* opts)
     : PathEnumerator(traverser, startVertex, opts),
-      _searchDepth(0) {
-  _allFound.insert(arangodb::basics::VPackHashedSlice(startVertex));
-  _currentDepth.insert(arangodb::basics::VPackHashedSlice(startVertex));
-  _iterator = _currentDepth.begin();
+      _currentDepthStart(0),
+      _currentDepthEnd(1),
+      _position(0),
+      _searchDepth(0),
+      _fromCache(false) {
+  _allFound.insert(startVertex);
+
+  if (!_opts->useCache || !_opts->canUseCache()) {
+    return;
+  }
+
+  TraversalCache* cache = TraversalCache::instance();
+  if (cache == nullptr) {
+    return;
+  }
+
+  _opts->buildCacheKey(startVertex, _cacheKey);
+  if (cache->lookup(_cacheKey, _cached)) {
+    for (auto const& depth : VPackArrayIterator(_cached.slice())) {
+      for (auto const& v : VPackArrayIterator(depth)) {
+        _allFound.insert(v);
+      }
+      _depthEnds.emplace_back(_allFound.size());
+    }
+    _cacheKey.clear();
+    _fromCache = true;
+  }
 }
 
 bool NeighborsEnumerator::next() {
@@ -402,52 +439,112 @@ bool NeighborsEnumerator::next() {
     }
   }
 
-  if (_iterator == _currentDepth.end() || ++_iterator == _currentDepth.end()) {
+  if (_position >= _currentDepthEnd || ++_position >= _currentDepthEnd) {
     do {
       // This depth is done. Get next
       if (_opts->maxDepth == _searchDepth) {
         // We are finished.
+        storeInCache();
         return false;
       }
 
-      _lastDepth.swap(_currentDepth);
-      _currentDepth.clear();
-      for (auto const& nextVertex : _lastDepth) {
-        size_t cursorIdx = 0;
-        std::unique_ptr<arangodb::traverser::EdgeCursor> cursor(
-            _opts->nextCursor(_traverser->mmdr(), nextVertex.slice, _searchDepth));
-        while (cursor->readAll(_tmpEdges, cursorIdx)) {
-          if (!_tmpEdges.empty()) {
-            _traverser->_readDocuments += _tmpEdges.size();
-            VPackSlice v;
-            for (auto const& e : _tmpEdges) {
-              if (_traverser->getSingleVertex(e, nextVertex.slice, _searchDepth, v)) {
-                arangodb::basics::VPackHashedSlice hashed(v);
-                if (_allFound.find(hashed) == _allFound.end()) {
-                  _currentDepth.emplace(hashed);
-                  _allFound.emplace(hashed);
-                }
-              }
-            }
-            _tmpEdges.clear();
-          }
-        }
+      // the vertices found now are appended to _allFound, right behind
+      // the vertices of the last depth
+      size_t const lastDepthStart = _currentDepthStart;
+      size_t const lastDepthEnd = _currentDepthEnd;
+      _currentDepthStart = lastDepthEnd;
+
+      if (_fromCache) {
+        // the vertices of all depths were taken from the cache
+        _currentDepthEnd = _searchDepth < _depthEnds.size()
+                               ? _depthEnds[_searchDepth]
+                               : _currentDepthStart;
+      } else {
+        fetchNeighbors(lastDepthStart, lastDepthEnd);
+        _currentDepthEnd = _allFound.size();
+        _depthEnds.emplace_back(_currentDepthEnd);
       }
-      if (_currentDepth.empty()) {
+      if (_currentDepthStart == _currentDepthEnd) {
         // Nothing found. Cannot do anything more.
+        storeInCache();
         return false;
       }
       ++_searchDepth;
     } while (_searchDepth < _opts->minDepth);
-    _iterator = _currentDepth.begin();
+    _position = _currentDepthStart;
   }
-  TRI_ASSERT(_iterator != _currentDepth.end());
+  TRI_ASSERT(_position < _currentDepthEnd);
   return true;
 }
 
+void NeighborsEnumerator::fetchNeighbors(size_t start, size_t end) {
+  // look up the edges of the whole depth at once if possible, and
+  // fall back to one cursor per vertex otherwise
+  _batchVertices.clear();
+  for (size_t i = start; i < end; ++i) {
+    _batchVertices.emplace_back(_allFound.vertex(i));
+  }
+
+  auto cb = [this](VPackSlice edge, VPackSlice vertex) {
+    ++_traverser->_readDocuments;
+    VPackSlice v;
+    if (_traverser->getSingleVertex(edge, vertex, _searchDepth, v)) {
+      // only vertices not found before are added
+      _allFound.insert(v);
+    }
+  };
+
+  bool const batched = _opts->nextEdgesBatch(
+      _traverser->mmdr(), _batchVertices, _searchDepth, cb);
+
+  for (size_t i = start; !batched && i < end; ++i) {
+    VPackSlice const nextVertex = _allFound.vertex(i);
+    size_t cursorIdx = 0;
+    std::unique_ptr<arangodb::traverser::EdgeCursor> cursor(
+        _opts->nextCursor(_traverser->mmdr(), nextVertex, _searchDepth));
+    while (cursor->readAll(_tmpEdges, cursorIdx)) {
+      if (!_tmpEdges.empty()) {
+        _traverser->_readDocuments += _tmpEdges.size();
+        VPackSlice v;
+        for (auto const& e : _tmpEdges) {
+          if (_traverser->getSingleVertex(e, nextVertex, _searchDepth, v)) {
+            // only vertices not found before are added
+            _allFound.insert(v);
+          }
+        }
+        _tmpEdges.clear();
+      }
+    }
+  }
+}
+
+void NeighborsEnumerator::storeInCache() {
+  if (_cacheKey.empty()) {
+    return;
+  }
+
+  TraversalCache* cache = TraversalCache::instance();
+  if (cache != nullptr) {
+    VPackBuilder value;
+    value.openArray();
+    size_t start = 1;
+    for (auto const& end : _depthEnds) {
+      value.openArray();
+      for (size_t i = start; i < end; ++i) {
+        value.add(_allFound.vertex(i));
+      }
+      value.close();
+      start = end;
+    }
+    value.close();
+    cache->store(_cacheKey, value.slice());
+  }
+  _cacheKey.clear();
+}
+
 arangodb::aql::AqlValue NeighborsEnumerator::lastVertexToAqlValue() {
-  TRI_ASSERT(_iterator != _currentDepth.end());
-  return _traverser->fetchVertexData((*_iterator).slice);
+  TRI_ASSERT(_position < _currentDepthEnd);
+  return _traverser->fetchVertexData(_allFound.vertex(_position));
 }
 
 arangodb::aql::AqlValue NeighborsEnumerator::lastEdgeToAqlValue() {
@@ -26,6 +26,8 @@
 
 #include "Basics/Common.h"
 #include "VocBase/TraverserOptions.h"
+#include "VocBase/VertexInterner.h"
+#include <velocypack/Builder.h>
 #include <velocypack/Slice.h>
 #include <stack>
 
@@ -272,22 +274,28 @@ class BreadthFirstEnumerator final : public PathEnumerator {
 // @brief Enumerator optimized for neighbors. Does not allow edge access
 
 class NeighborsEnumerator final : public PathEnumerator {
-  std::unordered_set<arangodb::basics::VPackHashedSlice,
-                     arangodb::basics::VelocyPackHelper::VPackHashedStringHash,
-                     arangodb::basics::VelocyPackHelper::VPackHashedStringEqual>
-      _allFound;
-
-  std::unordered_set<arangodb::basics::VPackHashedSlice,
-                     arangodb::basics::VelocyPackHelper::VPackHashedStringHash,
-                     arangodb::basics::VelocyPackHelper::VPackHashedStringEqual>
-      _currentDepth;
-
-  std::unordered_set<arangodb::basics::VPackHashedSlice,
-                     arangodb::basics::VelocyPackHelper::VPackHashedStringHash,
-                     arangodb::basics::VelocyPackHelper::VPackHashedStringEqual>
-      _lastDepth;
-
-  std::unordered_set<arangodb::basics::VPackHashedSlice, arangodb::basics::VelocyPackHelper::VPackHashedStringHash, arangodb::basics::VelocyPackHelper::VPackHashedStringEqual>::iterator _iterator;
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief All vertices found so far, in the order of their discovery.
+  ///        As every vertex is found at its lowest depth first, the vertices
+  ///        of each depth form a contiguous range of ids.
+  //////////////////////////////////////////////////////////////////////////////
+
+  VertexInterner _allFound;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief The ids of the vertices of the current depth are
+  ///        [_currentDepthStart, _currentDepthEnd)
+  //////////////////////////////////////////////////////////////////////////////
+
+  size_t _currentDepthStart;
+  size_t _currentDepthEnd;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Id of the vertex returned last
+  //////////////////////////////////////////////////////////////////////////////
+
+  size_t _position;
+
   uint64_t _searchDepth;
  
   //////////////////////////////////////////////////////////////////////////////
@@ -296,6 +304,37 @@ class NeighborsEnumerator final : public PathEnumerator {
 
    std::unordered_set<arangodb::velocypack::Slice> _tmpEdges;
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief The vertices of the depth expanded with batched edge lookups
+  //////////////////////////////////////////////////////////////////////////////
+
+  std::vector<arangodb::velocypack::Slice> _batchVertices;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief The end ids of the vertices of each depth computed so far
+  //////////////////////////////////////////////////////////////////////////////
+
+  std::vector<size_t> _depthEnds;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief The traversal cache key the neighbors are stored under once
+  ///        all depths are computed. Empty if they are not to be stored.
+  //////////////////////////////////////////////////////////////////////////////
+
+  std::string _cacheKey;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief The neighbors taken from the traversal cache, an array with
+  ///        an array of vertex ids per depth. _allFound points into it.
+  //////////////////////////////////////////////////////////////////////////////
+
+  arangodb::velocypack::Builder _cached;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Whether or not the neighbors were taken from the cache
+  //////////////////////////////////////////////////////////////////////////////
+
+  bool _fromCache;
 
  public:
    NeighborsEnumerator(Traverser* traverser,
@@ -317,6 +356,20 @@ class NeighborsEnumerator final : public PathEnumerator {
 
   aql::AqlValue pathToAqlValue(arangodb::velocypack::Builder& result) override;
 
+ private:
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Append the vertices connected to the vertices with the ids
+  ///        [start, end) which were not found before to _allFound
+  //////////////////////////////////////////////////////////////////////////////
+
+  void fetchNeighbors(size_t start, size_t end);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Store the neighbors of all depths in the traversal cache
+  //////////////////////////////////////////////////////////////////////////////
+
+  void storeInCache();
 };
 
 
@@ -27,6 +27,7 @@
 #include "Basics/StaticStrings.h"
 #include "Basics/VelocyPackHelper.h"
 #include "Indexes/Index.h"
+#include "Indexes/IndexIterator.h"
 #include "StorageEngine/TransactionState.h"
 #include "Transaction/Methods.h"
 #include "VocBase/KeyGenerator.h"
@@ -81,6 +82,12 @@ std::shared_ptr<Index> PhysicalCollection::lookupIndex(
   return nullptr;
 }
 
+std::unique_ptr<IndexIterator> PhysicalCollection::getPartitionIterator(
+    transaction::Methods* trx, ManagedDocumentResult* mdr, size_t partition) {
+  TRI_ASSERT(partition == 0);
+  return getAllIterator(trx, mdr, false);
+}
+
 /// @brief merge two objects for update, oldValue must have correctly set
 /// _key and _id attributes
 
@@ -43,6 +43,7 @@ class IndexIterator;
 class KeyGenerator;
 class LogicalCollection;
 class ManagedDocumentResult;
+class StringRef;
 struct OperationOptions;
 class Result;
 
@@ -137,6 +138,17 @@ class PhysicalCollection {
 
   virtual std::unique_ptr<IndexIterator> getAllIterator(transaction::Methods* trx, ManagedDocumentResult* mdr, bool reverse) = 0;
   virtual std::unique_ptr<IndexIterator> getAnyIterator(transaction::Methods* trx, ManagedDocumentResult* mdr) = 0;
+
+  /// @brief number of partitions a full collection scan can be split into.
+  /// the partitions can be scanned independently via getPartitionIterator
+  virtual size_t numScanPartitions() const { return 1; }
+
+  /// @brief iterator over all documents of a single scan partition. the
+  /// iterators of different partitions of the same transaction, each with
+  /// its own ManagedDocumentResult, must be usable from different threads
+  /// concurrently, also while an index is built in the background
+  virtual std::unique_ptr<IndexIterator> getPartitionIterator(
+      transaction::Methods* trx, ManagedDocumentResult* mdr, size_t partition);
   virtual void invokeOnAllElements(std::function<bool(DocumentIdentifierToken const&)> callback) = 0;
 
   ////////////////////////////////////
@@ -148,6 +160,14 @@ class PhysicalCollection {
   virtual int read(transaction::Methods*, arangodb::velocypack::Slice const key,
                    ManagedDocumentResult& result, bool) = 0;
 
+  /// @brief read a document by key and add it to the builder. if
+  /// projections are given, only an object with these top-level attributes
+  /// is added. a full document may be added as an external, which stays
+  /// valid while the transaction has the collection's data pinned
+  virtual int readInto(transaction::Methods*, StringRef const& key,
+                       std::vector<std::string> const& projections,
+                       arangodb::velocypack::Builder& result, bool) = 0;
+
   virtual bool readDocument(transaction::Methods* trx,
                             DocumentIdentifierToken const& token,
                             ManagedDocumentResult& result) = 0;
@@ -157,6 +177,15 @@ class PhysicalCollection {
                                        TRI_voc_tick_t maxTick,
                                        ManagedDocumentResult& result) = 0;
 
+  /// @brief read the documents of many tokens at once. result[i] is the
+  /// document of tokens[i], or a nullptr if it does not exist. the
+  /// documents stay valid while the transaction uses the collection. must
+  /// be safe to call from several threads of the same transaction at once,
+  /// as parallel collection scans do
+  virtual void readDocuments(transaction::Methods* trx,
+                             std::vector<DocumentIdentifierToken> const& tokens,
+                             std::vector<uint8_t const*>& result) = 0;
+
   virtual int insert(arangodb::transaction::Methods* trx,
                      arangodb::velocypack::Slice const newSlice,
                      arangodb::ManagedDocumentResult& result,
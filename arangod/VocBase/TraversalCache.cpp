@@ -0,0 +1,94 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "TraversalCache.h"
+#include "Basics/MutexLocker.h"
+#include "Cache/Cache.h"
+#include "Cache/CacheManagerFeature.h"
+#include "Cache/CachedValue.h"
+#include "Cache/Finding.h"
+#include "Cache/Manager.h"
+
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+using namespace arangodb::traverser;
+
+TraversalCache::TraversalCache(std::shared_ptr<cache::Cache> cache)
+    : _cache(cache) {
+  TRI_ASSERT(_cache != nullptr);
+}
+
+TraversalCache::~TraversalCache() {}
+
+/// @brief return the cache instance, or a nullptr if no cache can be
+/// created, e.g. because the cache manager is not available
+TraversalCache* TraversalCache::instance() {
+  static Mutex lock;
+  static std::unique_ptr<TraversalCache> instance;
+
+  MUTEX_LOCKER(mutexLocker, lock);
+  if (instance == nullptr) {
+    cache::Manager* manager = CacheManagerFeature::MANAGER;
+    if (manager == nullptr) {
+      return nullptr;
+    }
+    auto cache = manager->createCache(cache::CacheType::Transactional);
+    if (cache == nullptr) {
+      // creation may fail under memory pressure. try again next time
+      return nullptr;
+    }
+    instance.reset(new TraversalCache(cache));
+  }
+  return instance.get();
+}
+
+/// @brief look up the value stored for the key. returns false if there is
+/// none, and copies the value into the builder otherwise
+bool TraversalCache::lookup(std::string const& key,
+                            VPackBuilder& result) const {
+  cache::Finding finding =
+      _cache->find(key.data(), static_cast<uint32_t>(key.size()));
+
+  if (!finding.found()) {
+    return false;
+  }
+
+  result.clear();
+  result.add(VPackSlice(finding.value()->value()));
+  return true;
+}
+
+/// @brief store the value for the key. the value may silently not be
+/// stored, e.g. if the cache is full
+void TraversalCache::store(std::string const& key, VPackSlice value) {
+  cache::CachedValue* cached = cache::CachedValue::construct(
+      key.data(), static_cast<uint32_t>(key.size()), value.start(),
+      value.byteSize());
+
+  if (cached == nullptr) {
+    return;
+  }
+
+  if (!_cache->insert(cached)) {
+    delete cached;
+  }
+}
@@ -0,0 +1,73 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_VOC_BASE_TRAVERSAL_CACHE_H
+#define ARANGOD_VOC_BASE_TRAVERSAL_CACHE_H 1
+
+#include "Basics/Common.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Slice.h>
+
+namespace arangodb {
+namespace cache {
+class Cache;
+}
+
+namespace traverser {
+
+/// @brief process-wide cache for the neighbors of traversal start vertices,
+/// shared by all queries that use the "cache" traversal option. the values
+/// are stored in a transactional cache of the cache manager. the keys
+/// contain the modification epochs of all edge collections involved, so an
+/// entry is never found again once one of its edge collections has been
+/// modified, and stale entries are evicted by the cache eventually
+class TraversalCache {
+ public:
+  TraversalCache(TraversalCache const&) = delete;
+  TraversalCache& operator=(TraversalCache const&) = delete;
+
+  explicit TraversalCache(std::shared_ptr<cache::Cache> cache);
+  ~TraversalCache();
+
+ public:
+  /// @brief return the cache instance, or a nullptr if no cache can be
+  /// created, e.g. because the cache manager is not available
+  static TraversalCache* instance();
+
+  /// @brief look up the value stored for the key. returns false if there is
+  /// none, and copies the value into the builder otherwise
+  bool lookup(std::string const& key,
+              arangodb::velocypack::Builder& result) const;
+
+  /// @brief store the value for the key. the value may silently not be
+  /// stored, e.g. if the cache is full
+  void store(std::string const& key, arangodb::velocypack::Slice value);
+
+ private:
+  /// @brief the underlying transactional cache
+  std::shared_ptr<cache::Cache> _cache;
+};
+
+}  // namespace traverser
+}  // namespace arangodb
+
+#endif
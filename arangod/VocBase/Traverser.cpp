@@ -115,15 +115,11 @@ bool Traverser::UniqueVertexGetter::getVertex(
     toAdd = transaction::helpers::extractToFromDocument(edge);
   }
 
-  arangodb::basics::VPackHashedSlice hashed(toAdd);
-
   // First check if we visited it. If not, then mark
-  if (_returnedVertices.find(hashed) != _returnedVertices.end()) {
+  if (!_returnedVertices.insert(toAdd)) {
     // This vertex is not unique.
     ++_traverser->_filteredPaths;
     return false;
-  } else {
-    _returnedVertices.emplace(hashed);
   }
 
   if (!_traverser->vertexMatchesConditions(toAdd, result.size())) {
@@ -142,15 +138,11 @@ bool Traverser::UniqueVertexGetter::getSingleVertex(
     result = transaction::helpers::extractToFromDocument(edge);
   }
   
-  arangodb::basics::VPackHashedSlice hashed(result);
-  
   // First check if we visited it. If not, then mark
-  if (_returnedVertices.find(hashed) != _returnedVertices.end()) {
+  if (!_returnedVertices.insert(result)) {
     // This vertex is not unique.
     ++_traverser->_filteredPaths;
     return false;
-  } else {
-    _returnedVertices.emplace(hashed);
   }
 
   return _traverser->vertexMatchesConditions(result, depth);
@@ -159,9 +151,8 @@ bool Traverser::UniqueVertexGetter::getSingleVertex(
 void Traverser::UniqueVertexGetter::reset(VPackSlice startVertex) {
   _returnedVertices.clear();
   
-  arangodb::basics::VPackHashedSlice hashed(startVertex);
   // The startVertex always counts as visited!
-  _returnedVertices.emplace(hashed);
+  _returnedVertices.insert(startVertex);
 }
 
 Traverser::Traverser(arangodb::traverser::TraverserOptions* opts, transaction::Methods* trx,
@@ -32,6 +32,7 @@
 #include "Aql/AstNode.h"
 #include "Transaction/Helpers.h"
 #include "VocBase/PathEnumerator.h"
+#include "VocBase/VertexInterner.h"
 #include "VocBase/voc-types.h"
 
 namespace arangodb {
@@ -218,7 +219,7 @@ class Traverser {
     void reset(arangodb::velocypack::Slice) override;
 
    private:
-    std::unordered_set<arangodb::basics::VPackHashedSlice> _returnedVertices;
+    VertexInterner _returnedVertices;
   };
 
 
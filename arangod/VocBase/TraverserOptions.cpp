@@ -28,7 +28,10 @@
 #include "Aql/Query.h"
 #include "Basics/VelocyPackHelper.h"
 #include "Cluster/ClusterEdgeCursor.h"
+#include "Cluster/ClusterTraverser.h"
 #include "Indexes/Index.h"
+#include "Utils/OperationCursor.h"
+#include "VocBase/LogicalCollection.h"
 #include "VocBase/SingleServerTraverser.h"
 
 #include <velocypack/Iterator.h>
@@ -88,14 +91,17 @@ arangodb::traverser::TraverserOptions::LookupInfo::LookupInfo(
   }
 
   read = info.get("expression");
-  if (!read.isObject()) {
+  if (read.isObject()) {
+    expression = new aql::Expression(query->ast(), read);
+  } else if (!read.isNone()) {
+    // the expression is left out if the index enforces the whole condition
     THROW_ARANGO_EXCEPTION_MESSAGE(
         TRI_ERROR_BAD_PARAMETER,
         "Each lookup requires expression to be an object");
+  } else {
+    expression = nullptr;
   }
 
-  expression = new aql::Expression(query->ast(), read);
-
   read = info.get("condition");
   if (!read.isObject()) {
     THROW_ARANGO_EXCEPTION_MESSAGE(
@@ -112,7 +118,9 @@ arangodb::traverser::TraverserOptions::LookupInfo::LookupInfo(
       indexCondition(other.indexCondition),
       conditionNeedUpdate(other.conditionNeedUpdate),
       conditionMemberToUpdate(other.conditionMemberToUpdate) {
-  expression = other.expression->clone(nullptr);
+  if (other.expression != nullptr) {
+    expression = other.expression->clone(nullptr);
+  }
 }
 
 void arangodb::traverser::TraverserOptions::LookupInfo::buildEngineInfo(
@@ -124,11 +132,13 @@ void arangodb::traverser::TraverserOptions::LookupInfo::buildEngineInfo(
   result.openObject();
   idxHandles[0].toVelocyPack(result, false);
   result.close();
-  result.add(VPackValue("expression"));
-  result.openObject(); // We need to encapsulate the expression into an expression object
-  result.add(VPackValue("expression"));
-  expression->toVelocyPack(result, true);
-  result.close();
+  if (expression != nullptr) {
+    result.add(VPackValue("expression"));
+    result.openObject(); // We need to encapsulate the expression into an expression object
+    result.add(VPackValue("expression"));
+    expression->toVelocyPack(result, true);
+    result.close();
+  }
   result.add(VPackValue("condition"));
   indexCondition->toVelocyPack(result, true);
   result.add("condNeedUpdate", VPackValue(conditionNeedUpdate));
@@ -148,7 +158,10 @@ arangodb::traverser::TraverserOptions::TraverserOptions(
       maxDepth(1),
       useBreadthFirst(false),
       uniqueVertices(UniquenessLevel::NONE),
-      uniqueEdges(UniquenessLevel::PATH) {
+      uniqueEdges(UniquenessLevel::PATH),
+      useCache(false),
+      producePathVertices(true),
+      producePathEdges(true) {
   VPackSlice obj = slice.get("traversalFlags");
   TRI_ASSERT(obj.isObject());
 
@@ -156,6 +169,10 @@ arangodb::traverser::TraverserOptions::TraverserOptions(
   maxDepth = VPackHelper::getNumericValue<uint64_t>(obj, "maxDepth", 1);
   TRI_ASSERT(minDepth <= maxDepth);
   useBreadthFirst = VPackHelper::getBooleanValue(obj, "bfs", false);
+  useCache = VPackHelper::getBooleanValue(obj, "cache", false);
+  producePathVertices =
+      VPackHelper::getBooleanValue(obj, "pathVertices", true);
+  producePathEdges = VPackHelper::getBooleanValue(obj, "pathEdges", true);
   std::string tmp = VPackHelper::getStringValue(obj, "uniqueVertices", "");
   if (tmp == "path") {
     uniqueVertices =
@@ -201,7 +218,10 @@ arangodb::traverser::TraverserOptions::TraverserOptions(
       maxDepth(1),
       useBreadthFirst(false),
       uniqueVertices(UniquenessLevel::NONE),
-      uniqueEdges(UniquenessLevel::PATH) {
+      uniqueEdges(UniquenessLevel::PATH),
+      useCache(false),
+      producePathVertices(true),
+      producePathEdges(true) {
       // NOTE collections is an array of arrays of strings
   VPackSlice read = info.get("minDepth");
   if (!read.isInteger()) {
@@ -359,7 +379,10 @@ arangodb::traverser::TraverserOptions::TraverserOptions(
       maxDepth(other.maxDepth),
       useBreadthFirst(other.useBreadthFirst),
       uniqueVertices(other.uniqueVertices),
-      uniqueEdges(other.uniqueEdges) {
+      uniqueEdges(other.uniqueEdges),
+      useCache(other.useCache),
+      producePathVertices(other.producePathVertices),
+      producePathEdges(other.producePathEdges) {
   TRI_ASSERT(other._baseLookupInfos.empty());
   TRI_ASSERT(other._depthLookupInfo.empty());
   TRI_ASSERT(other._vertexExpressions.empty());
@@ -389,6 +412,9 @@ void arangodb::traverser::TraverserOptions::toVelocyPack(VPackBuilder& builder)
   builder.add("minDepth", VPackValue(minDepth));
   builder.add("maxDepth", VPackValue(maxDepth));
   builder.add("bfs", VPackValue(useBreadthFirst));
+  builder.add("cache", VPackValue(useCache));
+  builder.add("pathVertices", VPackValue(producePathVertices));
+  builder.add("pathEdges", VPackValue(producePathEdges));
 
   switch (uniqueVertices) {
     case arangodb::traverser::TraverserOptions::UniquenessLevel::NONE:
@@ -667,6 +693,152 @@ arangodb::traverser::TraverserOptions::nextCursorLocal(ManagedDocumentResult* mm
   return allCursor.release();
 }
 
+bool arangodb::traverser::TraverserOptions::nextEdgesBatch(
+    ManagedDocumentResult* mmdr, std::vector<VPackSlice> const& vertices,
+    uint64_t depth,
+    std::function<void(VPackSlice, VPackSlice)> const& callback) const {
+  if (_isCoordinator) {
+    // the DBServers evaluate the conditions of the depth themselves
+    TRI_ASSERT(_traverser != nullptr);
+    _traverser->fetchEdgesBatch(vertices, depth, callback);
+    return true;
+  }
+  TRI_ASSERT(mmdr != nullptr);
+  auto specific = _depthLookupInfo.find(depth);
+  std::vector<LookupInfo> const& list =
+      (specific != _depthLookupInfo.end()) ? specific->second
+                                           : _baseLookupInfos;
+
+  for (auto const& info : list) {
+    if (!canBatchLookup(info)) {
+      return false;
+    }
+  }
+
+  // The nodes of the IN condition are not registered in the AST. They
+  // only have to live until the index has created its iterator, which
+  // copies the vertex ids into its own search values.
+  aql::AstNode values(aql::NODE_TYPE_ARRAY);
+  std::deque<aql::AstNode> valueNodes;
+  for (auto const& vertex : vertices) {
+    TRI_ASSERT(vertex.isString());
+    VPackValueLength length;
+    char const* vid = vertex.getString(length);
+    valueNodes.emplace_back(vid, static_cast<size_t>(length),
+                            aql::VALUE_TYPE_STRING);
+    values.addMember(&valueNodes.back());
+  }
+
+  for (auto const& info : list) {
+    auto dirCmp =
+        info.indexCondition->getMemberUnchecked(info.conditionMemberToUpdate);
+    auto attrNode = dirCmp->getMemberUnchecked(0);
+    bool const isFrom = attrNode->stringEquals(StaticStrings::FromString);
+
+    aql::AstNode in(aql::NODE_TYPE_OPERATOR_BINARY_IN);
+    in.addMember(attrNode);
+    in.addMember(&values);
+    aql::AstNode condition(aql::NODE_TYPE_OPERATOR_NARY_AND);
+    condition.addMember(&in);
+
+    for (auto const& it : info.idxHandles) {
+      std::unique_ptr<OperationCursor> cursor(_trx->indexScanForCondition(
+          it, &condition, _tmpVar, mmdr, UINT64_MAX, 1000, false));
+      if (!cursor->successful()) {
+        THROW_ARANGO_EXCEPTION(cursor->code);
+      }
+
+      LogicalCollection* collection = cursor->collection();
+      auto cb = [&](DocumentIdentifierToken const& token) {
+        if (collection->readDocument(_trx, token, *mmdr)) {
+          VPackSlice edge(mmdr->vpack());
+          callback(edge,
+                   isFrom ? transaction::helpers::extractFromFromDocument(edge)
+                          : transaction::helpers::extractToFromDocument(edge));
+        }
+      };
+      while (cursor->getMore(cb, 1000)) {
+      }
+    }
+  }
+  return true;
+}
+
+bool arangodb::traverser::TraverserOptions::canUseCache() const {
+  if (_isCoordinator || !_depthLookupInfo.empty() ||
+      !_vertexExpressions.empty() || _baseVertexExpression != nullptr ||
+      _baseLookupInfos.empty()) {
+    return false;
+  }
+
+  for (auto const& info : _baseLookupInfos) {
+    if (info.expression != nullptr || !canBatchLookup(info)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void arangodb::traverser::TraverserOptions::buildCacheKey(
+    VPackSlice startVertex, std::string& key) const {
+  TRI_ASSERT(canUseCache());
+  TRI_ASSERT(startVertex.isString());
+
+  auto appendNumber = [&key](uint64_t value) {
+    key.append(reinterpret_cast<char const*>(&value), sizeof(value));
+  };
+
+  key.clear();
+  appendNumber(_trx->vocbase()->id());
+  appendNumber(maxDepth);
+
+  for (auto const& info : _baseLookupInfos) {
+    // the attribute compared with the vertex is either _from or _to
+    auto dirCmp = info.indexCondition->getMemberUnchecked(0);
+    key.push_back(
+        dirCmp->getMemberUnchecked(0)->stringEquals(StaticStrings::FromString)
+            ? 'o'
+            : 'i');
+    for (auto const& it : info.idxHandles) {
+      LogicalCollection* collection = it.getIndex()->collection();
+      appendNumber(collection->cid());
+      appendNumber(collection->modificationEpoch());
+    }
+  }
+
+  VPackValueLength length;
+  char const* p = startVertex.getString(length);
+  key.append(p, static_cast<size_t>(length));
+}
+
+/// @brief whether or not the lookups of a LookupInfo can be done for many
+/// vertices at once. this is the case if they use the edge index with
+/// nothing but the _from / _to comparison
+bool arangodb::traverser::TraverserOptions::canBatchLookup(
+    LookupInfo const& info) {
+  aql::AstNode const* node = info.indexCondition;
+  if (!info.conditionNeedUpdate || node == nullptr ||
+      node->numMembers() != 1 || info.conditionMemberToUpdate != 0 ||
+      info.idxHandles.empty()) {
+    return false;
+  }
+
+  auto dirCmp = node->getMemberUnchecked(0);
+  if (dirCmp->type != aql::NODE_TYPE_OPERATOR_BINARY_EQ ||
+      dirCmp->numMembers() != 2 ||
+      dirCmp->getMemberUnchecked(0)->type != aql::NODE_TYPE_ATTRIBUTE_ACCESS) {
+    return false;
+  }
+
+  for (auto const& it : info.idxHandles) {
+    auto idx = it.getIndex();
+    if (idx == nullptr || idx->type() != Index::TRI_IDX_TYPE_EDGE_INDEX) {
+      return false;
+    }
+  }
+  return true;
+}
+
 arangodb::traverser::EdgeCursor*
 arangodb::traverser::TraverserOptions::nextCursorCoordinator(
     VPackSlice vertex, uint64_t depth) const {
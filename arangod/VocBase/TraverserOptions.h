@@ -69,8 +69,6 @@ struct TraverserOptions {
  public:
   enum UniquenessLevel { NONE, PATH, GLOBAL };
 
- protected:
-
   struct LookupInfo {
     // This struct does only take responsibility for the expression
     // NOTE: The expression can be nullptr!
@@ -118,6 +116,17 @@ struct TraverserOptions {
 
   UniquenessLevel uniqueEdges;
 
+  /// @brief whether or not the neighbors of the start vertices may be taken
+  ///        from and stored in the traversal cache
+  bool useCache;
+
+  /// @brief whether or not the vertices and the edges of the path are
+  ///        produced in the path output. the optimizer turns off the parts
+  ///        that are never accessed
+  bool producePathVertices;
+
+  bool producePathEdges;
+
   explicit TraverserOptions(transaction::Methods* trx)
       : _trx(trx),
         _baseVertexExpression(nullptr),
@@ -129,7 +138,10 @@ struct TraverserOptions {
         maxDepth(1),
         useBreadthFirst(false),
         uniqueVertices(UniquenessLevel::NONE),
-        uniqueEdges(UniquenessLevel::PATH) {}
+        uniqueEdges(UniquenessLevel::PATH),
+        useCache(false),
+        producePathVertices(true),
+        producePathEdges(true) {}
 
   TraverserOptions(transaction::Methods*, arangodb::velocypack::Slice const&);
 
@@ -162,6 +174,36 @@ struct TraverserOptions {
 
   EdgeCursor* nextCursor(ManagedDocumentResult*, arangodb::velocypack::Slice, uint64_t) const;
 
+  /// @brief look up the edges of all given vertices with one index lookup
+  ///        per edge index, or one request per DBServer on a coordinator,
+  ///        instead of one cursor per vertex. Calls the callback with each
+  ///        edge and the vertex it was found for.
+  ///        Returns false without looking up anything if the lookups of
+  ///        this depth cannot be batched, i.e. for conditions other than
+  ///        a plain _from / _to comparison.
+  bool nextEdgesBatch(
+      ManagedDocumentResult*,
+      std::vector<arangodb::velocypack::Slice> const&, uint64_t,
+      std::function<void(arangodb::velocypack::Slice,
+                         arangodb::velocypack::Slice)> const&) const;
+
+  /// @brief whether or not the lookups of a LookupInfo can be done for many
+  ///        vertices at once. This is the case if they use the edge index
+  ///        with nothing but the _from / _to comparison.
+  static bool canBatchLookup(LookupInfo const&);
+
+  /// @brief whether or not the neighbors of a start vertex only depend on
+  ///        the edges of the traversed collections, so that they can be
+  ///        cached across queries. This is not the case if there are any
+  ///        filter conditions on edges or vertices.
+  bool canUseCache() const;
+
+  /// @brief build the traversal cache key for the neighbors of the start
+  ///        vertex. It consists of the database, the depth, the edge
+  ///        collections with their modification epochs and directions and
+  ///        the start vertex. Requires canUseCache().
+  void buildCacheKey(arangodb::velocypack::Slice, std::string&) const;
+
   void clearVariableValues();
 
   void setVariableValue(aql::Variable const*, aql::AqlValue const);
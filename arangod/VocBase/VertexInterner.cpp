@@ -0,0 +1,140 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "VertexInterner.h"
+#include "Basics/Exceptions.h"
+#include "Basics/VelocyPackHelper.h"
+
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+using namespace arangodb::traverser;
+
+namespace {
+/// @brief initial number of slots in the lookup table
+static constexpr size_t InitialSlots = 64;
+
+/// @brief lookup tables bigger than this are freed by clear() instead of
+/// being wiped, so that many small traversals after a big one stay cheap
+static constexpr size_t MaxRetainedSlots = 64 * 1024;
+}
+
+VertexInterner::VertexInterner() : _slots(InitialSlots, 0) {}
+
+VertexInterner::~VertexInterner() {}
+
+/// @brief whether or not the vertex is interned
+bool VertexInterner::contains(VPackSlice vertex) const {
+  return _slots[findSlot(vertex, vertex.hashString())] != 0;
+}
+
+/// @brief intern the vertex. returns true if the vertex was not interned
+/// before, in which case it has got the id size() - 1
+bool VertexInterner::insert(VPackSlice vertex) {
+  TRI_ASSERT(vertex.isString());
+  uint64_t const hash = vertex.hashString();
+  size_t slot = findSlot(vertex, hash);
+
+  if (_slots[slot] != 0) {
+    // already interned
+    return false;
+  }
+
+  if (_vertices.size() >= UINT32_MAX - 1) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_RESOURCE_LIMIT,
+                                   "too many vertices in traversal");
+  }
+
+  // keep the load factor at or below 50%
+  if ((_vertices.size() + 1) * 2 > _slots.size()) {
+    rehash(_slots.size() * 2);
+    slot = findSlot(vertex, hash);
+  }
+
+  _vertices.emplace_back(vertex);
+  try {
+    _hashes.emplace_back(hash);
+  } catch (...) {
+    _vertices.pop_back();
+    throw;
+  }
+
+  _slots[slot] = static_cast<uint32_t>(_vertices.size());
+  return true;
+}
+
+/// @brief remove all vertices
+void VertexInterner::clear() {
+  _vertices.clear();
+  _hashes.clear();
+
+  if (_slots.size() > MaxRetainedSlots) {
+    std::vector<uint32_t> slots(InitialSlots, 0);
+    _slots.swap(slots);
+  } else {
+    std::fill(_slots.begin(), _slots.end(), 0);
+  }
+}
+
+/// @brief find the slot for the vertex, which is either the slot that
+/// contains the vertex or the empty slot where it would go
+size_t VertexInterner::findSlot(VPackSlice vertex, uint64_t hash) const {
+  TRI_ASSERT(!_slots.empty());
+  TRI_ASSERT((_slots.size() & (_slots.size() - 1)) == 0);
+
+  basics::VelocyPackHelper::VPackHashedStringEqual const equal;
+  basics::VPackHashedSlice const hashed(vertex, hash);
+  size_t const mask = _slots.size() - 1;
+  size_t slot = static_cast<size_t>(hash) & mask;
+
+  while (true) {
+    uint32_t const value = _slots[slot];
+    if (value == 0) {
+      return slot;
+    }
+    size_t const id = value - 1;
+    if (_hashes[id] == hash &&
+        equal(hashed, basics::VPackHashedSlice(_vertices[id], hash))) {
+      return slot;
+    }
+    // linear probing
+    slot = (slot + 1) & mask;
+  }
+}
+
+/// @brief resize the lookup table to the specified number of slots
+void VertexInterner::rehash(size_t numSlots) {
+  TRI_ASSERT((numSlots & (numSlots - 1)) == 0);
+  TRI_ASSERT(numSlots > _vertices.size());
+
+  std::vector<uint32_t> slots(numSlots, 0);
+  size_t const mask = numSlots - 1;
+
+  for (size_t id = 0; id < _vertices.size(); ++id) {
+    size_t slot = static_cast<size_t>(_hashes[id]) & mask;
+    while (slots[slot] != 0) {
+      slot = (slot + 1) & mask;
+    }
+    slots[slot] = static_cast<uint32_t>(id + 1);
+  }
+
+  _slots.swap(slots);
+}
@@ -0,0 +1,92 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_VOC_BASE_VERTEX_INTERNER_H
+#define ARANGOD_VOC_BASE_VERTEX_INTERNER_H 1
+
+#include "Basics/Common.h"
+
+#include <velocypack/Slice.h>
+
+namespace arangodb {
+namespace traverser {
+
+/// @brief maps the _id string slices of the vertices seen by a traversal to
+/// dense ids 0, 1, 2, ... in the order in which they were first seen.
+/// the lookup table is a flat open-addressing hash table of 32 bit ids, so
+/// a vertex costs at most 32 bytes and no allocation of its own, unlike a
+/// node of a std::unordered_set. the vertices must be string slices. they
+/// are not copied and must stay valid while they are interned
+class VertexInterner {
+ public:
+  VertexInterner(VertexInterner const&) = delete;
+  VertexInterner& operator=(VertexInterner const&) = delete;
+
+  VertexInterner();
+  ~VertexInterner();
+
+ public:
+  /// @brief number of interned vertices
+  size_t size() const { return _vertices.size(); }
+
+  /// @brief whether or not no vertex is interned
+  bool empty() const { return _vertices.empty(); }
+
+  /// @brief return the vertex with the specified dense id
+  arangodb::velocypack::Slice vertex(size_t id) const {
+    TRI_ASSERT(id < _vertices.size());
+    return _vertices[id];
+  }
+
+  /// @brief whether or not the vertex is interned
+  bool contains(arangodb::velocypack::Slice vertex) const;
+
+  /// @brief intern the vertex. returns true if the vertex was not interned
+  /// before, in which case it has got the id size() - 1
+  bool insert(arangodb::velocypack::Slice vertex);
+
+  /// @brief remove all vertices
+  void clear();
+
+ private:
+  /// @brief find the slot for the vertex, which is either the slot that
+  /// contains the vertex or the empty slot where it would go
+  size_t findSlot(arangodb::velocypack::Slice vertex, uint64_t hash) const;
+
+  /// @brief resize the lookup table to the specified number of slots
+  void rehash(size_t numSlots);
+
+ private:
+  /// @brief the interned vertices, indexed by their id
+  std::vector<arangodb::velocypack::Slice> _vertices;
+
+  /// @brief hash values of the interned vertices, indexed by their id
+  std::vector<uint64_t> _hashes;
+
+  /// @brief lookup table. 0 means empty, all other values are id + 1.
+  /// the number of slots is always a power of two
+  std::vector<uint32_t> _slots;
+};
+
+}  // namespace traverser
+}  // namespace arangodb
+
+#endif
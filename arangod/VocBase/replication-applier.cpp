@@ -285,6 +285,12 @@ static int LoadConfiguration(TRI_vocbase_t* vocbase,
     config->_autoResyncRetries = value.getNumber<uint64_t>();
   }
 
+  value = slice.get("applyThreads");
+
+  if (value.isNumber()) {
+    config->_applyThreads = value.getNumber<uint64_t>();
+  }
+
   // read the endpoint
   value = slice.get("endpoint");
 
@@ -464,6 +470,7 @@ TRI_replication_applier_configuration_t::
       _idleMaxWaitTime(5 * 500 * 1000),
       _initialSyncMaxWaitTime(300 * 1000 * 1000),
       _autoResyncRetries(2),
+      _applyThreads(1),
       _sslProtocol(0),
       _autoStart(false),
       _adaptivePolling(true),
@@ -522,6 +529,7 @@ void TRI_replication_applier_configuration_t::toVelocyPack(
   builder.add("adaptivePolling", VPackValue(_adaptivePolling));
   builder.add("autoResync", VPackValue(_autoResync));
   builder.add("autoResyncRetries", VPackValue(_autoResyncRetries));
+  builder.add("applyThreads", VPackValue(_applyThreads));
   builder.add("includeSystem", VPackValue(_includeSystem));
   builder.add("requireFromPresent", VPackValue(_requireFromPresent));
   builder.add("verbose", VPackValue(_verbose));
@@ -827,6 +835,7 @@ void TRI_replication_applier_configuration_t::update(
   _idleMinWaitTime = src->_idleMinWaitTime;
   _idleMaxWaitTime = src->_idleMaxWaitTime;
   _autoResyncRetries = src->_autoResyncRetries;
+  _applyThreads = src->_applyThreads;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -57,6 +57,12 @@
 
 #define TRI_REPLICATION_HEADER_ACTIVE "x-arango-replication-active"
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief HTTP response header for "request was long-polled"
+////////////////////////////////////////////////////////////////////////////////
+
+#define TRI_REPLICATION_HEADER_LONGPOLL "x-arango-replication-longpoll"
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief replication operations
 ////////////////////////////////////////////////////////////////////////////////
@@ -30,6 +30,7 @@
 #include "MMFiles/MMFilesLogfileManager.h" //TODO -- remove
 #include "MMFiles/MMFilesCompactionLocker.h"
 #include "MMFiles/MMFilesDitch.h"
+#include "MMFiles/MMFilesDocumentCompression.h"
 #include "VocBase/LogicalCollection.h"
 #include "VocBase/vocbase.h"
 
@@ -156,6 +157,22 @@ static TRI_replication_operation_e TranslateType(
   }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the VelocyPack payload of a marker. the document of a document
+/// marker may be compressed, and is then decompressed into the buffer
+////////////////////////////////////////////////////////////////////////////////
+
+static VPackSlice MarkerPayload(TRI_df_marker_t const* marker,
+                                VPackBuffer<uint8_t>& buffer) {
+  TRI_df_marker_type_t const type = marker->getType();
+  uint8_t const* vpack = reinterpret_cast<uint8_t const*>(marker) +
+                         MMFilesDatafileHelper::VPackOffset(type);
+  if (type == TRI_DF_MARKER_VPACK_DOCUMENT) {
+    return MMFilesDocumentCompression::document(vpack, buffer);
+  }
+  return VPackSlice(vpack);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief stringify a raw marker from a logfile for a log dump or logger
 /// follow command
@@ -169,6 +186,9 @@ static int StringifyMarker(TRI_replication_dump_t* dump,
   TRI_ASSERT(MustReplicateWalMarkerType(marker));
   TRI_df_marker_type_t const type = marker->getType();
 
+  VPackBuffer<uint8_t> payloadBuffer;
+  VPackSlice const payload = MarkerPayload(marker, payloadBuffer);
+
   if (!isDump) {
     // logger-follow command
     Append(dump, "{\"tick\":\"");
@@ -180,8 +200,7 @@ static int StringifyMarker(TRI_replication_dump_t* dump,
     if (dump->_compat28 && (type == TRI_DF_MARKER_VPACK_DOCUMENT ||
                             type == TRI_DF_MARKER_VPACK_REMOVE)) {
       // 2.8-compatible format
-      VPackSlice slice(reinterpret_cast<char const*>(marker) +
-                       MMFilesDatafileHelper::VPackOffset(type));
+      VPackSlice slice = payload;
       arangodb::basics::VPackStringBufferAdapter adapter(dump->_buffer);
       VPackDumper dumper(
           &adapter,
@@ -250,8 +269,7 @@ static int StringifyMarker(TRI_replication_dump_t* dump,
     if (dump->_compat28 && (type == TRI_DF_MARKER_VPACK_DOCUMENT ||
                             type == TRI_DF_MARKER_VPACK_REMOVE)) {
       // 2.8-compatible format
-      VPackSlice slice(reinterpret_cast<char const*>(marker) +
-                       MMFilesDatafileHelper::VPackOffset(type));
+      VPackSlice slice = payload;
       arangodb::basics::VPackStringBufferAdapter adapter(dump->_buffer);
       VPackDumper dumper(
           &adapter,
@@ -290,8 +308,7 @@ static int StringifyMarker(TRI_replication_dump_t* dump,
     case TRI_DF_MARKER_VPACK_DROP_INDEX: {
       Append(dump, ",\"data\":");
 
-      VPackSlice slice(reinterpret_cast<char const*>(marker) +
-                       MMFilesDatafileHelper::VPackOffset(type));
+      VPackSlice slice = payload;
       arangodb::basics::VPackStringBufferAdapter adapter(dump->_buffer);
       VPackDumper dumper(
           &adapter,
@@ -318,6 +335,126 @@ static int StringifyMarker(TRI_replication_dump_t* dump,
   return TRI_ERROR_NO_ERROR;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief append the data of a document or remove marker to a builder. the
+/// _id attribute is stored as a custom type that refers to the local
+/// collection id and is converted to a string. all other values are copied
+/// as they are
+////////////////////////////////////////////////////////////////////////////////
+
+static void AppendDocumentVPack(TRI_replication_dump_t* dump,
+                                VPackBuilder& builder, VPackSlice slice) {
+  builder.openObject();
+
+  for (auto const& it : VPackObjectIterator(slice, true)) {
+    builder.add(it.key.makeKey());
+
+    if (it.value.isCustom()) {
+      builder.add(VPackValue(dump->_vpackOptions.customTypeHandler->toString(
+          it.value, &dump->_vpackOptions, slice)));
+    } else {
+      builder.add(it.value);
+    }
+  }
+
+  builder.close();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief append a raw marker from a logfile or datafile to the dump buffer
+/// as a VelocyPack value, with the same attributes as StringifyMarker
+/// produces. the marker data is copied instead of being converted to JSON,
+/// so neither the master nor the client need to encode or parse JSON
+////////////////////////////////////////////////////////////////////////////////
+
+static int AppendMarkerVPack(TRI_replication_dump_t* dump,
+                             TRI_voc_tick_t databaseId,
+                             TRI_voc_cid_t collectionId,
+                             TRI_df_marker_t const* marker, bool isDump,
+                             bool withTicks) {
+  TRI_ASSERT(MustReplicateWalMarkerType(marker));
+  TRI_ASSERT(!dump->_compat28);
+  TRI_df_marker_type_t const type = marker->getType();
+
+  VPackBuffer<uint8_t> payloadBuffer;
+  VPackSlice const payload = MarkerPayload(marker, payloadBuffer);
+
+  VPackBuilder& builder = dump->_builder;
+  builder.clear();
+  builder.openObject();
+
+  if (!isDump || withTicks) {
+    builder.add("tick", VPackValue(std::to_string(marker->getTick())));
+  }
+  builder.add("type", VPackValue(static_cast<uint64_t>(TranslateType(marker))));
+
+  if (!isDump) {
+    // logger-follow command
+    if (type == TRI_DF_MARKER_VPACK_DOCUMENT ||
+        type == TRI_DF_MARKER_VPACK_REMOVE ||
+        type == TRI_DF_MARKER_VPACK_BEGIN_TRANSACTION ||
+        type == TRI_DF_MARKER_VPACK_COMMIT_TRANSACTION ||
+        type == TRI_DF_MARKER_VPACK_ABORT_TRANSACTION) {
+      // transaction id
+      builder.add("tid", VPackValue(std::to_string(
+                             MMFilesDatafileHelper::TransactionId(marker))));
+    }
+    if (databaseId > 0) {
+      builder.add("database", VPackValue(std::to_string(databaseId)));
+      if (collectionId > 0) {
+        builder.add("cid", VPackValue(std::to_string(collectionId)));
+        // also include collection name
+        char const* cname = NameFromCid(dump, collectionId);
+        if (cname != nullptr) {
+          builder.add("cname", VPackValue(cname));
+        }
+      }
+    }
+  }
+
+  switch (type) {
+    case TRI_DF_MARKER_VPACK_DOCUMENT:
+    case TRI_DF_MARKER_VPACK_REMOVE: {
+      VPackSlice slice = payload;
+      builder.add(VPackValue("data"));
+      AppendDocumentVPack(dump, builder, slice);
+      break;
+    }
+
+    case TRI_DF_MARKER_VPACK_CREATE_DATABASE:
+    case TRI_DF_MARKER_VPACK_CREATE_COLLECTION:
+    case TRI_DF_MARKER_VPACK_CREATE_INDEX:
+    case TRI_DF_MARKER_VPACK_RENAME_COLLECTION:
+    case TRI_DF_MARKER_VPACK_CHANGE_COLLECTION:
+    case TRI_DF_MARKER_VPACK_DROP_DATABASE:
+    case TRI_DF_MARKER_VPACK_DROP_COLLECTION:
+    case TRI_DF_MARKER_VPACK_DROP_INDEX: {
+      VPackSlice slice = payload;
+      builder.add("data", slice);
+      break;
+    }
+
+    case TRI_DF_MARKER_VPACK_BEGIN_TRANSACTION:
+    case TRI_DF_MARKER_VPACK_COMMIT_TRANSACTION:
+    case TRI_DF_MARKER_VPACK_ABORT_TRANSACTION: {
+      // nothing to do
+      break;
+    }
+
+    default: {
+      TRI_ASSERT(false);
+      LOG_TOPIC(ERR, arangodb::Logger::FIXME) << "got invalid marker of type " << static_cast<int>(type); 
+      return TRI_ERROR_INTERNAL;
+    }
+  }
+
+  builder.close();
+
+  VPackSlice const result = builder.slice();
+  return TRI_AppendString2StringBuffer(dump->_buffer, result.startAs<char>(),
+                                       static_cast<size_t>(result.byteSize()));
+}
+
 static int SliceifyMarker(TRI_replication_dump_t* dump,
                           TRI_voc_tick_t databaseId, TRI_voc_cid_t collectionId,
                           TRI_df_marker_t const* marker, bool isDump,
@@ -325,6 +462,9 @@ static int SliceifyMarker(TRI_replication_dump_t* dump,
   TRI_ASSERT(MustReplicateWalMarkerType(marker));
   TRI_df_marker_type_t const type = marker->getType();
 
+  VPackBuffer<uint8_t> payloadBuffer;
+  VPackSlice const payload = MarkerPayload(marker, payloadBuffer);
+
   VPackBuffer<uint8_t> buffer;
   std::shared_ptr<VPackBuffer<uint8_t>> bufferPtr;
   bufferPtr.reset(&buffer, arangodb::velocypack::BufferNonDeleter<uint8_t>());
@@ -339,8 +479,7 @@ static int SliceifyMarker(TRI_replication_dump_t* dump,
     if (dump->_compat28 && (type == TRI_DF_MARKER_VPACK_DOCUMENT ||
                             type == TRI_DF_MARKER_VPACK_REMOVE)) {
       // 2.8-compatible format
-      VPackSlice slice(reinterpret_cast<char const*>(marker) +
-                       MMFilesDatafileHelper::VPackOffset(type));
+      VPackSlice slice = payload;
       // additionally dump "key" and "rev" attributes on the top-level
       builder.add("key", slice.get(StaticStrings::KeyString));
       if (slice.hasKey(StaticStrings::RevString)) {
@@ -387,8 +526,7 @@ static int SliceifyMarker(TRI_replication_dump_t* dump,
     if (dump->_compat28 && (type == TRI_DF_MARKER_VPACK_DOCUMENT ||
                             type == TRI_DF_MARKER_VPACK_REMOVE)) {
       // 2.8-compatible format
-      VPackSlice slice(reinterpret_cast<char const*>(marker) +
-                       MMFilesDatafileHelper::VPackOffset(type));
+      VPackSlice slice = payload;
       builder.add("key", slice.get(StaticStrings::KeyString));
       if (slice.hasKey(StaticStrings::RevString)) {
         builder.add("rev", slice.get(StaticStrings::RevString));
@@ -417,8 +555,7 @@ static int SliceifyMarker(TRI_replication_dump_t* dump,
     case TRI_DF_MARKER_VPACK_DROP_DATABASE:
     case TRI_DF_MARKER_VPACK_DROP_COLLECTION:
     case TRI_DF_MARKER_VPACK_DROP_INDEX: {
-      VPackSlice slice(reinterpret_cast<char const*>(marker) +
-                       MMFilesDatafileHelper::VPackOffset(type));
+      VPackSlice slice = payload;
       builder.add("data", slice);
       break;
     }
@@ -543,6 +680,9 @@ static int DumpCollection(TRI_replication_dump_t* dump,
     if (useVpp) {
       res = SliceifyMarker(dump, databaseId, collectionId, marker, true,
                            withTicks, isEdgeCollection);
+    } else if (dump->_writeVelocyPack) {
+      res = AppendMarkerVPack(dump, databaseId, collectionId, marker, true,
+                              withTicks);
     } else {
       res = StringifyMarker(dump, databaseId, collectionId, marker, true,
                             withTicks, isEdgeCollection);
@@ -773,6 +913,9 @@ int TRI_DumpLogReplication(
         if (dump->_useVpp) {
           res = SliceifyMarker(dump, databaseId, collectionId, marker, false,
                                true, false);
+        } else if (dump->_writeVelocyPack) {
+          res = AppendMarkerVPack(dump, databaseId, collectionId, marker,
+                                  false, true);
         } else {
           res = StringifyMarker(dump, databaseId, collectionId, marker, false,
                                 true, false);
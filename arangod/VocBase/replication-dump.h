@@ -63,6 +63,7 @@ struct TRI_replication_dump_t {
         _includeSystem(includeSystem),
         _fromTickIncluded(false),
         _compat28(false),
+        _writeVelocyPack(false),
         _slices(),
         _useVpp(useVpp) {
     if (_chunkSize == 0) {
@@ -100,6 +101,12 @@ struct TRI_replication_dump_t {
   bool _includeSystem;
   bool _fromTickIncluded;
   bool _compat28;
+  /// @brief write the markers into _buffer as consecutive VelocyPack values
+  /// instead of JSON lines. the attribute names and value types are the
+  /// same as in the JSON format
+  bool _writeVelocyPack;
+  /// @brief scratch builder for the VelocyPack format
+  arangodb::velocypack::Builder _builder;
   std::vector<VPackBuffer<uint8_t>> _slices;
   bool _useVpp;
 };
@@ -188,6 +188,8 @@ void TRI_vocbase_t::registerCollection(
   
     collection->setStatus(TRI_VOC_COL_STATUS_UNLOADED);
     TRI_ASSERT(_collectionsByName.size() == _collectionsById.size());
+
+    invalidateCollectionNames();
   }
 }
 
@@ -211,9 +213,25 @@ bool TRI_vocbase_t::unregisterCollection(arangodb::LogicalCollection* collection
   // post-condition
   TRI_ASSERT(_collectionsByName.size() == _collectionsById.size());
 
+  invalidateCollectionNames();
+
   return true;
 }
 
+/// @brief returns the current snapshot of the collection name and id maps,
+/// building it if necessary
+std::shared_ptr<CollectionNamesSnapshot const>
+TRI_vocbase_t::collectionNamesSnapshot() {
+  return _collectionNames.get(_collectionsLock, _collectionsByName,
+                              _collectionsById);
+}
+
+/// @brief discards the snapshot of the collection name and id maps
+/// caller must hold _collectionsLock in write mode
+void TRI_vocbase_t::invalidateCollectionNames() {
+  _collectionNames.invalidate();
+}
+
 /// @brief drops a collection
 bool TRI_vocbase_t::DropCollectionCallback(arangodb::LogicalCollection* collection) {
   std::string const name(collection->name());
@@ -630,6 +648,7 @@ void TRI_vocbase_t::shutdown() {
     WRITE_LOCKER(readLocker, _collectionsLock);
     _collectionsByName.clear();
     _collectionsById.clear();
+    invalidateCollectionNames();
   }
 
   // free dead collections (already dropped but pointers still around)
@@ -722,18 +741,18 @@ std::shared_ptr<VPackBuilder> TRI_vocbase_t::inventory(TRI_voc_tick_t maxTick,
 }
 
 /// @brief gets a collection name by a collection id
-/// the name is fetched under a lock to make this thread-safe.
+/// the name is fetched from the name snapshot to make this thread-safe.
 /// returns empty string if the collection does not exist.
 std::string TRI_vocbase_t::collectionName(TRI_voc_cid_t id) {
-  READ_LOCKER(readLocker, _collectionsLock);
+  auto snapshot = collectionNamesSnapshot();
 
-  auto it = _collectionsById.find(id);
+  auto it = snapshot->namesById.find(id);
 
-  if (it == _collectionsById.end()) {
+  if (it == snapshot->namesById.end()) {
     return StaticStrings::Empty;
   }
 
-  return (*it).second->name();
+  return (*it).second;
 }
 
 /// @brief looks up a collection by name
@@ -750,11 +769,11 @@ LogicalCollection* TRI_vocbase_t::lookupCollection(std::string const& name) {
   }
 
   // otherwise we'll look up the collection by name
-  READ_LOCKER(readLocker, _collectionsLock);
+  auto snapshot = collectionNamesSnapshot();
 
-  auto it = _collectionsByName.find(name);
+  auto it = snapshot->byName.find(name);
 
-  if (it == _collectionsByName.end()) {
+  if (it == snapshot->byName.end()) {
     return nullptr;
   }
   return (*it).second;
@@ -790,11 +809,11 @@ LogicalCollection* TRI_vocbase_t::lookupCollectionNoLock(std::string const& name
 
 /// @brief looks up a collection by identifier
 LogicalCollection* TRI_vocbase_t::lookupCollection(TRI_voc_cid_t id) {
-  READ_LOCKER(readLocker, _collectionsLock);
+  auto snapshot = collectionNamesSnapshot();
   
-  auto it = _collectionsById.find(id);
+  auto it = snapshot->byId.find(id);
 
-  if (it == _collectionsById.end()) {
+  if (it == snapshot->byId.end()) {
     return nullptr;
   }
   return (*it).second;
@@ -1036,6 +1055,8 @@ int TRI_vocbase_t::renameCollection(arangodb::LogicalCollection* collection,
   }
   TRI_ASSERT(_collectionsByName.size() == _collectionsById.size());
 
+  invalidateCollectionNames();
+
   locker.unlock();
   writeLocker.unlock();
 
@@ -31,6 +31,7 @@
 #include "Basics/ReadWriteLock.h"
 #include "Basics/StringUtils.h"
 #include "Basics/voc-errors.h"
+#include "VocBase/CollectionNamesCache.h"
 #include "VocBase/voc-types.h"
 
 #include "velocypack/Slice.h"
@@ -162,6 +163,9 @@ struct TRI_vocbase_t {
  
   std::unordered_map<std::string, arangodb::LogicalCollection*> _collectionsByName;  // collections by name
   std::unordered_map<TRI_voc_cid_t, arangodb::LogicalCollection*> _collectionsById;    // collections by id
+
+  /// @brief immutable copy of the name and id maps
+  arangodb::CollectionNamesCache _collectionNames;
   
   std::unique_ptr<arangodb::aql::QueryList> _queries;
   std::unique_ptr<arangodb::CursorRepository> _cursorRepository;
@@ -240,7 +244,7 @@ struct TRI_vocbase_t {
   std::vector<std::string> collectionNames();
 
   /// @brief get a collection name by a collection id
-  /// the name is fetched under a lock to make this thread-safe.
+  /// the name is fetched from the name snapshot to make this thread-safe.
   /// returns empty string if the collection does not exist.
   std::string collectionName(TRI_voc_cid_t id);
 
@@ -301,6 +305,15 @@ struct TRI_vocbase_t {
   /// @brief looks up a collection by name, without acquiring a lock
   arangodb::LogicalCollection* lookupCollectionNoLock(std::string const& name);
 
+  /// @brief returns the current snapshot of the collection name and id
+  /// maps, building it if necessary
+  std::shared_ptr<arangodb::CollectionNamesSnapshot const>
+  collectionNamesSnapshot();
+
+  /// @brief discards the snapshot of the collection name and id maps
+  /// caller must hold _collectionsLock in write mode
+  void invalidateCollectionNames();
+
   int loadCollection(arangodb::LogicalCollection* collection,
                      TRI_vocbase_col_status_e& status,
                      bool setStatus = true);
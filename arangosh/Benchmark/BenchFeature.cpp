@@ -73,6 +73,10 @@ BenchFeature::BenchFeature(application_features::ApplicationServer* server,
       _replicationFactor(1),
       _numberOfShards(1),
       _waitForSync(false),
+      _mix("read=70,query=20,update=10"),
+      _keyDistribution("uniform"),
+      _keySpace(10000),
+      _rate(0.0),
       _result(result) {
   requiresElevatedPrivileges(false);
   setOptional(false);
@@ -132,7 +136,14 @@ void BenchFeature::collectOptions(std::shared_ptr<ProgramOptions> options) {
                                            "multitrx",
                                            "multi-collection",
                                            "aqlinsert",
-                                           "aqlv8"};
+                                           "aqlv8",
+                                           "mix",
+                                           "aql-traversal",
+                                           "aql-shortest-path",
+                                           "aql-collect",
+                                           "aql-range",
+                                           "aql-join",
+                                           "agency-write"};
   std::vector<std::string> casesVector(cases.begin(), cases.end());
   std::string casesJoined = StringUtils::join(casesVector, ", ");
 
@@ -143,6 +154,32 @@ void BenchFeature::collectOptions(std::shared_ptr<ProgramOptions> options) {
   options->addOption("--complexity", "complexity parameter for the test",
                      new UInt64Parameter(&_complexity));
 
+  options->addOption("--mix",
+                     "weighted operations for the 'mix' test case, from "
+                     "read, query, update and insert (e.g. "
+                     "\"read=70,query=20,update=10\")",
+                     new StringParameter(&_mix));
+
+  std::unordered_set<std::string> distributions = {"uniform", "zipfian",
+                                                   "latest"};
+
+  options->addOption(
+      "--key-distribution",
+      "distribution of the keys accessed by the 'mix' test case (uniform, "
+      "zipfian or latest)",
+      new DiscreteValuesParameter<StringParameter>(&_keyDistribution,
+                                                   distributions));
+
+  options->addOption("--key-space",
+                     "number of documents created for the 'mix' test case",
+                     new UInt64Parameter(&_keySpace));
+
+  options->addOption("--rate",
+                     "send requests at this total rate per second, "
+                     "independent of response times (0 = send the next "
+                     "request when the previous one has returned)",
+                     new DoubleParameter(&_rate));
+
   options->addOption("--delay",
                      "use a startup delay (necessary only when run in series)",
                      new BooleanParameter(&_delay));
@@ -166,6 +203,55 @@ void BenchFeature::collectOptions(std::shared_ptr<ProgramOptions> options) {
                      new BooleanParameter(&_quiet));
 }
 
+void BenchFeature::validateOptions(
+    std::shared_ptr<options::ProgramOptions> options) {
+  if (_rate < 0.0) {
+    LOG_TOPIC(FATAL, arangodb::Logger::FIXME)
+        << "invalid value for --rate, expecting a value of at least 0";
+    FATAL_ERROR_EXIT();
+  }
+
+  if (_keySpace == 0) {
+    LOG_TOPIC(FATAL, arangodb::Logger::FIXME)
+        << "invalid value for --key-space, expecting a value of at least 1";
+    FATAL_ERROR_EXIT();
+  }
+
+  std::unordered_set<std::string> const operations = {"read", "query",
+                                                      "update", "insert"};
+
+  _parsedMix.clear();
+
+  for (auto const& it : StringUtils::split(_mix, ",")) {
+    auto parts = StringUtils::split(it, "=");
+
+    if (parts.size() == 2) {
+      StringUtils::trimInPlace(parts[0]);
+      StringUtils::trimInPlace(parts[1]);
+    }
+
+    if (parts.size() != 2 || operations.find(parts[0]) == operations.end()) {
+      LOG_TOPIC(FATAL, arangodb::Logger::FIXME)
+          << "invalid operation '" << it << "' in --mix, expecting "
+          << "<operation>=<weight> with an operation from read, query, "
+             "update and insert";
+      FATAL_ERROR_EXIT();
+    }
+
+    uint64_t const weight = StringUtils::uint64(parts[1]);
+
+    if (weight > 0) {
+      _parsedMix.emplace_back(parts[0], weight);
+    }
+  }
+
+  if (_parsedMix.empty()) {
+    LOG_TOPIC(FATAL, arangodb::Logger::FIXME)
+        << "invalid value for --mix, expecting at least one operation";
+    FATAL_ERROR_EXIT();
+  }
+}
+
 void BenchFeature::status(std::string const& value) {
   if (!_quiet) {
     std::cout << value << std::endl;
@@ -215,6 +301,9 @@ void BenchFeature::start() {
 
   std::vector<BenchmarkThread*> threads;
 
+  // in open-loop mode, each thread sends its share of the total rate
+  double const interval = _rate > 0.0 ? (double)_concurreny / _rate : 0.0;
+
   bool ok = true;
   std::vector<BenchRunResult> results;
   for (uint64_t j = 0; j < _runs; j++) {
@@ -228,7 +317,7 @@ void BenchFeature::start() {
       BenchmarkThread* thread = new BenchmarkThread(
           benchmark.get(), &startCondition, &BenchFeature::updateStartCounter,
           static_cast<int>(i), (unsigned long)_batchSize, &operationsCounter,
-          client, _keepAlive, _async, _verbose);
+          client, _keepAlive, _async, _verbose, interval);
       thread->setOffset((size_t)(i * realStep));
       thread->start();
       threads.push_back(thread);
@@ -289,6 +378,7 @@ void BenchFeature::start() {
     results.push_back({
         time, operationsCounter.failures(),
         operationsCounter.incompleteFailures(), requestTime,
+        latencies(benchmark->kinds(), threads),
     });
     for (size_t i = 0; i < static_cast<size_t>(_concurreny); ++i) {
       delete threads[i];
@@ -310,6 +400,44 @@ void BenchFeature::start() {
   *_result = ret;
 }
 
+/// @brief merge the latencies measured by the threads and compute their
+/// percentiles
+std::vector<BenchLatency> BenchFeature::latencies(
+    std::vector<std::string> const& kinds,
+    std::vector<BenchmarkThread*> const& threads) {
+  std::vector<BenchLatency> result;
+
+  for (size_t i = 0; i < kinds.size() + 1; ++i) {
+    std::vector<double> values;
+
+    for (auto const& thread : threads) {
+      auto const& latencies = thread->getLatencies();
+      if (i < latencies.size()) {
+        values.insert(values.end(), latencies[i].begin(), latencies[i].end());
+      }
+    }
+
+    if (values.empty()) {
+      continue;
+    }
+
+    std::sort(values.begin(), values.end());
+
+    // nearest-rank percentile
+    auto percentile = [&values](double p) {
+      size_t rank = static_cast<size_t>(std::ceil(p * values.size()));
+      return values[(std::max)(rank, static_cast<size_t>(1)) - 1];
+    };
+
+    result.push_back(BenchLatency{i == 0 ? "all" : kinds[i - 1],
+                                  values.size(), percentile(0.5),
+                                  percentile(0.99), percentile(0.999),
+                                  values.back()});
+  }
+
+  return result;
+}
+
 bool BenchFeature::report(ClientFeature* client,
                           std::vector<BenchRunResult> results) {
   std::cout << std::endl;
@@ -322,7 +450,11 @@ bool BenchFeature::report(ClientFeature* client,
             << ", replication factor: " << _replicationFactor
             << ", number of shards: " << _numberOfShards
             << ", wait for sync: " << (_waitForSync ? "true" : "false")
-            << ", concurrency level (threads): " << _concurreny << std::endl;
+            << ", concurrency level (threads): " << _concurreny;
+  if (_rate > 0.0) {
+    std::cout << ", rate: " << _rate << "/s";
+  }
+  std::cout << std::endl;
 
   std::cout << "Test case: " << _testCase << ", complexity: " << _complexity
             << ", database: '" << client->databaseName() << "', collection: '"
@@ -331,7 +463,7 @@ bool BenchFeature::report(ClientFeature* client,
   std::sort(results.begin(), results.end(),
             [](BenchRunResult a, BenchRunResult b) { return a.time < b.time; });
 
-  BenchRunResult output{0, 0, 0, 0};
+  BenchRunResult output{0, 0, 0, 0, {}};
   if (_runs > 1) {
     size_t size = results.size();
     std::cout << std::endl;
@@ -352,6 +484,7 @@ bool BenchFeature::report(ClientFeature* client,
           (results[mid - 1].failures + results[mid].failures) / 2,
           (results[mid - 1].incomplete + results[mid].incomplete) / 2,
           (results[mid - 1].requestTime + results[mid].requestTime) / 2);
+      output.latencies = results[mid].latencies;
     } else {
       output = results[mid];
     }
@@ -396,7 +529,19 @@ bool BenchFeature::writeJunitReport(BenchRunResult const& result) {
                "failures=\"0\" errors=\"0\" timestamp=\""
             << date << "\" hostname=\"" << hostname << "\" time=\""
             << std::fixed << result.time << "\">\n"
-            << "<properties/>\n"
+            << "<properties>\n";
+    for (auto const& latency : result.latencies) {
+      std::string const prefix = "latency." + latency.name + ".";
+      outfile << "<property name=\"" << prefix << "p50\" value=\""
+              << std::fixed << latency.p50 << "\"/>\n"
+              << "<property name=\"" << prefix << "p99\" value=\""
+              << std::fixed << latency.p99 << "\"/>\n"
+              << "<property name=\"" << prefix << "p999\" value=\""
+              << std::fixed << latency.p999 << "\"/>\n"
+              << "<property name=\"" << prefix << "max\" value=\""
+              << std::fixed << latency.max << "\"/>\n";
+    }
+    outfile << "</properties>\n"
             << "<testcase name=\"" << testCase() << "\" classname=\"BenchTest\""
             << " time=\"" << std::fixed << result.time << "\"/>\n"
             << "</testsuite>\n";
@@ -431,6 +576,17 @@ void BenchFeature::printResult(BenchRunResult const& result) {
             << std::endl
             << std::endl;
 
+  for (auto const& latency : result.latencies) {
+    std::cout << "Latency (" << latency.name << ", " << latency.count
+              << " requests): p50: " << std::fixed << latency.p50
+              << " s, p99: " << latency.p99 << " s, p99.9: " << latency.p999
+              << " s, max: " << latency.max << " s" << std::endl;
+  }
+
+  if (!result.latencies.empty()) {
+    std::cout << std::endl;
+  }
+
   if (result.failures > 0) {
     LOG_TOPIC(WARN, arangodb::Logger::FIXME) << "WARNING: " << result.failures
               << " arangobench request(s) failed!";
@@ -26,14 +26,27 @@
 #include "ApplicationFeatures/ApplicationFeature.h"
 
 namespace arangodb {
+namespace arangobench {
+class BenchmarkThread;
+}
 
 class ClientFeature;
 
+struct BenchLatency {
+  std::string name;
+  size_t count;
+  double p50;
+  double p99;
+  double p999;
+  double max;
+};
+
 struct BenchRunResult {
   double time;
   size_t failures;
   size_t incomplete;
   double requestTime;
+  std::vector<BenchLatency> latencies;
 
   void update(double _time, size_t _failures, size_t _incomplete, double _requestTime) {
     time = _time;
@@ -49,6 +62,8 @@ class BenchFeature final : public application_features::ApplicationFeature {
 
  public:
   void collectOptions(std::shared_ptr<options::ProgramOptions>) override;
+  void validateOptions(
+      std::shared_ptr<options::ProgramOptions> options) override final;
   void start() override final;
   void unprepare() override final;
 
@@ -70,9 +85,17 @@ class BenchFeature final : public application_features::ApplicationFeature {
   uint64_t replicationFactor() const { return _replicationFactor; }
   uint64_t numberOfShards() const { return _numberOfShards; }
   bool waitForSync() const { return _waitForSync; }
+  std::vector<std::pair<std::string, uint64_t>> const& mix() const {
+    return _parsedMix;
+  }
+  std::string const& keyDistribution() const { return _keyDistribution; }
+  uint64_t keySpace() const { return _keySpace; }
 
  private:
   void status(std::string const& value);
+  static std::vector<BenchLatency> latencies(
+      std::vector<std::string> const& kinds,
+      std::vector<arangobench::BenchmarkThread*> const& threads);
   bool report(ClientFeature*, std::vector<BenchRunResult>);
   void printResult(BenchRunResult const& result);
   bool writeJunitReport(BenchRunResult const& result);
@@ -95,6 +118,11 @@ class BenchFeature final : public application_features::ApplicationFeature {
   uint64_t _replicationFactor;
   uint64_t _numberOfShards;
   bool _waitForSync;
+  std::string _mix;
+  std::vector<std::pair<std::string, uint64_t>> _parsedMix;
+  std::string _keyDistribution;
+  uint64_t _keySpace;
+  double _rate;
 
  private:
   int* _result;
@@ -78,6 +78,21 @@ struct BenchmarkOperation {
 
   virtual char const* payload(size_t*, int const, size_t const, size_t const,
                               bool*) = 0;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief return the names of the kinds of operations the test executes.
+  /// latencies are reported separately for each kind. tests that execute
+  /// a single kind of operation need not override this
+  //////////////////////////////////////////////////////////////////////////////
+
+  virtual std::vector<std::string> kinds() const { return {}; }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief return the kind of the operation to execute, as an index into
+  /// the names returned by kinds()
+  //////////////////////////////////////////////////////////////////////////////
+
+  virtual size_t kind(int const, size_t const, size_t const) { return 0; }
 };
 }
 }
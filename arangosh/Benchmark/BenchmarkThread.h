@@ -50,7 +50,7 @@ class BenchmarkThread : public arangodb::Thread {
                   int threadNumber, const unsigned long batchSize,
                   BenchmarkCounter<unsigned long>* operationsCounter,
                   ClientFeature* client, bool keepAlive, bool async,
-                  bool verbose)
+                  bool verbose, double interval)
       : Thread("BenchmarkThread"),
         _operation(operation),
         _startCondition(condition),
@@ -70,7 +70,10 @@ class BenchmarkThread : public arangodb::Thread {
         _offset(0),
         _counter(0),
         _time(0.0),
-        _verbose(verbose) {
+        _verbose(verbose),
+        _interval(interval),
+        _nextStart(0.0),
+        _latencies(1 + operation->kinds().size()) {
     _errorHeader =
         basics::StringUtils::tolower(StaticStrings::Errors);
   }
@@ -131,6 +134,8 @@ class BenchmarkThread : public arangodb::Thread {
       guard.wait();
     }
 
+    _nextStart = TRI_microtime();
+
     while (!isStopping()) {
       unsigned long numOps = _operationsCounter->next(_batchSize);
 
@@ -251,11 +256,15 @@ class BenchmarkThread : public arangodb::Thread {
     _headers[StaticStrings::ContentTypeHeader] =
         StaticStrings::MultiPartContentType + "; boundary=" + boundary;
 
+    double const scheduled = waitForSchedule();
     double start = TRI_microtime();
     httpclient::SimpleHttpResult* result = _httpClient->request(
         rest::RequestType::POST, "/_api/batch", batchPayload.c_str(),
         batchPayload.length(), _headers);
-    _time += TRI_microtime() - start;
+    double const end = TRI_microtime();
+    _time += end - start;
+    // the parts of a batch may be of different kinds
+    _latencies[0].emplace_back(end - scheduled);
 
     if (result == nullptr || !result->isComplete()) {
       if (result != nullptr) {
@@ -332,11 +341,19 @@ class BenchmarkThread : public arangodb::Thread {
     // threadCounter << ", globalCounter " << globalCounter << "\n";
     char const* payload = _operation->payload(
         &payloadLength, _threadNumber, threadCounter, globalCounter, &mustFree);
+    size_t const kind =
+        _operation->kind(_threadNumber, threadCounter, globalCounter);
 
+    double const scheduled = waitForSchedule();
     double start = TRI_microtime();
     httpclient::SimpleHttpResult* result =
         _httpClient->request(type, url, payload, payloadLength, _headers);
-    _time += TRI_microtime() - start;
+    double const end = TRI_microtime();
+    _time += end - start;
+    _latencies[0].emplace_back(end - scheduled);
+    if (kind + 1 < _latencies.size()) {
+      _latencies[kind + 1].emplace_back(end - scheduled);
+    }
 
     if (mustFree) {
       TRI_Free(TRI_UNKNOWN_MEM_ZONE, (void*)payload);
@@ -369,6 +386,32 @@ class BenchmarkThread : public arangodb::Thread {
     delete result;
   }
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief in open-loop mode, wait until the next request is due and
+  /// return the time it was due at. requests are scheduled at a fixed rate
+  /// no matter how long earlier requests took, and latencies are measured
+  /// from the scheduled time, so that a stalling server cannot hide the
+  /// requests that queue up behind a slow one. in closed-loop mode, return
+  /// the current time
+  //////////////////////////////////////////////////////////////////////////////
+
+  double waitForSchedule() {
+    double const now = TRI_microtime();
+
+    if (_interval <= 0.0) {
+      return now;
+    }
+
+    double const scheduled = _nextStart;
+    _nextStart += _interval;
+
+    if (scheduled > now) {
+      usleep(static_cast<unsigned long>((scheduled - now) * 1000.0 * 1000.0));
+    }
+
+    return scheduled;
+  }
+
  public:
   //////////////////////////////////////////////////////////////////////////////
   /// @brief set the threads offset value
@@ -382,6 +425,15 @@ class BenchmarkThread : public arangodb::Thread {
 
   double getTime() const { return _time; }
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief return the request latencies measured by the thread. the first
+  /// entry contains all requests, the others those of the operation kinds
+  //////////////////////////////////////////////////////////////////////////////
+
+  std::vector<std::vector<double>> const& getLatencies() const {
+    return _latencies;
+  }
+
  private:
   //////////////////////////////////////////////////////////////////////////////
   /// @brief the operation to benchmark
@@ -508,6 +560,25 @@ class BenchmarkThread : public arangodb::Thread {
   //////////////////////////////////////////////////////////////////////////////
 
   bool _verbose;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief seconds between two requests of the thread in open-loop mode,
+  /// 0 in closed-loop mode
+  //////////////////////////////////////////////////////////////////////////////
+
+  double const _interval;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief time at which the next request is due in open-loop mode
+  //////////////////////////////////////////////////////////////////////////////
+
+  double _nextStart;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief request latencies, all requests first, then per operation kind
+  //////////////////////////////////////////////////////////////////////////////
+
+  std::vector<std::vector<double>> _latencies;
 };
 }
 }
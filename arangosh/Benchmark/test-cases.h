@@ -23,8 +23,11 @@
 
 #include "Basics/Common.h"
 
+#include "Basics/tri-strings.h"
 #include "Random/RandomGenerator.h"
 
+#include <cmath>
+
 static bool DeleteCollection(SimpleHttpClient*, std::string const&);
 
 static bool CreateCollection(SimpleHttpClient*, std::string const&, int const);
@@ -35,6 +38,9 @@ static bool CreateDocument(SimpleHttpClient*, std::string const&,
 static bool CreateIndex(SimpleHttpClient*, std::string const&,
                         std::string const&, std::string const&);
 
+static bool ImportDocuments(SimpleHttpClient*, std::string const&,
+                            std::string const&);
+
 struct VersionTest : public BenchmarkOperation {
   VersionTest() : BenchmarkOperation() { _url = "/_api/version"; }
 
@@ -1518,6 +1524,445 @@ struct AqlV8Test : public BenchmarkOperation {
   }
 };
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief a weighted mix of reads by key, AQL lookups by key, updates and
+/// inserts on a collection with --key-space documents. which operation is
+/// executed and which key it accesses is derived from the global counter,
+/// so url(), type() and payload() agree for the same operation
+////////////////////////////////////////////////////////////////////////////////
+
+struct WorkloadMixTest : public BenchmarkOperation {
+  enum Operation { READ, QUERY, UPDATE, INSERT };
+
+  WorkloadMixTest()
+      : BenchmarkOperation(),
+        _keySpace(ARANGOBENCH->keySpace()),
+        _totalWeight(0),
+        _zetan(0.0),
+        _eta(0.0) {
+    for (auto const& it : ARANGOBENCH->mix()) {
+      Operation operation = READ;
+      if (it.first == "query") {
+        operation = QUERY;
+      } else if (it.first == "update") {
+        operation = UPDATE;
+      } else if (it.first == "insert") {
+        operation = INSERT;
+      }
+
+      _totalWeight += it.second;
+      _operations.emplace_back(operation, _totalWeight);
+      _kinds.emplace_back(it.first);
+    }
+
+    if (ARANGOBENCH->keyDistribution() != "uniform") {
+      // constants for the zipfian generator of Gray et al., "Quickly
+      // Generating Billion-Record Synthetic Databases", as used by YCSB
+      for (uint64_t i = 1; i <= _keySpace; ++i) {
+        _zetan += 1.0 / std::pow(static_cast<double>(i), Theta);
+      }
+      double const zeta2 = 1.0 + 1.0 / std::pow(2.0, Theta);
+      _eta = (1.0 - std::pow(2.0 / _keySpace, 1.0 - Theta)) /
+             (1.0 - zeta2 / _zetan);
+    }
+  }
+
+  ~WorkloadMixTest() {}
+
+  bool setUp(SimpleHttpClient* client) override {
+    if (!DeleteCollection(client, ARANGOBENCH->collection()) ||
+        !CreateCollection(client, ARANGOBENCH->collection(), 2)) {
+      return false;
+    }
+
+    // create the documents to work on
+    std::string payload;
+
+    for (uint64_t i = 0; i < _keySpace; ++i) {
+      payload += "{\"_key\":\"testkey" + StringUtils::itoa(i) +
+                 "\",\"value\":" + StringUtils::itoa(i) + "}\n";
+
+      if ((i + 1) % 10000 == 0 || i + 1 == _keySpace) {
+        if (!ImportDocuments(client, ARANGOBENCH->collection(), payload)) {
+          return false;
+        }
+        payload.clear();
+      }
+    }
+
+    return true;
+  }
+
+  void tearDown() override {}
+
+  std::vector<std::string> kinds() const override { return _kinds; }
+
+  size_t kind(int const threadNumber, size_t const threadCounter,
+              size_t const globalCounter) override {
+    uint64_t const value = Hash(2 * globalCounter) % _totalWeight;
+
+    for (size_t i = 0; i < _operations.size(); ++i) {
+      if (value < _operations[i].second) {
+        return i;
+      }
+    }
+
+    TRI_ASSERT(false);
+    return 0;
+  }
+
+  std::string url(int const threadNumber, size_t const threadCounter,
+                  size_t const globalCounter) override {
+    switch (operation(threadNumber, threadCounter, globalCounter)) {
+      case READ:
+      case UPDATE:
+        return std::string("/_api/document/" + ARANGOBENCH->collection() +
+                           "/" + key(globalCounter));
+      case QUERY:
+        return std::string("/_api/cursor");
+      case INSERT:
+        return std::string("/_api/document?collection=" +
+                           ARANGOBENCH->collection());
+    }
+
+    TRI_ASSERT(false);
+    return std::string();
+  }
+
+  rest::RequestType type(int const threadNumber, size_t const threadCounter,
+                         size_t const globalCounter) override {
+    switch (operation(threadNumber, threadCounter, globalCounter)) {
+      case READ:
+        return rest::RequestType::GET;
+      case UPDATE:
+        return rest::RequestType::PATCH;
+      case QUERY:
+      case INSERT:
+        return rest::RequestType::POST;
+    }
+
+    TRI_ASSERT(false);
+    return rest::RequestType::GET;
+  }
+
+  char const* payload(size_t* length, int const threadNumber,
+                      size_t const threadCounter, size_t const globalCounter,
+                      bool* mustFree) override {
+    std::string body;
+
+    switch (operation(threadNumber, threadCounter, globalCounter)) {
+      case READ:
+        *mustFree = false;
+        *length = 0;
+        return "";
+      case QUERY:
+        body = "{\"query\":\"FOR doc IN @@collection FILTER doc._key == @key "
+               "RETURN doc\",\"bindVars\":{\"@collection\":\"" +
+               ARANGOBENCH->collection() + "\",\"key\":\"" +
+               key(globalCounter) + "\"}}";
+        break;
+      case UPDATE:
+      case INSERT:
+        body = "{\"value\":" + StringUtils::itoa(globalCounter) + "}";
+        break;
+    }
+
+    *mustFree = true;
+    *length = body.size();
+    return TRI_DuplicateString(TRI_UNKNOWN_MEM_ZONE, body.c_str(),
+                               body.size());
+  }
+
+ private:
+  Operation operation(int const threadNumber, size_t const threadCounter,
+                      size_t const globalCounter) {
+    return _operations[kind(threadNumber, threadCounter, globalCounter)].first;
+  }
+
+  /// @brief the key accessed by an operation. with the zipfian
+  /// distribution, the documents created first are accessed most often,
+  /// with the latest distribution, those created last
+  std::string key(size_t const globalCounter) const {
+    // uniformly distributed value in [0, 1)
+    double const u =
+        static_cast<double>(Hash(2 * globalCounter + 1) >> 11) /
+        9007199254740992.0;
+    uint64_t id;
+
+    if (ARANGOBENCH->keyDistribution() == "uniform") {
+      id = static_cast<uint64_t>(u * _keySpace);
+    } else {
+      double const uz = u * _zetan;
+
+      if (uz < 1.0) {
+        id = 0;
+      } else if (uz < 1.0 + std::pow(0.5, Theta)) {
+        id = 1;
+      } else {
+        id = static_cast<uint64_t>(
+            _keySpace * std::pow(_eta * u - _eta + 1.0, 1.0 / (1.0 - Theta)));
+      }
+
+      if (ARANGOBENCH->keyDistribution() == "latest") {
+        id = _keySpace - 1 - (std::min)(id, _keySpace - 1);
+      }
+    }
+
+    return "testkey" + StringUtils::itoa((std::min)(id, _keySpace - 1));
+  }
+
+  /// @brief a well-mixed 64 bit hash (splitmix64)
+  static uint64_t Hash(uint64_t value) {
+    value += 0x9e3779b97f4a7c15ULL;
+    value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+    return value ^ (value >> 31);
+  }
+
+  static constexpr double Theta = 0.99;
+
+  uint64_t const _keySpace;
+  std::vector<std::pair<Operation, uint64_t>> _operations;
+  std::vector<std::string> _kinds;
+  uint64_t _totalWeight;
+  double _zetan;
+  double _eta;
+};
+
+/// @brief writes to the agency. must be run against an agent (the leader,
+/// or followers will redirect). each request contains complexity write
+/// transactions, which the agency appends to its log as one batch
+struct AgencyWriteTest : public BenchmarkOperation {
+  AgencyWriteTest() : BenchmarkOperation() {}
+
+  ~AgencyWriteTest() {}
+
+  bool setUp(SimpleHttpClient* client) override { return true; }
+
+  void tearDown() override {}
+
+  std::string url(int const threadNumber, size_t const threadCounter,
+                  size_t const globalCounter) override {
+    return std::string("/_api/agency/write");
+  }
+
+  rest::RequestType type(int const threadNumber, size_t const threadCounter,
+                         size_t const globalCounter) override {
+    return rest::RequestType::POST;
+  }
+
+  char const* payload(size_t* length, int const threadNumber,
+                      size_t const threadCounter, size_t const globalCounter,
+                      bool* mustFree) override {
+    TRI_string_buffer_t* buffer;
+    buffer = TRI_CreateSizedStringBuffer(TRI_UNKNOWN_MEM_ZONE, 256);
+
+    uint64_t n = ARANGOBENCH->complexity();
+    if (n == 0) {
+      n = 1;
+    }
+
+    TRI_AppendCharStringBuffer(buffer, '[');
+    for (uint64_t i = 0; i < n; ++i) {
+      if (i > 0) {
+        TRI_AppendCharStringBuffer(buffer, ',');
+      }
+      // spread the writes over a few keys per thread, so that the agency's
+      // store does not grow with the number of requests
+      TRI_AppendStringStringBuffer(buffer, "[{\"/arangobench/");
+      TRI_AppendStringStringBuffer(buffer, ARANGOBENCH->collection().c_str());
+      TRI_AppendCharStringBuffer(buffer, '/');
+      TRI_AppendInt64StringBuffer(buffer, (int64_t)threadNumber);
+      TRI_AppendCharStringBuffer(buffer, '/');
+      TRI_AppendUInt64StringBuffer(buffer, i % 16);
+      TRI_AppendStringStringBuffer(buffer, "\":{\"op\":\"set\",\"new\":");
+      TRI_AppendUInt64StringBuffer(buffer, (uint64_t)globalCounter);
+      TRI_AppendStringStringBuffer(buffer, "}}]");
+    }
+    TRI_AppendCharStringBuffer(buffer, ']');
+
+    *length = TRI_LengthStringBuffer(buffer);
+    *mustFree = true;
+    char* ptr = TRI_StealStringBuffer(buffer);
+    TRI_FreeStringBuffer(TRI_UNKNOWN_MEM_ZONE, buffer);
+
+    return (char const*)ptr;
+  }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief base for AQL query benchmarks on a generated dataset. the dataset
+/// consists of --complexity * 1000 vertices in the benchmark collection,
+/// three edges per vertex in "<collection>Edges" and one document per
+/// vertex in "<collection>Join" referring to a vertex. it is generated
+/// deterministically, so results are comparable between runs
+////////////////////////////////////////////////////////////////////////////////
+struct AqlQueryTest : public BenchmarkOperation {
+  AqlQueryTest()
+      : BenchmarkOperation(),
+        _vertices(ARANGOBENCH->collection()),
+        _edges(ARANGOBENCH->collection() + "Edges"),
+        _join(ARANGOBENCH->collection() + "Join"),
+        _numVertices(1000 * (std::max)(ARANGOBENCH->complexity(),
+                                       static_cast<uint64_t>(1))) {}
+
+  bool setUp(SimpleHttpClient* client) override {
+    if (!DeleteCollection(client, _vertices) ||
+        !DeleteCollection(client, _edges) || !DeleteCollection(client, _join) ||
+        !CreateCollection(client, _vertices, 2) ||
+        !CreateCollection(client, _edges, 3) ||
+        !CreateCollection(client, _join, 2) ||
+        !CreateIndex(client, _vertices, "skiplist", "[\"value\"]") ||
+        !CreateIndex(client, _join, "hash", "[\"ref\"]")) {
+      return false;
+    }
+
+    std::string vertices;
+    std::string edges;
+    std::string join;
+
+    for (uint64_t i = 0; i < _numVertices; ++i) {
+      std::string const key = vertexKey(i);
+
+      vertices += "{\"_key\":\"" + key + "\",\"value\":" +
+                  StringUtils::itoa(i) + ",\"group\":" +
+                  StringUtils::itoa(i % 100) + "}\n";
+
+      for (uint64_t j = 0; j < 3; ++j) {
+        edges += "{\"_from\":\"" + _vertices + "/" + key + "\",\"_to\":\"" +
+                 _vertices + "/" +
+                 vertexKey((i * 7 + j * 13 + 1) % _numVertices) + "\"}\n";
+      }
+
+      join += "{\"ref\":\"" + vertexKey((i * 31) % _numVertices) +
+              "\",\"value\":" + StringUtils::itoa(i) + "}\n";
+
+      if ((i + 1) % 10000 == 0 || i + 1 == _numVertices) {
+        if (!ImportDocuments(client, _vertices, vertices) ||
+            !ImportDocuments(client, _edges, edges) ||
+            !ImportDocuments(client, _join, join)) {
+          return false;
+        }
+
+        vertices.clear();
+        edges.clear();
+        join.clear();
+      }
+    }
+
+    return true;
+  }
+
+  void tearDown() override {}
+
+  std::string url(int const threadNumber, size_t const threadCounter,
+                  size_t const globalCounter) override {
+    return std::string("/_api/cursor");
+  }
+
+  rest::RequestType type(int const threadNumber, size_t const threadCounter,
+                         size_t const globalCounter) override {
+    return rest::RequestType::POST;
+  }
+
+  char const* payload(size_t* length, int const threadNumber,
+                      size_t const threadCounter, size_t const globalCounter,
+                      bool* mustFree) override {
+    std::string const body = "{\"query\":\"" + query() +
+                             "\",\"bindVars\":{" + bindVars(globalCounter) +
+                             "}}";
+
+    *mustFree = true;
+    *length = body.size();
+    return TRI_DuplicateString(TRI_UNKNOWN_MEM_ZONE, body.c_str(),
+                               body.size());
+  }
+
+ protected:
+  /// @brief the query to execute, JSON-encoded
+  virtual std::string query() const = 0;
+
+  /// @brief the bind parameters for an execution, as JSON object members
+  virtual std::string bindVars(size_t globalCounter) const = 0;
+
+  static std::string vertexKey(uint64_t i) {
+    return "v" + StringUtils::itoa(i);
+  }
+
+  std::string vertexId(uint64_t i) const {
+    return _vertices + "/" + vertexKey(i % _numVertices);
+  }
+
+  std::string const _vertices;
+  std::string const _edges;
+  std::string const _join;
+  uint64_t const _numVertices;
+};
+
+struct AqlTraversalTest : public AqlQueryTest {
+  std::string query() const override {
+    return "FOR v IN 1..3 OUTBOUND @start @@edges RETURN v._key";
+  }
+
+  std::string bindVars(size_t globalCounter) const override {
+    return "\"start\":\"" + vertexId(globalCounter) + "\",\"@edges\":\"" +
+           _edges + "\"";
+  }
+};
+
+struct AqlShortestPathTest : public AqlQueryTest {
+  std::string query() const override {
+    return "FOR v IN OUTBOUND SHORTEST_PATH @start TO @target @@edges RETURN "
+           "v._key";
+  }
+
+  std::string bindVars(size_t globalCounter) const override {
+    return "\"start\":\"" + vertexId(globalCounter) + "\",\"target\":\"" +
+           vertexId(globalCounter * 17 + _numVertices / 2) +
+           "\",\"@edges\":\"" + _edges + "\"";
+  }
+};
+
+struct AqlCollectTest : public AqlQueryTest {
+  std::string query() const override {
+    return "FOR doc IN @@collection COLLECT group = doc.group AGGREGATE "
+           "total = SUM(doc.value) WITH COUNT INTO count RETURN "
+           "{ group, total, count }";
+  }
+
+  std::string bindVars(size_t globalCounter) const override {
+    return "\"@collection\":\"" + _vertices + "\"";
+  }
+};
+
+struct AqlRangeTest : public AqlQueryTest {
+  std::string query() const override {
+    return "FOR doc IN @@collection FILTER doc.value >= @low && doc.value < "
+           "@high RETURN doc.value";
+  }
+
+  std::string bindVars(size_t globalCounter) const override {
+    uint64_t const low = globalCounter % _numVertices;
+    return "\"@collection\":\"" + _vertices + "\",\"low\":" +
+           StringUtils::itoa(low) + ",\"high\":" + StringUtils::itoa(low + 100);
+  }
+};
+
+struct AqlJoinTest : public AqlQueryTest {
+  std::string query() const override {
+    return "FOR v IN @@vertices FILTER v.value >= @low && v.value < @high "
+           "FOR j IN @@join FILTER j.ref == v._key RETURN { vertex: v._key, "
+           "value: j.value }";
+  }
+
+  std::string bindVars(size_t globalCounter) const override {
+    uint64_t const low = globalCounter % _numVertices;
+    return "\"@vertices\":\"" + _vertices + "\",\"@join\":\"" + _join +
+           "\",\"low\":" + StringUtils::itoa(low) +
+           ",\"high\":" + StringUtils::itoa(low + 10);
+  }
+};
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief delete a collection
 ////////////////////////////////////////////////////////////////////////////////
@@ -1636,6 +2081,34 @@ static bool CreateDocument(SimpleHttpClient* client,
   return !failed;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief import documents, one JSON object per line
+////////////////////////////////////////////////////////////////////////////////
+
+static bool ImportDocuments(SimpleHttpClient* client,
+                            std::string const& collection,
+                            std::string const& payload) {
+  std::unordered_map<std::string, std::string> headerFields;
+  SimpleHttpResult* result = nullptr;
+
+  result = client->request(
+      rest::RequestType::POST,
+      "/_api/import?type=documents&complete=true&collection=" + collection,
+      payload.c_str(), payload.size(), headerFields);
+
+  bool failed = true;
+
+  if (result != nullptr) {
+    if (result->getHttpReturnCode() == 201) {
+      failed = false;
+    }
+
+    delete result;
+  }
+
+  return !failed;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief return the test case for a name
 ////////////////////////////////////////////////////////////////////////////////
@@ -1701,6 +2174,27 @@ static BenchmarkOperation* GetTestCase(std::string const& name) {
   if (name == "aqlv8") {
     return new AqlV8Test();
   }
+  if (name == "mix") {
+    return new WorkloadMixTest();
+  }
+  if (name == "aql-traversal") {
+    return new AqlTraversalTest();
+  }
+  if (name == "aql-shortest-path") {
+    return new AqlShortestPathTest();
+  }
+  if (name == "aql-collect") {
+    return new AqlCollectTest();
+  }
+  if (name == "aql-range") {
+    return new AqlRangeTest();
+  }
+  if (name == "aql-join") {
+    return new AqlJoinTest();
+  }
+  if (name == "agency-write") {
+    return new AgencyWriteTest();
+  }
 
   return nullptr;
 }
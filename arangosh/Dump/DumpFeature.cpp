@@ -24,6 +24,7 @@
 
 #include "ApplicationFeatures/ApplicationServer.h"
 #include "Basics/FileUtils.h"
+#include "Basics/MutexLocker.h"
 #include "Basics/StringUtils.h"
 #include "Basics/VelocyPackHelper.h"
 #include "Basics/files.h"
@@ -42,6 +43,9 @@
 #include <velocypack/velocypack-aliases.h>
 
 #include <iostream>
+#include <thread>
+
+#include "zlib.h"
 
 using namespace arangodb;
 using namespace arangodb::basics;
@@ -49,6 +53,134 @@ using namespace arangodb::httpclient;
 using namespace arangodb::options;
 using namespace arangodb::rest;
 
+/// @brief protects progress messages printed by the dump threads
+static Mutex ProgressLock;
+
+/// @brief a data file of the dump. it is created when the first job
+/// writing into it starts, and closed when the last one has finished. in
+/// cluster mode, the shards of a collection are dumped concurrently into
+/// the same file, so writes are serialized. every write is a complete
+/// response body and thus consists of complete lines only
+struct DumpFeature::DataFile {
+  DataFile(std::string const& fileName, bool compress)
+      : _fileName(fileName),
+        _compress(compress),
+        _fd(-1),
+        _gzFile(nullptr),
+        _opened(false),
+        _pendingJobs(0) {}
+
+  ~DataFile() { close(); }
+
+  int open(std::string& errorMsg) {
+    MUTEX_LOCKER(locker, _lock);
+
+    if (_opened) {
+      return _fd >= 0 ? TRI_ERROR_NO_ERROR : TRI_ERROR_CANNOT_WRITE_FILE;
+    }
+
+    _opened = true;
+
+    // remove an existing file first
+    if (TRI_ExistsFile(_fileName.c_str())) {
+      TRI_UnlinkFile(_fileName.c_str());
+    }
+
+    _fd = TRI_CREATE(_fileName.c_str(),
+                     O_CREAT | O_EXCL | O_RDWR | TRI_O_CLOEXEC,
+                     S_IRUSR | S_IWUSR);
+
+    if (_fd >= 0 && _compress) {
+      _gzFile = gzdopen(_fd, "wb");
+
+      if (_gzFile == nullptr) {
+        TRI_CLOSE(_fd);
+        _fd = -1;
+      }
+    }
+
+    if (_fd < 0) {
+      errorMsg = "cannot write to file '" + _fileName + "'";
+
+      return TRI_ERROR_CANNOT_WRITE_FILE;
+    }
+
+    return TRI_ERROR_NO_ERROR;
+  }
+
+  bool write(char const* data, size_t length) {
+    MUTEX_LOCKER(locker, _lock);
+
+    if (_gzFile != nullptr) {
+      return length == 0 ||
+             gzwrite(_gzFile, data, static_cast<unsigned>(length)) ==
+                 static_cast<int>(length);
+    }
+
+    return TRI_WritePointer(_fd, data, length);
+  }
+
+  /// @brief register a job that writes into the file
+  void addJob() { ++_pendingJobs; }
+
+  /// @brief unregister a job, closing the file after the last one
+  int finishJob() {
+    {
+      MUTEX_LOCKER(locker, _lock);
+
+      TRI_ASSERT(_pendingJobs > 0);
+      if (--_pendingJobs > 0) {
+        return TRI_ERROR_NO_ERROR;
+      }
+    }
+
+    return close();
+  }
+
+  int close() {
+    MUTEX_LOCKER(locker, _lock);
+
+    int res = TRI_ERROR_NO_ERROR;
+
+    if (_gzFile != nullptr) {
+      // this closes the file descriptor as well
+      if (gzclose(_gzFile) != Z_OK) {
+        res = TRI_ERROR_CANNOT_WRITE_FILE;
+      }
+    } else if (_fd >= 0) {
+      if (TRI_CLOSE(_fd) != 0) {
+        res = TRI_ERROR_CANNOT_WRITE_FILE;
+      }
+    }
+
+    _gzFile = nullptr;
+    _fd = -1;
+
+    return res;
+  }
+
+  std::string const _fileName;
+  bool const _compress;
+
+  Mutex _lock;
+  int _fd;
+  gzFile _gzFile;
+  bool _opened;
+  size_t _pendingJobs;
+};
+
+/// @brief dumping the data of a collection, or of a shard in cluster mode
+struct DumpFeature::DumpJob {
+  std::shared_ptr<DataFile> _file;
+  /// @brief the collection id, or the shard name in cluster mode
+  std::string _collection;
+  /// @brief the collection name
+  std::string _name;
+  /// @brief the server responsible for the shard in cluster mode
+  std::string _DBserver;
+  uint64_t _maxTick;
+};
+
 DumpFeature::DumpFeature(application_features::ApplicationServer* server,
                          int* result)
     : ApplicationFeature(server, "Dump"),
@@ -64,10 +196,11 @@ DumpFeature::DumpFeature(application_features::ApplicationServer* server,
       _tickStart(0),
       _tickEnd(0),
       _compat28(false),
+      _threadCount(2),
+      _compressOutput(false),
       _result(result),
       _batchId(0),
-      _clusterMode(false),
-      _stats{0, 0, 0} {
+      _clusterMode(false) {
   requiresElevatedPrivileges(false);
   setOptional(false);
   startsAfter("Client");
@@ -121,6 +254,15 @@ void DumpFeature::collectOptions(
   options->addOption("--compat28",
                      "produce a dump compatible with ArangoDB 2.8",
                      new BooleanParameter(&_compat28));
+
+  options->addOption("--threads",
+                     "maximum number of collections (or shards in a cluster) "
+                     "to dump concurrently",
+                     new UInt32Parameter(&_threadCount));
+
+  options->addOption("--compress-output",
+                     "compress the data files using gzip",
+                     new BooleanParameter(&_compressOutput));
 }
 
 void DumpFeature::validateOptions(
@@ -145,6 +287,10 @@ void DumpFeature::validateOptions(
     _maxChunkSize = _chunkSize;
   }
 
+  if (_threadCount < 1) {
+    _threadCount = 1;
+  }
+
   if (_tickStart < _tickEnd) {
     LOG_TOPIC(FATAL, arangodb::Logger::FIXME)
         << "invalid values for --tick-start or --tick-end";
@@ -209,7 +355,9 @@ void DumpFeature::prepare() {
 }
 
 // start a batch
-int DumpFeature::startBatch(std::string DBserver, std::string& errorMsg) {
+int DumpFeature::startBatch(SimpleHttpClient* client,
+                            std::string const& DBserver, uint64_t& batchId,
+                            std::string& errorMsg) {
   std::string const url = "/_api/replication/batch";
   std::string const body = "{\"ttl\":300}";
 
@@ -218,12 +366,12 @@ int DumpFeature::startBatch(std::string DBserver, std::string& errorMsg) {
     urlExt = "?DBserver=" + DBserver;
   }
 
-  std::unique_ptr<SimpleHttpResult> response(_httpClient->request(
+  std::unique_ptr<SimpleHttpResult> response(client->request(
       rest::RequestType::POST, url + urlExt, body.c_str(), body.size()));
 
   if (response == nullptr || !response->isComplete()) {
     errorMsg =
-        "got invalid response from server: " + _httpClient->getErrorMessage();
+        "got invalid response from server: " + client->getErrorMessage();
 
     if (_force) {
       return TRI_ERROR_NO_ERROR;
@@ -253,50 +401,53 @@ int DumpFeature::startBatch(std::string DBserver, std::string& errorMsg) {
   std::string const id =
       arangodb::basics::VelocyPackHelper::getStringValue(resBody, "id", "");
 
-  _batchId = StringUtils::uint64(id);
+  batchId = StringUtils::uint64(id);
 
   return TRI_ERROR_NO_ERROR;
 }
 
 // prolongs a batch
-void DumpFeature::extendBatch(std::string DBserver) {
-  TRI_ASSERT(_batchId > 0);
+void DumpFeature::extendBatch(SimpleHttpClient* client,
+                              std::string const& DBserver, uint64_t batchId) {
+  TRI_ASSERT(batchId > 0);
 
   std::string const url =
-      "/_api/replication/batch/" + StringUtils::itoa(_batchId);
+      "/_api/replication/batch/" + StringUtils::itoa(batchId);
   std::string const body = "{\"ttl\":300}";
   std::string urlExt;
   if (!DBserver.empty()) {
     urlExt = "?DBserver=" + DBserver;
   }
 
-  std::unique_ptr<SimpleHttpResult> response(_httpClient->request(
+  std::unique_ptr<SimpleHttpResult> response(client->request(
       rest::RequestType::PUT, url + urlExt, body.c_str(), body.size()));
 
   // ignore any return value
 }
 
 // end a batch
-void DumpFeature::endBatch(std::string DBserver) {
-  TRI_ASSERT(_batchId > 0);
+void DumpFeature::endBatch(SimpleHttpClient* client,
+                           std::string const& DBserver, uint64_t& batchId) {
+  TRI_ASSERT(batchId > 0);
 
   std::string const url =
-      "/_api/replication/batch/" + StringUtils::itoa(_batchId);
+      "/_api/replication/batch/" + StringUtils::itoa(batchId);
   std::string urlExt;
   if (!DBserver.empty()) {
     urlExt = "?DBserver=" + DBserver;
   }
 
-  _batchId = 0;
+  batchId = 0;
 
-  std::unique_ptr<SimpleHttpResult> response(_httpClient->request(
+  std::unique_ptr<SimpleHttpResult> response(client->request(
       rest::RequestType::DELETE_REQ, url + urlExt, nullptr, 0));
 
   // ignore any return value
 }
 
 /// @brief dump a single collection
-int DumpFeature::dumpCollection(int fd, std::string const& cid,
+int DumpFeature::dumpCollection(SimpleHttpClient* client, DataFile& file,
+                                std::string const& cid,
                                 std::string const& name, uint64_t maxTick,
                                 std::string& errorMsg) {
   uint64_t chunkSize = _chunkSize;
@@ -321,11 +472,11 @@ int DumpFeature::dumpCollection(int fd, std::string const& cid,
     _stats._totalBatches++;
 
     std::unique_ptr<SimpleHttpResult> response(
-        _httpClient->request(rest::RequestType::GET, url, nullptr, 0));
+        client->request(rest::RequestType::GET, url, nullptr, 0));
 
     if (response == nullptr || !response->isComplete()) {
       errorMsg =
-          "got invalid response from server: " + _httpClient->getErrorMessage();
+          "got invalid response from server: " + client->getErrorMessage();
 
       return TRI_ERROR_INTERNAL;
     }
@@ -374,7 +525,7 @@ int DumpFeature::dumpCollection(int fd, std::string const& cid,
     if (res == TRI_ERROR_NO_ERROR) {
       StringBuffer const& body = response->getBody();
 
-      if (!TRI_WritePointer(fd, body.c_str(), body.length())) {
+      if (!file.write(body.c_str(), body.length())) {
         res = TRI_ERROR_CANNOT_WRITE_FILE;
       } else {
         _stats._totalWritten += (uint64_t)body.length();
@@ -534,6 +685,10 @@ int DumpFeature::runDump(std::string& dbName, std::string& errorMsg) {
     restrictList.insert(std::pair<std::string, bool>(_collections[i], true));
   }
 
+  std::string const dataSuffix =
+      _compressOutput ? ".data.json.gz" : ".data.json";
+  std::vector<DumpJob> jobs;
+
   // iterate over collections
   for (VPackSlice const& collection : VPackArrayIterator(collections)) {
     if (!collection.isObject()) {
@@ -627,49 +782,24 @@ int DumpFeature::runDump(std::string& dbName, std::string& errorMsg) {
     }
 
     if (_dumpData) {
-      // save the actual data
-      std::string fileName;
-      fileName = _outputDirectory + TRI_DIR_SEPARATOR_STR + name + "_" +
-                 hexString + ".data.json";
-
-      int fd;
-
-      // remove an existing file first
-      if (TRI_ExistsFile(fileName.c_str())) {
-        TRI_UnlinkFile(fileName.c_str());
-      }
-
-      fd = TRI_CREATE(fileName.c_str(),
-                      O_CREAT | O_EXCL | O_RDWR | TRI_O_CLOEXEC,
-                      S_IRUSR | S_IWUSR);
-
-      if (fd < 0) {
-        errorMsg = "cannot write to file '" + fileName + "'";
-
-        return TRI_ERROR_CANNOT_WRITE_FILE;
-      }
-
-      extendBatch("");
-      int res =
-          dumpCollection(fd, std::to_string(cid), name, maxTick, errorMsg);
-
-      TRI_CLOSE(fd);
-
-      if (res != TRI_ERROR_NO_ERROR) {
-        if (errorMsg.empty()) {
-          errorMsg = "cannot write to file '" + fileName + "'";
-        }
-
-        return res;
-      }
+      // the actual data is saved once all meta data has been written
+      auto file = std::make_shared<DataFile>(
+          _outputDirectory + TRI_DIR_SEPARATOR_STR + name + "_" + hexString +
+              dataSuffix,
+          _compressOutput);
+      file->addJob();
+
+      jobs.emplace_back(
+          DumpJob{file, std::to_string(cid), name, std::string(), maxTick});
     }
   }
 
-  return TRI_ERROR_NO_ERROR;
+  return runJobs(jobs, errorMsg);
 }
 
 /// @brief dump a single shard, that is a collection on a DBserver
-int DumpFeature::dumpShard(int fd, std::string const& DBserver,
+int DumpFeature::dumpShard(SimpleHttpClient* client, DataFile& file,
+                           std::string const& DBserver,
                            std::string const& name, std::string& errorMsg) {
   std::string const baseUrl = "/_api/replication/dump?DBserver=" + DBserver +
                               "&collection=" + name + "&chunkSize=" +
@@ -688,11 +818,11 @@ int DumpFeature::dumpShard(int fd, std::string const& DBserver,
     _stats._totalBatches++;
 
     std::unique_ptr<SimpleHttpResult> response(
-        _httpClient->request(rest::RequestType::GET, url, nullptr, 0));
+        client->request(rest::RequestType::GET, url, nullptr, 0));
 
     if (response == nullptr || !response->isComplete()) {
       errorMsg =
-          "got invalid response from server: " + _httpClient->getErrorMessage();
+          "got invalid response from server: " + client->getErrorMessage();
 
       return TRI_ERROR_INTERNAL;
     }
@@ -741,7 +871,7 @@ int DumpFeature::dumpShard(int fd, std::string const& DBserver,
     if (res == TRI_ERROR_NO_ERROR) {
       StringBuffer const& body = response->getBody();
 
-      if (!TRI_WritePointer(fd, body.c_str(), body.length())) {
+      if (!file.write(body.c_str(), body.length())) {
         res = TRI_ERROR_CANNOT_WRITE_FILE;
       } else {
         _stats._totalWritten += (uint64_t)body.length();
@@ -764,8 +894,6 @@ int DumpFeature::dumpShard(int fd, std::string const& DBserver,
 
 // dump data from cluster via a coordinator
 int DumpFeature::runClusterDump(std::string& errorMsg) {
-  int res;
-
   std::string const url =
       "/_api/replication/clusterInventory?includeSystem=" +
       std::string(_includeSystemCollections ? "true" : "false");
@@ -818,6 +946,10 @@ int DumpFeature::runClusterDump(std::string& errorMsg) {
     restrictList.insert(std::pair<std::string, bool>(_collections[i], true));
   }
 
+  std::string const dataSuffix =
+      _compressOutput ? ".data.json.gz" : ".data.json";
+  std::vector<DumpJob> jobs;
+
   // iterate over collections
   for (auto const& collection : VPackArrayIterator(collections)) {
     if (!collection.isObject()) {
@@ -902,27 +1034,13 @@ int DumpFeature::runClusterDump(std::string& errorMsg) {
     }
 
     if (_dumpData) {
-      // save the actual data
-
-      // Now set up the output file:
+      // the actual data is saved once all meta data has been written. all
+      // shards of the collection go into the same file
       std::string const hexString(arangodb::rest::SslInterface::sslMD5(name));
-      std::string fileName = _outputDirectory + TRI_DIR_SEPARATOR_STR + name +
-                             "_" + hexString + ".data.json";
-
-      // remove an existing file first
-      if (TRI_ExistsFile(fileName.c_str())) {
-        TRI_UnlinkFile(fileName.c_str());
-      }
-
-      int fd = TRI_CREATE(fileName.c_str(),
-                          O_CREAT | O_EXCL | O_RDWR | TRI_O_CLOEXEC,
-                          S_IRUSR | S_IWUSR);
-
-      if (fd < 0) {
-        errorMsg = "cannot write to file '" + fileName + "'";
-
-        return TRI_ERROR_CANNOT_WRITE_FILE;
-      }
+      auto file = std::make_shared<DataFile>(
+          _outputDirectory + TRI_DIR_SEPARATOR_STR + name + "_" + hexString +
+              dataSuffix,
+          _compressOutput);
 
       // First we have to go through all the shards, what are they?
       VPackSlice const shards = parameters.get("shards");
@@ -935,44 +1053,153 @@ int DumpFeature::runClusterDump(std::string& errorMsg) {
 
         if (!it.value.isArray() || it.value.length() == 0 ||
             !it.value[0].isString()) {
-          TRI_CLOSE(fd);
           errorMsg = "unexpected value for 'shards' attribute";
 
           return TRI_ERROR_BAD_PARAMETER;
         }
 
-        std::string DBserver = it.value[0].copyString();
+        file->addJob();
 
-        if (_progress) {
-          std::cout << "# Dumping shard '" << shardName << "' from DBserver '"
-                    << DBserver << "' ..." << std::endl;
-        }
-        res = startBatch(DBserver, errorMsg);
-        if (res != TRI_ERROR_NO_ERROR) {
-          TRI_CLOSE(fd);
-          return res;
-        }
-        res = dumpShard(fd, DBserver, shardName, errorMsg);
-        if (res != TRI_ERROR_NO_ERROR) {
-          TRI_CLOSE(fd);
-          return res;
-        }
-        endBatch(DBserver);
+        jobs.emplace_back(
+            DumpJob{file, shardName, name, it.value[0].copyString(), 0});
       }
+    }
+  }
 
-      res = TRI_CLOSE(fd);
+  return runJobs(jobs, errorMsg);
+}
 
-      if (res != TRI_ERROR_NO_ERROR) {
-        if (errorMsg.empty()) {
-          errorMsg = "cannot write to file '" + fileName + "'";
-        }
+/// @brief dump the data of a collection, or of a shard in cluster mode
+int DumpFeature::runJob(SimpleHttpClient* client, DumpJob const& job,
+                        std::string& errorMsg) {
+  int res = job._file->open(errorMsg);
+
+  if (res == TRI_ERROR_NO_ERROR) {
+    if (_clusterMode) {
+      if (_progress) {
+        MUTEX_LOCKER(locker, ProgressLock);
+        std::cout << "# Dumping shard '" << job._collection
+                  << "' from DBserver '" << job._DBserver << "' ..."
+                  << std::endl;
+      }
+
+      uint64_t batchId = 0;
+      res = startBatch(client, job._DBserver, batchId, errorMsg);
+
+      if (res == TRI_ERROR_NO_ERROR) {
+        res = dumpShard(client, *job._file, job._DBserver, job._collection,
+                        errorMsg);
+      }
+
+      if (batchId > 0) {
+        endBatch(client, job._DBserver, batchId);
+      }
+    } else {
+      if (_batchId > 0) {
+        extendBatch(client, "", _batchId);
+      }
 
+      res = dumpCollection(client, *job._file, job._collection, job._name,
+                           job._maxTick, errorMsg);
+    }
+  }
+
+  int closeRes = job._file->finishJob();
+
+  if (res == TRI_ERROR_NO_ERROR) {
+    res = closeRes;
+  }
+
+  if (res != TRI_ERROR_NO_ERROR && errorMsg.empty()) {
+    errorMsg = "cannot write to file '" + job._file->_fileName + "'";
+  }
+
+  return res;
+}
+
+/// @brief run the dump jobs, using up to --threads connections
+int DumpFeature::runJobs(std::vector<DumpJob> const& jobs,
+                         std::string& errorMsg) {
+  size_t const numThreads =
+      (std::min)(static_cast<size_t>(_threadCount), jobs.size());
+
+  if (numThreads <= 1) {
+    for (auto const& job : jobs) {
+      int res = runJob(_httpClient.get(), job, errorMsg);
+
+      if (res != TRI_ERROR_NO_ERROR) {
         return res;
       }
     }
+
+    return TRI_ERROR_NO_ERROR;
   }
 
-  return TRI_ERROR_NO_ERROR;
+  ClientFeature* client =
+      application_features::ApplicationServer::getFeature<ClientFeature>(
+          "Client");
+
+  // every thread uses a connection of its own
+  std::vector<std::unique_ptr<SimpleHttpClient>> httpClients;
+  httpClients.reserve(numThreads);
+
+  for (size_t i = 0; i < numThreads; ++i) {
+    auto httpClient = client->createHttpClient();
+    httpClient->setLocationRewriter(static_cast<void*>(client),
+                                    &rewriteLocation);
+    httpClient->setUserNamePassword("/", client->username(),
+                                    client->password());
+    httpClients.emplace_back(std::move(httpClient));
+  }
+
+  std::atomic<size_t> next(0);
+  std::atomic<int> result(TRI_ERROR_NO_ERROR);
+  Mutex errorLock;
+
+  auto work = [&](SimpleHttpClient* httpClient) {
+    while (result.load() == TRI_ERROR_NO_ERROR) {
+      size_t const i = next.fetch_add(1);
+
+      if (i >= jobs.size()) {
+        return;
+      }
+
+      std::string jobErrorMsg;
+      int res;
+
+      try {
+        res = runJob(httpClient, jobs[i], jobErrorMsg);
+      } catch (std::exception const& ex) {
+        res = TRI_ERROR_INTERNAL;
+        jobErrorMsg = std::string("caught exception ") + ex.what();
+      } catch (...) {
+        res = TRI_ERROR_INTERNAL;
+        jobErrorMsg = "caught unknown exception";
+      }
+
+      if (res != TRI_ERROR_NO_ERROR) {
+        // report the first error only
+        MUTEX_LOCKER(locker, errorLock);
+
+        if (result.load() == TRI_ERROR_NO_ERROR) {
+          errorMsg = jobErrorMsg;
+          result = res;
+        }
+      }
+    }
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(numThreads);
+
+  for (auto& httpClient : httpClients) {
+    threads.emplace_back(work, httpClient.get());
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  return result.load();
 }
 
 void DumpFeature::start() {
@@ -1061,7 +1288,7 @@ void DumpFeature::start() {
 
   try {
     if (!_clusterMode) {
-      res = startBatch("", errorMsg);
+      res = startBatch(_httpClient.get(), "", _batchId, errorMsg);
 
       if (res != TRI_ERROR_NO_ERROR && _force) {
         res = TRI_ERROR_NO_ERROR;
@@ -1072,7 +1299,7 @@ void DumpFeature::start() {
       }
 
       if (_batchId > 0) {
-        endBatch("");
+        endBatch(_httpClient.get(), "", _batchId);
       }
     } else {
       res = runClusterDump(errorMsg);
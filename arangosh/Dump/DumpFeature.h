@@ -28,6 +28,7 @@
 
 namespace arangodb {
 namespace httpclient {
+class SimpleHttpClient;
 class SimpleHttpResult;
 }
 
@@ -57,18 +58,32 @@ class DumpFeature final : public application_features::ApplicationFeature,
   uint64_t _tickStart;
   uint64_t _tickEnd;
   bool _compat28;
+  uint32_t _threadCount;
+  bool _compressOutput;
 
  private:
-  int startBatch(std::string DBserver, std::string& errorMsg);
-  void extendBatch(std::string DBserver);
-  void endBatch(std::string DBserver);
-  int dumpCollection(int fd, std::string const& cid, std::string const& name,
+  struct DataFile;
+  struct DumpJob;
+
+  int startBatch(httpclient::SimpleHttpClient* client,
+                 std::string const& DBserver, uint64_t& batchId,
+                 std::string& errorMsg);
+  void extendBatch(httpclient::SimpleHttpClient* client,
+                   std::string const& DBserver, uint64_t batchId);
+  void endBatch(httpclient::SimpleHttpClient* client,
+                std::string const& DBserver, uint64_t& batchId);
+  int dumpCollection(httpclient::SimpleHttpClient* client, DataFile& file,
+                     std::string const& cid, std::string const& name,
                      uint64_t maxTick, std::string& errorMsg);
   void flushWal();
   int runDump(std::string& dbName, std::string& errorMsg);
-  int dumpShard(int fd, std::string const& DBserver, std::string const& name,
+  int dumpShard(httpclient::SimpleHttpClient* client, DataFile& file,
+                std::string const& DBserver, std::string const& name,
                 std::string& errorMsg);
   int runClusterDump(std::string& errorMsg);
+  int runJob(httpclient::SimpleHttpClient* client, DumpJob const& job,
+             std::string& errorMsg);
+  int runJobs(std::vector<DumpJob> const& jobs, std::string& errorMsg);
 
  private:
   int* _result;
@@ -79,11 +94,11 @@ class DumpFeature final : public application_features::ApplicationFeature,
   // cluster mode flag
   bool _clusterMode;
 
-  // statistics
+  // statistics, updated concurrently by the dump threads
   struct {
-    uint64_t _totalBatches;
-    uint64_t _totalCollections;
-    uint64_t _totalWritten;
+    std::atomic<uint64_t> _totalBatches{0};
+    std::atomic<uint64_t> _totalCollections{0};
+    std::atomic<uint64_t> _totalWritten{0};
   } _stats;
 };
 }
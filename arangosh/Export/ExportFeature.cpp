@@ -24,6 +24,8 @@
 
 #include "ApplicationFeatures/ApplicationServer.h"
 #include "Basics/FileUtils.h"
+#include "Basics/Mutex.h"
+#include "Basics/MutexLocker.h"
 #include "Basics/StringUtils.h"
 #include "Logger/Logger.h"
 #include "ProgramOptions/ProgramOptions.h"
@@ -35,6 +37,9 @@
 #include <boost/algorithm/string.hpp>
 #include <boost/property_tree/detail/xml_parser_utils.hpp>
 #include <regex>
+#include <thread>
+
+#include "zlib.h"
 
 using namespace arangodb;
 using namespace arangodb::basics;
@@ -42,6 +47,88 @@ using namespace arangodb::httpclient;
 using namespace arangodb::options;
 using namespace boost::property_tree::xml_parser;
 
+/// @brief an output file, optionally gzip-compressed. write errors are
+/// reported as exceptions
+struct ExportFeature::OutputFile {
+  OutputFile(std::string const& fileName, bool compress)
+      : _fileName(fileName), _fd(-1), _gzFile(nullptr) {
+    // remove an existing file first
+    if (TRI_ExistsFile(_fileName.c_str())) {
+      TRI_UnlinkFile(_fileName.c_str());
+    }
+
+    _fd = TRI_CREATE(_fileName.c_str(),
+                     O_CREAT | O_EXCL | O_RDWR | TRI_O_CLOEXEC,
+                     S_IRUSR | S_IWUSR);
+
+    if (_fd >= 0 && compress) {
+      _gzFile = gzdopen(_fd, "wb");
+
+      if (_gzFile == nullptr) {
+        TRI_CLOSE(_fd);
+        _fd = -1;
+      }
+    }
+
+    if (_fd < 0) {
+      THROW_ARANGO_EXCEPTION_MESSAGE(
+          TRI_ERROR_CANNOT_WRITE_FILE,
+          "cannot write to file '" + _fileName + "'");
+    }
+  }
+
+  ~OutputFile() {
+    try {
+      close();
+    } catch (...) {
+    }
+  }
+
+  void write(char const* data, size_t length) {
+    bool ok;
+
+    if (_gzFile != nullptr) {
+      ok = length == 0 ||
+           gzwrite(_gzFile, data, static_cast<unsigned>(length)) ==
+               static_cast<int>(length);
+    } else {
+      ok = TRI_WritePointer(_fd, data, length);
+    }
+
+    if (!ok) {
+      THROW_ARANGO_EXCEPTION_MESSAGE(
+          TRI_ERROR_CANNOT_WRITE_FILE,
+          "cannot write to file '" + _fileName + "'");
+    }
+  }
+
+  void write(std::string const& data) { write(data.c_str(), data.size()); }
+
+  void close() {
+    bool ok = true;
+
+    if (_gzFile != nullptr) {
+      // this closes the file descriptor as well
+      ok = (gzclose(_gzFile) == Z_OK);
+    } else if (_fd >= 0) {
+      ok = (TRI_CLOSE(_fd) == 0);
+    }
+
+    _gzFile = nullptr;
+    _fd = -1;
+
+    if (!ok) {
+      THROW_ARANGO_EXCEPTION_MESSAGE(
+          TRI_ERROR_CANNOT_WRITE_FILE,
+          "cannot write to file '" + _fileName + "'");
+    }
+  }
+
+  std::string const _fileName;
+  int _fd;
+  gzFile _gzFile;
+};
+
 ExportFeature::ExportFeature(application_features::ApplicationServer* server,
                              int* result)
     : ApplicationFeature(server, "Export"),
@@ -55,11 +142,14 @@ ExportFeature::ExportFeature(application_features::ApplicationServer* server,
       _outputDirectory(),
       _overwrite(false),
       _progress(true),
-      _firstLine(true),
+      _threadCount(2),
+      _outputPartitions(false),
+      _compressOutput(false),
       _skippedDeepNested(0),
       _httpRequestsDone(0),
       _currentCollection(),
       _currentGraph(),
+      _writtenFiles(),
       _result(result) {
   requiresElevatedPrivileges(false);
   setOptional(false);
@@ -106,6 +196,20 @@ void ExportFeature::collectOptions(
   options->addOption(
       "--type", "type of export",
       new DiscreteValuesParameter<StringParameter>(&_typeExport, exports));
+
+  options->addOption("--threads",
+                     "number of partitions of a collection to export "
+                     "concurrently, each using a connection of its own",
+                     new UInt32Parameter(&_threadCount));
+
+  options->addOption("--output-partitions",
+                     "write one file per partition instead of combining the "
+                     "partitions into one file per collection",
+                     new BooleanParameter(&_outputPartitions));
+
+  options->addOption("--compress-output",
+                     "compress the output files using gzip",
+                     new BooleanParameter(&_compressOutput));
 }
 
 void ExportFeature::validateOptions(
@@ -158,6 +262,10 @@ void ExportFeature::validateOptions(
 
     boost::split(_csvFields, _csvFieldOptions, boost::is_any_of(","));
   }
+
+  if (_threadCount < 1) {
+    _threadCount = 1;
+  }
 }
 
 void ExportFeature::prepare() {
@@ -255,21 +363,12 @@ void ExportFeature::start() {
       _typeExport == "csv") {
     if (_collections.size()) {
       collectionExport(httpClient.get());
-
-      for (auto const& collection : _collections) {
-        std::string filePath = _outputDirectory + TRI_DIR_SEPARATOR_STR +
-                               collection + "." + _typeExport;
-        int64_t fileSize = TRI_SizeFile(filePath.c_str());
-
-        if (0 < fileSize) {
-          exportedSize += fileSize;
-        }
-      }
     }
   } else if (_typeExport == "xgmml" && _graphName.size()) {
     graphExport(httpClient.get());
-    std::string filePath = _outputDirectory + TRI_DIR_SEPARATOR_STR +
-                           _graphName + "." + _typeExport;
+  }
+
+  for (auto const& filePath : _writtenFiles) {
     int64_t fileSize = TRI_SizeFile(filePath.c_str());
 
     if (0 < fileSize) {
@@ -278,14 +377,30 @@ void ExportFeature::start() {
   }
 
   std::cout << "Processed " << _collections.size() << " collection(s), wrote "
-            << exportedSize << " byte(s), " << _httpRequestsDone
+            << exportedSize << " byte(s), " << _httpRequestsDone.load()
             << " HTTP request(s)" << std::endl;
 
   *_result = ret;
 }
 
 void ExportFeature::collectionExport(SimpleHttpClient* httpClient) {
-  std::string errorMsg;
+  // every partition is exported using a connection of its own
+  std::vector<std::unique_ptr<SimpleHttpClient>> httpClients;
+
+  if (_threadCount > 1) {
+    ClientFeature* client =
+        application_features::ApplicationServer::getFeature<ClientFeature>(
+            "Client");
+
+    for (uint32_t i = 0; i < _threadCount; ++i) {
+      auto partitionClient = client->createHttpClient();
+      partitionClient->setLocationRewriter(static_cast<void*>(client),
+                                           &rewriteLocation);
+      partitionClient->setUserNamePassword("/", client->username(),
+                                           client->password());
+      httpClients.emplace_back(std::move(partitionClient));
+    }
+  }
 
   for (auto const& collection : _collections) {
     if (_progress) {
@@ -295,90 +410,265 @@ void ExportFeature::collectionExport(SimpleHttpClient* httpClient) {
 
     _currentCollection = collection;
 
-    std::string fileName = _outputDirectory + TRI_DIR_SEPARATOR_STR +
-                           collection + "." + _typeExport;
+    if (!httpClients.empty()) {
+      partitionedExport(httpClients, collection);
+      continue;
+    }
+
+    std::string const fileName = outputFileName(collection, "");
+    OutputFile file(fileName, _compressOutput);
+    bool firstLine = true;
 
-    // remove an existing file first
-    if (TRI_ExistsFile(fileName.c_str())) {
-      TRI_UnlinkFile(fileName.c_str());
+    writeCollectionHeader(file, collection);
+    exportPartition(httpClient, collection, 0, 1, file, firstLine);
+    writeCollectionFooter(file);
+    file.close();
+
+    _writtenFiles.emplace_back(fileName);
+  }
+}
+
+/// @brief export a collection in --threads partitions concurrently. the
+/// documents are assigned to the partitions by the hash of their keys.
+/// unless --output-partitions is set, the partitions are first written
+/// to temporary files, which are then combined in partition order
+void ExportFeature::partitionedExport(
+    std::vector<std::unique_ptr<SimpleHttpClient>>& httpClients,
+    std::string const& collection) {
+  size_t const partitions = httpClients.size();
+  std::vector<std::string> fileNames;
+
+  for (size_t i = 0; i < partitions; ++i) {
+    std::string const partition = StringUtils::itoa(i);
+
+    if (_outputPartitions) {
+      fileNames.emplace_back(outputFileName(collection, partition));
+    } else {
+      fileNames.emplace_back(_outputDirectory + TRI_DIR_SEPARATOR_STR +
+                             collection + "." + _typeExport + ".part" +
+                             partition);
     }
+  }
 
-    std::string const url = "_api/cursor";
+  Mutex errorLock;
+  std::string errorMsg;
+  int result = TRI_ERROR_NO_ERROR;
 
-    VPackBuilder post;
-    post.openObject();
-    post.add("query", VPackValue("FOR doc IN @@collection RETURN doc"));
-    post.add("bindVars", VPackValue(VPackValueType::Object));
-    post.add("@collection", VPackValue(collection));
-    post.close();
-    post.close();
+  auto work = [&](size_t partition) {
+    try {
+      // temporary files are combined later, so only compress final output
+      OutputFile file(fileNames[partition],
+                      _compressOutput && _outputPartitions);
+      bool firstLine = true;
 
-    std::shared_ptr<VPackBuilder> parsedBody =
-        httpCall(httpClient, url, rest::RequestType::POST, post.toJson());
-    VPackSlice body = parsedBody->slice();
+      if (_outputPartitions) {
+        writeCollectionHeader(file, collection);
+      }
+      exportPartition(httpClients[partition].get(), collection, partition,
+                      partitions, file, firstLine);
+      if (_outputPartitions) {
+        writeCollectionFooter(file);
+      }
+      file.close();
+    } catch (basics::Exception const& ex) {
+      MUTEX_LOCKER(locker, errorLock);
+      if (result == TRI_ERROR_NO_ERROR) {
+        result = ex.code();
+        errorMsg = ex.what();
+      }
+    } catch (std::exception const& ex) {
+      MUTEX_LOCKER(locker, errorLock);
+      if (result == TRI_ERROR_NO_ERROR) {
+        result = TRI_ERROR_INTERNAL;
+        errorMsg = ex.what();
+      }
+    } catch (...) {
+      MUTEX_LOCKER(locker, errorLock);
+      if (result == TRI_ERROR_NO_ERROR) {
+        result = TRI_ERROR_INTERNAL;
+        errorMsg = "caught unknown exception";
+      }
+    }
+  };
 
-    int fd =
-        TRI_CREATE(fileName.c_str(), O_CREAT | O_EXCL | O_RDWR | TRI_O_CLOEXEC,
-                   S_IRUSR | S_IWUSR);
+  std::vector<std::thread> threads;
+  threads.reserve(partitions);
+
+  for (size_t i = 0; i < partitions; ++i) {
+    threads.emplace_back(work, i);
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  if (result != TRI_ERROR_NO_ERROR) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(result, errorMsg);
+  }
+
+  if (_outputPartitions) {
+    _writtenFiles.insert(_writtenFiles.end(), fileNames.begin(),
+                         fileNames.end());
+    return;
+  }
+
+  std::string const fileName = outputFileName(collection, "");
+  OutputFile file(fileName, _compressOutput);
+  bool wroteDocuments = false;
+
+  writeCollectionHeader(file, collection);
+
+  for (auto const& partFile : fileNames) {
+    int fd = TRI_OPEN(partFile.c_str(), O_RDONLY | TRI_O_CLOEXEC);
 
     if (fd < 0) {
-      errorMsg = "cannot write to file '" + fileName + "'";
-      THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_CANNOT_WRITE_FILE, errorMsg);
+      THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL,
+                                     "cannot read file '" + partFile + "'");
     }
 
     TRI_DEFER(TRI_CLOSE(fd));
 
-    _firstLine = true;
-    if (_typeExport == "json") {
-      std::string openingBracket = "[";
-      writeToFile(fd, openingBracket, fileName);
-
-    } else if (_typeExport == "xml") {
-      std::string xmlHeader =
-          "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>\n"
-          "<collection name=\"";
-      xmlHeader.append(encode_char_entities(collection));
-      xmlHeader.append("\">\n");
-      writeToFile(fd, xmlHeader, fileName);
-
-    } else if (_typeExport == "csv") {
-      std::string firstLine = "";
-      bool isFirstValue = true;
-      for (auto const& str : _csvFields) {
-        if (isFirstValue) {
-          firstLine += str;
-          isFirstValue = false;
-        } else {
-          firstLine += "," + str;
-        }
+    char buffer[65536];
+    bool first = true;
+
+    while (true) {
+      ssize_t numRead = TRI_READ(fd, buffer, sizeof(buffer));
+
+      if (numRead < 0) {
+        THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL,
+                                       "cannot read file '" + partFile + "'");
       }
-      firstLine += "\n";
-      writeToFile(fd, firstLine, fileName);
-    }
 
-    writeCollectionBatch(fd, VPackArrayIterator(body.get("result")), fileName);
+      if (numRead == 0) {
+        break;
+      }
 
-    while (body.hasKey("id")) {
-      std::string const url = "/_api/cursor/" + body.get("id").copyString();
-      parsedBody = httpCall(httpClient, url, rest::RequestType::PUT);
-      body = parsedBody->slice();
+      // every partition starts its JSON array elements without a
+      // separator, so add one between partitions
+      if (first && wroteDocuments && _typeExport == "json") {
+        file.write(",", 1);
+      }
 
-      writeCollectionBatch(fd, VPackArrayIterator(body.get("result")),
-                           fileName);
+      file.write(buffer, static_cast<size_t>(numRead));
+      first = false;
+      wroteDocuments = true;
     }
+  }
+
+  writeCollectionFooter(file);
+  file.close();
+
+  for (auto const& partFile : fileNames) {
+    TRI_UnlinkFile(partFile.c_str());
+  }
+
+  _writtenFiles.emplace_back(fileName);
+}
+
+/// @brief export the documents of one partition of a collection
+void ExportFeature::exportPartition(SimpleHttpClient* httpClient,
+                                    std::string const& collection,
+                                    size_t partition, size_t partitions,
+                                    OutputFile& file, bool& firstLine) {
+  std::string const url = "_api/cursor";
+
+  VPackBuilder post;
+  post.openObject();
+  if (partitions > 1) {
+    post.add("query",
+             VPackValue("FOR doc IN @@collection FILTER HASH(doc._key) % "
+                        "@partitions == @partition RETURN doc"));
+  } else {
+    post.add("query", VPackValue("FOR doc IN @@collection RETURN doc"));
+  }
+  post.add("bindVars", VPackValue(VPackValueType::Object));
+  post.add("@collection", VPackValue(collection));
+  if (partitions > 1) {
+    post.add("partitions", VPackValue(partitions));
+    post.add("partition", VPackValue(partition));
+  }
+  post.close();
+  post.close();
 
-    if (_typeExport == "json") {
-      std::string closingBracket = "\n]";
-      writeToFile(fd, closingBracket, fileName);
-    } else if (_typeExport == "xml") {
-      std::string xmlFooter = "</collection>";
-      writeToFile(fd, xmlFooter, fileName);
+  std::shared_ptr<VPackBuilder> parsedBody =
+      httpCall(httpClient, url, rest::RequestType::POST, post.toJson());
+  VPackSlice body = parsedBody->slice();
+
+  writeCollectionBatch(file, VPackArrayIterator(body.get("result")),
+                       firstLine);
+
+  while (body.hasKey("id")) {
+    std::string const url = "/_api/cursor/" + body.get("id").copyString();
+    parsedBody = httpCall(httpClient, url, rest::RequestType::PUT);
+    body = parsedBody->slice();
+
+    writeCollectionBatch(file, VPackArrayIterator(body.get("result")),
+                         firstLine);
+  }
+}
+
+void ExportFeature::writeCollectionHeader(OutputFile& file,
+                                          std::string const& collection) {
+  if (_typeExport == "json") {
+    std::string openingBracket = "[";
+    file.write(openingBracket);
+
+  } else if (_typeExport == "xml") {
+    std::string xmlHeader =
+        "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>\n"
+        "<collection name=\"";
+    xmlHeader.append(encode_char_entities(collection));
+    xmlHeader.append("\">\n");
+    file.write(xmlHeader);
+
+  } else if (_typeExport == "csv") {
+    std::string firstLine = "";
+    bool isFirstValue = true;
+    for (auto const& str : _csvFields) {
+      if (isFirstValue) {
+        firstLine += str;
+        isFirstValue = false;
+      } else {
+        firstLine += "," + str;
+      }
     }
+    firstLine += "\n";
+    file.write(firstLine);
+  }
+}
+
+void ExportFeature::writeCollectionFooter(OutputFile& file) {
+  if (_typeExport == "json") {
+    std::string closingBracket = "\n]";
+    file.write(closingBracket);
+  } else if (_typeExport == "xml") {
+    std::string xmlFooter = "</collection>";
+    file.write(xmlFooter);
+  }
+}
+
+/// @brief the name of an output file. partition is empty for the file
+/// containing a complete collection or graph
+std::string ExportFeature::outputFileName(std::string const& name,
+                                          std::string const& partition) const {
+  std::string fileName = _outputDirectory + TRI_DIR_SEPARATOR_STR + name;
+
+  if (!partition.empty()) {
+    fileName += "." + partition;
   }
+
+  fileName += "." + _typeExport;
+
+  if (_compressOutput) {
+    fileName += ".gz";
+  }
+
+  return fileName;
 }
 
-void ExportFeature::writeCollectionBatch(int fd, VPackArrayIterator it,
-                                         std::string const& fileName) {
+void ExportFeature::writeCollectionBatch(OutputFile& file,
+                                         VPackArrayIterator it,
+                                         bool& firstLine) {
   std::string line;
   line.reserve(1024);
 
@@ -387,19 +677,19 @@ void ExportFeature::writeCollectionBatch(int fd, VPackArrayIterator it,
       line.clear();
       line += doc.toJson();
       line.push_back('\n');
-      writeToFile(fd, line, fileName);
+      file.write(line);
     }
   } else if (_typeExport == "json") {
     for (auto const& doc : it) {
       line.clear();
-      if (!_firstLine) {
+      if (!firstLine) {
         line.append(",\n  ", 4);
       } else {
         line.append("\n  ", 3);
-        _firstLine = false;
+        firstLine = false;
       }
       line += doc.toJson();
-      writeToFile(fd, line, fileName);
+      file.write(line);
     }
   } else if (_typeExport == "csv") {
     for (auto const& doc : it) {
@@ -439,7 +729,7 @@ void ExportFeature::writeCollectionBatch(int fd, VPackArrayIterator it,
         line.append(value);
       }
       line.append("\n");
-      writeToFile(fd, line, fileName);
+      file.write(line);
     }
   } else if (_typeExport == "xml") {
     for (auto const& doc : it) {
@@ -447,25 +737,17 @@ void ExportFeature::writeCollectionBatch(int fd, VPackArrayIterator it,
       line.append("<doc key=\"");
       line.append(encode_char_entities(doc.get("_key").copyString()));
       line.append("\">\n");
-      writeToFile(fd, line, fileName);
+      file.write(line);
       for (auto const& att : VPackObjectIterator(doc)) {
-        xgmmlWriteOneAtt(fd, fileName, att.value, att.key.copyString(), 2);
+        xgmmlWriteOneAtt(file, att.value, att.key.copyString(), 2);
       }
       line.clear();
       line.append("</doc>\n");
-      writeToFile(fd, line, fileName);
+      file.write(line);
     }
   }
 }
 
-void ExportFeature::writeToFile(int fd, std::string const& line,
-                                std::string const& fileName) {
-  if (!TRI_WritePointer(fd, line.c_str(), line.size())) {
-    std::string errorMsg = "cannot write to file '" + fileName + "'";
-    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_CANNOT_WRITE_FILE, errorMsg);
-  }
-}
-
 std::shared_ptr<VPackBuilder> ExportFeature::httpCall(
     SimpleHttpClient* httpClient, std::string const& url,
     rest::RequestType requestType, std::string postBody) {
@@ -522,8 +804,6 @@ std::shared_ptr<VPackBuilder> ExportFeature::httpCall(
 }
 
 void ExportFeature::graphExport(SimpleHttpClient* httpClient) {
-  std::string errorMsg;
-
   _currentGraph = _graphName;
 
   if (_collections.empty()) {
@@ -562,35 +842,20 @@ void ExportFeature::graphExport(SimpleHttpClient* httpClient) {
     }
   }
 
-  std::string fileName =
-      _outputDirectory + TRI_DIR_SEPARATOR_STR + _graphName + "." + _typeExport;
-
-  // remove an existing file first
-  if (TRI_ExistsFile(fileName.c_str())) {
-    TRI_UnlinkFile(fileName.c_str());
-  }
-
-  int fd =
-      TRI_CREATE(fileName.c_str(), O_CREAT | O_EXCL | O_RDWR | TRI_O_CLOEXEC,
-                 S_IRUSR | S_IWUSR);
-
-  if (fd < 0) {
-    errorMsg = "cannot write to file '" + fileName + "'";
-    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_CANNOT_WRITE_FILE, errorMsg);
-  }
-  TRI_DEFER(TRI_CLOSE(fd));
+  std::string const fileName = outputFileName(_graphName, "");
+  OutputFile file(fileName, _compressOutput);
 
   std::string xmlHeader =
       R"(<?xml version="1.0" encoding="UTF-8" standalone="yes"?>
 <graph label=")";
-  writeToFile(fd, xmlHeader, fileName);
-  writeToFile(fd, _graphName, fileName);
+  file.write(xmlHeader);
+  file.write(_graphName);
 
   xmlHeader = R"(" 
 xmlns="http://www.cs.rpi.edu/XGMML" 
 directed="1">
 )";
-  writeToFile(fd, xmlHeader, fileName);
+  file.write(xmlHeader);
 
   for (auto const& collection : _collections) {
     if (_progress) {
@@ -612,27 +877,29 @@ directed="1">
         httpCall(httpClient, url, rest::RequestType::POST, post.toJson());
     VPackSlice body = parsedBody->slice();
 
-    writeGraphBatch(fd, VPackArrayIterator(body.get("result")), fileName);
+    writeGraphBatch(file, VPackArrayIterator(body.get("result")));
 
     while (body.hasKey("id")) {
       std::string const url = "/_api/cursor/" + body.get("id").copyString();
       parsedBody = httpCall(httpClient, url, rest::RequestType::PUT);
       body = parsedBody->slice();
 
-      writeGraphBatch(fd, VPackArrayIterator(body.get("result")), fileName);
+      writeGraphBatch(file, VPackArrayIterator(body.get("result")));
     }
   }
   std::string closingGraphTag = "</graph>\n";
-  writeToFile(fd, closingGraphTag, fileName);
+  file.write(closingGraphTag);
+  file.close();
+
+  _writtenFiles.emplace_back(fileName);
 
-  if (_skippedDeepNested) {
-    std::cout << "skipped " << _skippedDeepNested
+  if (_skippedDeepNested > 0) {
+    std::cout << "skipped " << _skippedDeepNested.load()
               << " deep nested objects / arrays" << std::endl;
   }
 }
 
-void ExportFeature::writeGraphBatch(int fd, VPackArrayIterator it,
-                                    std::string const& fileName) {
+void ExportFeature::writeGraphBatch(OutputFile& file, VPackArrayIterator it) {
   std::string xmlTag;
 
   for (auto const& doc : it) {
@@ -646,21 +913,21 @@ void ExportFeature::writeGraphBatch(int fd, VPackArrayIterator it,
           "\" source=\"" + encode_char_entities(doc.get("_from").copyString()) +
           "\" target=\"" + encode_char_entities(doc.get("_to").copyString()) +
           "\"";
-      writeToFile(fd, xmlTag, fileName);
+      file.write(xmlTag);
       if (!_xgmmlLabelOnly) {
         xmlTag = ">\n";
-        writeToFile(fd, xmlTag, fileName);
+        file.write(xmlTag);
 
         for (auto const& it : VPackObjectIterator(doc)) {
-          xgmmlWriteOneAtt(fd, fileName, it.value, it.key.copyString());
+          xgmmlWriteOneAtt(file, it.value, it.key.copyString());
         }
 
         xmlTag = "</edge>\n";
-        writeToFile(fd, xmlTag, fileName);
+        file.write(xmlTag);
 
       } else {
         xmlTag = " />\n";
-        writeToFile(fd, xmlTag, fileName);
+        file.write(xmlTag);
       }
 
     } else {
@@ -671,27 +938,27 @@ void ExportFeature::writeGraphBatch(int fd, VPackArrayIterator it,
                                    ? doc.get(_xgmmlLabelAttribute).copyString()
                                    : "Default-Label") +
           "\" id=\"" + encode_char_entities(doc.get("_id").copyString()) + "\"";
-      writeToFile(fd, xmlTag, fileName);
+      file.write(xmlTag);
       if (!_xgmmlLabelOnly) {
         xmlTag = ">\n";
-        writeToFile(fd, xmlTag, fileName);
+        file.write(xmlTag);
 
         for (auto const& it : VPackObjectIterator(doc)) {
-          xgmmlWriteOneAtt(fd, fileName, it.value, it.key.copyString());
+          xgmmlWriteOneAtt(file, it.value, it.key.copyString());
         }
 
         xmlTag = "</node>\n";
-        writeToFile(fd, xmlTag, fileName);
+        file.write(xmlTag);
 
       } else {
         xmlTag = " />\n";
-        writeToFile(fd, xmlTag, fileName);
+        file.write(xmlTag);
       }
     }
   }
 }
 
-void ExportFeature::xgmmlWriteOneAtt(int fd, std::string const& fileName,
+void ExportFeature::xgmmlWriteOneAtt(OutputFile& file,
                                      VPackSlice const& slice,
                                      std::string const& name, int deep) {
   std::string value, type, xmlTag;
@@ -719,10 +986,9 @@ void ExportFeature::xgmmlWriteOneAtt(int fd, std::string const& fileName,
 
   } else if (slice.isArray() || slice.isObject()) {
     if (0 < deep) {
-      if (_skippedDeepNested == 0) {
+      if (_skippedDeepNested.fetch_add(1) == 0) {
         std::cout << "Warning: skip deep nested objects / arrays" << std::endl;
       }
-      _skippedDeepNested++;
       return;
     }
 
@@ -730,37 +996,37 @@ void ExportFeature::xgmmlWriteOneAtt(int fd, std::string const& fileName,
     xmlTag = "  <att name=\"" + encode_char_entities(name) +
              "\" type=\"string\" value=\"" +
              encode_char_entities(slice.toString()) + "\"/>\n";
-    writeToFile(fd, xmlTag, fileName);
+    file.write(xmlTag);
     return;
   }
 
   if (!type.empty()) {
     xmlTag = "  <att name=\"" + encode_char_entities(name) + "\" type=\"" +
              type + "\" value=\"" + encode_char_entities(value) + "\"/>\n";
-    writeToFile(fd, xmlTag, fileName);
+    file.write(xmlTag);
 
   } else if (slice.isArray()) {
     xmlTag =
         "  <att name=\"" + encode_char_entities(name) + "\" type=\"list\">\n";
-    writeToFile(fd, xmlTag, fileName);
+    file.write(xmlTag);
 
     for (auto const& val : VPackArrayIterator(slice)) {
-      xgmmlWriteOneAtt(fd, fileName, val, name, deep + 1);
+      xgmmlWriteOneAtt(file, val, name, deep + 1);
     }
 
     xmlTag = "  </att>\n";
-    writeToFile(fd, xmlTag, fileName);
+    file.write(xmlTag);
 
   } else if (slice.isObject()) {
     xmlTag =
         "  <att name=\"" + encode_char_entities(name) + "\" type=\"list\">\n";
-    writeToFile(fd, xmlTag, fileName);
+    file.write(xmlTag);
 
     for (auto const& it : VPackObjectIterator(slice)) {
-      xgmmlWriteOneAtt(fd, fileName, it.value, it.key.copyString(), deep + 1);
+      xgmmlWriteOneAtt(file, it.value, it.key.copyString(), deep + 1);
     }
 
     xmlTag = "  </att>\n";
-    writeToFile(fd, xmlTag, fileName);
+    file.write(xmlTag);
   }
 }
@@ -50,13 +50,24 @@ class ExportFeature final : public application_features::ApplicationFeature,
   void start() override final;
 
  private:
+  struct OutputFile;
+
   void collectionExport(httpclient::SimpleHttpClient* httpClient);
-  void writeCollectionBatch(int fd, VPackArrayIterator it, std::string const& fileName);
+  void partitionedExport(
+      std::vector<std::unique_ptr<httpclient::SimpleHttpClient>>& httpClients,
+      std::string const& collection);
+  void exportPartition(httpclient::SimpleHttpClient* httpClient,
+                       std::string const& collection, size_t partition,
+                       size_t partitions, OutputFile& file, bool& firstLine);
+  void writeCollectionHeader(OutputFile& file, std::string const& collection);
+  void writeCollectionFooter(OutputFile& file);
+  void writeCollectionBatch(OutputFile& file, VPackArrayIterator it, bool& firstLine);
   void graphExport(httpclient::SimpleHttpClient* httpClient);
-  void writeGraphBatch(int fd, VPackArrayIterator it, std::string const& fileName);
-  void xgmmlWriteOneAtt(int fd, std::string const& fileName, VPackSlice const& slice, std::string const& name, int deep = 0);
+  void writeGraphBatch(OutputFile& file, VPackArrayIterator it);
+  void xgmmlWriteOneAtt(OutputFile& file, VPackSlice const& slice, std::string const& name, int deep = 0);
 
-  void writeToFile(int fd, std::string const& string, std::string const& fileName);
+  std::string outputFileName(std::string const& name,
+                             std::string const& partition) const;
   std::shared_ptr<VPackBuilder> httpCall(httpclient::SimpleHttpClient* httpClient, std::string const& url, arangodb::rest::RequestType, std::string postBody = "");
 
  private:
@@ -71,13 +82,18 @@ class ExportFeature final : public application_features::ApplicationFeature,
   std::string _outputDirectory;
   bool _overwrite;
   bool _progress;
+  uint32_t _threadCount;
+  bool _outputPartitions;
+  bool _compressOutput;
 
-  bool _firstLine;
-  uint64_t _skippedDeepNested;
-  uint64_t _httpRequestsDone;
+  std::atomic<uint64_t> _skippedDeepNested;
+  std::atomic<uint64_t> _httpRequestsDone;
   std::string _currentCollection;
   std::string _currentGraph;
 
+  /// @brief the files written, for the summary
+  std::vector<std::string> _writtenFiles;
+
   int* _result;
 };
 }
@@ -58,6 +58,7 @@ ImportFeature::ImportFeature(application_features::ApplicationServer* server,
       _progress(true),
       _onDuplicateAction("error"),
       _rowsToSkip(0),
+      _threadCount(2),
       _result(result) {
   requiresElevatedPrivileges(false);
   setOptional(false);
@@ -147,6 +148,10 @@ void ImportFeature::collectOptions(
       "violation occurs. Possible values: " +
           actionsJoined,
       new DiscreteValuesParameter<StringParameter>(&_onDuplicateAction, actions));
+
+  options->addOption("--threads",
+                     "number of connections used to send batches concurrently",
+                     new UInt32Parameter(&_threadCount));
 }
 
 void ImportFeature::validateOptions(
@@ -176,6 +181,10 @@ void ImportFeature::validateOptions(
     _chunkSize = MaxBatchSize;
   }
 
+  if (_threadCount < 1) {
+    _threadCount = 1;
+  }
+
   for (auto const& it : _translations) {
     auto parts = StringUtils::split(it, "=");
     if (parts.size() != 2) {
@@ -269,10 +278,32 @@ void ImportFeature::start() {
 
   std::cout << "connect timeout:        " << client->connectionTimeout() << std::endl;
   std::cout << "request timeout:        " << client->requestTimeout() << std::endl;
+  std::cout << "threads:                " << _threadCount << std::endl;
   std::cout << "----------------------------------------" << std::endl;
 
   arangodb::import::ImportHelper ih(httpClient.get(), _chunkSize);
 
+  if (_threadCount > 1) {
+    // additional connections for sending batches concurrently
+    std::vector<std::unique_ptr<SimpleHttpClient>> senderClients;
+
+    try {
+      for (uint32_t i = 0; i < _threadCount; ++i) {
+        auto senderClient = client->createHttpClient();
+        senderClient->setLocationRewriter(static_cast<void*>(client),
+                                          &rewriteLocation);
+        senderClient->setUserNamePassword("/", client->username(),
+                                          client->password());
+        senderClients.emplace_back(std::move(senderClient));
+      }
+    } catch (...) {
+      LOG_TOPIC(FATAL, arangodb::Logger::FIXME) << "cannot create server connection, giving up!";
+      FATAL_ERROR_EXIT();
+    }
+
+    ih.setSenderClients(std::move(senderClients));
+  }
+
   // create colletion
   if (_createCollection) {
     ih.setCreateCollection(true);
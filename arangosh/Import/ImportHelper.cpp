@@ -24,6 +24,8 @@
 
 #include "ImportHelper.h"
 
+#include "Basics/ConditionLocker.h"
+#include "Basics/MutexLocker.h"
 #include "Basics/StringUtils.h"
 #include "Basics/files.h"
 #include "Logger/Logger.h"
@@ -160,12 +162,20 @@ ImportHelper::ImportHelper(httpclient::SimpleHttpClient* client,
       _onDuplicateAction("error"),
       _collectionName(),
       _lineBuffer(TRI_UNKNOWN_MEM_ZONE),
-      _outputBuffer(TRI_UNKNOWN_MEM_ZONE) {
-  _hasError = false;
+      _outputBuffer(TRI_UNKNOWN_MEM_ZONE),
+      _hasError(false),
+      _stopSenders(false),
+      _nextSequence(0),
+      _errorSequence(0) {}
+
+ImportHelper::~ImportHelper() { finishSenders(); }
+
+void ImportHelper::setSenderClients(
+    std::vector<std::unique_ptr<httpclient::SimpleHttpClient>>&& clients) {
+  TRI_ASSERT(_senderThreads.empty());
+  _senderClients = std::move(clients);
 }
 
-ImportHelper::~ImportHelper() {}
-
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief imports a delimited file
 ////////////////////////////////////////////////////////////////////////////////
@@ -268,6 +278,8 @@ bool ImportHelper::importDelimited(std::string const& collectionName,
     sendCsvBuffer();
   }
 
+  finishSenders();
+
   TRI_DestroyCsvParser(&parser);
   TRI_Free(TRI_UNKNOWN_MEM_ZONE, separator);
 
@@ -395,6 +407,8 @@ bool ImportHelper::importJson(std::string const& collectionName,
     sendJsonBuffer(_outputBuffer.c_str(), _outputBuffer.length(), isObject);
   }
 
+  finishSenders();
+
   if (fd != STDIN_FILENO) {
     TRI_CLOSE(fd);
   }
@@ -693,7 +707,6 @@ void ImportHelper::sendCsvBuffer() {
     return;
   }
 
-  std::unordered_map<std::string, std::string> headerFields;
   std::string url("/_api/import?" + getCollectionUrlPart() + "&line=" +
                   StringUtils::itoa(_rowOffset) + "&details=true&onDuplicate=" +
                   StringUtils::urlEncode(_onDuplicateAction));
@@ -708,13 +721,7 @@ void ImportHelper::sendCsvBuffer() {
     url += "&overwrite=true";
   }
 
-  _firstChunk = false;
-
-  std::unique_ptr<SimpleHttpResult> result(_client->request(
-      rest::RequestType::POST, url, _outputBuffer.c_str(),
-      _outputBuffer.length(), headerFields));
-
-  handleResult(result.get());
+  sendBatch(url, _outputBuffer.c_str(), _outputBuffer.length());
 
   _outputBuffer.reset();
   _rowOffset = _rowsRead;
@@ -748,21 +755,130 @@ void ImportHelper::sendJsonBuffer(char const* str, size_t len, bool isObject) {
   if (_firstChunk && _overwrite) {
     url += "&overwrite=true";
   }
-  
-  _firstChunk = false;
 
-  std::unordered_map<std::string, std::string> headerFields;
-  std::unique_ptr<SimpleHttpResult> result(_client->request(
-      rest::RequestType::POST, url, str, len, headerFields));
+  sendBatch(url, str, len);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief send a batch, either directly or via a sender thread
+////////////////////////////////////////////////////////////////////////////////
+
+void ImportHelper::sendBatch(std::string const& url, char const* data,
+                             size_t length) {
+  uint64_t const sequence = _nextSequence++;
+
+  if (_firstChunk || _senderClients.empty()) {
+    _firstChunk = false;
+
+    std::unordered_map<std::string, std::string> headerFields;
+    std::unique_ptr<SimpleHttpResult> result(_client->request(
+        rest::RequestType::POST, url, data, length, headerFields));
+
+    handleResult(result.get(), sequence);
+    return;
+  }
+
+  CONDITION_LOCKER(guard, _queueCondition);
+
+  if (_senderThreads.empty()) {
+    _stopSenders = false;
+
+    for (auto& client : _senderClients) {
+      _senderThreads.emplace_back(&ImportHelper::senderLoop, this,
+                                  client.get());
+    }
+  }
+
+  // wait until a sender thread has picked up a queued batch
+  while (_queue.size() >= _senderThreads.size()) {
+    guard.wait();
+  }
+
+  _queue.emplace_back(Batch{sequence, url, std::string(data, length)});
+  guard.broadcast();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the main loop of a sender thread
+////////////////////////////////////////////////////////////////////////////////
+
+void ImportHelper::senderLoop(SimpleHttpClient* client) {
+  while (true) {
+    Batch batch;
 
-  handleResult(result.get());
+    {
+      CONDITION_LOCKER(guard, _queueCondition);
+
+      while (_queue.empty() && !_stopSenders) {
+        guard.wait();
+      }
+
+      if (_queue.empty()) {
+        // no more batches will come
+        return;
+      }
+
+      batch = std::move(_queue.front());
+      _queue.pop_front();
+      // make room for the reader
+      guard.broadcast();
+    }
+
+    if (_hasError) {
+      // drop the batch
+      continue;
+    }
+
+    try {
+      std::unordered_map<std::string, std::string> headerFields;
+      std::unique_ptr<SimpleHttpResult> result(client->request(
+          rest::RequestType::POST, batch._url, batch._data.c_str(),
+          batch._data.size(), headerFields));
+
+      handleResult(result.get(), batch._sequence);
+    } catch (...) {
+      MUTEX_LOCKER(locker, _resultLock);
+
+      if (!_hasError || batch._sequence < _errorSequence) {
+        _errorSequence = batch._sequence;
+        _errorMessage = "caught exception while sending batch";
+      }
+
+      _hasError = true;
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief wait until all queued batches have been sent
+////////////////////////////////////////////////////////////////////////////////
+
+void ImportHelper::finishSenders() {
+  {
+    CONDITION_LOCKER(guard, _queueCondition);
+
+    if (_senderThreads.empty()) {
+      return;
+    }
+
+    _stopSenders = true;
+    guard.broadcast();
+  }
+
+  for (auto& thread : _senderThreads) {
+    thread.join();
+  }
+
+  _senderThreads.clear();
 }
 
-void ImportHelper::handleResult(SimpleHttpResult* result) {
+void ImportHelper::handleResult(SimpleHttpResult* result, uint64_t sequence) {
   if (result == nullptr) {
     return;
   }
 
+  MUTEX_LOCKER(locker, _resultLock);
+
   std::shared_ptr<VPackBuilder> parsedBody;
   try {
     parsedBody = result->getBodyVelocyPack();
@@ -786,13 +902,18 @@ void ImportHelper::handleResult(SimpleHttpResult* result) {
   // get the "error" flag. This returns a pointer, not a copy
   if (arangodb::basics::VelocyPackHelper::getBooleanValue(body, "error",
                                                           false)) {
-    _hasError = true;
-
-    // get the error message
-    VPackSlice const errorMessage = body.get("errorMessage");
-    if (errorMessage.isString()) {
-      _errorMessage = errorMessage.copyString();
+    // report the error of the earliest failed batch
+    if (!_hasError || sequence < _errorSequence) {
+      _errorSequence = sequence;
+
+      // get the error message
+      VPackSlice const errorMessage = body.get("errorMessage");
+      if (errorMessage.isString()) {
+        _errorMessage = errorMessage.copyString();
+      }
     }
+
+    _hasError = true;
   }
 
   // look up the "created" flag
@@ -28,8 +28,12 @@
 #include "Basics/Common.h"
 
 #include "Basics/csv.h"
+#include "Basics/ConditionVariable.h"
+#include "Basics/Mutex.h"
 #include "Basics/StringBuffer.h"
 
+#include <thread>
+
 #ifdef _WIN32
 #include "Basics/win-utils.h"
 #endif
@@ -174,6 +178,16 @@ class ImportHelper {
 
   void setProgress(bool value) { _progress = value; }
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief upload batches concurrently, using one sender thread per
+  /// connection. the reading thread keeps splitting the input while the
+  /// batches are in flight. the first batch is always sent over the main
+  /// connection, because it may create or truncate the collection
+  //////////////////////////////////////////////////////////////////////////////
+
+  void setSenderClients(
+      std::vector<std::unique_ptr<httpclient::SimpleHttpClient>>&& clients);
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief get the number of lines read (meaningful for CSV only)
   //////////////////////////////////////////////////////////////////////////////
@@ -242,7 +256,17 @@ class ImportHelper {
   bool checkCreateCollection();
   void sendCsvBuffer();
   void sendJsonBuffer(char const* str, size_t len, bool isObject);
-  void handleResult(httpclient::SimpleHttpResult* result);
+  void sendBatch(std::string const& url, char const* data, size_t length);
+  void senderLoop(httpclient::SimpleHttpClient* client);
+  void finishSenders();
+  void handleResult(httpclient::SimpleHttpResult* result, uint64_t sequence);
+
+ private:
+  struct Batch {
+    uint64_t _sequence;
+    std::string _url;
+    std::string _data;
+  };
 
  private:
   httpclient::SimpleHttpClient* _client;
@@ -280,9 +304,29 @@ class ImportHelper {
 
   std::unordered_map<std::string, std::string> _translations;
 
-  bool _hasError;
+  std::atomic<bool> _hasError;
   std::string _errorMessage;
 
+  /// @brief the connections and threads for concurrent uploads
+  std::vector<std::unique_ptr<httpclient::SimpleHttpClient>> _senderClients;
+  std::vector<std::thread> _senderThreads;
+
+  /// @brief batches waiting for a sender thread. the queue holds at most
+  /// one batch per sender thread, so the reader cannot run ahead too far
+  basics::ConditionVariable _queueCondition;
+  std::deque<Batch> _queue;
+  bool _stopSenders;
+
+  /// @brief protects the counters and the error message, which are
+  /// updated by the sender threads
+  Mutex _resultLock;
+
+  /// @brief sequence number of the next batch, and of the earliest batch
+  /// that failed. errors are reported in input order, even if a later batch
+  /// fails first
+  uint64_t _nextSequence;
+  uint64_t _errorSequence;
+
   static double const ProgressStep;
 };
 }
@@ -24,6 +24,7 @@
 
 #include "ApplicationFeatures/ApplicationServer.h"
 #include "Basics/FileUtils.h"
+#include "Basics/MutexLocker.h"
 #include "Basics/StringUtils.h"
 #include "Basics/VelocyPackHelper.h"
 #include "Basics/files.h"
@@ -43,6 +44,9 @@
 #include <velocypack/velocypack-aliases.h>
 
 #include <iostream>
+#include <thread>
+
+#include "zlib.h"
 
 using namespace arangodb;
 using namespace arangodb::basics;
@@ -50,6 +54,9 @@ using namespace arangodb::httpclient;
 using namespace arangodb::options;
 using namespace arangodb::rest;
 
+/// @brief protects progress messages printed by the restore threads
+static Mutex ProgressLock;
+
 RestoreFeature::RestoreFeature(application_features::ApplicationServer* server,
                                int* result)
     : ApplicationFeature(server, "Restore"),
@@ -67,8 +74,8 @@ RestoreFeature::RestoreFeature(application_features::ApplicationServer* server,
       _clusterMode(false),
       _defaultNumberOfShards(1),
       _defaultReplicationFactor(1),
-      _result(result),
-      _stats{0, 0, 0} {
+      _threadCount(2),
+      _result(result) {
   requiresElevatedPrivileges(false);
   setOptional(false);
   startsAfter("Client");
@@ -126,6 +133,10 @@ void RestoreFeature::collectOptions(
   options->addOption(
       "--force", "continue restore even in the face of some server-side errors",
       new BooleanParameter(&_force));
+
+  options->addOption("--threads",
+                     "maximum number of collections to restore concurrently",
+                     new UInt32Parameter(&_threadCount));
 }
 
 void RestoreFeature::validateOptions(
@@ -146,6 +157,10 @@ void RestoreFeature::validateOptions(
   if (_chunkSize < 1024 * 128) {
     _chunkSize = 1024 * 128;
   }
+
+  if (_threadCount < 1) {
+    _threadCount = 1;
+  }
 }
 
 void RestoreFeature::prepare() {
@@ -274,18 +289,19 @@ int RestoreFeature::sendRestoreCollection(VPackSlice const& slice,
   return TRI_ERROR_NO_ERROR;
 }
 
-int RestoreFeature::sendRestoreIndexes(VPackSlice const& slice,
+int RestoreFeature::sendRestoreIndexes(SimpleHttpClient* client,
+                                       VPackSlice const& slice,
                                        std::string& errorMsg) {
   std::string const url = "/_api/replication/restore-indexes?force=" +
                           std::string(_force ? "true" : "false");
   std::string const body = slice.toJson();
 
-  std::unique_ptr<SimpleHttpResult> response(_httpClient->request(
+  std::unique_ptr<SimpleHttpResult> response(client->request(
       rest::RequestType::PUT, url, body.c_str(), body.size()));
 
   if (response == nullptr || !response->isComplete()) {
     errorMsg =
-        "got invalid response from server: " + _httpClient->getErrorMessage();
+        "got invalid response from server: " + client->getErrorMessage();
 
     return TRI_ERROR_INTERNAL;
   }
@@ -304,7 +320,8 @@ int RestoreFeature::sendRestoreIndexes(VPackSlice const& slice,
   return TRI_ERROR_NO_ERROR;
 }
 
-int RestoreFeature::sendRestoreData(std::string const& cname,
+int RestoreFeature::sendRestoreData(SimpleHttpClient* client,
+                                    std::string const& cname,
                                     char const* buffer, size_t bufferSize,
                                     std::string& errorMsg) {
   std::string const url = "/_api/replication/restore-data?collection=" +
@@ -313,11 +330,11 @@ int RestoreFeature::sendRestoreData(std::string const& cname,
                           (_force ? "true" : "false");
 
   std::unique_ptr<SimpleHttpResult> response(
-      _httpClient->request(rest::RequestType::PUT, url, buffer, bufferSize));
+      client->request(rest::RequestType::PUT, url, buffer, bufferSize));
 
   if (response == nullptr || !response->isComplete()) {
     errorMsg =
-        "got invalid response from server: " + _httpClient->getErrorMessage();
+        "got invalid response from server: " + client->getErrorMessage();
 
     return TRI_ERROR_INTERNAL;
   }
@@ -472,12 +489,13 @@ int RestoreFeature::processInputDirectory(std::string& errorMsg) {
 
     std::sort(collections.begin(), collections.end(), SortCollections);
 
-    StringBuffer buffer(TRI_UNKNOWN_MEM_ZONE);
+    std::vector<VPackSlice> restored;
 
-    // step2: run the actual import
+    // step2: re-create the collections in the sorted order, so that
+    // prototypes for distributeShardsLike exist before the collections
+    // that refer to them
     for (VPackSlice const& collection : collections) {
       VPackSlice const parameters = collection.get("parameters");
-      VPackSlice const indexes = collection.get("indexes");
       std::string const cname =
           arangodb::basics::VelocyPackHelper::getStringValue(parameters, "name",
                                                              "");
@@ -510,149 +528,299 @@ int RestoreFeature::processInputDirectory(std::string& errorMsg) {
       }
       _stats._totalCollections++;
 
-      if (_importData) {
-        // import data. check if we have a datafile
-        std::string datafile =
-            _inputDirectory + TRI_DIR_SEPARATOR_STR + cname + "_" +
-            arangodb::rest::SslInterface::sslMD5(cname) + ".data.json";
-        if (!TRI_ExistsFile(datafile.c_str())) {
-          datafile =
-              _inputDirectory + TRI_DIR_SEPARATOR_STR + cname + ".data.json";
-        }
+      restored.emplace_back(collection);
+    }
 
-        if (TRI_ExistsFile(datafile.c_str())) {
-          // found a datafile
+    // step3: load the data and create the indexes
+    return runJobs(restored, errorMsg);
+  } catch (...) {
+    errorMsg = "out of memory";
+    return TRI_ERROR_OUT_OF_MEMORY;
+  }
+  return TRI_ERROR_NO_ERROR;
+}
 
-          if (_progress) {
-            std::cout << "# Loading data into " << collectionType
-                      << " collection '" << cname << "'..." << std::endl;
-          }
+/// @brief load the data of a collection and create its indexes. the
+/// indexes are created after the data has been loaded, so the documents
+/// are indexed in bulk
+int RestoreFeature::restoreCollection(SimpleHttpClient* client,
+                                      VPackSlice const& collection,
+                                      std::string& errorMsg) {
+  VPackSlice const parameters = collection.get("parameters");
+  VPackSlice const indexes = collection.get("indexes");
+  std::string const cname =
+      arangodb::basics::VelocyPackHelper::getStringValue(parameters, "name",
+                                                         "");
+  int type = arangodb::basics::VelocyPackHelper::getNumericValue<int>(
+      parameters, "type", 2);
+
+  std::string const collectionType(type == 2 ? "document" : "edge");
+
+  StringBuffer buffer(TRI_UNKNOWN_MEM_ZONE);
+
+  if (_importData) {
+    // import data. check if we have a datafile
+    std::string datafile =
+        _inputDirectory + TRI_DIR_SEPARATOR_STR + cname + "_" +
+        arangodb::rest::SslInterface::sslMD5(cname) + ".data.json";
+    if (!TRI_ExistsFile(datafile.c_str())) {
+      datafile = _inputDirectory + TRI_DIR_SEPARATOR_STR + cname + ".data.json";
+    }
+    if (!TRI_ExistsFile(datafile.c_str())) {
+      // written by arangodump --compress-output
+      datafile = _inputDirectory + TRI_DIR_SEPARATOR_STR + cname + "_" +
+                 arangodb::rest::SslInterface::sslMD5(cname) +
+                 ".data.json.gz";
+    }
 
-          int fd = TRI_OPEN(datafile.c_str(), O_RDONLY | TRI_O_CLOEXEC);
+    if (TRI_ExistsFile(datafile.c_str())) {
+      // found a datafile
 
-          if (fd < 0) {
-            errorMsg = "cannot open collection data file '" + datafile + "'";
+      if (_progress) {
+        MUTEX_LOCKER(locker, ProgressLock);
+        std::cout << "# Loading data into " << collectionType
+                  << " collection '" << cname << "'..." << std::endl;
+      }
 
-            return TRI_ERROR_INTERNAL;
-          }
+      int fd = TRI_OPEN(datafile.c_str(), O_RDONLY | TRI_O_CLOEXEC);
 
-          buffer.clear();
+      if (fd < 0) {
+        errorMsg = "cannot open collection data file '" + datafile + "'";
 
-          while (true) {
-            if (buffer.reserve(16384) != TRI_ERROR_NO_ERROR) {
-              TRI_CLOSE(fd);
-              errorMsg = "out of memory";
+        return TRI_ERROR_INTERNAL;
+      }
 
-              return TRI_ERROR_OUT_OF_MEMORY;
-            }
+      gzFile gzFd = nullptr;
 
-            ssize_t numRead = TRI_READ(fd, buffer.end(), 16384);
+      if (StringUtils::isSuffix(datafile, ".gz")) {
+        gzFd = gzdopen(fd, "rb");
 
-            if (numRead < 0) {
-              // error while reading
-              int res = TRI_errno();
-              TRI_CLOSE(fd);
-              errorMsg = std::string(TRI_errno_string(res));
+        if (gzFd == nullptr) {
+          TRI_CLOSE(fd);
+          errorMsg = "cannot open collection data file '" + datafile + "'";
 
-              return res;
-            }
+          return TRI_ERROR_INTERNAL;
+        }
+      }
 
-            // read something
-            buffer.increaseLength(numRead);
+      auto closeFile = [&fd, &gzFd]() {
+        if (gzFd != nullptr) {
+          // this closes the file descriptor as well
+          gzclose(gzFd);
+        } else {
+          TRI_CLOSE(fd);
+        }
+      };
 
-            _stats._totalRead += (uint64_t)numRead;
+      while (true) {
+        if (buffer.reserve(16384) != TRI_ERROR_NO_ERROR) {
+          closeFile();
+          errorMsg = "out of memory";
 
-            if (buffer.length() < _chunkSize && numRead > 0) {
-              // still continue reading
-              continue;
-            }
+          return TRI_ERROR_OUT_OF_MEMORY;
+        }
 
-            // do we have a buffer?
-            if (buffer.length() > 0) {
-              // look for the last \n in the buffer
-              char* found = (char*)memrchr((const void*)buffer.begin(), '\n',
-                                           buffer.length());
-              size_t length;
-
-              if (found == nullptr) {
-                // no \n found...
-                if (numRead == 0) {
-                  // we're at the end. send the complete buffer anyway
-                  length = buffer.length();
-                } else {
-                  // read more
-                  continue;
-                }
-              } else {
-                // found a \n somewhere
-                length = found - buffer.begin();
-              }
-
-              TRI_ASSERT(length > 0);
-
-              _stats._totalBatches++;
-
-              int res =
-                  sendRestoreData(cname, buffer.begin(), length, errorMsg);
-
-              if (res != TRI_ERROR_NO_ERROR) {
-                if (errorMsg.empty()) {
-                  errorMsg = std::string(TRI_errno_string(res));
-                } else {
-                  errorMsg =
-                      std::string(TRI_errno_string(res)) + ": " + errorMsg;
-                }
-
-                if (_force) {
-                  std::cerr << errorMsg << std::endl;
-                  continue;
-                }
-                TRI_CLOSE(fd);
-
-                return res;
-              }
-
-              buffer.erase_front(length);
-            }
+        ssize_t numRead =
+            (gzFd != nullptr)
+                ? static_cast<ssize_t>(gzread(gzFd, buffer.end(), 16384))
+                : TRI_READ(fd, buffer.end(), 16384);
 
-            if (numRead == 0) {
-              // EOF
-              break;
-            }
+        if (numRead < 0) {
+          // error while reading
+          if (gzFd != nullptr) {
+            closeFile();
+            errorMsg = "cannot read collection data file '" + datafile +
+                       "'";
+
+            return TRI_ERROR_INTERNAL;
           }
 
-          TRI_CLOSE(fd);
+          int res = TRI_errno();
+          closeFile();
+          errorMsg = std::string(TRI_errno_string(res));
+
+          return res;
         }
-      }
 
-      if (_importStructure) {
-        // re-create indexes
-        if (indexes.length() > 0) {
-          // we actually have indexes
-          if (_progress) {
-            std::cout << "# Creating indexes for collection '" << cname
-                      << "'..." << std::endl;
+        // read something
+        buffer.increaseLength(numRead);
+
+        _stats._totalRead += (uint64_t)numRead;
+
+        if (buffer.length() < _chunkSize && numRead > 0) {
+          // still continue reading
+          continue;
+        }
+
+        // do we have a buffer?
+        if (buffer.length() > 0) {
+          // look for the last \n in the buffer
+          char* found = (char*)memrchr((const void*)buffer.begin(), '\n',
+                                       buffer.length());
+          size_t length;
+
+          if (found == nullptr) {
+            // no \n found...
+            if (numRead == 0) {
+              // we're at the end. send the complete buffer anyway
+              length = buffer.length();
+            } else {
+              // read more
+              continue;
+            }
+          } else {
+            // found a \n somewhere
+            length = found - buffer.begin();
           }
 
-          int res = sendRestoreIndexes(collection, errorMsg);
+          TRI_ASSERT(length > 0);
+
+          _stats._totalBatches++;
+
+          int res = sendRestoreData(client, cname, buffer.begin(), length,
+                                    errorMsg);
 
           if (res != TRI_ERROR_NO_ERROR) {
+            if (errorMsg.empty()) {
+              errorMsg = std::string(TRI_errno_string(res));
+            } else {
+              errorMsg =
+                  std::string(TRI_errno_string(res)) + ": " + errorMsg;
+            }
+
             if (_force) {
               std::cerr << errorMsg << std::endl;
               continue;
             }
-            return TRI_ERROR_INTERNAL;
+            closeFile();
+
+            return res;
           }
+
+          buffer.erase_front(length);
+        }
+
+        if (numRead == 0) {
+          // EOF
+          break;
         }
       }
+
+      closeFile();
     }
-  } catch (...) {
-    errorMsg = "out of memory";
-    return TRI_ERROR_OUT_OF_MEMORY;
   }
+
+  if (_importStructure) {
+    // re-create indexes
+    if (indexes.length() > 0) {
+      // we actually have indexes
+      if (_progress) {
+        MUTEX_LOCKER(locker, ProgressLock);
+        std::cout << "# Creating indexes for collection '" << cname << "'..."
+                  << std::endl;
+      }
+
+      int res = sendRestoreIndexes(client, collection, errorMsg);
+
+      if (res != TRI_ERROR_NO_ERROR) {
+        if (_force) {
+          std::cerr << errorMsg << std::endl;
+          return TRI_ERROR_NO_ERROR;
+        }
+        return TRI_ERROR_INTERNAL;
+      }
+    }
+  }
+
   return TRI_ERROR_NO_ERROR;
 }
 
+/// @brief restore the data and indexes of the collections, using up to
+/// --threads connections
+int RestoreFeature::runJobs(std::vector<VPackSlice> const& collections,
+                            std::string& errorMsg) {
+  size_t const numThreads =
+      (std::min)(static_cast<size_t>(_threadCount), collections.size());
+
+  if (numThreads <= 1) {
+    for (auto const& collection : collections) {
+      int res = restoreCollection(_httpClient.get(), collection, errorMsg);
+
+      if (res != TRI_ERROR_NO_ERROR) {
+        return res;
+      }
+    }
+
+    return TRI_ERROR_NO_ERROR;
+  }
+
+  ClientFeature* client =
+      application_features::ApplicationServer::getFeature<ClientFeature>(
+          "Client");
+
+  // every thread uses a connection of its own
+  std::vector<std::unique_ptr<SimpleHttpClient>> httpClients;
+  httpClients.reserve(numThreads);
+
+  for (size_t i = 0; i < numThreads; ++i) {
+    auto httpClient = client->createHttpClient();
+    httpClient->setLocationRewriter(static_cast<void*>(client),
+                                    &rewriteLocation);
+    httpClient->setUserNamePassword("/", client->username(),
+                                    client->password());
+    httpClients.emplace_back(std::move(httpClient));
+  }
+
+  std::atomic<size_t> next(0);
+  std::atomic<int> result(TRI_ERROR_NO_ERROR);
+  Mutex errorLock;
+
+  auto work = [&](SimpleHttpClient* httpClient) {
+    while (result.load() == TRI_ERROR_NO_ERROR) {
+      size_t const i = next.fetch_add(1);
+
+      if (i >= collections.size()) {
+        return;
+      }
+
+      std::string jobErrorMsg;
+      int res;
+
+      try {
+        res = restoreCollection(httpClient, collections[i], jobErrorMsg);
+      } catch (std::exception const& ex) {
+        res = TRI_ERROR_INTERNAL;
+        jobErrorMsg = std::string("caught exception ") + ex.what();
+      } catch (...) {
+        res = TRI_ERROR_INTERNAL;
+        jobErrorMsg = "caught unknown exception";
+      }
+
+      if (res != TRI_ERROR_NO_ERROR) {
+        // report the first error only
+        MUTEX_LOCKER(locker, errorLock);
+
+        if (result.load() == TRI_ERROR_NO_ERROR) {
+          errorMsg = jobErrorMsg;
+          result = res;
+        }
+      }
+    }
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(numThreads);
+
+  for (auto& httpClient : httpClients) {
+    threads.emplace_back(work, httpClient.get());
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  return result.load();
+}
+
 void RestoreFeature::start() {
   ClientFeature* client =
       application_features::ApplicationServer::getFeature<ClientFeature>(
@@ -31,6 +31,7 @@
 
 namespace arangodb {
 namespace httpclient {
+class SimpleHttpClient;
 class SimpleHttpResult;
 }
 
@@ -63,24 +64,31 @@ class RestoreFeature final
   bool _clusterMode;
   uint64_t _defaultNumberOfShards;
   uint64_t _defaultReplicationFactor;
+  uint32_t _threadCount;
 
  private:
   int tryCreateDatabase(ClientFeature*, std::string const& name);
   int sendRestoreCollection(VPackSlice const& slice, std::string const& name,
                             std::string& errorMsg);
-  int sendRestoreIndexes(VPackSlice const& slice, std::string& errorMsg);
-  int sendRestoreData(std::string const& cname, char const* buffer,
+  int sendRestoreIndexes(httpclient::SimpleHttpClient* client,
+                         VPackSlice const& slice, std::string& errorMsg);
+  int sendRestoreData(httpclient::SimpleHttpClient* client,
+                      std::string const& cname, char const* buffer,
                       size_t bufferSize, std::string& errorMsg);
   int processInputDirectory(std::string& errorMsg);
+  int restoreCollection(httpclient::SimpleHttpClient* client,
+                        VPackSlice const& collection, std::string& errorMsg);
+  int runJobs(std::vector<VPackSlice> const& collections,
+              std::string& errorMsg);
 
  private:
   int* _result;
 
-  // statistics
+  // statistics, updated concurrently by the restore threads
   struct {
-    uint64_t _totalBatches;
-    uint64_t _totalCollections;
-    uint64_t _totalRead;
+    std::atomic<uint64_t> _totalBatches{0};
+    std::atomic<uint64_t> _totalCollections{0};
+    std::atomic<uint64_t> _totalRead{0};
   } _stats;
 };
 }
@@ -72,7 +72,9 @@ namespace basics {
 /// To this end, we use a hash table and ask the user to provide the following:
 ///  - a way to hash elements by their keys, and to hash keys themselves,
 ///  - a way to hash elements by their full identity
-///  - a way to compare a key to the key of a given element
+///  - a way to compare a key to the key of a given element. the comparison
+///    also receives the key's hash, so that elements which store a hash
+///    fingerprint can be rejected without looking at their data
 ///  - a way to compare two elements, either by their keys or by their full
 ///    identities.
 /// To avoid unnecessary comparisons the user can guarantee that s/he will
@@ -106,7 +108,7 @@ class AssocMulti {
   typedef std::function<uint64_t(UserData*, Key const*)> HashKeyFuncType;
   typedef std::function<uint64_t(UserData*, Element const&, bool)>
       HashElementFuncType;
-  typedef std::function<bool(UserData*, Key const*, Element const&)>
+  typedef std::function<bool(UserData*, Key const*, uint64_t, Element const&)>
       IsEqualKeyElementFuncType;
   typedef std::function<bool(UserData*, Element const&, Element const&)>
       IsEqualElementElementFuncType;
@@ -708,7 +710,7 @@ class AssocMulti {
     while (b._table[i].value &&
            (b._table[i].prev != INVALID_INDEX ||
             (useHashCache && b._table[i].readHashCache() != hashByKey) ||
-            !_isEqualKeyElement(userData, key, b._table[i].value))) {
+            !_isEqualKeyElement(userData, key, hashByKey, b._table[i].value))) {
       i = incr(b, i);
 #ifdef TRI_INTERNAL_STATS
       _nrProbesF++;
@@ -727,6 +729,19 @@ class AssocMulti {
     // return whatever we found
   }
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief prefetches the slot a lookup of the key starts at. used by
+  /// callers which look up many keys in a row, so that the cache misses
+  /// of consecutive lookups overlap
+  //////////////////////////////////////////////////////////////////////////////
+
+  void prefetchByKey(UserData* userData, Key const* key) const {
+    uint64_t hashByKey = _hashKey(userData, key);
+    Bucket const& b = _buckets[hashByKey & _bucketsMask];
+    IndexType i = hashToIndex(hashByKey) % b._nrAlloc;
+    TRI_PREFETCH(&b._table[i]);
+  }
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief looks up all elements with the same key as a given element
   //////////////////////////////////////////////////////////////////////////////
@@ -72,7 +72,36 @@ class AssocUnique {
   typedef arangodb::basics::IndexBucket<Element, uint64_t, SIZE_MAX> Bucket;
 
  private:
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief state of an incremental resize of a bucket. while a bucket is
+  /// resized, its previous table is kept here and its elements are moved
+  /// into the bucket's new table a few at a time by subsequent insert and
+  /// remove operations. the migration position is always at a cluster
+  /// boundary of the old table (i.e. the slot before it is empty), so that
+  /// the elements still left in the old table can be found by linear probing
+  /// there. new elements are always inserted into the new table
+  //////////////////////////////////////////////////////////////////////////////
+
+  struct Migration {
+    Bucket _old;
+    uint64_t _position;
+
+    Migration() : _old(), _position(0) {}
+    Migration(Migration const&) = delete;
+    Migration& operator=(Migration const&) = delete;
+    Migration(Migration&& other)
+        : _old(std::move(other._old)), _position(other._position) {}
+    Migration& operator=(Migration&& other) {
+      _old = std::move(other._old);
+      _position = other._position;
+      return *this;
+    }
+
+    bool active() const { return _old._table != nullptr; }
+  };
+
   std::vector<Bucket> _buckets;
+  std::vector<Migration> _migrations;
   size_t _bucketsMask;
 
   HashKeyFuncType const _hashKey;
@@ -110,6 +139,7 @@ class AssocUnique {
     _bucketsMask = nr - 1;
 
     _buckets.resize(numberBuckets);
+    _migrations.resize(numberBuckets);
 
     try {
       for (size_t j = 0; j < numberBuckets; j++) {
@@ -121,7 +151,10 @@ class AssocUnique {
     }
   }
 
-  ~AssocUnique() { _buckets.clear(); }
+  ~AssocUnique() {
+    _migrations.clear();
+    _buckets.clear();
+  }
 
   //////////////////////////////////////////////////////////////////////////////
   /// @brief adhere to the rule of five
@@ -143,7 +176,225 @@ class AssocUnique {
   static uint64_t initialSize() { return 251; }
 
   //////////////////////////////////////////////////////////////////////////////
-  /// @brief resizes the array
+  /// @brief minimum number of elements in a bucket for which a resize is
+  /// carried out incrementally. smaller buckets are rehashed in one go, which
+  /// is cheap for them
+  //////////////////////////////////////////////////////////////////////////////
+
+  static uint64_t incrementalResizeThreshold() { return 65536; }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief number of slots of the old table that each insert or remove
+  /// operation migrates during an incremental resize. as the new table is
+  /// about twice as big as the old one, this guarantees that the migration
+  /// has finished long before the new table needs to grow again
+  //////////////////////////////////////////////////////////////////////////////
+
+  static uint64_t migrationStep() { return 16; }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief returns the migration state of a bucket
+  //////////////////////////////////////////////////////////////////////////////
+
+  Migration& migration(Bucket const& b) {
+    return _migrations[static_cast<size_t>(&b - _buckets.data())];
+  }
+
+  Migration const& migration(Bucket const& b) const {
+    return _migrations[static_cast<size_t>(&b - _buckets.data())];
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief number of elements in a bucket, including the elements not yet
+  /// migrated from its old table
+  //////////////////////////////////////////////////////////////////////////////
+
+  uint64_t usedInBucket(size_t bucketId) const {
+    return _buckets[bucketId]._nrUsed + _migrations[bucketId]._old._nrUsed;
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief number of slots of a bucket as seen by the positional iteration
+  /// methods. the slots of an old table still being migrated are appended
+  /// to the slots of the new table
+  //////////////////////////////////////////////////////////////////////////////
+
+  uint64_t slotsInBucket(size_t bucketId) const {
+    return _buckets[bucketId]._nrAlloc + _migrations[bucketId]._old._nrAlloc;
+  }
+
+  Element const& slotInBucket(size_t bucketId, uint64_t position) const {
+    static Element const empty = Element();
+
+    Bucket const& b = _buckets[bucketId];
+    if (position < b._nrAlloc) {
+      return b._table[position];
+    }
+    position -= b._nrAlloc;
+
+    Bucket const& old = _migrations[bucketId]._old;
+    if (position < old._nrAlloc) {
+      return old._table[position];
+    }
+    // the bucket has shrunk since the caller obtained the position
+    return empty;
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief looks up an element in the old table of a bucket that is being
+  /// migrated. returns nullptr if there is no such element
+  //////////////////////////////////////////////////////////////////////////////
+
+  template <typename F>
+  Element* findInOldTable(Bucket const& b, uint64_t hash,
+                          F const& isEqual) const {
+    Bucket const& old = migration(b)._old;
+
+    if (old._nrUsed == 0) {
+      return nullptr;
+    }
+
+    uint64_t const n = old._nrAlloc;
+    uint64_t i = hash % n;
+
+    // the old table always contains empty slots, so this terminates
+    while (old._table[i]) {
+      if (isEqual(old._table[i])) {
+        return &old._table[i];
+      }
+      i = TRI_IncModU64(i, n);
+    }
+    return nullptr;
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief removes an element from the old table of a bucket that is
+  /// being migrated. returns a default-constructed Element if not found
+  //////////////////////////////////////////////////////////////////////////////
+
+  template <typename F>
+  Element removeFromOldTable(UserData* userData, Bucket& b, uint64_t hash,
+                             F const& isEqual) {
+    Migration& m = migration(b);
+    Element* found = findInOldTable(b, hash, isEqual);
+
+    if (found == nullptr) {
+      return Element();
+    }
+
+    Element old = *found;
+    removeSlot(userData, m._old, static_cast<uint64_t>(found - m._old._table));
+
+    if (m._old._nrUsed == 0) {
+      m._old.deallocate();
+      m._position = 0;
+
+      if (b._nrUsed == 0) {
+        resizeInternal(userData, b, initialSize(), true);
+      }
+    }
+    return old;
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief puts an element into the first free slot of its probe sequence.
+  /// the caller must have made sure that the element is not yet contained
+  /// in the table
+  //////////////////////////////////////////////////////////////////////////////
+
+  void place(Bucket& b, Element const& element, uint64_t hash) {
+    uint64_t const n = b._nrAlloc;
+    uint64_t i = hash % n;
+
+    while (b._table[i]) {
+      i = TRI_IncModU64(i, n);
+    }
+
+    b._table[i] = element;
+    ++b._nrUsed;
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief starts an incremental resize of a bucket. the bucket gets a new
+  /// table right away, the elements of the current table are moved over
+  /// later by migrate()
+  //////////////////////////////////////////////////////////////////////////////
+
+  void startMigration(Bucket& b, uint64_t targetSize) {
+    Migration& m = migration(b);
+    TRI_ASSERT(!m.active());
+    TRI_ASSERT(targetSize > 0);
+    targetSize = TRI_NearPrime(targetSize);
+
+    LOG_TOPIC(TRACE, Logger::PERFORMANCE)
+        << "starting incremental unique hash-resize " << _contextCallback()
+        << ", target size: " << targetSize;
+
+    Bucket copy;
+    copy.allocate(targetSize);
+
+    m._old = std::move(b);
+    b = std::move(copy);
+
+    // start the migration at a cluster boundary
+    m._position = 0;
+    while (m._old._table[m._position]) {
+      ++m._position;
+    }
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief moves elements from the old table of a bucket into its new table,
+  /// checking at least the given number of slots of the old table. the
+  /// migration only stops at empty slots, i.e. it always moves whole
+  /// clusters of the old table, so the elements left behind there can still
+  /// be found and removed by linear probing
+  //////////////////////////////////////////////////////////////////////////////
+
+  void migrate(UserData* userData, Bucket& b, uint64_t slots) {
+    Migration& m = migration(b);
+
+    if (!m.active()) {
+      return;
+    }
+
+    uint64_t const n = m._old._nrAlloc;
+
+    while (m._old._nrUsed > 0) {
+      Element& element = m._old._table[m._position];
+
+      if (element) {
+        place(b, element, _hashElement(userData, element));
+        element = Element();
+        --m._old._nrUsed;
+      } else if (slots == 0) {
+        break;
+      }
+
+      if (slots > 0) {
+        --slots;
+      }
+      m._position = TRI_IncModU64(m._position, n);
+    }
+
+    if (m._old._nrUsed == 0) {
+      m._old.deallocate();
+      m._position = 0;
+    }
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief moves all remaining elements of a bucket's old table into its
+  /// new table
+  //////////////////////////////////////////////////////////////////////////////
+
+  void completeMigration(UserData* userData, Bucket& b) {
+    migrate(userData, b, UINT64_MAX);
+    TRI_ASSERT(!migration(b).active());
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief resizes the array. this rehashes all elements at once
   //////////////////////////////////////////////////////////////////////////////
 
   void resizeInternal(UserData* userData, Bucket& b, uint64_t targetSize,
@@ -157,6 +408,8 @@ class AssocUnique {
       return;
     }
 
+    completeMigration(userData, b);
+
     std::string const cb(_contextCallback());
 
     TRI_ASSERT(targetSize > 0);
@@ -199,17 +452,37 @@ class AssocUnique {
   }
 
   //////////////////////////////////////////////////////////////////////////////
-  /// @brief check a resize of the hash array
+  /// @brief check a resize of the hash array. big buckets are resized
+  /// incrementally unless incremental is false, and each call advances an
+  /// ongoing incremental resize of the bucket
   //////////////////////////////////////////////////////////////////////////////
 
-  bool checkResize(UserData* userData, Bucket& b, uint64_t expected) {
-    if (2 * b._nrAlloc < 3 * (b._nrUsed + expected)) {
+  bool checkResize(UserData* userData, Bucket& b, uint64_t expected,
+                   bool incremental = true) {
+    uint64_t const used = b._nrUsed + migration(b)._old._nrUsed;
+
+    if (2 * b._nrAlloc < 3 * (used + expected)) {
       try {
-        resizeInternal(userData, b, 2 * (b._nrAlloc + expected) + 1, false);
+        // the new table of an incremental resize is full before the
+        // migration has finished. this can only happen if many elements
+        // are requested at once
+        completeMigration(userData, b);
+
+        uint64_t const targetSize = 2 * (b._nrAlloc + expected) + 1;
+
+        if (incremental && used >= incrementalResizeThreshold()) {
+          startMigration(b, targetSize);
+        } else {
+          resizeInternal(userData, b, targetSize, false);
+        }
       } catch (...) {
         return false;
       }
     }
+
+    if (incremental) {
+      migrate(userData, b, migrationStep());
+    }
     return true;
   }
 
@@ -222,14 +495,12 @@ class AssocUnique {
       UserData* userData, BucketPosition& position, uint64_t const step,
       BucketPosition const& initial) const {
     Element found;
-    Bucket const* b = &_buckets[position.bucketId];
     do {
-      found = b->_table[position.position];
+      found = slotInBucket(position.bucketId, position.position);
       position.position += step;
-      while (position.position >= b->_nrAlloc) {
-        position.position -= b->_nrAlloc;
+      while (position.position >= slotsInBucket(position.bucketId)) {
+        position.position -= slotsInBucket(position.bucketId);
         position.bucketId = (position.bucketId + 1) % _buckets.size();
-        b = &_buckets[position.bucketId];
       }
       if (position == initial) {
         // We are done. Return the last element we have in hand
@@ -246,6 +517,13 @@ class AssocUnique {
 
   int doInsert(UserData* userData, Element const& element, Bucket& b,
                uint64_t hash) {
+    if (migration(b).active() &&
+        findInOldTable(b, hash, [&](Element const& other) {
+          return _isEqualElementElementByKey(userData, element, other);
+        }) != nullptr) {
+      return TRI_ERROR_ARANGO_UNIQUE_CONSTRAINT_VIOLATED;
+    }
+
     uint64_t const n = b._nrAlloc;
     uint64_t i = hash % n;
     uint64_t k = i;
@@ -277,6 +555,8 @@ class AssocUnique {
   void truncate(CallbackElementFuncType callback) {
     for (auto& b : _buckets) {
       invokeOnAllElements(callback, b);
+      migration(b)._old.deallocate();
+      migration(b)._position = 0;
       b.deallocate();
       b.allocate(initialSize());
     }
@@ -289,8 +569,8 @@ class AssocUnique {
   //////////////////////////////////////////////////////////////////////////////
 
   bool isEmpty() const {
-    for (auto& b : _buckets) {
-      if (b._nrUsed > 0) {
+    for (size_t i = 0; i < _buckets.size(); ++i) {
+      if (usedInBucket(i) > 0) {
         return false;
       }
     }
@@ -303,8 +583,8 @@ class AssocUnique {
 
   size_t memoryUsage() const {
     size_t res = 0;
-    for (auto& b : _buckets) {
-      res += b.memoryUsage();
+    for (size_t i = 0; i < _buckets.size(); ++i) {
+      res += _buckets[i].memoryUsage() + _migrations[i]._old.memoryUsage();
     }
     return res;
   }
@@ -315,8 +595,8 @@ class AssocUnique {
 
   size_t size() const {
     size_t sum = 0;
-    for (auto& b : _buckets) {
-      sum += static_cast<size_t>(b._nrUsed);
+    for (size_t i = 0; i < _buckets.size(); ++i) {
+      sum += static_cast<size_t>(usedInBucket(i));
     }
     return sum;
   }
@@ -336,7 +616,7 @@ class AssocUnique {
   int resize(UserData* userData, size_t size) {
     size /= _buckets.size();
     for (auto& b : _buckets) {
-      if (2 * (2 * size + 1) < 3 * b._nrUsed) {
+      if (2 * (2 * size + 1) < 3 * (b._nrUsed + migration(b)._old._nrUsed)) {
         return TRI_ERROR_BAD_PARAMETER;
       }
 
@@ -355,10 +635,13 @@ class AssocUnique {
 
   void appendToVelocyPack(VPackBuilder& builder) {
     builder.add("buckets", VPackValue(VPackValueType::Array));
-    for (auto& b : _buckets) {
+    for (size_t i = 0; i < _buckets.size(); ++i) {
       builder.openObject();
-      builder.add("nrAlloc", VPackValue(b._nrAlloc));
-      builder.add("nrUsed", VPackValue(b._nrUsed));
+      builder.add("nrAlloc", VPackValue(_buckets[i]._nrAlloc));
+      builder.add("nrUsed", VPackValue(usedInBucket(i)));
+      if (_migrations[i].active()) {
+        builder.add("nrMigrating", VPackValue(_migrations[i]._old._nrUsed));
+      }
       builder.close();
     }
     builder.close();  // buckets
@@ -371,7 +654,8 @@ class AssocUnique {
   //////////////////////////////////////////////////////////////////////////////
 
   Element find(UserData* userData, Element const& element) const {
-    uint64_t i = _hashElement(userData, element);
+    uint64_t const hash = _hashElement(userData, element);
+    uint64_t i = hash;
     Bucket const& b = _buckets[i & _bucketsMask];
 
     uint64_t const n = b._nrAlloc;
@@ -389,6 +673,15 @@ class AssocUnique {
         ;
     }
 
+    if (!b._table[i] && migration(b).active()) {
+      Element* old = findInOldTable(b, hash, [&](Element const& other) {
+        return _isEqualElementElementByKey(userData, element, other);
+      });
+      if (old != nullptr) {
+        return *old;
+      }
+    }
+
     // ...........................................................................
     // return whatever we found, this is nullptr if the thing was not found
     // and otherwise a valid pointer
@@ -423,6 +716,15 @@ class AssocUnique {
         ;
     }
 
+    if (!b._table[i] && migration(b).active()) {
+      Element* old = findInOldTable(b, hash, [&](Element const& other) {
+        return _isEqualKeyElement(userData, key, hash, other);
+      });
+      if (old != nullptr) {
+        return *old;
+      }
+    }
+
     // ...........................................................................
     // return whatever we found, this is nullptr if the thing was not found
     // and otherwise a valid pointer
@@ -431,6 +733,18 @@ class AssocUnique {
     return b._table[i];
   }
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief prefetches the slot a lookup of the key starts at. used by
+  /// callers which look up many keys in a row, so that the cache misses
+  /// of consecutive lookups overlap
+  //////////////////////////////////////////////////////////////////////////////
+
+  void prefetchByKey(UserData* userData, Key const* key) const {
+    uint64_t hash = _hashKey(userData, key);
+    Bucket const& b = _buckets[static_cast<size_t>(hash & _bucketsMask)];
+    TRI_PREFETCH(&b._table[hash % b._nrAlloc]);
+  }
+
   Element* findByKeyRef(UserData* userData, Key const* key) const {
     uint64_t hash = _hashKey(userData, key);
     uint64_t i = hash;
@@ -452,6 +766,15 @@ class AssocUnique {
         ;
     }
 
+    if (!b._table[i] && migration(b).active()) {
+      Element* old = findInOldTable(b, hash, [&](Element const& other) {
+        return _isEqualKeyElement(userData, key, hash, other);
+      });
+      if (old != nullptr) {
+        return old;
+      }
+    }
+
     // ...........................................................................
     // return whatever we found, this is nullptr if the thing was not found
     // and otherwise a valid pointer
@@ -494,6 +817,15 @@ class AssocUnique {
     position.bucketId = static_cast<size_t>(bucketId);
     position.position = i;
 
+    if (!b._table[i] && migration(b).active()) {
+      Element* old = findInOldTable(b, hash, [&](Element const& other) {
+        return _isEqualKeyElement(userData, key, hash, other);
+      });
+      if (old != nullptr) {
+        return *old;
+      }
+    }
+
     // ...........................................................................
     // return whatever we found, this is nullptr if the thing was not found
     // and otherwise a valid pointer
@@ -536,6 +868,15 @@ class AssocUnique {
       return TRI_ERROR_ARANGO_UNIQUE_CONSTRAINT_VIOLATED;
     }
 
+    if (migration(b).active() &&
+        findInOldTable(b, _hashElement(userData, element),
+                       [&](Element const& other) {
+                         return _isEqualElementElementByKey(userData, element,
+                                                            other);
+                       }) != nullptr) {
+      return TRI_ERROR_ARANGO_UNIQUE_CONSTRAINT_VIOLATED;
+    }
+
     b._table[position.position] = element;
     b._nrUsed++;
 
@@ -597,9 +938,10 @@ class AssocUnique {
                                Bucket& b, uint64_t hashByKey) -> int {
       return doInsert(userData, element, b, hashByKey);
     };
+    // bulk inserts are not latency-sensitive, so they resize in one go
     auto checkResizeBinding = [&](UserData* userData, Bucket& b,
                                   uint64_t expected) -> bool {
-      return checkResize(userData, b, expected);
+      return checkResize(userData, b, expected, false);
     };
 
     try {
@@ -639,6 +981,19 @@ class AssocUnique {
   //////////////////////////////////////////////////////////////////////////////
 
   void healHole(UserData* userData, Bucket& b, uint64_t i) {
+    removeSlot(userData, b, i);
+
+    if (b._nrUsed == 0 && !migration(b).active()) {
+      resizeInternal(userData, b, initialSize(), true);
+    }
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief removes the element at the given slot of a table and moves the
+  /// following elements of its cluster closer together
+  //////////////////////////////////////////////////////////////////////////////
+
+  void removeSlot(UserData* userData, Bucket& b, uint64_t i) {
     //
     // remove item - destroy any internal memory associated with the
     // element structure
@@ -667,10 +1022,6 @@ class AssocUnique {
 
       k = TRI_IncModU64(k, n);
     }
-
-    if (b._nrUsed == 0) {
-      resizeInternal(userData, b, initialSize(), true);
-    }
   }
 
   //////////////////////////////////////////////////////////////////////////////
@@ -703,7 +1054,13 @@ class AssocUnique {
 
     if (old) {
       healHole(userData, b, i);
+    } else if (migration(b).active()) {
+      old = removeFromOldTable(userData, b, hash, [&](Element const& other) {
+        return _isEqualKeyElement(userData, key, hash, other);
+      });
     }
+
+    migrate(userData, b, migrationStep());
     return old;
   }
 
@@ -713,7 +1070,8 @@ class AssocUnique {
   //////////////////////////////////////////////////////////////////////////////
 
   Element remove(UserData* userData, Element const& element) {
-    uint64_t i = _hashElement(userData, element);
+    uint64_t const hash = _hashElement(userData, element);
+    uint64_t i = hash;
     Bucket& b = _buckets[i & _bucketsMask];
 
     uint64_t const n = b._nrAlloc;
@@ -735,8 +1093,13 @@ class AssocUnique {
 
     if (old) {
       healHole(userData, b, i);
+    } else if (migration(b).active()) {
+      old = removeFromOldTable(userData, b, hash, [&](Element const& other) {
+        return _isEqualElementElement(userData, element, other);
+      });
     }
 
+    migrate(userData, b, migrationStep());
     return old;
   }
 
@@ -756,15 +1119,18 @@ class AssocUnique {
   /// @brief a method to iterate over all elements in a bucket. this method
   /// can NOT be used for deleting elements
   bool invokeOnAllElements(CallbackElementFuncType const& callback, Bucket& b) {
-    if (b._nrUsed > 0) {
-      for (size_t i = 0; i < b._nrAlloc; ++i) {
-        if (!b._table[i]) {
+    for (Bucket* t : {&b, &migration(b)._old}) {
+      if (t->_nrUsed == 0) {
+        continue;
+      }
+      for (size_t i = 0; i < t->_nrAlloc; ++i) {
+        if (!t->_table[i]) {
           continue;
         }
-        if (!callback(b._table[i])) {
+        if (!callback(t->_table[i])) {
           return false;
         }
-        if (b._nrUsed == 0) {
+        if (t->_nrUsed == 0) {
           break;
         }
       }
@@ -779,6 +1145,11 @@ class AssocUnique {
 
   void invokeOnAllElementsForRemoval(CallbackElementFuncType callback) {
     for (auto& b : _buckets) {
+      // removals advance incremental resizes, which would move elements
+      // behind the iteration position. the element hash functions do not
+      // use the user data
+      completeMigration(nullptr, b);
+
       if (b._table == nullptr || b._nrUsed == 0) {
         continue;
       }
@@ -821,8 +1192,8 @@ class AssocUnique {
       if (position.bucketId == SIZE_MAX) {
         // first call, now fill total
         total = 0;
-        for (auto const& b : _buckets) {
-          total += b._nrUsed;
+        for (size_t i = 0; i < _buckets.size(); ++i) {
+          total += usedInBucket(i);
         }
 
         if (total == 0) {
@@ -837,16 +1208,16 @@ class AssocUnique {
     }
 
     while (true) {
-      Bucket const& b = _buckets[position.bucketId];
-      uint64_t const n = b._nrAlloc;
+      uint64_t const n = slotsInBucket(position.bucketId);
 
-      for (; position.position < n && !b._table[position.position];
+      for (; position.position < n &&
+             !slotInBucket(position.bucketId, position.position);
            ++position.position)
         ;
 
-      if (position.position != n) {
+      if (position.position < n) {
         // found an element
-        Element found = b._table[position.position];
+        Element found = slotInBucket(position.bucketId, position.position);
 
         // move forward the position indicator one more time
         if (++position.position == n) {
@@ -867,6 +1238,34 @@ class AssocUnique {
     }
   }
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief a method to iterate over all elements of a single bucket in
+  ///        a sequential order. this allows scanning the buckets of the
+  ///        index independently, e.g. from multiple threads.
+  ///        Returns nullptr if all documents of the bucket have been returned.
+  ///        Convention: position === 0 indicates a new start.
+  //////////////////////////////////////////////////////////////////////////////
+
+  Element findSequentialInBucket(UserData* userData, size_t bucketId,
+                                 uint64_t& position) const {
+    if (bucketId >= _buckets.size()) {
+      return Element();
+    }
+
+    uint64_t const n = slotsInBucket(bucketId);
+
+    for (; position < n && !slotInBucket(bucketId, position); ++position)
+      ;
+
+    if (position >= n) {
+      // reached end of bucket
+      return Element();
+    }
+
+    // found an element. move forward the position indicator one more time
+    return slotInBucket(bucketId, position++);
+  }
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief a method to iterate over all elements in the index in
   ///        reversed sequential order.
@@ -887,24 +1286,22 @@ class AssocUnique {
       }
 
       position.bucketId = _buckets.size() - 1;
-      position.position = _buckets[position.bucketId]._nrAlloc - 1;
+      position.position = slotsInBucket(position.bucketId) - 1;
     }
 
-    Bucket const* b = &_buckets[position.bucketId];
     Element found;
     do {
-      found = b->_table[position.position];
+      found = slotInBucket(position.bucketId, position.position);
 
       if (position.position == 0) {
         if (position.bucketId == 0) {
-          // Indicate we are done
+          // Indicate we are done. the first slot may still hold an element
           position.bucketId = _buckets.size();
-          return Element();
+          return found;
         }
 
         --position.bucketId;
-        b = &_buckets[position.bucketId];
-        position.position = b->_nrAlloc - 1;
+        position.position = slotsInBucket(position.bucketId) - 1;
       } else {
         --position.position;
       }
@@ -931,9 +1328,9 @@ class AssocUnique {
       // Initialize
       uint64_t used = 0;
       total = 0;
-      for (auto& b : _buckets) {
-        total += b._nrAlloc;
-        used += b._nrUsed;
+      for (size_t i = 0; i < _buckets.size(); ++i) {
+        total += slotsInBucket(i);
+        used += usedInBucket(i);
       }
       if (used == 0) {
         return Element();
@@ -950,14 +1347,14 @@ class AssocUnique {
             initialPositionNr = RandomGenerator::interval(UINT32_MAX) % total;
           }
           for (size_t i = 0; i < _buckets.size(); ++i) {
-            if (initialPositionNr < _buckets[i]._nrAlloc) {
+            if (initialPositionNr < slotsInBucket(i)) {
               position.bucketId = i;
               position.position = initialPositionNr;
               initialPosition.bucketId = i;
               initialPosition.position = initialPositionNr;
               break;
             }
-            initialPositionNr -= _buckets[i]._nrAlloc;
+            initialPositionNr -= slotsInBucket(i);
           }
           break;
         }
@@ -0,0 +1,429 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "CpuProfiler.h"
+
+#include "Basics/MutexLocker.h"
+#include "Basics/Thread.h"
+#include "Basics/WorkMonitor.h"
+#include "Logger/Logger.h"
+
+#include <map>
+#include <thread>
+
+#if defined(__linux__) && defined(__GLIBC__)
+#define ARANGODB_CPU_PROFILER 1
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <execinfo.h>
+#include <pthread.h>
+#include <signal.h>
+#include <sys/prctl.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+// older glibc versions do not name the target thread of SIGEV_THREAD_ID
+#ifndef sigev_notify_thread_id
+#define sigev_notify_thread_id _sigev_un._tid
+#endif
+#endif
+
+using namespace arangodb;
+using namespace arangodb::basics;
+
+#ifdef ARANGODB_CPU_PROFILER
+
+namespace {
+
+/// @brief the frames of the signal handler and of the signal trampoline at
+/// the top of each recorded stack
+int const HandlerFrames = 2;
+
+struct Sample {
+  void* frames[CpuProfiler::MaxFrames];
+  int depth;
+  char thread[32];
+  char work[32];
+};
+
+/// @brief a thread that takes part in profiles
+struct ProfiledThread {
+  pthread_t thread;
+  pid_t tid;
+};
+
+/// @brief the registered threads. a thread cannot unregister, and thus not
+/// end, while the lock is held
+Mutex ThreadsLock;
+std::vector<ProfiledThread> Threads;
+
+/// @brief whether a profile is being taken
+std::atomic<bool> Running(false);
+
+/// @brief whether the signal handler records samples
+std::atomic<bool> Sampling(false);
+
+/// @brief the number of signal handlers running right now
+std::atomic<size_t> ActiveHandlers(0);
+
+/// @brief the preallocated samples of the current profile. the number of
+/// samples is increased by every signal, also beyond the capacity
+Sample* Samples = nullptr;
+size_t Capacity = 0;
+std::atomic<size_t> NumSamples(0);
+
+/// @brief copy a name into a sample, without allocating
+void copyName(char* dst, size_t size, char const* src) {
+  size_t i = 0;
+  if (src != nullptr) {
+    for (; i + 1 < size && src[i] != '\0'; ++i) {
+      dst[i] = src[i];
+    }
+  }
+  dst[i] = '\0';
+}
+
+/// @brief record the stack of the interrupted thread. everything called
+/// from here must be async-signal-safe: backtrace() is, once libgcc has
+/// been loaded, and the thread and its work descriptions are only read
+void signalHandler(int) {
+  int const savedErrno = errno;
+  ActiveHandlers.fetch_add(1);
+
+  if (Sampling.load()) {
+    size_t const slot = NumSamples.fetch_add(1, std::memory_order_relaxed);
+
+    if (slot < Capacity) {
+      Sample& sample = Samples[slot];
+      sample.depth = backtrace(sample.frames,
+                               static_cast<int>(CpuProfiler::MaxFrames));
+      sample.work[0] = '\0';
+
+      Thread* thread = Thread::current();
+
+      if (thread == nullptr) {
+        // a thread not started via Thread, e.g. of a library
+        char name[16] = {0};
+        prctl(PR_GET_NAME, name, 0, 0, 0);
+        copyName(sample.thread, sizeof(sample.thread), name);
+      } else {
+        copyName(sample.thread, sizeof(sample.thread), thread->name().c_str());
+
+        WorkStack* stack = thread->workStack();
+        WorkDescription* desc =
+            (stack == nullptr) ? nullptr : stack->topIfStable();
+
+        if (desc != nullptr) {
+          switch (desc->_type) {
+            case WorkType::HANDLER:
+              copyName(sample.work, sizeof(sample.work),
+                       WorkMonitor::handlerName(desc));
+              break;
+            case WorkType::AQL_STRING:
+            case WorkType::AQL_ID:
+              copyName(sample.work, sizeof(sample.work), "AQL");
+              break;
+            case WorkType::CUSTOM:
+              copyName(sample.work, sizeof(sample.work),
+                       desc->_data._custom._type);
+              break;
+            case WorkType::THREAD:
+              break;
+          }
+        }
+      }
+    }
+  }
+
+  ActiveHandlers.fetch_sub(1);
+  errno = savedErrno;
+}
+
+/// @brief the name of the function an address belongs to, or the module
+/// and the offset in it if the function has no dynamic symbol
+std::string symbolize(void* address) {
+  Dl_info info;
+
+  if (dladdr(address, &info) != 0) {
+    if (info.dli_sname != nullptr) {
+      int status = 0;
+      char* demangled =
+          abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+      std::string name(status == 0 && demangled != nullptr ? demangled
+                                                           : info.dli_sname);
+      if (demangled != nullptr) {
+        TRI_SystemFree(demangled);
+      }
+      return name;
+    }
+
+    if (info.dli_fname != nullptr) {
+      char const* module = strrchr(info.dli_fname, '/');
+      module = (module == nullptr) ? info.dli_fname : module + 1;
+
+      char offset[32];
+      snprintf(offset, sizeof(offset), "+0x%llx",
+               static_cast<unsigned long long>(
+                   reinterpret_cast<uintptr_t>(address) -
+                   reinterpret_cast<uintptr_t>(info.dli_fbase)));
+      return std::string(module) + offset;
+    }
+  }
+
+  char hex[32];
+  snprintf(hex, sizeof(hex), "0x%llx", static_cast<unsigned long long>(
+                                           reinterpret_cast<uintptr_t>(address)));
+  return std::string(hex);
+}
+
+/// @brief append a frame to a folded stack. semicolons separate the frames
+void appendFrame(std::string& stack, std::string const& frame) {
+  if (!stack.empty()) {
+    stack.push_back(';');
+  }
+  for (char c : frame) {
+    stack.push_back(c == ';' ? ':' : c);
+  }
+}
+}
+
+#endif
+
+bool CpuProfiler::isSupported() {
+#ifdef ARANGODB_CPU_PROFILER
+  return true;
+#else
+  return false;
+#endif
+}
+
+void CpuProfiler::registerThread() {
+#ifdef ARANGODB_CPU_PROFILER
+  ProfiledThread const self{pthread_self(),
+                            static_cast<pid_t>(syscall(SYS_gettid))};
+  {
+    MUTEX_LOCKER(guard, ThreadsLock);
+    Threads.emplace_back(self);
+  }
+
+  sigset_t set;
+  sigemptyset(&set);
+  sigaddset(&set, SIGPROF);
+  pthread_sigmask(SIG_UNBLOCK, &set, nullptr);
+#endif
+}
+
+void CpuProfiler::unregisterThread() {
+#ifdef ARANGODB_CPU_PROFILER
+  // a timer of a running profile stays behind, but the CPU clock of an
+  // ended thread does not advance, so it never fires
+  sigset_t set;
+  sigemptyset(&set);
+  sigaddset(&set, SIGPROF);
+  pthread_sigmask(SIG_BLOCK, &set, nullptr);
+
+  pthread_t const self = pthread_self();
+
+  MUTEX_LOCKER(guard, ThreadsLock);
+  for (auto it = Threads.begin(); it != Threads.end(); ++it) {
+    if (pthread_equal((*it).thread, self)) {
+      Threads.erase(it);
+      break;
+    }
+  }
+#endif
+}
+
+int CpuProfiler::profile(double seconds, uint64_t frequency,
+                         std::string& result) {
+#ifdef ARANGODB_CPU_PROFILER
+  if (seconds <= 0.0 || seconds > MaxSeconds || frequency == 0 ||
+      frequency > MaxFrequency) {
+    return TRI_ERROR_BAD_PARAMETER;
+  }
+
+  bool expected = false;
+  if (!Running.compare_exchange_strong(expected, true)) {
+    return TRI_ERROR_LOCKED;
+  }
+  TRI_DEFER(Running.store(false));
+
+  // all threads together may consume a CPU second per core and second
+  size_t const cpus =
+      (std::max)(static_cast<size_t>(std::thread::hardware_concurrency()),
+                 static_cast<size_t>(1));
+  size_t const capacity = (std::min)(
+      MaxSamples,
+      static_cast<size_t>(seconds * static_cast<double>(frequency * cpus)) + 1);
+  std::vector<Sample> samples(capacity);
+
+  // backtrace() loads libgcc when it is called for the first time, which
+  // must not happen in the signal handler
+  void* frame;
+  backtrace(&frame, 1);
+
+  Samples = samples.data();
+  Capacity = capacity;
+  NumSamples.store(0);
+  Sampling.store(true);
+
+  struct sigaction action;
+  struct sigaction previous;
+  memset(&action, 0, sizeof(action));
+  action.sa_handler = signalHandler;
+  action.sa_flags = SA_RESTART;
+  sigemptyset(&action.sa_mask);
+
+  if (sigaction(SIGPROF, &action, &previous) != 0) {
+    Sampling.store(false);
+    Samples = nullptr;
+    Capacity = 0;
+    return TRI_ERROR_SYS_ERROR;
+  }
+
+  uint64_t const interval = 1000000000 / frequency;
+  struct itimerspec spec;
+  spec.it_interval.tv_sec = static_cast<time_t>(interval / 1000000000);
+  spec.it_interval.tv_nsec = static_cast<long>(interval % 1000000000);
+  spec.it_value = spec.it_interval;
+
+  int res = TRI_ERROR_NO_ERROR;
+
+  // one timer per registered thread, on the CPU clock of the thread, which
+  // sends SIGPROF to that thread only
+  std::vector<timer_t> timers;
+  {
+    MUTEX_LOCKER(guard, ThreadsLock);
+    timers.reserve(Threads.size());
+
+    for (auto const& it : Threads) {
+      clockid_t clock;
+      if (pthread_getcpuclockid(it.thread, &clock) != 0) {
+        continue;
+      }
+
+      struct sigevent event;
+      memset(&event, 0, sizeof(event));
+      event.sigev_notify = SIGEV_THREAD_ID;
+      event.sigev_signo = SIGPROF;
+      event.sigev_notify_thread_id = it.tid;
+
+      timer_t timer;
+      if (timer_create(clock, &event, &timer) != 0) {
+        res = TRI_ERROR_SYS_ERROR;
+        break;
+      }
+      timers.emplace_back(timer);
+
+      if (timer_settime(timer, 0, &spec, nullptr) != 0) {
+        res = TRI_ERROR_SYS_ERROR;
+        break;
+      }
+    }
+  }
+
+  if (res == TRI_ERROR_NO_ERROR) {
+    std::this_thread::sleep_for(std::chrono::duration<double>(seconds));
+  }
+
+  for (auto& it : timers) {
+    timer_delete(it);
+  }
+
+  // wait for the handlers that are still recording
+  Sampling.store(false);
+  while (ActiveHandlers.load() > 0) {
+    std::this_thread::yield();
+  }
+
+  // a signal may still be pending. the default action of SIGPROF would
+  // terminate the process, so it is ignored unless somebody else had
+  // installed a handler
+  if (!(previous.sa_flags & SA_SIGINFO) && previous.sa_handler == SIG_DFL) {
+    previous.sa_handler = SIG_IGN;
+  }
+  sigaction(SIGPROF, &previous, nullptr);
+
+  Samples = nullptr;
+  Capacity = 0;
+
+  if (res != TRI_ERROR_NO_ERROR) {
+    return res;
+  }
+
+  size_t const taken = NumSamples.load();
+  size_t const recorded = (std::min)(taken, capacity);
+
+  if (recorded < taken) {
+    LOG_TOPIC(WARN, arangodb::Logger::FIXME)
+        << "CPU profile dropped " << (taken - recorded) << " of " << taken
+        << " samples";
+  }
+
+  // aggregate the samples by stack, and resolve every address only once
+  std::unordered_map<void*, std::string> symbols;
+  std::map<std::string, uint64_t> stacks;
+
+  for (size_t i = 0; i < recorded; ++i) {
+    Sample const& sample = samples[i];
+
+    std::string stack;
+    appendFrame(stack, sample.thread[0] == '\0' ? "unknown" : sample.thread);
+    if (sample.work[0] != '\0') {
+      appendFrame(stack, sample.work);
+    }
+
+    for (int f = sample.depth - 1; f >= HandlerFrames; --f) {
+      void* address = sample.frames[f];
+      auto it = symbols.find(address);
+
+      if (it == symbols.end()) {
+        // all frames but the interrupted one hold return addresses, which
+        // may already belong to the next function
+        void* lookup = (f == HandlerFrames)
+                           ? address
+                           : static_cast<void*>(static_cast<char*>(address) - 1);
+        it = symbols.emplace(address, symbolize(lookup)).first;
+      }
+
+      appendFrame(stack, (*it).second);
+    }
+
+    ++stacks[stack];
+  }
+
+  for (auto const& it : stacks) {
+    result.append(it.first);
+    result.push_back(' ');
+    result.append(std::to_string(it.second));
+    result.push_back('\n');
+  }
+
+  LOG_TOPIC(DEBUG, arangodb::Logger::FIXME)
+      << "took CPU profile of " << seconds << " s with " << recorded
+      << " samples in " << stacks.size() << " distinct stacks";
+
+  return TRI_ERROR_NO_ERROR;
+#else
+  return TRI_ERROR_NOT_IMPLEMENTED;
+#endif
+}
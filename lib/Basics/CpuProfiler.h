@@ -0,0 +1,84 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGODB_BASICS_CPU_PROFILER_H
+#define ARANGODB_BASICS_CPU_PROFILER_H 1
+
+#include "Basics/Common.h"
+
+namespace arangodb {
+namespace basics {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief a sampling CPU profiler for the threads that registered with it.
+/// Only registered threads unblock SIGPROF. While a profile is taken, each
+/// of them gets a timer on its own CPU clock that sends SIGPROF to it, so
+/// threads are sampled in proportion to the CPU time they consume. The
+/// signal handler records the stack of the interrupted thread together with
+/// the name of the thread and its current work description into
+/// preallocated memory. Nothing is installed while no profile is taken.
+/// Only available on Linux with glibc.
+////////////////////////////////////////////////////////////////////////////////
+
+class CpuProfiler {
+ public:
+  CpuProfiler() = delete;
+
+  /// @brief the maximal number of frames recorded per sample
+  static constexpr size_t MaxFrames = 64;
+
+  /// @brief the maximal number of samples recorded per profile. further
+  /// samples are dropped
+  static constexpr size_t MaxSamples = 50000;
+
+  /// @brief the maximal duration of a profile in seconds, and the maximal
+  /// number of samples per CPU second
+  static constexpr double MaxSeconds = 60.0;
+  static constexpr uint64_t MaxFrequency = 1000;
+
+  /// @brief whether profiles can be taken on this platform
+  static bool isSupported();
+
+  /// @brief makes the calling thread part of all following profiles. the
+  /// thread must call unregisterThread() before it ends
+  static void registerThread();
+
+  /// @brief removes the calling thread from profiles
+  static void unregisterThread();
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief sample the registered threads for the given number of seconds,
+  /// taking the given number of samples per CPU second, and return the
+  /// stacks in the folded format of flame graph tools: one line per distinct
+  /// stack, with the frames from the outermost to the innermost separated by
+  /// semicolons, followed by a space and the number of samples. The first
+  /// frame is the name of the thread, followed by its current work if it
+  /// has any. Functions without a dynamic symbol are reported as module
+  /// and offset. Blocks the calling thread for the duration of the
+  /// profile. Returns TRI_ERROR_LOCKED if another profile is being taken
+  //////////////////////////////////////////////////////////////////////////////
+
+  static int profile(double seconds, uint64_t frequency, std::string& result);
+};
+}
+}
+
+#endif
@@ -26,6 +26,9 @@
 #define ARANGODB_BASICS_INDEX_BUCKET_H 1
 
 #include "Basics/Common.h"
+#include "Basics/LargePages.h"
+#include "Basics/MemoryArenas.h"
+#include "Basics/NumaTopology.h"
 #include "Basics/files.h"
 #include "Basics/memory-map.h"
 #include "Logger/Logger.h"
@@ -158,7 +161,30 @@ struct IndexBucket {
     TRI_ASSERT(numberElements > 0);
     
     if (_file == -1) {
-      return new EntryType[numberElements]();
+      // large tables are probed randomly, and are put on huge pages to
+      // save TLB misses. index tables are long-lived, so all others come
+      // from the index arena
+      void* data = LargePages::allocate(requiredSize(numberElements));
+
+      if (data == nullptr) {
+        data = MemoryArenas::allocateIndexMemory(requiredSize(numberElements));
+      }
+
+      if (data == nullptr) {
+        THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+      }
+
+      // an index is used by the threads of all nodes, so its pages are
+      // spread across the nodes instead of all landing on this one
+      NumaTopology::interleave(data, requiredSize(numberElements));
+
+      EntryType* table = static_cast<EntryType*>(data);
+
+      for (size_t i = 0; i < numberElements; ++i) {
+        new (&table[i]) EntryType();
+      }
+
+      return table;
     }
     
     size_t const totalSize = requiredSize(numberElements);
@@ -177,6 +203,8 @@ struct IndexBucket {
 
     TRI_ASSERT(data != nullptr);
 
+    NumaTopology::interleave(data, totalSize);
+
     try {
       // call placement new constructor
       (void) new (data) EntryType[numberElements]();
@@ -197,7 +225,12 @@ struct IndexBucket {
     } 
 
     if (_file == -1) {
-      delete[] _table;
+      for (size_t i = 0; i < static_cast<size_t>(_nrAlloc); ++i) {
+        _table[i].~EntryType();
+      }
+      if (!LargePages::free(_table)) {
+        MemoryArenas::freeIndexMemory(_table);
+      }
     } else {
       if (TRI_UNMMFile(_table, requiredSize(_nrAlloc), _file, &_mmHandle) != TRI_ERROR_NO_ERROR) { 
         // unmapping failed
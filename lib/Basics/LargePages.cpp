@@ -0,0 +1,263 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "LargePages.h"
+
+#include "Basics/Mutex.h"
+#include "Basics/MutexLocker.h"
+#include "Logger/Logger.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/velocypack-aliases.h>
+
+#include <fstream>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+using namespace arangodb;
+using namespace arangodb::basics;
+
+size_t const LargePages::MinSize = 2 * 1024 * 1024;
+
+namespace {
+size_t const TwoMB = 2 * 1024 * 1024;
+size_t const OneGB = 1024 * 1024 * 1024;
+
+std::atomic<LargePages::Mode> CurrentMode(LargePages::Mode::TRANSPARENT);
+
+/// @brief number of tables for which mapping failed
+std::atomic<uint64_t> Failures(0);
+
+struct Mapping {
+  size_t length;
+  bool reserved;
+};
+
+/// @brief the mapped tables. tables are allocated rarely, so a mutex does
+/// not hurt, and free() does not need the size from the caller
+Mutex MappingsLock;
+std::unordered_map<void*, Mapping> Mappings;
+
+size_t roundUp(size_t value, size_t alignment) {
+  return (value + alignment - 1) & ~(alignment - 1);
+}
+
+#ifdef __linux__
+/// @brief map pages reserved with vm.nr_hugepages
+void* mapReserved(size_t size, size_t& length) {
+#ifdef MAP_HUGETLB
+  int const flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB;
+
+#ifdef MAP_HUGE_1GB
+  if (size >= OneGB) {
+    length = roundUp(size, OneGB);
+    void* memory = mmap(nullptr, length, PROT_READ | PROT_WRITE,
+                        flags | MAP_HUGE_1GB, -1, 0);
+
+    if (memory != MAP_FAILED) {
+      return memory;
+    }
+  }
+#endif
+
+  length = roundUp(size, TwoMB);
+#ifdef MAP_HUGE_2MB
+  void* memory = mmap(nullptr, length, PROT_READ | PROT_WRITE,
+                      flags | MAP_HUGE_2MB, -1, 0);
+#else
+  void* memory =
+      mmap(nullptr, length, PROT_READ | PROT_WRITE, flags, -1, 0);
+#endif
+
+  if (memory != MAP_FAILED) {
+    return memory;
+  }
+#endif
+
+  return nullptr;
+}
+
+/// @brief map 2 MB aligned memory and ask for transparent huge pages. the
+/// kernel can only use a huge page for an aligned 2 MB range, so more is
+/// mapped and the surplus at both ends is returned right away
+void* mapTransparent(size_t size, size_t& length) {
+  length = roundUp(size, TwoMB);
+
+  void* memory = mmap(nullptr, length + TwoMB, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+  if (memory == MAP_FAILED) {
+    return nullptr;
+  }
+
+  uintptr_t const base = reinterpret_cast<uintptr_t>(memory);
+  uintptr_t const start = roundUp(base, TwoMB);
+  size_t const head = start - base;
+
+  if (head > 0) {
+    munmap(memory, head);
+  }
+  if (TwoMB - head > 0) {
+    munmap(reinterpret_cast<void*>(start + length), TwoMB - head);
+  }
+
+#ifdef MADV_HUGEPAGE
+  // fails if the kernel has no transparent huge pages, and the memory is
+  // then used with small pages
+  madvise(reinterpret_cast<void*>(start), length, MADV_HUGEPAGE);
+#endif
+
+  return reinterpret_cast<void*>(start);
+}
+#endif
+
+/// @brief the transparent huge page setting of the kernel, i.e. the value
+/// in brackets of "always [madvise] never"
+std::string transparentSetting() {
+  std::ifstream in("/sys/kernel/mm/transparent_hugepage/enabled");
+  std::string line;
+  std::getline(in, line);
+
+  size_t const open = line.find('[');
+  size_t const close = line.find(']', open);
+
+  if (open == std::string::npos || close == std::string::npos) {
+    return "unavailable";
+  }
+  return line.substr(open + 1, close - open - 1);
+}
+}
+
+void LargePages::setMode(Mode mode) { CurrentMode.store(mode); }
+
+LargePages::Mode LargePages::mode() { return CurrentMode.load(); }
+
+void* LargePages::allocate(size_t size) {
+  Mode const current = mode();
+
+  if (current == Mode::OFF || size < MinSize) {
+    return nullptr;
+  }
+
+#ifdef __linux__
+  size_t length = 0;
+  bool reserved = false;
+  void* memory = nullptr;
+
+  if (current == Mode::EXPLICIT) {
+    memory = mapReserved(size, length);
+    reserved = (memory != nullptr);
+  }
+
+  if (memory == nullptr) {
+    memory = mapTransparent(size, length);
+  }
+
+  if (memory == nullptr) {
+    ++Failures;
+    return nullptr;
+  }
+
+  try {
+    MUTEX_LOCKER(guard, MappingsLock);
+    Mappings.emplace(memory, Mapping{length, reserved});
+  } catch (...) {
+    munmap(memory, length);
+    ++Failures;
+    return nullptr;
+  }
+
+  return memory;
+#else
+  return nullptr;
+#endif
+}
+
+bool LargePages::free(void* memory) {
+  if (memory == nullptr) {
+    return false;
+  }
+
+#ifdef __linux__
+  size_t length;
+  {
+    MUTEX_LOCKER(guard, MappingsLock);
+    auto it = Mappings.find(memory);
+
+    if (it == Mappings.end()) {
+      return false;
+    }
+
+    length = (*it).second.length;
+    Mappings.erase(it);
+  }
+
+  if (munmap(memory, length) != 0) {
+    LOG_TOPIC(WARN, arangodb::Logger::MEMORY)
+        << "cannot unmap table memory: " << strerror(errno);
+  }
+
+  return true;
+#else
+  return false;
+#endif
+}
+
+void LargePages::toVelocyPack(VPackBuilder& builder) {
+  uint64_t tables = 0;
+  uint64_t reservedBytes = 0;
+  uint64_t transparentBytes = 0;
+  {
+    MUTEX_LOCKER(guard, MappingsLock);
+
+    for (auto const& it : Mappings) {
+      ++tables;
+      if (it.second.reserved) {
+        reservedBytes += it.second.length;
+      } else {
+        transparentBytes += it.second.length;
+      }
+    }
+  }
+
+  char const* name = "off";
+  switch (mode()) {
+    case Mode::TRANSPARENT:
+      name = "transparent";
+      break;
+    case Mode::EXPLICIT:
+      name = "explicit";
+      break;
+    case Mode::OFF:
+      break;
+  }
+
+  builder.openObject();
+  builder.add("mode", VPackValue(name));
+  builder.add("transparentHugePages", VPackValue(transparentSetting()));
+  builder.add("tables", VPackValue(tables));
+  builder.add("reservedBytes", VPackValue(reservedBytes));
+  builder.add("transparentBytes", VPackValue(transparentBytes));
+  builder.add("failures", VPackValue(Failures.load()));
+  builder.close();
+}
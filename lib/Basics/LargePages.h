@@ -0,0 +1,77 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGODB_BASICS_LARGE_PAGES_H
+#define ARANGODB_BASICS_LARGE_PAGES_H 1
+
+#include "Basics/Common.h"
+
+namespace arangodb {
+namespace velocypack {
+class Builder;
+}
+
+namespace basics {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief memory for large, long-lived tables (index and cache tables) on
+/// huge pages. Random probes into such a table miss the TLB on almost every
+/// access with 4 KB pages, while a 2 MB page covers 512 times as much.
+/// Tables of at least MinSize bytes are mapped directly:
+/// - TRANSPARENT: 2 MB aligned anonymous memory with madvise(MADV_HUGEPAGE),
+///   so the kernel backs it with transparent huge pages when it can. This
+///   needs no configuration and falls back to small pages by itself.
+/// - EXPLICIT: pages reserved with vm.nr_hugepages (MAP_HUGETLB), 1 GB
+///   pages for tables of at least 1 GB if the kernel has them. Falls back
+///   to TRANSPARENT if no pages are available.
+/// allocate() returns nullptr for smaller tables, with OFF, on other
+/// platforms and if mapping fails. The caller then uses its usual
+/// allocator. The memory is zero-filled
+////////////////////////////////////////////////////////////////////////////////
+
+class LargePages {
+ public:
+  LargePages() = delete;
+
+  enum class Mode { OFF, TRANSPARENT, EXPLICIT };
+
+  /// @brief the smallest table that is put on huge pages
+  static size_t const MinSize;
+
+  static void setMode(Mode);
+  static Mode mode();
+
+  /// @brief map memory for a table, nullptr if the caller must allocate
+  /// it itself
+  static void* allocate(size_t size);
+
+  /// @brief release memory if it came from allocate(). returns false for
+  /// other memory, which the caller must free itself
+  static bool free(void* memory);
+
+  /// @brief the mode, the number and size of the tables on huge pages, and
+  /// the transparent huge page setting of the kernel
+  static void toVelocyPack(arangodb::velocypack::Builder&);
+};
+}
+}
+
+#endif
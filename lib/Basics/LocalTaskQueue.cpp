@@ -32,7 +32,8 @@ using namespace arangodb::basics;
 /// @brief create a task tied to the specified queue
 ////////////////////////////////////////////////////////////////////////////////
 
-LocalTask::LocalTask(LocalTaskQueue* queue) : _queue(queue) {}
+LocalTask::LocalTask(LocalTaskQueue* queue)
+    : _queue(queue), _claimed(false) {}
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief dispatch this task to the underlying io_service
@@ -40,7 +41,11 @@ LocalTask::LocalTask(LocalTaskQueue* queue) : _queue(queue) {}
 
 void LocalTask::dispatch() {
   auto self = shared_from_this();
-  _queue->ioService()->post([self, this]() { run(); });
+  _queue->ioService()->post([self, this]() {
+    if (claim()) {
+      run();
+    }
+  });
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -49,7 +54,7 @@ void LocalTask::dispatch() {
 
 LocalCallbackTask::LocalCallbackTask(LocalTaskQueue* queue,
                                      std::function<void()> cb)
-    : _queue(queue), _cb(cb) {}
+    : _queue(queue), _cb(cb), _claimed(false) {}
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief run the callback and join
@@ -69,7 +74,11 @@ void LocalCallbackTask::run() {
 
 void LocalCallbackTask::dispatch() {
   auto self = shared_from_this();
-  _queue->ioService()->post([self, this]() { run(); });
+  _queue->ioService()->post([self, this]() {
+    if (claim()) {
+      run();
+    }
+  });
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -83,9 +92,7 @@ LocalTaskQueue::LocalTaskQueue(boost::asio::io_service* ioService)
       _condition(),
       _mutex(),
       _missing(0),
-      _status(TRI_ERROR_NO_ERROR) {
-  TRI_ASSERT(_ioService != nullptr);
-}
+      _status(TRI_ERROR_NO_ERROR) {}
 
 //////////////////////////////////////////////////////////////////////////////
 /// @brief exposes underlying io_service
@@ -130,26 +137,49 @@ void LocalTaskQueue::join() {
   _condition.signal();
 }
 
-//////////////////////////////////////////////////////////////////////////////
-/// @brief dispatch all tasks, including those that are queued while running,
-/// and wait for all tasks to join; then dispatch all callback tasks and wait
-/// for them to join
-//////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+/// @brief run the tasks that have not been claimed by a thread of the
+/// io_service. returns whether or not any task was run
+////////////////////////////////////////////////////////////////////////////////
 
-void LocalTaskQueue::dispatchAndWait() {
-  // regular task loop
-  if (!_queue.empty()) {
-    while (true) {
+template <typename T>
+static bool runUnclaimed(std::vector<std::shared_ptr<T>>& tasks) {
+  bool ran = false;
+  for (auto& task : tasks) {
+    if (task->claim()) {
+      task->run();
+      ran = true;
+    }
+  }
+  tasks.clear();
+  return ran;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief dispatch the tasks of one of the queues and wait for them
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename T>
+void LocalTaskQueue::dispatchAndWait(std::queue<std::shared_ptr<T>>& queue,
+                                     bool checkStatus) {
+  // the dispatched tasks that may not have been started yet
+  std::vector<std::shared_ptr<T>> dispatched;
+
+  while (true) {
+    {
       CONDITION_LOCKER(guard, _condition);
 
       {
         MUTEX_LOCKER(locker, _mutex);
         // dispatch all newly queued tasks
-        if (_status == TRI_ERROR_NO_ERROR) {
-          while (!_queue.empty()) {
-            auto task = _queue.front();
-            task->dispatch();
-            _queue.pop();
+        if (!checkStatus || _status == TRI_ERROR_NO_ERROR) {
+          while (!queue.empty()) {
+            auto task = queue.front();
+            if (_ioService != nullptr) {
+              task->dispatch();
+            }
+            dispatched.emplace_back(task);
+            queue.pop();
             ++_missing;
           }
         }
@@ -159,32 +189,48 @@ void LocalTaskQueue::dispatchAndWait() {
         break;
       }
 
-      guard.wait(100000);
+      if (_ioService != nullptr && !_ioService->stopped()) {
+        guard.wait(100000);
+
+        dispatched.erase(
+            std::remove_if(dispatched.begin(), dispatched.end(),
+                           [](std::shared_ptr<T> const& task) {
+                             return task->claimed();
+                           }),
+            dispatched.end());
+        continue;
+      }
     }
-  }
 
-  // callback task loop
-  if (!_callbackQueue.empty()) {
-    while (true) {
+    // the io_service is stopped, e.g. because the server is shutting down,
+    // and will not run the tasks posted to it anymore. the tasks run here
+    // join the queue themselves, so the condition must not be held
+    if (!runUnclaimed(dispatched)) {
+      // the remaining tasks are running on threads of the io_service
       CONDITION_LOCKER(guard, _condition);
-
-      {
-        MUTEX_LOCKER(locker, _mutex);
-        // dispatch all newly queued callbacks
-        while (!_callbackQueue.empty()) {
-          auto task = _callbackQueue.front();
-          task->dispatch();
-          _callbackQueue.pop();
-          ++_missing;
-        }
+      if (_missing > 0) {
+        guard.wait(100000);
       }
+    }
+  }
+}
 
-      if (_missing == 0) {
-        break;
-      }
+//////////////////////////////////////////////////////////////////////////////
+/// @brief dispatch all tasks, including those that are queued while running,
+/// and wait for all tasks to join; then dispatch all callback tasks and wait
+/// for them to join. if the io_service is stopped, e.g. at shutdown, the
+/// tasks it has not started are run by the calling thread
+//////////////////////////////////////////////////////////////////////////////
 
-      guard.wait(100000);
-    }
+void LocalTaskQueue::dispatchAndWait() {
+  // regular task loop
+  if (!_queue.empty()) {
+    dispatchAndWait(_queue, true);
+  }
+
+  // callback task loop
+  if (!_callbackQueue.empty()) {
+    dispatchAndWait(_callbackQueue, false);
   }
 }
 
@@ -49,12 +49,23 @@ class LocalTask : public std::enable_shared_from_this<LocalTask> {
   virtual void run() = 0;
   void dispatch();
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief claim the task for running. returns false if it has been claimed
+  /// by another thread already
+  //////////////////////////////////////////////////////////////////////////////
+
+  bool claim() { return !_claimed.exchange(true); }
+  bool claimed() const { return _claimed.load(); }
+
  protected:
   //////////////////////////////////////////////////////////////////////////////
   /// @brief the underlying queue
   //////////////////////////////////////////////////////////////////////////////
 
   LocalTaskQueue* _queue;
+
+ private:
+  std::atomic<bool> _claimed;
 };
 
 class LocalCallbackTask
@@ -70,6 +81,14 @@ class LocalCallbackTask
   virtual void run();
   void dispatch();
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief claim the task for running. returns false if it has been claimed
+  /// by another thread already
+  //////////////////////////////////////////////////////////////////////////////
+
+  bool claim() { return !_claimed.exchange(true); }
+  bool claimed() const { return _claimed.load(); }
+
  protected:
   //////////////////////////////////////////////////////////////////////////////
   /// @brief the underlying queue
@@ -83,6 +102,9 @@ class LocalCallbackTask
   //////////////////////////////////////////////////////////////////////////////
 
   std::function<void()> _cb;
+
+ private:
+  std::atomic<bool> _claimed;
 };
 
 class LocalTaskQueue {
@@ -90,6 +112,11 @@ class LocalTaskQueue {
   LocalTaskQueue(LocalTaskQueue const&) = delete;
   LocalTaskQueue& operator=(LocalTaskQueue const&) = delete;
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief create a queue. without an io_service, all tasks are run by the
+  /// thread calling dispatchAndWait()
+  //////////////////////////////////////////////////////////////////////////////
+
   explicit LocalTaskQueue(boost::asio::io_service*);
 
   ~LocalTaskQueue();
@@ -123,7 +150,8 @@ class LocalTaskQueue {
   //////////////////////////////////////////////////////////////////////////////
   /// @brief dispatch all tasks, including those that are queued while running,
   /// and wait for all tasks to join; then dispatch all callback tasks and wait
-  /// for them to join
+  /// for them to join. if the io_service is stopped, e.g. at shutdown, the
+  /// tasks it has not started are run by the calling thread
   //////////////////////////////////////////////////////////////////////////////
 
   void dispatchAndWait();
@@ -141,6 +169,13 @@ class LocalTaskQueue {
   int status();
 
  private:
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief dispatch the tasks of one of the queues and wait for them
+  //////////////////////////////////////////////////////////////////////////////
+
+  template <typename T>
+  void dispatchAndWait(std::queue<std::shared_ptr<T>>&, bool checkStatus);
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief io_service to dispatch tasks to
   //////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,270 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "MemoryArenas.h"
+
+#include "Basics/LargePages.h"
+#include "Logger/Logger.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Value.h>
+#include <velocypack/velocypack-aliases.h>
+
+#ifdef ARANGODB_HAVE_JEMALLOC
+#include <jemalloc/jemalloc.h>
+#endif
+
+using namespace arangodb;
+using namespace arangodb::basics;
+
+#ifdef ARANGODB_HAVE_JEMALLOC
+
+namespace {
+/// @brief the index of the arena for index tables, -1 if there is none
+std::atomic<int> IndexArena(-1);
+
+template <typename T>
+bool readValue(std::string const& name, T& value) {
+  size_t size = sizeof(T);
+  return mallctl(name.c_str(), &value, &size, nullptr, 0) == 0;
+}
+
+template <typename T>
+int writeValue(std::string const& name, T value) {
+  int res = mallctl(name.c_str(), nullptr, nullptr, &value, sizeof(T));
+
+  if (res != 0) {
+    LOG_TOPIC(DEBUG, Logger::MEMORY) << "cannot set jemalloc value '" << name
+                                     << "': " << strerror(res);
+    return TRI_ERROR_FAILED;
+  }
+  return TRI_ERROR_NO_ERROR;
+}
+
+/// @brief the number of arenas, including ones that are not in use yet
+unsigned numberOfArenas() {
+  unsigned n = 0;
+  readValue("arenas.narenas", n);
+  return n;
+}
+
+/// @brief read a size statistic of an arena, 0 if it is not available
+size_t arenaValue(unsigned arena, char const* name) {
+  size_t value = 0;
+  readValue("stats.arenas." + std::to_string(arena) + "." + name, value);
+  return value;
+}
+}
+
+bool MemoryArenas::enabled() { return true; }
+
+void MemoryArenas::initialize(bool useIndexArena) {
+  if (!useIndexArena || IndexArena.load() >= 0) {
+    return;
+  }
+
+  unsigned arena = 0;
+  size_t size = sizeof(arena);
+#if JEMALLOC_VERSION_MAJOR >= 5
+  int res = mallctl("arenas.create", &arena, &size, nullptr, 0);
+#else
+  int res = mallctl("arenas.extend", &arena, &size, nullptr, 0);
+#endif
+
+  if (res != 0) {
+    LOG_TOPIC(WARN, Logger::MEMORY)
+        << "cannot create jemalloc arena for indexes: " << strerror(res);
+    return;
+  }
+
+  LOG_TOPIC(DEBUG, Logger::MEMORY) << "using jemalloc arena " << arena
+                                   << " for indexes";
+  IndexArena = static_cast<int>(arena);
+}
+
+int MemoryArenas::setDecayTime(int64_t milliseconds) {
+  unsigned const n = numberOfArenas();
+
+#if JEMALLOC_VERSION_MAJOR >= 5
+  ssize_t const value = static_cast<ssize_t>(milliseconds);
+  // the default for arenas created later, then the existing ones. the
+  // loops stop early if jemalloc does not support decay at all
+  int res = writeValue("arenas.dirty_decay_ms", value);
+
+  for (unsigned i = 0; i < n && res == TRI_ERROR_NO_ERROR; ++i) {
+    writeValue("arena." + std::to_string(i) + ".dirty_decay_ms", value);
+  }
+#else
+  // jemalloc 4 counts in seconds, and only with opt.purge:decay
+  ssize_t const value =
+      static_cast<ssize_t>(milliseconds < 0 ? -1 : milliseconds / 1000);
+  int res = writeValue("arenas.decay_time", value);
+
+  for (unsigned i = 0; i < n && res == TRI_ERROR_NO_ERROR; ++i) {
+    writeValue("arena." + std::to_string(i) + ".decay_time", value);
+  }
+#endif
+
+  return res;
+}
+
+int MemoryArenas::setBackgroundThreads(bool enable) {
+#if JEMALLOC_VERSION_MAJOR >= 5
+  return writeValue("background_thread", enable);
+#else
+  return enable ? TRI_ERROR_NOT_IMPLEMENTED : TRI_ERROR_NO_ERROR;
+#endif
+}
+
+void* MemoryArenas::allocateIndexMemory(size_t size) {
+  TRI_ASSERT(size > 0);
+  int const arena = IndexArena.load(std::memory_order_relaxed);
+
+  if (arena < 0) {
+    return malloc(size);
+  }
+
+  // the thread caches of jemalloc belong to the thread's arena, so they
+  // are bypassed
+  return mallocx(size, MALLOCX_ARENA(static_cast<unsigned>(arena)) |
+                           MALLOCX_TCACHE_NONE);
+}
+
+void MemoryArenas::freeIndexMemory(void* memory) {
+  if (memory == nullptr) {
+    return;
+  }
+
+  // jemalloc finds the arena of an allocation itself
+  dallocx(memory, MALLOCX_TCACHE_NONE);
+}
+
+void MemoryArenas::toVelocyPack(VPackBuilder& builder) {
+  // statistics are only updated when the epoch is advanced
+  uint64_t epoch = 1;
+  size_t size = sizeof(epoch);
+  mallctl("epoch", &epoch, &size, &epoch, size);
+
+  size_t pageSize = 4096;
+  readValue("arenas.page", pageSize);
+
+  builder.openObject();
+  builder.add("enabled", VPackValue(true));
+  builder.add("version", VPackValue(JEMALLOC_VERSION));
+
+  for (auto const& name :
+       {"allocated", "active", "metadata", "resident", "mapped"}) {
+    size_t value = 0;
+    readValue(std::string("stats.") + name, value);
+    builder.add(name, VPackValue(value));
+  }
+
+  bool profiling = false;
+  readValue("opt.prof", profiling);
+  builder.add("profiling", VPackValue(profiling));
+
+#if JEMALLOC_VERSION_MAJOR >= 5
+  bool backgroundThreads = false;
+  readValue("background_thread", backgroundThreads);
+  builder.add("backgroundThreads", VPackValue(backgroundThreads));
+#endif
+
+  int const indexArena = IndexArena.load();
+
+  builder.add("arenas", VPackValue(VPackValueType::Array));
+  unsigned const n = numberOfArenas();
+
+  for (unsigned i = 0; i < n; ++i) {
+    unsigned threads = 0;
+    if (!readValue("stats.arenas." + std::to_string(i) + ".nthreads",
+                   threads)) {
+      // arena not initialized
+      continue;
+    }
+
+    size_t allocated =
+        arenaValue(i, "small.allocated") + arenaValue(i, "large.allocated");
+#if JEMALLOC_VERSION_MAJOR < 5
+    allocated += arenaValue(i, "huge.allocated");
+#endif
+
+    builder.openObject();
+    builder.add("id", VPackValue(i));
+    builder.add("purpose", VPackValue(static_cast<int>(i) == indexArena
+                                          ? "index"
+                                          : "default"));
+    builder.add("threads", VPackValue(threads));
+    builder.add("allocated", VPackValue(allocated));
+    builder.add("active", VPackValue(arenaValue(i, "pactive") * pageSize));
+    builder.add("dirty", VPackValue(arenaValue(i, "pdirty") * pageSize));
+    builder.add("mapped", VPackValue(arenaValue(i, "mapped")));
+    builder.close();
+  }
+
+  builder.close();  // arenas
+
+  builder.add(VPackValue("largePages"));
+  LargePages::toVelocyPack(builder);
+  builder.close();
+}
+
+int MemoryArenas::dumpProfile(std::string const& filename) {
+  bool profiling = false;
+
+  if (!readValue("opt.prof", profiling) || !profiling) {
+    return TRI_ERROR_NOT_IMPLEMENTED;
+  }
+
+  return writeValue("prof.dump", filename.c_str());
+}
+
+#else
+
+bool MemoryArenas::enabled() { return false; }
+
+void MemoryArenas::initialize(bool) {}
+
+int MemoryArenas::setDecayTime(int64_t) { return TRI_ERROR_NOT_IMPLEMENTED; }
+
+int MemoryArenas::setBackgroundThreads(bool enable) {
+  return enable ? TRI_ERROR_NOT_IMPLEMENTED : TRI_ERROR_NO_ERROR;
+}
+
+void* MemoryArenas::allocateIndexMemory(size_t size) {
+  TRI_ASSERT(size > 0);
+  return malloc(size);
+}
+
+void MemoryArenas::freeIndexMemory(void* memory) { free(memory); }
+
+void MemoryArenas::toVelocyPack(VPackBuilder& builder) {
+  builder.openObject();
+  builder.add("enabled", VPackValue(false));
+  builder.add(VPackValue("largePages"));
+  LargePages::toVelocyPack(builder);
+  builder.close();
+}
+
+int MemoryArenas::dumpProfile(std::string const&) {
+  return TRI_ERROR_NOT_IMPLEMENTED;
+}
+
+#endif
@@ -0,0 +1,84 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGODB_BASICS_MEMORY_ARENAS_H
+#define ARANGODB_BASICS_MEMORY_ARENAS_H 1
+
+#include "Basics/Common.h"
+
+namespace arangodb {
+namespace velocypack {
+class Builder;
+}
+
+namespace basics {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief access to the arenas of jemalloc, if the server is linked with it.
+/// The tables of the in-memory indexes live for a long time and are large,
+/// while most other allocations belong to a request or a query and are
+/// freed soon. Both mixed in the same arenas fragment them, so the index
+/// tables are allocated from an arena of their own. All other allocations
+/// stay in the automatic per-thread arenas of jemalloc.
+/// Without jemalloc, the functions use malloc and free, and report that
+/// there are no statistics.
+////////////////////////////////////////////////////////////////////////////////
+
+class MemoryArenas {
+ public:
+  MemoryArenas() = delete;
+
+  /// @brief whether the server uses jemalloc
+  static bool enabled();
+
+  /// @brief set up the arenas. must be called before the first index is
+  /// created. if useIndexArena is false, index memory is allocated like
+  /// all other memory
+  static void initialize(bool useIndexArena);
+
+  /// @brief set the time (in milliseconds) after which unused dirty pages
+  /// are returned to the operating system. -1 keeps them forever, 0 returns
+  /// them immediately. applies to all arenas
+  static int setDecayTime(int64_t milliseconds);
+
+  /// @brief let threads of jemalloc purge unused pages in the background,
+  /// instead of the threads that happen to allocate or free memory.
+  /// needs jemalloc 5
+  static int setBackgroundThreads(bool enable);
+
+  /// @brief allocate memory for an index table. returns nullptr if out of
+  /// memory
+  static void* allocateIndexMemory(size_t size);
+
+  /// @brief free memory allocated by allocateIndexMemory
+  static void freeIndexMemory(void* memory);
+
+  /// @brief global and per-arena statistics, as an object
+  static void toVelocyPack(velocypack::Builder&);
+
+  /// @brief write a heap profile to a file. needs a jemalloc built with
+  /// --enable-prof and the server started with MALLOC_CONF=prof:true
+  static int dumpProfile(std::string const& filename);
+};
+}
+}
+
+#endif
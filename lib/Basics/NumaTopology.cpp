@@ -0,0 +1,271 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "NumaTopology.h"
+
+#include "Basics/system-functions.h"
+#include "Logger/Logger.h"
+
+#include <fstream>
+
+#ifdef __linux__
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+using namespace arangodb;
+using namespace arangodb::basics;
+
+std::atomic<bool> NumaTopology::Enabled(false);
+
+namespace {
+
+/// @brief memory policies of mbind(2), which are declared in numaif.h of
+/// libnuma only
+int const PolicyPreferred = 1;
+int const PolicyInterleave = 3;
+
+/// @brief the largest number of nodes memory can be bound to
+size_t const MaxNodes = 256;
+
+struct Topology {
+  Topology() {
+    detect();
+
+    if (nodes.empty()) {
+      // one node with all CPUs
+      ids.clear();
+      ids.emplace_back(0);
+      nodes.emplace_back();
+
+      size_t const n = TRI_numberProcessors();
+      for (size_t i = 0; i < n; ++i) {
+        nodes.back().emplace_back(i);
+      }
+    }
+
+    for (size_t node = 0; node < nodes.size(); ++node) {
+      for (auto const& cpu : nodes[node]) {
+        if (cpu >= cpuToNode.size()) {
+          cpuToNode.resize(cpu + 1, 0);
+        }
+        cpuToNode[cpu] = node;
+      }
+    }
+  }
+
+  static std::string readFile(std::string const& filename) {
+    std::ifstream in(filename);
+    std::string result;
+    std::getline(in, result);
+    return result;
+  }
+
+  void detect() {
+#ifdef __linux__
+    std::string const base("/sys/devices/system/node/");
+
+    for (auto const& id : NumaTopology::parseCpuList(readFile(base + "online"))) {
+      if (id >= MaxNodes) {
+        continue;
+      }
+
+      auto cpus = NumaTopology::parseCpuList(
+          readFile(base + "node" + std::to_string(id) + "/cpulist"));
+
+      // nodes with memory only do not run threads
+      if (!cpus.empty()) {
+        ids.emplace_back(id);
+        nodes.emplace_back(std::move(cpus));
+      }
+    }
+#endif
+  }
+
+  /// @brief the node numbers of the kernel
+  std::vector<size_t> ids;
+
+  /// @brief the CPUs per node
+  std::vector<std::vector<size_t>> nodes;
+
+  std::vector<size_t> cpuToNode;
+};
+
+Topology const& topology() {
+  static Topology const instance;
+  return instance;
+}
+
+#ifdef __linux__
+void setMemoryPolicy(void* memory, size_t size, int policy,
+                     std::vector<size_t> const& nodes) {
+  uintptr_t const pageSize = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+  uintptr_t const start =
+      (reinterpret_cast<uintptr_t>(memory) + pageSize - 1) & ~(pageSize - 1);
+  uintptr_t const end =
+      (reinterpret_cast<uintptr_t>(memory) + size) & ~(pageSize - 1);
+
+  if (end <= start) {
+    return;
+  }
+
+  unsigned long mask[MaxNodes / (8 * sizeof(unsigned long))];
+  memset(&mask[0], 0, sizeof(mask));
+
+  for (auto const& node : nodes) {
+    auto const id = topology().ids[node];
+    mask[id / (8 * sizeof(unsigned long))] |=
+        1UL << (id % (8 * sizeof(unsigned long)));
+  }
+
+  // the pages are not moved, so memory that is in use already stays
+  // where it is. a failure is not worth more than a debug message
+  if (syscall(SYS_mbind, start, end - start, policy, &mask[0],
+              sizeof(mask) * 8 + 1, 0) != 0) {
+    LOG_TOPIC(DEBUG, arangodb::Logger::FIXME)
+        << "cannot set NUMA memory policy: " << strerror(errno);
+  }
+}
+#endif
+}
+
+bool NumaTopology::setEnabled(bool value) {
+  if (value && numberOfNodes() < 2) {
+    value = false;
+  }
+  Enabled.store(value);
+  return value;
+}
+
+size_t NumaTopology::numberOfNodes() { return topology().nodes.size(); }
+
+std::vector<size_t> const& NumaTopology::cpus(size_t node) {
+  TRI_ASSERT(node < numberOfNodes());
+  return topology().nodes[node];
+}
+
+size_t NumaTopology::nodeOfCpu(size_t cpu) {
+  auto const& cpuToNode = topology().cpuToNode;
+  return (cpu < cpuToNode.size()) ? cpuToNode[cpu] : 0;
+}
+
+size_t NumaTopology::currentNode() {
+#ifdef __linux__
+  int cpu = sched_getcpu();
+
+  if (cpu >= 0) {
+    return nodeOfCpu(static_cast<size_t>(cpu));
+  }
+#endif
+  return 0;
+}
+
+bool NumaTopology::bindCurrentThread(size_t node) {
+  TRI_ASSERT(node < numberOfNodes());
+
+#ifdef ARANGODB_HAVE_THREAD_AFFINITY
+  cpu_set_t cpuset;
+  CPU_ZERO(&cpuset);
+
+  for (auto const& cpu : cpus(node)) {
+    if (cpu < CPU_SETSIZE) {
+      CPU_SET(cpu, &cpuset);
+    }
+  }
+
+  int res = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuset);
+
+  if (res != 0) {
+    LOG_TOPIC(WARN, arangodb::Logger::THREADS)
+        << "cannot bind thread to NUMA node " << node << ": "
+        << strerror(res);
+    return false;
+  }
+
+  return true;
+#else
+  return false;
+#endif
+}
+
+void NumaTopology::preferNode(void* memory, size_t size, size_t node) {
+  if (!enabled()) {
+    return;
+  }
+
+  TRI_ASSERT(node < numberOfNodes());
+
+#ifdef __linux__
+  setMemoryPolicy(memory, size, PolicyPreferred, std::vector<size_t>{node});
+#endif
+}
+
+void NumaTopology::interleave(void* memory, size_t size) {
+  if (!enabled()) {
+    return;
+  }
+
+#ifdef __linux__
+  std::vector<size_t> nodes;
+  for (size_t i = 0; i < numberOfNodes(); ++i) {
+    nodes.emplace_back(i);
+  }
+
+  setMemoryPolicy(memory, size, PolicyInterleave, nodes);
+#endif
+}
+
+std::vector<size_t> NumaTopology::parseCpuList(std::string const& value) {
+  std::vector<size_t> result;
+  char const* p = value.c_str();
+
+  while (*p != '\0') {
+    while (*p == ' ' || *p == ',' || *p == '\n' || *p == '\t') {
+      ++p;
+    }
+
+    if (*p < '0' || *p > '9') {
+      // garbage ends the list
+      break;
+    }
+
+    char* end = nullptr;
+    size_t const first = static_cast<size_t>(strtoul(p, &end, 10));
+    size_t last = first;
+    p = end;
+
+    if (*p == '-') {
+      ++p;
+      if (*p < '0' || *p > '9') {
+        break;
+      }
+      last = static_cast<size_t>(strtoul(p, &end, 10));
+      p = end;
+    }
+
+    for (size_t i = first; i <= last && i - first < 65536; ++i) {
+      result.emplace_back(i);
+    }
+  }
+
+  return result;
+}
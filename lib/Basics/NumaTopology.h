@@ -0,0 +1,87 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGODB_BASICS_NUMA_TOPOLOGY_H
+#define ARANGODB_BASICS_NUMA_TOPOLOGY_H 1
+
+#include "Basics/Common.h"
+
+namespace arangodb {
+namespace basics {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the NUMA nodes of the machine and the CPUs that belong to them.
+/// The topology is read from /sys/devices/system/node once. On other
+/// platforms, or if the information is missing, all CPUs belong to one
+/// node. Memory placement does not need libnuma: threads are bound to the
+/// CPUs of a node, and the kernel places the pages they touch first on
+/// that node. Long-lived memory that is shared by the threads of all nodes
+/// can be interleaved explicitly.
+/// Nothing is changed unless NUMA awareness has been switched on with
+/// setEnabled(), and it cannot be switched on for a single node.
+////////////////////////////////////////////////////////////////////////////////
+
+class NumaTopology {
+ public:
+  NumaTopology() = delete;
+
+  /// @brief switch NUMA awareness on or off. returns whether it is on
+  static bool setEnabled(bool);
+
+  /// @brief whether threads and memory are placed per node
+  static bool enabled() { return Enabled.load(std::memory_order_relaxed); }
+
+  /// @brief the number of nodes, at least 1
+  static size_t numberOfNodes();
+
+  /// @brief the CPUs of a node
+  static std::vector<size_t> const& cpus(size_t node);
+
+  /// @brief the node a CPU belongs to, 0 for unknown CPUs
+  static size_t nodeOfCpu(size_t cpu);
+
+  /// @brief the node the calling thread is running on right now, 0 if
+  /// this cannot be determined
+  static size_t currentNode();
+
+  /// @brief restrict the calling thread to the CPUs of a node
+  static bool bindCurrentThread(size_t node);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief prefer a node for the pages of a memory region that have not
+  /// been touched yet, or interleave them across all nodes. these do
+  /// nothing if NUMA awareness is off. only whole pages inside the region
+  /// are affected
+  //////////////////////////////////////////////////////////////////////////////
+
+  static void preferNode(void* memory, size_t size, size_t node);
+  static void interleave(void* memory, size_t size);
+
+  /// @brief parse a CPU list as in sysfs, e.g. "0-3,8,10-11"
+  static std::vector<size_t> parseCpuList(std::string const&);
+
+ private:
+  static std::atomic<bool> Enabled;
+};
+}
+}
+
+#endif
@@ -0,0 +1,152 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "ReadMostlyLock.h"
+
+#include <thread>
+
+using namespace arangodb::basics;
+
+std::atomic<size_t> ReadMostlyLock::_nextSlot(0);
+
+thread_local int ReadMostlyLock::_mySlot = -1;
+
+namespace {
+/// @brief wait a bit for another thread. lock holders are short-lived, so
+/// yielding is tried first
+void backoff(uint64_t& tries) {
+  if (++tries < 64) {
+    std::this_thread::yield();
+  } else {
+    usleep(10);
+  }
+}
+}
+
+ReadMostlyLock::ReadMostlyLock()
+    : _slots(new Slot[NumSlots]), _writer(false), _writeLocked(false) {
+  for (size_t i = 0; i < NumSlots; ++i) {
+    _slots[i]._readers = 0;
+  }
+}
+
+ReadMostlyLock::~ReadMostlyLock() { delete[] _slots; }
+
+size_t ReadMostlyLock::mySlot() {
+  int slot = _mySlot;
+
+  if (slot < 0) {
+    // threads are distributed round-robin over the counters
+    slot = static_cast<int>(_nextSlot.fetch_add(1, std::memory_order_relaxed) %
+                            NumSlots);
+    _mySlot = slot;
+  }
+
+  return static_cast<size_t>(slot);
+}
+
+bool ReadMostlyLock::hasReaders() const {
+  for (size_t i = 0; i < NumSlots; ++i) {
+    if (_slots[i]._readers.load() != 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void ReadMostlyLock::readLock() {
+  uint64_t tries = 0;
+
+  while (!tryReadLock()) {
+    // wait for the writer to finish before incrementing the counter again,
+    // as the writer would otherwise wait for us
+    while (_writer.load()) {
+      backoff(tries);
+    }
+  }
+}
+
+bool ReadMostlyLock::tryReadLock() {
+  std::atomic<int64_t>& readers = _slots[mySlot()]._readers;
+
+  // the increment must become visible before the writer flag is checked,
+  // and the writer sets the flag before it checks the counters. both use
+  // sequential consistency, so at least one of them sees the other
+  readers.fetch_add(1);
+
+  if (!_writer.load()) {
+    return true;
+  }
+
+  readers.fetch_sub(1);
+  return false;
+}
+
+void ReadMostlyLock::writeLock() {
+  _writerLock.lock();
+  _writer.store(true);
+
+  uint64_t tries = 0;
+
+  while (hasReaders()) {
+    backoff(tries);
+  }
+
+  _writeLocked = true;
+}
+
+bool ReadMostlyLock::tryWriteLock() {
+  if (!_writerLock.tryLock()) {
+    return false;
+  }
+
+  _writer.store(true);
+
+  if (hasReaders()) {
+    _writer.store(false);
+    _writerLock.unlock();
+    return false;
+  }
+
+  _writeLocked = true;
+  return true;
+}
+
+void ReadMostlyLock::unlock() {
+  // while a writer holds the lock, there are no readers. so the caller must
+  // be the writer
+  if (_writeLocked) {
+    unlockWrite();
+  } else {
+    unlockRead();
+  }
+}
+
+void ReadMostlyLock::unlockRead() {
+  _slots[mySlot()]._readers.fetch_sub(1);
+}
+
+void ReadMostlyLock::unlockWrite() {
+  TRI_ASSERT(_writeLocked);
+  _writeLocked = false;
+  _writer.store(false);
+  _writerLock.unlock();
+}
@@ -0,0 +1,113 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGODB_BASICS_READ_MOSTLY_LOCK_H
+#define ARANGODB_BASICS_READ_MOSTLY_LOCK_H 1
+
+#include "Basics/Common.h"
+#include "Basics/Mutex.h"
+
+namespace arangodb {
+namespace basics {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief read-write lock for data that is read very often and changed
+/// rarely.
+/// Readers of a ReadWriteLock all modify the same cache line, so read
+/// locking does not scale with the number of cores. This lock has an array
+/// of reader counters instead, each in a cache line of its own, and every
+/// thread uses the same counter for the lifetime of the thread (as in
+/// DataProtector). A read lock thus only touches a cache line that is
+/// shared with few other threads. A writer announces itself, which keeps
+/// new readers out, and then waits until all counters have dropped to 0.
+/// Write locking is therefore much more expensive than with a
+/// ReadWriteLock, and the lock needs 4 KB of memory.
+/// It can be used with READ_LOCKER and WRITE_LOCKER. Writers are preferred,
+/// so a thread must not acquire a read lock it already holds: if a writer
+/// arrives in between, both would wait for each other forever.
+////////////////////////////////////////////////////////////////////////////////
+
+class ReadMostlyLock {
+  ReadMostlyLock(ReadMostlyLock const&) = delete;
+  ReadMostlyLock& operator=(ReadMostlyLock const&) = delete;
+
+ public:
+  ReadMostlyLock();
+  ~ReadMostlyLock();
+
+ public:
+  /// @brief locks for reading
+  void readLock();
+
+  /// @brief tries to lock for reading
+  bool tryReadLock();
+
+  /// @brief locks for writing
+  void writeLock();
+
+  /// @brief tries to lock for writing
+  bool tryWriteLock();
+
+  /// @brief releases the read-lock or write-lock
+  void unlock();
+
+  /// @brief releases the read-lock
+  void unlockRead();
+
+  /// @brief releases the write-lock
+  void unlockWrite();
+
+ private:
+  /// @brief number of reader counters
+  static constexpr size_t NumSlots = 64;
+
+  struct Slot {
+    std::atomic<int64_t> _readers;
+    // different counters must not share a cache line
+    char _padding[64 - sizeof(std::atomic<int64_t>)];
+  };
+
+  /// @brief the counter of the current thread
+  static size_t mySlot();
+
+  /// @brief whether there are readers left
+  bool hasReaders() const;
+
+ private:
+  Slot* _slots;
+
+  /// @brief set while a writer waits for or holds the lock
+  std::atomic<bool> _writer;
+
+  /// @brief write lock marker, only modified by the writer holding the lock
+  bool _writeLocked;
+
+  /// @brief serializes the writers
+  Mutex _writerLock;
+
+  static std::atomic<size_t> _nextSlot;
+
+  static thread_local int _mySlot;
+};
+}
+}
+
+#endif
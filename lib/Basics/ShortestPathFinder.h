@@ -484,17 +484,20 @@ class DynamicDistanceFinder : public PathFinder<VertexId, Path> {
     VertexId _start;
     ExpanderFunction _expander;
     std::string _id;
+    std::function<void()> const& _callback;
 
    public:
     SearcherTwoThreads(DynamicDistanceFinder* pathFinder, ThreadInfo& myInfo,
                        ThreadInfo& peerInfo, VertexId const& start,
-                       ExpanderFunction expander, std::string const& id)
+                       ExpanderFunction expander, std::string const& id,
+                       std::function<void()> const& callback)
         : _pathFinder(pathFinder),
           _myInfo(myInfo),
           _peerInfo(peerInfo),
           _start(start),
           _expander(expander),
-          _id(id) {}
+          _id(id),
+          _callback(callback) {}
 
     ////////////////////////////////////////////////////////////////////////////////
     /// @brief Insert a neighbor to the todo list.
@@ -595,10 +598,16 @@ class DynamicDistanceFinder : public PathFinder<VertexId, Path> {
         }
 
         std::vector<Step*> neighbors;
+        int counter = 0;
 
         // Iterate while no bingo found and
         // there still is a vertex on the stack.
         while (!_pathFinder->_bingo && b) {
+          if (++counter == 10) {
+            // check for abortion
+            _callback();
+            counter = 0;
+          }
           neighbors.clear();
           _expander(v, neighbors);
           for (auto* neighbor : neighbors) {
@@ -624,6 +633,10 @@ class DynamicDistanceFinder : public PathFinder<VertexId, Path> {
       } catch (...) {
         _pathFinder->_resultCode = TRI_ERROR_INTERNAL;
       }
+      if (_pathFinder->_resultCode.load() != TRI_ERROR_NO_ERROR) {
+        // make the peer thread stop, too
+        _pathFinder->_bingo = true;
+      }
     }
 
     ////////////////////////////////////////////////////////////////////////////////
@@ -784,7 +797,8 @@ class DynamicDistanceFinder : public PathFinder<VertexId, Path> {
   //////////////////////////////////////////////////////////////////////////////
 
   DynamicDistanceFinder(ExpanderFunction&& forwardExpander,
-             ExpanderFunction&& backwardExpander, bool bidirectional = true)
+             ExpanderFunction&& backwardExpander, bool bidirectional = true,
+             bool parallel = false)
       : _highscoreSet(false),
         _highscore(0),
         _bingo(false),
@@ -793,7 +807,8 @@ class DynamicDistanceFinder : public PathFinder<VertexId, Path> {
         _intermediate(),
         _forwardExpander(forwardExpander),
         _backwardExpander(backwardExpander),
-        _bidirectional(bidirectional){};
+        _bidirectional(bidirectional),
+        _parallel(parallel){};
 
   ~DynamicDistanceFinder(){};
 
@@ -808,6 +823,10 @@ class DynamicDistanceFinder : public PathFinder<VertexId, Path> {
   // path
   bool shortestPath(VertexId const& start, VertexId const& target, 
                     Path& result, std::function<void()> const& callback) override {
+    if (_parallel && _bidirectional) {
+      return shortestPathTwoThreads(start, target, result, callback);
+    }
+
     // For the result:
     result.clear();
     _highscoreSet = false;
@@ -897,12 +916,16 @@ class DynamicDistanceFinder : public PathFinder<VertexId, Path> {
   // If this returns true there is a path, if this returns false there is no
   // path
 
-  bool shortestPathTwoThreads(VertexId& start, VertexId& target, Path& result) {
+  bool shortestPathTwoThreads(VertexId const& start, VertexId const& target,
+                              Path& result,
+                              std::function<void()> const& callback) {
     // For the result:
     result.clear();
     _highscoreSet = false;
     _highscore = 0;
     _bingo = false;
+    _resultCode = TRI_ERROR_NO_ERROR;
+    _intermediateSet = false;
 
     // Forward with initialization:
     VertexId emptyVertex;
@@ -916,11 +939,12 @@ class DynamicDistanceFinder : public PathFinder<VertexId, Path> {
 
     // Now the searcher threads:
     SearcherTwoThreads forwardSearcher(this, forward, backward, start,
-                                       _forwardExpander, "Forward");
+                                       _forwardExpander, "Forward", callback);
     std::unique_ptr<SearcherTwoThreads> backwardSearcher;
     if (_bidirectional) {
-      backwardSearcher.reset(new SearcherTwoThreads(
-          this, backward, forward, target, _backwardExpander, "Backward"));
+      backwardSearcher.reset(new SearcherTwoThreads(this, backward, forward,
+                                                    target, _backwardExpander,
+                                                    "Backward", callback));
     }
 
     TRI_IF_FAILURE("TraversalOOMInitialize") {
@@ -1092,6 +1116,9 @@ class DynamicDistanceFinder : public PathFinder<VertexId, Path> {
   ExpanderFunction _forwardExpander;
   ExpanderFunction _backwardExpander;
   bool _bidirectional;
+
+  /// @brief whether or not the two directions are searched concurrently
+  bool _parallel;
 };
 
 template <typename VertexId, typename EdgeId, typename HashFuncType, typename EqualFuncType, typename Path>
@@ -1114,18 +1141,36 @@ class ConstDistanceFinder : public PathFinder<VertexId, Path> {
     PathSnippet(VertexId& pred, EdgeId& path) : _pred(pred), _path(path) {}
   };
 
-  std::unordered_map<VertexId, PathSnippet*, HashFuncType, EqualFuncType> _leftFound;
+  /// @brief the neighbors of one complete closure, used by the parallel
+  /// search. sources contains the position of the predecessor of each
+  /// neighbor in the closure
+  struct Expansion {
+    std::vector<EdgeId> edges;
+    std::vector<VertexId> neighbors;
+    std::vector<size_t> sources;
+  };
+
+  typedef std::unordered_map<VertexId, PathSnippet*, HashFuncType,
+                             EqualFuncType> FoundMap;
+
+  FoundMap _leftFound;
   std::deque<VertexId> _leftClosure;
 
-  std::unordered_map<VertexId, PathSnippet*, HashFuncType, EqualFuncType> _rightFound;
+  FoundMap _rightFound;
   std::deque<VertexId> _rightClosure;
 
   ExpanderFunction _leftNeighborExpander;
   ExpanderFunction _rightNeighborExpander;
 
+  /// @brief whether or not both closures are expanded concurrently
+  bool _parallel;
+
  public:
-  ConstDistanceFinder(ExpanderFunction left, ExpanderFunction right)
-      : _leftNeighborExpander(left), _rightNeighborExpander(right) {}
+  ConstDistanceFinder(ExpanderFunction left, ExpanderFunction right,
+                      bool parallel = false)
+      : _leftNeighborExpander(left),
+        _rightNeighborExpander(right),
+        _parallel(parallel) {}
 
   ~ConstDistanceFinder() {
     clearVisited();
@@ -1152,6 +1197,10 @@ class ConstDistanceFinder : public PathFinder<VertexId, Path> {
       THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
     }
 
+    if (_parallel) {
+      return shortestPathParallel(result, callback);
+    }
+
     std::vector<EdgeId> edges;
     std::vector<VertexId> neighbors;
     std::deque<VertexId> nextClosure;
@@ -1172,26 +1221,7 @@ class ConstDistanceFinder : public PathFinder<VertexId, Path> {
               auto leftFoundIt = _leftFound.emplace(n, new PathSnippet(v, edges[i])).first;
               auto rightFoundIt = _rightFound.find(n);
               if (rightFoundIt != _rightFound.end()) {
-                result._vertices.emplace_back(n);
-                auto it = leftFoundIt;
-                VertexId next;
-                while (it != _leftFound.end() && it->second != nullptr) {
-                  next = it->second->_pred;
-                  result._vertices.push_front(next);
-                  result._edges.push_front(it->second->_path);
-                  it = _leftFound.find(next);
-                }
-                it = rightFoundIt;
-                while (it != _rightFound.end() && it->second != nullptr) {
-                  next = it->second->_pred;
-                  result._vertices.emplace_back(next);
-                  result._edges.emplace_back(it->second->_path);
-                  it = _rightFound.find(next);
-                }
-
-                TRI_IF_FAILURE("TraversalOOMPath") {
-                  THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
-                }
+                buildPath(leftFoundIt, rightFoundIt, result);
                 return true;
               }
               nextClosure.emplace_back(n);
@@ -1211,26 +1241,7 @@ class ConstDistanceFinder : public PathFinder<VertexId, Path> {
               auto rightFoundIt = _rightFound.emplace(n, new PathSnippet(v, edges[i])).first;
               auto leftFoundIt = _leftFound.find(n);
               if (leftFoundIt != _leftFound.end()) {
-                result._vertices.emplace_back(n);
-                auto it = leftFoundIt;
-                VertexId next;
-                while (it != _leftFound.end() && it->second != nullptr) {
-                  next = it->second->_pred;
-                  result._vertices.push_front(next);
-                  result._edges.push_front(it->second->_path);
-                  it = _leftFound.find(next);
-                }
-                it = rightFoundIt;
-                while (it != _rightFound.end() && it->second != nullptr) {
-                  next = it->second->_pred;
-                  result._vertices.emplace_back(next);
-                  result._edges.emplace_back(it->second->_path);
-                  it = _rightFound.find(next);
-                }
-
-                TRI_IF_FAILURE("TraversalOOMPath") {
-                  THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
-                }
+                buildPath(leftFoundIt, rightFoundIt, result);
                 return true;
               }
               nextClosure.emplace_back(n);
@@ -1245,6 +1256,142 @@ class ConstDistanceFinder : public PathFinder<VertexId, Path> {
   }
 
  private:
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief search with both closures expanded concurrently, one level per
+  /// round. the right closure is expanded on a separate thread, the
+  /// neighbors are merged on the calling thread afterwards. the left
+  /// neighbors are merged first, so a meeting found there has an odd
+  /// length of 2k - 1 and one found in the right neighbors an even length
+  /// of 2k, which keeps the first path found a shortest one
+  //////////////////////////////////////////////////////////////////////////////
+
+  bool shortestPathParallel(Path& result,
+                            std::function<void()> const& callback) {
+    Expansion left;
+    Expansion right;
+
+    while (!_leftClosure.empty() && !_rightClosure.empty()) {
+      callback();
+
+      int rightResult = TRI_ERROR_NO_ERROR;
+      std::thread rightThread([this, &right, &rightResult]() {
+        try {
+          expandClosure(_rightNeighborExpander, _rightClosure, right);
+        } catch (arangodb::basics::Exception const& ex) {
+          rightResult = ex.code();
+        } catch (std::bad_alloc const&) {
+          rightResult = TRI_ERROR_OUT_OF_MEMORY;
+        } catch (...) {
+          rightResult = TRI_ERROR_INTERNAL;
+        }
+      });
+
+      try {
+        expandClosure(_leftNeighborExpander, _leftClosure, left);
+      } catch (...) {
+        rightThread.join();
+        throw;
+      }
+      rightThread.join();
+
+      if (rightResult != TRI_ERROR_NO_ERROR) {
+        THROW_ARANGO_EXCEPTION(rightResult);
+      }
+
+      if (mergeExpansion(left, _leftClosure, _leftFound, _rightFound, true,
+                         result) ||
+          mergeExpansion(right, _rightClosure, _rightFound, _leftFound, false,
+                         result)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief collect the neighbors of all vertices of a closure. this must
+  /// not touch any of the found maps, as it runs concurrently for both sides
+  //////////////////////////////////////////////////////////////////////////////
+
+  static void expandClosure(ExpanderFunction& expander,
+                            std::deque<VertexId>& closure,
+                            Expansion& expansion) {
+    expansion.edges.clear();
+    expansion.neighbors.clear();
+    expansion.sources.clear();
+
+    size_t const n = closure.size();
+    for (size_t i = 0; i < n; ++i) {
+      expander(closure[i], expansion.edges, expansion.neighbors);
+      TRI_ASSERT(expansion.edges.size() == expansion.neighbors.size());
+      expansion.sources.resize(expansion.neighbors.size(), i);
+    }
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief add the neighbors of a closure to the found map of its side and
+  /// make them the next closure. returns true and fills the result if one
+  /// of them is already known to the other side
+  //////////////////////////////////////////////////////////////////////////////
+
+  bool mergeExpansion(Expansion& expansion, std::deque<VertexId>& closure,
+                      FoundMap& found, FoundMap& peerFound, bool isLeft,
+                      Path& result) {
+    std::deque<VertexId> nextClosure;
+
+    size_t const n = expansion.neighbors.size();
+    for (size_t i = 0; i < n; ++i) {
+      VertexId const& v = expansion.neighbors[i];
+      if (found.find(v) != found.end()) {
+        continue;
+      }
+      auto foundIt = found.emplace(v, new PathSnippet(
+                                          closure[expansion.sources[i]],
+                                          expansion.edges[i])).first;
+      auto peerIt = peerFound.find(v);
+      if (peerIt != peerFound.end()) {
+        if (isLeft) {
+          buildPath(foundIt, peerIt, result);
+        } else {
+          buildPath(peerIt, foundIt, result);
+        }
+        return true;
+      }
+      nextClosure.emplace_back(v);
+    }
+
+    closure = std::move(nextClosure);
+    return false;
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief build the path through the vertex both sides have found
+  //////////////////////////////////////////////////////////////////////////////
+
+  void buildPath(typename FoundMap::iterator leftFoundIt,
+                 typename FoundMap::iterator rightFoundIt, Path& result) {
+    result._vertices.emplace_back(leftFoundIt->first);
+    auto it = leftFoundIt;
+    VertexId next;
+    while (it != _leftFound.end() && it->second != nullptr) {
+      next = it->second->_pred;
+      result._vertices.push_front(next);
+      result._edges.push_front(it->second->_path);
+      it = _leftFound.find(next);
+    }
+    it = rightFoundIt;
+    while (it != _rightFound.end() && it->second != nullptr) {
+      next = it->second->_pred;
+      result._vertices.emplace_back(next);
+      result._edges.emplace_back(it->second->_path);
+      it = _rightFound.find(next);
+    }
+
+    TRI_IF_FAILURE("TraversalOOMPath") {
+      THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
+    }
+  }
+
   void clearVisited() {  
     for (auto& it : _leftFound) {
       delete it.second;
@@ -75,6 +75,7 @@ std::string const StaticStrings::AccessControlMaxAge("access-control-max-age");
 std::string const StaticStrings::AccessControlRequestHeaders(
     "access-control-request-headers");
 std::string const StaticStrings::Allow("allow");
+std::string const StaticStrings::AllowDirtyReads("x-arango-allow-dirty-read");
 std::string const StaticStrings::Async("x-arango-async");
 std::string const StaticStrings::AsyncId("x-arango-async-id");
 std::string const StaticStrings::Authorization("authorization");
@@ -103,11 +104,14 @@ std::string const StaticStrings::ExposedCorsHeaders(
 std::string const StaticStrings::HLCHeader("x-arango-hlc");
 std::string const StaticStrings::KeepAlive("Keep-Alive");
 std::string const StaticStrings::Location("location");
+std::string const StaticStrings::MaxStaleness("x-arango-max-staleness");
 std::string const StaticStrings::MultiPartContentType("multipart/form-data");
 std::string const StaticStrings::Origin("origin");
 std::string const StaticStrings::Queue("x-arango-queue");
 std::string const StaticStrings::Server("server");
 std::string const StaticStrings::StartThread("x-arango-start-thread");
+std::string const StaticStrings::TransferEncoding("transfer-encoding");
+std::string const StaticStrings::Vary("vary");
 std::string const StaticStrings::WwwAuthenticate("www-authenticate");    
 
 // mime types
@@ -75,6 +75,7 @@ class StaticStrings {
   static std::string const AccessControlMaxAge;
   static std::string const AccessControlRequestHeaders;
   static std::string const Allow;
+  static std::string const AllowDirtyReads;
   static std::string const Async;
   static std::string const AsyncId;
   static std::string const Authorization;
@@ -99,11 +100,14 @@ class StaticStrings {
   static std::string const HLCHeader;
   static std::string const KeepAlive;
   static std::string const Location;
+  static std::string const MaxStaleness;
   static std::string const MultiPartContentType;
   static std::string const Origin;
   static std::string const Queue;
   static std::string const Server;
   static std::string const StartThread;
+  static std::string const TransferEncoding;
+  static std::string const Vary;
   static std::string const WwwAuthenticate;
 
   // mime types
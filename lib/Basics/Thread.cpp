@@ -30,6 +30,7 @@
 #include "ApplicationFeatures/ApplicationServer.h"
 #include "Basics/ConditionLocker.h"
 #include "Basics/Exceptions.h"
+#include "Basics/NumaTopology.h"
 #include "Basics/WorkMonitor.h"
 #include "Logger/Logger.h"
 
@@ -77,6 +78,10 @@ void Thread::startThread(void* arg) {
 
   ptr->_threadNumber = LOCAL_THREAD_NUMBER;
 
+  if (0 <= ptr->_numaNode) {
+    NumaTopology::bindCurrentThread(static_cast<size_t>(ptr->_numaNode));
+  }
+
   bool pushed = WorkMonitor::pushThread(ptr);
 
   try {
@@ -155,7 +160,8 @@ Thread::Thread(std::string const& name)
       _finishedCondition(nullptr),
       _state(ThreadState::CREATED),
       _affinity(-1),
-      _workDescription(nullptr) {
+      _numaNode(-1),
+      _workStack(nullptr) {
   TRI_InitThread(&_thread);
   
   // allow failing memory allocations for all threads by default 
@@ -327,19 +333,12 @@ bool Thread::start(ConditionVariable* finishedCondition) {
 void Thread::setProcessorAffinity(size_t c) { _affinity = (int)c; }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief sets the current work description
-////////////////////////////////////////////////////////////////////////////////
-
-void Thread::setWorkDescription(WorkDescription* desc) {
-  _workDescription.store(desc);
-}
-
-////////////////////////////////////////////////////////////////////////////////
-/// @brief sets the previous work description
+/// @brief restricts the thread to the CPUs of a NUMA node
 ////////////////////////////////////////////////////////////////////////////////
 
-WorkDescription* Thread::setPrevWorkDescription() {
-  return _workDescription.exchange(_workDescription.load()->_prev.load());
+void Thread::setNumaNode(size_t node) {
+  TRI_ASSERT(node < NumaTopology::numberOfNodes());
+  _numaNode = (int)node;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
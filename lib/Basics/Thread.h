@@ -226,23 +226,33 @@ class Thread {
 
   void setProcessorAffinity(size_t c);
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief restricts the thread to the CPUs of a NUMA node. the thread
+  /// binds itself before it runs, so all memory it touches is local
+  //////////////////////////////////////////////////////////////////////////////
+
+  void setNumaNode(size_t node);
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief returns the current work description
   //////////////////////////////////////////////////////////////////////////////
 
-  WorkDescription* workDescription() const { return _workDescription.load(); }
+  WorkDescription* workDescription() const {
+    WorkStack* stack = _workStack.load();
+    return stack == nullptr ? nullptr : stack->top();
+  }
 
   //////////////////////////////////////////////////////////////////////////////
-  /// @brief sets the current work description
+  /// @brief returns the work descriptions of the thread
   //////////////////////////////////////////////////////////////////////////////
 
-  void setWorkDescription(WorkDescription*);
+  WorkStack* workStack() const { return _workStack.load(); }
 
   //////////////////////////////////////////////////////////////////////////////
-  /// @brief sets the previous work description
+  /// @brief sets the work descriptions of the thread
   //////////////////////////////////////////////////////////////////////////////
 
-  WorkDescription* setPrevWorkDescription();
+  void setWorkStack(WorkStack* stack) { _workStack.store(stack); }
 
   //////////////////////////////////////////////////////////////////////////////
   /// @brief generates a description of the thread
@@ -315,10 +325,16 @@ class Thread {
   int _affinity;
 
   //////////////////////////////////////////////////////////////////////////////
-  /// @brief current work description
+  /// @brief NUMA node, -1 if the thread may run on all nodes
+  //////////////////////////////////////////////////////////////////////////////
+
+  int _numaNode;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief work descriptions, owned by the thread-local storage
   //////////////////////////////////////////////////////////////////////////////
 
-  std::atomic<WorkDescription*> _workDescription;
+  std::atomic<WorkStack*> _workStack;
 };
 }
 
@@ -45,7 +45,7 @@ using namespace arangodb::basics;
 Utf8Helper Utf8Helper::DefaultUtf8Helper(nullptr);
 
 Utf8Helper::Utf8Helper(std::string const& lang, void *icuDataPtr)
-  : _coll(nullptr) {
+  : _coll(nullptr), _asciiLowerCase(false) {
   setCollatorLanguage(lang, icuDataPtr);
 }
 
@@ -132,6 +132,41 @@ int Utf8Helper::compareUtf16(uint16_t const* left, size_t leftLength,
                         (const UChar*)right, (int32_t)rightLength);
 }
 
+bool Utf8Helper::appendSortKey(char const* value, size_t length,
+                               std::string& result) const {
+  TRI_ASSERT(value != nullptr);
+
+  if (!_coll) {
+    return false;
+  }
+
+  UnicodeString const s =
+      UnicodeString::fromUTF8(StringPiece(value, (int32_t)length));
+  size_t const offset = result.size();
+
+  // most sort keys are less than twice as long as the string
+  size_t capacity = 2 * length + 16;
+  result.resize(offset + capacity);
+  int32_t needed = _coll->getSortKey(
+      s, reinterpret_cast<uint8_t*>(&result[offset]), (int32_t)capacity);
+
+  if (needed > 0 && static_cast<size_t>(needed) > capacity) {
+    capacity = static_cast<size_t>(needed);
+    result.resize(offset + capacity);
+    needed = _coll->getSortKey(
+        s, reinterpret_cast<uint8_t*>(&result[offset]), (int32_t)capacity);
+  }
+
+  if (needed <= 1) {
+    result.resize(offset);
+    return false;
+  }
+
+  // strip the terminating zero byte
+  result.resize(offset + static_cast<size_t>(needed) - 1);
+  return true;
+}
+
 bool Utf8Helper::setCollatorLanguage(std::string const& lang, void* icuDataPointer) {
   if (icuDataPointer == nullptr) {
      return false;
@@ -194,6 +229,10 @@ bool Utf8Helper::setCollatorLanguage(std::string const& lang, void* icuDataPoint
   }
 
   _coll = coll;
+
+  // the Turkic languages lowercase 'I' to a dotless i
+  std::string const language = getCollatorLanguage();
+  _asciiLowerCase = (language != "tr" && language != "az");
   return true;
 }
 
@@ -410,6 +449,10 @@ bool Utf8Helper::getWords(std::vector<std::string>& words,
     return true;
   }
 
+  if (getAsciiWords(words, text, minimalLength, maximalLength, lowerCase)) {
+    return true;
+  }
+
   size_t textUtf16Length = 0;
   UChar* textUtf16 = nullptr;
 
@@ -510,6 +553,99 @@ bool Utf8Helper::getWords(std::vector<std::string>& words,
   return true;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief returns the words of a pure ASCII string without going through ICU
+////////////////////////////////////////////////////////////////////////////////
+
+bool Utf8Helper::getAsciiWords(std::vector<std::string>& words,
+                               std::string const& text, size_t minimalLength,
+                               size_t maximalLength, bool lowerCase) {
+  // the ICU word iterator also returns the single characters between words.
+  // these are only filtered out by the minimal length if it is at least 2
+  if (minimalLength < 2 || (lowerCase && !_asciiLowerCase)) {
+    return false;
+  }
+
+  char const* p = text.data();
+  size_t const length = text.size();
+
+  // check 8 bytes at a time whether the text is pure ASCII
+  size_t i = 0;
+  for (; i + sizeof(uint64_t) <= length; i += sizeof(uint64_t)) {
+    uint64_t chunk;
+    memcpy(&chunk, p + i, sizeof(uint64_t));
+    if ((chunk & 0x8080808080808080ULL) != 0) {
+      return false;
+    }
+  }
+  for (; i < length; ++i) {
+    if ((static_cast<unsigned char>(p[i]) & 0x80) != 0) {
+      return false;
+    }
+  }
+
+  auto isWordChar = [](char c) -> bool {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+           (c >= '0' && c <= '9');
+  };
+  auto isSpace = [](char c) -> bool {
+    return c == ' ' || (c >= '\t' && c <= '\r');
+  };
+  auto isMidChar = [](char c) -> bool {
+    return c == '.' || c == ',' || c == ';' || c == ':' || c == '\'';
+  };
+
+  size_t const initialSize = words.size();
+  i = 0;
+  while (i < length) {
+    char c = p[i];
+
+    if (isWordChar(c)) {
+      size_t const start = i;
+      while (i < length && isWordChar(p[i])) {
+        ++i;
+      }
+      if (i < length &&
+          (p[i] == '_' ||
+           (isMidChar(p[i]) && i + 1 < length && isWordChar(p[i + 1])))) {
+        // words may continue across these, depending on the context and
+        // the locale
+        words.resize(initialSize);
+        return false;
+      }
+
+      size_t wordLength = i - start;
+      if (wordLength >= minimalLength) {
+        if (wordLength > maximalLength) {
+          wordLength = maximalLength;
+        }
+        words.emplace_back(p + start, wordLength);
+        if (lowerCase) {
+          for (auto& it : words.back()) {
+            if (it >= 'A' && it <= 'Z') {
+              it += 'a' - 'A';
+            }
+          }
+        }
+      }
+      continue;
+    }
+
+    if (c == '_' || c == '@' ||
+        (isSpace(c) && i + 1 < length && isSpace(p[i + 1]))) {
+      // ICU may keep these together with the adjacent characters
+      words.resize(initialSize);
+      return false;
+    }
+
+    // any other character is a segment of its own, and too short to be
+    // returned
+    ++i;
+  }
+
+  return true;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief builds a regex matcher for the specified pattern
 ////////////////////////////////////////////////////////////////////////////////
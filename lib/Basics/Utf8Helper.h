@@ -85,6 +85,17 @@ class Utf8Helper {
   int compareUtf16(uint16_t const* left, size_t leftLength,
                    uint16_t const* right, size_t rightLength) const;
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief append the collation sort key of a utf8 string to result
+  /// comparing the sort keys of two strings with memcmp yields the same
+  /// order as compareUtf8(), as long as the collator is not changed. sort
+  /// keys are never empty and do not contain the terminating zero byte.
+  /// returns false if no sort key can be computed
+  //////////////////////////////////////////////////////////////////////////////
+
+  bool appendSortKey(char const* value, size_t length,
+                     std::string& result) const;
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief set collator by language
   /// @param lang   Lowercase two-letter or three-letter ISO-639 code.
@@ -157,8 +168,23 @@ class Utf8Helper {
                       char const* replacement, size_t replacementLength,
                       bool partial, bool& error);
 
+ private:
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief returns the words of a pure ASCII string without going through
+  /// ICU. returns false and leaves words unchanged if the text is not pure
+  /// ASCII or might be split differently by the ICU word break rules
+  //////////////////////////////////////////////////////////////////////////////
+
+  bool getAsciiWords(std::vector<std::string>& words, std::string const& text,
+                     size_t minimalWordLength, size_t maximalWordLength,
+                     bool lowerCase);
+
  private:
   Collator* _coll;
+
+  /// @brief whether or not ASCII letters can be lowercased without ICU in
+  /// the collator language
+  bool _asciiLowerCase;
 };
 }
 }
@@ -26,6 +26,8 @@
 #include "Basics/fpconv.h"
 #include "Logger/Logger.h"
 
+#include "../../3rdParty/velocypack/src/asm-functions.h"
+
 #include <velocypack/velocypack-common.h>
 #include <velocypack/AttributeTranslator.h>
 #include "velocypack/Iterator.h"
@@ -309,7 +311,29 @@ void VelocyPackDumper::appendString(char const* src, VPackValueLength len) {
         
   uint8_t const* p = reinterpret_cast<uint8_t const*>(src);
   uint8_t const* e = p + len;
+  // forward slashes are not stopped at by the block copy
+  bool const useBlockCopy = !options->escapeForwardSlashes;
+
   while (p < e) {
+    if (useBlockCopy && e - p >= 16) {
+      // copy the characters up to the next one that needs special treatment
+      // (control characters, '"', '\\' and multi-byte sequences) in blocks
+      // of 16 bytes, using SSE4.2 where the CPU supports it. the length is
+      // rounded down to full blocks so that the copy does not read beyond
+      // the end of the string
+      size_t const limit = static_cast<size_t>(e - p) & ~static_cast<size_t>(15);
+      size_t const copied = JSONStringCopyCheckUtf8(
+          reinterpret_cast<uint8_t*>(const_cast<char*>(TRI_EndStringBuffer(buffer))), p, limit);
+      TRI_IncreaseLengthStringBuffer(buffer, copied);
+      p += copied;
+
+      if (copied == limit) {
+        // the block copy may stop before a character that does not need
+        // escaping only at the end of its input
+        continue;
+      }
+    }
+
     uint8_t c = *p;
 
     if ((c & 0x80U) == 0) {
@@ -393,14 +417,20 @@ void VelocyPackDumper::appendString(char const* src, VPackValueLength len) {
 }
 
 void VelocyPackDumper::dumpValue(VPackSlice const* slice, VPackSlice const* base) {
-  if (base == nullptr) {
-    base = slice;
-  }
-  
   TRI_string_buffer_t* buffer = _buffer->stringBuffer(); 
   
   // alloc at least 32 bytes  
-  int res = TRI_ReserveStringBuffer(buffer, 32);
+  size_t reserve = 32;
+
+  if (base == nullptr) {
+    base = slice;
+    // top-level value: the JSON text is usually at least as long as the
+    // VelocyPack value, so reserve that much at once instead of growing
+    // the buffer repeatedly while dumping
+    reserve = (std::max)(reserve, static_cast<size_t>(slice->byteSize()));
+  }
+
+  int res = TRI_ReserveStringBuffer(buffer, reserve);
      
   if (res != TRI_ERROR_NO_ERROR) {
     THROW_ARANGO_EXCEPTION(res);
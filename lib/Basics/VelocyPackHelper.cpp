@@ -355,6 +355,24 @@ bool VelocyPackHelper::VPackHashedStringEqual::operator()(basics::VPackHashedSli
           0);
 };
 
+/// @brief whether the head byte is a SmallInt or an Int
+static inline bool IsSignedInteger(uint8_t head) {
+  return (head >= 0x20 && head <= 0x27) || (head >= 0x30 && head <= 0x3f);
+}
+
+/// @brief whether the head byte is a short or long string
+static inline bool IsString(uint8_t head) {
+  return head >= 0x40 && head <= 0xbf;
+}
+
+/// @brief whether two arrays or objects have identical bytes. such values
+/// always compare equal, even if they contain custom types, as those are
+/// resolved relative to the same base
+static inline bool IsIdentical(VPackSlice const& lhs, VPackSlice const& rhs) {
+  VPackValueLength const n = lhs.byteSize();
+  return n == rhs.byteSize() && memcmp(lhs.start(), rhs.start(), n) == 0;
+}
+
 static inline int8_t TypeWeight(VPackSlice& slice) {
 again:
   int8_t w = TypeWeights[slice.head()];
@@ -699,6 +717,33 @@ int VelocyPackHelper::compare(VPackSlice lhs, VPackSlice rhs, bool useUTF8,
                               VPackOptions const* options,
                               VPackSlice const* lhsBase,
                               VPackSlice const* rhsBase) {
+  // fast paths for the values most frequently compared in sorts and index
+  // lookups. they produce the same results as the general code below
+  uint8_t const lh = lhs.head();
+  uint8_t const rh = rhs.head();
+
+  if (IsSignedInteger(lh) && IsSignedInteger(rh)) {
+    int64_t l = lhs.getInt();
+    int64_t r = rhs.getInt();
+    if (l == r) {
+      return 0;
+    }
+    return (l < r ? -1 : 1);
+  }
+
+  if (IsString(lh) && IsString(rh)) {
+    VPackValueLength nl;
+    char const* left = lhs.getString(nl);
+    VPackValueLength nr;
+    char const* right = rhs.getString(nr);
+
+    if (nl == nr && memcmp(left, right, static_cast<size_t>(nl)) == 0) {
+      // equal bytes are equal in any collation
+      return 0;
+    }
+    return compareStringValues(left, nl, right, nr, useUTF8);
+  }
+
   {
     // will resolve externals and modify both lhs & rhs...
     int8_t lWeight = TypeWeight(lhs);
@@ -781,6 +826,10 @@ int VelocyPackHelper::compare(VPackSlice lhs, VPackSlice rhs, bool useUTF8,
       return compareStringValues(left, nl, right, nr, useUTF8);
     }
     case VPackValueType::Array: {
+      if (IsIdentical(lhs, rhs)) {
+        return 0;
+      }
+
       VPackArrayIterator al(lhs);
       VPackArrayIterator ar(rhs);
 
@@ -807,6 +856,11 @@ int VelocyPackHelper::compare(VPackSlice lhs, VPackSlice rhs, bool useUTF8,
       return 0;
     }
     case VPackValueType::Object: {
+      if (IsIdentical(lhs, rhs)) {
+        // avoids collecting and sorting the attribute names
+        return 0;
+      }
+
       if (useUTF8) {
         // must sort attributes by proper UTF8 values
         // this is expensive
@@ -26,6 +26,8 @@
 
 #include "Common.h"
 
+#include <thread>
+
 struct TRI_vocbase_t;
 
 namespace arangodb {
@@ -60,22 +62,16 @@ struct WorkContext {
 // -----------------------------------------------------------------------------
 
 struct WorkDescription {
-  WorkDescription(WorkType type, WorkDescription* prev)
-      : _type(type), _id(0), _prev(prev) {
-    if (prev != nullptr) {
-      _context = prev->_context;
-    }
-  }
+  WorkDescription() : _type(WorkType::CUSTOM), _id(0), _prev(nullptr) {}
 
-  WorkDescription(WorkType type, std::shared_ptr<WorkContext> context,
-                  WorkDescription* prev)
-      : _type(type), _id(0), _context(context), _prev(prev) {}
+  WorkDescription(WorkDescription const&) = delete;
+  WorkDescription& operator=(WorkDescription const&) = delete;
 
   WorkType _type;
   uint64_t _id;
 
   std::shared_ptr<WorkContext> _context;
-  std::atomic<WorkDescription*> _prev;
+  WorkDescription* _prev;
 
   union Data {
     Data() {}
@@ -111,6 +107,136 @@ struct WorkDescription {
     } _custom;
   } _data;
 };
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                         WorkStack
+// -----------------------------------------------------------------------------
+
+// the work descriptions of a thread. the descriptions are preallocated, so
+// pushing and popping them neither allocates nor takes a lock. the owning
+// thread is the only one to change them. other threads may read them
+// between tryBeginRead() and endRead(). the owner and a reader each set
+// their flag and then check the other's one, so at least one of them sees
+// the other; the reader backs off, and the owner waits for a reader that
+// is already reading. the owner thus only ever waits while somebody
+// requests a work overview
+class WorkStack {
+  WorkStack(WorkStack const&) = delete;
+  WorkStack& operator=(WorkStack const&) = delete;
+
+ public:
+  // maximal number of nested work descriptions. deeper ones are not
+  // recorded
+  static constexpr size_t MaxDepth = 16;
+
+  explicit WorkStack(uint64_t number)
+      : _writing(false),
+        _reading(false),
+        _depth(0),
+        _overflow(0),
+        _nextId(number << 32) {}
+
+ public:
+  // returns the current work description or nullptr. must only be called
+  // by the owner, or by a reader
+  WorkDescription* top() {
+    size_t depth = _depth.load(std::memory_order_acquire);
+    return depth == 0 ? nullptr : &_slots[depth - 1];
+  }
+
+  // returns the current work description, or nullptr if there is none or
+  // the owner is changing the stack. for signal handlers interrupting the
+  // owner, which can neither wait for it nor back off like a reader
+  WorkDescription* topIfStable() {
+    if (_writing.load()) {
+      return nullptr;
+    }
+    return top();
+  }
+
+  // starts pushing a work description. returns the slot to fill in, with
+  // its id and parent set, or nullptr if the stack is full. the slot must
+  // be published with endPush()
+  WorkDescription* beginPush() {
+    size_t depth = _depth.load(std::memory_order_relaxed);
+
+    if (depth == MaxDepth) {
+      ++_overflow;
+      return nullptr;
+    }
+
+    beginWrite();
+    WorkDescription* desc = &_slots[depth];
+    desc->_prev = (depth == 0) ? nullptr : &_slots[depth - 1];
+    // ids are unique across threads without a shared counter
+    desc->_id = ++_nextId;
+    return desc;
+  }
+
+  void endPush() {
+    _depth.fetch_add(1, std::memory_order_release);
+    endWrite();
+  }
+
+  // starts popping the current work description. returns the slot to clean
+  // up, or nullptr if the description was not recorded. the slot must be
+  // released with endPop()
+  WorkDescription* beginPop() {
+    if (_overflow > 0) {
+      --_overflow;
+      return nullptr;
+    }
+
+    beginWrite();
+    WorkDescription* desc = top();
+    TRI_ASSERT(desc != nullptr);
+    return desc;
+  }
+
+  void endPop() {
+    _depth.fetch_sub(1, std::memory_order_release);
+    endWrite();
+  }
+
+  // starts reading the work descriptions from another thread. returns false
+  // if the owner kept changing them
+  bool tryBeginRead() {
+    for (size_t i = 0; i < 1000; ++i) {
+      _reading.store(true);
+
+      if (!_writing.load()) {
+        return true;
+      }
+
+      _reading.store(false);
+      std::this_thread::yield();
+    }
+
+    return false;
+  }
+
+  void endRead() { _reading.store(false); }
+
+ private:
+  void beginWrite() {
+    _writing.store(true);
+
+    while (_reading.load()) {
+      // a reader is producing a work overview right now
+      std::this_thread::yield();
+    }
+  }
+
+  void endWrite() { _writing.store(false, std::memory_order_release); }
+
+ private:
+  std::atomic<bool> _writing;
+  std::atomic<bool> _reading;
+  std::atomic<size_t> _depth;
+  size_t _overflow;
+  uint64_t _nextId;
+  WorkDescription _slots[MaxDepth];
+};
 }
 
 #endif
@@ -27,6 +27,7 @@
 #include <velocypack/Sink.h>
 #include <velocypack/velocypack-aliases.h>
 
+#include "Basics/ConditionLocker.h"
 #include "Basics/MutexLocker.h"
 #include "Basics/tri-strings.h"
 #include "Logger/Logger.h"
@@ -36,7 +37,7 @@ using namespace arangodb::basics;
 using namespace arangodb::rest;
 
 namespace {
-std::atomic<uint64_t> NEXT_DESC_ID(static_cast<uint64_t>(0));
+std::atomic<uint64_t> NEXT_STACK_NUMBER(static_cast<uint64_t>(0));
 }
 
 // -----------------------------------------------------------------------------
@@ -45,12 +46,6 @@ std::atomic<uint64_t> NEXT_DESC_ID(static_cast<uint64_t>(0));
 
 std::atomic<bool> WorkMonitor::_stopped(true);
 
-boost::lockfree::queue<WorkDescription*> WorkMonitor::_emptyWorkDescription(
-    128);
-
-boost::lockfree::queue<WorkDescription*> WorkMonitor::_freeableWorkDescription(
-    128);
-
 boost::lockfree::queue<
     std::pair<std::shared_ptr<rest::RestHandler>, std::function<void()>>*>
     WorkMonitor::_workOverview(128);
@@ -62,21 +57,12 @@ Mutex WorkMonitor::_threadsLock;
 std::set<Thread*> WorkMonitor::_threads;
 
 static WorkMonitor WORK_MONITOR;
-static thread_local WorkDescription* CURRENT_WORK_DESCRIPTION = nullptr;
+static thread_local WorkStack CURRENT_WORK_STACK(NEXT_STACK_NUMBER.fetch_add(1));
 
 // -----------------------------------------------------------------------------
 // --SECTION--                                             static public methods
 // -----------------------------------------------------------------------------
 
-void WorkMonitor::freeWorkDescription(WorkDescription* desc) {
-  if (_stopped.load()) {
-    deleteWorkDescription(desc, true);
-  } else {
-    desc->_context.reset();
-    _freeableWorkDescription.push(desc);
-  }
-}
-
 bool WorkMonitor::pushThread(Thread* thread) {
   if (_stopped.load()) {
     return false;
@@ -85,48 +71,38 @@ bool WorkMonitor::pushThread(Thread* thread) {
   TRI_ASSERT(thread != nullptr);
   TRI_ASSERT(Thread::CURRENT_THREAD == nullptr);
   Thread::CURRENT_THREAD = thread;
+  thread->setWorkStack(&CURRENT_WORK_STACK);
 
-  try {
-    WorkDescription* desc = createWorkDescription(WorkType::THREAD);
+  WorkDescription* desc = beginPush(WorkType::THREAD);
 
+  if (desc != nullptr) {
     new (&desc->_data._thread)
         WorkDescription::Data::ThreadMember(thread, false);
 
-    activateWorkDescription(desc);
+    endPush(desc);
+  }
 
-    {
-      MUTEX_LOCKER(guard, _threadsLock);
-      _threads.insert(thread);
-    }
-  } catch (...) {
-    throw;
+  {
+    MUTEX_LOCKER(guard, _threadsLock);
+    _threads.insert(thread);
   }
 
   return true;
 }
 
 void WorkMonitor::popThread(Thread* thread) {
-  if (_stopped.load()) {
-    return;
-  }
-
   TRI_ASSERT(thread != nullptr);
-  WorkDescription* desc = deactivateWorkDescription();
-
-  TRI_ASSERT(desc->_type == WorkType::THREAD);
-  TRI_ASSERT(desc->_data._thread._thread == thread);
 
   try {
-    freeWorkDescription(desc);
-
-    {
-      MUTEX_LOCKER(guard, _threadsLock);
-      _threads.erase(thread);
-    }
+    MUTEX_LOCKER(guard, _threadsLock);
+    _threads.erase(thread);
   } catch (...) {
     // just to prevent throwing exceptions from here, as this method
     // will be called in destructors...
   }
+
+  popWorkDescription(WorkType::THREAD);
+  thread->setWorkStack(nullptr);
 }
 
 void WorkMonitor::pushAql(TRI_vocbase_t* vocbase, uint64_t queryId,
@@ -134,8 +110,11 @@ void WorkMonitor::pushAql(TRI_vocbase_t* vocbase, uint64_t queryId,
   TRI_ASSERT(vocbase != nullptr);
   TRI_ASSERT(text != nullptr);
 
-  WorkDescription* desc = createWorkDescription(WorkType::AQL_STRING);
-  TRI_ASSERT(desc != nullptr);
+  WorkDescription* desc = beginPush(WorkType::AQL_STRING);
+
+  if (desc == nullptr) {
+    return;
+  }
 
   desc->_data._aql._vocbase = vocbase;
   desc->_data._aql._id = queryId;
@@ -147,14 +126,17 @@ void WorkMonitor::pushAql(TRI_vocbase_t* vocbase, uint64_t queryId,
   TRI_CopyString(desc->_data._aql._text, text, length);
   new (&desc->_data._aql._canceled) std::atomic<bool>(false);
 
-  activateWorkDescription(desc);
+  endPush(desc);
 }
 
 void WorkMonitor::pushAql(TRI_vocbase_t* vocbase, uint64_t queryId) {
   TRI_ASSERT(vocbase != nullptr);
 
-  WorkDescription* desc = createWorkDescription(WorkType::AQL_ID);
-  TRI_ASSERT(desc != nullptr);
+  WorkDescription* desc = beginPush(WorkType::AQL_ID);
+
+  if (desc == nullptr) {
+    return;
+  }
 
   desc->_data._aql._vocbase = vocbase;
   desc->_data._aql._id = queryId;
@@ -162,31 +144,21 @@ void WorkMonitor::pushAql(TRI_vocbase_t* vocbase, uint64_t queryId) {
   *(desc->_data._aql._text) = '\0';
   new (&desc->_data._aql._canceled) std::atomic<bool>(false);
 
-  activateWorkDescription(desc);
+  endPush(desc);
 }
 
-void WorkMonitor::popAql() {
-  WorkDescription* desc = deactivateWorkDescription();
-
-  TRI_ASSERT(desc != nullptr);
-  TRI_ASSERT(desc->_type == WorkType::AQL_STRING ||
-             desc->_type == WorkType::AQL_ID);
-
-  try {
-    freeWorkDescription(desc);
-  } catch (...) {
-    // just to prevent throwing exceptions from here, as this method
-    // will be called in destructors...
-  }
-}
+void WorkMonitor::popAql() { popWorkDescription(WorkType::AQL_STRING); }
 
 void WorkMonitor::pushCustom(char const* type, char const* text,
                              size_t length) {
   TRI_ASSERT(type != nullptr);
   TRI_ASSERT(text != nullptr);
 
-  WorkDescription* desc = createWorkDescription(WorkType::CUSTOM);
-  TRI_ASSERT(desc != nullptr);
+  WorkDescription* desc = beginPush(WorkType::CUSTOM);
+
+  if (desc == nullptr) {
+    return;
+  }
 
   TRI_CopyString(desc->_data._custom._type, type,
                  sizeof(desc->_data._custom._type) - 1);
@@ -197,14 +169,17 @@ void WorkMonitor::pushCustom(char const* type, char const* text,
 
   TRI_CopyString(desc->_data._custom._text, text, length);
 
-  activateWorkDescription(desc);
+  endPush(desc);
 }
 
 void WorkMonitor::pushCustom(char const* type, uint64_t id) {
   TRI_ASSERT(type != nullptr);
 
-  WorkDescription* desc = createWorkDescription(WorkType::CUSTOM);
-  TRI_ASSERT(desc != nullptr);
+  WorkDescription* desc = beginPush(WorkType::CUSTOM);
+
+  if (desc == nullptr) {
+    return;
+  }
 
   TRI_CopyString(desc->_data._custom._type, type,
                  sizeof(desc->_data._custom._type) - 1);
@@ -212,33 +187,29 @@ void WorkMonitor::pushCustom(char const* type, uint64_t id) {
   std::string idString = std::to_string(id);
   TRI_CopyString(desc->_data._custom._text, idString.c_str(), idString.size());
 
-  activateWorkDescription(desc);
+  endPush(desc);
 }
 
-void WorkMonitor::popCustom() {
-  WorkDescription* desc = deactivateWorkDescription();
-
-  TRI_ASSERT(desc != nullptr);
-  TRI_ASSERT(desc->_type == WorkType::CUSTOM);
-
-  try {
-    freeWorkDescription(desc);
-  } catch (...) {
-    // just to prevent throwing exceptions from here, as this method
-    // will be called in destructors...
-  }
-}
+void WorkMonitor::popCustom() { popWorkDescription(WorkType::CUSTOM); }
 
 void WorkMonitor::requestWorkOverview(
     std::shared_ptr<rest::RestHandler> handler, std::function<void()> next) {
   _workOverview.push(
       new std::pair<std::shared_ptr<rest::RestHandler>, std::function<void()>>(
           handler, next));
+
+  CONDITION_LOCKER(guard, WORK_MONITOR._waiter);
+  guard.signal();
 }
 
 void WorkMonitor::cancelWork(uint64_t id) {
-  MUTEX_LOCKER(guard, _cancelLock);
-  _cancelIds.insert(id);
+  {
+    MUTEX_LOCKER(guard, _cancelLock);
+    _cancelIds.insert(id);
+  }
+
+  CONDITION_LOCKER(guard, WORK_MONITOR._waiter);
+  guard.signal();
 }
 
 void WorkMonitor::initialize() {
@@ -263,25 +234,37 @@ void WorkMonitor::clearHandlers() {
 // --SECTION--                                            static private methods
 // -----------------------------------------------------------------------------
 
-WorkDescription* WorkMonitor::createWorkDescription(WorkType type) {
-  WorkDescription* desc = nullptr;
-  WorkDescription* prev = (Thread::CURRENT_THREAD == nullptr)
-                              ? CURRENT_WORK_DESCRIPTION
-                              : Thread::CURRENT_THREAD->workDescription();
+WorkDescription* WorkMonitor::beginPush(WorkType type) {
+  WorkDescription* desc = CURRENT_WORK_STACK.beginPush();
 
-  if (_emptyWorkDescription.pop(desc) && desc != nullptr) {
+  if (desc != nullptr) {
     desc->_type = type;
-    desc->_prev.store(prev);
-  } else {
-    desc = new WorkDescription(type, prev);
-  }
 
-  desc->_id = NEXT_DESC_ID.fetch_add(1, std::memory_order_seq_cst);
+    if (desc->_prev != nullptr) {
+      desc->_context = desc->_prev->_context;
+    }
+  }
 
   return desc;
 }
 
-void WorkMonitor::deleteWorkDescription(WorkDescription* desc, bool stopped) {
+void WorkMonitor::endPush(WorkDescription* desc) {
+  TRI_ASSERT(desc != nullptr);
+  CURRENT_WORK_STACK.endPush();
+}
+
+void WorkMonitor::popWorkDescription(WorkType type) {
+  WorkStack* stack = &CURRENT_WORK_STACK;
+  WorkDescription* desc = stack->beginPop();
+
+  if (desc == nullptr) {
+    // the description was not recorded, because the stack was full
+    return;
+  }
+
+  TRI_ASSERT(desc->_type == type ||
+             (type == WorkType::AQL_STRING && desc->_type == WorkType::AQL_ID));
+
   desc->_context.reset();
 
   switch (desc->_type) {
@@ -302,36 +285,7 @@ void WorkMonitor::deleteWorkDescription(WorkDescription* desc, bool stopped) {
       break;
   }
 
-  if (stopped) {
-    // we'll be getting here if the work monitor thread is already shut down
-    // and cannot delete anything anymore. this means we ourselves are
-    // responsible for cleaning up!
-    delete desc;
-    return;
-  }
-
-  // while the work monitor thread is still active, push the item on the
-  // work monitor's cleanup list for destruction
-  _emptyWorkDescription.push(desc);
-}
-
-void WorkMonitor::activateWorkDescription(WorkDescription* desc) {
-  if (Thread::CURRENT_THREAD == nullptr) {
-    CURRENT_WORK_DESCRIPTION = desc;
-  } else {
-    Thread::CURRENT_THREAD->setWorkDescription(desc);
-  }
-}
-
-WorkDescription* WorkMonitor::deactivateWorkDescription() {
-  if (Thread::CURRENT_THREAD == nullptr) {
-    WorkDescription* desc = CURRENT_WORK_DESCRIPTION;
-    TRI_ASSERT(desc != nullptr);
-    CURRENT_WORK_DESCRIPTION = desc->_prev.load();
-    return desc;
-  } else {
-    return Thread::CURRENT_THREAD->setPrevWorkDescription();
-  }
+  stack->endPop();
 }
 
 void WorkMonitor::vpackWorkDescription(VPackBuilder* b, WorkDescription* desc) {
@@ -368,7 +322,7 @@ void WorkMonitor::vpackWorkDescription(VPackBuilder* b, WorkDescription* desc) {
 
   b->add("id", VPackValue(desc->_id));
 
-  auto prev = desc->_prev.load();
+  auto prev = desc->_prev;
 
   if (prev != nullptr) {
     b->add("parent", VPackValue(VPackValueType::Object));
@@ -378,47 +332,64 @@ void WorkMonitor::vpackWorkDescription(VPackBuilder* b, WorkDescription* desc) {
 }
 
 void WorkMonitor::cancelWorkDescriptions(Thread* thread) {
-  WorkDescription* desc = thread->workDescription();
+  WorkStack* stack = thread->workStack();
 
-  std::vector<WorkDescription*> path;
+  if (stack == nullptr) {
+    return;
+  }
 
-  while (desc != nullptr && desc->_type != WorkType::THREAD) {
-    path.push_back(desc);
+  // queries are killed after reading, as the thread may have to wait for
+  // us while it holds a lock of the query list
+  std::vector<std::pair<TRI_vocbase_t*, uint64_t>> queries;
 
-    uint64_t id = desc->_id;
+  if (!stack->tryBeginRead()) {
+    return;
+  }
 
-    if (_cancelIds.find(id) != _cancelIds.end()) {
-      for (auto it = path.rbegin(); it < path.rend(); ++it) {
-        bool descent = true;
-        WorkDescription* d = *it;
+  {
+    TRI_DEFER(stack->endRead());
 
-        switch (d->_type) {
-          case WorkType::THREAD:
-            d->_data._thread._canceled.store(true);
-            break;
+    WorkDescription* desc = stack->top();
+    std::vector<WorkDescription*> path;
 
-          case WorkType::HANDLER:
-            d->_data._handler._canceled.store(true);
-            break;
+    while (desc != nullptr && desc->_type != WorkType::THREAD) {
+      path.push_back(desc);
 
-          case WorkType::AQL_STRING:
-          case WorkType::AQL_ID:
-            descent = cancelAql(d);
-            break;
+      uint64_t id = desc->_id;
 
-          case WorkType::CUSTOM:
-            d->_data._thread._canceled.store(true);
-            break;
-        }
+      if (_cancelIds.find(id) != _cancelIds.end()) {
+        for (auto it = path.rbegin(); it < path.rend(); ++it) {
+          WorkDescription* d = *it;
 
-        if (!descent) {
-          break;
+          switch (d->_type) {
+            case WorkType::THREAD:
+              d->_data._thread._canceled.store(true);
+              break;
+
+            case WorkType::HANDLER:
+              d->_data._handler._canceled.store(true);
+              break;
+
+            case WorkType::AQL_STRING:
+            case WorkType::AQL_ID:
+              d->_data._aql._canceled.store(true);
+              queries.emplace_back(d->_data._aql._vocbase, d->_data._aql._id);
+              break;
+
+            case WorkType::CUSTOM:
+              d->_data._thread._canceled.store(true);
+              break;
+          }
         }
+
+        break;
       }
 
-      return;
+      desc = desc->_prev;
     }
+  }
 
-    desc = desc->_prev.load();
+  for (auto const& it : queries) {
+    cancelAql(it.first, it.second);
   }
 }
@@ -47,7 +47,6 @@ class Builder;
 
 class WorkMonitor : public Thread {
  public:
-  static void freeWorkDescription(WorkDescription* desc);
   static bool pushThread(Thread* thread);
   static void popThread(Thread* thread);
   static void pushAql(TRI_vocbase_t*, uint64_t queryId, char const* text,
@@ -63,31 +62,33 @@ class WorkMonitor : public Thread {
                                   std::function<void()> next);
   static void cancelWork(uint64_t id);
 
+  // the name of the handler of a HANDLER work description. only reads the
+  // handler, so it may be called from a signal handler. implemented in
+  // WorkMonitorArangod.cpp
+  static char const* handlerName(WorkDescription* desc);
+
  public:
   static void initialize();
   static void shutdown();
   static void clearHandlers();
 
  private:
-  static WorkDescription* createWorkDescription(WorkType);
-  static void deleteWorkDescription(WorkDescription*, bool stopped);
-  static void activateWorkDescription(WorkDescription*);
-  static WorkDescription* deactivateWorkDescription();
+  static WorkDescription* beginPush(WorkType);
+  static void endPush(WorkDescription*);
+  static void popWorkDescription(WorkType);
   static void vpackWorkDescription(VPackBuilder*, WorkDescription*);
   static void cancelWorkDescriptions(Thread* thread);
 
   // implemented in WorkMonitorArangod.cpp
   static void addWorkOverview(std::shared_ptr<rest::RestHandler>,
                               std::shared_ptr<velocypack::Buffer<uint8_t>>);
-  static bool cancelAql(WorkDescription*);
+  static void cancelAql(TRI_vocbase_t*, uint64_t queryId);
   static void deleteHandler(WorkDescription* desc);
   static void vpackHandler(velocypack::Builder*, WorkDescription* desc);
 
  private:
   static std::atomic<bool> _stopped;
 
-  static boost::lockfree::queue<WorkDescription*> _emptyWorkDescription;
-  static boost::lockfree::queue<WorkDescription*> _freeableWorkDescription;
   static boost::lockfree::queue<
       std::pair<std::shared_ptr<rest::RestHandler>, std::function<void()>>*>
       _workOverview;
@@ -28,13 +28,12 @@ using namespace arangodb::velocypack;
 
 void WorkMonitor::run() { TRI_ASSERT(false); }
 
-bool WorkMonitor::cancelAql(WorkDescription* desc) {
-  TRI_ASSERT(false);
-  return true;
-}
+void WorkMonitor::cancelAql(TRI_vocbase_t*, uint64_t) { TRI_ASSERT(false); }
 
 void WorkMonitor::deleteHandler(WorkDescription*) { TRI_ASSERT(false); }
 
+char const* WorkMonitor::handlerName(WorkDescription*) { return "handler"; }
+
 void WorkMonitor::vpackHandler(arangodb::velocypack::Builder*,
                                WorkDescription*) {
   TRI_ASSERT(false);
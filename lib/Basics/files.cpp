@@ -2442,35 +2442,14 @@ char* TRI_GetNullBufferFiles() { return &NullBuffer[0]; }
 
 size_t TRI_GetNullBufferSizeFiles() { return sizeof(NullBuffer); }
 
-/// @brief creates a new datafile
-/// returns the file descriptor or -1 if the file cannot be created
-int TRI_CreateDatafile(std::string const& filename, size_t maximalSize) {
+/// @brief zero-fills the first maximalSize bytes of an open datafile and
+/// positions the file at offset 0. isNew must only be set for files that
+/// were just created, as a plain allocation keeps the existing contents.
+/// on failure, the file is closed and removed, and false is returned
+static bool FillDatafile(int fd, std::string const& filename,
+                         size_t maximalSize, bool isNew) {
   TRI_ERRORBUF;
 
-  // open the file
-  int fd = TRI_CREATE(filename.c_str(), O_CREAT | O_EXCL | O_RDWR | TRI_O_CLOEXEC | TRI_NOATIME,
-                      S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP);
-
-  TRI_IF_FAILURE("CreateDatafile1") {
-    // intentionally fail
-    TRI_CLOSE(fd);
-    fd = -1;
-    errno = ENOSPC;
-  }
-
-  if (fd < 0) {
-    if (errno == ENOSPC) {
-      TRI_set_errno(TRI_ERROR_ARANGO_FILESYSTEM_FULL);
-      LOG_TOPIC(ERR, arangodb::Logger::FIXME) << "cannot create datafile '" << filename << "': " << TRI_last_error();
-    } else {
-      TRI_SYSTEM_ERROR();
-
-      TRI_set_errno(TRI_ERROR_SYS_ERROR);
-      LOG_TOPIC(ERR, arangodb::Logger::FIXME) << "cannot create datafile '" << filename << "': " << TRI_GET_ERRORBUF;
-    }
-    return -1;
-  }
-
   // no fallocate present, or at least pretend it's not there...
   int res = TRI_ERROR_NOT_IMPLEMENTED;
 
@@ -2479,6 +2458,11 @@ int TRI_CreateDatafile(std::string const& filename, size_t maximalSize) {
   // try fallocate
   res = fallocate(fd, FALLOC_FL_ZERO_RANGE, 0, maximalSize);
 #endif
+  if (res != TRI_ERROR_NO_ERROR && isNew) {
+    // the filesystem does not support zeroing ranges. allocating the
+    // blocks of a new file is just as good, as they read as zeros
+    res = fallocate(fd, 0, 0, maximalSize);
+  }
 #endif
 
   if (res != TRI_ERROR_NO_ERROR) {
@@ -2514,7 +2498,7 @@ int TRI_CreateDatafile(std::string const& filename, size_t maximalSize) {
         TRI_CLOSE(fd);
         TRI_UnlinkFile(filename.c_str());
 
-        return -1;
+        return false;
       }
 
       written += static_cast<size_t>(writeResult);
@@ -2533,6 +2517,81 @@ int TRI_CreateDatafile(std::string const& filename, size_t maximalSize) {
     TRI_UnlinkFile(filename.c_str());
 
     LOG_TOPIC(ERR, arangodb::Logger::FIXME) << "cannot seek in datafile '" << filename << "': '" << TRI_GET_ERRORBUF << "'";
+    return false;
+  }
+
+  return true;
+}
+
+/// @brief creates a new datafile
+/// returns the file descriptor or -1 if the file cannot be created
+int TRI_CreateDatafile(std::string const& filename, size_t maximalSize) {
+  TRI_ERRORBUF;
+
+  // open the file
+  int fd = TRI_CREATE(filename.c_str(), O_CREAT | O_EXCL | O_RDWR | TRI_O_CLOEXEC | TRI_NOATIME,
+                      S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP);
+
+  TRI_IF_FAILURE("CreateDatafile1") {
+    // intentionally fail
+    TRI_CLOSE(fd);
+    fd = -1;
+    errno = ENOSPC;
+  }
+
+  if (fd < 0) {
+    if (errno == ENOSPC) {
+      TRI_set_errno(TRI_ERROR_ARANGO_FILESYSTEM_FULL);
+      LOG_TOPIC(ERR, arangodb::Logger::FIXME) << "cannot create datafile '" << filename << "': " << TRI_last_error();
+    } else {
+      TRI_SYSTEM_ERROR();
+
+      TRI_set_errno(TRI_ERROR_SYS_ERROR);
+      LOG_TOPIC(ERR, arangodb::Logger::FIXME) << "cannot create datafile '" << filename << "': " << TRI_GET_ERRORBUF;
+    }
+    return -1;
+  }
+
+  if (!FillDatafile(fd, filename, maximalSize, true)) {
+    return -1;
+  }
+
+  return fd;
+}
+
+/// @brief reuses an existing file of exactly maximalSize bytes as a new
+/// datafile. the file is renamed from oldFilename to filename and its
+/// contents are zeroed, so that no old markers can be mistaken for valid
+/// ones. this avoids the file system metadata updates for removing and
+/// creating files.
+/// returns the file descriptor or -1 if the file cannot be reused. the
+/// old file is left alone if it has a different size or cannot be renamed
+int TRI_RecycleDatafile(std::string const& oldFilename,
+                        std::string const& filename, size_t maximalSize) {
+  TRI_ERRORBUF;
+
+  if (TRI_SizeFile(oldFilename.c_str()) != static_cast<int64_t>(maximalSize)) {
+    return -1;
+  }
+
+  int res = TRI_RenameFile(oldFilename.c_str(), filename.c_str());
+
+  if (res != TRI_ERROR_NO_ERROR) {
+    LOG_TOPIC(WARN, arangodb::Logger::FIXME) << "cannot rename datafile '" << oldFilename << "' to '" << filename << "': " << TRI_errno_string(res);
+    return -1;
+  }
+
+  int fd = TRI_OPEN(filename.c_str(), O_RDWR | TRI_O_CLOEXEC | TRI_NOATIME);
+
+  if (fd < 0) {
+    TRI_SYSTEM_ERROR();
+    TRI_set_errno(TRI_ERROR_SYS_ERROR);
+    LOG_TOPIC(WARN, arangodb::Logger::FIXME) << "cannot open datafile '" << filename << "' for reuse: " << TRI_GET_ERRORBUF;
+    TRI_UnlinkFile(filename.c_str());
+    return -1;
+  }
+
+  if (!FillDatafile(fd, filename, maximalSize, false)) {
     return -1;
   }
 
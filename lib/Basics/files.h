@@ -366,6 +366,11 @@ size_t TRI_GetNullBufferSizeFiles();
 /// returns the file descriptor or -1 if the file cannot be created
 int TRI_CreateDatafile(std::string const& filename, size_t maximalSize);
 
+/// @brief reuses an existing file as a new datafile, see files.cpp
+/// returns the file descriptor or -1 if the file cannot be reused
+int TRI_RecycleDatafile(std::string const& oldFilename,
+                        std::string const& filename, size_t maximalSize);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief checks whether path is full qualified or relative
 ////////////////////////////////////////////////////////////////////////////////
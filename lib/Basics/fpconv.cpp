@@ -8,17 +8,10 @@
 #define expmask 0x7FF0000000000000U
 #define hiddenbit 0x0010000000000000U
 #define signmask 0x8000000000000000U
-#define expbias (1023 + 52)
 
 #define absv(n) ((n) < 0 ? -(n) : (n))
 #define minv(a, b) ((a) < (b) ? (a) : (b))
 
-static uint64_t tens[] = {
-    10000000000000000000U, 1000000000000000000U, 100000000000000000U,
-    10000000000000000U, 1000000000000000U, 100000000000000U, 10000000000000U,
-    1000000000000U, 100000000000U, 10000000000U, 1000000000U, 100000000U,
-    10000000U, 1000000U, 100000U, 10000U, 1000U, 100U, 10U, 1U};
-
 static inline uint64_t get_dbits(double d) {
   union {
     double dbl;
@@ -28,165 +21,245 @@ static inline uint64_t get_dbits(double d) {
   return dbl_bits.i;
 }
 
-static Fp build_fp(double d) {
-  uint64_t bits = get_dbits(d);
-
-  Fp fp;
-  fp.frac = bits & fracmask;
-  fp.exp = (bits & expmask) >> 52;
+/* the shortest decimal representation of a double is computed with the Ryu
+ * algorithm (see powers.h). it finds the shortest digit string in the
+ * interval of values that round to the double and picks the one closest to
+ * the exact value, so that the output always parses back to the same
+ * double */
 
-  if (fp.exp) {
-    fp.frac += hiddenbit;
-    fp.exp -= expbias;
-
-  } else {
-    fp.exp = -expbias + 1;
-  }
+#define mantissabits 52
+#define doublebias 1023
 
-  return fp;
+/* floor(log10(2^e)), for 0 <= e <= 1650 */
+static inline uint32_t log10_pow2(int32_t e) {
+  return (static_cast<uint32_t>(e) * 78913) >> 18;
 }
 
-static void normalize(Fp* fp) {
-  while ((fp->frac & hiddenbit) == 0) {
-    fp->frac <<= 1;
-    fp->exp--;
-  }
+/* floor(log10(5^e)), for 0 <= e <= 2620 */
+static inline uint32_t log10_pow5(int32_t e) {
+  return (static_cast<uint32_t>(e) * 732923) >> 20;
+}
 
-  int shift = 64 - 52 - 1;
-  fp->frac <<= shift;
-  fp->exp -= shift;
+/* number of bits of 5^e (1 for e == 0), for 0 <= e <= 3528 */
+static inline int32_t pow5bits(int32_t e) {
+  return static_cast<int32_t>((static_cast<uint32_t>(e) * 1217359) >> 19) + 1;
 }
 
-static void get_normalized_boundaries(Fp* fp, Fp* lower, Fp* upper) {
-  upper->frac = (fp->frac << 1) + 1;
-  upper->exp = fp->exp - 1;
+static inline uint32_t pow5_factor(uint64_t value) {
+  uint32_t count = 0;
 
-  while ((upper->frac & (hiddenbit << 1)) == 0) {
-    upper->frac <<= 1;
-    upper->exp--;
+  while (value % 5 == 0) {
+    value /= 5;
+    ++count;
   }
 
-  int u_shift = 64 - 52 - 2;
-
-  upper->frac <<= u_shift;
-  upper->exp = upper->exp - u_shift;
-
-  int l_shift = fp->frac == hiddenbit ? 2 : 1;
+  return count;
+}
 
-  lower->frac = (fp->frac << l_shift) - 1;
-  lower->exp = fp->exp - l_shift;
+static inline bool multiple_of_pow5(uint64_t value, uint32_t p) {
+  return pow5_factor(value) >= p;
+}
 
-  lower->frac <<= lower->exp - upper->exp;
-  lower->exp = upper->exp;
+static inline bool multiple_of_pow2(uint64_t value, uint32_t p) {
+  return (value & ((1ULL << p) - 1)) == 0;
 }
 
-static Fp multiply(Fp* a, Fp* b) {
+/* (m * mul) >> j, where mul is a 128-bit value and 64 < j < 128 */
+static inline uint64_t mul_shift(uint64_t m, uint64_t const* mul, int32_t j) {
+#if defined(__SIZEOF_INT128__)
+  __uint128_t const b0 = static_cast<__uint128_t>(m) * mul[0];
+  __uint128_t const b2 = static_cast<__uint128_t>(m) * mul[1];
+
+  return static_cast<uint64_t>(((b0 >> 64) + b2) >> (j - 64));
+#else
   uint64_t const lomask = 0x00000000FFFFFFFF;
 
-  uint64_t ah_bl = (a->frac >> 32) * (b->frac & lomask);
-  uint64_t al_bh = (a->frac & lomask) * (b->frac >> 32);
-  uint64_t al_bl = (a->frac & lomask) * (b->frac & lomask);
-  uint64_t ah_bh = (a->frac >> 32) * (b->frac >> 32);
+  /* 64 x 64 -> 128 bit multiplication, returns the lower 64 bits */
+  auto umul128 = [lomask](uint64_t a, uint64_t b, uint64_t* high) {
+    uint64_t const al_bl = (a & lomask) * (b & lomask);
+    uint64_t const al_bh = (a & lomask) * (b >> 32);
+    uint64_t const ah_bl = (a >> 32) * (b & lomask);
+    uint64_t const ah_bh = (a >> 32) * (b >> 32);
 
-  uint64_t tmp = (ah_bl & lomask) + (al_bh & lomask) + (al_bl >> 32);
-  /* round up */
-  tmp += 1U << 31;
+    uint64_t const mid1 = ah_bl + (al_bl >> 32);
+    uint64_t const mid2 = al_bh + (mid1 & lomask);
 
-  Fp fp = {ah_bh + (ah_bl >> 32) + (al_bh >> 32) + (tmp >> 32),
-           a->exp + b->exp + 64};
+    *high = ah_bh + (mid1 >> 32) + (mid2 >> 32);
+    return (mid2 << 32) | (al_bl & lomask);
+  };
 
-  return fp;
-}
+  uint64_t high1;
+  uint64_t const low1 = umul128(m, mul[1], &high1);
+  uint64_t high0;
+  umul128(m, mul[0], &high0);
 
-static void round_digit(char* digits, int ndigits, uint64_t delta, uint64_t rem,
-                        uint64_t kappa, uint64_t frac) {
-  while (rem < frac && delta - rem >= kappa &&
-         (rem + kappa < frac || frac - rem > rem + kappa - frac)) {
-    digits[ndigits - 1]--;
-    rem += kappa;
+  uint64_t const sum = high0 + low1;
+  if (sum < high0) {
+    ++high1;
   }
-}
-
-static int generate_digits(Fp* fp, Fp* upper, Fp* lower, char* digits, int* K) {
-  uint64_t wfrac = upper->frac - fp->frac;
-  uint64_t delta = upper->frac - lower->frac;
-
-  Fp one;
-  one.frac = 1ULL << -upper->exp;
-  one.exp = upper->exp;
 
-  uint64_t part1 = upper->frac >> -one.exp;
-  uint64_t part2 = upper->frac & (one.frac - 1);
+  int32_t const dist = j - 64;
+  return (high1 << (64 - dist)) | (sum >> dist);
+#endif
+}
 
-  int idx = 0, kappa = 10;
-  uint64_t* divp;
-  /* 1000000000 */
-  for (divp = tens + 10; kappa > 0; divp++) {
-    uint64_t div = *divp;
-    unsigned digit = static_cast<unsigned>(part1 / div);
+/* computes the shortest decimal representation of a finite, non-zero and
+ * positive double. returns the decimal mantissa, and stores the decimal
+ * exponent in K */
+static uint64_t ryu(uint64_t bits, int* K) {
+  uint64_t const mantissa = bits & fracmask;
+  uint32_t const exponent = static_cast<uint32_t>((bits & expmask) >> 52);
+
+  /* two additional bits for the bounds computation */
+  int32_t e2;
+  uint64_t m2;
+  if (exponent == 0) {
+    e2 = 1 - doublebias - mantissabits - 2;
+    m2 = mantissa;
+  } else {
+    e2 = static_cast<int32_t>(exponent) - doublebias - mantissabits - 2;
+    m2 = hiddenbit | mantissa;
+  }
 
-    if (digit || idx) {
-      digits[idx++] = digit + '0';
+  bool const acceptBounds = (m2 & 1) == 0;
+
+  /* the interval of valid representations is [mm, mp] around mv, scaled by
+   * 4. the lower bound is closer if the mantissa is a power of 2 */
+  uint64_t const mv = 4 * m2;
+  uint32_t const mmShift = (mantissa != 0 || exponent <= 1) ? 1 : 0;
+
+  /* convert to a decimal power base */
+  uint64_t vr, vp, vm;
+  int32_t e10;
+  bool vmIsTrailingZeros = false;
+  bool vrIsTrailingZeros = false;
+
+  if (e2 >= 0) {
+    uint32_t const q = log10_pow2(e2) - (e2 > 3 ? 1 : 0);
+    e10 = static_cast<int32_t>(q);
+    int32_t const k = DOUBLE_POW5_INV_BITCOUNT + pow5bits(q) - 1;
+    int32_t const i = -e2 + static_cast<int32_t>(q) + k;
+
+    vr = mul_shift(4 * m2, DOUBLE_POW5_INV_SPLIT[q], i);
+    vp = mul_shift(4 * m2 + 2, DOUBLE_POW5_INV_SPLIT[q], i);
+    vm = mul_shift(4 * m2 - 1 - mmShift, DOUBLE_POW5_INV_SPLIT[q], i);
+
+    if (q <= 21) {
+      /* only one of mp, mv and mm can be a multiple of 5, if any */
+      if (mv % 5 == 0) {
+        vrIsTrailingZeros = multiple_of_pow5(mv, q);
+      } else if (acceptBounds) {
+        vmIsTrailingZeros = multiple_of_pow5(mv - 1 - mmShift, q);
+      } else {
+        vp -= multiple_of_pow5(mv + 2, q) ? 1 : 0;
+      }
     }
-
-    part1 -= digit * div;
-    kappa--;
-
-    uint64_t tmp = (part1 << -one.exp) + part2;
-    if (tmp <= delta) {
-      *K += kappa;
-      round_digit(digits, idx, delta, tmp, div << -one.exp, wfrac);
-
-      return idx;
+  } else {
+    uint32_t const q = log10_pow5(-e2) - (-e2 > 1 ? 1 : 0);
+    e10 = static_cast<int32_t>(q) + e2;
+    int32_t const i = -e2 - static_cast<int32_t>(q);
+    int32_t const k = pow5bits(i) - DOUBLE_POW5_BITCOUNT;
+    int32_t const j = static_cast<int32_t>(q) - k;
+
+    vr = mul_shift(4 * m2, DOUBLE_POW5_SPLIT[i], j);
+    vp = mul_shift(4 * m2 + 2, DOUBLE_POW5_SPLIT[i], j);
+    vm = mul_shift(4 * m2 - 1 - mmShift, DOUBLE_POW5_SPLIT[i], j);
+
+    if (q <= 1) {
+      /* mv = 4 * m2 always has at least two trailing 0 bits */
+      vrIsTrailingZeros = true;
+      if (acceptBounds) {
+        /* mm = mv - 1 - mmShift has a trailing 0 bit iff mmShift is 1 */
+        vmIsTrailingZeros = mmShift == 1;
+      } else {
+        /* mp = mv + 2 always has at least one trailing 0 bit */
+        --vp;
+      }
+    } else if (q < 63) {
+      vrIsTrailingZeros = multiple_of_pow2(mv, q);
     }
   }
 
-  /* 10 */
-  uint64_t* unit = tens + 18;
+  /* find the shortest representation in the interval */
+  int32_t removed = 0;
+  uint8_t lastRemovedDigit = 0;
+  uint64_t output;
+
+  if (vmIsTrailingZeros || vrIsTrailingZeros) {
+    /* general case, which happens rarely */
+    while (vp / 10 > vm / 10) {
+      vmIsTrailingZeros &= vm % 10 == 0;
+      vrIsTrailingZeros &= lastRemovedDigit == 0;
+      lastRemovedDigit = static_cast<uint8_t>(vr % 10);
+      vr /= 10;
+      vp /= 10;
+      vm /= 10;
+      ++removed;
+    }
 
-  while (true) {
-    part2 *= 10;
-    delta *= 10;
-    kappa--;
+    if (vmIsTrailingZeros) {
+      while (vm % 10 == 0) {
+        vrIsTrailingZeros &= lastRemovedDigit == 0;
+        lastRemovedDigit = static_cast<uint8_t>(vr % 10);
+        vr /= 10;
+        vp /= 10;
+        vm /= 10;
+        ++removed;
+      }
+    }
 
-    unsigned digit = static_cast<unsigned>(part2 >> -one.exp);
-    if (digit || idx) {
-      digits[idx++] = digit + '0';
+    if (vrIsTrailingZeros && lastRemovedDigit == 5 && vr % 2 == 0) {
+      /* round to even if the exact value is .....50..0 */
+      lastRemovedDigit = 4;
     }
 
-    part2 &= one.frac - 1;
-    if (part2 < delta) {
-      *K += kappa;
-      round_digit(digits, idx, delta, part2, one.frac, wfrac * *unit);
+    /* take vr + 1 if vr is outside the bounds or needs to be rounded up */
+    output = vr + (((vr == vm && (!acceptBounds || !vmIsTrailingZeros)) ||
+                    lastRemovedDigit >= 5) ? 1 : 0);
+  } else {
+    /* common case */
+    bool roundUp = false;
+
+    if (vp / 100 > vm / 100) {
+      /* remove two digits at a time */
+      roundUp = vr % 100 >= 50;
+      vr /= 100;
+      vp /= 100;
+      vm /= 100;
+      removed += 2;
+    }
 
-      return idx;
+    while (vp / 10 > vm / 10) {
+      roundUp = vr % 10 >= 5;
+      vr /= 10;
+      vp /= 10;
+      vm /= 10;
+      ++removed;
     }
 
-    unit--;
+    output = vr + ((vr == vm || roundUp) ? 1 : 0);
   }
-}
 
-static int grisu2(double d, char* digits, int* K) {
-  Fp w = build_fp(d);
+  *K = e10 + removed;
 
-  Fp lower, upper;
-  get_normalized_boundaries(&w, &lower, &upper);
-
-  normalize(&w);
-
-  int k;
-  Fp cp = find_cachedpow10(upper.exp, &k);
+  return output;
+}
 
-  w = multiply(&w, &cp);
-  upper = multiply(&upper, &cp);
-  lower = multiply(&lower, &cp);
+/* writes the decimal digits of value, returns the number of digits */
+static int generate_digits(uint64_t value, char* digits) {
+  char temp[20];
+  int n = 0;
 
-  lower.frac++;
-  upper.frac--;
+  do {
+    temp[n++] = static_cast<char>('0' + value % 10);
+    value /= 10;
+  } while (value != 0);
 
-  *K = -k;
+  for (int i = 0; i < n; ++i) {
+    digits[i] = temp[n - 1 - i];
+  }
 
-  return generate_digits(&w, &upper, &lower, digits, K);
+  return n;
 }
 
 static int emit_digits(char* digits, int ndigits, char* dest, int K, bool neg) {
@@ -311,7 +384,7 @@ int fpconv_dtoa(double d, char dest[24]) {
   digits[0] = '\0';
 
   int K = 0;
-  int ndigits = grisu2(d, digits, &K);
+  int ndigits = generate_digits(ryu(get_dbits(d), &K), digits);
 
   str_len += emit_digits(digits, ndigits, dest + str_len, K, neg);
 
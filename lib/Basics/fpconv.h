@@ -1,7 +1,8 @@
 #ifndef LIB_BASICS_FPCONV_H
 #define LIB_BASICS_FPCONV_H 1
-/* Fast and accurate double to string conversion based on Florian Loitsch's
- * Grisu-algorithm[1].
+/* Fast and accurate double to string conversion based on Ulf Adams'
+ * Ryu-algorithm[1]. The output is the shortest string that parses back
+ * to the same double.
  *
  * Input:
  * fp -> the double to convert, dest -> destination buffer.
@@ -29,4 +30,4 @@ int fpconv_dtoa(double fp, char dest[24]);
 
 #endif
 
-/* [1] http://florian.loitsch.com/publications/dtoa-pldi2010.pdf */
+/* [1] https://dl.acm.org/citation.cfm?id=3192369 */
@@ -423,11 +423,27 @@ static const uint32_t Crc32Lookup[8][256] = {
      0x14124958, 0x5d2e347f, 0xe54c35a1, 0xac704886, 0x7734cfef, 0x3e08b2c8,
      0xc451b7cc, 0x8d6dcaeb, 0x56294d82, 0x1f1530a5}};
 
+// without the hand-optimized assembler code, x86_64 builds can still use
+// the SSE4.2 crc32 instruction via compiler intrinsics. aarch64 builds use
+// the ARMv8 crc32c instructions if the CPU provides them. both are detected
+// at runtime, so the binary also runs on CPUs without these extensions
+#if ENABLE_ASM_CRC32 == 0 && defined(__x86_64__) && defined(__GNUC__)
+#define CRC32_SSE42_INTRINSICS 1
+#else
+#define CRC32_SSE42_INTRINSICS 0
+#endif
+
+#if defined(__aarch64__) && defined(__linux__) && defined(__GNUC__)
+#define CRC32_ARMV8 1
+#else
+#define CRC32_ARMV8 0
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief Detection of Intel SSE4.2 extensions at runtime:
 ////////////////////////////////////////////////////////////////////////////////
 
-#if ENABLE_ASM_CRC32 == 1
+#if ENABLE_ASM_CRC32 == 1 || CRC32_SSE42_INTRINSICS == 1
 
 #include <cpuid.h>
 #include <x86intrin.h>
@@ -445,28 +461,75 @@ static bool HasSSE42() {
   }
 }
 
-// The following is currently not used, it is a fallback for the case
-// that the pure assembler source cannot be assembled or linked for
-// some reason.
+#endif
+
+#if CRC32_SSE42_INTRINSICS == 1
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief CRC32 value of data block, using the SSE4.2 crc32 instruction.
+/// used when the pure assembler source is not compiled in
+////////////////////////////////////////////////////////////////////////////////
 
-#if 0
-extern "C" uint32_t TRI_BlockCrc32_intrinsics(uint32_t value,
-                                              char const* data,
-                                              size_t length) {
+__attribute__((target("sse4.2")))
+static uint32_t TRI_BlockCrc32_Intrinsics(uint32_t value, char const* data,
+                                          size_t length) {
   uint64_t tmp = value;
-  auto p = reinterpret_cast<uint64_t const*>(data);
   while (length >= 8) {
-    tmp = _mm_crc32_u64(tmp, *p++);
+    uint64_t v;
+    memcpy(&v, data, sizeof(v));
+    tmp = _mm_crc32_u64(tmp, v);
+    data += 8;
     length -= 8;
   }
-  auto p2 = reinterpret_cast<unsigned char const*>(p);
   value = static_cast<uint32_t>(tmp);
   while (length-- > 0) {
-    value = _mm_crc32_u8(value, *p2++);
+    value = _mm_crc32_u8(value, static_cast<unsigned char>(*data++));
   }
   return value;
 }
+
+#endif
+
+#if CRC32_ARMV8 == 1
+
+#include <sys/auxv.h>
+
+#ifndef HWCAP_CRC32
+#define HWCAP_CRC32 (1 << 7)
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Detection of ARMv8 CRC32 extensions at runtime
+////////////////////////////////////////////////////////////////////////////////
+
+static bool HasARMv8Crc32() {
+  return (getauxval(AT_HWCAP) & HWCAP_CRC32) != 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief CRC32 value of data block, using the ARMv8 crc32c instructions
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef __clang__
+__attribute__((target("crc")))
+#else
+__attribute__((target("+crc")))
 #endif
+static uint32_t TRI_BlockCrc32_ARMv8(uint32_t value, char const* data,
+                                     size_t length) {
+  while (length >= 8) {
+    uint64_t v;
+    memcpy(&v, data, sizeof(v));
+    __asm__("crc32cx %w0, %w0, %x1" : "+r"(value) : "r"(v));
+    data += 8;
+    length -= 8;
+  }
+  while (length-- > 0) {
+    uint32_t v = static_cast<unsigned char>(*data++);
+    __asm__("crc32cb %w0, %w0, %w1" : "+r"(value) : "r"(v));
+  }
+  return value;
+}
 
 #endif
 
@@ -509,16 +572,29 @@ extern "C" {
     return value;
   }
 
-#if ENABLE_ASM_CRC32 == 1
+#if ENABLE_ASM_CRC32 == 1 || CRC32_SSE42_INTRINSICS == 1 || CRC32_ARMV8 == 1
   static uint32_t TRI_BlockCrc32_Detect(uint32_t hash,
                                         char const* data,
                                         size_t length) {
+#if ENABLE_ASM_CRC32 == 1
     if (HasSSE42()) {
       TRI_BlockCrc32 = TRI_BlockCrc32_SSE42;
-      //TRI_BlockCrc32 = TRI_BlockCrc32_intrinsics;
     } else {
       TRI_BlockCrc32 = TRI_BlockCrc32_C;
     }
+#elif CRC32_SSE42_INTRINSICS == 1
+    if (HasSSE42()) {
+      TRI_BlockCrc32 = TRI_BlockCrc32_Intrinsics;
+    } else {
+      TRI_BlockCrc32 = TRI_BlockCrc32_C;
+    }
+#else
+    if (HasARMv8Crc32()) {
+      TRI_BlockCrc32 = TRI_BlockCrc32_ARMv8;
+    } else {
+      TRI_BlockCrc32 = TRI_BlockCrc32_C;
+    }
+#endif
     return (*TRI_BlockCrc32)(hash, data, length);
   }
 
@@ -206,6 +206,52 @@ int TRI_MMFileAdvise(void* memoryAddress, size_t numOfBytes, int advice) {
 #endif
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief determines how many bytes of a region are resident in memory
+////////////////////////////////////////////////////////////////////////////////
+
+int TRI_MMFileResidentSize(void* memoryAddress, size_t numOfBytes,
+                           size_t* residentBytes) {
+  *residentBytes = 0;
+
+  if (numOfBytes == 0) {
+    return TRI_ERROR_NO_ERROR;
+  }
+
+  size_t const pageSize = static_cast<size_t>(getpagesize());
+  // mincore wants a page-aligned start address
+  uintptr_t const start =
+      reinterpret_cast<uintptr_t>(memoryAddress) & ~(pageSize - 1);
+  size_t const length =
+      numOfBytes + (reinterpret_cast<uintptr_t>(memoryAddress) - start);
+  size_t const numPages = (length + pageSize - 1) / pageSize;
+
+  std::vector<uint8_t> pages(numPages);
+#ifdef __APPLE__
+  int res = mincore(reinterpret_cast<void*>(start), length,
+                    reinterpret_cast<char*>(pages.data()));
+#else
+  int res = mincore(reinterpret_cast<void*>(start), length,
+                    reinterpret_cast<unsigned char*>(pages.data()));
+#endif
+
+  if (res != 0) {
+    res = errno;
+    LOG_TOPIC(DEBUG, Logger::MMAP) << "mincore for range " << Logger::RANGE(memoryAddress, numOfBytes) << " failed with: " << strerror(res);
+    return TRI_ERROR_SYS_ERROR;
+  }
+
+  size_t resident = 0;
+  for (auto const& page : pages) {
+    if (page & 1) {
+      ++resident;
+    }
+  }
+
+  *residentBytes = (std::min)(resident * pageSize, numOfBytes);
+  return TRI_ERROR_NO_ERROR;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief locks a region in memory
 ////////////////////////////////////////////////////////////////////////////////
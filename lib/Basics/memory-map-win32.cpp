@@ -325,6 +325,16 @@ int TRI_MMFileAdvise(void*, size_t, int) {
   return TRI_ERROR_NO_ERROR;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief determines how many bytes of a region are resident in memory
+////////////////////////////////////////////////////////////////////////////////
+
+int TRI_MMFileResidentSize(void*, size_t, size_t* residentBytes) {
+  // Not on Windows
+  *residentBytes = 0;
+  return TRI_ERROR_NOT_IMPLEMENTED;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief locks a region in memory
 ////////////////////////////////////////////////////////////////////////////////
@@ -88,6 +88,13 @@ int TRI_ProtectMMFile(void* memoryAddress, size_t numOfBytesToProtect,
 
 int TRI_MMFileAdvise(void* memoryAddress, size_t numOfBytes, int advice);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief determines how many bytes of a region are resident in memory
+////////////////////////////////////////////////////////////////////////////////
+
+int TRI_MMFileResidentSize(void* memoryAddress, size_t numOfBytes,
+                           size_t* residentBytes);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief locks a region in memory
 ////////////////////////////////////////////////////////////////////////////////
@@ -68,6 +68,13 @@
 #define TRI_UNLIKELY(v) v
 #endif
 
+/// @brief hint to fetch the cache line of an address for reading
+#if defined(__GNUC__) || defined(__GNUG__) || defined(__clang__)
+#define TRI_PREFETCH(p) __builtin_prefetch((p), 0, 3)
+#else
+#define TRI_PREFETCH(p) /* unused */
+#endif
+
 /// @brief sizetint_t
 #if defined(TRI_OVERLOAD_FUNCS_SIZE_T)
 #if TRI_SIZEOF_SIZE_T == 8
@@ -167,14 +167,36 @@ std::pair<std::shared_ptr<LogAppender>, LogTopic*> LogAppender::buildAppender(
 }
 
 void LogAppender::log(LogMessage* message) {
+  MUTEX_LOCKER(guard, _appendersLock);
+
+  logLocked(message);
+}
+
+void LogAppender::log(std::vector<LogMessage*> const& messages) {
+  MUTEX_LOCKER(guard, _appendersLock);
+
+  // write the output of all messages with a single write per file
+  LogAppenderFile::beginBatch();
+
+  try {
+    for (auto const& message : messages) {
+      logLocked(message);
+    }
+  } catch (...) {
+    LogAppenderFile::endBatch();
+    throw;
+  }
+
+  LogAppenderFile::endBatch();
+}
+
+void LogAppender::logLocked(LogMessage* message) {
   LogLevel level = message->_level;
   size_t topicId = message->_topicId;
   std::string const& m = message->_message;
   size_t offset = message->_offset;
   bool shownStd = false;
 
-  MUTEX_LOCKER(guard, _appendersLock);
-
   // output to appender
   auto output = [&level, &m, &offset, &shownStd](size_t n) -> bool {
     auto const& it = _topics2appenders.find(n);
@@ -46,6 +46,7 @@ class LogAppender {
       std::string const& definition, std::string const& contentFilter);
 
   static void log(LogMessage*);
+  static void log(std::vector<LogMessage*> const&);
   static void writeStderr(LogLevel, std::string const&);
 
   static void reopen();
@@ -74,6 +75,9 @@ class LogAppender {
  protected:
   std::string const _filter;  // an optional content filter for log messages
 
+ private:
+  static void logLocked(LogMessage*);
+
  private:
   static Mutex _appendersLock;
   static std::unique_ptr<LogAppender> _ttyAppender;
@@ -35,6 +35,33 @@ using namespace arangodb::basics;
 std::vector<std::pair<int, std::string>> LogAppenderFile::_fds = {
     {STDOUT_FILENO, "-"}, {STDERR_FILENO, "+"}};
 
+bool LogAppenderFile::_batching = false;
+
+std::vector<std::string> LogAppenderFile::_pending;
+
+/// @brief collected output above this size is written out right away
+static size_t const MaxPendingSize = 64 * 1024;
+
+void LogAppenderFile::endBatch() {
+  _batching = false;
+
+  for (size_t pos = 0; pos < _pending.size(); ++pos) {
+    std::string& pending = _pending[pos];
+
+    if (pending.empty()) {
+      continue;
+    }
+
+    int fd = _fds[pos].first;
+
+    if (fd >= 0) {
+      writeLogFile(fd, pending.c_str(), static_cast<ssize_t>(pending.size()));
+    }
+
+    pending.clear();
+  }
+}
+
 void LogAppenderFile::reopen() {
   for (size_t pos = 2; pos < _fds.size(); ++pos) {
     int old = _fds[pos].first;
@@ -177,7 +204,21 @@ bool LogAppenderFile::logMessage(LogLevel level, std::string const& message,
   TRI_EscapeControlsCString(message.c_str(), message.size(), _buffer.get(), &escapedLength, true);
   TRI_ASSERT(escapedLength <= neededBufferSize);
 
-  writeLogFile(fd, _buffer.get(), static_cast<ssize_t>(escapedLength));
+  if (_batching) {
+    if (_pending.size() < _fds.size()) {
+      _pending.resize(_fds.size());
+    }
+
+    std::string& pending = _pending[_pos];
+    pending.append(_buffer.get(), escapedLength);
+
+    if (pending.size() >= MaxPendingSize) {
+      writeLogFile(fd, pending.c_str(), static_cast<ssize_t>(pending.size()));
+      pending.clear();
+    }
+  } else {
+    writeLogFile(fd, _buffer.get(), static_cast<ssize_t>(escapedLength));
+  }
 
   if (_bufferSize > 16384) {
     // free the buffer so the Logger is not hogging so much memory
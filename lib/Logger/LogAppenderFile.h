@@ -32,6 +32,11 @@ class LogAppenderFile : public LogAppender {
   static void reopen();
   static void close();
 
+  /// @brief collect the output of all following messages per file, until
+  /// endBatch() writes it out. must be called with the appenders lock held
+  static void beginBatch() { _batching = true; }
+  static void endBatch();
+
  public:
   LogAppenderFile(std::string const& filename, std::string const& filter);
   ~LogAppenderFile();
@@ -42,11 +47,17 @@ class LogAppenderFile : public LogAppender {
   std::string details() override final;
 
  private:
-  void writeLogFile(int, char const*, ssize_t);
+  static void writeLogFile(int, char const*, ssize_t);
 
  private:
   static std::vector<std::pair<int, std::string>> _fds;
 
+  /// @brief whether output is collected instead of written right away
+  static bool _batching;
+
+  /// @brief the collected output, by position in _fds
+  static std::vector<std::string> _pending;
+
  private:
   ssize_t _pos;
 
@@ -30,6 +30,8 @@ using namespace arangodb;
 
 arangodb::basics::ConditionVariable* LogThread::CONDITION = nullptr;
 boost::lockfree::queue<LogMessage*>* LogThread::MESSAGES = nullptr;
+std::atomic<size_t> LogThread::QUEUED(0);
+std::atomic<uint64_t> LogThread::DROPPED(0);
 
 LogThread::LogThread(std::string const& name) : Thread(name), _messages(0) {
   MESSAGES = &_messages;
@@ -44,9 +46,25 @@ LogThread::~LogThread() {
   shutdown();
 }
 
-void LogThread::log(std::unique_ptr<LogMessage>& message) {
-  MESSAGES->push(message.get());
+bool LogThread::log(std::unique_ptr<LogMessage>& message) {
+  LogLevel const level = message->_level;
+
+  if (QUEUED.load(std::memory_order_relaxed) >= MaxQueuedMessages &&
+      level != LogLevel::FATAL && level != LogLevel::ERR &&
+      level != LogLevel::WARN) {
+    // the logging thread cannot keep up. rather drop the message than
+    // making the logging threads wait
+    DROPPED.fetch_add(1, std::memory_order_relaxed);
+    return true;
+  }
+
+  if (!MESSAGES->push(message.get())) {
+    return false;
+  }
+
+  QUEUED.fetch_add(1, std::memory_order_relaxed);
   message.release();
+  return true;
 }
 
 void LogThread::flush() {
@@ -63,23 +81,58 @@ void LogThread::flush() {
 }
 
 void LogThread::run() {
-  LogMessage* msg;
+  std::vector<LogMessage*> batch;
+  batch.reserve(BatchSize);
 
   while (! isStopping() && Logger::_active.load()) {
-    while (_messages.pop(msg)) {
-      try {
-        LogAppender::log(msg);
-      } catch (...) {
-      }
+    while (processBatch(batch)) {
+    }
+
+    uint64_t dropped = DROPPED.exchange(0);
 
-      delete msg;
+    if (dropped > 0) {
+      LOG_TOPIC(WARN, arangodb::Logger::FIXME)
+          << "dropped " << dropped
+          << " log message(s) because the logging thread could not keep up";
+      continue;
     }
 
     CONDITION_LOCKER(guard, *CONDITION);
     guard.wait(10 * 1000);
   }
 
+  LogMessage* msg;
+
   while (_messages.pop(msg)) {
+    QUEUED.fetch_sub(1, std::memory_order_relaxed);
     delete msg;
   }
 }
+
+bool LogThread::processBatch(std::vector<LogMessage*>& batch) {
+  TRI_ASSERT(batch.empty());
+
+  LogMessage* msg;
+
+  while (batch.size() < BatchSize && _messages.pop(msg)) {
+    batch.push_back(msg);
+  }
+
+  if (batch.empty()) {
+    return false;
+  }
+
+  QUEUED.fetch_sub(batch.size(), std::memory_order_relaxed);
+
+  try {
+    LogAppender::log(batch);
+  } catch (...) {
+  }
+
+  for (auto& it : batch) {
+    delete it;
+  }
+  batch.clear();
+
+  return true;
+}
@@ -38,7 +38,18 @@ struct LogMessage;
 
 class LogThread final : public Thread {
  public:
-  static void log(std::unique_ptr<LogMessage>&);
+  /// @brief maximal number of queued messages. when it is reached, new
+  /// messages below level WARN are dropped and counted
+  static size_t const MaxQueuedMessages = 16384;
+
+  /// @brief maximal number of messages handed to the appenders at once
+  static size_t const BatchSize = 256;
+
+ public:
+  /// @brief queue a message. takes ownership of the message if it was
+  /// queued. returns false if the message could neither be queued nor
+  /// dropped, so that the caller must log it directly
+  static bool log(std::unique_ptr<LogMessage>&);
   static void flush();
 
  public:
@@ -50,10 +61,21 @@ class LogThread final : public Thread {
   bool isSilent() override { return true; }
   void run() override;
 
+ private:
+  /// @brief hand the next batch of queued messages to the appenders.
+  /// returns false if there were no messages
+  bool processBatch(std::vector<LogMessage*>&);
+
  private:
   static arangodb::basics::ConditionVariable* CONDITION;
   static boost::lockfree::queue<LogMessage*>* MESSAGES;
 
+  /// @brief number of queued messages
+  static std::atomic<size_t> QUEUED;
+
+  /// @brief number of messages dropped since the last report
+  static std::atomic<uint64_t> DROPPED;
+
   arangodb::basics::ConditionVariable _condition;
   boost::lockfree::queue<LogMessage*> _messages;
 };
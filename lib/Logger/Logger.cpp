@@ -245,13 +245,16 @@ void Logger::log(char const* function, char const* file, long int line,
     return;
   }
 
-  std::stringstream out;
+  // build the message in a single string. this is done on the calling
+  // thread, so it avoids the overhead of a string stream and copies
+  std::string out;
+  out.reserve(64 + message.size());
 
   // time prefix
   if (_useMicrotime) {
     char buf[128];
     snprintf(buf, sizeof(buf), "%.6f ", TRI_microtime());
-    out << buf;
+    out.append(buf);
   } else {
     char timePrefix[32];
     time_t tt = time(0);
@@ -267,12 +270,13 @@ void Logger::log(char const* function, char const* file, long int line,
       strftime(timePrefix, sizeof(timePrefix), "%Y-%m-%dT%H:%M:%S ", &tb);
     }
 
-    out << timePrefix;
+    out.append(timePrefix);
   }
 
   // output prefix
   if (!_outputPrefix.empty()) {
-    out << _outputPrefix << " ";
+    out.append(_outputPrefix);
+    out.push_back(' ');
   }
 
   // append the process / thread identifier
@@ -290,11 +294,12 @@ void Logger::log(char const* function, char const* file, long int line,
                (unsigned long long)processId);
     }
 
-    out << processPrefix;
+    out.append(processPrefix);
   }
 
   // log level
-  out << Logger::translateLogLevel(level) << ' ';
+  out.append(Logger::translateLogLevel(level));
+  out.push_back(' ');
 
   // check if we must display the line number
   if (_showLineNumber) {
@@ -307,23 +312,29 @@ void Logger::log(char const* function, char const* file, long int line,
         filename = shortened + 1;
       }
     }
-    out << '[' << filename << ':' << line << "] ";
+    out.push_back('[');
+    out.append(filename);
+    out.push_back(':');
+    out.append(std::to_string(line));
+    out.append("] ");
   }
 
   // generate the complete message
-  out << message;
-  size_t offset = out.str().size() - message.size();
-  auto msg = std::make_unique<LogMessage>(level, topicId, out.str(), offset);
+  size_t offset = out.size();
+  out.append(message);
+  auto msg = std::make_unique<LogMessage>(level, topicId, std::move(out), offset);
 
   // now either queue or output the message
   if (_threaded) {
     try {
-      _loggingThread->log(msg);
-      bool const isDirectLogLevel = (level == LogLevel::FATAL || level == LogLevel::ERR || level == LogLevel::WARN);
-      if (isDirectLogLevel) {
-        _loggingThread->flush();
+      if (_loggingThread->log(msg)) {
+        bool const isDirectLogLevel = (level == LogLevel::FATAL || level == LogLevel::ERR || level == LogLevel::WARN);
+        // the logging thread itself cannot wait for its own queue
+        if (isDirectLogLevel && Thread::current() != _loggingThread.get()) {
+          _loggingThread->flush();
+        }
+        return;
       }
-      return;
     } catch (...) {
       // fall-through to non-threaded logging
     }
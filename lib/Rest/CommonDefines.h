@@ -59,6 +59,10 @@ enum class ContentType {
   UNSET
 };
 
+// encoding of a response body, negotiated via Accept-Encoding. the values
+// are ordered by preference, the cheapest coding to produce comes last
+enum class ContentEncoding { IDENTITY, DEFLATE, GZIP, SNAPPY };
+
 enum class ProtocolVersion { HTTP_1_0, HTTP_1_1, VPP_1_0, UNKNOWN };
 
 enum class ConnectionType {
@@ -32,6 +32,16 @@
 using namespace arangodb;
 using namespace arangodb::basics;
 
+VPackOptions const* GeneralRequest::optionsWithUniquenessCheck() {
+  static VPackOptions const options = []() {
+    VPackOptions options = VPackOptions::Defaults;
+    options.checkAttributeUniqueness = true;
+    return options;
+  }();
+
+  return &options;
+}
+
 std::string GeneralRequest::translateVersion(ProtocolVersion version) {
   switch (version) {
     case ProtocolVersion::VPP_1_0:
@@ -173,15 +173,22 @@ class GeneralRequest {
   virtual VPackSlice payload(arangodb::velocypack::Options const* options =
                              &VPackOptions::Defaults) = 0;
 
-  std::shared_ptr<VPackBuilder> toVelocyPackBuilderPtr() {
-    VPackOptions optionsWithUniquenessCheck = VPackOptions::Defaults;
-    optionsWithUniquenessCheck.checkAttributeUniqueness = true;
-    return std::make_shared<VPackBuilder>(payload(&optionsWithUniquenessCheck), &optionsWithUniquenessCheck);
+  // returns a builder with the payload. the builder may be shared with
+  // the request, so it must not be modified
+  virtual std::shared_ptr<VPackBuilder> toVelocyPackBuilderPtr() {
+    return std::make_shared<VPackBuilder>(
+        payload(optionsWithUniquenessCheck()), optionsWithUniquenessCheck());
   };
 
   ContentType contentType() const { return _contentType; }
   ContentType contentTypeResponse() const { return _contentTypeResponse; }
 
+ protected:
+  // options for parsing request bodies, rejecting duplicate attributes
+  static arangodb::velocypack::Options const* optionsWithUniquenessCheck();
+
+ public:
+
   rest::AuthenticationMethod authenticationMethod() const {
     return _authenticationMethod;
   }
@@ -87,6 +87,19 @@ void GeneralResponse::addPayload(VPackBuffer<uint8_t>&& buffer,
                      skipBody);
 }
 
+std::size_t GeneralResponse::memoryUsage() const {
+  std::size_t size = sizeof(*this);
+
+  for (auto const& it : _headers) {
+    size += it.first.size() + it.second.size();
+  }
+  for (auto const& it : _vpackPayloads) {
+    size += it.size();
+  }
+
+  return size;
+}
+
 std::string GeneralResponse::responseString(ResponseCode code) {
   switch (code) {
     //  Informational 1xx
@@ -123,6 +123,11 @@ class GeneralResponse {
     _headers[key] = std::move(value);
   }
   
+  // whether a header is set. the header field name must be lower-cased
+  bool hasHeaderNC(std::string const& key) const {
+    return _headers.find(key) != _headers.end();
+  }
+
   // adds a header if not set. the header field name must be lower-cased
   void setHeaderNCIfNotSet(std::string const& key, std::string const& value) {
     if (_headers.find(key) != _headers.end()) {
@@ -174,6 +179,9 @@ class GeneralResponse {
                                   bool resolveExternals, bool bodySkipped) {}
 
   virtual int reservePayload(std::size_t size) { return TRI_ERROR_NO_ERROR; }
+
+  // approximate number of bytes held by the response (headers and payload)
+  virtual std::size_t memoryUsage() const;
   bool generateBody() const { return _generateBody; };  // used for head
   virtual bool setGenerateBody(bool) {
     return _generateBody;
@@ -736,6 +736,12 @@ void HttpRequest::setBody(char const* body, size_t length) {
   _body[length] = '\0';
 }
 
+void HttpRequest::setBody(std::string&& body) {
+  _body = std::move(body);
+  _vpackBuilder.reset();
+  _payloadValidated = false;
+}
+
 VPackSlice HttpRequest::payload(VPackOptions const* options) {
   TRI_ASSERT(options != nullptr);
 
@@ -745,19 +751,45 @@ VPackSlice HttpRequest::payload(VPackOptions const* options) {
         VPackParser parser(options);
         parser.parse(_body);
         _vpackBuilder = parser.steal();
+        _vpackBuilderUnique = options->checkAttributeUniqueness;
       }
       return VPackSlice(_vpackBuilder->slice());
     }
     return VPackSlice::noneSlice();  // no body
   } else /*VPACK*/ {
-    VPackOptions validationOptions = *options; // intentional copy
-    validationOptions.validateUtf8Strings = true;
-    VPackValidator validator(&validationOptions);
-    validator.validate(_body.c_str(), _body.length());
+    // the body is used in place, but only needs to be validated once
+    if (!_payloadValidated) {
+      VPackOptions validationOptions = *options; // intentional copy
+      validationOptions.validateUtf8Strings = true;
+      VPackValidator validator(&validationOptions);
+      validator.validate(_body.c_str(), _body.length());
+      _payloadValidated = true;
+    }
     return VPackSlice(_body.c_str());
   }
 }
 
+std::shared_ptr<VPackBuilder> HttpRequest::toVelocyPackBuilderPtr() {
+  if (_contentType == ContentType::JSON) {
+    // a body parsed before without the uniqueness check must be parsed
+    // again, so that duplicate attributes are rejected. the earlier result
+    // is kept, because slices of it may still be in use
+    if (_vpackBuilder != nullptr && !_vpackBuilderUnique) {
+      VPackParser parser(optionsWithUniquenessCheck());
+      parser.parse(_body);
+      return parser.steal();
+    }
+
+    payload(optionsWithUniquenessCheck());
+
+    if (_vpackBuilder != nullptr) {
+      return _vpackBuilder;
+    }
+  }
+
+  return GeneralRequest::toVelocyPackBuilderPtr();
+}
+
 std::string const& HttpRequest::header(std::string const& key,
                                        bool& found) const {
   auto it = _headers.find(key);
@@ -73,6 +73,12 @@ class HttpRequest final : public GeneralRequest {
   arangodb::Endpoint::TransportType transportType() override {
     return arangodb::Endpoint::TransportType::HTTP;
   }
+
+  // position of the request on its connection, starting at 1. responses
+  // to pipelined requests must be sent in this order
+  uint64_t messageId() const override { return _messageId; }
+  void setMessageId(uint64_t id) { _messageId = id; }
+
   // the content length
   int64_t contentLength() const override { return _contentLength; }
 
@@ -102,10 +108,14 @@ class HttpRequest final : public GeneralRequest {
 
   std::string const& body() const;
   void setBody(char const* body, size_t length);
+  void setBody(std::string&& body);
 
   // Payload
   VPackSlice payload(arangodb::velocypack::Options const*) override final;
 
+  // hands out the parsed JSON body without copying it
+  std::shared_ptr<VPackBuilder> toVelocyPackBuilderPtr() override final;
+
   /// @brief sets a key/value header
   //  this function is called by setHeaders and get offsets to
   //  the found key / value with respective lengths.
@@ -146,11 +156,19 @@ class HttpRequest final : public GeneralRequest {
   bool _allowMethodOverride;
   std::shared_ptr<velocypack::Builder> _vpackBuilder;
 
+  // whether _vpackBuilder was parsed with the attribute uniqueness check
+  bool _vpackBuilderUnique = false;
+
+  // whether a VelocyPack body has been validated already
+  bool _payloadValidated = false;
+
   // previously in base class
   std::unordered_map<std::string, std::string>
       _headers;  // is set by httpRequest: parseHeaders -> setHeaders
   std::unordered_map<std::string, std::string> _values;
   std::unordered_map<std::string, std::vector<std::string>> _arrayValues;
+
+  uint64_t _messageId = 1;
 };
 }
 
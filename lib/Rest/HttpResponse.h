@@ -85,6 +85,9 @@ class HttpResponse : public GeneralResponse {
     return _generateBody = generateBody;
   }  // used for head-responses
   int reservePayload(std::size_t size) override { return _body.reserve(size); }
+  std::size_t memoryUsage() const override {
+    return GeneralResponse::memoryUsage() + _body.length();
+  }
   void addPayloadPostHook(VPackSlice const&, VPackOptions const* options,
                           bool resolveExternals, bool bodySkipped) override;
 
@@ -92,6 +95,10 @@ class HttpResponse : public GeneralResponse {
     return arangodb::Endpoint::TransportType::HTTP;
   }
 
+  // the message id of the request this is the response to
+  uint64_t messageId() const override { return _messageId; }
+  void setMessageId(uint64_t id) { _messageId = id; }
+
  private:
   // the body must already be set. deflate is then run on the existing body
   int deflate(size_t = 16384);
@@ -101,6 +108,7 @@ class HttpResponse : public GeneralResponse {
   std::vector<std::string> _cookies;
   basics::StringBuffer _body;
   size_t _bodySize;
+  uint64_t _messageId = 1;
 };
 }
 
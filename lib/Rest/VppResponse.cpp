@@ -44,7 +44,10 @@ using namespace arangodb::basics;
 bool VppResponse::HIDE_PRODUCT_HEADER = false;
 
 VppResponse::VppResponse(ResponseCode code, uint64_t id)
-    : GeneralResponse(code), _header(nullptr), _messageId(id) {
+    : GeneralResponse(code),
+      _header(nullptr),
+      _messageId(id),
+      _acceptEncoding(rest::ContentEncoding::IDENTITY) {
   _contentType = ContentType::VPACK;
   _connectionType = rest::ConnectionType::C_KEEP_ALIVE;
 }
@@ -66,6 +69,12 @@ VPackMessageNoOwnBuffer VppResponse::prepareForNetwork() {
   builder.add(VPackValue(int(2)));  // 2 == response
   builder.add(
       VPackValue(static_cast<int>(meta::underlyingValue(_responseCode))));
+  // meta, e.g. the error code headers that ClusterComm callers inspect
+  builder.openObject();
+  for (auto const& it : _headers) {
+    builder.add(it.first, VPackValue(it.second));
+  }
+  builder.close();
   builder.close();
   _header = builder.steal();
   if (_vpackPayloads.empty()) {
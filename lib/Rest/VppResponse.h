@@ -63,6 +63,9 @@ class VppResponse : public GeneralResponse {
   std::shared_ptr<VPackBuffer<uint8_t>>
       _header;  // generated form _headers when prepared for network
   uint64_t _messageId;
+  // encoding of the payload, negotiated via the accept-encoding meta
+  // value of the request
+  rest::ContentEncoding _acceptEncoding;
 };
 }
 
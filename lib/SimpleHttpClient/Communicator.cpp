@@ -29,6 +29,10 @@
 #include "Basics/socket-utils.h"
 #include "Logger/Logger.h"
 #include "Rest/HttpRequest.h"
+#include "SimpleHttpClient/VstConnection.h"
+
+#include <velocypack/Buffer.h>
+#include <velocypack/velocypack-aliases.h>
 
 using namespace arangodb;
 using namespace arangodb::basics;
@@ -161,11 +165,21 @@ Communicator::~Communicator() {
   ::curl_global_cleanup();
 }
 
+Ticket Communicator::createTicket() {
+  return NEXT_TICKET_ID.fetch_add(1, std::memory_order_seq_cst);
+}
+
 Ticket Communicator::addRequest(Destination destination,
                                 std::unique_ptr<GeneralRequest> request,
                                 Callbacks callbacks, Options options) {
-  uint64_t id = NEXT_TICKET_ID.fetch_add(1, std::memory_order_seq_cst);
+  Ticket id = createTicket();
+  addRequest(id, destination, std::move(request), callbacks, options);
+  return id;
+}
 
+void Communicator::addRequest(Ticket id, Destination destination,
+                              std::unique_ptr<GeneralRequest> request,
+                              Callbacks callbacks, Options options) {
   {
     TRI_ASSERT(request != nullptr);
     MUTEX_LOCKER(guard, _newRequestsLock);
@@ -184,8 +198,6 @@ Ticket Communicator::addRequest(Destination destination,
     LOG_TOPIC(WARN, Logger::COMMUNICATION)
         << "Couldn't wake up pipe. numBytes was " + std::to_string(numBytes);
   }
-
-  return Ticket{id};
 }
 
 int Communicator::work_once() {
@@ -219,14 +231,36 @@ int Communicator::work_once() {
       handleResult(handle, msg->data.result);
     }
   }
+
+  processVstConnections();
+
+  for (auto const& it : _vstConnections) {
+    for (auto const& connection : it.second._connections) {
+      stillRunning += static_cast<int>(connection->numberOfRequests());
+    }
+  }
   return stillRunning;
 }
 
 void Communicator::wait() {
   static int const MAX_WAIT_MSECS = 1000;  // wait max. 1 seconds
 
+  // wait for the wakeup pipe and the sockets of the VelocyStream
+  // connections, in addition to the sockets of curl
+  std::vector<curl_waitfd> waitFds{_wakeup};
+  for (auto const& it : _vstConnections) {
+    for (auto const& connection : it.second._connections) {
+      curl_waitfd waitFd;
+      if (connection->fillWaitFd(waitFd)) {
+        waitFds.push_back(waitFd);
+      }
+    }
+  }
+
   int numFds;  // not used here
-  int res = curl_multi_wait(_curl, &_wakeup, 1, MAX_WAIT_MSECS, &numFds);
+  int res = curl_multi_wait(_curl, waitFds.data(),
+                            static_cast<unsigned int>(waitFds.size()),
+                            MAX_WAIT_MSECS, &numFds);
   if (res != CURLM_OK) {
     throw std::runtime_error(
         "Invalid curl multi result while waiting! Result was " +
@@ -252,6 +286,15 @@ void Communicator::createRequestInProgress(NewRequest const& newRequest) {
   auto request = (HttpRequest*)newRequest._request.get();
   TRI_ASSERT(request != nullptr);
 
+  std::string url = newRequest._destination.url();
+  if (url.compare(0, 6, "vst://") == 0) {
+    if (createVstRequestInProgress(newRequest)) {
+      return;
+    }
+    // the request cannot be sent via VelocyStream
+    url = "http://" + url.substr(6);
+  }
+
   // mop: the curl handle will be managed safely via unique_ptr and hold
   // ownership for rip
   auto rip = new RequestInProgress(
@@ -288,7 +331,7 @@ void Communicator::createRequestInProgress(NewRequest const& newRequest) {
     requestHeaders = curl_slist_append(requestHeaders, thisHeader.c_str());
   }
 
-  std::string url = createSafeDottedCurlUrl(newRequest._destination.url());
+  url = createSafeDottedCurlUrl(url);
   handleInProgress->_rip->_requestHeaders = requestHeaders;
   curl_easy_setopt(handle, CURLOPT_HTTPHEADER, requestHeaders);
   curl_easy_setopt(handle, CURLOPT_HEADER, 0L);
@@ -371,6 +414,177 @@ void Communicator::createRequestInProgress(NewRequest const& newRequest) {
   curl_multi_add_handle(_curl, handle);
 }
 
+bool Communicator::createVstRequestInProgress(NewRequest const& newRequest) {
+  auto request = (HttpRequest*)newRequest._request.get();
+  std::string const& url = newRequest._destination.url();
+
+  size_t pathStart = url.find('/', 6);
+  std::string hostAndPort = url.substr(6, pathStart == std::string::npos
+                                              ? pathStart
+                                              : pathStart - 6);
+  std::string pathAndQuery =
+      pathStart == std::string::npos ? "/" : url.substr(pathStart);
+
+  VPackBuffer<uint8_t> message;
+  if (!VstConnection::encodeRequest(request, pathAndQuery, message)) {
+    return false;
+  }
+
+  // use the connection with the fewest requests in flight, and open
+  // another one if all are busy and the pool may grow
+  auto& pool = _vstConnections[hostAndPort];
+  VstConnection* connection = nullptr;
+  for (auto const& it : pool._connections) {
+    if (connection == nullptr ||
+        it->numberOfRequests() < connection->numberOfRequests()) {
+      connection = it.get();
+    }
+  }
+
+  pool.grow(_poolOptions,
+            connection != nullptr && connection->numberOfRequests() > 0,
+            TRI_microtime());
+
+  if (connection == nullptr ||
+      (connection->numberOfRequests() > 0 &&
+       pool._connections.size() < pool._limit)) {
+    connection = openVstConnection(hostAndPort, pool);
+  }
+
+  std::unique_ptr<RequestInProgress> rip(new RequestInProgress(
+      newRequest._destination, newRequest._callbacks, newRequest._ticketId,
+      std::string(), newRequest._options));
+  rip->_startTime = TRI_microtime();
+  connection->addRequest(std::move(rip), message);
+  return true;
+}
+
+void Communicator::prewarm(std::vector<std::string> const& endpoints) {
+  for (auto const& endpoint : endpoints) {
+    if (endpoint.compare(0, 6, "vst://") != 0) {
+      continue;
+    }
+    size_t pathStart = endpoint.find('/', 6);
+    std::string hostAndPort = endpoint.substr(
+        6, pathStart == std::string::npos ? pathStart : pathStart - 6);
+
+    auto& pool = _vstConnections[hostAndPort];
+    while (pool._connections.size() < _poolOptions._minConnections) {
+      VstConnection* connection = openVstConnection(hostAndPort, pool);
+      if (!connection->open()) {
+        // the server is not reachable. the connection is removed by
+        // processVstConnections(), and prewarming is tried again later
+        break;
+      }
+      ++_poolStatistics._connectionsPrewarmed;
+    }
+  }
+}
+
+void Communicator::VstPool::addLatencies(double latencySum,
+                                         uint64_t completed) {
+  if (completed == 0) {
+    return;
+  }
+  double const latency = latencySum / completed;
+  _latency = (_latency == 0.0) ? latency : 0.9 * _latency + 0.1 * latency;
+  if (_baseLatency == 0.0 || _latency < _baseLatency) {
+    _baseLatency = _latency;
+  }
+}
+
+void Communicator::VstPool::grow(PoolOptions const& options, bool allBusy,
+                                 double now) {
+  if (allBusy && _connections.size() >= _limit &&
+      _limit < options._maxConnections && _baseLatency > 0.0 &&
+      _latency > LatencyGrowthFactor * _baseLatency &&
+      now - _lastGrowth >= 1.0) {
+    _lastGrowth = now;
+    ++_limit;
+  }
+}
+
+VstConnection* Communicator::openVstConnection(
+    std::string const& hostAndPort, VstPool& pool) {
+  if (pool._limit == 0) {
+    pool._limit = (std::max)(static_cast<size_t>(1),
+                             (std::min)(_poolOptions._minConnections,
+                                        _poolOptions._maxConnections));
+  }
+  pool._connections.emplace_back(
+      std::make_unique<VstConnection>(hostAndPort, _authenticationToken));
+  ++_poolStatistics._connectionsOpened;
+  return pool._connections.back().get();
+}
+
+void Communicator::processVstConnections() {
+  double const now = TRI_microtime();
+  uint64_t numConnections = 0;
+  uint64_t connectionLimit = 0;
+  uint64_t requestsInFlight = 0;
+
+  for (auto it = _vstConnections.begin(); it != _vstConnections.end();) {
+    auto& pool = (*it).second;
+    auto& connections = pool._connections;
+
+    double latencySum = 0.0;
+    uint64_t completed = 0;
+    for (auto const& connection : connections) {
+      connection->process();
+      connection->collectLatencies(latencySum, completed);
+    }
+
+    pool.addLatencies(latencySum, completed);
+
+    // close the connections above the minimum that have been idle for
+    // too long, and let the pool shrink accordingly
+    size_t numOpen = connections.size();
+    size_t closed = 0;
+    for (auto const& connection : connections) {
+      if (numOpen <= _poolOptions._minConnections) {
+        break;
+      }
+      if (connection->numberOfRequests() == 0 && !connection->isIdle() &&
+          now - connection->lastUsed() > _poolOptions._idleTimeout) {
+        connection->close();
+        --numOpen;
+        ++closed;
+      }
+    }
+    if (closed > 0) {
+      _poolStatistics._connectionsClosedIdle += closed;
+      pool._limit = (std::max)(numOpen, _poolOptions._minConnections);
+    }
+
+    // idle connections are polled for reading, so connections closed by
+    // the server are noticed here. they are re-opened on demand, or by
+    // the next prewarming
+    size_t const before = connections.size();
+    connections.erase(
+        std::remove_if(connections.begin(), connections.end(),
+                       [](std::unique_ptr<VstConnection> const& connection) {
+                         return connection->isIdle();
+                       }),
+        connections.end());
+    _poolStatistics._connectionsBroken += before - connections.size() - closed;
+
+    if (connections.empty()) {
+      it = _vstConnections.erase(it);
+    } else {
+      numConnections += connections.size();
+      connectionLimit += pool._limit;
+      for (auto const& connection : connections) {
+        requestsInFlight += connection->numberOfRequests();
+      }
+      ++it;
+    }
+  }
+
+  _poolStatistics._connections = numConnections;
+  _poolStatistics._connectionLimit = connectionLimit;
+  _poolStatistics._requestsInFlight = requestsInFlight;
+}
+
 void Communicator::handleResult(CURL* handle, CURLcode rc) {
   // remove request in progress
   curl_multi_remove_handle(_curl, handle);
@@ -555,6 +769,13 @@ std::string Communicator::createSafeDottedCurlUrl(
 void Communicator::abortRequest(Ticket ticketId) {
   auto handle = _handlesInProgress.find(ticketId);
   if (handle == _handlesInProgress.end()) {
+    for (auto const& it : _vstConnections) {
+      for (auto const& connection : it.second._connections) {
+        if (connection->abortRequest(ticketId)) {
+          return;
+        }
+      }
+    }
     return;
   }
   std::string prefix("Communicator(" + std::to_string(handle->second->_rip->_ticketId) +
@@ -581,5 +802,11 @@ std::vector<RequestInProgress const*> Communicator::requestsInProgress() {
     TRI_ASSERT(rip != nullptr);
     vec.push_back(rip);
   }
+
+  for (auto const& it : _vstConnections) {
+    for (auto const& connection : it.second._connections) {
+      connection->requestsInProgress(vec);
+    }
+  }
   return vec;
 }
@@ -105,6 +105,7 @@ struct CurlHandle {
 
 namespace arangodb {
 namespace communicator {
+class VstConnection;
 
 class Communicator {
  public:
@@ -115,12 +116,88 @@ class Communicator {
   Ticket addRequest(Destination, std::unique_ptr<GeneralRequest>, Callbacks,
                     Options);
 
+  /// @brief add a request with a ticket id from createTicket(). this allows
+  /// the caller to register the ticket before the callbacks can run
+  void addRequest(Ticket, Destination, std::unique_ptr<GeneralRequest>,
+                  Callbacks, Options);
+
+  /// @brief create a new, unique ticket id
+  static Ticket createTicket();
+
   int work_once();
   void wait();
   std::vector<RequestInProgress const*> requestsInProgress();
   void abortRequest(Ticket ticketId);
   void abortRequests();
 
+  /// @brief set the token used to authenticate VelocyStream connections.
+  /// must be called before the first request is added
+  void setAuthenticationToken(std::string const& token) {
+    _authenticationToken = token;
+  }
+
+ public:
+  /// @brief sizing of the pools of VelocyStream connections per endpoint
+  struct PoolOptions {
+    /// @brief connections kept open to each endpoint, also when idle
+    size_t _minConnections = 2;
+    /// @brief connections a pool may grow to
+    size_t _maxConnections = 8;
+    /// @brief seconds after which idle connections above the minimum
+    /// are closed
+    double _idleTimeout = 60.0;
+  };
+
+  /// @brief statistics of all connection pools
+  struct PoolStatistics {
+    std::atomic<uint64_t> _connectionsOpened{0};
+    std::atomic<uint64_t> _connectionsPrewarmed{0};
+    std::atomic<uint64_t> _connectionsClosedIdle{0};
+    std::atomic<uint64_t> _connectionsBroken{0};
+    std::atomic<uint64_t> _connections{0};
+    std::atomic<uint64_t> _connectionLimit{0};
+    std::atomic<uint64_t> _requestsInFlight{0};
+  };
+
+  /// @brief a pool grows when the average latency of its requests exceeds
+  /// the lowest average latency observed by this factor, i.e. when
+  /// multiplexing more requests over the open connections slows them down
+  static constexpr double LatencyGrowthFactor = 2.0;
+
+  /// @brief the VelocyStream connections to one endpoint
+  struct VstPool {
+    std::vector<std::unique_ptr<VstConnection>> _connections;
+    /// @brief number of connections the pool may currently open
+    size_t _limit = 0;
+    /// @brief smoothed average latency of the requests, and the lowest
+    /// value it had
+    double _latency = 0.0;
+    double _baseLatency = 0.0;
+    /// @brief the time the limit was last raised
+    double _lastGrowth = 0.0;
+
+    /// @brief fold the latencies of the requests completed since the last
+    /// call into the average latency
+    void addLatencies(double latencySum, uint64_t completed);
+    /// @brief allow one more connection if all open ones are busy, the
+    /// pool is at its limit and the average latency shows that
+    /// multiplexing slows the requests down. the limit is raised at most
+    /// once per second, so that the latency can reflect the new connection
+    void grow(PoolOptions const& options, bool allBusy, double now);
+  };
+
+  /// @brief set the sizing of the connection pools. must be called before
+  /// the first request is added
+  void setPoolOptions(PoolOptions const& options) { _poolOptions = options; }
+
+  /// @brief open the minimum number of connections to each of the given
+  /// vst:// endpoints ahead of the first request. must be called from the
+  /// thread running work_once()
+  void prewarm(std::vector<std::string> const& endpoints);
+
+  /// @brief statistics of all connection pools, updated by work_once()
+  PoolStatistics const& poolStatistics() const { return _poolStatistics; }
+
  private:
   struct NewRequest {
     Destination _destination;
@@ -139,6 +216,12 @@ class Communicator {
   CURLM* _curl;
   CURLMcode _mc;
   curl_waitfd _wakeup;
+  /// @brief multiplexed VelocyStream connections, by endpoint. requests
+  /// to vst:// destinations are sent via these instead of curl
+  std::unordered_map<std::string, VstPool> _vstConnections;
+  std::string _authenticationToken;
+  PoolOptions _poolOptions;
+  PoolStatistics _poolStatistics;
 #ifdef _WIN32
   SOCKET _socks[2];
 #else
@@ -147,6 +230,15 @@ class Communicator {
 
  private:
   void createRequestInProgress(NewRequest const& newRequest);
+  /// @brief send a request to a vst:// destination via VelocyStream.
+  /// returns false if the request needs to be sent via HTTP instead
+  bool createVstRequestInProgress(NewRequest const& newRequest);
+  /// @brief perform the I/O of all VelocyStream connections, and adapt
+  /// the sizes of the pools
+  void processVstConnections();
+  /// @brief add a new connection to a pool
+  VstConnection* openVstConnection(std::string const& hostAndPort,
+                                   VstPool& pool);
   void handleResult(CURL*, CURLcode);
   void transformResult(CURL*, HeadersInProgress&&,
                        std::unique_ptr<basics::StringBuffer>, HttpResponse*);
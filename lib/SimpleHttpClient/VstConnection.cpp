@@ -0,0 +1,728 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "VstConnection.h"
+
+#include "Basics/StaticStrings.h"
+#include "Basics/StringUtils.h"
+#include "Basics/tri-strings.h"
+#include "Logger/Logger.h"
+#include "Rest/HttpRequest.h"
+#include "Rest/HttpResponse.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Iterator.h>
+#include <velocypack/Parser.h>
+#include <velocypack/Slice.h>
+#include <velocypack/velocypack-aliases.h>
+
+#ifndef _WIN32
+#include <netdb.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#endif
+
+using namespace arangodb;
+using namespace arangodb::basics;
+using namespace arangodb::communicator;
+
+namespace {
+/// @brief the message id used for the authentication message. ticket
+/// ids are handed out sequentially from 0, so they will never get here
+constexpr uint64_t AuthenticationMessageId = UINT64_MAX;
+
+/// @brief size of a chunk header, with and without the total message
+/// length that is only sent in the first of many chunks
+constexpr size_t ChunkHeaderLength = 2 * sizeof(uint32_t) + sizeof(uint64_t);
+constexpr size_t FirstChunkHeaderLength = ChunkHeaderLength + sizeof(uint64_t);
+
+/// @brief handlers on these paths need the request to be an HttpRequest
+std::vector<std::string> const HttpOnlyPaths{
+    "/_api/batch", "/_api/import", "/_api/replication", "/_api/upload"};
+
+bool wouldBlock() {
+#ifdef _WIN32
+  int err = WSAGetLastError();
+  return err == WSAEWOULDBLOCK || err == WSAEINPROGRESS;
+#else
+  return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR ||
+         errno == EINPROGRESS;
+#endif
+}
+
+template <typename T>
+void appendValue(std::string& buffer, T value) {
+  buffer.append(reinterpret_cast<char const*>(&value), sizeof(T));
+}
+}
+
+VstConnection::VstConnection(std::string const& hostAndPort,
+                             std::string const& authenticationToken)
+    : _hostAndPort(hostAndPort),
+      _authenticationToken(authenticationToken),
+      _state(State::DISCONNECTED),
+      _connectStarted(0.0),
+      _lastUsed(TRI_microtime()),
+      _latencySum(0.0),
+      _completed(0),
+      _writeOffset(0),
+      _totalWritten(0),
+      _totalQueued(0),
+      _readOffset(0) {
+  TRI_invalidatesocket(&_socket);
+}
+
+VstConnection::~VstConnection() {
+  if (TRI_isvalidsocket(_socket)) {
+    TRI_closesocket(_socket);
+  }
+}
+
+/// @brief encode a request into a VelocyStream message. returns
+/// false if the request cannot be transported via VelocyStream, e.g.
+/// because its body is not valid JSON
+bool VstConnection::encodeRequest(HttpRequest const* request,
+                                  std::string const& pathAndQuery,
+                                  VPackBuffer<uint8_t>& message) {
+  switch (request->contentType()) {
+    case ContentType::UNSET:
+    case ContentType::JSON:
+      break;
+    default:
+      return false;
+  }
+
+  std::string database("_system");
+  std::string path;
+  std::string query;
+
+  size_t q = pathAndQuery.find('?');
+  path = pathAndQuery.substr(0, q);
+  if (q != std::string::npos) {
+    query = pathAndQuery.substr(q + 1);
+  }
+
+  if (path.compare(0, 5, "/_db/") == 0) {
+    size_t end = path.find('/', 5);
+    database = path.substr(5, end == std::string::npos ? end : end - 5);
+    path = (end == std::string::npos) ? "/" : path.substr(end);
+  }
+  if (path.empty()) {
+    path = "/";
+  }
+
+  for (auto const& it : HttpOnlyPaths) {
+    if (path.compare(0, it.size(), it) == 0) {
+      return false;
+    }
+  }
+
+  // the request body is sent as a VelocyPack payload
+  std::shared_ptr<VPackBuilder> body;
+  std::string const& requestBody = request->body();
+
+  if (requestBody.length() > 0) {
+    try {
+      body = VPackParser::fromJson(requestBody.c_str(), requestBody.length());
+    } catch (...) {
+      return false;
+    }
+  }
+
+  VPackBuilder header;
+  header.openArray();
+  header.add(VPackValue(1));  // version
+  header.add(VPackValue(1));  // type: request
+  header.add(VPackValue(database));
+  header.add(VPackValue(static_cast<int>(request->requestType())));
+  header.add(VPackValue(path));
+
+  // parameters
+  header.openObject();
+  std::unordered_map<std::string, std::vector<std::string>> arrayValues;
+  for (auto const& part : StringUtils::split(query, '&')) {
+    if (part.empty()) {
+      continue;
+    }
+    size_t eq = part.find('=');
+    std::string key = StringUtils::urlDecode(part.substr(0, eq));
+    std::string value = (eq == std::string::npos)
+                            ? ""
+                            : StringUtils::urlDecode(part.substr(eq + 1));
+
+    if (key.size() > 2 && key.compare(key.size() - 2, 2, "[]") == 0) {
+      arrayValues[key.substr(0, key.size() - 2)].emplace_back(
+          std::move(value));
+    } else {
+      header.add(key, VPackValue(value));
+    }
+  }
+  for (auto const& it : arrayValues) {
+    header.add(VPackValue(it.first));
+    header.openArray();
+    for (auto const& value : it.second) {
+      header.add(VPackValue(value));
+    }
+    header.close();
+  }
+  header.close();
+
+  // meta
+  header.openObject();
+  for (auto const& it : request->headers()) {
+    header.add(it.first, VPackValue(it.second));
+  }
+  header.close();
+  header.close();
+
+  message.clear();
+  message.append(header.slice().startAs<char>(), header.slice().byteSize());
+  if (body != nullptr) {
+    message.append(body->slice().startAs<char>(), body->slice().byteSize());
+  }
+
+  return true;
+}
+
+/// @brief queue an encoded request for sending
+void VstConnection::addRequest(std::unique_ptr<RequestInProgress> rip,
+                               VPackBuffer<uint8_t> const& message) {
+  Ticket ticketId = rip->_ticketId;
+
+  if (!TRI_isvalidsocket(_socket) && !connect()) {
+    rip->_callbacks._onError(TRI_SIMPLE_CLIENT_COULD_NOT_CONNECT, {nullptr});
+    return;
+  }
+
+  _lastUsed = TRI_microtime();
+  queueMessage(ticketId, message.data(), message.size());
+  _requests.emplace(ticketId,
+                    PendingRequest{std::move(rip), false, _totalQueued});
+}
+
+/// @brief fill in the events to wait for. returns false if nothing
+/// needs to be waited for
+bool VstConnection::fillWaitFd(curl_waitfd& waitFd) const {
+  if (!TRI_isvalidsocket(_socket)) {
+    return false;
+  }
+
+  waitFd.fd = TRI_get_fd_or_handle_of_socket(_socket);
+  waitFd.events = CURL_WAIT_POLLIN;
+  if (_state == State::CONNECTING || _writeOffset < _writeBuffer.size()) {
+    waitFd.events |= CURL_WAIT_POLLOUT;
+  }
+  waitFd.revents = 0;
+  return true;
+}
+
+/// @brief perform all possible I/O without blocking, invoke the
+/// callbacks of completed, failed and timed out requests
+void VstConnection::process() {
+  if (TRI_isvalidsocket(_socket)) {
+    struct pollfd pfd;
+    pfd.fd = TRI_get_fd_or_handle_of_socket(_socket);
+    pfd.events = POLLIN;
+    if (_state == State::CONNECTING || _writeOffset < _writeBuffer.size()) {
+      pfd.events |= POLLOUT;
+    }
+    pfd.revents = 0;
+
+#ifdef _WIN32
+    int res = WSAPoll(&pfd, 1, 0);
+#else
+    int res = ::poll(&pfd, 1, 0);
+#endif
+
+    if (res > 0) {
+      if (_state == State::CONNECTING &&
+          (pfd.revents & (POLLOUT | POLLERR | POLLHUP))) {
+        int err = 0;
+        socklen_t len = sizeof(err);
+        if (TRI_getsockopt(_socket, SOL_SOCKET, SO_ERROR, &err, &len) != 0 ||
+            err != 0 || (pfd.revents & POLLERR)) {
+          disconnect("cannot connect");
+          return;
+        }
+        _state = State::CONNECTED;
+        pfd.revents |= POLLOUT;
+      }
+
+      if (_state == State::CONNECTED) {
+        if ((pfd.revents & POLLOUT) && !writeData()) {
+          return;
+        }
+        if ((pfd.revents & (POLLIN | POLLHUP | POLLERR)) && !readData()) {
+          return;
+        }
+      }
+    }
+  }
+
+  checkTimeouts(TRI_microtime());
+}
+
+/// @brief close the connection if there are no requests in flight
+void VstConnection::close() {
+  if (_requests.empty() && TRI_isvalidsocket(_socket)) {
+    disconnect("connection is idle");
+  }
+}
+
+/// @brief append all requests in flight
+void VstConnection::requestsInProgress(
+    std::vector<RequestInProgress const*>& result) const {
+  for (auto const& it : _requests) {
+    result.push_back(it.second._rip.get());
+  }
+}
+
+/// @brief abort a request. returns false if the request is not
+/// handled by this connection
+bool VstConnection::abortRequest(Ticket ticketId) {
+  auto it = _requests.find(ticketId);
+  if (it == _requests.end()) {
+    return false;
+  }
+  LOG_TOPIC(WARN, Logger::REQUESTS)
+      << "Communicator(" << ticketId << ") // aborting request to "
+      << it->second._rip->_destination.url();
+  failRequest(ticketId, TRI_COMMUNICATOR_REQUEST_ABORTED);
+  return true;
+}
+
+/// @brief start connecting to the server
+bool VstConnection::connect() {
+  TRI_ASSERT(!TRI_isvalidsocket(_socket));
+
+  std::string host = _hostAndPort;
+  std::string port = "8529";
+  size_t colon = host.rfind(':');
+  if (colon != std::string::npos && host.find(']', colon) == std::string::npos) {
+    port = host.substr(colon + 1);
+    host = host.substr(0, colon);
+  }
+  if (host.size() >= 2 && host[0] == '[' && host.back() == ']') {
+    host = host.substr(1, host.size() - 2);
+  }
+
+  struct addrinfo hints;
+  memset(&hints, 0, sizeof(hints));
+  hints.ai_family = AF_UNSPEC;
+  hints.ai_socktype = SOCK_STREAM;
+  struct addrinfo* result = nullptr;
+
+  if (::getaddrinfo(host.c_str(), port.c_str(), &hints, &result) != 0 ||
+      result == nullptr) {
+    LOG_TOPIC(DEBUG, Logger::COMMUNICATION)
+        << "cannot resolve VelocyStream endpoint '" << _hostAndPort << "'";
+    return false;
+  }
+
+  _socket = TRI_socket(result->ai_family, result->ai_socktype,
+                       result->ai_protocol);
+
+  if (!TRI_isvalidsocket(_socket)) {
+    ::freeaddrinfo(result);
+    return false;
+  }
+
+  TRI_SetNonBlockingSocket(_socket);
+  TRI_SetCloseOnExecSocket(_socket);
+  int flag = 1;
+  TRI_setsockopt(_socket, IPPROTO_TCP, TCP_NODELAY, &flag, sizeof(flag));
+
+  int res = TRI_connect(_socket, result->ai_addr,
+                        static_cast<int>(result->ai_addrlen));
+  ::freeaddrinfo(result);
+
+  if (res != 0 && !wouldBlock()) {
+    TRI_closesocket(_socket);
+    TRI_invalidatesocket(&_socket);
+    return false;
+  }
+
+  _state = State::CONNECTING;
+  _connectStarted = TRI_microtime();
+  _writeBuffer.clear();
+  _writeOffset = 0;
+  _totalWritten = 0;
+  _totalQueued = 0;
+  _readBuffer.clear();
+  _readOffset = 0;
+  _incompleteMessages.clear();
+
+  // the protocol preface makes the server switch from HTTP to VelocyStream
+  _writeBuffer.append("VST/1.0\r\n\r\n");
+  _totalQueued = _writeBuffer.size();
+
+  if (!_authenticationToken.empty()) {
+    // messages are handled in order by the server, so the requests
+    // queued after the authentication do not need to wait for its answer
+    VPackBuilder auth;
+    auth.openArray();
+    auth.add(VPackValue(1));     // version
+    auth.add(VPackValue(1000));  // type: authentication
+    auth.add(VPackValue("jwt"));
+    auth.add(VPackValue(_authenticationToken));
+    auth.close();
+    queueMessage(AuthenticationMessageId, auth.slice().begin(),
+                 auth.slice().byteSize());
+  }
+
+  return true;
+}
+
+/// @brief close the socket. requests that have been sent fail with
+/// a timeout, all others with a connection error
+void VstConnection::disconnect(std::string const& reason) {
+  LOG_TOPIC(DEBUG, Logger::COMMUNICATION)
+      << "closing VelocyStream connection to '" << _hostAndPort
+      << "': " << reason;
+
+  if (TRI_isvalidsocket(_socket)) {
+    TRI_closesocket(_socket);
+    TRI_invalidatesocket(&_socket);
+  }
+  _state = State::DISCONNECTED;
+  _writeBuffer.clear();
+  _writeOffset = 0;
+  _readBuffer.clear();
+  _readOffset = 0;
+  _incompleteMessages.clear();
+
+  std::unordered_map<Ticket, PendingRequest> requests;
+  requests.swap(_requests);
+
+  for (auto& it : requests) {
+    it.second._rip->_callbacks._onError(
+        it.second._sent ? TRI_ERROR_CLUSTER_TIMEOUT
+                        : TRI_SIMPLE_CLIENT_COULD_NOT_CONNECT,
+        {nullptr});
+  }
+}
+
+/// @brief queue the chunks for a message
+void VstConnection::queueMessage(uint64_t messageId, uint8_t const* data,
+                                 size_t length) {
+  size_t const before = _writeBuffer.size();
+  appendChunks(_writeBuffer, messageId, data, length);
+  _totalQueued += _writeBuffer.size() - before;
+}
+
+/// @brief append the chunks of a message
+void VstConnection::appendChunks(std::string& out, uint64_t messageId,
+                                 uint8_t const* data, size_t length) {
+  if (length + ChunkHeaderLength <= MaxChunkSize) {
+    appendValue<uint32_t>(out,
+                          static_cast<uint32_t>(length + ChunkHeaderLength));
+    appendValue<uint32_t>(out, (1 << 1) | 0x1);
+    appendValue<uint64_t>(out, messageId);
+    out.append(reinterpret_cast<char const*>(data), length);
+    return;
+  }
+
+  size_t const firstBytes = MaxChunkSize - FirstChunkHeaderLength;
+  size_t const followBytes = MaxChunkSize - ChunkHeaderLength;
+  uint32_t const numberOfChunks = static_cast<uint32_t>(
+      1 + (length - firstBytes + followBytes - 1) / followBytes);
+
+  appendValue<uint32_t>(out, static_cast<uint32_t>(MaxChunkSize));
+  appendValue<uint32_t>(out, (numberOfChunks << 1) | 0x1);
+  appendValue<uint64_t>(out, messageId);
+  appendValue<uint64_t>(out, static_cast<uint64_t>(length));
+  out.append(reinterpret_cast<char const*>(data), firstBytes);
+
+  size_t offset = firstBytes;
+  uint32_t chunk = 0;
+  while (offset < length) {
+    size_t n = (std::min)(followBytes, length - offset);
+    appendValue<uint32_t>(out, static_cast<uint32_t>(n + ChunkHeaderLength));
+    appendValue<uint32_t>(out, (++chunk) << 1);
+    appendValue<uint64_t>(out, messageId);
+    out.append(reinterpret_cast<char const*>(data) + offset, n);
+    offset += n;
+  }
+}
+
+/// @brief write as much data as possible
+bool VstConnection::writeData() {
+  while (_writeOffset < _writeBuffer.size()) {
+#ifdef MSG_NOSIGNAL
+    int flags = MSG_NOSIGNAL;
+#else
+    int flags = 0;
+#endif
+    int n = TRI_send(_socket, _writeBuffer.data() + _writeOffset,
+                     _writeBuffer.size() - _writeOffset, flags);
+    if (n < 0) {
+      if (wouldBlock()) {
+        break;
+      }
+      disconnect(std::string("write failed: ") + strerror(errno));
+      return false;
+    }
+    _writeOffset += static_cast<size_t>(n);
+    _totalWritten += static_cast<uint64_t>(n);
+  }
+
+  if (_writeOffset == _writeBuffer.size()) {
+    _writeBuffer.clear();
+    _writeOffset = 0;
+  } else if (_writeOffset > 4 * MaxChunkSize) {
+    _writeBuffer.erase(0, _writeOffset);
+    _writeOffset = 0;
+  }
+
+  for (auto& it : _requests) {
+    if (!it.second._sent && it.second._sentOffset <= _totalWritten) {
+      it.second._sent = true;
+    }
+  }
+  return true;
+}
+
+/// @brief read as much data as possible and handle complete chunks
+bool VstConnection::readData() {
+  bool closed = false;
+  char buffer[16384];
+
+  while (true) {
+    int n = TRI_readsocket(_socket, buffer, sizeof(buffer), 0);
+    if (n > 0) {
+      _readBuffer.append(buffer, static_cast<size_t>(n));
+      continue;
+    }
+    if (n < 0 && wouldBlock()) {
+      break;
+    }
+    closed = true;
+    break;
+  }
+
+  if (!readChunks(_readBuffer, _readOffset, _incompleteMessages,
+                  [this](uint64_t messageId,
+                         VPackBuffer<uint8_t> const& message) {
+                    handleMessage(messageId, message);
+                  })) {
+    disconnect("invalid chunk length");
+    return false;
+  }
+
+  if (_readOffset == _readBuffer.size()) {
+    _readBuffer.clear();
+    _readOffset = 0;
+  } else if (_readOffset > 4 * MaxChunkSize) {
+    _readBuffer.erase(0, _readOffset);
+    _readOffset = 0;
+  }
+
+  if (closed) {
+    disconnect("connection closed by server");
+    return false;
+  }
+  return true;
+}
+
+/// @brief handle the complete chunks in the buffer
+bool VstConnection::readChunks(
+    std::string const& buffer, size_t& offset, IncompleteMessages& incomplete,
+    std::function<void(uint64_t, VPackBuffer<uint8_t> const&)> const&
+        onMessage) {
+  while (buffer.size() - offset >= ChunkHeaderLength) {
+    char const* p = buffer.data() + offset;
+
+    uint32_t chunkLength;
+    memcpy(&chunkLength, p, sizeof(chunkLength));
+    if (chunkLength < ChunkHeaderLength) {
+      return false;
+    }
+    if (buffer.size() - offset < chunkLength) {
+      break;
+    }
+
+    uint32_t chunkX;
+    memcpy(&chunkX, p + sizeof(uint32_t), sizeof(chunkX));
+    uint64_t messageId;
+    memcpy(&messageId, p + 2 * sizeof(uint32_t), sizeof(messageId));
+
+    bool const isFirst = (chunkX & 0x1) != 0;
+    uint32_t const chunk = chunkX >> 1;
+    size_t headerLength = ChunkHeaderLength;
+    uint64_t messageLength = 0;
+
+    if (isFirst && chunk > 1) {
+      if (chunkLength < FirstChunkHeaderLength) {
+        return false;
+      }
+      memcpy(&messageLength, p + ChunkHeaderLength, sizeof(messageLength));
+      headerLength = FirstChunkHeaderLength;
+    }
+
+    uint8_t const* data = reinterpret_cast<uint8_t const*>(p + headerLength);
+    size_t const dataLength = chunkLength - headerLength;
+    offset += chunkLength;
+
+    if (isFirst && chunk == 1) {
+      // the message consists of this chunk only
+      VPackBuffer<uint8_t> message;
+      message.append(data, dataLength);
+      onMessage(messageId, message);
+      continue;
+    }
+
+    if (isFirst) {
+      IncompleteMessage& m = incomplete[messageId];
+      m._buffer.clear();
+      m._buffer.append(data, dataLength);
+      m._length = messageLength;
+    } else {
+      auto it = incomplete.find(messageId);
+      if (it == incomplete.end()) {
+        continue;
+      }
+      it->second._buffer.append(data, dataLength);
+    }
+
+    auto it = incomplete.find(messageId);
+    if (it->second._buffer.size() >= it->second._length) {
+      onMessage(messageId, it->second._buffer);
+      incomplete.erase(it);
+    }
+  }
+
+  return true;
+}
+
+/// @brief handle a complete message received from the server
+void VstConnection::handleMessage(uint64_t messageId,
+                                  VPackBuffer<uint8_t> const& message) {
+  int code = 0;
+  VPackSlice header;
+
+  try {
+    header = VPackSlice(message.data());
+    code = header.at(2).getNumber<int>();
+  } catch (...) {
+    if (messageId != AuthenticationMessageId) {
+      failRequest(messageId, TRI_ERROR_INTERNAL);
+    }
+    return;
+  }
+
+  if (messageId == AuthenticationMessageId) {
+    if (code != static_cast<int>(ResponseCode::OK)) {
+      LOG_TOPIC(WARN, Logger::COMMUNICATION)
+          << "VelocyStream authentication at '" << _hostAndPort
+          << "' failed with code " << code;
+    }
+    return;
+  }
+
+  auto it = _requests.find(messageId);
+  if (it == _requests.end()) {
+    // request was aborted or has timed out
+    return;
+  }
+
+  std::unique_ptr<RequestInProgress> rip = std::move(it->second._rip);
+  _requests.erase(it);
+
+  std::unique_ptr<GeneralResponse> response(
+      new HttpResponse(static_cast<ResponseCode>(code)));
+  HttpResponse* httpResponse = static_cast<HttpResponse*>(response.get());
+
+  try {
+    HeadersInProgress headers;
+    if (header.length() > 3 && header.at(3).isObject()) {
+      for (auto const& meta : VPackObjectIterator(header.at(3))) {
+        if (meta.value.isString()) {
+          headers.emplace(StringUtils::tolower(meta.key.copyString()),
+                          meta.value.copyString());
+        }
+      }
+    }
+
+    size_t const headerSize = header.byteSize();
+    if (headerSize < message.size()) {
+      // the callers expect a JSON body, as delivered via HTTP
+      VPackSlice payload(message.data() + headerSize);
+      std::string json = payload.toJson();
+      httpResponse->body().appendText(json.data(), json.size());
+      headers[StaticStrings::ContentTypeHeader] =
+          StaticStrings::MimeTypeJson;
+    }
+    httpResponse->setHeaders(std::move(headers));
+  } catch (...) {
+    rip->_callbacks._onError(TRI_ERROR_INTERNAL, {nullptr});
+    return;
+  }
+
+  double const now = TRI_microtime();
+  _lastUsed = now;
+  _latencySum += now - rip->_startTime;
+  ++_completed;
+
+  LOG_TOPIC(TRACE, Logger::COMMUNICATION)
+      << "Communicator(" << rip->_ticketId << ") // VelocyStream response "
+      << code << " after " << Logger::FIXED(now - rip->_startTime)
+      << " s";
+
+  if (code < 400) {
+    rip->_callbacks._onSuccess(std::move(response));
+  } else {
+    rip->_callbacks._onError(code, std::move(response));
+  }
+}
+
+/// @brief fail and remove requests whose timeout has passed
+void VstConnection::checkTimeouts(double now) {
+  std::vector<std::pair<Ticket, int>> expired;
+
+  for (auto const& it : _requests) {
+    RequestInProgress const* rip = it.second._rip.get();
+    if (_state == State::CONNECTING &&
+        now - _connectStarted > rip->_options.connectionTimeout) {
+      expired.emplace_back(it.first, TRI_SIMPLE_CLIENT_COULD_NOT_CONNECT);
+    } else if (now - rip->_startTime > rip->_options.requestTimeout) {
+      expired.emplace_back(it.first, TRI_ERROR_CLUSTER_TIMEOUT);
+    }
+  }
+
+  for (auto const& it : expired) {
+    failRequest(it.first, it.second);
+  }
+
+  if (_state == State::CONNECTING && !expired.empty() && _requests.empty()) {
+    disconnect("connect timeout");
+  }
+}
+
+/// @brief invoke the error callback of a request and remove it
+void VstConnection::failRequest(Ticket ticketId, int errorCode) {
+  auto it = _requests.find(ticketId);
+  if (it == _requests.end()) {
+    return;
+  }
+  std::unique_ptr<RequestInProgress> rip = std::move(it->second._rip);
+  _requests.erase(it);
+  rip->_callbacks._onError(errorCode, {nullptr});
+}
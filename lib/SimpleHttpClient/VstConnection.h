@@ -0,0 +1,202 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGODB_SIMPLE_HTTP_CLIENT_VST_CONNECTION_H
+#define ARANGODB_SIMPLE_HTTP_CLIENT_VST_CONNECTION_H 1
+
+#include "curl/curl.h"
+
+#include "Basics/Common.h"
+#include "Basics/socket-utils.h"
+#include "SimpleHttpClient/Communicator.h"
+
+#include <velocypack/Buffer.h>
+
+namespace arangodb {
+class HttpRequest;
+
+namespace communicator {
+
+/// @brief a single multiplexed VelocyStream connection to a server.
+/// any number of requests can be in flight on the connection at the
+/// same time. requests are identified by their VelocyStream message id,
+/// which is the ticket id of the request. the connection is driven
+/// by the Communicator's thread only, so it does not need any locking
+class VstConnection {
+ public:
+  VstConnection(std::string const& hostAndPort,
+                std::string const& authenticationToken);
+  ~VstConnection();
+
+  VstConnection(VstConnection const&) = delete;
+  VstConnection& operator=(VstConnection const&) = delete;
+
+ public:
+  /// @brief maximum size of a chunk sent by the client
+  static constexpr size_t MaxChunkSize = 30 * 1024;
+
+  /// @brief encode a request into a VelocyStream message. returns
+  /// false if the request cannot be transported via VelocyStream, e.g.
+  /// because its body is not valid JSON
+  static bool encodeRequest(HttpRequest const* request,
+                            std::string const& pathAndQuery,
+                            arangodb::velocypack::Buffer<uint8_t>& message);
+
+  /// @brief the chunks of a message that have arrived so far
+  struct IncompleteMessage {
+    arangodb::velocypack::Buffer<uint8_t> _buffer;
+    uint64_t _length;
+  };
+
+  /// @brief messages of which not all chunks have arrived yet, by id
+  typedef std::unordered_map<uint64_t, IncompleteMessage> IncompleteMessages;
+
+  /// @brief append the VelocyStream 1.0 chunks of a message to out
+  static void appendChunks(std::string& out, uint64_t messageId,
+                           uint8_t const* data, size_t length);
+
+  /// @brief handle the complete chunks in buffer from offset on, and
+  /// advance offset past them. onMessage is called for every message whose chunks
+  /// have all arrived. returns false if the data is not valid VelocyStream
+  static bool readChunks(
+      std::string const& buffer, size_t& offset,
+      IncompleteMessages& incomplete,
+      std::function<void(uint64_t,
+                         arangodb::velocypack::Buffer<uint8_t> const&)> const&
+          onMessage);
+
+  /// @brief queue an encoded request for sending
+  void addRequest(std::unique_ptr<RequestInProgress> rip,
+                  arangodb::velocypack::Buffer<uint8_t> const& message);
+
+  /// @brief number of requests in flight on this connection
+  size_t numberOfRequests() const { return _requests.size(); }
+
+  /// @brief whether the connection can be removed
+  bool isIdle() const {
+    return _requests.empty() && !TRI_isvalidsocket(_socket);
+  }
+
+  /// @brief start connecting ahead of the first request. returns false
+  /// if the connection cannot be opened
+  bool open() { return TRI_isvalidsocket(_socket) || connect(); }
+
+  /// @brief close the connection if there are no requests in flight
+  void close();
+
+  /// @brief the time the connection was last used for a request
+  double lastUsed() const { return _lastUsed; }
+
+  /// @brief add the total latency and the number of the requests completed
+  /// since the last call
+  void collectLatencies(double& latencySum, uint64_t& completed) {
+    latencySum += _latencySum;
+    completed += _completed;
+    _latencySum = 0.0;
+    _completed = 0;
+  }
+
+  /// @brief fill in the events to wait for. returns false if nothing
+  /// needs to be waited for
+  bool fillWaitFd(curl_waitfd& waitFd) const;
+
+  /// @brief perform all possible I/O without blocking, invoke the
+  /// callbacks of completed, failed and timed out requests
+  void process();
+
+  /// @brief append all requests in flight
+  void requestsInProgress(std::vector<RequestInProgress const*>& result) const;
+
+  /// @brief abort a request. returns false if the request is not
+  /// handled by this connection
+  bool abortRequest(Ticket ticketId);
+
+ private:
+  enum class State { DISCONNECTED, CONNECTING, CONNECTED };
+
+  /// @brief start connecting to the server
+  bool connect();
+
+  /// @brief close the socket. requests that have been sent fail with
+  /// a timeout, all others with a connection error
+  void disconnect(std::string const& reason);
+
+  /// @brief queue the chunks for a message
+  void queueMessage(uint64_t messageId, uint8_t const* data, size_t length);
+
+  /// @brief write as much data as possible
+  bool writeData();
+
+  /// @brief read as much data as possible and handle complete chunks
+  bool readData();
+
+  /// @brief handle a complete message received from the server
+  void handleMessage(uint64_t messageId,
+                     arangodb::velocypack::Buffer<uint8_t> const& message);
+
+  /// @brief fail and remove requests whose timeout has passed
+  void checkTimeouts(double now);
+
+  /// @brief invoke the error callback of a request and remove it
+  void failRequest(Ticket ticketId, int errorCode);
+
+ private:
+  struct PendingRequest {
+    std::unique_ptr<RequestInProgress> _rip;
+    /// @brief whether the message has been handed to the socket
+    /// completely
+    bool _sent;
+    /// @brief write offset after which the message is completely sent
+    uint64_t _sentOffset;
+  };
+
+  std::string const _hostAndPort;
+  std::string const _authenticationToken;
+
+  TRI_socket_t _socket;
+  State _state;
+  double _connectStarted;
+  double _lastUsed;
+
+  /// @brief latency of the requests completed since the last collection
+  double _latencySum;
+  uint64_t _completed;
+
+  /// @brief the requests in flight, by message id
+  std::unordered_map<Ticket, PendingRequest> _requests;
+
+  /// @brief data to write, and total number of bytes written so far
+  std::string _writeBuffer;
+  size_t _writeOffset;
+  uint64_t _totalWritten;
+  uint64_t _totalQueued;
+
+  /// @brief data read but not yet handled
+  std::string _readBuffer;
+  size_t _readOffset;
+
+  /// @brief messages of which not all chunks have arrived yet
+  IncompleteMessages _incompleteMessages;
+};
+}
+}
+
+#endif
@@ -23,6 +23,7 @@
 #include "SslServerFeature.h"
 
 #include "Basics/FileUtils.h"
+#include "Basics/MutexLocker.h"
 #include "Basics/locks.h"
 #include "Logger/Logger.h"
 #include "ProgramOptions/ProgramOptions.h"
@@ -68,6 +69,16 @@ void SslServerFeature::collectOptions(std::shared_ptr<ProgramOptions> options) {
                      "enable the session cache for connections",
                      new BooleanParameter(&_sessionCache));
 
+  options->addOption("--ssl.session-timeout",
+                     "lifetime of cached sessions and session tickets "
+                     "(in seconds)",
+                     new UInt64Parameter(&_sessionTimeout));
+
+  options->addOption("--ssl.session-tickets",
+                     "allow clients to resume sessions with session tickets "
+                     "(RFC 5077)",
+                     new BooleanParameter(&_sessionTickets));
+
   options->addOption("--ssl.cipher-list",
                      "ssl cipers to use, see OpenSSL documentation",
                      new StringParameter(&_cipherList));
@@ -138,7 +149,7 @@ void SslServerFeature::verifySslOptions() {
   }
 
   try {
-    createSslContext();
+    sslContext();
   } catch (...) {
     LOG_TOPIC(FATAL, arangodb::Logger::SSL) << "cannot create SSL context";
     FATAL_ERROR_EXIT();
@@ -186,9 +197,16 @@ boost::asio::ssl::context SslServerFeature::createSslContext() const {
     LOG_TOPIC(TRACE, arangodb::Logger::SSL) << "using SSL session caching";
   }
 
+  // the timeout applies to both the cache and tickets
+  SSL_CTX_set_timeout(nativeContext, static_cast<long>(_sessionTimeout));
+
   // set options
   SSL_CTX_set_options(nativeContext, (long)_sslOptions);
 
+  if (!_sessionTickets) {
+    SSL_CTX_set_options(nativeContext, SSL_OP_NO_TICKET);
+  }
+
   if (!_cipherList.empty()) {
     if (SSL_CTX_set_cipher_list(nativeContext, _cipherList.c_str()) != 1) {
       LOG_TOPIC(ERR, arangodb::Logger::SSL) << "cannot set SSL cipher list '"
@@ -289,6 +307,16 @@ boost::asio::ssl::context SslServerFeature::createSslContext() const {
   return sslContext;
 }
 
+boost::asio::ssl::context& SslServerFeature::sslContext() {
+  MUTEX_LOCKER(guard, _sslContextLock);
+
+  if (_sslContext == nullptr) {
+    _sslContext.reset(new boost::asio::ssl::context(createSslContext()));
+  }
+
+  return *_sslContext;
+}
+
 std::string SslServerFeature::stringifySslOptions(uint64_t opts) const {
   std::string result;
 
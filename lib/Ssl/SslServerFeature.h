@@ -24,6 +24,7 @@
 #define ARANGODB_APPLICATION_FEATURES_SSL_SERVER_FEATURE_H 1
 
 #include "ApplicationFeatures/ApplicationFeature.h"
+#include "Basics/Mutex.h"
 
 // needs to come first
 #include "Ssl/ssl-helper.h"
@@ -50,10 +51,17 @@ class SslServerFeature : public application_features::ApplicationFeature {
  public:
   virtual boost::asio::ssl::context createSslContext() const;
 
+  // the context shared by all SSL connections of the server. it is created
+  // on first use. connections can only resume the sessions of other
+  // connections of the same context
+  boost::asio::ssl::context& sslContext();
+
  protected:
   std::string _cafile;
   std::string _keyfile;
-  bool _sessionCache = false;
+  bool _sessionCache = true;
+  uint64_t _sessionTimeout = 300;
+  bool _sessionTickets = true;
   std::string _cipherList;
   uint64_t _sslProtocol = TLS_V1;
   uint64_t _sslOptions =
@@ -65,6 +73,9 @@ class SslServerFeature : public application_features::ApplicationFeature {
 
  private:
   std::string _rctx;
+
+  Mutex _sslContextLock;
+  std::unique_ptr<boost::asio::ssl::context> _sslContext;
 };
 }
 
@@ -26,6 +26,7 @@
 TRI_v8_global_s::TRI_v8_global_s(v8::Isolate* isolate)
     : JSCollections(),
       JSVPack(),
+      AqlExpressions(),
 
       AgencyTempl(),
       AgentTempl(),
@@ -349,6 +349,11 @@ typedef struct TRI_v8_global_s {
   /// @brief document ditches mapping for weak pointers
   std::unordered_map<void*, v8::Persistent<v8::External>> JSVPack;
 
+  /// @brief compiled AQL expressions, keyed by their generated code. they
+  /// are reused by all queries executed in the context
+  std::unordered_map<std::string, v8::Persistent<v8::Function>>
+      AqlExpressions;
+
   /// @brief agency template
   v8::Persistent<v8::ObjectTemplate> AgencyTempl;
 
@@ -23,6 +23,7 @@
 
 #include "v8-vpack.h"
 
+#include <velocypack/Buffer.h>
 #include <velocypack/Iterator.h>
 #include <velocypack/velocypack-aliases.h>
 
@@ -245,6 +246,338 @@ v8::Handle<v8::Value> TRI_VPackToV8(v8::Isolate* isolate,
   }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief wrapper type of V8 objects that are backed by a VPack document.
+/// 1 and 2 are used by the database and collection wrappers
+////////////////////////////////////////////////////////////////////////////////
+
+static int32_t const WRP_VPACK_DOCUMENT_TYPE = 3;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief objects of at least this size are wrapped by TRI_VPackToV8Lazy
+////////////////////////////////////////////////////////////////////////////////
+
+static VPackValueLength const LazyDocumentSize = 2048;
+
+namespace {
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the data of a V8 object backed by a VPack document.
+/// attributes are converted into V8 values when they are accessed for the
+/// first time, and are stored as regular properties of the object from then
+/// on. attributes that were assigned or deleted shadow the document
+////////////////////////////////////////////////////////////////////////////////
+
+struct VPackDocument {
+  VPackSlice slice() const { return VPackSlice(buffer.data()); }
+
+  /// @brief copy of the document, without custom types and externals
+  VPackBuffer<uint8_t> buffer;
+  /// @brief attributes deleted from the V8 object
+  std::unordered_set<std::string> deleted;
+  /// @brief weak handle, the document is freed with the V8 object
+  v8::Persistent<v8::External> handle;
+  /// @brief an attribute was assigned, defined or deleted in V8
+  bool modified = false;
+  /// @brief an object or array attribute was handed out, which may have
+  /// been modified in place
+  bool materializedObjects = false;
+  /// @brief set while an accessed attribute is stored in the object
+  bool materializing = false;
+};
+}
+
+static VPackDocument* UnwrapVPackDocument(v8::Handle<v8::Object> object) {
+  return TRI_UnwrapClass<VPackDocument>(object, WRP_VPACK_DOCUMENT_TYPE);
+}
+
+static void VPackDocumentGetter(
+    v8::Local<v8::Name> name, v8::PropertyCallbackInfo<v8::Value> const& args) {
+  v8::Isolate* isolate = args.GetIsolate();
+  v8::Local<v8::Object> self = args.Holder();
+
+  if (self->HasRealNamedProperty(isolate->GetCurrentContext(), name)
+          .FromMaybe(false)) {
+    // accessed or assigned before
+    return;
+  }
+
+  VPackDocument* document = UnwrapVPackDocument(self);
+  v8::String::Utf8Value str(name);
+  if (document == nullptr || *str == nullptr) {
+    return;
+  }
+
+  std::string const attribute(*str, str.length());
+  if (document->deleted.find(attribute) != document->deleted.end()) {
+    return;
+  }
+
+  VPackSlice const slice = document->slice();
+  VPackSlice value = slice.get(attribute);
+  if (value.isNone()) {
+    return;
+  }
+
+  v8::Handle<v8::Value> result;
+  try {
+    result = TRI_VPackToV8(isolate, value, &VPackOptions::Defaults, &slice);
+  } catch (...) {
+    TRI_V8_THROW_EXCEPTION_MEMORY();
+  }
+  if (value.isObject() || value.isArray()) {
+    document->materializedObjects = true;
+  }
+
+  // store the value, so that further accesses return the same V8 value
+  document->materializing = true;
+  bool const stored =
+      self->CreateDataProperty(isolate->GetCurrentContext(), name, result)
+          .FromMaybe(false);
+  document->materializing = false;
+
+  if (!stored) {
+    // an exception is pending
+    return;
+  }
+
+  args.GetReturnValue().Set(result);
+}
+
+static void VPackDocumentSetter(
+    v8::Local<v8::Name> name, v8::Local<v8::Value> value,
+    v8::PropertyCallbackInfo<v8::Value> const& args) {
+  VPackDocument* document = UnwrapVPackDocument(args.Holder());
+  if (document != nullptr && !document->materializing) {
+    document->modified = true;
+  }
+  // not intercepted, V8 stores the value as a regular property
+}
+
+static void VPackDocumentDefiner(
+    v8::Local<v8::Name> name, v8::PropertyDescriptor const& desc,
+    v8::PropertyCallbackInfo<v8::Value> const& args) {
+  VPackDocument* document = UnwrapVPackDocument(args.Holder());
+  if (document != nullptr && !document->materializing) {
+    document->modified = true;
+  }
+}
+
+static void VPackDocumentQuery(
+    v8::Local<v8::Name> name,
+    v8::PropertyCallbackInfo<v8::Integer> const& args) {
+  v8::Isolate* isolate = args.GetIsolate();
+  v8::Local<v8::Object> self = args.Holder();
+
+  if (self->HasRealNamedProperty(isolate->GetCurrentContext(), name)
+          .FromMaybe(false)) {
+    return;
+  }
+
+  VPackDocument* document = UnwrapVPackDocument(self);
+  v8::String::Utf8Value str(name);
+  if (document == nullptr || *str == nullptr) {
+    return;
+  }
+
+  std::string const attribute(*str, str.length());
+  if (document->deleted.find(attribute) == document->deleted.end() &&
+      !document->slice().get(attribute).isNone()) {
+    args.GetReturnValue().Set(static_cast<int32_t>(v8::None));
+  }
+}
+
+static void VPackDocumentDeleter(
+    v8::Local<v8::Name> name,
+    v8::PropertyCallbackInfo<v8::Boolean> const& args) {
+  v8::Isolate* isolate = args.GetIsolate();
+  v8::Local<v8::Object> self = args.Holder();
+  VPackDocument* document = UnwrapVPackDocument(self);
+  v8::String::Utf8Value str(name);
+  if (document == nullptr || *str == nullptr) {
+    return;
+  }
+
+  std::string const attribute(*str, str.length());
+  if (!document->slice().get(attribute).isNone()) {
+    document->deleted.emplace(attribute);
+    document->modified = true;
+  }
+
+  if (!self->HasRealNamedProperty(isolate->GetCurrentContext(), name)
+           .FromMaybe(false)) {
+    args.GetReturnValue().Set(true);
+  }
+  // otherwise V8 deletes the regular property
+}
+
+static void VPackDocumentEnumerator(
+    v8::PropertyCallbackInfo<v8::Array> const& args) {
+  v8::Isolate* isolate = args.GetIsolate();
+  v8::Local<v8::Object> self = args.Holder();
+  VPackDocument* document = UnwrapVPackDocument(self);
+  if (document == nullptr) {
+    return;
+  }
+
+  v8::Handle<v8::Array> result = v8::Array::New(isolate);
+  uint32_t j = 0;
+
+  for (auto const& it : VPackObjectIterator(document->slice(), true)) {
+    std::string attribute = it.key.copyString();
+    if (document->deleted.find(attribute) != document->deleted.end()) {
+      continue;
+    }
+    v8::Handle<v8::String> name = TRI_V8_STD_STRING(attribute);
+    if (self->HasRealNamedProperty(isolate->GetCurrentContext(), name)
+            .FromMaybe(false)) {
+      // V8 enumerates regular properties itself
+      continue;
+    }
+    result->Set(j++, name);
+  }
+
+  args.GetReturnValue().Set(result);
+}
+
+static void WeakVPackDocumentCallback(
+    v8::WeakCallbackInfo<VPackDocument> const& data) {
+  auto isolate = data.GetIsolate();
+  VPackDocument* document = data.GetParameter();
+  TRI_GET_GLOBALS();
+
+  v8g->decreaseActiveExternals();
+  isolate->AdjustAmountOfExternalAllocatedMemory(
+      -static_cast<int64_t>(document->buffer.size()));
+
+  document->handle.Reset();
+  delete document;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief wraps a VPack object into a V8 object which converts attributes
+/// when they are accessed. the object is copied, and custom types are
+/// translated on the way, so the result does not depend on the lifetime
+/// of the slice or of the options
+////////////////////////////////////////////////////////////////////////////////
+
+static v8::Handle<v8::Value> ObjectVPackDocument(v8::Isolate* isolate,
+                                                 VPackSlice const& slice,
+                                                 VPackOptions const* options) {
+  TRI_ASSERT(slice.isObject());
+  TRI_GET_GLOBALS();
+
+  if (v8g->VPackTempl.IsEmpty()) {
+    v8::Handle<v8::ObjectTemplate> rt = v8::ObjectTemplate::New(isolate);
+    rt->SetInternalFieldCount(2);
+    v8::NamedPropertyHandlerConfiguration config(
+        VPackDocumentGetter, VPackDocumentSetter, VPackDocumentQuery,
+        VPackDocumentDeleter, VPackDocumentEnumerator,
+        v8::Local<v8::Value>(), v8::PropertyHandlerFlags::kOnlyInterceptStrings);
+    config.definer = VPackDocumentDefiner;
+    rt->SetHandler(config);
+    v8g->VPackTempl.Reset(isolate, rt);
+  }
+
+  auto document = std::make_unique<VPackDocument>();
+  VPackBuilder builder(document->buffer);
+  builder.openObject();
+  for (auto const& it : VPackObjectIterator(slice, true)) {
+    VPackSlice value = it.value;
+    while (value.isExternal()) {
+      value = VPackSlice(value.getExternal());
+    }
+    if (value.isCustom()) {
+      if (options == nullptr || options->customTypeHandler == nullptr) {
+        THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL,
+                                       "Could not extract custom attribute.");
+      }
+      builder.add(it.key.copyString(),
+                  VPackValue(options->customTypeHandler->toString(
+                      value, options, slice)));
+    } else {
+      builder.add(it.key.copyString(), value);
+    }
+  }
+  builder.close();
+
+  v8::Handle<v8::ObjectTemplate> rt =
+      v8::Local<v8::ObjectTemplate>::New(isolate, v8g->VPackTempl);
+  v8::Handle<v8::Object> result = rt->NewInstance();
+  if (result.IsEmpty()) {
+    return v8::Undefined(isolate);
+  }
+
+  auto external = v8::External::New(isolate, document.get());
+  result->SetInternalField(SLOT_CLASS_TYPE,
+                           v8::Integer::New(isolate, WRP_VPACK_DOCUMENT_TYPE));
+  result->SetInternalField(SLOT_CLASS, external);
+
+  document->handle.Reset(isolate, external);
+  document->handle.SetWeak(document.get(), WeakVPackDocumentCallback,
+                           v8::WeakCallbackType::kFinalizer);
+  v8g->increaseActiveExternals();
+  isolate->AdjustAmountOfExternalAllocatedMemory(
+      static_cast<int64_t>(document->buffer.size()));
+  document.release();
+
+  return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief converts a VPack value into a V8 object, wrapping large objects
+////////////////////////////////////////////////////////////////////////////////
+
+v8::Handle<v8::Value> TRI_VPackToV8Lazy(v8::Isolate* isolate,
+                                        VPackSlice const& slice,
+                                        VPackOptions const* options) {
+  VPackSlice value = slice;
+  while (value.isExternal()) {
+    value = VPackSlice(value.getExternal());
+  }
+
+  if (value.isObject()) {
+    if (value.byteSize() >= LazyDocumentSize) {
+      return ObjectVPackDocument(isolate, value, options);
+    }
+    return TRI_VPackToV8(isolate, value, options);
+  }
+
+  if (!value.isArray()) {
+    return TRI_VPackToV8(isolate, value, options);
+  }
+
+  // an array of documents, e.g. the result of a query
+  v8::Handle<v8::Array> object =
+      v8::Array::New(isolate, static_cast<int>(value.length()));
+
+  if (object.IsEmpty()) {
+    return v8::Undefined(isolate);
+  }
+
+  uint32_t j = 0;
+  for (auto const& it : VPackArrayIterator(value)) {
+    VPackSlice sub = it;
+    while (sub.isExternal()) {
+      sub = VPackSlice(sub.getExternal());
+    }
+
+    v8::Handle<v8::Value> val;
+    if (sub.isObject() && sub.byteSize() >= LazyDocumentSize) {
+      val = ObjectVPackDocument(isolate, sub, options);
+    } else {
+      val = TRI_VPackToV8(isolate, sub, options, &value);
+    }
+    if (!val.IsEmpty()) {
+      object->Set(j++, val);
+    }
+    if (arangodb::V8PlatformFeature::isOutOfMemory(isolate)) {
+      THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+    }
+  }
+
+  return object;
+}
+
 struct BuilderContext {
   BuilderContext(v8::Isolate* isolate, VPackBuilder& builder,
                  bool keepTopLevelOpen)
@@ -400,6 +733,15 @@ static int V8ToVPack(BuilderContext& context,
 
     v8::Handle<v8::Object> o = parameter->ToObject();
 
+    VPackDocument* document = UnwrapVPackDocument(o);
+    if (document != nullptr && !document->modified &&
+        !document->materializedObjects &&
+        (!context.keepTopLevelOpen || context.level > 0)) {
+      // unchanged since it was created from VPack, copy the original
+      AddValue<VPackSlice, inObject>(context, attributeName, document->slice());
+      return TRI_ERROR_NO_ERROR;
+    }
+
     if (performAllChecks) {
       // first check if the object has a "toJSON" function
       if (o->Has(context.toJsonKey)) {
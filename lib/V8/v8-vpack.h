@@ -41,6 +41,18 @@ v8::Handle<v8::Value> TRI_VPackToV8(
         &arangodb::velocypack::Options::Defaults,
     arangodb::velocypack::Slice const* base = nullptr);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief converts a VPack value into a V8 object. large objects, and large
+/// objects contained in an array, are not converted but wrapped into V8
+/// objects which convert attributes on first access. converting such an
+/// object back to VPack copies the original if it was not modified
+////////////////////////////////////////////////////////////////////////////////
+
+v8::Handle<v8::Value> TRI_VPackToV8Lazy(
+    v8::Isolate* isolate, arangodb::velocypack::Slice const&,
+    arangodb::velocypack::Options const* options =
+        &arangodb::velocypack::Options::Defaults);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief convert a V8 value to VPack value
 ////////////////////////////////////////////////////////////////////////////////
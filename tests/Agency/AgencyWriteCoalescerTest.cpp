@@ -0,0 +1,137 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+
+#include "catch.hpp"
+
+#include "Agency/AgencyWriteCoalescer.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Parser.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+
+static std::vector<std::string> const ClientIds{"a", "b", "c"};
+
+// the log index a result reports, or 0
+static uint64_t resultIndex(AgencyCommResult const& result) {
+  VPackSlice results = result.slice().get("results");
+  REQUIRE(results.isArray());
+  REQUIRE(results.length() == 1);
+  return results.at(0).getNumber<uint64_t>();
+}
+
+TEST_CASE("AgencyWriteCoalescerTest", "[agency]") {
+
+SECTION("test_all_transactions_applied") {
+  AgencyCommResult envelope(200, "OK");
+  envelope._connected = true;
+  envelope._sent = true;
+  envelope._body = "{\"results\":[5,6,7]}";
+
+  auto results = AgencyWriteCoalescer::splitResults(envelope, ClientIds);
+
+  REQUIRE(results.size() == 3);
+  for (size_t i = 0; i < results.size(); ++i) {
+    CHECK(results[i].successful());
+    CHECK(results[i]._clientId == ClientIds[i]);
+    CHECK(resultIndex(results[i]) == 5 + i);
+  }
+}
+
+SECTION("test_partial_precondition_failure") {
+  // the agency answers 412 as soon as one precondition failed
+  AgencyCommResult envelope(412, "Precondition Failed");
+  envelope._connected = true;
+  envelope._sent = true;
+  envelope._body = "{\"results\":[5,0,7]}";
+
+  auto results = AgencyWriteCoalescer::splitResults(envelope, ClientIds);
+
+  REQUIRE(results.size() == 3);
+  CHECK(results[0].successful());
+  CHECK(resultIndex(results[0]) == 5);
+  CHECK(!results[1].successful());
+  CHECK(results[1].httpCode() == 412);
+  CHECK(resultIndex(results[1]) == 0);
+  CHECK(results[2].successful());
+  CHECK(resultIndex(results[2]) == 7);
+}
+
+SECTION("test_missing_results_fail_only_their_transactions") {
+  AgencyCommResult envelope(200, "OK");
+  envelope._body = "{\"results\":[5]}";
+
+  auto results = AgencyWriteCoalescer::splitResults(envelope, ClientIds);
+
+  REQUIRE(results.size() == 3);
+  CHECK(results[0].successful());
+  CHECK(resultIndex(results[0]) == 5);
+  CHECK(results[1].httpCode() == 500);
+  CHECK(results[1]._clientId == "b");
+  CHECK(results[2].httpCode() == 500);
+  CHECK(results[2]._clientId == "c");
+}
+
+SECTION("test_failover_mid_batch") {
+  // the connection broke after sending. the inquiry found the first and
+  // the last transaction in the log, but not the second
+  AgencyCommResult failed(503, "Service Unavailable");
+  failed._sent = true;
+
+  auto inquiry = VPackParser::fromJson(
+      "[[{\"index\":11,\"term\":2,\"query\":{}}],"
+      "[],"
+      "[{\"index\":13,\"term\":2,\"query\":{}}]]");
+
+  auto results =
+      AgencyWriteCoalescer::splitInquiry(failed, inquiry->slice(), ClientIds);
+
+  REQUIRE(results.size() == 3);
+  CHECK(results[0].successful());
+  CHECK(results[0]._clientId == "a");
+  CHECK(resultIndex(results[0]) == 11);
+  CHECK(!results[1].successful());
+  CHECK(results[1].httpCode() == 503);
+  CHECK(results[1]._clientId == "b");
+  CHECK(results[2].successful());
+  CHECK(results[2]._clientId == "c");
+  CHECK(resultIndex(results[2]) == 13);
+}
+
+SECTION("test_failover_with_short_inquiry") {
+  AgencyCommResult failed(503, "Service Unavailable");
+
+  auto inquiry =
+      VPackParser::fromJson("[[{\"index\":11,\"term\":2,\"query\":{}}]]");
+
+  auto results =
+      AgencyWriteCoalescer::splitInquiry(failed, inquiry->slice(), ClientIds);
+
+  REQUIRE(results.size() == 3);
+  CHECK(results[0].successful());
+  CHECK(!results[1].successful());
+  CHECK(!results[2].successful());
+}
+
+}
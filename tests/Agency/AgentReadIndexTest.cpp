@@ -0,0 +1,84 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+
+#include "catch.hpp"
+
+#include "Agency/Agent.h"
+
+using namespace arangodb::consensus;
+
+TEST_CASE("AgentReadIndexTest", "[agency]") {
+
+SECTION("test_read_index_needs_commit_in_current_term") {
+  // a new leader's commit index may lag behind entries of earlier terms
+  CHECK(!Agent::mayServeReadIndex(3, 4));
+  CHECK(Agent::mayServeReadIndex(4, 4));
+}
+
+SECTION("test_apply_up_to_leader_commit") {
+  auto range = Agent::nextApplyRange(0, 5, 8);
+  CHECK(range.first == 1);
+  CHECK(range.second == 5);
+}
+
+SECTION("test_apply_only_matching_entries") {
+  // entries behind the last one the leader sent may still be replaced
+  auto range = Agent::nextApplyRange(2, 9, 6);
+  CHECK(range.first == 3);
+  CHECK(range.second == 6);
+}
+
+SECTION("test_nothing_to_apply") {
+  auto range = Agent::nextApplyRange(5, 5, 8);
+  CHECK(range.first > range.second);
+
+  range = Agent::nextApplyRange(5, 3, 8);
+  CHECK(range.first > range.second);
+}
+
+SECTION("test_entries_are_applied_once") {
+  // a sequence of appendEntries and heartbeats, with leader commit index
+  // and last matching index
+  std::vector<std::pair<index_t, index_t>> const messages{
+      {0, 3}, {2, 3}, {2, 5}, {5, 5}, {4, 7}, {7, 7}, {9, 8}};
+
+  std::vector<index_t> applied;
+  index_t lastApplied = 0;
+
+  for (auto const& it : messages) {
+    auto range = Agent::nextApplyRange(lastApplied, it.first, it.second);
+    for (index_t i = range.first; i <= range.second; ++i) {
+      applied.push_back(i);
+    }
+    if (range.first <= range.second) {
+      lastApplied = range.second;
+    }
+  }
+
+  REQUIRE(applied.size() == 8);
+  for (size_t i = 0; i < applied.size(); ++i) {
+    CHECK(applied[i] == i + 1);
+  }
+}
+
+}
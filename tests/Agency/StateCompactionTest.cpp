@@ -0,0 +1,254 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+
+#include "catch.hpp"
+
+#include "Agency/State.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Parser.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb::consensus;
+
+// a read DB dump [tree, timeTable, observerTable, observedTable]
+static std::shared_ptr<VPackBuilder> dump(std::string const& tree,
+                                          std::string const& ttl = "[]") {
+  return VPackParser::fromJson("[" + tree + "," + ttl + ",[],[]]");
+}
+
+// the persisted documents as the compaction collection returns them
+static VPackBuilder documents(std::vector<VPackBuilder> const& stored) {
+  VPackBuilder docs;
+  docs.openArray();
+  for (auto const& it : stored) {
+    docs.add(it.slice());
+  }
+  docs.close();
+  return docs;
+}
+
+TEST_CASE("StateCompactionTest", "[agency]") {
+
+SECTION("test_decompose_compose_round_trip") {
+  auto tree = VPackParser::fromJson(
+      "{\"arango\":{\"Plan\":{\"Version\":3},\"Current\":{\"Version\":2}},"
+      "\"empty\":{},\"value\":17}");
+
+  std::map<std::string, VPackSlice> subtrees;
+  State::decompose(tree->slice(), subtrees);
+  REQUIRE(subtrees.size() == 4);
+  CHECK(subtrees.find("arango/Plan") != subtrees.end());
+  CHECK(subtrees.find("arango/Current") != subtrees.end());
+  CHECK(subtrees["empty"].isObject());
+  CHECK(subtrees["value"].getInt() == 17);
+
+  VPackBuilder composed;
+  State::compose(subtrees, composed);
+  CHECK(composed.slice().get(std::vector<std::string>{"arango", "Plan",
+                                                      "Version"})
+            .getInt() == 3);
+  CHECK(composed.slice().get("empty").isObject());
+  CHECK(composed.slice().get("empty").length() == 0);
+
+  // the composed tree decomposes into the same subtrees
+  std::map<std::string, VPackSlice> again;
+  State::decompose(composed.slice(), again);
+  REQUIRE(again.size() == subtrees.size());
+  for (auto const& it : subtrees) {
+    CHECK(again[it.first].hash() == it.second.hash());
+  }
+}
+
+SECTION("test_first_snapshot_is_full") {
+  auto first = dump("{\"arango\":{\"Plan\":1}}");
+  State::CompactionChain chain, next;
+  VPackBuilder store;
+
+  CHECK(State::buildCompacted("00000000000000000010", first->slice(), chain,
+                              store, next));
+  CHECK(store.slice().hasKey("readDB"));
+  CHECK(next.base == "00000000000000000010");
+  CHECK(next.deltas == 0);
+  CHECK(next.fullBytes == store.slice().byteSize());
+  CHECK(next.hashes.size() == 1);
+}
+
+SECTION("test_delta_holds_changed_and_removed_subtrees") {
+  std::string const big(1000, 'x');
+  auto first = dump("{\"arango\":{\"Plan\":1,\"Current\":\"" + big +
+                    "\",\"Target\":3}}");
+  auto second = dump("{\"arango\":{\"Plan\":2,\"Current\":\"" + big +
+                         "\",\"Supervision\":4}}",
+                     "[5]");
+
+  State::CompactionChain chain, next;
+  VPackBuilder full;
+  REQUIRE(State::buildCompacted("00000000000000000010", first->slice(),
+                                chain, full, next));
+  chain = next;
+
+  VPackBuilder delta;
+  CHECK(!State::buildCompacted("00000000000000000020", second->slice(),
+                               chain, delta, next));
+  CHECK(delta.slice().get("base").copyString() == "00000000000000000010");
+  VPackSlice changed = delta.slice().get("delta").get("subtrees");
+  CHECK(changed.length() == 2);
+  CHECK(changed.get("arango/Plan").getInt() == 2);
+  CHECK(changed.get("arango/Supervision").getInt() == 4);
+  // the unchanged subtree is not written again
+  CHECK(!changed.hasKey("arango/Current"));
+  VPackSlice removed = delta.slice().get("delta").get("removed");
+  REQUIRE(removed.length() == 1);
+  CHECK(removed.at(0).copyString() == "arango/Target");
+  CHECK(next.deltas == 1);
+  CHECK(next.deltaBytes == delta.slice().byteSize());
+}
+
+SECTION("test_merge_rebuilds_the_latest_snapshot") {
+  std::string const big(1000, 'x');
+  std::vector<std::shared_ptr<VPackBuilder>> dumps{
+      dump("{\"arango\":{\"Plan\":1,\"Current\":\"" + big + "\"}}"),
+      dump("{\"arango\":{\"Plan\":2,\"Current\":\"" + big + "\",\"Target\":3}}"),
+      dump("{\"arango\":{\"Plan\":2,\"Current\":\"" + big + "\"},\"x\":5}",
+           "[7]")};
+
+  State::CompactionChain chain, next;
+  std::vector<VPackBuilder> stored;
+  for (size_t i = 0; i < dumps.size(); ++i) {
+    VPackBuilder store;
+    bool full = State::buildCompacted("0000000000000000000" +
+                                          std::to_string(i + 1),
+                                      dumps[i]->slice(), chain, store, next);
+    CHECK(full == (i == 0));
+    stored.emplace_back(std::move(store));
+    chain = next;
+  }
+
+  VPackBuilder docs = documents(stored);
+  VPackBuilder merged;
+  State::CompactionChain loaded;
+  REQUIRE(State::mergeCompacted(docs.slice(), merged, loaded));
+
+  CHECK(merged.slice().get("_key").copyString() == "00000000000000000003");
+  VPackSlice readDB = merged.slice().get("readDB");
+  REQUIRE(readDB.length() == 4);
+  CHECK(readDB.at(0).get("x").getInt() == 5);
+  CHECK(readDB.at(0).get("arango").get("Plan").getInt() == 2);
+  CHECK(!readDB.at(0).get("arango").hasKey("Target"));
+  CHECK(readDB.at(1).at(0).getInt() == 7);
+
+  // the merged tree has the subtrees of the last dump
+  std::map<std::string, VPackSlice> expected, actual;
+  State::decompose(dumps[2]->slice().at(0), expected);
+  State::decompose(readDB.at(0), actual);
+  REQUIRE(actual.size() == expected.size());
+  for (auto const& it : expected) {
+    CHECK(actual[it.first].hash() == it.second.hash());
+  }
+
+  // the loaded chain continues where the compactor left off
+  CHECK(loaded.base == chain.base);
+  CHECK(loaded.deltas == chain.deltas);
+  CHECK(loaded.deltaBytes == chain.deltaBytes);
+  CHECK(loaded.hashes == chain.hashes);
+}
+
+SECTION("test_merge_needs_a_full_snapshot") {
+  auto first = dump("{\"arango\":{\"Plan\":\"" + std::string(1000, 'x') +
+                    "\"}}");
+  State::CompactionChain chain, next;
+  VPackBuilder full;
+  State::buildCompacted("00000000000000000001", first->slice(), chain, full,
+                        next);
+  VPackBuilder delta;
+  State::buildCompacted("00000000000000000002", first->slice(), next, delta,
+                        chain);
+  REQUIRE(!delta.slice().hasKey("readDB"));
+
+  std::vector<VPackBuilder> stored;
+  stored.emplace_back(std::move(delta));
+  VPackBuilder docs = documents(stored);
+  VPackBuilder merged;
+  CHECK(!State::mergeCompacted(docs.slice(), merged, chain));
+}
+
+SECTION("test_delta_of_another_base_is_ignored") {
+  auto first = dump("{\"arango\":{\"Plan\":1,\"Current\":\"" +
+                    std::string(1000, 'x') + "\"}}");
+  auto second = dump("{\"arango\":{\"Plan\":2}}");
+  State::CompactionChain chain, next;
+  VPackBuilder full;
+  State::buildCompacted("00000000000000000001", first->slice(), chain, full,
+                        next);
+  chain = next;
+  chain.base = "00000000000000000000";
+  VPackBuilder delta;
+  REQUIRE(!State::buildCompacted("00000000000000000002", second->slice(),
+                                 chain, delta, next));
+
+  std::vector<VPackBuilder> stored;
+  stored.emplace_back(std::move(full));
+  stored.emplace_back(std::move(delta));
+  VPackBuilder docs = documents(stored);
+  VPackBuilder merged;
+  State::CompactionChain loaded;
+  REQUIRE(State::mergeCompacted(docs.slice(), merged, loaded));
+  CHECK(merged.slice().get("_key").copyString() == "00000000000000000001");
+  CHECK(merged.slice().get("readDB").at(0).get("arango").get("Plan")
+            .getInt() == 1);
+  CHECK(loaded.deltas == 0);
+}
+
+SECTION("test_full_snapshot_after_interval") {
+  std::string const big(1000, 'x');
+  State::CompactionChain chain, next;
+  size_t fulls = 0;
+  for (size_t i = 0; i < 21; ++i) {
+    auto current = dump("{\"arango\":{\"Plan\":" + std::to_string(i) +
+                        ",\"Current\":\"" + big + "\"}}");
+    VPackBuilder store;
+    if (State::buildCompacted(std::to_string(100 + i), current->slice(),
+                              chain, store, next)) {
+      ++fulls;
+    }
+    chain = next;
+  }
+  // one full snapshot every 10 compactions
+  CHECK(fulls == 3);
+}
+
+SECTION("test_full_snapshot_when_deltas_outgrow_it") {
+  State::CompactionChain chain, next;
+  VPackBuilder store;
+  State::buildCompacted("1", dump("{\"a\":{\"b\":1}}")->slice(), chain, store,
+                        next);
+  chain = next;
+  // the change alone is larger than the last full snapshot
+  CHECK(State::buildCompacted(
+      "2", dump("{\"a\":{\"b\":\"" + std::string(1000, 'x') + "\"}}")->slice(),
+      chain, store, next));
+  CHECK(next.base == "2");
+}
+
+}
@@ -0,0 +1,213 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+
+#include "catch.hpp"
+
+#include "Aql/AqlItemBlock.h"
+#include "Aql/Range.h"
+#include "Aql/ResourceUsage.h"
+#include "Basics/Exceptions.h"
+#include "Basics/VelocyPackHelper.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb::aql;
+
+namespace {
+/// @brief a printable form of a value, to compare the blocks
+std::string describe(AqlValue const& a) {
+  if (a.isEmpty()) {
+    return "empty";
+  }
+  if (a.isRange()) {
+    return std::to_string(a.range()->_low) + ".." +
+           std::to_string(a.range()->_high);
+  }
+  return a.slice().toJson();
+}
+
+/// @brief serialize a block, the way the DB servers send it
+VPackBuilder serialize(AqlItemBlock const& block) {
+  VPackBuilder builder;
+  builder.openObject();
+  block.toVelocyPack(nullptr, builder);
+  builder.close();
+  return builder;
+}
+
+void checkEqual(AqlItemBlock const& expected, AqlItemBlock const& actual) {
+  REQUIRE(actual.size() == expected.size());
+  REQUIRE(actual.getNrRegs() == expected.getNrRegs());
+  for (size_t i = 0; i < expected.size(); ++i) {
+    for (RegisterId j = 0; j < expected.getNrRegs(); ++j) {
+      CHECK(describe(actual.getValueReference(i, j)) ==
+            describe(expected.getValueReference(i, j)));
+    }
+  }
+}
+}
+
+TEST_CASE("AqlItemBlockTest", "[aql]") {
+  ResourceMonitor monitor;
+
+SECTION("test_columns_round_trip") {
+  std::string const longString(100, 'x');
+
+  AqlItemBlock block(&monitor, 4, 5);
+  // register 0: the same value in all rows
+  AqlValue constant(longString);
+  for (size_t i = 0; i < 4; ++i) {
+    block.setValue(i, 0, constant);
+  }
+  // register 1: scalars only
+  block.setValue(0, 1, AqlValue(int64_t(1)));
+  block.setValue(1, 1, AqlValue(2.5));
+  block.setValue(2, 1, AqlValue(true));
+  block.setValue(3, 1, AqlValue(arangodb::basics::VelocyPackHelper::NullValue()));
+  // register 2: strings with duplicates and a gap
+  AqlValue shared(longString + "y");
+  block.setValue(0, 2, shared);
+  block.setValue(1, 2, AqlValue(std::string("a")));
+  block.setValue(3, 2, shared);
+  // register 3: ranges
+  AqlValue range(int64_t(1), int64_t(10));
+  block.setValue(0, 3, range);
+  block.setValue(1, 3, range);
+  block.setValue(2, 3, AqlValue(int64_t(-3), int64_t(3)));
+  block.setValue(3, 3, AqlValue(std::string("b")));
+  // register 4 stays empty
+
+  VPackBuilder builder = serialize(block);
+  VPackSlice slice = builder.slice();
+
+  VPackSlice columns = slice.get("columns");
+  REQUIRE(columns.length() == 5);
+  CHECK(columns.at(0).isNumber());
+  CHECK(columns.at(1).isObject());
+  CHECK(columns.at(1).get("scalars").length() == 4);
+  CHECK(columns.at(2).isArray());
+  CHECK(columns.at(3).isArray());
+  CHECK(columns.at(4).getNumericValue<int64_t>() == 0);
+  // every distinct value is written once
+  CHECK(slice.get("values").length() == 4);
+  CHECK(slice.get("ranges").length() == 2);
+
+  AqlItemBlock copy(&monitor, slice);
+  checkEqual(block, copy);
+
+  // the rows of a value share one copy of it
+  CHECK(copy.getValueReference(0, 2).slice().begin() ==
+        copy.getValueReference(3, 2).slice().begin());
+  CHECK(copy.getValueReference(0, 3).range() ==
+        copy.getValueReference(1, 3).range());
+}
+
+SECTION("test_scalar_columns_have_no_values") {
+  AqlItemBlock block(&monitor, 3, 2);
+  for (size_t i = 0; i < 3; ++i) {
+    block.setValue(i, 0, AqlValue(int64_t(i)));
+    block.setValue(i, 1, AqlValue(i % 2 == 0));
+  }
+
+  VPackBuilder builder = serialize(block);
+  VPackSlice slice = builder.slice();
+  CHECK(slice.get("values").length() == 0);
+  CHECK(slice.get("ranges").isNone());
+
+  AqlItemBlock copy(&monitor, slice);
+  checkEqual(block, copy);
+}
+
+SECTION("test_undefined_references_are_rejected") {
+  VPackBuilder builder;
+  builder.openObject();
+  builder.add("nrItems", VPackValue(1));
+  builder.add("nrRegs", VPackValue(1));
+  builder.add("columns", VPackValue(VPackValueType::Array));
+  builder.add(VPackValue(3));
+  builder.close();
+  builder.add("values", VPackValue(VPackValueType::Array));
+  builder.add(VPackValue("a"));
+  builder.close();
+  builder.close();
+
+  CHECK_THROWS_AS(AqlItemBlock(&monitor, builder.slice()),
+                  arangodb::basics::Exception);
+}
+
+SECTION("test_move_takes_over_unshared_values") {
+  std::string const longString(100, 'x');
+
+  AqlItemBlock block(&monitor, 3, 2);
+  for (size_t i = 0; i < 3; ++i) {
+    block.setValue(i, 0, AqlValue(longString + std::to_string(i)));
+    block.setValue(i, 1, AqlValue(int64_t(i)));
+  }
+  uint8_t const* second = block.getValueReference(2, 0).slice().begin();
+
+  std::vector<size_t> const chosen{2, 0};
+  std::unique_ptr<AqlItemBlock> result(block.move(chosen, 0, 2));
+  REQUIRE(result->size() == 2);
+
+  // the value was not copied
+  CHECK(result->getValueReference(0, 0).slice().begin() == second);
+  CHECK(result->getValueReference(0, 0).slice().copyString() ==
+        longString + "2");
+  CHECK(result->getValueReference(1, 0).slice().copyString() ==
+        longString + "0");
+  CHECK(result->getValueReference(0, 1).toInt64(nullptr) == 2);
+  CHECK(result->getValueReference(1, 1).toInt64(nullptr) == 0);
+
+  // the chosen rows are empty now, the others are untouched
+  CHECK(block.getValueReference(0, 0).isEmpty());
+  CHECK(block.getValueReference(2, 1).isEmpty());
+  CHECK(block.getValueReference(1, 0).slice().copyString() ==
+        longString + "1");
+}
+
+SECTION("test_move_clones_shared_values_once") {
+  std::string const longString(100, 'x');
+
+  AqlItemBlock block(&monitor, 3, 1);
+  AqlValue shared(longString);
+  for (size_t i = 0; i < 3; ++i) {
+    block.setValue(i, 0, shared);
+  }
+
+  std::vector<size_t> const chosen{0, 1};
+  std::unique_ptr<AqlItemBlock> result(block.move(chosen, 0, 2));
+
+  // the rows of the new block share one copy
+  uint8_t const* copy = result->getValueReference(0, 0).slice().begin();
+  CHECK(copy == result->getValueReference(1, 0).slice().begin());
+  CHECK(copy != block.getValueReference(2, 0).slice().begin());
+  CHECK(result->getValueReference(1, 0).slice().copyString() == longString);
+
+  // the row that was not chosen still has the original
+  CHECK(block.getValueReference(0, 0).isEmpty());
+  CHECK(block.getValueReference(1, 0).isEmpty());
+  CHECK(block.getValueReference(2, 0).slice().copyString() == longString);
+}
+
+}
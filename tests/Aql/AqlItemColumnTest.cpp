@@ -0,0 +1,125 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+
+#include "catch.hpp"
+
+#include "Aql/AqlItemColumn.h"
+#include "Aql/Arithmetic.h"
+
+using namespace arangodb::aql;
+
+TEST_CASE("AqlItemColumnTest", "[aql]") {
+
+SECTION("test_integers") {
+  AqlItemColumn column;
+  column.reset(3);
+  CHECK(column.set(0, AqlValue(int64_t(1))));
+  CHECK(column.set(2, AqlValue(int64_t(-3))));
+
+  CHECK(column.type() == AqlItemColumn::INT64);
+  CHECK(column.isNumeric());
+  CHECK(column.hasNulls());
+  CHECK(column.isNull(1));
+  CHECK(column.int64Values()[0] == 1);
+  CHECK(column.int64Values()[1] == 0);
+  CHECK(column.int64Values()[2] == -3);
+
+  // the doubles are created on demand
+  CHECK(column.doubleValues()[2] == -3.0);
+  CHECK(column.type() == AqlItemColumn::INT64);
+
+  CHECK(column.value(0).toInt64(nullptr) == 1);
+  CHECK(column.value(1).isNull(false));
+}
+
+SECTION("test_integers_promoted_to_doubles") {
+  AqlItemColumn column;
+  column.reset(2);
+  CHECK(column.set(0, AqlValue(int64_t(2))));
+  CHECK(column.set(1, AqlValue(2.5)));
+
+  CHECK(column.type() == AqlItemColumn::DOUBLE);
+  CHECK(!column.hasNulls());
+  CHECK(column.doubleValues()[0] == 2.0);
+  CHECK(column.doubleValues()[1] == 2.5);
+}
+
+SECTION("test_booleans") {
+  AqlItemColumn column;
+  column.reset(3);
+  CHECK(column.set(0, AqlValue(true)));
+  CHECK(column.set(1, AqlValue(false)));
+
+  CHECK(column.type() == AqlItemColumn::BOOL);
+  CHECK(!column.isNumeric());
+  CHECK(column.boolValues()[0] == 1);
+  CHECK(column.boolValues()[1] == 0);
+  // a null position is not selected
+  CHECK(column.boolValues()[2] == 0);
+}
+
+SECTION("test_mixed_values") {
+  AqlItemColumn column;
+  column.reset(2);
+  CHECK(column.set(0, AqlValue(int64_t(1))));
+  CHECK(!column.set(1, AqlValue(true)));
+  CHECK(column.type() == AqlItemColumn::MIXED);
+
+  column.reset(1);
+  CHECK(column.type() == AqlItemColumn::EMPTY);
+  CHECK(!column.set(0, AqlValue(std::string("abc"))));
+  CHECK(column.type() == AqlItemColumn::MIXED);
+}
+
+SECTION("test_only_nulls") {
+  AqlItemColumn column;
+  column.reset(2);
+  CHECK(column.set(0, AqlValue()));
+  CHECK(column.type() == AqlItemColumn::EMPTY);
+  CHECK(column.hasNulls());
+}
+
+SECTION("test_compare_kernels") {
+  int64_t const l[] = {1, 5, 3, 7};
+  int64_t const r[] = {2, 5, 1, 9};
+  uint8_t out[4];
+
+  ColumnCompare(l, r, out, 4, std::less<int64_t>());
+  CHECK(out[0] == 1);
+  CHECK(out[1] == 0);
+  CHECK(out[2] == 0);
+  CHECK(out[3] == 1);
+
+  ColumnCompare(l, r, out, 4, std::equal_to<int64_t>());
+  CHECK(out[0] == 0);
+  CHECK(out[1] == 1);
+
+  double const d[] = {0.5, 1.5, 2.5, 3.5};
+  ColumnCompareScalar(d, 1.5, out, 4, std::greater_equal<double>());
+  CHECK(out[0] == 0);
+  CHECK(out[1] == 1);
+  CHECK(out[2] == 1);
+  CHECK(out[3] == 1);
+}
+
+}
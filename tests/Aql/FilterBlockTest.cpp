@@ -0,0 +1,55 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+
+#include "catch.hpp"
+
+#include "Aql/AstNode.h"
+#include "Aql/BasicBlocks.h"
+
+using namespace arangodb::aql;
+
+TEST_CASE("FilterBlockTest", "[aql]") {
+
+SECTION("test_comparisons_use_the_column") {
+  for (auto type : {NODE_TYPE_OPERATOR_BINARY_EQ, NODE_TYPE_OPERATOR_BINARY_NE,
+                    NODE_TYPE_OPERATOR_BINARY_LT, NODE_TYPE_OPERATOR_BINARY_LE,
+                    NODE_TYPE_OPERATOR_BINARY_GT,
+                    NODE_TYPE_OPERATOR_BINARY_GE}) {
+    AstNode node(type);
+    CHECK(FilterBlock::isComparison(&node));
+  }
+}
+
+SECTION("test_other_expressions_do_not_use_the_column") {
+  // these may produce any value, e.g. AND returns one of its operands
+  for (auto type : {NODE_TYPE_OPERATOR_BINARY_AND, NODE_TYPE_OPERATOR_BINARY_OR,
+                    NODE_TYPE_OPERATOR_BINARY_PLUS, NODE_TYPE_ATTRIBUTE_ACCESS,
+                    NODE_TYPE_REFERENCE, NODE_TYPE_FCALL}) {
+    AstNode node(type);
+    CHECK(!FilterBlock::isComparison(&node));
+  }
+
+  CHECK(!FilterBlock::isComparison(nullptr));
+}
+
+}
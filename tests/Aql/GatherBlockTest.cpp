@@ -0,0 +1,158 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+
+#include "catch.hpp"
+
+#include "Aql/AqlItemBlock.h"
+#include "Aql/ClusterBlocks.h"
+#include "Aql/ResourceUsage.h"
+
+using namespace arangodb::aql;
+
+namespace {
+
+/// @brief the buffered blocks of some dependencies, each holding sorted
+/// integers in register 0
+class Buffers {
+ public:
+  explicit Buffers(std::vector<std::vector<std::vector<int64_t>>> const& deps)
+      : _buffer(deps.size()) {
+    for (size_t i = 0; i < deps.size(); ++i) {
+      _pos.emplace_back(i, 0);
+      for (auto const& values : deps[i]) {
+        auto block = new AqlItemBlock(&_monitor, values.size(), 1);
+        for (size_t j = 0; j < values.size(); ++j) {
+          block->setValue(j, 0, AqlValue(values[j]));
+        }
+        _buffer[i].emplace_back(block);
+      }
+    }
+  }
+
+  ~Buffers() {
+    for (auto& it : _buffer) {
+      for (auto& block : it) {
+        delete block;
+      }
+    }
+  }
+
+  /// @brief merge all rows, the way GatherBlock::getSome does
+  std::vector<int64_t> merge(bool ascending) {
+    // like GatherBlock::HeapLess: a sorts after b, so the smallest row is on
+    // top of the heap
+    auto heapLess = [this, ascending](size_t a, size_t b) {
+      int64_t const left = current(a);
+      int64_t const right = current(b);
+      return ascending ? right < left : left < right;
+    };
+
+    std::vector<size_t> heap;
+    GatherBlock::buildHeap(heap, _buffer, heapLess);
+
+    std::vector<int64_t> result;
+    while (!heap.empty()) {
+      std::pop_heap(heap.begin(), heap.end(), heapLess);
+      std::pair<size_t, size_t> const val = _pos[heap.back()];
+      AqlItemBlock* src = _buffer[val.first].front();
+      result.emplace_back(
+          src->getValueReference(val.second, 0).toInt64(nullptr));
+
+      _pos[val.first].second++;
+      if (_pos[val.first].second == src->size()) {
+        delete src;
+        _buffer[val.first].pop_front();
+        _pos[val.first].second = 0;
+      }
+
+      if (_buffer[val.first].empty()) {
+        heap.pop_back();
+      } else {
+        std::push_heap(heap.begin(), heap.end(), heapLess);
+      }
+    }
+    return result;
+  }
+
+ private:
+  int64_t current(size_t dep) const {
+    return _buffer[dep].front()
+        ->getValueReference(_pos[dep].second, 0)
+        .toInt64(nullptr);
+  }
+
+  ResourceMonitor _monitor;
+  std::vector<std::deque<AqlItemBlock*>> _buffer;
+  std::vector<std::pair<size_t, size_t>> _pos;
+};
+
+}  // namespace
+
+TEST_CASE("GatherBlockTest", "[aql]") {
+
+SECTION("test_merge_is_sorted") {
+  Buffers buffers({{{1, 4, 7}, {10}}, {{2, 5}}, {}, {{3, 6, 8, 9}}});
+  CHECK(buffers.merge(true) ==
+        (std::vector<int64_t>{1, 2, 3, 4, 5, 6, 7, 8, 9, 10}));
+}
+
+SECTION("test_merge_is_sorted_descending") {
+  Buffers buffers({{{9, 3}}, {{8, 7, 6}, {2}}, {{5, 4, 1}}});
+  CHECK(buffers.merge(false) ==
+        (std::vector<int64_t>{9, 8, 7, 6, 5, 4, 3, 2, 1}));
+}
+
+SECTION("test_merge_keeps_duplicates") {
+  Buffers buffers({{{1, 1, 2}}, {{1, 2, 2}}});
+  CHECK(buffers.merge(true) == (std::vector<int64_t>{1, 1, 1, 2, 2, 2}));
+}
+
+SECTION("test_empty_dependencies_are_not_in_the_heap") {
+  Buffers buffers({{}, {{5}}, {}});
+  CHECK(buffers.merge(true) == (std::vector<int64_t>{5}));
+
+  Buffers empty({{}, {}});
+  CHECK(empty.merge(true).empty());
+}
+
+SECTION("test_many_dependencies") {
+  std::vector<std::vector<std::vector<int64_t>>> deps(17);
+  for (int64_t i = 0; i < 17 * 20; ++i) {
+    // every dependency gets every 17th value, in blocks of 3 rows
+    auto& blocks = deps[i % 17];
+    if (blocks.empty() || blocks.back().size() == 3) {
+      blocks.emplace_back();
+    }
+    blocks.back().emplace_back(i);
+  }
+
+  std::vector<int64_t> expected;
+  for (int64_t i = 0; i < 17 * 20; ++i) {
+    expected.emplace_back(i);
+  }
+
+  Buffers buffers(deps);
+  CHECK(buffers.merge(true) == expected);
+}
+
+}
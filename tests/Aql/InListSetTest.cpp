@@ -0,0 +1,101 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+
+#include "catch.hpp"
+
+#include "Aql/InListSet.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Iterator.h>
+#include <velocypack/Parser.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb::aql;
+
+namespace {
+bool contains(InListSet const& set, std::string const& json) {
+  auto value = VPackParser::fromJson(json);
+  REQUIRE(InListSet::canFind(value->slice()));
+  return set.contains(value->slice());
+}
+}
+
+TEST_CASE("InListSetTest", "[aql]") {
+
+SECTION("test_scalars_are_found") {
+  auto values = VPackParser::fromJson(
+      "[null, true, 1, 2.5, \"abc\", \"a somewhat longer string value\"]");
+  InListSet set(values->slice());
+
+  CHECK(contains(set, "null"));
+  CHECK(contains(set, "true"));
+  CHECK(contains(set, "1"));
+  CHECK(contains(set, "2.5"));
+  CHECK(contains(set, "\"abc\""));
+  CHECK(contains(set, "\"a somewhat longer string value\""));
+
+  CHECK(!contains(set, "false"));
+  CHECK(!contains(set, "2"));
+  CHECK(!contains(set, "\"ABC\""));
+  CHECK(!contains(set, "\"1\""));
+}
+
+SECTION("test_numbers_are_compared_by_value") {
+  auto values = VPackParser::fromJson("[1.0, -3, 100000000000]");
+  InListSet set(values->slice());
+
+  // the same numbers in other VelocyPack number types
+  VPackBuilder builder;
+  builder.openArray();
+  builder.add(VPackValue(int64_t(1)));
+  builder.add(VPackValue(uint64_t(1)));
+  builder.add(VPackValue(-3.0));
+  builder.add(VPackValue(double(100000000000)));
+  builder.close();
+
+  for (auto const& it : VPackArrayIterator(builder.slice())) {
+    CHECK(set.contains(it));
+  }
+}
+
+SECTION("test_the_set_owns_its_values") {
+  std::unique_ptr<InListSet> set;
+  {
+    auto values = VPackParser::fromJson("[\"a long string that is copied\"]");
+    set.reset(new InListSet(values->slice()));
+  }
+  CHECK(contains(*set, "\"a long string that is copied\""));
+}
+
+SECTION("test_compound_values_are_left_to_the_caller") {
+  auto array = VPackParser::fromJson("[1]");
+  auto object = VPackParser::fromJson("{\"a\":1}");
+  CHECK(!InListSet::canFind(array->slice()));
+  CHECK(!InListSet::canFind(object->slice()));
+
+  auto values = VPackParser::fromJson("[]");
+  InListSet set(values->slice());
+  CHECK(!contains(set, "1"));
+}
+
+}
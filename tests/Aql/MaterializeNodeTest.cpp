@@ -0,0 +1,122 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+
+#include "catch.hpp"
+
+#include "Aql/ExecutionNode.h"
+#include "Aql/MaterializeNode.h"
+#include "Aql/SortNode.h"
+#include "Aql/Variable.h"
+
+using namespace arangodb::aql;
+
+// the nodes of a plan without a query, each one the parent of the last
+class Chain {
+ public:
+  Chain() { _nodes.emplace_back(new SingletonNode(nullptr, 1)); }
+
+  ExecutionNode* start() const { return _nodes.front().get(); }
+
+  ExecutionNode* add(ExecutionNode* node) {
+    _nodes.back()->addParent(node);
+    _nodes.emplace_back(node);
+    return node;
+  }
+
+  size_t nextId() const { return _nodes.size() + 1; }
+
+ private:
+  std::vector<std::unique_ptr<ExecutionNode>> _nodes;
+};
+
+TEST_CASE("MaterializeNodeTest", "[aql]") {
+  Variable document("doc", 1);
+  Variable other("other", 2);
+  Variable list("list", 3);
+  Chain chain;
+
+SECTION("test_materialize_before_the_first_use_after_a_limit") {
+  chain.add(new LimitNode(nullptr, chain.nextId(), 10));
+  chain.add(new SortNode(nullptr, chain.nextId(),
+                         SortElementVector{SortElement(&other, true)}, false));
+  chain.add(new FilterNode(nullptr, chain.nextId(), &other));
+  auto use = chain.add(new ReturnNode(nullptr, chain.nextId(), &document));
+
+  CHECK(MaterializeNode::findMaterializationPoint(chain.start(), &document) ==
+        use);
+}
+
+SECTION("test_a_filter_may_use_the_documents") {
+  chain.add(new LimitNode(nullptr, chain.nextId(), 10));
+  auto use = chain.add(new FilterNode(nullptr, chain.nextId(), &document));
+  chain.add(new ReturnNode(nullptr, chain.nextId(), &document));
+
+  CHECK(MaterializeNode::findMaterializationPoint(chain.start(), &document) ==
+        use);
+}
+
+SECTION("test_no_limit_before_the_first_use") {
+  chain.add(new FilterNode(nullptr, chain.nextId(), &other));
+  chain.add(new ReturnNode(nullptr, chain.nextId(), &document));
+
+  CHECK(MaterializeNode::findMaterializationPoint(chain.start(), &document) ==
+        nullptr);
+}
+
+SECTION("test_a_limit_after_the_first_use") {
+  chain.add(new FilterNode(nullptr, chain.nextId(), &document));
+  chain.add(new LimitNode(nullptr, chain.nextId(), 10));
+  chain.add(new ReturnNode(nullptr, chain.nextId(), &document));
+
+  CHECK(MaterializeNode::findMaterializationPoint(chain.start(), &document) ==
+        nullptr);
+}
+
+SECTION("test_materialize_before_rows_are_multiplied") {
+  chain.add(new LimitNode(nullptr, chain.nextId(), 10));
+  auto enumerate =
+      chain.add(new EnumerateListNode(nullptr, chain.nextId(), &list, &other));
+  chain.add(new ReturnNode(nullptr, chain.nextId(), &document));
+
+  CHECK(MaterializeNode::findMaterializationPoint(chain.start(), &document) ==
+        enumerate);
+}
+
+SECTION("test_no_limit_before_rows_are_multiplied") {
+  chain.add(new EnumerateListNode(nullptr, chain.nextId(), &list, &other));
+  chain.add(new LimitNode(nullptr, chain.nextId(), 10));
+  chain.add(new ReturnNode(nullptr, chain.nextId(), &document));
+
+  CHECK(MaterializeNode::findMaterializationPoint(chain.start(), &document) ==
+        nullptr);
+}
+
+SECTION("test_documents_that_are_never_used") {
+  chain.add(new LimitNode(nullptr, chain.nextId(), 10));
+  chain.add(new FilterNode(nullptr, chain.nextId(), &other));
+
+  CHECK(MaterializeNode::findMaterializationPoint(chain.start(), &document) ==
+        nullptr);
+}
+
+}
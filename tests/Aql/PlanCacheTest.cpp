@@ -0,0 +1,139 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+
+#include "catch.hpp"
+
+#include "Aql/PlanCache.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Parser.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb::aql;
+
+// the calculation of FILTER @x > 10, as serialized by the optimizer
+static std::shared_ptr<VPackBuilder> comparisonPlan(double x) {
+  return VPackParser::fromJson(
+      "{\"nodes\":[{\"type\":\"CalculationNode\",\"expression\":"
+      "{\"type\":\"compare >\",\"subNodes\":["
+      "{\"type\":\"value\",\"value\":" + std::to_string(x) +
+      ",\"vType\":\"double\",\"vTypeID\":3,\"bindParameter\":true},"
+      "{\"type\":\"value\",\"value\":10,\"vType\":\"int\",\"vTypeID\":2}"
+      "]}},{\"type\":\"FilterNode\"}]}");
+}
+
+// the same query after the comparison was folded into a constant and the
+// filter was removed. this happens for all values of @x above 10
+static std::shared_ptr<VPackBuilder> foldedPlan() {
+  return VPackParser::fromJson(
+      "{\"nodes\":[{\"type\":\"CalculationNode\",\"expression\":"
+      "{\"type\":\"value\",\"value\":true,\"vType\":\"bool\",\"vTypeID\":1}"
+      "}]}");
+}
+
+static std::string signature(VPackSlice bindParameters, bool byValue) {
+  VPackBuilder builder;
+  PlanCache::buildSignature(builder, bindParameters, byValue);
+  return builder.slice().toJson();
+}
+
+TEST_CASE("PlanCacheTest", "[aql]") {
+  std::unordered_map<std::string, size_t> uses{{"x", 1}};
+
+SECTION("test_values_are_substituted") {
+  auto bind20 = VPackParser::fromJson("{\"x\":20}");
+  auto bind5 = VPackParser::fromJson("{\"x\":5}");
+
+  auto plan = comparisonPlan(20);
+  VPackBuilder parameterized;
+  PlanCache::parameterize(plan->slice(), bind20->slice(), parameterized);
+  CHECK(PlanCache::coversParameters(parameterized.slice(), bind20->slice(),
+                                    uses));
+
+  // the probe with another value yields the same parameterized plan
+  auto probeValues = VPackParser::fromJson("{\"x\":7939}");
+  auto probePlan = comparisonPlan(7939);
+  VPackBuilder probe;
+  PlanCache::parameterize(probePlan->slice(), probeValues->slice(), probe);
+  CHECK(PlanCache::equivalent(parameterized.slice(), probe.slice()));
+
+  // executing with a value on the other side of the comparison fills it in
+  VPackBuilder bound;
+  PlanCache::bind(parameterized.slice(), bind5->slice(), bound);
+  VPackSlice value =
+      bound.slice().get("nodes").at(0).get("expression").get("subNodes").at(0);
+  CHECK(5.0 == value.get("value").getNumber<double>());
+  CHECK(value.get("bindParameter").isNone());
+}
+
+SECTION("test_folded_values_are_not_substituted") {
+  auto bind20 = VPackParser::fromJson("{\"x\":20}");
+  auto bind5 = VPackParser::fromJson("{\"x\":5}");
+
+  // @x = 20 folds the filter away, and so does the probe with 7939
+  auto plan = foldedPlan();
+  VPackBuilder parameterized;
+  PlanCache::parameterize(plan->slice(), bind20->slice(), parameterized);
+
+  auto probeValues = VPackParser::fromJson("{\"x\":7939}");
+  VPackBuilder probe;
+  PlanCache::parameterize(plan->slice(), probeValues->slice(), probe);
+  CHECK(PlanCache::equivalent(parameterized.slice(), probe.slice()));
+
+  // but the plan must not be reused for @x = 5, which would not pass the
+  // filter
+  CHECK(!PlanCache::coversParameters(parameterized.slice(), bind20->slice(),
+                                     uses));
+
+  // so the plan is cached by value, with different keys on both sides of
+  // the comparison
+  CHECK(signature(bind20->slice(), false) == signature(bind5->slice(), false));
+  CHECK(signature(bind20->slice(), true) != signature(bind5->slice(), true));
+}
+
+SECTION("test_partially_folded_values_are_not_substituted") {
+  // @x is used twice, e.g. FILTER @x > 10 RETURN @x, and only the filter
+  // was folded
+  std::unordered_map<std::string, size_t> twice{{"x", 2}};
+  auto bind20 = VPackParser::fromJson("{\"x\":20}");
+
+  auto plan = comparisonPlan(20);
+  VPackBuilder parameterized;
+  PlanCache::parameterize(plan->slice(), bind20->slice(), parameterized);
+  CHECK(!PlanCache::coversParameters(parameterized.slice(), bind20->slice(),
+                                     twice));
+}
+
+SECTION("test_collection_parameters_are_ignored") {
+  std::unordered_map<std::string, size_t> collection{{"@coll", 1}, {"x", 1}};
+  auto bindParameters =
+      VPackParser::fromJson("{\"@coll\":\"test\",\"x\":20}");
+
+  auto plan = comparisonPlan(20);
+  VPackBuilder parameterized;
+  PlanCache::parameterize(plan->slice(), bindParameters->slice(),
+                          parameterized);
+  CHECK(PlanCache::coversParameters(parameterized.slice(),
+                                    bindParameters->slice(), collection));
+}
+}
@@ -0,0 +1,118 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+
+#include "catch.hpp"
+
+#include "Aql/QueryRegistry.h"
+#include "Basics/ConditionLocker.h"
+#include "Basics/ConditionVariable.h"
+
+#include <thread>
+
+using namespace arangodb;
+using namespace arangodb::aql;
+
+TEST_CASE("QueryRegistryTest", "[aql]") {
+
+SECTION("test_no_wait_if_not_busy") {
+  basics::ConditionVariable condition;
+  CONDITION_LOCKER(guard, condition);
+
+  size_t calls = 0;
+  CHECK(QueryRegistry::waitWhile(guard, 0.0, [&calls]() {
+    ++calls;
+    return false;
+  }));
+  CHECK(calls == 1);
+}
+
+SECTION("test_busy_without_wait") {
+  basics::ConditionVariable condition;
+  CONDITION_LOCKER(guard, condition);
+
+  CHECK(!QueryRegistry::waitWhile(guard, 0.0, []() { return true; }));
+}
+
+SECTION("test_busy_until_timeout") {
+  basics::ConditionVariable condition;
+  CONDITION_LOCKER(guard, condition);
+
+  double start = TRI_microtime();
+  CHECK(!QueryRegistry::waitWhile(guard, 0.1, []() { return true; }));
+  CHECK(TRI_microtime() - start >= 0.1);
+}
+
+SECTION("test_close_wakes_up_waiting_thread") {
+  basics::ConditionVariable condition;
+  bool isOpen = true;
+
+  std::thread closer([&condition, &isOpen]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    CONDITION_LOCKER(guard, condition);
+    isOpen = false;
+    guard.broadcast();
+  });
+
+  double start = TRI_microtime();
+  bool closed;
+  {
+    CONDITION_LOCKER(guard, condition);
+    closed = QueryRegistry::waitWhile(guard, 60.0,
+                                      [&isOpen]() { return isOpen; });
+  }
+  double elapsed = TRI_microtime() - start;
+  closer.join();
+
+  CHECK(closed);
+  CHECK(!isOpen);
+  // woken up by the broadcast, not by the timeout
+  CHECK(elapsed < 30.0);
+}
+
+SECTION("test_other_wake_ups_keep_waiting") {
+  basics::ConditionVariable condition;
+  int closes = 0;
+
+  // every broadcast wakes up the waiting thread, which must check again
+  std::thread closer([&condition, &closes]() {
+    for (int i = 0; i < 3; ++i) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(20));
+      CONDITION_LOCKER(guard, condition);
+      ++closes;
+      guard.broadcast();
+    }
+  });
+
+  bool closed;
+  {
+    CONDITION_LOCKER(guard, condition);
+    closed = QueryRegistry::waitWhile(guard, 60.0,
+                                      [&closes]() { return closes < 3; });
+  }
+  closer.join();
+
+  CHECK(closed);
+  CHECK(closes == 3);
+}
+
+}
@@ -0,0 +1,91 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+
+#include "catch.hpp"
+
+#include "Aql/SortBlock.h"
+
+#include <random>
+
+using namespace arangodb::aql;
+
+typedef std::vector<std::pair<size_t, size_t>> Coords;
+
+// the coordinates of the given number of rows, in blocks of blockSize rows
+static Coords makeCoords(size_t rows, size_t blockSize) {
+  Coords coords;
+  for (size_t i = 0; i < rows; ++i) {
+    coords.emplace_back(i / blockSize, i % blockSize);
+  }
+  return coords;
+}
+
+TEST_CASE("SortBlockTest", "[aql]") {
+
+SECTION("test_sort_first_is_stable") {
+  // many ties, so the tie-breaker decides most of the order
+  std::vector<int> const values{3, 1, 2, 1, 3, 1, 2, 2, 1, 3};
+  size_t const blockSize = 4;
+  auto lessThan = [&values, blockSize](std::pair<size_t, size_t> const& a,
+                                       std::pair<size_t, size_t> const& b) {
+    return values[a.first * blockSize + a.second] <
+           values[b.first * blockSize + b.second];
+  };
+
+  Coords expected = makeCoords(values.size(), blockSize);
+  std::stable_sort(expected.begin(), expected.end(), lessThan);
+
+  for (size_t limit = 1; limit < values.size(); ++limit) {
+    Coords coords = makeCoords(values.size(), blockSize);
+    SortBlock::sortFirst(coords, limit, lessThan);
+    REQUIRE(coords.size() == limit);
+    for (size_t i = 0; i < limit; ++i) {
+      CHECK(coords[i] == expected[i]);
+    }
+  }
+}
+
+SECTION("test_sort_first_matches_a_full_sort") {
+  std::mt19937 random(42);
+  std::vector<int> values;
+  for (size_t i = 0; i < 5000; ++i) {
+    values.push_back(static_cast<int>(random() % 100));
+  }
+  size_t const blockSize = 1000;
+  auto lessThan = [&values, blockSize](std::pair<size_t, size_t> const& a,
+                                       std::pair<size_t, size_t> const& b) {
+    return values[a.first * blockSize + a.second] >
+           values[b.first * blockSize + b.second];
+  };
+
+  Coords expected = makeCoords(values.size(), blockSize);
+  std::stable_sort(expected.begin(), expected.end(), lessThan);
+
+  Coords coords = makeCoords(values.size(), blockSize);
+  SortBlock::sortFirst(coords, 10, lessThan);
+  REQUIRE(coords.size() == 10);
+  CHECK(std::equal(coords.begin(), coords.end(), expected.begin()));
+  CHECK(values[coords[0].first * blockSize + coords[0].second] == 99);
+}
+
+}
@@ -0,0 +1,170 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+
+#include "catch.hpp"
+
+#include "Aql/AqlItemBlock.h"
+#include "Aql/ResourceUsage.h"
+#include "Aql/SpillFile.h"
+#include "Basics/files.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/velocypack-aliases.h>
+
+#include <algorithm>
+
+using namespace arangodb::aql;
+
+// the sort key of input row i. keys repeat, so the stability of the merge
+// can be checked
+static int64_t sortKey(int64_t i) { return (i * 7919) % 50; }
+
+// writes the input rows first .. last - 1 as a sorted run, the way SortBlock
+// spills its buffer. register 0 holds the sort key, register 1 the input
+// position and register 2 stays empty
+static std::unique_ptr<SpillFile> spillRun(ResourceMonitor* monitor,
+                                           int64_t first, int64_t last) {
+  std::vector<int64_t> rows;
+  for (int64_t i = first; i < last; ++i) {
+    rows.emplace_back(i);
+  }
+  std::stable_sort(rows.begin(), rows.end(), [](int64_t a, int64_t b) {
+    return sortKey(a) < sortKey(b);
+  });
+
+  AqlItemBlock block(monitor, rows.size(), 3);
+  for (size_t i = 0; i < rows.size(); ++i) {
+    block.setValue(i, 0, AqlValue(sortKey(rows[i])));
+    block.setValue(i, 1, AqlValue(rows[i]));
+  }
+
+  auto run = std::make_unique<SpillFile>();
+  for (size_t i = 0; i < rows.size(); ++i) {
+    run->appendRow(nullptr, &block, i);
+  }
+  run->finish();
+  return run;
+}
+
+static bool lessByKey(VPackSlice const& lhs, VPackSlice const& rhs) {
+  return lhs.at(0).getInt() < rhs.at(0).getInt();
+}
+
+TEST_CASE("SpillFileTest", "[aql]") {
+
+SECTION("test_values_read_back_in_order") {
+  SpillFile file;
+  VPackBuilder builder;
+  for (int64_t i = 0; i < 100; ++i) {
+    builder.clear();
+    builder.add(VPackValue(i));
+    file.append(builder.slice());
+  }
+  file.finish();
+  CHECK(file.count() == 100);
+
+  for (size_t pass = 0; pass < 2; ++pass) {
+    VPackSlice slice;
+    int64_t expected = 0;
+    while (file.next(slice)) {
+      CHECK(slice.getInt() == expected);
+      ++expected;
+    }
+    CHECK(expected == 100);
+    file.rewind();
+  }
+}
+
+SECTION("test_merge_of_spilled_runs_is_sorted_and_stable") {
+  ResourceMonitor monitor;
+
+  std::vector<std::unique_ptr<SpillFile>> runs;
+  runs.emplace_back(spillRun(&monitor, 0, 400));
+  runs.emplace_back(spillRun(&monitor, 400, 650));
+  runs.emplace_back(spillRun(&monitor, 650, 1000));
+
+  SpillFileMerge merge(runs, lessByKey);
+  AqlItemBlock result(&monitor, 1000, 3);
+
+  size_t count = 0;
+  VPackSlice row;
+  while (merge.next(row)) {
+    REQUIRE(count < 1000);
+    SpillFile::readRow(row, &result, count);
+    ++count;
+  }
+  CHECK(count == 1000);
+  CHECK(!merge.hasMore());
+
+  for (size_t i = 0; i < count; ++i) {
+    CHECK(result.getValueReference(i, 2).isEmpty());
+    int64_t const key = result.getValueReference(i, 0).slice().getInt();
+    int64_t const position = result.getValueReference(i, 1).slice().getInt();
+    CHECK(key == sortKey(position));
+
+    if (i > 0) {
+      int64_t const previousKey =
+          result.getValueReference(i - 1, 0).slice().getInt();
+      int64_t const previousPosition =
+          result.getValueReference(i - 1, 1).slice().getInt();
+      CHECK(previousKey <= key);
+      if (previousKey == key) {
+        // equal keys keep their input order
+        CHECK(previousPosition < position);
+      }
+    }
+  }
+}
+
+SECTION("test_merge_of_empty_runs") {
+  std::vector<std::unique_ptr<SpillFile>> runs;
+  runs.emplace_back(std::make_unique<SpillFile>());
+  runs.back()->finish();
+
+  SpillFileMerge merge(runs, lessByKey);
+  VPackSlice row;
+  CHECK(!merge.hasMore());
+  CHECK(!merge.next(row));
+}
+
+SECTION("test_temporary_files_are_removed") {
+  ResourceMonitor monitor;
+  std::vector<std::string> filenames;
+  {
+    std::vector<std::unique_ptr<SpillFile>> runs;
+    runs.emplace_back(spillRun(&monitor, 0, 10));
+    runs.emplace_back(spillRun(&monitor, 10, 20));
+
+    for (auto const& it : runs) {
+      filenames.emplace_back(it->filename());
+      CHECK(TRI_ExistsFile(it->filename().c_str()));
+    }
+    CHECK(filenames[0] != filenames[1]);
+  }
+
+  for (auto const& it : filenames) {
+    CHECK(!TRI_ExistsFile(it.c_str()));
+  }
+}
+
+}
@@ -0,0 +1,417 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite for arangodb::basics::AssocUnique
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+
+#include "catch.hpp"
+
+#include "Basics/AssocUnique.h"
+#include "Basics/fasthash.h"
+#include "Random/RandomGenerator.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Iterator.h>
+#include <velocypack/velocypack-aliases.h>
+
+#include <thread>
+
+using namespace arangodb::basics;
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 private functions
+// -----------------------------------------------------------------------------
+
+namespace {
+
+/// @brief an element is its key. 0 is the empty element
+struct TestElement {
+  uint64_t key;
+
+  TestElement() : key(0) {}
+  explicit TestElement(uint64_t key) : key(key) {}
+
+  operator bool() const { return key != 0; }
+  bool operator==(TestElement const& other) const { return key == other.key; }
+};
+
+typedef AssocUnique<uint64_t, TestElement> TestIndex;
+
+uint64_t hashKey(void*, uint64_t const* key) {
+  return fasthash64(key, sizeof(uint64_t), 0x12345678);
+}
+
+uint64_t hashElement(void*, TestElement const& element) {
+  return fasthash64(&element.key, sizeof(uint64_t), 0x12345678);
+}
+
+bool isEqualKeyElement(void*, uint64_t const* key, uint64_t,
+                       TestElement const& element) {
+  return *key == element.key;
+}
+
+bool isEqualElementElement(void*, TestElement const& left,
+                           TestElement const& right) {
+  return left.key == right.key;
+}
+
+std::unique_ptr<TestIndex> createIndex(size_t buckets) {
+  return std::unique_ptr<TestIndex>(
+      new TestIndex(hashKey, hashElement, isEqualKeyElement,
+                    isEqualElementElement, isEqualElementElement, buckets));
+}
+
+/// @brief whether some bucket of the index is being resized incrementally
+bool isMigrating(TestIndex& index) {
+  VPackBuilder builder;
+  builder.openObject();
+  index.appendToVelocyPack(builder);
+  builder.close();
+
+  for (auto const& bucket : VPackArrayIterator(builder.slice().get("buckets"))) {
+    if (bucket.hasKey("nrMigrating")) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/// @brief the keys of all elements, in the order of a sequential scan
+std::vector<uint64_t> scanSerial(TestIndex const& index) {
+  std::vector<uint64_t> keys;
+  BucketPosition position;
+  uint64_t total = 0;
+
+  while (true) {
+    TestElement element = index.findSequential(nullptr, position, total);
+    if (!element) {
+      break;
+    }
+    keys.emplace_back(element.key);
+  }
+  return keys;
+}
+
+/// @brief the keys of all elements, with the buckets scanned by several
+/// threads at once, as a parallel collection scan does
+std::vector<uint64_t> scanParallel(TestIndex const& index, size_t threads) {
+  std::vector<std::vector<uint64_t>> results(threads);
+  std::vector<std::thread> workers;
+
+  for (size_t t = 0; t < threads; ++t) {
+    workers.emplace_back([&index, &results, t, threads]() {
+      for (size_t b = t; b < index.buckets(); b += threads) {
+        uint64_t position = 0;
+        while (true) {
+          TestElement element =
+              index.findSequentialInBucket(nullptr, b, position);
+          if (!element) {
+            break;
+          }
+          results[t].emplace_back(element.key);
+        }
+      }
+    });
+  }
+  for (auto& it : workers) {
+    it.join();
+  }
+
+  std::vector<uint64_t> keys;
+  for (auto const& it : results) {
+    keys.insert(keys.end(), it.begin(), it.end());
+  }
+  return keys;
+}
+
+/// @brief inserts the keys 1, 2, ... until a bucket of the index is being
+/// resized incrementally. returns the number of inserted keys
+uint64_t fillUntilMigrating(TestIndex& index) {
+  uint64_t key = 0;
+  while (!isMigrating(index)) {
+    REQUIRE(index.insert(nullptr, TestElement(++key)) == TRI_ERROR_NO_ERROR);
+    REQUIRE(key < 1000000);
+  }
+  return key;
+}
+
+/// @brief the keys of all elements, in reverse sequential order
+std::vector<uint64_t> scanReverse(TestIndex const& index) {
+  std::vector<uint64_t> keys;
+  BucketPosition position;
+
+  while (true) {
+    TestElement element = index.findSequentialReverse(nullptr, position);
+    if (!element) {
+      break;
+    }
+    keys.emplace_back(element.key);
+  }
+  return keys;
+}
+
+/// @brief the keys of all elements, in random order
+std::vector<uint64_t> scanRandom(TestIndex const& index) {
+  std::vector<uint64_t> keys;
+  BucketPosition initial;
+  BucketPosition position;
+  uint64_t step = 0;
+  uint64_t total = 0;
+
+  while (true) {
+    TestElement element =
+        index.findRandom(nullptr, initial, position, step, total);
+    if (!element) {
+      break;
+    }
+    keys.emplace_back(element.key);
+  }
+  return keys;
+}
+
+/// @brief the sorted list of the keys first .. last
+std::vector<uint64_t> keyRange(uint64_t first, uint64_t last) {
+  std::vector<uint64_t> keys;
+  for (uint64_t i = first; i <= last; ++i) {
+    keys.emplace_back(i);
+  }
+  return keys;
+}
+
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                        test suite
+// -----------------------------------------------------------------------------
+
+TEST_CASE("AssocUniqueTest", "[assoc]") {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief a parallel scan of the buckets returns the same elements as a
+/// sequential scan
+////////////////////////////////////////////////////////////////////////////////
+
+SECTION("test_parallel_scan_equals_serial_scan") {
+  auto index = createIndex(8);
+  REQUIRE(index->buckets() == 8);
+
+  for (uint64_t i = 1; i <= 10000; ++i) {
+    REQUIRE(index->insert(nullptr, TestElement(i)) == TRI_ERROR_NO_ERROR);
+  }
+
+  std::vector<uint64_t> serial = scanSerial(*index);
+  std::vector<uint64_t> parallel = scanParallel(*index, 3);
+
+  CHECK(serial.size() == 10000);
+  std::sort(serial.begin(), serial.end());
+  std::sort(parallel.begin(), parallel.end());
+  CHECK(serial == parallel);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the scans also agree while a bucket is being resized, when its
+/// elements are spread across its old and its new table
+////////////////////////////////////////////////////////////////////////////////
+
+SECTION("test_parallel_scan_during_resize") {
+  auto index = createIndex(2);
+  uint64_t const key = fillUntilMigrating(*index);
+
+  std::vector<uint64_t> serial = scanSerial(*index);
+  std::vector<uint64_t> parallel = scanParallel(*index, 2);
+
+  CHECK(serial.size() == key);
+  std::sort(serial.begin(), serial.end());
+  std::sort(parallel.begin(), parallel.end());
+  CHECK(serial == parallel);
+  // no element is returned twice
+  CHECK(std::unique(parallel.begin(), parallel.end()) == parallel.end());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief all elements can be found while a bucket is being resized, no
+/// matter whether they are still in the old table or already in the new one
+////////////////////////////////////////////////////////////////////////////////
+
+SECTION("test_lookup_during_resize") {
+  auto index = createIndex(1);
+  uint64_t const last = fillUntilMigrating(*index);
+
+  CHECK(index->size() == last);
+  for (uint64_t key = 1; key <= last; ++key) {
+    CHECK(index->findByKey(nullptr, &key).key == key);
+    CHECK(index->find(nullptr, TestElement(key)).key == key);
+  }
+
+  uint64_t const missing = last + 1;
+  CHECK(!index->findByKey(nullptr, &missing));
+  CHECK(!index->find(nullptr, TestElement(missing)));
+  // lookups do not advance the resize
+  CHECK(isMigrating(*index));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief inserts during a resize keep the uniqueness of the keys, also for
+/// keys that are only contained in the old table
+////////////////////////////////////////////////////////////////////////////////
+
+SECTION("test_insert_during_resize") {
+  auto index = createIndex(1);
+  uint64_t const last = fillUntilMigrating(*index);
+
+  for (uint64_t key = 1; key <= 500; ++key) {
+    CHECK(index->insert(nullptr, TestElement(key)) ==
+          TRI_ERROR_ARANGO_UNIQUE_CONSTRAINT_VIOLATED);
+  }
+  for (uint64_t key = last + 1; key <= last + 500; ++key) {
+    CHECK(index->insert(nullptr, TestElement(key)) == TRI_ERROR_NO_ERROR);
+  }
+  REQUIRE(isMigrating(*index));
+
+  CHECK(index->size() == last + 500);
+  for (uint64_t key = 1; key <= last + 500; ++key) {
+    CHECK(index->findByKey(nullptr, &key).key == key);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief removes during a resize find their elements in both tables
+////////////////////////////////////////////////////////////////////////////////
+
+SECTION("test_remove_during_resize") {
+  auto index = createIndex(1);
+  uint64_t const last = fillUntilMigrating(*index);
+
+  // remove every third key, by key and by element
+  uint64_t removed = 0;
+  for (uint64_t key = 3; key <= 3000; key += 3) {
+    TestElement old = (key % 2 == 0)
+                          ? index->removeByKey(nullptr, &key)
+                          : index->remove(nullptr, TestElement(key));
+    CHECK(old.key == key);
+    ++removed;
+  }
+  REQUIRE(isMigrating(*index));
+
+  // removing again finds nothing
+  for (uint64_t key = 3; key <= 3000; key += 3) {
+    CHECK(!index->removeByKey(nullptr, &key));
+  }
+
+  CHECK(index->size() == last - removed);
+  for (uint64_t key = 1; key <= last; ++key) {
+    TestElement found = index->findByKey(nullptr, &key);
+    if (key <= 3000 && key % 3 == 0) {
+      CHECK(!found);
+    } else {
+      CHECK(found.key == key);
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the iteration methods return every element exactly once while a
+/// bucket is being resized, across its old and its new table
+////////////////////////////////////////////////////////////////////////////////
+
+SECTION("test_iteration_during_resize") {
+  auto index = createIndex(1);
+  uint64_t const last = fillUntilMigrating(*index);
+
+  // move some elements into the new table, and add some that are only there
+  for (uint64_t key = last + 1; key <= last + 100; ++key) {
+    REQUIRE(index->insert(nullptr, TestElement(key)) == TRI_ERROR_NO_ERROR);
+  }
+  REQUIRE(isMigrating(*index));
+
+  std::vector<uint64_t> const expected = keyRange(1, last + 100);
+
+  std::vector<uint64_t> serial = scanSerial(*index);
+  std::sort(serial.begin(), serial.end());
+  CHECK(serial == expected);
+
+  std::vector<uint64_t> reverse = scanReverse(*index);
+  std::sort(reverse.begin(), reverse.end());
+  CHECK(reverse == expected);
+
+  arangodb::RandomGenerator::initialize(
+      arangodb::RandomGenerator::RandomType::MERSENNE);
+  std::vector<uint64_t> random = scanRandom(*index);
+  arangodb::RandomGenerator::shutdown();
+  std::sort(random.begin(), random.end());
+  CHECK(random == expected);
+
+  std::vector<uint64_t> all;
+  index->invokeOnAllElements([&all](TestElement& element) {
+    all.emplace_back(element.key);
+    return true;
+  });
+  std::sort(all.begin(), all.end());
+  CHECK(all == expected);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief removing all elements during an iteration finishes the resize
+/// first and visits every element once
+////////////////////////////////////////////////////////////////////////////////
+
+SECTION("test_iteration_for_removal_during_resize") {
+  auto index = createIndex(1);
+  uint64_t const last = fillUntilMigrating(*index);
+
+  std::vector<uint64_t> visited;
+  index->invokeOnAllElementsForRemoval([&](TestElement& element) {
+    uint64_t const key = element.key;
+    visited.emplace_back(key);
+    CHECK(index->removeByKey(nullptr, &key).key == key);
+    return true;
+  });
+
+  CHECK(!isMigrating(*index));
+  CHECK(index->isEmpty());
+  std::sort(visited.begin(), visited.end());
+  CHECK(visited == keyRange(1, last));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the resize finishes under continued inserts, and no element is lost
+////////////////////////////////////////////////////////////////////////////////
+
+SECTION("test_resize_completes") {
+  auto index = createIndex(1);
+  uint64_t last = fillUntilMigrating(*index);
+
+  while (isMigrating(*index)) {
+    ++last;
+    REQUIRE(index->insert(nullptr, TestElement(last)) == TRI_ERROR_NO_ERROR);
+    REQUIRE(last < 1000000);
+  }
+
+  CHECK(index->size() == last);
+  std::vector<uint64_t> serial = scanSerial(*index);
+  std::sort(serial.begin(), serial.end());
+  CHECK(serial == keyRange(1, last));
+}
+
+}
@@ -0,0 +1,121 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+
+#include "catch.hpp"
+
+#include "Basics/CpuProfiler.h"
+#include "Basics/StringUtils.h"
+
+#include <thread>
+
+using namespace arangodb::basics;
+
+static void spin(std::atomic<bool>* stop, bool profiled) {
+  if (profiled) {
+    CpuProfiler::registerThread();
+  }
+  double x = 0.0;
+  while (!stop->load()) {
+    x = x * 1.0000001 + 0.5;
+  }
+  if (x < 0.0) {
+    std::abort();
+  }
+  if (profiled) {
+    CpuProfiler::unregisterThread();
+  }
+}
+
+TEST_CASE("CpuProfilerTest", "[profiler]") {
+
+SECTION("test_bad_parameters") {
+  std::string result;
+  CHECK(TRI_ERROR_BAD_PARAMETER == CpuProfiler::profile(0.0, 100, result));
+  CHECK(TRI_ERROR_BAD_PARAMETER == CpuProfiler::profile(1.0, 0, result));
+  CHECK(TRI_ERROR_BAD_PARAMETER ==
+        CpuProfiler::profile(CpuProfiler::MaxSeconds + 1.0, 100, result));
+  CHECK(TRI_ERROR_BAD_PARAMETER ==
+        CpuProfiler::profile(1.0, CpuProfiler::MaxFrequency + 1, result));
+  CHECK(result.empty());
+}
+
+SECTION("test_folded_stacks") {
+  if (!CpuProfiler::isSupported()) {
+    return;
+  }
+
+  std::atomic<bool> stop(false);
+  std::thread thread(spin, &stop, true);
+
+  std::string result;
+  int res = CpuProfiler::profile(0.5, 200, result);
+  stop.store(true);
+  thread.join();
+
+  CHECK(TRI_ERROR_NO_ERROR == res);
+  REQUIRE(!result.empty());
+
+  // every line is a stack followed by its number of samples
+  uint64_t total = 0;
+  for (auto const& line : StringUtils::split(result, '\n')) {
+    if (line.empty()) {
+      continue;
+    }
+    size_t pos = line.rfind(' ');
+    REQUIRE(pos != std::string::npos);
+    CHECK(pos > 0);
+    uint64_t count = StringUtils::uint64(line.substr(pos + 1));
+    CHECK(count > 0);
+    total += count;
+  }
+  CHECK(total > 0);
+}
+
+SECTION("test_unregistered_threads_not_sampled") {
+  if (!CpuProfiler::isSupported()) {
+    return;
+  }
+
+  std::atomic<bool> stop(false);
+  std::thread thread(spin, &stop, false);
+
+  std::string result;
+  int res = CpuProfiler::profile(0.2, 200, result);
+  stop.store(true);
+  thread.join();
+
+  CHECK(TRI_ERROR_NO_ERROR == res);
+  CHECK(result.empty());
+}
+
+SECTION("test_signal_ignored_afterwards") {
+  if (!CpuProfiler::isSupported()) {
+    return;
+  }
+
+  std::string result;
+  CHECK(TRI_ERROR_NO_ERROR == CpuProfiler::profile(0.05, 1000, result));
+  // a late SIGPROF must not terminate the process
+  raise(SIGPROF);
+}
+}
@@ -0,0 +1,79 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+
+#include "catch.hpp"
+
+#include "Basics/LargePages.h"
+
+using namespace arangodb::basics;
+
+TEST_CASE("LargePagesTest", "[memory]") {
+
+SECTION("test_small_tables") {
+  LargePages::setMode(LargePages::Mode::TRANSPARENT);
+  CHECK(LargePages::allocate(LargePages::MinSize - 1) == nullptr);
+
+  int onHeap = 0;
+  CHECK(!LargePages::free(&onHeap));
+  CHECK(!LargePages::free(nullptr));
+}
+
+SECTION("test_off") {
+  LargePages::setMode(LargePages::Mode::OFF);
+  CHECK(LargePages::allocate(8 * LargePages::MinSize) == nullptr);
+  LargePages::setMode(LargePages::Mode::TRANSPARENT);
+}
+
+#ifdef __linux__
+SECTION("test_transparent") {
+  LargePages::setMode(LargePages::Mode::TRANSPARENT);
+
+  size_t const size = 3 * LargePages::MinSize + 17;
+  char* memory = static_cast<char*>(LargePages::allocate(size));
+  REQUIRE(memory != nullptr);
+
+  // aligned to the huge page size and zero-filled
+  CHECK(reinterpret_cast<uintptr_t>(memory) % LargePages::MinSize == 0);
+  CHECK(memory[0] == 0);
+  CHECK(memory[size - 1] == 0);
+
+  memset(memory, 1, size);
+  CHECK(memory[size / 2] == 1);
+
+  CHECK(LargePages::free(memory));
+}
+
+SECTION("test_explicit_falls_back") {
+  // without reserved huge pages the memory is mapped transparently
+  LargePages::setMode(LargePages::Mode::EXPLICIT);
+
+  char* memory = static_cast<char*>(LargePages::allocate(LargePages::MinSize));
+  REQUIRE(memory != nullptr);
+  memset(memory, 1, LargePages::MinSize);
+  CHECK(LargePages::free(memory));
+
+  LargePages::setMode(LargePages::Mode::TRANSPARENT);
+}
+#endif
+
+}
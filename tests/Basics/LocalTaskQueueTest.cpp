@@ -0,0 +1,135 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+
+#include "catch.hpp"
+
+#include "Basics/LocalTaskQueue.h"
+
+#include <thread>
+
+using namespace arangodb::basics;
+
+namespace {
+
+class CountTask : public LocalTask {
+ public:
+  CountTask(LocalTaskQueue* queue, std::atomic<size_t>* counter)
+      : LocalTask(queue), _counter(counter) {}
+
+  void run() override {
+    ++(*_counter);
+    _queue->join();
+  }
+
+ private:
+  std::atomic<size_t>* _counter;
+};
+
+}
+
+// enqueues tasks and a callback that checks that all tasks ran before it
+static void fill(LocalTaskQueue& queue, size_t n, std::atomic<size_t>& counter,
+                 std::atomic<size_t>& seen) {
+  for (size_t i = 0; i < n; ++i) {
+    queue.enqueue(std::make_shared<CountTask>(&queue, &counter));
+  }
+  queue.enqueueCallback(std::make_shared<LocalCallbackTask>(
+      &queue, [&counter, &seen]() { seen = counter.load(); }));
+}
+
+TEST_CASE("LocalTaskQueueTest", "[basics]") {
+
+SECTION("test_tasks_run_on_io_service") {
+  boost::asio::io_service ioService;
+  auto work = std::make_unique<boost::asio::io_service::work>(ioService);
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < 4; ++i) {
+    threads.emplace_back([&ioService]() { ioService.run(); });
+  }
+
+  std::atomic<size_t> counter(0);
+  std::atomic<size_t> seen(0);
+  LocalTaskQueue queue(&ioService);
+  fill(queue, 100, counter, seen);
+  queue.dispatchAndWait();
+
+  CHECK(counter == 100);
+  CHECK(seen == 100);
+
+  work.reset();
+  for (auto& it : threads) {
+    it.join();
+  }
+}
+
+SECTION("test_tasks_run_inline_without_io_service") {
+  std::atomic<size_t> counter(0);
+  std::atomic<size_t> seen(0);
+  LocalTaskQueue queue(nullptr);
+  fill(queue, 10, counter, seen);
+  queue.dispatchAndWait();
+
+  CHECK(counter == 10);
+  CHECK(seen == 10);
+}
+
+SECTION("test_tasks_run_inline_on_stopped_io_service") {
+  boost::asio::io_service ioService;
+  ioService.stop();
+
+  std::atomic<size_t> counter(0);
+  std::atomic<size_t> seen(0);
+  LocalTaskQueue queue(&ioService);
+  fill(queue, 10, counter, seen);
+  queue.dispatchAndWait();
+
+  CHECK(counter == 10);
+  CHECK(seen == 10);
+}
+
+SECTION("test_io_service_stopped_while_waiting") {
+  // nobody runs the io_service, as at shutdown once its threads are gone.
+  // stopping it must not leave dispatchAndWait waiting forever
+  boost::asio::io_service ioService;
+  std::thread stopper([&ioService]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    ioService.stop();
+  });
+
+  std::atomic<size_t> counter(0);
+  std::atomic<size_t> seen(0);
+  LocalTaskQueue queue(&ioService);
+  fill(queue, 10, counter, seen);
+  queue.dispatchAndWait();
+  stopper.join();
+
+  CHECK(counter == 10);
+  CHECK(seen == 10);
+
+  // the handlers left in the io_service must not run the tasks again
+  ioService.reset();
+  ioService.run();
+  CHECK(counter == 10);
+}
+
+}
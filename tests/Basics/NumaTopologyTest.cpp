@@ -0,0 +1,77 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+
+#include "catch.hpp"
+
+#include "Basics/NumaTopology.h"
+
+using namespace arangodb::basics;
+
+TEST_CASE("NumaTopologyTest", "[numa]") {
+
+SECTION("test_parse_cpu_list") {
+  CHECK((NumaTopology::parseCpuList("") == std::vector<size_t>{}));
+  CHECK((NumaTopology::parseCpuList("0") == std::vector<size_t>{0}));
+  CHECK((NumaTopology::parseCpuList("0-3\n") ==
+         std::vector<size_t>{0, 1, 2, 3}));
+  CHECK((NumaTopology::parseCpuList("0-1,8,10-11") ==
+         std::vector<size_t>{0, 1, 8, 10, 11}));
+}
+
+SECTION("test_parse_cpu_list_garbage") {
+  CHECK((NumaTopology::parseCpuList("x") == std::vector<size_t>{}));
+  CHECK((NumaTopology::parseCpuList("2,x,3") == std::vector<size_t>{2}));
+  CHECK((NumaTopology::parseCpuList("4-") == std::vector<size_t>{}));
+}
+
+SECTION("test_topology") {
+  size_t const n = NumaTopology::numberOfNodes();
+  CHECK(n >= 1);
+
+  for (size_t node = 0; node < n; ++node) {
+    CHECK(!NumaTopology::cpus(node).empty());
+
+    for (auto const& cpu : NumaTopology::cpus(node)) {
+      CHECK(NumaTopology::nodeOfCpu(cpu) == node);
+    }
+  }
+
+  CHECK(NumaTopology::currentNode() < n);
+}
+
+SECTION("test_enable") {
+  bool enabled = NumaTopology::setEnabled(true);
+  CHECK(enabled == (NumaTopology::numberOfNodes() > 1));
+  CHECK(NumaTopology::enabled() == enabled);
+
+  // the policies must leave the memory usable
+  std::vector<char> memory(1 << 20, 1);
+  NumaTopology::interleave(memory.data(), memory.size());
+  NumaTopology::preferNode(memory.data(), memory.size(), 0);
+  CHECK(memory[12345] == 1);
+
+  CHECK(!NumaTopology::setEnabled(false));
+  CHECK(!NumaTopology::enabled());
+}
+
+}
@@ -0,0 +1,150 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+
+#include "catch.hpp"
+
+#include "Basics/ReadLocker.h"
+#include "Basics/ReadMostlyLock.h"
+#include "Basics/WriteLocker.h"
+
+#include <thread>
+
+using namespace arangodb::basics;
+
+TEST_CASE("ReadMostlyLockTest", "[locks]") {
+
+SECTION("test_read_lock_shared") {
+  ReadMostlyLock lock;
+
+  lock.readLock();
+  CHECK(lock.tryReadLock());
+  CHECK(!lock.tryWriteLock());
+
+  lock.unlock();
+  lock.unlock();
+
+  CHECK(lock.tryWriteLock());
+  lock.unlock();
+}
+
+SECTION("test_write_lock_exclusive") {
+  ReadMostlyLock lock;
+
+  lock.writeLock();
+  CHECK(!lock.tryReadLock());
+  CHECK(!lock.tryWriteLock());
+
+  // another thread counts with another slot
+  bool otherRead = true;
+  std::thread([&]() { otherRead = lock.tryReadLock(); }).join();
+  CHECK(!otherRead);
+
+  lock.unlock();
+
+  CHECK(lock.tryReadLock());
+  lock.unlock();
+}
+
+SECTION("test_reader_of_other_thread_blocks_writer") {
+  ReadMostlyLock lock;
+  std::atomic<bool> locked(false);
+  std::atomic<bool> release(false);
+
+  // a read lock must be released by the thread that acquired it
+  std::thread reader([&]() {
+    lock.readLock();
+    locked = true;
+    while (!release.load()) {
+      std::this_thread::yield();
+    }
+    lock.unlock();
+  });
+
+  while (!locked.load()) {
+    std::this_thread::yield();
+  }
+  CHECK(!lock.tryWriteLock());
+
+  release = true;
+  reader.join();
+
+  CHECK(lock.tryWriteLock());
+  lock.unlock();
+}
+
+SECTION("test_lockers") {
+  ReadMostlyLock lock;
+
+  {
+    READ_LOCKER(locker, lock);
+    CHECK(locker.isLocked());
+    CHECK(!lock.tryWriteLock());
+  }
+  {
+    WRITE_LOCKER(locker, lock);
+    CHECK(!lock.tryReadLock());
+  }
+
+  CHECK(lock.tryWriteLock());
+  lock.unlock();
+}
+
+SECTION("test_concurrent_writers_and_readers") {
+  ReadMostlyLock lock;
+  uint64_t a = 0;
+  uint64_t b = 0;
+  std::atomic<bool> mismatch(false);
+
+  std::vector<std::thread> threads;
+
+  for (size_t i = 0; i < 4; ++i) {
+    threads.emplace_back([&]() {
+      for (size_t j = 0; j < 10000; ++j) {
+        READ_LOCKER(locker, lock);
+        if (a != b) {
+          mismatch = true;
+        }
+      }
+    });
+  }
+
+  for (size_t i = 0; i < 2; ++i) {
+    threads.emplace_back([&]() {
+      for (size_t j = 0; j < 1000; ++j) {
+        WRITE_LOCKER(locker, lock);
+        ++a;
+        ++b;
+      }
+    });
+  }
+
+  for (auto& it : threads) {
+    it.join();
+  }
+
+  CHECK(!mismatch.load());
+  CHECK(a == 2000);
+  CHECK(b == 2000);
+}
+
+}
@@ -0,0 +1,159 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite for VelocyPackDumper
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+
+#include "catch.hpp"
+
+#include "Basics/StringBuffer.h"
+#include "Basics/VelocyPackDumper.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Options.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+using namespace arangodb::basics;
+
+static std::string dump(VPackSlice const& slice, VPackOptions const* options) {
+  StringBuffer buffer(TRI_UNKNOWN_MEM_ZONE);
+  VelocyPackDumper dumper(&buffer, options);
+  dumper.dumpValue(slice);
+  return std::string(buffer.c_str(), buffer.length());
+}
+
+/// @brief dumps a string value and compares the result with the one of the
+/// velocypack library's dumper
+static void checkString(std::string const& value,
+                        VPackOptions const* options = &VPackOptions::Defaults) {
+  VPackBuilder builder;
+  builder.add(VPackValue(value));
+  CHECK(dump(builder.slice(), options) == builder.slice().toJson(options));
+}
+
+TEST_CASE("VelocyPackDumperTest", "[vpack]") {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test_scalars
+////////////////////////////////////////////////////////////////////////////////
+
+SECTION("test_scalars") {
+  VPackBuilder builder;
+  builder.openArray();
+  builder.add(VPackValue(VPackValueType::Null));
+  builder.add(VPackValue(true));
+  builder.add(VPackValue(false));
+  builder.add(VPackValue(-5));
+  builder.add(VPackValue(static_cast<int64_t>(12345678901LL)));
+  builder.add(VPackValue(1.5));
+  builder.close();
+
+  CHECK(dump(builder.slice(), &VPackOptions::Defaults) ==
+        "[null,true,false,-5,12345678901,1.5]");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test_plain_strings
+////////////////////////////////////////////////////////////////////////////////
+
+SECTION("test_plain_strings") {
+  std::string value;
+  for (size_t i = 0; i < 100; ++i) {
+    checkString(value);
+    value.push_back(static_cast<char>('a' + (i % 26)));
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test_escapes_at_all_positions
+////////////////////////////////////////////////////////////////////////////////
+
+SECTION("test_escapes_at_all_positions") {
+  char const special[] = {'"', '\\', '/', '\n', '\t', '\x01', '\x1f'};
+
+  for (auto const& c : special) {
+    for (size_t pos = 0; pos < 40; ++pos) {
+      std::string value(40, 'x');
+      value[pos] = c;
+      checkString(value);
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test_multibyte_sequences
+////////////////////////////////////////////////////////////////////////////////
+
+SECTION("test_multibyte_sequences") {
+  VPackOptions escapeUnicode;
+  escapeUnicode.escapeUnicode = true;
+
+  std::string const sequences[] = {"\xc3\xa4", "\xe2\x82\xac",
+                                   "\xf0\x9f\x98\x80"};
+
+  for (auto const& sequence : sequences) {
+    for (size_t pos = 0; pos < 33; ++pos) {
+      std::string value(33, 'y');
+      value.insert(pos, sequence);
+      checkString(value);
+      checkString(value, &escapeUnicode);
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test_escape_forward_slashes
+////////////////////////////////////////////////////////////////////////////////
+
+SECTION("test_escape_forward_slashes") {
+  VPackOptions options;
+  options.escapeForwardSlashes = true;
+
+  checkString("/_db/_system/_api/document/products/12345678", &options);
+  checkString("/_db/_system/_api/document/products/12345678");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test_nested
+////////////////////////////////////////////////////////////////////////////////
+
+SECTION("test_nested") {
+  VPackBuilder builder;
+  builder.openObject();
+  builder.add("_key", VPackValue("some-document-key-00001"));
+  builder.add("text", VPackValue("a \"quoted\" value\twith a\ttab, long enough"));
+  builder.add(VPackValue("values"));
+  builder.openArray();
+  builder.add(VPackValue(1));
+  builder.add(VPackValue("two"));
+  builder.openObject();
+  builder.close();
+  builder.close();
+  builder.close();
+
+  CHECK(dump(builder.slice(), &VPackOptions::Defaults) ==
+        builder.slice().toJson());
+}
+}
@@ -0,0 +1,134 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+
+
+#include "catch.hpp"
+
+#include "Basics/WorkDescription.h"
+
+#include <thread>
+
+using namespace arangodb;
+
+static void pushCustom(WorkStack& stack) {
+  WorkDescription* desc = stack.beginPush();
+  if (desc != nullptr) {
+    desc->_type = WorkType::CUSTOM;
+    stack.endPush();
+  }
+}
+
+static void pop(WorkStack& stack) {
+  if (stack.beginPop() != nullptr) {
+    stack.endPop();
+  }
+}
+
+TEST_CASE("WorkStackTest", "[workmonitor]") {
+
+SECTION("test_push_and_pop") {
+  WorkStack stack(1);
+  CHECK(stack.top() == nullptr);
+
+  pushCustom(stack);
+  WorkDescription* first = stack.top();
+  REQUIRE(first != nullptr);
+  CHECK(first->_prev == nullptr);
+
+  pushCustom(stack);
+  WorkDescription* second = stack.top();
+  REQUIRE(second != nullptr);
+  CHECK(second->_prev == first);
+  CHECK(second->_id != first->_id);
+
+  pop(stack);
+  CHECK(stack.top() == first);
+  pop(stack);
+  CHECK(stack.top() == nullptr);
+}
+
+SECTION("test_ids_are_unique_across_stacks") {
+  WorkStack a(1);
+  WorkStack b(2);
+
+  pushCustom(a);
+  pushCustom(b);
+  CHECK(a.top()->_id != b.top()->_id);
+  pop(a);
+  pop(b);
+}
+
+SECTION("test_overflow_is_not_recorded") {
+  WorkStack stack(1);
+
+  for (size_t i = 0; i < WorkStack::MaxDepth; ++i) {
+    pushCustom(stack);
+  }
+  WorkDescription* top = stack.top();
+
+  CHECK(stack.beginPush() == nullptr);
+  CHECK(stack.top() == top);
+
+  // popping the unrecorded description keeps the recorded ones
+  CHECK(stack.beginPop() == nullptr);
+  CHECK(stack.top() == top);
+
+  for (size_t i = 0; i < WorkStack::MaxDepth; ++i) {
+    pop(stack);
+  }
+  CHECK(stack.top() == nullptr);
+}
+
+SECTION("test_reader_sees_consistent_stack") {
+  WorkStack stack(1);
+  std::atomic<bool> stop(false);
+  std::atomic<bool> mismatch(false);
+
+  std::thread owner([&]() {
+    while (!stop.load()) {
+      pushCustom(stack);
+      pushCustom(stack);
+      pop(stack);
+      pop(stack);
+    }
+  });
+
+  for (size_t i = 0; i < 10000; ++i) {
+    if (!stack.tryBeginRead()) {
+      continue;
+    }
+    WorkDescription* desc = stack.top();
+    if (desc != nullptr && desc->_prev != nullptr &&
+        desc->_prev->_prev != nullptr) {
+      mismatch = true;
+    }
+    stack.endRead();
+  }
+
+  stop = true;
+  owner.join();
+  CHECK(!mismatch.load());
+  CHECK(stack.top() == nullptr);
+}
+
+}
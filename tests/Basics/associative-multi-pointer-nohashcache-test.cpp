@@ -76,7 +76,7 @@ static uint64_t HashElement (void* userData, void const* e, bool byKey) {
   }
 }
 
-static bool IsEqualKeyElement (void* userData, void const* k, void const* r) {
+static bool IsEqualKeyElement (void* userData, void const* k, uint64_t, void const* r) {
   int const* key = (int const*) k;
   data_container_t const* element = (data_container_t const*) r;
 
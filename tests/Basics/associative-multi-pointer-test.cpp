@@ -81,6 +81,7 @@ static uint64_t HashElement (void* userData,
 
 static bool IsEqualKeyElement (void* userData,
                                void const* k, 
+                               uint64_t,
                                void const* r) {
   int const* key = (int const*) k;
   data_container_t const* element = (data_container_t const*) r;
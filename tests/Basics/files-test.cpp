@@ -219,6 +219,53 @@ SECTION("tst_filesize_non") {
   CHECK((int) -1 == (int) TRI_SizeFile("dihnui8ngiu54"));
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test reusing a file as a datafile
+////////////////////////////////////////////////////////////////////////////////
+
+SECTION("tst_recycle_datafile") {
+  std::string const blob(4096, 'x');
+  StringBuffer* oldFilename = s.writeFile(blob.c_str());
+  std::string filename = std::string(oldFilename->c_str()) + "-recycled";
+
+  int fd = TRI_RecycleDatafile(oldFilename->c_str(), filename, blob.size());
+  CHECK(fd >= 0);
+  CHECK(false == TRI_ExistsFile(oldFilename->c_str()));
+  CHECK((int64_t) blob.size() == TRI_SizeFile(filename.c_str()));
+
+  // the file is positioned at the start, and the old contents are gone
+  CHECK(0 == (int) TRI_LSEEK(fd, 0, SEEK_CUR));
+  TRI_CLOSE(fd);
+
+  size_t length;
+  char* content = TRI_SlurpFile(TRI_UNKNOWN_MEM_ZONE, filename.c_str(), &length);
+  CHECK(blob.size() == length);
+  CHECK(std::string(length, '\0') == std::string(content, length));
+  TRI_Free(TRI_UNKNOWN_MEM_ZONE, content);
+
+  TRI_UnlinkFile(filename.c_str());
+  delete oldFilename;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test files of another size are not reused
+////////////////////////////////////////////////////////////////////////////////
+
+SECTION("tst_recycle_datafile_size") {
+  const char* buffer = "the quick brown fox";
+
+  StringBuffer* oldFilename = s.writeFile(buffer);
+  std::string filename = std::string(oldFilename->c_str()) + "-recycled";
+
+  CHECK(-1 == TRI_RecycleDatafile(oldFilename->c_str(), filename, 4096));
+  CHECK(true == TRI_ExistsFile(oldFilename->c_str()));
+  CHECK(false == TRI_ExistsFile(filename.c_str()));
+  CHECK((int) strlen(buffer) == (int) TRI_SizeFile(oldFilename->c_str()));
+
+  TRI_UnlinkFile(oldFilename->c_str());
+  delete oldFilename;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief test absolute path
 ////////////////////////////////////////////////////////////////////////////////
@@ -404,6 +404,60 @@ SECTION("tst_value_low_roundtrip") {
   TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, json);
   TRI_DestroyStringBuffer(&buffer);
 }
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test shortest representations
+////////////////////////////////////////////////////////////////////////////////
+
+SECTION("tst_shortest") {
+  char out[24];
+  int length;
+
+  std::vector<std::pair<double, std::string>> const values = {
+    {0.1 + 0.2, "0.30000000000000004"},
+    {5e-324, "5e-324"},
+    {1.7976931348623157e308, "1.7976931348623157e+308"},
+    {2.2250738585072014e-308, "2.2250738585072014e-308"},
+    {9007199254740993.0, "9007199254740992"},
+    {1e21, "1e+21"},
+    {1e23, "1e+23"},
+    {123.456, "123.456"},
+    {-0.000001, "-0.000001"},
+    {1.5e-7, "1.5e-7"}
+  };
+
+  for (auto const& it : values) {
+    length = fpconv_dtoa(it.first, out);
+    CHECK(it.second == std::string(out, length));
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that the output parses back to the same value
+////////////////////////////////////////////////////////////////////////////////
+
+SECTION("tst_roundtrip_random") {
+  char out[25];
+  uint64_t bits = 0x9E3779B97F4A7C15ULL;
+
+  for (size_t i = 0; i < 100000; ++i) {
+    // xorshift, covers all exponents including denormals
+    bits ^= bits << 13;
+    bits ^= bits >> 7;
+    bits ^= bits << 17;
+
+    double value;
+    memcpy(&value, &bits, sizeof(double));
+
+    if (!std::isfinite(value)) {
+      continue;
+    }
+
+    int length = fpconv_dtoa(value, out);
+    out[length] = '\0';
+
+    CHECK(strtod(out, nullptr) == value);
+  }
+}
 }
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief generate tests
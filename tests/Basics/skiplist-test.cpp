@@ -65,6 +65,23 @@ static int CmpKeyElm (void*, void const* left,
 static void FreeElm (void* e) {
 }
 
+// comparators passed as function objects instead of std::function. the
+// user data counts the comparisons
+struct IntCmpElmElm {
+  int operator()(void* userData, int const* left, int const* right,
+                 arangodb::MMFilesSkiplistCmpType) const {
+    ++*static_cast<size_t*>(userData);
+    return *left == *right ? 0 : (*left < *right ? -1 : 1);
+  }
+};
+
+struct IntCmpKeyElm {
+  int operator()(void* userData, int const* left, int const* right) const {
+    ++*static_cast<size_t*>(userData);
+    return *left == *right ? 0 : (*left < *right ? -1 : 1);
+  }
+};
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                 setup / tear-down
 // -----------------------------------------------------------------------------
@@ -441,6 +458,62 @@ SECTION("tst_unique_remove_all") {
     delete i;
   }
 }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test comparators passed as template parameters
+////////////////////////////////////////////////////////////////////////////////
+
+SECTION("tst_comparator_objects") {
+  arangodb::MMFilesSkiplist<int, int, IntCmpElmElm, IntCmpKeyElm> skiplist(
+      IntCmpElmElm(), IntCmpKeyElm(), [](int*) {}, true, false);
+  size_t comparisons = 0;
+
+  // insert 100 values in reverse order
+  std::vector<int*> values;
+  for (int i = 0; i < 100; ++i) {
+    values.push_back(new int(i * 2));
+  }
+  for (int i = 99; i >= 0; --i) {
+    CHECK(0 == skiplist.insert(&comparisons, values[i]));
+  }
+  CHECK(comparisons > 0);
+  CHECK(100 == (int) skiplist.getNrUsed());
+
+  // a value that compares equal is rejected by the unique skiplist
+  int duplicate = 10;
+  CHECK(TRI_ERROR_ARANGO_UNIQUE_CONSTRAINT_VIOLATED == skiplist.insert(&comparisons, &duplicate));
+
+  // the forward iteration is sorted
+  auto current = skiplist.startNode()->nextNode();
+  for (int i = 0; i < 100; ++i) {
+    REQUIRE(current != nullptr);
+    CHECK(values[i] == current->document());
+    current = current->nextNode();
+  }
+  CHECK(current == nullptr);
+
+  // key lookups use the key comparator
+  comparisons = 0;
+  int key = 10;
+  CHECK(values[4] == skiplist.leftKeyLookup(&comparisons, &key)->document());
+  CHECK(values[5] == skiplist.rightKeyLookup(&comparisons, &key)->document());
+  key = 11;
+  CHECK(values[5] == skiplist.leftKeyLookup(&comparisons, &key)->document());
+  CHECK(values[5] == skiplist.rightKeyLookup(&comparisons, &key)->document());
+  key = -1;
+  CHECK(skiplist.startNode() == skiplist.leftKeyLookup(&comparisons, &key));
+  CHECK(comparisons > 0);
+
+  for (int i = 0; i < 100; ++i) {
+    CHECK(0 == skiplist.remove(&comparisons, values[i]));
+  }
+  CHECK(0 == (int) skiplist.getNrUsed());
+
+  // clean up
+  for (auto i : values) {
+    delete i;
+  }
+}
 }
 
 // Local Variables:
@@ -224,6 +224,53 @@ SECTION("tst_5") {
   arangodb::basics::Utf8Helper::DefaultUtf8Helper.getWords(words, "", 4, UINT32_MAX, false);
   CHECK(words.empty());
 }
+
+SECTION("tst_sort_keys") {
+  auto const& helper = arangodb::basics::Utf8Helper::DefaultUtf8Helper;
+  std::vector<std::string> values = {"", "a", "A", "ä", "Ä", "ab", "b", "B",
+                                     "Müller", "Mueller", "Muller", "zz",
+                                     "1", "10", "2", " ", "aa", "aä"};
+
+  std::vector<std::string> keys;
+  for (auto const& it : values) {
+    std::string key("prefix");
+    CHECK(helper.appendSortKey(it.data(), it.size(), key));
+    CHECK(key.size() > 6);
+    keys.emplace_back(key.substr(6));
+  }
+
+  for (size_t i = 0; i < values.size(); ++i) {
+    for (size_t j = 0; j < values.size(); ++j) {
+      int expected = helper.compareUtf8(values[i].data(), values[i].size(),
+                                        values[j].data(), values[j].size());
+      int actual = keys[i].compare(keys[j]);
+      CHECK((expected < 0) == (actual < 0));
+      CHECK((expected > 0) == (actual > 0));
+    }
+  }
+}
+
+SECTION("tst_ascii_words") {
+  auto& helper = arangodb::basics::Utf8Helper::DefaultUtf8Helper;
+  std::vector<std::string> values = {
+      "Der Mueller geht in die Post.", "THE QUICK brown fox!",
+      "don't stop", "3.14 and 2,5", "foo_bar baz", "a.b:c;d,e",
+      "mail@example.com", "two  spaces", "tab\tand\r\nnewline",
+      "(brackets) [and] {braces} -dash- \"quoted\"", "x1y2z3 42 abc123",
+      "end.", ".start", "ok?!", "averyveryveryverylongword"};
+
+  for (auto const& it : values) {
+    for (size_t minLength = 2; minLength <= 4; ++minLength) {
+      std::vector<std::string> ascii;
+      CHECK(helper.getWords(ascii, it, minLength, 10, true));
+
+      // the non-ASCII suffix is too short to be a word, but forces ICU
+      std::vector<std::string> icu;
+      CHECK(helper.getWords(icu, it + " \xc3\xbc", minLength, 10, true));
+      CHECK(icu == ascii);
+    }
+  }
+}
 }
 
 // Local Variables:
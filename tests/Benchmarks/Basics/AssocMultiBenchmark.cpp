@@ -0,0 +1,138 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief micro-benchmarks for AssocMulti
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+
+#include "../Benchmark.h"
+
+#include "Basics/AssocMulti.h"
+#include "Basics/fasthash.h"
+
+using namespace arangodb::benchmarks;
+
+namespace {
+struct Element {
+  uint64_t key;
+  uint64_t value;
+};
+
+typedef arangodb::basics::AssocMulti<uint64_t, Element*, uint32_t, true>
+    Index;
+
+uint64_t hashKey(void*, uint64_t const* key) {
+  return fasthash64_uint64(*key, 0x12345678);
+}
+
+uint64_t hashElement(void*, Element* const& element, bool byKey) {
+  if (byKey) {
+    return fasthash64_uint64(element->key, 0x12345678);
+  }
+  return fasthash64_uint64(element->value, 0x12345678);
+}
+
+bool isEqualKeyElement(void*, uint64_t const* key, uint64_t,
+                       Element* const& element) {
+  return *key == element->key;
+}
+
+bool isEqualElementElement(void*, Element* const& left,
+                           Element* const& right) {
+  return left->value == right->value;
+}
+
+bool isEqualElementElementByKey(void*, Element* const& left,
+                                Element* const& right) {
+  return left->key == right->key;
+}
+
+/// @brief number of elements, and number of distinct keys among them
+uint64_t const NumElements = 1000000;
+uint64_t const NumKeys = 100000;
+
+std::vector<Element>& elements() {
+  static std::vector<Element> result = []() {
+    std::vector<Element> elements;
+    elements.reserve(NumElements);
+    for (uint64_t i = 0; i < NumElements; ++i) {
+      elements.emplace_back(Element{i % NumKeys, i});
+    }
+    return elements;
+  }();
+  return result;
+}
+
+/// @brief an index filled with all elements, shared by the lookup
+/// benchmarks because building it is expensive
+Index& filledIndex() {
+  static std::unique_ptr<Index> index = []() {
+    std::unique_ptr<Index> index(
+        new Index(hashKey, hashElement, isEqualKeyElement,
+                  isEqualElementElement, isEqualElementElementByKey, 8));
+    for (auto& element : elements()) {
+      index->insert(nullptr, &element, false, false);
+    }
+    return index;
+  }();
+  return *index;
+}
+}
+
+// builds an index of 100000 elements per iteration, including the
+// allocation and destruction of the index
+BENCHMARK("assocmulti/insert-100000") {
+  auto& all = elements();
+  state.startTiming();
+
+  for (uint64_t i = 0; i < state.iterations(); ++i) {
+    Index index(hashKey, hashElement, isEqualKeyElement, isEqualElementElement,
+                isEqualElementElementByKey, 8);
+    for (uint64_t j = 0; j < 100000; ++j) {
+      index.insert(nullptr, &all[j], false, false);
+    }
+  }
+}
+
+BENCHMARK("assocmulti/lookup") {
+  auto& index = filledIndex();
+  auto& all = elements();
+  state.startTiming();
+
+  for (uint64_t i = 0; i < state.iterations(); ++i) {
+    doNotOptimize(index.lookup(nullptr, &all[(i * 7919) % NumElements]));
+  }
+}
+
+BENCHMARK("assocmulti/lookupByKey") {
+  auto& index = filledIndex();
+  std::vector<Element*> result;
+  state.startTiming();
+
+  for (uint64_t i = 0; i < state.iterations(); ++i) {
+    uint64_t const key = (i * 7919) % NumKeys;
+    result.clear();
+    index.lookupByKey(nullptr, &key, result, 100);
+    doNotOptimize(result.size());
+  }
+}
@@ -0,0 +1,193 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief micro-benchmarks for hash functions
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+
+#include "../Benchmark.h"
+
+#include "Basics/fasthash.h"
+#include "Basics/hashes.h"
+#include "Basics/xxhash.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Parser.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb::benchmarks;
+
+namespace {
+/// @brief input data for the hash functions, deterministic
+std::string const& input() {
+  static std::string data = []() {
+    std::string result;
+    for (size_t i = 0; i < 4096; ++i) {
+      result.push_back(static_cast<char>('a' + (i * 7) % 26));
+    }
+    return result;
+  }();
+  return data;
+}
+
+template <typename F>
+void hashLoop(State& state, size_t length, F const& hash) {
+  char const* data = input().data();
+  for (uint64_t i = 0; i < state.iterations(); ++i) {
+    doNotOptimize(hash(data + (i % 64), length));
+  }
+}
+
+/// @brief a document of realistic size and shape, about 400 bytes in
+/// VelocyPack
+std::shared_ptr<VPackBuilder> document() {
+  return VPackParser::fromJson(
+      "{\"_key\":\"12345678\",\"_rev\":\"_UqZ3Kwy---\",\"name\":"
+      "\"John Doe\",\"email\":\"john.doe@example.com\",\"age\":42,"
+      "\"active\":true,\"score\":1234.5678,\"tags\":[\"one\",\"two\","
+      "\"three\",\"four\"],\"address\":{\"street\":\"Main Street 1\","
+      "\"city\":\"Cologne\",\"zip\":\"50667\",\"country\":\"Germany\"},"
+      "\"history\":[{\"date\":\"2017-01-01\",\"value\":1},{\"date\":"
+      "\"2017-02-01\",\"value\":2},{\"date\":\"2017-03-01\",\"value\":3}],"
+      "\"description\":\"Lorem ipsum dolor sit amet, consectetur adipiscing "
+      "elit, sed do eiusmod tempor incididunt ut labore et dolore magna "
+      "aliqua.\"}");
+}
+}
+
+BENCHMARK("hashes/fasthash64/8") {
+  hashLoop(state, 8, [](char const* p, size_t l) {
+    return fasthash64(p, l, 0xdeadbeef);
+  });
+}
+
+BENCHMARK("hashes/fasthash64/64") {
+  hashLoop(state, 64, [](char const* p, size_t l) {
+    return fasthash64(p, l, 0xdeadbeef);
+  });
+}
+
+BENCHMARK("hashes/fasthash64/1024") {
+  hashLoop(state, 1024, [](char const* p, size_t l) {
+    return fasthash64(p, l, 0xdeadbeef);
+  });
+}
+
+BENCHMARK("hashes/fasthash64_uint64") {
+  for (uint64_t i = 0; i < state.iterations(); ++i) {
+    doNotOptimize(fasthash64_uint64(i, 0xdeadbeef));
+  }
+}
+
+BENCHMARK("hashes/xxhash64/8") {
+  hashLoop(state, 8, [](char const* p, size_t l) {
+    return XXH64(p, l, 0xdeadbeef);
+  });
+}
+
+BENCHMARK("hashes/xxhash64/64") {
+  hashLoop(state, 64, [](char const* p, size_t l) {
+    return XXH64(p, l, 0xdeadbeef);
+  });
+}
+
+BENCHMARK("hashes/xxhash64/1024") {
+  hashLoop(state, 1024, [](char const* p, size_t l) {
+    return XXH64(p, l, 0xdeadbeef);
+  });
+}
+
+BENCHMARK("hashes/fnv/64") {
+  hashLoop(state, 64, [](char const* p, size_t l) {
+    return TRI_FnvHashPointer(p, l);
+  });
+}
+
+BENCHMARK("hashes/crc32/64") {
+  hashLoop(state, 64, [](char const* p, size_t l) {
+    return TRI_Crc32HashPointer(p, l);
+  });
+}
+
+// TRI_BlockCrc32 dispatches to the SSE4.2 or ARMv8 instructions if the CPU
+// supports them, the _C variants show the table-driven fallback
+
+BENCHMARK("hashes/crc32/512") {
+  hashLoop(state, 512, [](char const* p, size_t l) {
+    return TRI_BlockCrc32(TRI_InitialCrc32(), p, l);
+  });
+}
+
+BENCHMARK("hashes/crc32/2048") {
+  hashLoop(state, 2048, [](char const* p, size_t l) {
+    return TRI_BlockCrc32(TRI_InitialCrc32(), p, l);
+  });
+}
+
+BENCHMARK("hashes/crc32_C/64") {
+  hashLoop(state, 64, [](char const* p, size_t l) {
+    return TRI_BlockCrc32_C(TRI_InitialCrc32(), p, l);
+  });
+}
+
+BENCHMARK("hashes/crc32_C/512") {
+  hashLoop(state, 512, [](char const* p, size_t l) {
+    return TRI_BlockCrc32_C(TRI_InitialCrc32(), p, l);
+  });
+}
+
+BENCHMARK("hashes/crc32_C/2048") {
+  hashLoop(state, 2048, [](char const* p, size_t l) {
+    return TRI_BlockCrc32_C(TRI_InitialCrc32(), p, l);
+  });
+}
+
+BENCHMARK("hashes/vpack/document") {
+  auto builder = document();
+  VPackSlice const slice = builder->slice();
+  state.startTiming();
+
+  for (uint64_t i = 0; i < state.iterations(); ++i) {
+    doNotOptimize(slice.hash());
+  }
+}
+
+BENCHMARK("hashes/vpack-normalized/document") {
+  auto builder = document();
+  VPackSlice const slice = builder->slice();
+  state.startTiming();
+
+  for (uint64_t i = 0; i < state.iterations(); ++i) {
+    doNotOptimize(slice.normalizedHash());
+  }
+}
+
+BENCHMARK("hashes/xxhash64/document") {
+  auto builder = document();
+  VPackSlice const slice = builder->slice();
+  state.startTiming();
+
+  for (uint64_t i = 0; i < state.iterations(); ++i) {
+    doNotOptimize(XXH64(slice.start(), slice.byteSize(), 0xdeadbeef));
+  }
+}
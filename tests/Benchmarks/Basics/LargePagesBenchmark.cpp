@@ -0,0 +1,164 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+
+#include "../Benchmark.h"
+
+#include "Basics/LargePages.h"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+using namespace arangodb::basics;
+using namespace arangodb::benchmarks;
+
+#ifdef __linux__
+namespace {
+/// @brief much larger than the TLBs can cover with 4 KB pages, which is a
+/// few MB on current CPUs
+size_t const TableSize = 256 * 1024 * 1024;
+
+/// @brief counts the data TLB misses of loads by the calling thread. no
+/// counter is reported where perf events are not permitted, e.g. in many
+/// containers (kernel.perf_event_paranoid)
+class TlbMisses {
+ public:
+  TlbMisses() : _fd(-1) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HW_CACHE;
+    attr.size = sizeof(attr);
+    attr.config = PERF_COUNT_HW_CACHE_DTLB |
+                  (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                  (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+
+    _fd = static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+  }
+
+  ~TlbMisses() {
+    if (_fd >= 0) {
+      close(_fd);
+    }
+  }
+
+  void start() {
+    if (_fd >= 0) {
+      ioctl(_fd, PERF_EVENT_IOC_RESET, 0);
+      ioctl(_fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+  }
+
+  void stop(State& state) {
+    if (_fd < 0) {
+      return;
+    }
+
+    ioctl(_fd, PERF_EVENT_IOC_DISABLE, 0);
+    uint64_t count = 0;
+
+    if (read(_fd, &count, sizeof(count)) == sizeof(count)) {
+      state.setCounter("dTLB load misses", static_cast<double>(count));
+    }
+  }
+
+ private:
+  int _fd;
+};
+
+/// @brief the tables are filled once and kept for all samples
+uint64_t* smallPagesTable() {
+  static uint64_t* table = nullptr;
+
+  if (table == nullptr) {
+    void* memory = mmap(nullptr, TableSize, PROT_READ | PROT_WRITE,
+                        MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    TRI_ASSERT(memory != MAP_FAILED);
+#ifdef MADV_NOHUGEPAGE
+    // with transparent_hugepage=always, the kernel would use huge pages
+    madvise(memory, TableSize, MADV_NOHUGEPAGE);
+#endif
+    table = static_cast<uint64_t*>(memory);
+    memset(table, 1, TableSize);
+  }
+  return table;
+}
+
+uint64_t* largePagesTable(LargePages::Mode mode) {
+  static std::map<LargePages::Mode, uint64_t*> tables;
+  auto it = tables.find(mode);
+
+  if (it == tables.end()) {
+    LargePages::Mode old = LargePages::mode();
+    LargePages::setMode(mode);
+    uint64_t* table = static_cast<uint64_t*>(LargePages::allocate(TableSize));
+    LargePages::setMode(old);
+
+    TRI_ASSERT(table != nullptr);
+    memset(table, 1, TableSize);
+    it = tables.emplace(mode, table).first;
+  }
+  return (*it).second;
+}
+
+/// @brief random lookups as in a hash index: nearly every one touches
+/// another page
+void probe(State& state, uint64_t const* table) {
+  size_t const mask = TableSize / sizeof(uint64_t) - 1;
+  uint64_t x = 0x9e3779b97f4a7c15ULL;
+  uint64_t sum = 0;
+
+  TlbMisses misses;
+  state.startTiming();
+  misses.start();
+
+  for (uint64_t i = 0; i < state.iterations(); ++i) {
+    // xorshift
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    sum += table[x & mask];
+  }
+
+  misses.stop(state);
+  state.stopTiming();
+  doNotOptimize(sum);
+}
+}
+
+BENCHMARK("largepages/probe/small") { probe(state, smallPagesTable()); }
+
+BENCHMARK("largepages/probe/transparent") {
+  probe(state, largePagesTable(LargePages::Mode::TRANSPARENT));
+}
+
+BENCHMARK("largepages/probe/explicit") {
+  probe(state, largePagesTable(LargePages::Mode::EXPLICIT));
+}
+#endif
@@ -0,0 +1,126 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+
+#include "../Benchmark.h"
+
+#include "Basics/ReadMostlyLock.h"
+#include "Basics/ReadWriteLock.h"
+#include "Basics/ReadWriteLockCPP11.h"
+
+#include <thread>
+
+using namespace arangodb::basics;
+using namespace arangodb::benchmarks;
+
+namespace {
+/// @brief every thread read-locks and unlocks iterations() times. the time
+/// per iteration stays flat as threads are added if reads scale
+template <typename LockType>
+void readers(State& state, size_t numThreads) {
+  LockType lock;
+  std::vector<std::thread> threads;
+  std::atomic<size_t> ready(0);
+  std::atomic<bool> go(false);
+
+  for (size_t i = 0; i < numThreads; ++i) {
+    threads.emplace_back([&]() {
+      ++ready;
+      while (!go.load()) {
+        std::this_thread::yield();
+      }
+      for (uint64_t j = 0; j < state.iterations(); ++j) {
+        lock.readLock();
+        lock.unlock();
+      }
+    });
+  }
+
+  while (ready.load() < numThreads) {
+    std::this_thread::yield();
+  }
+
+  state.startTiming();
+  go = true;
+
+  for (auto& it : threads) {
+    it.join();
+  }
+  state.stopTiming();
+}
+
+/// @brief a single write lock, which must wait for all reader counters
+template <typename LockType>
+void writer(State& state) {
+  LockType lock;
+  state.startTiming();
+
+  for (uint64_t i = 0; i < state.iterations(); ++i) {
+    lock.writeLock();
+    lock.unlock();
+  }
+}
+}
+
+BENCHMARK("readwritelock/pthread/read/1") {
+  readers<ReadWriteLock>(state, 1);
+}
+
+BENCHMARK("readwritelock/pthread/read/4") {
+  readers<ReadWriteLock>(state, 4);
+}
+
+BENCHMARK("readwritelock/pthread/read/16") {
+  readers<ReadWriteLock>(state, 16);
+}
+
+BENCHMARK("readwritelock/pthread/write") { writer<ReadWriteLock>(state); }
+
+BENCHMARK("readwritelock/cpp11/read/1") {
+  readers<ReadWriteLockCPP11>(state, 1);
+}
+
+BENCHMARK("readwritelock/cpp11/read/4") {
+  readers<ReadWriteLockCPP11>(state, 4);
+}
+
+BENCHMARK("readwritelock/cpp11/read/16") {
+  readers<ReadWriteLockCPP11>(state, 16);
+}
+
+BENCHMARK("readwritelock/cpp11/write") { writer<ReadWriteLockCPP11>(state); }
+
+BENCHMARK("readwritelock/readmostly/read/1") {
+  readers<ReadMostlyLock>(state, 1);
+}
+
+BENCHMARK("readwritelock/readmostly/read/4") {
+  readers<ReadMostlyLock>(state, 4);
+}
+
+BENCHMARK("readwritelock/readmostly/read/16") {
+  readers<ReadMostlyLock>(state, 16);
+}
+
+BENCHMARK("readwritelock/readmostly/write") {
+  writer<ReadMostlyLock>(state);
+}
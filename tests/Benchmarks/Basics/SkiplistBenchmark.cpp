@@ -0,0 +1,122 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief micro-benchmarks for MMFilesSkiplist
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+
+#include "../Benchmark.h"
+
+#include "MMFiles/MMFilesSkiplist.h"
+
+using namespace arangodb::benchmarks;
+
+namespace {
+typedef arangodb::MMFilesSkiplist<uint64_t, uint64_t> Skiplist;
+
+int cmpElmElm(void*, uint64_t const* left, uint64_t const* right,
+              arangodb::MMFilesSkiplistCmpType) {
+  if (*left != *right) {
+    return *left < *right ? -1 : 1;
+  }
+  return 0;
+}
+
+int cmpKeyElm(void*, uint64_t const* left, uint64_t const* right) {
+  if (*left != *right) {
+    return *left < *right ? -1 : 1;
+  }
+  return 0;
+}
+
+void freeElm(uint64_t*) {}
+
+uint64_t const NumElements = 1000000;
+
+/// @brief the values, in a pseudo-random but reproducible order
+std::vector<uint64_t>& values() {
+  static std::vector<uint64_t> result = []() {
+    std::vector<uint64_t> values;
+    values.reserve(NumElements);
+    for (uint64_t i = 0; i < NumElements; ++i) {
+      // multiplication with a number coprime to NumElements is a
+      // permutation
+      values.emplace_back((i * 7919) % NumElements);
+    }
+    return values;
+  }();
+  return result;
+}
+
+Skiplist& filledSkiplist() {
+  static std::unique_ptr<Skiplist> skiplist = []() {
+    std::unique_ptr<Skiplist> skiplist(
+        new Skiplist(cmpElmElm, cmpKeyElm, freeElm, true, false));
+    for (auto& value : values()) {
+      skiplist->insert(nullptr, &value);
+    }
+    return skiplist;
+  }();
+  return *skiplist;
+}
+}
+
+// builds a skiplist of 100000 elements per iteration, including the
+// allocation and destruction of the skiplist
+BENCHMARK("skiplist/insert-100000") {
+  auto& all = values();
+  state.startTiming();
+
+  for (uint64_t i = 0; i < state.iterations(); ++i) {
+    Skiplist skiplist(cmpElmElm, cmpKeyElm, freeElm, true, false);
+    for (uint64_t j = 0; j < 100000; ++j) {
+      skiplist.insert(nullptr, &all[j]);
+    }
+  }
+}
+
+BENCHMARK("skiplist/lookup") {
+  auto& skiplist = filledSkiplist();
+  auto& all = values();
+  state.startTiming();
+
+  for (uint64_t i = 0; i < state.iterations(); ++i) {
+    doNotOptimize(skiplist.lookup(nullptr, &all[(i * 31) % NumElements]));
+  }
+}
+
+BENCHMARK("skiplist/range-100") {
+  auto& skiplist = filledSkiplist();
+  state.startTiming();
+
+  for (uint64_t i = 0; i < state.iterations(); ++i) {
+    uint64_t const key = (i * 31) % (NumElements - 100);
+    auto node = skiplist.leftKeyLookup(nullptr, &key)->nextNode();
+    uint64_t sum = 0;
+    for (size_t j = 0; j < 100 && node != nullptr; ++j) {
+      sum += *node->document();
+      node = node->nextNode();
+    }
+    doNotOptimize(sum);
+  }
+}
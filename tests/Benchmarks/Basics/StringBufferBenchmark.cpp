@@ -0,0 +1,85 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief micro-benchmarks for StringBuffer
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+
+#include "../Benchmark.h"
+
+#include "Basics/StringBuffer.h"
+
+using namespace arangodb::basics;
+using namespace arangodb::benchmarks;
+
+BENCHMARK("stringbuffer/appendText") {
+  StringBuffer buffer(TRI_UNKNOWN_MEM_ZONE, 1024, false);
+  state.startTiming();
+
+  for (uint64_t i = 0; i < state.iterations(); ++i) {
+    if (buffer.length() > 1024 * 1024) {
+      buffer.reset();
+    }
+    buffer.appendText("the quick brown fox jumps over the lazy dog", 43);
+  }
+  doNotOptimize(buffer.length());
+}
+
+BENCHMARK("stringbuffer/appendInteger") {
+  StringBuffer buffer(TRI_UNKNOWN_MEM_ZONE, 1024, false);
+  state.startTiming();
+
+  for (uint64_t i = 0; i < state.iterations(); ++i) {
+    if (buffer.length() > 1024 * 1024) {
+      buffer.reset();
+    }
+    buffer.appendInteger(static_cast<uint64_t>(i * 2654435761ULL));
+  }
+  doNotOptimize(buffer.length());
+}
+
+BENCHMARK("stringbuffer/appendJsonEncoded") {
+  StringBuffer buffer(TRI_UNKNOWN_MEM_ZONE, 1024, false);
+  char const* value = "some \"quoted\" text with a\ttab and\na newline";
+  size_t const length = strlen(value);
+  state.startTiming();
+
+  for (uint64_t i = 0; i < state.iterations(); ++i) {
+    if (buffer.length() > 1024 * 1024) {
+      buffer.reset();
+    }
+    buffer.appendJsonEncoded(value, length);
+  }
+  doNotOptimize(buffer.length());
+}
+
+BENCHMARK("stringbuffer/grow") {
+  for (uint64_t i = 0; i < state.iterations(); ++i) {
+    // start small so that the buffer has to be reallocated repeatedly
+    StringBuffer buffer(TRI_UNKNOWN_MEM_ZONE, 16, false);
+    for (size_t j = 0; j < 64; ++j) {
+      buffer.appendText("0123456789abcdef", 16);
+    }
+    doNotOptimize(buffer.length());
+  }
+}
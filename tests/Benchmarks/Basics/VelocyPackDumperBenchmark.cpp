@@ -0,0 +1,113 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief micro-benchmarks for VelocyPackDumper
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+
+#include "../Benchmark.h"
+
+#include "Basics/StringBuffer.h"
+#include "Basics/VelocyPackDumper.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Dumper.h>
+#include <velocypack/Sink.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb::basics;
+using namespace arangodb::benchmarks;
+
+namespace {
+/// @brief an array of documents similar to a cursor result
+VPackBuilder makeDocuments(char const* text) {
+  VPackBuilder builder;
+  builder.openArray();
+
+  for (size_t i = 0; i < 1000; ++i) {
+    std::string const key = "document-" + std::to_string(i);
+    builder.openObject();
+    builder.add("_key", VPackValue(key));
+    builder.add("_id", VPackValue("products/" + key));
+    builder.add("_rev", VPackValue("_VdT8Zy2---"));
+    builder.add("value", VPackValue(i));
+    builder.add("price", VPackValue(i * 0.25));
+    builder.add("active", VPackValue(i % 2 == 0));
+    builder.add("text", VPackValue(text));
+    builder.close();
+  }
+
+  builder.close();
+  return builder;
+}
+
+void dumpLoop(State& state, char const* text) {
+  VPackBuilder documents = makeDocuments(text);
+  VPackSlice const slice = documents.slice();
+  StringBuffer buffer(TRI_UNKNOWN_MEM_ZONE);
+  state.startTiming();
+
+  for (uint64_t i = 0; i < state.iterations(); ++i) {
+    buffer.clear();
+    VelocyPackDumper dumper(&buffer);
+    dumper.dumpValue(slice);
+    doNotOptimize(buffer.length());
+  }
+}
+
+/// @brief the velocypack library's dumper, as a reference
+void vpackDumpLoop(State& state, char const* text) {
+  VPackBuilder documents = makeDocuments(text);
+  VPackSlice const slice = documents.slice();
+  std::string result;
+  state.startTiming();
+
+  for (uint64_t i = 0; i < state.iterations(); ++i) {
+    result.clear();
+    VPackStringSink sink(&result);
+    VPackDumper::dump(slice, &sink);
+    doNotOptimize(result.size());
+  }
+}
+
+char const* const PlainText =
+    "The quick brown fox jumps over the lazy dog, again and again and again";
+char const* const EscapedText =
+    "line one\nline two\n\"quoted\" and a back\\slash, path/to/file";
+char const* const Utf8Text =
+    "Grüße aus Köln, näher am Dom als am Rhein, € 12,50 für zwei Kölsch";
+}
+
+BENCHMARK("vpackdumper/documents/plain") { dumpLoop(state, PlainText); }
+
+BENCHMARK("vpackdumper/documents/escaped") { dumpLoop(state, EscapedText); }
+
+BENCHMARK("vpackdumper/documents/utf8") { dumpLoop(state, Utf8Text); }
+
+BENCHMARK("vpackdumper/library/plain") { vpackDumpLoop(state, PlainText); }
+
+BENCHMARK("vpackdumper/library/escaped") {
+  vpackDumpLoop(state, EscapedText);
+}
+
+BENCHMARK("vpackdumper/library/utf8") { vpackDumpLoop(state, Utf8Text); }
@@ -0,0 +1,102 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief micro-benchmarks for VelocyPackHelper
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+
+#include "../Benchmark.h"
+
+#include "Basics/VelocyPackHelper.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Parser.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb::basics;
+using namespace arangodb::benchmarks;
+
+namespace {
+std::shared_ptr<VPackBuilder> parse(char const* json) {
+  return VPackParser::fromJson(json);
+}
+
+void compareLoop(State& state, char const* left, char const* right,
+                 bool useUTF8) {
+  auto l = parse(left);
+  auto r = parse(right);
+  VPackSlice const ls = l->slice();
+  VPackSlice const rs = r->slice();
+  state.startTiming();
+
+  for (uint64_t i = 0; i < state.iterations(); ++i) {
+    doNotOptimize(VelocyPackHelper::compare(ls, rs, useUTF8));
+  }
+}
+}
+
+BENCHMARK("vpackhelper/compare/int") {
+  compareLoop(state, "12345", "12346", true);
+}
+
+BENCHMARK("vpackhelper/compare/smallint-int") {
+  compareLoop(state, "5", "12346", true);
+}
+
+BENCHMARK("vpackhelper/compare/double-int") {
+  compareLoop(state, "12345.5", "12346", true);
+}
+
+BENCHMARK("vpackhelper/compare/string-binary") {
+  compareLoop(state, "\"some-document-key-00001\"",
+              "\"some-document-key-00002\"", false);
+}
+
+BENCHMARK("vpackhelper/compare/string-utf8") {
+  compareLoop(state, "\"some-document-key-00001\"",
+              "\"some-document-key-00002\"", true);
+}
+
+BENCHMARK("vpackhelper/compare/string-utf8-equal") {
+  compareLoop(state, "\"some-document-key-00001\"",
+              "\"some-document-key-00001\"", true);
+}
+
+BENCHMARK("vpackhelper/compare/array") {
+  compareLoop(state, "[1, 2, 3, \"foo\", null, true]",
+              "[1, 2, 3, \"foo\", null, false]", true);
+}
+
+BENCHMARK("vpackhelper/compare/object") {
+  compareLoop(state,
+              "{\"a\": 1, \"b\": \"two\", \"c\": [3], \"d\": {\"e\": 4}}",
+              "{\"a\": 1, \"b\": \"two\", \"c\": [3], \"d\": {\"e\": 5}}",
+              true);
+}
+
+BENCHMARK("vpackhelper/compare/object-equal") {
+  compareLoop(state,
+              "{\"a\": 1, \"b\": \"two\", \"c\": [3], \"d\": {\"e\": 4}}",
+              "{\"a\": 1, \"b\": \"two\", \"c\": [3], \"d\": {\"e\": 4}}",
+              true);
+}
@@ -0,0 +1,175 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief micro-benchmark harness
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Benchmark.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+
+using namespace arangodb::benchmarks;
+
+namespace {
+struct Entry {
+  std::string name;
+  BenchmarkFunction function;
+};
+
+/// @brief the registered benchmarks. function-local so that registration
+/// from static initializers in other translation units is safe
+std::vector<Entry>& registry() {
+  static std::vector<Entry> benchmarks;
+  return benchmarks;
+}
+
+/// @brief run a benchmark once, returns the time per iteration in ns. the
+/// counters per iteration are appended to counters if given
+double runSample(BenchmarkFunction function, uint64_t iterations,
+                 std::map<std::string, std::vector<double>>* counters =
+                     nullptr) {
+  State state(iterations);
+  function(state);
+
+  if (counters != nullptr) {
+    for (auto const& it : state.counters()) {
+      (*counters)[it.first].emplace_back(it.second /
+                                         static_cast<double>(iterations));
+    }
+  }
+  return state.elapsed() / static_cast<double>(iterations);
+}
+
+/// @brief find the number of iterations for which one sample takes at least
+/// minSampleTime nanoseconds, so that timer resolution and call overhead
+/// do not distort the measurements
+uint64_t calibrate(BenchmarkFunction function, double minSampleTime) {
+  uint64_t iterations = 1;
+
+  while (true) {
+    double total = runSample(function, iterations) *
+                   static_cast<double>(iterations);
+
+    if (total >= minSampleTime) {
+      return iterations;
+    }
+
+    // grow quickly while far away from the target, then approach it
+    double factor = (total <= 0.0) ? 10.0 : (minSampleTime * 1.2) / total;
+    factor = (std::min)((std::max)(factor, 1.5), 10.0);
+    iterations = static_cast<uint64_t>(std::ceil(iterations * factor));
+  }
+}
+
+double median(std::vector<double> values) {
+  TRI_ASSERT(!values.empty());
+  std::sort(values.begin(), values.end());
+  size_t const n = values.size();
+
+  if (n % 2 == 1) {
+    return values[n / 2];
+  }
+  return (values[n / 2 - 1] + values[n / 2]) / 2.0;
+}
+}
+
+Registrar::Registrar(char const* name, BenchmarkFunction function) {
+  registry().emplace_back(Entry{name, function});
+}
+
+void arangodb::benchmarks::listBenchmarks() {
+  for (auto const& entry : registry()) {
+    std::cout << entry.name << std::endl;
+  }
+}
+
+size_t arangodb::benchmarks::runBenchmarks(std::string const& filter,
+                                           size_t samples,
+                                           double minSampleTime) {
+  TRI_ASSERT(samples > 0);
+
+  std::cout << std::left << std::setw(40) << "benchmark" << std::right
+            << std::setw(12) << "iterations" << std::setw(12) << "min ns"
+            << std::setw(12) << "median ns" << std::setw(12) << "mean ns"
+            << std::setw(10) << "mad %" << std::endl;
+
+  size_t count = 0;
+
+  for (auto const& entry : registry()) {
+    if (!filter.empty() && entry.name.find(filter) == std::string::npos) {
+      continue;
+    }
+    ++count;
+
+    uint64_t const iterations = calibrate(entry.function, minSampleTime);
+
+    // one untimed sample to warm up caches and the allocator
+    runSample(entry.function, iterations);
+
+    std::vector<double> times;
+    times.reserve(samples);
+    std::map<std::string, std::vector<double>> counters;
+
+    for (size_t i = 0; i < samples; ++i) {
+      times.emplace_back(runSample(entry.function, iterations, &counters));
+    }
+
+    double const med = median(times);
+    double mean = 0.0;
+
+    for (auto const& t : times) {
+      mean += t;
+    }
+    mean /= static_cast<double>(times.size());
+
+    // the median absolute deviation is robust against outliers caused by
+    // scheduling noise, in contrast to the standard deviation
+    std::vector<double> deviations;
+    deviations.reserve(times.size());
+
+    for (auto const& t : times) {
+      deviations.emplace_back(std::abs(t - med));
+    }
+
+    double const mad = median(deviations);
+
+    std::cout << std::left << std::setw(40) << entry.name << std::right
+              << std::setw(12) << iterations << std::fixed
+              << std::setprecision(2) << std::setw(12)
+              << *std::min_element(times.begin(), times.end())
+              << std::setw(12) << med << std::setw(12) << mean
+              << std::setw(10) << (med > 0.0 ? 100.0 * mad / med : 0.0)
+              << std::endl;
+
+    // counters are printed in the median column
+    for (auto const& it : counters) {
+      std::cout << std::left << std::setw(40)
+                << ("  " + it.first + " / iteration") << std::right
+                << std::setw(36) << median(it.second) << std::endl;
+    }
+  }
+
+  return count;
+}
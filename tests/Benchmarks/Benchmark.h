@@ -0,0 +1,125 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief micro-benchmark harness
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGODB_TESTS_BENCHMARKS_BENCHMARK_H
+#define ARANGODB_TESTS_BENCHMARKS_BENCHMARK_H 1
+
+#include "Basics/Common.h"
+
+#include <chrono>
+#include <map>
+
+namespace arangodb {
+namespace benchmarks {
+
+/// @brief state handed to a benchmark function. the function must execute
+/// the measured operation iterations() times. everything the function does
+/// before calling startTiming() (e.g. building the data structure to
+/// operate on) is not measured
+class State {
+ public:
+  explicit State(uint64_t iterations)
+      : _iterations(iterations),
+        _start(std::chrono::steady_clock::now()),
+        _stop(),
+        _stopped(false) {}
+
+  uint64_t iterations() const { return _iterations; }
+
+  void startTiming() { _start = std::chrono::steady_clock::now(); }
+
+  void stopTiming() {
+    _stop = std::chrono::steady_clock::now();
+    _stopped = true;
+  }
+
+  /// @brief the measured time in nanoseconds
+  double elapsed() {
+    if (!_stopped) {
+      stopTiming();
+    }
+    return static_cast<double>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(_stop - _start)
+            .count());
+  }
+
+  /// @brief report a count besides the time, e.g. of a hardware event
+  /// during the measured part. it is printed per iteration
+  void setCounter(std::string const& name, double value) {
+    _counters[name] = value;
+  }
+
+  std::map<std::string, double> const& counters() const { return _counters; }
+
+ private:
+  uint64_t const _iterations;
+  std::chrono::steady_clock::time_point _start;
+  std::chrono::steady_clock::time_point _stop;
+  bool _stopped;
+  std::map<std::string, double> _counters;
+};
+
+typedef void (*BenchmarkFunction)(State&);
+
+/// @brief register a benchmark, used via the BENCHMARK macro
+struct Registrar {
+  Registrar(char const* name, BenchmarkFunction function);
+};
+
+/// @brief keep the compiler from optimizing away a computed value
+template <typename T>
+inline void doNotOptimize(T const& value) {
+#ifdef _MSC_VER
+  static char const volatile* sink;
+  sink = reinterpret_cast<char const volatile*>(&value);
+#else
+  asm volatile("" : : "r,m"(value) : "memory");
+#endif
+}
+
+/// @brief run all benchmarks whose name contains filter. returns the
+/// number of benchmarks run
+size_t runBenchmarks(std::string const& filter, size_t samples,
+                     double minSampleTime);
+
+/// @brief print the names of all benchmarks
+void listBenchmarks();
+}
+}
+
+#define BENCHMARK_CONCAT_(a, b) a##b
+#define BENCHMARK_CONCAT(a, b) BENCHMARK_CONCAT_(a, b)
+
+/// @brief define and register a benchmark function
+#define BENCHMARK(name)                                                      \
+  static void BENCHMARK_CONCAT(benchmark_, __LINE__)(                        \
+      arangodb::benchmarks::State&);                                         \
+  static arangodb::benchmarks::Registrar BENCHMARK_CONCAT(registrar_,        \
+                                                          __LINE__)(         \
+      name, &BENCHMARK_CONCAT(benchmark_, __LINE__));                        \
+  static void BENCHMARK_CONCAT(benchmark_, __LINE__)(                        \
+      arangodb::benchmarks::State & state)
+
+#endif
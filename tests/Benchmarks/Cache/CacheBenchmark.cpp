@@ -0,0 +1,133 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief micro-benchmarks for the in-memory caches
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+
+#include "../Benchmark.h"
+
+#include "Cache/Common.h"
+#include "Cache/Manager.h"
+#include "Cache/PlainCache.h"
+#include "Cache/Transaction.h"
+#include "Cache/TransactionalCache.h"
+
+using namespace arangodb::benchmarks;
+using namespace arangodb::cache;
+
+namespace {
+uint64_t const CacheLimit = 16 * 1024 * 1024;
+uint64_t const NumKeys = 64 * 1024;
+
+Manager& manager() {
+  static Manager manager(nullptr, 4 * CacheLimit);
+  return manager;
+}
+
+void fill(Cache* cache) {
+  for (uint64_t i = 0; i < NumKeys; ++i) {
+    CachedValue* value =
+        CachedValue::construct(&i, sizeof(uint64_t), &i, sizeof(uint64_t));
+    if (!cache->insert(value)) {
+      delete value;
+    }
+  }
+}
+
+/// @brief a cache filled with NumKeys entries, shared by the find
+/// benchmarks
+std::shared_ptr<Cache> filledCache(CacheType type) {
+  static std::shared_ptr<Cache> plain;
+  static std::shared_ptr<Cache> transactional;
+
+  auto& cache = (type == CacheType::Plain) ? plain : transactional;
+
+  if (cache == nullptr) {
+    cache = manager().createCache(type, false, CacheLimit);
+    fill(cache.get());
+  }
+  return cache;
+}
+
+void findLoop(arangodb::benchmarks::State& state, CacheType type) {
+  auto cache = filledCache(type);
+  state.startTiming();
+
+  for (uint64_t i = 0; i < state.iterations(); ++i) {
+    uint64_t const key = (i * 7919) % NumKeys;
+    auto finding = cache->find(&key, sizeof(uint64_t));
+    doNotOptimize(finding.found());
+  }
+}
+
+void insertLoop(arangodb::benchmarks::State& state, CacheType type) {
+  auto cache = manager().createCache(type, false, CacheLimit);
+  state.startTiming();
+
+  for (uint64_t i = 0; i < state.iterations(); ++i) {
+    uint64_t const key = i % NumKeys;
+    CachedValue* value = CachedValue::construct(&key, sizeof(uint64_t), &i,
+                                                sizeof(uint64_t));
+    if (!cache->insert(value)) {
+      delete value;
+    }
+  }
+
+  state.stopTiming();
+  manager().destroyCache(cache);
+}
+}
+
+BENCHMARK("cache/plain/find") { findLoop(state, CacheType::Plain); }
+
+BENCHMARK("cache/plain/insert") { insertLoop(state, CacheType::Plain); }
+
+BENCHMARK("cache/transactional/find") {
+  findLoop(state, CacheType::Transactional);
+}
+
+BENCHMARK("cache/transactional/insert") {
+  Transaction* tx = manager().beginTransaction(false);
+  insertLoop(state, CacheType::Transactional);
+  manager().endTransaction(tx);
+}
+
+// a write transaction blacklisting one key, as done for every document
+// modification
+BENCHMARK("cache/transactional/blacklist") {
+  auto cache = manager().createCache(CacheType::Transactional, false,
+                                     CacheLimit);
+  fill(cache.get());
+  state.startTiming();
+
+  for (uint64_t i = 0; i < state.iterations(); ++i) {
+    Transaction* tx = manager().beginTransaction(false);
+    uint64_t const key = (i * 7919) % NumKeys;
+    doNotOptimize(cache->blacklist(&key, sizeof(uint64_t)));
+    manager().endTransaction(tx);
+  }
+
+  state.stopTiming();
+  manager().destroyCache(cache);
+}
@@ -0,0 +1,167 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief micro-benchmarks for the Pregel incoming message caches
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+
+#include "../Benchmark.h"
+
+#include "Pregel/IncomingCache.h"
+#include "Pregel/MessageCombiner.h"
+#include "Pregel/MessageFormat.h"
+#include "Pregel/Utils.h"
+#include "Pregel/WorkerConfig.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/velocypack-aliases.h>
+
+#include <thread>
+
+using namespace arangodb::benchmarks;
+using namespace arangodb::pregel;
+
+namespace {
+size_t const NumThreads = 4;
+size_t const NumKeys = 16 * 1024;
+PregelShard const NumShards = 2;
+
+/// @brief a worker config with two local vertex shards
+WorkerConfig& config() {
+  static std::unique_ptr<WorkerConfig> config;
+
+  if (config == nullptr) {
+    VPackBuilder params;
+    params.openObject();
+    params.add(Utils::coordinatorIdKey, VPackValue("CRDN-1"));
+    params.add(Utils::executionNumberKey, VPackValue(1));
+    params.add(Utils::asyncModeKey, VPackValue(false));
+    params.add(Utils::lazyLoadingKey, VPackValue(false));
+    params.add(Utils::vertexShardsKey, VPackValue(VPackValueType::Object));
+    params.add("v", VPackValue(VPackValueType::Array));
+    params.add(VPackValue("s1"));
+    params.add(VPackValue("s2"));
+    params.close();
+    params.close();
+    params.add(Utils::edgeShardsKey, VPackValue(VPackValueType::Object));
+    params.add("e", VPackValue(VPackValueType::Array));
+    params.add(VPackValue("s3"));
+    params.add(VPackValue("s4"));
+    params.close();
+    params.close();
+    params.add(Utils::collectionPlanIdMapKey,
+               VPackValue(VPackValueType::Object));
+    params.add("v", VPackValue("1"));
+    params.add("e", VPackValue("2"));
+    params.close();
+    params.add(Utils::globalShardListKey, VPackValue(VPackValueType::Array));
+    params.add(VPackValue("s1"));
+    params.add(VPackValue("s2"));
+    params.add(VPackValue("s3"));
+    params.add(VPackValue("s4"));
+    params.close();
+    params.add(Utils::userParametersKey, VPackValue(VPackValueType::Object));
+    params.close();
+    params.close();
+
+    config.reset(new WorkerConfig(nullptr, params.slice()));
+  }
+  return *config;
+}
+
+std::vector<PregelKey> const& keys() {
+  static std::vector<PregelKey> keys;
+
+  if (keys.empty()) {
+    for (size_t i = 0; i < NumKeys; ++i) {
+      keys.emplace_back("vertex" + std::to_string(i));
+    }
+  }
+  return keys;
+}
+
+/// @brief each thread stores its share of the messages. messages for the
+/// same vertex are combined
+template <typename F>
+void runThreads(arangodb::benchmarks::State& state, F const& store) {
+  std::vector<std::thread> threads;
+  uint64_t const perThread = state.iterations() / NumThreads + 1;
+
+  for (size_t t = 0; t < NumThreads; ++t) {
+    threads.emplace_back([&store, t, perThread]() {
+      auto const& k = keys();
+      for (uint64_t i = 0; i < perThread; ++i) {
+        uint64_t const n = (i * 7919 + t) % NumKeys;
+        store(t, static_cast<PregelShard>(n % NumShards), k[n]);
+      }
+    });
+  }
+
+  for (auto& it : threads) {
+    it.join();
+  }
+}
+}
+
+// all threads store into the shared cache, which locks the shard's bucket
+// for every message
+BENCHMARK("pregel/incache/shared") {
+  NumberMessageFormat<float> format;
+  SumCombiner<float> combiner;
+  CombiningInCache<float> shared(&config(), &format, &combiner);
+  keys();
+  state.startTiming();
+
+  runThreads(state, [&shared](size_t, PregelShard shard, PregelKey const& key) {
+    shared.storeMessage(shard, key, 1.0f);
+  });
+
+  state.stopTiming();
+  doNotOptimize(shared.containedMessageCount());
+}
+
+// every thread stores into its own cache without locking, the thread caches
+// are combined into the shared cache afterwards, like the worker does
+BENCHMARK("pregel/incache/thread-local") {
+  NumberMessageFormat<float> format;
+  SumCombiner<float> combiner;
+  CombiningInCache<float> shared(&config(), &format, &combiner);
+  std::vector<std::unique_ptr<CombiningInCache<float>>> local;
+  for (size_t t = 0; t < NumThreads; ++t) {
+    local.emplace_back(
+        new CombiningInCache<float>(nullptr, &format, &combiner));
+  }
+  keys();
+  state.startTiming();
+
+  runThreads(state, [&local](size_t t, PregelShard shard, PregelKey const& key) {
+    local[t]->storeMessageNoLock(shard, key, 1.0f);
+  });
+
+  for (auto const& it : local) {
+    shared.mergeCache(config(), it.get());
+  }
+
+  state.stopTiming();
+  doNotOptimize(shared.containedMessageCount());
+}
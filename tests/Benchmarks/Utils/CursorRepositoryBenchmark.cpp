@@ -0,0 +1,113 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief micro-benchmarks for the cursor repository
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+
+#include "../Benchmark.h"
+
+#include "Utils/Cursor.h"
+#include "Utils/CursorRepository.h"
+#include "VocBase/ticks.h"
+
+#include <thread>
+
+using namespace arangodb;
+using namespace arangodb::benchmarks;
+
+namespace {
+/// @brief a cursor without results, so that only the registration is
+/// measured
+class EmptyCursor final : public Cursor {
+ public:
+  explicit EmptyCursor(CursorId id) : Cursor(id, 1, nullptr, 30.0, false) {}
+
+  CursorType type() const override { return CURSOR_VPACK; }
+
+  bool hasNext() override { return false; }
+
+  arangodb::velocypack::Slice next() override {
+    return arangodb::velocypack::Slice();
+  }
+
+  size_t count() const override { return 0; }
+
+  void dump(VPackBuilder&) override {}
+
+  std::shared_ptr<transaction::Context> context() const override {
+    return nullptr;
+  }
+};
+
+/// @brief every thread goes through the life cycle of a cursor with a
+/// single follow-up request iterations() times: register the cursor,
+/// return it, look it up again and remove it. the time per iteration stays
+/// flat as threads are added if the repository does not serialize them
+void lifecycle(State& state, size_t numThreads) {
+  CursorRepository repository(nullptr);
+  std::vector<std::thread> threads;
+  std::atomic<size_t> ready(0);
+  std::atomic<bool> go(false);
+
+  for (size_t i = 0; i < numThreads; ++i) {
+    threads.emplace_back([&]() {
+      ++ready;
+      while (!go.load()) {
+        std::this_thread::yield();
+      }
+      bool busy;
+      for (uint64_t j = 0; j < state.iterations(); ++j) {
+        CursorId const id = TRI_NewTickServer();
+        Cursor* cursor = new EmptyCursor(id);
+        cursor->use();
+        repository.insert(cursor);
+        repository.release(cursor);
+
+        cursor = repository.find(id, Cursor::CURSOR_VPACK, busy);
+        TRI_ASSERT(cursor != nullptr);
+        repository.release(cursor);
+        repository.remove(id, Cursor::CURSOR_VPACK);
+      }
+    });
+  }
+
+  while (ready.load() < numThreads) {
+    std::this_thread::yield();
+  }
+
+  state.startTiming();
+  go = true;
+
+  for (auto& it : threads) {
+    it.join();
+  }
+  state.stopTiming();
+}
+}
+
+BENCHMARK("cursorrepository/lifecycle/1") { lifecycle(state, 1); }
+
+BENCHMARK("cursorrepository/lifecycle/4") { lifecycle(state, 4); }
+
+BENCHMARK("cursorrepository/lifecycle/16") { lifecycle(state, 16); }
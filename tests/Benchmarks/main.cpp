@@ -0,0 +1,74 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief micro-benchmark runner
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+
+#include "Benchmark.h"
+#include "Random/RandomGenerator.h"
+
+#include "../Basics/icu-helper.h"
+
+#include <iostream>
+
+static void usage(char const* name) {
+  std::cerr << "usage: " << name << " [--list] [--filter <substring>] "
+            << "[--samples <n>] [--min-time <milliseconds>]" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+  std::string filter;
+  size_t samples = 20;
+  double minTime = 10.0;
+
+  for (int i = 1; i < argc; ++i) {
+    std::string const arg(argv[i]);
+
+    if (arg == "--list") {
+      arangodb::benchmarks::listBenchmarks();
+      return EXIT_SUCCESS;
+    } else if (arg == "--filter" && i + 1 < argc) {
+      filter = argv[++i];
+    } else if (arg == "--samples" && i + 1 < argc) {
+      samples = static_cast<size_t>(std::max(1, std::atoi(argv[++i])));
+    } else if (arg == "--min-time" && i + 1 < argc) {
+      minTime = std::max(0.001, std::atof(argv[++i]));
+    } else {
+      usage(argv[0]);
+      return EXIT_FAILURE;
+    }
+  }
+
+  arangodb::RandomGenerator::initialize(
+      arangodb::RandomGenerator::RandomType::MERSENNE);
+  IcuInitializer::setup("./3rdParty/V8/v8/third_party/icu/common/icudtl.dat");
+
+  if (arangodb::benchmarks::runBenchmarks(filter, samples, minTime * 1.0e6) ==
+      0) {
+    std::cerr << "no benchmark matches '" << filter << "'" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
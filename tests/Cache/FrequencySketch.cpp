@@ -0,0 +1,84 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite for arangodb::cache::FrequencySketch
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Cache/FrequencySketch.h"
+#include "Basics/Common.h"
+
+#include "catch.hpp"
+
+#include <stdint.h>
+
+using namespace arangodb::cache;
+
+TEST_CASE("cache::FrequencySketch", "[cache]") {
+  SECTION("test width is rounded to a power of two") {
+    FrequencySketch sketch(1000);
+    REQUIRE(sketch.memoryUsage() == FrequencySketch::allocationSize(1024));
+    REQUIRE(FrequencySketch::allocationSize(1000) ==
+            FrequencySketch::allocationSize(1024));
+    REQUIRE(FrequencySketch::allocationSize(1) ==
+            FrequencySketch::allocationSize(64));
+  }
+
+  SECTION("test estimates follow recorded accesses") {
+    FrequencySketch sketch(1024);
+
+    REQUIRE(0 == sketch.estimate(1));
+    for (size_t i = 0; i < 5; i++) {
+      sketch.insertRecord(1);
+    }
+    sketch.insertRecord(2);
+
+    REQUIRE(5 <= sketch.estimate(1));
+    REQUIRE(1 <= sketch.estimate(2));
+    REQUIRE(sketch.estimate(2) < sketch.estimate(1));
+
+    // counters saturate
+    for (size_t i = 0; i < 100; i++) {
+      sketch.insertRecord(1);
+    }
+    REQUIRE(15 == sketch.estimate(1));
+
+    sketch.clear();
+    REQUIRE(0 == sketch.estimate(1));
+    REQUIRE(0 == sketch.estimate(2));
+  }
+
+  SECTION("test old accesses are aged out") {
+    FrequencySketch sketch(64);
+
+    for (size_t i = 0; i < 15; i++) {
+      sketch.insertRecord(1);
+    }
+    REQUIRE(15 == sketch.estimate(1));
+
+    // 10 * width records trigger a halving of all counters, later ones only
+    // need half as many
+    for (uint32_t i = 0; i < 2 * 10 * 64; i++) {
+      sketch.insertRecord(1000 + (i % 2));
+    }
+    REQUIRE(sketch.estimate(1) < 15);
+  }
+}
@@ -346,4 +346,63 @@ TEST_CASE("cache::PlainCache", "[cache][!hide][longRunning]") {
     manager.destroyCache(cacheMiss);
     manager.destroyCache(cacheMixed);
   }
+
+  SECTION("test admission filter protects hot set from scans") {
+    uint64_t cacheLimit = 256 * 1024;
+    Manager manager(nullptr, 4 * cacheLimit);
+    auto cacheLru = manager.createCache(CacheType::Plain, false, cacheLimit);
+    auto cacheLfu =
+        manager.createCache(CacheType::Plain, false, cacheLimit, true);
+
+    // skewed workload: a small hot set is read over and over, interleaved
+    // with scans over keys which are each read exactly once
+    uint64_t hotKeys = 256;
+    uint64_t scanKeys = 4096;
+    uint64_t rounds = 16;
+    auto run = [&](std::shared_ptr<Cache> cache) -> uint64_t {
+      uint64_t hits = 0;
+      uint64_t scanKey = hotKeys;
+      auto access = [&](uint64_t key) -> bool {
+        auto f = cache->find(&key, sizeof(uint64_t));
+        if (f.found()) {
+          return true;
+        }
+        CachedValue* value = CachedValue::construct(&key, sizeof(uint64_t),
+                                                    &key, sizeof(uint64_t));
+        if (!cache->insert(value)) {
+          delete value;
+        }
+        return false;
+      };
+
+      for (uint64_t r = 0; r < rounds; r++) {
+        for (uint64_t repeat = 0; repeat < 2; repeat++) {
+          for (uint64_t i = 0; i < hotKeys; i++) {
+            if (access(i) && r > 0) {
+              hits++;
+            }
+          }
+        }
+        for (uint64_t i = 0; i < scanKeys; i++) {
+          access(scanKey++);
+        }
+      }
+      return hits;
+    };
+
+    uint64_t lruHits = run(cacheLru);
+    uint64_t lfuHits = run(cacheLfu);
+    uint64_t hotFinds = (rounds - 1) * 2 * hotKeys;
+    double lruRate = 100 * (static_cast<double>(lruHits) /
+                            static_cast<double>(hotFinds));
+    double lfuRate = 100 * (static_cast<double>(lfuHits) /
+                            static_cast<double>(hotFinds));
+    // the scans evict the hot set from the LRU cache, while the admission
+    // filter keeps most of it
+    REQUIRE(lfuRate > lruRate);
+    REQUIRE(lfuRate >= 80.0);
+
+    manager.destroyCache(cacheLru);
+    manager.destroyCache(cacheLfu);
+  }
 }
@@ -0,0 +1,114 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+
+#include "catch.hpp"
+
+#include "Cluster/ClusterInfo.h"
+
+using namespace arangodb;
+
+typedef ClusterInfo::RoutingTable RoutingTable;
+typedef std::unordered_map<CollectionID,
+                           std::shared_ptr<std::vector<std::string>>>
+    PlanMap;
+
+static std::shared_ptr<std::vector<std::string>> strings(
+    std::vector<std::string> const& values) {
+  return std::make_shared<std::vector<std::string>>(values);
+}
+
+static RoutingTable emptyTable() {
+  RoutingTable table;
+  table.planVersion = 0;
+  table.currentVersion = 0;
+  table.collections = std::make_shared<RoutingTable::CollectionMap const>();
+  table.shardServers = std::make_shared<RoutingTable::ShardServerMap const>();
+  return table;
+}
+
+TEST_CASE("ClusterInfoTest", "[cluster]") {
+  RoutingTable const empty = emptyTable();
+
+SECTION("test_routing_table_from_plan") {
+  PlanMap shards{{"1", strings({"s1", "s2"})}, {"2", strings({"s3"})}};
+  PlanMap shardKeys{{"1", strings({"_key"})}, {"2", strings({"a", "b"})}};
+
+  auto table = empty.withPlan(5, shards, shardKeys);
+  CHECK(table->planVersion == 5);
+  CHECK(table->currentVersion == 0);
+  REQUIRE(table->collections->size() == 2);
+
+  auto const& first = table->collections->at("1");
+  CHECK(first.shards == shards["1"]);
+  CHECK(first.usesDefaultShardingAttributes);
+
+  auto const& second = table->collections->at("2");
+  CHECK(*second.shardKeys == (std::vector<std::string>{"a", "b"}));
+  CHECK(!second.usesDefaultShardingAttributes);
+}
+
+SECTION("test_collections_without_shard_keys_are_not_routed") {
+  PlanMap shards{{"1", strings({"s1"})}};
+  auto table = empty.withPlan(1, shards, PlanMap());
+  CHECK(table->collections->empty());
+}
+
+SECTION("test_routing_table_from_current") {
+  RoutingTable::ShardServerMap servers{{"s1", strings({"PRMR-1", "PRMR-2"})}};
+
+  auto table = empty.withCurrent(7, servers);
+  CHECK(table->currentVersion == 7);
+  CHECK(table->planVersion == 0);
+  REQUIRE(table->shardServers->size() == 1);
+  CHECK(table->shardServers->at("s1")->at(0) == "PRMR-1");
+}
+
+SECTION("test_snapshots_are_not_modified") {
+  PlanMap shards{{"1", strings({"s1"})}};
+  PlanMap shardKeys{{"1", strings({"_key"})}};
+  auto planned = empty.withPlan(1, shards, shardKeys);
+
+  RoutingTable::ShardServerMap servers{{"s1", strings({"PRMR-1"})}};
+  auto current = planned->withCurrent(2, servers);
+
+  // the new snapshot shares the Plan part of the old one
+  CHECK(current->collections == planned->collections);
+  CHECK(current->planVersion == 1);
+  CHECK(current->shardServers->size() == 1);
+
+  // readers of the old snapshot do not see the change
+  CHECK(planned->currentVersion == 0);
+  CHECK(planned->shardServers->empty());
+  CHECK(empty.collections->empty());
+
+  // the snapshot does not change with the maps it was built from
+  servers.clear();
+  CHECK(current->shardServers->size() == 1);
+
+  auto replanned = current->withPlan(3, PlanMap(), PlanMap());
+  CHECK(replanned->shardServers == current->shardServers);
+  CHECK(replanned->collections->empty());
+  CHECK(current->collections->size() == 1);
+}
+
+}
@@ -0,0 +1,79 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+
+#include "catch.hpp"
+
+#include "Cluster/ClusterMethods.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Parser.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+
+typedef std::unordered_map<VPackSlice, std::shared_ptr<VPackBuffer<uint8_t>>>
+    VertexCache;
+
+TEST_CASE("ClusterMethodsTest", "[cluster]") {
+  VertexCache cache;
+
+SECTION("test_vertices_returned_with_edges_are_cached") {
+  auto response = VPackParser::fromJson(
+      "{\"v/1\":{\"_id\":\"v/1\",\"value\":1},"
+      "\"v/2\":{\"_id\":\"v/2\",\"value\":2}}");
+  addVerticesFromEngine(response->slice(), cache);
+  REQUIRE(cache.size() == 2);
+
+  auto id = VPackParser::fromJson("\"v/2\"");
+  auto it = cache.find(id->slice());
+  REQUIRE(it != cache.end());
+  VPackSlice vertex(it->second->data());
+  CHECK(vertex.get("value").getUInt() == 2);
+  // the key points into the cached document, not into the response
+  CHECK(it->first.begin() == vertex.get("_id").begin());
+
+  response.reset();
+  CHECK(cache.find(id->slice())->first.copyString() == "v/2");
+}
+
+SECTION("test_cached_vertices_are_kept") {
+  auto first = VPackParser::fromJson("{\"v/1\":{\"_id\":\"v/1\",\"value\":1}}");
+  addVerticesFromEngine(first->slice(), cache);
+  auto second = VPackParser::fromJson(
+      "{\"v/1\":{\"_id\":\"v/1\",\"value\":2},"
+      "\"v/3\":{\"_id\":\"v/3\",\"value\":3}}");
+  addVerticesFromEngine(second->slice(), cache);
+
+  REQUIRE(cache.size() == 2);
+  auto id = VPackParser::fromJson("\"v/1\"");
+  CHECK(VPackSlice(cache[id->slice()]->data()).get("value").getUInt() == 1);
+}
+
+SECTION("test_responses_without_vertices") {
+  // older DBServers do not return any vertices
+  auto response = VPackParser::fromJson("{\"edges\":[]}");
+  addVerticesFromEngine(response->slice().get("vertices"), cache);
+  CHECK(cache.empty());
+}
+
+}
@@ -0,0 +1,117 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+
+#include "catch.hpp"
+
+#include "Cluster/DBServerAgencySync.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Parser.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+
+static std::shared_ptr<VPackBuilder> json(std::string const& value) {
+  return VPackParser::fromJson(value);
+}
+
+TEST_CASE("DBServerAgencySyncTest", "[cluster]") {
+
+SECTION("test_planned_shards") {
+  auto info = json(
+      "{\"shards\":{\"s1\":[\"PRMR-1\",\"PRMR-2\"],\"s2\":[\"PRMR-2\","
+      "\"PRMR-1\"],\"s3\":[\"PRMR-3\"]}}");
+
+  std::vector<std::pair<std::string, bool>> shards;
+  DBServerAgencySync::plannedShards(info->slice(), "PRMR-1", shards);
+  REQUIRE(shards.size() == 2);
+  CHECK(shards[0] == std::make_pair(std::string("s1"), true));
+  CHECK(shards[1] == std::make_pair(std::string("s2"), false));
+
+  shards.clear();
+  DBServerAgencySync::plannedShards(info->slice(), "PRMR-4", shards);
+  CHECK(shards.empty());
+
+  // collections without shards are ignored
+  DBServerAgencySync::plannedShards(json("{}")->slice(), "PRMR-1", shards);
+  CHECK(shards.empty());
+}
+
+SECTION("test_follower_in_sync") {
+  auto current = json("{\"servers\":[\"PRMR-2\",\"PRMR-1\"]}");
+  CHECK(DBServerAgencySync::isInSync(current->slice(), "PRMR-1"));
+  CHECK(!DBServerAgencySync::isInSync(current->slice(), "PRMR-3"));
+  // the shard is not yet reported by its leader
+  CHECK(!DBServerAgencySync::isInSync(VPackSlice(), "PRMR-1"));
+  CHECK(!DBServerAgencySync::isInSync(json("{}")->slice(), "PRMR-1"));
+}
+
+SECTION("test_fingerprint_detects_changes") {
+  auto info = json("{\"shards\":{\"s1\":[\"PRMR-1\"]},\"waitForSync\":false}");
+  auto changedInfo =
+      json("{\"shards\":{\"s1\":[\"PRMR-1\"]},\"waitForSync\":true}");
+  auto current = json("{\"s1\":{\"servers\":[\"PRMR-1\"]}}");
+  auto changedCurrent =
+      json("{\"s1\":{\"servers\":[\"PRMR-1\",\"PRMR-2\"]}}");
+
+  uint64_t const value =
+      DBServerAgencySync::collectionFingerprint(info->slice(),
+                                                current->slice());
+  CHECK(value == DBServerAgencySync::collectionFingerprint(
+                     json("{\"shards\":{\"s1\":[\"PRMR-1\"]},"
+                          "\"waitForSync\":false}")->slice(),
+                     current->slice()));
+  CHECK(value != DBServerAgencySync::collectionFingerprint(
+                     changedInfo->slice(), current->slice()));
+  CHECK(value != DBServerAgencySync::collectionFingerprint(
+                     info->slice(), changedCurrent->slice()));
+  // a collection that is not yet in Current
+  CHECK(value != DBServerAgencySync::collectionFingerprint(info->slice(),
+                                                           VPackSlice()));
+}
+
+SECTION("test_databases_in_sync") {
+  auto plan = json("{\"Databases\":{\"_system\":{},\"db\":{}}}");
+  auto current = json(
+      "{\"Databases\":{\"_system\":{\"PRMR-1\":{}},\"db\":{\"PRMR-1\":{}}}}");
+  CHECK(!DBServerAgencySync::databasesNeedJavaScript(
+      plan->slice(), current->slice(), {"_system", "db"}, "PRMR-1"));
+}
+
+SECTION("test_databases_to_create_or_drop") {
+  auto plan = json("{\"Databases\":{\"_system\":{},\"db\":{}}}");
+  auto current = json(
+      "{\"Databases\":{\"_system\":{\"PRMR-1\":{}},\"db\":{\"PRMR-1\":{}}}}");
+
+  // a planned database is missing locally
+  CHECK(DBServerAgencySync::databasesNeedJavaScript(
+      plan->slice(), current->slice(), {"_system"}, "PRMR-1"));
+  // a local database is no longer planned
+  CHECK(DBServerAgencySync::databasesNeedJavaScript(
+      plan->slice(), current->slice(), {"_system", "db", "old"}, "PRMR-1"));
+  // the database exists, but is not yet reported in Current
+  CHECK(DBServerAgencySync::databasesNeedJavaScript(
+      plan->slice(), current->slice(), {"_system", "db"}, "PRMR-2"));
+}
+
+}
@@ -0,0 +1,146 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+
+#include "catch.hpp"
+
+#include "GeneralServer/AsyncJobManager.h"
+#include "GeneralServer/RestHandler.h"
+#include "Rest/HttpRequest.h"
+#include "Rest/HttpResponse.h"
+
+using namespace arangodb;
+using namespace arangodb::rest;
+
+namespace {
+
+/// @brief handler whose response has a body of the given size
+class TestHandler final : public RestHandler {
+ public:
+  explicit TestHandler(size_t bodySize)
+      : RestHandler(HttpRequest::createHttpRequest(ContentType::JSON, "", 0,
+                                                   {}),
+                    new HttpResponse(ResponseCode::OK)) {
+    static_cast<HttpResponse*>(_response.get())
+        ->body()
+        .appendText(std::string(bodySize, 'x'));
+  }
+
+  char const* name() const override { return "TestHandler"; }
+  bool isDirect() const override { return true; }
+  RestStatus execute() override { return RestStatus::DONE; }
+  void handleError(basics::Exception const&) override {}
+};
+
+}  // namespace
+
+TEST_CASE("AsyncJobManagerTest", "[rest]") {
+
+SECTION("test_results_are_stored_until_fetched") {
+  AsyncJobManager manager;
+  TestHandler handler(1000);
+  manager.initAsyncJob(&handler, nullptr);
+
+  AsyncJobResult::Status status;
+  CHECK(manager.getJobResult(handler.handlerId(), status, true) == nullptr);
+  CHECK(status == AsyncJobResult::JOB_PENDING);
+  CHECK(manager.memoryUsage() == 0);
+
+  manager.finishAsyncJob(&handler);
+  CHECK(manager.memoryUsage() > 1000);
+  CHECK(manager.done(10).size() == 1);
+
+  std::unique_ptr<GeneralResponse> response(
+      manager.getJobResult(handler.handlerId(), status, true));
+  CHECK(status == AsyncJobResult::JOB_DONE);
+  REQUIRE(response != nullptr);
+  CHECK(static_cast<HttpResponse*>(response.get())->body().length() == 1000);
+  CHECK(manager.memoryUsage() == 0);
+
+  // the result can only be fetched once
+  CHECK(manager.getJobResult(handler.handlerId(), status, true) == nullptr);
+  CHECK(status == AsyncJobResult::JOB_UNDEFINED);
+}
+
+SECTION("test_oldest_results_are_dropped_above_the_memory_limit") {
+  uint64_t const maxMemory = 10000;
+  AsyncJobManager manager(maxMemory);
+  std::vector<std::unique_ptr<TestHandler>> handlers;
+
+  for (size_t i = 0; i < 20; ++i) {
+    handlers.emplace_back(new TestHandler(1000));
+    manager.initAsyncJob(handlers.back().get(), nullptr);
+    manager.finishAsyncJob(handlers.back().get());
+    CHECK(manager.memoryUsage() <= maxMemory);
+  }
+
+  size_t const kept = manager.done(100).size();
+  CHECK(kept > 0);
+  CHECK(kept < 20);
+
+  // the newest results are kept, the oldest are gone
+  AsyncJobResult::Status status;
+  manager.getJobResult(handlers.front()->handlerId(), status, false);
+  CHECK(status == AsyncJobResult::JOB_UNDEFINED);
+  manager.getJobResult(handlers.back()->handlerId(), status, false);
+  CHECK(status == AsyncJobResult::JOB_DONE);
+}
+
+SECTION("test_pending_jobs_are_never_dropped") {
+  AsyncJobManager manager(2000);
+  TestHandler pending(1000);
+  manager.initAsyncJob(&pending, nullptr);
+
+  std::vector<std::unique_ptr<TestHandler>> handlers;
+  for (size_t i = 0; i < 5; ++i) {
+    handlers.emplace_back(new TestHandler(1000));
+    manager.initAsyncJob(handlers.back().get(), nullptr);
+    manager.finishAsyncJob(handlers.back().get());
+  }
+
+  AsyncJobResult::Status status;
+  manager.getJobResult(pending.handlerId(), status, false);
+  CHECK(status == AsyncJobResult::JOB_PENDING);
+  CHECK(manager.pending(10).size() == 1);
+}
+
+SECTION("test_deleting_results_releases_their_memory") {
+  AsyncJobManager manager;
+  TestHandler first(1000);
+  TestHandler second(2000);
+
+  for (auto* handler : {&first, &second}) {
+    manager.initAsyncJob(handler, nullptr);
+    manager.finishAsyncJob(handler);
+  }
+  uint64_t const usage = manager.memoryUsage();
+
+  CHECK(manager.deleteJobResult(second.handlerId()));
+  CHECK(manager.memoryUsage() < usage - 2000);
+  CHECK(manager.memoryUsage() > 1000);
+
+  manager.deleteJobResults();
+  CHECK(manager.memoryUsage() == 0);
+  CHECK(manager.done(10).empty());
+}
+
+}
@@ -0,0 +1,106 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+
+#include "catch.hpp"
+
+#include "GeneralServer/ChunkInterleaver.h"
+
+using namespace arangodb::rest;
+
+namespace {
+struct Statistics {};
+
+std::vector<std::pair<std::string, Statistics*>> drain(
+    ChunkInterleaver<std::string, Statistics>& interleaver) {
+  std::vector<std::pair<std::string, Statistics*>> result;
+  std::string chunk;
+  Statistics* extra = nullptr;
+  while (interleaver.next(chunk, extra)) {
+    result.emplace_back(chunk, extra);
+  }
+  return result;
+}
+}
+
+TEST_CASE("ChunkInterleaverTest", "[vst]") {
+  ChunkInterleaver<std::string, Statistics> interleaver;
+  Statistics first;
+  Statistics second;
+
+SECTION("test_single_message_keeps_its_order") {
+  interleaver.add({"a1", "a2", "a3"}, &first);
+
+  auto chunks = drain(interleaver);
+  REQUIRE(chunks.size() == 3);
+  CHECK(chunks[0].first == "a1");
+  CHECK(chunks[1].first == "a2");
+  CHECK(chunks[2].first == "a3");
+  CHECK(interleaver.empty());
+}
+
+SECTION("test_messages_take_turns") {
+  interleaver.add({"a1", "a2", "a3", "a4"}, &first);
+  interleaver.add({"b1", "b2"}, &second);
+
+  auto chunks = drain(interleaver);
+  std::vector<std::string> order;
+  for (auto const& it : chunks) {
+    order.emplace_back(it.first);
+  }
+  // the small message is done after its second turn
+  CHECK(order == std::vector<std::string>({"a1", "b1", "a2", "b2", "a3", "a4"}));
+}
+
+SECTION("test_extra_goes_with_the_last_chunk") {
+  interleaver.add({"a1", "a2"}, &first);
+  interleaver.add({"b1"}, &second);
+
+  auto chunks = drain(interleaver);
+  REQUIRE(chunks.size() == 3);
+  CHECK(chunks[0].second == nullptr);
+  CHECK(chunks[1].second == &second);
+  CHECK(chunks[2].second == &first);
+}
+
+SECTION("test_extras_of_unsent_messages") {
+  interleaver.add({"a1", "a2"}, &first);
+  interleaver.add({"b1"}, &second);
+  interleaver.add({}, nullptr);
+
+  std::string chunk;
+  Statistics* extra = nullptr;
+  REQUIRE(interleaver.next(chunk, extra));
+
+  std::vector<Statistics*> extras;
+  interleaver.forEachExtra([&extras](Statistics* s) { extras.emplace_back(s); });
+  CHECK(extras == std::vector<Statistics*>({&second, &first}));
+}
+
+SECTION("test_nothing_to_send") {
+  std::string chunk;
+  Statistics* extra = &first;
+  CHECK(!interleaver.next(chunk, extra));
+  CHECK(interleaver.empty());
+}
+
+}
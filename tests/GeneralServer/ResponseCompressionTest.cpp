@@ -0,0 +1,174 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+
+#include "catch.hpp"
+
+#include "Basics/StringBuffer.h"
+#include "GeneralServer/ResponseCompression.h"
+
+#include <snappy.h>
+#include <zlib.h>
+
+using namespace arangodb;
+using namespace arangodb::basics;
+using namespace arangodb::rest;
+
+namespace {
+std::string body(size_t length) {
+  std::string result;
+  while (result.size() < length) {
+    result.append("{\"_key\":\"test\",\"value\":");
+    result.append(std::to_string(result.size()));
+    result.append("}");
+  }
+  return result;
+}
+
+/// @brief inflate a zlib or gzip wrapped body
+std::string inflateBody(StringBuffer const& compressed) {
+  z_stream strm;
+  memset(&strm, 0, sizeof(strm));
+  // detect the zlib and the gzip wrapper automatically
+  REQUIRE(inflateInit2(&strm, 32 + MAX_WBITS) == Z_OK);
+
+  strm.next_in = reinterpret_cast<Bytef*>(
+      const_cast<char*>(compressed.c_str()));
+  strm.avail_in = static_cast<uInt>(compressed.length());
+
+  std::string result;
+  char buffer[4096];
+  int res;
+  do {
+    strm.next_out = reinterpret_cast<Bytef*>(&buffer[0]);
+    strm.avail_out = sizeof(buffer);
+    res = inflate(&strm, Z_NO_FLUSH);
+    result.append(buffer, sizeof(buffer) - strm.avail_out);
+  } while (res == Z_OK);
+
+  (void)inflateEnd(&strm);
+  CHECK(res == Z_STREAM_END);
+  return result;
+}
+}
+
+TEST_CASE("ResponseCompressionTest", "[http]") {
+
+SECTION("test_negotiate_needs_an_accepted_coding") {
+  CHECK(ResponseCompression::negotiate("", true) == ContentEncoding::IDENTITY);
+  CHECK(ResponseCompression::negotiate("identity", true) ==
+        ContentEncoding::IDENTITY);
+  CHECK(ResponseCompression::negotiate("br, *", true) ==
+        ContentEncoding::IDENTITY);
+  CHECK(ResponseCompression::negotiate("gzip", false) ==
+        ContentEncoding::IDENTITY);
+}
+
+SECTION("test_negotiate_prefers_the_cheapest_coding") {
+  CHECK(ResponseCompression::negotiate("deflate", true) ==
+        ContentEncoding::DEFLATE);
+  CHECK(ResponseCompression::negotiate("gzip, deflate", true) ==
+        ContentEncoding::GZIP);
+  CHECK(ResponseCompression::negotiate("X-GZIP", true) ==
+        ContentEncoding::GZIP);
+  CHECK(ResponseCompression::negotiate("deflate, gzip, snappy", true) ==
+        ContentEncoding::SNAPPY);
+}
+
+SECTION("test_negotiate_respects_quality_values") {
+  CHECK(ResponseCompression::negotiate("snappy;q=0.5, deflate", true) ==
+        ContentEncoding::DEFLATE);
+  CHECK(ResponseCompression::negotiate("gzip; q=0.8, deflate;q=0.9", true) ==
+        ContentEncoding::DEFLATE);
+  CHECK(ResponseCompression::negotiate("gzip;q=0, deflate;q=0", true) ==
+        ContentEncoding::IDENTITY);
+  // unparsable quality values count as 1
+  CHECK(ResponseCompression::negotiate("deflate;q=abc, gzip;q=0.5", true) ==
+        ContentEncoding::DEFLATE);
+}
+
+SECTION("test_names") {
+  CHECK(ResponseCompression::name(ContentEncoding::IDENTITY) == "identity");
+  CHECK(ResponseCompression::name(ContentEncoding::DEFLATE) == "deflate");
+  CHECK(ResponseCompression::name(ContentEncoding::GZIP) == "gzip");
+  CHECK(ResponseCompression::name(ContentEncoding::SNAPPY) == "snappy");
+}
+
+SECTION("test_compress_zlib_round_trip") {
+  std::string const data = body(100000);
+
+  for (auto encoding : {ContentEncoding::DEFLATE, ContentEncoding::GZIP}) {
+    StringBuffer out(TRI_UNKNOWN_MEM_ZONE);
+    CHECK(ResponseCompression::compress(encoding, data.c_str(), data.size(),
+                                        1024, 1, out));
+    CHECK(out.length() < data.size());
+    CHECK(inflateBody(out) == data);
+  }
+}
+
+SECTION("test_compress_snappy_round_trip") {
+  std::string const data = body(100000);
+
+  StringBuffer out(TRI_UNKNOWN_MEM_ZONE);
+  CHECK(ResponseCompression::compress(ContentEncoding::SNAPPY, data.c_str(),
+                                      data.size(), 1024, 1, out));
+  CHECK(out.length() < data.size());
+
+  std::string result;
+  CHECK(snappy::Uncompress(out.c_str(), out.length(), &result));
+  CHECK(result == data);
+}
+
+SECTION("test_small_bodies_are_not_compressed") {
+  std::string const data = body(2000);
+
+  StringBuffer out(TRI_UNKNOWN_MEM_ZONE);
+  CHECK(!ResponseCompression::compress(ContentEncoding::GZIP, data.c_str(),
+                                       data.size(), data.size() + 1, 1, out));
+  CHECK(out.length() == 0);
+
+  // a threshold of 0 turns compression off
+  CHECK(!ResponseCompression::compress(ContentEncoding::GZIP, data.c_str(),
+                                       data.size(), 0, 1, out));
+  CHECK(!ResponseCompression::compress(ContentEncoding::IDENTITY,
+                                       data.c_str(), data.size(), 1, 1, out));
+}
+
+SECTION("test_incompressible_bodies_are_sent_as_they_are") {
+  // random bytes do not get smaller
+  std::string data;
+  uint32_t state = 4711;
+  for (size_t i = 0; i < 100000; ++i) {
+    state = state * 1103515245 + 12345;
+    data.push_back(static_cast<char>(state >> 24));
+  }
+
+  for (auto encoding : {ContentEncoding::DEFLATE, ContentEncoding::GZIP,
+                        ContentEncoding::SNAPPY}) {
+    StringBuffer out(TRI_UNKNOWN_MEM_ZONE);
+    CHECK(!ResponseCompression::compress(encoding, data.c_str(), data.size(),
+                                         1024, 1, out));
+    CHECK(out.length() == 0);
+  }
+}
+
+}
@@ -0,0 +1,81 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+
+#include "catch.hpp"
+
+#include "GeneralServer/ResponseSequencer.h"
+
+using namespace arangodb::rest;
+
+TEST_CASE("ResponseSequencerTest", "[http]") {
+  ResponseSequencer<std::string> sequencer;
+  std::vector<std::string> sent;
+  auto send = [&sent](std::string& response) { sent.emplace_back(response); };
+
+SECTION("test_responses_in_order_are_sent_at_once") {
+  sequencer.add(1, "a", send);
+  sequencer.add(2, "b", send);
+
+  CHECK(sent == std::vector<std::string>({"a", "b"}));
+  CHECK(sequencer.next() == 3);
+}
+
+SECTION("test_later_responses_wait_for_earlier_ones") {
+  sequencer.add(3, "c", send);
+  sequencer.add(2, "b", send);
+  CHECK(sent.empty());
+  CHECK(sequencer.next() == 1);
+
+  sequencer.add(1, "a", send);
+  CHECK(sent == std::vector<std::string>({"a", "b", "c"}));
+  CHECK(sequencer.next() == 4);
+}
+
+SECTION("test_gaps_stop_sending") {
+  sequencer.add(1, "a", send);
+  sequencer.add(3, "c", send);
+  sequencer.add(5, "e", send);
+  CHECK(sent == std::vector<std::string>({"a"}));
+
+  sequencer.add(2, "b", send);
+  CHECK(sent == std::vector<std::string>({"a", "b", "c"}));
+  CHECK(sequencer.next() == 4);
+
+  sequencer.add(4, "d", send);
+  CHECK(sent == std::vector<std::string>({"a", "b", "c", "d", "e"}));
+}
+
+SECTION("test_responses_already_added") {
+  CHECK(!sequencer.hasResponse(1));
+
+  sequencer.add(1, "a", send);
+  sequencer.add(3, "c", send);
+
+  // sent and waiting responses both count
+  CHECK(sequencer.hasResponse(1));
+  CHECK(!sequencer.hasResponse(2));
+  CHECK(sequencer.hasResponse(3));
+  CHECK(!sequencer.hasResponse(4));
+}
+
+}
@@ -0,0 +1,57 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+
+#include "catch.hpp"
+
+#include "GeneralServer/RestHandler.h"
+
+using namespace arangodb::rest;
+
+TEST_CASE("RestHandlerTest", "[rest]") {
+
+SECTION("test_times_without_statistics") {
+  auto times = RestHandler::requestTimes(100.0, 103.0, 0.0, 0.0, 0.0, 0.0);
+  CHECK(times._total == 3.0);
+  CHECK(times._execution == 3.0);
+  CHECK(!times._phases);
+}
+
+SECTION("test_times_with_statistics") {
+  // read from 90 to 92, queued from 92 to 96, executed from 100 to 103
+  auto times = RestHandler::requestTimes(100.0, 103.0, 90.0, 92.0, 92.0, 96.0);
+  CHECK(times._phases);
+  // measured from the first byte of the request
+  CHECK(times._total == 13.0);
+  CHECK(times._read == 2.0);
+  CHECK(times._queue == 4.0);
+  CHECK(times._execution == 3.0);
+}
+
+SECTION("test_times_of_requests_that_were_not_queued") {
+  auto times = RestHandler::requestTimes(100.0, 103.0, 90.0, 92.0, 0.0, 0.0);
+  CHECK(times._phases);
+  CHECK(times._total == 13.0);
+  CHECK(times._queue == 0.0);
+}
+
+}
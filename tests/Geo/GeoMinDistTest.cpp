@@ -0,0 +1,201 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+
+#include "catch.hpp"
+
+#include "MMFiles/geo-index.h"
+
+#include <algorithm>
+#include <cmath>
+
+static size_t const NumPoints = 2000;
+
+// the i-th indexed point. the data of each point is its number
+static GeoCoordinate point(size_t i) {
+  GeoCoordinate c;
+  c.latitude = std::fmod(41.23456789 + i * 19.5396157761, 180.0) - 90.0;
+  c.longitude = std::fmod(39.87654321 + i * 17.2329155421, 360.0) - 180.0;
+  c.data = i;
+  return c;
+}
+
+static GeoIdx* fill(size_t count) {
+  GeoIdx* gi = GeoIndex_new();
+  for (size_t i = 0; i < count; ++i) {
+    GeoCoordinate c = point(i);
+    REQUIRE(GeoIndex_insert(gi, &c) == 0);
+  }
+  CHECK(GeoIndex_INDEXVALID(gi) == 0);
+  return gi;
+}
+
+// the numbers of the points returned by a query, sorted. queries without
+// results return a nullptr
+static std::vector<uint64_t> found(GeoCoordinates* result) {
+  std::vector<uint64_t> numbers;
+  if (result == nullptr) {
+    return numbers;
+  }
+  for (size_t i = 0; i < result->length; ++i) {
+    numbers.emplace_back(result->coordinates[i].data);
+  }
+  GeoIndex_CoordinatesFree(result);
+  std::sort(numbers.begin(), numbers.end());
+  return numbers;
+}
+
+static bool contains(std::vector<uint64_t> const& numbers, uint64_t number) {
+  return std::binary_search(numbers.begin(), numbers.end(), number);
+}
+
+// checks a radius query against the distances of all points. points within
+// a relative 1e-9 of the radius may go either way
+static void checkWithin(GeoIdx* gi, GeoCoordinate& target, double radius,
+                        std::vector<bool> const& indexed) {
+  auto numbers = found(GeoIndex_PointsWithinRadius(gi, &target, radius));
+  for (size_t i = 0; i < indexed.size(); ++i) {
+    GeoCoordinate c = point(i);
+    double const distance = GeoIndex_distance(&target, &c);
+    if (!indexed[i] || distance > radius * (1.0 + 1e-9)) {
+      CHECK(!contains(numbers, i));
+    } else if (distance < radius * (1.0 - 1e-9)) {
+      CHECK(contains(numbers, i));
+    }
+  }
+}
+
+// the targets, chosen close to and far away from the fixed points of the
+// index, so that pots are rejected for being too far from them as well as
+// for being too close
+static std::vector<GeoCoordinate> targets() {
+  std::vector<GeoCoordinate> result;
+  for (double latitude : {90.0, 51.5, 0.0, -36.916667, -89.5}) {
+    for (double longitude : {-180.0, -0.166666, 28.033333, 90.0, 174.783333}) {
+      GeoCoordinate c;
+      c.latitude = latitude;
+      c.longitude = longitude;
+      c.data = 0;
+      result.emplace_back(c);
+    }
+  }
+  return result;
+}
+
+TEST_CASE("GeoMinDistTest", "[geo]") {
+
+SECTION("test_point_at_radius_is_found") {
+  GeoIdx* gi = fill(NumPoints);
+
+  for (auto& target : targets()) {
+    for (size_t i = 0; i < NumPoints; i += 97) {
+      GeoCoordinate c = point(i);
+      double const distance = GeoIndex_distance(&target, &c);
+
+      // exactly at the radius
+      auto numbers = found(GeoIndex_PointsWithinRadius(gi, &target, distance));
+      CHECK(contains(numbers, i));
+
+      // just inside the radius
+      numbers = found(
+          GeoIndex_PointsWithinRadius(gi, &target, distance * (1.0 + 1e-9)));
+      CHECK(contains(numbers, i));
+
+      // just outside the radius
+      numbers = found(
+          GeoIndex_PointsWithinRadius(gi, &target, distance * (1.0 - 1e-6)));
+      CHECK(!contains(numbers, i));
+    }
+  }
+
+  GeoIndex_free(gi);
+}
+
+SECTION("test_within_matches_all_distances") {
+  GeoIdx* gi = fill(NumPoints);
+  std::vector<bool> indexed(NumPoints, true);
+
+  for (auto& target : targets()) {
+    for (double radius : {1000.0, 500000.0, 3000000.0, 9000000.0, 15000000.0,
+                          19000000.0, 30000000.0}) {
+      checkWithin(gi, target, radius, indexed);
+    }
+  }
+
+  GeoIndex_free(gi);
+}
+
+SECTION("test_within_after_removal") {
+  // removals leave the bounds of the pots stale, which must only make them
+  // looser
+  GeoIdx* gi = fill(NumPoints);
+  std::vector<bool> indexed(NumPoints, true);
+  for (size_t i = 0; i < NumPoints; i += 3) {
+    GeoCoordinate c = point(i);
+    REQUIRE(GeoIndex_remove(gi, &c) == 0);
+    indexed[i] = false;
+  }
+  CHECK(GeoIndex_INDEXVALID(gi) == 0);
+
+  for (auto& target : targets()) {
+    for (double radius : {500000.0, 9000000.0, 15000000.0}) {
+      checkWithin(gi, target, radius, indexed);
+    }
+  }
+
+  GeoIndex_free(gi);
+}
+
+SECTION("test_nearest_matches_all_distances") {
+  GeoIdx* gi = fill(NumPoints);
+
+  for (auto& target : targets()) {
+    std::vector<double> distances;
+    for (size_t i = 0; i < NumPoints; ++i) {
+      GeoCoordinate c = point(i);
+      distances.emplace_back(GeoIndex_distance(&target, &c));
+    }
+    std::sort(distances.begin(), distances.end());
+
+    for (int count : {1, 10, 100}) {
+      GeoCoordinates* result =
+          GeoIndex_NearestCountPoints(gi, &target, count);
+      REQUIRE(result != nullptr);
+      REQUIRE(result->length == static_cast<size_t>(count));
+
+      std::vector<double> nearest;
+      for (size_t i = 0; i < result->length; ++i) {
+        nearest.emplace_back(GeoIndex_distance(&target, &result->coordinates[i]));
+      }
+      GeoIndex_CoordinatesFree(result);
+      std::sort(nearest.begin(), nearest.end());
+
+      for (size_t i = 0; i < nearest.size(); ++i) {
+        CHECK(nearest[i] <= distances[i] * (1.0 + 1e-9) + 1e-6);
+      }
+    }
+  }
+
+  GeoIndex_free(gi);
+}
+
+}
@@ -0,0 +1,185 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+
+#include "catch.hpp"
+
+#include "Indexes/Index.h"
+#include "Indexes/IndexIterator.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+
+namespace {
+
+struct TestToken final : public DocumentIdentifierToken {
+  explicit TestToken(uint64_t data) : DocumentIdentifierToken(data) {}
+};
+
+class TestIndex final : public Index {
+ public:
+  TestIndex() : Index(1, nullptr, {}, false, false) {}
+
+  bool allowExpansion() const override { return false; }
+  IndexType type() const override { return TRI_IDX_TYPE_UNKNOWN; }
+  bool canBeDropped() const override { return false; }
+  bool isSorted() const override { return false; }
+  bool hasSelectivityEstimate() const override { return false; }
+  size_t memory() const override { return 0; }
+  int insert(transaction::Methods*, TRI_voc_rid_t, VPackSlice const&,
+             bool) override {
+    return TRI_ERROR_NO_ERROR;
+  }
+  int remove(transaction::Methods*, TRI_voc_rid_t, VPackSlice const&,
+             bool) override {
+    return TRI_ERROR_NO_ERROR;
+  }
+  int unload() override { return TRI_ERROR_NO_ERROR; }
+};
+
+// the iterators do not use the collection, the transaction or the index
+static LogicalCollection* const testCollection =
+    reinterpret_cast<LogicalCollection*>(1);
+static transaction::Methods* const testTrx =
+    reinterpret_cast<transaction::Methods*>(1);
+static TestIndex const testIndex;
+
+// iterates over fixed tokens, with the extra value [token] for each
+class TestIterator final : public IndexIterator {
+ public:
+  TestIterator(std::vector<uint64_t> const& tokens, bool extra)
+      : IndexIterator(testCollection, testTrx, nullptr, &testIndex),
+        _tokens(tokens),
+        _position(0),
+        _hasExtra(extra) {}
+
+  char const* typeName() const override { return "test-index-iterator"; }
+
+  bool hasExtra() const override { return _hasExtra; }
+
+  bool next(TokenCallback const& cb, size_t limit) override {
+    return nextExtra([&cb](DocumentIdentifierToken const& token,
+                           VPackSlice) { cb(token); },
+                     limit);
+  }
+
+  bool nextExtra(ExtraCallback const& cb, size_t limit) override {
+    while (limit > 0) {
+      if (_position >= _tokens.size()) {
+        return false;
+      }
+      VPackBuilder extra;
+      extra.openArray();
+      extra.add(VPackValue(_tokens[_position]));
+      extra.close();
+      cb(TestToken(_tokens[_position++]), extra.slice());
+      --limit;
+    }
+    return true;
+  }
+
+  void reset() override { _position = 0; }
+
+ private:
+  std::vector<uint64_t> _tokens;
+  size_t _position;
+  bool _hasExtra;
+};
+
+static std::unique_ptr<MultiIndexIterator> multiIterator(
+    std::vector<IndexIterator*> const& iterators) {
+  return std::make_unique<MultiIndexIterator>(testCollection, testTrx, nullptr,
+                                              &testIndex, iterators);
+}
+
+}  // namespace
+
+TEST_CASE("IndexIteratorTest", "[indexes]") {
+  std::vector<uint64_t> found;
+  auto collect = [&found](DocumentIdentifierToken const& token) {
+    found.emplace_back(token._data);
+  };
+
+SECTION("test_multi_iterator_continues_with_the_next_iterator") {
+  auto iterator = multiIterator({new TestIterator({1, 2}, false),
+                                 new TestIterator({}, false),
+                                 new TestIterator({3, 4, 5}, false)});
+
+  CHECK(!iterator->next(collect, 10));
+  CHECK(found == (std::vector<uint64_t>{1, 2, 3, 4, 5}));
+}
+
+SECTION("test_multi_iterator_in_batches") {
+  auto iterator = multiIterator({new TestIterator({1, 2}, false),
+                                 new TestIterator({}, false),
+                                 new TestIterator({3, 4, 5}, false)});
+
+  CHECK(iterator->next(collect, 2));
+  CHECK(found == (std::vector<uint64_t>{1, 2}));
+  CHECK(iterator->next(collect, 2));
+  CHECK(found == (std::vector<uint64_t>{1, 2, 3, 4}));
+  CHECK(!iterator->next(collect, 2));
+  CHECK(found == (std::vector<uint64_t>{1, 2, 3, 4, 5}));
+  CHECK(!iterator->next(collect, 2));
+  CHECK(found.size() == 5);
+}
+
+SECTION("test_multi_iterator_tokens") {
+  auto iterator = multiIterator({new TestIterator({1}, false),
+                                 new TestIterator({2, 3}, false)});
+
+  std::vector<DocumentIdentifierToken> tokens;
+  CHECK(!iterator->nextTokens(tokens, 10));
+  REQUIRE(tokens.size() == 3);
+  CHECK(tokens[0] == 1);
+  CHECK(tokens[2] == 3);
+}
+
+SECTION("test_multi_iterator_extra_values") {
+  auto iterator = multiIterator({new TestIterator({1, 2}, true),
+                                 new TestIterator({3}, true)});
+  REQUIRE(iterator->hasExtra());
+
+  std::vector<uint64_t> extras;
+  auto cb = [&](DocumentIdentifierToken const& token, VPackSlice extra) {
+    found.emplace_back(token._data);
+    extras.emplace_back(extra.at(0).getUInt());
+  };
+
+  CHECK(iterator->nextExtra(cb, 2));
+  CHECK(!iterator->nextExtra(cb, 2));
+  CHECK(found == (std::vector<uint64_t>{1, 2, 3}));
+  CHECK(extras == found);
+}
+
+SECTION("test_multi_iterator_extra_values_need_all_iterators") {
+  auto mixed = multiIterator({new TestIterator({1}, true),
+                              new TestIterator({2}, false)});
+  CHECK(!mixed->hasExtra());
+
+  auto empty = multiIterator({});
+  CHECK(!empty->hasExtra());
+}
+
+}
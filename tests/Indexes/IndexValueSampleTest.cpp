@@ -0,0 +1,114 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+
+#include "catch.hpp"
+
+#include "Indexes/IndexValueSample.h"
+#include "Random/RandomGenerator.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+
+static void insertValues(IndexValueSample& sample, uint64_t from,
+                         uint64_t to) {
+  for (uint64_t i = from; i < to; ++i) {
+    VPackBuilder builder;
+    builder.add(VPackValue(i));
+    sample.insert(builder.slice());
+  }
+}
+
+static auto const lessThan = [](uint64_t limit) {
+  return [limit](VPackSlice value) { return value.getUInt() < limit; };
+};
+
+TEST_CASE("IndexValueSampleTest", "[indexes]") {
+  RandomGenerator::initialize(RandomGenerator::RandomType::MERSENNE);
+
+SECTION("test_no_estimate_for_small_samples") {
+  IndexValueSample sample;
+  size_t const minValues = IndexValueSample::MinValues;
+  insertValues(sample, 0, minValues - 1);
+
+  double fraction = -1.0;
+  CHECK(!sample.estimate(lessThan(10), fraction));
+  CHECK(fraction == -1.0);
+
+  insertValues(sample, minValues - 1, minValues);
+  CHECK(sample.estimate(lessThan(minValues), fraction));
+  CHECK(fraction == 1.0);
+}
+
+SECTION("test_exact_fraction_while_all_values_are_kept") {
+  IndexValueSample sample;
+  insertValues(sample, 0, 100);
+
+  double fraction = 0.0;
+  CHECK(sample.estimate(lessThan(25), fraction));
+  CHECK(fraction == 0.25);
+}
+
+SECTION("test_unmatched_values_are_rare_but_not_impossible") {
+  IndexValueSample sample;
+  insertValues(sample, 0, 100);
+
+  double fraction = 0.0;
+  CHECK(sample.estimate(lessThan(0), fraction));
+  CHECK(fraction > 0.0);
+  CHECK(fraction < 0.01);
+}
+
+SECTION("test_large_inputs_are_sampled_uniformly") {
+  IndexValueSample sample;
+  insertValues(sample, 0, 100000);
+
+  // a quarter of all values, with a generous margin for the randomness
+  double fraction = 0.0;
+  CHECK(sample.estimate(lessThan(25000), fraction));
+  CHECK(fraction > 0.1);
+  CHECK(fraction < 0.4);
+
+  // late values are sampled as well
+  CHECK(sample.estimate(
+      [](VPackSlice value) { return value.getUInt() >= 50000; }, fraction));
+  CHECK(fraction > 0.35);
+  CHECK(fraction < 0.65);
+}
+
+SECTION("test_clear_forgets_all_values") {
+  IndexValueSample sample;
+  insertValues(sample, 0, 100);
+  sample.clear();
+
+  double fraction = 0.0;
+  CHECK(!sample.estimate(lessThan(100), fraction));
+
+  insertValues(sample, 100, 200);
+  CHECK(sample.estimate(lessThan(100), fraction));
+  CHECK(fraction < 0.01);
+}
+
+  RandomGenerator::shutdown();
+}
@@ -0,0 +1,95 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+
+#include "catch.hpp"
+
+#include "Logger/LogAppenderFile.h"
+
+#include "Basics/FileUtils.h"
+#include "Basics/files.h"
+
+using namespace arangodb;
+
+static std::string logFilename() {
+  return TRI_GetTempPath() + TRI_DIR_SEPARATOR_STR + "arangotest-log-" +
+         std::to_string(static_cast<uint64_t>(TRI_microtime() * 1000000.0));
+}
+
+TEST_CASE("LogAppenderFileTest", "[logger]") {
+  std::string const filename = logFilename();
+
+SECTION("test_unbatched_messages") {
+  {
+    LogAppenderFile appender(filename, "");
+    appender.logMessage(LogLevel::INFO, "first", 0);
+    CHECK(basics::FileUtils::slurp(filename) == "first\n");
+  }
+  LogAppenderFile::close();
+  TRI_UnlinkFile(filename.c_str());
+}
+
+SECTION("test_batched_messages") {
+  {
+    LogAppenderFile appender(filename, "");
+    LogAppenderFile::beginBatch();
+    appender.logMessage(LogLevel::INFO, "first", 0);
+    appender.logMessage(LogLevel::INFO, "second\nline", 0);
+
+    // the output of a batch is written at its end
+    CHECK(basics::FileUtils::slurp(filename).empty());
+    LogAppenderFile::endBatch();
+    CHECK(basics::FileUtils::slurp(filename) == "first\nsecond\\nline\n");
+
+    // messages after the batch are written right away
+    appender.logMessage(LogLevel::INFO, "third", 0);
+    CHECK(basics::FileUtils::slurp(filename) ==
+          "first\nsecond\\nline\nthird\n");
+  }
+  LogAppenderFile::close();
+  TRI_UnlinkFile(filename.c_str());
+}
+
+SECTION("test_large_batches") {
+  {
+    LogAppenderFile appender(filename, "");
+    std::string const message(1000, 'x');
+
+    LogAppenderFile::beginBatch();
+    for (size_t i = 0; i < 100; ++i) {
+      appender.logMessage(LogLevel::INFO, message, 0);
+    }
+
+    // large output is written before the batch ends
+    size_t written = basics::FileUtils::slurp(filename).size();
+    CHECK(written > 0);
+    CHECK(written < 100 * (message.size() + 1));
+
+    LogAppenderFile::endBatch();
+    CHECK(basics::FileUtils::slurp(filename).size() ==
+          100 * (message.size() + 1));
+  }
+  LogAppenderFile::close();
+  TRI_UnlinkFile(filename.c_str());
+}
+
+}
@@ -0,0 +1,83 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+
+#include "catch.hpp"
+
+#include "Logger/LogThread.h"
+
+#include "Logger/Logger.h"
+
+using namespace arangodb;
+
+static std::unique_ptr<LogMessage> makeMessage(LogLevel level) {
+  return std::make_unique<LogMessage>(level, 0, std::string("test"), 0);
+}
+
+TEST_CASE("LogThreadTest", "[logger]") {
+
+SECTION("test_full_queue_drops_messages") {
+  LogThread thread("Logging");
+
+  // the thread is not running, so nothing is taken from the queue
+  size_t const maxQueued = LogThread::MaxQueuedMessages;
+  size_t queued = 0;
+  for (size_t i = 0; i < maxQueued; ++i) {
+    auto message = makeMessage(LogLevel::INFO);
+    if (LogThread::log(message) && message == nullptr) {
+      ++queued;
+    }
+  }
+  REQUIRE(queued == maxQueued);
+
+  // messages below WARN are dropped. the caller keeps them
+  auto message = makeMessage(LogLevel::INFO);
+  CHECK(LogThread::log(message));
+  CHECK(message != nullptr);
+
+  message = makeMessage(LogLevel::DEBUG);
+  CHECK(LogThread::log(message));
+  CHECK(message != nullptr);
+
+  // warnings and errors are still queued
+  for (LogLevel level : {LogLevel::WARN, LogLevel::ERR, LogLevel::FATAL}) {
+    message = makeMessage(level);
+    CHECK(LogThread::log(message));
+    CHECK(message == nullptr);
+  }
+
+  // the thread frees the remaining messages when it stops
+  REQUIRE(thread.start());
+}
+
+SECTION("test_queue_accepts_messages_again") {
+  // the messages of other threads were freed when they stopped
+  LogThread thread("Logging");
+
+  auto message = makeMessage(LogLevel::INFO);
+  CHECK(LogThread::log(message));
+  CHECK(message == nullptr);
+
+  REQUIRE(thread.start());
+}
+
+}
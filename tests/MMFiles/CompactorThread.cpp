@@ -0,0 +1,106 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite for arangodb::MMFilesCompactorThread
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "MMFiles/MMFilesCompactorThread.h"
+#include "Basics/Common.h"
+#include "VocBase/DatafileStatisticsContainer.h"
+
+#include "catch.hpp"
+
+using namespace arangodb;
+
+static DatafileStatisticsContainer makeStatistics(int64_t sizeAlive,
+                                                  int64_t sizeDead,
+                                                  int64_t numberUncollected) {
+  DatafileStatisticsContainer dfi;
+  dfi.sizeAlive = sizeAlive;
+  dfi.sizeDead = sizeDead;
+  dfi.numberUncollected = numberUncollected;
+  return dfi;
+}
+
+TEST_CASE("MMFilesCompactorThread", "[mmfiles]") {
+  SECTION("test compaction starts at the datafile with the most dead data") {
+    std::vector<DatafileStatisticsContainer> statistics;
+    statistics.emplace_back(makeStatistics(900, 100, 0));
+    statistics.emplace_back(makeStatistics(100, 900, 0));
+    statistics.emplace_back(makeStatistics(500, 500, 0));
+
+    CHECK(MMFilesCompactorThread::compactionStartIndex(statistics, 0, 100) == 1);
+    CHECK(MMFilesCompactorThread::compactionStartIndex(statistics, 2, 100) == 1);
+  }
+
+  SECTION("test the share of dead data decides, not its size") {
+    std::vector<DatafileStatisticsContainer> statistics;
+    statistics.emplace_back(makeStatistics(10000, 2000, 0));
+    statistics.emplace_back(makeStatistics(100, 1000, 0));
+
+    CHECK(MMFilesCompactorThread::compactionStartIndex(statistics, 0, 100) == 1);
+  }
+
+  SECTION("test datafiles with too little dead data are skipped") {
+    std::vector<DatafileStatisticsContainer> statistics;
+    statistics.emplace_back(makeStatistics(0, 50, 0));
+    statistics.emplace_back(makeStatistics(1000, 200, 0));
+
+    CHECK(MMFilesCompactorThread::compactionStartIndex(statistics, 0, 100) == 1);
+  }
+
+  SECTION("test datafiles with uncollected markers are skipped") {
+    std::vector<DatafileStatisticsContainer> statistics;
+    statistics.emplace_back(makeStatistics(0, 1000, 1));
+    statistics.emplace_back(makeStatistics(1000, 200, 0));
+
+    CHECK(MMFilesCompactorThread::compactionStartIndex(statistics, 0, 100) == 1);
+  }
+
+  SECTION("test compaction goes on round-robin if no datafile qualifies") {
+    std::vector<DatafileStatisticsContainer> statistics;
+    statistics.emplace_back(makeStatistics(1000, 10, 0));
+    statistics.emplace_back(makeStatistics(1000, 0, 0));
+
+    CHECK(MMFilesCompactorThread::compactionStartIndex(statistics, 1, 100) == 1);
+    CHECK(MMFilesCompactorThread::compactionStartIndex({}, 3, 100) == 3);
+  }
+
+  SECTION("test an unlimited write rate is never throttled") {
+    CHECK(MMFilesCompactorThread::throttleWait(1024 * 1024, 0.0, 0) == 0.0);
+  }
+
+  SECTION("test nothing written is never throttled") {
+    CHECK(MMFilesCompactorThread::throttleWait(0, 0.0, 1024) == 0.0);
+  }
+
+  SECTION("test throttling keeps the average write rate") {
+    // 4 MB at 1 MB/s take 4 s, one of which was already spent writing
+    CHECK(MMFilesCompactorThread::throttleWait(4 * 1024 * 1024, 1.0,
+                                               1024 * 1024) == 3.0);
+  }
+
+  SECTION("test slow compactions are not throttled") {
+    CHECK(MMFilesCompactorThread::throttleWait(1024 * 1024, 2.0,
+                                               1024 * 1024) == 0.0);
+  }
+}
@@ -0,0 +1,134 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "MMFiles/MMFilesDitch.h"
+#include "Basics/Common.h"
+
+#include "catch.hpp"
+
+using namespace arangodb;
+
+// the ditches never dereference their collection in these tests
+static LogicalCollection* const collection =
+    reinterpret_cast<LogicalCollection*>(uintptr_t(8));
+
+static MMFilesUnloadCollectionDitch* createUnloadDitch(
+    MMFilesDitches& ditches) {
+  return ditches.createMMFilesUnloadCollectionDitch(
+      collection, [](LogicalCollection*) { return true; }, __FILE__,
+      __LINE__);
+}
+
+TEST_CASE("MMFilesDitches", "[mmfiles]") {
+  SECTION("test document ditches are counted instead of linked") {
+    MMFilesDitches ditches(collection);
+    CHECK(ditches.head() == nullptr);
+
+    MMFilesDocumentDitch* ditch =
+        ditches.createMMFilesDocumentDitch(false, __FILE__, __LINE__);
+    REQUIRE(ditch != nullptr);
+    CHECK(ditches.numMMFilesDocumentMMFilesDitches() == 1);
+    CHECK(ditches.contains(MMFilesDitch::TRI_DITCH_DOCUMENT));
+    CHECK(std::string(ditches.head()) == "document-reference");
+
+    ditches.freeDitch(ditch);
+    CHECK(ditches.numMMFilesDocumentMMFilesDitches() == 0);
+    CHECK(!ditches.contains(MMFilesDitch::TRI_DITCH_DOCUMENT));
+    CHECK(ditches.head() == nullptr);
+  }
+
+  SECTION("test pinned documents block processing") {
+    MMFilesDitches ditches(collection);
+    MMFilesDitch* unload = createUnloadDitch(ditches);
+    REQUIRE(unload != nullptr);
+
+    size_t calls = 0;
+    auto callback = [&calls](MMFilesDitch const*) {
+      ++calls;
+      return true;
+    };
+
+    ditches.pinDocuments();
+    ditches.pinDocuments();
+    CHECK(ditches.contains(MMFilesDitch::TRI_DITCH_DOCUMENT));
+
+    bool popped = true;
+    CHECK(ditches.process(popped, callback) == nullptr);
+    CHECK(!popped);
+    CHECK(calls == 0);
+
+    // every pin must be released
+    ditches.releaseDocuments();
+    CHECK(ditches.process(popped, callback) == nullptr);
+    CHECK(calls == 0);
+
+    ditches.releaseDocuments();
+    CHECK(ditches.process(popped, callback) == unload);
+    CHECK(popped);
+    CHECK(calls == 1);
+    CHECK(ditches.head() == nullptr);
+    delete unload;
+  }
+
+  SECTION("test a later document ditch blocks processing") {
+    MMFilesDitches ditches(collection);
+    MMFilesDitch* unload = createUnloadDitch(ditches);
+    MMFilesDocumentDitch* document =
+        ditches.createMMFilesDocumentDitch(false, __FILE__, __LINE__);
+
+    // the head of the list is the unload ditch, the document ditch is not
+    // in the list
+    CHECK(std::string(ditches.head()) == "collection-unload");
+
+    bool popped = true;
+    CHECK(ditches.process(popped,
+                          [](MMFilesDitch const*) { return true; }) ==
+          nullptr);
+    CHECK(!popped);
+
+    ditches.freeMMFilesDocumentDitch(document, false);
+    CHECK(ditches.process(popped,
+                          [](MMFilesDitch const*) { return true; }) ==
+          unload);
+    CHECK(popped);
+    delete unload;
+  }
+
+  SECTION("test replication ditches block processing") {
+    MMFilesDitches ditches(collection);
+    MMFilesDitch* replication =
+        ditches.createMMFilesReplicationDitch(__FILE__, __LINE__);
+    createUnloadDitch(ditches);
+
+    CHECK(ditches.contains(MMFilesDitch::TRI_DITCH_REPLICATION));
+    CHECK(!ditches.contains(MMFilesDitch::TRI_DITCH_DOCUMENT));
+
+    bool popped = true;
+    CHECK(ditches.process(popped,
+                          [](MMFilesDitch const*) { return true; }) ==
+          nullptr);
+    CHECK(!popped);
+
+    ditches.freeDitch(replication);
+    CHECK(std::string(ditches.head()) == "collection-unload");
+    // the remaining ditch is freed with the ditches
+  }
+}
@@ -0,0 +1,154 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "MMFiles/MMFilesDocumentCache.h"
+#include "Basics/Common.h"
+#include "Cache/CacheManagerFeature.h"
+#include "Cache/Manager.h"
+
+#include "catch.hpp"
+
+#include <velocypack/Builder.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+
+static VPackBuilder makeDocument(std::string const& key, uint64_t value) {
+  VPackBuilder builder;
+  builder.openObject();
+  builder.add("_key", VPackValue(key));
+  builder.add("value", VPackValue(value));
+  builder.add("name", VPackValue("test" + key));
+  builder.close();
+  return builder;
+}
+
+TEST_CASE("MMFilesDocumentCache", "[mmfiles]") {
+  SECTION("test projections only contain the requested attributes") {
+    VPackBuilder document = makeDocument("test", 42);
+
+    VPackBuilder projection;
+    MMFilesDocumentCache::buildProjection(projection, document.slice(),
+                                          {"value", "missing"});
+    VPackSlice slice = projection.slice();
+    CHECK(slice.length() == 2);
+    CHECK(slice.get("value").getUInt() == 42);
+    CHECK(slice.get("missing").isNull());
+    CHECK(slice.get("name").isNone());
+  }
+
+  SECTION("test nothing is cached without a cache manager") {
+    REQUIRE(CacheManagerFeature::MANAGER == nullptr);
+    MMFilesDocumentCache documents;
+    VPackBuilder document = makeDocument("test", 1);
+
+    documents.store(StringRef("test"), {}, document.slice());
+    VPackBuilder result;
+    CHECK(!documents.lookup(StringRef("test"), {}, result));
+    CHECK(result.isEmpty());
+  }
+
+  cache::Manager manager(nullptr, 16 * 1024 * 1024);
+  CacheManagerFeature::MANAGER = &manager;
+
+  SECTION("test stored documents are found") {
+    MMFilesDocumentCache documents;
+    VPackBuilder document = makeDocument("test", 1);
+    VPackBuilder result;
+
+    // the cache is created by the first lookup
+    CHECK(!documents.lookup(StringRef("test"), {}, result));
+    documents.store(StringRef("test"), {}, document.slice());
+
+    CHECK(documents.lookup(StringRef("test"), {}, result));
+    CHECK(result.slice().get("value").getUInt() == 1);
+    CHECK(result.slice().get("name").copyString() == "testtest");
+
+    result.clear();
+    CHECK(!documents.lookup(StringRef("other"), {}, result));
+  }
+
+  SECTION("test projections are cached separately") {
+    MMFilesDocumentCache documents;
+    VPackBuilder document = makeDocument("test", 1);
+    VPackBuilder result;
+    std::vector<std::string> const projections{"value"};
+
+    CHECK(!documents.lookup(StringRef("test"), {}, result));
+    // projections are only known once they have been stored
+    CHECK(!documents.lookup(StringRef("test"), projections, result));
+    documents.store(StringRef("test"), projections, document.slice());
+
+    CHECK(documents.lookup(StringRef("test"), projections, result));
+    CHECK(result.slice().length() == 1);
+    CHECK(result.slice().get("value").getUInt() == 1);
+
+    // the full document was not stored
+    result.clear();
+    CHECK(!documents.lookup(StringRef("test"), {}, result));
+  }
+
+  SECTION("test only a limited number of projections is cached") {
+    MMFilesDocumentCache documents;
+    VPackBuilder document = makeDocument("test", 1);
+    VPackBuilder result;
+    CHECK(!documents.lookup(StringRef("test"), {}, result));
+
+    for (size_t i = 0; i <= MMFilesDocumentCache::MaxProjections; ++i) {
+      std::vector<std::string> projections{"value", std::to_string(i)};
+      documents.store(StringRef("test"), projections, document.slice());
+      result.clear();
+      CHECK(documents.lookup(StringRef("test"), projections, result) ==
+            (i < MMFilesDocumentCache::MaxProjections));
+    }
+  }
+
+  SECTION("test invalidated documents are not stored again by writers") {
+    MMFilesDocumentCache documents;
+    VPackBuilder document = makeDocument("test", 1);
+    std::vector<std::string> const projections{"value"};
+    VPackBuilder result;
+
+    CHECK(!documents.lookup(StringRef("test"), {}, result));
+    documents.store(StringRef("test"), {}, document.slice());
+    documents.store(StringRef("test"), projections, document.slice());
+
+    // a writer modifies the document
+    cache::Transaction* trx = manager.beginTransaction(false);
+    documents.invalidate(StringRef("test"));
+    CHECK(!documents.lookup(StringRef("test"), {}, result));
+    CHECK(!documents.lookup(StringRef("test"), projections, result));
+
+    // a reader cannot put back the old revision while the writer is active
+    documents.store(StringRef("test"), {}, document.slice());
+    CHECK(!documents.lookup(StringRef("test"), {}, result));
+    manager.endTransaction(trx);
+
+    VPackBuilder updated = makeDocument("test", 2);
+    trx = manager.beginTransaction(true);
+    documents.store(StringRef("test"), {}, updated.slice());
+    CHECK(documents.lookup(StringRef("test"), {}, result));
+    CHECK(result.slice().get("value").getUInt() == 2);
+    manager.endTransaction(trx);
+  }
+
+  CacheManagerFeature::MANAGER = nullptr;
+}
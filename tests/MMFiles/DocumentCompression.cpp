@@ -0,0 +1,142 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "MMFiles/MMFilesDocumentCompression.h"
+#include "Basics/Common.h"
+#include "Basics/Exceptions.h"
+
+#include "catch.hpp"
+
+#include <velocypack/Builder.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+
+static VPackBuilder makeDocument(std::string const& key, uint64_t value) {
+  VPackBuilder builder;
+  builder.openObject();
+  builder.add("_key", VPackValue(key));
+  builder.add("value", VPackValue(value));
+  builder.add("message", VPackValue(std::string(200, 'x')));
+  builder.close();
+  return builder;
+}
+
+static VPackBuilder compress(VPackSlice document) {
+  VPackBuilder builder;
+  MMFilesDocumentCompression::compress(document, builder);
+  return builder;
+}
+
+TEST_CASE("MMFilesDocumentCompression", "[mmfiles]") {
+  SECTION("test compressed documents decompress to the original") {
+    VPackBuilder document = makeDocument("test", 42);
+    VPackBuilder compressed = compress(document.slice());
+
+    CHECK(MMFilesDocumentCompression::isCompressed(compressed.slice().begin()));
+    CHECK(!MMFilesDocumentCompression::isCompressed(document.slice().begin()));
+    CHECK(compressed.slice().byteSize() < document.slice().byteSize());
+
+    VPackBuffer<uint8_t> buffer;
+    MMFilesDocumentCompression::decompress(compressed.slice().begin(), buffer);
+    REQUIRE(buffer.size() == document.slice().byteSize());
+    CHECK(memcmp(buffer.data(), document.slice().begin(), buffer.size()) == 0);
+  }
+
+  SECTION("test uncompressed documents are used in place") {
+    VPackBuilder document = makeDocument("test", 42);
+
+    VPackBuffer<uint8_t> buffer;
+    VPackSlice slice =
+        MMFilesDocumentCompression::document(document.slice().begin(), buffer);
+    CHECK(slice.begin() == document.slice().begin());
+    CHECK(buffer.size() == 0);
+
+    VPackBuilder compressed = compress(document.slice());
+    slice = MMFilesDocumentCompression::document(compressed.slice().begin(),
+                                                 buffer);
+    CHECK(slice.begin() == buffer.data());
+    CHECK(slice.get("value").getUInt() == 42);
+  }
+
+  SECTION("test corrupted documents are rejected") {
+    std::string garbage(64, '\xff');
+    VPackBuilder compressed;
+    compressed.add(VPackValuePair(garbage.data(), garbage.size(),
+                                  VPackValueType::Binary));
+
+    VPackBuffer<uint8_t> buffer;
+    CHECK_THROWS_AS(MMFilesDocumentCompression::decompress(
+                        compressed.slice().begin(), buffer),
+                    basics::Exception);
+  }
+}
+
+TEST_CASE("MMFilesDecompressedDocuments", "[mmfiles]") {
+  SECTION("test copies are shared by the readers of a revision") {
+    MMFilesDecompressedDocuments documents;
+    VPackBuilder compressed = compress(makeDocument("test", 1).slice());
+    uint8_t const* vpack = compressed.slice().begin();
+
+    uint8_t const* first = documents.lookup(1, vpack);
+    uint8_t const* second = documents.lookup(1, vpack);
+    CHECK(first == second);
+    CHECK(VPackSlice(first).get("value").getUInt() == 1);
+    CHECK(documents.size() == 1);
+    CHECK(documents.memoryUsage() == VPackSlice(first).byteSize());
+  }
+
+  SECTION("test a reused position keeps the copy of the old revision") {
+    MMFilesDecompressedDocuments documents;
+    VPackBuilder compressed = compress(makeDocument("test", 1).slice());
+    uint8_t const* vpack = compressed.slice().begin();
+    uint8_t const* first = documents.lookup(1, vpack);
+
+    // the position now contains another revision of the same size
+    VPackBuilder other = compress(makeDocument("test", 2).slice());
+    REQUIRE(other.slice().byteSize() == compressed.slice().byteSize());
+    memcpy(const_cast<uint8_t*>(vpack), other.slice().begin(),
+           other.slice().byteSize());
+
+    uint8_t const* second = documents.lookup(2, vpack);
+    CHECK(first != second);
+    CHECK(VPackSlice(second).get("value").getUInt() == 2);
+    // a reader of the old revision may still use its copy
+    CHECK(VPackSlice(first).get("value").getUInt() == 1);
+    CHECK(documents.size() == 1);
+  }
+
+  SECTION("test copies are only released when allowed") {
+    MMFilesDecompressedDocuments documents;
+    VPackBuilder compressed = compress(makeDocument("test", 1).slice());
+    documents.lookup(1, compressed.slice().begin());
+
+    CHECK(!documents.release([]() { return false; }));
+    CHECK(documents.size() == 1);
+
+    CHECK(documents.release([]() { return true; }));
+    CHECK(documents.size() == 0);
+    CHECK(documents.memoryUsage() == 0);
+
+    // nothing left to release
+    CHECK(!documents.release([]() { return true; }));
+  }
+}
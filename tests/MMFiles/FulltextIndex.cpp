@@ -0,0 +1,144 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite for the fulltext index
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "MMFiles/fulltext-index.h"
+#include "Basics/Common.h"
+#include "Basics/tri-strings.h"
+#include "MMFiles/fulltext-query.h"
+#include "MMFiles/fulltext-result.h"
+#include "StorageEngine/DocumentIdentifierToken.h"
+
+#include "catch.hpp"
+
+/// @brief builds a query for complete matches of already normalized words
+static TRI_fulltext_query_t* makeQuery(
+    std::vector<std::pair<std::string, TRI_fulltext_query_operation_e>> const&
+        words,
+    size_t maxResults) {
+  TRI_fulltext_query_t* query =
+      TRI_CreateQueryMMFilesFulltextIndex(words.size(), maxResults);
+  for (size_t i = 0; i < words.size(); ++i) {
+    query->_words[i] =
+        TRI_DuplicateString(TRI_UNKNOWN_MEM_ZONE, words[i].first.c_str());
+    query->_matches[i] = TRI_FULLTEXT_COMPLETE;
+    query->_operations[i] = words[i].second;
+  }
+  return query;
+}
+
+static void insert(TRI_fts_index_t* index, TRI_voc_rid_t revisionId,
+                   std::vector<std::string> words) {
+  REQUIRE(TRI_InsertWordsMMFilesFulltextIndex(index, revisionId, words));
+}
+
+static double idf(double numDocuments, double df) {
+  return std::log(1.0 + (numDocuments - df + 0.5) / (df + 0.5));
+}
+
+TEST_CASE("MMFilesFulltextIndex", "[mmfiles]") {
+  TRI_fts_index_t* index = TRI_CreateFtsIndex(2048, 1, 1);
+  REQUIRE(index != nullptr);
+
+  insert(index, 1, {"apple", "banana"});
+  insert(index, 2, {"apple"});
+  insert(index, 3, {"apple", "cherry"});
+  insert(index, 4, {"banana"});
+  insert(index, 5, {"date"});
+
+  SECTION("test scored results are ordered by descending score") {
+    TRI_fulltext_result_t* result = TRI_QueryScoredMMFilesFulltextIndex(
+        index,
+        makeQuery({{"apple", TRI_FULLTEXT_AND}, {"banana", TRI_FULLTEXT_OR}},
+                  0));
+    REQUIRE(result != nullptr);
+    REQUIRE(result->_numDocuments == 4);
+    REQUIRE(result->_scores != nullptr);
+
+    // the rarer word is worth more. ties are ordered by insertion
+    CHECK(result->_documents[0] == 1);
+    CHECK(result->_documents[1] == 4);
+    CHECK(result->_documents[2] == 2);
+    CHECK(result->_documents[3] == 3);
+
+    CHECK(result->_scores[0] == Approx(idf(5, 3) + idf(5, 2)));
+    CHECK(result->_scores[1] == Approx(idf(5, 2)));
+    CHECK(result->_scores[2] == Approx(idf(5, 3)));
+    CHECK(result->_scores[3] == Approx(idf(5, 3)));
+
+    TRI_FreeResultMMFilesFulltextIndex(result);
+  }
+
+  SECTION("test scored results are limited to the top documents") {
+    TRI_fulltext_result_t* result = TRI_QueryScoredMMFilesFulltextIndex(
+        index,
+        makeQuery({{"apple", TRI_FULLTEXT_AND}, {"banana", TRI_FULLTEXT_OR}},
+                  2));
+    REQUIRE(result != nullptr);
+    REQUIRE(result->_numDocuments == 2);
+    CHECK(result->_documents[0] == 1);
+    CHECK(result->_documents[1] == 4);
+
+    TRI_FreeResultMMFilesFulltextIndex(result);
+  }
+
+  SECTION("test excluded words do not contribute to the score") {
+    TRI_fulltext_result_t* result = TRI_QueryScoredMMFilesFulltextIndex(
+        index, makeQuery({{"apple", TRI_FULLTEXT_AND},
+                          {"cherry", TRI_FULLTEXT_EXCLUDE}},
+                         0));
+    REQUIRE(result != nullptr);
+    REQUIRE(result->_numDocuments == 2);
+    CHECK(result->_documents[0] == 1);
+    CHECK(result->_documents[1] == 2);
+    CHECK(result->_scores[0] == Approx(idf(5, 3)));
+    CHECK(result->_scores[1] == Approx(idf(5, 3)));
+
+    TRI_FreeResultMMFilesFulltextIndex(result);
+  }
+
+  SECTION("test deleted documents are not returned") {
+    TRI_DeleteDocumentMMFilesFulltextIndex(index, 1);
+
+    TRI_fulltext_result_t* result = TRI_QueryScoredMMFilesFulltextIndex(
+        index, makeQuery({{"banana", TRI_FULLTEXT_AND}}, 0));
+    REQUIRE(result != nullptr);
+    REQUIRE(result->_numDocuments == 1);
+    CHECK(result->_documents[0] == 4);
+
+    TRI_FreeResultMMFilesFulltextIndex(result);
+  }
+
+  SECTION("test unscored queries have no scores") {
+    TRI_fulltext_result_t* result = TRI_QueryMMFilesFulltextIndex(
+        index, makeQuery({{"apple", TRI_FULLTEXT_AND}}, 0));
+    REQUIRE(result != nullptr);
+    CHECK(result->_numDocuments == 3);
+    CHECK(result->_scores == nullptr);
+
+    TRI_FreeResultMMFilesFulltextIndex(result);
+  }
+
+  TRI_FreeFtsIndex(index);
+}
@@ -0,0 +1,113 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite for the fulltext index lists
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "MMFiles/fulltext-list.h"
+#include "Basics/Common.h"
+
+#include "catch.hpp"
+
+static TRI_fulltext_list_t* makeList(
+    std::vector<TRI_fulltext_list_entry_t> const& entries) {
+  TRI_fulltext_list_t* list = TRI_CreateListMMFilesFulltextIndex(0);
+  for (auto const& entry : entries) {
+    list = TRI_InsertListMMFilesFulltextIndex(list, entry);
+  }
+  return list;
+}
+
+static std::vector<TRI_fulltext_list_entry_t> entries(
+    TRI_fulltext_list_t* list) {
+  TRI_fulltext_list_entry_t const* start =
+      TRI_StartListMMFilesFulltextIndex(list);
+  std::vector<TRI_fulltext_list_entry_t> result(
+      start, start + TRI_NumEntriesListMMFilesFulltextIndex(list));
+  TRI_FreeListMMFilesFulltextIndex(list);
+  return result;
+}
+
+TEST_CASE("MMFilesFulltextList", "[mmfiles]") {
+  SECTION("test intersecting lists of similar size merges them") {
+    TRI_fulltext_list_t* result = TRI_IntersectListMMFilesFulltextIndex(
+        makeList({5, 1, 3, 7, 9}), makeList({2, 3, 4, 9, 10}));
+    CHECK(entries(result) == std::vector<TRI_fulltext_list_entry_t>({3, 9}));
+  }
+
+  SECTION("test intersecting a small with a big list") {
+    std::vector<TRI_fulltext_list_entry_t> big;
+    for (TRI_fulltext_list_entry_t i = 1000; i > 0; --i) {
+      big.emplace_back(i);
+    }
+
+    TRI_fulltext_list_t* result = TRI_IntersectListMMFilesFulltextIndex(
+        makeList({999, 1, 500, 2000, 37}), makeList(big));
+    CHECK(entries(result) ==
+          std::vector<TRI_fulltext_list_entry_t>({1, 37, 500, 999}));
+
+    // the order of the arguments does not matter
+    result = TRI_IntersectListMMFilesFulltextIndex(
+        makeList(big), makeList({1000, 2000, 3000}));
+    CHECK(entries(result) == std::vector<TRI_fulltext_list_entry_t>({1000}));
+  }
+
+  SECTION("test intersecting with a list without common entries") {
+    std::vector<TRI_fulltext_list_entry_t> big;
+    for (TRI_fulltext_list_entry_t i = 1; i <= 1000; ++i) {
+      big.emplace_back(i * 2);
+    }
+
+    TRI_fulltext_list_t* result = TRI_IntersectListMMFilesFulltextIndex(
+        makeList({1, 3, 1999, 2001}), makeList(big));
+    CHECK(entries(result).empty());
+  }
+
+  SECTION("test duplicates are only returned once") {
+    std::vector<TRI_fulltext_list_entry_t> big;
+    for (TRI_fulltext_list_entry_t i = 1; i <= 100; ++i) {
+      big.emplace_back(i);
+    }
+
+    TRI_fulltext_list_t* result = TRI_IntersectListMMFilesFulltextIndex(
+        makeList({4, 4, 8}), makeList(big));
+    CHECK(entries(result) == std::vector<TRI_fulltext_list_entry_t>({4, 8}));
+  }
+
+  SECTION("test excluding an unsorted list") {
+    std::vector<TRI_fulltext_list_entry_t> values;
+    for (TRI_fulltext_list_entry_t i = 1; i <= 100; ++i) {
+      values.emplace_back(i);
+    }
+
+    TRI_fulltext_list_t* result = TRI_ExcludeListMMFilesFulltextIndex(
+        makeList(values), makeList({90, 3, 50, 200, 1}));
+    std::vector<TRI_fulltext_list_entry_t> remaining = entries(result);
+    CHECK(remaining.size() == 96);
+    CHECK(std::find(remaining.begin(), remaining.end(), 1) == remaining.end());
+    CHECK(std::find(remaining.begin(), remaining.end(), 3) == remaining.end());
+    CHECK(std::find(remaining.begin(), remaining.end(), 50) == remaining.end());
+    CHECK(std::find(remaining.begin(), remaining.end(), 90) == remaining.end());
+    CHECK(remaining.front() == 2);
+    CHECK(remaining.back() == 100);
+  }
+}
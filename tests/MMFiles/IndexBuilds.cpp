@@ -0,0 +1,161 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "MMFiles/MMFilesIndexBuilds.h"
+#include "Basics/Common.h"
+
+#include "catch.hpp"
+
+#include <velocypack/Builder.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+
+static VPackBuilder makeDocument(std::string const& key) {
+  VPackBuilder builder;
+  builder.openObject();
+  builder.add("_key", VPackValue(key));
+  builder.close();
+  return builder;
+}
+
+// the builds only compare the transactions, they never use them
+static transaction::Methods const* trx(uintptr_t id) {
+  return reinterpret_cast<transaction::Methods const*>(id);
+}
+
+TEST_CASE("MMFilesIndexBuilds", "[mmfiles]") {
+  VPackBuilder document = makeDocument("test");
+
+  SECTION("test operations are only captured during a build") {
+    MMFilesIndexBuilds builds;
+    CHECK(builds.empty());
+
+    builds.capture(1, document.slice(), true);
+    auto build = builds.add(trx(1));
+    CHECK(!builds.empty());
+
+    builds.capture(2, document.slice(), true);
+    builds.capture(3, document.slice(), false);
+
+    MMFilesIndexBuilds::Changes changes;
+    REQUIRE(build->takeChanges(changes, 0));
+    REQUIRE(changes.size() == 2);
+    CHECK(changes[0] == std::make_pair(TRI_voc_rid_t(2), true));
+    CHECK(changes[1] == std::make_pair(TRI_voc_rid_t(3), false));
+
+    builds.remove(build);
+    CHECK(builds.empty());
+  }
+
+  SECTION("test changes are taken once") {
+    MMFilesIndexBuilds builds;
+    auto build = builds.add(trx(1));
+    builds.capture(1, document.slice(), true);
+
+    MMFilesIndexBuilds::Changes changes;
+    REQUIRE(build->takeChanges(changes, 0));
+    CHECK(changes.size() == 1);
+
+    // nothing left
+    CHECK(!build->takeChanges(changes, 0));
+
+    builds.capture(2, document.slice(), true);
+    REQUIRE(build->takeChanges(changes, 0));
+    REQUIRE(changes.size() == 1);
+    CHECK(changes[0].first == 2);
+  }
+
+  SECTION("test few changes are left for the write lock") {
+    MMFilesIndexBuilds builds;
+    auto build = builds.add(trx(1));
+    for (TRI_voc_rid_t rid = 1; rid <= 3; ++rid) {
+      builds.capture(rid, document.slice(), true);
+    }
+
+    MMFilesIndexBuilds::Changes changes;
+    CHECK(!build->takeChanges(changes, 3));
+    CHECK(changes.empty());
+    CHECK(build->takeChanges(changes, 2));
+    CHECK(changes.size() == 3);
+  }
+
+  SECTION("test every build captures the operations") {
+    MMFilesIndexBuilds builds;
+    auto first = builds.add(trx(1));
+    builds.capture(1, document.slice(), true);
+    auto second = builds.add(trx(2));
+    builds.capture(2, document.slice(), false);
+
+    MMFilesIndexBuilds::Changes changes;
+    REQUIRE(first->takeChanges(changes, 0));
+    CHECK(changes.size() == 2);
+    REQUIRE(second->takeChanges(changes, 0));
+    REQUIRE(changes.size() == 1);
+    CHECK(changes[0].first == 2);
+
+    builds.remove(first);
+    CHECK(!builds.empty());
+    builds.capture(3, document.slice(), true);
+    REQUIRE(second->takeChanges(changes, 0));
+    CHECK(changes[0].first == 3);
+  }
+
+  SECTION("test removed documents are kept for the builds") {
+    MMFilesIndexBuilds builds;
+    auto build = builds.add(trx(1));
+
+    {
+      // the document is gone after the operation
+      VPackBuilder removed = makeDocument("removed");
+      builds.capture(5, removed.slice(), false);
+    }
+    builds.capture(6, document.slice(), true);
+
+    uint8_t const* vpack = builds.lookupRemoved(trx(1), 5);
+    REQUIRE(vpack != nullptr);
+    CHECK(VPackSlice(vpack).get("_key").copyString() == "removed");
+
+    // inserted documents are read from the collection
+    CHECK(builds.lookupRemoved(trx(1), 6) == nullptr);
+    // other transactions do not see removed documents
+    CHECK(builds.lookupRemoved(trx(2), 5) == nullptr);
+  }
+
+  SECTION("test removed documents are freed with the last build") {
+    MMFilesIndexBuilds builds;
+    auto first = builds.add(trx(1));
+    auto second = builds.add(trx(2));
+    builds.capture(5, document.slice(), false);
+
+    builds.remove(first);
+    CHECK(builds.lookupRemoved(trx(1), 5) == nullptr);
+    CHECK(builds.lookupRemoved(trx(2), 5) != nullptr);
+
+    builds.remove(second);
+    CHECK(builds.empty());
+
+    // a later build does not see the documents of the earlier ones
+    auto third = builds.add(trx(2));
+    CHECK(builds.lookupRemoved(trx(2), 5) == nullptr);
+    builds.remove(third);
+  }
+}
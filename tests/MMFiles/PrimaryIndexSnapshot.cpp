@@ -0,0 +1,155 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "MMFiles/MMFilesPrimaryIndexSnapshot.h"
+#include "Basics/Common.h"
+
+#include "catch.hpp"
+
+#include <velocypack/Builder.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+
+// a snapshot of a collection with a datafile and a journal, as written
+// when the collection is closed
+static MMFilesPrimaryIndexSnapshot makeSnapshot() {
+  MMFilesPrimaryIndexSnapshot snapshot;
+  snapshot.lastRevision = 1234567;
+  snapshot.maxTick = 98765;
+
+  MMFilesPrimaryIndexSnapshot::Datafile datafile{
+      17, 32768, 100, 5000, 120, 4900, 40, 3, 2, 4096, 512};
+  MMFilesPrimaryIndexSnapshot::Datafile journal{
+      18, 1024, 5001, 98765, 5002, 98765, 2, 0, 0, 256, 0};
+  snapshot.datafiles.emplace_back(datafile);
+  snapshot.datafiles.emplace_back(journal);
+
+  MMFilesPrimaryIndexSnapshot::Documents documents{17, {}};
+  for (uint64_t i = 0; i < 40; ++i) {
+    documents.offsets.emplace_back(64 + i * 128);
+  }
+  snapshot.documents.emplace_back(documents);
+  snapshot.documents.emplace_back(
+      MMFilesPrimaryIndexSnapshot::Documents{18, {80, 336}});
+
+  return snapshot;
+}
+
+TEST_CASE("MMFilesPrimaryIndexSnapshotTest", "[mmfiles]") {
+
+SECTION("test_reopen_restores_tick_and_count") {
+  MMFilesPrimaryIndexSnapshot const written = makeSnapshot();
+  VPackBuilder builder;
+  written.toVelocyPack(builder);
+
+  MMFilesPrimaryIndexSnapshot read;
+  REQUIRE(read.fromVelocyPack(builder.slice()));
+
+  // WAL recovery relies on the tick to skip markers already in datafiles
+  CHECK(read.maxTick == 98765);
+  CHECK(read.lastRevision == 1234567);
+  CHECK(read.numberOfDocuments() == 42);
+
+  REQUIRE(read.datafiles.size() == 2);
+  CHECK(read.datafiles[1].fid == 18);
+  CHECK(read.datafiles[1].size == 1024);
+  CHECK(read.datafiles[1].tickMax == 98765);
+  CHECK(read.datafiles[0].numberAlive == 40);
+  CHECK(read.datafiles[0].sizeDead == 512);
+
+  REQUIRE(read.documents.size() == 2);
+  CHECK(read.documents[0].offsets == written.documents[0].offsets);
+  CHECK(read.documents[1].offsets == written.documents[1].offsets);
+}
+
+SECTION("test_empty_collection") {
+  MMFilesPrimaryIndexSnapshot written;
+  written.maxTick = 42;
+  VPackBuilder builder;
+  written.toVelocyPack(builder);
+
+  MMFilesPrimaryIndexSnapshot read;
+  REQUIRE(read.fromVelocyPack(builder.slice()));
+  CHECK(read.maxTick == 42);
+  CHECK(read.numberOfDocuments() == 0);
+}
+
+SECTION("test_snapshot_without_tick_is_not_used") {
+  // snapshots of version 1 did not store the tick
+  VPackBuilder builder;
+  builder.openObject();
+  builder.add("version", VPackValue(1));
+  builder.add("lastRevision", VPackValue(1234567));
+  builder.add("datafiles", VPackValue(VPackValueType::Array));
+  builder.close();
+  builder.add("documents", VPackValue(VPackValueType::Array));
+  builder.close();
+  builder.close();
+
+  MMFilesPrimaryIndexSnapshot read;
+  CHECK(!read.fromVelocyPack(builder.slice()));
+}
+
+SECTION("test_malformed_snapshot_is_not_used") {
+  MMFilesPrimaryIndexSnapshot read;
+
+  VPackBuilder builder;
+  builder.add(VPackValue(VPackValueType::Array));
+  builder.close();
+  CHECK(!read.fromVelocyPack(builder.slice()));
+
+  // a datafile entry with a missing statistics value
+  builder.clear();
+  builder.openObject();
+  builder.add("version", VPackValue(MMFilesPrimaryIndexSnapshot::Version));
+  builder.add("maxTick", VPackValue(1));
+  builder.add("datafiles", VPackValue(VPackValueType::Array));
+  builder.openArray();
+  for (int i = 0; i < 10; ++i) {
+    builder.add(VPackValue(i));
+  }
+  builder.close();
+  builder.close();
+  builder.add("documents", VPackValue(VPackValueType::Array));
+  builder.close();
+  builder.close();
+  CHECK(!read.fromVelocyPack(builder.slice()));
+
+  // document offsets that are not numbers
+  builder.clear();
+  builder.openObject();
+  builder.add("version", VPackValue(MMFilesPrimaryIndexSnapshot::Version));
+  builder.add("datafiles", VPackValue(VPackValueType::Array));
+  builder.close();
+  builder.add("documents", VPackValue(VPackValueType::Array));
+  builder.openArray();
+  builder.add(VPackValue(17));
+  builder.openArray();
+  builder.add(VPackValue("foo"));
+  builder.close();
+  builder.close();
+  builder.close();
+  builder.close();
+  CHECK(!read.fromVelocyPack(builder.slice()));
+}
+
+}
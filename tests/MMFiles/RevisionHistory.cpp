@@ -0,0 +1,174 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite for arangodb::MMFilesRevisionHistory
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "MMFiles/MMFilesRevisionHistory.h"
+#include "Basics/Common.h"
+
+#include "catch.hpp"
+
+#include <velocypack/Builder.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+
+static VPackBuilder makeDocument(uint64_t value) {
+  VPackBuilder builder;
+  builder.openObject();
+  builder.add("_key", VPackValue("test"));
+  builder.add("value", VPackValue(value));
+  builder.close();
+  return builder;
+}
+
+static uint64_t valueOf(MMFilesRevisionHistory::Document const& document) {
+  return VPackSlice(document.vpack->data()).get("value").getUInt();
+}
+
+TEST_CASE("MMFilesRevisionHistory", "[mmfiles]") {
+  StringRef const key("test");
+
+  SECTION("test pending modifications are invisible") {
+    MMFilesRevisionHistory history;
+    MMFilesRevisionHistory::Document document;
+
+    REQUIRE(!history.lookup(key, 100, document));
+
+    VPackBuilder old = makeDocument(1);
+    REQUIRE(history.record(10, key, old.slice(), 1));
+    // only the first modification of a transaction is recorded
+    VPackBuilder old2 = makeDocument(2);
+    REQUIRE(!history.record(10, key, old2.slice(), 2));
+
+    REQUIRE(history.lookup(key, 100, document));
+    REQUIRE(1 == document.revisionId);
+    REQUIRE(1 == valueOf(document));
+
+    history.commit(10, key.toString(), 50);
+    // snapshots taken after the commit see the current revision
+    REQUIRE(!history.lookup(key, 100, document));
+    REQUIRE(history.lookup(key, 49, document));
+    REQUIRE(1 == valueOf(document));
+  }
+
+  SECTION("test inserted documents are absent from older snapshots") {
+    MMFilesRevisionHistory history;
+    MMFilesRevisionHistory::Document document;
+
+    REQUIRE(history.record(10, key, VPackSlice(), 0));
+    REQUIRE(history.lookup(key, 100, document));
+    REQUIRE(nullptr == document.vpack);
+    REQUIRE(0 == document.revisionId);
+
+    history.abort(10, key.toString());
+    REQUIRE(!history.lookup(key, 100, document));
+    REQUIRE(0 == history.size());
+  }
+
+  SECTION("test failed inserts are not recorded") {
+    MMFilesRevisionHistory history;
+    MMFilesRevisionHistory::Document document;
+
+    // the document exists, and a snapshot is taken
+    TRI_voc_tick_t const snapshot = 100;
+
+    // an insert of the same key fails on the unique constraint of the
+    // primary index, before anything is recorded. the snapshot must see
+    // the existing document, not a "did not exist" entry
+    REQUIRE(!history.lookup(key, snapshot, document));
+    REQUIRE(0 == history.size());
+
+    // an insert that succeeds is recorded, and removed again when its
+    // transaction is rolled back
+    REQUIRE(history.record(20, key, VPackSlice(), 0));
+    REQUIRE(history.lookup(key, snapshot, document));
+    REQUIRE(nullptr == document.vpack);
+    history.abort(20, key.toString());
+    REQUIRE(!history.lookup(key, snapshot, document));
+    REQUIRE(0 == history.size());
+
+    // a transaction that updates the document and then fails to insert it
+    // again keeps the version from before its first modification
+    VPackBuilder v1 = makeDocument(1);
+    REQUIRE(history.record(30, key, v1.slice(), 1));
+    REQUIRE(history.lookup(key, snapshot, document));
+    REQUIRE(1 == valueOf(document));
+    history.abort(30, key.toString());
+    REQUIRE(0 == history.size());
+  }
+
+  SECTION("test snapshots see the first invisible write") {
+    MMFilesRevisionHistory history;
+    MMFilesRevisionHistory::Document document;
+
+    VPackBuilder v1 = makeDocument(1);
+    VPackBuilder v2 = makeDocument(2);
+    history.record(10, key, v1.slice(), 1);
+    history.commit(10, key.toString(), 20);
+    history.record(30, key, v2.slice(), 2);
+    history.commit(30, key.toString(), 40);
+
+    REQUIRE(history.lookup(key, 10, document));
+    REQUIRE(1 == valueOf(document));
+    REQUIRE(history.lookup(key, 25, document));
+    REQUIRE(2 == valueOf(document));
+    REQUIRE(!history.lookup(key, 45, document));
+  }
+
+  SECTION("test pruning keeps versions visible to active snapshots") {
+    MMFilesRevisionHistory history;
+    MMFilesRevisionHistory::Document document;
+
+    VPackBuilder v1 = makeDocument(1);
+    VPackBuilder v2 = makeDocument(2);
+    history.record(10, key, v1.slice(), 1);
+    history.commit(10, key.toString(), 20);
+    history.record(30, key, v2.slice(), 2);
+
+    history.prune(25);
+    REQUIRE(1 == history.size());
+    // the pending write is never pruned
+    REQUIRE(history.lookup(key, 25, document));
+    REQUIRE(2 == valueOf(document));
+
+    history.commit(30, key.toString(), 40);
+    history.prune(0);
+    REQUIRE(0 == history.size());
+  }
+
+  SECTION("test snapshot ticks") {
+    REQUIRE(!MMFilesSnapshots::active());
+    TRI_voc_tick_t first = MMFilesSnapshots::acquire();
+    TRI_voc_tick_t second = MMFilesSnapshots::acquire();
+    REQUIRE(first < second);
+    REQUIRE(MMFilesSnapshots::active());
+    REQUIRE(first == MMFilesSnapshots::oldest());
+
+    MMFilesSnapshots::release(first);
+    REQUIRE(second == MMFilesSnapshots::oldest());
+    MMFilesSnapshots::release(second);
+    REQUIRE(0 == MMFilesSnapshots::oldest());
+    REQUIRE(!MMFilesSnapshots::active());
+  }
+}
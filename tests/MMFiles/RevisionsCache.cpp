@@ -0,0 +1,72 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite for arangodb::MMFilesRevisionsCache
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "MMFiles/MMFilesRevisionsCache.h"
+#include "Basics/Common.h"
+
+#include "catch.hpp"
+
+using namespace arangodb;
+
+TEST_CASE("MMFilesRevisionsCache", "[mmfiles]") {
+  SECTION("test batch lookups find the same positions as single lookups") {
+    MMFilesRevisionsCache cache;
+    std::vector<uint8_t> data(1000);
+
+    for (TRI_voc_rid_t rid = 1; rid <= 1000; rid += 2) {
+      cache.insert(rid, data.data() + rid - 1, 1, false, true);
+    }
+
+    std::vector<TRI_voc_rid_t> revisionIds;
+    for (TRI_voc_rid_t rid = 1000; rid > 0; --rid) {
+      revisionIds.emplace_back(rid);
+    }
+
+    std::vector<MMFilesDocumentPosition> positions;
+    cache.lookup(revisionIds, positions);
+    REQUIRE(revisionIds.size() == positions.size());
+
+    for (size_t i = 0; i < revisionIds.size(); ++i) {
+      TRI_voc_rid_t rid = revisionIds[i];
+      MMFilesDocumentPosition single = cache.lookup(rid);
+      if (rid % 2 == 1) {
+        REQUIRE(static_cast<bool>(positions[i]));
+        REQUIRE(rid == positions[i].revisionId());
+        REQUIRE(data.data() + rid - 1 == positions[i].dataptr());
+        REQUIRE(single == positions[i]);
+      } else {
+        REQUIRE(!positions[i]);
+        REQUIRE(!single);
+      }
+    }
+  }
+
+  SECTION("test batch lookups of no revisions") {
+    MMFilesRevisionsCache cache;
+    std::vector<MMFilesDocumentPosition> positions(3);
+    cache.lookup(std::vector<TRI_voc_rid_t>(), positions);
+    REQUIRE(positions.empty());
+  }
+}
@@ -0,0 +1,226 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "MMFiles/MMFilesSkiplist.h"
+#include "Basics/Common.h"
+#include "Random/RandomGenerator.h"
+
+#include "catch.hpp"
+
+using namespace arangodb;
+
+namespace {
+
+/// @brief an element with a value for the preorder and an id which makes
+/// the total order proper
+struct Element {
+  int value;
+  int id;
+};
+
+static int cmpElmElm(void*, Element const* lhs, Element const* rhs,
+                     MMFilesSkiplistCmpType cmpType) {
+  if (lhs->value != rhs->value) {
+    return lhs->value < rhs->value ? -1 : 1;
+  }
+  if (cmpType == SKIPLIST_CMP_PREORDER || lhs->id == rhs->id) {
+    return 0;
+  }
+  return lhs->id < rhs->id ? -1 : 1;
+}
+
+static int cmpKeyElm(void*, int const* key, Element const* elm) {
+  if (*key != elm->value) {
+    return *key < elm->value ? -1 : 1;
+  }
+  return 0;
+}
+
+typedef MMFilesSkiplist<int, Element> Skiplist;
+
+static Skiplist* create(bool unique) {
+  return new Skiplist(cmpElmElm, cmpKeyElm, nullptr, unique, false);
+}
+
+static std::vector<Element*> pointers(std::vector<Element>& elements) {
+  std::vector<Element*> result;
+  for (auto& it : elements) {
+    result.emplace_back(&it);
+  }
+  return result;
+}
+
+/// @brief the ids of all documents, walking forward
+static std::vector<int> forward(Skiplist const& list) {
+  std::vector<int> result;
+  auto node = list.nextNode(list.startNode());
+  while (node != nullptr) {
+    result.emplace_back(node->document()->id);
+    node = list.nextNode(node);
+  }
+  return result;
+}
+
+/// @brief the ids of all documents, walking backward
+static std::vector<int> backward(Skiplist const& list) {
+  std::vector<int> result;
+  auto node = list.prevNode(nullptr);
+  while (node != list.startNode()) {
+    result.emplace_back(node->document()->id);
+    node = list.prevNode(node);
+  }
+  std::reverse(result.begin(), result.end());
+  return result;
+}
+
+}  // namespace
+
+TEST_CASE("MMFilesSkiplist", "[mmfiles]") {
+  RandomGenerator::initialize(RandomGenerator::RandomType::MERSENNE);
+
+  SECTION("test bulk inserted documents are sorted and found") {
+    std::vector<Element> elements;
+    for (int i = 0; i < 1000; ++i) {
+      // values in a scrambled order, with ids matching the sorted order
+      int value = (i * 389) % 1000;
+      elements.push_back(Element{value, value});
+    }
+    std::vector<Element*> docs = pointers(elements);
+
+    std::unique_ptr<Skiplist> list(create(false));
+    CHECK(list->bulkInsert(nullptr, docs) == TRI_ERROR_NO_ERROR);
+    CHECK(list->getNrUsed() == 1000);
+
+    std::vector<int> expected;
+    for (int i = 0; i < 1000; ++i) {
+      expected.emplace_back(i);
+    }
+    CHECK(forward(*list) == expected);
+    CHECK(backward(*list) == expected);
+
+    // lookups descend through the towers built by the bulk load
+    for (auto const& it : elements) {
+      auto node = list->lookup(nullptr, &it);
+      REQUIRE(node != nullptr);
+      CHECK(node->document() == &it);
+
+      auto left = list->leftKeyLookup(nullptr, &it.value);
+      CHECK(list->nextNode(left)->document() == &it);
+    }
+  }
+
+  SECTION("test bulk inserted documents are merged with existing ones") {
+    std::vector<Element> existing;
+    std::vector<Element> added;
+    for (int i = 0; i < 500; ++i) {
+      existing.push_back(Element{2 * i, 2 * i});
+      added.push_back(Element{2 * i + 1, 2 * i + 1});
+    }
+    // documents before and after all existing ones
+    added.push_back(Element{-1, -1});
+    added.push_back(Element{1000, 1000});
+
+    std::unique_ptr<Skiplist> list(create(false));
+    for (auto& it : existing) {
+      REQUIRE(list->insert(nullptr, &it) == TRI_ERROR_NO_ERROR);
+    }
+
+    std::vector<Element*> docs = pointers(added);
+    CHECK(list->bulkInsert(nullptr, docs) == TRI_ERROR_NO_ERROR);
+    CHECK(list->getNrUsed() == 1002);
+
+    std::vector<int> expected;
+    for (int i = -1; i <= 1000; ++i) {
+      expected.emplace_back(i);
+    }
+    CHECK(forward(*list) == expected);
+    CHECK(backward(*list) == expected);
+
+    for (auto const& it : added) {
+      CHECK(list->lookup(nullptr, &it) != nullptr);
+    }
+    for (auto const& it : existing) {
+      CHECK(list->lookup(nullptr, &it) != nullptr);
+    }
+
+    // the merged list still supports single removals and inserts
+    for (auto& it : added) {
+      CHECK(list->remove(nullptr, &it) == TRI_ERROR_NO_ERROR);
+    }
+    CHECK(list->getNrUsed() == 500);
+    CHECK(list->lookup(nullptr, &added[0]) == nullptr);
+    CHECK(list->insert(nullptr, &added[0]) == TRI_ERROR_NO_ERROR);
+    CHECK(list->lookup(nullptr, &added[0]) != nullptr);
+  }
+
+  SECTION("test equal values are allowed in a non-unique skiplist") {
+    std::vector<Element> elements;
+    for (int i = 0; i < 10; ++i) {
+      elements.push_back(Element{i % 2, i});
+    }
+    std::vector<Element*> docs = pointers(elements);
+
+    std::unique_ptr<Skiplist> list(create(false));
+    CHECK(list->bulkInsert(nullptr, docs) == TRI_ERROR_NO_ERROR);
+    CHECK(forward(*list) == (std::vector<int>{0, 2, 4, 6, 8, 1, 3, 5, 7, 9}));
+
+    int key = 1;
+    auto last = list->rightKeyLookup(nullptr, &key);
+    CHECK(last->document()->id == 9);
+  }
+
+  SECTION("test failed bulk inserts leave the skiplist untouched") {
+    std::vector<Element> existing{Element{1, 1}, Element{5, 5}};
+    std::unique_ptr<Skiplist> list(create(true));
+    for (auto& it : existing) {
+      REQUIRE(list->insert(nullptr, &it) == TRI_ERROR_NO_ERROR);
+    }
+
+    // a value that is already in the unique skiplist
+    std::vector<Element> conflicting{Element{3, 3}, Element{5, 6}};
+    std::vector<Element*> docs = pointers(conflicting);
+    CHECK(list->bulkInsert(nullptr, docs) ==
+          TRI_ERROR_ARANGO_UNIQUE_CONSTRAINT_VIOLATED);
+    CHECK(list->getNrUsed() == 2);
+    CHECK(forward(*list) == (std::vector<int>{1, 5}));
+
+    // two equal values amongst the new documents
+    std::vector<Element> duplicates{Element{7, 7}, Element{7, 8}};
+    docs = pointers(duplicates);
+    CHECK(list->bulkInsert(nullptr, docs) ==
+          TRI_ERROR_ARANGO_UNIQUE_CONSTRAINT_VIOLATED);
+
+    // the same document twice, even in a non-unique skiplist
+    std::unique_ptr<Skiplist> nonUnique(create(false));
+    std::vector<Element> same{Element{7, 7}};
+    docs = {&same[0], &same[0]};
+    CHECK(nonUnique->bulkInsert(nullptr, docs) ==
+          TRI_ERROR_ARANGO_UNIQUE_CONSTRAINT_VIOLATED);
+    CHECK(nonUnique->getNrUsed() == 0);
+    CHECK(nonUnique->prevNode(nullptr) == nonUnique->startNode());
+
+    CHECK(list->getNrUsed() == 2);
+    CHECK(forward(*list) == (std::vector<int>{1, 5}));
+    CHECK(backward(*list) == (std::vector<int>{1, 5}));
+  }
+
+  RandomGenerator::shutdown();
+}
@@ -0,0 +1,69 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite for arangodb::MMFilesSynchronizerThread
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "MMFiles/MMFilesSynchronizerThread.h"
+#include "Basics/Common.h"
+
+#include "catch.hpp"
+
+using namespace arangodb;
+
+TEST_CASE("MMFilesSynchronizerThread", "[mmfiles]") {
+  SECTION("test group commits are off by default") {
+    CHECK(MMFilesSynchronizerThread::groupCommitWait(0, 10, 500.0) == 0);
+  }
+
+  SECTION("test a single waiter is synced right away") {
+    CHECK(MMFilesSynchronizerThread::groupCommitWait(1000, 0, 500.0) == 0);
+    CHECK(MMFilesSynchronizerThread::groupCommitWait(1000, 1, 500.0) == 0);
+  }
+
+  SECTION("test the wait follows the sync latency") {
+    CHECK(MMFilesSynchronizerThread::groupCommitWait(1000, 2, 500.0) == 500);
+    CHECK(MMFilesSynchronizerThread::groupCommitWait(1000, 8, 20.5) == 20);
+    // no sync has been measured yet
+    CHECK(MMFilesSynchronizerThread::groupCommitWait(1000, 2, 0.0) == 0);
+  }
+
+  SECTION("test the wait is capped by the window") {
+    CHECK(MMFilesSynchronizerThread::groupCommitWait(1000, 2, 25000.0) ==
+          1000);
+  }
+
+  SECTION("test the sync latency is a moving average") {
+    double latency = MMFilesSynchronizerThread::averageSyncLatency(0.0, 100.0);
+    CHECK(latency == 100.0);
+
+    latency = MMFilesSynchronizerThread::averageSyncLatency(latency, 600.0);
+    CHECK(latency == Approx(200.0));
+
+    // a single slow sync does not dominate the window
+    for (int i = 0; i < 20; ++i) {
+      latency = MMFilesSynchronizerThread::averageSyncLatency(latency, 50.0);
+    }
+    latency = MMFilesSynchronizerThread::averageSyncLatency(latency, 100000.0);
+    CHECK(latency < 25000.0);
+  }
+}
@@ -0,0 +1,52 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+
+#include "catch.hpp"
+
+#include "MMFiles/MMFilesTransactionState.h"
+#include "MMFiles/MMFilesWalSlots.h"
+
+using namespace arangodb;
+
+TEST_CASE("MMFilesTransactionCommitSyncTest", "[mmfiles]") {
+
+SECTION("test_synced_tick_returns_immediately") {
+  MMFilesWalSlots slots(nullptr, 8, 0);
+
+  CHECK(MMFilesTransactionState::waitForCommitSync(&slots, 0, 0.05) ==
+        TRI_ERROR_NO_ERROR);
+}
+
+SECTION("test_unsynced_tick_times_out") {
+  // nothing is ever synced, so the commit marker never reaches the disk.
+  // the locks are already released at this point, so the caller must get
+  // an error instead of a successful commit
+  MMFilesWalSlots slots(nullptr, 8, 0);
+
+  double const start = TRI_microtime();
+  CHECK(MMFilesTransactionState::waitForCommitSync(&slots, 1, 0.05) ==
+        TRI_ERROR_ARANGO_SYNC_TIMEOUT);
+  CHECK(TRI_microtime() - start < 5.0);
+}
+
+}
@@ -0,0 +1,100 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite for arangodb::MMFilesWalSlot
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "MMFiles/MMFilesWalSlot.h"
+#include "Basics/Common.h"
+
+#include "catch.hpp"
+
+#include <thread>
+
+using namespace arangodb;
+
+TEST_CASE("MMFilesWalSlot", "[mmfiles]") {
+  SECTION("test the status of a slot goes through its life cycle") {
+    MMFilesWalSlot slot;
+    CHECK(slot.isUnused());
+    CHECK(slot.statusText() == "unused");
+
+    char mem[64];
+    slot.setUsed(mem, sizeof(mem), 1, 42);
+    CHECK(slot.isUsed());
+    CHECK(!slot.isReturned());
+    CHECK(slot.tick() == 42);
+    CHECK(slot.mem() == mem);
+
+    slot.setReturned(false);
+    CHECK(slot.isReturned());
+    CHECK(!slot.waitForSync());
+    CHECK(slot.statusText() == "returned");
+
+    slot.setUnused();
+    CHECK(slot.isUnused());
+    CHECK(slot.tick() == 0);
+    CHECK(slot.mem() == nullptr);
+  }
+
+  SECTION("test a sync request is kept with the returned slot") {
+    MMFilesWalSlot slot;
+    char mem[64];
+    slot.setUsed(mem, sizeof(mem), 1, 42);
+    slot.setReturned(true);
+    CHECK(slot.isReturned());
+    CHECK(slot.waitForSync());
+    CHECK(slot.statusText() == "returned (wfs)");
+  }
+
+  SECTION("test data written before returning a slot is visible") {
+    // the writer returns its slots without the slots lock, so the syncing
+    // thread relies on the status alone to see the complete marker data
+    size_t const numSlots = 1000;
+    std::vector<MMFilesWalSlot> slots(numSlots);
+    std::vector<uint64_t> data(numSlots, 0);
+    for (size_t i = 0; i < numSlots; ++i) {
+      slots[i].setUsed(&data[i], sizeof(uint64_t), 1, i + 1);
+    }
+
+    std::thread writer([&]() {
+      for (size_t i = 0; i < numSlots; ++i) {
+        data[i] = i + 1;
+        slots[i].setReturned(i % 2 == 0);
+      }
+    });
+
+    size_t complete = 0;
+    for (size_t i = 0; i < numSlots; ++i) {
+      while (!slots[i].isReturned()) {
+        std::this_thread::yield();
+      }
+      if (*static_cast<uint64_t*>(slots[i].mem()) == slots[i].tick() &&
+          slots[i].waitForSync() == (i % 2 == 0)) {
+        ++complete;
+      }
+    }
+    writer.join();
+
+    CHECK(complete == numSlots);
+  }
+}
@@ -0,0 +1,116 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+
+#include "catch.hpp"
+
+#include "Pregel/CommonFormats.h"
+#include "Pregel/GraphStore.h"
+#include "Pregel/TypedBuffer.h"
+
+using namespace arangodb::pregel;
+
+typedef GraphStore<int64_t, int64_t> IntStore;
+
+namespace {
+
+/// @brief buffers created by allocateBuffers, freed at the end of a test
+struct Buffers {
+  TypedBuffer<int64_t>* vertexData = nullptr;
+  TypedBuffer<Edge<int64_t>>* edges = nullptr;
+
+  ~Buffers() {
+    delete vertexData;
+    delete edges;
+  }
+
+  void allocate(uint64_t vertexBytes, uint64_t budget, bool useMemoryMaps,
+                bool lazyLoading, bool hasVertexData = true) {
+    IntStore::allocateBuffers(10, 100, hasVertexData, vertexBytes, budget,
+                              useMemoryMaps, lazyLoading, vertexData, edges);
+  }
+};
+
+}  // namespace
+
+TEST_CASE("GraphStoreMemoryTest", "[pregel]") {
+
+uint64_t const edgeBytes = 100 * sizeof(Edge<int64_t>);
+
+SECTION("test_graph_within_budget_is_on_the_heap") {
+  Buffers buffers;
+  buffers.allocate(80, 80 + edgeBytes, false, false);
+
+  REQUIRE(buffers.vertexData != nullptr);
+  CHECK(!buffers.vertexData->isMapped());
+  CHECK(buffers.vertexData->size() == 10);
+  CHECK(!buffers.edges->isMapped());
+  CHECK(buffers.edges->size() == 100);
+}
+
+SECTION("test_edges_are_mapped_first") {
+  Buffers buffers;
+  buffers.allocate(80, 80 + edgeBytes - 1, false, false);
+
+  REQUIRE(buffers.vertexData != nullptr);
+  CHECK(!buffers.vertexData->isMapped());
+  CHECK(buffers.edges->isMapped());
+  CHECK(buffers.edges->size() == 100);
+}
+
+SECTION("test_vertex_data_exceeding_the_budget_is_mapped") {
+  Buffers buffers;
+  buffers.allocate(80, 79, false, false);
+
+  REQUIRE(buffers.vertexData != nullptr);
+  CHECK(buffers.vertexData->isMapped());
+  CHECK(buffers.vertexData->size() == 10);
+  CHECK(buffers.edges->isMapped());
+}
+
+SECTION("test_memory_maps_can_be_enforced") {
+  Buffers buffers;
+  buffers.allocate(80, UINT64_MAX / 2, true, false);
+
+  REQUIRE(buffers.vertexData != nullptr);
+  CHECK(buffers.vertexData->isMapped());
+  CHECK(buffers.edges->isMapped());
+}
+
+SECTION("test_lazy_loading_stays_on_the_heap") {
+  Buffers buffers;
+  buffers.allocate(80, 0, true, true);
+
+  REQUIRE(buffers.vertexData != nullptr);
+  CHECK(!buffers.vertexData->isMapped());
+  CHECK(!buffers.edges->isMapped());
+}
+
+SECTION("test_formats_without_vertex_data") {
+  Buffers buffers;
+  buffers.allocate(0, 0, false, false, false);
+
+  CHECK(buffers.vertexData == nullptr);
+  CHECK(buffers.edges->isMapped());
+}
+
+}
@@ -0,0 +1,150 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+
+#include "catch.hpp"
+
+#include "Pregel/CommonFormats.h"
+#include "Pregel/GraphStore.h"
+#include "Pregel/TypedBuffer.h"
+
+using namespace arangodb::pregel;
+
+typedef GraphStore<int64_t, int64_t> IntStore;
+typedef GraphStore<SCCValue, int8_t> SCCStore;
+
+TEST_CASE("GraphStoreSnapshotTest", "[pregel]") {
+
+// all vertices share the data at offset 0, so the tests that check vertex
+// data use one vertex per shard
+std::vector<VertexEntry> index{VertexEntry(0, "a"), VertexEntry(0, "b"),
+                               VertexEntry(1, "c")};
+
+SECTION("test_restore_active_flags") {
+  std::map<PregelShard, std::string> snapshots;
+  IntStore::snapshotVertices(index, nullptr, {0, 1, 2}, snapshots);
+  REQUIRE(snapshots.size() == 3);
+
+  index[0].setActive(false);
+  index[2].setActive(false);
+  CHECK(IntStore::restoreVertices(index, nullptr, 0, snapshots[0]));
+  CHECK(index[0].active());
+  CHECK(!index[2].active());
+  CHECK(IntStore::restoreVertices(index, nullptr, 1, snapshots[1]));
+  CHECK(index[2].active());
+
+  // a shard without vertices has an empty snapshot
+  CHECK(IntStore::restoreVertices(index, nullptr, 2, snapshots[2]));
+}
+
+SECTION("test_restore_trivially_copyable_values") {
+  std::vector<VertexEntry> single{VertexEntry(0, "a")};
+  VectorTypedBuffer<int64_t> data(1);
+  data.data()[0] = 42;
+
+  std::map<PregelShard, std::string> snapshots;
+  IntStore::snapshotVertices(single, &data, {0}, snapshots);
+
+  data.data()[0] = 7;
+  single[0].setActive(false);
+  CHECK(IntStore::restoreVertices(single, &data, 0, snapshots[0]));
+  CHECK(data.data()[0] == 42);
+  CHECK(single[0].active());
+}
+
+SECTION("test_restore_serialized_values") {
+  std::vector<VertexEntry> single{VertexEntry(0, "a")};
+  VectorTypedBuffer<SCCValue> data(1);
+  data.data()[0].vertexID = 5;
+  data.data()[0].color = 3;
+  data.data()[0].parents.emplace_back(1, "p");
+
+  std::map<PregelShard, std::string> snapshots;
+  SCCStore::snapshotVertices(single, &data, {0}, snapshots);
+
+  data.data()[0] = SCCValue();
+  CHECK(SCCStore::restoreVertices(single, &data, 0, snapshots[0]));
+  CHECK(data.data()[0].vertexID == 5);
+  CHECK(data.data()[0].color == 3);
+  REQUIRE(data.data()[0].parents.size() == 1);
+  CHECK(data.data()[0].parents[0].shard == 1);
+  CHECK(data.data()[0].parents[0].key == "p");
+}
+
+SECTION("test_mismatching_vertices_are_rejected") {
+  std::map<PregelShard, std::string> snapshots;
+  IntStore::snapshotVertices(index, nullptr, {0, 1}, snapshots);
+
+  // a vertex of the snapshot is not loaded
+  std::vector<VertexEntry> fewer{VertexEntry(0, "a")};
+  CHECK(!IntStore::restoreVertices(fewer, nullptr, 0, snapshots[0]));
+
+  // a loaded vertex is not in the snapshot
+  std::vector<VertexEntry> more{VertexEntry(0, "a"), VertexEntry(0, "b"),
+                                VertexEntry(0, "d")};
+  CHECK(!IntStore::restoreVertices(more, nullptr, 0, snapshots[0]));
+
+  // the snapshot belongs to another shard
+  CHECK(!IntStore::restoreVertices(index, nullptr, 1, snapshots[0]));
+}
+
+SECTION("test_mismatching_values_are_rejected") {
+  std::vector<VertexEntry> single{VertexEntry(0, "a")};
+  VectorTypedBuffer<int64_t> ints(1);
+  VectorTypedBuffer<float> floats(1);
+  VectorTypedBuffer<SCCValue> sccs(1);
+
+  std::map<PregelShard, std::string> snapshots;
+  IntStore::snapshotVertices(single, &ints, {0}, snapshots);
+  typedef GraphStore<float, float> FloatStore;
+  CHECK(!FloatStore::restoreVertices(single, &floats, 0, snapshots[0]));
+  CHECK(!SCCStore::restoreVertices(single, &sccs, 0, snapshots[0]));
+  // the snapshot has no vertex data
+  std::map<PregelShard, std::string> withoutData;
+  IntStore::snapshotVertices(single, nullptr, {0}, withoutData);
+  CHECK(!IntStore::restoreVertices(single, &ints, 0, withoutData[0]));
+}
+
+SECTION("test_truncated_snapshots_are_rejected") {
+  std::vector<VertexEntry> pair{VertexEntry(0, "a"), VertexEntry(0, "bb")};
+  VectorTypedBuffer<int64_t> ints(1);
+  VectorTypedBuffer<SCCValue> sccs(1);
+  sccs.data()[0].parents.emplace_back(1, "parent");
+
+  std::map<PregelShard, std::string> intSnapshots, sccSnapshots;
+  IntStore::snapshotVertices(pair, &ints, {0}, intSnapshots);
+  SCCStore::snapshotVertices(pair, &sccs, {0}, sccSnapshots);
+
+  std::string const& intSnapshot = intSnapshots[0];
+  for (size_t size = 0; size < intSnapshot.size(); ++size) {
+    CHECK(!IntStore::restoreVertices(pair, &ints, 0,
+                                     intSnapshot.substr(0, size)));
+  }
+  std::string const& sccSnapshot = sccSnapshots[0];
+  for (size_t size = 0; size < sccSnapshot.size(); ++size) {
+    CHECK(!SCCStore::restoreVertices(pair, &sccs, 0,
+                                     sccSnapshot.substr(0, size)));
+  }
+  CHECK(SCCStore::restoreVertices(pair, &sccs, 0, sccSnapshot));
+}
+
+}
@@ -0,0 +1,97 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+
+#include "catch.hpp"
+
+#include "Basics/Exceptions.h"
+#include "Rest/HttpRequest.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Exception.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+
+static std::unique_ptr<HttpRequest> makeRequest(rest::ContentType contentType,
+                                                std::string const& body) {
+  return std::unique_ptr<HttpRequest>(HttpRequest::createHttpRequest(
+      contentType, body.c_str(), static_cast<int64_t>(body.size()), {}));
+}
+
+TEST_CASE("HttpRequestTest", "[rest]") {
+
+SECTION("test_json_body_is_parsed_once") {
+  auto request = makeRequest(rest::ContentType::JSON, "{\"a\":1}");
+
+  std::shared_ptr<VPackBuilder> first = request->toVelocyPackBuilderPtr();
+  std::shared_ptr<VPackBuilder> second = request->toVelocyPackBuilderPtr();
+  CHECK(first.get() == second.get());
+  CHECK(first->slice().get("a").getInt() == 1);
+
+  // the payload is the parsed body, not a copy of it
+  VPackOptions options;
+  CHECK(request->payload(&options).begin() == first->slice().begin());
+}
+
+SECTION("test_new_body_is_parsed_again") {
+  auto request = makeRequest(rest::ContentType::JSON, "{\"a\":1}");
+  std::shared_ptr<VPackBuilder> first = request->toVelocyPackBuilderPtr();
+
+  request->setBody(std::string("{\"a\":2}"));
+  CHECK(request->body() == "{\"a\":2}");
+
+  std::shared_ptr<VPackBuilder> second = request->toVelocyPackBuilderPtr();
+  CHECK(second->slice().get("a").getInt() == 2);
+  // a builder handed out earlier still holds the old body
+  CHECK(first->slice().get("a").getInt() == 1);
+}
+
+SECTION("test_duplicate_attributes_are_rejected") {
+  auto request = makeRequest(rest::ContentType::JSON, "{\"a\":1,\"a\":2}");
+  CHECK_THROWS_AS(request->toVelocyPackBuilderPtr(), VPackException);
+
+  // also if the body was parsed without the check before
+  request = makeRequest(rest::ContentType::JSON, "{\"a\":1,\"a\":2}");
+  VPackOptions options;
+  CHECK(request->payload(&options).isObject());
+  CHECK_THROWS_AS(request->toVelocyPackBuilderPtr(), VPackException);
+}
+
+SECTION("test_velocypack_body_is_used_in_place") {
+  VPackBuilder builder;
+  builder.openObject();
+  builder.add("a", VPackValue(1));
+  builder.close();
+  std::string body(reinterpret_cast<char const*>(builder.slice().begin()),
+                   builder.slice().byteSize());
+
+  auto request = makeRequest(rest::ContentType::VPACK, body);
+  VPackOptions options;
+  VPackSlice first = request->payload(&options);
+  VPackSlice second = request->payload(&options);
+  CHECK(first.begin() == second.begin());
+  CHECK(first.begin() == reinterpret_cast<uint8_t const*>(request->body().c_str()));
+  CHECK(first.get("a").getInt() == 1);
+}
+
+}
@@ -0,0 +1,133 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+
+#include "catch.hpp"
+
+#include "Basics/Mutex.h"
+#include "Basics/MutexLocker.h"
+#include "RestHandler/RestBatchHandler.h"
+
+#include <thread>
+
+using namespace arangodb;
+
+namespace {
+
+/// @brief io_service run by some threads for the duration of a test
+class IoServiceThreads {
+ public:
+  explicit IoServiceThreads(size_t n) : _work(_ioService) {
+    for (size_t i = 0; i < n; ++i) {
+      _threads.emplace_back([this]() { _ioService.run(); });
+    }
+  }
+
+  ~IoServiceThreads() {
+    _ioService.stop();
+    for (auto& thread : _threads) {
+      thread.join();
+    }
+  }
+
+  boost::asio::io_service* ioService() { return &_ioService; }
+
+ private:
+  boost::asio::io_service _ioService;
+  boost::asio::io_service::work _work;
+  std::vector<std::thread> _threads;
+};
+
+}  // namespace
+
+TEST_CASE("RestBatchHandlerTest", "[rest]") {
+
+SECTION("test_parts_run_in_order_without_parallelism") {
+  IoServiceThreads threads(4);
+  std::vector<size_t> order;
+  std::thread::id const self = std::this_thread::get_id();
+  bool sameThread = true;
+
+  RestBatchHandler::runParts(threads.ioService(), 5, 1, [&](size_t i) {
+    order.push_back(i);
+    sameThread = sameThread && std::this_thread::get_id() == self;
+  });
+
+  CHECK(order == (std::vector<size_t>{0, 1, 2, 3, 4}));
+  CHECK(sameThread);
+}
+
+SECTION("test_parts_run_in_order_without_io_service") {
+  std::vector<size_t> order;
+
+  RestBatchHandler::runParts(nullptr, 3, 4,
+                             [&order](size_t i) { order.push_back(i); });
+
+  CHECK(order == (std::vector<size_t>{0, 1, 2}));
+}
+
+SECTION("test_parallel_results_keep_the_order_of_the_parts") {
+  IoServiceThreads threads(4);
+  size_t const n = 8;
+  std::vector<size_t> results(n, 0);
+  std::vector<size_t> finished;
+  Mutex mutex;
+
+  // the earlier parts take longer, so they finish last
+  RestBatchHandler::runParts(threads.ioService(), n, 4, [&](size_t i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10 * (n - i)));
+    results[i] = i + 1;
+    MUTEX_LOCKER(locker, mutex);
+    finished.push_back(i);
+  });
+
+  // every part ran exactly once
+  REQUIRE(finished.size() == n);
+  for (size_t i = 0; i < n; ++i) {
+    CHECK(results[i] == i + 1);
+  }
+  // but they did not finish in the order of the request
+  CHECK(finished != (std::vector<size_t>{0, 1, 2, 3, 4, 5, 6, 7}));
+}
+
+SECTION("test_parallelism_is_bounded") {
+  IoServiceThreads threads(8);
+  std::atomic<size_t> running(0);
+  std::atomic<size_t> maxRunning(0);
+  std::atomic<size_t> calls(0);
+
+  RestBatchHandler::runParts(threads.ioService(), 20, 3, [&](size_t) {
+    size_t now = ++running;
+    size_t seen = maxRunning.load();
+    while (now > seen && !maxRunning.compare_exchange_weak(seen, now)) {
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    --running;
+    ++calls;
+  });
+
+  CHECK(calls.load() == 20);
+  CHECK(maxRunning.load() <= 3);
+  CHECK(maxRunning.load() > 1);
+}
+
+}
@@ -0,0 +1,89 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+
+#include "catch.hpp"
+
+#include "RestHandler/RestImportHandler.h"
+
+#include <velocypack/Iterator.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+
+// adds count documents to the batch, and returns the documents of the
+// batches that were full
+static std::vector<std::vector<uint64_t>> addDocuments(RestImportBatch& batch,
+                                                       uint64_t first,
+                                                       uint64_t count) {
+  std::vector<std::vector<uint64_t>> full;
+  for (uint64_t i = first; i < first + count; ++i) {
+    batch.builder().add(VPackValue(i));
+    if (batch.added()) {
+      std::vector<uint64_t> values;
+      for (auto const& it : VPackArrayIterator(batch.close().slice())) {
+        values.emplace_back(it.getUInt());
+      }
+      full.emplace_back(std::move(values));
+      batch.next();
+    }
+  }
+  return full;
+}
+
+TEST_CASE("RestImportBatchTest", "[rest]") {
+
+SECTION("test_empty_batch") {
+  RestImportBatch batch(3);
+  VPackSlice slice = batch.close().slice();
+  CHECK(slice.isArray());
+  CHECK(slice.length() == 0);
+  CHECK(batch.offset() == 0);
+}
+
+SECTION("test_full_batches") {
+  RestImportBatch batch(3);
+  auto full = addDocuments(batch, 0, 7);
+
+  REQUIRE(full.size() == 2);
+  CHECK(full[0] == std::vector<uint64_t>({0, 1, 2}));
+  CHECK(full[1] == std::vector<uint64_t>({3, 4, 5}));
+
+  // the rest is inserted at the end of the request
+  CHECK(batch.offset() == 6);
+  VPackSlice slice = batch.close().slice();
+  REQUIRE(slice.length() == 1);
+  CHECK(slice.at(0).getUInt() == 6);
+}
+
+SECTION("test_offsets") {
+  RestImportBatch batch(2);
+  CHECK(batch.offset() == 0);
+  addDocuments(batch, 0, 2);
+  CHECK(batch.offset() == 2);
+  addDocuments(batch, 2, 1);
+  CHECK(batch.offset() == 2);
+  addDocuments(batch, 3, 1);
+  CHECK(batch.offset() == 4);
+}
+
+}
@@ -0,0 +1,145 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+
+#include "catch.hpp"
+
+#include "Scheduler/JobQueue.h"
+
+using namespace arangodb;
+
+static std::unique_ptr<Job> makeJob(int id, std::vector<int>& ran) {
+  return std::make_unique<Job>(
+      [id, &ran](std::shared_ptr<rest::RestHandler>) { ran.emplace_back(id); });
+}
+
+static void run(Job* job) {
+  std::unique_ptr<Job> guard(job);
+  job->_callback(std::move(job->_handler));
+}
+
+TEST_CASE("JobQueueTest", "[scheduler]") {
+
+SECTION("test_jobs_are_taken_by_priority") {
+  JobQueue queue(16, nullptr, 0.0, 0.0);
+  std::vector<int> ran;
+
+  CHECK(queue.queue(JobQueue::USER_QUEUE, makeJob(1, ran)));
+  CHECK(queue.queue(JobQueue::STANDARD_QUEUE, makeJob(2, ran)));
+  CHECK(queue.queue(JobQueue::AQL_QUEUE, makeJob(3, ran)));
+  CHECK(queue.queue(JobQueue::STANDARD_QUEUE, makeJob(4, ran)));
+  CHECK(queue.queueSize(JobQueue::STANDARD_QUEUE) == 2);
+
+  Job* job = nullptr;
+  while (queue.popAny(job)) {
+    run(job);
+  }
+
+  CHECK(ran == std::vector<int>({3, 2, 4, 1}));
+  for (size_t i = 0; i < JobQueue::SYSTEM_QUEUE_SIZE; ++i) {
+    CHECK(queue.queueSize(i) == 0);
+  }
+}
+
+SECTION("test_nothing_to_pop") {
+  JobQueue queue(16, nullptr, 0.0, 0.0);
+
+  Job* job = nullptr;
+  CHECK(!queue.popAny(job));
+  CHECK(!queue.pop(JobQueue::SYSTEM_QUEUE_SIZE, job));
+
+  std::vector<int> ran;
+  CHECK(!queue.queue(JobQueue::SYSTEM_QUEUE_SIZE, makeJob(1, ran)));
+}
+
+SECTION("test_active_jobs_are_limited") {
+  JobQueue queue(16, nullptr, 0.0, 0.0);
+
+  size_t n = 0;
+  while (queue.tryActive()) {
+    ++n;
+  }
+  CHECK(n == queue.active());
+  CHECK(n > 0);
+
+  // a finished job frees a slot for the next one
+  queue.releaseActive();
+  CHECK(queue.tryActive());
+  CHECK(!queue.tryActive());
+}
+
+SECTION("test_no_shedding_without_target_time") {
+  JobQueue queue(16, nullptr, 0.0, 0.0);
+  std::vector<int> ran;
+
+  CHECK(queue.queue(JobQueue::USER_QUEUE, makeJob(1, ran)));
+  Job* job = nullptr;
+  REQUIRE(queue.pop(JobQueue::USER_QUEUE, job));
+  run(job);
+
+  CHECK(!queue.shouldShed(JobQueue::STANDARD_QUEUE));
+  CHECK(!queue.shouldShed(JobQueue::USER_QUEUE));
+}
+
+SECTION("test_shedding_after_waiting_too_long") {
+  // every job waits longer than the target time, and the queue counts as
+  // overloaded as soon as that happens
+  JobQueue queue(16, nullptr, 1e-12, 0.0);
+  std::vector<int> ran;
+
+  CHECK(!queue.shouldShed(JobQueue::STANDARD_QUEUE));
+
+  CHECK(queue.queue(JobQueue::STANDARD_QUEUE, makeJob(1, ran)));
+  CHECK(queue.queue(JobQueue::STANDARD_QUEUE, makeJob(2, ran)));
+  Job* job = nullptr;
+  REQUIRE(queue.pop(JobQueue::STANDARD_QUEUE, job));
+  run(job);
+
+  CHECK(queue.shouldShed(JobQueue::STANDARD_QUEUE));
+  // the user queue has a lower priority, so it is shed as well
+  CHECK(queue.shouldShed(JobQueue::USER_QUEUE));
+  // internal jobs are never shed
+  CHECK(!queue.shouldShed(JobQueue::REQUEUED_QUEUE));
+  CHECK(!queue.shouldShed(JobQueue::AQL_QUEUE));
+
+  // the queue is not overloaded any more once it runs empty
+  REQUIRE(queue.pop(JobQueue::STANDARD_QUEUE, job));
+  run(job);
+  CHECK(!queue.pop(JobQueue::STANDARD_QUEUE, job));
+  CHECK(!queue.shouldShed(JobQueue::STANDARD_QUEUE));
+  CHECK(!queue.shouldShed(JobQueue::USER_QUEUE));
+}
+
+SECTION("test_no_shedding_for_short_bursts") {
+  // the waiting time must stay above the target for a whole interval
+  JobQueue queue(16, nullptr, 1e-12, 3600.0);
+  std::vector<int> ran;
+
+  CHECK(queue.queue(JobQueue::USER_QUEUE, makeJob(1, ran)));
+  Job* job = nullptr;
+  REQUIRE(queue.pop(JobQueue::USER_QUEUE, job));
+  run(job);
+
+  CHECK(!queue.shouldShed(JobQueue::USER_QUEUE));
+}
+
+}
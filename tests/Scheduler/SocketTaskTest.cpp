@@ -0,0 +1,106 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+
+#include "catch.hpp"
+
+#include "Basics/StringBuffer.h"
+#include "Scheduler/SocketTask.h"
+
+using namespace arangodb;
+
+namespace {
+// gives access to the write buffers of socket tasks
+class TestSocketTask : public rest::SocketTask {
+ public:
+  typedef rest::SocketTask::WriteBuffer WriteBuffer;
+};
+
+std::string toString(boost::asio::const_buffer const& buffer) {
+  return std::string(boost::asio::buffer_cast<char const*>(buffer),
+                     boost::asio::buffer_size(buffer));
+}
+
+basics::StringBuffer* makeBuffer(std::string const& value) {
+  auto buffer = new basics::StringBuffer(TRI_UNKNOWN_MEM_ZONE, false);
+  buffer->appendText(value);
+  return buffer;
+}
+}
+
+TEST_CASE("SocketTaskTest", "[scheduler]") {
+
+SECTION("test_write_buffer_without_body") {
+  TestSocketTask::WriteBuffer buffer(makeBuffer("header"), nullptr);
+  CHECK(buffer.length() == 6);
+
+  BufferSequence buffers = buffer.buffers(0);
+  CHECK(toString(buffers[0]) == "header");
+  CHECK(boost::asio::buffer_size(buffers[1]) == 0);
+
+  buffers = buffer.buffers(2);
+  CHECK(toString(buffers[0]) == "ader");
+  CHECK(boost::asio::buffer_size(buffers[1]) == 0);
+
+  CHECK(boost::asio::buffer_size(buffer.buffers(6)) == 0);
+}
+
+SECTION("test_write_buffer_with_separate_body") {
+  TestSocketTask::WriteBuffer buffer(makeBuffer("head"), makeBuffer("body!"),
+                                     nullptr);
+  CHECK(buffer.length() == 9);
+
+  BufferSequence buffers = buffer.buffers(0);
+  CHECK(toString(buffers[0]) == "head");
+  CHECK(toString(buffers[1]) == "body!");
+  CHECK(boost::asio::buffer_size(buffers) == 9);
+
+  // partially written header
+  buffers = buffer.buffers(3);
+  CHECK(toString(buffers[0]) == "d");
+  CHECK(toString(buffers[1]) == "body!");
+
+  // header written completely
+  buffers = buffer.buffers(4);
+  CHECK(boost::asio::buffer_size(buffers[0]) == 0);
+  CHECK(toString(buffers[1]) == "body!");
+
+  // partially written body
+  buffers = buffer.buffers(6);
+  CHECK(boost::asio::buffer_size(buffers[0]) == 0);
+  CHECK(toString(buffers[1]) == "dy!");
+
+  CHECK(boost::asio::buffer_size(buffer.buffers(9)) == 0);
+}
+
+SECTION("test_moving_write_buffers_moves_the_body") {
+  TestSocketTask::WriteBuffer buffer(makeBuffer("head"), makeBuffer("body"),
+                                     nullptr);
+  TestSocketTask::WriteBuffer other(std::move(buffer));
+
+  CHECK(buffer.empty());
+  CHECK(buffer._body == nullptr);
+  CHECK(other.length() == 8);
+  CHECK(toString(other.buffers(4)[1]) == "body");
+}
+
+}
@@ -0,0 +1,124 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include "Basics/Common.h"
+
+#include "catch.hpp"
+
+#include "SimpleHttpClient/Communicator.h"
+#include "SimpleHttpClient/VstConnection.h"
+
+using namespace arangodb::communicator;
+
+namespace {
+/// @brief a pool at its limit whose latency has doubled since it was
+/// lowest
+Communicator::VstPool makeSlowPool(size_t connections) {
+  Communicator::VstPool pool;
+  for (size_t i = 0; i < connections; ++i) {
+    pool._connections.emplace_back(
+        std::make_unique<VstConnection>("127.0.0.1:8529", ""));
+  }
+  pool._limit = connections;
+  pool.addLatencies(0.01, 1);
+  for (int i = 0; i < 20; ++i) {
+    pool.addLatencies(1.0, 10);
+  }
+  return pool;
+}
+}
+
+TEST_CASE("CommunicatorTest", "[vst]") {
+  Communicator::PoolOptions options;
+
+SECTION("test_latencies_are_smoothed") {
+  Communicator::VstPool pool;
+  pool.addLatencies(0.0, 0);
+  CHECK(pool._latency == 0.0);
+
+  // the first value is taken as it is
+  pool.addLatencies(0.3, 3);
+  CHECK(pool._latency == Approx(0.1));
+  CHECK(pool._baseLatency == Approx(0.1));
+
+  pool.addLatencies(1.1, 1);
+  CHECK(pool._latency == Approx(0.2));
+  // the lowest average is kept
+  CHECK(pool._baseLatency == Approx(0.1));
+
+  pool.addLatencies(0.0, 1);
+  CHECK(pool._latency == Approx(0.18));
+  CHECK(pool._baseLatency == Approx(0.1));
+}
+
+SECTION("test_pool_grows_when_latency_rises") {
+  Communicator::VstPool pool = makeSlowPool(options._minConnections);
+  REQUIRE(pool._latency > Communicator::LatencyGrowthFactor *
+                              pool._baseLatency);
+
+  pool.grow(options, true, 100.0);
+  CHECK(pool._limit == options._minConnections + 1);
+  CHECK(pool._lastGrowth == 100.0);
+
+  // the pool does not grow again before it has opened the connection
+  pool.grow(options, true, 102.0);
+  CHECK(pool._limit == options._minConnections + 1);
+}
+
+SECTION("test_pool_grows_at_most_once_per_second") {
+  Communicator::VstPool pool = makeSlowPool(options._minConnections);
+  pool._lastGrowth = 100.0;
+
+  pool.grow(options, true, 100.5);
+  CHECK(pool._limit == options._minConnections);
+  pool.grow(options, true, 101.0);
+  CHECK(pool._limit == options._minConnections + 1);
+}
+
+SECTION("test_pool_does_not_grow_without_need") {
+  // idle connections are used first
+  Communicator::VstPool pool = makeSlowPool(options._minConnections);
+  pool.grow(options, false, 100.0);
+  CHECK(pool._limit == options._minConnections);
+
+  // the latency is not higher than before
+  Communicator::VstPool fast = makeSlowPool(options._minConnections);
+  fast._baseLatency = fast._latency;
+  fast.grow(options, true, 100.0);
+  CHECK(fast._limit == options._minConnections);
+
+  // nothing was measured yet
+  Communicator::VstPool fresh;
+  fresh._connections.emplace_back(
+      std::make_unique<VstConnection>("127.0.0.1:8529", ""));
+  fresh._limit = 1;
+  fresh.grow(options, true, 100.0);
+  CHECK(fresh._limit == 1);
+}
+
+SECTION("test_pool_does_not_grow_beyond_the_maximum") {
+  Communicator::VstPool pool = makeSlowPool(options._maxConnections);
+  pool.grow(options, true, 100.0);
+  CHECK(pool._limit == options._maxConnections);
+}
+
+}
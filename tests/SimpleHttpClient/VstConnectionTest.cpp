@@ -0,0 +1,233 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+
+#include "catch.hpp"
+
+#include "SimpleHttpClient/VstConnection.h"
+
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb::communicator;
+
+static std::string makeMessage(size_t length, char seed) {
+  std::string message;
+  message.reserve(length);
+  for (size_t i = 0; i < length; ++i) {
+    message.push_back(static_cast<char>(seed + i % 61));
+  }
+  return message;
+}
+
+static void appendChunks(std::string& out, uint64_t messageId,
+                         std::string const& message) {
+  VstConnection::appendChunks(
+      out, messageId, reinterpret_cast<uint8_t const*>(message.data()),
+      message.size());
+}
+
+// split the encoded data into its chunks
+static std::vector<std::string> splitChunks(std::string const& data) {
+  std::vector<std::string> chunks;
+  size_t offset = 0;
+  while (offset < data.size()) {
+    uint32_t length;
+    memcpy(&length, data.data() + offset, sizeof(length));
+    chunks.emplace_back(data.substr(offset, length));
+    offset += length;
+  }
+  return chunks;
+}
+
+// the messages completed by reading the data
+typedef std::vector<std::pair<uint64_t, std::string>> Messages;
+
+static bool readChunks(std::string const& data, size_t& offset,
+                       VstConnection::IncompleteMessages& incomplete,
+                       Messages& messages) {
+  return VstConnection::readChunks(
+      data, offset, incomplete,
+      [&messages](uint64_t messageId, VPackBuffer<uint8_t> const& message) {
+        messages.emplace_back(
+            messageId, std::string(reinterpret_cast<char const*>(
+                                       message.data()),
+                                   message.size()));
+      });
+}
+
+TEST_CASE("VstConnectionTest", "[vst]") {
+
+SECTION("test_small_message_is_one_chunk") {
+  std::string const message = makeMessage(100, 'a');
+  std::string data;
+  appendChunks(data, 7, message);
+  CHECK(data.size() == 100 + 16);
+  CHECK(splitChunks(data).size() == 1);
+
+  VstConnection::IncompleteMessages incomplete;
+  Messages messages;
+  size_t offset = 0;
+  REQUIRE(readChunks(data, offset, incomplete, messages));
+  CHECK(offset == data.size());
+  REQUIRE(messages.size() == 1);
+  CHECK(messages[0].first == 7);
+  CHECK(messages[0].second == message);
+  CHECK(incomplete.empty());
+}
+
+SECTION("test_large_message_is_split") {
+  std::string const message = makeMessage(100 * 1024, 'a');
+  std::string data;
+  appendChunks(data, 3, message);
+
+  auto chunks = splitChunks(data);
+  REQUIRE(chunks.size() == 4);
+  size_t const maxChunkSize = VstConnection::MaxChunkSize;
+  for (auto const& chunk : chunks) {
+    CHECK(chunk.size() <= maxChunkSize);
+  }
+
+  VstConnection::IncompleteMessages incomplete;
+  Messages messages;
+  size_t offset = 0;
+  REQUIRE(readChunks(data, offset, incomplete, messages));
+  REQUIRE(messages.size() == 1);
+  CHECK(messages[0].second == message);
+  CHECK(incomplete.empty());
+}
+
+SECTION("test_chunk_boundary") {
+  // the largest message that fits into a single chunk, and one more byte
+  size_t const single = VstConnection::MaxChunkSize - 16;
+  for (size_t length : {single, single + 1}) {
+    std::string const message = makeMessage(length, 'x');
+    std::string data;
+    appendChunks(data, 1, message);
+    CHECK(splitChunks(data).size() == (length == single ? 1 : 2));
+
+    VstConnection::IncompleteMessages incomplete;
+    Messages messages;
+    size_t offset = 0;
+    REQUIRE(readChunks(data, offset, incomplete, messages));
+    REQUIRE(messages.size() == 1);
+    CHECK(messages[0].second == message);
+  }
+}
+
+SECTION("test_interleaved_messages") {
+  std::string const first = makeMessage(70 * 1024, 'a');
+  std::string const second = makeMessage(50 * 1024, 'A');
+  std::string const third = makeMessage(10, '0');
+  std::string firstData, secondData, thirdData;
+  appendChunks(firstData, 1, first);
+  appendChunks(secondData, 2, second);
+  appendChunks(thirdData, 3, third);
+
+  // the server may send the chunks of its responses in any order
+  auto firstChunks = splitChunks(firstData);
+  auto secondChunks = splitChunks(secondData);
+  std::string data;
+  for (size_t i = 0; i < std::max(firstChunks.size(), secondChunks.size());
+       ++i) {
+    if (i < secondChunks.size()) {
+      data += secondChunks[i];
+    }
+    if (i == 1) {
+      data += thirdData;
+    }
+    if (i < firstChunks.size()) {
+      data += firstChunks[i];
+    }
+  }
+
+  VstConnection::IncompleteMessages incomplete;
+  Messages messages;
+  size_t offset = 0;
+  REQUIRE(readChunks(data, offset, incomplete, messages));
+  REQUIRE(messages.size() == 3);
+  // in the order of their last chunks
+  CHECK(messages[0].first == 2);
+  CHECK(messages[0].second == second);
+  CHECK(messages[1].first == 3);
+  CHECK(messages[1].second == third);
+  CHECK(messages[2].first == 1);
+  CHECK(messages[2].second == first);
+}
+
+SECTION("test_partial_chunks_wait_for_more_data") {
+  std::string const message = makeMessage(40 * 1024, 'a');
+  std::string data;
+  appendChunks(data, 9, message);
+
+  VstConnection::IncompleteMessages incomplete;
+  Messages messages;
+  std::string buffer;
+  size_t offset = 0;
+  // the data arrives in pieces that do not end at chunk boundaries
+  for (size_t pos = 0; pos < data.size(); pos += 1000) {
+    buffer += data.substr(pos, 1000);
+    REQUIRE(readChunks(buffer, offset, incomplete, messages));
+    CHECK(offset <= buffer.size());
+    if (buffer.size() < data.size()) {
+      CHECK(messages.empty());
+    }
+  }
+  CHECK(offset == data.size());
+  REQUIRE(messages.size() == 1);
+  CHECK(messages[0].second == message);
+}
+
+SECTION("test_invalid_chunk_length") {
+  std::string data;
+  uint32_t const length = 4;
+  data.append(reinterpret_cast<char const*>(&length), sizeof(length));
+  data.append(12, '\0');
+
+  VstConnection::IncompleteMessages incomplete;
+  Messages messages;
+  size_t offset = 0;
+  CHECK(!readChunks(data, offset, incomplete, messages));
+  CHECK(messages.empty());
+}
+
+SECTION("test_chunks_of_unknown_messages_are_skipped") {
+  std::string const message = makeMessage(70 * 1024, 'a');
+  std::string data;
+  appendChunks(data, 4, message);
+  auto chunks = splitChunks(data);
+
+  // the first chunk was lost, e.g. when the connection was reset
+  std::string rest;
+  for (size_t i = 1; i < chunks.size(); ++i) {
+    rest += chunks[i];
+  }
+
+  VstConnection::IncompleteMessages incomplete;
+  Messages messages;
+  size_t offset = 0;
+  REQUIRE(readChunks(rest, offset, incomplete, messages));
+  CHECK(offset == rest.size());
+  CHECK(messages.empty());
+  CHECK(incomplete.empty());
+}
+
+}
@@ -0,0 +1,126 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+
+#include "catch.hpp"
+
+#include "Statistics/MetricsRegistry.h"
+
+using namespace arangodb;
+using namespace arangodb::basics;
+
+static std::string metrics() {
+  std::string result;
+  MetricsRegistry::toPrometheus(result);
+  return result;
+}
+
+TEST_CASE("MetricsRegistryTest", "[statistics]") {
+
+SECTION("test_counters_and_gauges") {
+  double value = 1.0;
+  MetricsRegistry::addCounter("test_total", "total tests",
+                              [&value]() { return value; });
+  MetricsRegistry::addGauge("test_running", "running tests",
+                            []() { return 2.5; });
+
+  CHECK(metrics() ==
+        "# HELP test_total total tests\n"
+        "# TYPE test_total counter\n"
+        "test_total 1\n"
+        "# HELP test_running running tests\n"
+        "# TYPE test_running gauge\n"
+        "test_running 2.5\n");
+
+  // values are read when the metrics are exposed
+  value = 3.0;
+  CHECK(metrics().find("test_total 3\n") != std::string::npos);
+
+  MetricsRegistry::remove("test_total");
+  MetricsRegistry::remove("test_running");
+  CHECK(metrics().empty());
+}
+
+SECTION("test_families") {
+  MetricsRegistry::addGauge("test_queue{queue=\"a\"}", "queue length",
+                            []() { return 1.0; });
+  MetricsRegistry::addGauge("test_other", "other", []() { return 0.0; });
+  MetricsRegistry::addGauge("test_queue{queue=\"b\"}", "queue length",
+                            []() { return 2.0; });
+
+  // the samples of a family are kept together and described once
+  CHECK(metrics() ==
+        "# HELP test_queue queue length\n"
+        "# TYPE test_queue gauge\n"
+        "test_queue{queue=\"a\"} 1\n"
+        "test_queue{queue=\"b\"} 2\n"
+        "# HELP test_other other\n"
+        "# TYPE test_other gauge\n"
+        "test_other 0\n");
+
+  // removing a family removes all of its samples
+  MetricsRegistry::remove("test_queue");
+  CHECK(metrics().find("test_queue") == std::string::npos);
+  MetricsRegistry::remove("test_other");
+  CHECK(metrics().empty());
+}
+
+SECTION("test_histograms") {
+  MetricsRegistry::addHistogram("test_time", "time", []() {
+    StatisticsVector cuts;
+    cuts << 1.0 << 2.0;
+    StatisticsDistribution distribution(cuts);
+    distribution.addFigure(0.5);
+    distribution.addFigure(1.5);
+    distribution.addFigure(1.5);
+    distribution.addFigure(5.0);
+    return distribution;
+  });
+
+  // the buckets are cumulative
+  CHECK(metrics() ==
+        "# HELP test_time time\n"
+        "# TYPE test_time histogram\n"
+        "test_time_bucket{le=\"1\"} 1\n"
+        "test_time_bucket{le=\"2\"} 3\n"
+        "test_time_bucket{le=\"+Inf\"} 4\n"
+        "test_time_sum 8.5\n"
+        "test_time_count 4\n");
+
+  MetricsRegistry::remove("test_time");
+}
+
+SECTION("test_special_values") {
+  MetricsRegistry::addGauge("test_nan", "nan", []() { return std::nan(""); });
+  MetricsRegistry::addGauge("test_inf", "inf", []() {
+    return std::numeric_limits<double>::infinity();
+  });
+
+  std::string result = metrics();
+  CHECK(result.find("test_nan NaN\n") != std::string::npos);
+  CHECK(result.find("test_inf +Inf\n") != std::string::npos);
+
+  MetricsRegistry::remove("test_nan");
+  MetricsRegistry::remove("test_inf");
+}
+
+}
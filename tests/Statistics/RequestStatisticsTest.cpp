@@ -0,0 +1,104 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+
+#include "catch.hpp"
+
+#include "Statistics/RequestStatistics.h"
+
+using namespace arangodb;
+using namespace arangodb::basics;
+
+TEST_CASE("RequestStatisticsTest", "[statistics]") {
+
+SECTION("test_distribution_buckets") {
+  StatisticsVector cuts;
+  cuts << 1.0 << 2.0 << 3.0;
+  StatisticsDistribution distribution(cuts);
+
+  distribution.addFigure(0.5);
+  distribution.addFigure(1.0);
+  distribution.addFigure(1.5);
+  distribution.addFigure(3.0);
+  distribution.addFigure(10.0);
+
+  CHECK(distribution._count == 5);
+  CHECK(distribution._total == 16.0);
+  // a value equal to a cut belongs to the next bucket
+  CHECK(distribution._counts == std::vector<uint64_t>({1, 2, 0, 2}));
+}
+
+SECTION("test_process_in_batches") {
+  // the statistics thread is only started by start()
+  std::unique_ptr<application_features::ApplicationFeature> feature(
+      new StatisticsFeature(nullptr));
+  feature->prepare();
+
+  int64_t const requests = TRI_TotalRequestsStatistics._count;
+
+  // more finished requests than are aggregated at once
+  std::vector<RequestStatistics*> acquired;
+  for (size_t i = 0; i < 200; ++i) {
+    RequestStatistics* stat = RequestStatistics::acquire();
+    REQUIRE(stat != nullptr);
+    RequestStatistics::SET_READ_START(stat, StatisticsFeature::time());
+    RequestStatistics::SET_REQUEST_START(stat);
+    RequestStatistics::SET_REQUEST_END(stat);
+    RequestStatistics::SET_WRITE_END(stat);
+    if (i % 10 == 0) {
+      RequestStatistics::SET_IGNORE(stat);
+    }
+    acquired.emplace_back(stat);
+  }
+  for (auto& stat : acquired) {
+    stat->release();
+  }
+
+  CHECK(RequestStatistics::processAll() == 180);
+  CHECK(RequestStatistics::processAll() == 0);
+  CHECK(TRI_TotalRequestsStatistics._count - requests == 180);
+  CHECK(TRI_TotalTimeDistributionStatistics->_count == 180);
+
+  // all statistics were returned to the free list
+  acquired.clear();
+  size_t reset = 0;
+  while (true) {
+    RequestStatistics* stat = RequestStatistics::acquire();
+    if (stat == nullptr) {
+      break;
+    }
+    if (stat->readStart() == 0.0) {
+      ++reset;
+    }
+    acquired.emplace_back(stat);
+  }
+  CHECK(acquired.size() == 1000);
+  CHECK(reset == acquired.size());
+  for (auto& stat : acquired) {
+    RequestStatistics::SET_IGNORE(stat);
+    stat->release();
+  }
+
+  feature->unprepare();
+}
+
+}
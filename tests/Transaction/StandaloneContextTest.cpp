@@ -0,0 +1,110 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+
+#include "catch.hpp"
+
+#include "Transaction/StandaloneContext.h"
+
+#include <thread>
+
+#include <velocypack/Builder.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+
+// the contexts never dereference their database in these tests
+static TRI_vocbase_t* database(uintptr_t i) {
+  return reinterpret_cast<TRI_vocbase_t*>(i * 8);
+}
+
+TEST_CASE("StandaloneContextTest", "[transaction]") {
+
+SECTION("test_contexts_are_recycled") {
+  transaction::StandaloneContext* raw = nullptr;
+  VPackBuilder* builder = nullptr;
+  {
+    auto context = transaction::StandaloneContext::CreateRecycled(database(1));
+    raw = context.get();
+    builder = context->leaseBuilder();
+    builder->add(VPackValue("test"));
+    context->returnBuilder(builder);
+  }
+
+  auto context = transaction::StandaloneContext::CreateRecycled(database(2));
+  CHECK(context.get() == raw);
+  // the context now belongs to the new database
+  CHECK(context->vocbase() == database(2));
+
+  // the builder of the previous transaction is reused, but empty
+  VPackBuilder* reused = context->leaseBuilder();
+  CHECK(reused == builder);
+  CHECK(reused->isEmpty());
+  context->returnBuilder(reused);
+}
+
+SECTION("test_large_builders_are_not_kept") {
+  VPackBuilder* builder = nullptr;
+  {
+    auto context = transaction::StandaloneContext::CreateRecycled(database(1));
+    builder = context->leaseBuilder();
+    builder->add(VPackValue(std::string(128 * 1024, 'x')));
+    context->returnBuilder(builder);
+  }
+
+  auto context = transaction::StandaloneContext::CreateRecycled(database(1));
+  VPackBuilder* other = context->leaseBuilder();
+  CHECK(other->buffer()->capacity() < 128 * 1024);
+  context->returnBuilder(other);
+}
+
+SECTION("test_contexts_are_recycled_per_thread") {
+  transaction::StandaloneContext* raw = nullptr;
+  {
+    auto context = transaction::StandaloneContext::CreateRecycled(database(1));
+    raw = context.get();
+  }
+
+  // the recycled context stays with this thread
+  transaction::StandaloneContext* other = nullptr;
+  std::thread thread([&other]() {
+    auto context = transaction::StandaloneContext::CreateRecycled(database(1));
+    other = context.get();
+  });
+  thread.join();
+  CHECK(other != raw);
+
+  auto context = transaction::StandaloneContext::CreateRecycled(database(1));
+  CHECK(context.get() == raw);
+}
+
+SECTION("test_plain_contexts_are_not_recycled") {
+  auto recycled = transaction::StandaloneContext::CreateRecycled(database(1));
+  transaction::StandaloneContext* raw = recycled.get();
+  recycled.reset();
+
+  // a regular context does not take the recycled one
+  auto context = transaction::StandaloneContext::Create(database(1));
+  CHECK(context.get() != raw);
+}
+
+}
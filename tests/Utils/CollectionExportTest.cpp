@@ -0,0 +1,111 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+
+#include "catch.hpp"
+
+#include "Utils/CollectionExport.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Iterator.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb;
+
+static VPackBuilder makeDocument() {
+  VPackBuilder builder;
+  builder.openObject();
+  builder.add("_key", VPackValue("test"));
+  builder.add("a", VPackValue(1));
+  builder.add("b", VPackValue("two"));
+  builder.add("c", VPackValue(true));
+  builder.close();
+  return builder;
+}
+
+static std::vector<std::string> exported(
+    CollectionExport::Restrictions const& restrictions) {
+  VPackBuilder document = makeDocument();
+  VPackBuilder builder;
+  CollectionExport::appendDocument(builder, document.slice(), restrictions);
+
+  std::vector<std::string> keys;
+  for (auto const& it : VPackObjectIterator(builder.slice(), true)) {
+    keys.emplace_back(it.key.copyString());
+  }
+  return keys;
+}
+
+TEST_CASE("CollectionExportTest", "[utils]") {
+
+SECTION("test_no_restrictions") {
+  CollectionExport::Restrictions restrictions;
+  CHECK(exported(restrictions) ==
+        (std::vector<std::string>{"_key", "a", "b", "c"}));
+
+  VPackBuilder document = makeDocument();
+  VPackBuilder builder;
+  CollectionExport::appendDocument(builder, document.slice(), restrictions);
+  CHECK(builder.slice().get("a").getInt() == 1);
+  CHECK(builder.slice().get("b").copyString() == "two");
+  CHECK(builder.slice().get("c").getBool());
+}
+
+SECTION("test_include_restrictions") {
+  CollectionExport::Restrictions restrictions;
+  restrictions.type = CollectionExport::Restrictions::RESTRICTION_INCLUDE;
+  restrictions.fields = {"_key", "b", "missing"};
+  CHECK(exported(restrictions) == (std::vector<std::string>{"_key", "b"}));
+
+  restrictions.fields.clear();
+  CHECK(exported(restrictions).empty());
+}
+
+SECTION("test_exclude_restrictions") {
+  CollectionExport::Restrictions restrictions;
+  restrictions.type = CollectionExport::Restrictions::RESTRICTION_EXCLUDE;
+  restrictions.fields = {"a", "c", "missing"};
+  CHECK(exported(restrictions) == (std::vector<std::string>{"_key", "b"}));
+
+  restrictions.fields.clear();
+  CHECK(exported(restrictions) ==
+        (std::vector<std::string>{"_key", "a", "b", "c"}));
+}
+
+SECTION("test_documents_are_appended_to_an_open_array") {
+  CollectionExport::Restrictions restrictions;
+  restrictions.type = CollectionExport::Restrictions::RESTRICTION_INCLUDE;
+  restrictions.fields = {"a"};
+
+  VPackBuilder document = makeDocument();
+  VPackBuilder builder;
+  builder.openArray();
+  CollectionExport::appendDocument(builder, document.slice(), restrictions);
+  CollectionExport::appendDocument(builder, document.slice(), restrictions);
+  builder.close();
+
+  REQUIRE(builder.slice().length() == 2);
+  CHECK(builder.slice().at(1).get("a").getInt() == 1);
+  CHECK(builder.slice().at(1).length() == 1);
+}
+
+}
@@ -0,0 +1,125 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+
+#include "catch.hpp"
+
+#include "VocBase/AuthInfo.h"
+
+using namespace arangodb;
+
+static AuthResult authorized(std::string const& username) {
+  AuthResult result(username);
+  result._authorized = true;
+  return result;
+}
+
+TEST_CASE("AuthBasicCacheTest", "[auth]") {
+
+SECTION("test_hits_and_misses") {
+  AuthBasicCache cache;
+  AuthResult result;
+
+  CHECK(!cache.lookup("secret", 1.0, result));
+  CHECK(cache.misses() == 1);
+
+  cache.store("secret", authorized("root"), 1.0, cache.version());
+  REQUIRE(cache.lookup("secret", 2.0, result));
+  CHECK(result._username == "root");
+  CHECK(result._authorized);
+  CHECK(cache.hits() == 1);
+  CHECK(cache.misses() == 1);
+}
+
+SECTION("test_expired_secrets") {
+  AuthBasicCache cache;
+  AuthResult result;
+
+  cache.store("secret", authorized("root"), 1.0, cache.version());
+  CHECK(cache.lookup("secret", 1.0 + AuthBasicCache::TTL - 1.0, result));
+  CHECK(!cache.lookup("secret", 1.0 + AuthBasicCache::TTL, result));
+  CHECK(cache.misses() == 1);
+}
+
+SECTION("test_unauthorized_results") {
+  AuthBasicCache cache;
+  AuthResult result;
+
+  cache.store("secret", AuthResult("root"), 1.0, cache.version());
+  CHECK(!cache.lookup("secret", 1.0, result));
+
+  // a failed check removes a secret that was accepted before
+  cache.store("secret", authorized("root"), 1.0, cache.version());
+  cache.store("secret", AuthResult("root"), 1.0, cache.version());
+  CHECK(!cache.lookup("secret", 1.0, result));
+}
+
+SECTION("test_clear") {
+  AuthBasicCache cache;
+  AuthResult result;
+
+  cache.store("a", authorized("a"), 1.0, cache.version());
+  cache.store("b", authorized("b"), 1.0, cache.version());
+  cache.clear();
+  CHECK(!cache.lookup("a", 1.0, result));
+  CHECK(!cache.lookup("b", 1.0, result));
+}
+
+SECTION("test_results_from_before_clear") {
+  AuthBasicCache cache;
+  AuthResult result;
+
+  // the users were reloaded while the password was checked
+  uint64_t version = cache.version();
+  cache.clear();
+  cache.store("secret", authorized("root"), 1.0, version);
+  CHECK(!cache.lookup("secret", 1.0, result));
+
+  cache.store("secret", authorized("root"), 1.0, cache.version());
+  CHECK(cache.lookup("secret", 1.0, result));
+}
+
+SECTION("test_shard_size") {
+  AuthBasicCache cache;
+  AuthResult result;
+
+  // more secrets than fit into all shards. full shards start over, so
+  // the cache never holds more than its size
+  size_t const n = AuthBasicCache::Shards * AuthBasicCache::ShardSize * 2;
+  for (size_t i = 0; i < n; ++i) {
+    std::string secret = std::to_string(i);
+    cache.store(secret, authorized(secret), 1.0, cache.version());
+  }
+
+  size_t found = 0;
+  for (size_t i = 0; i < n; ++i) {
+    if (cache.lookup(std::to_string(i), 1.0, result)) {
+      ++found;
+    }
+  }
+  CHECK(found > 0);
+  CHECK(found <= AuthBasicCache::Shards * AuthBasicCache::ShardSize);
+  // the most recent secret is always kept
+  CHECK(cache.lookup(std::to_string(n - 1), 1.0, result));
+}
+
+}
@@ -0,0 +1,108 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+
+#include "catch.hpp"
+
+#include "Basics/WriteLocker.h"
+#include "VocBase/CollectionNamesCache.h"
+
+using namespace arangodb;
+
+// the snapshots never dereference the collections, so any distinct
+// addresses will do
+static char Collections[3];
+
+static LogicalCollection* collection(size_t i) {
+  return reinterpret_cast<LogicalCollection*>(&Collections[i]);
+}
+
+TEST_CASE("CollectionNamesCacheTest", "[vocbase]") {
+  basics::ReadWriteLock lock;
+  CollectionNamesSnapshot::ByName byName{{"a", collection(0)},
+                                         {"b", collection(1)}};
+  CollectionNamesSnapshot::ById byId{{1, collection(0)}, {2, collection(1)}};
+  CollectionNamesCache cache;
+
+SECTION("test_snapshot_contents") {
+  auto snapshot = cache.get(lock, byName, byId);
+  REQUIRE(snapshot != nullptr);
+  CHECK(snapshot->byName == byName);
+  CHECK(snapshot->byId == byId);
+  CHECK(snapshot->namesById.size() == 2);
+  CHECK(snapshot->namesById.at(1) == "a");
+  CHECK(snapshot->namesById.at(2) == "b");
+}
+
+SECTION("test_snapshot_is_shared") {
+  auto first = cache.get(lock, byName, byId);
+
+  // without an invalidation, changes of the maps are not picked up
+  byName.emplace("c", collection(2));
+  byId.emplace(3, collection(2));
+  auto second = cache.get(lock, byName, byId);
+  CHECK(first == second);
+  CHECK(second->byName.find("c") == second->byName.end());
+}
+
+SECTION("test_invalidation") {
+  auto first = cache.get(lock, byName, byId);
+
+  {
+    // a rename, as done by the database
+    WRITE_LOCKER(writeLocker, lock);
+    byName.erase("a");
+    byName.emplace("renamed", collection(0));
+    cache.invalidate();
+  }
+
+  auto second = cache.get(lock, byName, byId);
+  CHECK(first != second);
+  CHECK(second->byName.find("a") == second->byName.end());
+  CHECK(second->byName.at("renamed") == collection(0));
+  CHECK(second->namesById.at(1) == "renamed");
+
+  // readers of the old snapshot still see the old names
+  CHECK(first->byName.at("a") == collection(0));
+  CHECK(first->namesById.at(1) == "a");
+}
+
+SECTION("test_concurrent_lookups") {
+  std::vector<std::shared_ptr<CollectionNamesSnapshot const>> snapshots(4);
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < snapshots.size(); ++i) {
+    threads.emplace_back([&, i]() {
+      snapshots[i] = cache.get(lock, byName, byId);
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  // all lookups see the same snapshot, which was built once
+  for (auto const& snapshot : snapshots) {
+    CHECK(snapshot == snapshots[0]);
+  }
+  CHECK(cache.get(lock, byName, byId) == snapshots[0]);
+}
+
+}
@@ -0,0 +1,140 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+
+#include "catch.hpp"
+
+#include "Aql/AstNode.h"
+#include "Basics/StaticStrings.h"
+#include "Indexes/Index.h"
+#include "VocBase/TraverserOptions.h"
+
+using namespace arangodb;
+using namespace arangodb::aql;
+using namespace arangodb::traverser;
+
+namespace {
+
+class TestIndex final : public Index {
+ public:
+  explicit TestIndex(IndexType type)
+      : Index(1, nullptr, {}, false, false), _type(type) {}
+
+  bool allowExpansion() const override { return false; }
+  IndexType type() const override { return _type; }
+  bool canBeDropped() const override { return false; }
+  bool isSorted() const override { return false; }
+  bool hasSelectivityEstimate() const override { return false; }
+  size_t memory() const override { return 0; }
+  int insert(transaction::Methods*, TRI_voc_rid_t, VPackSlice const&,
+             bool) override {
+    return TRI_ERROR_NO_ERROR;
+  }
+  int remove(transaction::Methods*, TRI_voc_rid_t, VPackSlice const&,
+             bool) override {
+    return TRI_ERROR_NO_ERROR;
+  }
+  int unload() override { return TRI_ERROR_NO_ERROR; }
+
+ private:
+  IndexType const _type;
+};
+
+transaction::Methods::IndexHandle handle(Index::IndexType type) {
+  return transaction::Methods::IndexHandle(std::make_shared<TestIndex>(type));
+}
+
+}  // namespace
+
+TEST_CASE("TraverserOptionsTest", "[traversal]") {
+  // the index condition _from == <vertex>, as built by the optimizer
+  AstNode attribute(NODE_TYPE_ATTRIBUTE_ACCESS);
+  attribute.setStringValue(StaticStrings::FromString.data(),
+                           StaticStrings::FromString.size());
+  AstNode vertex(NODE_TYPE_VALUE, VALUE_TYPE_STRING);
+  vertex.setStringValue("v/1", 3);
+  AstNode comparison(NODE_TYPE_OPERATOR_BINARY_EQ);
+  comparison.addMember(&attribute);
+  comparison.addMember(&vertex);
+  AstNode condition(NODE_TYPE_OPERATOR_NARY_AND);
+  condition.addMember(&comparison);
+
+  TraverserOptions::LookupInfo info;
+  info.idxHandles[0] = handle(Index::TRI_IDX_TYPE_EDGE_INDEX);
+  info.indexCondition = &condition;
+  info.conditionNeedUpdate = true;
+  info.conditionMemberToUpdate = 0;
+
+SECTION("test_edge_index_lookups_are_batched") {
+  CHECK(TraverserOptions::canBatchLookup(info));
+
+  // one edge index per shard
+  info.idxHandles.emplace_back(handle(Index::TRI_IDX_TYPE_EDGE_INDEX));
+  CHECK(TraverserOptions::canBatchLookup(info));
+}
+
+SECTION("test_other_indexes_are_not_batched") {
+  info.idxHandles.emplace_back(handle(Index::TRI_IDX_TYPE_HASH_INDEX));
+  CHECK(!TraverserOptions::canBatchLookup(info));
+
+  info.idxHandles.clear();
+  CHECK(!TraverserOptions::canBatchLookup(info));
+
+  // the optimizer has not picked an index yet
+  info.idxHandles.resize(1);
+  CHECK(!TraverserOptions::canBatchLookup(info));
+}
+
+SECTION("test_further_conditions_are_not_batched") {
+  AstNode other(NODE_TYPE_OPERATOR_BINARY_EQ);
+  other.addMember(&attribute);
+  other.addMember(&vertex);
+  condition.addMember(&other);
+
+  CHECK(!TraverserOptions::canBatchLookup(info));
+}
+
+SECTION("test_other_comparisons_are_not_batched") {
+  AstNode unequal(NODE_TYPE_OPERATOR_BINARY_NE);
+  unequal.addMember(&attribute);
+  unequal.addMember(&vertex);
+  condition.changeMember(0, &unequal);
+  CHECK(!TraverserOptions::canBatchLookup(info));
+
+  // the vertex is not compared with an attribute
+  AstNode values(NODE_TYPE_OPERATOR_BINARY_EQ);
+  values.addMember(&vertex);
+  values.addMember(&vertex);
+  condition.changeMember(0, &values);
+  CHECK(!TraverserOptions::canBatchLookup(info));
+}
+
+SECTION("test_fixed_conditions_are_not_batched") {
+  info.conditionNeedUpdate = false;
+  CHECK(!TraverserOptions::canBatchLookup(info));
+
+  info.conditionNeedUpdate = true;
+  info.indexCondition = nullptr;
+  CHECK(!TraverserOptions::canBatchLookup(info));
+}
+
+}
@@ -0,0 +1,119 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Basics/Common.h"
+
+#include "catch.hpp"
+
+#include "VocBase/VertexInterner.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Iterator.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb::traverser;
+
+// the _id strings of count vertices, in an array
+static VPackBuilder makeVertices(size_t count, std::string const& prefix) {
+  VPackBuilder builder;
+  builder.openArray();
+  for (size_t i = 0; i < count; ++i) {
+    builder.add(VPackValue(prefix + std::to_string(i)));
+  }
+  builder.close();
+  return builder;
+}
+
+TEST_CASE("VertexInternerTest", "[traversal]") {
+  VertexInterner interner;
+
+SECTION("test_vertices_get_dense_ids_in_insertion_order") {
+  VPackBuilder vertices = makeVertices(3, "v/");
+  for (auto const& vertex : VPackArrayIterator(vertices.slice())) {
+    CHECK(!interner.contains(vertex));
+    CHECK(interner.insert(vertex));
+    CHECK(interner.contains(vertex));
+  }
+
+  REQUIRE(interner.size() == 3);
+  for (size_t id = 0; id < 3; ++id) {
+    CHECK(interner.vertex(id).copyString() == "v/" + std::to_string(id));
+  }
+}
+
+SECTION("test_equal_strings_are_interned_once") {
+  VPackBuilder first = makeVertices(1, "v/");
+  VPackBuilder second = makeVertices(1, "v/");
+
+  CHECK(interner.insert(first.slice().at(0)));
+  // another slice with the same contents
+  CHECK(!interner.insert(second.slice().at(0)));
+  CHECK(interner.contains(second.slice().at(0)));
+  CHECK(interner.size() == 1);
+  CHECK(interner.vertex(0).begin() == first.slice().at(0).begin());
+}
+
+SECTION("test_growing_keeps_all_vertices") {
+  // many more vertices than the initial lookup table holds
+  VPackBuilder vertices = makeVertices(100000, "vertices/");
+  size_t inserted = 0;
+  for (auto const& vertex : VPackArrayIterator(vertices.slice())) {
+    if (interner.insert(vertex)) {
+      ++inserted;
+    }
+  }
+  CHECK(inserted == 100000);
+  CHECK(interner.size() == 100000);
+
+  size_t found = 0;
+  for (auto const& vertex : VPackArrayIterator(vertices.slice())) {
+    if (interner.contains(vertex) && !interner.insert(vertex)) {
+      ++found;
+    }
+  }
+  CHECK(found == 100000);
+
+  VPackBuilder others = makeVertices(1000, "others/");
+  found = 0;
+  for (auto const& vertex : VPackArrayIterator(others.slice())) {
+    if (interner.contains(vertex)) {
+      ++found;
+    }
+  }
+  CHECK(found == 0);
+}
+
+SECTION("test_clear") {
+  VPackBuilder vertices = makeVertices(100000, "v/");
+  for (auto const& vertex : VPackArrayIterator(vertices.slice())) {
+    interner.insert(vertex);
+  }
+
+  interner.clear();
+  CHECK(interner.empty());
+  CHECK(!interner.contains(vertices.slice().at(0)));
+
+  // ids start at 0 again
+  CHECK(interner.insert(vertices.slice().at(5)));
+  CHECK(interner.vertex(0).copyString() == "v/5");
+}
+
+}